@@ -0,0 +1,69 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "utils.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <dolfinx/common/sort.h>
+#include <dolfinx/la/Vector.h>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Vector with the layout of the dofs of a P2 space
+la::Vector<double> create_vector(std::int64_t n)
+{
+  auto V = bench::lagrange_space(bench::unit_cube(n), 2);
+  la::Vector<double> x(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+  x.set(1.0);
+  return x;
+}
+
+void BM_scatter_fwd(benchmark::State& state)
+{
+  la::Vector<double> x = create_vector(state.range(0));
+  for (auto _ : state)
+    bench::time_iteration(state, [&x] { x.scatter_fwd(); });
+}
+
+void BM_scatter_rev(benchmark::State& state)
+{
+  la::Vector<double> x = create_vector(state.range(0));
+  for (auto _ : state)
+    bench::time_iteration(state, [&x] { x.scatter_rev(std::plus<>()); });
+}
+
+void BM_radix_sort(benchmark::State& state)
+{
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<std::int64_t> dist(0, 1ll << 40);
+  std::vector<std::int64_t> x0(state.range(0));
+  std::ranges::generate(x0, [&] { return dist(gen); });
+
+  // The copy of the unsorted values is included in the time
+  std::vector<std::int64_t> x(x0.size());
+  for (auto _ : state)
+  {
+    bench::time_iteration(state,
+                          [&]
+                          {
+                            std::ranges::copy(x0, x.begin());
+                            dolfinx::radix_sort(x);
+                          });
+    benchmark::DoNotOptimize(x.data());
+  }
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+} // namespace
+
+BENCHMARK(BM_scatter_fwd)->Arg(16)->Arg(32)->UseManualTime();
+BENCHMARK(BM_scatter_rev)->Arg(16)->Arg(32)->UseManualTime();
+BENCHMARK(BM_radix_sort)->Range(1 << 10, 1 << 22)->UseManualTime();
@@ -0,0 +1,65 @@
+# Copyright (C) 2026 The DOLFINx developers
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+"""Compare the timings of two benchmark reports written by bench_report.
+
+The average time of each phase of the report problems, maximised over
+the ranks, is compared. The exit code is 1 if a phase is slower than the
+baseline by more than the threshold, e.g. to check a branch against the
+report of the last release.
+"""
+
+import argparse
+import json
+import sys
+
+# Configuration entries that must agree for the timings to be comparable
+_config_keys = ("num_ranks", "num_threads", "scale", "repeats", "cg_iterations", "scalar_type")
+
+
+def _phase_times(report):
+    rows = report["timings"]["max"]["rows"]
+    return {name: row["avg"] for name, row in rows.items() if name.startswith("Report ")}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="Baseline report (JSON)")
+    parser.add_argument("report", help="Report to compare (JSON)")
+    parser.add_argument(
+        "--threshold", type=float, default=0.1, help="Allowed relative slowdown (default 0.1)"
+    )
+    args = parser.parse_args()
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    with open(args.report) as f:
+        report = json.load(f)
+
+    if baseline["schema_version"] != report["schema_version"]:
+        sys.exit("Reports have different schema versions")
+    for key in _config_keys:
+        if baseline["config"][key] != report["config"][key]:
+            print(f"Warning: {key} differs: {baseline['config'][key]} != {report['config'][key]}")
+
+    t0, t1 = _phase_times(baseline), _phase_times(report)
+    regressions = 0
+    width = max((len(name) for name in t0.keys() & t1.keys()), default=0)
+    print(f"{'Phase':<{width}}  {'baseline':>10}  {'report':>10}  {'change':>8}")
+    for name in sorted(t0.keys() & t1.keys()):
+        change = (t1[name] - t0[name]) / t0[name] if t0[name] > 0 else 0.0
+        flag = " *" if change > args.threshold else ""
+        regressions += change > args.threshold
+        print(f"{name:<{width}}  {t0[name]:10.4g}  {t1[name]:10.4g}  {change:+8.1%}{flag}")
+    for name in sorted(t0.keys() ^ t1.keys()):
+        print(f"{name}: only in {'baseline' if name in t0 else 'report'}")
+
+    if regressions > 0:
+        print(f"{regressions} phase(s) slower than the baseline by more than {args.threshold:.0%}")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
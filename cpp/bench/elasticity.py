@@ -0,0 +1,38 @@
+# Linear elasticity operators of degree 1, 2 and 3 on tetrahedra
+from basix import LagrangeVariant
+from basix.ufl import element
+from ufl import (
+    FunctionSpace,
+    Identity,
+    Mesh,
+    TestFunction,
+    TrialFunction,
+    dx,
+    grad,
+    inner,
+    sym,
+    tr,
+)
+
+coord_element = element("Lagrange", "tetrahedron", 1, shape=(3,))
+mesh = Mesh(coord_element)
+
+mu, lmbda = 1.0, 1.25
+
+
+def elasticity(k):
+    variant = LagrangeVariant.gll_warped
+    e = element("Lagrange", "tetrahedron", k, shape=(3,), lagrange_variant=variant)
+    V = FunctionSpace(mesh, e)
+    u, v = TrialFunction(V), TestFunction(V)
+
+    def sigma(w):
+        eps = sym(grad(w))
+        return 2.0 * mu * eps + lmbda * tr(eps) * Identity(3)
+
+    return inner(sigma(u), grad(v)) * dx
+
+
+a1 = elasticity(1)
+a2 = elasticity(2)
+a3 = elasticity(3)
@@ -0,0 +1,67 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "elasticity.h"
+#include "laplace.h"
+#include "utils.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <memory>
+
+using namespace dolfinx;
+
+namespace
+{
+// Assemble the matrix of a bilinear form on a Lagrange space of degree
+// k with bs components
+void BM_assemble(benchmark::State& state, ufcx_form* form, int k,
+                 std::size_t bs)
+{
+  auto V = bench::lagrange_space(bench::unit_cube(state.range(0)), k, bs);
+  auto a = fem::create_form<double>(*form, {V, V}, {}, {}, {}, {});
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+
+  for (auto _ : state)
+  {
+    bench::time_iteration(state,
+                          [&]
+                          {
+                            A.set(0.0);
+                            fem::assemble_matrix(A.mat_add_values(), a, {});
+                          });
+  }
+
+  const std::int64_t num_cells
+      = V->mesh()->topology()->index_map(3)->size_local();
+  state.SetItemsProcessed(state.iterations() * num_cells);
+}
+} // namespace
+
+// Meshes are chosen such that the number of dofs is similar
+BENCHMARK_CAPTURE(BM_assemble, laplace_P1, form_laplace_a1, 1, 1)
+    ->Arg(24)
+    ->UseManualTime();
+BENCHMARK_CAPTURE(BM_assemble, laplace_P2, form_laplace_a2, 2, 1)
+    ->Arg(12)
+    ->UseManualTime();
+BENCHMARK_CAPTURE(BM_assemble, laplace_P3, form_laplace_a3, 3, 1)
+    ->Arg(8)
+    ->UseManualTime();
+BENCHMARK_CAPTURE(BM_assemble, elasticity_P1, form_elasticity_a1, 1, 3)
+    ->Arg(16)
+    ->UseManualTime();
+BENCHMARK_CAPTURE(BM_assemble, elasticity_P2, form_elasticity_a2, 2, 3)
+    ->Arg(8)
+    ->UseManualTime();
+BENCHMARK_CAPTURE(BM_assemble, elasticity_P3, form_elasticity_a3, 3, 3)
+    ->Arg(6)
+    ->UseManualTime();
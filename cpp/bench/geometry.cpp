@@ -0,0 +1,60 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "utils.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+void BM_bbtree_build(benchmark::State& state)
+{
+  auto mesh = bench::unit_cube(state.range(0));
+  const int tdim = mesh->topology()->dim();
+  for (auto _ : state)
+  {
+    bench::time_iteration(state,
+                          [&]
+                          {
+                            geometry::BoundingBoxTree tree(*mesh, tdim);
+                            benchmark::DoNotOptimize(tree);
+                          });
+  }
+}
+
+void BM_bbtree_query(benchmark::State& state)
+{
+  auto mesh = bench::unit_cube(state.range(0));
+  geometry::BoundingBoxTree tree(*mesh, mesh->topology()->dim());
+
+  // Random points in the unit cube
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  std::vector<double> points(3 * 10000);
+  std::ranges::generate(points, [&] { return dist(gen); });
+  for (auto _ : state)
+  {
+    bench::time_iteration(state,
+                          [&]
+                          {
+                            auto cells = geometry::compute_collisions(
+                                tree, std::span<const double>(points));
+                            benchmark::DoNotOptimize(cells);
+                          });
+  }
+  state.SetItemsProcessed(state.iterations() * points.size() / 3);
+}
+} // namespace
+
+BENCHMARK(BM_bbtree_build)->Arg(16)->Arg(32)->UseManualTime();
+BENCHMARK(BM_bbtree_query)->Arg(16)->Arg(32)->UseManualTime();
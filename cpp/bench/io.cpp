@@ -0,0 +1,66 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "utils.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/io/VTKFile.h>
+#include <dolfinx/io/XDMFFile.h>
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+using namespace dolfinx;
+
+namespace
+{
+// P1 function on the unit cube
+std::shared_ptr<fem::Function<double>> create_function(std::int64_t n)
+{
+  auto u = std::make_shared<fem::Function<double>>(
+      bench::lagrange_space(bench::unit_cube(n), 1));
+  u->x()->set(1.0);
+  return u;
+}
+
+void BM_xdmf_write(benchmark::State& state)
+{
+  auto u = create_function(state.range(0));
+  const std::filesystem::path filename
+      = std::filesystem::temp_directory_path() / "dolfinx_bench.xdmf";
+  for (auto _ : state)
+  {
+    bench::time_iteration(state,
+                          [&]
+                          {
+                            io::XDMFFile file(MPI_COMM_WORLD, filename, "w");
+                            file.write_mesh(*u->function_space()->mesh());
+                            file.write_function(*u, 0.0);
+                          });
+  }
+}
+
+void BM_vtk_write(benchmark::State& state)
+{
+  auto u = create_function(state.range(0));
+  const std::filesystem::path filename
+      = std::filesystem::temp_directory_path() / "dolfinx_bench.pvd";
+  for (auto _ : state)
+  {
+    bench::time_iteration(state,
+                          [&]
+                          {
+                            io::VTKFile file(MPI_COMM_WORLD, filename, "w",
+                                             io::VTKFile::Encoding::Binary);
+                            file.write<double>({*u}, 0.0);
+                          });
+  }
+}
+} // namespace
+
+BENCHMARK(BM_xdmf_write)->Arg(16)->Arg(32)->UseManualTime();
+BENCHMARK(BM_vtk_write)->Arg(16)->Arg(32)->UseManualTime();
@@ -0,0 +1,88 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "laplace.h"
+#include "utils.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// P2 Laplace operator on the unit cube
+std::shared_ptr<const fem::Form<double>> laplace_form(std::int64_t n)
+{
+  auto V = bench::lagrange_space(bench::unit_cube(n), 2);
+  return std::make_shared<fem::Form<double>>(
+      fem::create_form<double>(*form_laplace_a2, {V, V}, {}, {}, {}, {}));
+}
+
+// Matrix with the sparsity of a form
+la::MatrixCSR<double> create_matrix(const fem::Form<double>& a)
+{
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  return la::MatrixCSR<double>(sp);
+}
+
+void BM_insert_csr(benchmark::State& state)
+{
+  auto a = laplace_form(state.range(0));
+  la::MatrixCSR<double> A = create_matrix(*a);
+  auto dofmap = a->function_spaces()[0]->dofmap();
+  const std::int32_t num_cells = dofmap->map().extent(0);
+  std::vector<double> Ae(dofmap->map().extent(1) * dofmap->map().extent(1),
+                         1.0);
+  for (auto _ : state)
+  {
+    bench::time_iteration(state,
+                          [&]
+                          {
+                            for (std::int32_t c = 0; c < num_cells; ++c)
+                            {
+                              std::span dofs = dofmap->cell_dofs(c);
+                              A.add(Ae, dofs, dofs);
+                            }
+                          });
+  }
+  state.SetItemsProcessed(state.iterations() * num_cells);
+}
+
+void BM_mult(benchmark::State& state)
+{
+  auto a = laplace_form(state.range(0));
+  la::MatrixCSR<double> A = create_matrix(*a);
+  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  A.scatter_rev();
+
+  auto map = a->function_spaces()[0]->dofmap()->index_map;
+  la::Vector<double> x(map, 1), y(map, 1);
+  x.set(1.0);
+  for (auto _ : state)
+  {
+    bench::time_iteration(state,
+                          [&]
+                          {
+                            x.scatter_fwd();
+                            y.set(0.0);
+                            A.mult(x, y);
+                          });
+  }
+  state.SetItemsProcessed(state.iterations() * A.row_ptr()[map->size_local()]);
+}
+} // namespace
+
+BENCHMARK(BM_insert_csr)->Arg(8)->Arg(16)->UseManualTime();
+BENCHMARK(BM_mult)->Arg(8)->Arg(16)->UseManualTime();
@@ -0,0 +1,19 @@
+# Laplace operators of degree 1, 2 and 3 on tetrahedra
+from basix import LagrangeVariant
+from basix.ufl import element
+from ufl import FunctionSpace, Mesh, TestFunction, TrialFunction, dx, grad, inner
+
+coord_element = element("Lagrange", "tetrahedron", 1, shape=(3,))
+mesh = Mesh(coord_element)
+
+
+def laplace(k):
+    e = element("Lagrange", "tetrahedron", k, lagrange_variant=LagrangeVariant.gll_warped)
+    V = FunctionSpace(mesh, e)
+    u, v = TrialFunction(V), TestFunction(V)
+    return inner(grad(u), grad(v)) * dx
+
+
+a1 = laplace(1)
+a2 = laplace(2)
+a3 = laplace(3)
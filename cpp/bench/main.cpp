@@ -0,0 +1,61 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <benchmark/benchmark.h>
+#include <dolfinx/common/log.h>
+#include <mpi.h>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+// Reporter that discards the results
+class NullReporter : public benchmark::BenchmarkReporter
+{
+public:
+  bool ReportContext(const Context&) override { return true; }
+  void ReportRuns(const std::vector<Run>&) override {}
+};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  dolfinx::init_logging(argc, argv);
+
+  // Benchmarks of collective operations require MPI initialization
+  // before any benchmarks run and termination only after all complete.
+  MPI_Init(&argc, &argv);
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // Only rank 0 reports the results, e.g. to the JSON file given by
+  // --benchmark_out=<file>
+  std::vector<char*> args(argv, argv + argc);
+  if (rank > 0)
+  {
+    std::erase_if(args, [](std::string_view arg)
+                  { return arg.starts_with("--benchmark_out"); });
+  }
+  int num_args = args.size();
+  benchmark::Initialize(&num_args, args.data());
+  if (benchmark::ReportUnrecognizedArguments(num_args, args.data()))
+  {
+    MPI_Finalize();
+    return 1;
+  }
+
+  if (rank == 0)
+    benchmark::RunSpecifiedBenchmarks();
+  else
+  {
+    NullReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+  }
+
+  benchmark::Shutdown();
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,62 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "utils.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/topologycomputation.h>
+
+using namespace dolfinx;
+
+namespace
+{
+void BM_create_box(benchmark::State& state)
+{
+  const std::int64_t n = state.range(0);
+  for (auto _ : state)
+  {
+    bench::time_iteration(
+        state,
+        [n]
+        {
+          auto mesh = mesh::create_box(
+              MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {n, n, n},
+              mesh::CellType::tetrahedron,
+              mesh::create_cell_partitioner(mesh::GhostMode::none));
+          benchmark::DoNotOptimize(mesh);
+        });
+  }
+}
+
+// Compute the entities of dimension state.range(1)
+void BM_compute_entities(benchmark::State& state)
+{
+  auto mesh = bench::unit_cube(state.range(0));
+  const int dim = state.range(1);
+  const mesh::Topology& topology = *mesh->topology();
+  const mesh::CellType type
+      = mesh::cell_entity_type(mesh::CellType::tetrahedron, dim, 0);
+  for (auto _ : state)
+  {
+    bench::time_iteration(state,
+                          [&]
+                          {
+                            auto entities
+                                = mesh::compute_entities(topology, dim, type);
+                            benchmark::DoNotOptimize(entities);
+                          });
+  }
+}
+} // namespace
+
+BENCHMARK(BM_create_box)->Arg(16)->Arg(32)->UseManualTime();
+BENCHMARK(BM_compute_entities)
+    ->Args({32, 1})
+    ->Args({32, 2})
+    ->UseManualTime();
@@ -0,0 +1,462 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+// Benchmark report: runs a fixed set of problems, modelled on the
+// Poisson, hyperelasticity and matrix-free demos, and writes the
+// timings, hardware counts and memory usage, reduced over the ranks,
+// together with the configuration to a JSON file. See README.md for
+// the schema.
+
+#include "report.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/MemoryUsage.h>
+#include <dolfinx/common/PerfCounters.h>
+#include <dolfinx/common/Table.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/defines.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/common/timing.h>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/DirichletBC.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/pack.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/la/krylov.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mpi.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Configuration of the build of the report, set by CMake
+#ifndef DOLFINX_BENCH_COMPILER
+#define DOLFINX_BENCH_COMPILER "unknown"
+#endif
+#ifndef DOLFINX_BENCH_BUILD_TYPE
+#define DOLFINX_BENCH_BUILD_TYPE "unknown"
+#endif
+#ifndef DOLFINX_BENCH_CXX_FLAGS
+#define DOLFINX_BENCH_CXX_FLAGS ""
+#endif
+
+using namespace dolfinx;
+using T = double;
+
+namespace
+{
+/// Version of the output format. It is incremented when entries are
+/// removed or change meaning, so that reports of different versions
+/// are only compared when they are compatible.
+constexpr int schema_version = 1;
+
+/// Options of the report
+struct Options
+{
+  // Factor of the number of cells of each problem
+  double scale = 1;
+
+  // Number of times that each assembly is repeated
+  int repeats = 3;
+
+  // Number of conjugate gradient iterations. The tolerance is zero, so
+  // that the amount of work is independent of the convergence.
+  int cg_iterations = 50;
+
+  // Number of threads of assembly and matrix-vector products
+  int num_threads = 1;
+
+  // Output file
+  std::string output = "bench-report.json";
+};
+
+/// Parse `--name value` options
+Options parse_options(int argc, char* argv[])
+{
+  Options options;
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string_view arg = argv[i];
+    if (arg.starts_with("--log_level"))
+      continue;
+    if (i + 1 == argc)
+      throw std::runtime_error(std::format("Missing value of {}.", arg));
+    const std::string value = argv[++i];
+    if (arg == "--scale")
+      options.scale = std::stod(value);
+    else if (arg == "--repeats")
+      options.repeats = std::stoi(value);
+    else if (arg == "--cg-iterations")
+      options.cg_iterations = std::stoi(value);
+    else if (arg == "--threads")
+      options.num_threads = std::stoi(value);
+    else if (arg == "--output")
+      options.output = value;
+    else
+      throw std::runtime_error(std::format("Unknown option {}.", arg));
+  }
+
+  if (options.scale <= 0 or options.repeats < 1 or options.cg_iterations < 1
+      or options.num_threads < 1)
+  {
+    throw std::runtime_error("Invalid benchmark report options.");
+  }
+
+  return options;
+}
+
+/// Size of a problem, for the report
+struct Problem
+{
+  std::string name;
+  std::int64_t num_cells;
+  std::int64_t num_dofs;
+  int num_iterations;
+};
+
+/// Name of the timer of a phase of a problem
+std::string timer_name(std::string_view problem, std::string_view phase)
+{
+  return std::format("Report {}: {}", problem, phase);
+}
+
+/// Tetrahedral mesh of the unit cube, with `n0` cells in each direction
+/// for scale 1. The number of cells is proportional to the scale.
+std::shared_ptr<mesh::Mesh<T>> create_mesh(std::string_view problem,
+                                           std::int64_t n0, double scale)
+{
+  common::Timer timer(timer_name(problem, "create mesh"));
+  const std::int64_t n
+      = std::max<std::int64_t>(1, std::llround(n0 * std::cbrt(scale)));
+  auto mesh = std::make_shared<mesh::Mesh<T>>(mesh::create_box<T>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {n, n, n},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  common::memory_usage::record(std::format("{}: mesh", problem),
+                               mesh->memory_usage());
+  return mesh;
+}
+
+/// Boundary condition `u = 0` on the boundary of the unit cube
+fem::DirichletBC<T> create_bc(std::shared_ptr<fem::FunctionSpace<T>> V)
+{
+  auto topology = V->mesh()->topology_mutable();
+  topology->create_connectivity(2, 3);
+  std::vector facets = mesh::exterior_facet_indices(*topology);
+  std::vector dofs
+      = fem::locate_dofs_topological(*topology, *V->dofmap(), 2, facets);
+  return fem::DirichletBC<T>(0.0, std::move(dofs), V);
+}
+
+/// Poisson equation with P1 elements, solved by conjugate gradients
+/// with a la::MatrixCSR
+Problem poisson(const Options& options)
+{
+  const std::string name = "poisson";
+  auto mesh = create_mesh(name, 48, options.scale);
+  auto V = bench::lagrange_space(mesh, 1);
+  auto f = std::make_shared<fem::Constant<T>>(1.0);
+  fem::Form<T> a
+      = fem::create_form<T>(*form_report_a_poisson, {V, V}, {}, {}, {}, {});
+  fem::Form<T> L = fem::create_form<T>(*form_report_L_poisson, {V}, {},
+                                       {{"f", f}}, {}, {});
+  fem::DirichletBC<T> bc = create_bc(V);
+
+  std::optional<la::MatrixCSR<T>> A;
+  {
+    common::Timer timer(timer_name(name, "create matrix"));
+    la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+    sp.finalize();
+    A.emplace(sp);
+  }
+  for (int i = 0; i < options.repeats; ++i)
+  {
+    common::Timer timer(timer_name(name, "assemble matrix"));
+    A->set(0.0);
+    fem::assemble_matrix(A->mat_add_values(), a, {bc}, options.num_threads);
+    fem::set_diagonal<T>(A->mat_set_values(), *V, {bc});
+    A->scatter_rev();
+  }
+
+  la::Vector<T> b(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+  for (int i = 0; i < options.repeats; ++i)
+  {
+    common::Timer timer(timer_name(name, "assemble vector"));
+    b.set(0.0);
+    fem::assemble_vector(b.mutable_array(), L, options.num_threads);
+    b.scatter_rev(std::plus<T>());
+    bc.set(b.mutable_array(), std::nullopt);
+  }
+
+  la::Vector<T> u(b.index_map(), b.bs());
+  int num_iterations = 0;
+  {
+    common::Timer timer(timer_name(name, "solve"));
+    u.set(0.0);
+    auto action = [&A, &options](la::Vector<T>& x, la::Vector<T>& y)
+    {
+      x.scatter_fwd();
+      y.set(0.0);
+      A->mult(x, y, options.num_threads);
+    };
+    num_iterations = la::cg(u, b, action, options.cg_iterations, 0.0);
+  }
+
+  common::memory_usage::record(name + ": matrix", A->memory_usage());
+  common::memory_usage::record(name + ": vectors",
+                               b.memory_usage() + u.memory_usage());
+  auto map = V->dofmap()->index_map;
+  return {name, mesh->topology()->index_map(3)->size_global(),
+          map->size_global() * V->dofmap()->index_map_bs(), num_iterations};
+}
+
+/// Residual and Jacobian of a compressible neo-Hookean material with
+/// vector P1 elements, at a given displacement
+Problem hyperelasticity(const Options& options)
+{
+  const std::string name = "hyperelasticity";
+  auto mesh = create_mesh(name, 24, options.scale);
+  auto V = bench::lagrange_space(mesh, 1, 3);
+  auto u = std::make_shared<fem::Function<T>>(V);
+  u->interpolate(
+      [](auto x) -> std::pair<std::vector<T>, std::vector<std::size_t>>
+      {
+        std::vector<T> v(3 * x.extent(1));
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+        {
+          v[0 * x.extent(1) + p] = 0.1 * x(0, p) * x(1, p);
+          v[1 * x.extent(1) + p] = -0.05 * x(2, p);
+          v[2 * x.extent(1) + p] = 0.1 * x(0, p) * x(0, p);
+        }
+        return {std::move(v), {3, x.extent(1)}};
+      });
+  auto B = std::make_shared<fem::Constant<T>>(std::vector<T>{0.0, 0.0, -1.0});
+  fem::Form<T> F = fem::create_form<T>(*form_report_F_hyperelasticity, {V},
+                                       {{"uh", u}}, {{"B", B}}, {}, {});
+  fem::Form<T> J = fem::create_form<T>(*form_report_J_hyperelasticity,
+                                       {V, V}, {{"uh", u}}, {}, {}, {});
+
+  std::optional<la::MatrixCSR<T>> A;
+  {
+    common::Timer timer(timer_name(name, "create matrix"));
+    la::SparsityPattern sp = fem::create_sparsity_pattern(J);
+    sp.finalize();
+    A.emplace(sp);
+  }
+  for (int i = 0; i < options.repeats; ++i)
+  {
+    common::Timer timer(timer_name(name, "assemble matrix"));
+    A->set(0.0);
+    fem::assemble_matrix(A->mat_add_values(), J, {}, options.num_threads);
+    A->scatter_rev();
+  }
+
+  la::Vector<T> b(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+  for (int i = 0; i < options.repeats; ++i)
+  {
+    common::Timer timer(timer_name(name, "assemble vector"));
+    b.set(0.0);
+    fem::assemble_vector(b.mutable_array(), F, options.num_threads);
+    b.scatter_rev(std::plus<T>());
+  }
+
+  common::memory_usage::record(name + ": matrix", A->memory_usage());
+  common::memory_usage::record(name + ": vectors", b.memory_usage());
+  auto map = V->dofmap()->index_map;
+  return {name, mesh->topology()->index_map(3)->size_global(),
+          map->size_global() * V->dofmap()->index_map_bs(), 0};
+}
+
+/// Poisson equation with P2 elements, solved by conjugate gradients
+/// with the action of the operator assembled as a vector
+Problem matrix_free(const Options& options)
+{
+  const std::string name = "matrix-free";
+  auto mesh = create_mesh(name, 24, options.scale);
+  auto V = bench::lagrange_space(mesh, 2);
+  auto f = std::make_shared<fem::Constant<T>>(1.0);
+  auto ui = std::make_shared<fem::Function<T>>(V);
+  fem::Form<T> M = fem::create_form<T>(*form_report_M_matrix_free, {V},
+                                       {{"ui", ui}}, {}, {}, {});
+  fem::Form<T> L = fem::create_form<T>(*form_report_L_matrix_free, {V}, {},
+                                       {{"f", f}}, {}, {});
+  fem::DirichletBC<T> bc = create_bc(V);
+
+  la::Vector<T> b(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+  for (int i = 0; i < options.repeats; ++i)
+  {
+    common::Timer timer(timer_name(name, "assemble vector"));
+    b.set(0.0);
+    fem::assemble_vector(b.mutable_array(), L, options.num_threads);
+    b.scatter_rev(std::plus<T>());
+    bc.set(b.mutable_array(), std::nullopt);
+  }
+
+  // Action y = Ax of the operator, with the rows and columns of the
+  // boundary condition dofs zeroed
+  auto coeffs = fem::allocate_coefficient_storage(M);
+  auto action = [&](la::Vector<T>& x, la::Vector<T>& y)
+  {
+    common::Timer timer(timer_name(name, "apply operator"));
+    x.scatter_fwd();
+    y.set(0.0);
+    std::ranges::copy(x.array(), ui->x()->mutable_array().begin());
+    bc.set(ui->x()->mutable_array(), std::nullopt, T(0));
+    fem::pack_coefficients(M, coeffs, options.num_threads);
+    fem::assemble_vector(y.mutable_array(), M, M.packed_constants(),
+                         fem::make_coefficients_span(coeffs),
+                         options.num_threads);
+    y.scatter_rev(std::plus<T>());
+    bc.set(y.mutable_array(), std::nullopt, T(0));
+  };
+
+  la::Vector<T> u(b.index_map(), b.bs());
+  int num_iterations = 0;
+  {
+    common::Timer timer(timer_name(name, "solve"));
+    u.set(0.0);
+    num_iterations = la::cg(u, b, action, options.cg_iterations, 0.0);
+  }
+
+  common::memory_usage::record(name + ": vectors",
+                               b.memory_usage() + u.memory_usage());
+  auto map = V->dofmap()->index_map;
+  return {name, mesh->topology()->index_map(3)->size_global(),
+          map->size_global() * V->dofmap()->index_map_bs(), num_iterations};
+}
+
+/// Quote a string for JSON output
+std::string quote(std::string_view str)
+{
+  std::string out = "\"";
+  for (char c : str)
+  {
+    if (c == '"' or c == '\\')
+      out += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      out += c;
+  }
+  return out + "\"";
+}
+
+/// Minimum, average and maximum over the ranks of a table, as JSON.
+/// @note Collective.
+std::string reduce_table(MPI_Comm comm, const Table& table)
+{
+  std::string json;
+  for (auto [reduction, key] :
+       {std::pair(Table::Reduction::min, "min"),
+        std::pair(Table::Reduction::average, "average"),
+        std::pair(Table::Reduction::max, "max")})
+  {
+    json += std::format("{}\"{}\": {}", json.empty() ? "" : ", ", key,
+                        table.reduce(comm, reduction).json());
+  }
+  return "{" + json + "}";
+}
+
+/// Configuration of the run, as JSON
+std::string configuration(MPI_Comm comm, const Options& options,
+                          bool counters)
+{
+  std::array<char, MPI_MAX_LIBRARY_VERSION_STRING> library;
+  int length = 0;
+  MPI_Get_library_version(library.data(), &length);
+  std::string mpi_library(library.data(), length);
+  mpi_library = mpi_library.substr(0, mpi_library.find('\n'));
+
+  int major = 0, minor = 0;
+  MPI_Get_version(&major, &minor);
+
+  std::array<char, MPI_MAX_PROCESSOR_NAME> host;
+  MPI_Get_processor_name(host.data(), &length);
+
+  return std::format(
+      "{{\"dolfinx_version\": {}, \"git_commit_hash\": {}, "
+      "\"compiler\": {}, \"build_type\": {}, \"cxx_flags\": {}, "
+      "\"mpi_library\": {}, \"mpi_version\": \"{}.{}\", \"host\": {}, "
+      "\"num_ranks\": {}, \"num_threads\": {}, \"scale\": {}, "
+      "\"repeats\": {}, \"cg_iterations\": {}, \"scalar_type\": "
+      "\"float64\", \"perf_counters\": {}}}",
+      quote(dolfinx::version()), quote(dolfinx::git_commit_hash()),
+      quote(DOLFINX_BENCH_COMPILER), quote(DOLFINX_BENCH_BUILD_TYPE),
+      quote(DOLFINX_BENCH_CXX_FLAGS), quote(mpi_library), major, minor,
+      quote(std::string_view(host.data(), length)),
+      dolfinx::MPI::size(comm), options.num_threads, options.scale,
+      options.repeats, options.cg_iterations, counters);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  dolfinx::init_logging(argc, argv);
+  MPI_Init(&argc, &argv);
+
+  {
+    MPI_Comm comm = MPI_COMM_WORLD;
+    const Options options = parse_options(argc, argv);
+
+    // Hardware counters are recorded by the named timers, if available
+    const int counters_local = common::perf::start();
+    int counters = 0;
+    MPI_Allreduce(&counters_local, &counters, 1, MPI_INT, MPI_MIN, comm);
+
+    std::vector<Problem> problems;
+    for (auto problem : {poisson, hyperelasticity, matrix_free})
+    {
+      MPI_Barrier(comm);
+      problems.push_back(problem(options));
+    }
+    common::perf::stop();
+
+    std::string problems_json;
+    for (const Problem& p : problems)
+    {
+      problems_json += std::format(
+          "{}{{\"name\": {}, \"num_cells\": {}, \"num_dofs\": {}, "
+          "\"num_iterations\": {}}}",
+          problems_json.empty() ? "" : ", ", quote(p.name), p.num_cells,
+          p.num_dofs, p.num_iterations);
+    }
+
+    const std::string config = configuration(comm, options, counters == 1);
+    const std::string timings = reduce_table(comm, dolfinx::timing_table());
+    const std::string counts = reduce_table(comm, dolfinx::counter_table());
+    const std::string memory
+        = reduce_table(comm, common::memory_usage::table());
+    if (dolfinx::MPI::rank(comm) == 0)
+    {
+      std::ofstream file(options.output);
+      file << std::format("{{\"schema_version\": {},\n\"config\": {},\n"
+                          "\"problems\": [{}],\n\"timings\": {},\n"
+                          "\"counters\": {},\n\"memory\": {}}}\n",
+                          schema_version, config, problems_json, timings,
+                          counts, memory);
+      if (!file)
+        throw std::runtime_error("Failed to write " + options.output);
+    }
+  }
+
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,64 @@
+# Forms of the problems of the benchmark report: Poisson (P1),
+# hyperelasticity (vector P1) and a matrix-free Laplace operator (P2)
+# on tetrahedra
+from basix import LagrangeVariant
+from basix.ufl import element
+from ufl import (
+    Coefficient,
+    Constant,
+    FunctionSpace,
+    Identity,
+    Mesh,
+    TestFunction,
+    TrialFunction,
+    action,
+    derivative,
+    det,
+    dx,
+    grad,
+    inner,
+    ln,
+    tr,
+)
+
+coord_element = element("Lagrange", "tetrahedron", 1, shape=(3,))
+mesh = Mesh(coord_element)
+variant = LagrangeVariant.gll_warped
+
+# Poisson
+V = FunctionSpace(mesh, element("Lagrange", "tetrahedron", 1, lagrange_variant=variant))
+u, v = TrialFunction(V), TestFunction(V)
+f = Constant(mesh)
+a_poisson = inner(grad(u), grad(v)) * dx
+L_poisson = inner(f, v) * dx
+
+# Hyperelasticity (compressible neo-Hookean), residual and Jacobian
+W = FunctionSpace(
+    mesh, element("Lagrange", "tetrahedron", 1, shape=(3,), lagrange_variant=variant)
+)
+du, w = TrialFunction(W), TestFunction(W)
+uh = Coefficient(W)
+B = Constant(mesh, shape=(3,))
+F = Identity(3) + grad(uh)
+J = det(F)
+mu, lmbda = 3.85, 5.77
+psi = (mu / 2) * (tr(F.T * F) - 3) - mu * ln(J) + (lmbda / 2) * ln(J) ** 2
+Pi = psi * dx - inner(B, uh) * dx
+F_hyperelasticity = derivative(Pi, uh, w)
+J_hyperelasticity = derivative(F_hyperelasticity, uh, du)
+
+# Matrix-free Laplace operator of degree 2
+Q = FunctionSpace(mesh, element("Lagrange", "tetrahedron", 2, lagrange_variant=variant))
+p, q = TrialFunction(Q), TestFunction(Q)
+ui = Coefficient(Q)
+M_matrix_free = action(inner(grad(p), grad(q)) * dx, ui)
+L_matrix_free = inner(f, q) * dx
+
+forms = [
+    a_poisson,
+    L_poisson,
+    F_hyperelasticity,
+    J_hyperelasticity,
+    M_matrix_free,
+    L_matrix_free,
+]
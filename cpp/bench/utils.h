@@ -0,0 +1,83 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <basix/finite-element.h>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <vector>
+
+namespace bench
+{
+/// @brief Tetrahedral mesh of the unit cube with `n` cells in each
+/// direction.
+///
+/// Meshes are cached, since Google Benchmark calls a benchmark
+/// function several times to determine the number of iterations.
+inline std::shared_ptr<dolfinx::mesh::Mesh<double>>
+unit_cube(std::int64_t n)
+{
+  static std::map<std::int64_t, std::shared_ptr<dolfinx::mesh::Mesh<double>>>
+      meshes;
+  auto& mesh = meshes[n];
+  if (!mesh)
+  {
+    mesh = std::make_shared<dolfinx::mesh::Mesh<double>>(
+        dolfinx::mesh::create_box(
+            MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {n, n, n},
+            dolfinx::mesh::CellType::tetrahedron,
+            dolfinx::mesh::create_cell_partitioner(
+                dolfinx::mesh::GhostMode::none)));
+  }
+  return mesh;
+}
+
+/// @brief Lagrange function space of degree `k` with `bs` components.
+inline std::shared_ptr<dolfinx::fem::FunctionSpace<double>>
+lagrange_space(std::shared_ptr<dolfinx::mesh::Mesh<double>> mesh, int k,
+               std::size_t bs = 1)
+{
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, k,
+      basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  std::vector<std::size_t> shape;
+  if (bs > 1)
+    shape.push_back(bs);
+  return std::make_shared<dolfinx::fem::FunctionSpace<double>>(
+      dolfinx::fem::create_functionspace<double>(
+          mesh,
+          std::make_shared<dolfinx::fem::FiniteElement<double>>(element,
+                                                                shape)));
+}
+
+/// @brief Time one iteration of a benchmark.
+///
+/// The iteration time is the maximum over the ranks, so that all ranks
+/// run the same number of iterations and collective operations can be
+/// benchmarked. Benchmarks using this function must be registered with
+/// `UseManualTime()`.
+template <typename F>
+void time_iteration(benchmark::State& state, F&& f)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  const double t0 = MPI_Wtime();
+  f();
+  double t = MPI_Wtime() - t0;
+  MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  state.SetIterationTime(t);
+}
+} // namespace bench
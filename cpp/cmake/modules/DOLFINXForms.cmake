@@ -0,0 +1,127 @@
+# Copyright (C) 2026 The DOLFINx developers
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+#
+# CMake helper for compiling UFL files ahead of time.
+#
+#   dolfinx_add_forms(<target> [OBJECT|SHARED|MODULE]
+#                     UFL <file.py>...
+#                     [SCALAR_TYPE <float32|float64|complex64|complex128>]
+#                     [FFCX_OPTIONS <option>...])
+#
+# Compiles the UFL files with FFCx and adds a library <target> with the
+# generated code and a generated registration file. The registration
+# file registers every form of the UFL files with
+# dolfinx::fem::FormRegistry::global() as "<file>_<name>", e.g.
+# "poisson_a" for the form 'a' in poisson.py. The headers generated by
+# FFCx are on the include path of targets that link to <target>.
+#
+# An OBJECT library (the default) registers its forms when a program
+# that links to it starts. A MODULE library is loaded at run time with
+# dolfinx::fem::FormRegistry::load(). Static libraries are not
+# supported, since the linker drops the unreferenced registration
+# objects.
+#
+# The calling project must enable the C language.
+
+# This file is also run as a script (cmake -P) to generate the
+# registration file
+set(_DOLFINX_FORMS_SCRIPT ${CMAKE_CURRENT_LIST_FILE})
+
+if(CMAKE_SCRIPT_MODE_FILE)
+  # Collect the forms declared in the headers generated by FFCx, e.g.
+  # 'extern ufcx_form* form_poisson_a;'
+  string(REPLACE "|" ";" _headers "${DOLFINX_FORMS_HEADERS}")
+  set(_includes "")
+  set(_forms "")
+  foreach(_header ${_headers})
+    get_filename_component(_name ${_header} NAME)
+    string(APPEND _includes "#include \"${_name}\"\n")
+    file(STRINGS ${_header} _lines
+         REGEX "^extern ufcx_form\\* form_[A-Za-z0-9_]+;"
+    )
+    foreach(_line ${_lines})
+      string(REGEX REPLACE "^extern ufcx_form\\* form_([A-Za-z0-9_]+);.*" "\\1"
+                           _form "${_line}"
+      )
+      string(APPEND _forms "     {\"${_form}\", form_${_form}},\n")
+    endforeach()
+  endforeach()
+
+  file(
+    WRITE ${DOLFINX_FORMS_OUTPUT}.tmp
+    "// Generated by dolfinx_add_forms. Do not edit.\n\n"
+    "${_includes}#include <dolfinx/fem/FormRegistry.h>\n\n"
+    "namespace\n{\n"
+    "const dolfinx::fem::FormRegistrar registrar(\n"
+    "    {\n${_forms}    });\n"
+    "} // namespace\n"
+  )
+  configure_file(
+    ${DOLFINX_FORMS_OUTPUT}.tmp ${DOLFINX_FORMS_OUTPUT} COPYONLY
+  )
+  file(REMOVE ${DOLFINX_FORMS_OUTPUT}.tmp)
+  return()
+endif()
+
+function(dolfinx_add_forms target)
+  cmake_parse_arguments(
+    PARSE_ARGV 1 arg "OBJECT;SHARED;MODULE" "SCALAR_TYPE" "UFL;FFCX_OPTIONS"
+  )
+  if(NOT arg_UFL)
+    message(FATAL_ERROR "dolfinx_add_forms: no UFL files given for ${target}")
+  endif()
+
+  if(arg_MODULE)
+    set(_type MODULE)
+  elseif(arg_SHARED)
+    set(_type SHARED)
+  else()
+    set(_type OBJECT)
+  endif()
+
+  set(_ffcx_options ${arg_FFCX_OPTIONS})
+  if(arg_SCALAR_TYPE)
+    list(APPEND _ffcx_options "--scalar_type=${arg_SCALAR_TYPE}")
+  endif()
+
+  # Compile UFL files using FFCx
+  set(_dir ${CMAKE_CURRENT_BINARY_DIR}/${target}_forms)
+  file(MAKE_DIRECTORY ${_dir})
+  set(_sources "")
+  set(_headers "")
+  foreach(_ufl ${arg_UFL})
+    get_filename_component(_file ${_ufl} ABSOLUTE)
+    get_filename_component(_stem ${_ufl} NAME_WE)
+    add_custom_command(
+      OUTPUT ${_dir}/${_stem}.c ${_dir}/${_stem}.h
+      COMMAND ffcx ${_ffcx_options} -o ${_dir} ${_file}
+      VERBATIM
+      DEPENDS ${_file}
+      COMMENT "Compile ${_ufl} using FFCx"
+    )
+    list(APPEND _sources ${_dir}/${_stem}.c)
+    list(APPEND _headers ${_dir}/${_stem}.h)
+  endforeach()
+
+  # Generate the registration file
+  string(REPLACE ";" "|" _header_list "${_headers}")
+  set(_registry ${_dir}/${target}_registry.cpp)
+  add_custom_command(
+    OUTPUT ${_registry}
+    COMMAND
+      ${CMAKE_COMMAND} "-DDOLFINX_FORMS_HEADERS=${_header_list}"
+      "-DDOLFINX_FORMS_OUTPUT=${_registry}" -P ${_DOLFINX_FORMS_SCRIPT}
+    VERBATIM
+    DEPENDS ${_headers} ${_DOLFINX_FORMS_SCRIPT}
+    COMMENT "Generate form registry for ${target}"
+  )
+
+  add_library(${target} ${_type} ${_sources} ${_registry})
+  target_include_directories(${target} PUBLIC $<BUILD_INTERFACE:${_dir}>)
+  target_link_libraries(${target} PUBLIC dolfinx)
+  target_compile_features(${target} PUBLIC cxx_std_20)
+  set_target_properties(${target} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+endfunction()
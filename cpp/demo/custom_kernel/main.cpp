@@ -122,28 +122,23 @@ double assemble_vector0(std::shared_ptr<const fem::FunctionSpace<T>> V,
 /// be important for performance for lightweight kernels.
 ///
 /// @tparam T Scalar type.
-/// @param g mesh geometry.
-/// @param dofmap dofmap.
+/// @param V Function space.
 /// @param kernel Element kernel to execute.
 /// @param cells Cells to execute the kernel over.
 /// @return Frobenius norm squared of the matrix.
 template <std::floating_point T>
-double assemble_matrix1(const mesh::Geometry<T>& g, const fem::DofMap& dofmap,
+double assemble_matrix1(std::shared_ptr<const fem::FunctionSpace<T>> V,
                         auto kernel, std::span<const std::int32_t> cells)
 {
-  auto sp = la::SparsityPattern(dofmap.index_map->comm(),
-                                {dofmap.index_map, dofmap.index_map},
-                                {dofmap.index_map_bs(), dofmap.index_map_bs()});
-  fem::sparsitybuild::cells(sp, {cells, cells}, {dofmap, dofmap});
+  auto dofmap = V->dofmap();
+  auto sp = la::SparsityPattern(
+      V->mesh()->comm(), {dofmap->index_map, dofmap->index_map},
+      {dofmap->index_map_bs(), dofmap->index_map_bs()});
+  fem::sparsitybuild::cells(sp, {cells, cells}, {*dofmap, *dofmap});
   sp.finalize();
   la::MatrixCSR<T> A(sp);
-  auto ident = [](auto, auto, auto, auto) {}; // DOF permutation not required
   common::Timer timer("Assembler1 lambda (matrix)");
-  md::mdspan<const T, md::extents<std::size_t, md::dynamic_extent, 3>> x(
-      g.x().data(), g.x().size() / 3, 3);
-  fem::impl::assemble_cells<T>(
-      A.mat_add_values(), g.dofmap(), x, cells, {dofmap.map(), 1, cells}, ident,
-      {dofmap.map(), 1, cells}, ident, {}, {}, kernel, {}, {}, {}, {});
+  fem::assemble_matrix_cells<T>(A.mat_add_values(), *V, *V, cells, kernel);
   A.scatter_rev();
   return A.squared_norm();
 }
@@ -154,22 +149,17 @@ double assemble_matrix1(const mesh::Geometry<T>& g, const fem::DofMap& dofmap,
 /// be important for performance for lightweight kernels.
 ///
 /// @tparam T Scalar type.
-/// @param g mesh geometry.
-/// @param dofmap dofmap.
+/// @param V Function space.
 /// @param kernel Element kernel to execute.
 /// @param cells Cells to execute the kernel over.
 /// @return l2 norm squared of the vector.
 template <std::floating_point T>
-double assemble_vector1(const mesh::Geometry<T>& g, const fem::DofMap& dofmap,
+double assemble_vector1(std::shared_ptr<const fem::FunctionSpace<T>> V,
                         auto kernel, const std::vector<std::int32_t>& cells)
 {
-  la::Vector<T> b(dofmap.index_map, 1);
-  md::mdspan<const T, md::extents<std::size_t, md::dynamic_extent, 3>> x(
-      g.x().data(), g.x().size() / 3, 3);
+  la::Vector<T> b(V->dofmap()->index_map, 1);
   common::Timer timer("Assembler1 lambda (vector)");
-  fem::impl::assemble_cells<T, 1>([](auto, auto, auto, auto) {},
-                                  b.mutable_array(), g.dofmap(), x, cells,
-                                  {dofmap.map(), 1, cells}, kernel, {}, {}, {});
+  fem::assemble_vector_cells<T>(b.mutable_array(), *V, cells, kernel);
   b.scatter_rev(std::plus<T>());
   return la::squared_norm(b);
 }
@@ -265,8 +255,8 @@ void assemble(MPI_Comm comm)
   // supports efficient inlining of the kernel in the assembler. This
   // can give a significant performance improvement for lightweight
   // kernels.
-  assemble_matrix1<T>(mesh->geometry(), *V->dofmap(), kernel_a, cells);
-  assemble_vector1<T>(mesh->geometry(), *V->dofmap(), kernel_L, cells);
+  assemble_matrix1<T>(V, kernel_a, cells);
+  assemble_vector1<T>(V, kernel_L, cells);
 
   list_timings(comm);
 }
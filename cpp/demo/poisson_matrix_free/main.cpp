@@ -50,88 +50,12 @@
 #include <dolfinx.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/fem/Constant.h>
+#include <dolfinx/la/krylov.h>
 #include <memory>
 #include <petscsystypes.h>
 
 using namespace dolfinx;
 
-namespace linalg
-{
-/// @brief Compute vector r = alpha * x + y.
-/// @param[out] r
-/// @param[in] alpha
-/// @param[in] x
-/// @param[in] y
-void axpy(auto&& r, auto alpha, auto&& x, auto&& y)
-{
-  std::ranges::transform(x.array(), y.array(), r.mutable_array().begin(),
-                         [alpha](auto x, auto y) { return alpha * x + y; });
-}
-
-/// @brief Solve problem A.x = b using the conjugate gradient (CG)
-/// method.
-///
-/// @param[in, out] x Solution vector, may be set to an initial guess
-/// hence no zeroed.
-/// @param[in] b Right-hand side vector.
-/// @param[in] action Function that computes the action of the linear
-/// operator on a vector.
-/// @param[in] kmax Maximum number of iterations
-/// @param[in] rtol Relative tolerances for convergence
-/// @return Number of CG iterations.
-/// @pre The ghost values of `x` and `b` must be updated before this
-/// function is called.
-int cg(auto& x, auto& b, auto action, int kmax = 50, double rtol = 1e-8)
-{
-  using T = typename std::decay_t<decltype(x)>::value_type;
-
-  // Create working vectors
-  la::Vector r(b), y(b);
-
-  // Compute initial residual r0 = b - Ax0
-  action(x, y);
-  axpy(r, T(-1), y, b);
-
-  // Create p work vector
-  la::Vector p(r);
-
-  // Iterations of CG
-  auto rnorm0 = la::squared_norm(r);
-  auto rtol2 = rtol * rtol;
-  auto rnorm = rnorm0;
-  int k = 0;
-  while (k < kmax)
-  {
-    ++k;
-
-    // Compute y = A p
-    action(p, y);
-
-    // Compute alpha = r.r/p.y
-    T alpha = rnorm / la::inner_product(p, y);
-
-    // Update x (x <- x + alpha*p)
-    axpy(x, alpha, p, x);
-
-    // Update r (r <- r - alpha*y)
-    axpy(r, -alpha, y, r);
-
-    // Update residual norm
-    auto rnorm_new = la::squared_norm(r);
-    T beta = rnorm_new / rnorm;
-    rnorm = rnorm_new;
-
-    if (rnorm / rnorm0 < rtol2)
-      break;
-
-    // Update p (p <- beta * p + r)
-    axpy(p, beta, p, r);
-  }
-
-  return k;
-}
-} // namespace linalg
-
 template <typename T, std::floating_point U>
 void solver(MPI_Comm comm)
 {
@@ -200,6 +124,9 @@ void solver(MPI_Comm comm)
   // Create function for computing the action of A on x (y = Ax)
   auto action = [&M, &ui, &bc, &coeff, &constants](auto& x, auto& y)
   {
+    // Update ghost values of x
+    x.scatter_fwd();
+
     // Zero y
     y.set(0.0);
 
@@ -216,14 +143,11 @@ void solver(MPI_Comm comm)
 
     // Accumulate ghost values
     y.scatter_rev(std::plus<T>());
-
-    // Update ghost values
-    y.scatter_fwd();
   };
 
   // Compute solution using the CG method
   auto u = std::make_shared<fem::Function<T>>(V);
-  int num_it = linalg::cg(*u->x(), b, action, 200, 1e-6);
+  int num_it = la::cg(*u->x(), b, action, 200, 1e-6);
 
   // Set BC values in the solution vectors
   bc->set(u->x()->mutable_array(), std::nullopt, T(1));
@@ -0,0 +1,313 @@
+// ```text
+// Copyright (C) 2026 The DOLFINx developers
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+// ```
+
+// # Weak and strong scaling driver
+//
+// This demo is a harness for parallel scaling tests. It illustrates
+// how to:
+//
+// * Create a box mesh with a prescribed number of degrees-of-freedom
+//   per process (weak scaling) or in total (strong scaling)
+// * Assemble, solve and write the solution of a Poisson problem with
+//   PETSc or with the native DOLFINx linear algebra
+// * Time the phases of a program with named {cpp:class}`Timer`s and
+//   report the timings, reduced over the processes, in JSON format
+//
+// The Poisson equation $-\nabla^{2} u = f$ is solved on the unit cube
+// with $u = 0$ on the boundary and $f = 1$, using P1 elements on a
+// tetrahedral mesh.
+//
+// The problem is configured with the command line options
+//
+// * `-ndofs <n>`: Number of degrees-of-freedom per process (weak
+//   scaling) or in total (strong scaling). Default 50000.
+// * `-scaling <weak|strong>`: Type of scaling test. Default `weak`.
+// * `-solver <petsc|native>`: Solve with a PETSc Krylov solver
+//   (conjugate gradients with algebraic multigrid by default, which can
+//   be changed with the usual PETSc options, e.g. `-pc_type hypre`) or
+//   with the native conjugate gradient solver {cpp:func}`la::cg` applied
+//   to a {cpp:class}`la::MatrixCSR`. Default `petsc`.
+// * `-rtol <tol>`: Relative tolerance of the solver. Default `1e-8`.
+// * `-output <file>`: File to write the results to, in addition to
+//   the standard output.
+// * `-write_solution <bool>`: Write the solution to an XDMF file.
+//   Default `true`.
+//
+// For example, a weak scaling test with one million
+// degrees-of-freedom per process on 64 processes is run by
+//
+// ```shell
+// mpirun -n 64 ./demo_scaling -ndofs 1000000 -output weak_64.json
+// ```
+//
+// The results include the number of processes, the problem size, the
+// number of solver iterations and, for each phase, the minimum,
+// average and maximum wall time over the processes.
+//
+// ## UFL form file
+//
+// The UFL file is implemented in
+// {download}`demo_scaling/poisson.py`.
+// ````{admonition} UFL form implemented in python
+// :class: dropdown
+// ![ufl-code]
+// ````
+//
+// ## C++ program
+
+#include "poisson.h"
+#include <algorithm>
+#include <array>
+#include <basix/finite-element.h>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx.h>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/petsc.h>
+#include <dolfinx/io/XDMFFile.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/krylov.h>
+#include <dolfinx/la/petsc.h>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <petscksp.h>
+#include <petscmat.h>
+#include <petscsys.h>
+#include <petscsystypes.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace dolfinx;
+using T = PetscScalar;
+using U = typename dolfinx::scalar_value_t<T>;
+
+// The phases of the program are timed with named timers. The times are
+// accumulated by the {cpp:class}`TimeLogger`, and are reduced over
+// the processes for the results.
+
+namespace
+{
+const std::array<std::string, 6> phases
+    = {"create mesh",     "create function space", "assemble matrix",
+       "assemble vector", "solve",                 "write solution"};
+
+// Name of the timer of a phase
+std::string timer_name(int phase) { return "Scaling: " + phases[phase]; }
+
+// Get a string option from the PETSc options database
+std::string get_option(const std::string& name, const std::string& value)
+{
+  std::array<char, PETSC_MAX_PATH_LEN> buffer;
+  PetscBool set = PETSC_FALSE;
+  PetscOptionsGetString(nullptr, nullptr, name.c_str(), buffer.data(),
+                        buffer.size(), &set);
+  return set ? std::string(buffer.data()) : value;
+}
+
+// Minimum, average and maximum over the processes of the time of each
+// phase that has been run, as JSON
+std::string phase_timings(MPI_Comm comm)
+{
+  const int size = dolfinx::MPI::size(comm);
+  const auto timings = dolfinx::timings();
+  std::vector<std::string> entries;
+  for (std::size_t i = 0; i < phases.size(); ++i)
+  {
+    auto it = timings.find(timer_name(i));
+    if (it == timings.end())
+      continue;
+
+    double t = it->second.second.count();
+    double tmin, tmax, tsum;
+    MPI_Allreduce(&t, &tmin, 1, MPI_DOUBLE, MPI_MIN, comm);
+    MPI_Allreduce(&t, &tmax, 1, MPI_DOUBLE, MPI_MAX, comm);
+    MPI_Allreduce(&t, &tsum, 1, MPI_DOUBLE, MPI_SUM, comm);
+    entries.push_back(
+        std::format("    \"{}\": {{\"min\": {}, \"avg\": {}, \"max\": {}}}",
+                    phases[i], tmin, tsum / size, tmax));
+  }
+
+  std::string json;
+  for (std::size_t i = 0; i < entries.size(); ++i)
+    json += (i == 0 ? "\n" : ",\n") + entries[i];
+  return json;
+}
+} // namespace
+
+// The number of cells in each direction of the box mesh is computed
+// from the requested number of degrees-of-freedom. For P1 elements on
+// a mesh with $n^3$ cubes (each split into six tetrahedra), there are
+// $(n + 1)^3$ degrees-of-freedom.
+
+int main(int argc, char* argv[])
+{
+  dolfinx::init_logging(argc, argv);
+  PetscInitialize(&argc, &argv, nullptr, nullptr);
+
+  {
+    MPI_Comm comm = MPI_COMM_WORLD;
+    const int size = dolfinx::MPI::size(comm);
+
+    PetscInt ndofs = 50000;
+    PetscOptionsGetInt(nullptr, nullptr, "-ndofs", &ndofs, nullptr);
+    PetscBool write_solution = PETSC_TRUE;
+    PetscOptionsGetBool(nullptr, nullptr, "-write_solution", &write_solution,
+                        nullptr);
+    const std::string scaling = get_option("-scaling", "weak");
+    const std::string solver = get_option("-solver", "petsc");
+    const std::string output = get_option("-output", "");
+    PetscReal rtol = 1e-8;
+    PetscOptionsGetReal(nullptr, nullptr, "-rtol", &rtol, nullptr);
+    if (scaling != "weak" and scaling != "strong")
+      throw std::runtime_error("Unknown scaling type: " + scaling);
+    if (solver != "petsc" and solver != "native")
+      throw std::runtime_error("Unknown solver: " + solver);
+
+    const double ndofs_total
+        = scaling == "weak" ? double(ndofs) * size : double(ndofs);
+    const std::int64_t n = std::max<std::int64_t>(
+        1, std::llround(std::cbrt(ndofs_total)) - 1);
+
+    // Create mesh and function space
+    common::Timer t0(timer_name(0));
+    auto mesh = std::make_shared<mesh::Mesh<U>>(mesh::create_box<U>(
+        comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {n, n, n},
+        mesh::CellType::tetrahedron,
+        mesh::create_cell_partitioner(mesh::GhostMode::none)));
+    t0.stop();
+
+    common::Timer t1(timer_name(1));
+    auto element = basix::create_element<U>(
+        basix::element::family::P, basix::cell::type::tetrahedron, 1,
+        basix::element::lagrange_variant::unset,
+        basix::element::dpc_variant::unset, false);
+    auto V
+        = std::make_shared<fem::FunctionSpace<U>>(fem::create_functionspace<U>(
+            mesh, std::make_shared<fem::FiniteElement<U>>(element)));
+    t1.stop();
+
+    // Define variational forms and the boundary condition
+    auto f = std::make_shared<fem::Constant<T>>(1.0);
+    fem::Form<T> a
+        = fem::create_form<T>(*form_poisson_a, {V, V}, {}, {}, {}, {});
+    fem::Form<T> L
+        = fem::create_form<T>(*form_poisson_L, {V}, {}, {{"f", f}}, {}, {});
+
+    mesh->topology_mutable()->create_connectivity(2, 3);
+    std::vector facets = mesh::exterior_facet_indices(*mesh->topology());
+    std::vector bdofs = fem::locate_dofs_topological(
+        *V->mesh()->topology_mutable(), *V->dofmap(), 2, facets);
+    fem::DirichletBC<T> bc(0.0, bdofs, V);
+
+    // Assemble the right-hand side
+    common::Timer t3(timer_name(3));
+    la::Vector<T> b(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+    b.set(0.0);
+    fem::assemble_vector(b.mutable_array(), L);
+    fem::apply_lifting<T, U>(b.mutable_array(), {a}, {{bc}}, {}, T(1));
+    b.scatter_rev(std::plus<T>());
+    bc.set(b.mutable_array(), std::nullopt);
+    t3.stop();
+
+    // Assemble the matrix and solve, with either PETSc or the native
+    // linear algebra
+    auto u = std::make_shared<fem::Function<T>>(V);
+    int num_iterations = 0;
+    if (solver == "petsc")
+    {
+      common::Timer t2(timer_name(2));
+      la::petsc::Matrix A(fem::petsc::create_matrix(a), false);
+      MatZeroEntries(A.mat());
+      fem::assemble_matrix(
+          la::petsc::Matrix::set_block_fn(A.mat(), ADD_VALUES), a, {bc});
+      MatAssemblyBegin(A.mat(), MAT_FLUSH_ASSEMBLY);
+      MatAssemblyEnd(A.mat(), MAT_FLUSH_ASSEMBLY);
+      fem::set_diagonal<T>(la::petsc::Matrix::set_fn(A.mat(), INSERT_VALUES),
+                           *V, {bc});
+      MatAssemblyBegin(A.mat(), MAT_FINAL_ASSEMBLY);
+      MatAssemblyEnd(A.mat(), MAT_FINAL_ASSEMBLY);
+      t2.stop();
+
+      // Conjugate gradients with algebraic multigrid, unless set
+      // otherwise on the command line
+      common::Timer t4(timer_name(4));
+      la::petsc::KrylovSolver ksp(comm);
+      KSPSetType(ksp.ksp(), KSPCG);
+      PC pc;
+      KSPGetPC(ksp.ksp(), &pc);
+      PCSetType(pc, PCGAMG);
+      la::petsc::options::set("ksp_rtol", rtol);
+      ksp.set_from_options();
+      ksp.set_operator(A.mat());
+      la::petsc::Vector _u(la::petsc::create_vector_wrap(*u->x()), false);
+      la::petsc::Vector _b(la::petsc::create_vector_wrap(b), false);
+      num_iterations = ksp.solve(_u.vec(), _b.vec());
+      u->x()->scatter_fwd();
+      t4.stop();
+    }
+    else
+    {
+      common::Timer t2(timer_name(2));
+      la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+      sp.finalize();
+      la::MatrixCSR<T> A(sp);
+      fem::assemble_matrix(A.mat_add_values(), a, {bc});
+      fem::set_diagonal<T>(A.mat_set_values(), *V, {bc});
+      A.scatter_rev();
+      t2.stop();
+
+      // Unpreconditioned conjugate gradients
+      common::Timer t4(timer_name(4));
+      auto action = [&A](la::Vector<T>& x, la::Vector<T>& y)
+      {
+        x.scatter_fwd();
+        y.set(0.0);
+        A.mult(x, y);
+      };
+      num_iterations = la::cg(*u->x(), b, action, 10000, rtol);
+      t4.stop();
+    }
+
+    // Write the solution
+    if (write_solution)
+    {
+      common::Timer t5(timer_name(5));
+      io::XDMFFile file(comm, "u.xdmf", "w");
+      file.write_mesh(*mesh);
+      file.write_function(*u, 0.0);
+      t5.stop();
+    }
+
+    // Report the results, reduced over the processes, in JSON format
+    std::string timings = phase_timings(comm);
+    if (dolfinx::MPI::rank(comm) == 0)
+    {
+      auto map = V->dofmap()->index_map;
+      std::string json = std::format(
+          "{{\n  \"num_processes\": {},\n  \"scaling\": \"{}\",\n"
+          "  \"solver\": \"{}\",\n  \"num_cells\": {},\n"
+          "  \"num_dofs\": {},\n  \"num_iterations\": {},\n"
+          "  \"timings\": {{{}\n  }}\n}}\n",
+          size, scaling, solver,
+          mesh->topology()->index_map(3)->size_global(), map->size_global(),
+          num_iterations, timings);
+      std::cout << json;
+      if (!output.empty())
+        std::ofstream(output) << json;
+    }
+  }
+
+  PetscFinalize();
+
+  return 0;
+}
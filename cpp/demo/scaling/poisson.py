@@ -0,0 +1,20 @@
+# UFL input for the scaling demo
+# ==============================
+#
+# Poisson equation on a tetrahedral mesh with P1 elements, as used for
+# the DOLFINx weak and strong scaling tests.
+
+from basix.ufl import element
+from ufl import Constant, FunctionSpace, Mesh, TestFunction, TrialFunction, dx, grad, inner
+
+e = element("Lagrange", "tetrahedron", 1)
+coord_element = element("Lagrange", "tetrahedron", 1, shape=(3,))
+mesh = Mesh(coord_element)
+V = FunctionSpace(mesh, e)
+
+u = TrialFunction(V)
+v = TestFunction(V)
+f = Constant(mesh)
+
+a = inner(grad(u), grad(v)) * dx
+L = inner(f, v) * dx
@@ -0,0 +1,94 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "CommStats.h"
+#include "MPI.h"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+std::atomic<bool> comm_stats::impl::enabled = false;
+
+namespace
+{
+std::mutex mutex;
+std::map<std::string, comm_stats::Statistics, std::less<>> stats;
+
+// Statistics of a region
+comm_stats::Statistics& get(std::string_view region)
+{
+  if (auto it = stats.find(region); it != stats.end())
+    return it->second;
+  else
+    return stats.emplace(region, comm_stats::Statistics()).first->second;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+void comm_stats::start() { impl::enabled = true; }
+//-----------------------------------------------------------------------------
+void comm_stats::stop() { impl::enabled = false; }
+//-----------------------------------------------------------------------------
+void comm_stats::clear()
+{
+  std::scoped_lock lock(mutex);
+  stats.clear();
+}
+//-----------------------------------------------------------------------------
+void comm_stats::record(std::string_view region, std::int64_t messages_sent,
+                        std::int64_t bytes_sent,
+                        std::int64_t messages_received,
+                        std::int64_t bytes_received, std::int64_t neighbours)
+{
+  std::scoped_lock lock(mutex);
+  Statistics& s = get(region);
+  s.calls += 1;
+  s.messages_sent += messages_sent;
+  s.bytes_sent += bytes_sent;
+  s.messages_received += messages_received;
+  s.bytes_received += bytes_received;
+  s.max_neighbours = std::max(s.max_neighbours, neighbours);
+}
+//-----------------------------------------------------------------------------
+void comm_stats::record_wait(std::string_view region, double seconds)
+{
+  std::scoped_lock lock(mutex);
+  get(region).wait += seconds;
+}
+//-----------------------------------------------------------------------------
+std::map<std::string, comm_stats::Statistics> comm_stats::statistics()
+{
+  std::scoped_lock lock(mutex);
+  return {stats.begin(), stats.end()};
+}
+//-----------------------------------------------------------------------------
+Table comm_stats::table()
+{
+  Table table("Summary of MPI communication");
+  for (auto& [region, s] : statistics())
+  {
+    table.set(region, "calls", double(s.calls));
+    table.set(region, "messages sent", double(s.messages_sent));
+    table.set(region, "messages recv", double(s.messages_received));
+    table.set(region, "bytes sent", double(s.bytes_sent));
+    table.set(region, "bytes recv", double(s.bytes_received));
+    table.set(region, "max neighbours", double(s.max_neighbours));
+    table.set(region, "wait (s)", s.wait);
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
+void comm_stats::list(MPI_Comm comm, Table::Reduction reduction)
+{
+  const std::string str = "\n" + table().reduce(comm, reduction).str();
+  if (dolfinx::MPI::rank(comm) == 0)
+    std::cout << str << std::endl;
+}
+//-----------------------------------------------------------------------------
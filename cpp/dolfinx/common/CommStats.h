@@ -0,0 +1,112 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Table.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mpi.h>
+#include <string>
+#include <string_view>
+
+/// @brief Statistics of the MPI communication of the library.
+///
+/// When enabled, the halo exchanges of common::Scatterer and the data
+/// distribution and graph discovery functions in dolfinx::MPI record
+/// the number of messages and bytes that they send and receive, the
+/// number of neighbours and the time that they wait for communication
+/// to complete. The statistics are accumulated by region, e.g.
+/// `Scatterer::scatter_fwd`, and can be reduced over the ranks to find
+/// imbalanced halos.
+///
+/// The basic usage is
+/// \code{.cpp}
+/// common::comm_stats::start();
+/// /* .... */
+/// common::comm_stats::list(MPI_COMM_WORLD, Table::Reduction::max);
+/// \endcode
+namespace dolfinx::common::comm_stats
+{
+/// @brief Accumulated statistics of a region.
+struct Statistics
+{
+  /// Number of calls.
+  std::int64_t calls = 0;
+
+  /// Number of messages sent.
+  std::int64_t messages_sent = 0;
+
+  /// Number of messages received.
+  std::int64_t messages_received = 0;
+
+  /// Number of bytes sent.
+  std::int64_t bytes_sent = 0;
+
+  /// Number of bytes received.
+  std::int64_t bytes_received = 0;
+
+  /// Largest number of neighbour ranks (sources and destinations) of a
+  /// call.
+  std::int64_t max_neighbours = 0;
+
+  /// Time in seconds waiting for communication to complete.
+  double wait = 0;
+};
+
+/// @privatesection
+namespace impl
+{
+/// If true, statistics are recorded.
+extern std::atomic<bool> enabled;
+} // namespace impl
+
+/// @brief Check if the statistics are recorded.
+inline bool enabled() noexcept
+{
+  return impl::enabled.load(std::memory_order_relaxed);
+}
+
+/// @brief Start recording statistics.
+void start();
+
+/// @brief Stop recording statistics. The recorded statistics are kept.
+void stop();
+
+/// @brief Discard the recorded statistics.
+void clear();
+
+/// @brief Record a call of a region.
+/// @param[in] region Name of the region.
+/// @param[in] messages_sent Number of messages sent.
+/// @param[in] bytes_sent Number of bytes sent.
+/// @param[in] messages_received Number of messages received.
+/// @param[in] bytes_received Number of bytes received.
+/// @param[in] neighbours Number of neighbour ranks.
+void record(std::string_view region, std::int64_t messages_sent,
+            std::int64_t bytes_sent, std::int64_t messages_received,
+            std::int64_t bytes_received, std::int64_t neighbours);
+
+/// @brief Record time waiting for the communication of a region to
+/// complete.
+/// @param[in] region Name of the region.
+/// @param[in] seconds Wait time.
+void record_wait(std::string_view region, double seconds);
+
+/// @brief Recorded statistics.
+/// @return Statistics of each region.
+std::map<std::string, Statistics> statistics();
+
+/// @brief Return the recorded statistics of this rank in a Table.
+Table table();
+
+/// @brief List the recorded statistics, reduced over ranks.
+/// @param[in] comm MPI communicator.
+/// @param[in] reduction Reduction over the ranks (min, max or
+/// average).
+void list(MPI_Comm comm, Table::Reduction reduction);
+} // namespace dolfinx::common::comm_stats
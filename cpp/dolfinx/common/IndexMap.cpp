@@ -7,6 +7,7 @@
 
 #include "IndexMap.h"
 #include "sort.h"
+#include "threads.h"
 #include <algorithm>
 #include <cstdint>
 #include <functional>
@@ -20,6 +21,15 @@ using namespace dolfinx::common;
 
 namespace
 {
+/// @brief Position of a global index in the ghost hash table of an
+/// IndexMap (multiplicative hashing).
+/// @param[in] index Global index.
+/// @param[in] shift 64 minus the base-2 logarithm of the table size.
+std::size_t ghost_hash(std::int64_t index, int shift)
+{
+  return (static_cast<std::uint64_t>(index) * 0x9e3779b97f4a7c15) >> shift;
+}
+
 /// @brief Given source ranks (ranks that own indices ghosted by the
 /// calling rank), compute ranks that ghost indices owned by the calling
 /// rank.
@@ -816,6 +826,23 @@ common::create_sub_index_map(const IndexMap& imap,
                              std::span<const std::int32_t> indices,
                              IndexMapOrder order, bool allow_owner_change)
 {
+  // If no process includes ghost indices, the submap indices are the
+  // owned indices in `indices` and the submap has no ghosts. Detecting
+  // this case requires a single reduction, and avoids the creation of
+  // neighbourhood communicators and the ownership exchange.
+  {
+    std::int32_t has_ghosts
+        = !indices.empty() and indices.back() >= imap.size_local();
+    int ierr = MPI_Allreduce(MPI_IN_PLACE, &has_ghosts, 1, MPI_INT32_T,
+                             MPI_MAX, imap.comm());
+    dolfinx::MPI::check_error(imap.comm(), ierr);
+    if (!has_ghosts)
+    {
+      return {IndexMap(imap.comm(), indices.size()),
+              std::vector<std::int32_t>(indices.begin(), indices.end())};
+    }
+  }
+
   // Compute the owned, ghost, and ghost owners of submap indices.
   // NOTE: All indices are local and numbered w.r.t. the original (imap)
   // index map
@@ -913,6 +940,25 @@ IndexMap::IndexMap(MPI_Comm comm, std::int32_t local_size,
                         comm, &request);
   dolfinx::MPI::check_error(_comm.comm(), ierr);
 
+  // Build the ghost hash table while the reductions are in progress.
+  // The table is at most half full.
+  if (!_ghosts.empty())
+  {
+    int bits = 1;
+    while ((std::size_t(1) << bits) < 2 * _ghosts.size())
+      ++bits;
+    _ghost_table_shift = 64 - bits;
+    _ghost_table.resize(std::size_t(1) << bits, {-1, -1});
+    const std::size_t mask = _ghost_table.size() - 1;
+    for (std::size_t i = 0; i < _ghosts.size(); ++i)
+    {
+      std::size_t pos = ghost_hash(_ghosts[i], _ghost_table_shift);
+      while (_ghost_table[pos].first != -1)
+        pos = (pos + 1) & mask;
+      _ghost_table[pos] = {_ghosts[i], i + local_size};
+    }
+  }
+
   // Wait for MPI_Iexscan to complete (get offset)
   ierr = MPI_Wait(&request_scan, MPI_STATUS_IGNORE);
   dolfinx::MPI::check_error(_comm.comm(), ierr);
@@ -943,49 +989,62 @@ std::span<const std::int64_t> IndexMap::ghosts() const noexcept
 }
 //-----------------------------------------------------------------------------
 void IndexMap::local_to_global(std::span<const std::int32_t> local,
-                               std::span<std::int64_t> global) const
+                               std::span<std::int64_t> global,
+                               int num_threads) const
 {
   assert(local.size() <= global.size());
   const std::int32_t local_size = _local_range[1] - _local_range[0];
-  std::ranges::transform(
-      local, global.begin(),
-      [local_size, local_range = _local_range[0], &ghosts = _ghosts](auto local)
+  const std::int64_t offset = _local_range[0];
+  common::parallel_for(
+      local.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
       {
-        if (local < local_size)
-          return local_range + local;
-        else
+        for (std::size_t i = i0; i < i1; ++i)
         {
-          assert((local - local_size) < (int)ghosts.size());
-          return ghosts[local - local_size];
+          const std::int32_t idx = local[i];
+          if (idx < local_size)
+            global[i] = offset + idx;
+          else
+          {
+            assert((idx - local_size) < (int)_ghosts.size());
+            global[i] = _ghosts[idx - local_size];
+          }
         }
       });
 }
 //-----------------------------------------------------------------------------
 void IndexMap::global_to_local(std::span<const std::int64_t> global,
-                               std::span<std::int32_t> local) const
+                               std::span<std::int32_t> local,
+                               int num_threads) const
 {
-  const std::int32_t local_size = _local_range[1] - _local_range[0];
-  std::vector<std::pair<std::int64_t, std::int32_t>> global_to_local(
-      _ghosts.size());
-  for (std::size_t i = 0; i < _ghosts.size(); ++i)
-    global_to_local[i] = {_ghosts[i], i + local_size};
-
-  std::ranges::sort(global_to_local);
-  std::ranges::transform(
-      global, local.begin(),
-      [range = _local_range,
-       &global_to_local](std::int64_t index) -> std::int32_t
+  assert(global.size() <= local.size());
+  const std::array<std::int64_t, 2> range = _local_range;
+  const std::size_t mask = _ghost_table.size() - 1;
+  common::parallel_for(
+      global.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
       {
-        if (index >= range[0] and index < range[1])
-          return index - range[0];
-        else
+        for (std::size_t i = i0; i < i1; ++i)
         {
-          auto it = std::ranges::lower_bound(global_to_local, index,
-                                             std::ranges::less(),
-                                             [](auto e) { return e.first; });
-          return (it != global_to_local.end() and it->first == index)
-                     ? it->second
-                     : -1;
+          const std::int64_t index = global[i];
+          if (index >= range[0] and index < range[1])
+          {
+            local[i] = index - range[0];
+            continue;
+          }
+
+          local[i] = -1;
+          if (_ghost_table.empty())
+            continue;
+          for (std::size_t pos = ghost_hash(index, _ghost_table_shift);
+               _ghost_table[pos].first != -1; pos = (pos + 1) & mask)
+          {
+            if (_ghost_table[pos].first == index)
+            {
+              local[i] = _ghost_table[pos].second;
+              break;
+            }
+          }
         }
       });
 }
@@ -1333,3 +1392,10 @@ std::array<double, 2> IndexMap::imbalance() const
   return imbalance;
 }
 //-----------------------------------------------------------------------------
+std::size_t IndexMap::memory_usage() const
+{
+  return sizeof(std::int64_t) * _ghosts.size()
+         + sizeof(int) * (_owners.size() + _src.size() + _dest.size())
+         + sizeof(decltype(_ghost_table)::value_type) * _ghost_table.size();
+}
+//-----------------------------------------------------------------------------
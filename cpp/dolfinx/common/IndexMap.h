@@ -7,6 +7,7 @@
 #pragma once
 
 #include "IndexMap.h"
+#include <cstddef>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <memory>
@@ -196,16 +197,26 @@ public:
   /// @brief Compute global indices for array of local indices.
   /// @param[in] local Local indices
   /// @param[out] global The global indices
+  /// @param[in] num_threads Number of threads. The array is split into
+  /// contiguous blocks that are converted concurrently.
   void local_to_global(std::span<const std::int32_t> local,
-                       std::span<std::int64_t> global) const;
+                       std::span<std::int64_t> global,
+                       int num_threads = 1) const;
 
   /// @brief Compute local indices for array of global indices.
+  ///
+  /// Owned indices are converted by an offset, and ghost indices are
+  /// found in a hash table of the ghosts that is built with the map.
+  ///
   /// @param[in] global Global indices
   /// @param[out] local The local of the corresponding global index in
   /// 'global'. Returns -1 if the local index does not exist on this
   /// process.
+  /// @param[in] num_threads Number of threads. The array is split into
+  /// contiguous blocks that are converted concurrently.
   void global_to_local(std::span<const std::int64_t> global,
-                       std::span<std::int32_t> local) const;
+                       std::span<std::int32_t> local,
+                       int num_threads = 1) const;
 
   /// @brief Build list of indices with global indexing.
   /// @return The global index for all local indices `(0, 1, 2, ...)` on
@@ -272,6 +283,11 @@ public:
   /// element) and the imbalance in ghost indices (second element).
   std::array<double, 2> imbalance() const;
 
+  /// @brief Memory used by the index map.
+  /// @return Number of bytes of the ghost, owner and neighbour rank
+  /// arrays, and of the ghost lookup table.
+  std::size_t memory_usage() const;
+
 private:
   // Range of indices (global) owned by this process
   std::array<std::int64_t, 2> _local_range;
@@ -293,5 +309,12 @@ private:
 
   // Set of ranks ghost owned indices
   std::vector<int> _dest;
+
+  // Open addressing (linear probing) hash table of (global index,
+  // local index) of the ghosts, for global-to-local lookups. Empty slots
+  // have global index -1. The size is a power of two, 2^(64 -
+  // _ghost_table_shift).
+  std::vector<std::pair<std::int64_t, std::int32_t>> _ghost_table;
+  int _ghost_table_shift = 64;
 };
 } // namespace dolfinx::common
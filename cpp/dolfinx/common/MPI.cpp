@@ -5,8 +5,11 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "MPI.h"
+#include <cmath>
 #include <dolfinx/common/log.h>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 //-----------------------------------------------------------------------------
 dolfinx::MPI::Comm::Comm(MPI_Comm comm, bool duplicate)
@@ -91,6 +94,26 @@ void dolfinx::MPI::check_error(MPI_Comm comm, int code)
   }
 }
 //-----------------------------------------------------------------------------
+std::pair<dolfinx::MPI::Comm, int> dolfinx::MPI::split(MPI_Comm comm,
+                                                       int num_groups)
+{
+  const int size = dolfinx::MPI::size(comm);
+  if (num_groups < 1 or num_groups > size)
+  {
+    throw std::runtime_error("Number of groups (" + std::to_string(num_groups)
+                             + ") must be between 1 and the communicator "
+                               "size ("
+                             + std::to_string(size) + ").");
+  }
+
+  const int rank = dolfinx::MPI::rank(comm);
+  const int group = dolfinx::MPI::index_owner(num_groups, rank, size);
+  MPI_Comm group_comm;
+  int err = MPI_Comm_split(comm, group, rank, &group_comm);
+  dolfinx::MPI::check_error(comm, err);
+  return {Comm(group_comm, false), group};
+}
+//-----------------------------------------------------------------------------
 std::vector<int>
 dolfinx::MPI::compute_graph_edges_pcx(MPI_Comm comm, std::span<const int> edges)
 {
@@ -167,6 +190,8 @@ dolfinx::MPI::compute_graph_edges_nbx(MPI_Comm comm, std::span<const int> edges,
       "of input edges: {}",
       static_cast<int>(edges.size()));
 
+  const double t0 = common::comm_stats::enabled() ? MPI_Wtime() : -1;
+
   // Start non-blocking synchronised send
   std::vector<MPI_Request> send_requests(edges.size());
   std::vector<std::byte> send_buffer(edges.size());
@@ -234,6 +259,339 @@ dolfinx::MPI::compute_graph_edges_nbx(MPI_Comm comm, std::span<const int> edges,
                "of discovered edges {}",
                static_cast<int>(other_ranks.size()));
 
+  if (t0 >= 0)
+  {
+    const std::string_view region = "MPI::compute_graph_edges_nbx";
+    common::comm_stats::record(region, edges.size(), edges.size(),
+                               other_ranks.size(), other_ranks.size(),
+                               edges.size() + other_ranks.size());
+    common::comm_stats::record_wait(region, MPI_Wtime() - t0);
+  }
+
+  return other_ranks;
+}
+//-----------------------------------------------------------------------------
+std::vector<int>
+dolfinx::MPI::compute_graph_edges_node(MPI_Comm comm,
+                                       std::span<const int> edges)
+{
+  spdlog::info(
+      "Computing communication graph edges (using node-aware NBX "
+      "algorithm). Number of input edges: {}",
+      static_cast<int>(edges.size()));
+
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Create communicators for the ranks on the same node and for the
+  // node leaders (rank 0 on each node)
+  MPI_Comm comm_node;
+  int err = MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank,
+                                MPI_INFO_NULL, &comm_node);
+  dolfinx::MPI::check_error(comm, err);
+  const int node_rank = dolfinx::MPI::rank(comm_node);
+  const int node_size = dolfinx::MPI::size(comm_node);
+  MPI_Comm comm_leaders;
+  err = MPI_Comm_split(comm, node_rank == 0 ? 0 : MPI_UNDEFINED, rank,
+                       &comm_leaders);
+  dolfinx::MPI::check_error(comm, err);
+
+  // Get the node leader (rank on comm_leaders) of each rank
+  int leader = node_rank == 0 ? dolfinx::MPI::rank(comm_leaders) : -1;
+  err = MPI_Bcast(&leader, 1, MPI_INT, 0, comm_node);
+  dolfinx::MPI::check_error(comm, err);
+  std::vector<int> leaders(size);
+  err = MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, comm);
+  dolfinx::MPI::check_error(comm, err);
+
+  // Gather the (destination, source) edges of the ranks on the node on
+  // the node leader
+  std::vector<int> send_edges;
+  send_edges.reserve(2 * edges.size());
+  for (int e : edges)
+    send_edges.insert(send_edges.end(), {e, rank});
+  const int num_send = send_edges.size();
+  std::vector<int> node_counts(node_size), node_ranks(node_size);
+  err = MPI_Gather(&num_send, 1, MPI_INT, node_counts.data(), 1, MPI_INT, 0,
+                   comm_node);
+  dolfinx::MPI::check_error(comm, err);
+  err = MPI_Gather(&rank, 1, MPI_INT, node_ranks.data(), 1, MPI_INT, 0,
+                   comm_node);
+  dolfinx::MPI::check_error(comm, err);
+  std::vector<int> node_displs(node_size + 1, 0);
+  std::partial_sum(node_counts.begin(), node_counts.end(),
+                   std::next(node_displs.begin()));
+  std::vector<int> node_edges(node_rank == 0 ? node_displs.back() : 0);
+  err = MPI_Gatherv(send_edges.data(), num_send, MPI_INT, node_edges.data(),
+                    node_counts.data(), node_displs.data(), MPI_INT, 0,
+                    comm_node);
+  dolfinx::MPI::check_error(comm, err);
+
+  // On the leader, exchange edges with the leaders of the destination
+  // nodes and compute the data to scatter to each rank on the node
+  std::vector<int> scatter_data, scatter_counts(node_size, 0);
+  if (node_rank == 0)
+  {
+    // Sort edges by destination node leader
+    std::vector<std::array<int, 3>> node_out;
+    node_out.reserve(node_edges.size() / 2);
+    for (std::size_t i = 0; i < node_edges.size(); i += 2)
+    {
+      node_out.push_back(
+          {leaders[node_edges[i]], node_edges[i], node_edges[i + 1]});
+    }
+    std::ranges::sort(node_out);
+
+    // Pack (destination, source) edges for each other node leader, and
+    // keep edges with a destination on this node
+    std::vector<int> dest, send_sizes, send_buffer;
+    std::vector<std::array<int, 2>> node_in;
+    for (auto [l, d, s] : node_out)
+    {
+      if (l == leader)
+        node_in.push_back({d, s});
+      else
+      {
+        if (dest.empty() or dest.back() != l)
+        {
+          dest.push_back(l);
+          send_sizes.push_back(0);
+        }
+        send_sizes.back() += 2;
+        send_buffer.insert(send_buffer.end(), {d, s});
+      }
+    }
+
+    const std::vector<int> src
+        = dolfinx::MPI::compute_graph_edges_nbx(comm_leaders, dest);
+    MPI_Comm neigh_comm;
+    err = MPI_Dist_graph_create_adjacent(
+        comm_leaders, src.size(), src.data(), MPI_UNWEIGHTED, dest.size(),
+        dest.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &neigh_comm);
+    dolfinx::MPI::check_error(comm, err);
+
+    std::vector<int> recv_sizes(src.size());
+    send_sizes.reserve(1);
+    recv_sizes.reserve(1);
+    err = MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT,
+                                recv_sizes.data(), 1, MPI_INT, neigh_comm);
+    dolfinx::MPI::check_error(comm, err);
+
+    std::vector<int> send_disp(send_sizes.size() + 1, 0);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     std::next(send_disp.begin()));
+    std::vector<int> recv_disp(recv_sizes.size() + 1, 0);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_disp.begin()));
+    std::vector<int> recv_buffer(recv_disp.back());
+    err = MPI_Neighbor_alltoallv(send_buffer.data(), send_sizes.data(),
+                                 send_disp.data(), MPI_INT, recv_buffer.data(),
+                                 recv_sizes.data(), recv_disp.data(), MPI_INT,
+                                 neigh_comm);
+    dolfinx::MPI::check_error(comm, err);
+    err = MPI_Comm_free(&neigh_comm);
+    dolfinx::MPI::check_error(comm, err);
+
+    for (std::size_t i = 0; i < recv_buffer.size(); i += 2)
+      node_in.push_back({recv_buffer[i], recv_buffer[i + 1]});
+
+    // Sort incoming edges by the node rank of the destination
+    std::vector<std::array<int, 2>> rank_to_node(node_size);
+    for (int i = 0; i < node_size; ++i)
+      rank_to_node[i] = {node_ranks[i], i};
+    std::ranges::sort(rank_to_node);
+    for (auto& [d, s] : node_in)
+    {
+      auto it = std::ranges::lower_bound(rank_to_node, std::array{d, 0});
+      assert(it != rank_to_node.end() and (*it)[0] == d);
+      d = (*it)[1];
+    }
+    std::ranges::sort(node_in);
+
+    scatter_data.reserve(node_in.size());
+    for (auto [d, s] : node_in)
+    {
+      scatter_data.push_back(s);
+      ++scatter_counts[d];
+    }
+  }
+
+  // Scatter the source ranks to the ranks on the node
+  int num_recv = 0;
+  err = MPI_Scatter(scatter_counts.data(), 1, MPI_INT, &num_recv, 1, MPI_INT,
+                    0, comm_node);
+  dolfinx::MPI::check_error(comm, err);
+  std::vector<int> scatter_displs(node_size + 1, 0);
+  std::partial_sum(scatter_counts.begin(), scatter_counts.end(),
+                   std::next(scatter_displs.begin()));
+  std::vector<int> other_ranks(num_recv);
+  err = MPI_Scatterv(scatter_data.data(), scatter_counts.data(),
+                     scatter_displs.data(), MPI_INT, other_ranks.data(),
+                     num_recv, MPI_INT, 0, comm_node);
+  dolfinx::MPI::check_error(comm, err);
+
+  if (comm_leaders != MPI_COMM_NULL)
+  {
+    err = MPI_Comm_free(&comm_leaders);
+    dolfinx::MPI::check_error(comm, err);
+  }
+  err = MPI_Comm_free(&comm_node);
+  dolfinx::MPI::check_error(comm, err);
+
+  spdlog::info("Finished graph edge discovery using node-aware NBX "
+               "algorithm. Number of discovered edges {}",
+               static_cast<int>(other_ranks.size()));
+
   return other_ranks;
 }
 //-----------------------------------------------------------------------------
+std::pair<std::vector<int>, std::vector<std::byte>>
+dolfinx::MPI::alltoallv_grid(MPI_Comm comm, std::span<const int> dest,
+                             std::span<const std::byte> data,
+                             std::size_t row_size)
+{
+  assert(data.size() == dest.size() * row_size);
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Arrange ranks in a grid with q columns, and create communicators
+  // for the row and column of the caller. The rank of the caller on
+  // the row (column) communicator is its column (row) in the grid.
+  const int q = std::ceil(std::sqrt(static_cast<double>(size)));
+  MPI_Comm comm_row, comm_col;
+  int err = MPI_Comm_split(comm, rank / q, rank, &comm_row);
+  dolfinx::MPI::check_error(comm, err);
+  err = MPI_Comm_split(comm, rank % q, rank, &comm_col);
+  dolfinx::MPI::check_error(comm, err);
+
+  // Destination and origin rank of each row
+  std::vector<int> ranks;
+  ranks.reserve(2 * dest.size());
+  for (int d : dest)
+    ranks.insert(ranks.end(), {d, rank});
+  std::vector<std::byte> rows(data.begin(), data.end());
+
+  MPI_Datatype row_type;
+  err = MPI_Type_contiguous(row_size, MPI_BYTE, &row_type);
+  dolfinx::MPI::check_error(comm, err);
+  err = MPI_Type_commit(&row_type);
+  dolfinx::MPI::check_error(comm, err);
+
+  // Communication statistics
+  const bool stats = common::comm_stats::enabled();
+  std::array<std::int64_t, 5> counts = {0, 0, 0, 0, 0};
+  double wait = 0;
+
+  // Send each row to the rank on a row or column communicator given by
+  // target(d, r), where d is the destination of the row and r is the
+  // rank (of comm) of the caller.
+  auto exchange = [&](MPI_Comm subcomm, auto target)
+  {
+    const int subsize = dolfinx::MPI::size(subcomm);
+    const std::size_t num_rows = ranks.size() / 2;
+    std::vector<int> row_target(num_rows);
+    std::vector<int> send_sizes(subsize, 0);
+    for (std::size_t i = 0; i < num_rows; ++i)
+    {
+      row_target[i] = target(ranks[2 * i]);
+      ++send_sizes[row_target[i]];
+    }
+
+    std::vector<int> send_disp(subsize + 1, 0);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     std::next(send_disp.begin()));
+    std::vector<int> send_ranks(ranks.size());
+    std::vector<std::byte> send_rows(rows.size());
+    {
+      std::vector<int> pos(send_disp.begin(), std::prev(send_disp.end()));
+      for (std::size_t i = 0; i < num_rows; ++i)
+      {
+        int p = pos[row_target[i]]++;
+        send_ranks[2 * p] = ranks[2 * i];
+        send_ranks[2 * p + 1] = ranks[2 * i + 1];
+        std::copy_n(std::next(rows.begin(), i * row_size), row_size,
+                    std::next(send_rows.begin(), p * row_size));
+      }
+    }
+
+    std::vector<int> recv_sizes(subsize);
+    int err = MPI_Alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(),
+                           1, MPI_INT, subcomm);
+    dolfinx::MPI::check_error(comm, err);
+    std::vector<int> recv_disp(subsize + 1, 0);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_disp.begin()));
+
+    if (stats)
+    {
+      auto nonzero = [](auto& sizes)
+      { return std::ranges::count_if(sizes, [](int n) { return n > 0; }); };
+      const std::size_t bytes = row_size + 2 * sizeof(int);
+      counts[0] += nonzero(send_sizes);
+      counts[1] += send_disp.back() * bytes;
+      counts[2] += nonzero(recv_sizes);
+      counts[3] += recv_disp.back() * bytes;
+      counts[4]
+          = std::max(counts[4], nonzero(send_sizes) + nonzero(recv_sizes));
+    }
+    const double t0 = stats ? MPI_Wtime() : 0;
+
+    rows.resize(recv_disp.back() * row_size);
+    err = MPI_Alltoallv(send_rows.data(), send_sizes.data(), send_disp.data(),
+                        row_type, rows.data(), recv_sizes.data(),
+                        recv_disp.data(), row_type, subcomm);
+    dolfinx::MPI::check_error(comm, err);
+
+    // Send the (destination, origin) pairs
+    auto scale = [](auto& x)
+    { std::ranges::transform(x, x.begin(), [](auto e) { return 2 * e; }); };
+    scale(send_sizes);
+    scale(send_disp);
+    scale(recv_sizes);
+    scale(recv_disp);
+    ranks.resize(recv_disp.back());
+    err = MPI_Alltoallv(send_ranks.data(), send_sizes.data(), send_disp.data(),
+                        MPI_INT, ranks.data(), recv_sizes.data(),
+                        recv_disp.data(), MPI_INT, subcomm);
+    dolfinx::MPI::check_error(comm, err);
+    if (stats)
+      wait += MPI_Wtime() - t0;
+  };
+
+  // Rows are sent (1) along the column of the caller to the row of the
+  // destination, and (2) along that row to the destination. If the
+  // intermediate rank in (1) does not exist (the destination is in an
+  // incomplete last row of the grid), the row is instead sent (2) to
+  // the column of the destination and then (3) along the column to the
+  // destination.
+  auto exists = [size, q](int i, int j) { return i * q + j < size; };
+  exchange(comm_col, [&](int d)
+           { return exists(d / q, rank % q) ? d / q : rank / q; });
+  exchange(comm_row, [&](int d) { return d % q; });
+  exchange(comm_col, [&](int d) { return d / q; });
+
+  if (stats)
+  {
+    const std::string_view region = "MPI::alltoallv_grid";
+    common::comm_stats::record(region, counts[0], counts[1], counts[2],
+                               counts[3], counts[4]);
+    common::comm_stats::record_wait(region, wait);
+  }
+
+  err = MPI_Type_free(&row_type);
+  dolfinx::MPI::check_error(comm, err);
+  err = MPI_Comm_free(&comm_row);
+  dolfinx::MPI::check_error(comm, err);
+  err = MPI_Comm_free(&comm_col);
+  dolfinx::MPI::check_error(comm, err);
+
+  std::vector<int> src(ranks.size() / 2);
+  for (std::size_t i = 0; i < src.size(); ++i)
+  {
+    assert(ranks[2 * i] == rank);
+    src[i] = ranks[2 * i + 1];
+  }
+
+  return {std::move(src), std::move(rows)};
+}
+//-----------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "CommStats.h"
 #include "Timer.h"
 #include "log.h"
 #include "types.h"
@@ -13,11 +14,14 @@
 #include <array>
 #include <cassert>
 #include <complex>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <numeric>
 #include <set>
 #include <span>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -37,6 +41,11 @@ enum class tag : int
   consensus_nbx = 1202,
 };
 
+/// Default communicator size from which the post office exchanges in
+/// MPI::distribute_to_postoffice and MPI::distribute_from_postoffice
+/// route data through a grid of ranks (see MPI::alltoallv_grid)
+constexpr int grid_routing_threshold = 16384;
+
 /// @brief A duplicate MPI communicator and manage lifetime of the
 /// communicator.
 class Comm
@@ -81,6 +90,24 @@ int size(MPI_Comm comm);
 /// @param[in] code Error code returned by an MPI function call.
 void check_error(MPI_Comm comm, int code);
 
+/// @brief Split a communicator into groups of contiguous ranks.
+///
+/// The ranks of `comm` are divided into `num_groups` groups of almost
+/// equal size, with the ranks in MPI::local_range(g, size, num_groups)
+/// forming group `g`. Each group can then work on an independent
+/// problem, e.g. a load case of a parameter study, with less
+/// communication than on `comm`. Data can be redistributed to the
+/// groups using mesh::create_group_mesh.
+///
+/// @note Collective.
+///
+/// @param[in] comm Communicator to split.
+/// @param[in] num_groups Number of groups. It must be in `[1, size]`,
+/// where `size` is the size of `comm`.
+/// @return Communicator for the group of the caller and the index of
+/// the group.
+std::pair<Comm, int> split(MPI_Comm comm, int num_groups);
+
 /// @brief Return local range for the calling process, partitioning the
 /// global [0, N - 1] range across all ranks into partitions of almost
 /// equal size.
@@ -186,6 +213,60 @@ std::vector<int>
 compute_graph_edges_nbx(MPI_Comm comm, std::span<const int> edges,
                         int tag = static_cast<int>(tag::consensus_nbx));
 
+/// @brief Determine incoming graph edges using a node-aware
+/// (hierarchical) consensus algorithm.
+///
+/// Given a list of outgoing edges (destination ranks) from this rank,
+/// this function returns the incoming edges (source ranks) to this rank.
+/// The edges of all ranks on a shared-memory node are gathered on a
+/// node leader rank, and the edge discovery and exchange is performed
+/// between the node leaders using the NBX algorithm (see
+/// MPI::compute_graph_edges_nbx). The node leaders then distribute the
+/// incoming edges to the ranks on their node. The number of messages
+/// between nodes is reduced from one per edge to at most one per pair
+/// of nodes.
+///
+/// @note An array the size of the communicator, holding the node
+/// leader of each rank, is constructed.
+///
+/// @note The order of the returned ranks is not deterministic.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator
+/// @param[in] edges Edges (ranks) from this rank (the caller).
+/// @return Ranks that have defined edges from them to this rank.
+std::vector<int> compute_graph_edges_node(MPI_Comm comm,
+                                          std::span<const int> edges);
+
+/// @brief Send rows of data to destination ranks by routing through a
+/// two-dimensional grid of ranks.
+///
+/// The ranks are arranged in a grid with \f$\lceil\sqrt{p}\rceil\f$
+/// columns, where \f$p\f$ is the size of `comm`. A row is first sent
+/// along the grid column of the caller to the grid row of its
+/// destination, and then along the grid row to the destination. Each
+/// rank therefore communicates with \f$O(\sqrt{p})\f$ ranks, and the
+/// memory used for sizes and displacements is \f$O(\sqrt{p})\f$,
+/// independent of the communication pattern. This is suitable for
+/// dense communication patterns at large rank counts, for which
+/// neighbourhood communication approaches all-to-all communication.
+///
+/// @note The order of the received rows is not deterministic.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] dest Destination rank of each row.
+/// @param[in] data Data to send (row-major, `dest.size()` rows of
+/// `row_size` bytes).
+/// @param[in] row_size Size (in bytes) of a row.
+/// @return (0) Origin rank of each received row and (1) the received
+/// rows.
+std::pair<std::vector<int>, std::vector<std::byte>>
+alltoallv_grid(MPI_Comm comm, std::span<const int> dest,
+               std::span<const std::byte> data, std::size_t row_size);
+
 /// @brief Distribute row data to 'post office' ranks.
 ///
 /// This function takes row-wise data that is distributed across
@@ -202,6 +283,13 @@ compute_graph_edges_nbx(MPI_Comm comm, std::span<const int> edges,
 /// @param[in] rank_offset The rank offset such that global index of
 /// local row `i` in `x` is `rank_offset + i`. It is usually computed
 /// using `MPI_Exscan`.
+/// @param[in] node_aware If `true`, the communication graph is
+/// computed using MPI::compute_graph_edges_node, otherwise using
+/// MPI::compute_graph_edges_nbx.
+/// @param[in] grid_threshold Size of `comm` from which the data is
+/// routed through a grid of ranks using MPI::alltoallv_grid instead of
+/// using neighbourhood communication. Grid routing is not used if the
+/// value is not positive.
 /// @returns (0) local indices of my post office data and (1) the data
 /// (row-major). It **does not** include rows that are in `x`, i.e. rows
 /// for which the calling process is the post office.
@@ -210,7 +298,8 @@ std::pair<std::vector<std::int32_t>,
           std::vector<typename std::remove_reference_t<typename U::value_type>>>
 distribute_to_postoffice(MPI_Comm comm, const U& x,
                          std::array<std::int64_t, 2> shape,
-                         std::int64_t rank_offset);
+                         std::int64_t rank_offset, bool node_aware = false,
+                         int grid_threshold = grid_routing_threshold);
 
 /// @brief Distribute rows of a rectangular data array from post office
 /// ranks to ranks where they are required.
@@ -231,13 +320,19 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
 /// @param[in] rank_offset The rank offset such that global index of
 /// local row `i` in `x` is `rank_offset + i`. It is usually computed
 /// using `MPI_Exscan` on `comm1` from MPI::distribute_data.
+/// @param[in] node_aware If `true`, the communication graphs are
+/// computed using MPI::compute_graph_edges_node, otherwise using
+/// MPI::compute_graph_edges_nbx.
+/// @param[in] grid_threshold Size of `comm` from which data is routed
+/// through a grid of ranks (see MPI::distribute_to_postoffice).
 /// @return The data for each index in `indices` (row-major storage).
 /// @pre `shape1 > 0`.
 template <typename U>
 std::vector<typename std::remove_reference_t<typename U::value_type>>
 distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
                            const U& x, std::array<std::int64_t, 2> shape,
-                           std::int64_t rank_offset);
+                           std::int64_t rank_offset, bool node_aware = false,
+                           int grid_threshold = grid_routing_threshold);
 
 /// @brief Distribute rows of a rectangular data array to ranks where
 /// they are required (scalable version).
@@ -257,12 +352,20 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
 /// rows is assumed to be the local index plus the offset for this rank
 /// on `comm1`.
 /// @param[in] shape1 The number of columns of the data array `x`.
+/// @param[in] node_aware If `true`, the communication graphs are
+/// computed using the node-aware MPI::compute_graph_edges_node. This
+/// reduces the number of messages between nodes for large process
+/// counts.
+/// @param[in] grid_threshold Size of `comm0` from which data is routed
+/// through a grid of ranks (see MPI::distribute_to_postoffice).
 /// @return The data for each index in `indices` (row-major storage).
 /// @pre `shape1 > 0`
 template <typename U>
 std::vector<typename std::remove_reference_t<typename U::value_type>>
 distribute_data(MPI_Comm comm0, std::span<const std::int64_t> indices,
-                MPI_Comm comm1, const U& x, int shape1);
+                MPI_Comm comm1, const U& x, int shape1,
+                bool node_aware = false,
+                int grid_threshold = grid_routing_threshold);
 
 template <typename T>
 struct dependent_false : std::false_type
@@ -307,13 +410,135 @@ MAP_TO_MPI_TYPE(std::uint64_t, MPI_UINT64_T)
 /// @endcond
 /// @}
 
+/// @brief Handle of a non-blocking reduction over the processes of a
+/// communicator (see MPI::iallreduce).
+///
+/// The reduced values are available once the reduction has completed,
+/// so the latency of the reduction can be overlapped with local work
+/// between starting the reduction and calling get(). The destructor
+/// waits for an incomplete reduction.
+///
+/// @tparam T Value type.
+template <typename T>
+class Reduction
+{
+public:
+  /// @brief Start a reduction.
+  /// @param[in] values Local values to reduce.
+  /// @param[in] op Reduction operation, e.g. `MPI_SUM`.
+  /// @param[in] comm Communicator.
+  Reduction(std::vector<T> values, MPI_Op op, MPI_Comm comm)
+      : _values(std::move(values))
+  {
+    int err = MPI_Iallreduce(MPI_IN_PLACE, _values.data(), _values.size(),
+                             mpi_t<T>, op, comm, &_request);
+    dolfinx::MPI::check_error(comm, err);
+  }
+
+  /// Move constructor. The reduction buffer is not moved in memory.
+  Reduction(Reduction&& r) noexcept
+      : _values(std::move(r._values)),
+        _request(std::exchange(r._request, MPI_REQUEST_NULL))
+  {
+  }
+
+  // Copy constructor (deleted)
+  Reduction(const Reduction&) = delete;
+
+  /// Destructor
+  ~Reduction() { wait(); }
+
+  /// Move assignment. Waits for an incomplete reduction of this
+  /// object.
+  Reduction& operator=(Reduction&& r) noexcept
+  {
+    wait();
+    _values = std::move(r._values);
+    _request = std::exchange(r._request, MPI_REQUEST_NULL);
+    return *this;
+  }
+
+  // Copy assignment (deleted)
+  Reduction& operator=(const Reduction&) = delete;
+
+  /// @brief Check, without blocking, if the reduction has completed.
+  bool test()
+  {
+    if (_request != MPI_REQUEST_NULL)
+    {
+      int flag = 0;
+      MPI_Test(&_request, &flag, MPI_STATUS_IGNORE);
+    }
+    return _request == MPI_REQUEST_NULL;
+  }
+
+  /// @brief Wait for the reduction to complete.
+  void wait()
+  {
+    if (_request != MPI_REQUEST_NULL)
+      MPI_Wait(&_request, MPI_STATUS_IGNORE);
+  }
+
+  /// @brief Reduced values. Waits for the reduction to complete.
+  std::span<const T> get()
+  {
+    wait();
+    return _values;
+  }
+
+  /// @brief First reduced value, e.g. of the reduction of a single
+  /// value. Waits for the reduction to complete.
+  T value()
+  {
+    wait();
+    return _values.front();
+  }
+
+private:
+  // Values, reduced in-place
+  std::vector<T> _values;
+
+  // Request handle
+  MPI_Request _request = MPI_REQUEST_NULL;
+};
+
+/// @brief Start a non-blocking reduction of values over all processes
+/// of a communicator.
+///
+/// @note Collective MPI operation.
+/// @param[in] x Local values.
+/// @param[in] op Reduction operation, e.g. `MPI_SUM`.
+/// @param[in] comm Communicator.
+/// @return Handle to test or wait for the reduction, which holds the
+/// reduced values on completion.
+template <typename T>
+Reduction<T> iallreduce(std::span<const T> x, MPI_Op op, MPI_Comm comm)
+{
+  return Reduction<T>(std::vector<T>(x.begin(), x.end()), op, comm);
+}
+
+/// @brief Start a non-blocking reduction of a value over all processes
+/// of a communicator (see iallreduce()).
+///
+/// @note Collective MPI operation.
+/// @param[in] x Local value.
+/// @param[in] op Reduction operation, e.g. `MPI_SUM`.
+/// @param[in] comm Communicator.
+/// @return Handle to test or wait for the reduction.
+template <typename T>
+Reduction<T> iallreduce(T x, MPI_Op op, MPI_Comm comm)
+{
+  return Reduction<T>(std::vector<T>{x}, op, comm);
+}
+
 //---------------------------------------------------------------------------
 template <typename U>
 std::pair<std::vector<std::int32_t>,
           std::vector<typename std::remove_reference_t<typename U::value_type>>>
 distribute_to_postoffice(MPI_Comm comm, const U& x,
                          std::array<std::int64_t, 2> shape,
-                         std::int64_t rank_offset)
+                         std::int64_t rank_offset, bool node_aware,
+                         int grid_threshold)
 {
   assert(rank_offset >= 0 or x.empty());
   using T = typename std::remove_reference_t<typename U::value_type>;
@@ -345,6 +570,46 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
   }
   std::ranges::sort(dest_to_index);
 
+  const std::int64_t r0 = MPI::local_range(rank, shape[0], size)[0];
+  if (grid_threshold > 0 and size >= grid_threshold)
+  {
+    // Route rows (global index, row of x) to the post offices through a
+    // grid of ranks
+    const std::size_t row_size = sizeof(std::int64_t) + shape[1] * sizeof(T);
+    std::vector<int> dest(dest_to_index.size());
+    std::vector<std::byte> send_buffer(row_size * dest_to_index.size());
+    for (std::size_t i = 0; i < dest_to_index.size(); ++i)
+    {
+      auto [d, pos] = dest_to_index[i];
+      dest[i] = d;
+      std::int64_t idx = pos + rank_offset;
+      std::byte* row = send_buffer.data() + i * row_size;
+      std::memcpy(row, &idx, sizeof(std::int64_t));
+      std::memcpy(row + sizeof(std::int64_t),
+                  &*std::next(x.begin(), pos * shape[1]),
+                  shape[1] * sizeof(T));
+    }
+    auto [src, recv_buffer]
+        = MPI::alltoallv_grid(comm, dest, send_buffer, row_size);
+
+    // Unpack local indices and data
+    const std::size_t num_rows = src.size();
+    std::vector<std::int32_t> index_local(num_rows);
+    std::vector<T> recv_buffer_data(shape[1] * num_rows);
+    for (std::size_t i = 0; i < num_rows; ++i)
+    {
+      const std::byte* row = recv_buffer.data() + i * row_size;
+      std::int64_t idx;
+      std::memcpy(&idx, row, sizeof(std::int64_t));
+      index_local[i] = idx - r0;
+      std::memcpy(recv_buffer_data.data() + shape[1] * i,
+                  row + sizeof(std::int64_t), shape[1] * sizeof(T));
+    }
+
+    spdlog::debug("Completed send data to post offices.");
+    return {index_local, recv_buffer_data};
+  }
+
   // Build list of neighbour src ranks and count number of items (rows
   // of x) to receive from each src post office (by neighbourhood rank)
   std::vector<int> dest;
@@ -377,7 +642,9 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
   }
 
   // Determine source ranks
-  const std::vector<int> src = MPI::compute_graph_edges_nbx(comm, dest);
+  const std::vector<int> src = node_aware
+                                   ? MPI::compute_graph_edges_node(comm, dest)
+                                   : MPI::compute_graph_edges_nbx(comm, dest);
   spdlog::info(
       "Number of neighbourhood source ranks in distribute_to_postoffice: {}",
       static_cast<int>(src.size()));
@@ -427,6 +694,7 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
                    std::next(recv_disp.begin()));
 
   // Send/receive global indices
+  const double t0 = common::comm_stats::enabled() ? MPI_Wtime() : -1;
   std::vector<std::int64_t> recv_buffer_index(recv_disp.back());
   err = MPI_Neighbor_alltoallv(
       send_buffer_index.data(), num_items_per_dest.data(), send_disp.data(),
@@ -444,6 +712,19 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
       compound_type, recv_buffer_data.data(), num_items_recv.data(),
       recv_disp.data(), compound_type, neigh_comm);
   dolfinx::MPI::check_error(comm, err);
+  if (t0 >= 0)
+  {
+    // Each item is sent as an index and a row of x
+    const std::string_view region = "MPI::distribute_to_postoffice";
+    const std::size_t bytes = sizeof(std::int64_t) + shape[1] * sizeof(T);
+    common::comm_stats::record(
+        region, std::ranges::count_if(num_items_per_dest, [](int n)
+                                      { return n > 0; }),
+        send_disp.back() * bytes,
+        std::ranges::count_if(num_items_recv, [](int n) { return n > 0; }),
+        recv_disp.back() * bytes, src.size() + dest.size());
+    common::comm_stats::record_wait(region, MPI_Wtime() - t0);
+  }
   err = MPI_Type_free(&compound_type);
   dolfinx::MPI::check_error(comm, err);
   err = MPI_Comm_free(&neigh_comm);
@@ -452,7 +733,6 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
   spdlog::debug("Completed send data to post offices.");
 
   // Convert to local indices
-  const std::int64_t r0 = MPI::local_range(rank, shape[0], size)[0];
   std::vector<std::int32_t> index_local(recv_buffer_index.size());
   std::ranges::transform(recv_buffer_index, index_local.begin(),
                          [r0](auto idx) { return idx - r0; });
@@ -464,7 +744,8 @@ template <typename U>
 std::vector<typename std::remove_reference_t<typename U::value_type>>
 distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
                            const U& x, std::array<std::int64_t, 2> shape,
-                           std::int64_t rank_offset)
+                           std::int64_t rank_offset, bool node_aware,
+                           int grid_threshold)
 {
   assert(rank_offset >= 0 or x.empty());
   using T = typename std::remove_reference_t<typename U::value_type>;
@@ -482,9 +763,42 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
   // Send receive x data to post office (only for rows that need to be
   // communicated)
   auto [post_indices, post_x] = dolfinx::MPI::distribute_to_postoffice(
-      comm, x, {shape[0], shape[1]}, rank_offset);
+      comm, x, {shape[0], shape[1]}, rank_offset, node_aware, grid_threshold);
   assert(post_indices.size() == post_x.size() / shape[1]);
 
+  // Build map from local index to post_indices position. Set to -1 for
+  // data that was already on this rank and was therefore was not
+  // sent/received via a postoffice.
+  const std::array<std::int64_t, 2> postoffice_range
+      = dolfinx::MPI::local_range(rank, shape[0], size);
+  std::vector<std::int32_t> post_indices_map(
+      postoffice_range[1] - postoffice_range[0], -1);
+  for (std::size_t i = 0; i < post_indices.size(); ++i)
+  {
+    assert(post_indices[i] < (int)post_indices_map.size());
+    post_indices_map[post_indices[i]] = i;
+  }
+
+  // Get the row for a global index that is either in x or in my 'post
+  // bag'
+  auto post_row = [&](std::int64_t index) -> const T*
+  {
+    if (index >= rank_offset and index < (rank_offset + shape0_local))
+    {
+      // I already had this index before any communication
+      std::int32_t local_index = index - rank_offset;
+      return &*std::next(x.begin(), shape[1] * local_index);
+    }
+    else
+    {
+      // Take from my 'post bag'
+      auto local_index = index - postoffice_range[0];
+      std::int32_t pos = post_indices_map[local_index];
+      assert(pos != -1);
+      return post_x.data() + shape[1] * pos;
+    }
+  };
+
   // 1. Send request to post office ranks for data
 
   // Build list of (src, global index, global, index position) for each
@@ -498,140 +812,178 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
   }
   std::ranges::sort(src_to_index);
 
-  // Build list is neighbour src ranks and count number of items (rows
-  // of x) to receive from each src post office (by neighbourhood rank)
-  std::vector<std::int32_t> num_items_per_src;
-  std::vector<int> src;
+  // Received data for each entry in src_to_index
+  std::vector<T> recv_buffer_data(shape[1] * src_to_index.size());
+  if (grid_threshold > 0 and size >= grid_threshold)
   {
-    auto it = src_to_index.begin();
-    while (it != src_to_index.end())
+    // Send requests (global index, position in src_to_index) to the
+    // post offices through a grid of ranks
+    constexpr std::size_t req_size
+        = sizeof(std::int64_t) + sizeof(std::int32_t);
+    std::vector<int> src(src_to_index.size());
+    std::vector<std::byte> send_buffer(req_size * src_to_index.size());
+    for (std::size_t i = 0; i < src_to_index.size(); ++i)
     {
-      src.push_back(std::get<0>(*it));
-      auto it1
-          = std::find_if(it, src_to_index.end(), [r = src.back()](auto& idx)
-                         { return std::get<0>(idx) != r; });
-      num_items_per_src.push_back(std::distance(it, it1));
-      it = it1;
+      auto [s, idx, pos] = src_to_index[i];
+      src[i] = s;
+      std::int32_t p = i;
+      std::byte* row = send_buffer.data() + i * req_size;
+      std::memcpy(row, &idx, sizeof(std::int64_t));
+      std::memcpy(row + sizeof(std::int64_t), &p, sizeof(std::int32_t));
     }
-  }
-
-  // Determine 'delivery' destination ranks (ranks that want data from
-  // me)
-  const std::vector<int> dest
-      = dolfinx::MPI::compute_graph_edges_nbx(comm, src);
-  spdlog::info(
-      "Neighbourhood destination ranks from post office in "
-      "distribute_data (rank, num dests, num dests/mpi_size): {}, {}, {}",
-      rank, static_cast<int>(dest.size()),
-      static_cast<double>(dest.size()) / size);
-
-  // Create neighbourhood communicator for sending data to post offices
-  // (src), and receiving data form my send my post office
-  MPI_Comm neigh_comm0;
-  int err = MPI_Dist_graph_create_adjacent(
-      comm, dest.size(), dest.data(), MPI_UNWEIGHTED, src.size(), src.data(),
-      MPI_UNWEIGHTED, MPI_INFO_NULL, false, &neigh_comm0);
-  dolfinx::MPI::check_error(comm, err);
-
-  // Communicate number of requests to each source
-  std::vector<int> num_items_recv(dest.size());
-  num_items_per_src.reserve(1);
-  num_items_recv.reserve(1);
-  err = MPI_Neighbor_alltoall(num_items_per_src.data(), 1, MPI_INT,
-                              num_items_recv.data(), 1, MPI_INT, neigh_comm0);
-  dolfinx::MPI::check_error(comm, err);
-
-  // Prepare send/receive displacements
-  std::vector<std::int32_t> send_disp = {0};
-  std::partial_sum(num_items_per_src.begin(), num_items_per_src.end(),
-                   std::back_inserter(send_disp));
-  std::vector<std::int32_t> recv_disp = {0};
-  std::partial_sum(num_items_recv.begin(), num_items_recv.end(),
-                   std::back_inserter(recv_disp));
-
-  // Pack my requested indices (global) in send buffer ready to send to
-  // post offices
-  assert(send_disp.back() == (int)src_to_index.size());
-  std::vector<std::int64_t> send_buffer_index(src_to_index.size());
-  std::ranges::transform(src_to_index, send_buffer_index.begin(),
-                         [](auto x) { return std::get<1>(x); });
-
-  // Prepare the receive buffer
-  std::vector<std::int64_t> recv_buffer_index(recv_disp.back());
-  err = MPI_Neighbor_alltoallv(
-      send_buffer_index.data(), num_items_per_src.data(), send_disp.data(),
-      MPI_INT64_T, recv_buffer_index.data(), num_items_recv.data(),
-      recv_disp.data(), MPI_INT64_T, neigh_comm0);
-  dolfinx::MPI::check_error(comm, err);
-
-  err = MPI_Comm_free(&neigh_comm0);
-  dolfinx::MPI::check_error(comm, err);
-
-  // 2. Send data (rows of x) from post office back to requesting ranks
-  //    (transpose of the preceding communication pattern operation)
+    auto [dest, requests] = alltoallv_grid(comm, src, send_buffer, req_size);
+
+    // Send data (position, row of x) from post office back to
+    // requesting ranks
+    const std::size_t data_size
+        = sizeof(std::int32_t) + shape[1] * sizeof(T);
+    send_buffer.resize(data_size * dest.size());
+    for (std::size_t i = 0; i < dest.size(); ++i)
+    {
+      const std::byte* req = requests.data() + i * req_size;
+      std::byte* row = send_buffer.data() + i * data_size;
+      std::int64_t index;
+      std::memcpy(&index, req, sizeof(std::int64_t));
+      std::memcpy(row, req + sizeof(std::int64_t), sizeof(std::int32_t));
+      std::memcpy(row + sizeof(std::int32_t), post_row(index),
+                  shape[1] * sizeof(T));
+    }
+    auto [_, data] = alltoallv_grid(comm, dest, send_buffer, data_size);
 
-  // Build map from local index to post_indices position. Set to -1 for
-  // data that was already on this rank and was therefore was not
-  // sent/received via a postoffice.
-  const std::array<std::int64_t, 2> postoffice_range
-      = dolfinx::MPI::local_range(rank, shape[0], size);
-  std::vector<std::int32_t> post_indices_map(
-      postoffice_range[1] - postoffice_range[0], -1);
-  for (std::size_t i = 0; i < post_indices.size(); ++i)
-  {
-    assert(post_indices[i] < (int)post_indices_map.size());
-    post_indices_map[post_indices[i]] = i;
+    for (std::size_t i = 0; i < data.size() / data_size; ++i)
+    {
+      const std::byte* row = data.data() + i * data_size;
+      std::int32_t pos;
+      std::memcpy(&pos, row, sizeof(std::int32_t));
+      std::memcpy(recv_buffer_data.data() + shape[1] * pos,
+                  row + sizeof(std::int32_t), shape[1] * sizeof(T));
+    }
   }
-
-  // Build send buffer
-  std::vector<T> send_buffer_data(shape[1] * recv_disp.back());
-  for (std::size_t p = 0; p < recv_disp.size() - 1; ++p)
+  else
   {
-    int offset = recv_disp[p];
-    for (std::int32_t i = recv_disp[p]; i < recv_disp[p + 1]; ++i)
+    // Build list is neighbour src ranks and count number of items (rows
+    // of x) to receive from each src post office (by neighbourhood
+    // rank)
+    std::vector<std::int32_t> num_items_per_src;
+    std::vector<int> src;
     {
-      std::int64_t index = recv_buffer_index[i];
-      if (index >= rank_offset and index < (rank_offset + shape0_local))
+      auto it = src_to_index.begin();
+      while (it != src_to_index.end())
       {
-        // I already had this index before any communication
-        std::int32_t local_index = index - rank_offset;
-        std::copy_n(std::next(x.begin(), shape[1] * local_index), shape[1],
-                    std::next(send_buffer_data.begin(), shape[1] * offset));
+        src.push_back(std::get<0>(*it));
+        auto it1
+            = std::find_if(it, src_to_index.end(), [r = src.back()](auto& idx)
+                           { return std::get<0>(idx) != r; });
+        num_items_per_src.push_back(std::distance(it, it1));
+        it = it1;
       }
-      else
-      {
-        // Take from my 'post bag'
-        auto local_index = index - postoffice_range[0];
-        std::int32_t pos = post_indices_map[local_index];
-        assert(pos != -1);
-        std::copy_n(std::next(post_x.begin(), shape[1] * pos), shape[1],
-                    std::next(send_buffer_data.begin(), shape[1] * offset));
-      }
-
-      ++offset;
     }
-  }
 
-  err = MPI_Dist_graph_create_adjacent(
-      comm, src.size(), src.data(), MPI_UNWEIGHTED, dest.size(), dest.data(),
-      MPI_UNWEIGHTED, MPI_INFO_NULL, false, &neigh_comm0);
-  dolfinx::MPI::check_error(comm, err);
-
-  MPI_Datatype compound_type0;
-  MPI_Type_contiguous(shape[1], dolfinx::MPI::mpi_t<T>, &compound_type0);
-  MPI_Type_commit(&compound_type0);
+    // Determine 'delivery' destination ranks (ranks that want data from
+    // me)
+    const std::vector<int> dest
+        = node_aware ? dolfinx::MPI::compute_graph_edges_node(comm, src)
+                     : dolfinx::MPI::compute_graph_edges_nbx(comm, src);
+    spdlog::info(
+        "Neighbourhood destination ranks from post office in "
+        "distribute_data (rank, num dests, num dests/mpi_size): {}, {}, {}",
+        rank, static_cast<int>(dest.size()),
+        static_cast<double>(dest.size()) / size);
+
+    // Create neighbourhood communicator for sending data to post
+    // offices (src), and receiving data form my send my post office
+    MPI_Comm neigh_comm0;
+    int err = MPI_Dist_graph_create_adjacent(
+        comm, dest.size(), dest.data(), MPI_UNWEIGHTED, src.size(),
+        src.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &neigh_comm0);
+    dolfinx::MPI::check_error(comm, err);
+
+    // Communicate number of requests to each source
+    std::vector<int> num_items_recv(dest.size());
+    num_items_per_src.reserve(1);
+    num_items_recv.reserve(1);
+    err = MPI_Neighbor_alltoall(num_items_per_src.data(), 1, MPI_INT,
+                                num_items_recv.data(), 1, MPI_INT,
+                                neigh_comm0);
+    dolfinx::MPI::check_error(comm, err);
+
+    // Prepare send/receive displacements
+    std::vector<std::int32_t> send_disp = {0};
+    std::partial_sum(num_items_per_src.begin(), num_items_per_src.end(),
+                     std::back_inserter(send_disp));
+    std::vector<std::int32_t> recv_disp = {0};
+    std::partial_sum(num_items_recv.begin(), num_items_recv.end(),
+                     std::back_inserter(recv_disp));
+
+    // Pack my requested indices (global) in send buffer ready to send
+    // to post offices
+    assert(send_disp.back() == (int)src_to_index.size());
+    std::vector<std::int64_t> send_buffer_index(src_to_index.size());
+    std::ranges::transform(src_to_index, send_buffer_index.begin(),
+                           [](auto x) { return std::get<1>(x); });
+
+    // Prepare the receive buffer
+    const double t0 = common::comm_stats::enabled() ? MPI_Wtime() : -1;
+    std::vector<std::int64_t> recv_buffer_index(recv_disp.back());
+    err = MPI_Neighbor_alltoallv(
+        send_buffer_index.data(), num_items_per_src.data(), send_disp.data(),
+        MPI_INT64_T, recv_buffer_index.data(), num_items_recv.data(),
+        recv_disp.data(), MPI_INT64_T, neigh_comm0);
+    dolfinx::MPI::check_error(comm, err);
+    const double wait0 = t0 >= 0 ? MPI_Wtime() - t0 : 0;
+
+    err = MPI_Comm_free(&neigh_comm0);
+    dolfinx::MPI::check_error(comm, err);
+
+    // 2. Send data (rows of x) from post office back to requesting
+    //    ranks (transpose of the preceding communication pattern
+    //    operation)
+
+    // Build send buffer
+    std::vector<T> send_buffer_data(shape[1] * recv_disp.back());
+    for (std::int32_t i = 0; i < recv_disp.back(); ++i)
+    {
+      std::copy_n(post_row(recv_buffer_index[i]), shape[1],
+                  std::next(send_buffer_data.begin(), shape[1] * i));
+    }
 
-  std::vector<T> recv_buffer_data(shape[1] * send_disp.back());
-  err = MPI_Neighbor_alltoallv(
-      send_buffer_data.data(), num_items_recv.data(), recv_disp.data(),
-      compound_type0, recv_buffer_data.data(), num_items_per_src.data(),
-      send_disp.data(), compound_type0, neigh_comm0);
-  dolfinx::MPI::check_error(comm, err);
+    err = MPI_Dist_graph_create_adjacent(
+        comm, src.size(), src.data(), MPI_UNWEIGHTED, dest.size(),
+        dest.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &neigh_comm0);
+    dolfinx::MPI::check_error(comm, err);
+
+    MPI_Datatype compound_type0;
+    MPI_Type_contiguous(shape[1], dolfinx::MPI::mpi_t<T>, &compound_type0);
+    MPI_Type_commit(&compound_type0);
+
+    const double t1 = t0 >= 0 ? MPI_Wtime() : -1;
+    err = MPI_Neighbor_alltoallv(
+        send_buffer_data.data(), num_items_recv.data(), recv_disp.data(),
+        compound_type0, recv_buffer_data.data(), num_items_per_src.data(),
+        send_disp.data(), compound_type0, neigh_comm0);
+    dolfinx::MPI::check_error(comm, err);
+    if (t1 >= 0)
+    {
+      // Indices are sent to the post offices (src), and rows of x are
+      // sent back to the requesting ranks (dest)
+      const std::string_view region = "MPI::distribute_from_postoffice";
+      auto nonzero = [](auto& sizes)
+      { return std::ranges::count_if(sizes, [](int n) { return n > 0; }); };
+      const std::int64_t n = nonzero(num_items_per_src);
+      const std::int64_t m = nonzero(num_items_recv);
+      const std::size_t ib = sizeof(std::int64_t), xb = shape[1] * sizeof(T);
+      common::comm_stats::record(
+          region, n + m, send_disp.back() * ib + recv_disp.back() * xb, m + n,
+          recv_disp.back() * ib + send_disp.back() * xb,
+          src.size() + dest.size());
+      common::comm_stats::record_wait(region, wait0 + MPI_Wtime() - t1);
+    }
 
-  err = MPI_Type_free(&compound_type0);
-  dolfinx::MPI::check_error(comm, err);
-  err = MPI_Comm_free(&neigh_comm0);
-  dolfinx::MPI::check_error(comm, err);
+    err = MPI_Type_free(&compound_type0);
+    dolfinx::MPI::check_error(comm, err);
+    err = MPI_Comm_free(&neigh_comm0);
+    dolfinx::MPI::check_error(comm, err);
+  }
 
   std::vector<std::int32_t> index_pos_to_buffer(indices.size(), -1);
   for (std::size_t i = 0; i < src_to_index.size(); ++i)
@@ -678,7 +1030,8 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
 template <typename U>
 std::vector<typename std::remove_reference_t<typename U::value_type>>
 distribute_data(MPI_Comm comm0, std::span<const std::int64_t> indices,
-                MPI_Comm comm1, const U& x, int shape1)
+                MPI_Comm comm1, const U& x, int shape1, bool node_aware,
+                int grid_threshold)
 {
   assert(shape1 > 0);
   assert(x.size() % shape1 == 0);
@@ -705,7 +1058,7 @@ distribute_data(MPI_Comm comm0, std::span<const std::int64_t> indices,
   }
 
   return distribute_from_postoffice(comm0, indices, x, {shape0, shape1},
-                                    rank_offset);
+                                    rank_offset, node_aware, grid_threshold);
 }
 //---------------------------------------------------------------------------
 
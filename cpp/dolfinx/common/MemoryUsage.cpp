@@ -0,0 +1,87 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "MemoryUsage.h"
+#include "MPI.h"
+#include <iostream>
+#include <mutex>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+std::mutex mutex;
+std::map<std::string, std::size_t, std::less<>> sizes;
+} // namespace
+
+//-----------------------------------------------------------------------------
+void memory_usage::record(std::string_view name, std::size_t bytes)
+{
+  std::scoped_lock lock(mutex);
+  if (auto it = sizes.find(name); it != sizes.end())
+    it->second = bytes;
+  else
+    sizes.emplace(name, bytes);
+}
+//-----------------------------------------------------------------------------
+void memory_usage::clear()
+{
+  std::scoped_lock lock(mutex);
+  sizes.clear();
+}
+//-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> memory_usage::recorded()
+{
+  std::scoped_lock lock(mutex);
+  return {sizes.begin(), sizes.end()};
+}
+//-----------------------------------------------------------------------------
+std::size_t memory_usage::peak_resident()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    // Bytes on macOS
+    return usage.ru_maxrss;
+#else
+    // Kilobytes on Linux
+    return 1024 * static_cast<std::size_t>(usage.ru_maxrss);
+#endif
+  }
+#endif
+  return 0;
+}
+//-----------------------------------------------------------------------------
+Table memory_usage::table()
+{
+  constexpr double mb = 1024 * 1024;
+  Table table("Summary of memory usage");
+  double total = 0;
+  for (auto& [name, bytes] : recorded())
+  {
+    table.set(name, "MB", bytes / mb);
+    total += bytes;
+  }
+  table.set("Total (recorded)", "MB", total / mb);
+  table.set("Peak resident memory", "MB", peak_resident() / mb);
+
+  return table;
+}
+//-----------------------------------------------------------------------------
+void memory_usage::list(MPI_Comm comm, Table::Reduction reduction)
+{
+  const std::string str = "\n" + table().reduce(comm, reduction).str();
+  if (dolfinx::MPI::rank(comm) == 0)
+    std::cout << str << std::endl;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Table.h"
+#include <cstddef>
+#include <map>
+#include <mpi.h>
+#include <string>
+#include <string_view>
+
+/// @brief Accounting of the memory used by the objects of a program.
+///
+/// The main objects of the library, e.g. mesh::Mesh, fem::DofMap,
+/// la::MatrixCSR and la::Vector, report the memory that they use with
+/// a `memory_usage()` member function. The reported sizes can be
+/// recorded by name, and listed in a table that is reduced over the
+/// ranks, together with the peak resident memory of the process. The
+/// table is a per-rank breakdown of the data, e.g. to estimate the
+/// resources required by a larger problem.
+///
+/// The basic usage is
+/// \code{.cpp}
+/// common::memory_usage::record("Mesh", mesh.memory_usage());
+/// common::memory_usage::record("Matrix", A.memory_usage());
+/// common::memory_usage::list(MPI_COMM_WORLD, Table::Reduction::max);
+/// \endcode
+namespace dolfinx::common::memory_usage
+{
+/// @brief Record the memory used by an object.
+///
+/// A previously recorded size of the same name is replaced.
+/// @param[in] name Name of the object.
+/// @param[in] bytes Memory in bytes.
+void record(std::string_view name, std::size_t bytes);
+
+/// @brief Discard the recorded sizes.
+void clear();
+
+/// @brief Recorded sizes.
+/// @return Memory in bytes of each named object.
+std::map<std::string, std::size_t> recorded();
+
+/// @brief Peak resident memory of the calling process.
+/// @return Memory in bytes, or zero if not available on the system.
+std::size_t peak_resident();
+
+/// @brief Return the recorded sizes (in MB) of this rank in a Table.
+///
+/// The table includes the total of the recorded sizes, and the peak
+/// resident memory of the process.
+Table table();
+
+/// @brief List the recorded sizes, reduced over ranks.
+/// @param[in] comm MPI communicator.
+/// @param[in] reduction Reduction over the ranks (min, max or
+/// average).
+void list(MPI_Comm comm, Table::Reduction reduction);
+} // namespace dolfinx::common::memory_usage
@@ -0,0 +1,107 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "PerfCounters.h"
+#include "log.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+// File descriptors of the counters. The first is the group leader.
+std::array<int, perf::num_counters> fds = {-1, -1, -1};
+std::atomic<bool> _enabled = false;
+
+#ifdef __linux__
+// Open a hardware counter of the calling thread
+int open_counter(std::uint64_t config, int group)
+{
+  perf_event_attr attr{};
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(perf_event_attr);
+  attr.config = config;
+  attr.disabled = group == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+#endif
+} // namespace
+
+//-----------------------------------------------------------------------------
+bool perf::start()
+{
+  stop();
+#ifdef __linux__
+  constexpr std::array<std::uint64_t, num_counters> config
+      = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+         PERF_COUNT_HW_CACHE_MISSES};
+  for (std::size_t i = 0; i < num_counters; ++i)
+  {
+    fds[i] = open_counter(config[i], fds[0]);
+    if (fds[i] < 0)
+    {
+      spdlog::warn("Hardware counter \"{}\" is not available.", names[i]);
+      stop();
+      return false;
+    }
+  }
+
+  ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  _enabled = true;
+  return true;
+#else
+  spdlog::warn("Hardware counters are not available.");
+  return false;
+#endif
+}
+//-----------------------------------------------------------------------------
+void perf::stop()
+{
+  _enabled = false;
+#ifdef __linux__
+  for (int& fd : fds)
+  {
+    if (fd >= 0)
+      close(fd);
+    fd = -1;
+  }
+#endif
+}
+//-----------------------------------------------------------------------------
+bool perf::enabled() noexcept
+{
+  return _enabled.load(std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+perf::counts_t perf::read() noexcept
+{
+  counts_t counts{};
+#ifdef __linux__
+  if (enabled())
+  {
+    // Number of counters followed by their values
+    std::array<std::uint64_t, num_counters + 1> data{};
+    if (::read(fds[0], data.data(), sizeof(data)) == sizeof(data))
+      std::copy_n(std::next(data.begin()), num_counters, counts.begin());
+  }
+#endif
+  return counts;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,58 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/// @brief Hardware performance counters of the calling thread.
+///
+/// When the counters are enabled, named Timers accumulate the counts of
+/// the periods that they run, and the counts are registered with the
+/// timings (see dolfinx::list_counters). The instructions per cycle and
+/// the memory traffic (estimated from last level cache misses) then show
+/// whether a timed region, e.g. assembly or a matrix-vector product, is
+/// compute or memory bound.
+///
+/// The counters are read with the Linux `perf_event` interface. They
+/// are not available on other systems, or if access is restricted, see
+/// `/proc/sys/kernel/perf_event_paranoid`.
+///
+/// @note Only the thread that called start() is counted.
+namespace dolfinx::common::perf
+{
+/// Number of counters
+constexpr std::size_t num_counters = 3;
+
+/// Counts of the counters
+using counts_t = std::array<std::uint64_t, num_counters>;
+
+/// Names of the counters
+constexpr std::array<std::string_view, num_counters> names
+    = {"cycles", "instructions", "LLC misses"};
+
+/// Size in bytes of a cache line, used to estimate the memory traffic
+/// from the last level cache misses
+constexpr std::size_t cache_line_bytes = 64;
+
+/// @brief Enable the counters of the calling thread.
+/// @return True if the counters are available and have been enabled.
+bool start();
+
+/// @brief Disable the counters.
+void stop();
+
+/// @brief Check if the counters are enabled.
+bool enabled() noexcept;
+
+/// @brief Read the counters.
+/// @return Counts since start(), or zeros if the counters are not
+/// enabled.
+counts_t read() noexcept;
+} // namespace dolfinx::common::perf
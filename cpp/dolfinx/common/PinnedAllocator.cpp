@@ -0,0 +1,58 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "PinnedAllocator.h"
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace dolfinx;
+
+namespace
+{
+#if defined(__unix__) || defined(__APPLE__)
+// Page size in bytes
+std::size_t page_size()
+{
+  static const std::size_t size = sysconf(_SC_PAGESIZE);
+  return size;
+}
+
+// Size in bytes rounded up to a multiple of the page size
+std::size_t page_round(std::size_t bytes)
+{
+  const std::size_t p = page_size();
+  return (std::max<std::size_t>(bytes, 1) + p - 1) / p * p;
+}
+#endif
+} // namespace
+
+//-----------------------------------------------------------------------------
+void* common::impl::pinned_allocate(std::size_t bytes)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  const std::size_t size = page_round(bytes);
+  void* p = ::operator new(size, std::align_val_t(page_size()));
+  mlock(p, size);
+  return p;
+#else
+  return ::operator new(bytes);
+#endif
+}
+//-----------------------------------------------------------------------------
+void common::impl::pinned_deallocate(void* p, std::size_t bytes) noexcept
+{
+#if defined(__unix__) || defined(__APPLE__)
+  munlock(p, page_round(bytes));
+  ::operator delete(p, std::align_val_t(page_size()));
+#else
+  ::operator delete(p);
+#endif
+}
+//-----------------------------------------------------------------------------
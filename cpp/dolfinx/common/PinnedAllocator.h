@@ -0,0 +1,97 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+/// @file PinnedAllocator.h
+/// @brief Allocator for page-locked host memory.
+
+namespace dolfinx::common
+{
+namespace impl
+{
+/// @brief Allocate page-locked memory.
+///
+/// The memory is aligned to a page boundary and its size is rounded up
+/// to a multiple of the page size, so that pages are not shared with
+/// other allocations. Locking is best-effort: if the pages cannot be
+/// locked, e.g. because the limit on locked memory (`RLIMIT_MEMLOCK`)
+/// is reached, the memory is returned unlocked.
+///
+/// @param[in] bytes Size in bytes.
+/// @return Pointer to the memory.
+void* pinned_allocate(std::size_t bytes);
+
+/// @brief Free memory allocated by pinned_allocate().
+/// @param[in] p Pointer to the memory.
+/// @param[in] bytes Size in bytes that was passed to pinned_allocate().
+void pinned_deallocate(void* p, std::size_t bytes) noexcept;
+} // namespace impl
+
+/// @brief Allocator for page-locked (pinned) host memory.
+///
+/// Page-locked memory cannot be swapped out, which device runtimes and
+/// RDMA networks require for direct memory access. Staging buffers in
+/// pinned memory therefore reach the full transfer bandwidth for
+/// copies between device and host, and for MPI communication.
+///
+/// The allocator locks memory with `mlock`. Allocators that pin memory
+/// with a device runtime (e.g. `cudaHostAlloc` or `hipHostMalloc`) can
+/// be used in the same places, since the staging buffers of
+/// la::Vector and of io::VTXWriter take any allocator.
+///
+/// @tparam T Value type.
+template <typename T>
+class PinnedAllocator
+{
+public:
+  /// Value type
+  using value_type = T;
+
+  /// All allocators can free memory allocated by any other allocator
+  using is_always_equal = std::true_type;
+
+  PinnedAllocator() = default;
+
+  /// Converting constructor
+  template <typename U>
+  constexpr PinnedAllocator(const PinnedAllocator<U>&) noexcept
+  {
+  }
+
+  /// @brief Allocate memory for `n` values.
+  /// @param[in] n Number of values.
+  /// @return Pointer to the memory.
+  T* allocate(std::size_t n)
+  {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+      throw std::bad_array_new_length();
+    return static_cast<T*>(impl::pinned_allocate(n * sizeof(T)));
+  }
+
+  /// @brief Free memory allocated by allocate().
+  /// @param[in] p Pointer to the memory.
+  /// @param[in] n Number of values that was passed to allocate().
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    impl::pinned_deallocate(p, n * sizeof(T));
+  }
+};
+
+/// @brief Compare allocators.
+template <typename T, typename U>
+constexpr bool operator==(const PinnedAllocator<T>&,
+                          const PinnedAllocator<U>&) noexcept
+{
+  return true;
+}
+
+} // namespace dolfinx::common
@@ -6,26 +6,155 @@
 
 #pragma once
 
+#include "CommStats.h"
 #include "IndexMap.h"
 #include "MPI.h"
 #include "sort.h"
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mpi.h>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <span>
+#include <stdexcept>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::common
 {
+namespace impl
+{
+/// @brief Cache of the communication patterns selected by
+/// Scatterer::tune, with keys that are signatures of the communication
+/// graph.
+inline std::map<std::array<std::uint64_t, 2>, int>& scatterer_type_cache()
+{
+  static std::map<std::array<std::uint64_t, 2>, int> cache;
+  return cache;
+}
+
+/// @brief Mutex for scatterer_type_cache.
+inline std::mutex& scatterer_type_cache_mutex()
+{
+  static std::mutex m;
+  return m;
+}
+} // namespace impl
+
+template <class Allocator>
+class Scatterer;
+
+/// @brief Shared-memory window for forward scatters between processes
+/// on the same (shared-memory) node.
+///
+/// A window is created by Scatterer::create_shared_window. The owned
+/// data to be sent is packed by the caller into the buffer returned by
+/// ScattererWindow::send_buffer, which is in a memory window that is
+/// shared by the processes on a node. Processes on the same node read
+/// their ghost data directly from the window of the owner, and only
+/// data for processes on other nodes is communicated using MPI.
+///
+/// @tparam T Data type to scatter.
+template <typename T>
+class ScattererWindow
+{
+  template <class Allocator>
+  friend class Scatterer;
+
+public:
+  // Copy constructor (disabled)
+  ScattererWindow(const ScattererWindow& w) = delete;
+
+  /// Move constructor
+  ScattererWindow(ScattererWindow&& w) noexcept
+      : _comm_node(std::move(w._comm_node)),
+        _comm_remote(std::move(w._comm_remote)),
+        _win(std::exchange(w._win, MPI_WIN_NULL)), _buffer(w._buffer),
+        _barrier(std::exchange(w._barrier, MPI_REQUEST_NULL)),
+        _node_src(std::move(w._node_src)),
+        _node_displs(std::move(w._node_displs)),
+        _node_sizes(std::move(w._node_sizes)),
+        _sizes_local(std::move(w._sizes_local)),
+        _displs_local(std::move(w._displs_local)),
+        _sizes_remote(std::move(w._sizes_remote)),
+        _displs_remote(std::move(w._displs_remote))
+  {
+  }
+
+  // Assignment operator (disabled)
+  ScattererWindow& operator=(const ScattererWindow& w) = delete;
+
+  // Move assignment operator (disabled)
+  ScattererWindow& operator=(ScattererWindow&& w) = delete;
+
+  /// Destructor (frees the window)
+  ~ScattererWindow()
+  {
+    if (_win != MPI_WIN_NULL)
+    {
+      MPI_Win_unlock_all(_win);
+      MPI_Win_free(&_win);
+    }
+  }
+
+  /// @brief Buffer for the owned data to send, in the shared-memory
+  /// window of the caller.
+  ///
+  /// The order of data in the buffer is given by
+  /// Scatterer::local_indices. The buffer must not be changed between
+  /// calls to Scatterer::scatter_fwd_begin and
+  /// Scatterer::scatter_fwd_end.
+  std::span<T> send_buffer() const { return _buffer; }
+
+private:
+  ScattererWindow() = default;
+
+  // Communicator for the processes on the same node, and neighbourhood
+  // communicator (owner -> ghost) for neighbours on other nodes
+  dolfinx::MPI::Comm _comm_node{MPI_COMM_NULL};
+  dolfinx::MPI::Comm _comm_remote{MPI_COMM_NULL};
+
+  // Shared-memory window and send buffer (in the window)
+  MPI_Win _win = MPI_WIN_NULL;
+  std::span<T> _buffer;
+
+  // Request for synchronisation of the node processes
+  MPI_Request _barrier = MPI_REQUEST_NULL;
+
+  // For each source (owner) process on the same node, the start of the
+  // data for the caller in the window of the owner, and the position
+  // and size of the data in the receive buffer
+  std::vector<const T*> _node_src;
+  std::vector<int> _node_displs, _node_sizes;
+
+  // Sizes and displacements of the data sent to (local) and received
+  // from (remote) neighbours on other nodes
+  std::vector<int> _sizes_local, _displs_local;
+  std::vector<int> _sizes_remote, _displs_remote;
+};
+
 /// @brief A Scatterer supports the MPI scattering and gathering of data
 /// that is associated with a common::IndexMap.
 ///
 /// Scatter and gather operations use MPI neighbourhood collectives.
 /// The implementation is designed for sparse communication patterns,
 /// as it typical of patterns based on an IndexMap.
+///
+/// The pack/unpack indices are stored using `Allocator`. With an
+/// allocator for memory that is accessible from a device (e.g. CUDA
+/// managed memory), the indices can be used directly by device
+/// pack/unpack functions (see the `pack_fn` and `unpack_fn` arguments
+/// of the scatter functions), and the send and receive buffers can be
+/// device memory if the MPI implementation is device-aware.
+///
+/// @tparam Allocator Allocator for the pack/unpack indices.
 template <class Allocator = std::allocator<std::int32_t>>
 class Scatterer
 {
@@ -36,8 +165,10 @@ public:
   /// Types of MPI communication pattern used by the Scatterer.
   enum class type
   {
-    neighbor, // use MPI neighborhood collectives
-    p2p       // use MPI Isend/Irecv for communication
+    neighbor,   // use MPI neighborhood collectives
+    p2p,        // use MPI Isend/Irecv for communication
+    persistent, // use persistent MPI Send/Recv requests
+    automatic   // use the fastest of neighbor and p2p (see tune)
   };
 
   /// @brief Create a scatterer.
@@ -170,6 +301,94 @@ public:
         _remote_inds[i * _bs + j] = perm[i] * _bs + j;
   }
 
+  /// @brief Create persistent MPI requests for sending owned data to
+  /// ranks that ghost the data.
+  ///
+  /// The requests are bound to the buffers, and a forward scatter using
+  /// the buffers is then performed by calling
+  /// Scatterer::scatter_fwd_begin and Scatterer::scatter_fwd_end with
+  /// the requests and Scatterer::type::persistent. This avoids the
+  /// set-up cost of the communication for each scatter. The requests
+  /// can be re-used for any number of scatters, and must be freed by
+  /// the caller using `MPI_Request_free`.
+  ///
+  /// @param[in] send_buffer Send buffer (see
+  /// Scatterer::scatter_fwd_begin). It must remain valid while the
+  /// requests are used.
+  /// @param[in] recv_buffer Receive buffer (see
+  /// Scatterer::scatter_fwd_begin). It must remain valid while the
+  /// requests are used.
+  /// @param[out] requests Persistent request handles. The required size
+  /// is given by Scatterer::create_request_vector with
+  /// Scatterer::type::persistent.
+  template <typename T>
+  void scatter_fwd_init(std::span<const T> send_buffer,
+                        std::span<T> recv_buffer,
+                        std::span<MPI_Request> requests) const
+  {
+    // Return early if there are no incoming or outgoing edges
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return;
+
+    assert(requests.size() == _dest.size() + _src.size());
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      MPI_Recv_init(recv_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                    dolfinx::MPI::mpi_t<T>, _src[i], MPI_ANY_TAG,
+                    _comm0.comm(), &requests[i]);
+    }
+
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      MPI_Send_init(send_buffer.data() + _displs_local[i], _sizes_local[i],
+                    dolfinx::MPI::mpi_t<T>, _dest[i], 0, _comm0.comm(),
+                    &requests[i + _src.size()]);
+    }
+  }
+
+  /// @brief Create persistent MPI requests for sending ghost data to
+  /// ranks that own the data.
+  ///
+  /// This is the reverse scatter counterpart of
+  /// Scatterer::scatter_fwd_init. The requests are used with
+  /// Scatterer::scatter_rev_begin and Scatterer::scatter_rev_end with
+  /// Scatterer::type::persistent, and must be freed by the caller using
+  /// `MPI_Request_free`.
+  ///
+  /// @param[in] send_buffer Send buffer (see
+  /// Scatterer::scatter_rev_begin). It must remain valid while the
+  /// requests are used.
+  /// @param[in] recv_buffer Receive buffer (see
+  /// Scatterer::scatter_rev_begin). It must remain valid while the
+  /// requests are used.
+  /// @param[out] requests Persistent request handles. The required size
+  /// is given by Scatterer::create_request_vector with
+  /// Scatterer::type::persistent.
+  template <typename T>
+  void scatter_rev_init(std::span<const T> send_buffer,
+                        std::span<T> recv_buffer,
+                        std::span<MPI_Request> requests) const
+  {
+    // Return early if there are no incoming or outgoing edges
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return;
+
+    assert(requests.size() == _dest.size() + _src.size());
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      MPI_Recv_init(recv_buffer.data() + _displs_local[i], _sizes_local[i],
+                    dolfinx::MPI::mpi_t<T>, _dest[i], MPI_ANY_TAG,
+                    _comm0.comm(), &requests[i]);
+    }
+
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      MPI_Send_init(send_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                    dolfinx::MPI::mpi_t<T>, _src[i], 0, _comm0.comm(),
+                    &requests[i + _dest.size()]);
+    }
+  }
+
   /// @brief Start a non-blocking send of owned data to ranks that ghost
   /// the data.
   ///
@@ -189,17 +408,25 @@ public:
   /// @param requests The MPI request handle for tracking the status of
   /// the non-blocking communication
   /// @param[in] type The type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or Scatterer::type::p2p.
+  /// Scatterer, Scatterer::type::neighbor, Scatterer::type::p2p,
+  /// Scatterer::type::persistent or Scatterer::type::automatic.
   template <typename T>
   void scatter_fwd_begin(std::span<const T> send_buffer,
                          std::span<T> recv_buffer,
                          std::span<MPI_Request> requests,
                          Scatterer::type type = type::neighbor) const
   {
+    // Resolve the automatic type on all ranks, since tuning is
+    // collective
+    type = resolve(type);
+
     // Return early if there are no incoming or outgoing edges
     if (_sizes_local.empty() and _sizes_remote.empty())
       return;
 
+    if (comm_stats::enabled())
+      record_stats<T>("Scatterer::scatter_fwd", true);
+
     switch (type)
     {
     case type::neighbor:
@@ -230,6 +457,12 @@ public:
       }
       break;
     }
+    case type::persistent:
+    {
+      assert(requests.size() == _dest.size() + _src.size());
+      MPI_Startall(requests.size(), requests.data());
+      break;
+    }
     default:
       throw std::runtime_error("Scatter::type not recognized");
     }
@@ -250,7 +483,10 @@ public:
       return;
 
     // Wait for communication to complete
+    const double t0 = comm_stats::enabled() ? MPI_Wtime() : -1;
     MPI_Waitall(requests.size(), requests.data(), MPI_STATUS_IGNORE);
+    if (t0 >= 0)
+      comm_stats::record_wait("Scatterer::scatter_fwd", MPI_Wtime() - t0);
   }
 
   /// @brief Scatter data associated with owned indices to ghosting
@@ -272,7 +508,8 @@ public:
   /// @param[in] requests The MPI request handle for tracking the status
   /// of the send
   /// @param[in] type The type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or Scatterer::type::p2p.
+  /// Scatterer, Scatterer::type::neighbor, Scatterer::type::p2p,
+  /// Scatterer::type::persistent or Scatterer::type::automatic.
   template <typename T, typename F>
     requires std::is_invocable_v<F, std::span<const T>,
                                  std::span<const std::int32_t>, std::span<T>>
@@ -359,6 +596,188 @@ public:
                     std::span<MPI_Request>(requests));
   }
 
+  /// @brief Create a shared-memory window for forward scatters that
+  /// read the data of owners on the same node directly.
+  ///
+  /// Neighbouring processes on the same node are determined using
+  /// `MPI_Comm_split_type` with `MPI_COMM_TYPE_SHARED`. Data for
+  /// neighbours on other nodes is communicated using a neighbourhood
+  /// collective, and data from neighbours on the same node is copied
+  /// directly from the shared-memory window of the owner.
+  ///
+  /// @note Collective MPI operation.
+  /// @tparam T Data type to scatter.
+  /// @return Shared-memory window, which is used with
+  /// Scatterer::scatter_fwd_begin and Scatterer::scatter_fwd_end.
+  template <typename T>
+  ScattererWindow<T> create_shared_window() const
+  {
+    ScattererWindow<T> w;
+    MPI_Comm comm = _comm0.comm();
+    if (comm == MPI_COMM_NULL)
+      comm = MPI_COMM_SELF;
+
+    MPI_Comm comm_node;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                        &comm_node);
+    w._comm_node = dolfinx::MPI::Comm(comm_node, false);
+
+    // Allocate window for the send buffer
+    T* ptr = nullptr;
+    MPI_Win_allocate_shared(_local_inds.size() * sizeof(T), sizeof(T),
+                            MPI_INFO_NULL, comm_node, &ptr, &w._win);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, w._win);
+    w._buffer = std::span<T>(ptr, _local_inds.size());
+    if (_comm0.comm() == MPI_COMM_NULL)
+      return w;
+
+    // Rank on the node of each source and destination rank
+    // (MPI_UNDEFINED if on another node)
+    auto node_ranks = [comm, comm_node](const std::vector<int>& ranks)
+    {
+      MPI_Group group, group_node;
+      MPI_Comm_group(comm, &group);
+      MPI_Comm_group(comm_node, &group_node);
+      std::vector<int> node_ranks(ranks.size());
+      MPI_Group_translate_ranks(group, ranks.size(), ranks.data(), group_node,
+                                node_ranks.data());
+      MPI_Group_free(&group);
+      MPI_Group_free(&group_node);
+      return node_ranks;
+    };
+    const std::vector<int> src_node = node_ranks(_src);
+    const std::vector<int> dest_node = node_ranks(_dest);
+
+    // Send to each destination the position of its data in the send
+    // buffer
+    std::vector<int> src_displs(_src.size());
+    {
+      std::vector<int> displs(_displs_local.begin(),
+                              std::prev(_displs_local.end()));
+      displs.reserve(1);
+      src_displs.reserve(1);
+      MPI_Neighbor_alltoall(displs.data(), 1, MPI_INT, src_displs.data(), 1,
+                            MPI_INT, comm);
+    }
+
+    // Sources on the same node, and sizes and displacements (in the
+    // receive buffer) for sources on other nodes
+    std::vector<int> src_remote;
+    for (std::size_t i = 0; i < _src.size(); ++i)
+    {
+      if (src_node[i] == MPI_UNDEFINED)
+      {
+        src_remote.push_back(_src[i]);
+        w._sizes_remote.push_back(_sizes_remote[i]);
+        w._displs_remote.push_back(_displs_remote[i]);
+      }
+      else
+      {
+        MPI_Aint size;
+        int disp_unit;
+        T* src_ptr = nullptr;
+        MPI_Win_shared_query(w._win, src_node[i], &size, &disp_unit, &src_ptr);
+        w._node_src.push_back(src_ptr + src_displs[i]);
+        w._node_displs.push_back(_displs_remote[i]);
+        w._node_sizes.push_back(_sizes_remote[i]);
+      }
+    }
+
+    // Sizes and displacements (in the send buffer) for destinations on
+    // other nodes
+    std::vector<int> dest_remote;
+    for (std::size_t i = 0; i < _dest.size(); ++i)
+    {
+      if (dest_node[i] == MPI_UNDEFINED)
+      {
+        dest_remote.push_back(_dest[i]);
+        w._sizes_local.push_back(_sizes_local[i]);
+        w._displs_local.push_back(_displs_local[i]);
+      }
+    }
+
+    // Create neighbourhood communicator for neighbours on other nodes
+    MPI_Comm comm_remote;
+    MPI_Dist_graph_create_adjacent(
+        comm, src_remote.size(), src_remote.data(), MPI_UNWEIGHTED,
+        dest_remote.size(), dest_remote.data(), MPI_UNWEIGHTED, MPI_INFO_NULL,
+        false, &comm_remote);
+    w._comm_remote = dolfinx::MPI::Comm(comm_remote, false);
+
+    return w;
+  }
+
+  /// @brief Start a forward scatter using a shared-memory window.
+  ///
+  /// The data to send must have been packed into
+  /// ScattererWindow::send_buffer. The communication with neighbours on
+  /// other nodes is started, and the processes on the node are
+  /// synchronised (non-blocking) before the data is read by
+  /// Scatterer::scatter_fwd_end.
+  ///
+  /// @note Collective MPI operation.
+  /// @param[in] window Shared-memory window created by
+  /// Scatterer::create_shared_window.
+  /// @param recv_buffer Buffer used for the received data (see
+  /// Scatterer::scatter_fwd_begin).
+  /// @param requests MPI request handle (size 1) for the communication
+  /// with neighbours on other nodes.
+  template <typename T>
+  void scatter_fwd_begin(ScattererWindow<T>& window, std::span<T> recv_buffer,
+                         std::span<MPI_Request> requests) const
+  {
+    // Make the send buffer visible to the processes on the node
+    MPI_Win_sync(window._win);
+    MPI_Ibarrier(window._comm_node.comm(), &window._barrier);
+
+    if (window._comm_remote.comm() != MPI_COMM_NULL)
+    {
+      assert(requests.size() == std::size_t(1));
+      window._sizes_local.reserve(1);
+      window._sizes_remote.reserve(1);
+      window._displs_local.reserve(1);
+      window._displs_remote.reserve(1);
+      MPI_Ineighbor_alltoallv(
+          window._buffer.data(), window._sizes_local.data(),
+          window._displs_local.data(), dolfinx::MPI::mpi_t<T>,
+          recv_buffer.data(), window._sizes_remote.data(),
+          window._displs_remote.data(), dolfinx::MPI::mpi_t<T>,
+          window._comm_remote.comm(), requests.data());
+    }
+  }
+
+  /// @brief Complete a forward scatter using a shared-memory window.
+  ///
+  /// The data from owners on the same node is copied from their
+  /// shared-memory windows, and the communication with neighbours on
+  /// other nodes is completed. On return the send buffers of all
+  /// processes on the node may be modified.
+  ///
+  /// @note Collective MPI operation.
+  /// @param[in] window Shared-memory window used in
+  /// Scatterer::scatter_fwd_begin.
+  /// @param recv_buffer Buffer for the received data.
+  /// @param requests MPI request handle used in
+  /// Scatterer::scatter_fwd_begin.
+  template <typename T>
+  void scatter_fwd_end(ScattererWindow<T>& window, std::span<T> recv_buffer,
+                       std::span<MPI_Request> requests) const
+  {
+    MPI_Wait(&window._barrier, MPI_STATUS_IGNORE);
+    MPI_Win_sync(window._win);
+    for (std::size_t i = 0; i < window._node_src.size(); ++i)
+    {
+      std::copy_n(window._node_src[i], window._node_sizes[i],
+                  std::next(recv_buffer.begin(), window._node_displs[i]));
+    }
+
+    // Wait until all processes on the node have read their data
+    MPI_Barrier(window._comm_node.comm());
+
+    if (window._comm_remote.comm() != MPI_COMM_NULL)
+      MPI_Waitall(requests.size(), requests.data(), MPI_STATUS_IGNORE);
+  }
+
   /// @brief Start a non-blocking send of ghost data to ranks that own
   /// the data.
   ///
@@ -384,17 +803,25 @@ public:
   /// @param requests The MPI request handle for tracking the status of
   /// the non-blocking communication
   /// @param[in] type The type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or Scatterer::type::p2p.
+  /// Scatterer, Scatterer::type::neighbor, Scatterer::type::p2p,
+  /// Scatterer::type::persistent or Scatterer::type::automatic.
   template <typename T>
   void scatter_rev_begin(std::span<const T> send_buffer,
                          std::span<T> recv_buffer,
                          std::span<MPI_Request> requests,
                          Scatterer::type type = type::neighbor) const
   {
+    // Resolve the automatic type on all ranks, since tuning is
+    // collective
+    type = resolve(type);
+
     // Return early if there are no incoming or outgoing edges
     if (_sizes_local.empty() and _sizes_remote.empty())
       return;
 
+    if (comm_stats::enabled())
+      record_stats<T>("Scatterer::scatter_rev", false);
+
     // // Send and receive data
 
     switch (type)
@@ -429,6 +856,12 @@ public:
       }
       break;
     }
+    case type::persistent:
+    {
+      assert(requests.size() == _dest.size() + _src.size());
+      MPI_Startall(requests.size(), requests.data());
+      break;
+    }
     default:
       throw std::runtime_error("Scatter::type not recognized");
     }
@@ -449,7 +882,10 @@ public:
       return;
 
     // Wait for communication to complete
+    const double t0 = comm_stats::enabled() ? MPI_Wtime() : -1;
     MPI_Waitall(request.size(), request.data(), MPI_STATUS_IGNORE);
+    if (t0 >= 0)
+      comm_stats::record_wait("Scatterer::scatter_rev", MPI_Wtime() - t0);
   }
 
   /// @brief Scatter data associated with ghost indices to owning ranks.
@@ -474,8 +910,8 @@ public:
   /// @param request MPI request handles for tracking the status of the
   /// non-blocking communication.
   /// @param[in] type Type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or
-  /// Scatterer::type::p2p.
+  /// Scatterer, Scatterer::type::neighbor, Scatterer::type::p2p,
+  /// Scatterer::type::persistent or Scatterer::type::automatic.
   template <typename T, typename F>
     requires std::is_invocable_v<F, std::span<const T>,
                                  std::span<const std::int32_t>, std::span<T>>
@@ -571,14 +1007,16 @@ public:
   /// Return a vector of local indices (owned) used to pack/unpack local
   /// data. These indices are grouped by neighbor process (process for
   /// which an index is a ghost).
-  const std::vector<std::int32_t>& local_indices() const noexcept
+  const std::vector<std::int32_t, allocator_type>&
+  local_indices() const noexcept
   {
     return _local_inds;
   }
 
   /// Return a vector of remote indices (ghosts) used to pack/unpack ghost
   /// data. These indices are grouped by neighbor process (ghost owners).
-  const std::vector<std::int32_t>& remote_indices() const noexcept
+  const std::vector<std::int32_t, allocator_type>&
+  remote_indices() const noexcept
   {
     return _remote_inds;
   }
@@ -588,18 +1026,149 @@ public:
   /// @return The block size
   int bs() const noexcept { return _bs; }
 
+  /// @brief Memory used by the scatterer.
+  /// @return Number of bytes of the pack/unpack indices and of the
+  /// neighbour sizes, displacements and ranks.
+  std::size_t memory_usage() const noexcept
+  {
+    return sizeof(std::int32_t) * (_remote_inds.size() + _local_inds.size())
+           + sizeof(int)
+                 * (_sizes_remote.size() + _displs_remote.size()
+                    + _sizes_local.size() + _displs_local.size()
+                    + _src.size() + _dest.size());
+  }
+
+  /// @brief Select the fastest communication pattern for the scatterer
+  /// by timing forward and reverse scatters.
+  ///
+  /// Scatterer::type::neighbor and Scatterer::type::p2p are timed on
+  /// the actual communication graph and message sizes, and the pattern
+  /// with the lowest maximum time over all ranks is selected, so all
+  /// ranks make the same choice. The choice is cached for the process
+  /// using a signature of the communication graph (neighbour ranks and
+  /// message sizes on all ranks). Scatterers with the same signature,
+  /// e.g. for vectors with the same index map, re-use the choice
+  /// without timing if it is cached on all ranks of the communicator.
+  /// The selected pattern is used for
+  /// Scatterer::type::automatic.
+  ///
+  /// Persistent requests and shared-memory windows are bound to
+  /// buffers, and are not considered.
+  ///
+  /// @note Collective on the communicator of the index map used to
+  /// create the scatterer.
+  ///
+  /// @tparam T Value type of the timed scatters.
+  /// @param[in] repeats Number of timed forward and reverse scatters
+  /// for each pattern.
+  /// @return The selected pattern.
+  template <typename T = double>
+  type tune(int repeats = 5) const
+  {
+    if (_tuned)
+      return *_tuned;
+
+    // Serial scatterers do not communicate
+    if (_comm0.comm() == MPI_COMM_NULL)
+    {
+      _tuned = type::neighbor;
+      return *_tuned;
+    }
+
+    // Signature of the communication graph, combined over all ranks
+    std::array<std::uint64_t, 2> key = {0, 0};
+    {
+      std::array<std::uint64_t, 2> h = {0x9e3779b97f4a7c15ull, 0};
+      auto mix = [&h](std::uint64_t v)
+      {
+        h[0] = (h[0] ^ v) * 0x100000001b3ull;
+        h[1] = (h[1] + v + 0x9e3779b97f4a7c15ull) * 0xbf58476d1ce4e5b9ull;
+        h[1] ^= h[1] >> 31;
+      };
+      mix(dolfinx::MPI::rank(_comm0.comm()));
+      mix(sizeof(T));
+      for (const std::vector<int>* v :
+           {&_src, &_dest, &_sizes_local, &_sizes_remote})
+      {
+        mix(v->size());
+        std::ranges::for_each(*v, mix);
+      }
+      MPI_Allreduce(h.data(), key.data(), 2, MPI_UINT64_T, MPI_BXOR,
+                    _comm0.comm());
+      key[1] ^= dolfinx::MPI::size(_comm0.comm());
+    }
+
+    // Use the cached choice only if it is cached on all ranks, as
+    // otherwise the ranks that missed would wait in the timed scatters.
+    // The minimum is taken so that all ranks make the same choice.
+    int cached = -1;
+    {
+      std::scoped_lock lock(impl::scatterer_type_cache_mutex());
+      auto& cache = impl::scatterer_type_cache();
+      if (auto it = cache.find(key); it != cache.end())
+        cached = it->second;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &cached, 1, MPI_INT, MPI_MIN, _comm0.comm());
+    if (cached >= 0)
+    {
+      _tuned = static_cast<type>(cached);
+      return *_tuned;
+    }
+
+    std::vector<T> local_buffer(local_buffer_size(), 0);
+    std::vector<T> remote_buffer(remote_buffer_size(), 0);
+    auto time = [&](type t)
+    {
+      std::vector<MPI_Request> requests(
+          t == type::neighbor ? 1 : _dest.size() + _src.size(),
+          MPI_REQUEST_NULL);
+      auto scatter = [&]()
+      {
+        scatter_fwd_begin(std::span<const T>(local_buffer),
+                          std::span<T>(remote_buffer),
+                          std::span<MPI_Request>(requests), t);
+        scatter_fwd_end(std::span<MPI_Request>(requests));
+        scatter_rev_begin(std::span<const T>(remote_buffer),
+                          std::span<T>(local_buffer),
+                          std::span<MPI_Request>(requests), t);
+        scatter_rev_end(std::span<MPI_Request>(requests));
+      };
+
+      // Warm up, e.g. the set-up of the neighbourhood collectives
+      scatter();
+      MPI_Barrier(_comm0.comm());
+      const double t0 = MPI_Wtime();
+      for (int i = 0; i < repeats; ++i)
+        scatter();
+      double dt = MPI_Wtime() - t0;
+      MPI_Allreduce(MPI_IN_PLACE, &dt, 1, MPI_DOUBLE, MPI_MAX, _comm0.comm());
+      return dt;
+    };
+
+    const double t_neighbor = time(type::neighbor);
+    const double t_p2p = time(type::p2p);
+    _tuned = t_p2p < t_neighbor ? type::p2p : type::neighbor;
+    spdlog::info("Scatterer tuning: neighbor {} s, p2p {} s",
+                 t_neighbor, t_p2p);
+
+    std::scoped_lock lock(impl::scatterer_type_cache_mutex());
+    impl::scatterer_type_cache()[key] = static_cast<int>(*_tuned);
+    return *_tuned;
+  }
+
   /// @brief Create a vector of MPI_Requests for a given Scatterer::type
   /// @return A vector of MPI requests
   std::vector<MPI_Request> create_request_vector(Scatterer::type type
                                                  = type::neighbor)
   {
     std::vector<MPI_Request> requests;
-    switch (type)
+    switch (resolve(type))
     {
     case type::neighbor:
       requests = {MPI_REQUEST_NULL};
       break;
     case type::p2p:
+    case type::persistent:
       requests.resize(_dest.size() + _src.size(), MPI_REQUEST_NULL);
       break;
     default:
@@ -609,6 +1178,29 @@ public:
   }
 
 private:
+  // Return the pattern to use for type t, tuning the scatterer if t
+  // is automatic
+  type resolve(type t) const { return t == type::automatic ? tune() : t; }
+
+  // Record the communication statistics of a forward or reverse
+  // scatter of values of type T
+  template <typename T>
+  void record_stats(std::string_view region, bool forward) const
+  {
+    std::int64_t local = sizeof(T) * _displs_local.back();
+    std::int64_t remote = sizeof(T) * _displs_remote.back();
+    if (forward)
+    {
+      comm_stats::record(region, _dest.size(), local, _src.size(), remote,
+                         _src.size() + _dest.size());
+    }
+    else
+    {
+      comm_stats::record(region, _src.size(), remote, _dest.size(), local,
+                         _src.size() + _dest.size());
+    }
+  }
+
   // Block size
   int _bs;
 
@@ -653,5 +1245,8 @@ private:
   // Set of ranks ghost owned indices
   // FIXME: Should we store the index map instead?
   std::vector<int> _dest;
+
+  // Pattern selected by tune
+  mutable std::optional<type> _tuned;
 };
 } // namespace dolfinx::common
@@ -6,10 +6,19 @@
 
 #include "Table.h"
 #include "MPI.h"
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
+#include <format>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <numeric>
+#include <sstream>
+#include <string_view>
+#include <utility>
 #include <variant>
 
 namespace
@@ -25,6 +34,145 @@ std::string to_str(std::variant<std::string, int, double> value)
   else
     throw std::runtime_error("Variant incorrect");
 }
+
+/// @brief Quote a string for JSON output.
+std::string json_str(std::string_view str)
+{
+  std::string out = "\"";
+  for (char c : str)
+  {
+    if (c == '"' or c == '\\')
+      out += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      out += c;
+  }
+  return out + "\"";
+}
+
+/// @brief Format a table value for JSON output. Non-finite values,
+/// which JSON cannot represent, are written as `null`.
+std::string json_value(const std::variant<std::string, int, double>& value)
+{
+  if (std::holds_alternative<int>(value))
+    return std::to_string(std::get<int>(value));
+  else if (std::holds_alternative<double>(value))
+  {
+    const double x = std::get<double>(value);
+    return std::isfinite(x) ? std::format("{}", x) : "null";
+  }
+  else
+    return json_str(std::get<std::string>(value));
+}
+
+using key_t = std::pair<std::string, std::string>;
+
+/// @brief Serialise keys as `row\0col\0row\0col\0...`.
+std::string pack_keys(const std::vector<key_t>& keys)
+{
+  std::string s;
+  for (auto& [row, col] : keys)
+    s += row + '\0' + col + '\0';
+  return s;
+}
+
+/// @brief Append the keys serialised by pack_keys() to `keys`.
+void unpack_keys(const std::string& s, std::vector<key_t>& keys)
+{
+  std::stringstream stream(s);
+  key_t key;
+  while (std::getline(stream, key.first, '\0'),
+         std::getline(stream, key.second, '\0'))
+  {
+    keys.push_back(key);
+  }
+}
+
+/// @brief Compute keys of the `double` entries of a table that are the
+/// same on all processes, and the values of the calling process for
+/// these keys.
+///
+/// If the keys of all processes are the same, which is detected from a
+/// hash of the serialised keys, no keys are communicated. Otherwise the
+/// union of the keys is formed on rank 0 and broadcast.
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] values Table values.
+/// @param[in] missing Value for keys that are not in `values`.
+/// @return Sorted keys, and the value of each key.
+std::pair<std::vector<key_t>, std::vector<double>>
+align_values(MPI_Comm comm,
+             const std::map<key_t, std::variant<std::string, int, double>>&
+                 values,
+             double missing)
+{
+  std::vector<key_t> keys;
+  std::vector<double> x;
+  for (auto& [key, value] : values)
+  {
+    if (const auto* const pval = std::get_if<double>(&value))
+    {
+      keys.push_back(key);
+      x.push_back(*pval);
+    }
+  }
+
+  // Compare the hash and number of the keys on all processes, using
+  // max(~a) = ~min(a) to get minimum and maximum in one reduction
+  std::string packed = pack_keys(keys);
+  const std::uint64_t h = std::hash<std::string>{}(packed);
+  const std::uint64_t n = keys.size();
+  std::array<std::uint64_t, 4> hn = {h, ~h, n, ~n};
+  int err = MPI_Allreduce(MPI_IN_PLACE, hn.data(), hn.size(), MPI_UINT64_T,
+                          MPI_MAX, comm);
+  dolfinx::MPI::check_error(comm, err);
+  if (hn[0] == ~hn[1] and hn[2] == ~hn[3])
+    return {std::move(keys), std::move(x)};
+
+  // Gather keys on rank 0 and form the union
+  const int mpi_size = dolfinx::MPI::size(comm);
+  std::vector<int> counts(mpi_size), offsets(mpi_size + 1, 0);
+  const int size = packed.size();
+  err = MPI_Gather(&size, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm);
+  dolfinx::MPI::check_error(comm, err);
+  std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+  std::string packed_all(offsets.back(), '\0');
+  err = MPI_Gatherv(packed.data(), packed.size(), MPI_CHAR, packed_all.data(),
+                    counts.data(), offsets.data(), MPI_CHAR, 0, comm);
+  dolfinx::MPI::check_error(comm, err);
+
+  std::string packed_union;
+  if (dolfinx::MPI::rank(comm) == 0)
+  {
+    std::vector<key_t> keys_all;
+    unpack_keys(packed_all, keys_all);
+    std::ranges::sort(keys_all);
+    auto [last, end] = std::ranges::unique(keys_all);
+    keys_all.erase(last, end);
+    packed_union = pack_keys(keys_all);
+  }
+
+  // Broadcast the union
+  std::uint64_t union_size = packed_union.size();
+  err = MPI_Bcast(&union_size, 1, MPI_UINT64_T, 0, comm);
+  dolfinx::MPI::check_error(comm, err);
+  packed_union.resize(union_size);
+  err = MPI_Bcast(packed_union.data(), union_size, MPI_CHAR, 0, comm);
+  dolfinx::MPI::check_error(comm, err);
+
+  std::vector<key_t> keys_union;
+  unpack_keys(packed_union, keys_union);
+  std::vector<double> x_union(keys_union.size(), missing);
+  for (std::size_t i = 0; i < keys_union.size(); ++i)
+  {
+    if (auto it = values.find(keys_union[i]); it != values.end())
+    {
+      if (const auto* const pval = std::get_if<double>(&it->second))
+        x_union[i] = *pval;
+    }
+  }
+
+  return {std::move(keys_union), std::move(x_union)};
+}
 } // namespace
 
 using namespace dolfinx;
@@ -68,23 +216,31 @@ std::variant<std::string, int, double> Table::get(std::string row,
 //-----------------------------------------------------------------------------
 Table Table::reduce(MPI_Comm comm, Table::Reduction reduction) const
 {
+  if (reduction == Table::Reduction::statistics)
+    return reduce_statistics(comm);
+
   std::string new_title;
 
-  // Prepare reduction operation y := op(y, x)
-  std::function<double(double, double)> op_impl;
+  // Prepare reduction operation, and the value of the entries that a
+  // process does not have (identity of the operation)
+  MPI_Op op;
+  double missing;
   switch (reduction)
   {
   case Table::Reduction::average:
     new_title = "[MPI_AVG] ";
-    op_impl = [](double y, double x) { return y + x; };
+    op = MPI_SUM;
+    missing = 0;
     break;
   case Table::Reduction::min:
     new_title = "[MPI_MIN] ";
-    op_impl = [](double y, double x) { return std::min(y, x); };
+    op = MPI_MIN;
+    missing = std::numeric_limits<double>::infinity();
     break;
   case Table::Reduction::max:
     new_title = "[MPI_MAX] ";
-    op_impl = [](double y, double x) { return std::max(y, x); };
+    op = MPI_MAX;
+    missing = -std::numeric_limits<double>::infinity();
     break;
   default:
     throw std::runtime_error("Cannot perform reduction of Table. Requested "
@@ -102,81 +258,23 @@ Table Table::reduce(MPI_Comm comm, Table::Reduction reduction) const
     return table_all;
   }
 
-  // Get keys, values into containers for int doubles
-  std::string keys;
-  std::vector<double> values;
-  for (const auto& it : _values)
-  {
-    if (const auto* const pval = std::get_if<double>(&it.second))
-    {
-      keys += it.first.first + '\0' + it.first.second + '\0';
-      values.push_back(*pval);
-    }
-  }
-
-  // Gather to rank zero
-
-  // Get string data size on each process
-  std::vector<int> pcounts(mpi_size), offsets(mpi_size + 1, 0);
-  const int local_size_str = keys.size();
-  int err = MPI_Gather(&local_size_str, 1, MPI_INT, pcounts.data(), 1, MPI_INT,
-                       0, comm);
-  dolfinx::MPI::check_error(comm, err);
-  std::partial_sum(pcounts.begin(), pcounts.end(), offsets.begin() + 1);
-  std::vector<char> out_str(offsets.back());
-  err = MPI_Gatherv(keys.data(), keys.size(), MPI_CHAR, out_str.data(),
-                    pcounts.data(), offsets.data(), MPI_CHAR, 0, comm);
-  dolfinx::MPI::check_error(comm, err);
-
-  // Rebuild string
-  std::vector<std::string> keys_all(mpi_size);
-  for (int p = 0; p < mpi_size; ++p)
-  {
-    keys_all[p] = std::string(out_str.begin() + offsets[p],
-                              out_str.begin() + offsets[p + 1]);
-  }
-
-  // Get value data size on each process
-  const int local_size = values.size();
-  err = MPI_Gather(&local_size, 1, MPI_INT, pcounts.data(), 1, MPI_INT, 0,
-                   comm);
-  dolfinx::MPI::check_error(comm, err);
-  std::partial_sum(pcounts.begin(), pcounts.end(), offsets.begin() + 1);
-
-  std::vector<double> values_all(offsets.back());
-  err = MPI_Gatherv(values.data(), values.size(), dolfinx::MPI::mpi_t<double>,
-                    values_all.data(), pcounts.data(), offsets.data(),
-                    dolfinx::MPI::mpi_t<double>, 0, comm);
+  // Reduce the values of the double entries
+  auto [keys, values] = align_values(comm, _values, missing);
+  std::vector<double> values_all(values.size());
+  int err = MPI_Reduce(values.data(), values_all.data(), values.size(),
+                       dolfinx::MPI::mpi_t<double>, op, 0, comm);
   dolfinx::MPI::check_error(comm, err);
 
   // Return empty table on rank > 0
   if (MPI::rank(comm) > 0)
     return Table(new_title);
 
-  // Construct dvalues map from obtained data
-  std::map<std::array<std::string, 2>, double> dvalues_all;
-  std::array<std::string, 2> key;
-  const double* values_ptr = values_all.data();
-  for (int i = 0; i < dolfinx::MPI::size(comm); ++i)
-  {
-    std::stringstream keys_stream(keys_all[i]);
-    while (std::getline(keys_stream, key[0], '\0'),
-           std::getline(keys_stream, key[1], '\0'))
-    {
-      if (auto it = dvalues_all.find(key); it != dvalues_all.end())
-        it->second = op_impl(it->second, *(values_ptr++));
-      else
-        dvalues_all[key] = *(values_ptr++);
-    }
-  }
-  assert(values_ptr == values_all.data() + values_all.size());
-
   // Weight by MPI size when averaging
   if (reduction == Table::Reduction::average)
   {
-    const double w = 1.0 / static_cast<double>(MPI::size(comm));
-    for (auto& it : dvalues_all)
-      it.second *= w;
+    const double w = 1.0 / static_cast<double>(mpi_size);
+    for (double& v : values_all)
+      v *= w;
   }
 
   // Construct table to return
@@ -188,10 +286,81 @@ Table Table::reduce(MPI_Comm comm, Table::Reduction reduction) const
   }
   // NB - the cast to std::variant should not be needed: needed by Intel
   // compiler.
-  for (const auto& it : dvalues_all)
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    table_all.set(keys[i].first, keys[i].second,
+                  std::variant<std::string, int, double>(values_all[i]));
+  }
+
+  return table_all;
+}
+//-----------------------------------------------------------------------------
+Table Table::reduce_statistics(MPI_Comm comm) const
+{
+  const std::string new_title = "[MPI_STATS] " + name;
+  const int mpi_size = dolfinx::MPI::size(comm);
+
+  // Gather the values of all processes on rank 0, with NaN for entries
+  // that a process does not have
+  auto [keys, values] = align_values(
+      comm, _values, std::numeric_limits<double>::quiet_NaN());
+  const std::size_t n = keys.size();
+  std::vector<double> values_all;
+  if (dolfinx::MPI::rank(comm) == 0)
+    values_all.resize(n * mpi_size);
+  int err = MPI_Gather(values.data(), n, dolfinx::MPI::mpi_t<double>,
+                       values_all.data(), n, dolfinx::MPI::mpi_t<double>, 0,
+                       comm);
+  dolfinx::MPI::check_error(comm, err);
+
+  if (MPI::rank(comm) > 0)
+    return Table(new_title);
+
+  Table table_all(new_title);
+  for (const auto& it : _values)
   {
-    table_all.set(it.first[0], it.first[1],
-                  std::variant<std::string, int, double>(it.second));
+    if (std::holds_alternative<int>(it.second))
+      table_all.set(it.first.first, it.first.second, it.second);
+  }
+
+  std::vector<double> v;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    // Values on processes that have the entry, and the maximum
+    v.clear();
+    double vmax = -std::numeric_limits<double>::infinity();
+    int rank_max = -1;
+    for (int p = 0; p < mpi_size; ++p)
+    {
+      if (double x = values_all[p * n + i]; !std::isnan(x))
+      {
+        v.push_back(x);
+        if (x > vmax)
+        {
+          vmax = x;
+          rank_max = p;
+        }
+      }
+    }
+
+    // Percentile by the nearest rank method
+    auto percentile = [&v](double q)
+    {
+      const std::size_t k = std::max<std::size_t>(
+          std::ceil(q * static_cast<double>(v.size())), 1);
+      auto it = std::next(v.begin(), k - 1);
+      std::nth_element(v.begin(), it, v.end());
+      return *it;
+    };
+
+    auto& [row, col] = keys[i];
+    table_all.set(row, col + " p50",
+                  std::variant<std::string, int, double>(percentile(0.5)));
+    table_all.set(row, col + " p95",
+                  std::variant<std::string, int, double>(percentile(0.95)));
+    table_all.set(row, col + " max",
+                  std::variant<std::string, int, double>(vmax));
+    table_all.set(row, col + " max rank", rank_max);
   }
 
   return table_all;
@@ -280,3 +449,24 @@ std::string Table::str() const
   return s.str();
 }
 //-----------------------------------------------------------------------------
+std::string Table::json() const
+{
+  // The entries are stored sorted by (row, column)
+  std::string out = "{\"name\": " + json_str(name) + ", \"rows\": {";
+  const std::string* row = nullptr;
+  for (auto& [key, value] : _values)
+  {
+    if (!row or *row != key.first)
+    {
+      out += row ? "}, " : "";
+      out += json_str(key.first) + ": {";
+      row = &key.first;
+    }
+    else
+      out += ", ";
+    out += json_str(key.second) + ": " + json_value(value);
+  }
+  out += row ? "}}}" : "}}";
+  return out;
+}
+//-----------------------------------------------------------------------------
@@ -33,7 +33,8 @@ public:
   {
     average,
     max,
-    min
+    min,
+    statistics
   };
 
   /// Create empty table
@@ -68,18 +69,54 @@ public:
   std::variant<std::string, int, double> get(std::string row,
                                              std::string col) const;
 
-  /// Do MPI reduction on Table
+  /// @brief Do MPI reduction on Table.
+  ///
+  /// The `double` entries are reduced. If all processes have the same
+  /// entries, which is checked with a hash of the keys, the values are
+  /// reduced with a single `MPI_Reduce`. Otherwise the union of the
+  /// keys is first formed on rank 0 and broadcast.
+  ///
+  /// If `reduction` is Reduction::statistics, the table of
+  /// reduce_statistics() is returned.
+  ///
+  /// @note Collective MPI operation.
   /// @param[in] comm MPI communicator
   /// @param[in] reduction Type of reduction to perform
-  /// @return Reduced Table
+  /// @return Reduced Table on rank 0, and an empty table on other ranks
   Table reduce(MPI_Comm comm, Reduction reduction) const;
 
+  /// @brief Compute the distribution over processes of the `double`
+  /// entries of the table.
+  ///
+  /// For each entry `(row, col)` with a `double` value, the reduced
+  /// table has the entries `(row, col + " p50")`, `(row, col + "
+  /// p95")`, `(row, col + " max")` and `(row, col + " max rank")`.
+  /// These are the median, the 95th percentile (nearest rank) and the
+  /// maximum of the values on the processes that have the entry, and
+  /// the lowest rank with the maximum value. The `int` entries of rank
+  /// 0 are kept, as for reduce().
+  ///
+  /// @note Collective MPI operation. The values are gathered on rank 0.
+  /// @param[in] comm MPI communicator
+  /// @return Reduced Table on rank 0, and an empty table on other ranks
+  Table reduce_statistics(MPI_Comm comm) const;
+
   /// Table name
   std::string name;
 
   /// Return string representation of the table
   std::string str() const;
 
+  /// @brief Return a JSON representation of the table.
+  ///
+  /// The table is an object `{"name": ..., "rows": {row: {col:
+  /// value}}}`. Rows and columns are sorted by name, entries that have
+  /// not been set are omitted, and `double` values are written with
+  /// the shortest representation that round-trips. The output is
+  /// therefore independent of the order in which the entries were set,
+  /// e.g. to compare benchmark results of different versions.
+  std::string json() const;
+
 private:
   // Row and column names
   std::vector<std::string> _rows, _cols;
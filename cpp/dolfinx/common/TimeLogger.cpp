@@ -26,7 +26,7 @@ void TimeLogger::register_timing(
   // Print a message
   std::string line
       = "Elapsed time: " + std::to_string(time.count()) + " (" + task + ")";
-  spdlog::debug(line.c_str());
+  SPDLOG_DEBUG("{}", line);
 
   // Store values for summary
   if (auto it = _timings.find(task); it != _timings.end())
@@ -38,6 +38,17 @@ void TimeLogger::register_timing(
     _timings.insert({task, {1, time}});
 }
 //-----------------------------------------------------------------------------
+void TimeLogger::register_counters(std::string task,
+                                   const perf::counts_t& counts)
+{
+  auto [it, inserted] = _counters.try_emplace(task, counts);
+  if (!inserted)
+  {
+    for (std::size_t i = 0; i < counts.size(); ++i)
+      it->second[i] += counts[i];
+  }
+}
+//-----------------------------------------------------------------------------
 void TimeLogger::list_timings(MPI_Comm comm, Table::Reduction reduction) const
 {
   // Format and reduce to rank 0
@@ -66,6 +77,38 @@ Table TimeLogger::timing_table() const
   return table;
 }
 //-----------------------------------------------------------------------------
+Table TimeLogger::counter_table() const
+{
+  Table table("Summary of hardware counters");
+  for (auto& [task, counts] : _counters)
+  {
+    for (std::size_t i = 0; i < counts.size(); ++i)
+      table.set(task, std::string(perf::names[i]), double(counts[i]));
+    if (counts[0] > 0)
+      table.set(task, "IPC", double(counts[1]) / double(counts[0]));
+
+    // Memory bandwidth, from the cache misses and the total time
+    if (auto it = _timings.find(task);
+        it != _timings.end() and it->second.second.count() > 0)
+    {
+      double bytes = double(counts[2]) * perf::cache_line_bytes;
+      table.set(task, "LLC GB/s", bytes / it->second.second.count() / 1e9);
+    }
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
+void TimeLogger::list_counters(MPI_Comm comm,
+                               Table::Reduction reduction) const
+{
+  Table counters = this->counter_table();
+  counters = counters.reduce(comm, reduction);
+  const std::string str = "\n" + counters.str();
+  if (dolfinx::MPI::rank(comm) == 0)
+    std::cout << str << std::endl;
+}
+//-----------------------------------------------------------------------------
 std::pair<int, std::chrono::duration<double, std::ratio<1>>>
 TimeLogger::timing(std::string task) const
 {
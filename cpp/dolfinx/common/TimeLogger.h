@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "PerfCounters.h"
 #include "Table.h"
 #include "timing.h"
 #include <chrono>
@@ -31,9 +32,26 @@ public:
   void register_timing(std::string task,
                        std::chrono::duration<double, std::ratio<1>> wall);
 
+  /// @brief Register hardware counts of a task (for later summary).
+  /// @param[in] task Name of the task.
+  /// @param[in] counts Counts, see common::perf.
+  void register_counters(std::string task, const perf::counts_t& counts);
+
   /// Return a summary of timings and tasks in a Table
   Table timing_table() const;
 
+  /// @brief Return a summary of the hardware counts of the tasks in a
+  /// Table.
+  ///
+  /// The table holds the total counts, the instructions per cycle and
+  /// the memory bandwidth estimated from the last level cache misses.
+  Table counter_table() const;
+
+  /// @brief List a summary of the hardware counts of the tasks.
+  /// @param comm MPI Communicator
+  /// @param reduction Reduction type (min, max or average)
+  void list_counters(MPI_Comm comm, Table::Reduction reduction) const;
+
   /// List a summary of timings and tasks. Reduction type is
   /// printed.
   /// @param comm MPI Communicator
@@ -70,5 +88,8 @@ private:
   std::map<std::string,
            std::pair<int, std::chrono::duration<double, std::ratio<1>>>>
       _timings;
+
+  // Accumulated hardware counts of tasks
+  std::map<std::string, perf::counts_t> _counters;
 };
 } // namespace dolfinx::common
@@ -8,11 +8,15 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <stdexcept>
 #include <string>
 
+#include "PerfCounters.h"
 #include "TimeLogger.h"
+#include "Trace.h"
 
 namespace dolfinx::common
 {
@@ -36,6 +40,14 @@ namespace dolfinx::common
 /// \endcode
 /// Registered elapsed times are logged when (1) the timer goes
 /// out-of-scope or (2) Timer::flush() is called.
+///
+/// If tracing is enabled (see common::trace), the running periods of
+/// named timers are also recorded as trace regions with the name of
+/// the task.
+///
+/// If hardware counters are enabled (see common::perf), named timers
+/// accumulate the counts of the periods that they run, and register
+/// them with the elapsed time.
 template <typename T = std::chrono::high_resolution_clock>
 class Timer
 {
@@ -48,16 +60,24 @@ public:
   /// @param[in] task Name used to registered the elapsed time in the
   /// logger. If no name is set, the elapsed time is not registered in
   /// the logger.
-  Timer(std::optional<std::string> task = std::nullopt) : _task(task) {}
+  Timer(std::optional<std::string> task = std::nullopt) : _task(task)
+  {
+    counters_begin();
+    trace_begin();
+  }
 
   /// If timer is still running, it is stopped. Elapsed time is
   /// registered in the logger.
   ~Timer()
   {
+    trace_end();
     if (_start_time.has_value() and _task.has_value())
     {
       _acc += T::now() - *_start_time;
+      counters_end();
       TimeLogger::instance().register_timing(*_task, _acc);
+      if (_counts)
+        TimeLogger::instance().register_counters(*_task, *_counts);
     }
   }
 
@@ -66,6 +86,12 @@ public:
   {
     _acc = T::duration::zero();
     _start_time = T::now();
+    _counts = std::nullopt;
+    counters_begin();
+    if (_trace_start >= 0)
+      _trace_start = trace::now();
+    else
+      trace_begin();
   }
 
   /// @brief Elapsed time since time has been started.
@@ -94,6 +120,8 @@ public:
     {
       _acc += T::now() - *_start_time;
       _start_time = std::nullopt;
+      counters_end();
+      trace_end();
     }
 
     return _acc;
@@ -105,7 +133,11 @@ public:
   void resume()
   {
     if (!_start_time.has_value())
+    {
       _start_time = T::now();
+      counters_begin();
+      trace_begin();
+    }
   }
 
   /// @brief Flush timer duration to the logger.
@@ -123,11 +155,51 @@ public:
     if (_task.has_value())
     {
       TimeLogger::instance().register_timing(*_task, _acc);
+      if (_counts)
+        TimeLogger::instance().register_counters(*_task, *_counts);
       _task = std::nullopt;
     }
   }
 
 private:
+  // Enter a trace region for the task, if tracing is enabled
+  void trace_begin() noexcept
+  {
+    if (_task.has_value() and trace::enabled())
+      _trace_start = trace::impl::begin();
+  }
+
+  // Read the hardware counters at the start of a running period
+  void counters_begin() noexcept
+  {
+    if (_task.has_value() and perf::enabled())
+      _counts_start = perf::read();
+  }
+
+  // Accumulate the counts of a running period
+  void counters_end() noexcept
+  {
+    if (_counts_start)
+    {
+      perf::counts_t counts = perf::read();
+      if (!_counts)
+        _counts = perf::counts_t{};
+      for (std::size_t i = 0; i < counts.size(); ++i)
+        (*_counts)[i] += counts[i] - (*_counts_start)[i];
+      _counts_start = std::nullopt;
+    }
+  }
+
+  // Leave the trace region of the task
+  void trace_end()
+  {
+    if (_trace_start >= 0)
+    {
+      trace::impl::end(trace::region(*_task), _trace_start);
+      _trace_start = -1;
+    }
+  }
+
   // Name of task to register in logger
   std::optional<std::string> _task;
 
@@ -136,5 +208,14 @@ private:
 
   // Store start time (std::nullopt if timer has been stopped)
   std::optional<typename T::time_point> _start_time = T::now();
+
+  // Start time of the trace region, or -1 if no region is running
+  std::int64_t _trace_start = -1;
+
+  // Accumulated hardware counts, if counted
+  std::optional<perf::counts_t> _counts;
+
+  // Hardware counts at the start of the running period
+  std::optional<perf::counts_t> _counts_start;
 };
 } // namespace dolfinx::common
@@ -0,0 +1,230 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "Trace.h"
+#include "MPI.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+std::atomic<bool> trace::impl::enabled = false;
+
+namespace
+{
+// Ring buffer of the events of a thread
+struct Buffer
+{
+  int thread;
+  std::vector<trace::Event> events;
+
+  // Number of events that have been recorded since start()
+  std::size_t count = 0;
+
+  // Number of running regions
+  std::uint32_t depth = 0;
+};
+
+// Data that is shared by the threads. Buffers are owned here, so that
+// events of threads that have finished are kept.
+struct State
+{
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Buffer>> buffers;
+  std::size_t capacity = 1 << 16;
+  std::int64_t t0 = 0;
+  std::map<std::string, std::uint32_t, std::less<>> ids;
+  std::vector<std::string> names;
+};
+
+State& state()
+{
+  static State _state;
+  return _state;
+}
+
+// Buffer of the calling thread
+Buffer& buffer()
+{
+  thread_local Buffer* _buffer = nullptr;
+  if (!_buffer)
+  {
+    State& s = state();
+    std::scoped_lock lock(s.mutex);
+    auto& b = s.buffers.emplace_back(std::make_unique<Buffer>());
+    b->thread = s.buffers.size() - 1;
+    b->events.resize(s.capacity);
+    _buffer = b.get();
+  }
+
+  return *_buffer;
+}
+
+// Escape a string for JSON
+std::string escape(std::string_view str)
+{
+  std::string out;
+  for (char c : str)
+  {
+    if (c == '"' or c == '\\')
+      out += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      out += c;
+  }
+  return out;
+}
+
+// Time in microseconds, which is the unit of the Chrome trace format
+std::string microseconds(std::int64_t ns)
+{
+  ns = std::max<std::int64_t>(ns, 0);
+  return std::to_string(ns / 1000) + "." + std::to_string(1000 + ns % 1000)
+                                               .substr(1);
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::int64_t trace::impl::begin() noexcept
+{
+  ++buffer().depth;
+  return trace::now();
+}
+//-----------------------------------------------------------------------------
+void trace::impl::end(std::uint32_t region, std::int64_t start) noexcept
+{
+  Buffer& b = buffer();
+  if (b.depth > 0)
+    --b.depth;
+  if (!b.events.empty())
+  {
+    b.events[b.count % b.events.size()] = {region, b.depth, start, now()};
+    ++b.count;
+  }
+}
+//-----------------------------------------------------------------------------
+void trace::start(std::size_t capacity)
+{
+  State& s = state();
+  std::scoped_lock lock(s.mutex);
+  s.capacity = capacity;
+  for (auto& b : s.buffers)
+  {
+    b->events.assign(capacity, {});
+    b->count = 0;
+  }
+  s.t0 = now();
+  impl::enabled = true;
+}
+//-----------------------------------------------------------------------------
+void trace::stop() { impl::enabled = false; }
+//-----------------------------------------------------------------------------
+std::uint32_t trace::region(std::string_view name)
+{
+  State& s = state();
+  std::scoped_lock lock(s.mutex);
+  if (auto it = s.ids.find(name); it != s.ids.end())
+    return it->second;
+
+  std::uint32_t id = s.names.size();
+  s.names.emplace_back(name);
+  s.ids.emplace(name, id);
+  return id;
+}
+//-----------------------------------------------------------------------------
+std::string trace::region_name(std::uint32_t id)
+{
+  State& s = state();
+  std::scoped_lock lock(s.mutex);
+  if (id >= s.names.size())
+    throw std::runtime_error("Invalid trace region.");
+  return s.names[id];
+}
+//-----------------------------------------------------------------------------
+std::vector<trace::ThreadEvents> trace::events()
+{
+  State& s = state();
+  std::scoped_lock lock(s.mutex);
+  std::vector<ThreadEvents> events;
+  for (auto& b : s.buffers)
+  {
+    if (b->count == 0)
+      continue;
+
+    // Oldest event is at the position of the next event if the buffer
+    // has wrapped around
+    std::size_t n = std::min(b->count, b->events.size());
+    std::size_t first = b->count > n ? b->count % n : 0;
+    ThreadEvents& e = events.emplace_back();
+    e.thread = b->thread;
+    e.dropped = b->count - n;
+    e.events.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+      e.events.push_back(b->events[(first + i) % n]);
+  }
+
+  return events;
+}
+//-----------------------------------------------------------------------------
+void trace::write_chrome(MPI_Comm comm, const std::filesystem::path& filename)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  std::vector<ThreadEvents> thread_events = events();
+
+  std::int64_t t0;
+  std::vector<std::string> names;
+  {
+    State& s = state();
+    std::scoped_lock lock(s.mutex);
+    t0 = s.t0;
+    std::ranges::transform(s.names, std::back_inserter(names), escape);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &t0, 1, MPI_INT64_T, MPI_MIN, comm);
+
+  // Events of this rank
+  const std::string pid = std::to_string(rank);
+  std::string json = "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + pid
+                     + ",\"args\":{\"name\":\"Rank " + pid + "\"}},\n";
+  for (auto& [thread, events, dropped] : thread_events)
+  {
+    const std::string tid = std::to_string(thread);
+    for (const Event& e : events)
+    {
+      json += "{\"name\":\"" + names.at(e.region)
+              + "\",\"ph\":\"X\",\"pid\":" + pid + ",\"tid\":" + tid
+              + ",\"ts\":" + microseconds(e.start - t0)
+              + ",\"dur\":" + microseconds(e.end - e.start) + "},\n";
+    }
+  }
+
+  // Gather the events on rank 0
+  int size = json.size();
+  std::vector<int> sizes(rank == 0 ? dolfinx::MPI::size(comm) : 0);
+  MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+  std::vector<int> disp(sizes.size() + 1, 0);
+  std::partial_sum(sizes.begin(), sizes.end(), std::next(disp.begin()));
+  std::string all(disp.back(), ' ');
+  MPI_Gatherv(json.data(), size, MPI_CHAR, all.data(), sizes.data(),
+              disp.data(), MPI_CHAR, 0, comm);
+
+  if (rank == 0)
+  {
+    // Remove the separator of the last event
+    all.resize(all.size() - 2);
+    std::ofstream file(filename);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+         << all << "\n]}\n";
+    if (!file)
+      throw std::runtime_error("Failed to write trace file.");
+  }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,189 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mpi.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief Low-overhead tracing of nested regions of code.
+///
+/// When tracing is enabled, the start and end times of regions that are
+/// entered by a TraceRegion (and by named Timers) are recorded in a
+/// ring buffer of each thread, without locks. The events can be written
+/// to a Chrome trace file, which shows the nested regions of each
+/// thread on each rank on a timeline, e.g. in https://ui.perfetto.dev
+/// or `chrome://tracing`.
+///
+/// The basic usage is
+/// \code{.cpp}
+/// static const std::uint32_t region = common::trace::region("assemble");
+/// common::TraceRegion r(region);
+/// \endcode
+/// with
+/// \code{.cpp}
+/// common::trace::start();
+/// /* .... */
+/// common::trace::stop();
+/// common::trace::write_chrome(MPI_COMM_WORLD, "trace.json");
+/// \endcode
+namespace dolfinx::common::trace
+{
+/// @brief Recorded region.
+struct Event
+{
+  /// Region identifier, see region().
+  std::uint32_t region;
+
+  /// Number of enclosing regions of the thread.
+  std::uint32_t depth;
+
+  /// Start time in nanoseconds, see now().
+  std::int64_t start;
+
+  /// End time in nanoseconds.
+  std::int64_t end;
+};
+
+/// @brief Events recorded by a thread.
+struct ThreadEvents
+{
+  /// Index of the thread, in the order that the threads first recorded
+  /// an event.
+  int thread;
+
+  /// Events, ordered by their end times.
+  std::vector<Event> events;
+
+  /// Number of events that have been overwritten because the ring
+  /// buffer was full.
+  std::size_t dropped;
+};
+
+/// @privatesection
+namespace impl
+{
+/// If true, events are recorded.
+extern std::atomic<bool> enabled;
+
+/// Enter a region of the calling thread.
+/// @return Start time.
+std::int64_t begin() noexcept;
+
+/// Leave a region of the calling thread and record its event.
+void end(std::uint32_t region, std::int64_t start) noexcept;
+} // namespace impl
+
+/// @brief Time in nanoseconds of the clock of the trace events.
+inline std::int64_t now() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// @brief Check if tracing is enabled.
+inline bool enabled() noexcept
+{
+  return impl::enabled.load(std::memory_order_relaxed);
+}
+
+/// @brief Enable tracing and discard the recorded events.
+///
+/// @note Must not be called while regions are running on other
+/// threads.
+///
+/// @param[in] capacity Number of events of the ring buffer of each
+/// thread. Older events are overwritten when a buffer is full.
+void start(std::size_t capacity = 1 << 16);
+
+/// @brief Disable tracing. The recorded events are kept.
+void stop();
+
+/// @brief Get the identifier of a region, which is the same for all
+/// calls with the same name.
+///
+/// The identifier should be stored, e.g. in a static variable, by
+/// regions that are entered often, since this function takes a lock.
+///
+/// @param[in] name Name of the region.
+/// @return Identifier of the region.
+std::uint32_t region(std::string_view name);
+
+/// @brief Name of a region.
+/// @param[in] id Identifier of the region, see region().
+/// @return Name of the region.
+std::string region_name(std::uint32_t id);
+
+/// @brief Events recorded by the threads of this process.
+///
+/// @note Must not be called while regions are running on other
+/// threads.
+///
+/// @return Events of each thread that has recorded events.
+std::vector<ThreadEvents> events();
+
+/// @brief Write the recorded events of all ranks to a file in the
+/// Chrome trace event format.
+///
+/// Each rank is shown as a process and each thread of a rank as a
+/// thread of the process. The times are relative to the earliest
+/// start() of the ranks.
+///
+/// @note This function is collective.
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] filename Name of the file.
+void write_chrome(MPI_Comm comm, const std::filesystem::path& filename);
+} // namespace dolfinx::common::trace
+
+namespace dolfinx::common
+{
+/// @brief Region of code that is recorded by common::trace while it is
+/// in scope.
+///
+/// Entering and leaving a region costs two clock reads and a store into
+/// a thread-local buffer when tracing is enabled, and a relaxed atomic
+/// load when it is disabled.
+class TraceRegion
+{
+public:
+  /// @brief Enter a region.
+  /// @param[in] region Identifier of the region, see trace::region().
+  explicit TraceRegion(std::uint32_t region) noexcept : _region(region)
+  {
+    if (trace::enabled())
+      _start = trace::impl::begin();
+  }
+
+  /// @brief Leave the region.
+  ~TraceRegion()
+  {
+    if (_start >= 0)
+      trace::impl::end(_region, _start);
+  }
+
+  // Copy constructor
+  TraceRegion(const TraceRegion&) = delete;
+
+  // Copy assignment
+  TraceRegion& operator=(const TraceRegion&) = delete;
+
+private:
+  // Region identifier
+  std::uint32_t _region;
+
+  // Start time, or -1 if tracing was disabled when entering the region
+  std::int64_t _start = -1;
+};
+} // namespace dolfinx::common
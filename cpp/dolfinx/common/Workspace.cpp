@@ -0,0 +1,72 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "Workspace.h"
+#include <algorithm>
+#include <numeric>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+// Size (bytes) of the first block of a workspace
+constexpr std::size_t min_block_size = 1 << 16;
+} // namespace
+
+//-----------------------------------------------------------------------------
+Workspace& Workspace::local()
+{
+  thread_local Workspace workspace;
+  return workspace;
+}
+//-----------------------------------------------------------------------------
+std::size_t Workspace::capacity() const
+{
+  return std::accumulate(_sizes.begin(), _sizes.end(), std::size_t(0));
+}
+//-----------------------------------------------------------------------------
+std::byte* Workspace::allocate_bytes(std::size_t n)
+{
+  constexpr std::size_t align = alignof(std::max_align_t);
+  n = (n + align - 1) / align * align;
+
+  // Move to the next block that is large enough, allocating a new
+  // block if there is none
+  while (_block < _blocks.size() and _offset + n > _sizes[_block])
+  {
+    ++_block;
+    _offset = 0;
+  }
+  if (_block == _blocks.size())
+  {
+    const std::size_t size = std::max({min_block_size, n, capacity()});
+    _blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+    _sizes.push_back(size);
+  }
+
+  std::byte* p = _blocks[_block].get() + _offset;
+  _offset += n;
+  return p;
+}
+//-----------------------------------------------------------------------------
+void Workspace::release(std::size_t block, std::size_t offset)
+{
+  _block = block;
+  _offset = offset;
+
+  // When all arrays have been released, merge the blocks into one
+  // block so that the workspace settles to a single block
+  if (_block == 0 and _offset == 0 and _blocks.size() > 1)
+  {
+    const std::size_t size = capacity();
+    _blocks.clear();
+    _sizes.clear();
+    _blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+    _sizes.push_back(size);
+  }
+}
+//-----------------------------------------------------------------------------
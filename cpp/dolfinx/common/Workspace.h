@@ -0,0 +1,121 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/// @file Workspace.h
+/// @brief Arena for scratch arrays.
+
+namespace dolfinx::common
+{
+/// @brief Monotonic arena for short-lived scratch arrays.
+///
+/// Arrays are allocated by advancing an offset into blocks of memory
+/// that are owned by the workspace. Memory is not returned to the
+/// system when arrays are released, but is re-used by subsequent
+/// allocations, so that functions that are called many times do not
+/// allocate heap memory after the first call.
+///
+/// Arrays are released in scopes (see Workspace::Scope): all arrays
+/// allocated while a scope exists are released when the scope is
+/// destroyed. Scopes can be nested.
+///
+/// Each thread has its own workspace, see Workspace::local().
+///
+/// Example:
+/// @code{.cpp}
+/// common::Workspace& ws = common::Workspace::local();
+/// common::Workspace::Scope scope(ws);
+/// std::span<double> Ae = ws.allocate<double>(n);
+/// @endcode
+class Workspace
+{
+public:
+  /// @brief Release scope for arrays of a workspace.
+  ///
+  /// Arrays allocated from the workspace after the scope is created
+  /// are released when the scope is destroyed.
+  class Scope
+  {
+  public:
+    /// @brief Create a scope.
+    /// @param[in] workspace The workspace.
+    explicit Scope(Workspace& workspace)
+        : _workspace(workspace), _block(workspace._block),
+          _offset(workspace._offset)
+    {
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    /// Destructor. Releases the arrays allocated in the scope.
+    ~Scope() { _workspace.release(_block, _offset); }
+
+  private:
+    Workspace& _workspace;
+    std::size_t _block, _offset;
+  };
+
+  /// Create an empty workspace.
+  Workspace() = default;
+
+  Workspace(const Workspace&) = delete;
+  Workspace& operator=(const Workspace&) = delete;
+
+  /// Move constructor
+  Workspace(Workspace&&) = default;
+
+  /// Move assignment
+  Workspace& operator=(Workspace&&) = default;
+
+  /// @brief Workspace of the calling thread.
+  static Workspace& local();
+
+  /// @brief Allocate an array.
+  ///
+  /// The array is valid until the innermost Scope that exists when the
+  /// array is allocated is destroyed.
+  ///
+  /// @tparam T Value type. Must be trivially copyable and trivially
+  /// destructible, e.g. a floating point or integer type.
+  /// @param[in] n Number of entries.
+  /// @return The array. The entries are not initialised.
+  template <typename T>
+  std::span<T> allocate(std::size_t n)
+  {
+    static_assert(std::is_trivially_copyable_v<T>
+                  and std::is_trivially_destructible_v<T>);
+    static_assert(alignof(T) <= alignof(std::max_align_t));
+    return std::span<T>(reinterpret_cast<T*>(allocate_bytes(n * sizeof(T))),
+                        n);
+  }
+
+  /// @brief Total size (bytes) of the memory blocks owned by the
+  /// workspace.
+  std::size_t capacity() const;
+
+private:
+  // Allocate n bytes, aligned to alignof(std::max_align_t)
+  std::byte* allocate_bytes(std::size_t n);
+
+  // Release all allocations after (block, offset)
+  void release(std::size_t block, std::size_t offset);
+
+  // Memory blocks and their sizes (bytes)
+  std::vector<std::unique_ptr<std::byte[]>> _blocks;
+  std::vector<std::size_t> _sizes;
+
+  // Current block and offset (bytes) in the block
+  std::size_t _block = 0, _offset = 0;
+};
+} // namespace dolfinx::common
@@ -5,9 +5,27 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "log.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <spdlog/async.h>
 #include <spdlog/cfg/argv.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <string>
 #include <vector>
 
+namespace
+{
+// True if init_parallel_logging made the caller a non-logging process
+std::atomic<bool> inactive_rank = false;
+
+// Log level requested on a non-logging process, which is restored if
+// the process logs again
+std::atomic<spdlog::level::level_enum> inactive_level
+    = spdlog::level::warn;
+} // namespace
+
 //-----------------------------------------------------------------------------
 void dolfinx::init_logging(int argc, char* argv[])
 {
@@ -16,3 +34,62 @@ void dolfinx::init_logging(int argc, char* argv[])
   spdlog::cfg::load_argv_levels(argc, argv);
 }
 //-----------------------------------------------------------------------------
+void dolfinx::init_parallel_logging(MPI_Comm comm,
+                                    std::span<const int> ranks,
+                                    bool asynchronous, std::size_t queue_size,
+                                    std::chrono::seconds flush_interval)
+{
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  const bool active
+      = ranks.empty() or std::ranges::find(ranks, rank) != ranks.end();
+
+  // Non-logging processes discard messages before formatting
+  const spdlog::level::level_enum level
+      = inactive_rank ? inactive_level.load() : spdlog::get_level();
+  inactive_rank = !active;
+  if (!active)
+  {
+    inactive_level = level;
+    auto logger = std::make_shared<spdlog::logger>(
+        "dolfinx", std::make_shared<spdlog::sinks::null_sink_mt>());
+    logger->set_level(spdlog::level::off);
+    spdlog::set_default_logger(logger);
+    return;
+  }
+
+  auto sink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
+  std::shared_ptr<spdlog::logger> logger;
+  if (asynchronous)
+  {
+    // Single background thread, so that messages remain ordered. The
+    // pool is created once, since replacing it would destroy the pool
+    // of a previous asynchronous logger with messages in the queue.
+    if (!spdlog::thread_pool())
+      spdlog::init_thread_pool(queue_size, 1);
+    logger = std::make_shared<spdlog::async_logger>(
+        "dolfinx", sink, spdlog::thread_pool(),
+        spdlog::async_overflow_policy::block);
+  }
+  else
+    logger = std::make_shared<spdlog::logger>("dolfinx", sink);
+
+  logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [" + std::to_string(rank)
+                      + "] [%l] %v");
+  logger->set_level(level);
+  logger->flush_on(spdlog::level::err);
+  spdlog::set_default_logger(logger);
+  if (asynchronous)
+    spdlog::flush_every(flush_interval);
+}
+//-----------------------------------------------------------------------------
+void dolfinx::set_log_level(spdlog::level::level_enum level)
+{
+  spdlog::set_level(level);
+  if (inactive_rank)
+  {
+    inactive_level = level;
+    spdlog::default_logger_raw()->set_level(spdlog::level::off);
+  }
+}
+//-----------------------------------------------------------------------------
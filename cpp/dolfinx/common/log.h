@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <mpi.h>
+#include <span>
 #include <spdlog/spdlog.h>
 
 namespace dolfinx
@@ -24,4 +28,47 @@ namespace dolfinx
 /// @param[in] argv Command line argument vector.
 void init_logging(int argc, char* argv[]);
 
+/// @brief Set the default logger for parallel runs.
+///
+/// Messages are written to `stderr` by the processes in `ranks` only,
+/// and prefixed with the rank. On the other processes the logger
+/// discards all messages without formatting them.
+///
+/// In asynchronous mode, log calls on the logging processes push the
+/// message into a bounded queue and return. A background thread
+/// writes the messages and flushes the output every `flush_interval`.
+/// A log call blocks only if the queue is full.
+///
+/// Debug and trace messages logged with the `SPDLOG_DEBUG` and
+/// `SPDLOG_TRACE` macros are removed at compile time in release builds
+/// of DOLFINx.
+///
+/// The log level of the current default logger is kept. On the
+/// non-logging processes the level stays `off` when it is changed with
+/// dolfinx::set_log_level.
+///
+/// @note In asynchronous mode, the spdlog thread pool is created by
+/// the first call only, and `queue_size` of later calls is ignored.
+///
+/// @param[in] comm MPI communicator for the ranks.
+/// @param[in] ranks Ranks on `comm` that log. If empty, all processes
+/// log.
+/// @param[in] asynchronous Use asynchronous logging.
+/// @param[in] queue_size Maximum number of queued messages in
+/// asynchronous mode.
+/// @param[in] flush_interval Period of the background flush in
+/// asynchronous mode.
+void init_parallel_logging(
+    MPI_Comm comm, std::span<const int> ranks = {}, bool asynchronous = false,
+    std::size_t queue_size = 8192,
+    std::chrono::seconds flush_interval = std::chrono::seconds(1));
+
+/// @brief Set the log level of all loggers.
+///
+/// Unlike `spdlog::set_level`, the default logger of processes that do
+/// not log (see init_parallel_logging) stays disabled.
+///
+/// @param[in] level Log level.
+void set_log_level(spdlog::level::level_enum level);
+
 } // namespace dolfinx
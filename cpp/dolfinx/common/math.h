@@ -259,4 +259,195 @@ void pinv(U A, V P)
   }
 }
 
+/// @brief Compute the determinants of a batch of small square matrices
+/// (1x1, 2x2 or 3x3).
+///
+/// The matrices are stored in structure-of-arrays layout, i.e. entry
+/// `(i, j)` of matrix `w` is `A(i, j, w)` and the entries `(i, j)` of
+/// all matrices are contiguous. The loops over the matrices are
+/// innermost so that they are vectorised by the compiler.
+///
+/// @param[in] A Matrices, with shape `(n, n, num_matrices)`.
+/// @param[out] detA Determinants, with size `num_matrices`.
+template <typename U, typename V>
+void det_batch(U A, V&& detA)
+{
+  static_assert(U::rank() == 3, "Must be rank 3");
+  assert(A.extent(0) == A.extent(1));
+  assert(detA.size() == A.extent(2));
+
+  const std::size_t num = A.extent(2);
+  switch (A.extent(0))
+  {
+  case 1:
+    for (std::size_t w = 0; w < num; ++w)
+      detA[w] = A(0, 0, w);
+    break;
+  case 2:
+    for (std::size_t w = 0; w < num; ++w)
+    {
+      detA[w] = difference_of_products(A(0, 0, w), A(0, 1, w), A(1, 0, w),
+                                       A(1, 1, w));
+    }
+    break;
+  case 3:
+    for (std::size_t w = 0; w < num; ++w)
+    {
+      auto w0 = difference_of_products(A(1, 1, w), A(1, 2, w), A(2, 1, w),
+                                       A(2, 2, w));
+      auto w1 = difference_of_products(A(1, 0, w), A(1, 2, w), A(2, 0, w),
+                                       A(2, 2, w));
+      auto w2 = difference_of_products(A(1, 0, w), A(1, 1, w), A(2, 0, w),
+                                       A(2, 1, w));
+      auto w3 = difference_of_products(A(0, 0, w), A(0, 1, w), w1, w0);
+      detA[w] = std::fma(A(0, 2, w), w2, w3);
+    }
+    break;
+  default:
+    throw std::runtime_error("math::det_batch is not implemented for "
+                             + std::to_string(A.extent(0)) + "x"
+                             + std::to_string(A.extent(1)) + " matrices.");
+  }
+}
+
+/// @brief Compute the inverses of a batch of small square matrices
+/// (1x1, 2x2 or 3x3).
+///
+/// The matrices are stored in structure-of-arrays layout (see
+/// det_batch()).
+///
+/// @param[in] A Matrices, with shape `(n, n, num_matrices)`.
+/// @param[out] B Inverses of the matrices, with the same shape as `A`.
+/// @warning This function does not check if the matrices are
+/// invertible.
+template <typename U, typename V>
+void inv_batch(U A, V B)
+{
+  static_assert(U::rank() == 3, "Must be rank 3");
+  static_assert(V::rank() == 3, "Must be rank 3");
+  assert(A.extent(0) == A.extent(1));
+  assert(B.extent(2) == A.extent(2));
+
+  using value_type = typename U::value_type;
+  const std::size_t num = A.extent(2);
+  switch (A.extent(0))
+  {
+  case 1:
+    for (std::size_t w = 0; w < num; ++w)
+      B(0, 0, w) = 1 / A(0, 0, w);
+    break;
+  case 2:
+    for (std::size_t w = 0; w < num; ++w)
+    {
+      value_type idet = 1
+                        / difference_of_products(A(0, 0, w), A(0, 1, w),
+                                                 A(1, 0, w), A(1, 1, w));
+      B(0, 0, w) = idet * A(1, 1, w);
+      B(0, 1, w) = -idet * A(0, 1, w);
+      B(1, 0, w) = -idet * A(1, 0, w);
+      B(1, 1, w) = idet * A(0, 0, w);
+    }
+    break;
+  case 3:
+    for (std::size_t w = 0; w < num; ++w)
+    {
+      value_type w0 = difference_of_products(A(1, 1, w), A(1, 2, w),
+                                             A(2, 1, w), A(2, 2, w));
+      value_type w1 = difference_of_products(A(1, 0, w), A(1, 2, w),
+                                             A(2, 0, w), A(2, 2, w));
+      value_type w2 = difference_of_products(A(1, 0, w), A(1, 1, w),
+                                             A(2, 0, w), A(2, 1, w));
+      value_type w3 = difference_of_products(A(0, 0, w), A(0, 1, w), w1, w0);
+      value_type idet = 1 / std::fma(A(0, 2, w), w2, w3);
+      B(0, 0, w) = w0 * idet;
+      B(1, 0, w) = -w1 * idet;
+      B(2, 0, w) = w2 * idet;
+      B(0, 1, w) = difference_of_products(A(0, 2, w), A(0, 1, w), A(2, 2, w),
+                                          A(2, 1, w))
+                   * idet;
+      B(0, 2, w) = difference_of_products(A(0, 1, w), A(0, 2, w), A(1, 1, w),
+                                          A(1, 2, w))
+                   * idet;
+      B(1, 1, w) = difference_of_products(A(0, 0, w), A(0, 2, w), A(2, 0, w),
+                                          A(2, 2, w))
+                   * idet;
+      B(1, 2, w) = difference_of_products(A(1, 0, w), A(0, 0, w), A(1, 2, w),
+                                          A(0, 2, w))
+                   * idet;
+      B(2, 1, w) = difference_of_products(A(2, 0, w), A(0, 0, w), A(2, 1, w),
+                                          A(0, 1, w))
+                   * idet;
+      B(2, 2, w) = difference_of_products(A(0, 0, w), A(1, 0, w), A(0, 1, w),
+                                          A(1, 1, w))
+                   * idet;
+    }
+    break;
+  default:
+    throw std::runtime_error("math::inv_batch is not implemented for "
+                             + std::to_string(A.extent(0)) + "x"
+                             + std::to_string(A.extent(1)) + " matrices.");
+  }
+}
+
+/// @brief Compute the left pseudo inverses of a batch of rectangular
+/// matrices (3x2, 3x1, 2x1), such that pinv(A) * A = I.
+///
+/// The matrices are stored in structure-of-arrays layout (see
+/// det_batch()).
+///
+/// @param[in] A Matrices, with shape `(m, n, num_matrices)`.
+/// @param[out] P Pseudo inverses, with shape `(n, m, num_matrices)`.
+/// @pre The matrices must be full rank.
+template <typename U, typename V>
+void pinv_batch(U A, V P)
+{
+  static_assert(U::rank() == 3, "Must be rank 3");
+  static_assert(V::rank() == 3, "Must be rank 3");
+  assert(A.extent(0) > A.extent(1));
+  assert(P.extent(0) == A.extent(1));
+  assert(P.extent(1) == A.extent(0));
+  assert(P.extent(2) == A.extent(2));
+
+  using value_type = typename U::value_type;
+  const std::size_t m = A.extent(0);
+  const std::size_t num = A.extent(2);
+  if (A.extent(1) == 2)
+  {
+    // pinv(A) = (A^T * A)^-1 * A^T, with the 2x2 inverse written out
+    for (std::size_t w = 0; w < num; ++w)
+    {
+      value_type a = 0, b = 0, d = 0;
+      for (std::size_t k = 0; k < m; ++k)
+      {
+        a += A(k, 0, w) * A(k, 0, w);
+        b += A(k, 0, w) * A(k, 1, w);
+        d += A(k, 1, w) * A(k, 1, w);
+      }
+      value_type idet = 1 / difference_of_products(a, b, b, d);
+      for (std::size_t k = 0; k < m; ++k)
+      {
+        P(0, k, w) = idet * (d * A(k, 0, w) - b * A(k, 1, w));
+        P(1, k, w) = idet * (a * A(k, 1, w) - b * A(k, 0, w));
+      }
+    }
+  }
+  else if (A.extent(1) == 1)
+  {
+    for (std::size_t w = 0; w < num; ++w)
+    {
+      value_type res = 0;
+      for (std::size_t k = 0; k < m; ++k)
+        res += A(k, 0, w) * A(k, 0, w);
+      for (std::size_t k = 0; k < m; ++k)
+        P(0, k, w) = A(k, 0, w) / res;
+    }
+  }
+  else
+  {
+    throw std::runtime_error("math::pinv_batch is not implemented for "
+                             + std::to_string(A.extent(0)) + "x"
+                             + std::to_string(A.extent(1)) + " matrices.");
+  }
+}
+
 } // namespace dolfinx::math
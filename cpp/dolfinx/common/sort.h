@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include "threads.h"
 #include <algorithm>
+#include <barrier>
 #include <bit>
 #include <cassert>
 #include <concepts>
@@ -126,8 +128,8 @@ struct __radix_sort
     }
 
     // Adjacency list arrays for computing insertion position
-    std::array<I, bucket_size> counter;
-    std::array<I, bucket_size + 1> offset;
+    std::array<std::size_t, bucket_size> counter;
+    std::array<std::size_t, bucket_size + 1> offset;
 
     uI mask_offset = 0;
     std::vector<T> buffer(range.size());
@@ -149,7 +151,7 @@ struct __radix_sort
       for (const auto& c : current_perm)
       {
         uI bucket = (proj(c) & mask) >> mask_offset;
-        uI new_pos = offset[bucket + 1] - counter[bucket];
+        std::size_t new_pos = offset[bucket + 1] - counter[bucket];
         next_perm[new_pos] = c;
         counter[bucket]--;
       }
@@ -169,18 +171,205 @@ struct __radix_sort
 /// Radix sort
 inline constexpr __radix_sort radix_sort{};
 
+/// @brief Sort a range with a parallel (threaded) radix sorting
+/// algorithm.
+///
+/// The range is divided into contiguous blocks, one per thread. In
+/// each pass (least significant digit first), the threads count the
+/// digits in their block, the per-thread counts are combined into
+/// insertion positions, and the threads then move the entries of their
+/// block to the sorted positions. The sort is stable, and gives the
+/// same result as dolfinx::radix_sort.
+///
+/// @tparam BITS The number of bits to sort at a time.
+/// @param[in, out] range The range to sort.
+/// @param[in] num_threads Number of threads. Small ranges are sorted
+/// on the calling thread.
+/// @param[in] proj Element projection.
+template <int BITS = 8, std::ranges::random_access_range R,
+          typename P = std::identity>
+void parallel_radix_sort(R&& range, int num_threads, P proj = {})
+{
+  using T = std::iter_value_t<R>;
+  using I = std::remove_cvref_t<std::invoke_result_t<P, T>>;
+  using uI = std::make_unsigned_t<I>;
+
+  if constexpr (!std::is_same_v<uI, I>)
+  {
+    parallel_radix_sort<BITS>(std::forward<R>(range), num_threads,
+                              [&](const T& e) -> uI
+                              { return unsigned_projection(proj(e)); });
+    return;
+  }
+  else
+  {
+    // Minimum number of entries per thread
+    constexpr std::size_t min_block_size = 1 << 14;
+
+    const std::size_t N = range.size();
+    num_threads = std::min<std::size_t>(std::max(num_threads, 1),
+                                        N / min_block_size);
+    if (num_threads <= 1)
+    {
+      radix_sort(std::forward<R>(range), proj);
+      return;
+    }
+
+    // Compute number of passes from the largest value
+    std::vector<uI> max_values(num_threads, 0);
+    std::span<T> current = range;
+    common::run_threads(
+        num_threads,
+        [&](int t)
+        {
+          auto [i0, i1] = common::thread_range(t, N, num_threads);
+          for (std::size_t i = i0; i < i1; ++i)
+            max_values[t] = std::max<uI>(max_values[t], proj(current[i]));
+        });
+    uI max_value = std::ranges::max(max_values);
+    int its = 0;
+    while (max_value)
+    {
+      max_value >>= BITS;
+      its++;
+    }
+
+    // Bucket counts (insertion positions) for each thread
+    constexpr std::size_t bucket_size = std::size_t(1) << BITS;
+    constexpr uI mask = (uI(1) << BITS) - 1;
+    std::vector<std::size_t> counter(num_threads * bucket_size);
+
+    std::vector<T> buffer(N);
+    std::span<T> next = buffer;
+    int shift = 0;
+    bool scatter = false;
+    auto sync_step = [&]() noexcept
+    {
+      if (!scatter)
+      {
+        // Compute insertion position of each bucket for each thread
+        std::size_t offset = 0;
+        for (std::size_t b = 0; b < bucket_size; ++b)
+        {
+          for (int t = 0; t < num_threads; ++t)
+          {
+            std::size_t n = counter[t * bucket_size + b];
+            counter[t * bucket_size + b] = offset;
+            offset += n;
+          }
+        }
+      }
+      else
+      {
+        std::swap(current, next);
+        shift += BITS;
+      }
+      scatter = !scatter;
+    };
+
+    std::barrier sync(num_threads, sync_step);
+    common::run_threads(
+        num_threads,
+        [&](int t)
+        {
+          auto [i0, i1] = common::thread_range(t, N, num_threads);
+          std::span<std::size_t> c(counter.data() + t * bucket_size,
+                                   bucket_size);
+          for (int it = 0; it < its; ++it)
+          {
+            // Count number of elements per bucket
+            std::ranges::fill(c, 0);
+            for (std::size_t i = i0; i < i1; ++i)
+              c[(proj(current[i]) >> shift) & mask]++;
+            sync.arrive_and_wait();
+
+            // Move entries to the sorted position
+            for (std::size_t i = i0; i < i1; ++i)
+              next[c[(proj(current[i]) >> shift) & mask]++] = current[i];
+            sync.arrive_and_wait();
+          }
+        });
+
+    // Copy data back to array
+    if (its % 2 != 0)
+    {
+      common::parallel_for(N, num_threads,
+                           [&](std::size_t i0, std::size_t i1)
+                           {
+                             std::copy(std::next(buffer.begin(), i0),
+                                       std::next(buffer.begin(), i1),
+                                       std::next(range.begin(), i0));
+                           });
+    }
+  }
+}
+
+/// @brief Sort a vector and remove duplicate entries, using threads.
+///
+/// The vector is sorted using dolfinx::parallel_radix_sort, and the
+/// unique entries are then found and compacted in parallel.
+///
+/// @param[in, out] x Vector to sort. On return it holds the sorted
+/// unique entries.
+/// @param[in] num_threads Number of threads.
+template <std::integral T>
+void sort_unique(std::vector<T>& x, int num_threads = 1)
+{
+  parallel_radix_sort(x, num_threads);
+
+  // Number of unique entries in the block of each thread. An entry is
+  // kept if it differs from the preceding entry.
+  const std::size_t N = x.size();
+  num_threads = std::min<std::size_t>(std::max(num_threads, 1), N);
+  if (num_threads <= 1)
+  {
+    auto [unique_end, range_end] = std::ranges::unique(x);
+    x.erase(unique_end, range_end);
+    return;
+  }
+
+  std::vector<std::size_t> offsets(num_threads + 1, 0);
+  common::run_threads(num_threads,
+                      [&](int t)
+                      {
+                        auto [i0, i1] = common::thread_range(t, N, num_threads);
+                        std::size_t n = 0;
+                        for (std::size_t i = i0; i < i1; ++i)
+                          n += (i == 0 or x[i] != x[i - 1]);
+                        offsets[t + 1] = n;
+                      });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<T> y(offsets.back());
+  common::run_threads(num_threads,
+                      [&](int t)
+                      {
+                        auto [i0, i1] = common::thread_range(t, N, num_threads);
+                        std::size_t pos = offsets[t];
+                        for (std::size_t i = i0; i < i1; ++i)
+                        {
+                          if (i == 0 or x[i] != x[i - 1])
+                            y[pos++] = x[i];
+                        }
+                      });
+  x = std::move(y);
+}
+
 /// @brief Compute the permutation array that sorts a 2D array by row.
 ///
 /// @param[in] x The flattened 2D array to compute the permutation array
 /// for (row-major storage).
 /// @param[in] shape1 The number of columns of `x`.
+/// @param[in] num_threads Number of threads used for sorting (see
+/// dolfinx::parallel_radix_sort).
 /// @return The permutation array such that `x[perm[i]] <= x[perm[i
 /// +1]].
 /// @pre `x.size()` must be a multiple of `shape1`.
 /// @note This function is suitable for small values of `shape1`. Each
 /// column of `x` is copied into an array that is then sorted.
 template <typename T, int BITS = 16>
-std::vector<std::int32_t> sort_by_perm(std::span<const T> x, std::size_t shape1)
+std::vector<std::int32_t> sort_by_perm(std::span<const T> x, std::size_t shape1,
+                                       int num_threads = 1)
 {
   static_assert(std::is_integral_v<T>, "Integral required.");
 
@@ -199,10 +388,15 @@ std::vector<std::int32_t> sort_by_perm(std::span<const T> x, std::size_t shape1)
   for (std::size_t i = 0; i < shape1; ++i)
   {
     std::size_t col = shape1 - 1 - i;
-    for (std::size_t j = 0; j < shape0; ++j)
-      column[j] = x[j * shape1 + col];
+    common::parallel_for(shape0, num_threads,
+                         [&](std::size_t j0, std::size_t j1)
+                         {
+                           for (std::size_t j = j0; j < j1; ++j)
+                             column[j] = x[j * shape1 + col];
+                         });
 
-    radix_sort(perm, [&column](auto index) { return column[index]; });
+    parallel_radix_sort(perm, num_threads,
+                        [&column](auto index) { return column[index]; });
   }
 
   return perm;
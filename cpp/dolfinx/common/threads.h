@@ -0,0 +1,115 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @file threads.h
+/// @brief Simple tools for shared-memory (thread) parallelism.
+
+namespace dolfinx::common
+{
+/// @brief Compute the range `[i0, i1)` of work items assigned to a
+/// thread when `N` items are divided as evenly as possible between
+/// `num_threads` threads.
+/// @param[in] thread Thread index, `0 <= thread < num_threads`.
+/// @param[in] N Number of work items.
+/// @param[in] num_threads Number of threads.
+/// @return Range `[i0, i1)` of work items for thread `thread`.
+constexpr std::array<std::size_t, 2>
+thread_range(int thread, std::size_t N, int num_threads)
+{
+  assert(thread >= 0);
+  assert(num_threads > 0);
+  const std::size_t n = N / num_threads;
+  const std::size_t r = N % num_threads;
+  const std::size_t t = thread;
+  if (t < r)
+    return {t * (n + 1), t * (n + 1) + n + 1};
+  else
+    return {t * n + r, t * n + r + n};
+}
+
+/// @brief Execute a function concurrently on a number of threads.
+///
+/// The function `fn(i)` is called for `i = 0, ..., num_threads - 1`,
+/// with `fn(0)` executed on the calling thread. The function returns
+/// once all threads have finished. If a call to `fn` throws, the
+/// first exception is re-thrown on the calling thread after all
+/// threads have been joined.
+///
+/// @param[in] num_threads Number of threads to execute `fn` on. If
+/// `num_threads <= 1`, `fn(0)` is called on the calling thread only.
+/// @param[in] fn Function to execute, with signature `void(int)`.
+template <typename F>
+void run_threads(int num_threads, F&& fn)
+{
+  if (num_threads <= 1)
+  {
+    fn(0);
+    return;
+  }
+
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto task = [&](int i)
+  {
+    try
+    {
+      fn(i);
+    }
+    catch (...)
+    {
+      std::scoped_lock lock(error_mutex);
+      if (!error)
+        error = std::current_exception();
+    }
+  };
+
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i)
+      threads.emplace_back(task, i);
+    task(0);
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+/// @brief Execute a function over a range of work items, with the
+/// range divided into contiguous blocks that are executed concurrently
+/// on a number of threads.
+///
+/// @param[in] N Number of work items.
+/// @param[in] num_threads Number of threads.
+/// @param[in] fn Function to execute, with signature `void(std::size_t
+/// i0, std::size_t i1)`, that processes work items `[i0, i1)`.
+template <typename F>
+void parallel_for(std::size_t N, int num_threads, F&& fn)
+{
+  // Do not use more threads than work items
+  num_threads = std::max(num_threads, 1);
+  if (N < static_cast<std::size_t>(num_threads))
+    num_threads = std::max<std::size_t>(N, 1);
+
+  run_threads(num_threads,
+              [&](int i)
+              {
+                auto [i0, i1] = thread_range(i, N, num_threads);
+                fn(i0, i1);
+              });
+}
+} // namespace dolfinx::common
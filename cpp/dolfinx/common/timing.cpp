@@ -20,6 +20,16 @@ void dolfinx::list_timings(MPI_Comm comm, Table::Reduction reduction)
   dolfinx::common::TimeLogger::instance().list_timings(comm, reduction);
 }
 //-----------------------------------------------------------------------------
+dolfinx::Table dolfinx::counter_table()
+{
+  return dolfinx::common::TimeLogger::instance().counter_table();
+}
+//-----------------------------------------------------------------------------
+void dolfinx::list_counters(MPI_Comm comm, Table::Reduction reduction)
+{
+  dolfinx::common::TimeLogger::instance().list_counters(comm, reduction);
+}
+//-----------------------------------------------------------------------------
 std::pair<int, std::chrono::duration<double, std::ratio<1>>>
 dolfinx::timing(std::string task)
 {
@@ -28,6 +28,19 @@ Table timing_table();
 void list_timings(MPI_Comm comm,
                   Table::Reduction reduction = Table::Reduction::max);
 
+/// @brief Return a summary of the hardware counts of the tasks in a
+/// Table, see common::perf.
+/// @return Table with hardware counts.
+Table counter_table();
+
+/// @brief List a summary of the hardware counts of the tasks, see
+/// common::perf.
+///
+/// @param[in] comm MPI Communicator.
+/// @param[in] reduction MPI Reduction to apply (min, max or average).
+void list_counters(MPI_Comm comm,
+                   Table::Reduction reduction = Table::Reduction::max);
+
 /// @brief Return timing (count, total wall time) for given task.
 /// @param[in] task Name of a task
 /// @return The (count, total wall time) for the task.
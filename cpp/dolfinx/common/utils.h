@@ -8,7 +8,9 @@
 
 #include "MPI.h"
 #include <algorithm>
+#include <atomic>
 #include <boost/functional/hash.hpp>
+#include <cstdint>
 #include <mpi.h>
 #include <utility>
 #include <vector>
@@ -55,6 +57,19 @@ sort_unique(const U& indices, const V& values)
   return {std::move(indices_new), std::move(values_new)};
 }
 
+/// @brief Create a new data state.
+///
+/// States are increasing and unique within a process. An object whose
+/// data may have been modified takes a new state, so that an unchanged
+/// state identifies unchanged data, see la::Vector::state and
+/// fem::Constant::state.
+/// @return The new state.
+inline std::uint64_t next_state()
+{
+  static std::atomic<std::uint64_t> state = 0;
+  return ++state;
+}
+
 /// @brief Compute a hash of a given object
 ///
 /// The hash is computed using Boost container hash
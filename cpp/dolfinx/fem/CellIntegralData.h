@@ -0,0 +1,377 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "assembler.h"
+#include "colouring.h"
+#include "traits.h"
+#include <algorithm>
+#include <array>
+#include <basix/mdspan.hpp>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/// @file CellIntegralData.h
+/// @brief Flat, colour-ordered cell integral data for assembly on
+/// accelerators.
+
+namespace dolfinx::fem
+{
+/// @brief Data of a cell integral that is gathered once into flat
+/// arrays, ordered by colour.
+///
+/// For each integration cell, the test (and trial) function
+/// degrees-of-freedom, the coordinate dofs and the packed coefficients
+/// are stored contiguously, so that the data can be placed in device
+/// memory with one transfer per array and the element kernels can be
+/// executed without indirection through the mesh geometry or dofmaps.
+/// The cells are ordered by colour (see Form::colouring), such that
+/// the cells `[colouring.offsets()[c], colouring.offsets()[c + 1])`
+/// share no test function degree-of-freedom and can be assembled
+/// concurrently, e.g. by one device kernel launch per colour, without
+/// atomics.
+///
+/// The containers can be device containers that can be constructed
+/// from a pair of host iterators. The assembly functions in this file
+/// are for host containers; device assembly is provided by executing
+/// the (device) kernels over the same data.
+///
+/// @tparam T Scalar type.
+/// @tparam Container Container type for scalar data.
+/// @tparam GeometryContainer Container type for coordinate dofs.
+/// @tparam IndexContainer Container type for degree-of-freedom indices
+/// and matrix data positions.
+template <dolfinx::scalar T, typename Container = std::vector<T>,
+          typename GeometryContainer = std::vector<scalar_value_t<T>>,
+          typename IndexContainer = std::vector<std::int32_t>>
+struct CellIntegralData
+{
+  /// @brief Colouring of the cells, where `colouring.links(c)` are the
+  /// positions of the cells with colour `c`. The positions of each
+  /// colour are contiguous.
+  graph::AdjacencyList<std::int32_t> colouring{0};
+
+  /// @brief Position in the integration entity list (see Form::domain)
+  /// of each cell.
+  std::vector<std::int32_t> positions;
+
+  /// @brief Block sizes of the test and trial function dofmaps. The
+  /// trial block size is zero for linear forms.
+  std::array<int, 2> bs = {0, 0};
+
+  /// @brief Number of (unblocked) test and trial function dofs per
+  /// cell. The number of trial dofs is zero for linear forms.
+  std::array<int, 2> num_dofs = {0, 0};
+
+  /// @brief Test function dofs, shape `(num_cells, num_dofs[0])`.
+  IndexContainer dofs0;
+
+  /// @brief Trial function dofs, shape `(num_cells, num_dofs[1])`.
+  IndexContainer dofs1;
+
+  /// @brief Coordinate dofs, shape `(num_cells, num_dofs_g, 3)`.
+  GeometryContainer coordinate_dofs;
+
+  /// @brief Number of coordinate dof entries per cell.
+  int cdofs_stride = 0;
+
+  /// @brief Packed coefficients, shape `(num_cells, cstride)`.
+  Container coefficients;
+
+  /// @brief Number of coefficient entries per cell.
+  int cstride = 0;
+
+  /// @brief Positions in the data of a la::MatrixCSR of the element
+  /// matrix entries, shape `(num_cells, bs[0] * num_dofs[0] * bs[1] *
+  /// num_dofs[1])`, see compute_csr_offsets(). A negative position
+  /// marks an entry that is not assembled, e.g. because of a boundary
+  /// condition. Empty for linear forms.
+  IndexContainer offsets;
+
+  /// @brief Number of cells.
+  std::size_t num_cells() const { return positions.size(); }
+};
+
+/// @brief Gather the data of a cell integral of a linear or bilinear
+/// form for assembly from flat, colour-ordered arrays.
+///
+/// @note Elements that need degree-of-freedom transformations and forms
+/// that need facet permutations are not supported.
+///
+/// @param[in] a Linear or bilinear form.
+/// @param[in] id Cell integral domain identifier.
+/// @param[in] kernel_idx Kernel index (cell type).
+/// @param[in] coeffs Packed coefficients of the integral, shape
+/// `(num_cells, cstride)`, in the order of Form::domain.
+/// @param[in] cstride Number of coefficient entries per cell.
+/// @return Cell integral data.
+template <dolfinx::scalar T, std::floating_point U,
+          typename Container = std::vector<T>,
+          typename GeometryContainer = std::vector<scalar_value_t<T>>,
+          typename IndexContainer = std::vector<std::int32_t>>
+CellIntegralData<T, Container, GeometryContainer, IndexContainer>
+create_cell_integral_data(const Form<T, U>& a, int id, int kernel_idx,
+                          std::span<const T> coeffs, int cstride)
+{
+  if (a.rank() != 1 and a.rank() != 2)
+    throw std::runtime_error("Cell integral data requires a rank 1 or 2 form.");
+  if (a.needs_facet_permutations())
+  {
+    throw std::runtime_error(
+        "Cell integral data for forms with facet permutations is not "
+        "supported.");
+  }
+
+  // Colour-ordered positions of the cells in the entity list
+  const graph::AdjacencyList<std::int32_t>& colouring
+      = a.colouring(IntegralType::cell, id, kernel_idx);
+  std::vector<std::int32_t> positions = colouring.array();
+  std::vector<std::int32_t> offsets = colouring.offsets();
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  std::span cells = a.domain(IntegralType::cell, id, kernel_idx);
+  assert(cells.size() * cstride == coeffs.size());
+
+  // Gather the test and trial function dofs
+  std::array<int, 2> bs = {0, 0};
+  std::array<int, 2> num_dofs = {0, 0};
+  std::array<std::vector<std::int32_t>, 2> dofs;
+  for (int r = 0; r < a.rank(); ++r)
+  {
+    auto V = a.function_spaces().at(r);
+    assert(V);
+    if (V->elements(kernel_idx)->needs_dof_transformations())
+    {
+      throw std::runtime_error(
+          "Cell integral data for elements with dof transformations is not "
+          "supported.");
+    }
+
+    std::shared_ptr<const DofMap> dofmap = V->dofmaps(kernel_idx);
+    assert(dofmap);
+    bs[r] = dofmap->bs();
+    num_dofs[r] = dofmap->map().extent(1);
+    std::span cells_r = a.domain_arg(IntegralType::cell, r, id, kernel_idx);
+    dofs[r].reserve(positions.size() * num_dofs[r]);
+    for (std::int32_t p : positions)
+      std::ranges::copy(dofmap->cell_dofs(cells_r[p]),
+                        std::back_inserter(dofs[r]));
+  }
+
+  // Gather the coordinate dofs
+  impl::mdspan2_t x_dofmap = mesh->geometry().dofmap(kernel_idx);
+  std::span<const U> x = mesh->geometry().x();
+  const int cdofs_stride = 3 * x_dofmap.extent(1);
+  std::vector<scalar_value_t<T>> cdofs;
+  cdofs.reserve(positions.size() * cdofs_stride);
+  for (std::int32_t p : positions)
+  {
+    auto x_dofs = md::submdspan(x_dofmap, cells[p], md::full_extent);
+    for (std::size_t i = 0; i < x_dofs.size(); ++i)
+      for (int k = 0; k < 3; ++k)
+        cdofs.push_back(x[3 * x_dofs[i] + k]);
+  }
+
+  // Gather the coefficients
+  std::vector<T> c;
+  c.reserve(positions.size() * cstride);
+  for (std::int32_t p : positions)
+  {
+    auto cp = coeffs.subspan(p * cstride, cstride);
+    c.insert(c.end(), cp.begin(), cp.end());
+  }
+
+  // Positions of the cells of each colour in the colour-ordered data
+  std::vector<std::int32_t> pos(positions.size());
+  std::iota(pos.begin(), pos.end(), 0);
+
+  CellIntegralData<T, Container, GeometryContainer, IndexContainer> data;
+  data.colouring
+      = graph::AdjacencyList<std::int32_t>(std::move(pos), std::move(offsets));
+  data.positions = std::move(positions);
+  data.bs = bs;
+  data.num_dofs = num_dofs;
+  data.dofs0 = IndexContainer(dofs[0].begin(), dofs[0].end());
+  data.dofs1 = IndexContainer(dofs[1].begin(), dofs[1].end());
+  data.coordinate_dofs = GeometryContainer(cdofs.begin(), cdofs.end());
+  data.cdofs_stride = cdofs_stride;
+  data.coefficients = Container(c.begin(), c.end());
+  data.cstride = cstride;
+  return data;
+}
+
+/// @brief Compute the positions in the data of a la::MatrixCSR of the
+/// element matrix entries of cell integral data of a bilinear form.
+///
+/// Entries in a row or column with a boundary condition are marked
+/// with a negative position and are not assembled.
+///
+/// @param[in,out] data Cell integral data of a bilinear form (see
+/// create_cell_integral_data()). Sets CellIntegralData::offsets.
+/// @param[in] A Matrix with a sparsity pattern that contains the
+/// entries of `data`. The block size of `A` must be the block size of
+/// the dofmaps of `data` or one.
+/// @param[in] bc0 Markers of the (blocked) test function dofs with a
+/// boundary condition. If empty, no rows are marked.
+/// @param[in] bc1 Markers of the (blocked) trial function dofs with a
+/// boundary condition. If empty, no columns are marked.
+template <dolfinx::scalar T, typename Container, typename GeometryContainer,
+          typename IndexContainer>
+void compute_csr_offsets(
+    CellIntegralData<T, Container, GeometryContainer, IndexContainer>& data,
+    const la::MatrixCSR<T>& A, std::span<const std::int8_t> bc0 = {},
+    std::span<const std::int8_t> bc1 = {})
+{
+  if (data.bs[1] == 0)
+    throw std::runtime_error("CSR offsets require a bilinear form.");
+
+  std::vector<std::int32_t> dofs0(data.dofs0.begin(), data.dofs0.end());
+  std::vector<std::int32_t> dofs1(data.dofs1.begin(), data.dofs1.end());
+  auto [bs0, bs1] = data.bs;
+  auto [n0, n1] = data.num_dofs;
+  const std::size_t n = bs0 * n0 * bs1 * n1;
+  std::vector<std::int32_t> offsets(data.num_cells() * n);
+  impl::dispatch_block_size(
+      bs0, bs1,
+      [&]<int BS0, int BS1>(std::integral_constant<int, BS0>,
+                            std::integral_constant<int, BS1>)
+      {
+        if constexpr (BS0 < 0 or BS1 < 0)
+          throw std::runtime_error("Unsupported dofmap block size.");
+        else
+        {
+          for (std::size_t e = 0; e < data.num_cells(); ++e)
+          {
+            A.template data_offsets<BS0, BS1>(
+                std::span(offsets).subspan(e * n, n),
+                std::span(dofs0).subspan(e * n0, n0),
+                std::span(dofs1).subspan(e * n1, n1));
+          }
+        }
+      });
+
+  // Mark the entries in rows and columns with a boundary condition
+  for (std::size_t e = 0; e < data.num_cells(); ++e)
+  {
+    std::span<std::int32_t> off = std::span(offsets).subspan(e * n, n);
+    for (int i = 0; i < n0; ++i)
+    {
+      for (int k = 0; k < bs0; ++k)
+      {
+        const std::int32_t row = bs0 * dofs0[e * n0 + i] + k;
+        for (int j = 0; j < n1; ++j)
+        {
+          for (int l = 0; l < bs1; ++l)
+          {
+            const std::int32_t col = bs1 * dofs1[e * n1 + j] + l;
+            if ((!bc0.empty() and bc0[row]) or (!bc1.empty() and bc1[col]))
+              off[(i * bs0 + k) * n1 * bs1 + j * bs1 + l] = -1;
+          }
+        }
+      }
+    }
+  }
+
+  data.offsets = IndexContainer(offsets.begin(), offsets.end());
+}
+
+/// @brief Assemble cell integral data of a linear form into a vector.
+///
+/// @param[in,out] b Array to accumulate into.
+/// @param[in] data Cell integral data (see create_cell_integral_data()).
+/// @param[in] kernel Kernel of the cell integral.
+/// @param[in] constants Packed constants that appear in the form.
+/// @param[in] num_threads Number of threads to use. If greater than
+/// one, the cells of each colour are assembled concurrently.
+template <dolfinx::scalar T>
+void assemble_vector(std::span<T> b, const CellIntegralData<T>& data,
+                     FEkernel<T> auto kernel, std::span<const T> constants,
+                     int num_threads = 1)
+{
+  const int bs = data.bs[0];
+  const int num_dofs = data.num_dofs[0];
+  auto assemble = [&](std::span<const std::int32_t> cells)
+  {
+    std::vector<T> be(bs * num_dofs);
+    for (std::int32_t e : cells)
+    {
+      std::ranges::fill(be, 0);
+      kernel(be.data(), data.coefficients.data() + e * data.cstride,
+             constants.data(),
+             data.coordinate_dofs.data() + e * data.cdofs_stride, nullptr,
+             nullptr, nullptr);
+      const std::int32_t* dofs = data.dofs0.data() + e * num_dofs;
+      for (int i = 0; i < num_dofs; ++i)
+        for (int k = 0; k < bs; ++k)
+          b[bs * dofs[i] + k] += be[bs * i + k];
+    }
+  };
+
+  if (num_threads > 1)
+    impl::for_each_colour(data.colouring, num_threads, assemble);
+  else
+    assemble(data.colouring.array());
+}
+
+/// @brief Assemble cell integral data of a bilinear form into the
+/// data of a la::MatrixCSR.
+///
+/// @param[in,out] A Data of the matrix to accumulate into (see
+/// la::MatrixCSR::values).
+/// @param[in] data Cell integral data with the positions of the element
+/// matrix entries in `A` (see compute_csr_offsets()).
+/// @param[in] kernel Kernel of the cell integral.
+/// @param[in] constants Packed constants that appear in the form.
+/// @param[in] num_threads Number of threads to use. If greater than
+/// one, the cells of each colour are assembled concurrently.
+template <dolfinx::scalar T>
+void assemble_matrix(std::span<T> A, const CellIntegralData<T>& data,
+                     FEkernel<T> auto kernel, std::span<const T> constants,
+                     int num_threads = 1)
+{
+  if (data.offsets.empty() and data.num_cells() > 0)
+    throw std::runtime_error("CSR offsets of cell integral data not set.");
+
+  const std::size_t n = data.bs[0] * data.num_dofs[0] * data.bs[1]
+                        * data.num_dofs[1];
+  auto assemble = [&](std::span<const std::int32_t> cells)
+  {
+    std::vector<T> Ae(n);
+    for (std::int32_t e : cells)
+    {
+      std::ranges::fill(Ae, 0);
+      kernel(Ae.data(), data.coefficients.data() + e * data.cstride,
+             constants.data(),
+             data.coordinate_dofs.data() + e * data.cdofs_stride, nullptr,
+             nullptr, nullptr);
+      const std::int32_t* off = data.offsets.data() + e * n;
+      for (std::size_t i = 0; i < n; ++i)
+        if (off[i] >= 0)
+          A[off[i]] += Ae[i];
+    }
+  };
+
+  if (num_threads > 1)
+    impl::for_each_colour(data.colouring, num_threads, assemble);
+  else
+    assemble(data.colouring.array());
+}
+} // namespace dolfinx::fem
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "dolfinx/common/types.h"
+#include <cstdint>
+#include <dolfinx/common/utils.h>
 #include <span>
 #include <vector>
 
@@ -48,5 +50,30 @@ public:
 
   /// Shape
   std::vector<std::size_t> shape;
+
+  /// @brief State of the value.
+  ///
+  /// The state increases when the value has changed since the previous
+  /// call. As for la::Vector::state, states are unique across all
+  /// objects, so that an unchanged state identifies an unchanged value,
+  /// e.g. to skip repacking of constants.
+  ///
+  /// @note The value is compared with a copy of the value at the
+  /// previous call. Not thread-safe.
+  std::uint64_t state() const
+  {
+    if (value != _value)
+    {
+      _value = value;
+      _state = common::next_state();
+    }
+
+    return _state;
+  }
+
+private:
+  // Value at the last call to state(), and its state
+  mutable std::vector<value_type> _value = value;
+  mutable std::uint64_t _state = common::next_state();
 };
 } // namespace dolfinx::fem
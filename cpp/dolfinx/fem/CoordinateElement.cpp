@@ -6,10 +6,14 @@
 
 #include "CoordinateElement.h"
 #include <algorithm>
+#include <array>
 #include <basix/finite-element.h>
 #include <cmath>
 #include <dolfinx/common/math.h>
 #include <dolfinx/mesh/cell_types.h>
+#include <functional>
+#include <numeric>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
@@ -59,6 +63,16 @@ void CoordinateElement<T>::tabulate(int nd, std::span<const T> X,
   assert(_element);
   _element->tabulate(nd, X, shape, basis);
 }
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
+void CoordinateElement<T>::tabulate_cached(int nd, std::span<const T> X,
+                                           std::array<std::size_t, 2> shape,
+                                           std::span<T> basis) const
+{
+  assert(_element);
+  _tabulation_cache->tabulate(nd, X, shape, basis, [&](std::span<T> v)
+                              { _element->tabulate(nd, X, shape, v); });
+}
 //--------------------------------------------------------------------------------
 template <std::floating_point T>
 void CoordinateElement<T>::permute_subentity_closure(std::span<std::int32_t> d,
@@ -83,91 +97,272 @@ template <std::floating_point T>
 void CoordinateElement<T>::pull_back_nonaffine(mdspan2_t<T> X,
                                                mdspan2_t<const T> x,
                                                mdspan2_t<const T> cell_geometry,
-                                               double tol, int maxit) const
+                                               double tol, int maxit,
+                                               bool initial_guess) const
+{
+  assert(cell_geometry.extent(1) == x.extent(1));
+  pull_back_nonaffine_impl(
+      X, x, [cell_geometry](auto) { return cell_geometry; },
+      cell_geometry.extent(0), tol, maxit, initial_guess);
+}
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
+void CoordinateElement<T>::pull_back_nonaffine(mdspan2_t<T> X,
+                                               mdspan2_t<const T> x,
+                                               mdspan3_t<const T> cell_geometry,
+                                               double tol, int maxit,
+                                               bool initial_guess) const
+{
+  assert(cell_geometry.extent(0) == x.extent(0));
+  assert(cell_geometry.extent(2) == x.extent(1));
+  const std::size_t num_xnodes = cell_geometry.extent(1);
+  const std::size_t gdim = cell_geometry.extent(2);
+  pull_back_nonaffine_impl(
+      X, x,
+      [&](std::size_t p)
+      {
+        return mdspan2_t<const T>(cell_geometry.data_handle()
+                                      + p * num_xnodes * gdim,
+                                  num_xnodes, gdim);
+      },
+      num_xnodes, tol, maxit, initial_guess);
+}
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
+template <typename G>
+void CoordinateElement<T>::pull_back_nonaffine_impl(mdspan2_t<T> X,
+                                                    mdspan2_t<const T> x,
+                                                    G&& cell_geometry,
+                                                    std::size_t num_xnodes,
+                                                    double tol, int maxit,
+                                                    bool initial_guess) const
 {
   // Number of points
-  std::size_t num_points = x.extent(0);
+  const std::size_t num_points = x.extent(0);
   if (num_points == 0)
     return;
 
   const std::size_t tdim = mesh::cell_dim(this->cell_shape());
   const std::size_t gdim = x.extent(1);
-  const std::size_t num_xnodes = cell_geometry.extent(0);
-  assert(cell_geometry.extent(1) == gdim);
   assert(X.extent(0) == num_points);
   assert(X.extent(1) == tdim);
 
   std::vector<T> dphi_b(tdim * num_xnodes);
   mdspan2_t<T> dphi(dphi_b.data(), tdim, num_xnodes);
-
-  std::vector<T> Xk_b(tdim);
-  mdspan2_t<T> Xk(Xk_b.data(), 1, tdim);
-
   std::array<T, 3> xk = {0, 0, 0};
-  std::vector<T> dX(tdim);
+  std::array<T, 3> dX = {0, 0, 0};
   std::vector<T> J_b(gdim * tdim);
   mdspan2_t<T> J(J_b.data(), gdim, tdim);
   std::vector<T> K_b(tdim * gdim);
   mdspan2_t<T> K(K_b.data(), tdim, gdim);
 
-  using mdspan4_t = md::mdspan<T, md::dextents<std::size_t, 4>>;
-
-  const std::array<std::size_t, 4> bsize = _element->tabulate_shape(1, 1);
-  std::vector<T> basis_b(
-      std::reduce(bsize.begin(), bsize.end(), 1, std::multiplies{}));
-  mdspan4_t basis(basis_b.data(), bsize);
-  std::vector<T> phi(basis.extent(2));
-  for (std::size_t p = 0; p < num_points; ++p)
+  // Run the Newton iterations of the points in lockstep, so that the
+  // basis is tabulated at all unconverged points at once. Workspaces
+  // are sized for all points and reused across iterations.
+  std::vector<T> Xk_b(num_points * tdim, 0);
+  if (initial_guess)
+  {
+    for (std::size_t p = 0; p < num_points; ++p)
+      for (std::size_t i = 0; i < tdim; ++i)
+        Xk_b[p * tdim + i] = X(p, i);
+  }
+  std::vector<std::int32_t> active(num_points);
+  std::iota(active.begin(), active.end(), 0);
+  std::vector<T> Xa_b;
+  Xa_b.reserve(num_points * tdim);
+  std::vector<T> basis_b;
+  for (int k = 0; k < maxit and !active.empty(); ++k)
   {
-    std::ranges::fill(Xk_b, 0.0);
-    int k;
-    for (k = 0; k < maxit; ++k)
+    // Tabulate at the unconverged points
+    Xa_b.resize(active.size() * tdim);
+    for (std::size_t q = 0; q < active.size(); ++q)
+    {
+      std::copy_n(std::next(Xk_b.begin(), active[q] * tdim), tdim,
+                  std::next(Xa_b.begin(), q * tdim));
+    }
+    const std::array<std::size_t, 4> bsize
+        = _element->tabulate_shape(1, active.size());
+    basis_b.resize(
+        std::reduce(bsize.begin(), bsize.end(), 1, std::multiplies{}));
+    md::mdspan<const T, md::dextents<std::size_t, 4>> basis(basis_b.data(),
+                                                            bsize);
+    _element->tabulate(1, Xa_b, {active.size(), tdim}, basis_b);
+
+    std::size_t num_active = 0;
+    for (std::size_t q = 0; q < active.size(); ++q)
     {
-      _element->tabulate(1, Xk_b, {1, tdim}, basis_b);
+      const std::int32_t p = active[q];
+      mdspan2_t<const T> geometry = cell_geometry(p);
 
       // x = cell_geometry * phi
       std::ranges::fill(xk, 0.0);
-      for (std::size_t i = 0; i < cell_geometry.extent(0); ++i)
-        for (std::size_t j = 0; j < cell_geometry.extent(1); ++j)
-          xk[j] += cell_geometry(i, j) * basis(0, 0, i, 0);
+      for (std::size_t i = 0; i < geometry.extent(0); ++i)
+        for (std::size_t j = 0; j < geometry.extent(1); ++j)
+          xk[j] += geometry(i, j) * basis(0, q, i, 0);
 
-      // Compute Jacobian, its inverse and determinant
+      // Compute Jacobian and its inverse
       std::ranges::fill(J_b, 0.0);
       for (std::size_t i = 0; i < tdim; ++i)
         for (std::size_t j = 0; j < basis.extent(2); ++j)
-          dphi(i, j) = basis(i + 1, 0, j, 0);
-
-      compute_jacobian(dphi, cell_geometry, J);
+          dphi(i, j) = basis(i + 1, q, j, 0);
+      compute_jacobian(dphi, geometry, J);
       compute_jacobian_inverse(J, K);
 
-      // Compute dX = K * (x_p - x_k)
+      // Compute dX = K * (x_p - x_k) and Xk += dX
       std::ranges::fill(dX, 0);
       for (std::size_t i = 0; i < K.extent(0); ++i)
         for (std::size_t j = 0; j < K.extent(1); ++j)
           dX[i] += K(i, j) * (x(p, j) - xk[j]);
+      for (std::size_t i = 0; i < tdim; ++i)
+        Xk_b[p * tdim + i] += dX[i];
+
+      // Keep the point unless norm(dX) is below the tolerance
+      if (auto dX_squared = std::transform_reduce(
+              dX.cbegin(), std::next(dX.cbegin(), tdim), 0.0, std::plus{},
+              [](auto v) { return v * v; });
+          !(std::sqrt(dX_squared) < tol))
+      {
+        active[num_active++] = p;
+      }
+    }
+    active.resize(num_active);
+  }
 
-      // Compute Xk += dX
-      std::ranges::transform(dX, Xk_b, Xk_b.begin(),
-                             [](auto a, auto b) { return a + b; });
+  for (std::size_t p = 0; p < num_points; ++p)
+    for (std::size_t i = 0; i < tdim; ++i)
+      X(p, i) = Xk_b[p * tdim + i];
+  if (!active.empty())
+  {
+    throw std::runtime_error(
+        "Newton method failed to converge for non-affine geometry");
+  }
+}
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
+std::vector<T> CoordinateElement<T>::bernstein_matrix() const
+{
+  assert(_element);
+  const mesh::CellType cell = this->cell_shape();
+  const bool simplex = mesh::is_simplex(cell);
+  if (!simplex and cell != mesh::CellType::quadrilateral
+      and cell != mesh::CellType::hexahedron)
+  {
+    return {};
+  }
+
+  const int p = _element->degree();
+  const std::size_t tdim = mesh::cell_dim(cell);
+  const std::size_t n = _element->dim();
+  const auto& [X_b, Xshape] = _element->points();
+  assert(Xshape[0] == n);
+  assert(Xshape[1] == tdim);
+
+  // Binomial coefficients of degree p
+  std::vector<double> binom(p + 1, 1);
+  for (int i = 1; i <= p; ++i)
+    binom[i] = binom[i - 1] * (p - i + 1) / i;
+
+  // Exponents of the Bernstein polynomials, in the barycentric
+  // coordinates (1 - X0 - ..., X0, ...) for simplices and in (1 - Xi,
+  // Xi) in each direction for tensor product cells
+  std::vector<std::array<int, 4>> alpha;
+  if (simplex)
+  {
+    for (int a1 = 0; a1 <= p; ++a1)
+      for (int a2 = 0; a2 <= (tdim > 1 ? p - a1 : 0); ++a2)
+        for (int a3 = 0; a3 <= (tdim > 2 ? p - a1 - a2 : 0); ++a3)
+          alpha.push_back({p - a1 - a2 - a3, a1, a2, a3});
+  }
+  else
+  {
+    for (int a1 = 0; a1 <= p; ++a1)
+      for (int a2 = 0; a2 <= p; ++a2)
+        for (int a3 = 0; a3 <= (tdim > 2 ? p : 0); ++a3)
+          alpha.push_back({0, a1, a2, a3});
+  }
+  if (alpha.size() != n)
+    return {};
 
-      // Compute norm(dX)
-      if (auto dX_squared
-          = std::transform_reduce(dX.cbegin(), dX.cend(), 0.0, std::plus{},
-                                  [](auto v) { return v * v; });
-          std::sqrt(dX_squared) < tol)
+  // A(j, k) = B_k(X_j), with the Bernstein polynomials B_k evaluated
+  // at the nodes X_j. The control points c satisfy x = A c.
+  std::vector<double> A(n * n);
+  for (std::size_t j = 0; j < n; ++j)
+  {
+    std::span<const T> X(X_b.data() + j * tdim, tdim);
+    for (std::size_t k = 0; k < n; ++k)
+    {
+      double b = 1;
+      if (simplex)
+      {
+        // Multinomial coefficient p! / (a0! a1! ...), as a product of
+        // binomial coefficients
+        double lambda0 = 1;
+        int m = p;
+        for (std::size_t i = 0; i < tdim; ++i)
+        {
+          const int a = alpha[k][i + 1];
+          lambda0 -= X[i];
+          for (int l = 1; l <= a; ++l)
+            b = b * (m - l + 1) / l;
+          b *= std::pow(X[i], a);
+          m -= a;
+        }
+        b *= std::pow(lambda0, alpha[k][0]);
+      }
+      else
       {
-        break;
+        for (std::size_t i = 0; i < tdim; ++i)
+        {
+          const int a = alpha[k][i + 1];
+          b *= binom[a] * std::pow(X[i], a) * std::pow(1 - X[i], p - a);
+        }
       }
+      A[j * n + k] = b;
+    }
+  }
+
+  // Invert A by Gauss-Jordan elimination with partial pivoting
+  std::vector<double> M(n * n, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    M[i * n + i] = 1;
+  for (std::size_t c = 0; c < n; ++c)
+  {
+    std::size_t pivot = c;
+    for (std::size_t r = c + 1; r < n; ++r)
+    {
+      if (std::abs(A[r * n + c]) > std::abs(A[pivot * n + c]))
+        pivot = r;
+    }
+    if (pivot != c)
+    {
+      std::swap_ranges(std::next(A.begin(), c * n),
+                       std::next(A.begin(), (c + 1) * n),
+                       std::next(A.begin(), pivot * n));
+      std::swap_ranges(std::next(M.begin(), c * n),
+                       std::next(M.begin(), (c + 1) * n),
+                       std::next(M.begin(), pivot * n));
     }
 
-    std::copy(Xk_b.cbegin(), std::next(Xk_b.cbegin(), tdim),
-              X.data_handle() + p * tdim);
-    if (k == maxit)
+    const double d = A[c * n + c];
+    for (std::size_t l = 0; l < n; ++l)
+    {
+      A[c * n + l] /= d;
+      M[c * n + l] /= d;
+    }
+    for (std::size_t r = 0; r < n; ++r)
     {
-      throw std::runtime_error(
-          "Newton method failed to converge for non-affine geometry");
+      if (const double f = A[r * n + c]; r != c and f != 0)
+      {
+        for (std::size_t l = 0; l < n; ++l)
+        {
+          A[r * n + l] -= f * A[c * n + l];
+          M[r * n + l] -= f * M[c * n + l];
+        }
+      }
     }
   }
+
+  return std::vector<T>(M.begin(), M.end());
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "ElementDofLayout.h"
+#include "TabulationCache.h"
 #include <algorithm>
 #include <array>
 #include <basix/element-families.h>
@@ -100,6 +101,33 @@ public:
   void tabulate(int nd, std::span<const T> X, std::array<std::size_t, 2> shape,
                 std::span<T> basis) const;
 
+  /// @brief Evaluate basis values and derivatives at set of points,
+  /// using the tabulation cache.
+  ///
+  /// Use for fixed point sets that are tabulated repeatedly, e.g.
+  /// interpolation or quadrature points, but not for arbitrary
+  /// evaluation points. See tabulation_cache().
+  ///
+  /// @param[in] nd The order of derivatives, up to and including, to
+  /// compute. Use 0 for the basis functions only.
+  /// @param[in] X The points at which to compute the basis functions.
+  /// The shape of X is (number of points, geometric dimension).
+  /// @param[in] shape The shape of `X`.
+  /// @param[out] basis The array to fill with the basis function
+  /// values. The shape can be computed using `tabulate_shape`.
+  void tabulate_cached(int nd, std::span<const T> X,
+                       std::array<std::size_t, 2> shape,
+                       std::span<T> basis) const;
+
+  /// @brief Cache of the tabulations of the basis functions.
+  ///
+  /// Only tabulate_cached() uses the cache, which is shared by copies of
+  /// the coordinate element. Its size
+  /// bound can be changed, or the cache disabled, through the returned
+  /// object.
+  /// @return The tabulation cache.
+  TabulationCache<T>& tabulation_cache() const { return *_tabulation_cache; }
+
   /// @brief Given the closure DOFs \f$\tilde{d}\f$ of a cell sub-entity in
   /// reference ordering, this function computes the permuted degrees-of-freedom
   ///   \f[ d = P \tilde{d},\f]
@@ -233,6 +261,10 @@ public:
   template <typename X>
   using mdspan2_t = md::mdspan<X, md::dextents<std::size_t, 2>>;
 
+  /// mdspan typedef
+  template <typename X>
+  using mdspan3_t = md::mdspan<X, md::dextents<std::size_t, 3>>;
+
   /// @brief Compute reference coordinates `X` for physical coordinates
   /// `x` for a non-affine map.
   /// @param [in,out] X The reference coordinates to compute
@@ -242,11 +274,58 @@ public:
   /// geometry nodes, gdim)`).
   /// @param [in] tol Tolerance for termination of Newton method.
   /// @param [in] maxit Maximum number of Newton iterations
+  /// @param [in] initial_guess If `true`, `X` holds the initial guesses
+  /// of the Newton iterations on input. Otherwise the iterations start
+  /// at the origin of the reference cell.
   /// @note If convergence is not achieved within `maxit`, the function
   /// throws a runtime error.
   void pull_back_nonaffine(mdspan2_t<T> X, mdspan2_t<const T> x,
                            mdspan2_t<const T> cell_geometry,
-                           double tol = 1.0e-6, int maxit = 15) const;
+                           double tol = 1.0e-6, int maxit = 15,
+                           bool initial_guess = false) const;
+
+  /// @brief Compute reference coordinates `X` for physical coordinates
+  /// `x` in different cells for a non-affine map.
+  ///
+  /// The Newton iterations of all points run in lockstep, i.e. the
+  /// basis is tabulated at all unconverged points with one call per
+  /// iteration, and converged points drop out. This is much faster than
+  /// pulling back points one at a time.
+  ///
+  /// @param [in,out] X The reference coordinates to compute
+  /// (shape=`(num_points, tdim)`).
+  /// @param [in] x Physical coordinates (`shape=(num_points, gdim)`).
+  /// @param [in] cell_geometry Node coordinates of the cell of each
+  /// point (`shape=(num_points, num geometry nodes, gdim)`).
+  /// @param [in] tol Tolerance for termination of Newton method.
+  /// @param [in] maxit Maximum number of Newton iterations
+  /// @param [in] initial_guess If `true`, `X` holds the initial guesses
+  /// of the Newton iterations on input, e.g. from
+  /// mesh::CurvedGeometryCache::initial_guess. Otherwise the iterations
+  /// start at the origin of the reference cell.
+  /// @note If convergence is not achieved within `maxit` for a point,
+  /// the function throws a runtime error.
+  void pull_back_nonaffine(mdspan2_t<T> X, mdspan2_t<const T> x,
+                           mdspan3_t<const T> cell_geometry,
+                           double tol = 1.0e-6, int maxit = 15,
+                           bool initial_guess = false) const;
+
+  /// @brief Compute the matrix that maps the node coordinates of a cell
+  /// to the control points of its Bernstein-Bézier representation.
+  ///
+  /// The geometry of a cell is a polynomial map, which can be written
+  /// in the Bernstein basis of the same degree. Since the Bernstein
+  /// polynomials are non-negative and sum to one, a cell lies in the
+  /// convex hull of its control points. Bounds computed from the
+  /// control points therefore enclose curved cells, which bounds from
+  /// the Lagrange nodes in general do not, and converge to the cell as
+  /// the cell is refined.
+  ///
+  /// @return Matrix `M` (shape `(dim(), dim())`, row-major) such that
+  /// the control points of a cell are `M x`, where `x` (shape `(dim(),
+  /// gdim)`) are the node coordinates. Empty if the Bernstein basis is
+  /// not implemented for the cell type (prisms and pyramids).
+  std::vector<T> bernstein_matrix() const;
 
   /// @brief Permute a list of DOF numbers on a cell.
   void permute(std::span<std::int32_t> dofs, std::uint32_t cell_perm) const;
@@ -266,10 +345,22 @@ public:
   bool is_affine() const noexcept { return _is_affine; }
 
 private:
+  // Pull back points in lockstep, where cell_geometry(p) returns the
+  // node coordinates of the cell of point p
+  template <typename G>
+  void pull_back_nonaffine_impl(mdspan2_t<T> X, mdspan2_t<const T> x,
+                                G&& cell_geometry, std::size_t num_xnodes,
+                                double tol, int maxit,
+                                bool initial_guess) const;
+
   // Flag denoting affine map
   bool _is_affine;
 
   // Basix Element
   std::shared_ptr<const basix::FiniteElement<T>> _element;
+
+  // Cache of basis function tabulations
+  std::shared_ptr<TabulationCache<T>> _tabulation_cache
+      = std::make_shared<TabulationCache<T>>();
 };
 } // namespace dolfinx::fem
@@ -9,8 +9,9 @@
 #include "FiniteElement.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <dolfinx/common/IndexMap.h>
-#include <dolfinx/common/sort.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/cell_types.h>
@@ -29,11 +30,13 @@ namespace
 /// @param[in] mesh The mesh
 /// @param[in] entities The list of entities
 /// @param[in] dim The dimension of the entities
+/// @param[in] num_threads Number of threads
 /// @returns A list of (cell_index, entity_index) pairs for each input
 /// entity.
 std::vector<std::pair<std::int32_t, int>>
 find_local_entity_index(const mesh::Topology& topology,
-                        std::span<const std::int32_t> entities, int dim)
+                        std::span<const std::int32_t> entities, int dim,
+                        int num_threads)
 {
   // Initialise entity-cell connectivity
   const int tdim = topology.dim();
@@ -53,26 +56,65 @@ find_local_entity_index(const mesh::Topology& topology,
         + std::to_string(tdim) + "->" + std::to_string(dim));
   }
 
-  std::vector<std::pair<std::int32_t, int>> entity_indices;
-  entity_indices.reserve(entities.size());
-  for (std::int32_t e : entities)
-  {
-    // Get first attached cell
-    assert(e_to_c->num_links(e) > 0);
-    const int cell = e_to_c->links(e).front();
-
-    // Get local index of facet with respect to the cell
-    auto entities_d = c_to_e->links(cell);
-    auto it = std::find(entities_d.begin(), entities_d.end(), e);
-    assert(it != entities_d.end());
-    std::size_t entity_local_index = std::distance(entities_d.begin(), it);
-    entity_indices.emplace_back(cell, entity_local_index);
-  }
+  std::vector<std::pair<std::int32_t, int>> entity_indices(entities.size());
+  common::parallel_for(
+      entities.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          // Get first attached cell
+          const std::int32_t e = entities[i];
+          assert(e_to_c->num_links(e) > 0);
+          const int cell = e_to_c->links(e).front();
+
+          // Get local index of facet with respect to the cell
+          auto entities_d = c_to_e->links(cell);
+          auto it = std::find(entities_d.begin(), entities_d.end(), e);
+          assert(it != entities_d.end());
+          entity_indices[i]
+              = {cell, (int)std::distance(entities_d.begin(), it)};
+        }
+      });
 
   return entity_indices;
 }
 //-----------------------------------------------------------------------------
 
+/// Create a 'symmetric' neighbourhood communicator for the ranks that
+/// share indices of an index map. The caller must free the
+/// communicator.
+MPI_Comm create_symmetric_comm(const common::IndexMap& map)
+{
+  std::span src = map.src();
+  std::span dest = map.dest();
+  std::vector<int> ranks;
+  std::ranges::set_union(src, dest, std::back_inserter(ranks));
+  auto [unique_end, range_end] = std::ranges::unique(ranks);
+  ranks.erase(unique_end, range_end);
+  MPI_Comm comm;
+  MPI_Dist_graph_create_adjacent(map.comm(), ranks.size(), ranks.data(),
+                                 MPI_UNWEIGHTED, ranks.size(), ranks.data(),
+                                 MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
+  return comm;
+}
+//-----------------------------------------------------------------------------
+
+/// Positions of the entries of an array that are set (not equal to
+/// `unset`), in increasing order
+template <typename T>
+std::vector<std::int32_t> set_entries(std::span<const T> x, T unset)
+{
+  std::vector<std::int32_t> indices;
+  for (std::size_t i = 0; i < x.size(); ++i)
+  {
+    if (x[i] != unset)
+      indices.push_back(i);
+  }
+  return indices;
+}
+//-----------------------------------------------------------------------------
+
 /// Find all DOFs on this process that have been detected on another
 /// process
 /// @param[in] comm A symmetric communicator
@@ -186,7 +228,7 @@ get_remote_dofs(MPI_Comm comm, const common::IndexMap& map, int bs_map,
 //-----------------------------------------------------------------------------
 std::vector<std::int32_t> fem::locate_dofs_topological(
     const mesh::Topology& topology, const DofMap& dofmap, int dim,
-    std::span<const std::int32_t> entities, bool remote)
+    std::span<const std::int32_t> entities, bool remote, int num_threads)
 {
   mesh::CellType cell_type = topology.cell_type();
 
@@ -202,92 +244,81 @@ std::vector<std::int32_t> fem::locate_dofs_topological(
 
   // Get cell index and local entity index
   std::vector<std::pair<std::int32_t, int>> entity_indices
-      = find_local_entity_index(topology, entities, dim);
-
-  std::vector<std::int32_t> dofs;
-  dofs.reserve(entities.size()
-               * dofmap.element_dof_layout().num_entity_closure_dofs(dim));
+      = find_local_entity_index(topology, entities, dim, num_threads);
 
   // V is a sub space we need to take the block size of the dofmap and
   // the index map into account as they can differ
   const int bs = dofmap.bs();
   const int element_bs = dofmap.element_dof_layout().block_size();
+  if (element_bs != bs and bs != 1)
+    throw std::runtime_error("Block size combination not supported");
 
-  // Iterate over marked facets
-  if (element_bs == bs)
-  {
-    // Work with blocks
-    for (auto [cell, entity_local_index] : entity_indices)
-    {
-      // Get cell dofmap and loop over entity dofs
-      auto cell_dofs = dofmap.cell_dofs(cell);
-      for (int index : entity_dofs[entity_local_index])
-        dofs.push_back(cell_dofs[index]);
-    }
-  }
-  else if (bs == 1)
-  {
-    // Space is not blocked, unroll dofs
-    for (auto [cell, entity_local_index] : entity_indices)
-    {
-      // Get cell dofmap and loop over facet dofs and 'unpack' blocked
-      // dofs
-      std::span<const std::int32_t> cell_dofs = dofmap.cell_dofs(cell);
-      for (int index : entity_dofs[entity_local_index])
+  // Mark the dofs of the marked entities. Dofs are marked in an array
+  // over all dofs, rather than collected and sorted, and threads mark
+  // concurrently (different threads can mark the same dof).
+  auto map = dofmap.index_map;
+  assert(map);
+  std::vector<std::int8_t> marker(
+      dofmap.index_map_bs() * (map->size_local() + map->num_ghosts()), false);
+  common::parallel_for(
+      entity_indices.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
       {
-        for (int k = 0; k < element_bs; ++k)
+        auto mark = [&marker](std::int32_t dof)
         {
-          const std::div_t pos = std::div(element_bs * index + k, bs);
-          dofs.push_back(bs * cell_dofs[pos.quot] + pos.rem);
-        }
-      }
-    }
-  }
-  else
-    throw std::runtime_error("Block size combination not supported");
+          assert(dof < (std::int32_t)marker.size());
+          std::atomic_ref(marker[dof]).store(true, std::memory_order_relaxed);
+        };
 
-  // TODO: is removing duplicates at this point worth the effort?
-  // Remove duplicates
-  std::ranges::sort(dofs);
-  auto [unique_end, range_end] = std::ranges::unique(dofs);
-  dofs.erase(unique_end, range_end);
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          auto [cell, entity_local_index] = entity_indices[i];
+          std::span<const std::int32_t> cell_dofs = dofmap.cell_dofs(cell);
+          if (element_bs == bs)
+          {
+            // Work with blocks
+            for (int index : entity_dofs[entity_local_index])
+              mark(cell_dofs[index]);
+          }
+          else
+          {
+            // Space is not blocked, 'unpack' blocked dofs
+            for (int index : entity_dofs[entity_local_index])
+            {
+              for (int k = 0; k < element_bs; ++k)
+              {
+                const std::div_t pos = std::div(element_bs * index + k, bs);
+                mark(bs * cell_dofs[pos.quot] + pos.rem);
+              }
+            }
+          }
+        }
+      });
 
+  std::vector<std::int32_t> dofs
+      = set_entries(std::span<const std::int8_t>(marker), std::int8_t(0));
   if (remote)
   {
     // Get bc dof indices (local) in V spaces on this process that were
     // found by other processes, e.g. a vertex dof on this process that
     // has no connected facets on the boundary.
-    auto map = dofmap.index_map;
-    assert(map);
-
-    // Create 'symmetric' neighbourhood communicator
-    MPI_Comm comm;
-    {
-      std::span src = map->src();
-      std::span dest = map->dest();
-      std::vector<int> ranks;
-      std::ranges::set_union(src, dest, std::back_inserter(ranks));
-      auto [unique_end, range_end] = std::ranges::unique(ranks);
-      ranks.erase(unique_end, range_end);
-      MPI_Dist_graph_create_adjacent(
-          map->comm(), ranks.size(), ranks.data(), MPI_UNWEIGHTED, ranks.size(),
-          ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
-    }
-
+    MPI_Comm comm = create_symmetric_comm(*map);
     std::vector<std::int32_t> dofs_remote;
     if (int map_bs = dofmap.index_map_bs(); map_bs == bs)
       dofs_remote = get_remote_dofs(comm, *map, 1, dofs);
     else
       dofs_remote = get_remote_dofs(comm, *map, map_bs, dofs);
-
     MPI_Comm_free(&comm);
 
-    // Add received bc indices to dofs_local, sort, and remove
-    // duplicates
-    dofs.insert(dofs.end(), dofs_remote.begin(), dofs_remote.end());
-    std::ranges::sort(dofs);
-    auto [unique_end, range_end] = std::ranges::unique(dofs);
-    dofs.erase(unique_end, range_end);
+    // Add received bc indices
+    bool added = false;
+    for (std::int32_t dof : dofs_remote)
+    {
+      added = added or !marker[dof];
+      marker[dof] = true;
+    }
+    if (added)
+      dofs = set_entries(std::span<const std::int8_t>(marker), std::int8_t(0));
   }
 
   return dofs;
@@ -296,7 +327,7 @@ std::vector<std::int32_t> fem::locate_dofs_topological(
 std::array<std::vector<std::int32_t>, 2> fem::locate_dofs_topological(
     const mesh::Topology& topology,
     std::array<std::reference_wrapper<const DofMap>, 2> dofmaps, const int dim,
-    std::span<const std::int32_t> entities, bool remote)
+    std::span<const std::int32_t> entities, bool remote, int num_threads)
 {
   // Get dofmaps
   const DofMap& dofmap0 = dofmaps.at(0).get();
@@ -320,116 +351,87 @@ std::array<std::vector<std::int32_t>, 2> fem::locate_dofs_topological(
 
   // Get cell index and local entity index
   std::vector<std::pair<std::int32_t, int>> entity_indices
-      = find_local_entity_index(topology, entities, dim);
-
-  // Iterate over marked facets
+      = find_local_entity_index(topology, entities, dim, num_threads);
+
+  // Store the dof in V1 of each marked dof in V0 (-1 if not marked).
+  // The array over all dofs of V0 replaces collecting and sorting the
+  // dof pairs. Threads can mark the same dof, which always has the
+  // same dof in V1.
+  auto map0 = dofmap0.index_map;
+  assert(map0);
+  std::vector<std::int32_t> dof1_of(
+      dofmap0.index_map_bs() * (map0->size_local() + map0->num_ghosts()), -1);
   const int element_bs = dofmap0.element_dof_layout().block_size();
-  std::array<std::vector<std::int32_t>, 2> bc_dofs;
-  bc_dofs[0].reserve(entities.size()
-                     * dofmap0.element_dof_layout().num_entity_closure_dofs(dim)
-                     * element_bs);
-  bc_dofs[1].reserve(entities.size()
-                     * dofmap0.element_dof_layout().num_entity_closure_dofs(dim)
-                     * element_bs);
-  for (auto [cell, entity_local_index] : entity_indices)
-  {
-    // Get cell dofmap
-    std::span<const std::int32_t> cell_dofs0 = dofmap0.cell_dofs(cell);
-    std::span<const std::int32_t> cell_dofs1 = dofmap1.cell_dofs(cell);
-    assert(bs[0] * cell_dofs0.size() == bs[1] * cell_dofs1.size());
-
-    // Loop over facet dofs and 'unpack' blocked dofs
-    for (int index : entity_dofs[entity_local_index])
-    {
-      for (int k = 0; k < element_bs; ++k)
+  common::parallel_for(
+      entity_indices.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
       {
-        const int local_pos = element_bs * index + k;
-        const std::div_t pos0 = std::div(local_pos, bs[0]);
-        const std::div_t pos1 = std::div(local_pos, bs[1]);
-        std::int32_t dof_index0 = bs[0] * cell_dofs0[pos0.quot] + pos0.rem;
-        std::int32_t dof_index1 = bs[1] * cell_dofs1[pos1.quot] + pos1.rem;
-        bc_dofs[0].push_back(dof_index0);
-        bc_dofs[1].push_back(dof_index1);
-      }
-    }
-  }
-
-  // TODO: is removing duplicates at this point worth the effort?
-  // Remove duplicates
-  std::vector<std::int32_t> perm(bc_dofs[0].size());
-  std::iota(perm.begin(), perm.end(), 0);
-  dolfinx::radix_sort(perm,
-                      [&dofs = bc_dofs[0]](auto index) { return dofs[index]; });
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          // Get cell dofmap
+          auto [cell, entity_local_index] = entity_indices[i];
+          std::span<const std::int32_t> cell_dofs0 = dofmap0.cell_dofs(cell);
+          std::span<const std::int32_t> cell_dofs1 = dofmap1.cell_dofs(cell);
+          assert(bs[0] * cell_dofs0.size() == bs[1] * cell_dofs1.size());
+
+          // Loop over facet dofs and 'unpack' blocked dofs
+          for (int index : entity_dofs[entity_local_index])
+          {
+            for (int k = 0; k < element_bs; ++k)
+            {
+              const int local_pos = element_bs * index + k;
+              const std::div_t pos0 = std::div(local_pos, bs[0]);
+              const std::div_t pos1 = std::div(local_pos, bs[1]);
+              std::int32_t dof0 = bs[0] * cell_dofs0[pos0.quot] + pos0.rem;
+              std::int32_t dof1 = bs[1] * cell_dofs1[pos1.quot] + pos1.rem;
+              assert(dof0 < (std::int32_t)dof1_of.size());
+              std::atomic_ref(dof1_of[dof0])
+                  .store(dof1, std::memory_order_relaxed);
+            }
+          }
+        }
+      });
 
-  std::array<std::vector<std::int32_t>, 2> sorted_bc_dofs = bc_dofs;
-  for (std::size_t b = 0; b < 2; ++b)
+  auto collect = [&dof1_of]()
   {
-    std::ranges::transform(perm, sorted_bc_dofs[b].begin(),
-                           [&bc_dofs = bc_dofs[b]](auto p)
-                           { return bc_dofs[p]; });
-    auto [unique_end, range_end] = std::ranges::unique(sorted_bc_dofs[b]);
-    sorted_bc_dofs[b].erase(unique_end, range_end);
-  }
-
-  if (!remote)
-    return sorted_bc_dofs;
-  else
+    std::array<std::vector<std::int32_t>, 2> dofs;
+    dofs[0] = set_entries(std::span<const std::int32_t>(dof1_of), -1);
+    dofs[1].resize(dofs[0].size());
+    std::ranges::transform(dofs[0], dofs[1].begin(),
+                           [&dof1_of](auto dof0) { return dof1_of[dof0]; });
+    return dofs;
+  };
+
+  std::array<std::vector<std::int32_t>, 2> bc_dofs = collect();
+  if (remote)
   {
     // Get bc dof indices (local) for each of spaces on this process that
     // were found by other processes, e.g. a vertex dof on this process
     // that has no connected facets on the boundary.
-
-    auto map0 = dofmap0.index_map;
-    assert(map0);
-
-    // Create 'symmetric' neighbourhood communicator
-    MPI_Comm comm;
-    {
-      std::span src = map0->src();
-      std::span dest = map0->dest();
-      std::vector<int> ranks;
-      std::ranges::set_union(src, dest, std::back_inserter(ranks));
-      auto [unique_end, range_end] = std::ranges::unique(ranks);
-      ranks.erase(unique_end, range_end);
-      MPI_Dist_graph_create_adjacent(map0->comm(), ranks.size(), ranks.data(),
-                                     MPI_UNWEIGHTED, ranks.size(), ranks.data(),
-                                     MPI_UNWEIGHTED, MPI_INFO_NULL, false,
-                                     &comm);
-    }
-
-    std::vector<std::int32_t> dofs_remote = get_remote_dofs(
-        comm, *map0, dofmap0.index_map_bs(), sorted_bc_dofs[0]);
-
-    // Add received bc indices to dofs_local
-    sorted_bc_dofs[0].insert(sorted_bc_dofs[0].end(), dofs_remote.begin(),
-                             dofs_remote.end());
-
-    dofs_remote = get_remote_dofs(comm, *(dofmap1.index_map),
-                                  dofmap1.index_map_bs(), sorted_bc_dofs[1]);
-    sorted_bc_dofs[1].insert(sorted_bc_dofs[1].end(), dofs_remote.begin(),
-                             dofs_remote.end());
-    assert(sorted_bc_dofs[0].size() == sorted_bc_dofs[1].size());
-
+    MPI_Comm comm = create_symmetric_comm(*map0);
+    std::vector<std::int32_t> dofs_remote0
+        = get_remote_dofs(comm, *map0, dofmap0.index_map_bs(), bc_dofs[0]);
+    std::vector<std::int32_t> dofs_remote1
+        = get_remote_dofs(comm, *(dofmap1.index_map), dofmap1.index_map_bs(),
+                          bc_dofs[1]);
+    assert(dofs_remote0.size() == dofs_remote1.size());
     MPI_Comm_free(&comm);
 
-    // Remove duplicates and sort
-    perm.resize(sorted_bc_dofs[0].size());
-    std::iota(perm.begin(), perm.end(), 0);
-    dolfinx::radix_sort(perm, [&dofs = sorted_bc_dofs[0]](auto index)
-                        { return dofs[index]; });
-
-    std::array<std::vector<std::int32_t>, 2> out_dofs = sorted_bc_dofs;
-    for (std::size_t b = 0; b < 2; ++b)
+    // Add received bc indices
+    bool added = false;
+    for (std::size_t i = 0; i < dofs_remote0.size(); ++i)
     {
-      std::ranges::transform(perm, out_dofs[b].begin(),
-                             [&sorted_dofs = sorted_bc_dofs[b]](auto p)
-                             { return sorted_dofs[p]; });
-      auto [unique_end, range_end] = std::ranges::unique(out_dofs[b]);
-      out_dofs[b].erase(unique_end, range_end);
+      if (std::int32_t& dof1 = dof1_of[dofs_remote0[i]]; dof1 < 0)
+      {
+        dof1 = dofs_remote1[i];
+        added = true;
+      }
     }
-
-    assert(out_dofs[0].size() == out_dofs[1].size());
-    return out_dofs;
+    if (added)
+      bc_dofs = collect();
   }
+
+  assert(bc_dofs[0].size() == bc_dofs[1].size());
+  return bc_dofs;
 }
 //-----------------------------------------------------------------------------
@@ -14,11 +14,15 @@
 #include <algorithm>
 #include <array>
 #include <concepts>
+#include <cstdint>
 #include <dolfinx/common/types.h>
+#include <dolfinx/mesh/MeshTags.h>
 #include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <span>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -47,15 +51,17 @@ namespace dolfinx::fem
 /// entity as a marked. For example, a boundary condition dof at a
 /// vertex where this process does not have the associated boundary
 /// facet. This commonly occurs with partitioned meshes.
+/// @param[in] num_threads Number of threads used to find the DOFs of
+/// the entities.
 /// @return Array of DOF index blocks (local to the MPI rank) in the
 /// space V. The array uses the block size of the dofmap associated
-/// with V.
+/// with V. The indices are sorted.
 /// @pre The topology cell->entity and entity->cell connectivity must
 /// have been computed before calling this function.
 std::vector<std::int32_t>
 locate_dofs_topological(const mesh::Topology& topology, const DofMap& dofmap,
                         int dim, std::span<const std::int32_t> entities,
-                        bool remote = true);
+                        bool remote = true, int num_threads = 1);
 
 /// @brief Find degrees-of-freedom which belong to the provided mesh
 /// entities (topological).
@@ -77,16 +83,20 @@ locate_dofs_topological(const mesh::Topology& topology, const DofMap& dofmap,
 /// entity as a marked. For example, a boundary condition dof at a
 /// vertex where this process does not have the associated boundary
 /// facet. This commonly occurs with partitioned meshes.
+/// @param[in] num_threads Number of threads used to find the DOFs of
+/// the entities.
 /// @return Array of DOF indices (local to the MPI rank) in the spaces
 /// V[0] and V[1]. The array[0](i) entry is the DOF index in the space
 /// V[0] and array[1](i) is the corresponding DOF entry in the space
-/// V[1]. The returned dofs are 'unrolled', i.e. block size = 1.
+/// V[1]. The returned dofs are 'unrolled', i.e. block size = 1, and
+/// sorted by the DOF index in V[0].
 /// @pre The topology cell->entity and entity->cell connectivity must
 /// have been computed before calling this function.
 std::array<std::vector<std::int32_t>, 2> locate_dofs_topological(
     const mesh::Topology& topology,
     std::array<std::reference_wrapper<const DofMap>, 2> dofmaps, int dim,
-    std::span<const std::int32_t> entities, bool remote = true);
+    std::span<const std::int32_t> entities, bool remote = true,
+    int num_threads = 1);
 
 /// @brief Find degrees of freedom whose geometric coordinate is true
 /// for the provided marking function.
@@ -195,17 +205,23 @@ std::array<std::vector<std::int32_t>, 2> locate_dofs_geometrical(
   const int element_bs = dofmap0->element_dof_layout().block_size();
   assert(element_bs == dofmap1->element_dof_layout().block_size());
 
+  // Store the dof in V1 of each marked dof in V0 (-1 if not marked).
+  // The array over all dofs of V0 replaces sorting the dof pairs.
+  auto map0 = dofmap0->index_map;
+  assert(map0);
+  std::vector<std::int32_t> dof1_of(
+      dofmap0->index_map_bs() * (map0->size_local() + map0->num_ghosts()), -1);
+
   // Iterate over cells
   auto topology = mesh->topology();
   assert(topology);
-  std::vector<std::array<std::int32_t, 2>> bc_dofs;
   for (int c = 0; c < topology->connectivity(tdim, 0)->num_nodes(); ++c)
   {
     // Get cell dofmaps
     auto cell_dofs0 = dofmap0->cell_dofs(c);
     auto cell_dofs1 = dofmap1->cell_dofs(c);
 
-    // Loop over cell dofs and add to bc_dofs if marked.
+    // Loop over cell dofs and store the marked dofs
     for (std::size_t i = 0; i < cell_dofs1.size(); ++i)
     {
       if (marked_dofs[cell_dofs1[i]])
@@ -220,28 +236,108 @@ std::array<std::vector<std::int32_t>, 2> locate_dofs_geometrical(
               = bs0 * cell_dofs0[pos0.quot] + pos0.rem;
           const std::int32_t dof_index1
               = bs1 * cell_dofs1[pos1.quot] + pos1.rem;
-          bc_dofs.push_back({dof_index0, dof_index1});
+          dof1_of[dof_index0] = dof_index1;
         }
       }
     }
   }
 
-  // Remove duplicates
-  std::ranges::sort(bc_dofs);
-  auto [unique_end, range_end] = std::ranges::unique(bc_dofs);
-  bc_dofs.erase(unique_end, range_end);
-
-  // Copy to separate array
-  std::array dofs = {std::vector<std::int32_t>(bc_dofs.size()),
-                     std::vector<std::int32_t>(bc_dofs.size())};
-  std::ranges::transform(bc_dofs, dofs[0].begin(),
-                         [](auto dof) { return dof[0]; });
-  std::ranges::transform(bc_dofs, dofs[1].begin(),
-                         [](auto dof) { return dof[1]; });
+  // Copy to separate arrays
+  std::array<std::vector<std::int32_t>, 2> dofs;
+  for (std::size_t i = 0; i < dof1_of.size(); ++i)
+  {
+    if (dof1_of[i] >= 0)
+    {
+      dofs[0].push_back(i);
+      dofs[1].push_back(dof1_of[i]);
+    }
+  }
 
   return dofs;
 }
 
+/// @brief Cache of the DOFs of tagged mesh entities.
+///
+/// The DOFs of the entities with a tag value are located (see
+/// fem::locate_dofs_topological) the first time that they are
+/// requested, and stored by dofmap, tags (which carry the topological
+/// dimension of the entities) and value. A boundary that is used for
+/// several boundary conditions is then located once.
+///
+/// @note The dofmap and tags are assumed to not change. An entry is
+/// recomputed if the dofmap or tags that it was computed for have been
+/// destroyed.
+/// @note This class is not thread-safe.
+/// @tparam T Type of the tag values.
+template <typename T>
+class TopologicalDofLocator
+{
+public:
+  /// @brief Create an empty cache.
+  /// @param[in] num_threads Number of threads used to locate the DOFs.
+  explicit TopologicalDofLocator(int num_threads = 1)
+      : _num_threads(num_threads)
+  {
+  }
+
+  /// @brief Get the DOFs of tagged mesh entities.
+  /// @param[in] dofmap Dofmap that associated DOFs with cells.
+  /// @param[in] tags Tags of mesh entities.
+  /// @param[in] value Tag value of the entities.
+  /// @param[in] remote True to return also "remotely located" DOFs, see
+  /// fem::locate_dofs_topological.
+  /// @return DOF index blocks (local to the MPI rank), as returned by
+  /// fem::locate_dofs_topological. The array is valid until the cache
+  /// is cleared or destroyed.
+  /// @pre The topology cell->entity and entity->cell connectivity must
+  /// have been computed before calling this function.
+  const std::vector<std::int32_t>&
+  operator()(std::shared_ptr<const DofMap> dofmap,
+             std::shared_ptr<const mesh::MeshTags<T>> tags, const T& value,
+             bool remote = true)
+  {
+    assert(dofmap);
+    assert(tags);
+    assert(tags->topology());
+    auto [it, inserted] = _entries.try_emplace(
+        std::tuple(dofmap.get(), tags.get(), value, remote));
+    Entry& e = it->second;
+    if (inserted or e.dofmap.lock() != dofmap or e.tags.lock() != tags)
+    {
+      e.dofmap = dofmap;
+      e.tags = tags;
+      e.dofs = locate_dofs_topological(*tags->topology(), *dofmap,
+                                       tags->dim(), tags->find(value),
+                                       remote, _num_threads);
+    }
+
+    return e.dofs;
+  }
+
+  /// @brief Remove all cached DOFs.
+  void clear() { _entries.clear(); }
+
+  /// @brief Number of cached DOF arrays.
+  std::size_t size() const { return _entries.size(); }
+
+private:
+  // Cached DOFs, and the dofmap and tags that they were computed for
+  struct Entry
+  {
+    std::weak_ptr<const DofMap> dofmap;
+    std::weak_ptr<const mesh::MeshTags<T>> tags;
+    std::vector<std::int32_t> dofs;
+  };
+
+  // Number of threads
+  int _num_threads;
+
+  // Map from (dofmap, tags, value, remote) to cached DOFs
+  std::map<std::tuple<const DofMap*, const mesh::MeshTags<T>*, T, bool>,
+           Entry>
+      _entries;
+};
+
 /// Object for setting (strong) Dirichlet boundary conditions
 /// \f[u = g \ \text{on} \ G,\f]
 /// where \f$u\f$ is the solution to be computed, \f$g\f$ is a function
@@ -277,6 +373,29 @@ private:
     return dofs_unrolled;
   }
 
+  /// @brief Compute the runs of consecutive constrained dofs.
+  ///
+  /// A run is a range of positions `[runs[k], runs[k + 1])` in `dofs0`
+  /// for which the dof indices in `dofs0` and, if not empty, `dofs1`
+  /// are consecutive.
+  static std::vector<std::int32_t>
+  compute_runs(std::span<const std::int32_t> dofs0,
+               std::span<const std::int32_t> dofs1)
+  {
+    std::vector<std::int32_t> runs = {0};
+    for (std::size_t i = 1; i < dofs0.size(); ++i)
+    {
+      if (dofs0[i] != dofs0[i - 1] + 1
+          or (!dofs1.empty() and dofs1[i] != dofs1[i - 1] + 1))
+      {
+        runs.push_back(i);
+      }
+    }
+    if (!dofs0.empty())
+      runs.push_back(dofs0.size());
+    return runs;
+  }
+
 public:
   /// @brief Create a representation of a Dirichlet boundary condition
   /// constrained by a scalar- or vector-valued constant.
@@ -356,6 +475,7 @@ public:
       _owned_indices0 *= bs;
       _dofs0 = unroll_dofs(_dofs0, bs);
     }
+    _runs = compute_runs(_dofs0, _dofs1_g);
   }
 
   /// @brief Create a representation of a Dirichlet boundary condition
@@ -386,6 +506,7 @@ public:
       _owned_indices0 *= bs;
       _dofs0 = unroll_dofs(_dofs0, bs);
     }
+    _runs = compute_runs(_dofs0, _dofs1_g);
   }
 
   /// @brief Create a representation of a Dirichlet boundary condition
@@ -417,7 +538,8 @@ public:
             V_g_dofs[0])),
         _dofs1_g(std::forward<typename std::remove_reference_t<X>::value_type>(
             V_g_dofs[1])),
-        _owned_indices0(num_owned(*_function_space->dofmap(), _dofs0))
+        _owned_indices0(num_owned(*_function_space->dofmap(), _dofs0)),
+        _runs(compute_runs(_dofs0, _dofs1_g))
   {
   }
 
@@ -491,25 +613,29 @@ public:
   void set(std::span<T> x, std::optional<std::span<const T>> x0,
            T alpha = 1) const
   {
-    // set_fn is a lambda which gets evaluated for every index in [0,
-    // _dofs0.size()) and its result is assigned to x[_dofs0[i]].
-    auto apply = [&](std::invocable<std::int32_t> auto set_fn)
+    // The dofs are sorted, so the dofs in x are the first num_dofs
+    const std::size_t num_dofs = std::distance(
+        _dofs0.begin(),
+        std::ranges::lower_bound(_dofs0, static_cast<std::int32_t>(x.size())));
+
+    // Call set_run(d0, i0, n) for each run of consecutive constrained
+    // dofs x[d0:d0 + n], which are at positions _dofs0[i0:i0 + n]
+    auto apply = [&](auto set_run)
     {
-      static_assert(
-          std::is_same_v<std::invoke_result_t<decltype(set_fn), std::int32_t>,
-                         T>);
-
-      std::int32_t x_size = x.size();
-      for (std::size_t i = 0; i < _dofs0.size(); ++i)
+      for (std::size_t k = 0; k + 1 < _runs.size(); ++k)
       {
-        if (_dofs0[i] < x_size)
-          x[_dofs0[i]] = set_fn(i);
+        const std::size_t i0 = _runs[k];
+        const std::size_t i1 = std::min<std::size_t>(_runs[k + 1], num_dofs);
+        if (i0 >= i1)
+          break;
+        set_run(_dofs0[i0], i0, i1 - i0);
       }
     };
 
     if (alpha == T(0)) // Optimisation for when alpha == 0
     {
-      apply([](std::int32_t) -> T { return 0; });
+      apply([x](std::int32_t d0, std::size_t, std::size_t n)
+            { std::fill_n(std::next(x.begin(), d0), n, T(0)); });
       return;
     }
 
@@ -528,20 +654,35 @@ public:
       {
         assert(x.size() <= x0->size());
         apply(
-            [dofs_g, x0 = *x0, alpha, values,
-             &dofs0 = this->_dofs0](std::int32_t i) -> T
+            [x, x0 = *x0, alpha, values,
+             dofs_g](std::int32_t d0, std::size_t i0, std::size_t n)
+            {
+              const std::int32_t g0 = dofs_g[i0];
+              assert(g0 + n <= values.size());
+              for (std::size_t k = 0; k < n; ++k)
+                x[d0 + k] = alpha * (values[g0 + k] - x0[d0 + k]);
+            });
+      }
+      else if (alpha == T(1))
+      {
+        apply(
+            [x, values, dofs_g](std::int32_t d0, std::size_t i0, std::size_t n)
             {
-              assert(dofs_g[i] < static_cast<std::int32_t>(values.size()));
-              return alpha * (values[dofs_g[i]] - x0[dofs0[i]]);
+              assert(dofs_g[i0] + n <= values.size());
+              std::copy_n(std::next(values.begin(), dofs_g[i0]), n,
+                          std::next(x.begin(), d0));
             });
       }
       else
       {
         apply(
-            [dofs_g, values, alpha](std::int32_t i) -> T
+            [x, values, alpha,
+             dofs_g](std::int32_t d0, std::size_t i0, std::size_t n)
             {
-              assert(dofs_g[i] < static_cast<std::int32_t>(values.size()));
-              return alpha * values[dofs_g[i]];
+              const std::int32_t g0 = dofs_g[i0];
+              assert(g0 + n <= values.size());
+              for (std::size_t k = 0; k < n; ++k)
+                x[d0 + k] = alpha * values[g0 + k];
             });
       }
     }
@@ -554,16 +695,27 @@ public:
       {
         assert(x.size() <= x0->size());
         apply(
-            [x0 = *x0, alpha, bs, &value, &dofs0 = _dofs0](std::int32_t i) -> T
+            [x, x0 = *x0, alpha, bs,
+             &value](std::int32_t d0, std::size_t, std::size_t n)
             {
-              auto dof = dofs0[i];
-              return alpha * (value[dof % bs] - x0[dof]);
+              for (std::int32_t d = d0; d < d0 + (std::int32_t)n; ++d)
+                x[d] = alpha * (value[d % bs] - x0[d]);
             });
       }
+      else if (bs == 1)
+      {
+        apply([x, v = alpha * value.front()](std::int32_t d0, std::size_t,
+                                              std::size_t n)
+              { std::fill_n(std::next(x.begin(), d0), n, v); });
+      }
       else
       {
-        apply([alpha, bs, &value, &dofs0 = _dofs0](std::int32_t i) -> T
-              { return alpha * value[dofs0[i] % bs]; });
+        apply(
+            [x, alpha, bs, &value](std::int32_t d0, std::size_t, std::size_t n)
+            {
+              for (std::int32_t d = d0; d < d0 + (std::int32_t)n; ++d)
+                x[d] = alpha * value[d % bs];
+            });
       }
     }
     else
@@ -591,6 +743,51 @@ public:
     }
   }
 
+  /// @brief Cells with a degree-of-freedom that is constrained by
+  /// the boundary condition.
+  ///
+  /// The cells are computed when first requested and are then cached.
+  /// Assembly functions use the cells to restrict the boundary
+  /// condition lifting to the integration entities that are attached
+  /// to a constrained degree-of-freedom.
+  ///
+  /// @note This function is not thread-safe.
+  ///
+  /// @return Sorted (local) indices of the cells, including ghost
+  /// cells, of the mesh of the constrained function space.
+  std::span<const std::int32_t> cells() const
+  {
+    if (!_cells)
+    {
+      std::shared_ptr<const DofMap> dofmap = _function_space->dofmap();
+      assert(dofmap);
+      auto map = dofmap->index_map;
+      assert(map);
+      std::vector<std::int8_t> markers(
+          dofmap->index_map_bs() * (map->size_local() + map->num_ghosts()),
+          false);
+      mark_dofs(markers);
+
+      const int bs = dofmap->bs();
+      auto dofs = dofmap->map();
+      std::vector<std::int32_t>& cells = _cells.emplace();
+      for (std::size_t c = 0; c < dofs.extent(0); ++c)
+      {
+        for (std::size_t i = 0; i < dofs.extent(1); ++i)
+        {
+          std::span m = std::span(markers).subspan(bs * dofs(c, i), bs);
+          if (std::ranges::any_of(m, [](auto marker) { return marker; }))
+          {
+            cells.push_back(c);
+            break;
+          }
+        }
+      }
+    }
+
+    return *_cells;
+  }
+
 private:
   // The function space (possibly a sub function space)
   std::shared_ptr<const FunctionSpace<U>> _function_space;
@@ -606,5 +803,11 @@ private:
 
   // The first _owned_indices in _dofs are owned by this process
   std::int32_t _owned_indices0 = -1;
+
+  // Runs of consecutive dofs, see compute_runs
+  std::vector<std::int32_t> _runs;
+
+  // Cells with a constrained dof, computed when first requested
+  mutable std::optional<std::vector<std::int32_t>> _cells;
 };
 } // namespace dolfinx::fem
@@ -275,3 +275,11 @@ md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> DofMap::map() const
 //-----------------------------------------------------------------------------
 int DofMap::index_map_bs() const { return _index_map_bs; }
 //-----------------------------------------------------------------------------
+std::size_t DofMap::memory_usage() const
+{
+  std::size_t bytes = sizeof(std::int32_t) * _dofmap.size();
+  if (index_map)
+    bytes += index_map->memory_usage();
+  return bytes;
+}
+//-----------------------------------------------------------------------------
@@ -11,7 +11,9 @@
 
 #include "ElementDofLayout.h"
 #include <basix/mdspan.hpp>
+#include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <cstdlib>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/graph/AdjacencyList.h>
@@ -20,6 +22,8 @@
 #include <memory>
 #include <mpi.h>
 #include <span>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -36,6 +40,55 @@ class Topology;
 namespace dolfinx::fem
 {
 
+/// @brief Cell dofmap view with a compile-time number of dofs per
+/// cell.
+///
+/// With a static extent, loops over the dofs of a cell have a
+/// compile-time trip count, which allows the compiler to unroll and
+/// vectorise them.
+///
+/// @tparam N Number of dofs per cell, or `md::dynamic_extent` if it is
+/// known at run time only.
+template <std::size_t N = md::dynamic_extent>
+using dofmap_view_t
+    = md::mdspan<const std::int32_t,
+                 md::extents<std::size_t, md::dynamic_extent, N>>;
+
+/// @brief Call `fn(std::integral_constant<int, N>{})` with the number
+/// of dofs per cell as a compile-time constant `N`.
+///
+/// Compile-time constants are used for the dimensions of common
+/// elements, i.e. P1 triangles (3), P1 tetrahedra and quadrilaterals
+/// (4), P2 triangles (6), P1 hexahedra (8) and P2 tetrahedra (10).
+/// For other dimensions, `N = -1`.
+///
+/// @param[in] num_dofs Number of dofs per cell.
+/// @param[in] fn Function to call.
+template <typename F>
+void dispatch_num_dofs(int num_dofs, F&& fn)
+{
+  switch (num_dofs)
+  {
+  case 3:
+    fn(std::integral_constant<int, 3>{});
+    break;
+  case 4:
+    fn(std::integral_constant<int, 4>{});
+    break;
+  case 6:
+    fn(std::integral_constant<int, 6>{});
+    break;
+  case 8:
+    fn(std::integral_constant<int, 8>{});
+    break;
+  case 10:
+    fn(std::integral_constant<int, 10>{});
+    break;
+  default:
+    fn(std::integral_constant<int, -1>{});
+  }
+}
+
 /// @brief Create an adjacency list that maps a global index
 /// (process-wise) to the 'unassembled' cell-wise contributions.
 ///
@@ -129,6 +182,20 @@ public:
     return std::span<const std::int32_t>(_dofmap.data() + _shape1 * c, _shape1);
   }
 
+  /// @brief Local-to-global mapping of dofs on a cell, with a
+  /// compile-time number of dofs.
+  /// @tparam N Number of dofs per cell. Must be equal to the number of
+  /// dofs of the dofmap.
+  /// @param[in] c The cell index
+  /// @return Local-global dof map for the cell (using process-local
+  /// indices)
+  template <std::size_t N>
+  std::span<const std::int32_t, N> cell_dofs(std::int32_t c) const
+  {
+    assert(N == static_cast<std::size_t>(_shape1));
+    return std::span<const std::int32_t, N>(_dofmap.data() + N * c, N);
+  }
+
   /// @brief Return the block size for the dofmap
   int bs() const noexcept;
 
@@ -153,6 +220,19 @@ public:
   /// @return The adjacency list with dof indices for each cell
   md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> map() const;
 
+  /// @brief Get dofmap data with a compile-time number of dofs per
+  /// cell.
+  /// @tparam N Number of dofs per cell. Must be equal to the number of
+  /// dofs of the dofmap.
+  /// @return The dof indices for each cell.
+  template <std::size_t N>
+  dofmap_view_t<N> map() const
+  {
+    if (N != static_cast<std::size_t>(_shape1))
+      throw std::runtime_error("Incorrect number of dofs per cell.");
+    return dofmap_view_t<N>(_dofmap.data(), _dofmap.size() / N);
+  }
+
   /// Layout of dofs on an element
   const ElementDofLayout& element_dof_layout() const
   {
@@ -166,6 +246,10 @@ public:
   /// @brief Block size associated with the index_map
   int index_map_bs() const;
 
+  /// @brief Memory used by the dofmap.
+  /// @return Number of bytes of the cell dofs and the index map.
+  std::size_t memory_usage() const;
+
 private:
   // Block size for the IndexMap
   int _index_map_bs = -1;
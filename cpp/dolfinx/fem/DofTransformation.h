@@ -0,0 +1,243 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "FiniteElement.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <numeric>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief DOF transformations of the cells of a mesh, precomputed as
+/// small dense blocks.
+///
+/// The transformation of an element depends on the cell only through
+/// the cell permutation information. For each distinct value of the
+/// cell permutation information, the transformation matrix is computed
+/// once (by transforming the identity) and stored as the dense blocks
+/// of the DOFs that it couples, skipping the DOFs that it leaves
+/// unchanged. Applying the transformation to the data of a cell is then
+/// a lookup and a few small matrix-vector products, and nothing for
+/// elements and cells that do not need transformations.
+///
+/// An object of this type satisfies fem::DofTransformKernel and can be
+/// used in place of the functions returned by
+/// FiniteElement::dof_transformation_fn and
+/// FiniteElement::dof_transformation_right_fn.
+///
+/// @tparam T Scalar type of the transformed data.
+template <dolfinx::scalar T>
+class DofTransformation
+{
+public:
+  /// @brief Precompute the transformations of an element.
+  /// @param[in] element The element.
+  /// @param[in] ttype Transformation type, see
+  /// FiniteElement::dof_transformation_fn.
+  /// @param[in] right If true, the transformation is applied from the
+  /// right (see FiniteElement::dof_transformation_right_fn), otherwise
+  /// from the left.
+  /// @param[in] cell_info Cell permutation information of all cells
+  /// that the transformation will be applied for. It can be empty if
+  /// the element does not need DOF transformations.
+  template <std::floating_point U>
+  DofTransformation(const FiniteElement<U>& element, doftransform ttype,
+                    bool right, std::span<const std::uint32_t> cell_info)
+      : _dim(element.space_dimension()), _right(right), _matrix_blocks(1, 0),
+        _block_indices(1, 0), _block_values(1, 0)
+  {
+    if (!element.needs_dof_transformations())
+      return;
+
+    auto fn = right ? element.template dof_transformation_right_fn<T>(ttype)
+                    : element.template dof_transformation_fn<T>(ttype);
+
+    // Compute the matrix of each distinct value of the cell permutation
+    // information
+    const std::size_t dim = _dim;
+    std::unordered_map<std::uint32_t, std::int32_t> matrices;
+    std::vector<T> A(dim * dim);
+    _cell_matrix.resize(cell_info.size());
+    for (std::size_t c = 0; c < cell_info.size(); ++c)
+    {
+      auto [it, inserted] = matrices.try_emplace(cell_info[c], -1);
+      if (inserted)
+      {
+        std::ranges::fill(A, 0);
+        for (std::size_t i = 0; i < dim; ++i)
+          A[i * dim + i] = 1;
+        fn(A, cell_info, c, dim);
+        it->second = add_matrix(A);
+      }
+      _cell_matrix[c] = it->second;
+    }
+  }
+
+  /// @brief Apply the transformation of a cell.
+  /// @param[in,out] data The data to transform. For a transformation
+  /// from the left its shape is `(m, n)`, and for a transformation
+  /// from the right its shape is `(n, m)`, where `m` is at least the
+  /// dimension `dim` of the element (row-major storage). The first
+  /// `dim` rows (left) or columns (right) are transformed.
+  /// @param[in] cell_info Unused. The cell permutation information
+  /// passed to the constructor is used.
+  /// @param[in] cell The cell.
+  /// @param[in] n The number of columns (left) or rows (right) of
+  /// `data`.
+  void operator()(std::span<T> data,
+                  [[maybe_unused]] std::span<const std::uint32_t> cell_info,
+                  std::int32_t cell, int n) const
+  {
+    if (_cell_matrix.empty())
+      return;
+    assert(cell < (std::int32_t)_cell_matrix.size());
+    if (const std::int32_t m = _cell_matrix[cell]; m >= 0)
+    {
+      for (std::int32_t b = _matrix_blocks[m]; b < _matrix_blocks[m + 1]; ++b)
+        apply_block(data, b, n);
+    }
+  }
+
+private:
+  // Append the non-identity blocks of the matrix A, and return the
+  // index of the matrix (or -1 if A is the identity)
+  std::int32_t add_matrix(std::span<const T> A)
+  {
+    // Group DOFs that are coupled by A, and mark DOFs that are changed
+    const std::size_t dim = _dim;
+    std::vector<std::int32_t> root(dim);
+    std::iota(root.begin(), root.end(), 0);
+    auto find = [&root](std::int32_t i)
+    {
+      while (root[i] != i)
+        i = root[i] = root[root[i]];
+      return i;
+    };
+    std::vector<std::int8_t> changed(dim, 0);
+    for (std::size_t i = 0; i < dim; ++i)
+    {
+      for (std::size_t j = 0; j < dim; ++j)
+      {
+        const T a = A[i * dim + j];
+        if (i == j and a != T(1))
+          changed[i] = 1;
+        else if (i != j and a != T(0))
+        {
+          changed[i] = changed[j] = 1;
+          std::int32_t ri = find(i), rj = find(j);
+          root[std::max(ri, rj)] = std::min(ri, rj);
+        }
+      }
+    }
+
+    if (std::ranges::none_of(changed, [](auto c) { return c; }))
+      return -1;
+
+    // Store the dense block of each group of changed DOFs
+    std::vector<std::int8_t> done(dim, 0);
+    for (std::size_t i = 0; i < dim; ++i)
+    {
+      if (!changed[i] or done[i])
+        continue;
+
+      std::vector<std::int32_t> block;
+      for (std::size_t j = i; j < dim; ++j)
+      {
+        if (changed[j] and find(j) == find(i))
+        {
+          block.push_back(j);
+          done[j] = 1;
+        }
+      }
+
+      for (std::int32_t r : block)
+        for (std::int32_t c : block)
+          _values.push_back(A[r * dim + c]);
+      _indices.insert(_indices.end(), block.begin(), block.end());
+      _block_indices.push_back(_indices.size());
+      _block_values.push_back(_values.size());
+    }
+
+    _matrix_blocks.push_back(_block_indices.size() - 1);
+    return _matrix_blocks.size() - 2;
+  }
+
+  // Apply block b of a matrix
+  void apply_block(std::span<T> data, std::int32_t b, int n) const
+  {
+    std::span<const std::int32_t> dofs(
+        _indices.data() + _block_indices[b],
+        _block_indices[b + 1] - _block_indices[b]);
+    const T* A = _values.data() + _block_values[b];
+    const std::size_t size = dofs.size();
+
+    // Stride between the values of a DOF and between the DOFs. The
+    // data can have more than `dim` rows (left) or columns (right), of
+    // which the first `dim` are transformed.
+    const std::size_t dof_stride = _right ? 1 : n;
+    const std::size_t stride = _right ? data.size() / n : 1;
+
+    if (size == 1)
+    {
+      // Scaling, e.g. a change of sign
+      for (int k = 0; k < n; ++k)
+        data[dofs[0] * dof_stride + k * stride] *= A[0];
+      return;
+    }
+
+    std::array<T, 32> w_b;
+    std::vector<T> w_v;
+    if (size > w_b.size())
+      w_v.resize(size);
+    T* w = size > w_b.size() ? w_v.data() : w_b.data();
+    for (int k = 0; k < n; ++k)
+    {
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        w[i] = 0;
+        for (std::size_t j = 0; j < size; ++j)
+        {
+          // Left: (A u)_i, right: (u A)_i
+          const T a = _right ? A[j * size + i] : A[i * size + j];
+          w[i] += a * data[dofs[j] * dof_stride + k * stride];
+        }
+      }
+      for (std::size_t i = 0; i < size; ++i)
+        data[dofs[i] * dof_stride + k * stride] = w[i];
+    }
+  }
+
+  // Dimension of the element
+  std::size_t _dim;
+
+  // True if the transformation is applied from the right
+  bool _right;
+
+  // Matrix of each cell (-1 for the identity). Empty if the element
+  // does not need transformations.
+  std::vector<std::int32_t> _cell_matrix;
+
+  // Blocks [_matrix_blocks[m], _matrix_blocks[m + 1]) of each matrix m
+  std::vector<std::int32_t> _matrix_blocks;
+
+  // DOFs of each block, and offsets into _indices
+  std::vector<std::int32_t> _indices;
+  std::vector<std::int32_t> _block_indices;
+
+  // Values (row-major) of each block, and offsets into _values
+  std::vector<T> _values;
+  std::vector<std::int32_t> _block_values;
+};
+} // namespace dolfinx::fem
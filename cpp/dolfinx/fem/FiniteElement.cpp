@@ -371,6 +371,17 @@ void FiniteElement<T>::tabulate(std::span<T> values, std::span<const T> X,
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
+void FiniteElement<T>::tabulate_cached(std::span<T> values,
+                                       std::span<const T> X,
+                                       std::array<std::size_t, 2> shape,
+                                       int order) const
+{
+  assert(_element);
+  _tabulation_cache->tabulate(order, X, shape, values, [&](std::span<T> v)
+                              { _element->tabulate(order, X, shape, v); });
+}
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
 std::pair<std::vector<T>, std::array<std::size_t, 4>>
 FiniteElement<T>::tabulate(std::span<const T> X,
                            std::array<std::size_t, 2> shape, int order) const
@@ -380,6 +391,27 @@ FiniteElement<T>::tabulate(std::span<const T> X,
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
+std::pair<std::vector<T>, std::array<std::size_t, 4>>
+FiniteElement<T>::tabulate_cached(std::span<const T> X,
+                                  std::array<std::size_t, 2> shape,
+                                  int order) const
+{
+  assert(_element);
+  std::array<std::size_t, 4> vshape
+      = _element->tabulate_shape(order, shape[0]);
+  std::vector<T> values(std::reduce(vshape.begin(), vshape.end(), 1,
+                                    std::multiplies{}));
+  tabulate_cached(values, X, shape, order);
+  return {std::move(values), vshape};
+}
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
+TabulationCache<T>& FiniteElement<T>::tabulation_cache() const
+{
+  return *_tabulation_cache;
+}
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
 int FiniteElement<T>::num_sub_elements() const noexcept
 {
   return _sub_elements.size();
@@ -404,8 +436,8 @@ FiniteElement<T>::extract_sub_element(const std::vector<int>& component) const
 {
   // Recursively extract sub element
   auto sub_finite_element = _extract_sub_element(*this, component);
-  spdlog::debug("Extracted finite element for sub-system: {}",
-                sub_finite_element->signature().c_str());
+  SPDLOG_DEBUG("Extracted finite element for sub-system: {}",
+               sub_finite_element->signature().c_str());
   return sub_finite_element;
 }
 //-----------------------------------------------------------------------------
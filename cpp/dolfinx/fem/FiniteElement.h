@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "TabulationCache.h"
 #include "traits.h"
 #include <array>
 #include <basix/finite-element.h>
@@ -263,6 +264,26 @@ public:
                 std::span<const geometry_type> X,
                 std::array<std::size_t, 2> shape, int order) const;
 
+  /// @brief Evaluate derivatives of the basis functions up to given
+  /// order at points in the reference cell, using the tabulation cache.
+  ///
+  /// Use for fixed point sets that are tabulated repeatedly, e.g.
+  /// interpolation or quadrature points, but not for arbitrary
+  /// evaluation points. See tabulation_cache().
+  ///
+  /// @param[in,out] values Array that will be filled with the tabulated
+  /// basis values. Must have shape `(num_derivatives, num_points,
+  /// num_dofs, reference_value_size)` (row-major storage)
+  /// @param[in] X The reference coordinates at which to evaluate the
+  /// basis functions. Shape is `(num_points, topological dimension)`
+  /// (row-major storage).
+  /// @param[in] shape Shape of `X`.
+  /// @param[in] order Number of derivatives (up to and including
+  /// this order) to tabulate for.
+  void tabulate_cached(std::span<geometry_type> values,
+                       std::span<const geometry_type> X,
+                       std::array<std::size_t, 2> shape, int order) const;
+
   /// @brief Evaluate all derivatives of the basis functions up to given
   /// order at given points in reference cell.
   ///
@@ -277,6 +298,31 @@ public:
   tabulate(std::span<const geometry_type> X, std::array<std::size_t, 2> shape,
            int order) const;
 
+  /// @brief Evaluate all derivatives of the basis functions up to given
+  /// order at given points in reference cell, using the tabulation
+  /// cache. See tabulate_cached(std::span<geometry_type>,
+  /// std::span<const geometry_type>, std::array<std::size_t, 2>, int).
+  ///
+  /// @param[in] X The reference coordinates at which to evaluate the
+  /// basis functions. Shape is `(num_points, topological dimension)`
+  /// (row-major storage).
+  /// @param[in] shape Shape of `X`.
+  /// @param[in] order Number of derivatives (up to and including this
+  /// order) to tabulate for.
+  /// @return Basis function values and array shape (row-major storage).
+  std::pair<std::vector<geometry_type>, std::array<std::size_t, 4>>
+  tabulate_cached(std::span<const geometry_type> X,
+                  std::array<std::size_t, 2> shape, int order) const;
+
+  /// @brief Cache of the tabulations of the basis functions.
+  ///
+  /// Only tabulate_cached() uses the cache. Repeated tabulations at
+  /// the same points, e.g. at the interpolation points, are copied from
+  /// the cache. The size bound of the cache can
+  /// be changed, or the cache disabled, through the returned object.
+  /// @return The tabulation cache.
+  TabulationCache<geometry_type>& tabulation_cache() const;
+
   /// @brief Number of sub elements (for a mixed or blocked element).
   /// @return Number of sub elements.
   int num_sub_elements() const noexcept;
@@ -880,6 +926,10 @@ private:
   // Quadrature points of a quadrature element (0 dimensional array for
   // all elements except quadrature elements)
   std::pair<std::vector<geometry_type>, std::array<std::size_t, 2>> _points;
+
+  // Cache of basis function tabulations
+  std::unique_ptr<TabulationCache<geometry_type>> _tabulation_cache
+      = std::make_unique<TabulationCache<geometry_type>>();
 };
 
 } // namespace dolfinx::fem
@@ -6,21 +6,29 @@
 
 #pragma once
 
+#include "Constant.h"
 #include "FunctionSpace.h"
+#include "colouring.h"
 #include "traits.h"
 #include <algorithm>
+#include <array>
 #include <basix/mdspan.hpp>
 #include <concepts>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/types.h>
+#include <dolfinx/common/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/cell_types.h>
 #include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <optional>
 #include <span>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -100,6 +108,27 @@ std::vector<std::int32_t> compute_domain(
 
   return mapped_entities;
 }
+
+/// @brief Gather the coordinate dofs of a cell.
+///
+/// This is the shared geometry gather of the assembly loops, which
+/// loop over each cell type of a mixed-topology mesh separately with
+/// the kernel, entities and dofmap of that type. Compile-time dofs per
+/// cell are provided by fem::dispatch_num_dofs, and fixed-size IO
+/// permutations by io::cells::apply_permutation. A gather specialised
+/// on the number of geometry nodes was measured to be no faster than
+/// this loop.
+///
+/// @param[out] cdofs Coordinate dofs of the cell, shape `(x_dofs.size(),
+/// 3)`.
+/// @param[in] x_dofs Geometry dofs of the cell.
+/// @param[in] x Mesh geometry (coordinates), shape `(num_nodes, 3)`.
+template <std::floating_point T>
+void gather_coordinate_dofs(std::span<T> cdofs, auto x_dofs, auto x)
+{
+  for (std::size_t i = 0; i < x_dofs.size(); ++i)
+    std::copy_n(&x(x_dofs[i], 0), 3, std::next(cdofs.begin(), 3 * i));
+}
 } // namespace impl
 
 /// @brief Represents integral data, containing the kernel, and a list
@@ -133,6 +162,29 @@ struct integral_data
                      const uint8_t*, void*)>
       kernel;
 
+  /// @brief Batched integration kernel, which tabulates the element
+  /// tensors of #batch_size entities in one call. Empty if the integral
+  /// has no batched kernel.
+  ///
+  /// The arguments are as for #kernel, but per-entity data is in a
+  /// structure-of-arrays layout with the entity (lane) index running
+  /// fastest, i.e. for `W = batch_size` the element tensor has shape
+  /// `(n, W)`, the coefficients `(num_coeffs, W)`, the coordinate dofs
+  /// `(num_dofs_g, 3, W)`, and the local entity indices and
+  /// permutations `(W)`. Constants are shared by all lanes. Lanes
+  /// beyond the number of remaining entities hold copies of the last
+  /// entity and their output is discarded.
+  ///
+  /// @note Batched kernels are used for cell and exterior facet
+  /// integrals. Other integral types use #kernel.
+  std::function<void(T*, const T*, const T*, const U*, const int*,
+                     const uint8_t*, void*)>
+      kernel_batch;
+
+  /// @brief Number of entities (lanes) `W` tabulated per call to
+  /// #kernel_batch. Supported values are 4, 8 and 16.
+  int batch_size = 0;
+
   /// @brief The entities to integrate over for this integral. These are
   /// the entities in 'full' mesh.
   std::vector<std::int32_t> entities;
@@ -142,6 +194,89 @@ struct integral_data
   std::vector<int> coeffs;
 };
 
+/// @brief Packed coordinate dofs of integration entities (see
+/// Form::coordinate_dofs()).
+///
+/// The coordinate dofs of each entity are a block of `n` values. They
+/// are stored either directly, or compactly as single-precision offsets
+/// from a per-entity origin that is stored in full precision. The
+/// compact storage halves the memory and bandwidth for `U = double`,
+/// and keeps the relative accuracy of the coordinates to that of
+/// single precision relative to the entity size rather than the domain
+/// size.
+///
+/// @tparam U Geometry type.
+template <std::floating_point U>
+struct packed_coordinate_dofs
+{
+  /// @brief Coordinate dofs, shape `(num_entities, n)`. Empty for
+  /// compact storage.
+  std::span<const U> x;
+
+  /// @brief Origin of each entity, shape `(num_entities, 3)`. Empty
+  /// unless the storage is compact.
+  std::span<const U> origin;
+
+  /// @brief Offsets of the coordinate dofs from the entity origin,
+  /// shape `(num_entities, n)`. Empty unless the storage is compact.
+  std::span<const float> dx;
+
+  /// @brief Check if there is no packed data.
+  bool empty() const { return x.empty() and dx.empty(); }
+
+  /// @brief Coordinate dofs of an entity.
+  /// @param[in] e Position of the entity in the packed data.
+  /// @param[in,out] buffer Work array of size `n`, into which compact
+  /// data is unpacked.
+  /// @return Pointer to the `n` coordinate dofs of the entity, or
+  /// `nullptr` if there is no packed data.
+  const U* get(std::size_t e, std::span<U> buffer) const
+  {
+    const std::size_t n = buffer.size();
+    if (!x.empty())
+      return x.data() + e * n;
+    else if (!dx.empty())
+    {
+      const U* x0 = origin.data() + 3 * e;
+      const float* dx_e = dx.data() + e * n;
+      for (std::size_t i = 0; i < n; i += 3)
+      {
+        for (std::size_t j = 0; j < 3; ++j)
+          buffer[i + j] = x0[j] + static_cast<U>(dx_e[i + j]);
+      }
+      return buffer.data();
+    }
+    else
+      return nullptr;
+  }
+};
+
+/// @brief Precomputed data of the facets of an interior facet integral
+/// (see Form::facet_pairs()).
+///
+/// For each facet, the degrees-of-freedom of the two attached cells
+/// are stored as a single merged list, and the permutations of the
+/// facet relative to the two cells as a pair, in the layout expected by
+/// the kernel.
+struct packed_facet_pairs
+{
+  /// @brief Merged test function dofs of the two cells of each facet,
+  /// shape `(num_facets, 2 * num_dofs0)`.
+  std::span<const std::int32_t> dofs0;
+
+  /// @brief Merged trial function dofs of the two cells of each facet,
+  /// shape `(num_facets, 2 * num_dofs1)`. Empty for linear forms.
+  std::span<const std::int32_t> dofs1;
+
+  /// @brief Facet permutations relative to the two cells of each
+  /// facet, shape `(num_facets, 2)`. Empty if the form does not need
+  /// facet permutations.
+  std::span<const std::uint8_t> perms;
+
+  /// @brief Check if there is no precomputed data.
+  bool empty() const { return dofs0.empty(); }
+};
+
 /// @brief A representation of finite element variational forms.
 ///
 /// A note on the order of trial and test spaces: FEniCS numbers
@@ -255,6 +390,16 @@ public:
       }
     }
 
+    for (auto& [key, integral] : _integrals)
+    {
+      if (integral.kernel_batch and integral.batch_size != 4
+          and integral.batch_size != 8 and integral.batch_size != 16)
+      {
+        throw std::runtime_error(
+            "Unsupported kernel batch size. Must be 4, 8 or 16.");
+      }
+    }
+
     for (auto& space : _function_spaces)
     {
       // Working map: [integral type, domain ID, kernel_idx]->entities
@@ -399,6 +544,26 @@ public:
     return it->second.kernel;
   }
 
+  /// @brief Get the batched kernel function for an integral.
+  /// @param[in] type Integral type.
+  /// @param[in] id Integral subdomain ID.
+  /// @param[in] kernel_idx Index of the kernel (we may have multiple
+  /// kernels for a given ID in mixed-topology meshes).
+  /// @return Batched kernel function and the batch size (see
+  /// integral_data::kernel_batch). The function is empty if the
+  /// integral has no batched kernel.
+  std::pair<std::function<void(scalar_type*, const scalar_type*,
+                               const scalar_type*, const geometry_type*,
+                               const int*, const uint8_t*, void*)>,
+            int>
+  kernel_batch(IntegralType type, int id, int kernel_idx) const
+  {
+    auto it = _integrals.find({type, id, kernel_idx});
+    if (it == _integrals.end())
+      throw std::runtime_error("Requested integral kernel not found.");
+    return {it->second.kernel_batch, it->second.batch_size};
+  }
+
   /// @brief Get types of integrals in the form.
   /// @return Integrals types.
   std::set<IntegralType> integral_types() const
@@ -569,6 +734,372 @@ public:
     }
   }
 
+  /// @brief Colouring of the integration entities of an integral
+  /// (kernel) for thread-parallel assembly.
+  ///
+  /// Entities are coloured such that no two entities with the same
+  /// colour share a test function degree-of-freedom (see
+  /// fem::compute_colouring). The colouring is computed when first
+  /// requested and is then cached. A cached colouring is re-computed if
+  /// the test function dofmap or the topology of the test function mesh
+  /// has changed.
+  ///
+  /// @note This function is not thread-safe.
+  ///
+  /// @param[in] type Integral type.
+  /// @param[in] id Integral domain identifier.
+  /// @param[in] kernel_idx Kernel index (cell type).
+  /// @return Colouring, where `links(c)` are the positions in the
+  /// integration entity list (see domain()) of the entities with colour
+  /// `c`.
+  const graph::AdjacencyList<std::int32_t>&
+  colouring(IntegralType type, int id, int kernel_idx) const
+  {
+    if (_function_spaces.empty())
+    {
+      throw std::runtime_error(
+          "Colouring of integration entities requires a test function.");
+    }
+
+    std::shared_ptr<const DofMap> dofmap
+        = _function_spaces[0]->dofmaps(kernel_idx);
+    assert(dofmap);
+    auto dofs = dofmap->map();
+    std::shared_ptr<const mesh::Topology> topology
+        = _function_spaces[0]->mesh()->topology();
+    assert(topology);
+    std::shared_ptr<const common::IndexMap> cell_map
+        = topology->index_maps(topology->dim()).at(kernel_idx);
+
+    auto it = _colourings.find({type, id, kernel_idx});
+    if (it == _colourings.end() or it->second.dofmap.lock() != dofmap
+        or it->second.cell_map != cell_map)
+    {
+      graph::AdjacencyList<std::int32_t> c = compute_colouring(
+          type, dofs, domain_arg(type, 0, id, kernel_idx));
+      it = _colourings
+               .insert_or_assign(
+                   {type, id, kernel_idx},
+                   colouring_data{std::move(c), dofmap, cell_map})
+               .first;
+    }
+
+    return it->second.colouring;
+  }
+
+  /// @brief Clear all cached colourings of integration entities (see
+  /// colouring()).
+  void clear_colourings() { _colourings.clear(); }
+
+  /// @brief Enable or disable reproducible assembly.
+  ///
+  /// Thread-parallel assembly processes the integration entities in
+  /// colour order (see colouring()), whereas serial assembly processes
+  /// them in the order of domain(). The contributions to a
+  /// degree-of-freedom are therefore summed in a different order, and
+  /// the results differ in the last bits. If reproducible assembly is
+  /// enabled, the entities are also processed in colour order when
+  /// assembling with a single thread. Since entities of the same colour
+  /// do not share a degree-of-freedom, the contributions to each
+  /// degree-of-freedom are then summed in a fixed order, and the
+  /// assembled vectors and matrices are bitwise identical for any
+  /// number of threads and across runs.
+  ///
+  /// The ghost contributions that are accumulated by a reverse scatter
+  /// (e.g. la::Vector::scatter_rev) are summed in a fixed order for a
+  /// given mesh partition. Results are therefore reproducible across
+  /// runs with the same number of processes, but not across different
+  /// numbers of processes.
+  ///
+  /// @note Colour-ordered traversal has poorer memory locality than
+  /// traversal in the order of domain(), which is typically ordered for
+  /// locality, so serial assembly in reproducible mode is slower. The
+  /// colouring is computed on first use and is then cached.
+  ///
+  /// @param[in] reproducible `true` to enable reproducible assembly.
+  void set_reproducible(bool reproducible) { _reproducible = reproducible; }
+
+  /// @brief Check if reproducible assembly is enabled (see
+  /// set_reproducible()).
+  bool reproducible() const { return _reproducible; }
+
+  /// @brief Integration entities of an integral (kernel) that are
+  /// attached to each cell of an argument function space mesh.
+  ///
+  /// The map from cells to entities allows the entities that are
+  /// attached to a set of cells, e.g. the cells with a constrained
+  /// degree-of-freedom (see DirichletBC::cells), to be found without
+  /// searching all entities. It is computed when first requested and
+  /// is then cached. A cached map is re-computed if the cell index map
+  /// of the argument function space mesh has changed.
+  ///
+  /// @note This function is not thread-safe.
+  ///
+  /// @param[in] type Integral type.
+  /// @param[in] rank Argument index.
+  /// @param[in] id Integral domain identifier.
+  /// @param[in] kernel_idx Kernel index (cell type).
+  /// @return Adjacency list where `links(c)` are the positions in the
+  /// integration entity list (see domain_arg()) of the entities
+  /// attached to cell `c` of the argument function space mesh.
+  const graph::AdjacencyList<std::int32_t>&
+  cell_entities(IntegralType type, int rank, int id, int kernel_idx) const
+  {
+    std::shared_ptr<const mesh::Topology> topology
+        = _function_spaces.at(rank)->mesh()->topology();
+    assert(topology);
+    std::shared_ptr<const common::IndexMap> cell_map
+        = topology->index_maps(topology->dim()).at(kernel_idx);
+    assert(cell_map);
+
+    auto it = _cell_entities.find({type, rank, id, kernel_idx});
+    if (it == _cell_entities.end() or it->second.second != cell_map)
+    {
+      graph::AdjacencyList<std::int32_t> e = compute_cell_entities(
+          type, cell_map->size_local() + cell_map->num_ghosts(),
+          domain_arg(type, rank, id, kernel_idx));
+      it = _cell_entities
+               .insert_or_assign({type, rank, id, kernel_idx},
+                                 std::pair(std::move(e), cell_map))
+               .first;
+    }
+
+    return it->second.first;
+  }
+
+  /// @brief Enable or disable caching of packed coordinate dofs of
+  /// integration entities (see coordinate_dofs()).
+  ///
+  /// Disabling the cache, or changing the storage, releases cached
+  /// data.
+  ///
+  /// @param[in] cache `true` to cache packed coordinate dofs.
+  /// @param[in] compact `true` to store the coordinate dofs as
+  /// single-precision offsets from the first coordinate dof of each
+  /// entity (see packed_coordinate_dofs). The offsets are up-cast to
+  /// the geometry type when passed to the kernels.
+  void cache_coordinate_dofs(bool cache, bool compact = false)
+  {
+    if (!cache or compact != _compact_coordinate_dofs)
+      _coordinate_dofs.clear();
+    _cache_coordinate_dofs = cache;
+    _compact_coordinate_dofs = compact;
+  }
+
+  /// @brief Packed coordinate dofs of the integration entities of an
+  /// integral (kernel), in the layout expected by the kernel.
+  ///
+  /// For each entity in domain(), the coordinate dofs of the attached
+  /// integration domain cell(s) are stored contiguously with shape
+  /// `(num_cells, num_dofs_g, 3)`, where `num_cells` is two for
+  /// interior facet integrals and one otherwise. For compact storage
+  /// the origin of an entity is the first coordinate dof of its
+  /// (first) cell. The data is computed when first requested and then
+  /// cached. The cache is not updated if the mesh geometry changes,
+  /// e.g. for moving meshes, in which case clear_coordinate_dofs()
+  /// must be called.
+  ///
+  /// @note This function is not thread-safe.
+  ///
+  /// @param[in] type Integral type.
+  /// @param[in] id Integral domain identifier.
+  /// @param[in] kernel_idx Kernel index (cell type).
+  /// @return Packed coordinate dofs. Empty if caching is not enabled
+  /// (see cache_coordinate_dofs()).
+  packed_coordinate_dofs<scalar_value_t<scalar_type>>
+  coordinate_dofs(IntegralType type, int id, int kernel_idx) const
+  {
+    if (!_cache_coordinate_dofs)
+      return {};
+
+    auto it = _coordinate_dofs.find({type, id, kernel_idx});
+    if (it == _coordinate_dofs.end())
+    {
+      // Number of entries per entity in the entity list, and number of
+      // cells attached to each entity
+      auto [stride, num_cells] = [type]() -> std::array<std::size_t, 2>
+      {
+        switch (type)
+        {
+        case IntegralType::cell:
+          return {1, 1};
+        case IntegralType::exterior_facet:
+          return {2, 1};
+        case IntegralType::interior_facet:
+          return {4, 2};
+        default:
+          throw std::runtime_error(
+              "Integral type not supported for packing coordinate dofs.");
+        }
+      }();
+
+      md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> x_dofmap
+          = _mesh->geometry().dofmap(kernel_idx);
+      std::span<const geometry_type> x = _mesh->geometry().x();
+      std::span<const std::int32_t> entities
+          = this->domain(type, id, kernel_idx);
+      const std::size_t num_entities = entities.size() / stride;
+      const std::size_t num_dofs_g = x_dofmap.extent(1);
+      const std::size_t n = num_cells * num_dofs_g * 3;
+      coordinate_dofs_data data;
+      if (_compact_coordinate_dofs)
+      {
+        data.origin.resize(num_entities * 3);
+        data.dx.resize(num_entities * n);
+      }
+      else
+        data.x.resize(num_entities * n);
+
+      for (std::size_t e = 0; e < num_entities; ++e)
+      {
+        const geometry_type* x0
+            = x.data() + 3 * x_dofmap(entities[e * stride], 0);
+        if (_compact_coordinate_dofs)
+          std::copy_n(x0, 3, std::next(data.origin.begin(), 3 * e));
+        for (std::size_t k = 0; k < num_cells; ++k)
+        {
+          std::int32_t c = entities[e * stride + 2 * k];
+          for (std::size_t i = 0; i < num_dofs_g; ++i)
+          {
+            const geometry_type* xi = x.data() + 3 * x_dofmap(c, i);
+            std::size_t pos = e * n + 3 * (k * num_dofs_g + i);
+            if (_compact_coordinate_dofs)
+            {
+              for (std::size_t j = 0; j < 3; ++j)
+                data.dx[pos + j] = static_cast<float>(xi[j] - x0[j]);
+            }
+            else
+              std::copy_n(xi, 3, std::next(data.x.begin(), pos));
+          }
+        }
+      }
+
+      it = _coordinate_dofs.emplace(std::tuple{type, id, kernel_idx},
+                                    std::move(data))
+               .first;
+    }
+
+    const coordinate_dofs_data& data = it->second;
+    return {data.x, data.origin, data.dx};
+  }
+
+  /// @brief Clear cached packed coordinate dofs (see
+  /// coordinate_dofs()).
+  ///
+  /// Must be called if the mesh geometry changes and caching of
+  /// coordinate dofs is enabled.
+  void clear_coordinate_dofs() { _coordinate_dofs.clear(); }
+
+  /// @brief Enable or disable caching of precomputed interior facet
+  /// data (see facet_pairs()).
+  ///
+  /// Disabling the cache releases cached data. Enabling the cache
+  /// computes the entity permutations of the mesh if the form needs
+  /// facet permutations.
+  ///
+  /// @param[in] cache `true` to cache interior facet data.
+  void cache_facet_pairs(bool cache)
+  {
+    if (!cache)
+      _facet_pairs.clear();
+    else if (_needs_facet_permutations)
+      _mesh->topology_mutable()->create_entity_permutations();
+    _cache_facet_pairs = cache;
+  }
+
+  /// @brief Precomputed merged dofs and facet permutations of the
+  /// facets of an interior facet integral.
+  ///
+  /// With the packed coordinate dofs (see coordinate_dofs()), the data
+  /// allows the facets to be assembled as a contiguous stream, without
+  /// gathering and concatenating the dofs of the two cells of each
+  /// facet. The data is computed when first requested and then cached.
+  /// Cached data is re-computed if an argument dofmap or the topology
+  /// of the integration domain mesh has changed.
+  ///
+  /// @note This function is not thread-safe.
+  /// @pre If the form needs facet permutations, the entity permutations
+  /// of the mesh have been computed (see cache_facet_pairs()).
+  ///
+  /// @param[in] id Integral domain identifier.
+  /// @return Precomputed facet data. Empty if caching is not enabled
+  /// (see cache_facet_pairs()).
+  packed_facet_pairs facet_pairs(int id) const
+  {
+    if (!_cache_facet_pairs or _function_spaces.empty())
+      return {};
+
+    std::shared_ptr<const mesh::Topology> topology = _mesh->topology();
+    assert(topology);
+    std::shared_ptr<const common::IndexMap> cell_map
+        = topology->index_maps(topology->dim()).at(0);
+
+    // Cached data is valid if it was computed for the current dofmaps,
+    // i.e. the dofmaps it was computed for are still alive and are the
+    // current dofmaps
+    auto it = _facet_pairs.find(id);
+    auto valid = [this, &cell_map](const facet_pairs_data& data)
+    {
+      for (std::size_t r = 0; r < _function_spaces.size(); ++r)
+      {
+        if (data.dofmaps[r].lock() != _function_spaces[r]->dofmaps(0))
+          return false;
+      }
+      return data.cell_map == cell_map;
+    };
+
+    if (it == _facet_pairs.end() or !valid(it->second))
+    {
+      facet_pairs_data data;
+      for (std::size_t r = 0; r < _function_spaces.size(); ++r)
+        data.dofmaps[r] = _function_spaces[r]->dofmaps(0);
+      data.cell_map = cell_map;
+
+      // Merge the dofs of the two cells of each facet
+      std::array<std::vector<std::int32_t>*, 2> dofs
+          = {&data.dofs0, &data.dofs1};
+      for (std::size_t r = 0; r < _function_spaces.size(); ++r)
+      {
+        std::shared_ptr<const DofMap> dofmap
+            = _function_spaces[r]->dofmaps(0);
+        std::span<const std::int32_t> facets
+            = domain_arg(IntegralType::interior_facet, r, id, 0);
+        dofs[r]->reserve(facets.size() / 2 * dofmap->map().extent(1));
+        for (std::size_t f = 0; f < facets.size(); f += 4)
+        {
+          std::ranges::copy(dofmap->cell_dofs(facets[f]),
+                            std::back_inserter(*dofs[r]));
+          std::ranges::copy(dofmap->cell_dofs(facets[f + 2]),
+                            std::back_inserter(*dofs[r]));
+        }
+      }
+
+      // Facet permutations relative to the two cells of each facet
+      if (_needs_facet_permutations)
+      {
+        const std::vector<std::uint8_t>& p
+            = topology->get_facet_permutations();
+        const int num_facets_per_cell = mesh::cell_num_entities(
+            topology->cell_type(), topology->dim() - 1);
+        std::span<const std::int32_t> facets
+            = domain(IntegralType::interior_facet, id, 0);
+        data.perms.reserve(facets.size() / 2);
+        for (std::size_t f = 0; f < facets.size(); f += 4)
+        {
+          data.perms.push_back(
+              p[facets[f] * num_facets_per_cell + facets[f + 1]]);
+          data.perms.push_back(
+              p[facets[f + 2] * num_facets_per_cell + facets[f + 3]]);
+        }
+      }
+
+      it = _facet_pairs.insert_or_assign(id, std::move(data)).first;
+    }
+
+    const facet_pairs_data& data = it->second;
+    return {data.dofs0, data.dofs1, data.perms};
+  }
+
   /// @brief Access coefficients.
   const std::vector<
       std::shared_ptr<const Function<scalar_type, geometry_type>>>&
@@ -605,7 +1136,80 @@ public:
     return _constants;
   }
 
+  /// @brief Packed values of the constants, ready for assembly.
+  ///
+  /// The values are stored in a buffer that persists between calls and
+  /// that is updated in place: only the constants whose value has
+  /// changed since the previous call (see Constant::state) are
+  /// copied. The span is valid until the next call, or until the value
+  /// of a constant changes size.
+  ///
+  /// @note Not thread-safe.
+  /// @return Packed constants, see fem::pack_constants.
+  std::span<const scalar_type> packed_constants() const
+  {
+    if (_constant_states.size() != _constants.size())
+    {
+      _constant_states.assign(_constants.size(), 0);
+      _packed_constants.clear();
+    }
+
+    // Size of the packed constants, which changes only if the value of
+    // a constant has been resized
+    std::size_t size = 0;
+    for (auto& c : _constants)
+      size += c->value.size();
+    if (size != _packed_constants.size())
+    {
+      _packed_constants.resize(size);
+      std::ranges::fill(_constant_states, 0);
+    }
+
+    bool changed = false;
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < _constants.size(); ++i)
+    {
+      const Constant<scalar_type>& c = *_constants[i];
+      if (std::uint64_t state = c.state(); state != _constant_states[i])
+      {
+        std::ranges::copy(c.value,
+                          std::next(_packed_constants.begin(), offset));
+        _constant_states[i] = state;
+        changed = true;
+      }
+      offset += c.value.size();
+    }
+
+    if (changed)
+      _packed_constants_state = common::next_state();
+    return _packed_constants;
+  }
+
+  /// @brief State of the packed constants.
+  ///
+  /// The state changes when packed_constants() updates the packed
+  /// values, and is unique across all objects (see common::next_state).
+  /// An unchanged state identifies unchanged packed constants, e.g. to
+  /// skip copying the constants to device memory (see
+  /// fem::mirror_constants).
+  ///
+  /// @note Not thread-safe.
+  std::uint64_t packed_constants_state() const
+  {
+    packed_constants();
+    return _packed_constants_state;
+  }
+
 private:
+  // Cached colouring of integration entities, and the test function
+  // dofmap and cell index map it was computed from
+  struct colouring_data
+  {
+    graph::AdjacencyList<std::int32_t> colouring;
+    std::weak_ptr<const DofMap> dofmap;
+    std::shared_ptr<const common::IndexMap> cell_map;
+  };
+
   // Function spaces (one for each argument)
   std::vector<std::shared_ptr<const FunctionSpace<geometry_type>>>
       _function_spaces;
@@ -625,6 +1229,13 @@ private:
   // Constants associated with the Form
   std::vector<std::shared_ptr<const Constant<scalar_type>>> _constants;
 
+  // Persistent packed constants, with the state of each constant at
+  // the time it was packed and the state of the packed values, see
+  // packed_constants
+  mutable std::vector<scalar_type> _packed_constants;
+  mutable std::vector<std::uint64_t> _constant_states;
+  mutable std::uint64_t _packed_constants_state = 0;
+
   // True if permutation data needs to be passed into these integrals
   bool _needs_facet_permutations;
 
@@ -657,5 +1268,63 @@ private:
       std::tuple<IntegralType, int, int>,
       std::variant<std::vector<std::int32_t>, std::span<const std::int32_t>>>
       _cdata;
+
+  // Colourings of integration entities for thread-parallel assembly
+  // (integral type, id, kernel_idx) -> colouring
+  mutable std::map<std::tuple<IntegralType, int, int>, colouring_data>
+      _colourings;
+
+  // Integration entities attached to each cell of an argument mesh, and
+  // the cell index map they were computed for (integral type, rank, id,
+  // kernel_idx) -> entities
+  mutable std::map<std::tuple<IntegralType, int, int, int>,
+                   std::pair<graph::AdjacencyList<std::int32_t>,
+                             std::shared_ptr<const common::IndexMap>>>
+      _cell_entities;
+
+  // True if packed coordinate dofs of integration entities are cached
+  bool _cache_coordinate_dofs = false;
+
+  // True if cached coordinate dofs are stored as single-precision
+  // offsets from a per-entity origin
+  bool _compact_coordinate_dofs = false;
+
+  // Packed coordinate dofs of the entities of an integral, see
+  // packed_coordinate_dofs, in the coordinate type of the kernels
+  struct coordinate_dofs_data
+  {
+    std::vector<scalar_value_t<scalar_type>> x;
+    std::vector<scalar_value_t<scalar_type>> origin;
+    std::vector<float> dx;
+  };
+
+  // Cached packed coordinate dofs of integration entities
+  // (integral type, id, kernel_idx) -> coordinate dofs
+  mutable std::map<std::tuple<IntegralType, int, int>, coordinate_dofs_data>
+      _coordinate_dofs;
+
+  // True if integration entities are assembled in colour order for
+  // any number of threads, see set_reproducible()
+  bool _reproducible = false;
+
+  // True if precomputed interior facet data is cached
+  bool _cache_facet_pairs = false;
+
+  // Precomputed data of the facets of an interior facet integral, and
+  // the argument dofmaps and cell index map it was computed for, see
+  // packed_facet_pairs. The dofmaps are held by weak pointers, so a
+  // new dofmap at the address of a destroyed one is not mistaken for
+  // it.
+  struct facet_pairs_data
+  {
+    std::vector<std::int32_t> dofs0;
+    std::vector<std::int32_t> dofs1;
+    std::vector<std::uint8_t> perms;
+    std::array<std::weak_ptr<const DofMap>, 2> dofmaps;
+    std::shared_ptr<const common::IndexMap> cell_map;
+  };
+
+  // Cached interior facet data, id -> data
+  mutable std::map<int, facet_pairs_data> _facet_pairs;
 };
 } // namespace dolfinx::fem
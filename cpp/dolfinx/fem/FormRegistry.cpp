@@ -0,0 +1,97 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "FormRegistry.h"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#endif
+
+using namespace dolfinx;
+
+//-----------------------------------------------------------------------------
+fem::FormRegistry& fem::FormRegistry::global()
+{
+  static FormRegistry registry;
+  return registry;
+}
+//-----------------------------------------------------------------------------
+void fem::FormRegistry::load(const std::filesystem::path& library)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  if (!dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL))
+  {
+    throw std::runtime_error("Failed to load form library: "
+                             + std::string(dlerror()));
+  }
+#else
+  throw std::runtime_error("Loading form libraries is not supported on "
+                           "this platform: "
+                           + library.string());
+#endif
+}
+//-----------------------------------------------------------------------------
+void fem::FormRegistry::insert(std::string name, const ufcx_form& form)
+{
+  if (auto it = _forms.find(name); it != _forms.end())
+  {
+    if (it->second != &form)
+    {
+      throw std::runtime_error("A different form is registered as \"" + name
+                               + "\".");
+    }
+    return;
+  }
+
+  _forms.emplace(std::move(name), &form);
+  if (form.signature)
+    _signatures.emplace(form.signature, &form);
+}
+//-----------------------------------------------------------------------------
+const ufcx_form* fem::FormRegistry::find(std::string_view name) const
+{
+  auto it = _forms.find(name);
+  return it != _forms.end() ? it->second : nullptr;
+}
+//-----------------------------------------------------------------------------
+const ufcx_form& fem::FormRegistry::at(std::string_view name) const
+{
+  if (const ufcx_form* form = find(name))
+    return *form;
+  else
+  {
+    throw std::runtime_error("No form is registered as \"" + std::string(name)
+                             + "\".");
+  }
+}
+//-----------------------------------------------------------------------------
+const ufcx_form*
+fem::FormRegistry::find_signature(std::string_view signature) const
+{
+  auto it = _signatures.find(signature);
+  return it != _signatures.end() ? it->second : nullptr;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::string> fem::FormRegistry::names() const
+{
+  std::vector<std::string> names;
+  names.reserve(_forms.size());
+  for (auto& [name, form] : _forms)
+    names.push_back(name);
+  std::ranges::sort(names);
+  return names;
+}
+//-----------------------------------------------------------------------------
+fem::FormRegistrar::FormRegistrar(
+    std::initializer_list<std::pair<const char*, const ufcx_form*>> forms)
+{
+  FormRegistry& registry = FormRegistry::global();
+  for (auto [name, form] : forms)
+    registry.insert(name, *form);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,124 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <ufcx.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Registry of forms that are compiled ahead of time.
+///
+/// The registry maps names and signatures of forms to the `ufcx_form`
+/// objects generated by FFCx, so that programs can use forms that are
+/// compiled when the program is built, without a Python toolchain at
+/// run time. Forms are usually registered with global() by the files
+/// that the CMake function `dolfinx_add_forms` generates, either at
+/// program start-up or when a library of forms is loaded with load().
+///
+/// Lookup by name and by signature takes constant time.
+///
+/// @note Registration is not thread-safe. Forms should be registered
+/// before the registry is used from several threads.
+class FormRegistry
+{
+public:
+  /// Create an empty registry
+  FormRegistry() = default;
+
+  /// @brief The registry of the process.
+  ///
+  /// Forms generated by `dolfinx_add_forms` register themselves with
+  /// this registry.
+  /// @return The registry.
+  static FormRegistry& global();
+
+  /// @brief Load a library of forms.
+  ///
+  /// The forms of the library register themselves with global() when
+  /// the library is loaded. All symbols of the library are resolved
+  /// when it is loaded, so that the first call of a kernel does not
+  /// bind symbols lazily. The library remains loaded until the program
+  /// exits.
+  ///
+  /// @param[in] library Path of a shared library built with
+  /// `dolfinx_add_forms(... MODULE ...)`.
+  static void load(const std::filesystem::path& library);
+
+  /// @brief Register a form.
+  /// @param[in] name Name of the form.
+  /// @param[in] form Compiled form, which must outlive the registry.
+  /// @pre A different form is not registered with name `name`.
+  void insert(std::string name, const ufcx_form& form);
+
+  /// @brief Find a form by name.
+  /// @param[in] name Name of the form.
+  /// @return Pointer to the form, or `nullptr` if no form with name
+  /// `name` is registered.
+  const ufcx_form* find(std::string_view name) const;
+
+  /// @brief Find a form by name.
+  /// @param[in] name Name of the form.
+  /// @return The form.
+  /// @pre A form with name `name` is registered.
+  const ufcx_form& at(std::string_view name) const;
+
+  /// @brief Find a form by the signature computed by FFCx.
+  /// @param[in] signature Signature of the form.
+  /// @return Pointer to the form, or `nullptr` if no form with
+  /// signature `signature` is registered.
+  const ufcx_form* find_signature(std::string_view signature) const;
+
+  /// @brief Names of the registered forms.
+  /// @return Sorted names.
+  std::vector<std::string> names() const;
+
+  /// @brief Number of registered forms.
+  std::size_t size() const { return _forms.size(); }
+
+private:
+  // Hash that allows lookup with a std::string_view
+  struct string_hash
+  {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const noexcept
+    {
+      return std::hash<std::string_view>{}(s);
+    }
+  };
+
+  using map_type = std::unordered_map<std::string, const ufcx_form*,
+                                      string_hash, std::equal_to<>>;
+
+  // Map from name to form
+  map_type _forms;
+
+  // Map from signature to form
+  map_type _signatures;
+};
+
+/// @brief Register forms with FormRegistry::global() on construction.
+///
+/// Static objects of this type in the files generated by
+/// `dolfinx_add_forms` register forms when the program starts or when
+/// a library of forms is loaded.
+struct FormRegistrar
+{
+  /// @brief Register forms.
+  /// @param[in] forms Names and forms.
+  FormRegistrar(
+      std::initializer_list<std::pair<const char*, const ufcx_form*>> forms);
+};
+} // namespace dolfinx::fem
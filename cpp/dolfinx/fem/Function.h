@@ -14,10 +14,14 @@
 #include <algorithm>
 #include <basix/mdspan.hpp>
 #include <concepts>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/CurvedGeometryCache.h>
 #include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/GeometryCache.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <functional>
@@ -33,6 +37,79 @@ namespace dolfinx::fem
 template <dolfinx::scalar T, std::floating_point U>
 class Expression;
 
+/// @brief Work arrays for evaluating a Function at points.
+///
+/// Function::eval resizes the arrays of a workspace as required and
+/// reuses them in subsequent calls with the same workspace. A workspace
+/// can be used with different functions, but not by concurrent calls.
+///
+/// @tparam T The function scalar type.
+/// @tparam U The mesh geometry scalar type.
+template <dolfinx::scalar T, std::floating_point U = dolfinx::scalar_value_t<T>>
+class EvalWorkspace
+{
+  template <dolfinx::scalar, std::floating_point>
+  friend class Function;
+
+public:
+  /// @brief Use precomputed cell Jacobians for evaluation.
+  ///
+  /// The Jacobians of affine cells are then read from the cache instead
+  /// of being computed for each evaluation. The cache is only used
+  /// for functions on its mesh and while it is up to date (see
+  /// mesh::GeometryCache::update).
+  ///
+  /// @param[in] cache Geometry cache, or `nullptr` to not use a cache.
+  void set_geometry_cache(std::shared_ptr<const mesh::GeometryCache<U>> cache)
+  {
+    _geometry_cache = cache;
+  }
+
+  /// @brief Use precomputed cell linearisations for the initial guesses
+  /// of the pull-back of points in non-affine cells.
+  ///
+  /// The Newton iterations of fem::CoordinateElement::pull_back_nonaffine
+  /// then start from the linearisation of each cell at its midpoint
+  /// instead of the origin of the reference cell, which reduces the
+  /// number of iterations. The cache is only used for functions on its
+  /// mesh and while it is up to date (see
+  /// mesh::CurvedGeometryCache::update).
+  ///
+  /// @param[in] cache Curved geometry cache, or `nullptr` to not use a
+  /// cache.
+  void set_curved_geometry_cache(
+      std::shared_ptr<const mesh::CurvedGeometryCache<U>> cache)
+  {
+    _curved_geometry_cache = cache;
+  }
+
+private:
+  // Work arrays of a thread
+  struct buffers_t
+  {
+    std::vector<U> coord_dofs, X, J, K, detJ, det_scratch;
+    std::vector<std::size_t> nonaffine_points;
+    std::vector<U> nonaffine_x, nonaffine_coord_dofs, Xn, phi;
+    std::vector<U> basis_reference_values, basis_values;
+    std::vector<T> coefficients;
+  };
+
+  // (cell, point index) of the points to evaluate, sorted
+  std::vector<std::pair<std::int32_t, std::size_t>> _points;
+
+  // Geometry basis derivatives at the origin of the reference cell
+  std::vector<U> _phi0;
+
+  // Work arrays of each thread
+  std::vector<buffers_t> _buffers;
+
+  // Precomputed cell Jacobians
+  std::shared_ptr<const mesh::GeometryCache<U>> _geometry_cache;
+
+  // Precomputed linearisations of non-affine cells
+  std::shared_ptr<const mesh::CurvedGeometryCache<U>> _curved_geometry_cache;
+};
+
 /// This class represents a function \f$ u_h \f$ in a finite
 /// element function space \f$ V_h \f$, given by
 ///
@@ -118,12 +195,12 @@ public:
   /// @return New collapsed Function.
   Function collapse() const
   {
-    // Create new collapsed FunctionSpace
-    auto [V, map] = _function_space->collapse();
+    // Get (cached) collapsed FunctionSpace
+    auto [V, map] = _function_space->collapsed();
 
     // Create new vector
     auto x = std::make_shared<la::Vector<value_type>>(
-        V.dofmap()->index_map, V.dofmap()->index_map_bs());
+        V->dofmap()->index_map, V->dofmap()->index_map_bs());
 
     // Copy values into new vector
     std::span<const value_type> x_old = _x->array();
@@ -135,8 +212,7 @@ public:
       x_new[i] = x_old[map[i]];
     }
 
-    return Function(
-        std::make_shared<FunctionSpace<geometry_type>>(std::move(V)), x);
+    return Function(V, x);
   }
 
   /// @brief Access the function space.
@@ -152,6 +228,10 @@ public:
   /// @brief Underlying vector.
   std::shared_ptr<la::Vector<value_type>> x() { return _x; }
 
+  /// @brief State of the degree-of-freedom values, see
+  /// la::Vector::state.
+  std::uint64_t state() const { return _x->state(); }
+
   /// @brief Interpolate an expression f(x) on the whole domain.
   /// @param[in] f Expression to be interpolated.
   void interpolate(
@@ -187,46 +267,91 @@ public:
         = fem::interpolation_coords<geometry_type>(
             *_function_space->element(), _function_space->mesh()->geometry(),
             cells);
-    md::mdspan<const geometry_type,
-               md::extents<std::size_t, 3, md::dynamic_extent>>
-        _x(x.data(), 3, x.size() / 3);
+    interpolate_values(f, x, cells);
+  }
 
-    const auto [fx, fshape] = f(_x);
-    assert(fshape.size() <= 2);
-    if (int vs = _function_space->element()->value_size();
-        vs == 1 and fshape.size() == 1)
+  /// @brief Interpolate an expression f(x) over a set of cells, one
+  /// chunk of cells at a time.
+  ///
+  /// The expression is evaluated at the interpolation coordinates of
+  /// each chunk of cells in turn, which bounds the memory used for the
+  /// coordinates and the values of `f`. Coordinates that are cached by
+  /// `x` are re-used, which avoids recomputing them when the same
+  /// cells are interpolated repeatedly, e.g. for time-dependent
+  /// boundary data.
+  ///
+  /// @param[in] f Expression function to be interpolated.
+  /// @param[in,out] x Interpolation coordinates of the cells to
+  /// interpolate on. They must have been created for the element and
+  /// mesh of the function space of this function.
+  void interpolate(
+      const std::function<
+          std::pair<std::vector<value_type>, std::vector<std::size_t>>(
+              md::mdspan<const geometry_type,
+                         md::extents<std::size_t, 3, md::dynamic_extent>>)>& f,
+      InterpolationCoords<geometry_type>& x)
+  {
+    assert(_function_space);
+    assert(_function_space->element());
+    if (x.mesh() != _function_space->mesh()
+        or (x.element() != _function_space->element()
+            and !(*x.element() == *_function_space->element())))
     {
-      // Check for scalar-valued functions
-      if (fshape.front() != x.size() / 3)
-        throw std::runtime_error("Data returned by callable has wrong length");
+      throw std::runtime_error("Interpolation coordinates were created for a "
+                               "different element or mesh.");
     }
-    else
-    {
-      // Check for vector/tensor value
-      if (fshape.size() != 2)
-        throw std::runtime_error("Expected 2D array of data");
 
-      if (fshape[0] != vs)
-      {
-        throw std::runtime_error(
-            "Data returned by callable has wrong shape(0) size");
-      }
+    for (std::size_t i = 0; i < x.num_chunks(); ++i)
+      interpolate_values(f, x.x(i), x.cells(i));
+  }
 
-      if (fshape[1] != x.size() / 3)
-      {
-        throw std::runtime_error(
-            "Data returned by callable has wrong shape(1) size");
-      }
+  /// @brief Interpolate an expression f(x) at a subset of the
+  /// degrees-of-freedom.
+  ///
+  /// The expression is evaluated at the coordinates of the
+  /// degrees-of-freedom in `x` only, and the values are set for these
+  /// degrees-of-freedom (including ghosts). Other degrees-of-freedom
+  /// are not changed. This is typically used to update the value of a
+  /// Dirichlet boundary condition at the constrained
+  /// degrees-of-freedom, see fem::DofCoordinates.
+  ///
+  /// @param[in] f Expression function to be interpolated.
+  /// @param[in,out] x Coordinates of the degrees-of-freedom to
+  /// interpolate at. They must have been created for the function space
+  /// of this function.
+  void interpolate(
+      const std::function<
+          std::pair<std::vector<value_type>, std::vector<std::size_t>>(
+              md::mdspan<const geometry_type,
+                         md::extents<std::size_t, 3, md::dynamic_extent>>)>& f,
+      DofCoordinates<geometry_type>& x)
+  {
+    assert(_function_space);
+    assert(x.function_space());
+    if (x.function_space()->mesh() != _function_space->mesh()
+        or x.function_space()->dofmap() != _function_space->dofmap())
+    {
+      throw std::runtime_error("Degree-of-freedom coordinates were created "
+                               "for a different function space.");
     }
 
-    std::array<std::size_t, 2> _fshape;
-    if (fshape.size() == 1)
-      _fshape = {1, fshape[0]};
-    else
-      _fshape = {fshape[0], fshape[1]};
-
-    fem::interpolate(*this, std::span<const value_type>(fx.data(), fx.size()),
-                     _fshape, cells);
+    std::span<const geometry_type> xd = x.x();
+    md::mdspan<const geometry_type,
+               md::extents<std::size_t, 3, md::dynamic_extent>>
+        _xd(xd.data(), 3, xd.size() / 3);
+    const auto [fx, fshape] = f(_xd);
+    const std::array<std::size_t, 2> _fshape
+        = values_shape(fshape, xd.size() / 3);
+
+    // Point evaluation with an identity map, so the value of component
+    // k at dof block d is dof bs * d + k
+    const int bs = _function_space->dofmap()->bs();
+    assert(_fshape[0] == (std::size_t)bs);
+    std::span<const std::int32_t> dofs = x.dofs();
+    std::span<value_type> u = _x->mutable_array();
+    for (std::size_t k = 0; k < _fshape[0]; ++k)
+      for (std::size_t i = 0; i < dofs.size(); ++i)
+        u[bs * dofs[i] + k] = fx[k * _fshape[1] + i];
   }
 
   /// @brief Interpolate a Function over all cells.
@@ -268,6 +393,32 @@ public:
   {
     if (cells1.empty())
       cells1 = cells0;
+
+    // Reuse the cell interpolation operators when interpolating
+    // repeatedly between spaces with different maps
+    assert(u0.function_space());
+    assert(_function_space);
+    std::shared_ptr<const FunctionSpace<geometry_type>> V0
+        = u0.function_space();
+    auto e0 = V0->element();
+    auto e1 = _function_space->element();
+    if (cells0.size() == cells1.size()
+        and std::ranges::equal(e0->value_shape(), e1->value_shape())
+        and e0 != e1 and !(*e0 == *e1) and e0->map_type() != e1->map_type())
+    {
+      if (_interpolation_operator
+          and _interpolation_operator->matches(_function_space, cells1, V0,
+                                               cells0))
+      {
+        _interpolation_operator->apply(*this, u0);
+        return;
+      }
+
+      _interpolation_operator = std::make_shared<
+          NonmatchingInterpolationOperator<value_type, geometry_type>>(
+          _function_space, cells1, V0, cells0);
+    }
+
     fem::interpolate(*this, cells1, u0, cells0);
   }
 
@@ -374,6 +525,45 @@ public:
       }
     }
 
+    // For point evaluation elements with no degree-of-freedom
+    // transformations, e.g. quadrature elements, the Expression values
+    // at the points are the degrees-of-freedom. Write them directly into
+    // the Function vector, evaluating one chunk of cells at a time.
+    std::shared_ptr<const FiniteElement<geometry_type>> element
+        = _function_space->element();
+    if (!element->is_mixed() and element->interpolation_ident()
+        and element->map_ident() and !element->needs_dof_transformations()
+        and !_function_space->symmetric()
+        and element->block_size() == static_cast<int>(value_size))
+    {
+      std::shared_ptr<const DofMap> dofmap = _function_space->dofmap();
+      assert(dofmap);
+      const int dofmap_bs = dofmap->bs();
+      const std::size_t cell_size = e0.X().second[0] * value_size;
+      std::span<value_type> x = _x->mutable_array();
+      auto insert = [&](std::size_t c0, std::span<const value_type> values)
+      {
+        for (std::size_t c = 0; c < values.size() / cell_size; ++c)
+        {
+          std::span<const std::int32_t> dofs
+              = dofmap->cell_dofs(cells1[c0 + c]);
+          std::span<const value_type> vc
+              = values.subspan(c * cell_size, cell_size);
+          for (std::size_t i = 0; i < cell_size; ++i)
+          {
+            std::div_t pos = std::div(static_cast<int>(i), dofmap_bs);
+            x[dofmap_bs * dofs[pos.quot] + pos.rem] = vc[i];
+          }
+        }
+      };
+
+      constexpr std::size_t chunk_size = 4096;
+      tabulate_expression<value_type, geometry_type>(
+          insert, e0, *mesh0, md::mdspan(cells0.data(), cells0.size()),
+          chunk_size);
+      return;
+    }
+
     // Array to hold evaluated Expression
     std::size_t num_cells = cells0.size();
     std::size_t num_points = e0.X().second[0];
@@ -434,6 +624,40 @@ public:
   void eval(std::span<const geometry_type> x, std::array<std::size_t, 2> xshape,
             std::span<const std::int32_t> cells, std::span<value_type> u,
             std::array<std::size_t, 2> ushape) const
+  {
+    EvalWorkspace<value_type, geometry_type> workspace;
+    eval(x, xshape, cells, u, ushape, workspace);
+  }
+
+  /// @brief Evaluate the Function at points, using a workspace for the
+  /// temporary arrays.
+  ///
+  /// Points in the same cell are evaluated together, so that the cell
+  /// geometry, the Jacobian of affine cells and the expansion
+  /// coefficients are computed once per cell. Reusing `workspace` for
+  /// repeated evaluations, e.g. at probe points at every time step,
+  /// avoids re-allocating the temporary arrays.
+  ///
+  /// @param[in] x The coordinates of the points. It has shape
+  /// (num_points, 3) and storage is row-major.
+  /// @param[in] xshape Shape of `x`.
+  /// @param[in] cells Cell indices such that `cells[i]` is the index of
+  /// the cell that contains the point x(i). Negative cell indices can
+  /// be passed, in which case the corresponding point is ignored.
+  /// @param[out] u Values at the points. Values are not computed for
+  /// points with a negative cell index. This argument must be passed
+  /// with the correct size. Storage is row-major.
+  /// @param[in] ushape Shape of `u`.
+  /// @param[in,out] workspace Work arrays, which are resized as
+  /// required.
+  /// @param[in] num_threads Number of threads. The points are divided
+  /// between threads such that the points in a cell are evaluated by
+  /// the same thread.
+  void eval(std::span<const geometry_type> x, std::array<std::size_t, 2> xshape,
+            std::span<const std::int32_t> cells, std::span<value_type> u,
+            std::array<std::size_t, 2> ushape,
+            EvalWorkspace<value_type, geometry_type>& workspace,
+            int num_threads = 1) const
   {
     if (cells.empty())
       return;
@@ -441,9 +665,6 @@ public:
     assert(x.size() == xshape[0] * xshape[1]);
     assert(u.size() == ushape[0] * ushape[1]);
 
-    // TODO: This could be easily made more efficient by exploiting
-    // points being ordered by the cell to which they belong.
-
     if (xshape[0] != cells.size())
     {
       throw std::runtime_error(
@@ -463,7 +684,6 @@ public:
     assert(mesh);
     const std::size_t gdim = mesh->geometry().dim();
     const std::size_t tdim = mesh->topology()->dim();
-    auto map = mesh->topology()->index_map(tdim);
 
     // Get coordinate map
     const CoordinateElement<geometry_type>& cmap = mesh->geometry().cmap();
@@ -491,9 +711,6 @@ public:
                                "elements. Extract subspaces.");
     }
 
-    // Create work vector for expansion coefficients
-    std::vector<value_type> coefficients(space_dimension * bs_element);
-
     // Get dofmap
     std::shared_ptr<const DofMap> dofmap = _function_space->dofmap();
     assert(dofmap);
@@ -506,121 +723,51 @@ public:
       cell_info = std::span(mesh->topology()->get_cell_permutation_info());
     }
 
-    std::vector<geometry_type> coord_dofs_b(num_dofs_g * gdim);
-    impl::mdspan_t<geometry_type, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g,
-                                                gdim);
-    std::vector<geometry_type> xp_b(1 * gdim);
-    impl::mdspan_t<geometry_type, 2> xp(xp_b.data(), 1, gdim);
+    // Precomputed Jacobians of affine cells
+    const mesh::GeometryCache<geometry_type>* geometry_cache = nullptr;
+    if (workspace._geometry_cache and workspace._geometry_cache->mesh() == mesh
+        and !workspace._geometry_cache->stale())
+    {
+      geometry_cache = workspace._geometry_cache.get();
+    }
+
+    // Precomputed linearisations of non-affine cells
+    const mesh::CurvedGeometryCache<geometry_type>* curved_cache = nullptr;
+    if (workspace._curved_geometry_cache
+        and workspace._curved_geometry_cache->mesh() == mesh
+        and !workspace._curved_geometry_cache->stale())
+    {
+      curved_cache = workspace._curved_geometry_cache.get();
+    }
 
-    // Loop over points
     std::ranges::fill(u, 0.0);
     std::span<const value_type> _v = _x->array();
 
+    // Group the points (with a non-negative cell index) by cell
+    std::vector<std::pair<std::int32_t, std::size_t>>& points
+        = workspace._points;
+    points.clear();
+    for (std::size_t p = 0; p < cells.size(); ++p)
+    {
+      if (cells[p] >= 0)
+        points.emplace_back(cells[p], p);
+    }
+    std::ranges::sort(points);
+    if (points.empty())
+      return;
+
     // Evaluate geometry basis at point (0, 0, 0) on the reference cell.
     // Used in affine case.
     std::array<std::size_t, 4> phi0_shape = cmap.tabulate_shape(1, 1);
-    std::vector<geometry_type> phi0_b(std::reduce(
-        phi0_shape.begin(), phi0_shape.end(), 1, std::multiplies{}));
-    impl::mdspan_t<const geometry_type, 4> phi0(phi0_b.data(), phi0_shape);
-    cmap.tabulate(1, std::vector<geometry_type>(tdim), {1, tdim}, phi0_b);
+    workspace._phi0.resize(std::reduce(phi0_shape.begin(), phi0_shape.end(),
+                                       1, std::multiplies{}));
+    impl::mdspan_t<const geometry_type, 4> phi0(workspace._phi0.data(),
+                                                phi0_shape);
+    const std::array<geometry_type, 3> X0 = {0, 0, 0};
+    cmap.tabulate(1, std::span(X0.data(), tdim), {1, tdim}, workspace._phi0);
     auto dphi0
         = md::submdspan(phi0, std::pair(1, tdim + 1), 0, md::full_extent, 0);
 
-    // Data structure for evaluating geometry basis at specific points.
-    // Used in non-affine case.
-    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, 1);
-    std::vector<geometry_type> phi_b(
-        std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
-    impl::mdspan_t<const geometry_type, 4> phi(phi_b.data(), phi_shape);
-    auto dphi
-        = md::submdspan(phi, std::pair(1, tdim + 1), 0, md::full_extent, 0);
-
-    // Reference coordinates for each point
-    std::vector<geometry_type> Xb(xshape[0] * tdim);
-    impl::mdspan_t<geometry_type, 2> X(Xb.data(), xshape[0], tdim);
-
-    // Geometry data at each point
-    std::vector<geometry_type> J_b(xshape[0] * gdim * tdim);
-    impl::mdspan_t<geometry_type, 3> J(J_b.data(), xshape[0], gdim, tdim);
-    std::vector<geometry_type> K_b(xshape[0] * tdim * gdim);
-    impl::mdspan_t<geometry_type, 3> K(K_b.data(), xshape[0], tdim, gdim);
-    std::vector<geometry_type> detJ(xshape[0]);
-    std::vector<geometry_type> det_scratch(2 * gdim * tdim);
-
-    // Prepare geometry data in each cell
-    for (std::size_t p = 0; p < cells.size(); ++p)
-    {
-      const int cell_index = cells[p];
-
-      // Skip negative cell indices
-      if (cell_index < 0)
-        continue;
-
-      // Get cell geometry (coordinate dofs)
-      auto x_dofs = md::submdspan(x_dofmap, cell_index, md::full_extent);
-      assert(x_dofs.size() == num_dofs_g);
-      for (std::size_t i = 0; i < num_dofs_g; ++i)
-      {
-        const int pos = 3 * x_dofs[i];
-        for (std::size_t j = 0; j < gdim; ++j)
-          coord_dofs(i, j) = x_g[pos + j];
-      }
-
-      for (std::size_t j = 0; j < gdim; ++j)
-        xp(0, j) = x[p * xshape[1] + j];
-
-      auto _J = md::submdspan(J, p, md::full_extent, md::full_extent);
-      auto _K = md::submdspan(K, p, md::full_extent, md::full_extent);
-
-      std::array<geometry_type, 3> Xpb = {0, 0, 0};
-      md::mdspan<geometry_type, md::extents<std::size_t, 1, md::dynamic_extent>>
-          Xp(Xpb.data(), 1, tdim);
-
-      // Compute reference coordinates X, and J, detJ and K
-      if (cmap.is_affine())
-      {
-        CoordinateElement<geometry_type>::compute_jacobian(dphi0, coord_dofs,
-                                                           _J);
-        CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
-        std::array<geometry_type, 3> x0 = {0, 0, 0};
-        for (std::size_t i = 0; i < coord_dofs.extent(1); ++i)
-          x0[i] += coord_dofs(0, i);
-        CoordinateElement<geometry_type>::pull_back_affine(Xp, _K, x0, xp);
-        detJ[p]
-            = CoordinateElement<geometry_type>::compute_jacobian_determinant(
-                _J, det_scratch);
-      }
-      else
-      {
-        // Pull-back physical point xp to reference coordinate Xp
-        cmap.pull_back_nonaffine(Xp, xp, coord_dofs);
-        cmap.tabulate(1, std::span(Xpb.data(), tdim), {1, tdim}, phi_b);
-        CoordinateElement<geometry_type>::compute_jacobian(dphi, coord_dofs,
-                                                           _J);
-        CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
-        detJ[p]
-            = CoordinateElement<geometry_type>::compute_jacobian_determinant(
-                _J, det_scratch);
-      }
-
-      for (std::size_t j = 0; j < X.extent(1); ++j)
-        X(p, j) = Xpb[j];
-    }
-
-    // Prepare basis function data structures
-    std::vector<geometry_type> basis_derivatives_reference_values_b(
-        1 * xshape[0] * space_dimension * reference_value_size);
-    impl::mdspan_t<const geometry_type, 4> basis_derivatives_reference_values(
-        basis_derivatives_reference_values_b.data(), 1, xshape[0],
-        space_dimension, reference_value_size);
-    std::vector<geometry_type> basis_values_b(space_dimension * value_size);
-    impl::mdspan_t<geometry_type, 2> basis_values(basis_values_b.data(),
-                                                  space_dimension, value_size);
-
-    // Compute basis on reference element
-    element->tabulate(basis_derivatives_reference_values_b, Xb,
-                      {X.extent(0), X.extent(1)}, 0);
-
     using xu_t = impl::mdspan_t<geometry_type, 2>;
     using xU_t = impl::mdspan_t<const geometry_type, 2>;
     using xJ_t = impl::mdspan_t<const geometry_type, 2>;
@@ -643,91 +790,365 @@ public:
         ++matrix_size;
     }
 
-    const std::size_t num_basis_values = space_dimension * reference_value_size;
-    for (std::size_t p = 0; p < cells.size(); ++p)
+    // Evaluate the points [r0, r1) of the sorted points, using the
+    // work arrays `w`
+    auto eval_points = [&](std::size_t r0, std::size_t r1, auto& w)
     {
-      const int cell_index = cells[p];
-      if (cell_index < 0) // Skip negative cell indices
-        continue;
-
-      // Permute the reference basis function values to account for the
-      // cell's orientation
-      apply_dof_transformation(
-          std::span(basis_derivatives_reference_values_b.data()
-                        + p * num_basis_values,
-                    num_basis_values),
-          cell_info, cell_index, reference_value_size);
-
+      const std::size_t num_points = r1 - r0;
+      std::span<const std::pair<std::int32_t, std::size_t>> pts(
+          points.data() + r0, num_points);
+
+      w.coord_dofs.resize(num_dofs_g * gdim);
+      impl::mdspan_t<geometry_type, 2> coord_dofs(w.coord_dofs.data(),
+                                                  num_dofs_g, gdim);
+
+      // Reference coordinates and geometry data at each point
+      w.X.resize(num_points * tdim);
+      impl::mdspan_t<geometry_type, 2> X(w.X.data(), num_points, tdim);
+      w.J.assign(num_points * gdim * tdim, 0);
+      impl::mdspan_t<geometry_type, 3> J(w.J.data(), num_points, gdim, tdim);
+      w.K.assign(num_points * tdim * gdim, 0);
+      impl::mdspan_t<geometry_type, 3> K(w.K.data(), num_points, tdim, gdim);
+      w.detJ.resize(num_points);
+      w.det_scratch.resize(2 * gdim * tdim);
+
+      // Points in non-affine cells, and their cell geometry, which are
+      // pulled back together
+      w.nonaffine_points.clear();
+      w.nonaffine_x.clear();
+      w.nonaffine_coord_dofs.clear();
+
+      // Prepare geometry data in each cell
+      for (std::size_t q0 = 0; q0 < num_points;)
       {
-        auto _U = md::submdspan(basis_derivatives_reference_values, 0, p,
-                                md::full_extent, md::full_extent);
-        auto _J = md::submdspan(J, p, md::full_extent, md::full_extent);
-        auto _K = md::submdspan(K, p, md::full_extent, md::full_extent);
-        push_forward_fn(basis_values, _U, _J, detJ[p], _K);
-      }
+        const std::int32_t cell_index = pts[q0].first;
+        std::size_t q1 = q0 + 1;
+        while (q1 < num_points and pts[q1].first == cell_index)
+          ++q1;
+
+        // Get cell geometry (coordinate dofs)
+        auto x_dofs = md::submdspan(x_dofmap, cell_index, md::full_extent);
+        assert(x_dofs.size() == num_dofs_g);
+        for (std::size_t i = 0; i < num_dofs_g; ++i)
+        {
+          const int pos = 3 * x_dofs[i];
+          for (std::size_t j = 0; j < gdim; ++j)
+            coord_dofs(i, j) = x_g[pos + j];
+        }
 
-      // Get degrees of freedom for current cell
-      std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell_index);
-      for (std::size_t i = 0; i < dofs.size(); ++i)
-        for (int k = 0; k < bs_dof; ++k)
-          coefficients[bs_dof * i + k] = _v[bs_dof * dofs[i] + k];
+        if (!cmap.is_affine())
+        {
+          for (std::size_t q = q0; q < q1; ++q)
+          {
+            auto xp = std::next(x.begin(), pts[q].second * xshape[1]);
+            w.nonaffine_points.push_back(q);
+            w.nonaffine_x.insert(w.nonaffine_x.end(), xp, std::next(xp, gdim));
+            w.nonaffine_coord_dofs.insert(w.nonaffine_coord_dofs.end(),
+                                          w.coord_dofs.begin(),
+                                          w.coord_dofs.end());
+          }
+          q0 = q1;
+          continue;
+        }
+
+        // Compute J, detJ and K, which are the same for all points in
+        // the cell
+        auto _J = md::submdspan(J, q0, md::full_extent, md::full_extent);
+        auto _K = md::submdspan(K, q0, md::full_extent, md::full_extent);
+        if (geometry_cache)
+        {
+          std::span<const geometry_type> g = geometry_cache->data().subspan(
+              cell_index * geometry_cache->stride(), geometry_cache->stride());
+          std::copy_n(g.begin(), gdim * tdim,
+                      std::next(w.J.begin(), q0 * gdim * tdim));
+          std::copy_n(std::next(g.begin(), gdim * tdim), tdim * gdim,
+                      std::next(w.K.begin(), q0 * tdim * gdim));
+          w.detJ[q0] = g.back();
+        }
+        else
+        {
+          CoordinateElement<geometry_type>::compute_jacobian(dphi0,
+                                                             coord_dofs, _J);
+          CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
+          w.detJ[q0]
+              = CoordinateElement<geometry_type>::compute_jacobian_determinant(
+                  _J, w.det_scratch);
+        }
+        std::array<geometry_type, 3> x0 = {0, 0, 0};
+        for (std::size_t i = 0; i < coord_dofs.extent(1); ++i)
+          x0[i] += coord_dofs(0, i);
+
+        for (std::size_t q = q0; q < q1; ++q)
+        {
+          if (q > q0)
+          {
+            std::copy_n(std::next(w.J.begin(), q0 * gdim * tdim), gdim * tdim,
+                        std::next(w.J.begin(), q * gdim * tdim));
+            std::copy_n(std::next(w.K.begin(), q0 * tdim * gdim), tdim * gdim,
+                        std::next(w.K.begin(), q * tdim * gdim));
+            w.detJ[q] = w.detJ[q0];
+          }
 
-      if (element->symmetric())
+          // Compute reference coordinates X
+          std::array<geometry_type, 3> xpb = {0, 0, 0};
+          impl::mdspan_t<geometry_type, 2> xp(xpb.data(), 1, gdim);
+          for (std::size_t j = 0; j < gdim; ++j)
+            xp(0, j) = x[pts[q].second * xshape[1] + j];
+          std::array<geometry_type, 3> Xpb = {0, 0, 0};
+          md::mdspan<geometry_type,
+                     md::extents<std::size_t, 1, md::dynamic_extent>>
+              Xp(Xpb.data(), 1, tdim);
+          CoordinateElement<geometry_type>::pull_back_affine(Xp, _K, x0, xp);
+          for (std::size_t j = 0; j < X.extent(1); ++j)
+            X(q, j) = Xpb[j];
+        }
+
+        q0 = q1;
+      }
+
+      if (!w.nonaffine_points.empty())
       {
-        int row = 0;
-        int rowstart = 0;
-        // Compute expansion
-        for (int k = 0; k < bs_element; ++k)
+        // Pull-back physical points to reference coordinates
+        const std::size_t num_nonaffine = w.nonaffine_points.size();
+        w.Xn.resize(num_nonaffine * tdim);
+        impl::mdspan_t<geometry_type, 2> Xn(w.Xn.data(), num_nonaffine, tdim);
+        impl::mdspan_t<const geometry_type, 3> cdofs(
+            w.nonaffine_coord_dofs.data(), num_nonaffine, num_dofs_g, gdim);
+        if (curved_cache)
         {
-          if (k - rowstart > row)
+          for (std::size_t i = 0; i < num_nonaffine; ++i)
           {
-            row++;
-            rowstart = k;
+            curved_cache->initial_guess(
+                pts[w.nonaffine_points[i]].first,
+                std::span(w.nonaffine_x.data() + i * gdim, gdim),
+                std::span(w.Xn.data() + i * tdim, tdim));
           }
-          for (std::size_t i = 0; i < space_dimension; ++i)
+        }
+        cmap.pull_back_nonaffine(
+            Xn,
+            impl::mdspan_t<const geometry_type, 2>(w.nonaffine_x.data(),
+                                                   num_nonaffine, gdim),
+            cdofs, 1.0e-6, 15, curved_cache != nullptr);
+
+        // Evaluate geometry basis derivatives at the reference points
+        std::array<std::size_t, 4> phi_shape
+            = cmap.tabulate_shape(1, num_nonaffine);
+        w.phi.resize(std::reduce(phi_shape.begin(), phi_shape.end(), 1,
+                                 std::multiplies{}));
+        impl::mdspan_t<const geometry_type, 4> phi(w.phi.data(), phi_shape);
+        cmap.tabulate(1, w.Xn, {num_nonaffine, tdim}, w.phi);
+
+        for (std::size_t i = 0; i < num_nonaffine; ++i)
+        {
+          const std::size_t q = w.nonaffine_points[i];
+          auto dphi = md::submdspan(phi, std::pair(1, tdim + 1), i,
+                                    md::full_extent, 0);
+          auto _coord_dofs
+              = md::submdspan(cdofs, i, md::full_extent, md::full_extent);
+          auto _J = md::submdspan(J, q, md::full_extent, md::full_extent);
+          auto _K = md::submdspan(K, q, md::full_extent, md::full_extent);
+          CoordinateElement<geometry_type>::compute_jacobian(dphi, _coord_dofs,
+                                                             _J);
+          CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
+          w.detJ[q]
+              = CoordinateElement<geometry_type>::compute_jacobian_determinant(
+                  _J, w.det_scratch);
+          for (std::size_t j = 0; j < X.extent(1); ++j)
+            X(q, j) = Xn(i, j);
+        }
+      }
+
+      // Compute basis on reference element
+      const std::size_t num_basis_values
+          = space_dimension * reference_value_size;
+      w.basis_reference_values.resize(num_points * num_basis_values);
+      impl::mdspan_t<const geometry_type, 3> basis_reference_values(
+          w.basis_reference_values.data(), num_points, space_dimension,
+          reference_value_size);
+      element->tabulate(w.basis_reference_values, w.X, {num_points, tdim},
+                        0);
+
+      w.basis_values.resize(space_dimension * value_size);
+      impl::mdspan_t<geometry_type, 2> basis_values(
+          w.basis_values.data(), space_dimension, value_size);
+      w.coefficients.resize(space_dimension * bs_element);
+      std::span<value_type> coefficients(w.coefficients);
+      for (std::size_t q = 0; q < num_points; ++q)
+      {
+        const std::int32_t cell_index = pts[q].first;
+        const std::size_t p = pts[q].second;
+
+        // Permute the reference basis function values to account for
+        // the cell's orientation
+        apply_dof_transformation(
+            std::span(w.basis_reference_values.data() + q * num_basis_values,
+                      num_basis_values),
+            cell_info, cell_index, reference_value_size);
+
+        {
+          auto _U = md::submdspan(basis_reference_values, q, md::full_extent,
+                                  md::full_extent);
+          auto _J = md::submdspan(J, q, md::full_extent, md::full_extent);
+          auto _K = md::submdspan(K, q, md::full_extent, md::full_extent);
+          push_forward_fn(basis_values, _U, _J, w.detJ[q], _K);
+        }
+
+        // Get degrees of freedom for current cell, once for all points
+        // in the cell
+        if (q == 0 or pts[q - 1].first != cell_index)
+        {
+          std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell_index);
+          for (std::size_t i = 0; i < dofs.size(); ++i)
+            for (int k = 0; k < bs_dof; ++k)
+              coefficients[bs_dof * i + k] = _v[bs_dof * dofs[i] + k];
+        }
+
+        if (element->symmetric())
+        {
+          int row = 0;
+          int rowstart = 0;
+          // Compute expansion
+          for (int k = 0; k < bs_element; ++k)
           {
-            for (std::size_t j = 0; j < value_size; ++j)
+            if (k - rowstart > row)
             {
-              u[p * ushape[1]
-                + (j * bs_element + row * matrix_size + k - rowstart)]
-                  += coefficients[bs_element * i + k] * basis_values(i, j);
-              if (k - rowstart != row)
+              row++;
+              rowstart = k;
+            }
+            for (std::size_t i = 0; i < space_dimension; ++i)
+            {
+              for (std::size_t j = 0; j < value_size; ++j)
               {
                 u[p * ushape[1]
-                  + (j * bs_element + row + matrix_size * (k - rowstart))]
+                  + (j * bs_element + row * matrix_size + k - rowstart)]
                     += coefficients[bs_element * i + k] * basis_values(i, j);
+                if (k - rowstart != row)
+                {
+                  u[p * ushape[1]
+                    + (j * bs_element + row + matrix_size * (k - rowstart))]
+                      += coefficients[bs_element * i + k] * basis_values(i, j);
+                }
               }
             }
           }
         }
-      }
-      else
-      {
-        // Compute expansion
-        for (int k = 0; k < bs_element; ++k)
+        else
         {
-          for (std::size_t i = 0; i < space_dimension; ++i)
+          // Compute expansion
+          for (int k = 0; k < bs_element; ++k)
           {
-            for (std::size_t j = 0; j < value_size; ++j)
+            for (std::size_t i = 0; i < space_dimension; ++i)
             {
-              u[p * ushape[1] + (j * bs_element + k)]
-                  += coefficients[bs_element * i + k] * basis_values(i, j);
+              for (std::size_t j = 0; j < value_size; ++j)
+              {
+                u[p * ushape[1] + (j * bs_element + k)]
+                    += coefficients[bs_element * i + k] * basis_values(i, j);
+              }
             }
           }
         }
       }
-    }
+    };
+
+    // Divide the points between threads at cell boundaries
+    num_threads = std::clamp<int>(num_threads, 1, points.size());
+    if (workspace._buffers.size() < static_cast<std::size_t>(num_threads))
+      workspace._buffers.resize(num_threads);
+    auto cell_boundary = [&](std::size_t r)
+    {
+      while (r > 0 and r < points.size()
+             and points[r].first == points[r - 1].first)
+      {
+        ++r;
+      }
+      return r;
+    };
+    common::run_threads(
+        num_threads,
+        [&](int t)
+        {
+          auto [r0, r1] = common::thread_range(t, points.size(), num_threads);
+          r0 = cell_boundary(r0);
+          r1 = cell_boundary(r1);
+          if (r0 < r1)
+            eval_points(r0, r1, workspace._buffers[t]);
+        });
   }
 
   /// Name
   std::string name = "u";
 
 private:
+  // Evaluate f at the interpolation coordinates x of the cells, check
+  // the shape of the values, and interpolate the values
+  void interpolate_values(
+      const std::function<
+          std::pair<std::vector<value_type>, std::vector<std::size_t>>(
+              md::mdspan<const geometry_type,
+                         md::extents<std::size_t, 3, md::dynamic_extent>>)>& f,
+      std::span<const geometry_type> x, std::span<const std::int32_t> cells)
+  {
+    md::mdspan<const geometry_type,
+               md::extents<std::size_t, 3, md::dynamic_extent>>
+        _x(x.data(), 3, x.size() / 3);
+
+    const auto [fx, fshape] = f(_x);
+    const std::array<std::size_t, 2> _fshape
+        = values_shape(fshape, x.size() / 3);
+    fem::interpolate(*this, std::span<const value_type>(fx.data(), fx.size()),
+                     _fshape, cells);
+  }
+
+  // Check the shape of the values returned by an expression evaluated
+  // at num_points points and return the shape as (value_size,
+  // num_points)
+  std::array<std::size_t, 2>
+  values_shape(const std::vector<std::size_t>& fshape,
+               std::size_t num_points) const
+  {
+    assert(fshape.size() <= 2);
+    if (int vs = _function_space->element()->value_size();
+        vs == 1 and fshape.size() == 1)
+    {
+      // Check for scalar-valued functions
+      if (fshape.front() != num_points)
+        throw std::runtime_error("Data returned by callable has wrong length");
+    }
+    else
+    {
+      // Check for vector/tensor value
+      if (fshape.size() != 2)
+        throw std::runtime_error("Expected 2D array of data");
+
+      if (fshape[0] != vs)
+      {
+        throw std::runtime_error(
+            "Data returned by callable has wrong shape(0) size");
+      }
+
+      if (fshape[1] != num_points)
+      {
+        throw std::runtime_error(
+            "Data returned by callable has wrong shape(1) size");
+      }
+    }
+
+    if (fshape.size() == 1)
+      return {1, fshape[0]};
+    else
+      return {fshape[0], fshape[1]};
+  }
+
   // Function space
   std::shared_ptr<const FunctionSpace<geometry_type>> _function_space;
 
   // Vector of expansion coefficients (local)
   std::shared_ptr<la::Vector<value_type>> _x;
+
+  // Operator of the most recent interpolation from a space with a
+  // different map, reused by repeated interpolation
+  std::shared_ptr<NonmatchingInterpolationOperator<value_type, geometry_type>>
+      _interpolation_operator;
 };
 
 } // namespace dolfinx::fem
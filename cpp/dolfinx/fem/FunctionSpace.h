@@ -8,6 +8,7 @@
 
 #include "CoordinateElement.h"
 #include "DofMap.h"
+#include "DofTransformation.h"
 #include "FiniteElement.h"
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -20,6 +21,10 @@
 #include <dolfinx/mesh/Topology.h>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <tuple>
+#include <typeindex>
 #include <vector>
 
 namespace dolfinx::fem
@@ -45,7 +50,8 @@ public:
                 std::shared_ptr<const FiniteElement<geometry_type>> element,
                 std::shared_ptr<const DofMap> dofmap)
       : _mesh(mesh), _elements{element}, _dofmaps{dofmap},
-        _id(boost::uuids::random_generator()()), _root_space_id(_id)
+        _id(boost::uuids::random_generator()()), _root_space_id(_id),
+        _cache(std::make_shared<Cache>())
   {
     // Do nothing
   }
@@ -63,7 +69,8 @@ public:
       std::vector<std::shared_ptr<const FiniteElement<geometry_type>>> elements,
       std::vector<std::shared_ptr<const DofMap>> dofmaps)
       : _mesh(mesh), _elements(elements), _dofmaps(dofmaps),
-        _id(boost::uuids::random_generator()()), _root_space_id(_id)
+        _id(boost::uuids::random_generator()()), _root_space_id(_id),
+        _cache(std::make_shared<Cache>())
   {
     std::vector<mesh::CellType> cell_types = mesh->topology()->cell_types();
     std::size_t num_cell_types = cell_types.size();
@@ -102,9 +109,10 @@ public:
 
   /// @brief Create a subspace (view) for a specific component.
   ///
-  /// @note If the subspace is re-used, for performance reasons the
-  /// returned subspace should be stored by the caller to avoid repeated
-  /// re-computation of the subspace.
+  /// The sub-element and sub-dofmap are computed the first time that a
+  /// component is requested, and shared by the subspaces that are
+  /// returned for the component. Subspaces for the same component also
+  /// share the cached collapsed space, see collapsed().
   ///
   /// @param[in] component Subspace component.
   /// @return A subspace.
@@ -118,15 +126,29 @@ public:
     if (component.empty())
       throw std::runtime_error("Component must be non-empty");
 
-    // Extract sub-element
-    auto element = this->_elements.front()->extract_sub_element(component);
-
-    // Extract sub dofmap
-    auto dofmap = std::make_shared<DofMap>(
-        _dofmaps.front()->extract_sub_dofmap(component));
+    // Extract sub-element and sub dofmap, or get the cached ones
+    std::shared_ptr<const FiniteElement<geometry_type>> element;
+    std::shared_ptr<const DofMap> dofmap;
+    std::shared_ptr<Cache> cache;
+    {
+      std::scoped_lock lock(_cache->mutex);
+      auto [it, inserted] = _cache->sub.try_emplace(component);
+      if (inserted)
+      {
+        it->second.element
+            = this->_elements.front()->extract_sub_element(component);
+        it->second.dofmap = std::make_shared<DofMap>(
+            _dofmaps.front()->extract_sub_dofmap(component));
+        it->second.cache = std::make_shared<Cache>();
+      }
+      element = it->second.element;
+      dofmap = it->second.dofmap;
+      cache = it->second.cache;
+    }
 
     // Create new sub space
     FunctionSpace sub_space(_mesh, element, dofmap);
+    sub_space._cache = cache;
 
     // Set root space id and component w.r.t. root
     sub_space._root_space_id = _root_space_id;
@@ -164,20 +186,50 @@ public:
 
   /// Collapse a subspace and return a new function space and a map from
   /// new to old dofs
+  /// @note The collapsed dofmap is shared with the space returned by
+  /// collapsed(), so that only the first call computes it.
   /// @return The new function space and a map from new to old dofs
   std::pair<FunctionSpace, std::vector<std::int32_t>> collapse() const
+  {
+    auto [V, dofs] = collapsed();
+    return {FunctionSpace(_mesh, _elements.front(), V->dofmap()),
+            std::vector<std::int32_t>(dofs.begin(), dofs.end())};
+  }
+
+  /// @brief Get the collapsed subspace and the map from its dofs to the
+  /// dofs of this space.
+  ///
+  /// The collapsed space is computed (see collapse()) the first time
+  /// that it is requested, and then returned without copies. The cache
+  /// is shared by the subspaces returned by sub() for the same
+  /// component.
+  ///
+  /// @note The first call for a component is collective.
+  ///
+  /// @return The collapsed space and a map from its dofs to dofs of
+  /// this space. The map is valid while this space, or a subspace for
+  /// the same component, exists.
+  std::pair<std::shared_ptr<const FunctionSpace>,
+            std::span<const std::int32_t>>
+  collapsed() const
   {
     if (_component.empty())
       throw std::runtime_error("Function space is not a subspace");
 
-    // Create collapsed DofMap
-    auto [_collapsed_dofmap, collapsed_dofs]
-        = _dofmaps.front()->collapse(_mesh->comm(), *_mesh->topology());
-    auto collapsed_dofmap
-        = std::make_shared<DofMap>(std::move(_collapsed_dofmap));
+    std::scoped_lock lock(_cache->mutex);
+    if (!_cache->collapsed)
+    {
+      // Create collapsed DofMap
+      auto [_collapsed_dofmap, collapsed_dofs]
+          = _dofmaps.front()->collapse(_mesh->comm(), *_mesh->topology());
+      auto collapsed_dofmap
+          = std::make_shared<DofMap>(std::move(_collapsed_dofmap));
+      _cache->collapsed = std::make_shared<const FunctionSpace>(
+          _mesh, _elements.front(), collapsed_dofmap);
+      _cache->collapsed_dofs = std::move(collapsed_dofs);
+    }
 
-    return {FunctionSpace(_mesh, _elements.front(), collapsed_dofmap),
-            std::move(collapsed_dofs)};
+    return {_cache->collapsed, _cache->collapsed_dofs};
   }
 
   /// @brief Get the component with respect to the root superspace.
@@ -289,7 +341,7 @@ public:
     std::vector<geometry_type> phi_b(
         std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
     cmdspan4_t phi_full(phi_b.data(), phi_shape);
-    cmap.tabulate(0, X, Xshape, phi_b);
+    cmap.tabulate_cached(0, X, Xshape, phi_b);
     auto phi = md::submdspan(phi_full, 0, md::full_extent, md::full_extent, 0);
 
     // TODO: Check transform
@@ -375,6 +427,58 @@ public:
     return _dofmaps.at(cell_type_idx);
   }
 
+  /// @brief Precomputed DOF transformation of the element of a cell
+  /// type (see DofTransformation).
+  ///
+  /// The transformation is computed on the first call for a cell type,
+  /// transformation type, side and scalar type, using the cell
+  /// permutation information of the mesh of the space, and is cached.
+  /// Later calls, e.g. by repeated assembly, return the cached object.
+  ///
+  /// @tparam S Scalar type of the transformed data.
+  /// @param[in] cell_type_idx Index of the cell type.
+  /// @param[in] ttype Transformation type.
+  /// @param[in] right If true, the transformation is applied from the
+  /// right, otherwise from the left.
+  /// @return The transformation.
+  template <dolfinx::scalar S>
+  std::shared_ptr<const DofTransformation<S>>
+  dof_transformation(int cell_type_idx, doftransform ttype, bool right) const
+  {
+    std::shared_ptr<const FiniteElement<geometry_type>> element
+        = _elements.at(cell_type_idx);
+    assert(element);
+
+    std::scoped_lock lock(_cache->mutex);
+    std::shared_ptr<const void>& P = _cache->transformations[{
+        cell_type_idx, ttype, right, std::type_index(typeid(S))}];
+    if (!P)
+    {
+      std::span<const std::uint32_t> cell_info;
+      if (element->needs_dof_transformations())
+      {
+        _mesh->topology_mutable()->create_entity_permutations();
+        cell_info = std::span(_mesh->topology()->get_cell_permutation_info());
+      }
+      P = std::make_shared<const DofTransformation<S>>(*element, ttype, right,
+                                                       cell_info);
+    }
+
+    return std::static_pointer_cast<const DofTransformation<S>>(P);
+  }
+
+  /// @brief Memory used by the dofmaps of the function space.
+  /// @note The mesh, which is usually shared by many function spaces,
+  /// is not included (see mesh::Mesh::memory_usage).
+  /// @return Number of bytes.
+  std::size_t memory_usage() const
+  {
+    std::size_t bytes = 0;
+    for (auto& dofmap : _dofmaps)
+      bytes += dofmap->memory_usage();
+    return bytes;
+  }
+
 private:
   // The mesh
   std::shared_ptr<const mesh::Mesh<geometry_type>> _mesh;
@@ -391,6 +495,31 @@ private:
   // Unique identifier for the space and for its root space
   boost::uuids::uuid _id;
   boost::uuids::uuid _root_space_id;
+
+  // Sub-elements, sub-dofmaps and caches of the subspaces (by
+  // component), the collapsed space of a subspace, and the DOF
+  // transformations (by cell type, transformation type, side and
+  // scalar type)
+  struct Cache
+  {
+    struct Sub
+    {
+      std::shared_ptr<const FiniteElement<geometry_type>> element;
+      std::shared_ptr<const DofMap> dofmap;
+      std::shared_ptr<Cache> cache;
+    };
+
+    std::mutex mutex;
+    std::map<std::vector<int>, Sub> sub;
+    std::shared_ptr<const FunctionSpace> collapsed;
+    std::vector<std::int32_t> collapsed_dofs;
+    std::map<std::tuple<int, doftransform, bool, std::type_index>,
+             std::shared_ptr<const void>>
+        transformations;
+  };
+
+  // Cache shared by the subspaces for the same component of a space
+  std::shared_ptr<Cache> _cache;
 };
 
 /// @brief Extract FunctionSpaces for (0) rows blocks and (1) columns
@@ -0,0 +1,596 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DirichletBC.h"
+#include "DofMap.h"
+#include "DofTransformation.h"
+#include "FiniteElement.h"
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "colouring.h"
+#include "pack.h"
+#include "traits.h"
+#include <algorithm>
+#include <array>
+#include <basix/mdspan.hpp>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Matrix-free action of a bilinear form.
+///
+/// Computes `y = A x`, where `A` is the matrix of a bilinear form, by
+/// tabulating and applying the element matrices entity-by-entity rather
+/// than assembling `A`. Constants, coefficients, the entity geometry,
+/// the (merged) degrees-of-freedom of the cells attached to each entity
+/// and the facet permutations are packed when the operator is created
+/// and re-used by every application.
+///
+/// Cell, exterior facet and interior facet integrals are supported, so
+/// that discontinuous Galerkin operators can be applied. For an
+/// interior facet, the element matrix couples the degrees-of-freedom of
+/// the two attached cells.
+///
+/// The forward scatter of the ghost entries of `x` is overlapped with
+/// the computation on entities that do not depend on ghost entries of
+/// `x`. Entities with ghost (trial space) degrees-of-freedom, e.g.
+/// interior facets shared with a ghost cell, are processed after the
+/// ghost values have been received.
+///
+/// @note Facet integrals are not supported on mixed-topology meshes.
+///
+/// @tparam T Scalar type of the form.
+/// @tparam U Geometry type.
+template <dolfinx::scalar T, std::floating_point U = scalar_value_t<T>>
+class MatrixFreeOperator
+{
+public:
+  /// Scalar type
+  using scalar_type = T;
+
+  /// Geometry type
+  using geometry_type = U;
+
+  /// @brief Create a matrix-free operator for a bilinear form.
+  /// @param[in] a Bilinear form.
+  /// @param[in] bcs Boundary conditions to apply. For boundary
+  /// condition dofs the row and column are zeroed, as in
+  /// fem::assemble_matrix.
+  /// @param[in] diagonal Value of the diagonal entry of boundary
+  /// condition rows. Only applied if the test and trial function spaces
+  /// are the same.
+  MatrixFreeOperator(
+      std::shared_ptr<const Form<T, U>> a,
+      const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs
+      = {},
+      T diagonal = 1)
+      : _a(a), _diagonal(diagonal)
+  {
+    if (!_a)
+      throw std::runtime_error("Form is null.");
+    if (_a->rank() != 2)
+      throw std::runtime_error("Form must be bilinear.");
+
+    std::shared_ptr<const mesh::Mesh<U>> mesh = _a->mesh();
+    assert(mesh);
+    std::shared_ptr<const mesh::Topology> topology = mesh->topology();
+    const int num_cell_types = topology->cell_types().size();
+    for (IntegralType type : _a->integral_types())
+    {
+      if (type != IntegralType::cell and type != IntegralType::exterior_facet
+          and type != IntegralType::interior_facet)
+      {
+        throw std::runtime_error(
+            "MatrixFreeOperator supports cell and facet integrals only.");
+      }
+      if (type != IntegralType::cell and num_cell_types > 1)
+      {
+        throw std::runtime_error(
+            "Facet integrals on mixed-topology meshes are not supported.");
+      }
+    }
+
+    // Build dof markers
+    auto V0 = _a->function_spaces().at(0);
+    auto V1 = _a->function_spaces().at(1);
+    auto map0 = V0->dofmaps(0)->index_map;
+    auto map1 = V1->dofmaps(0)->index_map;
+    int bs0 = V0->dofmaps(0)->index_map_bs();
+    int bs1 = V1->dofmaps(0)->index_map_bs();
+    for (auto& bc : bcs)
+    {
+      assert(bc.get().function_space());
+      if (V0->contains(*bc.get().function_space()))
+      {
+        _bc0.resize(bs0 * (map0->size_local() + map0->num_ghosts()), false);
+        bc.get().mark_dofs(_bc0);
+      }
+      if (V1->contains(*bc.get().function_space()))
+      {
+        _bc1.resize(bs1 * (map1->size_local() + map1->num_ghosts()), false);
+        bc.get().mark_dofs(_bc1);
+      }
+    }
+
+    for (int cell_type_idx = 0; cell_type_idx < num_cell_types;
+         ++cell_type_idx)
+    {
+      auto element0 = V0->elements(cell_type_idx);
+      auto element1 = V1->elements(cell_type_idx);
+      std::span<const std::uint32_t> cell_info0, cell_info1;
+      if (element0->needs_dof_transformations()
+          or element1->needs_dof_transformations())
+      {
+        V0->mesh()->topology_mutable()->create_entity_permutations();
+        V1->mesh()->topology_mutable()->create_entity_permutations();
+        cell_info0 = V0->mesh()->topology()->get_cell_permutation_info();
+        cell_info1 = V1->mesh()->topology()->get_cell_permutation_info();
+      }
+      _transformations.emplace_back(
+          DofTransformation<T>(*element0, doftransform::standard, false,
+                               cell_info0),
+          DofTransformation<T>(*element1, doftransform::transpose, true,
+                               cell_info1));
+    }
+
+    for (IntegralType type : _a->integral_types())
+    {
+      const auto [stride, num_cells] = entity_layout(type);
+      const int num_kernels = type == IntegralType::cell ? num_cell_types : 1;
+      for (int i : _a->integral_ids(type))
+      {
+        for (int k = 0; k < num_kernels; ++k)
+        {
+          entity_data& data = _entity_data[{type, i, k}];
+
+          // Split entities into entities that do and do not depend on
+          // ghost entries of the input vector
+          auto [boundary, interior] = partition_by_ghosts(
+              type, V1->dofmaps(k)->map(), map1->size_local(),
+              _a->domain_arg(type, 1, i, k));
+          data.boundary = std::move(boundary);
+          data.interior = std::move(interior);
+
+          // Merge the dofs of the cells attached to each entity
+          for (int r = 0; r < 2; ++r)
+          {
+            std::shared_ptr<const DofMap> dofmap
+                = _a->function_spaces().at(r)->dofmaps(k);
+            std::span<const std::int32_t> entities
+                = _a->domain_arg(type, r, i, k);
+            std::vector<std::int32_t>& dofs = r == 0 ? data.dofs0 : data.dofs1;
+            dofs.reserve(entities.size() / stride * num_cells
+                         * dofmap->map().extent(1));
+            for (std::size_t e = 0; e < entities.size(); e += stride)
+            {
+              for (std::size_t c = 0; c < num_cells; ++c)
+              {
+                std::ranges::copy(dofmap->cell_dofs(entities[e + 2 * c]),
+                                  std::back_inserter(dofs));
+              }
+            }
+          }
+
+          // Facet permutations relative to the cells attached to each
+          // facet
+          if (type != IntegralType::cell and _a->needs_facet_permutations())
+          {
+            mesh->topology_mutable()->create_entity_permutations();
+            const std::vector<std::uint8_t>& p
+                = topology->get_facet_permutations();
+            const int num_facets_per_cell = mesh::cell_num_entities(
+                topology->cell_type(), topology->dim() - 1);
+            std::span<const std::int32_t> facets = _a->domain(type, i, 0);
+            for (std::size_t f = 0; f < facets.size(); f += 2)
+            {
+              data.perms.push_back(
+                  p[facets[f] * num_facets_per_cell + facets[f + 1]]);
+            }
+          }
+        }
+      }
+    }
+
+    update_geometry();
+    update_coefficients();
+  }
+
+  /// @brief Re-pack the constants and coefficients of the form.
+  ///
+  /// Must be called if the values of any of the constants or
+  /// coefficients of the form have changed.
+  void update_coefficients()
+  {
+    _constants = pack_constants(*_a);
+    _coefficients = allocate_coefficient_storage(*_a);
+    pack_coefficients(*_a, _coefficients);
+  }
+
+  /// @brief Re-pack the geometry of the integration entities.
+  ///
+  /// Must be called if the mesh geometry has changed, e.g. for moving
+  /// meshes.
+  void update_geometry()
+  {
+    std::shared_ptr<const mesh::Mesh<U>> mesh = _a->mesh();
+    std::span<const U> x = mesh->geometry().x();
+    for (auto& [key, data] : _entity_data)
+    {
+      auto [type, i, cell_type_idx] = key;
+      const auto [stride, num_cells] = entity_layout(type);
+      md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> x_dofmap
+          = mesh->geometry().dofmap(cell_type_idx);
+      std::span entities = _a->domain(type, i, cell_type_idx);
+      const std::size_t num_dofs_g = x_dofmap.extent(1);
+      data.coordinate_dofs.resize(entities.size() / stride * num_cells
+                                  * num_dofs_g * 3);
+      auto cdofs = data.coordinate_dofs.begin();
+      for (std::size_t e = 0; e < entities.size(); e += stride)
+      {
+        for (std::size_t c = 0; c < num_cells; ++c)
+        {
+          for (std::size_t j = 0; j < num_dofs_g; ++j)
+          {
+            cdofs = std::copy_n(
+                std::next(x.begin(), 3 * x_dofmap(entities[e + 2 * c], j)),
+                3, cdofs);
+          }
+        }
+      }
+    }
+  }
+
+  /// @brief Compute `y = A x`.
+  ///
+  /// The ghost entries of `x` are updated by the operator. On return
+  /// the owned and ghost entries of `y` are set.
+  ///
+  /// @note Collective MPI operation.
+  ///
+  /// @param[in,out] x Input vector, in the trial function space.
+  /// @param[out] y Output vector, in the test function space.
+  void apply(la::Vector<T>& x, la::Vector<T>& y) const
+  {
+    std::ranges::fill(y.mutable_array(), 0);
+
+    // Start update of ghost values of x and compute contributions from
+    // entities that do not depend on ghost values
+    x.scatter_fwd_begin();
+    for (auto& [key, data] : _entity_data)
+      apply_entities(key, data, data.interior, x.array(), y.mutable_array());
+
+    // Finish update of ghost values and compute the remaining entities
+    x.scatter_fwd_end();
+    for (auto& [key, data] : _entity_data)
+      apply_entities(key, data, data.boundary, x.array(), y.mutable_array());
+
+    y.scatter_rev(std::plus<T>());
+
+    // Set diagonal for boundary condition rows
+    if (!_bc0.empty()
+        and _a->function_spaces().at(0) == _a->function_spaces().at(1))
+    {
+      std::span<const T> _x = x.array();
+      std::span<T> _y = y.mutable_array();
+      const std::size_t num_owned = y.bs() * y.index_map()->size_local();
+      for (std::size_t i = 0; i < num_owned; ++i)
+      {
+        if (_bc0[i])
+          _y[i] = _diagonal * _x[i];
+      }
+    }
+
+    y.scatter_fwd();
+  }
+
+  /// @brief Compute the diagonal of the operator.
+  ///
+  /// The element matrices are tabulated as in apply(), but only their
+  /// diagonal entries are accumulated, so the diagonal is computed in
+  /// one pass over the entities without assembling a matrix. The
+  /// entries of boundary condition rows are set to the diagonal value
+  /// of the operator.
+  ///
+  /// @note Collective MPI operation.
+  /// @pre The test and trial function spaces are the same.
+  ///
+  /// @param[out] d Diagonal, in the test function space. On return the
+  /// owned and ghost entries are set.
+  void diagonal(la::Vector<T>& d) const
+  {
+    if (_a->function_spaces().at(0) != _a->function_spaces().at(1))
+    {
+      throw std::runtime_error(
+          "Diagonal requires the same test and trial function spaces.");
+    }
+
+    std::span<T> _d = d.mutable_array();
+    std::ranges::fill(_d, 0);
+    for (auto& [key, data] : _entity_data)
+    {
+      diagonal_entities(key, data, data.interior, _d);
+      diagonal_entities(key, data, data.boundary, _d);
+    }
+    d.scatter_rev(std::plus<T>());
+
+    // Set diagonal for boundary condition rows
+    const std::size_t num_owned = d.bs() * d.index_map()->size_local();
+    for (std::size_t i = 0; i < std::min(num_owned, _bc0.size()); ++i)
+    {
+      if (_bc0[i])
+        _d[i] = _diagonal;
+    }
+
+    d.scatter_fwd();
+  }
+
+  /// @brief The bilinear form.
+  std::shared_ptr<const Form<T, U>> form() const { return _a; }
+
+private:
+  // (integral type, integral id, cell type index)
+  using key_type = std::tuple<IntegralType, int, int>;
+
+  // Per integral data
+  struct entity_data
+  {
+    // Positions of entities (in the integral entity list) that do not
+    // depend on ghost entries of the input vector
+    std::vector<std::int32_t> interior;
+
+    // Positions of entities that depend on ghost entries of the input
+    // vector
+    std::vector<std::int32_t> boundary;
+
+    // Packed coordinate dofs, shape (num_entities, num_cells,
+    // num_dofs_g, 3), where num_cells is the number of cells attached
+    // to an entity
+    std::vector<U> coordinate_dofs;
+
+    // Merged test (0) and trial (1) dofs of the cells attached to each
+    // entity, shape (num_entities, num_cells * num_dofs)
+    std::vector<std::int32_t> dofs0, dofs1;
+
+    // Facet permutations relative to the cells attached to each facet,
+    // shape (num_entities, num_cells). Empty for cell integrals and if
+    // the form does not need facet permutations.
+    std::vector<std::uint8_t> perms;
+  };
+
+  // Number of entries per entity in an integration entity list, and
+  // number of cells attached to an entity
+  static std::array<std::size_t, 2> entity_layout(IntegralType type)
+  {
+    switch (type)
+    {
+    case IntegralType::cell:
+      return {1, 1};
+    case IntegralType::exterior_facet:
+      return {2, 1};
+    case IntegralType::interior_facet:
+      return {4, 2};
+    default:
+      throw std::runtime_error("Integral type not supported.");
+    }
+  }
+
+  // Create a function `f(p, Ae)` that tabulates the element matrix of
+  // the entity at position `p` in the entity list of the integral `key`
+  // into `Ae`, and applies the dof transformations. For interior facets
+  // the element matrix is a 2x2 block matrix, with the blocks
+  // coupling the dofs of the two cells.
+  auto tabulator(const key_type& key, const entity_data& data) const
+  {
+    auto [type, id, cell_type_idx] = key;
+    const auto [stride, num_cells] = entity_layout(type);
+    auto dofmap0 = _a->function_spaces().at(0)->dofmaps(cell_type_idx);
+    auto dofmap1 = _a->function_spaces().at(1)->dofmaps(cell_type_idx);
+    const int ndim0 = dofmap0->bs() * dofmap0->map().extent(1);
+    const int ndim1 = dofmap1->bs() * dofmap1->map().extent(1);
+    const int num_rows = num_cells * ndim0;
+    const int num_cols = num_cells * ndim1;
+
+    // The cell permutation information is stored in the precomputed
+    // transformations
+    const DofTransformation<T>& P0 = _transformations[cell_type_idx].first;
+    const DofTransformation<T>& P1T = _transformations[cell_type_idx].second;
+
+    auto kernel = _a->kernel(type, id, cell_type_idx);
+    assert(kernel);
+    std::span entities = _a->domain(type, id, cell_type_idx);
+    std::span entities0 = _a->domain_arg(type, 0, id, cell_type_idx);
+    std::span entities1 = _a->domain_arg(type, 1, id, cell_type_idx);
+    auto& [coeffs, cstride] = _coefficients.at({type, id});
+    const std::size_t num_entities = entities.size() / stride;
+    const std::size_t cdofs_size
+        = num_entities > 0 ? data.coordinate_dofs.size() / num_entities : 0;
+    const T* constants = _constants.data();
+    const U* cdofs = data.coordinate_dofs.data();
+    const std::uint8_t* perms = data.perms.data();
+    const bool has_perms = !data.perms.empty();
+    const T* c = coeffs.data();
+    const std::size_t coeff_size = num_cells * cstride;
+
+    return [=, &P0, &P1T](std::int32_t p, std::span<T> Ae)
+    {
+      std::array<std::int32_t, 2> local_facet = {0, 0};
+      std::array<std::uint8_t, 2> perm = {0, 0};
+      if (type != IntegralType::cell)
+      {
+        for (std::size_t k = 0; k < num_cells; ++k)
+        {
+          local_facet[k] = entities[p * stride + 2 * k + 1];
+          if (has_perms)
+            perm[k] = perms[p * num_cells + k];
+        }
+      }
+
+      std::span<const std::uint32_t> cell_info0, cell_info1;
+      std::ranges::fill(Ae, 0);
+      kernel(Ae.data(), c + p * coeff_size, constants,
+             cdofs + p * cdofs_size, local_facet.data(), perm.data(),
+             nullptr);
+
+      const std::int32_t cell0 = entities0[p * stride];
+      const std::int32_t cell1 = entities1[p * stride];
+      if (num_cells == 1)
+      {
+        P0(Ae, cell_info0, cell0, ndim1);
+        P1T(Ae, cell_info1, cell1, ndim0);
+      }
+      else
+      {
+        P0(Ae, cell_info0, cell0, num_cols);
+        P0(Ae.subspan(ndim0 * num_cols, ndim0 * num_cols), cell_info0,
+           entities0[p * stride + 2], num_cols);
+        P1T(Ae, cell_info1, cell1, num_rows);
+        for (int row = 0; row < num_rows; ++row)
+        {
+          P1T(Ae.subspan(row * num_cols + ndim1, ndim1), cell_info1,
+              entities1[p * stride + 2], 1);
+        }
+      }
+    };
+  }
+
+  // Compute the action of the integral `key` on `x` for the entities at
+  // `positions` in the integral entity list, and accumulate the result
+  // in `y`
+  void apply_entities(const key_type& key, const entity_data& data,
+                      std::span<const std::int32_t> positions,
+                      std::span<const T> x, std::span<T> y) const
+  {
+    if (positions.empty())
+      return;
+
+    auto [type, id, cell_type_idx] = key;
+    const std::size_t num_cells = entity_layout(type)[1];
+    auto dofmap0 = _a->function_spaces().at(0)->dofmaps(cell_type_idx);
+    auto dofmap1 = _a->function_spaces().at(1)->dofmaps(cell_type_idx);
+    const int bs0 = dofmap0->bs();
+    const int bs1 = dofmap1->bs();
+    const int num_dofs0 = num_cells * dofmap0->map().extent(1);
+    const int num_dofs1 = num_cells * dofmap1->map().extent(1);
+    const int num_rows = bs0 * num_dofs0;
+    const int num_cols = bs1 * num_dofs1;
+
+    auto tabulate = tabulator(key, data);
+    std::vector<T> Ae(num_rows * num_cols), xe(num_cols), ye(num_rows);
+    for (std::int32_t p : positions)
+    {
+      // Tabulate element matrix
+      tabulate(p, Ae);
+
+      // Gather x, with zero for boundary condition columns
+      std::span dofs0(data.dofs0.data() + p * num_dofs0, num_dofs0);
+      std::span dofs1(data.dofs1.data() + p * num_dofs1, num_dofs1);
+      for (int j = 0; j < num_dofs1; ++j)
+      {
+        for (int k = 0; k < bs1; ++k)
+        {
+          const std::int32_t dof = bs1 * dofs1[j] + k;
+          xe[bs1 * j + k] = (!_bc1.empty() and _bc1[dof]) ? 0 : x[dof];
+        }
+      }
+
+      // Compute element action and add to y, skipping boundary
+      // condition rows
+      for (int i = 0; i < num_rows; ++i)
+      {
+        ye[i] = 0;
+        for (int j = 0; j < num_cols; ++j)
+          ye[i] += Ae[i * num_cols + j] * xe[j];
+      }
+      for (int i = 0; i < num_dofs0; ++i)
+      {
+        for (int k = 0; k < bs0; ++k)
+        {
+          const std::int32_t dof = bs0 * dofs0[i] + k;
+          if (_bc0.empty() or !_bc0[dof])
+            y[dof] += ye[bs0 * i + k];
+        }
+      }
+    }
+  }
+
+  // Accumulate the diagonal entries of the element matrices of the
+  // integral `key` for the entities at `positions` in the integral
+  // entity list in `d`. The test and trial spaces are the same.
+  void diagonal_entities(const key_type& key, const entity_data& data,
+                         std::span<const std::int32_t> positions,
+                         std::span<T> d) const
+  {
+    if (positions.empty())
+      return;
+
+    auto [type, id, cell_type_idx] = key;
+    const std::size_t num_cells = entity_layout(type)[1];
+    auto dofmap = _a->function_spaces().at(0)->dofmaps(cell_type_idx);
+    const int bs = dofmap->bs();
+    const int num_dofs = num_cells * dofmap->map().extent(1);
+    const int ndim = bs * num_dofs;
+
+    auto tabulate = tabulator(key, data);
+    std::vector<T> Ae(ndim * ndim);
+    for (std::int32_t p : positions)
+    {
+      tabulate(p, Ae);
+      std::span dofs(data.dofs0.data() + p * num_dofs, num_dofs);
+      for (int i = 0; i < num_dofs; ++i)
+      {
+        for (int k = 0; k < bs; ++k)
+        {
+          const std::int32_t dof = bs * dofs[i] + k;
+          if (_bc0.empty() or !_bc0[dof])
+            d[dof] += Ae[(bs * i + k) * (ndim + 1)];
+        }
+      }
+    }
+  }
+
+  // Bilinear form
+  std::shared_ptr<const Form<T, U>> _a;
+
+  // Packed constants
+  std::vector<T> _constants;
+
+  // Packed coefficients
+  std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>
+      _coefficients;
+
+  // (integral type, integral id, cell type index) -> entity data
+  std::map<key_type, entity_data> _entity_data;
+
+  // DOF transformations (P0, P1T) of each cell type
+  std::vector<std::pair<DofTransformation<T>, DofTransformation<T>>>
+      _transformations;
+
+  // Boundary condition markers for rows (0) and columns (1)
+  std::vector<std::int8_t> _bc0, _bc1;
+
+  // Diagonal value for boundary condition rows
+  T _diagonal;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,197 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Cache of the sparsity patterns of bilinear forms.
+///
+/// The sparsity pattern of a form depends only on the dofmaps of its
+/// test and trial spaces and on its integration domains. Forms that
+/// share these, e.g. a mass and a stiffness matrix on the same spaces,
+/// or the same operator with different coefficients, then share one
+/// finalised pattern, which is built the first time that it is
+/// requested. Matrices created by the cache also share the column
+/// indices and row pointers of a prototype matrix (see
+/// la::MatrixCSR::share_structure).
+///
+/// @note Dofmaps are compared by identity and integration domains by
+/// value. Entries for dofmaps that have been destroyed are removed
+/// when the cache is next used.
+/// @note This class is not thread-safe.
+class SparsityPatternCache
+{
+public:
+  /// @brief Create an empty cache.
+  /// @param[in] num_threads Number of threads used to build the
+  /// patterns.
+  explicit SparsityPatternCache(int num_threads = 1)
+      : _num_threads(num_threads)
+  {
+  }
+
+  /// @brief Get the finalised sparsity pattern of a bilinear form.
+  /// @param[in] a Bilinear form.
+  /// @return Sparsity pattern of `a`.
+  template <dolfinx::scalar T, std::floating_point U>
+  std::shared_ptr<const la::SparsityPattern> pattern(const Form<T, U>& a)
+  {
+    return entry(a).pattern;
+  }
+
+  /// @brief Create a matrix, with zero entries, for a bilinear form.
+  ///
+  /// The matrix shares its non-zero structure with the other matrices
+  /// that the cache creates for forms with the same pattern and block
+  /// mode.
+  ///
+  /// @note This function is collective.
+  ///
+  /// @param[in] a Bilinear form.
+  /// @param[in] mode Block mode of the matrix, see la::MatrixCSR.
+  /// @return Matrix with the sparsity pattern of `a`.
+  template <dolfinx::scalar T, std::floating_point U>
+  la::MatrixCSR<T> create_matrix(const Form<T, U>& a,
+                                 la::BlockMode mode = la::BlockMode::compact)
+  {
+    Entry& e = entry(a);
+    std::shared_ptr<prototype_t>& A
+        = e.prototypes[mode == la::BlockMode::compact ? 0 : 1];
+    if (!A)
+    {
+      // Keep only the structure of the prototype
+      A = std::make_shared<prototype_t>(*e.pattern, mode);
+      A->values().clear();
+      A->values().shrink_to_fit();
+    }
+
+    return la::MatrixCSR<T>::share_structure(*A);
+  }
+
+  /// @brief Remove all cached patterns.
+  void clear() { _entries.clear(); }
+
+  /// @brief Number of cached patterns.
+  std::size_t size() const { return _entries.size(); }
+
+private:
+  // Matrix type that holds the shared structure
+  using prototype_t = la::MatrixCSR<double>;
+
+  // Integration domain of a form, as used to build the pattern
+  struct Domain
+  {
+    IntegralType type;
+    int id;
+    int kernel_idx;
+    std::array<std::vector<std::int32_t>, 2> entities;
+    bool operator==(const Domain&) const = default;
+  };
+
+  // Cached pattern and the data that it was computed from
+  struct Entry
+  {
+    std::vector<std::weak_ptr<const DofMap>> dofmaps;
+    std::vector<Domain> domains;
+    std::shared_ptr<const la::SparsityPattern> pattern;
+    std::array<std::shared_ptr<prototype_t>, 2> prototypes;
+  };
+
+  // Find or create the entry of a form
+  template <dolfinx::scalar T, std::floating_point U>
+  Entry& entry(const Form<T, U>& a)
+  {
+    if (a.rank() != 2)
+    {
+      throw std::runtime_error(
+          "Cannot create sparsity pattern. Form is not a bilinear.");
+    }
+
+    // Dofmaps of the test and trial spaces, for each cell type
+    std::shared_ptr mesh = a.mesh();
+    assert(mesh);
+    const int num_cell_types = mesh->topology()->cell_types().size();
+    std::vector<std::shared_ptr<const DofMap>> dofmaps;
+    for (int i = 0; i < num_cell_types; ++i)
+      for (int j = 0; j < 2; ++j)
+        dofmaps.push_back(a.function_spaces().at(j)->dofmaps(i));
+
+    // Integration domains, see fem::build_sparsity_pattern
+    std::vector<Domain> domains;
+    const std::set<IntegralType> types = a.integral_types();
+    for (int i = 0; i < num_cell_types; ++i)
+    {
+      for (IntegralType type : types)
+      {
+        int kernel_idx = type == IntegralType::cell ? i : 0;
+        for (int id : a.integral_ids(type))
+        {
+          auto d0 = a.domain_arg(type, 0, id, kernel_idx);
+          auto d1 = a.domain_arg(type, 1, id, kernel_idx);
+          domains.push_back({type,
+                             id,
+                             kernel_idx,
+                             {std::vector(d0.begin(), d0.end()),
+                              std::vector(d1.begin(), d1.end())}});
+        }
+      }
+    }
+
+    // Drop entries with destroyed dofmaps
+    std::erase_if(_entries,
+                  [](const Entry& e)
+                  {
+                    return std::ranges::any_of(e.dofmaps, [](auto& d)
+                                               { return d.expired(); });
+                  });
+
+    auto it = std::ranges::find_if(
+        _entries,
+        [&](const Entry& e)
+        {
+          return std::ranges::equal(e.dofmaps, dofmaps,
+                                    [](auto& d0, auto& d1)
+                                    { return d0.lock() == d1; })
+                 and e.domains == domains;
+        });
+    if (it != _entries.end())
+      return *it;
+
+    la::SparsityPattern p = create_sparsity_pattern(a, _num_threads);
+    p.finalize();
+    Entry& e = _entries.emplace_back();
+    e.dofmaps.assign(dofmaps.begin(), dofmaps.end());
+    e.domains = std::move(domains);
+    e.pattern = std::make_shared<const la::SparsityPattern>(std::move(p));
+    return e;
+  }
+
+  // Number of threads
+  int _num_threads;
+
+  // Cached patterns
+  std::vector<Entry> _entries;
+};
+} // namespace dolfinx::fem
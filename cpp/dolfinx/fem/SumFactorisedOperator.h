@@ -0,0 +1,617 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "CoordinateElement.h"
+#include "DirichletBC.h"
+#include "DofMap.h"
+#include "FiniteElement.h"
+#include "FunctionSpace.h"
+#include <algorithm>
+#include <array>
+#include <basix/finite-element.h>
+#include <basix/mdspan.hpp>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <functional>
+#include <memory>
+#include <numbers>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+namespace impl
+{
+/// @brief Gauss-Legendre quadrature on the interval [0, 1].
+/// @param[in] m Number of points.
+/// @return Points (in ascending order) and weights.
+template <std::floating_point U>
+std::array<std::vector<U>, 2> gauss_legendre(int m)
+{
+  std::vector<U> points(m), weights(m);
+  for (int i = 0; i < m; ++i)
+  {
+    // Newton iteration for the i-th root of the Legendre polynomial of
+    // degree m, in descending order
+    double x = std::cos(std::numbers::pi * (i + 0.75) / (m + 0.5));
+    double dp = 1;
+    for (int it = 0; it < 100; ++it)
+    {
+      double p0 = 1, p1 = x;
+      for (int k = 2; k <= m; ++k)
+      {
+        const double p2 = ((2 * k - 1) * x * p1 - (k - 1) * p0) / k;
+        p0 = p1;
+        p1 = p2;
+      }
+      dp = m * (x * p1 - p0) / (x * x - 1);
+      const double dx = p1 / dp;
+      x -= dx;
+      if (std::abs(dx) < 1e-15)
+        break;
+    }
+    points[i] = (1 - x) / 2;
+    weights[i] = 1 / ((1 - x * x) * dp * dp);
+  }
+
+  return {std::move(points), std::move(weights)};
+}
+
+/// @brief Contract a tensor along one axis with a matrix.
+///
+/// Computes `out(..., i, ...) = sum_j A(i, j) in(..., j, ...)`, where
+/// `i` and `j` are the indices of axis `axis`, or with `A^T` if
+/// `transpose` is true. Tensors are stored with the first axis
+/// fastest.
+///
+/// @param[in] A Matrix (`shape=(rows, cols)`, row-major).
+/// @param[in] rows Number of rows of `A`.
+/// @param[in] cols Number of columns of `A`.
+/// @param[in] transpose Contract with the transpose of `A`.
+/// @param[in] axis Axis to contract.
+/// @param[in] shape Shape of `in`. On return the size of axis `axis`
+/// is the size of the axis after the contraction.
+/// @param[in] in Input tensor.
+/// @param[out] out Output tensor.
+template <typename T, typename U>
+void contract(std::span<const U> A, std::size_t rows, std::size_t cols,
+              bool transpose, int axis, std::array<std::size_t, 3>& shape,
+              std::span<const T> in, std::span<T> out)
+{
+  const std::size_t n_in = shape[axis];
+  const std::size_t n_out = transpose ? cols : rows;
+  assert(n_in == (transpose ? rows : cols));
+  std::size_t pre = 1, post = 1;
+  for (int a = 0; a < axis; ++a)
+    pre *= shape[a];
+  for (int a = axis + 1; a < 3; ++a)
+    post *= shape[a];
+
+  for (std::size_t k = 0; k < post; ++k)
+  {
+    for (std::size_t i = 0; i < n_out; ++i)
+    {
+      T* o = out.data() + (k * n_out + i) * pre;
+      std::fill_n(o, pre, T(0));
+      for (std::size_t j = 0; j < n_in; ++j)
+      {
+        const U a = transpose ? A[j * cols + i] : A[i * cols + j];
+        const T* x = in.data() + (k * n_in + j) * pre;
+        for (std::size_t l = 0; l < pre; ++l)
+          o[l] += a * x[l];
+      }
+    }
+  }
+
+  shape[axis] = n_out;
+}
+} // namespace impl
+
+/// @brief Matrix-free action of mass and stiffness operators for
+/// Lagrange elements on quadrilateral and hexahedral meshes, using sum
+/// factorisation.
+///
+/// Computes `y = A x`, where `A` is the matrix of the bilinear form
+/// \f[ a(u, v) = \int_{\Omega} \alpha u v + \beta \nabla u \cdot
+/// \nabla v \, {\rm d}x, \f]
+/// with constant \f$\alpha\f$ and \f$\beta\f$. The tensor-product
+/// structure of the element is used to evaluate the function and its
+/// gradient at the quadrature points, and to integrate against the
+/// test functions, one direction at a time. For an element of degree
+/// \f$p\f$ in three dimensions this costs \f$O(p^4)\f$ operations per
+/// cell rather than the \f$O(p^6)\f$ of applying an element matrix.
+///
+/// The geometric factors are computed at the quadrature points of each
+/// cell when the operator is created, for any (also non-affine)
+/// coordinate element. As for MatrixFreeOperator, the forward scatter
+/// of the ghost entries of `x` is overlapped with the computation on
+/// cells that do not depend on ghost entries.
+///
+/// @note The element must be a scalar Lagrange element, whose basis
+/// functions are products of one-dimensional Lagrange basis
+/// functions. This is checked when the operator is created.
+///
+/// @tparam T Scalar type.
+/// @tparam U Geometry type.
+template <dolfinx::scalar T, std::floating_point U = scalar_value_t<T>>
+class SumFactorisedOperator
+{
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// Geometry type
+  using geometry_type = U;
+
+  /// @brief Create a sum factorised operator.
+  /// @param[in] V Function space (test and trial).
+  /// @param[in] alpha Coefficient \f$\alpha\f$ of the mass term.
+  /// @param[in] beta Coefficient \f$\beta\f$ of the stiffness term.
+  /// @param[in] bcs Boundary conditions to apply. For boundary
+  /// condition dofs the row and column are zeroed, as in
+  /// fem::assemble_matrix.
+  /// @param[in] diagonal Value of the diagonal entry of boundary
+  /// condition rows.
+  /// @param[in] num_points Number of (Gauss-Legendre) quadrature points
+  /// in each direction. If negative, the degree of the element plus
+  /// one is used, which integrates the mass term exactly on affine
+  /// cells.
+  SumFactorisedOperator(
+      std::shared_ptr<const FunctionSpace<U>> V, T alpha, T beta,
+      const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs
+      = {},
+      T diagonal = 1, int num_points = -1)
+      : _V(V), _alpha(alpha), _beta(beta), _diagonal(diagonal)
+  {
+    assert(_V);
+    auto mesh = _V->mesh();
+    assert(mesh);
+    const mesh::CellType cell_type = mesh->topology()->cell_type();
+    if (cell_type != mesh::CellType::quadrilateral
+        and cell_type != mesh::CellType::hexahedron)
+    {
+      throw std::runtime_error("Sum factorisation requires a quadrilateral "
+                               "or hexahedral mesh.");
+    }
+
+    auto element = _V->element();
+    assert(element);
+    if (element->is_mixed() or element->block_size() != 1
+        or element->basix_element().family() != basix::element::family::P
+        or element->needs_dof_transformations())
+    {
+      throw std::runtime_error(
+          "Sum factorisation requires a scalar Lagrange element.");
+    }
+
+    _tdim = mesh::cell_dim(cell_type);
+    _num_dofs = element->basix_element().degree() + 1;
+    _num_points = num_points < 0 ? _num_dofs : num_points;
+    create_basis(*element);
+
+    // Boundary condition markers
+    auto map = _V->dofmap()->index_map;
+    const int bs = _V->dofmap()->index_map_bs();
+    for (auto& bc : bcs)
+    {
+      assert(bc.get().function_space());
+      if (_V->contains(*bc.get().function_space()))
+      {
+        _bc.resize(bs * (map->size_local() + map->num_ghosts()), false);
+        bc.get().mark_dofs(_bc);
+      }
+    }
+
+    // Split owned cells into cells that do and do not depend on ghost
+    // entries of the input vector
+    const std::int32_t num_cells
+        = mesh->topology()->index_map(_tdim)->size_local();
+    const std::int32_t size_local = bs * map->size_local();
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      std::span<const std::int32_t> dofs = _V->dofmap()->cell_dofs(c);
+      if (std::ranges::any_of(dofs, [&](auto d) { return d >= size_local; }))
+        _boundary.push_back(c);
+      else
+        _interior.push_back(c);
+    }
+
+    update_geometry();
+  }
+
+  /// @brief Re-compute the geometric factors at the quadrature points.
+  ///
+  /// Must be called if the mesh geometry has changed, e.g. for moving
+  /// meshes.
+  void update_geometry()
+  {
+    auto mesh = _V->mesh();
+    const CoordinateElement<U>& cmap = mesh->geometry().cmap();
+    auto x_dofmap = mesh->geometry().dofmap();
+    std::span<const U> x_g = mesh->geometry().x();
+    const std::size_t gdim = mesh->geometry().dim();
+    const std::size_t tdim = _tdim;
+    const std::size_t num_dofs_g = cmap.dim();
+    const std::size_t nq = num_quadrature_points();
+
+    // Quadrature points and weights, first direction fastest
+    auto [q1, w1] = impl::gauss_legendre<U>(_num_points);
+    std::vector<U> X(nq * tdim), weights(nq, 1);
+    for (std::size_t q = 0; q < nq; ++q)
+    {
+      for (std::size_t d = 0, r = q; d < tdim; ++d, r /= _num_points)
+      {
+        X[q * tdim + d] = q1[r % _num_points];
+        weights[q] *= w1[r % _num_points];
+      }
+    }
+
+    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, nq);
+    std::vector<U> phi_b(std::reduce(phi_shape.begin(), phi_shape.end(), 1,
+                                     std::multiplies{}));
+    md::mdspan<const U, md::dextents<std::size_t, 4>> phi(phi_b.data(),
+                                                          phi_shape);
+    cmap.tabulate(1, X, {nq, tdim}, phi_b);
+
+    // Per quadrature point: |det J| w and |det J| w K K^T
+    const std::size_t num_cells
+        = mesh->topology()->index_map(tdim)->size_local();
+    const std::size_t stride = 1 + tdim * tdim;
+    _geometry.resize(num_cells * nq * stride);
+    std::vector<U> coord_dofs_b(num_dofs_g * gdim);
+    md::mdspan<U, md::dextents<std::size_t, 2>> coord_dofs(
+        coord_dofs_b.data(), num_dofs_g, gdim);
+    std::vector<U> J_b(gdim * tdim), K_b(tdim * gdim), scratch(2 * gdim * tdim);
+    md::mdspan<U, md::dextents<std::size_t, 2>> J(J_b.data(), gdim, tdim);
+    md::mdspan<U, md::dextents<std::size_t, 2>> K(K_b.data(), tdim, gdim);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      for (std::size_t i = 0; i < num_dofs_g; ++i)
+        for (std::size_t j = 0; j < gdim; ++j)
+          coord_dofs(i, j) = x_g[3 * x_dofmap(c, i) + j];
+
+      for (std::size_t q = 0; q < nq; ++q)
+      {
+        auto dphi = md::submdspan(phi, std::pair(1, tdim + 1), q,
+                                  md::full_extent, 0);
+        std::ranges::fill(J_b, 0);
+        CoordinateElement<U>::compute_jacobian(dphi, coord_dofs, J);
+        CoordinateElement<U>::compute_jacobian_inverse(J, K);
+        const U detJ = std::abs(
+            CoordinateElement<U>::compute_jacobian_determinant(J, scratch));
+        U* g = _geometry.data() + (c * nq + q) * stride;
+        g[0] = detJ * weights[q];
+        for (std::size_t i = 0; i < tdim; ++i)
+        {
+          for (std::size_t j = 0; j < tdim; ++j)
+          {
+            U Gij = 0;
+            for (std::size_t k = 0; k < gdim; ++k)
+              Gij += K(i, k) * K(j, k);
+            g[1 + i * tdim + j] = g[0] * Gij;
+          }
+        }
+      }
+    }
+  }
+
+  /// @brief Compute `y = A x`.
+  ///
+  /// The ghost entries of `x` are updated by the operator. On return
+  /// the owned and ghost entries of `y` are set.
+  ///
+  /// @note Collective MPI operation.
+  ///
+  /// @param[in,out] x Input vector.
+  /// @param[out] y Output vector.
+  void apply(la::Vector<T>& x, la::Vector<T>& y) const
+  {
+    std::ranges::fill(y.mutable_array(), 0);
+
+    // Start update of ghost values of x and compute contributions from
+    // cells that do not depend on ghost values
+    x.scatter_fwd_begin();
+    apply_cells(_interior, x.array(), y.mutable_array());
+
+    // Finish update of ghost values and compute the remaining cells
+    x.scatter_fwd_end();
+    apply_cells(_boundary, x.array(), y.mutable_array());
+
+    y.scatter_rev(std::plus<T>());
+
+    // Set diagonal for boundary condition rows
+    if (!_bc.empty())
+    {
+      std::span<const T> _x = x.array();
+      std::span<T> _y = y.mutable_array();
+      const std::size_t num_owned = y.bs() * y.index_map()->size_local();
+      for (std::size_t i = 0; i < num_owned; ++i)
+      {
+        if (_bc[i])
+          _y[i] = _diagonal * _x[i];
+      }
+    }
+
+    y.scatter_fwd();
+  }
+
+  /// @brief The function space.
+  std::shared_ptr<const FunctionSpace<U>> function_space() const
+  {
+    return _V;
+  }
+
+  /// @brief Number of quadrature points per cell.
+  std::size_t num_quadrature_points() const
+  {
+    std::size_t nq = 1;
+    for (int d = 0; d < _tdim; ++d)
+      nq *= _num_points;
+    return nq;
+  }
+
+private:
+  // Compute the one-dimensional basis functions and their derivatives
+  // at the quadrature points, and the tensor-product numbering of the
+  // element degrees-of-freedom
+  void create_basis(const FiniteElement<U>& element)
+  {
+    const std::size_t tdim = _tdim;
+    const std::size_t n = _num_dofs;
+    const std::size_t m = _num_points;
+    const std::size_t num_dofs = element.space_dimension();
+    std::size_t num_tp_dofs = 1;
+    for (std::size_t d = 0; d < tdim; ++d)
+      num_tp_dofs *= n;
+    if (num_dofs != num_tp_dofs)
+    {
+      throw std::runtime_error(
+          "Element does not have a tensor-product structure.");
+    }
+
+    // One-dimensional nodes, from the nodes of the element in the
+    // first direction
+    auto [X, Xshape] = element.interpolation_points();
+    constexpr U tol = 1e-10;
+    std::vector<U> nodes;
+    for (std::size_t i = 0; i < Xshape[0]; ++i)
+      nodes.push_back(X[i * tdim]);
+    std::ranges::sort(nodes);
+    auto [last, end] = std::ranges::unique(
+        nodes, [](U a, U b) { return std::abs(a - b) < tol; });
+    nodes.erase(last, end);
+    if (nodes.size() != n)
+    {
+      throw std::runtime_error(
+          "Element does not have a tensor-product structure.");
+    }
+
+    // Element DOF of each tensor-product index, first direction
+    // fastest
+    _tp_dofs.assign(num_dofs, -1);
+    for (std::size_t i = 0; i < num_dofs; ++i)
+    {
+      std::size_t idx = 0;
+      for (std::size_t d = tdim; d-- > 0;)
+      {
+        auto it = std::ranges::find_if(nodes, [&](U x)
+                                       { return std::abs(x - X[i * tdim + d])
+                                                < tol; });
+        idx = idx * n + std::distance(nodes.begin(), it);
+      }
+      if (idx >= num_dofs or _tp_dofs[idx] >= 0)
+      {
+        throw std::runtime_error(
+            "Element does not have a tensor-product structure.");
+      }
+      _tp_dofs[idx] = i;
+    }
+
+    // One-dimensional basis functions and derivatives at the quadrature
+    // points, from the element basis functions of the DOFs on the line
+    // through the first node in the first direction
+    auto [q1, w1] = impl::gauss_legendre<U>(m);
+    std::vector<U> Xq(m * tdim, nodes[0]);
+    for (std::size_t q = 0; q < m; ++q)
+      Xq[q * tdim] = q1[q];
+    auto [phi_b, phi_shape] = element.tabulate(Xq, {m, tdim}, 1);
+    md::mdspan<const U, md::dextents<std::size_t, 4>> phi(phi_b.data(),
+                                                          phi_shape);
+    _B.resize(m * n);
+    _D.resize(m * n);
+    for (std::size_t q = 0; q < m; ++q)
+    {
+      for (std::size_t a = 0; a < n; ++a)
+      {
+        _B[q * n + a] = phi(0, q, _tp_dofs[a], 0);
+        _D[q * n + a] = phi(1, q, _tp_dofs[a], 0);
+      }
+    }
+
+    // Check that the basis functions are products of the
+    // one-dimensional basis functions at the quadrature points
+    const std::size_t nq = num_quadrature_points();
+    std::vector<U> Xtp(nq * tdim);
+    for (std::size_t q = 0; q < nq; ++q)
+      for (std::size_t d = 0, r = q; d < tdim; ++d, r /= m)
+        Xtp[q * tdim + d] = q1[r % m];
+    auto [psi_b, psi_shape] = element.tabulate(Xtp, {nq, tdim}, 0);
+    for (std::size_t q = 0; q < nq; ++q)
+    {
+      for (std::size_t i = 0; i < num_dofs; ++i)
+      {
+        U v = 1;
+        for (std::size_t d = 0, r = q, s = i; d < tdim;
+             ++d, r /= m, s /= n)
+        {
+          v *= _B[(r % m) * n + s % n];
+        }
+        if (std::abs(v - psi_b[q * num_dofs + _tp_dofs[i]]) > 1e3 * tol)
+        {
+          throw std::runtime_error(
+              "Element does not have a tensor-product structure.");
+        }
+      }
+    }
+  }
+
+  // Compute the action of the operator on cells, and accumulate the
+  // result in y
+  void apply_cells(std::span<const std::int32_t> cells, std::span<const T> x,
+                   std::span<T> y) const
+  {
+    if (cells.empty())
+      return;
+
+    const int tdim = _tdim;
+    const std::size_t n = _num_dofs;
+    const std::size_t m = _num_points;
+    const std::size_t nq = num_quadrature_points();
+    const std::size_t stride = 1 + tdim * tdim;
+    const std::size_t num_dofs = _tp_dofs.size();
+    const std::size_t size = std::max(num_dofs, nq) * std::max(n, m);
+    std::vector<T> xe(num_dofs), ye(num_dofs), w0(size), w1(size);
+    std::vector<T> uq(nq), gq(tdim * nq);
+
+    // Apply the one-dimensional matrices (the derivative matrix in
+    // direction `deriv`, or none if negative) in each direction
+    auto interpolate = [&](std::span<const T> in, std::span<T> out, int deriv)
+    {
+      std::array<std::size_t, 3> shape = {1, 1, 1};
+      for (int d = 0; d < tdim; ++d)
+        shape[d] = n;
+      std::span<const T> src = in;
+      for (int d = 0; d < tdim; ++d)
+      {
+        std::span<T> dst = d == tdim - 1 ? out : (d % 2 == 0 ? w0 : w1);
+        impl::contract<T, U>(d == deriv ? _D : _B, m, n, false, d, shape,
+                             src, dst);
+        src = dst;
+      }
+    };
+    auto integrate = [&](std::span<const T> in, std::span<T> out, int deriv)
+    {
+      std::array<std::size_t, 3> shape = {1, 1, 1};
+      for (int d = 0; d < tdim; ++d)
+        shape[d] = m;
+      std::span<const T> src = in;
+      for (int d = 0; d < tdim; ++d)
+      {
+        std::span<T> dst = d % 2 == 0 ? w0 : w1;
+        impl::contract<T, U>(d == deriv ? _D : _B, m, n, true, d, shape,
+                             src, dst);
+        src = dst;
+      }
+      for (std::size_t i = 0; i < out.size(); ++i)
+        out[i] += src[i];
+    };
+
+    for (std::int32_t c : cells)
+    {
+      // Gather x in the tensor-product numbering, with zero for
+      // boundary condition columns
+      std::span<const std::int32_t> dofs = _V->dofmap()->cell_dofs(c);
+      for (std::size_t i = 0; i < num_dofs; ++i)
+      {
+        const std::int32_t dof = dofs[_tp_dofs[i]];
+        xe[i] = (!_bc.empty() and _bc[dof]) ? 0 : x[dof];
+      }
+
+      // Values and reference gradients at quadrature points
+      std::ranges::fill(ye, 0);
+      if (_alpha != T(0))
+        interpolate(xe, uq, -1);
+      if (_beta != T(0))
+      {
+        for (int d = 0; d < tdim; ++d)
+          interpolate(xe, std::span(gq).subspan(d * nq, nq), d);
+      }
+
+      // Apply the geometric factors
+      const U* g = _geometry.data() + c * nq * stride;
+      for (std::size_t q = 0; q < nq; ++q)
+      {
+        const U* gq_c = g + q * stride;
+        if (_alpha != T(0))
+          uq[q] *= _alpha * gq_c[0];
+        if (_beta != T(0))
+        {
+          std::array<T, 3> f = {0, 0, 0};
+          for (int i = 0; i < tdim; ++i)
+            for (int j = 0; j < tdim; ++j)
+              f[i] += gq_c[1 + i * tdim + j] * gq[j * nq + q];
+          for (int i = 0; i < tdim; ++i)
+            gq[i * nq + q] = _beta * f[i];
+        }
+      }
+
+      // Integrate against test functions
+      if (_alpha != T(0))
+        integrate(uq, ye, -1);
+      if (_beta != T(0))
+      {
+        for (int d = 0; d < tdim; ++d)
+          integrate(std::span(gq).subspan(d * nq, nq), ye, d);
+      }
+
+      // Add to y, skipping boundary condition rows
+      for (std::size_t i = 0; i < num_dofs; ++i)
+      {
+        const std::int32_t dof = dofs[_tp_dofs[i]];
+        if (_bc.empty() or !_bc[dof])
+          y[dof] += ye[i];
+      }
+    }
+  }
+
+  // Function space
+  std::shared_ptr<const FunctionSpace<U>> _V;
+
+  // Coefficients of the mass and stiffness terms
+  T _alpha, _beta;
+
+  // Diagonal value for boundary condition rows
+  T _diagonal;
+
+  // Topological dimension
+  int _tdim;
+
+  // Number of one-dimensional DOFs and quadrature points
+  std::size_t _num_dofs, _num_points;
+
+  // One-dimensional basis functions and derivatives at the quadrature
+  // points (shape=(num_points, num_dofs))
+  std::vector<U> _B, _D;
+
+  // Element DOFs in tensor-product order
+  std::vector<std::int32_t> _tp_dofs;
+
+  // Geometric factors at the quadrature points of each owned cell
+  // (shape=(num_cells, num_quadrature_points, 1 + tdim * tdim))
+  std::vector<U> _geometry;
+
+  // Boundary condition markers
+  std::vector<std::int8_t> _bc;
+
+  // Owned cells that do not (interior) and do (boundary) depend on
+  // ghost entries of the input vector
+  std::vector<std::int32_t> _interior, _boundary;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,168 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Thread-safe cache of basis function tabulations of an
+/// element.
+///
+/// Tabulations are keyed by the number of derivatives and the points
+/// (compared exactly, after comparing a hash). The least recently used
+/// tabulations are evicted when the total number of stored values
+/// exceeds a bound, or the number of tabulations exceeds
+/// #max_entries. Tabulations that are larger than the bound are not
+/// cached.
+///
+/// The cache is intended for the small point sets that are tabulated
+/// repeatedly, e.g. interpolation points and quadrature points.
+///
+/// @tparam T Floating point type of the points and values.
+template <std::floating_point T>
+class TabulationCache
+{
+public:
+  /// Default bound of the number of stored values
+  static constexpr std::size_t default_max_size = 1 << 18;
+
+  /// Maximum number of stored tabulations
+  static constexpr std::size_t max_entries = 64;
+
+  /// @brief Create an empty cache.
+  /// @param[in] max_size Bound of the total number of stored values.
+  explicit TabulationCache(std::size_t max_size = default_max_size)
+      : _max_size(max_size)
+  {
+  }
+
+  /// @brief Tabulate, using a cached tabulation if there is one.
+  ///
+  /// @param[in] nd Number of derivatives.
+  /// @param[in] X Points (`shape=(num_points, tdim)`, row-major).
+  /// @param[in] shape Shape of `X`.
+  /// @param[out] values Tabulated values.
+  /// @param[in] f Function `f(values)` that tabulates the values if
+  /// they are not cached.
+  template <typename F>
+  void tabulate(int nd, std::span<const T> X, std::array<std::size_t, 2> shape,
+                std::span<T> values, F&& f)
+  {
+    const std::size_t hash = hash_key(nd, X);
+    {
+      std::scoped_lock lock(_mutex);
+      auto it = std::ranges::find_if(_entries, [&](const entry_t& e)
+                                     { return e.match(hash, nd, X, shape); });
+      if (it != _entries.end())
+      {
+        // Move to front (most recently used)
+        _entries.splice(_entries.begin(), _entries, it);
+        std::ranges::copy(it->values, values.begin());
+        return;
+      }
+    }
+
+    f(values);
+    std::scoped_lock lock(_mutex);
+    if (values.size() <= _max_size
+        and std::ranges::none_of(_entries, [&](const entry_t& e)
+                                 { return e.match(hash, nd, X, shape); }))
+    {
+      _entries.push_front({hash, nd, shape, std::vector<T>(X.begin(), X.end()),
+                           std::vector<T>(values.begin(), values.end())});
+      _size += values.size();
+      evict();
+    }
+  }
+
+  /// @brief Bound of the total number of stored values.
+  std::size_t max_size() const
+  {
+    std::scoped_lock lock(_mutex);
+    return _max_size;
+  }
+
+  /// @brief Set the bound of the total number of stored values,
+  /// evicting tabulations if required. A bound of zero disables the
+  /// cache.
+  void set_max_size(std::size_t max_size)
+  {
+    std::scoped_lock lock(_mutex);
+    _max_size = max_size;
+    evict();
+  }
+
+  /// @brief Total number of stored values.
+  std::size_t size() const
+  {
+    std::scoped_lock lock(_mutex);
+    return _size;
+  }
+
+  /// @brief Remove all cached tabulations.
+  void clear()
+  {
+    std::scoped_lock lock(_mutex);
+    _entries.clear();
+    _size = 0;
+  }
+
+private:
+  struct entry_t
+  {
+    std::size_t hash;
+    int nd;
+    std::array<std::size_t, 2> shape;
+    std::vector<T> X;
+    std::vector<T> values;
+
+    bool match(std::size_t h, int n, std::span<const T> x,
+               std::array<std::size_t, 2> s) const
+    {
+      return h == hash and n == nd and s == shape and std::ranges::equal(x, X);
+    }
+  };
+
+  static std::size_t hash_key(int nd, std::span<const T> X)
+  {
+    std::size_t h = std::hash<int>{}(nd);
+    for (T x : X)
+      h ^= std::hash<T>{}(x) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+  }
+
+  // Evict least recently used entries until the bounds are satisfied
+  void evict()
+  {
+    while (_size > _max_size or _entries.size() > max_entries)
+    {
+      _size -= _entries.back().values.size();
+      _entries.pop_back();
+    }
+  }
+
+  mutable std::mutex _mutex;
+
+  // Bound of the total number of stored values
+  std::size_t _max_size;
+
+  // Total number of stored values
+  std::size_t _size = 0;
+
+  // Cached tabulations, most recently used first
+  std::list<entry_t> _entries;
+};
+} // namespace dolfinx::fem
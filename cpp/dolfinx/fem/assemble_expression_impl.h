@@ -6,19 +6,26 @@
 
 #pragma once
 
-#include "Expression.h"
 #include "FunctionSpace.h"
 #include "traits.h"
 #include "utils.h"
 #include <algorithm>
 #include <basix/mdspan.hpp>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <memory>
+#include <optional>
 #include <vector>
 
+namespace dolfinx::fem
+{
+template <dolfinx::scalar T, std::floating_point U>
+class Expression;
+} // namespace dolfinx::fem
+
 namespace dolfinx::fem::impl
 {
 /// @brief Tabulate an Expression at points.
@@ -58,6 +65,8 @@ namespace dolfinx::fem::impl
 /// @param[in] P0 Degree-of-freedom transformation function. Applied when
 /// expressions includes an argument function that requires a
 /// transformation.
+/// @param[in] num_threads Number of threads to use. The entities are
+/// divided into contiguous ranges, one per thread.
 template <dolfinx::scalar T, std::floating_point U>
 void tabulate_expression(
     std::span<T> values, fem::FEkernel<T> auto fn,
@@ -68,49 +77,57 @@ void tabulate_expression(
     md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
     std::span<const T> constants, fem::MDSpan2 auto entities,
     std::span<const std::uint32_t> cell_info,
-    fem::DofTransformKernel<T> auto P0)
+    fem::DofTransformKernel<T> auto P0, int num_threads = 1)
 {
   static_assert(entities.rank() == 1 or entities.rank() == 2);
 
-  // Create data structures used in evaluation
-  std::vector<U> coord_dofs(3 * x_dofmap.extent(1));
+  const int size0 = Xshape[0] * value_size;
+  const std::size_t offset = size0 * num_argument_dofs;
+  const std::size_t num_entities = entities.extent(0);
+  num_threads = std::max(1, std::min<int>(num_threads, num_entities));
 
-  // Iterate over cells and 'assemble' into values
-  int size0 = Xshape[0] * value_size;
-  std::vector<T> values_local(size0 * num_argument_dofs, 0);
-  std::size_t offset = values_local.size();
-  for (std::size_t e = 0; e < entities.extent(0); ++e)
+  // Iterate over the entities [e0, e1) and 'assemble' into values
+  auto tabulate = [&](int thread)
   {
-    std::ranges::fill(values_local, 0);
-    if constexpr (entities.rank() == 1)
+    auto [e0, e1] = common::thread_range(thread, num_entities, num_threads);
+
+    // Create data structures used in evaluation
+    std::vector<U> coord_dofs(3 * x_dofmap.extent(1));
+    std::vector<T> values_local(offset, 0);
+    for (std::size_t e = e0; e < e1; ++e)
     {
-      std::int32_t entity = entities(e);
-      auto x_dofs = md::submdspan(x_dofmap, entity, md::full_extent);
-      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+      std::ranges::fill(values_local, 0);
+      if constexpr (entities.rank() == 1)
       {
-        std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                    std::next(coord_dofs.begin(), 3 * i));
+        std::int32_t entity = entities(e);
+        auto x_dofs = md::submdspan(x_dofmap, entity, md::full_extent);
+        for (std::size_t i = 0; i < x_dofs.size(); ++i)
+        {
+          std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
+                      std::next(coord_dofs.begin(), 3 * i));
+        }
+        fn(values_local.data(), &coeffs(e, 0), constants.data(),
+           coord_dofs.data(), nullptr, nullptr, nullptr);
       }
-      fn(values_local.data(), &coeffs(e, 0), constants.data(),
-         coord_dofs.data(), nullptr, nullptr, nullptr);
-    }
-    else
-    {
-      std::int32_t entity = entities(e, 0);
-      auto x_dofs = md::submdspan(x_dofmap, entity, md::full_extent);
-      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+      else
       {
-        std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                    std::next(coord_dofs.begin(), 3 * i));
+        std::int32_t entity = entities(e, 0);
+        auto x_dofs = md::submdspan(x_dofmap, entity, md::full_extent);
+        for (std::size_t i = 0; i < x_dofs.size(); ++i)
+        {
+          std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
+                      std::next(coord_dofs.begin(), 3 * i));
+        }
+        fn(values_local.data(), &coeffs(e, 0), constants.data(),
+           coord_dofs.data(), &entities(e, 1), nullptr, nullptr);
       }
-      fn(values_local.data(), &coeffs(e, 0), constants.data(),
-         coord_dofs.data(), &entities(e, 1), nullptr, nullptr);
+
+      P0(values_local, cell_info, e, size0);
+      std::ranges::copy(values_local, std::next(values.begin(), e * offset));
     }
+  };
 
-    P0(values_local, cell_info, e, size0);
-    for (std::size_t j = 0; j < values_local.size(); ++j)
-      values[e * offset + j] = values_local[j];
-  }
+  common::run_threads(num_threads, tabulate);
 }
 
 /// @brief Tabulate an Expression at points.
@@ -145,6 +162,7 @@ void tabulate_expression(
 /// Used to computed a 1-form expression, e.g. can be used to create a
 /// matrix that when applied to a degree-of-freedom vector gives the
 /// expression values at the evaluation points.
+/// @param[in] num_threads Number of threads to use.
 template <dolfinx::scalar T, std::floating_point U>
 void tabulate_expression(
     std::span<T> values, fem::FEkernel<T> auto fn,
@@ -154,7 +172,8 @@ void tabulate_expression(
     fem::MDSpan2 auto entities,
     std::optional<
         std::pair<std::reference_wrapper<const FiniteElement<U>>, std::size_t>>
-        element)
+        element,
+    int num_threads = 1)
 {
   std::function<void(std::span<T>, std::span<const std::uint32_t>, std::int32_t,
                      int)>
@@ -184,6 +203,26 @@ void tabulate_expression(
   tabulate_expression<T, U>(values, fn, Xshape, value_size, num_argument_dofs,
                             mesh.geometry().dofmap(), mesh.geometry().x(),
                             coeffs, constants, entities, cell_info,
-                            post_dof_transform);
+                            post_dof_transform, num_threads);
+}
+/// @brief Argument element and argument space dimension of an
+/// Expression.
+/// @param[in] e The Expression.
+/// @return The argument element and dimension of the argument space, or
+/// `std::nullopt` if the Expression has no argument function.
+template <dolfinx::scalar T, std::floating_point U>
+std::optional<
+    std::pair<std::reference_wrapper<const FiniteElement<U>>, std::size_t>>
+expression_argument_element(const Expression<T, U>& e)
+{
+  if (auto V = e.argument_space(); V)
+  {
+    std::size_t num_argument_dofs
+        = V->dofmap()->element_dof_layout().num_dofs() * V->dofmap()->bs();
+    assert(V->element());
+    return std::pair(std::cref(*V->element()), num_argument_dofs);
+  }
+  else
+    return std::nullopt;
 }
 } // namespace dolfinx::fem::impl
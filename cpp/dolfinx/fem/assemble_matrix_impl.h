@@ -7,19 +7,27 @@
 #pragma once
 
 #include "DofMap.h"
+#include "DofTransformation.h"
 #include "Form.h"
 #include "FunctionSpace.h"
+#include "batch.h"
+#include "colouring.h"
 #include "traits.h"
 #include "utils.h"
 #include <algorithm>
+#include <dolfinx/common/Workspace.h>
 #include <dolfinx/la/utils.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <functional>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
 #include <span>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace dolfinx::fem::impl
@@ -27,9 +35,80 @@ namespace dolfinx::fem::impl
 /// @brief Typedef
 using mdspan2_t = md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>>;
 
+/// @brief Call `fn(std::integral_constant<int, BS0>{},
+/// std::integral_constant<int, BS1>{})` with the run-time block sizes
+/// `bs0` and `bs1` as compile-time constants.
+///
+/// Block sizes 1, 2, 3, 4 and 6 are supported. If either block size is
+/// not supported, `fn` is called with `BS0 = BS1 = -1`, in which case
+/// the block sizes must be handled at run time.
+///
+/// @param[in] bs0 Row block size.
+/// @param[in] bs1 Column block size.
+/// @param[in] fn Function to call.
+template <typename F>
+void dispatch_block_size(int bs0, int bs1, F&& fn)
+{
+  using dynamic_t = std::integral_constant<int, -1>;
+  auto dispatch1 = [&]<int BS0>(std::integral_constant<int, BS0> b0)
+  {
+    switch (bs1)
+    {
+    case 1:
+      fn(b0, std::integral_constant<int, 1>{});
+      break;
+    case 2:
+      fn(b0, std::integral_constant<int, 2>{});
+      break;
+    case 3:
+      fn(b0, std::integral_constant<int, 3>{});
+      break;
+    case 4:
+      fn(b0, std::integral_constant<int, 4>{});
+      break;
+    case 6:
+      fn(b0, std::integral_constant<int, 6>{});
+      break;
+    default:
+      fn(dynamic_t{}, dynamic_t{});
+    }
+  };
+
+  switch (bs0)
+  {
+  case 1:
+    dispatch1(std::integral_constant<int, 1>{});
+    break;
+  case 2:
+    dispatch1(std::integral_constant<int, 2>{});
+    break;
+  case 3:
+    dispatch1(std::integral_constant<int, 3>{});
+    break;
+  case 4:
+    dispatch1(std::integral_constant<int, 4>{});
+    break;
+  case 6:
+    dispatch1(std::integral_constant<int, 6>{});
+    break;
+  default:
+    fn(dynamic_t{}, dynamic_t{});
+  }
+}
+
 /// @brief Execute kernel over cells and accumulate result in a matrix.
 ///
 /// @tparam T Matrix/form scalar type.
+/// @tparam _bs0 The block size of the test function dof map. If less
+/// than zero the block size is determined at runtime. If `_bs0` is
+/// positive the block size is used as a compile-time constant, which
+/// has performance benefits.
+/// @tparam _bs1 The block size of the trial function dof map.
+/// @tparam _num_dofs0 The number of dofs per cell of the test function
+/// dof map. If less than zero it is determined at runtime, otherwise
+/// it is used as a compile-time constant (see fem::dispatch_num_dofs).
+/// @tparam _num_dofs1 The number of dofs per cell of the trial
+/// function dof map.
 /// @param mat_set Function that accumulates computed entries into a
 /// matrix.
 /// @param[in] x_dofmap Degree-of-freedom map for the mesh geometry.
@@ -60,7 +139,22 @@ using mdspan2_t = md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>>;
 /// function mesh.
 /// @param cell_info1 Cell permutation information for the trial
 /// function mesh.
-template <dolfinx::scalar T>
+/// @param[in] coordinate_dofs Packed coordinate dofs of the cells,
+/// with the coordinate dofs of entity `i` starting at `i * n`, where
+/// `n` is the number of coordinate dof entries per entity. If empty,
+/// the coordinate dofs are gathered from `x`.
+/// @param[in,out] values Matrix data (see la::MatrixCSR::values). Only
+/// used if `offsets` is not empty.
+/// @param[in] offsets Positions in `values` of the entries of the
+/// element tensor of each entity, with the positions for entity `i`
+/// starting at `i * n`, where `n` is the size of the element tensor
+/// (see la::MatrixCSR::data_offsets). If empty, `mat_set` is used to
+/// add the element tensors to the matrix.
+/// @param[in] positions Positions in `cells` of the cells to execute
+/// the kernel over. If not set, the kernel is executed over all cells
+/// in `cells`.
+template <dolfinx::scalar T, int _bs0 = -1, int _bs1 = -1,
+          int _num_dofs0 = -1, int _num_dofs1 = -1>
 void assemble_cells(
     la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
     md::mdspan<const scalar_value_t<T>,
@@ -74,28 +168,48 @@ void assemble_cells(
     std::span<const std::int8_t> bc1, FEkernel<T> auto kernel,
     md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
     std::span<const T> constants, std::span<const std::uint32_t> cell_info0,
-    std::span<const std::uint32_t> cell_info1)
+    std::span<const std::uint32_t> cell_info1,
+    packed_coordinate_dofs<scalar_value_t<T>> coordinate_dofs = {},
+    std::span<T> values = {}, std::span<const std::int32_t> offsets = {},
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
 {
   if (cells.empty())
     return;
 
-  const auto [dmap0, bs0, cells0] = dofmap0;
-  const auto [dmap1, bs1, cells1] = dofmap1;
+  const auto [dmap0, dbs0, cells0] = dofmap0;
+  const auto [dmap1, dbs1, cells1] = dofmap1;
+  assert(_bs0 < 0 or _bs0 == dbs0);
+  assert(_bs1 < 0 or _bs1 == dbs1);
+
+  assert(_num_dofs0 < 0 or _num_dofs0 == (int)dmap0.extent(1));
+  assert(_num_dofs1 < 0 or _num_dofs1 == (int)dmap1.extent(1));
+
+  // Block sizes and numbers of dofs per cell, as compile-time constants
+  // if available
+  const int bs0 = _bs0 > 0 ? _bs0 : dbs0;
+  const int bs1 = _bs1 > 0 ? _bs1 : dbs1;
+  const int num_dofs0 = _num_dofs0 > 0 ? _num_dofs0 : dmap0.extent(1);
+  const int num_dofs1 = _num_dofs1 > 0 ? _num_dofs1 : dmap1.extent(1);
+  constexpr std::size_t N0 = _num_dofs0 > 0 ? _num_dofs0 : md::dynamic_extent;
+  constexpr std::size_t N1 = _num_dofs1 > 0 ? _num_dofs1 : md::dynamic_extent;
 
   // Iterate over active cells
-  const int num_dofs0 = dmap0.extent(1);
-  const int num_dofs1 = dmap1.extent(1);
   const int ndim0 = bs0 * num_dofs0;
   const int ndim1 = bs1 * num_dofs1;
-  std::vector<T> Ae(ndim0 * ndim1);
+  common::Workspace& ws = common::Workspace::local();
+  common::Workspace::Scope scope(ws);
+  std::span<T> Ae = ws.allocate<T>(ndim0 * ndim1);
   std::span<T> _Ae(Ae);
-  std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1));
+  std::span cdofs = ws.allocate<scalar_value_t<T>>(3 * x_dofmap.extent(1));
 
   // Iterate over active cells
   assert(cells0.size() == cells.size());
   assert(cells1.size() == cells.size());
-  for (std::size_t c = 0; c < cells.size(); ++c)
+  const std::size_t num_cells = positions ? positions->size() : cells.size();
+  for (std::size_t p = 0; p < num_cells; ++p)
   {
+    const std::size_t c = positions ? (*positions)[p] : p;
+
     // Cell index in integration domain mesh (c), test function mesh
     // (c0) and trial function mesh (c1)
     std::int32_t cell = cells[c];
@@ -103,13 +217,18 @@ void assemble_cells(
     std::int32_t cell1 = cells1[c];
 
     // Get cell coordinates/geometry
-    auto x_dofs = md::submdspan(x_dofmap, cell, md::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-      std::copy_n(&x(x_dofs[i], 0), 3, std::next(cdofs.begin(), 3 * i));
+    const scalar_value_t<T>* cdofs_e = cdofs.data();
+    if (!coordinate_dofs.empty())
+      cdofs_e = coordinate_dofs.get(c, cdofs);
+    else
+    {
+      auto x_dofs = md::submdspan(x_dofmap, cell, md::full_extent);
+      gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
+    }
 
     // Tabulate tensor
     std::ranges::fill(Ae, 0);
-    kernel(Ae.data(), &coeffs(c, 0), constants.data(), cdofs.data(), nullptr,
+    kernel(Ae.data(), &coeffs(c, 0), constants.data(), cdofs_e, nullptr,
            nullptr, nullptr);
 
     // Compute A = P_0 \tilde{A} P_1^T (dof transformation)
@@ -117,8 +236,10 @@ void assemble_cells(
     P1T(_Ae, cell_info1, cell1, ndim0); // A =  B P1_T
 
     // Zero rows/columns for essential bcs
-    std::span dofs0(dmap0.data_handle() + cell0 * num_dofs0, num_dofs0);
-    std::span dofs1(dmap1.data_handle() + cell1 * num_dofs1, num_dofs1);
+    std::span<const std::int32_t, N0> dofs0(
+        dmap0.data_handle() + cell0 * num_dofs0, num_dofs0);
+    std::span<const std::int32_t, N1> dofs1(
+        dmap1.data_handle() + cell1 * num_dofs1, num_dofs1);
 
     if (!bc0.empty())
     {
@@ -153,7 +274,170 @@ void assemble_cells(
       }
     }
 
-    mat_set(dofs0, dofs1, Ae);
+    if (offsets.empty())
+    {
+      mat_set(std::span<const std::int32_t>(dofs0),
+              std::span<const std::int32_t>(dofs1), Ae);
+    }
+    else
+    {
+      std::span<const std::int32_t> offsets_e
+          = offsets.subspan(c * Ae.size(), Ae.size());
+      for (std::size_t k = 0; k < Ae.size(); ++k)
+        values[offsets_e[k]] += Ae[k];
+    }
+  }
+}
+
+/// @brief Execute the kernels of a bilinear and a linear form over
+/// cells, and accumulate the results in a matrix and a vector.
+///
+/// For each cell the geometry is gathered once and both kernels are
+/// executed. The result is equal to assemble_cells() for the bilinear
+/// form and the vector cell assembly for the linear form, with a single
+/// pass over the cells.
+///
+/// @tparam T Scalar type.
+/// @tparam _bs0 The block size of the test function dof map. If less
+/// than zero the block size is determined at runtime.
+/// @tparam _bs1 The block size of the trial function dof map.
+/// @param[in] mat_set Function that accumulates computed entries into a
+/// matrix.
+/// @param[in,out] b The vector to accumulate into.
+/// @param[in] x_dofmap Dofmap for the mesh geometry.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] cells Cell indices (in the integration domain mesh) to
+/// execute the kernels over.
+/// @param[in] dofmap0 Test function (row) degree-of-freedom data
+/// holding the (0) dofmap, (1) dofmap block size and (2) dofmap cell
+/// indices.
+/// @param[in] P0 Function that applies the transformation `P_0 A`
+/// in-place to transform test degrees-of-freedom.
+/// @param[in] dofmap1 Trial function (column) degree-of-freedom data.
+/// See `dofmap0` for a description.
+/// @param[in] P1T Function that applies the transformation `A P_1^T`
+/// in-place to transform trial degrees-of-freedom.
+/// @param[in] bc0 Marker for rows with Dirichlet boundary conditions
+/// applied.
+/// @param[in] bc1 Marker for columns with Dirichlet boundary conditions
+/// applied.
+/// @param[in] kernel_a Bilinear form kernel.
+/// @param[in] constants_a Constant data in `kernel_a`.
+/// @param[in] coeffs_a Coefficient data in `kernel_a`, with shape
+/// `(cells.size(), num_cell_coeffs)`.
+/// @param[in] kernel_L Linear form kernel.
+/// @param[in] constants_L Constant data in `kernel_L`.
+/// @param[in] coeffs_L Coefficient data in `kernel_L`, with shape
+/// `(cells.size(), num_cell_coeffs)`.
+/// @param[in] cell_info0 Cell permutation information for the test
+/// function mesh.
+/// @param[in] cell_info1 Cell permutation information for the trial
+/// function mesh.
+template <dolfinx::scalar T, int _bs0 = -1, int _bs1 = -1>
+void assemble_matrix_vector_cells(
+    la::MatSet<T> auto mat_set, std::span<T> b, mdspan2_t x_dofmap,
+    md::mdspan<const scalar_value_t<T>,
+               md::extents<std::size_t, md::dynamic_extent, 3>>
+        x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    fem::DofTransformKernel<T> auto P1T, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1, FEkernel<T> auto kernel_a,
+    std::span<const T> constants_a,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs_a,
+    FEkernel<T> auto kernel_L, std::span<const T> constants_L,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs_L,
+    std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1)
+{
+  if (cells.empty())
+    return;
+
+  const auto [dmap0, dbs0, cells0] = dofmap0;
+  const auto [dmap1, dbs1, cells1] = dofmap1;
+  assert(_bs0 < 0 or _bs0 == dbs0);
+  assert(_bs1 < 0 or _bs1 == dbs1);
+  assert(cells0.size() == cells.size());
+  assert(cells1.size() == cells.size());
+
+  const int bs0 = _bs0 > 0 ? _bs0 : dbs0;
+  const int bs1 = _bs1 > 0 ? _bs1 : dbs1;
+  const int num_dofs0 = dmap0.extent(1);
+  const int num_dofs1 = dmap1.extent(1);
+  const int ndim0 = bs0 * num_dofs0;
+  const int ndim1 = bs1 * num_dofs1;
+  common::Workspace& ws = common::Workspace::local();
+  common::Workspace::Scope scope(ws);
+  std::span<T> Ae = ws.allocate<T>(ndim0 * ndim1);
+  std::span<T> be = ws.allocate<T>(ndim0);
+  std::span<T> _Ae(Ae);
+  std::span<T> _be(be);
+  std::span cdofs = ws.allocate<scalar_value_t<T>>(3 * x_dofmap.extent(1));
+  for (std::size_t index = 0; index < cells.size(); ++index)
+  {
+    // Cell index in integration domain mesh, test function mesh, and
+    // trial function mesh
+    std::int32_t c = cells[index];
+    std::int32_t c0 = cells0[index];
+    std::int32_t c1 = cells1[index];
+
+    // Get cell coordinates/geometry
+    auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
+    gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
+
+    // Tabulate matrix and vector for cell
+    std::ranges::fill(Ae, 0);
+    kernel_a(Ae.data(), &coeffs_a(index, 0), constants_a.data(),
+             cdofs.data(), nullptr, nullptr, nullptr);
+    P0(_Ae, cell_info0, c0, ndim1);
+    P1T(_Ae, cell_info1, c1, ndim0);
+
+    std::ranges::fill(be, 0);
+    kernel_L(be.data(), &coeffs_L(index, 0), constants_L.data(),
+             cdofs.data(), nullptr, nullptr, nullptr);
+    P0(_be, cell_info0, c0, 1);
+
+    // Zero rows/columns for essential bcs
+    std::span dofs0(dmap0.data_handle() + c0 * num_dofs0, num_dofs0);
+    std::span dofs1(dmap1.data_handle() + c1 * num_dofs1, num_dofs1);
+    if (!bc0.empty())
+    {
+      for (int i = 0; i < num_dofs0; ++i)
+      {
+        for (int k = 0; k < bs0; ++k)
+        {
+          if (bc0[bs0 * dofs0[i] + k])
+          {
+            const int row = bs0 * i + k;
+            std::fill_n(std::next(Ae.begin(), ndim1 * row), ndim1, 0);
+          }
+        }
+      }
+    }
+
+    if (!bc1.empty())
+    {
+      for (int j = 0; j < num_dofs1; ++j)
+      {
+        for (int k = 0; k < bs1; ++k)
+        {
+          if (bc1[bs1 * dofs1[j] + k])
+          {
+            const int col = bs1 * j + k;
+            for (int row = 0; row < ndim0; ++row)
+              Ae[row * ndim1 + col] = 0;
+          }
+        }
+      }
+    }
+
+    mat_set(std::span<const std::int32_t>(dofs0),
+            std::span<const std::int32_t>(dofs1), Ae);
+    for (int i = 0; i < num_dofs0; ++i)
+      for (int k = 0; k < bs0; ++k)
+        b[bs0 * dofs0[i] + k] += be[bs0 * i + k];
   }
 }
 
@@ -161,6 +445,11 @@ void assemble_cells(
 /// a matrix.
 ///
 /// @tparam T Matrix/form scalar type.
+/// @tparam _bs0 The block size of the test function dof map. If less
+/// than zero the block size is determined at runtime. If `_bs0` is
+/// positive the block size is used as a compile-time constant, which
+/// has performance benefits.
+/// @tparam _bs1 The block size of the trial function dof map.
 /// @param[in] mat_set Function that accumulates computed entries into a
 /// matrix.
 /// @param[in] x_dofmap Dofmap for the mesh geometry.
@@ -191,7 +480,21 @@ void assemble_cells(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
-template <dolfinx::scalar T>
+/// @param[in] coordinate_dofs Packed coordinate dofs of the facets,
+/// with the coordinate dofs of entity `i` starting at `i * n`, where
+/// `n` is the number of coordinate dof entries per entity. If empty,
+/// the coordinate dofs are gathered from `x`.
+/// @param[in,out] values Matrix data (see la::MatrixCSR::values). Only
+/// used if `offsets` is not empty.
+/// @param[in] offsets Positions in `values` of the entries of the
+/// element tensor of each entity, with the positions for entity `i`
+/// starting at `i * n`, where `n` is the size of the element tensor
+/// (see la::MatrixCSR::data_offsets). If empty, `mat_set` is used to
+/// add the element tensors to the matrix.
+/// @param[in] positions Positions in `facets` of the facets to execute
+/// the kernel over. If not set, the kernel is executed over all facets
+/// in `facets`.
+template <dolfinx::scalar T, int _bs0 = -1, int _bs1 = -1>
 void assemble_exterior_facets(
     la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
     md::mdspan<const scalar_value_t<T>,
@@ -214,26 +517,41 @@ void assemble_exterior_facets(
     md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
     std::span<const T> constants, std::span<const std::uint32_t> cell_info0,
     std::span<const std::uint32_t> cell_info1,
-    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms)
+    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms,
+    packed_coordinate_dofs<scalar_value_t<T>> coordinate_dofs = {},
+    std::span<T> values = {}, std::span<const std::int32_t> offsets = {},
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
 {
   if (facets.empty())
     return;
 
-  const auto [dmap0, bs0, facets0] = dofmap0;
-  const auto [dmap1, bs1, facets1] = dofmap1;
+  const auto [dmap0, dbs0, facets0] = dofmap0;
+  const auto [dmap1, dbs1, facets1] = dofmap1;
+  assert(_bs0 < 0 or _bs0 == dbs0);
+  assert(_bs1 < 0 or _bs1 == dbs1);
 
-  // Data structures used in assembly
-  std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1));
+  // Block sizes, as compile-time constants if available
+  const int bs0 = _bs0 > 0 ? _bs0 : dbs0;
+  const int bs1 = _bs1 > 0 ? _bs1 : dbs1;
+
+  // Data structures used in assembly (scratch arrays)
+  common::Workspace& ws = common::Workspace::local();
+  common::Workspace::Scope scope(ws);
+  std::span cdofs = ws.allocate<scalar_value_t<T>>(3 * x_dofmap.extent(1));
   const int num_dofs0 = dmap0.extent(1);
   const int num_dofs1 = dmap1.extent(1);
   const int ndim0 = bs0 * num_dofs0;
   const int ndim1 = bs1 * num_dofs1;
-  std::vector<T> Ae(ndim0 * ndim1);
+  std::span<T> Ae = ws.allocate<T>(ndim0 * ndim1);
   std::span<T> _Ae(Ae);
   assert(facets0.size() == facets.size());
   assert(facets1.size() == facets.size());
-  for (std::size_t f = 0; f < facets.extent(0); ++f)
+  const std::size_t num_facets
+      = positions ? positions->size() : facets.extent(0);
+  for (std::size_t p = 0; p < num_facets; ++p)
   {
+    const std::size_t f = positions ? (*positions)[p] : p;
+
     // Cell in the integration domain, local facet index relative to the
     // integration domain cell, and cells in the test and trial function
     // meshes
@@ -243,17 +561,22 @@ void assemble_exterior_facets(
     std::int32_t cell1 = facets1(f, 0);
 
     // Get cell coordinates/geometry
-    auto x_dofs = md::submdspan(x_dofmap, cell, md::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-      std::copy_n(&x(x_dofs[i], 0), 3, std::next(cdofs.begin(), 3 * i));
+    const scalar_value_t<T>* cdofs_e = cdofs.data();
+    if (!coordinate_dofs.empty())
+      cdofs_e = coordinate_dofs.get(f, cdofs);
+    else
+    {
+      auto x_dofs = md::submdspan(x_dofmap, cell, md::full_extent);
+      gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
+    }
 
     // Permutations
     std::uint8_t perm = perms.empty() ? 0 : perms(cell, local_facet);
 
     // Tabulate tensor
     std::ranges::fill(Ae, 0);
-    kernel(Ae.data(), &coeffs(f, 0), constants.data(), cdofs.data(),
-           &local_facet, &perm, nullptr);
+    kernel(Ae.data(), &coeffs(f, 0), constants.data(), cdofs_e, &local_facet,
+           &perm, nullptr);
 
     P0(_Ae, cell_info0, cell0, ndim1);
     P1T(_Ae, cell_info1, cell1, ndim0);
@@ -293,7 +616,329 @@ void assemble_exterior_facets(
       }
     }
 
-    mat_set(dofs0, dofs1, Ae);
+    if (offsets.empty())
+      mat_set(dofs0, dofs1, Ae);
+    else
+    {
+      std::span<const std::int32_t> offsets_e
+          = offsets.subspan(f * Ae.size(), Ae.size());
+      for (std::size_t k = 0; k < Ae.size(); ++k)
+        values[offsets_e[k]] += Ae[k];
+    }
+  }
+}
+
+/// @brief Execute a batched kernel over cells and accumulate result in
+/// a matrix.
+///
+/// Cells are processed in batches of `W`, with the geometry and
+/// coefficients of each batch packed in a structure-of-arrays layout
+/// (see integral_data::kernel_batch).
+///
+/// @tparam T Matrix/form scalar type.
+/// @tparam W Batch size (number of cells per kernel call).
+/// @param mat_set Function that accumulates computed entries into a
+/// matrix.
+/// @param[in] x_dofmap Degree-of-freedom map for the mesh geometry.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] cells Cell indices to execute the kernel over. These are
+/// the indices into the geometry dofmap `x_dofmap`.
+/// @param[in] dofmap0 Test function (row) degree-of-freedom data
+/// holding the (0) dofmap, (1) dofmap block size and (2) dofmap cell
+/// indices.
+/// @param[in] P0 Function that applies transformation `P_0 A` in-place
+/// to the computed tensor `A` to transform its test degrees-of-freedom.
+/// @param[in] dofmap1 Trial function (column) degree-of-freedom data
+/// holding the (0) dofmap, (1) dofmap block size and (2) dofmap cell
+/// indices.
+/// @param[in] P1T Function that applies transformation `A P_1^T`
+/// in-place to to the computed tensor `A` to transform trial
+/// degrees-of-freedom.
+/// @param bc0 Marker for rows with Dirichlet boundary conditions
+/// applied.
+/// @param bc1 Marker for columns with Dirichlet boundary conditions
+/// applied.
+/// @param kernel Batched kernel function.
+/// @param[in] coeffs Coefficient data in the kernel. It has shape
+/// `(cells.size(), num_cell_coeffs)`.
+/// @param constants Constant data.
+/// @param cell_info0 Cell permutation information for the test
+/// function mesh.
+/// @param cell_info1 Cell permutation information for the trial
+/// function mesh.
+/// @param[in] positions Positions in `cells` of the cells to execute
+/// the kernel over. If not set, the kernel is executed over all cells
+/// in `cells`.
+template <dolfinx::scalar T, int W>
+void assemble_cells_batched(
+    la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
+    md::mdspan<const scalar_value_t<T>,
+               md::extents<std::size_t, md::dynamic_extent, 3>>
+        x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    fem::DofTransformKernel<T> auto P1T, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1, FEkernel<T> auto kernel,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
+    std::span<const T> constants, std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1,
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
+{
+  if (cells.empty())
+    return;
+
+  const auto [dmap0, bs0, cells0] = dofmap0;
+  const auto [dmap1, bs1, cells1] = dofmap1;
+
+  // Data structures used in assembly
+  const int num_dofs0 = dmap0.extent(1);
+  const int num_dofs1 = dmap1.extent(1);
+  const int ndim0 = bs0 * num_dofs0;
+  const int ndim1 = bs1 * num_dofs1;
+  std::vector<T> Ae(ndim0 * ndim1);
+  std::span<T> _Ae(Ae);
+  std::vector<T> Ae_b(ndim0 * ndim1 * W);
+  std::vector<T> coeffs_b(coeffs.extent(1) * W);
+  std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1) * W);
+
+  // Iterate over batches of active cells
+  assert(cells0.size() == cells.size());
+  assert(cells1.size() == cells.size());
+  const std::size_t num_cells = positions ? positions->size() : cells.size();
+  for (std::size_t p0 = 0; p0 < num_cells; p0 += W)
+  {
+    auto [index, num_lanes] = batch_positions<W>(p0, num_cells, positions);
+
+    // Pack cell geometry and coefficients for the batch
+    std::array<std::int32_t, W> c;
+    for (int w = 0; w < W; ++w)
+      c[w] = cells[index[w]];
+    pack_coordinate_dofs_batch<W>(std::span(cdofs), x_dofmap, x,
+                                  std::span<const std::int32_t, W>(c));
+    pack_coefficients_batch<W>(std::span(coeffs_b), coeffs,
+                               std::span<const std::size_t, W>(index));
+
+    // Tabulate tensors for batch
+    std::ranges::fill(Ae_b, 0);
+    kernel(Ae_b.data(), coeffs_b.data(), constants.data(), cdofs.data(),
+           nullptr, nullptr, nullptr);
+
+    for (int w = 0; w < num_lanes; ++w)
+    {
+      // Cell index in test function mesh (c0) and trial function mesh
+      // (c1)
+      std::int32_t cell0 = cells0[index[w]];
+      std::int32_t cell1 = cells1[index[w]];
+
+      // Compute A = P_0 \tilde{A} P_1^T (dof transformation)
+      extract_batch_lane<W>(_Ae, std::span<const T>(Ae_b), w);
+      P0(_Ae, cell_info0, cell0, ndim1);
+      P1T(_Ae, cell_info1, cell1, ndim0);
+
+      // Zero rows/columns for essential bcs
+      std::span dofs0(dmap0.data_handle() + cell0 * num_dofs0, num_dofs0);
+      std::span dofs1(dmap1.data_handle() + cell1 * num_dofs1, num_dofs1);
+      if (!bc0.empty())
+      {
+        for (int i = 0; i < num_dofs0; ++i)
+        {
+          for (int k = 0; k < bs0; ++k)
+          {
+            if (bc0[bs0 * dofs0[i] + k])
+            {
+              // Zero row bs0 * i + k
+              const int row = bs0 * i + k;
+              std::fill_n(std::next(Ae.begin(), ndim1 * row), ndim1, 0);
+            }
+          }
+        }
+      }
+      if (!bc1.empty())
+      {
+        for (int j = 0; j < num_dofs1; ++j)
+        {
+          for (int k = 0; k < bs1; ++k)
+          {
+            if (bc1[bs1 * dofs1[j] + k])
+            {
+              // Zero column bs1 * j + k
+              const int col = bs1 * j + k;
+              for (int row = 0; row < ndim0; ++row)
+                Ae[row * ndim1 + col] = 0;
+            }
+          }
+        }
+      }
+
+      mat_set(dofs0, dofs1, Ae);
+    }
+  }
+}
+
+/// @brief Execute a batched kernel over exterior facets and accumulate
+/// result in a matrix.
+///
+/// Facets are processed in batches of `W`, with the geometry,
+/// coefficients, local facet indices and permutations of each batch
+/// packed in a structure-of-arrays layout (see
+/// integral_data::kernel_batch).
+///
+/// @tparam T Matrix/form scalar type.
+/// @tparam W Batch size (number of facets per kernel call).
+/// @param[in] mat_set Function that accumulates computed entries into a
+/// matrix.
+/// @param[in] x_dofmap Dofmap for the mesh geometry.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] facets Facet indices (in the integration domain mesh) to
+/// execute the kernel over.
+/// @param[in] dofmap0 Test function (row) degree-of-freedom data
+/// holding the (0) dofmap, (1) dofmap block size and (2) dofmap cell
+/// indices.
+/// @param[in] P0 Function that applies transformation P0.A in-place to
+/// transform test degrees-of-freedom.
+/// @param[in] dofmap1 Trial function (column) degree-of-freedom data
+/// holding the (0) dofmap, (1) dofmap block size and (2) dofmap cell
+/// indices.
+/// @param[in] P1T Function that applies transformation A.P1^T in-place
+/// to transform trial degrees-of-freedom.
+/// @param[in] bc0 Marker for rows with Dirichlet boundary conditions
+/// applied.
+/// @param[in] bc1 Marker for columns with Dirichlet boundary conditions
+/// applied.
+/// @param[in] kernel Batched kernel function.
+/// @param[in] coeffs Coefficient data array of shape
+/// `(facets.extent(0), cstride)`.
+/// @param[in] constants Constant data.
+/// @param[in] cell_info0 Cell permutation information for the test
+/// function mesh.
+/// @param[in] cell_info1 Cell permutation information for the trial
+/// function mesh.
+/// @param[in] perms Facet permutation integer. Empty if facet
+/// permutations are not required.
+/// @param[in] positions Positions in `facets` of the facets to execute
+/// the kernel over. If not set, the kernel is executed over all facets
+/// in `facets`.
+template <dolfinx::scalar T, int W>
+void assemble_exterior_facets_batched(
+    la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
+    md::mdspan<const scalar_value_t<T>,
+               md::extents<std::size_t, md::dynamic_extent, 3>>
+        x,
+    md::mdspan<const std::int32_t,
+               std::extents<std::size_t, md::dynamic_extent, 2>>
+        facets,
+    std::tuple<mdspan2_t, int,
+               md::mdspan<const std::int32_t,
+                          std::extents<std::size_t, md::dynamic_extent, 2>>>
+        dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int,
+               md::mdspan<const std::int32_t,
+                          std::extents<std::size_t, md::dynamic_extent, 2>>>
+        dofmap1,
+    fem::DofTransformKernel<T> auto P1T, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1, FEkernel<T> auto kernel,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
+    std::span<const T> constants, std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1,
+    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms,
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
+{
+  if (facets.empty())
+    return;
+
+  const auto [dmap0, bs0, facets0] = dofmap0;
+  const auto [dmap1, bs1, facets1] = dofmap1;
+
+  // Data structures used in assembly
+  const int num_dofs0 = dmap0.extent(1);
+  const int num_dofs1 = dmap1.extent(1);
+  const int ndim0 = bs0 * num_dofs0;
+  const int ndim1 = bs1 * num_dofs1;
+  std::vector<T> Ae(ndim0 * ndim1);
+  std::span<T> _Ae(Ae);
+  std::vector<T> Ae_b(ndim0 * ndim1 * W);
+  std::vector<T> coeffs_b(coeffs.extent(1) * W);
+  std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1) * W);
+  assert(facets0.size() == facets.size());
+  assert(facets1.size() == facets.size());
+  const std::size_t num_facets
+      = positions ? positions->size() : facets.extent(0);
+  for (std::size_t p0 = 0; p0 < num_facets; p0 += W)
+  {
+    auto [index, num_lanes] = batch_positions<W>(p0, num_facets, positions);
+
+    // Cells in the integration domain, local facet indices relative to
+    // the integration domain cells, and facet permutations
+    std::array<std::int32_t, W> cells, local_facets;
+    std::array<std::uint8_t, W> perm;
+    for (int w = 0; w < W; ++w)
+    {
+      cells[w] = facets(index[w], 0);
+      local_facets[w] = facets(index[w], 1);
+      perm[w] = perms.empty() ? 0 : perms(cells[w], local_facets[w]);
+    }
+
+    // Pack geometry and coefficients for the batch
+    pack_coordinate_dofs_batch<W>(std::span(cdofs), x_dofmap, x,
+                                  std::span<const std::int32_t, W>(cells));
+    pack_coefficients_batch<W>(std::span(coeffs_b), coeffs,
+                               std::span<const std::size_t, W>(index));
+
+    // Tabulate tensors for batch
+    std::ranges::fill(Ae_b, 0);
+    kernel(Ae_b.data(), coeffs_b.data(), constants.data(), cdofs.data(),
+           local_facets.data(), perm.data(), nullptr);
+
+    for (int w = 0; w < num_lanes; ++w)
+    {
+      // Cells in the test and trial function meshes
+      std::int32_t cell0 = facets0(index[w], 0);
+      std::int32_t cell1 = facets1(index[w], 0);
+
+      extract_batch_lane<W>(_Ae, std::span<const T>(Ae_b), w);
+      P0(_Ae, cell_info0, cell0, ndim1);
+      P1T(_Ae, cell_info1, cell1, ndim0);
+
+      // Zero rows/columns for essential bcs
+      std::span dofs0(dmap0.data_handle() + cell0 * num_dofs0, num_dofs0);
+      std::span dofs1(dmap1.data_handle() + cell1 * num_dofs1, num_dofs1);
+      if (!bc0.empty())
+      {
+        for (int i = 0; i < num_dofs0; ++i)
+        {
+          for (int k = 0; k < bs0; ++k)
+          {
+            if (bc0[bs0 * dofs0[i] + k])
+            {
+              // Zero row bs0 * i + k
+              const int row = bs0 * i + k;
+              std::fill_n(std::next(Ae.begin(), ndim1 * row), ndim1, 0);
+            }
+          }
+        }
+      }
+      if (!bc1.empty())
+      {
+        for (int j = 0; j < num_dofs1; ++j)
+        {
+          for (int k = 0; k < bs1; ++k)
+          {
+            if (bc1[bs1 * dofs1[j] + k])
+            {
+              // Zero column bs1 * j + k
+              const int col = bs1 * j + k;
+              for (int row = 0; row < ndim0; ++row)
+                Ae[row * ndim1 + col] = 0;
+            }
+          }
+        }
+      }
+
+      mat_set(dofs0, dofs1, Ae);
+    }
   }
 }
 
@@ -301,6 +946,11 @@ void assemble_exterior_facets(
 /// a matrix.
 ///
 /// @tparam T Matrix/form scalar type.
+/// @tparam _bs0 The block size of the test function dof map. If less
+/// than zero the block size is determined at runtime. If `_bs0` is
+/// positive the block size is used as a compile-time constant, which
+/// has performance benefits.
+/// @tparam _bs1 The block size of the trial function dof map.
 /// @param mat_set Function that accumulates computed entries into a
 /// matrix.
 /// @param[in] x_dofmap Dofmap for the mesh geometry.
@@ -331,7 +981,24 @@ void assemble_exterior_facets(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
-template <dolfinx::scalar T>
+/// @param[in] coordinate_dofs Packed coordinate dofs of the facets,
+/// with the coordinate dofs of entity `i` starting at `i * n`, where
+/// `n` is the number of coordinate dof entries per entity. If empty,
+/// the coordinate dofs are gathered from `x`.
+/// @param[in,out] values Matrix data (see la::MatrixCSR::values). Only
+/// used if `offsets` is not empty.
+/// @param[in] offsets Positions in `values` of the entries of the
+/// element tensor of each entity, with the positions for entity `i`
+/// starting at `i * n`, where `n` is the size of the element tensor
+/// (see la::MatrixCSR::data_offsets). If empty, `mat_set` is used to
+/// add the element tensors to the matrix.
+/// @param[in] positions Positions in `facets` of the facets to execute
+/// the kernel over. If not set, the kernel is executed over all facets
+/// in `facets`.
+/// @param[in] facet_pairs Precomputed merged dofs and permutations of
+/// the facets (see Form::facet_pairs). If empty, the dofs of the two
+/// cells are merged and the permutations looked up for each facet.
+template <dolfinx::scalar T, int _bs0 = -1, int _bs1 = -1>
 void assemble_interior_facets(
     la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
     md::mdspan<const scalar_value_t<T>,
@@ -356,13 +1023,23 @@ void assemble_interior_facets(
         coeffs,
     std::span<const T> constants, std::span<const std::uint32_t> cell_info0,
     std::span<const std::uint32_t> cell_info1,
-    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms)
+    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms,
+    packed_coordinate_dofs<scalar_value_t<T>> coordinate_dofs = {},
+    std::span<T> values = {}, std::span<const std::int32_t> offsets = {},
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt,
+    packed_facet_pairs facet_pairs = {})
 {
   if (facets.empty())
     return;
 
-  const auto [dmap0, bs0, facets0] = dofmap0;
-  const auto [dmap1, bs1, facets1] = dofmap1;
+  const auto [dmap0, dbs0, facets0] = dofmap0;
+  const auto [dmap1, dbs1, facets1] = dofmap1;
+  assert(_bs0 < 0 or _bs0 == dbs0);
+  assert(_bs1 < 0 or _bs1 == dbs1);
+
+  // Block sizes, as compile-time constants if available
+  const int bs0 = _bs0 > 0 ? _bs0 : dbs0;
+  const int bs1 = _bs1 > 0 ? _bs1 : dbs1;
 
   // Data structures used in assembly
   using X = scalar_value_t<T>;
@@ -373,12 +1050,20 @@ void assemble_interior_facets(
 
   std::vector<T> Ae, be;
 
+  // Number of dofs per cell
+  const std::size_t num_dofs0 = dmap0.map().extent(1);
+  const std::size_t num_dofs1 = dmap1.map().extent(1);
+
   // Temporaries for joint dofmaps
   std::vector<std::int32_t> dmapjoint0, dmapjoint1;
   assert(facets0.size() == facets.size());
   assert(facets1.size() == facets.size());
-  for (std::size_t f = 0; f < facets.extent(0); ++f)
+  const std::size_t num_facets
+      = positions ? positions->size() : facets.extent(0);
+  for (std::size_t p = 0; p < num_facets; ++p)
   {
+    const std::size_t f = positions ? (*positions)[p] : p;
+
     // Cells in integration domain,  test function domain and trial
     // function domain
     std::array cells{facets(f, 0, 0), facets(f, 1, 0)};
@@ -389,40 +1074,54 @@ void assemble_interior_facets(
     std::array local_facet{facets(f, 0, 1), facets(f, 1, 1)};
 
     // Get cell geometry
-    auto x_dofs0 = md::submdspan(x_dofmap, cells[0], md::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
-      std::copy_n(&x(x_dofs0[i], 0), 3, std::next(cdofs0.begin(), 3 * i));
-    auto x_dofs1 = md::submdspan(x_dofmap, cells[1], md::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
-      std::copy_n(&x(x_dofs1[i], 0), 3, std::next(cdofs1.begin(), 3 * i));
-
-    // Get dof maps for cells and pack
-    std::span<const std::int32_t> dmap0_cell0 = dmap0.cell_dofs(cells0[0]);
-    std::span<const std::int32_t> dmap0_cell1 = dmap0.cell_dofs(cells0[1]);
-    dmapjoint0.resize(dmap0_cell0.size() + dmap0_cell1.size());
-    std::ranges::copy(dmap0_cell0, dmapjoint0.begin());
-    std::ranges::copy(dmap0_cell1,
-                      std::next(dmapjoint0.begin(), dmap0_cell0.size()));
-
-    std::span<const std::int32_t> dmap1_cell0 = dmap1.cell_dofs(cells1[0]);
-    std::span<const std::int32_t> dmap1_cell1 = dmap1.cell_dofs(cells1[1]);
-    dmapjoint1.resize(dmap1_cell0.size() + dmap1_cell1.size());
-    std::ranges::copy(dmap1_cell0, dmapjoint1.begin());
-    std::ranges::copy(dmap1_cell1,
-                      std::next(dmapjoint1.begin(), dmap1_cell0.size()));
-
-    const int num_rows = bs0 * dmapjoint0.size();
-    const int num_cols = bs1 * dmapjoint1.size();
+    const X* cdofs_e = cdofs.data();
+    if (!coordinate_dofs.empty())
+      cdofs_e = coordinate_dofs.get(f, cdofs);
+    else
+    {
+      auto x_dofs0 = md::submdspan(x_dofmap, cells[0], md::full_extent);
+      gather_coordinate_dofs(cdofs0, x_dofs0, x);
+      auto x_dofs1 = md::submdspan(x_dofmap, cells[1], md::full_extent);
+      gather_coordinate_dofs(cdofs1, x_dofs1, x);
+    }
+
+    // Get merged dof maps of the two cells, precomputed or packed
+    std::span<const std::int32_t> dofs0, dofs1;
+    if (!facet_pairs.empty())
+    {
+      dofs0 = facet_pairs.dofs0.subspan(2 * num_dofs0 * f, 2 * num_dofs0);
+      dofs1 = facet_pairs.dofs1.subspan(2 * num_dofs1 * f, 2 * num_dofs1);
+    }
+    else
+    {
+      dmapjoint0.resize(2 * num_dofs0);
+      std::ranges::copy(dmap0.cell_dofs(cells0[0]), dmapjoint0.begin());
+      std::ranges::copy(dmap0.cell_dofs(cells0[1]),
+                        std::next(dmapjoint0.begin(), num_dofs0));
+      dmapjoint1.resize(2 * num_dofs1);
+      std::ranges::copy(dmap1.cell_dofs(cells1[0]), dmapjoint1.begin());
+      std::ranges::copy(dmap1.cell_dofs(cells1[1]),
+                        std::next(dmapjoint1.begin(), num_dofs1));
+      dofs0 = dmapjoint0;
+      dofs1 = dmapjoint1;
+    }
+
+    const int num_rows = bs0 * dofs0.size();
+    const int num_cols = bs1 * dofs1.size();
 
     // Tabulate tensor
     Ae.resize(num_rows * num_cols);
     std::ranges::fill(Ae, 0);
 
-    std::array perm = perms.empty()
-                          ? std::array<std::uint8_t, 2>{0, 0}
-                          : std::array{perms(cells[0], local_facet[0]),
-                                       perms(cells[1], local_facet[1])};
-    kernel(Ae.data(), &coeffs(f, 0, 0), constants.data(), cdofs.data(),
+    std::array<std::uint8_t, 2> perm = {0, 0};
+    if (!facet_pairs.perms.empty())
+      perm = {facet_pairs.perms[2 * f], facet_pairs.perms[2 * f + 1]};
+    else if (!perms.empty())
+    {
+      perm = {perms(cells[0], local_facet[0]),
+              perms(cells[1], local_facet[1])};
+    }
+    kernel(Ae.data(), &coeffs(f, 0, 0), constants.data(), cdofs_e,
            local_facet.data(), perm.data(), nullptr);
 
     // Local element layout is a 2x2 block matrix with structure
@@ -433,8 +1132,8 @@ void assemble_interior_facets(
     // where each block is element tensor of size (dmap0, dmap1).
 
     std::span<T> _Ae(Ae);
-    std::span<T> sub_Ae0 = _Ae.subspan(bs0 * dmap0_cell0.size() * num_cols,
-                                       bs0 * dmap0_cell1.size() * num_cols);
+    std::span<T> sub_Ae0 = _Ae.subspan(bs0 * num_dofs0 * num_cols,
+                                       bs0 * num_dofs0 * num_cols);
 
     P0(_Ae, cell_info0, cells0[0], num_cols);
     P0(sub_Ae0, cell_info0, cells0[1], num_cols);
@@ -444,19 +1143,19 @@ void assemble_interior_facets(
     {
       // DOFs for dmap1 and cell1 are not stored contiguously in
       // the block matrix, so each row needs a separate span access
-      std::span<T> sub_Ae1 = _Ae.subspan(
-          row * num_cols + bs1 * dmap1_cell0.size(), bs1 * dmap1_cell1.size());
+      std::span<T> sub_Ae1
+          = _Ae.subspan(row * num_cols + bs1 * num_dofs1, bs1 * num_dofs1);
       P1T(sub_Ae1, cell_info1, cells1[1], 1);
     }
 
     // Zero rows/columns for essential bcs
     if (!bc0.empty())
     {
-      for (std::size_t i = 0; i < dmapjoint0.size(); ++i)
+      for (std::size_t i = 0; i < dofs0.size(); ++i)
       {
         for (int k = 0; k < bs0; ++k)
         {
-          if (bc0[bs0 * dmapjoint0[i] + k])
+          if (bc0[bs0 * dofs0[i] + k])
           {
             // Zero row bs0 * i + k
             std::fill_n(std::next(Ae.begin(), num_cols * (bs0 * i + k)),
@@ -467,11 +1166,11 @@ void assemble_interior_facets(
     }
     if (!bc1.empty())
     {
-      for (std::size_t j = 0; j < dmapjoint1.size(); ++j)
+      for (std::size_t j = 0; j < dofs1.size(); ++j)
       {
         for (int k = 0; k < bs1; ++k)
         {
-          if (bc1[bs1 * dmapjoint1[j] + k])
+          if (bc1[bs1 * dofs1[j] + k])
           {
             // Zero column bs1 * j + k
             for (int m = 0; m < num_rows; ++m)
@@ -481,7 +1180,15 @@ void assemble_interior_facets(
       }
     }
 
-    mat_set(dmapjoint0, dmapjoint1, Ae);
+    if (offsets.empty())
+      mat_set(dofs0, dofs1, Ae);
+    else
+    {
+      std::span<const std::int32_t> offsets_e
+          = offsets.subspan(f * Ae.size(), Ae.size());
+      for (std::size_t k = 0; k < Ae.size(); ++k)
+        values[offsets_e[k]] += Ae[k];
+    }
   }
 }
 
@@ -509,6 +1216,23 @@ void assemble_interior_facets(
 /// applied.
 /// @param bc1 Marker for columns with Dirichlet boundary conditions
 /// applied.
+/// @param[in] num_threads Number of threads to use. If greater than
+/// one, integration entities are coloured such that entities of the
+/// same colour do not share a row degree-of-freedom, and the entities
+/// of each colour are assembled concurrently (see Form::colouring).
+/// `mat_set` must support concurrent calls that insert into different
+/// rows.
+/// @param[in] positions If set, `positions[(type, id, kernel_idx)]`
+/// are the positions in the entity list (see Form::domain) of each
+/// integral of the entities to assemble. Otherwise all entities are
+/// assembled. If set, `num_threads` is ignored.
+/// @param[in,out] values Matrix data (see la::MatrixCSR::values). Only
+/// used if `offsets` is set.
+/// @param[in] offsets If set, `offsets[(type, id, kernel_idx)]` are the
+/// positions in `values` of the element tensor entries of each entity
+/// of each integral (see create_csr_offsets). Element tensors are then
+/// added directly to `values` rather than using `mat_set`. Batched
+/// kernels always use `mat_set`.
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     la::MatSet<T> auto mat_set, const Form<T, U>& a,
@@ -518,7 +1242,19 @@ void assemble_matrix(
     std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients,
-    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1,
+    int num_threads = 1,
+    std::optional<std::reference_wrapper<
+        const std::map<std::tuple<IntegralType, int, int>,
+                       std::vector<std::int32_t>>>>
+        positions
+    = std::nullopt,
+    std::span<T> values = {},
+    std::optional<std::reference_wrapper<
+        const std::map<std::tuple<IntegralType, int, int>,
+                       std::vector<std::int32_t>>>>
+        offsets
+    = std::nullopt)
 {
   // Integration domain mesh
   std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
@@ -560,12 +1296,6 @@ void assemble_matrix(
     assert(element0);
     auto element1 = a.function_spaces().at(1)->elements(cell_type_idx);
     assert(element1);
-    fem::DofTransformKernel<T> auto P0
-        = element0->template dof_transformation_fn<T>(doftransform::standard);
-    fem::DofTransformKernel<T> auto P1T
-        = element1->template dof_transformation_right_fn<T>(
-            doftransform::transpose);
-
     std::span<const std::uint32_t> cell_info0;
     std::span<const std::uint32_t> cell_info1;
     if (element0->needs_dof_transformations()
@@ -578,6 +1308,16 @@ void assemble_matrix(
       cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
     }
 
+    // DOF transformations, cached on the spaces
+    std::shared_ptr<const fem::DofTransformation<T>> P0_ptr
+        = a.function_spaces().at(0)->template dof_transformation<T>(
+            cell_type_idx, doftransform::standard, false);
+    std::shared_ptr<const fem::DofTransformation<T>> P1T_ptr
+        = a.function_spaces().at(1)->template dof_transformation<T>(
+            cell_type_idx, doftransform::transpose, true);
+    fem::DofTransformKernel<T> auto P0 = std::cref(*P0_ptr);
+    fem::DofTransformKernel<T> auto P1T = std::cref(*P1T_ptr);
+
     for (int i : a.integral_ids(IntegralType::cell))
     {
       auto fn = a.kernel(IntegralType::cell, i, cell_type_idx);
@@ -587,10 +1327,72 @@ void assemble_matrix(
       std::span cells1 = a.domain_arg(IntegralType::cell, 1, i, cell_type_idx);
       auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
       assert(cells.size() * cstride == coeffs.size());
-      impl::assemble_cells(mat_set, x_dofmap, x, cells, {dofs0, bs0, cells0},
-                           P0, {dofs1, bs1, cells1}, P1T, bc0, bc1, fn,
-                           md::mdspan(coeffs.data(), cells.size(), cstride),
-                           constants, cell_info0, cell_info1);
+      auto [fn_b, batch_size]
+          = a.kernel_batch(IntegralType::cell, i, cell_type_idx);
+      packed_coordinate_dofs<scalar_value_t<T>> cdofs
+          = a.coordinate_dofs(IntegralType::cell, i, cell_type_idx);
+      std::span<const std::int32_t> offsets_i;
+      if (offsets)
+        offsets_i = offsets->get().at({IntegralType::cell, i, cell_type_idx});
+      auto assemble = [&](std::optional<std::span<const std::int32_t>> pos)
+      {
+        if (fn_b)
+        {
+          impl::dispatch_batch_size(
+              batch_size,
+              [&]<int W>(std::integral_constant<int, W>)
+              {
+                impl::assemble_cells_batched<T, W>(
+                    mat_set, x_dofmap, x, cells, {dofs0, bs0, cells0}, P0,
+                    {dofs1, bs1, cells1}, P1T, bc0, bc1, fn_b,
+                    md::mdspan(coeffs.data(), cells.size(), cstride),
+                    constants, cell_info0, cell_info1, pos);
+              });
+        }
+        else
+        {
+          impl::dispatch_block_size(
+              bs0, bs1,
+              [&]<int BS0, int BS1>(std::integral_constant<int, BS0>,
+                                    std::integral_constant<int, BS1>)
+              {
+                auto assemble_n = [&]<int N>(std::integral_constant<int, N>)
+                {
+                  impl::assemble_cells<T, BS0, BS1, N, N>(
+                      mat_set, x_dofmap, x, cells, {dofs0, bs0, cells0}, P0,
+                      {dofs1, bs1, cells1}, P1T, bc0, bc1, fn,
+                      md::mdspan(coeffs.data(), cells.size(), cstride),
+                      constants, cell_info0, cell_info1, cdofs, values,
+                      offsets_i, pos);
+                };
+
+                // Compile-time number of dofs for square blocks of
+                // common elements
+                if constexpr (BS0 == BS1 and BS0 > 0 and BS0 <= 3)
+                {
+                  if (dofs0.extent(1) == dofs1.extent(1))
+                    fem::dispatch_num_dofs(dofs0.extent(1), assemble_n);
+                  else
+                    assemble_n(std::integral_constant<int, -1>{});
+                }
+                else
+                  assemble_n(std::integral_constant<int, -1>{});
+              });
+        }
+      };
+
+      if (positions)
+      {
+        assemble(std::span<const std::int32_t>(
+            positions->get().at({IntegralType::cell, i, cell_type_idx})));
+      }
+      else if (num_threads > 1 or a.reproducible())
+      {
+        impl::for_each_colour(a.colouring(IntegralType::cell, i, cell_type_idx),
+                              num_threads, assemble);
+      }
+      else
+        assemble(std::nullopt);
     }
 
     md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms;
@@ -630,11 +1432,57 @@ void assemble_matrix(
       std::span f1 = a.domain_arg(IntegralType::exterior_facet, 1, i, 0);
       mdspanx2_t facets1(f1.data(), f1.size() / 2, 2);
       assert((facets.size() / 2) * cstride == coeffs.size());
-      impl::assemble_exterior_facets(
-          mat_set, x_dofmap, x, facets, {dofs0, bs0, facets0}, P0,
-          {dofs1, bs1, facets1}, P1T, bc0, bc1, fn,
-          md::mdspan(coeffs.data(), facets.extent(0), cstride), constants,
-          cell_info0, cell_info1, perms);
+      auto [fn_b, batch_size]
+          = a.kernel_batch(IntegralType::exterior_facet, i, 0);
+      packed_coordinate_dofs<scalar_value_t<T>> cdofs
+          = a.coordinate_dofs(IntegralType::exterior_facet, i, 0);
+      std::span<const std::int32_t> offsets_i;
+      if (offsets)
+        offsets_i = offsets->get().at({IntegralType::exterior_facet, i, 0});
+      auto assemble = [&](std::optional<std::span<const std::int32_t>> pos)
+      {
+        if (fn_b)
+        {
+          impl::dispatch_batch_size(
+              batch_size,
+              [&]<int W>(std::integral_constant<int, W>)
+              {
+                impl::assemble_exterior_facets_batched<T, W>(
+                    mat_set, x_dofmap, x, facets, {dofs0, bs0, facets0}, P0,
+                    {dofs1, bs1, facets1}, P1T, bc0, bc1, fn_b,
+                    md::mdspan(coeffs.data(), facets.extent(0), cstride),
+                    constants, cell_info0, cell_info1, perms, pos);
+              });
+        }
+        else
+        {
+          impl::dispatch_block_size(
+              bs0, bs1,
+              [&]<int BS0, int BS1>(std::integral_constant<int, BS0>,
+                                    std::integral_constant<int, BS1>)
+              {
+                impl::assemble_exterior_facets<T, BS0, BS1>(
+                    mat_set, x_dofmap, x, facets, {dofs0, bs0, facets0}, P0,
+                    {dofs1, bs1, facets1}, P1T, bc0, bc1, fn,
+                    md::mdspan(coeffs.data(), facets.extent(0), cstride),
+                    constants, cell_info0, cell_info1, perms, cdofs, values,
+                    offsets_i, pos);
+              });
+        }
+      };
+
+      if (positions)
+      {
+        assemble(std::span<const std::int32_t>(
+            positions->get().at({IntegralType::exterior_facet, i, 0})));
+      }
+      else if (num_threads > 1 or a.reproducible())
+      {
+        impl::for_each_colour(a.colouring(IntegralType::exterior_facet, i, 0),
+                              num_threads, assemble);
+      }
+      else
+        assemble(std::nullopt);
     }
 
     for (int i : a.integral_ids(IntegralType::interior_facet))
@@ -661,17 +1509,46 @@ void assemble_matrix(
       std::span facets0 = a.domain_arg(IntegralType::interior_facet, 0, i, 0);
       std::span facets1 = a.domain_arg(IntegralType::interior_facet, 1, i, 0);
       assert((facets.size() / 4) * 2 * cstride == coeffs.size());
-      impl::assemble_interior_facets(
-          mat_set, x_dofmap, x,
-          mdspanx22_t(facets.data(), facets.size() / 4, 2, 2),
-          {*dofmap0, bs0,
-           mdspanx22_t(facets0.data(), facets0.size() / 4, 2, 2)},
-          P0,
-          {*dofmap1, bs1,
-           mdspanx22_t(facets1.data(), facets1.size() / 4, 2, 2)},
-          P1T, bc0, bc1, fn,
-          mdspanx2x_t(coeffs.data(), facets.size() / 4, 2, cstride), constants,
-          cell_info0, cell_info1, perms);
+      packed_coordinate_dofs<scalar_value_t<T>> cdofs
+          = a.coordinate_dofs(IntegralType::interior_facet, i, 0);
+      packed_facet_pairs facet_pairs = a.facet_pairs(i);
+      std::span<const std::int32_t> offsets_i;
+      if (offsets)
+        offsets_i = offsets->get().at({IntegralType::interior_facet, i, 0});
+      auto assemble = [&](std::optional<std::span<const std::int32_t>> pos)
+      {
+        impl::dispatch_block_size(
+            bs0, bs1,
+            [&]<int BS0, int BS1>(std::integral_constant<int, BS0>,
+                                  std::integral_constant<int, BS1>)
+            {
+              impl::assemble_interior_facets<T, BS0, BS1>(
+                  mat_set, x_dofmap, x,
+                  mdspanx22_t(facets.data(), facets.size() / 4, 2, 2),
+                  {*dofmap0, bs0,
+                   mdspanx22_t(facets0.data(), facets0.size() / 4, 2, 2)},
+                  P0,
+                  {*dofmap1, bs1,
+                   mdspanx22_t(facets1.data(), facets1.size() / 4, 2, 2)},
+                  P1T, bc0, bc1, fn,
+                  mdspanx2x_t(coeffs.data(), facets.size() / 4, 2, cstride),
+                  constants, cell_info0, cell_info1, perms, cdofs, values,
+                  offsets_i, pos, facet_pairs);
+            });
+      };
+
+      if (positions)
+      {
+        assemble(std::span<const std::int32_t>(
+            positions->get().at({IntegralType::interior_facet, i, 0})));
+      }
+      else if (num_threads > 1 or a.reproducible())
+      {
+        impl::for_each_colour(a.colouring(IntegralType::interior_facet, i, 0),
+                              num_threads, assemble);
+      }
+      else
+        assemble(std::nullopt);
     }
   }
 }
@@ -0,0 +1,430 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "DofTransformation.h"
+#include "FiniteElement.h"
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "colouring.h"
+#include "traits.h"
+#include <algorithm>
+#include <basix/mdspan.hpp>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/// @file assemble_points.h
+/// @brief Assembly of kernels over vertices and over cells with
+/// quadrature points that are provided at run time.
+///
+/// The functions in this file assemble a kernel over a list of
+/// integration entities without a fem::Form. The entities, the packed
+/// coefficients and the quadrature points can change between calls,
+/// e.g. for moving point sources or for cut cell methods where the
+/// quadrature rules are computed in each time step, without creating
+/// a new form.
+
+namespace dolfinx::fem
+{
+/// @brief Quadrature rule of one integration entity, passed to kernels
+/// through the `custom_data` argument.
+/// @tparam U Geometry type.
+template <std::floating_point U>
+struct quadrature_data
+{
+  /// Number of quadrature points
+  std::int32_t num_points;
+
+  /// Quadrature points on the reference cell, shape `(num_points,
+  /// tdim)`
+  const U* points;
+
+  /// Quadrature weights, shape `(num_points,)`
+  const U* weights;
+};
+
+/// @brief Quadrature rules, with a possibly different number of points,
+/// for a list of integration entities.
+///
+/// The rules are stored in compressed form, with the points and
+/// weights of entity `e` in the range `[offsets[e], offsets[e + 1])`.
+/// @tparam U Geometry type.
+template <std::floating_point U>
+class RuntimeQuadrature
+{
+public:
+  /// @brief Create quadrature rules.
+  /// @param[in] tdim Topological dimension of the reference cell.
+  /// @param[in] offsets Offsets into the points and weights of each
+  /// entity, shape `(num_entities + 1,)`.
+  /// @param[in] points Quadrature points on the reference cell, shape
+  /// `(offsets.back(), tdim)`.
+  /// @param[in] weights Quadrature weights, shape `(offsets.back(),)`.
+  RuntimeQuadrature(std::size_t tdim, std::vector<std::int32_t> offsets,
+                    std::vector<U> points, std::vector<U> weights)
+      : _tdim(tdim), _offsets(std::move(offsets)), _points(std::move(points)),
+        _weights(std::move(weights))
+  {
+    if (_offsets.empty() or _offsets.front() != 0
+        or !std::ranges::is_sorted(_offsets)
+        or _weights.size() != (std::size_t)_offsets.back()
+        or _points.size() != _tdim * _weights.size())
+    {
+      throw std::runtime_error("Inconsistent quadrature rule data.");
+    }
+  }
+
+  /// @brief Number of integration entities.
+  std::size_t num_entities() const { return _offsets.size() - 1; }
+
+  /// @brief Topological dimension of the reference cell.
+  std::size_t tdim() const { return _tdim; }
+
+  /// @brief Quadrature rule of an integration entity.
+  /// @param[in] e Position of the entity in the entity list.
+  quadrature_data<U> operator()(std::size_t e) const
+  {
+    assert(e + 1 < _offsets.size());
+    const std::int32_t p0 = _offsets[e];
+    return {_offsets[e + 1] - p0, _points.data() + _tdim * p0,
+            _weights.data() + p0};
+  }
+
+  /// @brief Offsets of the quadrature rules.
+  std::span<const std::int32_t> offsets() const { return _offsets; }
+
+  /// @brief Quadrature points, shape `(offsets.back(), tdim)`.
+  ///
+  /// The points can be modified in place, e.g. for rules with a fixed
+  /// number of points that move between calls.
+  std::span<U> points() { return _points; }
+
+  /// @brief Quadrature points, shape `(offsets.back(), tdim)`.
+  std::span<const U> points() const { return _points; }
+
+  /// @brief Quadrature weights, shape `(offsets.back(),)`.
+  std::span<U> weights() { return _weights; }
+
+  /// @brief Quadrature weights, shape `(offsets.back(),)`.
+  std::span<const U> weights() const { return _weights; }
+
+private:
+  std::size_t _tdim;
+  std::vector<std::int32_t> _offsets;
+  std::vector<U> _points, _weights;
+};
+
+namespace impl
+{
+/// @brief Cell and local entity index of an integration entity for
+/// point integrals, see assemble_vector_points.
+inline std::pair<std::int32_t, const int*>
+point_entity(IntegralType type, std::span<const std::int32_t> entities,
+             std::size_t e)
+{
+  if (type == IntegralType::cell)
+    return {entities[e], nullptr};
+  else
+    return {entities[2 * e], &entities[2 * e + 1]};
+}
+
+/// @brief Check the arguments of point integral assembly, and return
+/// the number of integration entities.
+template <typename T, std::floating_point U>
+std::size_t check_point_entities(
+    IntegralType type, std::span<const std::int32_t> entities,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
+    std::optional<std::reference_wrapper<const RuntimeQuadrature<U>>>
+        quadrature)
+{
+  if (type != IntegralType::cell and type != IntegralType::vertex)
+  {
+    throw std::runtime_error(
+        "Point assembly supports cell and vertex integrals only.");
+  }
+
+  const std::size_t num_entities
+      = type == IntegralType::cell ? entities.size() : entities.size() / 2;
+  if (coeffs.extent(1) > 0 and coeffs.extent(0) != num_entities)
+    throw std::runtime_error("Coefficient data has the wrong shape.");
+  if (quadrature and quadrature->get().num_entities() != num_entities)
+  {
+    throw std::runtime_error(
+        "Number of quadrature rules and entities do not match.");
+  }
+
+  return num_entities;
+}
+
+/// @brief Cell permutation information of a mesh, if it is required
+/// for the DOF transformations of an element.
+template <std::floating_point U>
+std::span<const std::uint32_t> cell_info(const FunctionSpace<U>& V)
+{
+  assert(V.element());
+  if (!V.element()->needs_dof_transformations())
+    return {};
+  auto mesh = V.mesh();
+  mesh->topology_mutable()->create_entity_permutations();
+  return std::span(mesh->topology()->get_cell_permutation_info());
+}
+
+/// @brief Execute a function over the positions of the integration
+/// entities, concurrently over the colours of the entities if
+/// `num_threads > 1`.
+template <typename F>
+void for_each_point_entity(IntegralType type, const DofMap& dofmap,
+                           std::span<const std::int32_t> entities,
+                           std::size_t num_entities, int num_threads, F&& fn)
+{
+  if (num_threads > 1 and num_entities > 1)
+  {
+    for_each_colour(compute_colouring(type, dofmap.map(), entities),
+                    num_threads, fn);
+  }
+  else
+  {
+    std::vector<std::int32_t> positions(num_entities);
+    std::iota(positions.begin(), positions.end(), 0);
+    fn(std::span<const std::int32_t>(positions));
+  }
+}
+} // namespace impl
+
+/// @brief Assemble a kernel over vertices or over cells with run-time
+/// quadrature rules into a vector.
+///
+/// The kernel is called once for each integration entity with the
+/// coordinate dofs of the cell, the packed coefficients of the entity
+/// and, if `quadrature` is set, a pointer to the
+/// fem::quadrature_data of the entity as the `custom_data` argument.
+/// For vertex integrals the local index of the vertex in the cell is
+/// passed as the local entity index.
+///
+/// @note Entries of `b` are not zeroed. Contributions to ghost entries
+/// are not communicated.
+///
+/// @param[in,out] b Array to accumulate into, with the (blocked)
+/// degrees-of-freedom of `V`.
+/// @param[in] kernel Kernel to execute.
+/// @param[in] V Test function space.
+/// @param[in] type Integral type, IntegralType::cell or
+/// IntegralType::vertex.
+/// @param[in] entities Integration entities. For cell integrals it is
+/// a list of cells, and for vertex integrals a list of `(cell,
+/// local_vertex)` pairs (see fem::compute_integration_domains).
+/// @param[in] constants Packed constants.
+/// @param[in] coeffs Packed coefficients, shape `(num_entities,
+/// num_coeffs)`. Can be empty if the kernel has no coefficients.
+/// @param[in] quadrature Quadrature rule of each entity.
+/// @param[in] num_threads Number of threads. If greater than one, the
+/// entities are coloured (see fem::compute_colouring) and the entities
+/// of each colour are assembled concurrently.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_points(
+    std::span<T> b, FEkernel<T> auto kernel, const FunctionSpace<U>& V,
+    IntegralType type, std::span<const std::int32_t> entities,
+    std::span<const T> constants,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
+    std::optional<std::reference_wrapper<const RuntimeQuadrature<U>>>
+        quadrature
+    = std::nullopt,
+    int num_threads = 1)
+{
+  const std::size_t num_entities
+      = impl::check_point_entities(type, entities, coeffs, quadrature);
+  if (num_entities == 0)
+    return;
+
+  auto mesh = V.mesh();
+  assert(mesh);
+  auto x_dofmap = mesh->geometry().dofmap();
+  std::span<const U> x = mesh->geometry().x();
+  std::shared_ptr<const DofMap> dofmap = V.dofmap();
+  assert(dofmap);
+  const int bs = dofmap->bs();
+  const std::size_t cstride = coeffs.extent(1);
+
+  std::span<const std::uint32_t> cell_info0 = impl::cell_info(V);
+  std::shared_ptr<const DofTransformation<T>> P0_ptr
+      = V.template dof_transformation<T>(0, doftransform::standard, false);
+  const DofTransformation<T>& P0 = *P0_ptr;
+
+  auto assemble = [&](std::span<const std::int32_t> positions)
+  {
+    std::vector<U> cdofs(3 * x_dofmap.extent(1));
+    std::vector<T> be(bs * dofmap->map().extent(1));
+    for (std::int32_t e : positions)
+    {
+      auto [c, local_index] = impl::point_entity(type, entities, e);
+      auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
+      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+        std::copy_n(x.data() + 3 * x_dofs[i], 3, cdofs.data() + 3 * i);
+
+      std::optional<quadrature_data<U>> q;
+      if (quadrature)
+        q = quadrature->get()(e);
+
+      std::ranges::fill(be, 0);
+      kernel(be.data(), coeffs.data_handle() + e * cstride, constants.data(),
+             cdofs.data(), local_index, nullptr, q ? &*q : nullptr);
+      P0(be, cell_info0, c, 1);
+
+      std::span<const std::int32_t> dofs = dofmap->cell_dofs(c);
+      for (std::size_t i = 0; i < dofs.size(); ++i)
+        for (int k = 0; k < bs; ++k)
+          b[bs * dofs[i] + k] += be[bs * i + k];
+    }
+  };
+
+  impl::for_each_point_entity(type, *dofmap, entities, num_entities,
+                              num_threads, assemble);
+}
+
+/// @brief Assemble a kernel over vertices or over cells with run-time
+/// quadrature rules into a matrix.
+///
+/// See assemble_vector_points for the arguments of the kernel.
+/// Boundary condition rows and columns are zeroed, as in
+/// fem::assemble_matrix.
+///
+/// @param[in] mat_set Function that accumulates the values of a block
+/// of rows and columns into the matrix. For `num_threads > 1` it must
+/// be safe to call concurrently for disjoint rows.
+/// @param[in] kernel Kernel to execute.
+/// @param[in] V0 Test function space.
+/// @param[in] V1 Trial function space.
+/// @param[in] type Integral type, IntegralType::cell or
+/// IntegralType::vertex.
+/// @param[in] entities Integration entities (see
+/// assemble_vector_points).
+/// @param[in] constants Packed constants.
+/// @param[in] coeffs Packed coefficients, shape `(num_entities,
+/// num_coeffs)`. Can be empty if the kernel has no coefficients.
+/// @param[in] bc0 Markers of the (blocked) test function
+/// degrees-of-freedom with boundary conditions. Can be empty.
+/// @param[in] bc1 Markers of the (blocked) trial function
+/// degrees-of-freedom with boundary conditions. Can be empty.
+/// @param[in] quadrature Quadrature rule of each entity.
+/// @param[in] num_threads Number of threads (see
+/// assemble_vector_points).
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_points(
+    la::MatSet<T> auto mat_set, FEkernel<T> auto kernel,
+    const FunctionSpace<U>& V0, const FunctionSpace<U>& V1,
+    IntegralType type, std::span<const std::int32_t> entities,
+    std::span<const T> constants,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1,
+    std::optional<std::reference_wrapper<const RuntimeQuadrature<U>>>
+        quadrature
+    = std::nullopt,
+    int num_threads = 1)
+{
+  const std::size_t num_entities
+      = impl::check_point_entities(type, entities, coeffs, quadrature);
+  if (num_entities == 0)
+    return;
+
+  auto mesh = V0.mesh();
+  assert(mesh);
+  if (V1.mesh() != mesh)
+    throw std::runtime_error("Function spaces must be on the same mesh.");
+  auto x_dofmap = mesh->geometry().dofmap();
+  std::span<const U> x = mesh->geometry().x();
+  std::shared_ptr<const DofMap> dofmap0 = V0.dofmap();
+  std::shared_ptr<const DofMap> dofmap1 = V1.dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  const int bs0 = dofmap0->bs();
+  const int bs1 = dofmap1->bs();
+  const std::size_t cstride = coeffs.extent(1);
+
+  std::span<const std::uint32_t> cell_info0 = impl::cell_info(V0);
+  std::span<const std::uint32_t> cell_info1 = impl::cell_info(V1);
+  std::shared_ptr<const DofTransformation<T>> P0_ptr
+      = V0.template dof_transformation<T>(0, doftransform::standard, false);
+  std::shared_ptr<const DofTransformation<T>> P1T_ptr
+      = V1.template dof_transformation<T>(0, doftransform::transpose, true);
+  const DofTransformation<T>& P0 = *P0_ptr;
+  const DofTransformation<T>& P1T = *P1T_ptr;
+
+  auto assemble = [&](std::span<const std::int32_t> positions)
+  {
+    const std::size_t ndim0 = bs0 * dofmap0->map().extent(1);
+    const std::size_t ndim1 = bs1 * dofmap1->map().extent(1);
+    std::vector<U> cdofs(3 * x_dofmap.extent(1));
+    std::vector<T> Ae(ndim0 * ndim1);
+    for (std::int32_t e : positions)
+    {
+      auto [c, local_index] = impl::point_entity(type, entities, e);
+      auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
+      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+        std::copy_n(x.data() + 3 * x_dofs[i], 3, cdofs.data() + 3 * i);
+
+      std::optional<quadrature_data<U>> q;
+      if (quadrature)
+        q = quadrature->get()(e);
+
+      std::ranges::fill(Ae, 0);
+      kernel(Ae.data(), coeffs.data_handle() + e * cstride, constants.data(),
+             cdofs.data(), local_index, nullptr, q ? &*q : nullptr);
+      P0(Ae, cell_info0, c, ndim1);
+      P1T(Ae, cell_info1, c, ndim0);
+
+      // Zero rows and columns with boundary conditions
+      std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(c);
+      std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(c);
+      if (!bc0.empty())
+      {
+        for (std::size_t i = 0; i < dofs0.size(); ++i)
+        {
+          for (int k = 0; k < bs0; ++k)
+          {
+            if (bc0[bs0 * dofs0[i] + k])
+              std::fill_n(Ae.data() + (bs0 * i + k) * ndim1, ndim1, T(0));
+          }
+        }
+      }
+      if (!bc1.empty())
+      {
+        for (std::size_t j = 0; j < dofs1.size(); ++j)
+        {
+          for (int k = 0; k < bs1; ++k)
+          {
+            if (bc1[bs1 * dofs1[j] + k])
+            {
+              for (std::size_t i = 0; i < ndim0; ++i)
+                Ae[i * ndim1 + bs1 * j + k] = 0;
+            }
+          }
+        }
+      }
+
+      mat_set(dofs0, dofs1, Ae);
+    }
+  };
+
+  impl::for_each_point_entity(type, *dofmap0, entities, num_entities,
+                              num_threads, assemble);
+}
+} // namespace dolfinx::fem
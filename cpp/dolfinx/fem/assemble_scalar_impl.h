@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <basix/mdspan.hpp>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
@@ -21,6 +22,86 @@
 
 namespace dolfinx::fem::impl
 {
+/// @brief Number of entities whose contributions are summed into one
+/// partial sum by assemble_scalar.
+///
+/// The partitioning of the entities into blocks does not depend on the
+/// number of threads, so that the assembled value is independent of
+/// the number of threads.
+constexpr std::size_t scalar_block_size = 1024;
+
+/// @brief Compensated (Kahan) accumulator.
+template <dolfinx::scalar T>
+struct compensated_sum
+{
+  /// @brief Add `v` to the sum.
+  void add(T v)
+  {
+    T y = v - c;
+    T t = sum + y;
+    c = (t - sum) - y;
+    sum = t;
+  }
+
+  /// Sum
+  T sum = 0;
+
+  /// Running compensation for lost low-order bits
+  T c = 0;
+};
+
+/// @brief Sum values using pairwise (tree) summation.
+///
+/// The rounding error grows as `O(log n)` rather than `O(n)` for
+/// sequential summation.
+template <dolfinx::scalar T>
+T pairwise_sum(std::span<const T> x)
+{
+  if (x.size() <= 8)
+  {
+    T value = 0;
+    for (T v : x)
+      value += v;
+    return value;
+  }
+  else
+  {
+    std::size_t m = x.size() / 2;
+    return pairwise_sum(x.first(m)) + pairwise_sum(x.subspan(m));
+  }
+}
+
+/// @brief Sum the contributions of `n` entities.
+///
+/// The entities are divided into blocks of scalar_block_size entities.
+/// The partial sums of the blocks are computed concurrently and then
+/// summed pairwise.
+///
+/// @param[in] n Number of entities.
+/// @param[in] num_threads Number of threads.
+/// @param[in] fn Function with signature `T(std::size_t i0, std::size_t
+/// i1)` that returns the sum of the contributions of entities `[i0,
+/// i1)`.
+/// @return Sum of the contributions.
+template <dolfinx::scalar T, typename F>
+T reduce_blocks(std::size_t n, int num_threads, F&& fn)
+{
+  const std::size_t num_blocks
+      = (n + scalar_block_size - 1) / scalar_block_size;
+  std::vector<T> partial(num_blocks, 0);
+  common::parallel_for(num_blocks, num_threads,
+                       [&](std::size_t b0, std::size_t b1)
+                       {
+                         for (std::size_t b = b0; b < b1; ++b)
+                         {
+                           std::size_t i0 = b * scalar_block_size;
+                           std::size_t i1 = std::min(i0 + scalar_block_size, n);
+                           partial[b] = fn(i0, i1);
+                         }
+                       });
+  return pairwise_sum(std::span<const T>(partial));
+}
+
 /// Assemble functional over cells
 template <dolfinx::scalar T>
 T assemble_cells(mdspan2_t x_dofmap,
@@ -31,9 +112,9 @@ T assemble_cells(mdspan2_t x_dofmap,
                  std::span<const T> constants,
                  md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs)
 {
-  T value(0);
+  compensated_sum<T> value;
   if (cells.empty())
-    return value;
+    return value.sum;
 
   // Create data structures used in assembly
   std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1));
@@ -45,16 +126,15 @@ T assemble_cells(mdspan2_t x_dofmap,
 
     // Get cell coordinates/geometry
     auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(&x(x_dofs[i], 0), 3, std::next(cdofs.begin(), 3 * i));
-    }
+    gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
 
-    fn(&value, &coeffs(index, 0), constants.data(), cdofs.data(), nullptr,
+    T v(0);
+    fn(&v, &coeffs(index, 0), constants.data(), cdofs.data(), nullptr,
        nullptr, nullptr);
+    value.add(v);
   }
 
-  return value;
+  return value.sum;
 }
 
 /// Execute kernel over exterior facets and accumulate result
@@ -71,9 +151,9 @@ T assemble_exterior_facets(
     md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
     md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms)
 {
-  T value(0);
+  compensated_sum<T> value;
   if (facets.empty())
-    return value;
+    return value.sum;
 
   // Create data structures used in assembly
   std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1));
@@ -86,16 +166,17 @@ T assemble_exterior_facets(
 
     // Get cell coordinates/geometry
     auto x_dofs = md::submdspan(x_dofmap, cell, md::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-      std::copy_n(&x(x_dofs[i], 0), 3, std::next(cdofs.begin(), 3 * i));
+    gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
 
     // Permutations
     std::uint8_t perm = perms.empty() ? 0 : perms(cell, local_facet);
-    fn(&value, &coeffs(f, 0), constants.data(), cdofs.data(), &local_facet,
-       &perm, nullptr);
+    T v(0);
+    fn(&v, &coeffs(f, 0), constants.data(), cdofs.data(), &local_facet, &perm,
+       nullptr);
+    value.add(v);
   }
 
-  return value;
+  return value.sum;
 }
 
 /// Assemble functional over interior facets
@@ -114,9 +195,9 @@ T assemble_interior_facets(
         coeffs,
     md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms)
 {
-  T value(0);
+  compensated_sum<T> value;
   if (facets.empty())
-    return value;
+    return value.sum;
 
   // Create data structures used in assembly
   using X = scalar_value_t<T>;
@@ -133,24 +214,30 @@ T assemble_interior_facets(
 
     // Get cell geometry
     auto x_dofs0 = md::submdspan(x_dofmap, cells[0], md::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
-      std::copy_n(&x(x_dofs0[i], 0), 3, std::next(cdofs0.begin(), 3 * i));
+    gather_coordinate_dofs(cdofs0, x_dofs0, x);
     auto x_dofs1 = md::submdspan(x_dofmap, cells[1], md::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
-      std::copy_n(&x(x_dofs1[i], 0), 3, std::next(cdofs1.begin(), 3 * i));
+    gather_coordinate_dofs(cdofs1, x_dofs1, x);
 
     std::array perm = perms.empty()
                           ? std::array<std::uint8_t, 2>{0, 0}
                           : std::array{perms(cells[0], local_facet[0]),
                                        perms(cells[1], local_facet[1])};
-    fn(&value, &coeffs(f, 0, 0), constants.data(), cdofs.data(),
+    T v(0);
+    fn(&v, &coeffs(f, 0, 0), constants.data(), cdofs.data(),
        local_facet.data(), perm.data(), nullptr);
+    value.add(v);
   }
 
-  return value;
+  return value.sum;
 }
 
-/// Assemble functional into an scalar with provided mesh geometry.
+/// @brief Assemble functional into an scalar with provided mesh
+/// geometry.
+///
+/// The contributions of each integral are summed in blocks of entities
+/// (see reduce_blocks) using compensated summation within a block, and
+/// the block sums are summed pairwise. The result does not depend on
+/// `num_threads`.
 template <dolfinx::scalar T, std::floating_point U>
 T assemble_scalar(
     const fem::Form<T, U>& M, mdspan2_t x_dofmap,
@@ -159,12 +246,13 @@ T assemble_scalar(
         x,
     std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
-                   std::pair<std::span<const T>, int>>& coefficients)
+                   std::pair<std::span<const T>, int>>& coefficients,
+    int num_threads = 1)
 {
   std::shared_ptr<const mesh::Mesh<U>> mesh = M.mesh();
   assert(mesh);
 
-  T value = 0;
+  compensated_sum<T> value;
   for (int i : M.integral_ids(IntegralType::cell))
   {
     auto fn = M.kernel(IntegralType::cell, i, 0);
@@ -172,9 +260,14 @@ T assemble_scalar(
     auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
     std::span<const std::int32_t> cells = M.domain(IntegralType::cell, i, 0);
     assert(cells.size() * cstride == coeffs.size());
-    value += impl::assemble_cells(
-        x_dofmap, x, cells, fn, constants,
-        md::mdspan(coeffs.data(), cells.size(), cstride));
+    value.add(reduce_blocks<T>(
+        cells.size(), num_threads,
+        [&](std::size_t i0, std::size_t i1)
+        {
+          return impl::assemble_cells(
+              x_dofmap, x, cells.subspan(i0, i1 - i0), fn, constants,
+              md::mdspan(coeffs.data() + i0 * cstride, i1 - i0, cstride));
+        }));
   }
 
   mesh::CellType cell_type = mesh->topology()->cell_type();
@@ -199,13 +292,19 @@ T assemble_scalar(
 
     std::span facets = M.domain(IntegralType::exterior_facet, i, 0);
     assert((facets.size() / 2) * cstride == coeffs.size());
-    value += impl::assemble_exterior_facets(
-        x_dofmap, x,
-        md::mdspan<const std::int32_t,
-                   md::extents<std::size_t, md::dynamic_extent, 2>>(
-            facets.data(), facets.size() / 2, 2),
-        fn, constants, md::mdspan(coeffs.data(), facets.size() / 2, cstride),
-        perms);
+    value.add(reduce_blocks<T>(
+        facets.size() / 2, num_threads,
+        [&](std::size_t i0, std::size_t i1)
+        {
+          return impl::assemble_exterior_facets(
+              x_dofmap, x,
+              md::mdspan<const std::int32_t,
+                         md::extents<std::size_t, md::dynamic_extent, 2>>(
+                  facets.data() + 2 * i0, i1 - i0, 2),
+              fn, constants,
+              md::mdspan(coeffs.data() + i0 * cstride, i1 - i0, cstride),
+              perms);
+        }));
   }
 
   for (int i : M.integral_ids(IntegralType::interior_facet))
@@ -216,19 +315,24 @@ T assemble_scalar(
         = coefficients.at({IntegralType::interior_facet, i});
     std::span facets = M.domain(IntegralType::interior_facet, i, 0);
     assert((facets.size() / 4) * 2 * cstride == coeffs.size());
-    value += impl::assemble_interior_facets(
-        x_dofmap, x,
-        md::mdspan<const std::int32_t,
-                   md::extents<std::size_t, md::dynamic_extent, 2, 2>>(
-            facets.data(), facets.size() / 4, 2, 2),
-        fn, constants,
-        md::mdspan<const T, md::extents<std::size_t, md::dynamic_extent, 2,
-                                        md::dynamic_extent>>(
-            coeffs.data(), facets.size() / 4, 2, cstride),
-        perms);
+    value.add(reduce_blocks<T>(
+        facets.size() / 4, num_threads,
+        [&](std::size_t i0, std::size_t i1)
+        {
+          return impl::assemble_interior_facets(
+              x_dofmap, x,
+              md::mdspan<const std::int32_t,
+                         md::extents<std::size_t, md::dynamic_extent, 2, 2>>(
+                  facets.data() + 4 * i0, i1 - i0, 2, 2),
+              fn, constants,
+              md::mdspan<const T, md::extents<std::size_t, md::dynamic_extent,
+                                              2, md::dynamic_extent>>(
+                  coeffs.data() + 2 * i0 * cstride, i1 - i0, 2, cstride),
+              perms);
+        }));
   }
 
-  return value;
+  return value.sum;
 }
 
 } // namespace dolfinx::fem::impl
@@ -9,20 +9,27 @@
 #include "Constant.h"
 #include "DirichletBC.h"
 #include "DofMap.h"
+#include "DofTransformation.h"
 #include "Form.h"
+#include "batch.h"
+#include "colouring.h"
 #include "traits.h"
 #include "utils.h"
 #include <algorithm>
 #include <basix/mdspan.hpp>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Workspace.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <functional>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <span>
+#include <tuple>
 #include <vector>
 
 namespace dolfinx::fem
@@ -76,6 +83,10 @@ using mdspan2_t = md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>>;
 /// conditions applied.
 /// @param[in] x0 Vector used in the lifting.
 /// @param[in] alpha Scaling to apply.
+/// @param[in] positions Positions in `cells` of the cells to execute
+/// the kernel over, e.g. the cells attached to a cell with a
+/// boundary condition applied. If not set, the kernel is executed over
+/// all cells in `cells`.
 template <dolfinx::scalar T, int _bs0 = -1, int _bs1 = -1>
 void _lift_bc_cells(
     std::span<T> b, mdspan2_t x_dofmap,
@@ -90,7 +101,8 @@ void _lift_bc_cells(
     md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
     std::span<const std::uint32_t> cell_info0,
     std::span<const std::uint32_t> cell_info1, std::span<const T> bc_values1,
-    std::span<const std::int8_t> bc_markers1, std::span<const T> x0, T alpha)
+    std::span<const std::int8_t> bc_markers1, std::span<const T> x0, T alpha,
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
 {
   if (cells.empty())
     return;
@@ -105,8 +117,11 @@ void _lift_bc_cells(
   std::vector<T> Ae, be;
   assert(cells0.size() == cells.size());
   assert(cells1.size() == cells.size());
-  for (std::size_t index = 0; index < cells.size(); ++index)
+  const std::size_t num_cells = positions ? positions->size() : cells.size();
+  for (std::size_t p = 0; p < num_cells; ++p)
   {
+    const std::size_t index = positions ? (*positions)[p] : p;
+
     // Cell index in integration domain mesh, test function mesh, and trial
     // function mesh
     std::int32_t c = cells[index];
@@ -151,8 +166,7 @@ void _lift_bc_cells(
 
     // Get cell coordinates/geometry
     auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-      std::copy_n(&x(x_dofs[i], 0), 3, std::next(cdofs.begin(), 3 * i));
+    gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
 
     // Size data structure for assembly
     auto dofs0 = md::submdspan(dmap0, c0, md::full_extent);
@@ -260,6 +274,10 @@ void _lift_bc_cells(
 /// local_facet_idx)` is the permutation value for the facet attached to
 /// the cell `cell_idx` with local index `local_facet_idx` relative to
 /// the cell. Empty if facet permutations are not required.
+/// @param[in] positions Positions in `facets` of the facets to execute
+/// the kernel over, e.g. the facets attached to a cell with a
+/// boundary condition applied. If not set, the kernel is executed over
+/// all facets in `facets`.
 template <dolfinx::scalar T>
 void _lift_bc_exterior_facets(
     std::span<T> b, mdspan2_t x_dofmap,
@@ -284,7 +302,8 @@ void _lift_bc_exterior_facets(
     std::span<const std::uint32_t> cell_info0,
     std::span<const std::uint32_t> cell_info1, std::span<const T> bc_values1,
     std::span<const std::int8_t> bc_markers1, std::span<const T> x0, T alpha,
-    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms)
+    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms,
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
 {
   if (facets.empty())
     return;
@@ -297,8 +316,12 @@ void _lift_bc_exterior_facets(
   std::vector<T> Ae, be;
   assert(facets0.size() == facets.size());
   assert(facets1.size() == facets.size());
-  for (std::size_t index = 0; index < facets.extent(0); ++index)
+  const std::size_t num_facets
+      = positions ? positions->size() : facets.extent(0);
+  for (std::size_t p = 0; p < num_facets; ++p)
   {
+    const std::size_t index = positions ? (*positions)[p] : p;
+
     // Cell in integration domain, test function and trial function
     // meshes
     std::int32_t cell = facets(index, 0);
@@ -330,8 +353,7 @@ void _lift_bc_exterior_facets(
 
     // Get cell coordinates/geometry
     auto x_dofs = md::submdspan(x_dofmap, cell, md::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-      std::copy_n(&x(x_dofs[i], 0), 3, std::next(cdofs.begin(), 3 * i));
+    gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
 
     // Size data structure for assembly
     auto dofs0 = md::submdspan(dmap0, cell0, md::full_extent);
@@ -414,6 +436,10 @@ void _lift_bc_exterior_facets(
 /// local_facet_idx)` is the permutation value for the facet attached to
 /// the cell `cell_idx` with local index `local_facet_idx` relative to
 /// the cell. Empty if facet permutations are not required.
+/// @param[in] positions Positions in `facets` of the facets to execute
+/// the kernel over, e.g. the facets attached to a cell with a
+/// boundary condition applied. If not set, the kernel is executed over
+/// all facets in `facets`.
 template <dolfinx::scalar T>
 void _lift_bc_interior_facets(
     std::span<T> b, mdspan2_t x_dofmap,
@@ -440,7 +466,8 @@ void _lift_bc_interior_facets(
     std::span<const std::uint32_t> cell_info0,
     std::span<const std::uint32_t> cell_info1, std::span<const T> bc_values1,
     std::span<const std::int8_t> bc_markers1, std::span<const T> x0, T alpha,
-    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms)
+    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms,
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
 {
   if (facets.empty())
     return;
@@ -463,8 +490,12 @@ void _lift_bc_interior_facets(
   const int num_dofs1 = dmap1.extent(1);
   assert(facets0.size() == facets.size());
   assert(facets1.size() == facets.size());
-  for (std::size_t f = 0; f < facets.extent(0); ++f)
+  const std::size_t num_facets
+      = positions ? positions->size() : facets.extent(0);
+  for (std::size_t p = 0; p < num_facets; ++p)
   {
+    const std::size_t f = positions ? (*positions)[p] : p;
+
     // Cells in integration domain, test function domain and trial
     // function domain meshes
     std::array cells{facets(f, 0, 0), facets(f, 1, 0)};
@@ -476,11 +507,9 @@ void _lift_bc_interior_facets(
 
     // Get cell geometry
     auto x_dofs0 = md::submdspan(x_dofmap, cells[0], md::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
-      std::copy_n(&x(x_dofs0[i], 0), 3, std::next(cdofs0.begin(), 3 * i));
+    gather_coordinate_dofs(cdofs0, x_dofs0, x);
     auto x_dofs1 = md::submdspan(x_dofmap, cells[1], md::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
-      std::copy_n(&x(x_dofs1[i], 0), 3, std::next(cdofs1.begin(), 3 * i));
+    gather_coordinate_dofs(cdofs1, x_dofs1, x);
 
     // Get dof maps for cells and pack
     std::span dmap0_cell0(dmap0.data_handle() + cells0[0] * num_dofs0,
@@ -622,6 +651,9 @@ void _lift_bc_interior_facets(
 /// than zero the block size is determined at runtime. If `_bs` is
 /// positive the block size is used as a compile-time constant, which
 /// has performance benefits.
+/// @tparam _num_dofs Number of dofs per cell of the test function dof
+/// map. If less than zero it is determined at runtime, otherwise it is
+/// used as a compile-time constant (see fem::dispatch_num_dofs).
 /// @param[in] P0 Function that applies transformation `P0.b` in-place
 /// to `b` to transform test degrees-of-freedom.
 /// @param[in,out] b Aray to accumulate into.
@@ -638,7 +670,14 @@ void _lift_bc_interior_facets(
 /// coefficient for cell `i`.
 /// @param[in] cell_info0 Cell permutation information for the test
 /// function mesh.
-template <dolfinx::scalar T, int _bs = -1>
+/// @param[in] coordinate_dofs Packed coordinate dofs of the cells,
+/// with the coordinate dofs of entity `i` starting at `i * n`, where
+/// `n` is the number of coordinate dof entries per entity. If empty,
+/// the coordinate dofs are gathered from `x`.
+/// @param[in] positions Positions in `cells` of the cells to execute
+/// the kernel over. If not set, the kernel is executed over all cells
+/// in `cells`.
+template <dolfinx::scalar T, int _bs = -1, int _num_dofs = -1>
 void assemble_cells(
     fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
     md::mdspan<const scalar_value_t<T>,
@@ -648,39 +687,57 @@ void assemble_cells(
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
     FEkernel<T> auto kernel, std::span<const T> constants,
     md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
-    std::span<const std::uint32_t> cell_info0)
+    std::span<const std::uint32_t> cell_info0,
+    packed_coordinate_dofs<scalar_value_t<T>> coordinate_dofs = {},
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
 {
   if (cells.empty())
     return;
 
   const auto [dmap, bs, cells0] = dofmap;
   assert(_bs < 0 or _bs == bs);
+  assert(_num_dofs < 0 or _num_dofs == (int)dmap.extent(1));
 
-  // Create data structures used in assembly
-  std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1));
-  std::vector<T> be(bs * dmap.extent(1));
+  // Number of dofs per cell, as a compile-time constant if available
+  constexpr std::size_t N = _num_dofs > 0 ? _num_dofs : md::dynamic_extent;
+  const int num_dofs = _num_dofs > 0 ? _num_dofs : dmap.extent(1);
+
+  // Create data structures used in assembly (scratch arrays)
+  common::Workspace& ws = common::Workspace::local();
+  common::Workspace::Scope scope(ws);
+  std::span cdofs = ws.allocate<scalar_value_t<T>>(3 * x_dofmap.extent(1));
+  std::span<T> be = ws.allocate<T>(bs * num_dofs);
   std::span<T> _be(be);
 
   // Iterate over active cells
-  for (std::size_t index = 0; index < cells.size(); ++index)
+  const std::size_t num_cells = positions ? positions->size() : cells.size();
+  for (std::size_t p = 0; p < num_cells; ++p)
   {
+    const std::size_t index = positions ? (*positions)[p] : p;
+
     // Integration domain celland test function cell
     std::int32_t c = cells[index];
     std::int32_t c0 = cells0[index];
 
     // Get cell coordinates/geometry
-    auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-      std::copy_n(&x(x_dofs[i], 0), 3, std::next(cdofs.begin(), 3 * i));
+    const scalar_value_t<T>* cdofs_e = cdofs.data();
+    if (!coordinate_dofs.empty())
+      cdofs_e = coordinate_dofs.get(index, cdofs);
+    else
+    {
+      auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
+      gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
+    }
 
     // Tabulate vector for cell
     std::ranges::fill(be, 0);
-    kernel(be.data(), &coeffs(index, 0), constants.data(), cdofs.data(),
-           nullptr, nullptr, nullptr);
+    kernel(be.data(), &coeffs(index, 0), constants.data(), cdofs_e, nullptr,
+           nullptr, nullptr);
     P0(_be, cell_info0, c0, 1);
 
     // Scatter cell vector to 'global' vector array
-    auto dofs = md::submdspan(dmap, c0, md::full_extent);
+    std::span<const std::int32_t, N> dofs(
+        dmap.data_handle() + c0 * num_dofs, num_dofs);
     if constexpr (_bs > 0)
     {
       for (std::size_t i = 0; i < dofs.size(); ++i)
@@ -720,6 +777,13 @@ void assemble_cells(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
+/// @param[in] coordinate_dofs Packed coordinate dofs of the facets,
+/// with the coordinate dofs of entity `i` starting at `i * n`, where
+/// `n` is the number of coordinate dof entries per entity. If empty,
+/// the coordinate dofs are gathered from `x`.
+/// @param[in] positions Positions in `facets` of the facets to execute
+/// the kernel over. If not set, the kernel is executed over all facets
+/// in `facets`.
 template <dolfinx::scalar T, int _bs = -1>
 void assemble_exterior_facets(
     fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
@@ -736,7 +800,9 @@ void assemble_exterior_facets(
     FEkernel<T> auto fn, std::span<const T> constants,
     md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
     std::span<const std::uint32_t> cell_info0,
-    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms)
+    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms,
+    packed_coordinate_dofs<scalar_value_t<T>> coordinate_dofs = {},
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
 {
   if (facets.empty())
     return;
@@ -744,14 +810,20 @@ void assemble_exterior_facets(
   const auto [dmap, bs, facets0] = dofmap;
   assert(_bs < 0 or _bs == bs);
 
-  // Create data structures used in assembly
+  // Create data structures used in assembly (scratch arrays)
   const int num_dofs = dmap.extent(1);
-  std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1));
-  std::vector<T> be(bs * num_dofs);
+  common::Workspace& ws = common::Workspace::local();
+  common::Workspace::Scope scope(ws);
+  std::span cdofs = ws.allocate<scalar_value_t<T>>(3 * x_dofmap.extent(1));
+  std::span<T> be = ws.allocate<T>(bs * num_dofs);
   std::span<T> _be(be);
   assert(facets0.size() == facets.size());
-  for (std::size_t f = 0; f < facets.extent(0); ++f)
+  const std::size_t num_facets
+      = positions ? positions->size() : facets.extent(0);
+  for (std::size_t p = 0; p < num_facets; ++p)
   {
+    const std::size_t f = positions ? (*positions)[p] : p;
+
     // Cell in the integration domain, local facet index relative to the
     // integration domain cell, and cell in the test function mesh
     std::int32_t cell = facets(f, 0);
@@ -759,16 +831,21 @@ void assemble_exterior_facets(
     std::int32_t cell0 = facets0(f, 0);
 
     // Get cell coordinates/geometry
-    auto x_dofs = md::submdspan(x_dofmap, cell, md::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-      std::copy_n(&x(x_dofs[i], 0), 3, std::next(cdofs.begin(), 3 * i));
+    const scalar_value_t<T>* cdofs_e = cdofs.data();
+    if (!coordinate_dofs.empty())
+      cdofs_e = coordinate_dofs.get(f, cdofs);
+    else
+    {
+      auto x_dofs = md::submdspan(x_dofmap, cell, md::full_extent);
+      gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
+    }
 
     // Permutations
     std::uint8_t perm = perms.empty() ? 0 : perms(cell, local_facet);
 
     // Tabulate element vector
     std::ranges::fill(be, 0);
-    fn(be.data(), &coeffs(f, 0), constants.data(), cdofs.data(), &local_facet,
+    fn(be.data(), &coeffs(f, 0), constants.data(), cdofs_e, &local_facet,
        &perm, nullptr);
 
     P0(_be, cell_info0, cell0, 1);
@@ -790,6 +867,222 @@ void assemble_exterior_facets(
   }
 }
 
+/// @brief Execute a batched kernel over cells and accumulate result in
+/// vector.
+///
+/// Cells are processed in batches of `W`, with the geometry and
+/// coefficients of each batch packed in a structure-of-arrays layout
+/// (see integral_data::kernel_batch).
+///
+/// @tparam T Scalar type.
+/// @tparam W Batch size (number of cells per kernel call).
+/// @tparam _bs Block size of the form test function dof map. If less
+/// than zero the block size is determined at runtime.
+/// @param[in] P0 Function that applies transformation `P0.b` in-place
+/// to `b` to transform test degrees-of-freedom.
+/// @param[in,out] b Aray to accumulate into.
+/// @param[in] x_dofmap Dofmap for the mesh geometry.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] cells Cell indices to execute the kernel over. These are
+/// the indices into the geometry dofmap.
+/// @param[in] dofmap Test function (row) degree-of-freedom data holding
+/// the (0) dofmap, (1) dofmap block size and (2) dofmap cell indices.
+/// @param[in] kernel Batched kernel function.
+/// @param[in] constants Constant coefficient data in the kernel.
+/// @param[in] coeffs Coefficient data in the kernel. It has shape
+/// `(cells.size(), num_cell_coeffs)`.
+/// @param[in] cell_info0 Cell permutation information for the test
+/// function mesh.
+/// @param[in] positions Positions in `cells` of the cells to execute
+/// the kernel over. If not set, the kernel is executed over all cells
+/// in `cells`.
+template <dolfinx::scalar T, int W, int _bs = -1>
+void assemble_cells_batched(
+    fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
+    md::mdspan<const scalar_value_t<T>,
+               md::extents<std::size_t, md::dynamic_extent, 3>>
+        x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
+    FEkernel<T> auto kernel, std::span<const T> constants,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
+    std::span<const std::uint32_t> cell_info0,
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
+{
+  if (cells.empty())
+    return;
+
+  const auto [dmap, bs, cells0] = dofmap;
+  assert(_bs < 0 or _bs == bs);
+
+  // Create data structures used in assembly
+  std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1) * W);
+  std::vector<T> coeffs_b(coeffs.extent(1) * W);
+  std::vector<T> be_b(bs * dmap.extent(1) * W);
+  std::vector<T> be(bs * dmap.extent(1));
+  std::span<T> _be(be);
+
+  // Iterate over batches of active cells
+  const std::size_t num_cells = positions ? positions->size() : cells.size();
+  for (std::size_t p0 = 0; p0 < num_cells; p0 += W)
+  {
+    auto [index, num_lanes] = batch_positions<W>(p0, num_cells, positions);
+
+    // Pack cell geometry and coefficients for the batch
+    std::array<std::int32_t, W> c;
+    for (int w = 0; w < W; ++w)
+      c[w] = cells[index[w]];
+    pack_coordinate_dofs_batch<W>(std::span(cdofs), x_dofmap, x,
+                                  std::span<const std::int32_t, W>(c));
+    pack_coefficients_batch<W>(std::span(coeffs_b), coeffs,
+                               std::span<const std::size_t, W>(index));
+
+    // Tabulate vectors for batch
+    std::ranges::fill(be_b, 0);
+    kernel(be_b.data(), coeffs_b.data(), constants.data(), cdofs.data(),
+           nullptr, nullptr, nullptr);
+
+    for (int w = 0; w < num_lanes; ++w)
+    {
+      std::int32_t c0 = cells0[index[w]];
+      extract_batch_lane<W>(_be, std::span<const T>(be_b), w);
+      P0(_be, cell_info0, c0, 1);
+
+      // Scatter cell vector to 'global' vector array
+      auto dofs = md::submdspan(dmap, c0, md::full_extent);
+      if constexpr (_bs > 0)
+      {
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int k = 0; k < _bs; ++k)
+            b[_bs * dofs[i] + k] += be[_bs * i + k];
+      }
+      else
+      {
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int k = 0; k < bs; ++k)
+            b[bs * dofs[i] + k] += be[bs * i + k];
+      }
+    }
+  }
+}
+
+/// @brief Execute a batched kernel over exterior facets and accumulate
+/// result in vector.
+///
+/// Facets are processed in batches of `W`, with the geometry,
+/// coefficients, local facet indices and permutations of each batch
+/// packed in a structure-of-arrays layout (see
+/// integral_data::kernel_batch).
+///
+/// @tparam T Scalar type.
+/// @tparam W Batch size (number of facets per kernel call).
+/// @tparam _bs The block size of the form test function dof map. If
+/// less than zero the block size is determined at runtime.
+/// @param P0 Function that applies transformation `P0.b` in-place to
+/// transform test degrees-of-freedom.
+/// @param[in,out] b The vector to accumulate into.
+/// @param[in] x_dofmap Dofmap for the mesh geometry.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] facets Facets (in the integration domain mesh) to execute
+/// the kernel over.
+/// @param[in] dofmap Test function (row) degree-of-freedom data holding
+/// the (0) dofmap, (1) dofmap block size and (2) dofmap cell indices.
+/// @param[in] fn Batched kernel function.
+/// @param[in] constants The constant data.
+/// @param[in] coeffs The coefficient data array of shape
+/// `(facets.extent(0), coeffs_per_facet)`.
+/// @param[in] cell_info0 The cell permutation information for the test
+/// function mesh.
+/// @param[in] perms Facet permutation integer. Empty if facet
+/// permutations are not required.
+/// @param[in] positions Positions in `facets` of the facets to execute
+/// the kernel over. If not set, the kernel is executed over all facets
+/// in `facets`.
+template <dolfinx::scalar T, int W, int _bs = -1>
+void assemble_exterior_facets_batched(
+    fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
+    md::mdspan<const scalar_value_t<T>,
+               md::extents<std::size_t, md::dynamic_extent, 3>>
+        x,
+    md::mdspan<const std::int32_t,
+               std::extents<std::size_t, md::dynamic_extent, 2>>
+        facets,
+    std::tuple<mdspan2_t, int,
+               md::mdspan<const std::int32_t,
+                          std::extents<std::size_t, md::dynamic_extent, 2>>>
+        dofmap,
+    FEkernel<T> auto fn, std::span<const T> constants,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
+    std::span<const std::uint32_t> cell_info0,
+    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms,
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt)
+{
+  if (facets.empty())
+    return;
+
+  const auto [dmap, bs, facets0] = dofmap;
+  assert(_bs < 0 or _bs == bs);
+
+  // Create data structures used in assembly
+  const int num_dofs = dmap.extent(1);
+  std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1) * W);
+  std::vector<T> coeffs_b(coeffs.extent(1) * W);
+  std::vector<T> be_b(bs * num_dofs * W);
+  std::vector<T> be(bs * num_dofs);
+  std::span<T> _be(be);
+  assert(facets0.size() == facets.size());
+  const std::size_t num_facets
+      = positions ? positions->size() : facets.extent(0);
+  for (std::size_t p0 = 0; p0 < num_facets; p0 += W)
+  {
+    auto [index, num_lanes] = batch_positions<W>(p0, num_facets, positions);
+
+    // Cells in the integration domain, local facet indices relative to
+    // the integration domain cells, and facet permutations
+    std::array<std::int32_t, W> cells, local_facets;
+    std::array<std::uint8_t, W> perm;
+    for (int w = 0; w < W; ++w)
+    {
+      cells[w] = facets(index[w], 0);
+      local_facets[w] = facets(index[w], 1);
+      perm[w] = perms.empty() ? 0 : perms(cells[w], local_facets[w]);
+    }
+
+    // Pack geometry and coefficients for the batch
+    pack_coordinate_dofs_batch<W>(std::span(cdofs), x_dofmap, x,
+                                  std::span<const std::int32_t, W>(cells));
+    pack_coefficients_batch<W>(std::span(coeffs_b), coeffs,
+                               std::span<const std::size_t, W>(index));
+
+    // Tabulate element vectors for batch
+    std::ranges::fill(be_b, 0);
+    fn(be_b.data(), coeffs_b.data(), constants.data(), cdofs.data(),
+       local_facets.data(), perm.data(), nullptr);
+
+    for (int w = 0; w < num_lanes; ++w)
+    {
+      std::int32_t cell0 = facets0(index[w], 0);
+      extract_batch_lane<W>(_be, std::span<const T>(be_b), w);
+      P0(_be, cell_info0, cell0, 1);
+
+      // Add element vector to global vector
+      auto dofs = md::submdspan(dmap, cell0, md::full_extent);
+      if constexpr (_bs > 0)
+      {
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int k = 0; k < _bs; ++k)
+            b[_bs * dofs[i] + k] += be[_bs * i + k];
+      }
+      else
+      {
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int k = 0; k < bs; ++k)
+            b[bs * dofs[i] + k] += be[bs * i + k];
+      }
+    }
+  }
+}
+
 /// @brief Assemble linear form interior facet integrals into an vector.
 /// @tparam T Scalar type.
 /// @tparam _bs Block size of the form test function dof map. If less
@@ -813,6 +1106,16 @@ void assemble_exterior_facets(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
+/// @param[in] coordinate_dofs Packed coordinate dofs of the facets,
+/// with the coordinate dofs of entity `i` starting at `i * n`, where
+/// `n` is the number of coordinate dof entries per entity. If empty,
+/// the coordinate dofs are gathered from `x`.
+/// @param[in] positions Positions in `facets` of the facets to execute
+/// the kernel over. If not set, the kernel is executed over all facets
+/// in `facets`.
+/// @param[in] facet_pairs Precomputed merged dofs and permutations of
+/// the facets (see Form::facet_pairs). If empty, the dofs of the two
+/// cells are merged and the permutations looked up for each facet.
 template <dolfinx::scalar T, int _bs = -1>
 void assemble_interior_facets(
     fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
@@ -831,7 +1134,10 @@ void assemble_interior_facets(
                                     md::dynamic_extent>>
         coeffs,
     std::span<const std::uint32_t> cell_info0,
-    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms)
+    md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms,
+    packed_coordinate_dofs<scalar_value_t<T>> coordinate_dofs = {},
+    std::optional<std::span<const std::int32_t>> positions = std::nullopt,
+    packed_facet_pairs facet_pairs = {})
 {
   if (facets.empty())
     return;
@@ -847,9 +1153,19 @@ void assemble_interior_facets(
                       x_dofmap.extent(1) * 3);
   std::vector<T> be;
 
+  // Number of dofs per cell
+  const std::size_t num_dofs = dmap.map().extent(1);
+
+  // Temporary for joint dofmap
+  std::vector<std::int32_t> dmapjoint;
+
   assert(facets0.size() == facets.size());
-  for (std::size_t f = 0; f < facets.extent(0); ++f)
+  const std::size_t num_facets
+      = positions ? positions->size() : facets.extent(0);
+  for (std::size_t p = 0; p < num_facets; ++p)
   {
+    const std::size_t f = positions ? (*positions)[p] : p;
+
     // Cells in integration domain and test function domain meshes
     std::array<std::int32_t, 2> cells{facets(f, 0, 0), facets(f, 1, 0)};
     std::array<std::int32_t, 2> cells0{facets0(f, 0, 0), facets0(f, 1, 0)};
@@ -858,29 +1174,46 @@ void assemble_interior_facets(
     std::array<std::int32_t, 2> local_facet{facets(f, 0, 1), facets(f, 1, 1)};
 
     // Get cell geometry
-    auto x_dofs0 = md::submdspan(x_dofmap, cells[0], md::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
-      std::copy_n(&x(x_dofs0[i], 0), 3, std::next(cdofs0.begin(), 3 * i));
-    auto x_dofs1 = md::submdspan(x_dofmap, cells[1], md::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
-      std::copy_n(&x(x_dofs1[i], 0), 3, std::next(cdofs1.begin(), 3 * i));
+    const X* cdofs_e = cdofs.data();
+    if (!coordinate_dofs.empty())
+      cdofs_e = coordinate_dofs.get(f, cdofs);
+    else
+    {
+      auto x_dofs0 = md::submdspan(x_dofmap, cells[0], md::full_extent);
+      gather_coordinate_dofs(cdofs0, x_dofs0, x);
+      auto x_dofs1 = md::submdspan(x_dofmap, cells[1], md::full_extent);
+      gather_coordinate_dofs(cdofs1, x_dofs1, x);
+    }
 
-    // Get dofmaps for cells
-    std::span dmap0 = dmap.cell_dofs(cells0[0]);
-    std::span dmap1 = dmap.cell_dofs(cells0[1]);
+    // Get merged dofmap of the two cells, precomputed or packed
+    std::span<const std::int32_t> dofs;
+    if (!facet_pairs.empty())
+      dofs = facet_pairs.dofs0.subspan(2 * num_dofs * f, 2 * num_dofs);
+    else
+    {
+      dmapjoint.resize(2 * num_dofs);
+      std::ranges::copy(dmap.cell_dofs(cells0[0]), dmapjoint.begin());
+      std::ranges::copy(dmap.cell_dofs(cells0[1]),
+                        std::next(dmapjoint.begin(), num_dofs));
+      dofs = dmapjoint;
+    }
 
     // Tabulate element vector
-    be.resize(bs * (dmap0.size() + dmap1.size()));
+    be.resize(bs * dofs.size());
     std::ranges::fill(be, 0);
-    std::array perm = perms.empty()
-                          ? std::array<std::uint8_t, 2>{0, 0}
-                          : std::array{perms(cells[0], local_facet[0]),
-                                       perms(cells[1], local_facet[1])};
-    fn(be.data(), &coeffs(f, 0, 0), constants.data(), cdofs.data(),
+    std::array<std::uint8_t, 2> perm = {0, 0};
+    if (!facet_pairs.perms.empty())
+      perm = {facet_pairs.perms[2 * f], facet_pairs.perms[2 * f + 1]};
+    else if (!perms.empty())
+    {
+      perm = {perms(cells[0], local_facet[0]),
+              perms(cells[1], local_facet[1])};
+    }
+    fn(be.data(), &coeffs(f, 0, 0), constants.data(), cdofs_e,
        local_facet.data(), perm.data(), nullptr);
 
     std::span<T> _be(be);
-    std::span<T> sub_be = _be.subspan(bs * dmap0.size(), bs * dmap1.size());
+    std::span<T> sub_be = _be.subspan(bs * num_dofs, bs * num_dofs);
 
     P0(be, cell_info0, cells0[0], 1);
     P0(sub_be, cell_info0, cells0[1], 1);
@@ -888,25 +1221,238 @@ void assemble_interior_facets(
     // Add element vector to global vector
     if constexpr (_bs > 0)
     {
-      for (std::size_t i = 0; i < dmap0.size(); ++i)
-        for (int k = 0; k < _bs; ++k)
-          b[_bs * dmap0[i] + k] += be[_bs * i + k];
-      for (std::size_t i = 0; i < dmap1.size(); ++i)
+      for (std::size_t i = 0; i < dofs.size(); ++i)
         for (int k = 0; k < _bs; ++k)
-          b[_bs * dmap1[i] + k] += be[_bs * (i + dmap0.size()) + k];
+          b[_bs * dofs[i] + k] += be[_bs * i + k];
     }
     else
     {
-      for (std::size_t i = 0; i < dmap0.size(); ++i)
+      for (std::size_t i = 0; i < dofs.size(); ++i)
         for (int k = 0; k < bs; ++k)
-          b[bs * dmap0[i] + k] += be[bs * i + k];
-      for (std::size_t i = 0; i < dmap1.size(); ++i)
+          b[bs * dofs[i] + k] += be[bs * i + k];
+    }
+  }
+}
+
+/// @brief Mark the integration entities whose trial function
+/// degrees-of-freedom include at least one degree-of-freedom with a
+/// boundary condition applied.
+/// @param[in] dofmap1 Trial function (column) degree-of-freedom data
+/// holding the (0) dofmap, (1) dofmap block size and (2) dofmap cell
+/// indices.
+/// @param[in] bc_markers1 Marker to identify which DOFs have boundary
+/// conditions applied.
+/// @return Marker for each entity in the dofmap cell indices list.
+inline std::vector<std::int8_t> mark_bc_cells(
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    std::span<const std::int8_t> bc_markers1)
+{
+  const auto [dmap1, bs1, cells1] = dofmap1;
+  std::vector<std::int8_t> markers(cells1.size(), 0);
+  for (std::size_t index = 0; index < cells1.size(); ++index)
+  {
+    auto dofs1 = md::submdspan(dmap1, cells1[index], md::full_extent);
+    for (std::size_t j = 0; j < dofs1.size() and !markers[index]; ++j)
+    {
+      for (int k = 0; k < bs1; ++k)
+      {
+        assert(bs1 * dofs1[j] + k < (int)bc_markers1.size());
+        if (bc_markers1[bs1 * dofs1[j] + k])
+        {
+          markers[index] = 1;
+          break;
+        }
+      }
+    }
+  }
+
+  return markers;
+}
+
+/// @brief Execute the kernels of a linear and a bilinear form over
+/// cells, and accumulate the cell vectors with boundary condition
+/// lifting applied in a vector.
+///
+/// For each cell, the linear form kernel is executed and, if the cell
+/// has a degree-of-freedom with a boundary condition applied, the
+/// bilinear form kernel is executed and the lifting `-alpha * A_e
+/// (g_e - x0_e)` is added to the cell vector before it is accumulated
+/// in `b`. The result is equal to assemble_cells() followed by
+/// _lift_bc_cells(), with a single pass over the cells and the
+/// geometry packed once per cell.
+///
+/// @tparam T Scalar type.
+/// @tparam _bs0 The block size of the test function dof map. If less
+/// than zero the block size is determined at runtime.
+/// @tparam _bs1 The block size of the trial function dof map.
+/// @param[in,out] b The vector to accumulate into.
+/// @param[in] x_dofmap Dofmap for the mesh geometry.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] cells Cell indices (in the integration
+/// domain mesh) to execute the kernels over.
+/// @param[in] dofmap0 Test function (row) degree-of-freedom data
+/// holding the (0) dofmap, (1) dofmap block size and (2) dofmap cell
+/// indices.
+/// @param[in] P0 Function that applies the transformation `P_0 A`
+/// in-place to transform test degrees-of-freedom.
+/// @param[in] dofmap1 Trial function (column) degree-of-freedom data.
+/// See `dofmap0` for a description.
+/// @param[in] P1T Function that applies the transformation `A P_1^T`
+/// in-place to transform trial degrees-of-freedom.
+/// @param[in] kernel_L Linear form kernel.
+/// @param[in] constants_L Constant data in `kernel_L`.
+/// @param[in] coeffs_L Coefficient data in `kernel_L`, with shape
+/// `(cells.size(), num_cell_coeffs)`.
+/// @param[in] kernel_a Bilinear form kernel.
+/// @param[in] constants_a Constant data in `kernel_a`.
+/// @param[in] coeffs_a Coefficient data in `kernel_a`, with shape
+/// `(cells.size(), num_cell_coeffs)`.
+/// @param[in] cell_info0 Cell permutation information for the test
+/// function mesh.
+/// @param[in] cell_info1 Cell permutation information for the trial
+/// function mesh.
+/// @param[in] bc_values1 Values for entries with an applied boundary
+/// condition.
+/// @param[in] bc_markers1 Marker to identify which DOFs have boundary
+/// conditions applied.
+/// @param[in] bc_cells Marker for each cell in `cells` that has a
+/// degree-of-freedom with a boundary condition applied (see
+/// mark_bc_cells()).
+/// @param[in] x0 Vector used in the lifting.
+/// @param[in] alpha Scaling to apply.
+template <dolfinx::scalar T, int _bs0 = -1, int _bs1 = -1>
+void assemble_lift_cells(
+    std::span<T> b, mdspan2_t x_dofmap,
+    md::mdspan<const scalar_value_t<T>,
+               md::extents<std::size_t, md::dynamic_extent, 3>>
+        x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    fem::DofTransformKernel<T> auto P1T, FEkernel<T> auto kernel_L,
+    std::span<const T> constants_L,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs_L,
+    FEkernel<T> auto kernel_a, std::span<const T> constants_a,
+    md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs_a,
+    std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1, std::span<const T> bc_values1,
+    std::span<const std::int8_t> bc_markers1,
+    std::span<const std::int8_t> bc_cells, std::span<const T> x0, T alpha)
+{
+  if (cells.empty())
+    return;
+
+  const auto [dmap0, bs0, cells0] = dofmap0;
+  const auto [dmap1, bs1, cells1] = dofmap1;
+  assert(_bs0 < 0 or _bs0 == bs0);
+  assert(_bs1 < 0 or _bs1 == bs1);
+  assert(cells0.size() == cells.size());
+  assert(cells1.size() == cells.size());
+  assert(bc_cells.size() == cells.size());
+
+  const int num_rows = bs0 * dmap0.extent(1);
+  const int num_cols = bs1 * dmap1.extent(1);
+  common::Workspace& ws = common::Workspace::local();
+  common::Workspace::Scope scope(ws);
+  std::span cdofs = ws.allocate<scalar_value_t<T>>(3 * x_dofmap.extent(1));
+  std::span<T> be = ws.allocate<T>(num_rows);
+  std::span<T> Ae = ws.allocate<T>(num_rows * num_cols);
+  std::span<T> _be(be);
+  for (std::size_t index = 0; index < cells.size(); ++index)
+  {
+    // Cell index in integration domain mesh, test function mesh, and
+    // trial function mesh
+    std::int32_t c = cells[index];
+    std::int32_t c0 = cells0[index];
+    std::int32_t c1 = cells1[index];
+
+    // Get cell coordinates/geometry
+    auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
+    gather_coordinate_dofs(std::span(cdofs), x_dofs, x);
+
+    // Tabulate vector for cell
+    std::ranges::fill(be, 0);
+    kernel_L(be.data(), &coeffs_L(index, 0), constants_L.data(),
+             cdofs.data(), nullptr, nullptr, nullptr);
+    P0(_be, cell_info0, c0, 1);
+
+    // Add the lifting for cells with a boundary condition applied
+    if (bc_cells[index])
+    {
+      std::ranges::fill(Ae, 0);
+      kernel_a(Ae.data(), &coeffs_a(index, 0), constants_a.data(),
+               cdofs.data(), nullptr, nullptr, nullptr);
+      P0(Ae, cell_info0, c0, num_cols);
+      P1T(Ae, cell_info1, c1, num_rows);
+
+      auto dofs1 = md::submdspan(dmap1, c1, md::full_extent);
+      const int bs = _bs1 > 0 ? _bs1 : bs1;
+      for (std::size_t j = 0; j < dofs1.size(); ++j)
+      {
         for (int k = 0; k < bs; ++k)
-          b[bs * dmap1[i] + k] += be[bs * (i + dmap0.size()) + k];
+        {
+          const std::int32_t jj = bs * dofs1[j] + k;
+          assert(jj < (int)bc_markers1.size());
+          if (bc_markers1[jj])
+          {
+            const T bc = bc_values1[jj];
+            const T _x0 = x0.empty() ? 0 : x0[jj];
+            for (int m = 0; m < num_rows; ++m)
+              be[m] -= Ae[m * num_cols + bs * j + k] * alpha * (bc - _x0);
+          }
+        }
+      }
+    }
+
+    // Scatter cell vector to 'global' vector array
+    auto dofs0 = md::submdspan(dmap0, c0, md::full_extent);
+    if constexpr (_bs0 > 0)
+    {
+      for (std::size_t i = 0; i < dofs0.size(); ++i)
+        for (int k = 0; k < _bs0; ++k)
+          b[_bs0 * dofs0[i] + k] += be[_bs0 * i + k];
+    }
+    else
+    {
+      for (std::size_t i = 0; i < dofs0.size(); ++i)
+        for (int k = 0; k < bs0; ++k)
+          b[bs0 * dofs0[i] + k] += be[bs0 * i + k];
     }
   }
 }
 
+/// @brief Cells of a function space mesh with a degree-of-freedom
+/// that is constrained by any of a list of boundary conditions.
+/// @param[in] V Function space that the boundary conditions apply to,
+/// e.g. the trial function space of a bilinear form.
+/// @param[in] bcs Boundary conditions.
+/// @return Sorted cells (see DirichletBC::cells), or `std::nullopt` if
+/// the cells are not available because a boundary condition is
+/// applied on a different mesh, or the mesh has more than one cell
+/// type.
+template <dolfinx::scalar T, std::floating_point U>
+std::optional<std::vector<std::int32_t>> constrained_cells(
+    const FunctionSpace<U>& V,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  if (V.mesh()->topology()->cell_types().size() > 1)
+    return std::nullopt;
+
+  std::vector<std::int32_t> cells;
+  for (auto& bc : bcs)
+  {
+    if (bc.get().function_space()->mesh() != V.mesh())
+      return std::nullopt;
+    std::span<const std::int32_t> c = bc.get().cells();
+    cells.insert(cells.end(), c.begin(), c.end());
+  }
+  std::ranges::sort(cells);
+  auto [unique_end, range_end] = std::ranges::unique(cells);
+  cells.erase(unique_end, range_end);
+  return cells;
+}
+
 /// Modify RHS vector to account for boundary condition such that:
 ///
 /// b <- b - alpha * A.(x_bc - x0)
@@ -923,6 +1469,12 @@ void assemble_interior_facets(
 /// @param[in] x0 The array used in the lifting, typically a 'current
 /// solution' in a Newton method
 /// @param[in] alpha Scaling to apply
+/// @param[in] skip_cell_ids Identifiers of the cell integrals to skip
+/// @param[in] bc_cells Sorted cells of the trial function mesh with a
+/// degree-of-freedom with a boundary condition applied (see
+/// DirichletBC::cells). If set, only the entities attached to these
+/// cells are visited (see Form::cell_entities). If not set, all
+/// entities are checked for boundary conditions.
 template <dolfinx::scalar T, std::floating_point U>
 void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
              md::mdspan<const scalar_value_t<T>,
@@ -933,7 +1485,9 @@ void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
                             std::pair<std::span<const T>, int>>& coefficients,
              std::span<const T> bc_values1,
              std::span<const std::int8_t> bc_markers1, std::span<const T> x0,
-             T alpha)
+             T alpha, std::span<const int> skip_cell_ids = {},
+             std::optional<std::span<const std::int32_t>> bc_cells
+             = std::nullopt)
 {
   // Integration domain mesh
   std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
@@ -970,14 +1524,34 @@ void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
     cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
   }
 
-  fem::DofTransformKernel<T> auto P0
-      = element0->template dof_transformation_fn<T>(doftransform::standard);
-  fem::DofTransformKernel<T> auto P1T
-      = element1->template dof_transformation_right_fn<T>(
-          doftransform::transpose);
+  // DOF transformations, cached on the spaces
+  std::shared_ptr<const fem::DofTransformation<T>> P0_ptr
+      = a.function_spaces()[0]->template dof_transformation<T>(
+          0, doftransform::standard, false);
+  std::shared_ptr<const fem::DofTransformation<T>> P1T_ptr
+      = a.function_spaces()[1]->template dof_transformation<T>(
+          0, doftransform::transpose, true);
+  fem::DofTransformKernel<T> auto P0 = std::cref(*P0_ptr);
+  fem::DofTransformKernel<T> auto P1T = std::cref(*P1T_ptr);
+
+  // Positions of the entities of an integral that are attached to a
+  // cell with a boundary condition applied
+  std::vector<std::int32_t> bc_entities;
+  auto bc_positions = [&](IntegralType type, int i)
+      -> std::optional<std::span<const std::int32_t>>
+  {
+    if (!bc_cells)
+      return std::nullopt;
+    bc_entities
+        = cell_entity_positions(a.cell_entities(type, 1, i, 0), *bc_cells);
+    return bc_entities;
+  };
 
   for (int i : a.integral_ids(IntegralType::cell))
   {
+    if (std::ranges::find(skip_cell_ids, i) != skip_cell_ids.end())
+      continue;
+
     auto kernel = a.kernel(IntegralType::cell, i, 0);
     assert(kernel);
     auto& [_coeffs, cstride] = coefficients.at({IntegralType::cell, i});
@@ -986,25 +1560,27 @@ void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
     std::span cells1 = a.domain_arg(IntegralType::cell, 1, i, 0);
     assert(_coeffs.size() == cells.size() * cstride);
     auto coeffs = md::mdspan(_coeffs.data(), cells.size(), cstride);
+    auto positions = bc_positions(IntegralType::cell, i);
     if (bs0 == 1 and bs1 == 1)
     {
       _lift_bc_cells<T, 1, 1>(
           b, x_dofmap, x, kernel, cells, {dofmap0, bs0, cells0}, P0,
           {dofmap1, bs1, cells1}, P1T, constants, coeffs, cell_info0,
-          cell_info1, bc_values1, bc_markers1, x0, alpha);
+          cell_info1, bc_values1, bc_markers1, x0, alpha, positions);
     }
     else if (bs0 == 3 and bs1 == 3)
     {
       _lift_bc_cells<T, 3, 3>(
           b, x_dofmap, x, kernel, cells, {dofmap0, bs0, cells0}, P0,
           {dofmap1, bs1, cells1}, P1T, constants, coeffs, cell_info0,
-          cell_info1, bc_values1, bc_markers1, x0, alpha);
+          cell_info1, bc_values1, bc_markers1, x0, alpha, positions);
     }
     else
     {
       _lift_bc_cells(b, x_dofmap, x, kernel, cells, {dofmap0, bs0, cells0}, P0,
                      {dofmap1, bs1, cells1}, P1T, constants, coeffs, cell_info0,
-                     cell_info1, bc_values1, bc_markers1, x0, alpha);
+                     cell_info1, bc_values1, bc_markers1, x0, alpha,
+                     positions);
     }
   }
 
@@ -1042,7 +1618,8 @@ void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
         b, x_dofmap, x, kernel, facets, {dofmap0, bs0, facets0}, P0,
         {dofmap1, bs1, facets1}, P1T, constants,
         md::mdspan(coeffs.data(), facets.extent(0), cstride), cell_info0,
-        cell_info1, bc_values1, bc_markers1, x0, alpha, perms);
+        cell_info1, bc_values1, bc_markers1, x0, alpha, perms,
+        bc_positions(IntegralType::exterior_facet, i));
   }
 
   for (int i : a.integral_ids(IntegralType::interior_facet))
@@ -1068,7 +1645,8 @@ void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
         b, x_dofmap, x, kernel, facets, {dofmap0, bs0, facets0}, P0,
         {dofmap1, bs1, facets1}, P1T, constants,
         mdspanx2x_t(coeffs.data(), facets.extent(0), 2, cstride), cell_info0,
-        cell_info1, bc_values1, bc_markers1, x0, alpha, perms);
+        cell_info1, bc_values1, bc_markers1, x0, alpha, perms,
+        bc_positions(IntegralType::interior_facet, i));
   }
 }
 
@@ -1146,16 +1724,17 @@ void apply_lifting(
         bc.get().set(bc_values1, std::nullopt, 1);
       }
 
-      if (!x0.empty())
-      {
-        lift_bc<T>(b, a[j]->get(), x_dofmap, x, constants[j], coeffs[j],
-                   bc_values1, bc_markers1, x0[j], alpha);
-      }
-      else
-      {
-        lift_bc<T>(b, a[j]->get(), x_dofmap, x, constants[j], coeffs[j],
-                   bc_values1, bc_markers1, std::span<const T>(), alpha);
-      }
+      // Cells with a boundary condition applied
+      std::optional<std::vector<std::int32_t>> cells_bc
+          = constrained_cells(*V1, bcs1[j]);
+      std::optional<std::span<const std::int32_t>> _cells_bc;
+      if (cells_bc)
+        _cells_bc = *cells_bc;
+
+      lift_bc<T>(b, a[j]->get(), x_dofmap, x, constants[j], coeffs[j],
+                 bc_values1, bc_markers1,
+                 x0.empty() ? std::span<const T>() : x0[j], alpha, {},
+                 _cells_bc);
     }
   }
 }
@@ -1167,6 +1746,14 @@ void apply_lifting(
 /// @param[in] x Mesh coordinates.
 /// @param[in] constants Packed constants that appear in `L`.
 /// @param[in] coefficients Packed coefficients that appear in `L`.
+/// @param[in] num_threads Number of threads to use. If greater than
+/// one, integration entities are coloured such that entities of the
+/// same colour do not share a degree-of-freedom, and the entities of
+/// each colour are assembled concurrently (see Form::colouring).
+/// @param[in] positions If set, `positions[(type, id, kernel_idx)]`
+/// are the positions in the entity list (see Form::domain) of each
+/// integral of the entities to assemble. Otherwise all entities are
+/// assembled. If set, `num_threads` is ignored.
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_vector(
     std::span<T> b, const Form<T, U>& L,
@@ -1175,7 +1762,13 @@ void assemble_vector(
         x,
     std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
-                   std::pair<std::span<const T>, int>>& coefficients)
+                   std::pair<std::span<const T>, int>>& coefficients,
+    int num_threads = 1,
+    std::optional<std::reference_wrapper<
+        const std::map<std::tuple<IntegralType, int, int>,
+                       std::vector<std::int32_t>>>>
+        positions
+    = std::nullopt)
 {
   // Integration domain mesh
   std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
@@ -1201,9 +1794,6 @@ void assemble_vector(
     auto dofs = dofmap->map();
     const int bs = dofmap->bs();
 
-    fem::DofTransformKernel<T> auto P0
-        = element->template dof_transformation_fn<T>(doftransform::standard);
-
     std::span<const std::uint32_t> cell_info0;
     if (element->needs_dof_transformations() or L.needs_facet_permutations())
     {
@@ -1211,6 +1801,12 @@ void assemble_vector(
       cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
     }
 
+    // DOF transformations, cached on the spaces
+    std::shared_ptr<const fem::DofTransformation<T>> P0_ptr
+        = L.function_spaces().at(0)->template dof_transformation<T>(
+            cell_type_idx, doftransform::standard, false);
+    fem::DofTransformKernel<T> auto P0 = std::cref(*P0_ptr);
+
     for (int i : L.integral_ids(IntegralType::cell))
     {
       auto fn = L.kernel(IntegralType::cell, i, cell_type_idx);
@@ -1219,24 +1815,72 @@ void assemble_vector(
       std::span cells0 = L.domain_arg(IntegralType::cell, 0, i, cell_type_idx);
       auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
       assert(cells.size() * cstride == coeffs.size());
-      if (bs == 1)
+      auto [fn_b, batch_size]
+          = L.kernel_batch(IntegralType::cell, i, cell_type_idx);
+      packed_coordinate_dofs<scalar_value_t<T>> cdofs
+          = L.coordinate_dofs(IntegralType::cell, i, cell_type_idx);
+      auto assemble = [&](std::optional<std::span<const std::int32_t>> pos)
       {
-        impl::assemble_cells<T, 1>(
-            P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn, constants,
-            md::mdspan(coeffs.data(), cells.size(), cstride), cell_info0);
-      }
-      else if (bs == 3)
+        if (fn_b)
+        {
+          impl::dispatch_batch_size(
+              batch_size,
+              [&]<int W>(std::integral_constant<int, W>)
+              {
+                impl::assemble_cells_batched<T, W>(
+                    P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn_b,
+                    constants,
+                    md::mdspan(coeffs.data(), cells.size(), cstride),
+                    cell_info0, pos);
+              });
+        }
+        else if (bs == 1)
+        {
+          fem::dispatch_num_dofs(
+              dofs.extent(1),
+              [&]<int N>(std::integral_constant<int, N>)
+              {
+                impl::assemble_cells<T, 1, N>(
+                    P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn,
+                    constants,
+                    md::mdspan(coeffs.data(), cells.size(), cstride),
+                    cell_info0, cdofs, pos);
+              });
+        }
+        else if (bs == 3)
+        {
+          fem::dispatch_num_dofs(
+              dofs.extent(1),
+              [&]<int N>(std::integral_constant<int, N>)
+              {
+                impl::assemble_cells<T, 3, N>(
+                    P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn,
+                    constants,
+                    md::mdspan(coeffs.data(), cells.size(), cstride),
+                    cell_info0, cdofs, pos);
+              });
+        }
+        else
+        {
+          impl::assemble_cells(
+              P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn, constants,
+              md::mdspan(coeffs.data(), cells.size(), cstride), cell_info0,
+              cdofs, pos);
+        }
+      };
+
+      if (positions)
       {
-        impl::assemble_cells<T, 3>(
-            P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn, constants,
-            md::mdspan(coeffs.data(), cells.size(), cstride), cell_info0);
+        assemble(std::span<const std::int32_t>(
+            positions->get().at({IntegralType::cell, i, cell_type_idx})));
       }
-      else
+      else if (num_threads > 1 or L.reproducible())
       {
-        impl::assemble_cells(
-            P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn, constants,
-            md::mdspan(coeffs.data(), cells.size(), cstride), cell_info0);
+        impl::for_each_colour(L.colouring(IntegralType::cell, i, cell_type_idx),
+                              num_threads, assemble);
       }
+      else
+        assemble(std::nullopt);
     }
 
     md::mdspan<const std::uint8_t, md::dextents<std::size_t, 2>> perms;
@@ -1267,27 +1911,60 @@ void assemble_vector(
       std::span f1 = L.domain_arg(IntegralType::exterior_facet, 0, i, 0);
       mdspanx2_t facets1(f1.data(), f1.size() / 2, 2);
       assert((facets.size() / 2) * cstride == coeffs.size());
-      if (bs == 1)
+      auto [fn_b, batch_size]
+          = L.kernel_batch(IntegralType::exterior_facet, i, 0);
+      packed_coordinate_dofs<scalar_value_t<T>> cdofs
+          = L.coordinate_dofs(IntegralType::exterior_facet, i, 0);
+      auto assemble = [&](std::optional<std::span<const std::int32_t>> pos)
       {
-        impl::assemble_exterior_facets<T, 1>(
-            P0, b, x_dofmap, x, facets, {dofs, bs, facets1}, fn, constants,
-            md::mdspan(coeffs.data(), facets.extent(0), cstride), cell_info0,
-            perms);
-      }
-      else if (bs == 3)
+        if (fn_b)
+        {
+          impl::dispatch_batch_size(
+              batch_size,
+              [&]<int W>(std::integral_constant<int, W>)
+              {
+                impl::assemble_exterior_facets_batched<T, W>(
+                    P0, b, x_dofmap, x, facets, {dofs, bs, facets1}, fn_b,
+                    constants,
+                    md::mdspan(coeffs.data(), facets.extent(0), cstride),
+                    cell_info0, perms, pos);
+              });
+        }
+        else if (bs == 1)
+        {
+          impl::assemble_exterior_facets<T, 1>(
+              P0, b, x_dofmap, x, facets, {dofs, bs, facets1}, fn, constants,
+              md::mdspan(coeffs.data(), facets.extent(0), cstride),
+              cell_info0, perms, cdofs, pos);
+        }
+        else if (bs == 3)
+        {
+          impl::assemble_exterior_facets<T, 3>(
+              P0, b, x_dofmap, x, facets, {dofs, bs, facets1}, fn, constants,
+              md::mdspan(coeffs.data(), facets.size() / 2, cstride),
+              cell_info0, perms, cdofs, pos);
+        }
+        else
+        {
+          impl::assemble_exterior_facets(
+              P0, b, x_dofmap, x, facets, {dofs, bs, facets1}, fn, constants,
+              md::mdspan(coeffs.data(), facets.size() / 2, cstride),
+              cell_info0, perms, cdofs, pos);
+        }
+      };
+
+      if (positions)
       {
-        impl::assemble_exterior_facets<T, 3>(
-            P0, b, x_dofmap, x, facets, {dofs, bs, facets1}, fn, constants,
-            md::mdspan(coeffs.data(), facets.size() / 2, cstride), cell_info0,
-            perms);
+        assemble(std::span<const std::int32_t>(
+            positions->get().at({IntegralType::exterior_facet, i, 0})));
       }
-      else
+      else if (num_threads > 1 or L.reproducible())
       {
-        impl::assemble_exterior_facets(
-            P0, b, x_dofmap, x, facets, {dofs, bs, facets1}, fn, constants,
-            md::mdspan(coeffs.data(), facets.size() / 2, cstride), cell_info0,
-            perms);
+        impl::for_each_colour(L.colouring(IntegralType::exterior_facet, i, 0),
+                              num_threads, assemble);
       }
+      else
+        assemble(std::nullopt);
     }
 
     for (int i : L.integral_ids(IntegralType::interior_facet))
@@ -1306,39 +1983,58 @@ void assemble_vector(
       std::span facets = L.domain(IntegralType::interior_facet, i, 0);
       std::span facets1 = L.domain_arg(IntegralType::interior_facet, 0, i, 0);
       assert((facets.size() / 4) * 2 * cstride == coeffs.size());
-      if (bs == 1)
+      packed_coordinate_dofs<scalar_value_t<T>> cdofs
+          = L.coordinate_dofs(IntegralType::interior_facet, i, 0);
+      packed_facet_pairs facet_pairs = L.facet_pairs(i);
+      auto assemble = [&](std::optional<std::span<const std::int32_t>> pos)
       {
-        impl::assemble_interior_facets<T, 1>(
-            P0, b, x_dofmap, x,
-            mdspanx22_t(facets.data(), facets.size() / 4, 2, 2),
-            {*dofmap, bs,
-             mdspanx22_t(facets1.data(), facets1.size() / 4, 2, 2)},
-            fn, constants,
-            mdspanx2x_t(coeffs.data(), facets.size() / 4, 2, cstride),
-            cell_info0, perms);
-      }
-      else if (bs == 3)
+        if (bs == 1)
+        {
+          impl::assemble_interior_facets<T, 1>(
+              P0, b, x_dofmap, x,
+              mdspanx22_t(facets.data(), facets.size() / 4, 2, 2),
+              {*dofmap, bs,
+               mdspanx22_t(facets1.data(), facets1.size() / 4, 2, 2)},
+              fn, constants,
+              mdspanx2x_t(coeffs.data(), facets.size() / 4, 2, cstride),
+              cell_info0, perms, cdofs, pos, facet_pairs);
+        }
+        else if (bs == 3)
+        {
+          impl::assemble_interior_facets<T, 3>(
+              P0, b, x_dofmap, x,
+              mdspanx22_t(facets.data(), facets.size() / 4, 2, 2),
+              {*dofmap, bs,
+               mdspanx22_t(facets1.data(), facets1.size() / 4, 2, 2)},
+              fn, constants,
+              mdspanx2x_t(coeffs.data(), facets.size() / 4, 2, cstride),
+              cell_info0, perms, cdofs, pos, facet_pairs);
+        }
+        else
+        {
+          impl::assemble_interior_facets(
+              P0, b, x_dofmap, x,
+              mdspanx22_t(facets.data(), facets.size() / 4, 2, 2),
+              {*dofmap, bs,
+               mdspanx22_t(facets1.data(), facets1.size() / 4, 2, 2)},
+              fn, constants,
+              mdspanx2x_t(coeffs.data(), facets.size() / 4, 2, cstride),
+              cell_info0, perms, cdofs, pos, facet_pairs);
+        }
+      };
+
+      if (positions)
       {
-        impl::assemble_interior_facets<T, 3>(
-            P0, b, x_dofmap, x,
-            mdspanx22_t(facets.data(), facets.size() / 4, 2, 2),
-            {*dofmap, bs,
-             mdspanx22_t(facets1.data(), facets1.size() / 4, 2, 2)},
-            fn, constants,
-            mdspanx2x_t(coeffs.data(), facets.size() / 4, 2, cstride),
-            cell_info0, perms);
+        assemble(std::span<const std::int32_t>(
+            positions->get().at({IntegralType::interior_facet, i, 0})));
       }
-      else
+      else if (num_threads > 1 or L.reproducible())
       {
-        impl::assemble_interior_facets(
-            P0, b, x_dofmap, x,
-            mdspanx22_t(facets.data(), facets.size() / 4, 2, 2),
-            {*dofmap, bs,
-             mdspanx22_t(facets1.data(), facets1.size() / 4, 2, 2)},
-            fn, constants,
-            mdspanx2x_t(coeffs.data(), facets.size() / 4, 2, cstride),
-            cell_info0, perms);
+        impl::for_each_colour(L.colouring(IntegralType::interior_facet, i, 0),
+                              num_threads, assemble);
       }
+      else
+        assemble(std::nullopt);
     }
   }
 }
@@ -1349,11 +2045,13 @@ void assemble_vector(
 /// @param[in] L Linear forms to assemble into b.
 /// @param[in] constants Packed constants that appear in `L`.
 /// @param[in] coefficients Packed coefficients that appear in `L.`
+/// @param[in] num_threads Number of threads to use.
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_vector(
     std::span<T> b, const Form<T, U>& L, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
-                   std::pair<std::span<const T>, int>>& coefficients)
+                   std::pair<std::span<const T>, int>>& coefficients,
+    int num_threads = 1)
 {
   using mdspanx3_t
       = md::mdspan<const scalar_value_t<T>,
@@ -1365,13 +2063,228 @@ void assemble_vector(
   if constexpr (std::is_same_v<U, scalar_value_t<T>>)
   {
     assemble_vector(b, L, mdspanx3_t(x.data(), x.size() / 3, 3), constants,
-                    coefficients);
+                    coefficients, num_threads);
   }
   else
   {
     std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
     assemble_vector(b, L, mdspanx3_t(_x.data(), _x.size() / 3, 3), constants,
-                    coefficients);
+                    coefficients, num_threads);
+  }
+}
+
+/// @brief Assemble a linear form into a vector and apply the lifting
+/// of a bilinear form in a single pass over the cells.
+///
+/// Computes `b <- b + L - alpha * A (g - x0)`, where `A` is the matrix
+/// of `a` and `g` are the boundary condition values. Cell integrals
+/// with the same identifier and integration domain in `L` and `a` are
+/// fused (see assemble_lift_cells()). The remaining integrals are
+/// assembled and lifted separately.
+///
+/// @param[in,out] b Array to be accumulated into. It will not be zeroed
+/// before assembly.
+/// @param[in] L Linear form.
+/// @param[in] a Bilinear form, with the same test function space as
+/// `L`.
+/// @param[in] x Mesh coordinates.
+/// @param[in] constants_L Packed constants that appear in `L`.
+/// @param[in] coeffs_L Packed coefficients that appear in `L`.
+/// @param[in] constants_a Packed constants that appear in `a`.
+/// @param[in] coeffs_a Packed coefficients that appear in `a`.
+/// @param[in] bcs1 Boundary conditions on the trial space of `a`.
+/// @param[in] x0 Array used in the lifting. If empty it is treated as
+/// zero.
+/// @param[in] alpha Scaling to apply to the lifting.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_lifted(
+    std::span<T> b, const Form<T, U>& L, const Form<T, U>& a,
+    md::mdspan<const scalar_value_t<T>,
+               md::extents<std::size_t, md::dynamic_extent, 3>>
+        x,
+    std::span<const T> constants_L,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coeffs_L,
+    std::span<const T> constants_a,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coeffs_a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs1,
+    std::span<const T> x0, T alpha)
+{
+  auto V0 = L.function_spaces().at(0);
+  assert(V0);
+  assert(a.function_spaces().at(0));
+  if (V0->dofmap() != a.function_spaces()[0]->dofmap())
+  {
+    throw std::runtime_error(
+        "Linear and bilinear forms must have the same test space.");
+  }
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  mdspan2_t x_dofmap = mesh->geometry().dofmap();
+
+  // Boundary condition markers and values
+  auto V1 = a.function_spaces().at(1);
+  assert(V1);
+  auto map1 = V1->dofmap()->index_map;
+  assert(map1);
+  const int crange = V1->dofmap()->index_map_bs()
+                     * (map1->size_local() + map1->num_ghosts());
+  std::vector<std::int8_t> bc_markers1(crange, false);
+  std::vector<T> bc_values1(crange, 0);
+  for (auto& bc : bcs1)
+  {
+    bc.get().mark_dofs(bc_markers1);
+    bc.get().set(bc_values1, std::nullopt, 1);
+  }
+
+  // Cell integrals of L and a over the same cells are fused. Forms on
+  // different meshes, or on mixed-topology meshes, are not fused.
+  std::vector<int> fused;
+  if (L.mesh() == mesh and mesh->topology()->cell_types().size() == 1
+      and !bcs1.empty())
+  {
+    for (int i : L.integral_ids(IntegralType::cell))
+    {
+      std::vector<int> ids = a.integral_ids(IntegralType::cell);
+      if (std::ranges::find(ids, i) != ids.end()
+          and std::ranges::equal(L.domain(IntegralType::cell, i, 0),
+                                 a.domain(IntegralType::cell, i, 0))
+          and std::ranges::equal(L.domain_arg(IntegralType::cell, 0, i, 0),
+                                 a.domain_arg(IntegralType::cell, 0, i, 0)))
+      {
+        fused.push_back(i);
+      }
+    }
+  }
+
+  // Assemble the integrals of L that are not fused
+  std::map<std::tuple<IntegralType, int, int>, std::vector<std::int32_t>>
+      positions;
+  const int num_cell_types = L.mesh()->topology()->cell_types().size();
+  for (auto [type, size] : {std::pair{IntegralType::cell, 1},
+                            std::pair{IntegralType::exterior_facet, 2},
+                            std::pair{IntegralType::interior_facet, 4}})
+  {
+    const int num_kernels = type == IntegralType::cell ? num_cell_types : 1;
+    for (int i : L.integral_ids(type))
+    {
+      for (int kernel_idx = 0; kernel_idx < num_kernels; ++kernel_idx)
+      {
+        std::vector<std::int32_t>& p = positions[{type, i, kernel_idx}];
+        if (type != IntegralType::cell
+            or std::ranges::find(fused, i) == fused.end())
+        {
+          p.resize(L.domain(type, i, kernel_idx).size() / size);
+          std::iota(p.begin(), p.end(), 0);
+        }
+      }
+    }
+  }
+  assemble_vector(b, L, x, constants_L, coeffs_L, 1, std::cref(positions));
+
+  // Lift the integrals of a that are not fused
+  std::optional<std::vector<std::int32_t>> cells_bc
+      = constrained_cells(*V1, bcs1);
+  std::optional<std::span<const std::int32_t>> _cells_bc;
+  if (cells_bc)
+    _cells_bc = *cells_bc;
+  if (!bcs1.empty())
+  {
+    lift_bc<T>(b, a, x_dofmap, x, constants_a, coeffs_a, bc_values1,
+               bc_markers1, x0, alpha, fused, _cells_bc);
+  }
+
+  if (fused.empty())
+    return;
+
+  auto dofmap0 = V0->dofmap()->map();
+  const int bs0 = V0->dofmap()->bs();
+  auto element0 = V0->element();
+  assert(element0);
+  auto dofmap1 = V1->dofmap()->map();
+  const int bs1 = V1->dofmap()->bs();
+  auto element1 = V1->element();
+  assert(element1);
+
+  std::span<const std::uint32_t> cell_info0;
+  std::span<const std::uint32_t> cell_info1;
+  if (element0->needs_dof_transformations()
+      or element1->needs_dof_transformations())
+  {
+    V0->mesh()->topology_mutable()->create_entity_permutations();
+    V1->mesh()->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(V0->mesh()->topology()->get_cell_permutation_info());
+    cell_info1 = std::span(V1->mesh()->topology()->get_cell_permutation_info());
+  }
+
+  // DOF transformations, cached on the spaces
+  std::shared_ptr<const fem::DofTransformation<T>> P0_ptr
+      = V0->template dof_transformation<T>(
+          0, doftransform::standard, false);
+  std::shared_ptr<const fem::DofTransformation<T>> P1T_ptr
+      = V1->template dof_transformation<T>(
+          0, doftransform::transpose, true);
+  fem::DofTransformKernel<T> auto P0 = std::cref(*P0_ptr);
+  fem::DofTransformKernel<T> auto P1T = std::cref(*P1T_ptr);
+
+  for (int i : fused)
+  {
+    auto kernel_L = L.kernel(IntegralType::cell, i, 0);
+    assert(kernel_L);
+    auto kernel_a = a.kernel(IntegralType::cell, i, 0);
+    assert(kernel_a);
+    std::span cells = a.domain(IntegralType::cell, i, 0);
+    std::span cells0 = a.domain_arg(IntegralType::cell, 0, i, 0);
+    std::span cells1 = a.domain_arg(IntegralType::cell, 1, i, 0);
+    auto& [_coeffs_L, cstride_L] = coeffs_L.at({IntegralType::cell, i});
+    auto& [_coeffs_a, cstride_a] = coeffs_a.at({IntegralType::cell, i});
+    assert(_coeffs_L.size() == cells.size() * cstride_L);
+    assert(_coeffs_a.size() == cells.size() * cstride_a);
+    md::mdspan<const T, md::dextents<std::size_t, 2>> c_L(
+        _coeffs_L.data(), cells.size(), cstride_L);
+    md::mdspan<const T, md::dextents<std::size_t, 2>> c_a(
+        _coeffs_a.data(), cells.size(), cstride_a);
+
+    // Cells with a degree-of-freedom with a boundary condition applied
+    std::vector<std::int8_t> bc_cells;
+    if (cells_bc)
+    {
+      bc_cells.assign(cells.size(), false);
+      for (std::int32_t p : cell_entity_positions(
+               a.cell_entities(IntegralType::cell, 1, i, 0), *cells_bc))
+      {
+        bc_cells[p] = true;
+      }
+    }
+    else
+      bc_cells = mark_bc_cells({dofmap1, bs1, cells1}, bc_markers1);
+
+    if (bs0 == 1 and bs1 == 1)
+    {
+      assemble_lift_cells<T, 1, 1>(
+          b, x_dofmap, x, cells, {dofmap0, bs0, cells0}, P0,
+          {dofmap1, bs1, cells1}, P1T, kernel_L, constants_L, c_L, kernel_a,
+          constants_a, c_a, cell_info0, cell_info1, bc_values1, bc_markers1,
+          bc_cells, x0, alpha);
+    }
+    else if (bs0 == 3 and bs1 == 3)
+    {
+      assemble_lift_cells<T, 3, 3>(
+          b, x_dofmap, x, cells, {dofmap0, bs0, cells0}, P0,
+          {dofmap1, bs1, cells1}, P1T, kernel_L, constants_L, c_L, kernel_a,
+          constants_a, c_a, cell_info0, cell_info1, bc_values1, bc_markers1,
+          bc_cells, x0, alpha);
+    }
+    else
+    {
+      assemble_lift_cells<T>(
+          b, x_dofmap, x, cells, {dofmap0, bs0, cells0}, P0,
+          {dofmap1, bs1, cells1}, P1T, kernel_L, constants_L, c_L, kernel_a,
+          constants_a, c_a, cell_info0, cell_info1, bc_values1, bc_markers1,
+          bc_cells, x0, alpha);
+    }
   }
 }
 } // namespace dolfinx::fem::impl
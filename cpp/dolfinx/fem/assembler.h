@@ -12,16 +12,33 @@
 #include "assemble_matrix_impl.h"
 #include "assemble_scalar_impl.h"
 #include "assemble_vector_impl.h"
+#include "colouring.h"
 #include "pack.h"
 #include "traits.h"
 #include "utils.h"
 #include <algorithm>
+#include <array>
 #include <basix/mdspan.hpp>
 #include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Trace.h>
 #include <dolfinx/common/types.h>
+#include <dolfinx/la/BlockDiagonalMatrix.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/MultiVector.h>
+#include <dolfinx/la/Vector.h>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mpi.h>
+#include <numeric>
 #include <optional>
 #include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 /// @file assembler.h
@@ -60,6 +77,8 @@ class FunctionSpace;
 /// facet_local0, cell1, facet_local1, ...]`.
 /// @param[in] mesh Mesh that the Expression is evaluated on.
 /// @param[in] element Argument element and argument space dimension.
+/// @param[in] num_threads Number of threads to use. The entities are
+/// divided into contiguous ranges, one per thread.
 template <dolfinx::scalar T, std::floating_point U>
 void tabulate_expression(
     std::span<T> values, const fem::Expression<T, U>& e,
@@ -68,11 +87,12 @@ void tabulate_expression(
     fem::MDSpan2 auto entities,
     std::optional<
         std::pair<std::reference_wrapper<const FiniteElement<U>>, std::size_t>>
-        element)
+        element,
+    int num_threads = 1)
 {
   auto [X, Xshape] = e.X();
   impl::tabulate_expression(values, e.kernel(), Xshape, e.value_size(), coeffs,
-                            constants, mesh, entities, element);
+                            constants, mesh, entities, element, num_threads);
 }
 
 /// @brief Evaluate an Expression on cells or facets.
@@ -91,20 +111,15 @@ void tabulate_expression(
 /// `(num_facets, 2)`, where `entities[i, 0]` is the cell index and
 /// `entities[i, 1]` is the local index of the facet relative to the
 /// cell.
+/// @param[in] num_threads Number of threads to use.
 template <dolfinx::scalar T, std::floating_point U>
 void tabulate_expression(std::span<T> values, const fem::Expression<T, U>& e,
-                         const mesh::Mesh<U>& mesh, fem::MDSpan2 auto entities)
+                         const mesh::Mesh<U>& mesh, fem::MDSpan2 auto entities,
+                         int num_threads = 1)
 {
   std::optional<
       std::pair<std::reference_wrapper<const FiniteElement<U>>, std::size_t>>
-      element = std::nullopt;
-  if (auto V = e.argument_space(); V)
-  {
-    std::size_t num_argument_dofs
-        = V->dofmap()->element_dof_layout().num_dofs() * V->dofmap()->bs();
-    assert(V->element());
-    element = {std::cref(*V->element()), num_argument_dofs};
-  }
+      element = impl::expression_argument_element(e);
 
   std::vector<int> coffsets = e.coefficient_offsets();
   const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
@@ -120,8 +135,80 @@ void tabulate_expression(std::span<T> values, const fem::Expression<T, U>& e,
   std::vector<T> constants = fem::pack_constants(e);
 
   tabulate_expression<T, U>(
-      values, e, md::mdspan(coeffs.data(), entities.size(), cstride),
-      std::span<const T>(constants), mesh, entities, element);
+      values, e, md::mdspan(coeffs.data(), entities.extent(0), cstride),
+      std::span<const T>(constants), mesh, entities, element, num_threads);
+}
+
+/// @brief Evaluate an Expression on cells or facets in chunks, passing
+/// the values for each chunk of entities to a callback.
+///
+/// The entities are processed in chunks of (at most) `chunk_size`
+/// entities. For each chunk, the coefficients are packed and the
+/// Expression is evaluated into a buffer of size `chunk_size *
+/// num_points * value_size * num_argument_dofs`, which is passed to
+/// `fn`. Memory use is therefore independent of the number of
+/// entities, which allows the values to be streamed, e.g. reduced or
+/// written to file, for very large numbers of entities.
+///
+/// @tparam T Scalar type.
+/// @tparam U Geometry type.
+/// @param[in] fn Function called for each chunk, with the position of
+/// the first entity of the chunk in `entities` and the computed values
+/// for the chunk. Values have shape `(num_chunk_entities, num_points,
+/// value_size, num_argument_dofs)`, and storage is row-major. The
+/// values span is only valid during the call.
+/// @param[in] e Expression to evaluate.
+/// @param[in] mesh Mesh to compute `e` on.
+/// @param[in] entities Mesh entities to evaluate the expression over,
+/// as for fem::tabulate_expression.
+/// @param[in] chunk_size Maximum number of entities per chunk.
+/// @param[in] num_threads Number of threads to use for each chunk.
+template <dolfinx::scalar T, std::floating_point U>
+void tabulate_expression(
+    const std::function<void(std::size_t, std::span<const T>)>& fn,
+    const fem::Expression<T, U>& e, const mesh::Mesh<U>& mesh,
+    fem::MDSpan2 auto entities, std::size_t chunk_size, int num_threads = 1)
+{
+  if (chunk_size == 0)
+    throw std::runtime_error("Chunk size must be greater than zero.");
+
+  std::optional<
+      std::pair<std::reference_wrapper<const FiniteElement<U>>, std::size_t>>
+      element = impl::expression_argument_element(e);
+  const std::size_t num_argument_dofs = element ? element->second : 1;
+  auto [X, Xshape] = e.X();
+  const std::size_t stride = Xshape[0] * e.value_size() * num_argument_dofs;
+
+  std::vector<int> coffsets = e.coefficient_offsets();
+  std::vector<std::reference_wrapper<const Function<T, U>>> coefficients;
+  std::ranges::transform(e.coefficients(), std::back_inserter(coefficients),
+                         [](auto c) -> const Function<T, U>& { return *c; });
+  const int cstride = coffsets.back();
+  std::vector<T> constants = fem::pack_constants(e);
+
+  const std::size_t num_entities = entities.extent(0);
+  chunk_size = std::min(chunk_size, num_entities);
+  std::vector<T> coeffs(chunk_size * cstride);
+  std::vector<T> values(chunk_size * stride);
+  for (std::size_t c0 = 0; c0 < num_entities; c0 += chunk_size)
+  {
+    const std::size_t c1 = std::min(c0 + chunk_size, num_entities);
+    auto chunk = [&]()
+    {
+      if constexpr (entities.rank() == 1)
+        return md::submdspan(entities, std::pair(c0, c1));
+      else
+        return md::submdspan(entities, std::pair(c0, c1), md::full_extent);
+    }();
+
+    std::span<T> _coeffs(coeffs.data(), (c1 - c0) * cstride);
+    fem::pack_coefficients(coefficients, coffsets, chunk, _coeffs);
+    std::span<T> _values(values.data(), (c1 - c0) * stride);
+    tabulate_expression<T, U>(
+        _values, e, md::mdspan(_coeffs.data(), c1 - c0, cstride),
+        std::span<const T>(constants), mesh, chunk, element, num_threads);
+    fn(c0, _values);
+  }
 }
 
 // -- Helper functions -----------------------------------------------------
@@ -152,14 +239,23 @@ make_coefficients_span(const std::map<std::pair<IntegralType, int>,
 /// @param[in] M The form (functional) to assemble
 /// @param[in] constants The constants that appear in `M`
 /// @param[in] coefficients The coefficients that appear in `M`
+/// @param[in] num_threads Number of threads to use. The contributions
+/// are summed in fixed blocks of entities with compensated summation
+/// and the block sums are summed pairwise, so the returned value does
+/// not depend on the number of threads.
 /// @return The contribution to the form (functional) from the local
 /// process
 template <dolfinx::scalar T, std::floating_point U>
 T assemble_scalar(
     const Form<T, U>& M, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
-                   std::pair<std::span<const T>, int>>& coefficients)
+                   std::pair<std::span<const T>, int>>& coefficients,
+    int num_threads = 1)
 {
+  static const std::uint32_t trace_region
+      = common::trace::region("assemble_scalar");
+  common::TraceRegion trace(trace_region);
+
   using mdspanx3_t
       = md::mdspan<const scalar_value_t<T>,
                    md::extents<std::size_t, md::dynamic_extent, 3>>;
@@ -171,14 +267,14 @@ T assemble_scalar(
   {
     return impl::assemble_scalar(M, mesh->geometry().dofmap(),
                                  mdspanx3_t(x.data(), x.size() / 3, 3),
-                                 constants, coefficients);
+                                 constants, coefficients, num_threads);
   }
   else
   {
     std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
     return impl::assemble_scalar(M, mesh->geometry().dofmap(),
                                  mdspanx3_t(_x.data(), _x.size() / 3, 3),
-                                 constants, coefficients);
+                                 constants, coefficients, num_threads);
   }
 }
 
@@ -187,16 +283,42 @@ T assemble_scalar(
 /// @note Caller is responsible for accumulation across processes.
 ///
 /// @param[in] M The form (functional) to assemble.
+/// @param[in] num_threads Number of threads to use (see
+/// assemble_scalar()).
 /// @return The contribution to the form (functional) from the local
 /// process.
 template <dolfinx::scalar T, std::floating_point U>
-T assemble_scalar(const Form<T, U>& M)
+T assemble_scalar(const Form<T, U>& M, int num_threads = 1)
 {
-  const std::vector<T> constants = pack_constants(M);
+  std::span<const T> constants = M.packed_constants();
   auto coefficients = allocate_coefficient_storage(M);
-  pack_coefficients(M, coefficients);
+  pack_coefficients(M, coefficients, num_threads);
   return assemble_scalar(M, std::span(constants),
-                         make_coefficients_span(coefficients));
+                         make_coefficients_span(coefficients), num_threads);
+}
+
+/// @brief Assemble functional into scalar and start the sum of the
+/// contributions over processes, with a non-blocking reduction.
+///
+/// The latency of the reduction can be overlapped with other work,
+/// e.g. the assembly of further forms, before the value is retrieved
+/// from the returned handle.
+///
+/// @note Collective MPI operation.
+///
+/// @param[in] M The form (functional) to assemble.
+/// @param[in] num_threads Number of threads to use (see
+/// assemble_scalar()).
+/// @return Handle for the reduction, with the value of the functional
+/// on completion.
+template <dolfinx::scalar T, std::floating_point U>
+MPI::Reduction<T> assemble_scalar_begin(const Form<T, U>& M,
+                                        int num_threads = 1)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = M.mesh();
+  assert(mesh);
+  return MPI::iallreduce(assemble_scalar(M, num_threads), MPI_SUM,
+                         mesh->comm());
 }
 
 // -- Vectors ----------------------------------------------------------------
@@ -211,27 +333,338 @@ T assemble_scalar(const Form<T, U>& M)
 /// @param[in] L The linear forms to assemble into b.
 /// @param[in] constants The constants that appear in `L`.
 /// @param[in] coefficients The coefficients that appear in `L`.
+/// @param[in] num_threads Number of threads to use. If greater than
+/// one, integration entities are coloured such that no two entities
+/// with the same colour share a degree-of-freedom, and the entities of
+/// each colour are assembled concurrently. The colourings are cached
+/// by `L` (see Form::colouring).
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_vector(
     std::span<T> b, const Form<T, U>& L, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
-                   std::pair<std::span<const T>, int>>& coefficients)
+                   std::pair<std::span<const T>, int>>& coefficients,
+    int num_threads = 1)
 {
-  impl::assemble_vector(b, L, constants, coefficients);
+  static const std::uint32_t trace_region
+      = common::trace::region("assemble_vector");
+  common::TraceRegion trace(trace_region);
+  impl::assemble_vector(b, L, constants, coefficients, num_threads);
 }
 
 /// @brief Assemble linear form into a vector.
 /// @param[in,out] b Vector to be assembled. It will not be zeroed
 /// before assembly.
 /// @param[in] L Linear forms to assemble into b.
+/// @param[in] num_threads Number of threads to use (see
+/// assemble_vector()).
 template <dolfinx::scalar T, std::floating_point U>
-void assemble_vector(std::span<T> b, const Form<T, U>& L)
+void assemble_vector(std::span<T> b, const Form<T, U>& L,
+                     int num_threads = 1)
 {
   auto coefficients = allocate_coefficient_storage(L);
-  pack_coefficients(L, coefficients);
-  const std::vector<T> constants = pack_constants(L);
+  pack_coefficients(L, coefficients, num_threads);
+  std::span<const T> constants = L.packed_constants();
   assemble_vector(b, L, std::span(constants),
-                  make_coefficients_span(coefficients));
+                  make_coefficients_span(coefficients), num_threads);
+}
+
+/// @brief Assemble a cell kernel over cells into a vector.
+///
+/// The kernel is passed as a compile-time callable, e.g. a lambda,
+/// rather than through the type-erased kernels of a Form, so that it
+/// can be inlined in the cell loop. This can be significant for
+/// lightweight, hand-written kernels.
+///
+/// @param[in,out] b Array to accumulate into. It is not zeroed before
+/// assembly.
+/// @param[in] V Test function space.
+/// @param[in] cells Cells to execute the kernel over.
+/// @param[in] kernel Element kernel.
+/// @param[in] constants Constants passed to the kernel.
+/// @param[in] coeffs Coefficients passed to the kernel, shape
+/// `(cells.size(), cstride)`.
+/// @param[in] cstride Number of coefficient entries per cell.
+/// @param[in] num_threads Number of threads to use. If greater than
+/// one, the cells are coloured (see fem::compute_colouring) and the
+/// cells of each colour are assembled concurrently.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_cells(std::span<T> b, const FunctionSpace<U>& V,
+                           std::span<const std::int32_t> cells,
+                           FEkernel<T> auto kernel,
+                           std::span<const T> constants = {},
+                           std::span<const T> coeffs = {}, int cstride = 0,
+                           int num_threads = 1)
+{
+  using mdspanx3_t
+      = md::mdspan<const scalar_value_t<T>,
+                   md::extents<std::size_t, md::dynamic_extent, 3>>;
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = V.mesh();
+  assert(mesh);
+  std::shared_ptr<const FiniteElement<U>> element = V.element();
+  assert(element);
+  std::shared_ptr<const DofMap> dofmap = V.dofmap();
+  assert(dofmap);
+
+  std::span<const std::uint32_t> cell_info;
+  if (element->needs_dof_transformations())
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+    cell_info = std::span(mesh->topology()->get_cell_permutation_info());
+  }
+  // DOF transformations, cached on the spaces
+  std::shared_ptr<const fem::DofTransformation<T>> P0_ptr
+      = V.template dof_transformation<T>(
+          0, doftransform::standard, false);
+  fem::DofTransformKernel<T> auto P0 = std::cref(*P0_ptr);
+
+  auto dofs = dofmap->map();
+  const int bs = dofmap->bs();
+  md::mdspan<const T, md::dextents<std::size_t, 2>> c(coeffs.data(),
+                                                      cells.size(), cstride);
+  auto assemble = [&](mdspanx3_t x)
+  {
+    auto assemble_cells
+        = [&](std::optional<std::span<const std::int32_t>> pos)
+    {
+      impl::mdspan2_t x_dofmap = mesh->geometry().dofmap();
+      if (bs == 1)
+      {
+        impl::assemble_cells<T, 1>(P0, b, x_dofmap, x, cells,
+                                   {dofs, bs, cells}, kernel, constants, c,
+                                   cell_info, {}, pos);
+      }
+      else if (bs == 3)
+      {
+        impl::assemble_cells<T, 3>(P0, b, x_dofmap, x, cells,
+                                   {dofs, bs, cells}, kernel, constants, c,
+                                   cell_info, {}, pos);
+      }
+      else
+      {
+        impl::assemble_cells(P0, b, x_dofmap, x, cells, {dofs, bs, cells},
+                             kernel, constants, c, cell_info, {}, pos);
+      }
+    };
+
+    if (num_threads > 1)
+    {
+      impl::for_each_colour(compute_colouring(IntegralType::cell, dofs, cells),
+                            num_threads, assemble_cells);
+    }
+    else
+      assemble_cells(std::nullopt);
+  };
+
+  std::span x = mesh->geometry().x();
+  if constexpr (std::is_same_v<U, scalar_value_t<T>>)
+    assemble(mdspanx3_t(x.data(), x.size() / 3, 3));
+  else
+  {
+    std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
+    assemble(mdspanx3_t(_x.data(), _x.size() / 3, 3));
+  }
+}
+
+/// @brief Assemble linear forms into the vectors of a multi-vector.
+///
+/// The form `L[j]` is assembled into vector `j` of `b`. The forms
+/// must have the same test function space, whose dofmap must be
+/// compatible with the layout of `b`. Each form is assembled into a
+/// work array, which is then added to the interleaved storage of `b`.
+///
+/// @param[in,out] b Multi-vector to be assembled. It will not be
+/// zeroed before assembly.
+/// @param[in] L Linear forms to assemble, one for each vector in `b`.
+/// @param[in] num_threads Number of threads to use (see
+/// assemble_vector()).
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector(
+    la::MultiVector<T>& b,
+    const std::vector<std::reference_wrapper<const Form<T, U>>>& L,
+    int num_threads = 1)
+{
+  const std::size_t num_vectors = b.num_vectors();
+  if (L.size() != num_vectors)
+    throw std::runtime_error("Number of forms and vectors do not match.");
+
+  std::span<T> _b = b.mutable_array();
+  std::vector<T> bj(_b.size() / num_vectors);
+  for (std::size_t j = 0; j < num_vectors; ++j)
+  {
+    std::ranges::fill(bj, T(0));
+    assemble_vector(std::span(bj), L[j].get(), num_threads);
+    for (std::size_t i = 0; i < bj.size(); ++i)
+      _b[i * num_vectors + j] += bj[i];
+  }
+}
+
+namespace impl
+{
+/// @brief Split the integration entities of each integral in a form
+/// into entities with and without ghost test function
+/// degrees-of-freedom.
+///
+/// Entities with ghost test degrees-of-freedom contribute to the ghost
+/// entries of a vector, or to the ghost rows of a matrix, i.e. to the
+/// data that is communicated in a reverse scatter.
+///
+/// @param[in] a Form.
+/// @return Positions in the entity list (see Form::domain) of each
+/// integral, keyed by `(type, id, kernel_idx)`, of `(0)` the entities
+/// with ghost test degrees-of-freedom and `(1)` the entities with owned
+/// test degrees-of-freedom only.
+template <dolfinx::scalar T, std::floating_point U>
+std::array<
+    std::map<std::tuple<IntegralType, int, int>, std::vector<std::int32_t>>,
+    2>
+partition_integrals_by_ghosts(const Form<T, U>& a)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+
+  std::array<
+      std::map<std::tuple<IntegralType, int, int>, std::vector<std::int32_t>>,
+      2>
+      positions;
+  const int num_cell_types = mesh->topology()->cell_types().size();
+  for (IntegralType type : {IntegralType::cell, IntegralType::exterior_facet,
+                            IntegralType::interior_facet})
+  {
+    const int num_kernels = type == IntegralType::cell ? num_cell_types : 1;
+    for (int i : a.integral_ids(type))
+    {
+      for (int kernel_idx = 0; kernel_idx < num_kernels; ++kernel_idx)
+      {
+        std::shared_ptr<const DofMap> dofmap
+            = a.function_spaces().at(0)->dofmaps(kernel_idx);
+        assert(dofmap);
+        auto [p0, p1] = partition_by_ghosts(
+            type, dofmap->map(), dofmap->index_map->size_local(),
+            a.domain_arg(type, 0, i, kernel_idx));
+        positions[0].insert({{type, i, kernel_idx}, std::move(p0)});
+        positions[1].insert({{type, i, kernel_idx}, std::move(p1)});
+      }
+    }
+  }
+
+  return positions;
+}
+
+/// @brief Build markers for the row and column degrees-of-freedom of a
+/// bilinear form that are constrained by Dirichlet boundary
+/// conditions.
+/// @param[in] a Bilinear form.
+/// @param[in] bcs Boundary conditions.
+/// @return Markers for the rows `(0)` and columns `(1)`. A marker
+/// array is empty if no boundary condition applies to the space.
+template <dolfinx::scalar T, std::floating_point U>
+std::array<std::vector<std::int8_t>, 2> mark_bc_dofs(
+    const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  // Index maps for dof ranges
+  // NOTE: For mixed-topology meshes, there will be multiple DOF maps,
+  // but the index maps are the same.
+  auto map0 = a.function_spaces().at(0)->dofmaps(0)->index_map;
+  auto map1 = a.function_spaces().at(1)->dofmaps(0)->index_map;
+  auto bs0 = a.function_spaces().at(0)->dofmaps(0)->index_map_bs();
+  auto bs1 = a.function_spaces().at(1)->dofmaps(0)->index_map_bs();
+
+  // Build dof markers
+  std::vector<std::int8_t> dof_marker0, dof_marker1;
+  assert(map0);
+  std::int32_t dim0 = bs0 * (map0->size_local() + map0->num_ghosts());
+  assert(map1);
+  std::int32_t dim1 = bs1 * (map1->size_local() + map1->num_ghosts());
+  for (std::size_t k = 0; k < bcs.size(); ++k)
+  {
+    assert(bcs[k].get().function_space());
+    if (a.function_spaces().at(0)->contains(*bcs[k].get().function_space()))
+    {
+      dof_marker0.resize(dim0, false);
+      bcs[k].get().mark_dofs(dof_marker0);
+    }
+
+    if (a.function_spaces().at(1)->contains(*bcs[k].get().function_space()))
+    {
+      dof_marker1.resize(dim1, false);
+      bcs[k].get().mark_dofs(dof_marker1);
+    }
+  }
+
+  return {std::move(dof_marker0), std::move(dof_marker1)};
+}
+} // namespace impl
+
+/// @brief Assemble linear form into a distributed vector and
+/// accumulate ghost contributions on the owning processes, overlapping
+/// the communication with computation.
+///
+/// Integration entities with ghost test degrees-of-freedom are
+/// assembled first. The reverse scatter of the ghost entries of `b` is
+/// then started, and the remaining entities are assembled before the
+/// scatter is completed. On return, `b` is equivalent to calling
+/// assemble_vector() followed by `b.scatter_rev(std::plus<T>())`.
+///
+/// @note Collective MPI operation.
+///
+/// @param[in,out] b Vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L Linear form to assemble into `b`.
+/// @param[in] constants Constants that appear in `L`.
+/// @param[in] coefficients Coefficients that appear in `L`.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_scatter_rev(
+    la::Vector<T>& b, const Form<T, U>& L, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  const auto positions = impl::partition_integrals_by_ghosts(L);
+
+  using mdspanx3_t
+      = md::mdspan<const scalar_value_t<T>,
+                   md::extents<std::size_t, md::dynamic_extent, 3>>;
+  auto assemble = [&](mdspanx3_t x)
+  {
+    impl::assemble_vector(b.mutable_array(), L, x, constants, coefficients, 1,
+                          std::cref(positions[0]));
+    b.scatter_rev_begin();
+    impl::assemble_vector(b.mutable_array(), L, x, constants, coefficients, 1,
+                          std::cref(positions[1]));
+    b.scatter_rev_end(std::plus<T>());
+  };
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+  std::span x = mesh->geometry().x();
+  if constexpr (std::is_same_v<U, scalar_value_t<T>>)
+    assemble(mdspanx3_t(x.data(), x.size() / 3, 3));
+  else
+  {
+    std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
+    assemble(mdspanx3_t(_x.data(), _x.size() / 3, 3));
+  }
+}
+
+/// @brief Assemble linear form into a distributed vector and
+/// accumulate ghost contributions on the owning processes, overlapping
+/// the communication with computation (see
+/// assemble_vector_scatter_rev()).
+///
+/// @note Collective MPI operation.
+///
+/// @param[in,out] b Vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L Linear form to assemble into `b`.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_scatter_rev(la::Vector<T>& b, const Form<T, U>& L)
+{
+  auto coefficients = allocate_coefficient_storage(L);
+  pack_coefficients(L, coefficients);
+  std::span<const T> constants = L.packed_constants();
+  assemble_vector_scatter_rev(b, L, std::span(constants),
+                              make_coefficients_span(coefficients));
 }
 
 /// @brief Modify the right-hand side vector to account for constraints
@@ -368,7 +801,7 @@ void apply_lifting(
   std::vector<
       std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>>
       coeffs;
-  std::vector<std::vector<T>> constants;
+  std::vector<std::span<const T>> _constants;
   for (auto _a : a)
   {
     if (_a)
@@ -376,17 +809,15 @@ void apply_lifting(
       auto coefficients = allocate_coefficient_storage(_a->get());
       pack_coefficients(_a->get(), coefficients);
       coeffs.push_back(coefficients);
-      constants.push_back(pack_constants(_a->get()));
+      _constants.push_back(_a->get().packed_constants());
     }
     else
     {
       coeffs.emplace_back();
-      constants.emplace_back();
+      _constants.emplace_back();
     }
   }
 
-  std::vector<std::span<const T>> _constants(constants.begin(),
-                                             constants.end());
   std::vector<std::map<std::pair<IntegralType, int>,
                        std::pair<std::span<const T>, int>>>
       _coeffs;
@@ -396,6 +827,108 @@ void apply_lifting(
   apply_lifting(b, a, _constants, _coeffs, bcs1, x0, alpha);
 }
 
+/// @brief Assemble a linear form into a vector and apply the lifting
+/// of a bilinear form, in a single pass over the cells.
+///
+/// The result is the same as assemble_vector() for `L` followed by
+/// apply_lifting() for `a`, i.e.
+/// \f[
+///  b \leftarrow b + L - \alpha A (g - x_{0}),
+/// \f]
+/// but cell integrals that `L` and `a` share (same identifier and
+/// integration domain) are computed in one pass over the cells. The
+/// geometry of a cell is packed once, and the kernel of `a` is only
+/// executed for the cells that have a degree-of-freedom with a
+/// boundary condition applied.
+///
+/// @note Ghost contributions are not accumulated (not sent to owner).
+/// Caller is responsible for reverse-scatter to update the ghosts.
+///
+/// @note Boundary condition values are *not* set in `b` by this
+/// function. Use DirichletBC::set to set values in `b`.
+///
+/// @param[in,out] b Vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L Linear form.
+/// @param[in] a Bilinear form. It must have the same test function
+/// space as `L`.
+/// @param[in] constants_L Constants that appear in `L`.
+/// @param[in] coeffs_L Coefficients that appear in `L`.
+/// @param[in] constants_a Constants that appear in `a`.
+/// @param[in] coeffs_a Coefficients that appear in `a`.
+/// @param[in] bcs1 Boundary conditions that provide the \f$g\f$ values
+/// on the trial space of `a`.
+/// @param[in] x0 The vector \f$x_{0}\f$ above. If empty it is set to
+/// zero.
+/// @param[in] alpha Scalar used in the modification of `b`.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_lifted(
+    std::span<T> b, const Form<T, U>& L, const Form<T, U>& a,
+    std::span<const T> constants_L,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coeffs_L,
+    std::span<const T> constants_a,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coeffs_a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs1,
+    std::span<const T> x0, T alpha)
+{
+  using mdspanx3_t
+      = md::mdspan<const scalar_value_t<T>,
+                   md::extents<std::size_t, md::dynamic_extent, 3>>;
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  std::span x = mesh->geometry().x();
+  if constexpr (std::is_same_v<U, scalar_value_t<T>>)
+  {
+    impl::assemble_vector_lifted(b, L, a, mdspanx3_t(x.data(), x.size() / 3, 3),
+                                 constants_L, coeffs_L, constants_a, coeffs_a,
+                                 bcs1, x0, alpha);
+  }
+  else
+  {
+    std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
+    impl::assemble_vector_lifted(
+        b, L, a, mdspanx3_t(_x.data(), _x.size() / 3, 3), constants_L,
+        coeffs_L, constants_a, coeffs_a, bcs1, x0, alpha);
+  }
+}
+
+/// @brief Assemble a linear form into a vector and apply the lifting
+/// of a bilinear form, in a single pass over the cells.
+///
+/// The constant and coefficient data of the forms are packed, and then
+/// assemble_vector_lifted() is called (see the packed data version for
+/// a detailed description).
+///
+/// @param[in,out] b Vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L Linear form.
+/// @param[in] a Bilinear form. It must have the same test function
+/// space as `L`.
+/// @param[in] bcs1 Boundary conditions on the trial space of `a`.
+/// @param[in] x0 Vector used in the lifting. If empty it is set to
+/// zero.
+/// @param[in] alpha Scalar used in the modification of `b`.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_lifted(
+    std::span<T> b, const Form<T, U>& L, const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs1,
+    std::span<const T> x0, T alpha)
+{
+  auto coeffs_L = allocate_coefficient_storage(L);
+  pack_coefficients(L, coeffs_L);
+  std::span<const T> constants_L = L.packed_constants();
+  auto coeffs_a = allocate_coefficient_storage(a);
+  pack_coefficients(a, coeffs_a);
+  std::span<const T> constants_a = a.packed_constants();
+  assemble_vector_lifted(b, L, a, std::span(constants_L),
+                         make_coefficients_span(coeffs_L),
+                         std::span(constants_a),
+                         make_coefficients_span(coeffs_a), bcs1, x0, alpha);
+}
+
 // -- Matrices ---------------------------------------------------------------
 
 /// @brief Assemble bilinear form into a matrix. Matrix must already be
@@ -410,6 +943,13 @@ void apply_lifting(
 /// @param[in] dof_marker1 Boundary condition markers for the columns.
 /// If bc[i] is true then rows i in A will be zeroed. The index i is a
 /// local index.
+/// @param[in] num_threads Number of threads to use. If greater than
+/// one, integration entities are coloured such that no two entities
+/// with the same colour share a row degree-of-freedom, and the
+/// entities of each colour are assembled concurrently. The colourings
+/// are cached by `a` (see Form::colouring). `mat_add` must then
+/// support concurrent insertion into different rows, e.g.
+/// la::MatrixCSR::mat_add_values. PETSc matrices do not support this.
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     la::MatSet<T> auto mat_add, const Form<T, U>& a,
@@ -417,9 +957,13 @@ void assemble_matrix(
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients,
     std::span<const std::int8_t> dof_marker0,
-    std::span<const std::int8_t> dof_marker1)
+    std::span<const std::int8_t> dof_marker1, int num_threads = 1)
 
 {
+  static const std::uint32_t trace_region
+      = common::trace::region("assemble_matrix");
+  common::TraceRegion trace(trace_region);
+
   using mdspanx3_t
       = md::mdspan<const scalar_value_t<T>,
                    md::extents<std::size_t, md::dynamic_extent, 3>>;
@@ -430,13 +974,15 @@ void assemble_matrix(
   if constexpr (std::is_same_v<U, scalar_value_t<T>>)
   {
     impl::assemble_matrix(mat_add, a, mdspanx3_t(x.data(), x.size() / 3, 3),
-                          constants, coefficients, dof_marker0, dof_marker1);
+                          constants, coefficients, dof_marker0, dof_marker1,
+                          num_threads);
   }
   else
   {
     std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
     impl::assemble_matrix(mat_add, a, mdspanx3_t(_x.data(), _x.size() / 3, 3),
-                          constants, coefficients, dof_marker0, dof_marker1);
+                          constants, coefficients, dof_marker0, dof_marker1,
+                          num_threads);
   }
 }
 
@@ -447,46 +993,21 @@ void assemble_matrix(
 /// @param[in] coefficients Coefficients that appear in `a`.
 /// @param[in] bcs Boundary conditions to apply. For boundary condition
 /// dofs the row and column are zeroed. The diagonal  entry is not set.
+/// @param[in] num_threads Number of threads to use (see
+/// assemble_matrix()).
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     auto mat_add, const Form<T, U>& a, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients,
-    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    int num_threads = 1)
 {
-  // Index maps for dof ranges
-  // NOTE: For mixed-topology meshes, there will be multiple DOF maps,
-  // but the index maps are the same.
-  auto map0 = a.function_spaces().at(0)->dofmaps(0)->index_map;
-  auto map1 = a.function_spaces().at(1)->dofmaps(0)->index_map;
-  auto bs0 = a.function_spaces().at(0)->dofmaps(0)->index_map_bs();
-  auto bs1 = a.function_spaces().at(1)->dofmaps(0)->index_map_bs();
-
-  // Build dof markers
-  std::vector<std::int8_t> dof_marker0, dof_marker1;
-  assert(map0);
-  std::int32_t dim0 = bs0 * (map0->size_local() + map0->num_ghosts());
-  assert(map1);
-  std::int32_t dim1 = bs1 * (map1->size_local() + map1->num_ghosts());
-  for (std::size_t k = 0; k < bcs.size(); ++k)
-  {
-    assert(bcs[k].get().function_space());
-    if (a.function_spaces().at(0)->contains(*bcs[k].get().function_space()))
-    {
-      dof_marker0.resize(dim0, false);
-      bcs[k].get().mark_dofs(dof_marker0);
-    }
-
-    if (a.function_spaces().at(1)->contains(*bcs[k].get().function_space()))
-    {
-      dof_marker1.resize(dim1, false);
-      bcs[k].get().mark_dofs(dof_marker1);
-    }
-  }
+  auto [dof_marker0, dof_marker1] = impl::mark_bc_dofs(a, bcs);
 
   // Assemble
   assemble_matrix(mat_add, a, constants, coefficients, dof_marker0,
-                  dof_marker1);
+                  dof_marker1, num_threads);
 }
 
 /// @brief Assemble bilinear form into a matrix.
@@ -494,19 +1015,22 @@ void assemble_matrix(
 /// @param[in] a The bilinear from to assemble.
 /// @param[in] bcs Boundary conditions to apply. For boundary condition
 /// dofs the row and column are zeroed. The diagonal  entry is not set.
+/// @param[in] num_threads Number of threads to use (see
+/// assemble_matrix()).
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     auto mat_add, const Form<T, U>& a,
-    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    int num_threads = 1)
 {
   // Prepare constants and coefficients
-  const std::vector<T> constants = pack_constants(a);
+  std::span<const T> constants = a.packed_constants();
   auto coefficients = allocate_coefficient_storage(a);
-  pack_coefficients(a, coefficients);
+  pack_coefficients(a, coefficients, num_threads);
 
   // Assemble
   assemble_matrix(mat_add, a, std::span(constants),
-                  make_coefficients_span(coefficients), bcs);
+                  make_coefficients_span(coefficients), bcs, num_threads);
 }
 
 /// @brief Assemble bilinear form into a matrix. Matrix must already be
@@ -520,37 +1044,1375 @@ void assemble_matrix(
 /// @param[in] dof_marker1 Boundary condition markers for the columns.
 /// If `bc[i]` is `true` then rows `i` in `A` will be zeroed. The index
 /// `i` is a local index.
+/// @param[in] num_threads Number of threads to use (see
+/// assemble_matrix()).
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(auto mat_add, const Form<T, U>& a,
                      std::span<const std::int8_t> dof_marker0,
-                     std::span<const std::int8_t> dof_marker1)
+                     std::span<const std::int8_t> dof_marker1,
+                     int num_threads = 1)
 
 {
   // Prepare constants and coefficients
-  const std::vector<T> constants = pack_constants(a);
+  std::span<const T> constants = a.packed_constants();
   auto coefficients = allocate_coefficient_storage(a);
-  pack_coefficients(a, coefficients);
+  pack_coefficients(a, coefficients, num_threads);
 
   // Assemble
   assemble_matrix(mat_add, a, std::span(constants),
                   make_coefficients_span(coefficients), dof_marker0,
-                  dof_marker1);
+                  dof_marker1, num_threads);
 }
 
-/// @brief Sets a value to the diagonal of a matrix for specified rows.
+/// @brief Assemble a cell kernel over cells into a matrix. Does not
+/// zero or finalise the matrix.
 ///
-/// This function is typically called after assembly. The assembly
-/// function zeroes Dirichlet rows and columns. For block matrices, this
-/// function should normally be called only on the diagonal blocks, i.e.
-/// blocks for which the test and trial spaces are the same.
+/// The kernel is passed as a compile-time callable, e.g. a lambda,
+/// rather than through the type-erased kernels of a Form, so that it
+/// can be inlined in the cell loop (see assemble_vector_cells()). The
+/// block sizes of the dofmaps are dispatched as compile-time constants
+/// for block sizes 1, 2, 3, 4 and 6.
 ///
-/// @param[in] set_fn The function for setting values to a matrix.
-/// @param[in] rows Row blocks, in local indices, for which to add a
-/// value to the diagonal.
-/// @param[in] diagonal Value to add to the diagonal for the specified
-/// rows.
-template <dolfinx::scalar T>
-void set_diagonal(auto set_fn, std::span<const std::int32_t> rows,
+/// @param[in] mat_add Function for adding values into the matrix.
+/// @param[in] V0 Test function space.
+/// @param[in] V1 Trial function space. It must have the same mesh as
+/// `V0`.
+/// @param[in] cells Cells to execute the kernel over.
+/// @param[in] kernel Element kernel.
+/// @param[in] constants Constants passed to the kernel.
+/// @param[in] coeffs Coefficients passed to the kernel, shape
+/// `(cells.size(), cstride)`.
+/// @param[in] cstride Number of coefficient entries per cell.
+/// @param[in] dof_marker0 Boundary condition markers for the rows. If
+/// `dof_marker0[i]` is true then row `i` is zeroed.
+/// @param[in] dof_marker1 Boundary condition markers for the columns.
+/// If `dof_marker1[i]` is true then column `i` is zeroed.
+/// @param[in] num_threads Number of threads to use. If greater than
+/// one, the cells are coloured and the cells of each colour are
+/// assembled concurrently. `mat_add` must then support concurrent
+/// insertion into different rows.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_cells(la::MatSet<T> auto mat_add,
+                           const FunctionSpace<U>& V0,
+                           const FunctionSpace<U>& V1,
+                           std::span<const std::int32_t> cells,
+                           FEkernel<T> auto kernel,
+                           std::span<const T> constants = {},
+                           std::span<const T> coeffs = {}, int cstride = 0,
+                           std::span<const std::int8_t> dof_marker0 = {},
+                           std::span<const std::int8_t> dof_marker1 = {},
+                           int num_threads = 1)
+{
+  using mdspanx3_t
+      = md::mdspan<const scalar_value_t<T>,
+                   md::extents<std::size_t, md::dynamic_extent, 3>>;
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = V0.mesh();
+  assert(mesh);
+  if (V1.mesh() != mesh)
+  {
+    throw std::runtime_error(
+        "Test and trial function spaces must share the same mesh.");
+  }
+
+  std::shared_ptr<const FiniteElement<U>> element0 = V0.element();
+  std::shared_ptr<const FiniteElement<U>> element1 = V1.element();
+  assert(element0);
+  assert(element1);
+  std::shared_ptr<const DofMap> dofmap0 = V0.dofmap();
+  std::shared_ptr<const DofMap> dofmap1 = V1.dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+
+  std::span<const std::uint32_t> cell_info;
+  if (element0->needs_dof_transformations()
+      or element1->needs_dof_transformations())
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+    cell_info = std::span(mesh->topology()->get_cell_permutation_info());
+  }
+  // DOF transformations, cached on the spaces
+  std::shared_ptr<const fem::DofTransformation<T>> P0_ptr
+      = V0.template dof_transformation<T>(
+          0, doftransform::standard, false);
+  std::shared_ptr<const fem::DofTransformation<T>> P1T_ptr
+      = V1.template dof_transformation<T>(
+          0, doftransform::transpose, true);
+  fem::DofTransformKernel<T> auto P0 = std::cref(*P0_ptr);
+  fem::DofTransformKernel<T> auto P1T = std::cref(*P1T_ptr);
+
+  auto dofs0 = dofmap0->map();
+  auto dofs1 = dofmap1->map();
+  const int bs0 = dofmap0->bs();
+  const int bs1 = dofmap1->bs();
+  md::mdspan<const T, md::dextents<std::size_t, 2>> c(coeffs.data(),
+                                                      cells.size(), cstride);
+  auto assemble = [&](mdspanx3_t x)
+  {
+    auto assemble_cells
+        = [&](std::optional<std::span<const std::int32_t>> pos)
+    {
+      impl::dispatch_block_size(
+          bs0, bs1,
+          [&]<int BS0, int BS1>(std::integral_constant<int, BS0>,
+                                std::integral_constant<int, BS1>)
+          {
+            impl::assemble_cells<T, BS0, BS1>(
+                mat_add, mesh->geometry().dofmap(), x, cells,
+                {dofs0, bs0, cells}, P0, {dofs1, bs1, cells}, P1T, dof_marker0,
+                dof_marker1, kernel, c, constants, cell_info, cell_info, {},
+                {}, {}, pos);
+          });
+    };
+
+    if (num_threads > 1)
+    {
+      impl::for_each_colour(
+          compute_colouring(IntegralType::cell, dofs0, cells), num_threads,
+          assemble_cells);
+    }
+    else
+      assemble_cells(std::nullopt);
+  };
+
+  std::span x = mesh->geometry().x();
+  if constexpr (std::is_same_v<U, scalar_value_t<T>>)
+    assemble(mdspanx3_t(x.data(), x.size() / 3, 3));
+  else
+  {
+    std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
+    assemble(mdspanx3_t(_x.data(), _x.size() / 3, 3));
+  }
+}
+
+/// @brief Compute the positions in the data of a la::MatrixCSR of the
+/// entries of the element tensors of a bilinear form.
+///
+/// The positions are computed once by searching the matrix sparsity
+/// pattern, and can then be passed to assemble_matrix() to add element
+/// tensors directly into the matrix data, e.g. for repeated assembly
+/// of a Jacobian. They remain valid for as long as the sparsity
+/// pattern of `A` and the integration entities of `a` are unchanged.
+///
+/// @param[in] a Bilinear form.
+/// @param[in] A Matrix with a sparsity pattern that contains the
+/// entries of `a`. The block size of `A` must be the block size of the
+/// dofmaps of `a` or one.
+/// @return Positions in `A.values()` of the element tensor entries,
+/// keyed by `(type, id, kernel_idx)`. The positions for entity `e` of
+/// an integral start at `e * n`, where `n` is the element tensor size.
+template <dolfinx::scalar T, std::floating_point U>
+std::map<std::tuple<IntegralType, int, int>, std::vector<std::int32_t>>
+create_csr_offsets(const Form<T, U>& a, const la::MatrixCSR<T>& A)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+
+  std::map<std::tuple<IntegralType, int, int>, std::vector<std::int32_t>>
+      offsets;
+  const int bs0 = a.function_spaces().at(0)->dofmaps(0)->bs();
+  const int bs1 = a.function_spaces().at(1)->dofmaps(0)->bs();
+  impl::dispatch_block_size(
+      bs0, bs1,
+      [&]<int BS0, int BS1>(std::integral_constant<int, BS0>,
+                            std::integral_constant<int, BS1>)
+      {
+        if constexpr (BS0 < 0 or BS1 < 0)
+          throw std::runtime_error("Unsupported dofmap block size.");
+        else
+        {
+          const int num_cell_types = mesh->topology()->cell_types().size();
+          std::vector<std::int32_t> dofs0, dofs1;
+          for (IntegralType type :
+               {IntegralType::cell, IntegralType::exterior_facet,
+                IntegralType::interior_facet})
+          {
+            // Entity data stride and number of cells per entity
+            auto [stride, num_cells] = type == IntegralType::cell
+                                           ? std::array{1, 1}
+                                       : type == IntegralType::exterior_facet
+                                           ? std::array{2, 1}
+                                           : std::array{4, 2};
+            const int num_kernels
+                = type == IntegralType::cell ? num_cell_types : 1;
+            for (int i : a.integral_ids(type))
+            {
+              for (int kernel_idx = 0; kernel_idx < num_kernels; ++kernel_idx)
+              {
+                auto dofmap0 = a.function_spaces().at(0)->dofmaps(kernel_idx);
+                auto dofmap1 = a.function_spaces().at(1)->dofmaps(kernel_idx);
+                assert(dofmap0);
+                assert(dofmap1);
+                std::span e0 = a.domain_arg(type, 0, i, kernel_idx);
+                std::span e1 = a.domain_arg(type, 1, i, kernel_idx);
+                const std::size_t num_entities = e0.size() / stride;
+                const std::size_t n = num_cells * dofmap0->map().extent(1)
+                                      * num_cells * dofmap1->map().extent(1)
+                                      * BS0 * BS1;
+                std::vector<std::int32_t> off(num_entities * n);
+                for (std::size_t e = 0; e < num_entities; ++e)
+                {
+                  dofs0.clear();
+                  dofs1.clear();
+                  for (int k = 0; k < num_cells; ++k)
+                  {
+                    std::ranges::copy(
+                        dofmap0->cell_dofs(e0[e * stride + 2 * k]),
+                        std::back_inserter(dofs0));
+                    std::ranges::copy(
+                        dofmap1->cell_dofs(e1[e * stride + 2 * k]),
+                        std::back_inserter(dofs1));
+                  }
+                  A.template data_offsets<BS0, BS1>(
+                      std::span(off).subspan(e * n, n), dofs0, dofs1);
+                }
+                offsets.insert({{type, i, kernel_idx}, std::move(off)});
+              }
+            }
+          }
+        }
+      });
+
+  return offsets;
+}
+
+/// @brief Assemble bilinear form into a la::MatrixCSR. Does not zero
+/// or finalise the matrix.
+///
+/// The block sizes of the test and trial function dofmaps are
+/// dispatched as compile-time constants, for block sizes 1, 2, 3, 4
+/// and 6, through to the assembly kernels and the matrix insertion
+/// function (see la::MatrixCSR::mat_add_values).
+///
+/// @param[in,out] A Matrix to assemble into.
+/// @param[in] a Bilinear form to assemble.
+/// @param[in] constants Constants that appear in `a`.
+/// @param[in] coefficients Coefficients that appear in `a`.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column are zeroed. The diagonal entry is not set.
+/// @param[in] num_threads Number of threads to use (see
+/// assemble_matrix()).
+/// @param[in] offsets Positions in the data of `A` of the element
+/// tensor entries, computed by create_csr_offsets(). If set, element
+/// tensors are added directly into the matrix data without searching
+/// the sparsity pattern.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix(
+    la::MatrixCSR<T>& A, const Form<T, U>& a, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    int num_threads = 1,
+    std::optional<std::reference_wrapper<
+        const std::map<std::tuple<IntegralType, int, int>,
+                       std::vector<std::int32_t>>>>
+        offsets
+    = std::nullopt)
+{
+  using mdspanx3_t
+      = md::mdspan<const scalar_value_t<T>,
+                   md::extents<std::size_t, md::dynamic_extent, 3>>;
+
+  auto markers = impl::mark_bc_dofs(a, bcs);
+  const int bs0 = a.function_spaces().at(0)->dofmaps(0)->bs();
+  const int bs1 = a.function_spaces().at(1)->dofmaps(0)->bs();
+  auto assemble = [&](mdspanx3_t x)
+  {
+    impl::dispatch_block_size(
+        bs0, bs1,
+        [&]<int BS0, int BS1>(std::integral_constant<int, BS0>,
+                              std::integral_constant<int, BS1>)
+        {
+          if constexpr (BS0 > 0 and BS1 > 0)
+          {
+            impl::assemble_matrix(A.template mat_add_values<BS0, BS1>(), a, x,
+                                  constants, coefficients, markers[0],
+                                  markers[1], num_threads, std::nullopt,
+                                  std::span<T>(A.values()), offsets);
+          }
+          else
+            throw std::runtime_error("Unsupported dofmap block size.");
+        });
+  };
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  std::span x = mesh->geometry().x();
+  if constexpr (std::is_same_v<U, scalar_value_t<T>>)
+    assemble(mdspanx3_t(x.data(), x.size() / 3, 3));
+  else
+  {
+    std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
+    assemble(mdspanx3_t(_x.data(), _x.size() / 3, 3));
+  }
+}
+
+/// @brief Assemble bilinear form into a la::MatrixCSR, with the
+/// dofmap block sizes dispatched as compile-time constants (see
+/// assemble_matrix()). Does not zero or finalise the matrix.
+///
+/// @param[in,out] A Matrix to assemble into.
+/// @param[in] a Bilinear form to assemble.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column are zeroed. The diagonal entry is not set.
+/// @param[in] num_threads Number of threads to use (see
+/// assemble_matrix()).
+/// @param[in] offsets Positions in the data of `A` of the element
+/// tensor entries (see create_csr_offsets()).
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix(
+    la::MatrixCSR<T>& A, const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    int num_threads = 1,
+    std::optional<std::reference_wrapper<
+        const std::map<std::tuple<IntegralType, int, int>,
+                       std::vector<std::int32_t>>>>
+        offsets
+    = std::nullopt)
+{
+  std::span<const T> constants = a.packed_constants();
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients, num_threads);
+  assemble_matrix(A, a, std::span(constants),
+                  make_coefficients_span(coefficients), bcs, num_threads,
+                  offsets);
+}
+
+/// @brief Assemble bilinear form into a distributed matrix and
+/// accumulate ghost rows on the owning processes, overlapping the
+/// communication with computation.
+///
+/// Integration entities with ghost test degrees-of-freedom, i.e.
+/// entities that contribute to ghost rows, are assembled first. The
+/// reverse scatter of the ghost rows of `A` is then started, and the
+/// remaining entities are assembled before the scatter is completed.
+/// On return, `A` is equivalent to calling assemble_matrix() followed
+/// by `A.scatter_rev()`.
+///
+/// @note Collective MPI operation.
+///
+/// @param[in,out] A Matrix to assemble into. It will not be zeroed
+/// before assembly.
+/// @param[in] a Bilinear form to assemble.
+/// @param[in] constants Constants that appear in `a`.
+/// @param[in] coefficients Coefficients that appear in `a`.
+/// @param[in] dof_marker0 Boundary condition markers for the rows. If
+/// `bc[i]` is `true` then rows `i` in `A` will be zeroed. The index `i`
+/// is a local index.
+/// @param[in] dof_marker1 Boundary condition markers for the columns.
+/// If `bc[i]` is `true` then rows `i` in `A` will be zeroed. The index
+/// `i` is a local index.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_scatter_rev(
+    la::MatrixCSR<T>& A, const Form<T, U>& a, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::int8_t> dof_marker0,
+    std::span<const std::int8_t> dof_marker1)
+{
+  const auto positions = impl::partition_integrals_by_ghosts(a);
+
+  using mdspanx3_t
+      = md::mdspan<const scalar_value_t<T>,
+                   md::extents<std::size_t, md::dynamic_extent, 3>>;
+  const int bs0 = a.function_spaces().at(0)->dofmaps(0)->bs();
+  const int bs1 = a.function_spaces().at(1)->dofmaps(0)->bs();
+  auto assemble = [&](mdspanx3_t x)
+  {
+    impl::dispatch_block_size(
+        bs0, bs1,
+        [&]<int BS0, int BS1>(std::integral_constant<int, BS0>,
+                              std::integral_constant<int, BS1>)
+        {
+          if constexpr (BS0 > 0 and BS1 > 0)
+          {
+            auto mat_add = A.template mat_add_values<BS0, BS1>();
+            impl::assemble_matrix(mat_add, a, x, constants, coefficients,
+                                  dof_marker0, dof_marker1, 1,
+                                  std::cref(positions[0]));
+            A.scatter_rev_begin();
+            impl::assemble_matrix(mat_add, a, x, constants, coefficients,
+                                  dof_marker0, dof_marker1, 1,
+                                  std::cref(positions[1]));
+            A.scatter_rev_end();
+          }
+          else
+            throw std::runtime_error("Unsupported dofmap block size.");
+        });
+  };
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  std::span x = mesh->geometry().x();
+  if constexpr (std::is_same_v<U, scalar_value_t<T>>)
+    assemble(mdspanx3_t(x.data(), x.size() / 3, 3));
+  else
+  {
+    std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
+    assemble(mdspanx3_t(_x.data(), _x.size() / 3, 3));
+  }
+}
+
+/// @brief Assemble bilinear form into a distributed matrix and
+/// accumulate ghost rows on the owning processes, overlapping the
+/// communication with computation (see
+/// assemble_matrix_scatter_rev()).
+///
+/// @note Collective MPI operation.
+///
+/// @param[in,out] A Matrix to assemble into. It will not be zeroed
+/// before assembly.
+/// @param[in] a Bilinear form to assemble.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column are zeroed. The diagonal entry is not set.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_scatter_rev(
+    la::MatrixCSR<T>& A, const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  std::span<const T> constants = a.packed_constants();
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients);
+  auto markers = impl::mark_bc_dofs(a, bcs);
+  assemble_matrix_scatter_rev(A, a, std::span(constants),
+                              make_coefficients_span(coefficients),
+                              std::span<const std::int8_t>(markers[0]),
+                              std::span<const std::int8_t>(markers[1]));
+}
+
+/// @brief Re-assemble the rows of a la::MatrixCSR that are affected by
+/// a change of a bilinear form on a set of cells.
+///
+/// The rows of the test degrees-of-freedom of `cells` are zeroed and
+/// re-assembled from the integration entities that contribute to them,
+/// i.e. the entities attached to a cell with a degree-of-freedom in
+/// one of the rows. The element tensor entries of other rows are
+/// discarded, and the data of other rows is not touched. The set of
+/// rows is made consistent across processes, so that a row changed on
+/// one process is re-assembled on all processes that contribute to it,
+/// and the ghost rows are then accumulated on the owning processes.
+/// Apart from a scan of the test dofmap for the contributing cells,
+/// the cost scales with the number of affected rows rather than the
+/// size of the mesh.
+///
+/// On return, `A` is equal to the result of zeroing `A` and calling
+/// assemble_matrix() followed by `A.scatter_rev()`.
+///
+/// @note Collective MPI operation.
+/// @note Diagonal entries of the affected rows that were set by
+/// set_diagonal() are zeroed, and must be set again.
+///
+/// @pre `A` holds the assembled form `a`, with its ghost rows
+/// accumulated (see la::MatrixCSR::scatter_rev), and the form changed
+/// on `cells` only.
+///
+/// @param[in,out] A Matrix to re-assemble. Symmetric storage is not
+/// supported.
+/// @param[in] a Bilinear form to assemble.
+/// @param[in] cells Local indices of the cells of the test function
+/// space mesh on which `a` has changed. Ghost cells may be included.
+/// @param[in] constants Constants that appear in `a`.
+/// @param[in] coefficients Coefficients that appear in `a`. Only the
+/// coefficients of the entities that are re-assembled are read.
+/// @param[in] bcs Boundary conditions to apply, as for
+/// assemble_matrix().
+template <dolfinx::scalar T, std::floating_point U>
+void reassemble_matrix(
+    la::MatrixCSR<T>& A, const Form<T, U>& a,
+    std::span<const std::int32_t> cells, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  if (A.symmetric())
+  {
+    throw std::runtime_error(
+        "Re-assembly into a matrix with symmetric storage is not supported.");
+  }
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh0
+      = a.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  if (mesh0->topology()->cell_types().size() != 1)
+  {
+    throw std::runtime_error(
+        "Re-assembly on mixed-topology meshes is not supported.");
+  }
+
+  std::shared_ptr<const DofMap> dofmap0
+      = a.function_spaces().at(0)->dofmaps(0);
+  assert(dofmap0);
+  auto dofs0 = dofmap0->map();
+  const int bs0 = dofmap0->bs();
+  const int bs1 = a.function_spaces().at(1)->dofmaps(0)->bs();
+
+  // Mark the (blocked) rows of the changed cells, and make the markers
+  // consistent across processes
+  la::Vector<std::int8_t> marker(dofmap0->index_map, 1);
+  std::span<std::int8_t> rows = marker.mutable_array();
+  for (std::int32_t c : cells)
+  {
+    for (std::size_t i = 0; i < dofs0.extent(1); ++i)
+      rows[dofs0(c, i)] = 1;
+  }
+  marker.scatter_rev([](std::int8_t x, std::int8_t y)
+                     { return std::max(x, y); });
+  marker.scatter_fwd();
+
+  // Cells with a degree-of-freedom in a marked row, and the positions
+  // of the integration entities attached to them
+  std::vector<std::int32_t> row_cells;
+  for (std::size_t c = 0; c < dofs0.extent(0); ++c)
+  {
+    for (std::size_t i = 0; i < dofs0.extent(1); ++i)
+    {
+      if (rows[dofs0(c, i)])
+      {
+        row_cells.push_back(c);
+        break;
+      }
+    }
+  }
+
+  std::map<std::tuple<IntegralType, int, int>, std::vector<std::int32_t>>
+      positions;
+  for (IntegralType type : {IntegralType::cell, IntegralType::exterior_facet,
+                            IntegralType::interior_facet})
+  {
+    for (int i : a.integral_ids(type))
+    {
+      positions.insert({{type, i, 0},
+                        cell_entity_positions(a.cell_entities(type, 0, i, 0),
+                                              row_cells)});
+    }
+  }
+
+  // Unmarked rows are treated as constrained rows, so that their
+  // element tensor entries are zeroed before insertion
+  auto markers = impl::mark_bc_dofs(a, bcs);
+  std::vector<std::int8_t> marker0(bs0 * rows.size());
+  for (std::size_t i = 0; i < marker0.size(); ++i)
+  {
+    marker0[i] = !rows[i / bs0] or (!markers[0].empty() and markers[0][i]);
+  }
+
+  // Zero the marked rows of A. The rows of A are unrolled if A does
+  // not store the dofmap blocks.
+  const int row_bs = bs0 / A.block_size()[0];
+  std::vector<std::int32_t> A_rows;
+  for (std::size_t r = 0; r < rows.size(); ++r)
+  {
+    if (rows[r])
+    {
+      for (int k = 0; k < row_bs; ++k)
+        A_rows.push_back(r * row_bs + k);
+    }
+  }
+  A.set_rows(0, A_rows);
+
+  using mdspanx3_t
+      = md::mdspan<const scalar_value_t<T>,
+                   md::extents<std::size_t, md::dynamic_extent, 3>>;
+  auto assemble = [&](mdspanx3_t x)
+  {
+    impl::dispatch_block_size(
+        bs0, bs1,
+        [&]<int BS0, int BS1>(std::integral_constant<int, BS0>,
+                              std::integral_constant<int, BS1>)
+        {
+          if constexpr (BS0 > 0 and BS1 > 0)
+          {
+            impl::assemble_matrix(A.template mat_add_values<BS0, BS1>(), a, x,
+                                  constants, coefficients,
+                                  std::span<const std::int8_t>(marker0),
+                                  std::span<const std::int8_t>(markers[1]), 1,
+                                  std::cref(positions));
+          }
+          else
+            throw std::runtime_error("Unsupported dofmap block size.");
+        });
+  };
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  std::span x = mesh->geometry().x();
+  if constexpr (std::is_same_v<U, scalar_value_t<T>>)
+    assemble(mdspanx3_t(x.data(), x.size() / 3, 3));
+  else
+  {
+    std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
+    assemble(mdspanx3_t(_x.data(), _x.size() / 3, 3));
+  }
+
+  A.scatter_rev();
+}
+
+/// @brief Re-assemble the rows of a la::MatrixCSR that are affected by
+/// a change of a bilinear form on a set of cells (see
+/// reassemble_matrix()).
+///
+/// The constants and coefficients of `a` are packed on all cells. To
+/// avoid packing on the whole mesh, pass packed coefficients to the
+/// overload that takes them and update their data on the changed cells
+/// only.
+///
+/// @note Collective MPI operation.
+///
+/// @param[in,out] A Matrix to re-assemble.
+/// @param[in] a Bilinear form to assemble.
+/// @param[in] cells Local indices of the cells of the test function
+/// space mesh on which `a` has changed.
+/// @param[in] bcs Boundary conditions to apply.
+template <dolfinx::scalar T, std::floating_point U>
+void reassemble_matrix(
+    la::MatrixCSR<T>& A, const Form<T, U>& a,
+    std::span<const std::int32_t> cells,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  std::span<const T> constants = a.packed_constants();
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients);
+  reassemble_matrix(A, a, cells, std::span(constants),
+                    make_coefficients_span(coefficients), bcs);
+}
+
+namespace impl
+{
+/// @brief Group the integration entities of each integral in a form by
+/// the blocks of owned rows that they contribute to.
+///
+/// Owned (unrolled) row `r` of the test space is in block `r /
+/// block_size`. An entity is listed for each block that contains one
+/// of its owned test degrees-of-freedom, and in a final group if it has
+/// a ghost test degree-of-freedom.
+///
+/// @param[in] a Bilinear form.
+/// @param[in] block_size Number of rows per block.
+/// @return Positions in the entity list (see Form::domain) of each
+/// integral, keyed by `(type, id, kernel_idx)`, of the entities that
+/// contribute to each block. The last entry holds the entities with
+/// ghost test degrees-of-freedom.
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<
+    std::map<std::tuple<IntegralType, int, int>, std::vector<std::int32_t>>>
+partition_integrals_by_row_blocks(const Form<T, U>& a,
+                                  std::int32_t block_size)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+
+  auto V0 = a.function_spaces().at(0);
+  const std::int32_t num_rows = V0->dofmaps(0)->index_map_bs()
+                                * V0->dofmaps(0)->index_map->size_local();
+  const std::int32_t num_blocks = (num_rows + block_size - 1) / block_size;
+  const int bs0 = V0->dofmaps(0)->bs();
+
+  std::vector<
+      std::map<std::tuple<IntegralType, int, int>, std::vector<std::int32_t>>>
+      positions(num_blocks + 1);
+  const int num_cell_types = mesh->topology()->cell_types().size();
+  std::vector<std::vector<std::int32_t>*> pos(num_blocks + 1);
+  std::vector<std::int32_t> blocks;
+  for (IntegralType type : {IntegralType::cell, IntegralType::exterior_facet,
+                            IntegralType::interior_facet})
+  {
+    // Entity data stride and number of cells per entity
+    auto [stride, num_cells] = type == IntegralType::cell ? std::array{1, 1}
+                               : type == IntegralType::exterior_facet
+                                   ? std::array{2, 1}
+                                   : std::array{4, 2};
+    const int num_kernels = type == IntegralType::cell ? num_cell_types : 1;
+    for (int i : a.integral_ids(type))
+    {
+      for (int kernel_idx = 0; kernel_idx < num_kernels; ++kernel_idx)
+      {
+        for (std::size_t b = 0; b < positions.size(); ++b)
+          pos[b] = &positions[b][{type, i, kernel_idx}];
+
+        std::shared_ptr<const DofMap> dofmap0 = V0->dofmaps(kernel_idx);
+        assert(dofmap0);
+        std::span e0 = a.domain_arg(type, 0, i, kernel_idx);
+        for (std::size_t e = 0; e < e0.size() / stride; ++e)
+        {
+          blocks.clear();
+          for (int k = 0; k < num_cells; ++k)
+          {
+            for (std::int32_t dof : dofmap0->cell_dofs(e0[e * stride + 2 * k]))
+            {
+              for (int j = 0; j < bs0; ++j)
+              {
+                const std::int32_t row = bs0 * dof + j;
+                blocks.push_back(row < num_rows ? row / block_size
+                                                : num_blocks);
+              }
+            }
+          }
+
+          std::ranges::sort(blocks);
+          auto [first, last] = std::ranges::unique(blocks);
+          blocks.erase(first, last);
+          for (std::int32_t b : blocks)
+            pos[b]->push_back(e);
+        }
+      }
+    }
+  }
+
+  return positions;
+}
+} // namespace impl
+
+/// @brief Assemble a bilinear form in blocks of rows, passing each
+/// block of the assembled matrix to a callback.
+///
+/// The owned rows of the matrix are split into contiguous blocks of (at
+/// most) `block_size` rows. For each block, the integration entities
+/// that contribute to the block are assembled, and the block is passed
+/// to `fn` in compressed sparse row format and then freed. Memory use
+/// is therefore bounded by the size of a block and of the ghost row
+/// contributions, rather than by the size of the matrix, which allows
+/// matrices that do not fit in memory to be assembled and streamed,
+/// e.g. to file. Entities that contribute to more than one block are
+/// tabulated once per block.
+///
+/// Contributions to ghost rows are assembled first and sent to the
+/// owning processes, where they are added to the blocks. The blocks
+/// hold the same entries as the owned rows of the matrix assembled by
+/// assemble_matrix() followed by la::MatrixCSR::scatter_rev(), with
+/// the diagonal of boundary condition rows set (see set_diagonal()).
+///
+/// @note Collective MPI operation.
+///
+/// @param[in] fn Function called for each block, in order, with the
+/// global index of the first row of the block, the row offsets (size
+/// `num_block_rows + 1`), the global column indices of the entries
+/// (sorted for each row) and the values of the entries. Row and column
+/// indices are unrolled, i.e. the dofmap block sizes are expanded. The
+/// spans are only valid during the call.
+/// @param[in] a Bilinear form to assemble.
+/// @param[in] constants Constants that appear in `a`.
+/// @param[in] coefficients Coefficients that appear in `a`.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column are zeroed, and, if the test and trial
+/// function spaces are the same, `diagonal` is set on the diagonal.
+/// @param[in] block_size Maximum number of rows in a block.
+/// @param[in] diagonal Value of the diagonal for boundary condition
+/// rows.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_streamed(
+    const std::function<void(std::int64_t, std::span<const std::int64_t>,
+                             std::span<const std::int64_t>,
+                             std::span<const T>)>& fn,
+    const Form<T, U>& a, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    std::int32_t block_size, T diagonal = 1)
+{
+  if (block_size <= 0)
+    throw std::runtime_error("Block size must be greater than zero.");
+
+  static const std::uint32_t trace_region
+      = common::trace::region("assemble_matrix_streamed");
+  common::TraceRegion trace(trace_region);
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+
+  auto V0 = a.function_spaces().at(0);
+  auto V1 = a.function_spaces().at(1);
+  std::shared_ptr<const common::IndexMap> map0 = V0->dofmaps(0)->index_map;
+  std::shared_ptr<const common::IndexMap> map1 = V1->dofmaps(0)->index_map;
+  const int bs0 = V0->dofmaps(0)->bs();
+  const int bs1 = V1->dofmaps(0)->bs();
+  const int map_bs0 = V0->dofmaps(0)->index_map_bs();
+  const int map_bs1 = V1->dofmaps(0)->index_map_bs();
+  const std::int32_t num_rows = map_bs0 * map0->size_local();
+  const std::int32_t num_cols = map_bs1 * map1->size_local();
+  const std::int64_t row_offset = map_bs0 * map0->local_range()[0];
+  const std::int64_t col_offset = map_bs1 * map1->local_range()[0];
+  std::span ghosts0 = map0->ghosts();
+  std::span ghosts1 = map1->ghosts();
+
+  // Global (unrolled) index of a local (unrolled) row or column
+  auto global_row = [&](std::int32_t r) -> std::int64_t
+  {
+    return r < num_rows ? row_offset + r
+                        : map_bs0 * ghosts0[r / map_bs0 - map0->size_local()]
+                              + r % map_bs0;
+  };
+  auto global_col = [&](std::int32_t c) -> std::int64_t
+  {
+    return c < num_cols ? col_offset + c
+                        : map_bs1 * ghosts1[c / map_bs1 - map1->size_local()]
+                              + c % map_bs1;
+  };
+
+  // Geometry
+  using mdspanx3_t
+      = md::mdspan<const scalar_value_t<T>,
+                   md::extents<std::size_t, md::dynamic_extent, 3>>;
+  std::span x = mesh->geometry().x();
+  std::vector<scalar_value_t<T>> x_b;
+  const scalar_value_t<T>* x_ptr = nullptr;
+  if constexpr (std::is_same_v<U, scalar_value_t<T>>)
+    x_ptr = x.data();
+  else
+  {
+    x_b.assign(x.begin(), x.end());
+    x_ptr = x_b.data();
+  }
+  mdspanx3_t _x(x_ptr, x.size() / 3, 3);
+
+  auto markers = impl::mark_bc_dofs(a, bcs);
+  const auto positions = impl::partition_integrals_by_row_blocks(a, block_size);
+  const std::size_t num_blocks = positions.size() - 1;
+
+  // Entries (local row, global column, value) of the rows in [r0, r1),
+  // or of the ghost rows if r0 = num_rows
+  std::vector<std::int32_t> rows;
+  std::vector<std::int64_t> cols;
+  std::vector<T> vals;
+  std::int32_t r0 = 0, r1 = 0;
+  auto mat_add = [&](std::span<const std::int32_t> dofs0,
+                     std::span<const std::int32_t> dofs1,
+                     std::span<const T> Ae)
+  {
+    const std::size_t ndim1 = bs1 * dofs1.size();
+    for (std::size_t i = 0; i < dofs0.size(); ++i)
+    {
+      for (int k = 0; k < bs0; ++k)
+      {
+        const std::int32_t row = bs0 * dofs0[i] + k;
+        if (row < r0 or row >= r1)
+          continue;
+        for (std::size_t j = 0; j < dofs1.size(); ++j)
+        {
+          for (int l = 0; l < bs1; ++l)
+          {
+            rows.push_back(row);
+            cols.push_back(global_col(bs1 * dofs1[j] + l));
+            vals.push_back(Ae[(bs0 * i + k) * ndim1 + bs1 * j + l]);
+          }
+        }
+      }
+    }
+  };
+
+  // Assemble the ghost rows
+  r0 = num_rows;
+  r1 = std::numeric_limits<std::int32_t>::max();
+  impl::assemble_matrix(mat_add, a, _x, constants, coefficients, markers[0],
+                        markers[1], 1, std::cref(positions.back()));
+
+  // Send the ghost row entries to the owners (owner <- ghost)
+  std::vector<std::int32_t> recv_rows;
+  std::vector<std::int64_t> recv_cols;
+  std::vector<T> recv_vals;
+  {
+    std::span src = map0->src();
+    std::span dest = map0->dest();
+    std::span owners = map0->owners();
+    MPI_Comm comm;
+    MPI_Dist_graph_create_adjacent(map0->comm(), dest.size(), dest.data(),
+                                   MPI_UNWEIGHTED, src.size(), src.data(),
+                                   MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                                   &comm);
+
+    // Neighbourhood rank of the owner of each entry
+    std::vector<int> entry_rank(rows.size());
+    std::vector<int> send_sizes(src.size(), 0);
+    for (std::size_t e = 0; e < rows.size(); ++e)
+    {
+      const int owner = owners[rows[e] / map_bs0 - map0->size_local()];
+      auto it = std::ranges::lower_bound(src, owner);
+      assert(it != src.end() and *it == owner);
+      entry_rank[e] = std::distance(src.begin(), it);
+      ++send_sizes[entry_rank[e]];
+    }
+
+    std::vector<int> send_disp(src.size() + 1, 0);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     std::next(send_disp.begin()));
+    std::vector<std::int64_t> send_idx(2 * rows.size());
+    std::vector<T> send_vals(rows.size());
+    {
+      std::vector<int> insert_pos = send_disp;
+      for (std::size_t e = 0; e < rows.size(); ++e)
+      {
+        const int p = insert_pos[entry_rank[e]]++;
+        send_idx[2 * p] = global_row(rows[e]);
+        send_idx[2 * p + 1] = cols[e];
+        send_vals[p] = vals[e];
+      }
+    }
+    rows.clear();
+    cols.clear();
+    vals.clear();
+
+    std::vector<int> recv_sizes(dest.size());
+    send_sizes.reserve(1);
+    recv_sizes.reserve(1);
+    MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                          MPI_INT, comm);
+    std::vector<int> recv_disp(dest.size() + 1, 0);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_disp.begin()));
+
+    std::vector<T> vals_b(recv_disp.back());
+    MPI_Neighbor_alltoallv(send_vals.data(), send_sizes.data(),
+                           send_disp.data(), dolfinx::MPI::mpi_t<T>,
+                           vals_b.data(), recv_sizes.data(), recv_disp.data(),
+                           dolfinx::MPI::mpi_t<T>, comm);
+
+    // Each entry has a (row, column) index pair
+    for (auto v : {&send_sizes, &send_disp, &recv_sizes, &recv_disp})
+      std::ranges::transform(*v, v->begin(), [](auto n) { return 2 * n; });
+    std::vector<std::int64_t> idx_b(recv_disp.back());
+    MPI_Neighbor_alltoallv(send_idx.data(), send_sizes.data(),
+                           send_disp.data(), MPI_INT64_T, idx_b.data(),
+                           recv_sizes.data(), recv_disp.data(), MPI_INT64_T,
+                           comm);
+    MPI_Comm_free(&comm);
+
+    // Sort received entries by row
+    std::vector<std::int32_t> perm(vals_b.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::ranges::stable_sort(perm, [&idx_b](auto p, auto q)
+                             { return idx_b[2 * p] < idx_b[2 * q]; });
+    for (std::int32_t p : perm)
+    {
+      recv_rows.push_back(idx_b[2 * p] - row_offset);
+      recv_cols.push_back(idx_b[2 * p + 1]);
+      recv_vals.push_back(vals_b[p]);
+    }
+  }
+
+  // Assemble and emit the blocks
+  const bool set_diag = V0 == V1 and !markers[0].empty();
+  std::vector<std::int32_t> perm;
+  std::vector<std::int64_t> row_ptr, block_cols;
+  std::vector<T> block_vals;
+  for (std::size_t b = 0; b < num_blocks; ++b)
+  {
+    r0 = b * block_size;
+    r1 = std::min<std::int32_t>(r0 + block_size, num_rows);
+    impl::assemble_matrix(mat_add, a, _x, constants, coefficients,
+                          markers[0], markers[1], 1, std::cref(positions[b]));
+
+    // Add the received ghost row entries
+    auto it0 = std::ranges::lower_bound(recv_rows, r0);
+    auto it1 = std::ranges::lower_bound(recv_rows, r1);
+    for (auto it = it0; it != it1; ++it)
+    {
+      std::size_t p = std::distance(recv_rows.begin(), it);
+      rows.push_back(*it);
+      cols.push_back(recv_cols[p]);
+      vals.push_back(recv_vals[p]);
+    }
+
+    if (set_diag)
+    {
+      for (std::int32_t r = r0; r < r1; ++r)
+      {
+        if (markers[0][r])
+        {
+          rows.push_back(r);
+          cols.push_back(global_col(r));
+          vals.push_back(diagonal);
+        }
+      }
+    }
+
+    // Sort the entries by row and column, and sum duplicates
+    perm.resize(rows.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::ranges::sort(perm,
+                      [&](auto p, auto q) {
+                        return std::tie(rows[p], cols[p])
+                               < std::tie(rows[q], cols[q]);
+                      });
+    row_ptr.assign(r1 - r0 + 1, 0);
+    block_cols.clear();
+    block_vals.clear();
+    for (std::size_t k = 0; k < perm.size(); ++k)
+    {
+      const std::int32_t p = perm[k];
+      if (k > 0 and rows[p] == rows[perm[k - 1]]
+          and cols[p] == cols[perm[k - 1]])
+      {
+        block_vals.back() += vals[p];
+      }
+      else
+      {
+        ++row_ptr[rows[p] - r0 + 1];
+        block_cols.push_back(cols[p]);
+        block_vals.push_back(vals[p]);
+      }
+    }
+    std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+
+    fn(row_offset + r0, row_ptr, block_cols, block_vals);
+
+    // Free the block
+    rows = std::vector<std::int32_t>();
+    cols = std::vector<std::int64_t>();
+    vals = std::vector<T>();
+    perm = std::vector<std::int32_t>();
+    block_cols = std::vector<std::int64_t>();
+    block_vals = std::vector<T>();
+  }
+}
+
+/// @brief Assemble a bilinear form in blocks of rows, passing each
+/// block of the assembled matrix to a callback.
+///
+/// Constants and coefficients are packed before assembly (see the
+/// overload above).
+///
+/// @note Collective MPI operation.
+///
+/// @param[in] fn Function called for each block.
+/// @param[in] a Bilinear form to assemble.
+/// @param[in] bcs Boundary conditions to apply.
+/// @param[in] block_size Maximum number of rows in a block.
+/// @param[in] diagonal Value of the diagonal for boundary condition
+/// rows.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_streamed(
+    const std::function<void(std::int64_t, std::span<const std::int64_t>,
+                             std::span<const std::int64_t>,
+                             std::span<const T>)>& fn,
+    const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    std::int32_t block_size, T diagonal = 1)
+{
+  std::span<const T> constants = a.packed_constants();
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients);
+  assemble_matrix_streamed(fn, a, std::span(constants),
+                           make_coefficients_span(coefficients), bcs,
+                           block_size, diagonal);
+}
+
+/// @brief Assemble a bilinear form into a matrix and a linear form into
+/// a vector, in a single pass over the cells.
+///
+/// The result is equal to assemble_matrix() for `a` followed by
+/// assemble_vector() for `L`. Cell integrals with the same identifier
+/// and integration domain in `a` and `L` are fused, i.e. the geometry
+/// of each cell is gathered once and both kernels are executed (see
+/// impl::assemble_matrix_vector_cells()). This is typically used to
+/// assemble the Jacobian and residual of a nonlinear problem together.
+/// Forms on different meshes, or on mixed-topology meshes, are not
+/// fused. The remaining integrals are assembled separately.
+///
+/// @note Boundary condition lifting is not applied to `b`, and values
+/// are not set for boundary condition rows (see
+/// assemble_vector_lifted() and set_diagonal()).
+///
+/// @note Ghost contributions to `b` are not accumulated (not sent to
+/// owner). Caller is responsible for reverse-scatter to update the
+/// ghosts.
+///
+/// @param[in] mat_add The function for adding values into the matrix.
+/// @param[in,out] b Vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] a Bilinear form.
+/// @param[in] L Linear form. It must have the same test function space
+/// as `a`.
+/// @param[in] constants_a Constants that appear in `a`.
+/// @param[in] coeffs_a Coefficients that appear in `a`.
+/// @param[in] constants_L Constants that appear in `L`.
+/// @param[in] coeffs_L Coefficients that appear in `L`.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column of the matrix are zeroed. The diagonal
+/// entry is not set.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_vector(
+    la::MatSet<T> auto mat_add, std::span<T> b, const Form<T, U>& a,
+    const Form<T, U>& L, std::span<const T> constants_a,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coeffs_a,
+    std::span<const T> constants_L,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coeffs_L,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  using mdspanx3_t
+      = md::mdspan<const scalar_value_t<T>,
+                   md::extents<std::size_t, md::dynamic_extent, 3>>;
+
+  auto V0 = a.function_spaces().at(0);
+  assert(V0);
+  assert(L.function_spaces().at(0));
+  if (V0->dofmap() != L.function_spaces()[0]->dofmap())
+  {
+    throw std::runtime_error(
+        "Linear and bilinear forms must have the same test space.");
+  }
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  auto [bc0, bc1] = impl::mark_bc_dofs(a, bcs);
+
+  // Cell integrals of a and L over the same cells are fused
+  std::vector<int> fused;
+  if (L.mesh() == mesh and mesh->topology()->cell_types().size() == 1)
+  {
+    std::vector<int> ids = L.integral_ids(IntegralType::cell);
+    for (int i : a.integral_ids(IntegralType::cell))
+    {
+      if (std::ranges::find(ids, i) != ids.end()
+          and std::ranges::equal(a.domain(IntegralType::cell, i, 0),
+                                 L.domain(IntegralType::cell, i, 0))
+          and std::ranges::equal(a.domain_arg(IntegralType::cell, 0, i, 0),
+                                 L.domain_arg(IntegralType::cell, 0, i, 0)))
+      {
+        fused.push_back(i);
+      }
+    }
+  }
+
+  // Positions of the entities of the integrals that are not fused
+  auto unfused_positions = [&fused](const Form<T, U>& form)
+  {
+    std::map<std::tuple<IntegralType, int, int>, std::vector<std::int32_t>>
+        positions;
+    const int num_cell_types = form.mesh()->topology()->cell_types().size();
+    for (auto [type, size] : {std::pair{IntegralType::cell, 1},
+                              std::pair{IntegralType::exterior_facet, 2},
+                              std::pair{IntegralType::interior_facet, 4}})
+    {
+      const int num_kernels = type == IntegralType::cell ? num_cell_types : 1;
+      for (int i : form.integral_ids(type))
+      {
+        for (int kernel_idx = 0; kernel_idx < num_kernels; ++kernel_idx)
+        {
+          std::vector<std::int32_t>& p = positions[{type, i, kernel_idx}];
+          if (type != IntegralType::cell
+              or std::ranges::find(fused, i) == fused.end())
+          {
+            p.resize(form.domain(type, i, kernel_idx).size() / size);
+            std::iota(p.begin(), p.end(), 0);
+          }
+        }
+      }
+    }
+    return positions;
+  };
+
+  const auto positions_a = unfused_positions(a);
+  const auto positions_L = unfused_positions(L);
+  auto assemble = [&](mdspanx3_t x)
+  {
+    impl::assemble_matrix(mat_add, a, x, constants_a, coeffs_a, bc0, bc1, 1,
+                          std::cref(positions_a));
+    impl::assemble_vector(b, L, x, constants_L, coeffs_L, 1,
+                          std::cref(positions_L));
+    if (fused.empty())
+      return;
+
+    auto V1 = a.function_spaces().at(1);
+    assert(V1);
+    auto dofmap0 = V0->dofmap()->map();
+    const int bs0 = V0->dofmap()->bs();
+    auto element0 = V0->element();
+    assert(element0);
+    auto dofmap1 = V1->dofmap()->map();
+    const int bs1 = V1->dofmap()->bs();
+    auto element1 = V1->element();
+    assert(element1);
+
+    std::span<const std::uint32_t> cell_info0;
+    std::span<const std::uint32_t> cell_info1;
+    if (element0->needs_dof_transformations()
+        or element1->needs_dof_transformations())
+    {
+      V0->mesh()->topology_mutable()->create_entity_permutations();
+      V1->mesh()->topology_mutable()->create_entity_permutations();
+      cell_info0
+          = std::span(V0->mesh()->topology()->get_cell_permutation_info());
+      cell_info1
+          = std::span(V1->mesh()->topology()->get_cell_permutation_info());
+    }
+
+    // DOF transformations, cached on the spaces
+    std::shared_ptr<const fem::DofTransformation<T>> P0_ptr
+        = V0->template dof_transformation<T>(
+            0, doftransform::standard, false);
+    std::shared_ptr<const fem::DofTransformation<T>> P1T_ptr
+        = V1->template dof_transformation<T>(
+            0, doftransform::transpose, true);
+    fem::DofTransformKernel<T> auto P0 = std::cref(*P0_ptr);
+    fem::DofTransformKernel<T> auto P1T = std::cref(*P1T_ptr);
+
+    impl::mdspan2_t x_dofmap = mesh->geometry().dofmap();
+    for (int i : fused)
+    {
+      auto kernel_a = a.kernel(IntegralType::cell, i, 0);
+      assert(kernel_a);
+      auto kernel_L = L.kernel(IntegralType::cell, i, 0);
+      assert(kernel_L);
+      std::span cells = a.domain(IntegralType::cell, i, 0);
+      std::span cells0 = a.domain_arg(IntegralType::cell, 0, i, 0);
+      std::span cells1 = a.domain_arg(IntegralType::cell, 1, i, 0);
+      auto& [_coeffs_a, cstride_a] = coeffs_a.at({IntegralType::cell, i});
+      auto& [_coeffs_L, cstride_L] = coeffs_L.at({IntegralType::cell, i});
+      assert(_coeffs_a.size() == cells.size() * cstride_a);
+      assert(_coeffs_L.size() == cells.size() * cstride_L);
+      md::mdspan<const T, md::dextents<std::size_t, 2>> c_a(
+          _coeffs_a.data(), cells.size(), cstride_a);
+      md::mdspan<const T, md::dextents<std::size_t, 2>> c_L(
+          _coeffs_L.data(), cells.size(), cstride_L);
+
+      if (bs0 == 1 and bs1 == 1)
+      {
+        impl::assemble_matrix_vector_cells<T, 1, 1>(
+            mat_add, b, x_dofmap, x, cells, {dofmap0, bs0, cells0}, P0,
+            {dofmap1, bs1, cells1}, P1T, bc0, bc1, kernel_a, constants_a,
+            c_a, kernel_L, constants_L, c_L, cell_info0, cell_info1);
+      }
+      else if (bs0 == 3 and bs1 == 3)
+      {
+        impl::assemble_matrix_vector_cells<T, 3, 3>(
+            mat_add, b, x_dofmap, x, cells, {dofmap0, bs0, cells0}, P0,
+            {dofmap1, bs1, cells1}, P1T, bc0, bc1, kernel_a, constants_a,
+            c_a, kernel_L, constants_L, c_L, cell_info0, cell_info1);
+      }
+      else
+      {
+        impl::assemble_matrix_vector_cells<T>(
+            mat_add, b, x_dofmap, x, cells, {dofmap0, bs0, cells0}, P0,
+            {dofmap1, bs1, cells1}, P1T, bc0, bc1, kernel_a, constants_a,
+            c_a, kernel_L, constants_L, c_L, cell_info0, cell_info1);
+      }
+    }
+  };
+
+  std::span x = mesh->geometry().x();
+  if constexpr (std::is_same_v<U, scalar_value_t<T>>)
+    assemble(mdspanx3_t(x.data(), x.size() / 3, 3));
+  else
+  {
+    std::vector<scalar_value_t<T>> _x(x.begin(), x.end());
+    assemble(mdspanx3_t(_x.data(), _x.size() / 3, 3));
+  }
+}
+
+/// @brief Assemble a bilinear form into a matrix and a linear form into
+/// a vector, in a single pass over the cells.
+///
+/// The constant and coefficient data of the forms are packed, and then
+/// assemble_matrix_vector() is called (see the packed data version for
+/// a detailed description).
+///
+/// If `a` and `L` have the same coefficients, as for a residual and its
+/// Jacobian, the coefficients of integrals with the same type,
+/// identifier and integration domain are packed once and shared by the
+/// two forms.
+///
+/// @param[in] mat_add The function for adding values into the matrix.
+/// @param[in,out] b Vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] a Bilinear form.
+/// @param[in] L Linear form. It must have the same test function space
+/// as `a`.
+/// @param[in] bcs Boundary conditions to apply to the matrix.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_vector(
+    la::MatSet<T> auto mat_add, std::span<T> b, const Form<T, U>& a,
+    const Form<T, U>& L,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  std::span<const T> constants_a = a.packed_constants();
+  std::span<const T> constants_L = L.packed_constants();
+  auto coeffs_L = allocate_coefficient_storage(L);
+  pack_coefficients(L, coeffs_L);
+
+  // Integrals of a with the same packed coefficient data as L
+  std::vector<std::pair<IntegralType, int>> shared;
+  if (!a.coefficients().empty() and a.coefficients() == L.coefficients()
+      and a.mesh() == L.mesh()
+      and a.mesh()->topology()->cell_types().size() == 1)
+  {
+    for (IntegralType type : a.integral_types())
+    {
+      for (int i : a.integral_ids(type))
+      {
+        if (coeffs_L.contains({type, i})
+            and std::ranges::equal(a.domain(type, i, 0),
+                                   L.domain(type, i, 0)))
+        {
+          shared.emplace_back(type, i);
+        }
+      }
+    }
+  }
+
+  // Pack the coefficients of the shared integrals that are active in a
+  // but not in L
+  if (!shared.empty())
+  {
+    std::vector<std::int8_t> packed(a.coefficients().size(), false);
+    for (auto [type, i] : shared)
+    {
+      std::vector<int> active_L = L.active_coeffs(type, i);
+      for (int c : a.active_coeffs(type, i))
+      {
+        if (std::ranges::find(active_L, c) == active_L.end())
+          packed[c] = true;
+      }
+    }
+
+    if (std::ranges::find(packed, true) != packed.end())
+    {
+      std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>
+          storage;
+      for (auto& key : shared)
+        storage.insert(coeffs_L.extract(key));
+      impl::pack_coefficients(a, storage, packed, 1);
+      coeffs_L.merge(storage);
+    }
+  }
+
+  std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>
+      coeffs_a;
+  for (IntegralType type : a.integral_types())
+  {
+    for (int i : a.integral_ids(type))
+    {
+      if (std::ranges::find(shared, std::pair{type, i}) == shared.end())
+      {
+        coeffs_a.emplace(std::pair{type, i},
+                         allocate_coefficient_storage(a, type, i));
+      }
+    }
+  }
+  pack_coefficients(a, coeffs_a);
+
+  auto _coeffs_L = make_coefficients_span(coeffs_L);
+  auto _coeffs_a = make_coefficients_span(coeffs_a);
+  for (auto& key : shared)
+    _coeffs_a.emplace(key, _coeffs_L.at(key));
+  assemble_matrix_vector(mat_add, b, a, L, std::span(constants_a), _coeffs_a,
+                         std::span(constants_L), _coeffs_L, bcs);
+}
+
+/// @brief Sets a value to the diagonal of a matrix for specified rows.
+///
+/// This function is typically called after assembly. The assembly
+/// function zeroes Dirichlet rows and columns. For block matrices, this
+/// function should normally be called only on the diagonal blocks, i.e.
+/// blocks for which the test and trial spaces are the same.
+///
+/// @param[in] set_fn The function for setting values to a matrix.
+/// @param[in] rows Row blocks, in local indices, for which to add a
+/// value to the diagonal.
+/// @param[in] diagonal Value to add to the diagonal for the specified
+/// rows.
+template <dolfinx::scalar T>
+void set_diagonal(auto set_fn, std::span<const std::int32_t> rows,
                   T diagonal = 1.0)
 {
   for (std::size_t i = 0; i < rows.size(); ++i)
@@ -592,4 +2454,276 @@ void set_diagonal(
   }
 }
 
+/// @brief Assemble the diagonal of a bilinear form into a vector.
+///
+/// The element matrices are tabulated as for assemble_matrix(), but
+/// only the entries that contribute to the diagonal are accumulated, so
+/// the memory required is proportional to the number of
+/// degrees-of-freedom rather than the number of matrix non-zeros. For
+/// boundary condition dofs the diagonal is set to `diagonal`. The
+/// result is the diagonal of the matrix assembled by
+/// assemble_matrix() followed by set_diagonal(), and can be used for
+/// Jacobi preconditioning and polynomial smoothers (see
+/// la/smoothers.h).
+///
+/// @note Collective MPI operation.
+/// @pre The test and trial function spaces are the same.
+///
+/// @param[out] d Diagonal, in the test function space. It is zeroed
+/// before assembly. On return the owned and ghost entries are set.
+/// @param[in] a Bilinear form.
+/// @param[in] constants Constants that appear in `a`.
+/// @param[in] coefficients Coefficients that appear in `a`.
+/// @param[in] bcs Boundary conditions.
+/// @param[in] diagonal Value of the diagonal for boundary condition
+/// dofs.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_diagonal(
+    la::Vector<T>& d, const Form<T, U>& a, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    T diagonal = 1)
+{
+  if (a.function_spaces().at(0) != a.function_spaces().at(1))
+  {
+    throw std::runtime_error(
+        "Diagonal requires the same test and trial function spaces.");
+  }
+
+  static const std::uint32_t trace_region
+      = common::trace::region("assemble_diagonal");
+  common::TraceRegion trace(trace_region);
+
+  const int bs = d.bs();
+  std::span<T> _d = d.mutable_array();
+  std::ranges::fill(_d, 0);
+
+  // Add the element matrix entries for which the row and column dofs
+  // are the same. For interior facet integrals a dof can appear twice
+  // in the element dofs.
+  auto diag_add = [_d, bs](std::span<const std::int32_t> rows,
+                           std::span<const std::int32_t> cols,
+                           std::span<const T> Ae)
+  {
+    const std::size_t ndim1 = bs * cols.size();
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+      for (std::size_t j = 0; j < cols.size(); ++j)
+      {
+        if (rows[i] == cols[j])
+        {
+          for (int k = 0; k < bs; ++k)
+            _d[bs * rows[i] + k] += Ae[(bs * i + k) * ndim1 + bs * j + k];
+        }
+      }
+    }
+  };
+
+  // Boundary condition rows and columns are zeroed
+  auto [bc0, bc1] = impl::mark_bc_dofs(a, bcs);
+  assemble_matrix(diag_add, a, constants, coefficients,
+                  std::span<const std::int8_t>(bc0),
+                  std::span<const std::int8_t>(bc1));
+  d.scatter_rev(std::plus<T>());
+
+  // Set diagonal for boundary condition rows
+  const std::size_t num_owned = bs * d.index_map()->size_local();
+  for (std::size_t i = 0; i < std::min(num_owned, bc0.size()); ++i)
+  {
+    if (bc0[i])
+      _d[i] = diagonal;
+  }
+
+  d.scatter_fwd();
+}
+
+/// @brief Assemble the diagonal of a bilinear form into a vector.
+///
+/// Constants and coefficients are packed before assembly (see the
+/// overload above).
+///
+/// @note Collective MPI operation.
+/// @pre The test and trial function spaces are the same.
+///
+/// @param[out] d Diagonal, in the test function space.
+/// @param[in] a Bilinear form.
+/// @param[in] bcs Boundary conditions.
+/// @param[in] diagonal Value of the diagonal for boundary condition
+/// dofs.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_diagonal(
+    la::Vector<T>& d, const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    T diagonal = 1)
+{
+  std::span<const T> constants = a.packed_constants();
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients);
+  assemble_diagonal(d, a, std::span(constants),
+                    make_coefficients_span(coefficients), bcs, diagonal);
+}
+
+/// @brief Create a la::BlockDiagonalMatrix for the element matrices
+/// of a bilinear form.
+///
+/// The matrix has one block for each cell owned by this process, with
+/// the (unrolled) cell degrees-of-freedom of the test function space.
+/// The blocks are zero.
+///
+/// @pre The test and trial function spaces are the same and the mesh
+/// has one cell type.
+///
+/// @param[in] a Bilinear form.
+/// @return Matrix with zero blocks.
+template <dolfinx::scalar T, std::floating_point U>
+la::BlockDiagonalMatrix<T> create_block_diagonal_matrix(const Form<T, U>& a)
+{
+  std::shared_ptr<const FunctionSpace<U>> V = a.function_spaces().at(0);
+  if (V != a.function_spaces().at(1))
+  {
+    throw std::runtime_error(
+        "Block-diagonal matrices require the same test and trial function "
+        "spaces.");
+  }
+  if (V->mesh()->topology()->cell_types().size() != 1)
+  {
+    throw std::runtime_error(
+        "Block-diagonal matrices require a single cell type.");
+  }
+
+  const DofMap& dofmap = *V->dofmap();
+  const int bs = dofmap.bs();
+  const int num_dofs = dofmap.map().extent(1);
+  const int tdim = V->mesh()->topology()->dim();
+  const std::int32_t num_cells
+      = V->mesh()->topology()->index_map(tdim)->size_local();
+  std::vector<std::int32_t> dofs;
+  dofs.reserve(num_cells * num_dofs * bs);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    for (std::int32_t dof : dofmap.cell_dofs(c))
+      for (int k = 0; k < bs; ++k)
+        dofs.push_back(bs * dof + k);
+  }
+
+  return la::BlockDiagonalMatrix<T>(std::move(dofs), bs * num_dofs);
+}
+
+/// @brief Assemble the element matrices of a bilinear form into the
+/// blocks of a la::BlockDiagonalMatrix.
+///
+/// The element matrix of each owned cell is tabulated directly into
+/// its block, without inserting into a sparse matrix. The element
+/// matrices of the cell integrals of the form are added to the blocks,
+/// e.g. to compute a DG mass matrix that is then inverted with
+/// la::BlockDiagonalMatrix::factorize and la::BlockDiagonalMatrix::solve.
+///
+/// @pre `A` was created by create_block_diagonal_matrix() for `a`, and
+/// `a` has only cell integrals.
+///
+/// @param[in,out] A Matrix to assemble into. It is not zeroed before
+/// assembly.
+/// @param[in] a Bilinear form.
+/// @param[in] constants Constants that appear in `a`.
+/// @param[in] coefficients Coefficients that appear in `a`.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_block_diagonal(
+    la::BlockDiagonalMatrix<T>& A, const Form<T, U>& a,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  if (!a.integral_ids(IntegralType::exterior_facet).empty()
+      or !a.integral_ids(IntegralType::interior_facet).empty())
+  {
+    throw std::runtime_error(
+        "Block-diagonal assembly supports only cell integrals.");
+  }
+  if (A.factorized())
+    throw std::runtime_error("Cannot assemble into a factorised matrix.");
+
+  static const std::uint32_t trace_region
+      = common::trace::region("assemble_block_diagonal");
+  common::TraceRegion trace(trace_region);
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  std::shared_ptr<const FunctionSpace<U>> V = a.function_spaces().at(0);
+  auto element = V->element();
+  assert(element);
+  std::span<const std::uint32_t> cell_info;
+  if (element->needs_dof_transformations())
+  {
+    V->mesh()->topology_mutable()->create_entity_permutations();
+    cell_info = std::span(V->mesh()->topology()->get_cell_permutation_info());
+  }
+  // DOF transformations, cached on the spaces
+  std::shared_ptr<const fem::DofTransformation<T>> P0_ptr
+      = V->template dof_transformation<T>(
+          0, doftransform::standard, false);
+  std::shared_ptr<const fem::DofTransformation<T>> P1T_ptr
+      = V->template dof_transformation<T>(
+          0, doftransform::transpose, true);
+  fem::DofTransformKernel<T> auto P0 = std::cref(*P0_ptr);
+  fem::DofTransformKernel<T> auto P1T = std::cref(*P1T_ptr);
+
+  const int n = A.block_size();
+  std::span<const U> x = mesh->geometry().x();
+  impl::mdspan2_t x_dofmap = mesh->geometry().dofmap();
+  std::vector<scalar_value_t<T>> cdofs(3 * x_dofmap.extent(1));
+  for (int i : a.integral_ids(IntegralType::cell))
+  {
+    auto kernel = a.kernel(IntegralType::cell, i, 0);
+    assert(kernel);
+    std::span cells = a.domain(IntegralType::cell, i, 0);
+    std::span cells0 = a.domain_arg(IntegralType::cell, 0, i, 0);
+    std::span cells1 = a.domain_arg(IntegralType::cell, 1, i, 0);
+    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+    for (std::size_t c = 0; c < cells.size(); ++c)
+    {
+      // Cells that are not owned have no block
+      std::int32_t cell0 = cells0[c];
+      if (cell0 >= A.num_blocks())
+        continue;
+
+      // Gather cell coordinates
+      auto x_dofs = md::submdspan(x_dofmap, cells[c], md::full_extent);
+      for (std::size_t j = 0; j < x_dofs.size(); ++j)
+      {
+        std::copy_n(std::next(x.begin(), 3 * x_dofs[j]), 3,
+                    std::next(cdofs.begin(), 3 * j));
+      }
+
+      // Tabulate the element matrix into the block, which the kernel
+      // adds to
+      std::span<T> Ae = A.block(cell0);
+      kernel(Ae.data(), coeffs.data() + c * cstride, constants.data(),
+             cdofs.data(), nullptr, nullptr, nullptr);
+      P0(Ae, cell_info, cell0, n);
+      P1T(Ae, cell_info, cells1[c], n);
+    }
+  }
+}
+
+/// @brief Assemble the element matrices of a bilinear form into the
+/// blocks of a la::BlockDiagonalMatrix.
+///
+/// Constants and coefficients are packed before assembly (see the
+/// overload above).
+///
+/// @param[in,out] A Matrix to assemble into. It is not zeroed before
+/// assembly.
+/// @param[in] a Bilinear form.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_block_diagonal(la::BlockDiagonalMatrix<T>& A,
+                             const Form<T, U>& a)
+{
+  std::span<const T> constants = a.packed_constants();
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients);
+  assemble_block_diagonal(A, a, std::span(constants),
+                          make_coefficients_span(coefficients));
+}
+
 } // namespace dolfinx::fem
@@ -0,0 +1,147 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <basix/mdspan.hpp>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// @file batch.h
+/// @brief Tools for executing batched (cross-entity vectorised)
+/// kernels.
+///
+/// A batched kernel tabulates the element tensors of `W` entities
+/// (lanes) in a single call. Per-entity data is passed in a
+/// structure-of-arrays layout with the lane index running fastest, see
+/// integral_data::kernel_batch.
+
+namespace dolfinx::fem::impl
+{
+/// @brief Call `fn(std::integral_constant<int, W>{})` with `W` the
+/// run-time batch size `batch_size` as a compile-time constant.
+/// @param[in] batch_size Batch size. Must be 4, 8 or 16.
+/// @param[in] fn Function to call.
+template <typename F>
+void dispatch_batch_size(int batch_size, F&& fn)
+{
+  switch (batch_size)
+  {
+  case 4:
+    fn(std::integral_constant<int, 4>{});
+    break;
+  case 8:
+    fn(std::integral_constant<int, 8>{});
+    break;
+  case 16:
+    fn(std::integral_constant<int, 16>{});
+    break;
+  default:
+    throw std::runtime_error("Unsupported kernel batch size.");
+  }
+}
+
+/// @brief Compute the positions in an entity list of the entities in a
+/// batch.
+///
+/// If fewer than `W` entities remain, the unused lanes repeat the last
+/// entity of the batch so that the kernel always operates on valid
+/// data. The results for these lanes must be discarded.
+///
+/// @tparam W Batch size.
+/// @param[in] p0 Index (relative to `positions`) of the first entity in
+/// the batch.
+/// @param[in] num_entities Total number of entities.
+/// @param[in] positions Positions of the entities in the entity list.
+/// If not set, the entity at index `p` is at position `p`.
+/// @return Positions of the entities in each lane in the entity list,
+/// and the number of lanes with valid entities.
+template <int W>
+std::pair<std::array<std::size_t, W>, int>
+batch_positions(std::size_t p0, std::size_t num_entities,
+                std::optional<std::span<const std::int32_t>> positions)
+{
+  assert(p0 < num_entities);
+  const int num_lanes = std::min<std::size_t>(W, num_entities - p0);
+  std::array<std::size_t, W> pos;
+  for (int w = 0; w < W; ++w)
+  {
+    std::size_t p = p0 + std::min(w, num_lanes - 1);
+    pos[w] = positions ? (*positions)[p] : p;
+  }
+
+  return {pos, num_lanes};
+}
+
+/// @brief Pack the coordinate dofs of a batch of cells into a
+/// structure-of-arrays array of shape `(num_dofs_g, 3, W)`.
+/// @tparam W Batch size.
+/// @param[out] cdofs Packed coordinate dofs.
+/// @param[in] x_dofmap Dofmap for the mesh geometry.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] cells Cell (geometry dofmap) index for each lane.
+template <int W, std::floating_point U>
+void pack_coordinate_dofs_batch(
+    std::span<U> cdofs,
+    md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> x_dofmap,
+    md::mdspan<const U, md::extents<std::size_t, md::dynamic_extent, 3>> x,
+    std::span<const std::int32_t, W> cells)
+{
+  assert(cdofs.size() == 3 * x_dofmap.extent(1) * W);
+  for (int w = 0; w < W; ++w)
+  {
+    for (std::size_t i = 0; i < x_dofmap.extent(1); ++i)
+    {
+      const std::int32_t xd = x_dofmap(cells[w], i);
+      for (std::size_t j = 0; j < 3; ++j)
+        cdofs[(3 * i + j) * W + w] = x(xd, j);
+    }
+  }
+}
+
+/// @brief Pack the coefficients of a batch of entities into a
+/// structure-of-arrays array of shape `(cstride, W)`.
+/// @tparam W Batch size.
+/// @param[out] w Packed coefficients.
+/// @param[in] coeffs Coefficient data of shape `(num_entities,
+/// cstride)`.
+/// @param[in] pos Position (row in `coeffs`) of the entity in each
+/// lane.
+template <int W, dolfinx::scalar T>
+void pack_coefficients_batch(
+    std::span<T> w, md::mdspan<const T, md::dextents<std::size_t, 2>> coeffs,
+    std::span<const std::size_t, W> pos)
+{
+  assert(w.size() == coeffs.extent(1) * W);
+  for (int lane = 0; lane < W; ++lane)
+    for (std::size_t j = 0; j < coeffs.extent(1); ++j)
+      w[j * W + lane] = coeffs(pos[lane], j);
+}
+
+/// @brief Extract the element tensor of one lane from a batched
+/// element tensor of shape `(Ae.size(), W)`.
+/// @tparam W Batch size.
+/// @param[out] Ae Element tensor for lane `lane`.
+/// @param[in] Ab Batched element tensor.
+/// @param[in] lane Lane index.
+template <int W, dolfinx::scalar T>
+void extract_batch_lane(std::span<T> Ae, std::span<const T> Ab, int lane)
+{
+  assert(Ab.size() == Ae.size() * W);
+  for (std::size_t i = 0; i < Ae.size(); ++i)
+    Ae[i] = Ab[i * W + lane];
+}
+} // namespace dolfinx::fem::impl
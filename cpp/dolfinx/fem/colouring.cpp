@@ -0,0 +1,131 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "colouring.h"
+#include "Form.h"
+#include <algorithm>
+#include <dolfinx/graph/colouring.h>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Number of entries per entity in an integration entity list, and
+/// number of cells attached to each entity
+std::array<std::size_t, 2> entity_layout(fem::IntegralType type)
+{
+  switch (type)
+  {
+  case fem::IntegralType::cell:
+    return {1, 1};
+  case fem::IntegralType::exterior_facet:
+  case fem::IntegralType::vertex:
+    return {2, 1};
+  case fem::IntegralType::interior_facet:
+    return {4, 2};
+  default:
+    throw std::runtime_error("Integral type not supported.");
+  }
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> fem::compute_colouring(
+    IntegralType type,
+    md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> dofmap,
+    std::span<const std::int32_t> entities)
+{
+  auto [stride, num_cells] = entity_layout(type);
+
+  // Build list of dofs for each entity in the integration domain.
+  // Entities that share a dof conflict.
+  const std::size_t num_entities = entities.size() / stride;
+  const std::size_t num_dofs = dofmap.extent(1);
+  std::vector<std::int32_t> dofs(num_entities * num_cells * num_dofs);
+  for (std::size_t e = 0; e < num_entities; ++e)
+  {
+    for (std::size_t k = 0; k < num_cells; ++k)
+    {
+      std::int32_t c = entities[e * stride + 2 * k];
+      std::copy_n(dofmap.data_handle() + c * num_dofs, num_dofs,
+                  std::next(dofs.begin(), (e * num_cells + k) * num_dofs));
+    }
+  }
+
+  return graph::compute_colouring(
+      graph::regular_adjacency_list(std::move(dofs), num_cells * num_dofs));
+}
+//-----------------------------------------------------------------------------
+std::array<std::vector<std::int32_t>, 2> fem::partition_by_ghosts(
+    IntegralType type,
+    md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> dofmap,
+    std::int32_t num_owned, std::span<const std::int32_t> entities)
+{
+  auto [stride, num_cells] = entity_layout(type);
+  const std::size_t num_entities = entities.size() / stride;
+  std::array<std::vector<std::int32_t>, 2> partition;
+  for (std::size_t e = 0; e < num_entities; ++e)
+  {
+    bool ghosted = false;
+    for (std::size_t k = 0; k < num_cells; ++k)
+    {
+      auto dofs = md::submdspan(dofmap, entities[e * stride + 2 * k],
+                                md::full_extent);
+      for (std::size_t i = 0; i < dofs.size(); ++i)
+        ghosted = ghosted or dofs[i] >= num_owned;
+    }
+    partition[ghosted ? 0 : 1].push_back(e);
+  }
+
+  return partition;
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t>
+fem::compute_cell_entities(IntegralType type, std::int32_t num_cells,
+                           std::span<const std::int32_t> entities)
+{
+  auto [stride, cells_per_entity] = entity_layout(type);
+  const std::size_t num_entities = entities.size() / stride;
+
+  // Count the entities attached to each cell
+  std::vector<std::int32_t> offsets(num_cells + 1, 0);
+  for (std::size_t e = 0; e < num_entities; ++e)
+    for (std::size_t k = 0; k < cells_per_entity; ++k)
+      ++offsets[entities[e * stride + 2 * k] + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // Positions of the entities attached to each cell, in increasing
+  // order
+  std::vector<std::int32_t> data(offsets.back());
+  std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+  for (std::size_t e = 0; e < num_entities; ++e)
+    for (std::size_t k = 0; k < cells_per_entity; ++k)
+      data[pos[entities[e * stride + 2 * k]]++] = e;
+
+  return graph::AdjacencyList<std::int32_t>(std::move(data),
+                                            std::move(offsets));
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+fem::cell_entity_positions(const graph::AdjacencyList<std::int32_t>& entities,
+                           std::span<const std::int32_t> cells)
+{
+  std::vector<std::int32_t> positions;
+  for (std::int32_t c : cells)
+  {
+    auto e = entities.links(c);
+    positions.insert(positions.end(), e.begin(), e.end());
+  }
+  std::ranges::sort(positions);
+  auto [unique_end, range_end] = std::ranges::unique(positions);
+  positions.erase(unique_end, range_end);
+  return positions;
+}
+//-----------------------------------------------------------------------------
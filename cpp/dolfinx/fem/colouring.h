@@ -0,0 +1,155 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <basix/mdspan.hpp>
+#include <cstdint>
+#include <dolfinx/common/threads.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <exception>
+#include <span>
+#include <vector>
+
+/// @file colouring.h
+/// @brief Colouring and partitioning of integration entities for
+/// thread-parallel and communication-overlapping assembly.
+
+namespace dolfinx::fem
+{
+enum class IntegralType : std::int8_t;
+
+/// @brief Compute a colouring of the entities of an integration domain
+/// such that no two entities with the same colour share a
+/// degree-of-freedom.
+///
+/// Entities with the same colour can be assembled concurrently into a
+/// vector, or into the rows of a matrix, without write conflicts. For
+/// facet integrals, the degrees-of-freedom of an entity are the
+/// degrees-of-freedom of the cell (exterior facets) or of both cells
+/// (interior facets) attached to the facet.
+///
+/// @param[in] type Integral type.
+/// @param[in] dofmap Degree-of-freedom map for the space that is
+/// assembled into, i.e. the test function space.
+/// @param[in] entities Integration entities, e.g. as returned by
+/// Form::domain_arg. For cell integrals it is a list of cell indices.
+/// For exterior facet integrals it is a list of `(cell, local_facet)`
+/// pairs, for vertex integrals a list of `(cell, local_vertex)` pairs,
+/// and for interior facet integrals it is a list of `(cell0,
+/// local_facet0, cell1, local_facet1)` tuples.
+/// @return Adjacency list where `links(c)` are the positions in
+/// `entities` of the entities with colour `c`.
+graph::AdjacencyList<std::int32_t> compute_colouring(
+    IntegralType type,
+    md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> dofmap,
+    std::span<const std::int32_t> entities);
+
+/// @brief Split the entities of an integration domain into entities
+/// that have ghost degrees-of-freedom and entities that have owned
+/// degrees-of-freedom only.
+///
+/// Entities with owned degrees-of-freedom only do not contribute to
+/// the ghost entries of an assembled vector, and can therefore be
+/// assembled while a reverse scatter of the ghost entries is in
+/// progress. The degrees-of-freedom of an entity are as for
+/// compute_colouring().
+///
+/// @param[in] type Integral type.
+/// @param[in] dofmap Degree-of-freedom map for the space that is
+/// assembled into, i.e. the test function space.
+/// @param[in] num_owned Number of owned (blocked) degrees-of-freedom.
+/// Degrees-of-freedom with index `>= num_owned` are ghosts.
+/// @param[in] entities Integration entities (see compute_colouring()).
+/// @return Positions in `entities` of (0) the entities with ghost
+/// degrees-of-freedom and (1) the entities with owned
+/// degrees-of-freedom only.
+std::array<std::vector<std::int32_t>, 2> partition_by_ghosts(
+    IntegralType type,
+    md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> dofmap,
+    std::int32_t num_owned, std::span<const std::int32_t> entities);
+
+/// @brief Compute the integration entities that are attached to each
+/// cell.
+///
+/// @param[in] type Integral type.
+/// @param[in] num_cells Number of cells (including ghost cells) of the
+/// mesh that the cells in `entities` belong to.
+/// @param[in] entities Integration entities (see compute_colouring()).
+/// @return Adjacency list where `links(c)` are the positions in
+/// `entities`, in increasing order, of the entities attached to cell
+/// `c`.
+graph::AdjacencyList<std::int32_t>
+compute_cell_entities(IntegralType type, std::int32_t num_cells,
+                      std::span<const std::int32_t> entities);
+
+/// @brief Positions of the integration entities that are attached to
+/// any of a list of cells.
+///
+/// @param[in] entities Integration entities attached to each cell (see
+/// compute_cell_entities()).
+/// @param[in] cells Cell indices.
+/// @return Sorted positions, without duplicates, of the entities
+/// attached to `cells`.
+std::vector<std::int32_t>
+cell_entity_positions(const graph::AdjacencyList<std::int32_t>& entities,
+                      std::span<const std::int32_t> cells);
+
+namespace impl
+{
+/// @brief Execute a function concurrently over the entities of each
+/// colour of a colouring.
+///
+/// The colours are processed in order. The entities of a colour are
+/// divided into contiguous blocks that are processed concurrently, and
+/// all threads finish a colour before the next colour is started.
+///
+/// @param[in] colouring Colouring, where `colouring.links(c)` are the
+/// entities with colour `c`.
+/// @param[in] num_threads Number of threads.
+/// @param[in] fn Function with signature `void(std::span<const
+/// std::int32_t>)` that processes a block of entities of one colour.
+template <typename F>
+void for_each_colour(const graph::AdjacencyList<std::int32_t>& colouring,
+                     int num_threads, F&& fn)
+{
+  std::barrier sync(num_threads);
+  std::atomic<bool> failed = false;
+  std::exception_ptr error;
+  common::run_threads(
+      num_threads,
+      [&](int t)
+      {
+        for (std::int32_t c = 0; c < colouring.num_nodes(); ++c)
+        {
+          std::span<const std::int32_t> entities = colouring.links(c);
+          auto [i0, i1] = common::thread_range(t, entities.size(), num_threads);
+          if (i1 > i0 and !failed)
+          {
+            try
+            {
+              fn(entities.subspan(i0, i1 - i0));
+            }
+            catch (...)
+            {
+              // Continue to the barrier to avoid a deadlock
+              if (!failed.exchange(true))
+                error = std::current_exception();
+            }
+          }
+          sync.arrive_and_wait();
+        }
+      });
+
+  if (error)
+    std::rethrow_exception(error);
+}
+} // namespace impl
+} // namespace dolfinx::fem
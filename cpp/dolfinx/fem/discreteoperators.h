@@ -9,81 +9,82 @@
 #include "DofMap.h"
 #include "FiniteElement.h"
 #include "FunctionSpace.h"
+#include "interpolate.h"
+#include "sparsitybuild.h"
 #include <algorithm>
 #include <array>
 #include <concepts>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/math.h>
+#include <dolfinx/common/threads.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/la/utils.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <memory>
+#include <numeric>
 #include <span>
 #include <vector>
 
 namespace dolfinx::fem
 {
-
-/// @brief Assemble a discrete curl operator.
-///
-/// For vector-valued finite functions \f$u \in V_{0} \f$ and \f$v \in
-/// V_{1}\f$, consider the interpolation of the curl of \f$u\f$ in the
-/// space \f$V_{1}\f$, i.e. \f$\Pi_{V_{1}}: \nabla \times u \rightarrow
-/// v\f$, where \f$\Pi_{V_{1}}\f$ is the interpolation operator
-/// associated with \f$V_{1}\f$. This interpolation of \f$\nabla \times
-/// u\f$ into \f$V_{1}\f$ is properly posed and exact for specific
-/// choices of function spaces. If \f$V_{0}\f$ is a Nédélec (\f$H({\rm
-/// curl})\f$) space of degree \f$k > 1\f$ and \f$V_{1}\f$ is a
-/// Raviart-Thomas (\f$H({\rm div})\f$) space of degree of at least \f$k
-/// - 1\f$, then the interpolation is exact.
+/// @brief Create the sparsity pattern of a discrete operator that maps
+/// the degrees-of-freedom of `V0` to the degrees-of-freedom of `V1`.
 ///
-/// The implementation of this function exploits the result:
-///
-/// \f[
-///   \hat{\nabla} \times \psi_{C}(\boldsymbol{u}) = \psi_{D}(\nabla \times
-///   \boldsymbol{u}),
-/// \f]
-///
-/// where \f$\psi_{C}\f$ is the covariant pull-back (to the reference
-/// cell) and \f$\psi_{D}\f$ is the contravariant pull-back. See Ern and
-/// Guermond (2021), *Finite Elements I*, Springer Nature,
-/// https://doi.org/10.1007/978-3-030-56341-7 [Corollary 9.9 (Commuting
-/// properties)]. Consequently, the spaces `V0` and `V1` must use
-/// covariant and contravariant maps, respectively.
-///
-/// This function builds a matrix \f$C\f$ (the 'discrete curl'), which
-/// when applied to the degrees-of-freedom of \f$u\f$ gives the
-/// degrees-of-freedom of \f$v\f$ such that \f$v = \nabla \times u\f$.
-/// If the finite element degree-of-freedom vectors associated with
-/// \f$u\f$ and \f$v\f$ are \f$a\f$ and \f$b\f$, respectively, then \f$b
-/// = C a\f$, which yields \f$v = \Pi_{V} \nabla \times u\f$. It
-/// essentially maps that curl of a function in a degree \f$k > 1\f$
-/// Nédélec space into a degree \f$k - 1\f$ Raviart-Thomas space.
+/// The rows of the pattern are the degrees-of-freedom of `V1` and the
+/// columns are the degrees-of-freedom of `V0`. The pattern contains the
+/// entries of the cell matrices of the cells owned by this process,
+/// which are the entries set by fem::discrete_curl,
+/// fem::discrete_gradient and fem::interpolation_matrix.
 ///
-/// The discerete curl is typically used in constructing algebraic
-/// multigrid preconditioners for \f$H({\rm div})\f$ problems, e.g. when
-/// using the Hypre Auxiliary-space Divergence Solver (ADS) to solve a
-/// mixed Poisson in three-dimension.
+/// @note Collective.
 ///
-/// @pre `V0` and `V1` must be vector-valued, in three spatial
-/// dimensions, and use covariant and contravariant maps, respectively.
+/// @param[in] V0 Space of the columns.
+/// @param[in] V1 Space of the rows.
+/// @return Finalised sparsity pattern.
+template <std::floating_point U>
+la::SparsityPattern
+create_discrete_operator_sparsity(const FunctionSpace<U>& V0,
+                                  const FunctionSpace<U>& V1)
+{
+  auto mesh = V0.mesh();
+  assert(mesh);
+  auto dofmap0 = V0.dofmap();
+  assert(dofmap0);
+  auto dofmap1 = V1.dofmap();
+  assert(dofmap1);
+
+  // Create and build sparsity pattern
+  assert(dofmap0->index_map);
+  assert(dofmap1->index_map);
+  la::SparsityPattern sp(mesh->comm(), {dofmap1->index_map, dofmap0->index_map},
+                         {dofmap1->index_map_bs(), dofmap0->index_map_bs()});
+
+  int tdim = mesh->topology()->dim();
+  auto map = mesh->topology()->index_map(tdim);
+  assert(map);
+  std::vector<std::int32_t> c(map->size_local(), 0);
+  std::iota(c.begin(), c.end(), 0);
+  sparsitybuild::cells(sp, {c, c}, {*dofmap1, *dofmap0});
+  sp.finalize();
+
+  return sp;
+}
+
+namespace impl
+{
+/// @brief Assemble a discrete curl operator on a subset of cells.
 ///
-/// @tparam T Scalar type of the mesh and elements. @tparam U Scalar
-/// type of the matrix being inserted into. This is usually the same as
-/// `T`, but may differ for matrix backends that support only a specific
-/// type, e.g. PETSc which supports only one scalar type for a build of
-/// PETSc.
+/// See fem::discrete_curl.
 ///
-/// @param[in] V0 Space that \f$u\f$ is from. It must be a covariant
-/// Piola mapped element. It is normally an \f$H({\rm
-/// curl})\f$-conforming Nédélec space.
-/// @param[in] V1 Space that \f$v\f$ is from. It must be a contravariant
-/// Piola mapped element. It is normally an \f$H({\rm
-/// div})\f$-conforming Raviart-Thomas space of one degree lower than
-/// `V0`.
+/// @param[in] V0 Space that \f$u\f$ is from.
+/// @param[in] V1 Space that \f$v\f$ is from.
+/// @param[in] cells Cells to assemble the operator on.
 /// @param[in] mat_set A functor that sets (not add) values in a matrix
 /// \f$C\f$.
 template <std::floating_point T, dolfinx::scalar U = T>
 void discrete_curl(const FunctionSpace<T>& V0, const FunctionSpace<T>& V1,
+                   std::span<const std::int32_t> cells,
                    la::MatSet<U> auto&& mat_set)
 {
   // Get mesh
@@ -162,7 +163,7 @@ void discrete_curl(const FunctionSpace<T>& V0, const FunctionSpace<T>& V1,
   md::mdspan<const T, md::extents<std::size_t, gdim + 1, md::dynamic_extent,
                                   md::dynamic_extent, 1>>
       Phi_g(Phi_g_b.data(), Phi_g_shape);
-  cmap.tabulate(1, X, Xshape, Phi_g_b);
+  cmap.tabulate_cached(1, X, Xshape, Phi_g_b);
 
   // Geometry data structures
   std::vector<T> coord_dofs_b(num_dofs_g * gdim);
@@ -178,7 +179,7 @@ void discrete_curl(const FunctionSpace<T>& V0, const FunctionSpace<T>& V1,
 
   // Evaluate V0 basis function derivatives at reference interpolation
   // points for V1, (deriv, pt_idx, phi (dof), comp)
-  const auto [Phi0_b, Phi0_shape] = e0->tabulate(X, Xshape, 1);
+  const auto [Phi0_b, Phi0_shape] = e0->tabulate_cached(X, Xshape, 1);
   md::mdspan<const T, md::extents<std::size_t, 4, md::dynamic_extent,
                                   md::dynamic_extent, 3>>
       Phi0(Phi0_b.data(), Phi0_shape);
@@ -207,10 +208,8 @@ void discrete_curl(const FunctionSpace<T>& V0, const FunctionSpace<T>& V1,
   std::vector<U> Ab(space_dim0 * space_dim1);
   std::vector<U> local1(space_dim1);
 
-  // Iterate over mesh and interpolate on each cell
-  assert(mesh->topology()->index_map(gdim));
-  for (std::int32_t c = 0; c < mesh->topology()->index_map(gdim)->size_local();
-       ++c)
+  // Iterate over cells and interpolate on each cell
+  for (std::int32_t c : cells)
   {
     // Get cell geometry (coordinate dofs)
     auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
@@ -283,31 +282,16 @@ void discrete_curl(const FunctionSpace<T>& V0, const FunctionSpace<T>& V1,
   }
 }
 
-/// @brief Assemble a discrete gradient operator.
-///
-/// The discrete gradient operator \f$A\f$ interpolates the gradient of
-/// a Lagrange finite element function in \f$V_0 \subset H^1\f$ into a
-/// Nédélec (first kind) space \f$V_1 \subset H({\rm curl})\f$, i.e.
-/// \f$\nabla V_0 \rightarrow V_1\f$. If \f$u_0\f$ is the
-/// degree-of-freedom vector associated with \f$V_0\f$, then
-/// \f$u_1=Au_0\f$ where \f$u_1\f$ is the degrees-of-freedom vector for
-/// interpolating function in the \f$H({\rm curl})\f$ space. An example
-/// of where discrete gradient operators are used is the creation of
-/// algebraic multigrid solvers for \f$H({\rm curl})\f$ and \f$H({\rm
-/// div})\f$ problems.
-///
-/// @note The sparsity pattern for a discrete operator can be
-/// initialised using sparsitybuild::cells. The space `V1` should be
-/// used for the rows of the sparsity pattern, `V0` for the columns.
+/// @brief Assemble a discrete gradient operator on a subset of cells.
 ///
-/// @warning This function relies on the user supplying appropriate
-/// input and output spaces. See parameter descriptions.
+/// See fem::discrete_gradient.
 ///
 /// @param[in] topology Mesh topology
 /// @param[in] V0 Lagrange element and dofmap for corresponding space to
 /// interpolate the gradient from.
 /// @param[in] V1 Nédélec (first kind) element and dofmap for
 /// corresponding space to interpolate into.
+/// @param[in] cells Cells to assemble the operator on.
 /// @param[in] mat_set A functor that sets values in a matrix
 template <dolfinx::scalar T, std::floating_point U = dolfinx::scalar_value_t<T>>
 void discrete_gradient(mesh::Topology& topology,
@@ -317,7 +301,7 @@ void discrete_gradient(mesh::Topology& topology,
                        std::pair<std::reference_wrapper<const FiniteElement<U>>,
                                  std::reference_wrapper<const DofMap>>
                            V1,
-                       auto&& mat_set)
+                       std::span<const std::int32_t> cells, auto&& mat_set)
 {
   auto& e0 = V0.first.get();
   const DofMap& dofmap0 = V0.second.get();
@@ -349,7 +333,7 @@ void discrete_gradient(mesh::Topology& topology,
   const int tdim = topology.dim();
   std::vector<U> phi0_b((tdim + 1) * Xshape[0] * ndofs0 * 1);
   cmdspan4_t phi0(phi0_b.data(), tdim + 1, Xshape[0], ndofs0, 1);
-  e0.tabulate(phi0_b, X, Xshape, 1);
+  e0.tabulate_cached(phi0_b, X, Xshape, 1);
 
   // Reshape Lagrange basis derivatives as a matrix of shape (tdim *
   // num_points, num_dofs_per_cell)
@@ -379,11 +363,8 @@ void discrete_gradient(mesh::Topology& topology,
   }
 
   // Insert local interpolation matrix for each cell
-  auto cell_map = topology.index_map(tdim);
-  assert(cell_map);
-  std::int32_t num_cells = cell_map->size_local();
   std::vector<T> Ae(Ab.size());
-  for (std::int32_t c = 0; c < num_cells; ++c)
+  for (std::int32_t c : cells)
   {
     std::ranges::copy(Ab, Ae.begin());
     apply_inverse_dof_transform(Ae, cell_info, c, ndofs0);
@@ -391,24 +372,19 @@ void discrete_gradient(mesh::Topology& topology,
   }
 }
 
-/// @brief Assemble an interpolation operator matrix.
+/// @brief Assemble an interpolation operator matrix on a subset of
+/// cells.
 ///
-/// The interpolation operator \f$A\f$ interpolates a function in the
-/// space \f$V_0\f$ into a space \f$V_1\f$. If \f$u_0\f$ is the
-/// degree-of-freedom vector associated with \f$V_0\f$, then the
-/// degree-of-freedom vector \f$u_1\f$ for the interpolated function in
-/// \f$V_1\f$ is given by \f$u_1=Au_0\f$.
-///
-/// @note The sparsity pattern for a discrete operator can be
-/// initialised using sparsitybuild::cells. The space `V1` should be
-/// used for the rows of the sparsity pattern, `V0` for the columns.
+/// See fem::interpolation_matrix.
 ///
 /// @param[in] V0 Space to interpolate from.
 /// @param[in] V1 Space to interpolate to.
+/// @param[in] cells Cells to assemble the operator on.
 /// @param[in] mat_set Functor that sets values in a matrix.
 template <dolfinx::scalar T, std::floating_point U>
 void interpolation_matrix(const FunctionSpace<U>& V0,
-                          const FunctionSpace<U>& V1, auto&& mat_set)
+                          const FunctionSpace<U>& V1,
+                          std::span<const std::int32_t> cells, auto&& mat_set)
 {
   // Get mesh
   auto mesh = V0.mesh();
@@ -469,14 +445,14 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
   std::vector<U> phi_b(
       std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
   cmdspan4_t phi(phi_b.data(), phi_shape);
-  cmap.tabulate(1, X, Xshape, phi_b);
+  cmap.tabulate_cached(1, X, Xshape, phi_b);
 
   // Evaluate V0 basis functions at reference interpolation points for V1
   std::vector<U> basis_derivatives_reference0_b(Xshape[0] * dim0
                                                 * value_size_ref0);
   cmdspan4_t basis_derivatives_reference0(basis_derivatives_reference0_b.data(),
                                           1, Xshape[0], dim0, value_size_ref0);
-  e0->tabulate(basis_derivatives_reference0_b, X, Xshape, 0);
+  e0->tabulate_cached(basis_derivatives_reference0_b, X, Xshape, 0);
 
   // Clamp values
   std::ranges::transform(
@@ -532,11 +508,8 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
   std::vector<T> Ab(space_dim0 * space_dim1);
   std::vector<T> local1(space_dim1);
 
-  // Iterate over mesh and interpolate on each cell
-  auto cell_map = mesh->topology()->index_map(tdim);
-  assert(cell_map);
-  std::int32_t num_cells = cell_map->size_local();
-  for (std::int32_t c = 0; c < num_cells; ++c)
+  // Iterate over cells and interpolate on each cell
+  for (std::int32_t c : cells)
   {
     // Get cell geometry (coordinate dofs)
     auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
@@ -631,4 +604,344 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
   }
 }
 
+/// @brief Create the matrix of a discrete operator, with the cell
+/// matrices computed concurrently.
+///
+/// The cells owned by this process are processed in chunks. For each
+/// chunk, `num_threads` threads compute the cell matrices of a part of
+/// the chunk each, and the cell matrices are then set in the matrix.
+///
+/// @param[in] V0 Space of the columns.
+/// @param[in] V1 Space of the rows.
+/// @param[in] kernel Function `kernel(cells, mat_set)` that computes
+/// the cell matrices of `cells` and passes them to `mat_set`. It is
+/// called concurrently by different threads.
+/// @param[in] num_threads Number of threads.
+/// @return The operator matrix.
+template <dolfinx::scalar T, std::floating_point U, typename Kernel>
+la::MatrixCSR<T> discrete_operator_matrix(const FunctionSpace<U>& V0,
+                                          const FunctionSpace<U>& V1,
+                                          Kernel&& kernel, int num_threads)
+{
+  la::MatrixCSR<T> A(create_discrete_operator_sparsity(V0, V1));
+
+  auto mesh = V0.mesh();
+  assert(mesh);
+  auto cell_map = mesh->topology()->index_map(mesh->topology()->dim());
+  assert(cell_map);
+  std::vector<std::int32_t> cells(cell_map->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+
+  const int bs0 = V0.dofmap()->bs();
+  const int bs1 = V1.dofmap()->bs();
+
+  // Cell matrices computed by a thread, with unrolled row and column
+  // indices
+  struct buffer_t
+  {
+    std::vector<std::int32_t> rows, cols;
+    std::vector<T> values;
+    std::vector<std::array<std::size_t, 2>> shape;
+  };
+
+  num_threads = std::max(num_threads, 1);
+  std::vector<buffer_t> buffers(num_threads);
+  const std::size_t chunk_size = num_threads * 4096;
+  std::size_t c0 = 0;
+  do
+  {
+    std::span<const std::int32_t> chunk = std::span(cells).subspan(
+        c0, std::min(chunk_size, cells.size() - c0));
+    common::run_threads(
+        num_threads,
+        [&](int t)
+        {
+          buffer_t& b = buffers[t];
+          b.rows.clear();
+          b.cols.clear();
+          b.values.clear();
+          b.shape.clear();
+          auto [r0, r1] = common::thread_range(t, chunk.size(), num_threads);
+          kernel(chunk.subspan(r0, r1 - r0),
+                 [&b, bs0, bs1](std::span<const std::int32_t> rows,
+                                std::span<const std::int32_t> cols,
+                                std::span<const T> x) -> int
+                 {
+                   for (std::int32_t r : rows)
+                     for (int k = 0; k < bs1; ++k)
+                       b.rows.push_back(bs1 * r + k);
+                   for (std::int32_t c : cols)
+                     for (int k = 0; k < bs0; ++k)
+                       b.cols.push_back(bs0 * c + k);
+                   b.values.insert(b.values.end(), x.begin(), x.end());
+                   b.shape.push_back({bs1 * rows.size(), bs0 * cols.size()});
+                   return 0;
+                 });
+        });
+
+    // Set the cell matrices of the chunk in the matrix
+    for (const buffer_t& b : buffers)
+    {
+      std::size_t r = 0, c = 0, v = 0;
+      for (auto [m, n] : b.shape)
+      {
+        A.template set<1, 1>(std::span(b.values).subspan(v, m * n),
+                             std::span(b.rows).subspan(r, m),
+                             std::span(b.cols).subspan(c, n));
+        r += m;
+        c += n;
+        v += m * n;
+      }
+    }
+
+    c0 += chunk.size();
+  } while (c0 < cells.size());
+
+  return A;
+}
+} // namespace impl
+
+/// @brief Assemble a discrete curl operator.
+///
+/// For vector-valued finite functions \f$u \in V_{0} \f$ and \f$v \in
+/// V_{1}\f$, consider the interpolation of the curl of \f$u\f$ in the
+/// space \f$V_{1}\f$, i.e. \f$\Pi_{V_{1}}: \nabla \times u \rightarrow
+/// v\f$, where \f$\Pi_{V_{1}}\f$ is the interpolation operator
+/// associated with \f$V_{1}\f$. This interpolation of \f$\nabla \times
+/// u\f$ into \f$V_{1}\f$ is properly posed and exact for specific
+/// choices of function spaces. If \f$V_{0}\f$ is a Nédélec (\f$H({\rm
+/// curl})\f$) space of degree \f$k > 1\f$ and \f$V_{1}\f$ is a
+/// Raviart-Thomas (\f$H({\rm div})\f$) space of degree of at least \f$k
+/// - 1\f$, then the interpolation is exact.
+///
+/// The implementation of this function exploits the result:
+///
+/// \f[
+///   \hat{\nabla} \times \psi_{C}(\boldsymbol{u}) = \psi_{D}(\nabla \times
+///   \boldsymbol{u}),
+/// \f]
+///
+/// where \f$\psi_{C}\f$ is the covariant pull-back (to the reference
+/// cell) and \f$\psi_{D}\f$ is the contravariant pull-back. See Ern and
+/// Guermond (2021), *Finite Elements I*, Springer Nature,
+/// https://doi.org/10.1007/978-3-030-56341-7 [Corollary 9.9 (Commuting
+/// properties)]. Consequently, the spaces `V0` and `V1` must use
+/// covariant and contravariant maps, respectively.
+///
+/// This function builds a matrix \f$C\f$ (the 'discrete curl'), which
+/// when applied to the degrees-of-freedom of \f$u\f$ gives the
+/// degrees-of-freedom of \f$v\f$ such that \f$v = \nabla \times u\f$.
+/// If the finite element degree-of-freedom vectors associated with
+/// \f$u\f$ and \f$v\f$ are \f$a\f$ and \f$b\f$, respectively, then \f$b
+/// = C a\f$, which yields \f$v = \Pi_{V} \nabla \times u\f$. It
+/// essentially maps that curl of a function in a degree \f$k > 1\f$
+/// Nédélec space into a degree \f$k - 1\f$ Raviart-Thomas space.
+///
+/// The discerete curl is typically used in constructing algebraic
+/// multigrid preconditioners for \f$H({\rm div})\f$ problems, e.g. when
+/// using the Hypre Auxiliary-space Divergence Solver (ADS) to solve a
+/// mixed Poisson in three-dimension.
+///
+/// @pre `V0` and `V1` must be vector-valued, in three spatial
+/// dimensions, and use covariant and contravariant maps, respectively.
+///
+/// @tparam T Scalar type of the mesh and elements. @tparam U Scalar
+/// type of the matrix being inserted into. This is usually the same as
+/// `T`, but may differ for matrix backends that support only a specific
+/// type, e.g. PETSc which supports only one scalar type for a build of
+/// PETSc.
+///
+/// @param[in] V0 Space that \f$u\f$ is from. It must be a covariant
+/// Piola mapped element. It is normally an \f$H({\rm
+/// curl})\f$-conforming Nédélec space.
+/// @param[in] V1 Space that \f$v\f$ is from. It must be a contravariant
+/// Piola mapped element. It is normally an \f$H({\rm
+/// div})\f$-conforming Raviart-Thomas space of one degree lower than
+/// `V0`.
+/// @param[in] mat_set A functor that sets (not add) values in a matrix
+/// \f$C\f$.
+template <std::floating_point T, dolfinx::scalar U = T>
+void discrete_curl(const FunctionSpace<T>& V0, const FunctionSpace<T>& V1,
+                   la::MatSet<U> auto&& mat_set)
+{
+  auto mesh = V0.mesh();
+  assert(mesh);
+  auto cell_map = mesh->topology()->index_map(mesh->topology()->dim());
+  assert(cell_map);
+  std::vector<std::int32_t> cells(cell_map->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  impl::discrete_curl<T, U>(V0, V1, cells, mat_set);
+}
+
+/// @brief Assemble a discrete curl operator into a la::MatrixCSR.
+///
+/// The sparsity pattern of the matrix is created by
+/// fem::create_discrete_operator_sparsity, and the cell matrices are
+/// computed by `num_threads` threads and set in the matrix. See
+/// fem::discrete_curl for a description of the operator.
+///
+/// @param[in] V0 Space that \f$u\f$ is from. It must be a covariant
+/// Piola mapped element.
+/// @param[in] V1 Space that \f$v\f$ is from. It must be a
+/// contravariant Piola mapped element.
+/// @param[in] num_threads Number of threads used to compute the cell
+/// matrices.
+/// @return The discrete curl matrix \f$C\f$.
+template <std::floating_point T, dolfinx::scalar U = T>
+la::MatrixCSR<U> discrete_curl(const FunctionSpace<T>& V0,
+                               const FunctionSpace<T>& V1,
+                               int num_threads = 1)
+{
+  // Compute the cell permutations before the threads are started
+  auto mesh = V0.mesh();
+  assert(mesh);
+  if (V0.element()->needs_dof_transformations()
+      or V1.element()->needs_dof_transformations())
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+  }
+
+  return impl::discrete_operator_matrix<U>(
+      V0, V1,
+      [&](std::span<const std::int32_t> cells, auto&& mat_set)
+      { impl::discrete_curl<T, U>(V0, V1, cells, mat_set); },
+      num_threads);
+}
+/// @brief Assemble a discrete gradient operator.
+///
+/// The discrete gradient operator \f$A\f$ interpolates the gradient of
+/// a Lagrange finite element function in \f$V_0 \subset H^1\f$ into a
+/// Nédélec (first kind) space \f$V_1 \subset H({\rm curl})\f$, i.e.
+/// \f$\nabla V_0 \rightarrow V_1\f$. If \f$u_0\f$ is the
+/// degree-of-freedom vector associated with \f$V_0\f$, then
+/// \f$u_1=Au_0\f$ where \f$u_1\f$ is the degrees-of-freedom vector for
+/// interpolating function in the \f$H({\rm curl})\f$ space. An example
+/// of where discrete gradient operators are used is the creation of
+/// algebraic multigrid solvers for \f$H({\rm curl})\f$ and \f$H({\rm
+/// div})\f$ problems.
+///
+/// @note The sparsity pattern for a discrete operator can be
+/// initialised using sparsitybuild::cells. The space `V1` should be
+/// used for the rows of the sparsity pattern, `V0` for the columns.
+///
+/// @warning This function relies on the user supplying appropriate
+/// input and output spaces. See parameter descriptions.
+///
+/// @param[in] topology Mesh topology
+/// @param[in] V0 Lagrange element and dofmap for corresponding space to
+/// interpolate the gradient from.
+/// @param[in] V1 Nédélec (first kind) element and dofmap for
+/// corresponding space to interpolate into.
+/// @param[in] mat_set A functor that sets values in a matrix
+template <dolfinx::scalar T, std::floating_point U = dolfinx::scalar_value_t<T>>
+void discrete_gradient(mesh::Topology& topology,
+                       std::pair<std::reference_wrapper<const FiniteElement<U>>,
+                                 std::reference_wrapper<const DofMap>>
+                           V0,
+                       std::pair<std::reference_wrapper<const FiniteElement<U>>,
+                                 std::reference_wrapper<const DofMap>>
+                           V1,
+                       auto&& mat_set)
+{
+  auto cell_map = topology.index_map(topology.dim());
+  assert(cell_map);
+  std::vector<std::int32_t> cells(cell_map->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  impl::discrete_gradient<T, U>(topology, V0, V1, cells, mat_set);
+}
+
+/// @brief Assemble a discrete gradient operator into a la::MatrixCSR.
+///
+/// The sparsity pattern of the matrix is created by
+/// fem::create_discrete_operator_sparsity, and the cell matrices are
+/// computed by `num_threads` threads and set in the matrix. See
+/// fem::discrete_gradient for a description of the operator.
+///
+/// @param[in] V0 Lagrange space to interpolate the gradient from.
+/// @param[in] V1 Nédélec (first kind) space to interpolate into.
+/// @param[in] num_threads Number of threads used to compute the cell
+/// matrices.
+/// @return The discrete gradient matrix.
+template <dolfinx::scalar T, std::floating_point U = dolfinx::scalar_value_t<T>>
+la::MatrixCSR<T> discrete_gradient(const FunctionSpace<U>& V0,
+                                   const FunctionSpace<U>& V1,
+                                   int num_threads = 1)
+{
+  // Compute the cell permutations before the threads are started
+  auto mesh = V0.mesh();
+  assert(mesh);
+  std::shared_ptr<mesh::Topology> topology = mesh->topology_mutable();
+  topology->create_entity_permutations();
+
+  return impl::discrete_operator_matrix<T>(
+      V0, V1,
+      [&](std::span<const std::int32_t> cells, auto&& mat_set)
+      {
+        impl::discrete_gradient<T, U>(*topology, {*V0.element(), *V0.dofmap()},
+                                      {*V1.element(), *V1.dofmap()}, cells,
+                                      mat_set);
+      },
+      num_threads);
+}
+/// @brief Assemble an interpolation operator matrix.
+///
+/// The interpolation operator \f$A\f$ interpolates a function in the
+/// space \f$V_0\f$ into a space \f$V_1\f$. If \f$u_0\f$ is the
+/// degree-of-freedom vector associated with \f$V_0\f$, then the
+/// degree-of-freedom vector \f$u_1\f$ for the interpolated function in
+/// \f$V_1\f$ is given by \f$u_1=Au_0\f$.
+///
+/// @note The sparsity pattern for a discrete operator can be
+/// initialised using sparsitybuild::cells. The space `V1` should be
+/// used for the rows of the sparsity pattern, `V0` for the columns.
+///
+/// @param[in] V0 Space to interpolate from.
+/// @param[in] V1 Space to interpolate to.
+/// @param[in] mat_set Functor that sets values in a matrix.
+template <dolfinx::scalar T, std::floating_point U>
+void interpolation_matrix(const FunctionSpace<U>& V0,
+                          const FunctionSpace<U>& V1, auto&& mat_set)
+{
+  auto mesh = V0.mesh();
+  assert(mesh);
+  auto cell_map = mesh->topology()->index_map(mesh->topology()->dim());
+  assert(cell_map);
+  std::vector<std::int32_t> cells(cell_map->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  impl::interpolation_matrix<T, U>(V0, V1, cells, mat_set);
+}
+
+/// @brief Assemble an interpolation operator matrix into a
+/// la::MatrixCSR.
+///
+/// The sparsity pattern of the matrix is created by
+/// fem::create_discrete_operator_sparsity, and the cell matrices are
+/// computed by `num_threads` threads and set in the matrix. See
+/// fem::interpolation_matrix for a description of the operator.
+///
+/// @param[in] V0 Space to interpolate from.
+/// @param[in] V1 Space to interpolate to.
+/// @param[in] num_threads Number of threads used to compute the cell
+/// matrices.
+/// @return The interpolation matrix.
+template <dolfinx::scalar T, std::floating_point U>
+la::MatrixCSR<T> interpolation_matrix(const FunctionSpace<U>& V0,
+                                      const FunctionSpace<U>& V1,
+                                      int num_threads = 1)
+{
+  // Compute the cell permutations before the threads are started
+  auto mesh = V0.mesh();
+  assert(mesh);
+  if (V0.element()->needs_dof_transformations()
+      or V1.element()->needs_dof_transformations())
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+  }
+
+  return impl::discrete_operator_matrix<T>(
+      V0, V1,
+      [&](std::span<const std::int32_t> cells, auto&& mat_set)
+      { impl::interpolation_matrix<T, U>(V0, V1, cells, mat_set); },
+      num_threads);
+}
 } // namespace dolfinx::fem
@@ -7,11 +7,13 @@
 #include "dofmapbuilder.h"
 #include "ElementDofLayout.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/cell_types.h>
@@ -46,23 +48,25 @@ struct dofmap_t
 /// to new indices that are ordered such that owned indices are [0,
 /// owned_size)
 /// @param[in] reorder_fn The graph reordering function to apply
+/// @param[in] num_threads Number of threads used to build the graph
 /// @return Map from original_to_contiguous[i] to new index after
 /// reordering
 std::vector<int>
 reorder_owned(const std::vector<dofmap_t>& dofmaps, std::int32_t owned_size,
               const std::vector<int>& original_to_contiguous,
               const std::function<std::vector<int>(
-                  const graph::AdjacencyList<std::int32_t>&)>& reorder_fn)
+                  const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+              int num_threads)
 {
-  std::vector<std::int32_t> graph_data, graph_offsets;
-
-  // Compute maximum number of graph out edges edges per dof
-  std::vector<int> num_edges(owned_size);
-  for (const auto& dofmap : dofmaps)
+  // Call f(nodes) with the owned nodes of each cell, for the cells
+  // [c0, c1) of a dofmap
+  auto for_each_cell
+      = [owned_size, &original_to_contiguous](const dofmap_t& dofmap,
+                                              std::size_t c0, std::size_t c1,
+                                              auto&& f)
   {
-    std::size_t num_cells = dofmap.array.size() / dofmap.width;
     std::vector<std::int32_t> node_temp;
-    for (std::size_t cell = 0; cell < num_cells; ++cell)
+    for (std::size_t cell = c0; cell < c1; ++cell)
     {
       node_temp.clear();
       for (std::int32_t i = 0; i < dofmap.width; ++i)
@@ -72,60 +76,100 @@ reorder_owned(const std::vector<dofmap_t>& dofmaps, std::int32_t owned_size,
         if (node < owned_size)
           node_temp.push_back(node);
       }
-      for (std::int32_t node : node_temp)
-        num_edges[node] += node_temp.size() - 1;
+      f(node_temp);
     }
+  };
+
+  // Compute maximum number of graph out edges edges per dof
+  std::vector<std::int32_t> num_edges(owned_size, 0);
+  for (const auto& dofmap : dofmaps)
+  {
+    std::size_t num_cells = dofmap.array.size() / dofmap.width;
+    common::parallel_for(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
+        {
+          for_each_cell(dofmap, c0, c1,
+                        [&num_edges](auto& nodes)
+                        {
+                          for (std::int32_t node : nodes)
+                          {
+                            std::atomic_ref(num_edges[node])
+                                .fetch_add(nodes.size() - 1,
+                                           std::memory_order_relaxed);
+                          }
+                        });
+        });
   }
 
-  // Compute adjacency list with duplicate edges
+  // Compute adjacency list with duplicate edges. The order of the
+  // edges of a node depends on the threads, but is made unique below.
   std::vector<std::int32_t> offsets(num_edges.size() + 1, 0);
   std::partial_sum(num_edges.begin(), num_edges.end(),
                    std::next(offsets.begin(), 1));
   std::vector<std::int32_t> edges(offsets.back());
-  for (const auto& dofmap : dofmaps)
   {
-    std::size_t num_cells = dofmap.array.size() / dofmap.width;
-    std::vector<std::int32_t> node_temp;
-
-    for (std::size_t cell = 0; cell < num_cells; ++cell)
+    std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+    for (const auto& dofmap : dofmaps)
     {
-      node_temp.clear();
-      for (std::int32_t i = 0; i < dofmap.width; ++i)
-      {
-        std::int32_t node
-            = original_to_contiguous[dofmap.array[cell * dofmap.width + i]];
-        if (node < owned_size)
-          node_temp.push_back(node);
-      }
-
-      for (std::size_t i = 0; i < node_temp.size(); ++i)
-      {
-        std::int32_t node_0 = node_temp[i];
-        for (std::size_t j = i + 1; j < node_temp.size(); ++j)
-        {
-          std::int32_t node_1 = node_temp[j];
-          edges[offsets[node_0]++] = node_1;
-          edges[offsets[node_1]++] = node_0;
-        }
-      }
+      std::size_t num_cells = dofmap.array.size() / dofmap.width;
+      common::parallel_for(
+          num_cells, num_threads,
+          [&](std::size_t c0, std::size_t c1)
+          {
+            auto insert = [&](std::int32_t node_0, std::int32_t node_1)
+            {
+              edges[std::atomic_ref(pos[node_0])
+                        .fetch_add(1, std::memory_order_relaxed)]
+                  = node_1;
+            };
+            for_each_cell(dofmap, c0, c1,
+                          [&insert](auto& nodes)
+                          {
+                            for (std::size_t i = 0; i < nodes.size(); ++i)
+                            {
+                              for (std::size_t j = i + 1; j < nodes.size();
+                                   ++j)
+                              {
+                                insert(nodes[i], nodes[j]);
+                                insert(nodes[j], nodes[i]);
+                              }
+                            }
+                          });
+          });
     }
   }
 
   // Eliminate duplicate edges and create AdjacencyList
-  graph_offsets.resize(num_edges.size() + 1, 0);
-  std::int32_t current_offset = 0;
-  for (std::size_t i = 0; i < num_edges.size(); ++i)
-  {
-    auto range_begin = std::next(edges.begin(), current_offset);
-    auto edge_range = std::ranges::subrange(
-        range_begin, std::next(range_begin, num_edges[i]));
-    std::ranges::sort(edge_range);
-    auto it = std::ranges::unique(edge_range).begin();
-
-    graph_data.insert(graph_data.end(), range_begin, it);
-    graph_offsets[i + 1] = graph_offsets[i] + std::distance(range_begin, it);
-    current_offset += num_edges[i];
-  }
+  std::vector<std::int32_t> graph_offsets(num_edges.size() + 1, 0);
+  common::parallel_for(
+      num_edges.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          auto edge_range = std::ranges::subrange(
+              std::next(edges.begin(), offsets[i]),
+              std::next(edges.begin(), offsets[i + 1]));
+          std::ranges::sort(edge_range);
+          auto it = std::ranges::unique(edge_range).begin();
+          graph_offsets[i + 1] = std::distance(edge_range.begin(), it);
+        }
+      });
+  std::partial_sum(graph_offsets.begin(), graph_offsets.end(),
+                   graph_offsets.begin());
+  std::vector<std::int32_t> graph_data(graph_offsets.back());
+  common::parallel_for(
+      num_edges.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          auto it = std::next(edges.begin(), offsets[i]);
+          std::copy_n(it, graph_offsets[i + 1] - graph_offsets[i],
+                      std::next(graph_data.begin(), graph_offsets[i]));
+        }
+      });
 
   // Re-order graph and return re-odering
   assert(reorder_fn);
@@ -140,6 +184,7 @@ reorder_owned(const std::vector<dofmap_t>& dofmaps, std::int32_t owned_size,
 /// @param [in] mesh The mesh to build the dofmap on
 /// @param [in] topology The mesh topology
 /// @param [in] element_dof_layout The layout of dofs on each cell type
+/// @param [in] num_threads Number of threads used to build the dofmaps
 /// @return Returns: * dofmaps for each cell type (local to the process)
 ///                  * local-to-global map for each local dof
 ///                  * local-to-entity map for each local dof
@@ -152,7 +197,8 @@ std::tuple<std::vector<dofmap_t>, std::vector<std::int64_t>,
            std::vector<std::shared_ptr<const common::IndexMap>>, std::int64_t>
 build_basic_dofmaps(
     const mesh::Topology& topology,
-    const std::vector<fem::ElementDofLayout>& element_dof_layouts)
+    const std::vector<fem::ElementDofLayout>& element_dof_layouts,
+    int num_threads)
 {
   // Start timer for dofmap initialization
   common::Timer t0("Init dofmap from element dofmap");
@@ -263,64 +309,82 @@ build_basic_dofmaps(
     dofs[i].array.resize(num_cells * dofmap_width);
     spdlog::info("Cell type: {} dofmap: {}x{}", i, num_cells, dofmap_width);
 
-    std::int32_t dofmap_offset = 0;
-    for (std::int32_t c = 0; c < num_cells; ++c)
+    // Cell-to-entity connectivity for each required entity, or nullptr
+    // for undefined topology, e.g. quad facets of tetrahedra
+    std::vector<std::shared_ptr<const graph::AdjacencyList<std::int32_t>>>
+        c_to_e_k(required_dim_et.size());
+    for (std::size_t k = 0; k < required_dim_et.size(); ++k)
     {
-      // Wrap dofs for cell c
-      std::span<std::int32_t> dofs_c(dofs[i].array.data() + dofmap_offset,
-                                     dofmap_width);
-      dofmap_offset += dofmap_width;
-
-      // Iterate over required entities for this element, dimension and type
-      for (std::size_t k = 0; k < required_dim_et.size(); ++k)
+      if (int d = required_dim_et[k].first; d < (int)D)
       {
-        // Get dimension d and entity type et
-        std::size_t d = required_dim_et[k].first;
-        std::size_t et = required_dim_et[k].second;
-        mesh::CellType e_type = topology.entity_types(d)[et];
-
-        const std::vector<std::vector<int>>& e_dofs_d = entity_dofs[d];
-
-        // Skip over undefined topology, e.g. quad facets of tetrahedra
-        if (d < D
-            and !topology.connectivity({int(D), int(i)}, {int(d), int(et)}))
-          continue;
-
-        // Iterate over each entity of current dimension d and type et
-        std::span<const std::int32_t> c_to_e
-            = d < D
-                  ? topology.connectivity({int(D), int(i)}, {int(d), int(et)})
-                        ->links(c)
-                  : std::span<const std::int32_t>(&c, 1);
-
-        int w = 0;
-        for (std::size_t e = 0; e < e_dofs_d.size(); ++e)
+        c_to_e_k[k] = topology.connectivity({int(D), int(i)},
+                                            {d, required_dim_et[k].second});
+      }
+    }
+
+    common::parallel_for(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
         {
-          // Skip entities of wrong type (e.g. for facets of prism)
-          // Use separate connectivity index 'w' which only advances for
-          // correct entities
-          if (mesh::cell_entity_type(cell_type, d, e) == e_type)
+          for (std::int32_t c = c0; c < (std::int32_t)c1; ++c)
           {
-            const std::vector<int>& e_dofs_d_e = e_dofs_d[e];
-            std::size_t num_entity_dofs = e_dofs_d_e.size();
-            assert((int)num_entity_dofs == num_entity_dofs_et[k]);
-            std::int32_t e_index_local = c_to_e[w];
-            ++w;
-
-            // Loop over dofs belonging to entity e of dimension d (d, e)
-            // d: topological dimension
-            // e: local entity index
-            // dof_local: local index of dof at (d, e)
-            for (std::size_t j = 0; j < num_entity_dofs; ++j)
+            // Wrap dofs for cell c
+            std::span<std::int32_t> dofs_c(
+                dofs[i].array.data() + c * dofmap_width, dofmap_width);
+
+            // Iterate over required entities for this element,
+            // dimension and type
+            for (std::size_t k = 0; k < required_dim_et.size(); ++k)
             {
-              int dof_local = e_dofs_d_e[j];
-              dofs_c[dof_local] = local_entity_offsets[k]
-                                  + num_entity_dofs * e_index_local + j;
+              // Get dimension d and entity type et
+              std::size_t d = required_dim_et[k].first;
+              std::size_t et = required_dim_et[k].second;
+              mesh::CellType e_type = entity_types[d][et];
+
+              const std::vector<std::vector<int>>& e_dofs_d
+                  = entity_dofs[d];
+
+              // Skip over undefined topology
+              if (d < D and !c_to_e_k[k])
+                continue;
+
+              // Iterate over each entity of current dimension d and
+              // type et
+              std::span<const std::int32_t> c_to_e
+                  = d < D ? c_to_e_k[k]->links(c)
+                          : std::span<const std::int32_t>(&c, 1);
+
+              int w = 0;
+              for (std::size_t e = 0; e < e_dofs_d.size(); ++e)
+              {
+                // Skip entities of wrong type (e.g. for facets of
+                // prism). Use separate connectivity index 'w' which
+                // only advances for correct entities
+                if (mesh::cell_entity_type(cell_type, d, e) == e_type)
+                {
+                  const std::vector<int>& e_dofs_d_e = e_dofs_d[e];
+                  std::size_t num_entity_dofs = e_dofs_d_e.size();
+                  assert((int)num_entity_dofs == num_entity_dofs_et[k]);
+                  std::int32_t e_index_local = c_to_e[w];
+                  ++w;
+
+                  // Loop over dofs belonging to entity e of dimension d
+                  // (d, e)
+                  // d: topological dimension
+                  // e: local entity index
+                  // dof_local: local index of dof at (d, e)
+                  for (std::size_t j = 0; j < num_entity_dofs; ++j)
+                  {
+                    int dof_local = e_dofs_d_e[j];
+                    dofs_c[dof_local] = local_entity_offsets[k]
+                                        + num_entity_dofs * e_index_local
+                                        + j;
+                  }
+                }
+              }
             }
           }
-        }
-      }
-    }
+        });
   }
 
   spdlog::info("Global index computation");
@@ -348,18 +412,24 @@ build_basic_dofmaps(
     assert(map);
     std::vector<std::int64_t> global_indices = map->global_indices();
 
-    for (std::size_t e_index = 0; e_index < global_indices.size(); ++e_index)
-    {
-      auto e_index_global = global_indices[e_index];
-      for (std::int32_t count = 0; count < num_entity_dofs; ++count)
-      {
-        std::int32_t dof
-            = local_entity_offsets[k] + num_entity_dofs * e_index + count;
-        local_to_global[dof]
-            = global_entity_offsets + num_entity_dofs * e_index_global + count;
-        dof_entity[dof] = {k, e_index};
-      }
-    }
+    common::parallel_for(
+        global_indices.size(), num_threads,
+        [&](std::size_t i0, std::size_t i1)
+        {
+          for (std::size_t e_index = i0; e_index < i1; ++e_index)
+          {
+            auto e_index_global = global_indices[e_index];
+            for (std::int32_t count = 0; count < num_entity_dofs; ++count)
+            {
+              std::int32_t dof = local_entity_offsets[k]
+                                 + num_entity_dofs * e_index + count;
+              local_to_global[dof] = global_entity_offsets
+                                     + num_entity_dofs * e_index_global
+                                     + count;
+              dof_entity[dof] = {k, e_index};
+            }
+          }
+        });
     global_entity_offsets += num_entity_dofs * map->size_global();
     global_start += num_entity_dofs * map->local_range()[0];
   }
@@ -385,6 +455,8 @@ build_basic_dofmaps(
 /// `dof_entity`.
 /// @param [in] reorder_fn Graph reordering function that is applied for
 /// dof re-ordering
+/// @param [in] num_threads Number of threads used to build the graph
+/// that is re-ordered
 /// @return The pair (old-to-new local index map, M), where M is the
 /// number of dofs owned by this process
 std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
@@ -392,7 +464,8 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
     const std::vector<std::pair<std::int8_t, std::int32_t>>& dof_entity,
     const std::vector<std::shared_ptr<const common::IndexMap>>& index_maps,
     const std::function<std::vector<int>(
-        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn)
+        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+    int num_threads)
 {
   common::Timer t0("Compute dof reordering map");
 
@@ -448,7 +521,7 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
 
     // Apply graph reordering to owned dofs
     const std::vector<int> node_remap = reorder_owned(
-        dofmaps, owned_size, original_to_contiguous, reorder_fn);
+        dofmaps, owned_size, original_to_contiguous, reorder_fn, num_threads);
     std::ranges::transform(
         original_to_contiguous, original_to_contiguous.begin(),
         [&node_remap, owned_size](auto index)
@@ -460,17 +533,24 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
 //-----------------------------------------------------------------------------
 
 /// Get global indices for unowned dofs
+///
+/// The (old, new) global indices of shared dofs are sent by their
+/// owners in a single exchange over the union of the neighbourhoods of
+/// the index maps.
+///
 /// @param [in] index_maps Set of index maps corresponding to dofs in @p
 /// dof_entity, below.
 /// @param [in] num_owned The number of nodes owned by this process
 /// @param [in] process_offset The node offset for this process, i.e.
 /// the global index of owned node i is i + process_offset
 /// @param [in] global_indices_old The old global index of the old local
-/// node i
+/// node i. The old global indices are unique across the index maps.
 /// @param [in] old_to_new The old local index to new local index map
 /// @param [in] dof_entity The ith entry gives (index_map, local
 /// index) of the mesh entity to which node i (old local index) is
 /// associated.
+/// @param [in] num_threads Number of threads used to look up the
+/// received indices
 /// @returns The (0) global indices for unowned dofs, (1) owner rank of
 /// each unowned dof
 std::pair<std::vector<std::int64_t>, std::vector<int>> get_global_indices(
@@ -478,9 +558,12 @@ std::pair<std::vector<std::int64_t>, std::vector<int>> get_global_indices(
     std::int32_t num_owned, std::int64_t process_offset,
     const std::vector<std::int64_t>& global_indices_old,
     const std::vector<std::int32_t>& old_to_new,
-    const std::vector<std::pair<std::int8_t, std::int32_t>>& dof_entity)
+    const std::vector<std::pair<std::int8_t, std::int32_t>>& dof_entity,
+    int num_threads)
 {
   assert(dof_entity.size() == global_indices_old.size());
+  if (index_maps.empty())
+    return {};
 
   // Build list of flags for owned mesh entities that are shared, i.e.
   // are a ghost on a neighbor
@@ -516,106 +599,105 @@ std::pair<std::vector<std::int64_t>, std::vector<int>> get_global_indices(
     }
   }
 
-  std::vector<int> requests_dim;
-  std::vector<MPI_Request> requests(index_maps.size());
-  std::vector<MPI_Comm> comm(index_maps.size(), MPI_COMM_NULL);
-  std::vector<std::vector<std::int64_t>> all_dofs_received(index_maps.size());
-  std::vector<std::vector<int>> size_recv(index_maps.size());
-  std::vector<std::vector<int>> disp_recv(index_maps.size());
-  for (std::size_t d = 0; d < index_maps.size(); ++d)
+  // Union of the neighbourhoods: ranks that own entities that are
+  // ghosted on this rank (src) and ranks that ghost entities owned by
+  // this rank (dest)
+  std::vector<int> src, dest;
+  for (auto& map : index_maps)
   {
-    auto map = index_maps[d];
-    assert(map);
-
-    std::span src = map->src();
-    std::span dest = map->dest();
-    MPI_Dist_graph_create_adjacent(
-        map->comm(), src.size(), src.data(), MPI_UNWEIGHTED, dest.size(),
-        dest.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm[d]);
-
-    // Number and values to send and receive
-    const int num_indices = global[d].size();
-    size_recv[d].reserve(1); // ensure data is not a nullptr
-    size_recv[d].resize(src.size());
-    MPI_Neighbor_allgather(&num_indices, 1, MPI_INT, size_recv[d].data(), 1,
-                           MPI_INT, comm[d]);
-
-    // Compute displacements for data to receive. Last entry has total
-    // number of received items.
-    disp_recv[d].resize(src.size() + 1);
-    std::partial_sum(size_recv[d].begin(), size_recv[d].begin() + src.size(),
-                     disp_recv[d].begin() + 1);
-
-    // TODO: use MPI_Ineighbor_alltoallv
-    // Send global index of dofs to neighbors
-    all_dofs_received[d].resize(disp_recv[d].back());
-    MPI_Ineighbor_allgatherv(global[d].data(), global[d].size(), MPI_INT64_T,
-                             all_dofs_received[d].data(), size_recv[d].data(),
-                             disp_recv[d].data(), MPI_INT64_T, comm[d],
-                             &requests[requests_dim.size()]);
-    requests_dim.push_back(d);
+    src.insert(src.end(), map->src().begin(), map->src().end());
+    dest.insert(dest.end(), map->dest().begin(), map->dest().end());
   }
-
-  // Build  [local_new - num_owned] -> global old array  broken down by
-  // dimension
-  std::vector<std::vector<std::int64_t>> local_new_to_global_old(
-      index_maps.size());
-  for (std::size_t i = 0; i < global_indices_old.size(); ++i)
+  for (std::vector<int>* ranks : {&src, &dest})
   {
-    const int d = dof_entity[i].first;
-    const std::int32_t local_new = old_to_new[i] - num_owned;
-    if (local_new >= 0)
-    {
-      local_new_to_global_old[d].push_back(global_indices_old[i]);
-      local_new_to_global_old[d].push_back(local_new);
-    }
+    std::ranges::sort(*ranks);
+    auto [unique_end, range_end] = std::ranges::unique(*ranks);
+    ranks->erase(unique_end, range_end);
   }
 
-  std::vector<std::int64_t> local_to_global_new(old_to_new.size() - num_owned);
-  std::vector<int> local_to_global_new_owner(old_to_new.size() - num_owned);
-  for (std::size_t i = 0; i < requests_dim.size(); ++i)
+  // Pack the pairs of each index map for the ranks that ghost its
+  // entities
+  std::vector<int> send_sizes(dest.size(), 0);
+  for (std::size_t d = 0; d < index_maps.size(); ++d)
   {
-    int idx, d;
-    MPI_Waitany(requests_dim.size(), requests.data(), &idx, MPI_STATUS_IGNORE);
-    d = requests_dim[idx];
-
-    std::span src = index_maps[d]->src();
-
-    // Build (global old, global new) map for dofs of dimension d
-    std::vector<std::pair<std::int64_t, std::pair<int64_t, int>>>
-        global_old_new;
-    global_old_new.reserve(disp_recv[d].back());
-    for (std::size_t j = 0; j < all_dofs_received[d].size(); j += 2)
+    for (int r : index_maps[d]->dest())
     {
-      const auto pos = std::ranges::upper_bound(disp_recv[d], j);
-      const int owner = std::distance(disp_recv[d].begin(), pos) - 1;
-      global_old_new.push_back(
-          {all_dofs_received[d][j], {all_dofs_received[d][j + 1], src[owner]}});
+      auto it = std::ranges::lower_bound(dest, r);
+      send_sizes[std::distance(dest.begin(), it)] += global[d].size();
     }
-    std::ranges::sort(global_old_new);
-
-    // Build the dimension d part of local_to_global_new vector
-    for (std::size_t i = 0; i < local_new_to_global_old[d].size(); i += 2)
+  }
+  std::vector<int> send_disp(dest.size() + 1, 0);
+  std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                   std::next(send_disp.begin()));
+  std::vector<std::int64_t> send_buffer(send_disp.back());
+  {
+    std::vector<int> insert_pos(send_disp.begin(), std::prev(send_disp.end()));
+    for (std::size_t d = 0; d < index_maps.size(); ++d)
     {
-      std::pair<std::int64_t, std::pair<int64_t, int>> idx_old
-          = {local_new_to_global_old[d][i], {0, 0}};
-
-      auto it = std::ranges::lower_bound(global_old_new, idx_old,
-                                         [](auto& a, auto& b)
-                                         { return a.first < b.first; });
-      assert(it != global_old_new.end() and it->first == idx_old.first);
-
-      local_to_global_new[local_new_to_global_old[d][i + 1]] = it->second.first;
-      local_to_global_new_owner[local_new_to_global_old[d][i + 1]]
-          = it->second.second;
+      for (int r : index_maps[d]->dest())
+      {
+        auto it = std::ranges::lower_bound(dest, r);
+        int& pos = insert_pos[std::distance(dest.begin(), it)];
+        std::ranges::copy(global[d], std::next(send_buffer.begin(), pos));
+        pos += global[d].size();
+      }
     }
   }
 
-  for (MPI_Comm c : comm)
+  // Send (global old, global new) pairs to neighbors
+  MPI_Comm comm;
+  MPI_Dist_graph_create_adjacent(
+      index_maps.front()->comm(), src.size(), src.data(), MPI_UNWEIGHTED,
+      dest.size(), dest.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
+
+  std::vector<int> recv_sizes(src.size());
+  send_sizes.reserve(1); // ensure data is not a nullptr
+  recv_sizes.reserve(1);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                        MPI_INT, comm);
+  std::vector<int> recv_disp(src.size() + 1, 0);
+  std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                   std::next(recv_disp.begin()));
+  std::vector<std::int64_t> recv_buffer(recv_disp.back());
+  MPI_Neighbor_alltoallv(send_buffer.data(), send_sizes.data(),
+                         send_disp.data(), MPI_INT64_T, recv_buffer.data(),
+                         recv_sizes.data(), recv_disp.data(), MPI_INT64_T,
+                         comm);
+  MPI_Comm_free(&comm);
+
+  // Build (global old, (global new, owner)) map
+  std::vector<std::pair<std::int64_t, std::pair<int64_t, int>>>
+      global_old_new;
+  global_old_new.reserve(recv_buffer.size() / 2);
+  for (std::size_t p = 0; p < src.size(); ++p)
   {
-    if (c != MPI_COMM_NULL)
-      MPI_Comm_free(&c);
+    for (int j = recv_disp[p]; j < recv_disp[p + 1]; j += 2)
+      global_old_new.push_back({recv_buffer[j], {recv_buffer[j + 1], src[p]}});
   }
+  std::ranges::sort(global_old_new);
+
+  // Look up the new global index and owner of each unowned dof
+  std::vector<std::int64_t> local_to_global_new(old_to_new.size() - num_owned);
+  std::vector<int> local_to_global_new_owner(old_to_new.size() - num_owned);
+  common::parallel_for(
+      global_indices_old.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          const std::int32_t local_new = old_to_new[i] - num_owned;
+          if (local_new >= 0)
+          {
+            auto it = std::ranges::lower_bound(
+                global_old_new, global_indices_old[i], std::ranges::less(),
+                [](auto& e) { return e.first; });
+            assert(it != global_old_new.end()
+                   and it->first == global_indices_old[i]);
+            local_to_global_new[local_new] = it->second.first;
+            local_to_global_new_owner[local_new] = it->second.second;
+          }
+        }
+      });
 
   return {std::move(local_to_global_new), std::move(local_to_global_new_owner)};
 }
@@ -628,7 +710,8 @@ fem::build_dofmap_data(
     MPI_Comm comm, const mesh::Topology& topology,
     const std::vector<ElementDofLayout>& element_dof_layouts,
     const std::function<std::vector<int>(
-        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn)
+        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+    int num_threads)
 {
   common::Timer t0("Build dofmap data");
 
@@ -638,21 +721,21 @@ fem::build_dofmap_data(
   // i is associated with.
   const auto [node_graphs, local_to_global0, dof_entity0, topo_index_maps,
               offset]
-      = build_basic_dofmaps(topology, element_dof_layouts);
+      = build_basic_dofmaps(topology, element_dof_layouts, num_threads);
 
   spdlog::info("Got {} index_maps", topo_index_maps.size());
 
   // Build re-ordering map for data locality and get number of owned
   // nodes
   const auto [old_to_new, num_owned] = compute_reordering_map(
-      node_graphs, dof_entity0, topo_index_maps, reorder_fn);
+      node_graphs, dof_entity0, topo_index_maps, reorder_fn, num_threads);
 
   spdlog::info("Get global indices");
 
   // Get global indices for unowned dofs
   const auto [local_to_global_unowned, local_to_global_owner]
       = get_global_indices(topo_index_maps, num_owned, offset, local_to_global0,
-                           old_to_new, dof_entity0);
+                           old_to_new, dof_entity0, num_threads);
   assert(local_to_global_unowned.size() == local_to_global_owner.size());
 
   // Create IndexMap for dofs range on this process
@@ -666,11 +749,15 @@ fem::build_dofmap_data(
     const std::vector<std::int32_t>& node_graphs_i = node_graphs[i].array;
     dofmaps[i].resize(node_graphs_i.size());
     std::vector<std::int32_t>& dofmaps_i = dofmaps[i];
-    for (std::size_t j = 0; j < node_graphs_i.size(); ++j)
-    {
-      std::int32_t old_node = node_graphs_i[j];
-      dofmaps_i[j] = old_to_new[old_node];
-    }
+    common::parallel_for(node_graphs_i.size(), num_threads,
+                         [&](std::size_t j0, std::size_t j1)
+                         {
+                           for (std::size_t j = j0; j < j1; ++j)
+                           {
+                             std::int32_t old_node = node_graphs_i[j];
+                             dofmaps_i[j] = old_to_new[old_node];
+                           }
+                         });
   }
 
   return {std::move(index_map), element_dof_layouts.front().block_size(),
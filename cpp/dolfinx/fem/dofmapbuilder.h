@@ -39,11 +39,14 @@ class ElementDofLayout;
 /// type in `topology`.
 /// @param[in] reorder_fn Graph reordering function that is applied to
 /// the dofmaps
+/// @param[in] num_threads Number of threads used for the local
+/// (shared-memory) stages
 /// @return The index map, block size, and dofmaps for each element type
 std::tuple<common::IndexMap, int, std::vector<std::vector<std::int32_t>>>
 build_dofmap_data(MPI_Comm comm, const mesh::Topology& topology,
                   const std::vector<ElementDofLayout>& element_dof_layouts,
                   const std::function<std::vector<int>(
-                      const graph::AdjacencyList<std::int32_t>&)>& reorder_fn);
+                      const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+                  int num_threads = 1);
 
 } // namespace dolfinx::fem
@@ -15,8 +15,13 @@ namespace dolfinx::fem
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/FormRegistry.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/MatrixFreeOperator.h>
+#include <dolfinx/fem/SparsityPatternCache.h>
+#include <dolfinx/fem/SumFactorisedOperator.h>
+#include <dolfinx/fem/assemble_points.h>
 #include <dolfinx/fem/assembler.h>
 #include <dolfinx/fem/discreteoperators.h>
 #include <dolfinx/fem/sparsitybuild.h>
@@ -15,11 +15,14 @@
 #include <basix/mdspan.hpp>
 #include <concepts>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/geometry/utils.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <functional>
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <vector>
@@ -70,7 +73,7 @@ std::vector<T> interpolation_coords(const fem::FiniteElement<T>& element,
   md::mdspan<const T, md::extents<std::size_t, 1, md::dynamic_extent,
                                   md::dynamic_extent, 1>>
       phi_full(phi_b.data(), phi_shape);
-  cmap.tabulate(0, X, Xshape, phi_b);
+  cmap.tabulate_cached(0, X, Xshape, phi_b);
   auto phi = md::submdspan(phi_full, 0, md::full_extent, md::full_extent, 0);
 
   // Push reference coordinates (X) forward to the physical coordinates
@@ -103,6 +106,279 @@ std::vector<T> interpolation_coords(const fem::FiniteElement<T>& element,
   return x;
 }
 
+/// @brief Interpolation coordinates of a set of cells, computed in
+/// chunks of cells.
+///
+/// Function::interpolate with an InterpolationCoords object evaluates
+/// an expression `f(x)` one chunk of cells at a time, so the memory for
+/// the coordinates and the values of `f` is bounded by the chunk size
+/// rather than the number of cells. If caching is enabled, the
+/// coordinates of each chunk are computed the first time they are
+/// requested and re-used by later interpolations, e.g. of
+/// time-dependent boundary data on a fixed mesh. Cached coordinates are
+/// recomputed if the mesh geometry has been modified (see
+/// mesh::Geometry::x_version).
+///
+/// @tparam T Geometry type.
+template <std::floating_point T>
+class InterpolationCoords
+{
+public:
+  /// @brief Create interpolation coordinates for a set of cells.
+  /// @param[in] element Element to be interpolated into.
+  /// @param[in] mesh Mesh that the cells belong to.
+  /// @param[in] cells Indices of the cells to interpolate on.
+  /// @param[in] chunk_size Number of cells in each chunk.
+  /// @param[in] cache If true, the coordinates of all chunks are
+  /// stored for re-use. If false, only the coordinates of the current
+  /// chunk are stored.
+  InterpolationCoords(std::shared_ptr<const FiniteElement<T>> element,
+                      std::shared_ptr<const mesh::Mesh<T>> mesh,
+                      std::span<const std::int32_t> cells,
+                      std::size_t chunk_size = 4096, bool cache = true)
+      : _element(element), _mesh(mesh), _cells(cells.begin(), cells.end()),
+        _chunk_size(std::max<std::size_t>(chunk_size, 1)), _cache(cache),
+        _x(cache ? num_chunks() : 1)
+  {
+    assert(_element);
+    assert(_mesh);
+  }
+
+  /// @brief The element that the coordinates are computed for.
+  std::shared_ptr<const FiniteElement<T>> element() const
+  {
+    return _element;
+  }
+
+  /// @brief The mesh that the coordinates are computed for.
+  std::shared_ptr<const mesh::Mesh<T>> mesh() const { return _mesh; }
+
+  /// @brief Number of chunks of cells.
+  std::size_t num_chunks() const
+  {
+    return (_cells.size() + _chunk_size - 1) / _chunk_size;
+  }
+
+  /// @brief Cells of a chunk.
+  /// @param[in] i Chunk index.
+  std::span<const std::int32_t> cells(std::size_t i) const
+  {
+    const std::size_t c0 = i * _chunk_size;
+    const std::size_t c1 = std::min(c0 + _chunk_size, _cells.size());
+    return std::span(_cells).subspan(c0, c1 - c0);
+  }
+
+  /// @brief Interpolation coordinates of a chunk.
+  /// @param[in] i Chunk index.
+  /// @return Coordinates of the interpolation points of the cells of
+  /// chunk `i`, with shape `(3, num_points)` and row-major storage
+  /// (see fem::interpolation_coords). The array is valid until the
+  /// next call with a different chunk if caching is disabled.
+  std::span<const T> x(std::size_t i)
+  {
+    const mesh::Geometry<T>& geometry = _mesh->geometry();
+    if (_cache and _x_version != geometry.x_version())
+    {
+      std::ranges::for_each(_x, [](auto& x) { x.clear(); });
+      _x_version = geometry.x_version();
+    }
+
+    std::vector<T>& x = _cache ? _x[i] : _x.front();
+    if (!_cache or x.empty())
+      x = interpolation_coords<T>(*_element, geometry, cells(i));
+    return x;
+  }
+
+private:
+  std::shared_ptr<const FiniteElement<T>> _element;
+  std::shared_ptr<const mesh::Mesh<T>> _mesh;
+  std::vector<std::int32_t> _cells;
+  std::size_t _chunk_size;
+  bool _cache;
+
+  // Coordinates of each chunk, or of the current chunk if caching is
+  // disabled
+  std::vector<std::vector<T>> _x;
+
+  // Geometry version that the cached coordinates were computed for
+  std::uint64_t _x_version = 0;
+};
+
+/// @brief Physical coordinates of a subset of the degrees-of-freedom of
+/// a function space.
+///
+/// The subset is typically the degrees-of-freedom of a Dirichlet
+/// boundary condition (see fem::locate_dofs_topological).
+/// Function::interpolate with a DofCoordinates object evaluates an
+/// expression `f(x)` at these degrees-of-freedom only and sets the
+/// corresponding entries of the Function, e.g. the boundary condition
+/// value. The cost of updating time-dependent boundary data is then
+/// proportional to the size of the boundary rather than the size of the
+/// mesh. The coordinates are computed when first requested and are
+/// recomputed if the mesh geometry has been modified (see
+/// mesh::Geometry::x_version).
+///
+/// @note Can be used only with point-evaluation elements that are not
+/// mapped, e.g. (blocked) Lagrange elements.
+///
+/// @tparam T Geometry type.
+template <std::floating_point T>
+class DofCoordinates
+{
+public:
+  /// @brief Create the coordinates of a subset of degrees-of-freedom.
+  /// @param[in] V Function space. Must not be a subspace.
+  /// @param[in] dofs Degree-of-freedom block indices (local to the MPI
+  /// rank), e.g. as returned by fem::locate_dofs_topological.
+  /// @note The constructor visits the dofmap of each cell once to find
+  /// a cell of each degree-of-freedom.
+  DofCoordinates(std::shared_ptr<const FunctionSpace<T>> V,
+                 std::span<const std::int32_t> dofs)
+      : _V(V), _dofs(dofs.begin(), dofs.end())
+  {
+    assert(_V);
+    if (!_V->component().empty())
+    {
+      throw std::runtime_error("Cannot create degree-of-freedom coordinates "
+                               "for a subspace.");
+    }
+
+    std::shared_ptr<const FiniteElement<T>> element = _V->element();
+    assert(element);
+    if (element->is_mixed() or _V->symmetric()
+        or !element->interpolation_ident() or !element->map_ident())
+    {
+      throw std::runtime_error(
+          "Degree-of-freedom coordinates can be created only for "
+          "point-evaluation elements.");
+    }
+
+    // Position of each dof block in dofs, or -1 if not in dofs
+    std::shared_ptr<const DofMap> dofmap = _V->dofmap();
+    assert(dofmap);
+    std::vector<std::int32_t> pos(
+        dofmap->index_map->size_local() + dofmap->index_map->num_ghosts(),
+        -1);
+    for (std::size_t i = 0; i < _dofs.size(); ++i)
+      pos.at(_dofs[i]) = i;
+
+    // Find a (cell, local dof) pair for each dof. The entries are
+    // grouped by cell.
+    const int tdim = _V->mesh()->topology()->dim();
+    auto cell_map = _V->mesh()->topology()->index_map(tdim);
+    assert(cell_map);
+    const std::int32_t num_cells
+        = cell_map->size_local() + cell_map->num_ghosts();
+    std::size_t num_found = 0;
+    for (std::int32_t c = 0; c < num_cells and num_found < _dofs.size(); ++c)
+    {
+      std::span<const std::int32_t> cell_dofs = dofmap->cell_dofs(c);
+      for (std::size_t j = 0; j < cell_dofs.size(); ++j)
+      {
+        if (std::int32_t& p = pos[cell_dofs[j]]; p >= 0)
+        {
+          _entries.push_back({c, static_cast<std::int32_t>(j), p});
+          p = -1;
+          ++num_found;
+        }
+      }
+    }
+    assert(num_found == _dofs.size());
+  }
+
+  /// @brief The function space of the degrees-of-freedom.
+  std::shared_ptr<const FunctionSpace<T>> function_space() const
+  {
+    return _V;
+  }
+
+  /// @brief The degree-of-freedom block indices.
+  std::span<const std::int32_t> dofs() const { return _dofs; }
+
+  /// @brief Coordinates of the degrees-of-freedom.
+  /// @return Coordinates with shape `(3, num_dofs)` and row-major
+  /// storage, where column `i` holds the coordinate of `dofs()[i]`.
+  std::span<const T> x()
+  {
+    const mesh::Geometry<T>& geometry = _V->mesh()->geometry();
+    if (_x_version == geometry.x_version())
+      return _x;
+    _x_version = geometry.x_version();
+
+    const FiniteElement<T>& element = *_V->element();
+    const std::size_t gdim = geometry.dim();
+    const std::size_t scalar_dofs
+        = element.space_dimension() / element.block_size();
+    const auto [X, Xshape] = element.interpolation_points();
+
+    // Tabulate the coordinate element basis at the interpolation points
+    const CoordinateElement<T>& cmap = geometry.cmap();
+    auto x_dofmap = geometry.dofmap();
+    std::span<const T> x_g = geometry.x();
+    const std::array<std::size_t, 4> phi_shape
+        = cmap.tabulate_shape(0, Xshape[0]);
+    std::vector<T> phi_b(
+        std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
+    md::mdspan<const T, md::dextents<std::size_t, 4>> phi_full(phi_b.data(),
+                                                               phi_shape);
+    cmap.tabulate_cached(0, X, Xshape, phi_b);
+    auto phi = md::submdspan(phi_full, 0, md::full_extent, md::full_extent, 0);
+
+    std::span<const std::uint32_t> cell_info;
+    if (element.needs_dof_transformations())
+    {
+      _V->mesh()->topology_mutable()->create_entity_permutations();
+      cell_info
+          = std::span(_V->mesh()->topology()->get_cell_permutation_info());
+    }
+    auto apply_dof_transformation
+        = element.template dof_transformation_fn<T>(doftransform::standard);
+
+    std::vector<T> coordinate_dofs_b(cmap.dim() * gdim);
+    md::mdspan<T, md::dextents<std::size_t, 2>> coordinate_dofs(
+        coordinate_dofs_b.data(), cmap.dim(), gdim);
+    std::vector<T> xc_b(scalar_dofs * gdim);
+    md::mdspan<T, md::dextents<std::size_t, 2>> xc(xc_b.data(), scalar_dofs,
+                                                   gdim);
+
+    // Push forward the interpolation points of each cell with a dof,
+    // and copy the coordinates of the dofs of the cell
+    const std::size_t num_dofs = _dofs.size();
+    _x.assign(3 * num_dofs, 0);
+    for (std::size_t e = 0; e < _entries.size(); ++e)
+    {
+      const auto [c, j, p] = _entries[e];
+      if (e == 0 or _entries[e - 1][0] != c)
+      {
+        auto x_dofs = md::submdspan(x_dofmap, c, md::full_extent);
+        for (std::size_t i = 0; i < x_dofs.size(); ++i)
+          for (std::size_t k = 0; k < gdim; ++k)
+            coordinate_dofs(i, k) = x_g[3 * x_dofs[i] + k];
+        cmap.push_forward(xc, coordinate_dofs, phi);
+        apply_dof_transformation(xc_b, cell_info, c, xc.extent(1));
+      }
+
+      for (std::size_t k = 0; k < gdim; ++k)
+        _x[k * num_dofs + p] = xc(j, k);
+    }
+
+    return _x;
+  }
+
+private:
+  std::shared_ptr<const FunctionSpace<T>> _V;
+  std::vector<std::int32_t> _dofs;
+
+  // (cell, local dof, position in _dofs) for each dof, grouped by cell
+  std::vector<std::array<std::int32_t, 3>> _entries;
+
+  // Coordinates of the dofs, shape (3, num_dofs)
+  std::vector<T> _x;
+
+  // Geometry version that the coordinates were computed for
+  std::optional<std::uint64_t> _x_version;
+};
+
 /// @brief Interpolate an evaluated expression f(x) in a finite element
 /// space.
 ///
@@ -130,34 +406,44 @@ namespace impl
 template <typename T, std::size_t D>
 using mdspan_t = md::mdspan<T, md::dextents<std::size_t, D>>;
 
-/// @brief Scatter data into non-contiguous memory.
+/// @brief Communication pattern of impl::scatter_values.
 ///
-/// Scatter blocked data `send_values` to its corresponding `src_rank`
-/// and insert the data into `recv_values`. The insert location in
-/// `recv_values` is determined by `dest_ranks`. If the j-th dest rank
-/// is -1, then `recv_values[j*block_size:(j+1)*block_size]) = 0`.
+/// Sizes and offsets are in numbers of values, i.e. they are not
+/// unrolled for the block size.
+struct ScatterLayout
+{
+  /// Neighbourhood communicator, with edges from the processes that own
+  /// the values to the processes that receive them
+  dolfinx::MPI::Comm comm{MPI_COMM_NULL, false};
+
+  /// Number of values sent to each out-edge
+  std::vector<std::int32_t> send_sizes;
+
+  /// Offsets into the send buffer of the values for each out-edge
+  std::vector<std::int32_t> send_offsets;
+
+  /// Number of values received from each in-edge
+  std::vector<std::int32_t> recv_sizes;
+
+  /// Offsets into the receive buffer of the values from each in-edge
+  std::vector<std::int32_t> recv_offsets;
+
+  /// Position in the output of each received value
+  std::vector<std::int32_t> comm_to_output;
+};
+
+/// @brief Compute the communication pattern of impl::scatter_values.
 ///
 /// @param[in] comm The MPI communicator.
 /// @param[in] src_ranks Rank owning the values of each row in
 /// `send_values`.
-/// @param[in] dest_ranks List of ranks receiving data. Size of array is
-/// how many values we are receiving (not unrolled for block_size).
-/// @param[in] send_values Values to send back to owner. Shape is
-/// `(src_ranks.size(), block_size)`.
-/// @param[in,out] recv_values Array to fill with values.  Shape
-/// `(dest_ranks.size(), block_size)`. Storage is row-major.
+/// @param[in] dest_ranks List of ranks receiving data.
+/// @return The communication pattern.
 /// @pre It is required that src_ranks are sorted.
-/// @note `dest_ranks` can contain repeated entries.
-/// @note `dest_ranks` might contain -1 (no process owns the point).
-template <dolfinx::scalar T>
-void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
-                    std::span<const std::int32_t> dest_ranks,
-                    mdspan_t<const T, 2> send_values, std::span<T> recv_values)
+inline ScatterLayout
+create_scatter_layout(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
+                      std::span<const std::int32_t> dest_ranks)
 {
-  const std::size_t block_size = send_values.extent(1);
-  assert(src_ranks.size() * block_size == send_values.size());
-  assert(recv_values.size() == dest_ranks.size() * block_size);
-
   // Build unique set of the sorted src_ranks
   std::vector<std::int32_t> out_ranks(src_ranks.size());
   out_ranks.assign(src_ranks.begin(), src_ranks.end());
@@ -181,15 +467,18 @@ void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
   in_ranks.reserve(in_ranks.size() + 1);
 
   // Create neighborhood communicator
+  ScatterLayout layout;
   MPI_Comm reverse_comm;
   MPI_Dist_graph_create_adjacent(
       comm, in_ranks.size(), in_ranks.data(), MPI_UNWEIGHTED, out_ranks.size(),
       out_ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &reverse_comm);
+  layout.comm = dolfinx::MPI::Comm(reverse_comm, false);
 
-  std::vector<std::int32_t> comm_to_output;
-  std::vector<std::int32_t> recv_sizes(in_ranks.size());
+  std::vector<std::int32_t>& recv_sizes = layout.recv_sizes;
+  recv_sizes.resize(in_ranks.size());
   recv_sizes.reserve(1);
-  std::vector<std::int32_t> recv_offsets(in_ranks.size() + 1, 0);
+  std::vector<std::int32_t>& recv_offsets = layout.recv_offsets;
+  recv_offsets.resize(in_ranks.size() + 1, 0);
   {
     // Build map from parent to neighborhood communicator ranks
     std::vector<std::pair<std::int32_t, std::int32_t>> rank_to_neighbor;
@@ -201,7 +490,7 @@ void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
     // Compute receive sizes
     std::ranges::for_each(
         dest_ranks,
-        [&rank_to_neighbor, &recv_sizes, block_size](auto rank)
+        [&rank_to_neighbor, &recv_sizes](auto rank)
         {
           if (rank >= 0)
           {
@@ -209,7 +498,7 @@ void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
                                                std::ranges::less(),
                                                [](auto e) { return e.first; });
             assert(it != rank_to_neighbor.end() and it->first == rank);
-            recv_sizes[it->second] += block_size;
+            recv_sizes[it->second] += 1;
           }
         });
 
@@ -218,7 +507,7 @@ void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
                      std::next(recv_offsets.begin(), 1));
 
     // Compute map from receiving values to position in recv_values
-    comm_to_output.resize(recv_offsets.back() / block_size);
+    layout.comm_to_output.resize(recv_offsets.back());
     std::vector<std::int32_t> recv_counter(recv_sizes.size(), 0);
     for (std::size_t i = 0; i < dest_ranks.size(); ++i)
     {
@@ -229,13 +518,14 @@ void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
                                            [](auto e) { return e.first; });
         assert(it != rank_to_neighbor.end() and it->first == rank);
         int insert_pos = recv_offsets[it->second] + recv_counter[it->second];
-        comm_to_output[insert_pos / block_size] = i * block_size;
-        recv_counter[it->second] += block_size;
+        layout.comm_to_output[insert_pos] = i;
+        recv_counter[it->second] += 1;
       }
     }
   }
 
-  std::vector<std::int32_t> send_sizes(out_ranks.size());
+  std::vector<std::int32_t>& send_sizes = layout.send_sizes;
+  send_sizes.resize(out_ranks.size());
   send_sizes.reserve(1);
   {
     // Compute map from parent MPI rank to neighbor rank for outgoing
@@ -251,41 +541,101 @@ void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
     auto start = rank_to_neighbor.begin();
     std::ranges::for_each(
         src_ranks,
-        [&rank_to_neighbor, &send_sizes, block_size, &start](auto rank)
+        [&rank_to_neighbor, &send_sizes, &start](auto rank)
         {
           auto it = std::ranges::lower_bound(start, rank_to_neighbor.end(),
                                              rank, std::ranges::less(),
                                              [](auto e) { return e.first; });
           assert(it != rank_to_neighbor.end() and it->first == rank);
-          send_sizes[it->second] += block_size;
+          send_sizes[it->second] += 1;
           start = it;
         });
   }
 
   // Compute sending offsets
-  std::vector<std::int32_t> send_offsets(send_sizes.size() + 1, 0);
+  layout.send_offsets.resize(send_sizes.size() + 1, 0);
   std::partial_sum(send_sizes.begin(), send_sizes.end(),
-                   std::next(send_offsets.begin(), 1));
+                   std::next(layout.send_offsets.begin(), 1));
+
+  return layout;
+}
+
+/// @brief Scatter data with a precomputed communication pattern.
+///
+/// @param[in] layout Communication pattern, see
+/// impl::create_scatter_layout.
+/// @param[in] send_values Values to send back to owner. Shape is
+/// `(layout.send_offsets.back(), block_size)`.
+/// @param[in,out] recv_values Array to fill with values. Storage is
+/// row-major. Rows that are not received are set to zero.
+template <dolfinx::scalar T>
+void scatter_values(const ScatterLayout& layout,
+                    mdspan_t<const T, 2> send_values, std::span<T> recv_values)
+{
+  const std::size_t block_size = send_values.extent(1);
+  assert(layout.send_offsets.back() * block_size == send_values.size());
+  auto scale = [block_size](const std::vector<std::int32_t>& v)
+  {
+    std::vector<std::int32_t> w(v.size());
+    w.reserve(1);
+    std::ranges::transform(v, w.begin(),
+                           [block_size](auto n) { return n * block_size; });
+    return w;
+  };
 
   // Send values to dest ranks
+  std::vector<std::int32_t> send_sizes = scale(layout.send_sizes);
+  std::vector<std::int32_t> send_offsets = scale(layout.send_offsets);
+  std::vector<std::int32_t> recv_sizes = scale(layout.recv_sizes);
+  std::vector<std::int32_t> recv_offsets = scale(layout.recv_offsets);
   std::vector<T> values(recv_offsets.back());
   values.reserve(1);
   MPI_Neighbor_alltoallv(send_values.data_handle(), send_sizes.data(),
                          send_offsets.data(), dolfinx::MPI::mpi_t<T>,
                          values.data(), recv_sizes.data(), recv_offsets.data(),
-                         dolfinx::MPI::mpi_t<T>, reverse_comm);
-  MPI_Comm_free(&reverse_comm);
+                         dolfinx::MPI::mpi_t<T>, layout.comm.comm());
 
   // Insert values received from neighborhood communicator in output
   // span
   std::ranges::fill(recv_values, T(0));
-  for (std::size_t i = 0; i < comm_to_output.size(); i++)
+  for (std::size_t i = 0; i < layout.comm_to_output.size(); i++)
   {
-    auto vals = std::next(recv_values.begin(), comm_to_output[i]);
+    auto vals
+        = std::next(recv_values.begin(), layout.comm_to_output[i] * block_size);
     auto vals_from = std::next(values.begin(), i * block_size);
     std::copy_n(vals_from, block_size, vals);
   }
-};
+}
+
+/// @brief Scatter data into non-contiguous memory.
+///
+/// Scatter blocked data `send_values` to its corresponding `src_rank`
+/// and insert the data into `recv_values`. The insert location in
+/// `recv_values` is determined by `dest_ranks`. If the j-th dest rank
+/// is -1, then `recv_values[j*block_size:(j+1)*block_size]) = 0`.
+///
+/// @param[in] comm The MPI communicator.
+/// @param[in] src_ranks Rank owning the values of each row in
+/// `send_values`.
+/// @param[in] dest_ranks List of ranks receiving data. Size of array is
+/// how many values we are receiving (not unrolled for block_size).
+/// @param[in] send_values Values to send back to owner. Shape is
+/// `(src_ranks.size(), block_size)`.
+/// @param[in,out] recv_values Array to fill with values.  Shape
+/// `(dest_ranks.size(), block_size)`. Storage is row-major.
+/// @pre It is required that src_ranks are sorted.
+/// @note `dest_ranks` can contain repeated entries.
+/// @note `dest_ranks` might contain -1 (no process owns the point).
+template <dolfinx::scalar T>
+void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
+                    std::span<const std::int32_t> dest_ranks,
+                    mdspan_t<const T, 2> send_values, std::span<T> recv_values)
+{
+  assert(src_ranks.size() * send_values.extent(1) == send_values.size());
+  assert(recv_values.size() == dest_ranks.size() * send_values.extent(1));
+  scatter_values(create_scatter_layout(comm, src_ranks, dest_ranks),
+                 send_values, recv_values);
+}
 
 /// @brief Apply interpolation operator Pi to data to evaluate the dof
 /// coefficients.
@@ -436,30 +786,35 @@ void interpolate_same_map(Function<T, U>& u1, const Function<T, U>& u0,
   }
 }
 
-/// @brief Interpolate from one finite element Function to another on
-/// the same mesh.
+/// @brief Cell-wise interpolation between finite element spaces on the
+/// same mesh whose basis functions are mapped differently.
 ///
-/// This interpolation function is for cases where the finite element
-/// basis functions for the two elements are mapped differently, e.g.
-/// one may be subject to a Piola mapping and the other to a standard
-/// isoparametric mapping.
+/// For each cell `c` and each `j < num_vectors`, `get(c, j, coeffs0)`
+/// provides expansion coefficients `coeffs0` of a function in `V0` on
+/// cell `cells0[c]`, and `set(c, j, local1)` receives the expansion
+/// coefficients `local1` of its interpolant in `V1` on cell `cells1[c]`.
+/// The geometry of each cell and the mapped basis of `V0` are computed
+/// once for all `num_vectors` coefficient vectors.
 ///
-/// @param[out] u1 Function to interpolate to.
+/// @param[in] V1 Function space to interpolate to.
 /// @param[in] cells1 Cells to interpolate on.
-/// @param[in] u0 Function to interpolate from.
-/// @param[in] cells0 Equivalent cell in `u0` for each cell in `u1`.
-/// @pre The functions `u1` and `u0` must share the same mesh. This is
-/// not checked by the function.
-template <dolfinx::scalar T, std::floating_point U>
-void interpolate_nonmatching_maps(Function<T, U>& u1,
-                                  std::span<const std::int32_t> cells1,
-                                  const Function<T, U>& u0,
-                                  std::span<const std::int32_t> cells0)
+/// @param[in] V0 Function space to interpolate from.
+/// @param[in] cells0 Equivalent cell in `V0` for each cell in `V1`.
+/// @param[in] num_vectors Number of coefficient vectors per cell.
+/// @param[in] get Function that provides the coefficients to
+/// interpolate.
+/// @param[in] set Function that receives the interpolated coefficients.
+/// @pre The spaces `V1` and `V0` must share the same mesh. This is not
+/// checked by the function.
+template <dolfinx::scalar T, std::floating_point U, typename G, typename S>
+void nonmatching_maps_apply(const FunctionSpace<U>& V1,
+                            std::span<const std::int32_t> cells1,
+                            const FunctionSpace<U>& V0,
+                            std::span<const std::int32_t> cells0,
+                            int num_vectors, G&& get, S&& set)
 {
   // Get mesh
-  auto V0 = u0.function_space();
-  assert(V0);
-  auto mesh0 = V0->mesh();
+  auto mesh0 = V0.mesh();
   assert(mesh0);
 
   // Mesh dims
@@ -467,13 +822,11 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
   const int gdim = mesh0->geometry().dim();
 
   // Get elements
-  auto V1 = u1.function_space();
-  assert(V1);
-  auto mesh1 = V1->mesh();
+  auto mesh1 = V1.mesh();
   assert(mesh1);
-  auto element0 = V0->element();
+  auto element0 = V0.element();
   assert(element0);
-  auto element1 = V1->element();
+  auto element1 = V1.element();
   assert(element1);
 
   std::span<const std::uint32_t> cell_info0;
@@ -487,10 +840,6 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
     cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
   }
 
-  // Get dofmaps
-  auto dofmap0 = V0->dofmap();
-  auto dofmap1 = V1->dofmap();
-
   const auto [X, Xshape] = element1->interpolation_points();
 
   // Get block sizes and dof transformation operators
@@ -505,7 +854,7 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
   // Get sizes of elements
   const std::size_t dim0 = element0->space_dimension() / bs0;
   const std::size_t value_size_ref0 = element0->reference_value_size();
-  const std::size_t value_size0 = V0->element()->reference_value_size();
+  const std::size_t value_size0 = V0.element()->reference_value_size();
 
   const CoordinateElement<U>& cmap = mesh0->geometry().cmap();
   auto x_dofmap = mesh0->geometry().dofmap();
@@ -523,11 +872,11 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
   md::mdspan<const U, md::extents<std::size_t, md::dynamic_extent,
                                   md::dynamic_extent, md::dynamic_extent, 1>>
       phi(phi_b.data(), phi_shape);
-  cmap.tabulate(1, X, Xshape, phi_b);
+  cmap.tabulate_cached(1, X, Xshape, phi_b);
 
   // Evaluate v basis functions at reference interpolation points
   const auto [_basis_derivatives_reference0, b0shape]
-      = element0->tabulate(X, Xshape, 0);
+      = element0->tabulate_cached(X, Xshape, 0);
   md::mdspan<const U, std::extents<std::size_t, 1, md::dynamic_extent,
                                    md::dynamic_extent, md::dynamic_extent>>
       basis_derivatives_reference0(_basis_derivatives_reference0.data(),
@@ -545,16 +894,16 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
   md::mdspan<U, std::dextents<std::size_t, 3>> basis_reference0(
       basis_reference0_b.data(), Xshape[0], dim0, value_size_ref0);
 
-  std::vector<T> values0_b(Xshape[0] * 1 * V1->element()->value_size());
+  std::vector<T> values0_b(Xshape[0] * 1 * V1.element()->value_size());
   md::mdspan<
       T, md::extents<std::size_t, md::dynamic_extent, 1, md::dynamic_extent>>
-      values0(values0_b.data(), Xshape[0], 1, V1->element()->value_size());
+      values0(values0_b.data(), Xshape[0], 1, V1.element()->value_size());
 
-  std::vector<T> mapped_values_b(Xshape[0] * 1 * V1->element()->value_size());
+  std::vector<T> mapped_values_b(Xshape[0] * 1 * V1.element()->value_size());
   md::mdspan<
       T, md::extents<std::size_t, md::dynamic_extent, 1, md::dynamic_extent>>
       mapped_values0(mapped_values_b.data(), Xshape[0], 1,
-                     V1->element()->value_size());
+                     V1.element()->value_size());
 
   std::vector<U> coord_dofs_b(num_dofs_g * gdim);
   md::mdspan<U, std::dextents<std::size_t, 2>> coord_dofs(coord_dofs_b.data(),
@@ -587,8 +936,6 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
       = element1->basix_element().template map_fn<V_t, v_t, K_t, J_t>();
 
   // Iterate over mesh and interpolate on each cell
-  std::span<const T> array0 = u0.x()->array();
-  std::span<T> array1 = u1.x()->mutable_array();
   for (std::size_t c = 0; c < cells0.size(); c++)
   {
     // Get cell geometry (coordinate dofs)
@@ -639,54 +986,101 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
       push_forward_fn0(_u, _U, _J, detJ[i], _K);
     }
 
-    // Copy expansion coefficients for v into local array
-    const int dof_bs0 = dofmap0->bs();
-    std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(cells0[c]);
-    for (std::size_t i = 0; i < dofs0.size(); ++i)
-      for (int k = 0; k < dof_bs0; ++k)
-        coeffs0[dof_bs0 * i + k] = array0[dof_bs0 * dofs0[i] + k];
-
-    // Evaluate v at the interpolation points (physical space values)
-    using X = typename dolfinx::scalar_value_t<T>;
-    for (std::size_t p = 0; p < Xshape[0]; ++p)
+    for (int n = 0; n < num_vectors; ++n)
     {
-      for (int k = 0; k < bs0; ++k)
+      get(c, n, std::span<T>(coeffs0));
+
+      // Evaluate v at the interpolation points (physical space values)
+      using X = typename dolfinx::scalar_value_t<T>;
+      for (std::size_t p = 0; p < Xshape[0]; ++p)
       {
-        for (std::size_t j = 0; j < value_size0; ++j)
+        for (int k = 0; k < bs0; ++k)
         {
-          T acc = 0;
-          for (std::size_t i = 0; i < dim0; ++i)
-            acc += coeffs0[bs0 * i + k] * static_cast<X>(basis0(p, i, j));
-          values0(p, 0, j * bs0 + k) = acc;
+          for (std::size_t j = 0; j < value_size0; ++j)
+          {
+            T acc = 0;
+            for (std::size_t i = 0; i < dim0; ++i)
+              acc += coeffs0[bs0 * i + k] * static_cast<X>(basis0(p, i, j));
+            values0(p, 0, j * bs0 + k) = acc;
+          }
         }
       }
-    }
 
-    // Pull back the physical values to the u reference
-    for (std::size_t i = 0; i < values0.extent(0); ++i)
-    {
-      auto _u = md::submdspan(values0, i, md::full_extent, md::full_extent);
-      auto _U
-          = md::submdspan(mapped_values0, i, md::full_extent, md::full_extent);
-      auto _K = md::submdspan(K, i, md::full_extent, md::full_extent);
-      auto _J = md::submdspan(J, i, md::full_extent, md::full_extent);
-      pull_back_fn1(_U, _u, _K, 1.0 / detJ[i], _J);
-    }
+      // Pull back the physical values to the u reference
+      for (std::size_t i = 0; i < values0.extent(0); ++i)
+      {
+        auto _u = md::submdspan(values0, i, md::full_extent, md::full_extent);
+        auto _U = md::submdspan(mapped_values0, i, md::full_extent,
+                                md::full_extent);
+        auto _K = md::submdspan(K, i, md::full_extent, md::full_extent);
+        auto _J = md::submdspan(J, i, md::full_extent, md::full_extent);
+        pull_back_fn1(_U, _u, _K, 1.0 / detJ[i], _J);
+      }
 
-    auto values
-        = md::submdspan(mapped_values0, md::full_extent, 0, md::full_extent);
-    interpolation_apply(Pi_1, values, std::span(local1), bs1);
-    apply_inverse_dof_transform1(local1, cell_info1, cells1[c], 1);
+      auto values
+          = md::submdspan(mapped_values0, md::full_extent, 0, md::full_extent);
+      interpolation_apply(Pi_1, values, std::span(local1), bs1);
+      apply_inverse_dof_transform1(local1, cell_info1, cells1[c], 1);
 
-    // Copy local coefficients to the correct position in u dof array
-    const int dof_bs1 = dofmap1->bs();
-    std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(c);
-    for (std::size_t i = 0; i < dofs1.size(); ++i)
-      for (int k = 0; k < dof_bs1; ++k)
-        array1[dof_bs1 * dofs1[i] + k] = local1[dof_bs1 * i + k];
+      set(c, n, std::span<const T>(local1));
+    }
   }
 }
 
+/// @brief Interpolate from one finite element Function to another on
+/// the same mesh.
+///
+/// This interpolation function is for cases where the finite element
+/// basis functions for the two elements are mapped differently, e.g.
+/// one may be subject to a Piola mapping and the other to a standard
+/// isoparametric mapping.
+///
+/// @param[out] u1 Function to interpolate to.
+/// @param[in] cells1 Cells to interpolate on.
+/// @param[in] u0 Function to interpolate from.
+/// @param[in] cells0 Equivalent cell in `u0` for each cell in `u1`.
+/// @pre The functions `u1` and `u0` must share the same mesh. This is
+/// not checked by the function.
+template <dolfinx::scalar T, std::floating_point U>
+void interpolate_nonmatching_maps(Function<T, U>& u1,
+                                  std::span<const std::int32_t> cells1,
+                                  const Function<T, U>& u0,
+                                  std::span<const std::int32_t> cells0)
+{
+  auto V0 = u0.function_space();
+  assert(V0);
+  auto V1 = u1.function_space();
+  assert(V1);
+
+  // Get dofmaps
+  auto dofmap0 = V0->dofmap();
+  auto dofmap1 = V1->dofmap();
+  const int dof_bs0 = dofmap0->bs();
+  const int dof_bs1 = dofmap1->bs();
+
+  std::span<const T> array0 = u0.x()->array();
+  std::span<T> array1 = u1.x()->mutable_array();
+  nonmatching_maps_apply<T>(
+      *V1, cells1, *V0, cells0, 1,
+      [&](std::size_t c, int, std::span<T> coeffs0)
+      {
+        // Copy expansion coefficients for u0 into local array
+        std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(cells0[c]);
+        for (std::size_t i = 0; i < dofs0.size(); ++i)
+          for (int k = 0; k < dof_bs0; ++k)
+            coeffs0[dof_bs0 * i + k] = array0[dof_bs0 * dofs0[i] + k];
+      },
+      [&](std::size_t c, int, std::span<const T> local1)
+      {
+        // Copy local coefficients to the correct position in u1 dof
+        // array
+        std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(cells1[c]);
+        for (std::size_t i = 0; i < dofs1.size(); ++i)
+          for (int k = 0; k < dof_bs1; ++k)
+            array1[dof_bs1 * dofs1[i] + k] = local1[dof_bs1 * i + k];
+      });
+}
+
 //----------------------------------------------------------------------------
 } // namespace impl
 
@@ -938,7 +1332,7 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
     md::mdspan<const U, md::extents<std::size_t, md::dynamic_extent,
                                     md::dynamic_extent, md::dynamic_extent, 1>>
         phi(phi_b.data(), phi_shape);
-    cmap.tabulate(1, X, Xshape, phi_b);
+    cmap.tabulate_cached(1, X, Xshape, phi_b);
     auto dphi = md::submdspan(phi, std::pair(1, tdim + 1), md::full_extent,
                               md::full_extent, 0);
 
@@ -1134,6 +1528,331 @@ void interpolate(Function<T, U>& u, const Function<T, U>& v,
                       cells);
 }
 
+/// @brief Precomputed data for repeated interpolation of a
+/// fem::Function into a finite element space on a different
+/// (non-matching) mesh.
+///
+/// The interpolation points of the destination space are located once,
+/// by fem::create_interpolation_data. An InterpolationPlan stores, for
+/// the points that are located on the calling process, the cell and the
+/// values of the basis functions of the source space, and it stores the
+/// pattern (including a neighbourhood communicator) of the communication
+/// that returns the evaluated values to the processes that own the
+/// interpolation points. Interpolation with a plan is then a local
+/// sparse matrix-vector product, one neighbourhood communication and the
+/// local interpolation in the destination space.
+///
+/// @note A plan is invalid if the mesh of the source space is moved.
+///
+/// @tparam U Mesh geometry scalar type.
+template <std::floating_point U>
+class InterpolationPlan
+{
+public:
+  /// @brief Create an interpolation plan.
+  ///
+  /// @note Collective.
+  ///
+  /// @param[in] V Function space to interpolate from.
+  /// @param[in] cells Cell indices relative to the mesh of the space to
+  /// interpolate into.
+  /// @param[in] interpolation_data Data associating the interpolation
+  /// points of the space to interpolate into with cells of the mesh of
+  /// `V`, computed by fem::create_interpolation_data.
+  InterpolationPlan(
+      std::shared_ptr<const FunctionSpace<U>> V,
+      std::span<const std::int32_t> cells,
+      const geometry::PointOwnershipData<U>& interpolation_data)
+      : _V(V), _cells(cells.begin(), cells.end()),
+        _num_points(interpolation_data.src_owner.size()),
+        _eval_cells(interpolation_data.dest_cells)
+  {
+    assert(V);
+    auto mesh = V->mesh();
+    assert(mesh);
+    auto element = V->element();
+    assert(element);
+    if (element->num_sub_elements() > 1
+        and element->num_sub_elements() != element->block_size())
+    {
+      throw std::runtime_error("Interpolation plans are not supported for "
+                               "mixed elements. Extract subspaces.");
+    }
+
+    if (element->symmetric())
+    {
+      throw std::runtime_error(
+          "Interpolation plans are not supported for symmetric elements.");
+    }
+
+    _layout = impl::create_scatter_layout(
+        mesh->comm(), interpolation_data.dest_owners,
+        interpolation_data.src_owner);
+
+    const std::size_t gdim = mesh->geometry().dim();
+    const std::size_t tdim = mesh->topology()->dim();
+    const CoordinateElement<U>& cmap = mesh->geometry().cmap();
+    auto x_dofmap = mesh->geometry().dofmap();
+    const std::size_t num_dofs_g = cmap.dim();
+    std::span<const U> x_g = mesh->geometry().x();
+    const std::size_t space_dimension
+        = element->space_dimension() / element->block_size();
+    const std::size_t value_size = element->reference_value_size();
+
+    std::span<const std::uint32_t> cell_info;
+    if (element->needs_dof_transformations())
+    {
+      mesh->topology_mutable()->create_entity_permutations();
+      cell_info = std::span(mesh->topology()->get_cell_permutation_info());
+    }
+
+    // Pull back each point, and compute the Jacobian data
+    const std::size_t num_eval = _eval_cells.size();
+    const std::vector<U>& x = interpolation_data.dest_points;
+    std::vector<U> X_b(num_eval * tdim);
+    std::vector<U> J_b(num_eval * gdim * tdim);
+    impl::mdspan_t<U, 3> J(J_b.data(), num_eval, gdim, tdim);
+    std::vector<U> K_b(num_eval * tdim * gdim);
+    impl::mdspan_t<U, 3> K(K_b.data(), num_eval, tdim, gdim);
+    std::vector<U> detJ(num_eval);
+    std::vector<U> det_scratch(2 * gdim * tdim);
+
+    // Points with a cell, with their physical coordinates and the
+    // geometry of their cell
+    std::vector<std::size_t> points;
+    std::vector<U> xp_b, coord_dofs_b;
+    for (std::size_t p = 0; p < num_eval; ++p)
+    {
+      if (_eval_cells[p] < 0)
+        continue;
+
+      points.push_back(p);
+      auto x_dofs = md::submdspan(x_dofmap, _eval_cells[p], md::full_extent);
+      for (std::size_t i = 0; i < num_dofs_g; ++i)
+        for (std::size_t j = 0; j < gdim; ++j)
+          coord_dofs_b.push_back(x_g[3 * x_dofs[i] + j]);
+      for (std::size_t j = 0; j < gdim; ++j)
+        xp_b.push_back(x[3 * p + j]);
+    }
+    impl::mdspan_t<const U, 3> coord_dofs(coord_dofs_b.data(), points.size(),
+                                          num_dofs_g, gdim);
+
+    // Geometry basis derivatives at the origin of the reference cell for
+    // affine cells, and at each (pulled back) point otherwise
+    std::vector<U> Xn_b(std::max<std::size_t>(points.size(), 1) * tdim, 0);
+    if (!cmap.is_affine())
+    {
+      cmap.pull_back_nonaffine(
+          impl::mdspan_t<U, 2>(Xn_b.data(), points.size(), tdim),
+          impl::mdspan_t<const U, 2>(xp_b.data(), points.size(), gdim),
+          coord_dofs);
+    }
+    const std::size_t num_phi = cmap.is_affine() ? 1 : points.size();
+    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, num_phi);
+    std::vector<U> phi_b(
+        std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
+    impl::mdspan_t<const U, 4> phi(phi_b.data(), phi_shape);
+    cmap.tabulate(1, std::span(Xn_b.data(), num_phi * tdim), {num_phi, tdim},
+                  phi_b);
+
+    for (std::size_t q = 0; q < points.size(); ++q)
+    {
+      const std::size_t p = points[q];
+      auto dphi = md::submdspan(phi, std::pair(1, tdim + 1),
+                                cmap.is_affine() ? 0 : q, md::full_extent, 0);
+      auto _coord_dofs
+          = md::submdspan(coord_dofs, q, md::full_extent, md::full_extent);
+      auto _J = md::submdspan(J, p, md::full_extent, md::full_extent);
+      auto _K = md::submdspan(K, p, md::full_extent, md::full_extent);
+      CoordinateElement<U>::compute_jacobian(dphi, _coord_dofs, _J);
+      CoordinateElement<U>::compute_jacobian_inverse(_J, _K);
+      detJ[p] = CoordinateElement<U>::compute_jacobian_determinant(
+          _J, det_scratch);
+      if (cmap.is_affine())
+      {
+        std::array<U, 3> Xpb = {0, 0, 0};
+        md::mdspan<U, md::extents<std::size_t, 1, md::dynamic_extent>> Xp(
+            Xpb.data(), 1, tdim);
+        std::array<U, 3> x0 = {0, 0, 0};
+        for (std::size_t i = 0; i < gdim; ++i)
+          x0[i] = _coord_dofs(0, i);
+        CoordinateElement<U>::pull_back_affine(
+            Xp, _K, x0,
+            impl::mdspan_t<const U, 2>(xp_b.data() + q * gdim, 1, gdim));
+        std::copy_n(Xpb.begin(), tdim, std::next(X_b.begin(), p * tdim));
+      }
+      else
+      {
+        std::copy_n(std::next(Xn_b.begin(), q * tdim), tdim,
+                    std::next(X_b.begin(), p * tdim));
+      }
+    }
+
+    // Tabulate the basis at all points, and map the values to the
+    // physical cells
+    std::vector<U> basis_ref_b(num_eval * space_dimension * value_size);
+    impl::mdspan_t<const U, 3> basis_ref(basis_ref_b.data(), num_eval,
+                                         space_dimension, value_size);
+    element->tabulate(basis_ref_b, X_b, {num_eval, tdim}, 0);
+    _basis_values.resize(basis_ref_b.size());
+
+    using xu_t = impl::mdspan_t<U, 2>;
+    using xU_t = impl::mdspan_t<const U, 2>;
+    using xJ_t = impl::mdspan_t<const U, 2>;
+    using xK_t = impl::mdspan_t<const U, 2>;
+    auto push_forward_fn
+        = element->basix_element().template map_fn<xu_t, xU_t, xJ_t, xK_t>();
+    auto apply_dof_transformation
+        = element->template dof_transformation_fn<U>(doftransform::standard);
+    const std::size_t num_basis_values = space_dimension * value_size;
+    for (std::size_t p = 0; p < num_eval; ++p)
+    {
+      if (_eval_cells[p] < 0)
+        continue;
+
+      apply_dof_transformation(
+          std::span(basis_ref_b.data() + p * num_basis_values,
+                    num_basis_values),
+          cell_info, _eval_cells[p], value_size);
+      auto _U = md::submdspan(basis_ref, p, md::full_extent, md::full_extent);
+      xu_t _u(_basis_values.data() + p * num_basis_values, space_dimension,
+              value_size);
+      auto _J = md::submdspan(J, p, md::full_extent, md::full_extent);
+      auto _K = md::submdspan(K, p, md::full_extent, md::full_extent);
+      push_forward_fn(_u, _U, _J, detJ[p], _K);
+    }
+  }
+
+  /// Function space to interpolate from
+  std::shared_ptr<const FunctionSpace<U>> function_space() const
+  {
+    return _V;
+  }
+
+  /// Cells (in the mesh of the space to interpolate into) to
+  /// interpolate into
+  std::span<const std::int32_t> cells() const { return _cells; }
+
+  /// Number of interpolation points owned by the calling process
+  std::size_t num_points() const { return _num_points; }
+
+  /// @brief Cells (in the mesh of the space to interpolate from) in
+  /// which the points located on the calling process are evaluated.
+  std::span<const std::int32_t> evaluation_cells() const
+  {
+    return _eval_cells;
+  }
+
+  /// @brief Values of the basis functions of a block of the space to
+  /// interpolate from at the points located on the calling process.
+  ///
+  /// The shape is `(evaluation_cells().size(), space_dimension,
+  /// reference_value_size)`, where `space_dimension` is the dimension of
+  /// the unblocked space. Storage is row-major.
+  std::span<const U> basis_values() const { return _basis_values; }
+
+  /// Communication pattern for returning the evaluated values
+  const impl::ScatterLayout& layout() const { return _layout; }
+
+private:
+  // Function space to interpolate from
+  std::shared_ptr<const FunctionSpace<U>> _V;
+
+  // Cells to interpolate into
+  std::vector<std::int32_t> _cells;
+
+  // Number of interpolation points owned by this process
+  std::size_t _num_points;
+
+  // Cell of each point located on this process, and the basis function
+  // values at the point
+  std::vector<std::int32_t> _eval_cells;
+  std::vector<U> _basis_values;
+
+  // Communication pattern
+  impl::ScatterLayout _layout;
+};
+
+/// @brief Interpolate a finite element Function defined on a mesh to a
+/// finite element Function defined on different (non-matching) mesh,
+/// using precomputed data.
+///
+/// The result is the same as for fem::interpolate with the
+/// interpolation data used to create the plan.
+///
+/// @note Collective.
+///
+/// @tparam T Function scalar type.
+/// @tparam U mesh::Mesh geometry scalar type.
+/// @param u Function to interpolate into.
+/// @param v Function to interpolate from. It must be in the space of
+/// the plan, and its ghost values must be up-to-date.
+/// @param plan Interpolation plan.
+template <dolfinx::scalar T, std::floating_point U>
+void interpolate(Function<T, U>& u, const Function<T, U>& v,
+                 const InterpolationPlan<U>& plan)
+{
+  if (v.function_space() != plan.function_space())
+  {
+    throw std::runtime_error(
+        "Function to interpolate from is not in the space of the plan.");
+  }
+
+  auto element_v = v.function_space()->element();
+  assert(element_v);
+  const int bs = element_v->block_size();
+  const std::size_t space_dimension = element_v->space_dimension() / bs;
+  const std::size_t ref_value_size = element_v->reference_value_size();
+  std::shared_ptr<const DofMap> dofmap = v.function_space()->dofmap();
+  assert(dofmap);
+  assert(dofmap->bs() == bs);
+  assert(u.function_space()->element());
+  const std::size_t value_size = u.function_space()->element()->value_size();
+
+  // Evaluate the interpolating function at the points located on this
+  // process
+  std::span<const std::int32_t> eval_cells = plan.evaluation_cells();
+  std::span<const U> basis_values = plan.basis_values();
+  std::span<const T> x = v.x()->array();
+  std::vector<T> send_values(eval_cells.size() * value_size, 0);
+  for (std::size_t p = 0; p < eval_cells.size(); ++p)
+  {
+    if (eval_cells[p] < 0)
+      continue;
+
+    std::span<const std::int32_t> dofs = dofmap->cell_dofs(eval_cells[p]);
+    const U* phi = basis_values.data() + p * space_dimension * ref_value_size;
+    T* values = send_values.data() + p * value_size;
+    for (std::size_t i = 0; i < space_dimension; ++i)
+    {
+      for (int k = 0; k < bs; ++k)
+      {
+        const T c = x[bs * dofs[i] + k];
+        for (std::size_t j = 0; j < ref_value_size; ++j)
+          values[j * bs + k] += c * phi[i * ref_value_size + j];
+      }
+    }
+  }
+
+  // Send values back to owning process
+  std::vector<T> values_b(plan.num_points() * value_size);
+  impl::scatter_values(plan.layout(),
+                       impl::mdspan_t<const T, 2>(send_values.data(),
+                                                  eval_cells.size(),
+                                                  value_size),
+                       std::span(values_b));
+
+  // Transpose received data
+  std::vector<T> valuesT_b(values_b.size());
+  for (std::size_t i = 0; i < plan.num_points(); ++i)
+    for (std::size_t j = 0; j < value_size; ++j)
+      valuesT_b[j * plan.num_points() + i] = values_b[i * value_size + j];
+
+  // Call local interpolation operator
+  fem::interpolate<T>(u, valuesT_b, {value_size, plan.num_points()},
+                      plan.cells());
+}
+
 /// @brief Interpolate from one finite element Function to another
 /// Function on the same (sub)mesh.
 ///
@@ -1238,4 +1957,150 @@ void interpolate(Function<T, U>& u1, std::span<const std::int32_t> cells1,
     }
   }
 }
+
+/// @brief Cell-local operators for repeated interpolation between two
+/// finite element spaces on the same mesh whose basis functions are
+/// mapped differently, e.g. from a Lagrange to a Nédélec space.
+///
+/// Interpolation between such spaces requires on each cell the
+/// Jacobian of the geometry map, the push forward of the basis of the
+/// source space and the pull back to the destination space (see
+/// fem::interpolate). These steps are linear in the expansion
+/// coefficients of the source function. The operator stores the result
+/// as a dense matrix for each cell, so that repeated interpolation is a
+/// cell-wise matrix-vector product.
+///
+/// Function::interpolate creates an operator when a Function is
+/// interpolated between spaces with different maps, and reuses it when
+/// the same pair of spaces and cells is interpolated again. The cell
+/// matrices are computed at the first reuse, and require storage of
+/// `num_cells * dim0 * dim1` values, where `dim0` and `dim1` are the
+/// dimensions of the elements.
+///
+/// @note An operator is invalid if the mesh is moved.
+///
+/// @tparam T Scalar type of the functions.
+/// @tparam U Mesh geometry scalar type.
+template <dolfinx::scalar T, std::floating_point U>
+class NonmatchingInterpolationOperator
+{
+public:
+  /// @brief Create an operator for the interpolation from `V0` to `V1`.
+  ///
+  /// The cell matrices are computed by the first call to
+  /// NonmatchingInterpolationOperator::apply.
+  ///
+  /// @param[in] V1 Function space to interpolate to.
+  /// @param[in] cells1 Cells to interpolate on.
+  /// @param[in] V0 Function space to interpolate from.
+  /// @param[in] cells0 Equivalent cell in `V0` for each cell in `V1`.
+  NonmatchingInterpolationOperator(
+      std::shared_ptr<const FunctionSpace<U>> V1,
+      std::span<const std::int32_t> cells1,
+      std::shared_ptr<const FunctionSpace<U>> V0,
+      std::span<const std::int32_t> cells0)
+      : _V1(V1), _V0(V0), _cells1(cells1.begin(), cells1.end()),
+        _cells0(cells0.begin(), cells0.end())
+  {
+    if (cells0.size() != cells1.size())
+      throw std::runtime_error("Length of cell lists do not match.");
+  }
+
+  /// @brief Check if the operator interpolates from `V0` on `cells0`
+  /// to `V1` on `cells1`.
+  /// @param[in] V1 Function space to interpolate to.
+  /// @param[in] cells1 Cells to interpolate on.
+  /// @param[in] V0 Function space to interpolate from.
+  /// @param[in] cells0 Equivalent cell in `V0` for each cell in `V1`.
+  /// @return True if the operator interpolates between the spaces and
+  /// cells.
+  bool matches(const std::shared_ptr<const FunctionSpace<U>>& V1,
+               std::span<const std::int32_t> cells1,
+               const std::shared_ptr<const FunctionSpace<U>>& V0,
+               std::span<const std::int32_t> cells0) const
+  {
+    return _V1.lock() == V1 and _V0.lock() == V0
+           and std::ranges::equal(_cells1, cells1)
+           and std::ranges::equal(_cells0, cells0);
+  }
+
+  /// @brief Interpolate `u0` into `u1`.
+  /// @param[in,out] u1 Function to interpolate to. It must be in the
+  /// space `V1` of the operator.
+  /// @param[in] u0 Function to interpolate from. It must be in the space
+  /// `V0` of the operator.
+  void apply(Function<T, U>& u1, const Function<T, U>& u0)
+  {
+    std::shared_ptr<const FunctionSpace<U>> V0 = _V0.lock();
+    std::shared_ptr<const FunctionSpace<U>> V1 = _V1.lock();
+    if (!V0 or !V1 or u0.function_space() != V0
+        or u1.function_space() != V1)
+    {
+      throw std::runtime_error(
+          "Functions are not in the spaces of the interpolation operator.");
+    }
+
+    auto dofmap0 = V0->dofmap();
+    assert(dofmap0);
+    auto dofmap1 = V1->dofmap();
+    assert(dofmap1);
+    const int bs0 = dofmap0->bs();
+    const int bs1 = dofmap1->bs();
+    const std::size_t dim0 = V0->element()->space_dimension();
+    const std::size_t dim1 = V1->element()->space_dimension();
+
+    if (_A.empty() and !_cells0.empty())
+    {
+      // Column n of the matrix of cell c is the interpolant of basis
+      // function n of V0
+      _A.resize(_cells0.size() * dim1 * dim0);
+      impl::nonmatching_maps_apply<T>(
+          *V1, _cells1, *V0, _cells0, dim0,
+          [](std::size_t, int n, std::span<T> coeffs0)
+          {
+            std::ranges::fill(coeffs0, 0);
+            coeffs0[n] = 1;
+          },
+          [&](std::size_t c, int n, std::span<const T> local1)
+          {
+            for (std::size_t i = 0; i < dim1; ++i)
+              _A[(c * dim1 + i) * dim0 + n] = local1[i];
+          });
+    }
+
+    std::span<const T> array0 = u0.x()->array();
+    std::span<T> array1 = u1.x()->mutable_array();
+    std::vector<T> coeffs0(dim0);
+    for (std::size_t c = 0; c < _cells0.size(); ++c)
+    {
+      std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(_cells0[c]);
+      for (std::size_t i = 0; i < dofs0.size(); ++i)
+        for (int k = 0; k < bs0; ++k)
+          coeffs0[bs0 * i + k] = array0[bs0 * dofs0[i] + k];
+
+      std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(_cells1[c]);
+      std::span<const T> A(_A.data() + c * dim1 * dim0, dim1 * dim0);
+      for (std::size_t i = 0; i < dofs1.size(); ++i)
+      {
+        for (int k = 0; k < bs1; ++k)
+        {
+          std::span<const T> row = A.subspan((bs1 * i + k) * dim0, dim0);
+          array1[bs1 * dofs1[i] + k]
+              = std::inner_product(row.begin(), row.end(), coeffs0.begin(),
+                                   T(0));
+        }
+      }
+    }
+  }
+
+private:
+  // Spaces interpolated to and from
+  std::weak_ptr<const FunctionSpace<U>> _V1, _V0;
+
+  // Cells interpolated on
+  std::vector<std::int32_t> _cells1, _cells0;
+
+  // Dense (dim1 x dim0) matrix for each cell, row-major
+  std::vector<T> _A;
+};
 } // namespace dolfinx::fem
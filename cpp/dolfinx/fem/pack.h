@@ -13,13 +13,20 @@
 #include "Function.h"
 #include "FunctionSpace.h"
 #include "traits.h"
+#include <algorithm>
 #include <array>
 #include <basix/mdspan.hpp>
 #include <concepts>
+#include <cstdint>
+#include <dolfinx/common/threads.h>
+#include <dolfinx/la/Vector.h>
 #include <dolfinx/mesh/Topology.h>
+#include <map>
+#include <memory>
 #include <span>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 /// @file pack.h
@@ -50,13 +57,21 @@ get_cell_orientation_info(const Function<T, U>& coefficient)
   return cell_info;
 }
 
-/// Pack a single coefficient for a single cell
-template <int _bs, dolfinx::scalar T>
+/// Pack a single coefficient for a single cell. The number of dofs
+/// per cell is a compile-time constant if `_num_dofs > 0`.
+template <int _bs, int _num_dofs, dolfinx::scalar T>
 void pack_impl(std::span<T> coeffs, std::int32_t cell, int bs,
                std::span<const T> v, std::span<const std::uint32_t> cell_info,
                const DofMap& dofmap, auto transform)
 {
-  std::span<const std::int32_t> dofs = dofmap.cell_dofs(cell);
+  constexpr std::size_t N = _num_dofs > 0 ? _num_dofs : md::dynamic_extent;
+  std::span<const std::int32_t, N> dofs = [&]
+  {
+    if constexpr (_num_dofs > 0)
+      return dofmap.cell_dofs<N>(cell);
+    else
+      return dofmap.cell_dofs(cell);
+  }();
   for (std::size_t i = 0; i < dofs.size(); ++i)
   {
     if constexpr (_bs < 0)
@@ -89,11 +104,13 @@ void pack_impl(std::span<T> coeffs, std::int32_t cell, int bs,
 /// has to be applied on the cell to map it to the reference element.
 /// @param[in] cells Set of active cells.
 /// @param[in] offset The offset for c.
+/// @param[in] num_threads Number of threads to pack with.
 template <dolfinx::scalar T, std::floating_point U>
 void pack_coefficient_entity(std::span<T> c, int cstride,
                              const Function<T, U>& u,
                              std::span<const std::uint32_t> cell_info,
-                             auto cells, std::int32_t offset)
+                             auto cells, std::int32_t offset,
+                             int num_threads = 1)
 {
   static_assert(cells.rank() == 1);
 
@@ -109,51 +126,46 @@ void pack_coefficient_entity(std::span<T> c, int cstride,
   auto transformation
       = element->template dof_transformation_fn<T>(doftransform::transpose);
   const int bs = dofmap.bs();
+  const int num_dofs = dofmap.map().extent(1);
+  auto pack = [&]<int _bs, int _num_dofs>(
+                  std::integral_constant<int, _bs>,
+                  std::integral_constant<int, _num_dofs>)
+  {
+    common::parallel_for(
+        cells.extent(0), num_threads,
+        [&](std::size_t e0, std::size_t e1)
+        {
+          for (std::size_t e = e0; e < e1; ++e)
+          {
+            if (std::int32_t cell = cells(e); cell >= 0)
+            {
+              auto cell_coeff = c.subspan(e * cstride + offset, space_dim);
+              pack_impl<_bs, _num_dofs>(cell_coeff, cell, bs, v, cell_info,
+                                        dofmap, transformation);
+            }
+          }
+        });
+  };
+
+  auto pack_bs = [&](auto _bs)
+  {
+    fem::dispatch_num_dofs(num_dofs,
+                           [&](auto _num_dofs) { pack(_bs, _num_dofs); });
+  };
+
   switch (bs)
   {
   case 1:
-    for (std::size_t e = 0; e < cells.extent(0); ++e)
-    {
-      if (std::int32_t cell = cells(e); cell >= 0)
-      {
-        auto cell_coeff = c.subspan(e * cstride + offset, space_dim);
-        pack_impl<1>(cell_coeff, cell, bs, v, cell_info, dofmap,
-                     transformation);
-      }
-    }
+    pack_bs(std::integral_constant<int, 1>{});
     break;
   case 2:
-    for (std::size_t e = 0; e < cells.extent(0); ++e)
-    {
-      if (std::int32_t cell = cells(e); cell >= 0)
-      {
-        auto cell_coeff = c.subspan(e * cstride + offset, space_dim);
-        pack_impl<2>(cell_coeff, cell, bs, v, cell_info, dofmap,
-                     transformation);
-      }
-    }
+    pack_bs(std::integral_constant<int, 2>{});
     break;
   case 3:
-    for (std::size_t e = 0; e < cells.extent(0); ++e)
-    {
-      if (std::int32_t cell = cells(e); cell >= 0)
-      {
-        auto cell_coeff = c.subspan(e * cstride + offset, space_dim);
-        pack_impl<3>(cell_coeff, cell, bs, v, cell_info, dofmap,
-                     transformation);
-      }
-    }
+    pack_bs(std::integral_constant<int, 3>{});
     break;
   default:
-    for (std::size_t e = 0; e < cells.extent(0); ++e)
-    {
-      if (std::int32_t cell = cells(e); cell >= 0)
-      {
-        auto cell_coeff = c.subspan(e * cstride + offset, space_dim);
-        pack_impl<-1>(cell_coeff, cell, bs, v, cell_info, dofmap,
-                      transformation);
-      }
-    }
+    pack(std::integral_constant<int, -1>{}, std::integral_constant<int, -1>{});
     break;
   }
 }
@@ -210,21 +222,19 @@ allocate_coefficient_storage(const Form<T, U>& form)
   return coeffs;
 }
 
-/// @brief Pack coefficients of a Form.
-///
+namespace impl
+{
+/// @brief Pack coefficients of a Form (see fem::pack_coefficients).
 /// @param[in] form Form to pack the coefficients for.
-/// @param[in,out] coeffs Map from a `(integral_type, domain_id)` pair
-/// to a `(coeffs, cstride)` pair.
-/// - `coeffs` is an array of shape `(num_int_entities, cstride)` into
-/// which coefficient data will be packed.
-/// - `num_int_entities` is the number of entities over which
-/// coefficient data is packed.
-/// - `cstride` is the number of coefficient data entries per entity.
-/// - `coeffs` is flattened using  row-major layout.
+/// @param[in,out] coeffs Packed coefficient data.
+/// @param[in] packed Markers of the coefficients to pack. If empty, all
+/// coefficients are packed.
+/// @param[in] num_threads Number of threads to pack with.
 template <dolfinx::scalar T, std::floating_point U>
 void pack_coefficients(const Form<T, U>& form,
                        std::map<std::pair<IntegralType, int>,
-                                std::pair<std::vector<T>, int>>& coeffs)
+                                std::pair<std::vector<T>, int>>& coeffs,
+                       std::span<const std::int8_t> packed, int num_threads)
 {
   const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
       = form.coefficients();
@@ -244,6 +254,9 @@ void pack_coefficients(const Form<T, U>& form,
         // Iterate over coefficients that are active in cell integrals
         for (int coeff : form.active_coeffs(IntegralType::cell, id))
         {
+          if (!packed.empty() and !packed[coeff])
+            continue;
+
           // Get coefficient mesh
           auto mesh = coefficients[coeff]->function_space()->mesh();
           assert(mesh);
@@ -263,10 +276,10 @@ void pack_coefficients(const Form<T, U>& form,
               = form.domain_coeff(IntegralType::cell, id, coeff);
           md::mdspan cells(cells_b.data(), cells_b.size());
           std::span<const std::uint32_t> cell_info
-              = impl::get_cell_orientation_info(*coefficients[coeff]);
-          impl::pack_coefficient_entity(std::span(c), cstride,
+              = get_cell_orientation_info(*coefficients[coeff]);
+          pack_coefficient_entity(std::span(c), cstride,
                                         *coefficients[coeff], cell_info, cells,
-                                        offsets[coeff]);
+                                        offsets[coeff], num_threads);
         }
         break;
       }
@@ -276,6 +289,9 @@ void pack_coefficients(const Form<T, U>& form,
         // exterior facet integrals
         for (int coeff : form.active_coeffs(IntegralType::exterior_facet, id))
         {
+          if (!packed.empty() and !packed[coeff])
+            continue;
+
           auto mesh = coefficients[coeff]->function_space()->mesh();
           std::span<const std::int32_t> facets_b
               = form.domain_coeff(IntegralType::exterior_facet, id, coeff);
@@ -285,10 +301,10 @@ void pack_coefficients(const Form<T, U>& form,
           auto cells = md::submdspan(facets, md::full_extent, 0);
 
           std::span<const std::uint32_t> cell_info
-              = impl::get_cell_orientation_info(*coefficients[coeff]);
-          impl::pack_coefficient_entity(std::span(c), cstride,
+              = get_cell_orientation_info(*coefficients[coeff]);
+          pack_coefficient_entity(std::span(c), cstride,
                                         *coefficients[coeff], cell_info, cells,
-                                        offsets[coeff]);
+                                        offsets[coeff], num_threads);
         }
         break;
       }
@@ -298,6 +314,9 @@ void pack_coefficients(const Form<T, U>& form,
         // facet integrals
         for (int coeff : form.active_coeffs(IntegralType::interior_facet, id))
         {
+          if (!packed.empty() and !packed[coeff])
+            continue;
+
           auto mesh = coefficients[coeff]->function_space()->mesh();
           std::span<const std::int32_t> facets_b
               = form.domain_coeff(IntegralType::interior_facet, id, coeff);
@@ -306,19 +325,20 @@ void pack_coefficients(const Form<T, U>& form,
               facets(facets_b.data(), facets_b.size() / 4, 4);
 
           std::span<const std::uint32_t> cell_info
-              = impl::get_cell_orientation_info(*coefficients[coeff]);
+              = get_cell_orientation_info(*coefficients[coeff]);
 
           // Pack coefficient ['+']
           auto cells0 = md::submdspan(facets, md::full_extent, 0);
-          impl::pack_coefficient_entity(std::span(c), 2 * cstride,
+          pack_coefficient_entity(std::span(c), 2 * cstride,
                                         *coefficients[coeff], cell_info, cells0,
-                                        2 * offsets[coeff]);
+                                        2 * offsets[coeff], num_threads);
 
           // Pack coefficient ['-']
           auto cells1 = md::submdspan(facets, md::full_extent, 2);
-          impl::pack_coefficient_entity(std::span(c), 2 * cstride,
+          pack_coefficient_entity(std::span(c), 2 * cstride,
                                         *coefficients[coeff], cell_info, cells1,
-                                        offsets[coeff] + offsets[coeff + 1]);
+                                        offsets[coeff] + offsets[coeff + 1],
+                                        num_threads);
         }
         break;
       }
@@ -329,6 +349,100 @@ void pack_coefficients(const Form<T, U>& form,
     }
   }
 }
+} // namespace impl
+
+/// @brief Pack coefficients of a Form.
+///
+/// @param[in] form Form to pack the coefficients for.
+/// @param[in,out] coeffs Map from a `(integral_type, domain_id)` pair
+/// to a `(coeffs, cstride)` pair.
+/// - `coeffs` is an array of shape `(num_int_entities, cstride)` into
+/// which coefficient data will be packed.
+/// - `num_int_entities` is the number of entities over which
+/// coefficient data is packed.
+/// - `cstride` is the number of coefficient data entries per entity.
+/// - `coeffs` is flattened using  row-major layout.
+/// @param[in] num_threads Number of threads to pack with. The entities
+/// of each integral are divided between the threads.
+template <dolfinx::scalar T, std::floating_point U>
+void pack_coefficients(const Form<T, U>& form,
+                       std::map<std::pair<IntegralType, int>,
+                                std::pair<std::vector<T>, int>>& coeffs,
+                       int num_threads = 1)
+{
+  impl::pack_coefficients(form, coeffs, {}, num_threads);
+}
+
+/// @brief Packed coefficients of a Form, with storage that is reused
+/// between packings.
+///
+/// Coefficients are repacked only if the data of their Function
+/// vector has changed since they were last packed, as detected by
+/// la::Vector::state. This avoids packing coefficients that are
+/// constant, e.g. in the iterations of a nonlinear solver.
+///
+/// @note The form must outlive the packer.
+/// @note Modifications of the vector data through a span returned by
+/// an earlier call to la::Vector::mutable_array are not detected, see
+/// la::Vector::state. Use reset() to force repacking in this case.
+///
+/// @tparam T Scalar type.
+/// @tparam U Geometry type.
+template <dolfinx::scalar T, std::floating_point U>
+class CoefficientPacker
+{
+public:
+  /// @brief Create a packer for the coefficients of a form.
+  /// @param[in] form The form.
+  /// @param[in] num_threads Number of threads to pack with.
+  explicit CoefficientPacker(const Form<T, U>& form, int num_threads = 1)
+      : _form(form), _coeffs(allocate_coefficient_storage(form)),
+        _num_threads(num_threads), _vectors(form.coefficients().size())
+  {
+  }
+
+  /// @brief Pack the coefficients whose data has changed.
+  /// @return Map from a `(integral_type, domain_id)` pair to a
+  /// `(coeffs, cstride)` pair, see fem::pack_coefficients.
+  const std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>&
+  pack()
+  {
+    const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
+        = _form.coefficients();
+    std::vector<std::int8_t> packed(coefficients.size(), 0);
+    for (std::size_t i = 0; i < coefficients.size(); ++i)
+    {
+      std::shared_ptr<const la::Vector<T>> x = coefficients[i]->x();
+      auto& [vector, state] = _vectors[i];
+      if (vector.lock() != x or state != x->state())
+      {
+        packed[i] = 1;
+        vector = x;
+        state = x->state();
+      }
+    }
+
+    if (std::ranges::any_of(packed, [](auto p) { return p; }))
+      impl::pack_coefficients(_form, _coeffs, packed, _num_threads);
+
+    return _coeffs;
+  }
+
+  /// @brief Repack all coefficients in the next call to pack().
+  void reset() { std::ranges::fill(_vectors, vector_state_t{}); }
+
+private:
+  // Vector and state of the vector data of each coefficient when last
+  // packed
+  using vector_state_t
+      = std::pair<std::weak_ptr<const la::Vector<T>>, std::uint64_t>;
+
+  const Form<T, U>& _form;
+  std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>
+      _coeffs;
+  int _num_threads;
+  std::vector<vector_state_t> _vectors;
+};
 
 /// @brief Pack coefficient data over a list of cells or facets.
 ///
@@ -416,4 +530,34 @@ std::vector<typename U::scalar_type> pack_constants(const U& u)
   return fem::pack_constants(c);
 }
 
+/// @brief Copy the packed constants of a Form to a container, e.g. in
+/// device memory, if they have changed since the previous copy.
+///
+/// The constants are packed in place by Form::packed_constants, and
+/// are only copied if their state (see Form::packed_constants_state)
+/// differs from `state`. This makes repeated assembly with unchanged
+/// constants free of host-to-device transfers.
+///
+/// @tparam Container Container type, e.g. a device container, that can
+/// be constructed from a pair of host iterators.
+/// @param[in] form The form.
+/// @param[in,out] c Container that mirrors the packed constants.
+/// @param[in,out] state State of the constants in `c`. Pass `0` for the
+/// first call. It is updated to the state of the copied constants.
+/// @return `true` if the constants have been copied.
+template <typename Container, dolfinx::scalar T, std::floating_point U>
+bool mirror_constants(const Form<T, U>& form, Container& c,
+                      std::uint64_t& state)
+{
+  std::span<const T> constants = form.packed_constants();
+  if (std::uint64_t s = form.packed_constants_state(); s != state)
+  {
+    c = Container(constants.begin(), constants.end());
+    state = s;
+    return true;
+  }
+  else
+    return false;
+}
+
 } // namespace dolfinx::fem
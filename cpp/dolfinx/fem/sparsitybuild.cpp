@@ -7,54 +7,149 @@
 #include "sparsitybuild.h"
 #include "DofMap.h"
 #include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/la/SparsityPattern.h>
+#include <numeric>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
 
+namespace
+{
+/// @brief Insert the entries of a list of elements into a sparsity
+/// pattern.
+///
+/// An element is a group of `num_cells` consecutive cells, e.g. a cell
+/// or the two cells of an interior facet, and couples all row dofs of
+/// its cells in `dofmaps[0]` with all column dofs of its cells in
+/// `dofmaps[1]`. The rows are built in compressed form in two passes
+/// over the rows (count, then fill), using the elements of each row.
+/// This bounds the memory to about the size of the compressed rows,
+/// and the passes are executed on `num_threads` threads.
+void insert_elements(
+    la::SparsityPattern& pattern,
+    std::array<std::span<const std::int32_t>, 2> cells,
+    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps,
+    int num_cells, int num_threads)
+{
+  assert(cells[0].size() == cells[1].size());
+  assert(cells[0].size() % num_cells == 0);
+  const std::size_t num_elements = cells[0].size() / num_cells;
+
+  // Call fn(dof) for the dofs of element e in dofmaps[d]
+  auto for_each_dof = [&](int d, std::size_t e, auto&& fn)
+  {
+    for (int j = 0; j < num_cells; ++j)
+    {
+      for (std::int32_t dof :
+           dofmaps[d].get().cell_dofs(cells[d][num_cells * e + j]))
+      {
+        fn(dof);
+      }
+    }
+  };
+
+  auto map0 = pattern.index_map(0);
+  auto map1 = pattern.index_map(1);
+  assert(map0);
+  assert(map1);
+  const std::int32_t num_rows = map0->size_local() + map0->num_ghosts();
+  const std::int32_t num_cols = map1->size_local() + map1->num_ghosts();
+
+  // Build the elements of each row
+  std::vector<std::int64_t> row_offsets(num_rows + 1, 0);
+  for (std::size_t e = 0; e < num_elements; ++e)
+    for_each_dof(0, e, [&](auto row) { ++row_offsets[row + 1]; });
+  std::partial_sum(row_offsets.begin(), row_offsets.end(),
+                   row_offsets.begin());
+  std::vector<std::int32_t> row_elements(row_offsets.back());
+  {
+    std::vector<std::int64_t> pos(row_offsets.begin(),
+                                  std::prev(row_offsets.end()));
+    for (std::size_t e = 0; e < num_elements; ++e)
+      for_each_dof(0, e, [&](auto row) { row_elements[pos[row]++] = e; });
+  }
+
+  std::vector<std::int32_t> rows;
+  for (std::int32_t r = 0; r < num_rows; ++r)
+  {
+    if (row_offsets[r + 1] > row_offsets[r])
+      rows.push_back(r);
+  }
+
+  // Call fn(col) for the unique columns of rows[i], using the marker
+  // array `last` with the last row that a column was found on
+  auto for_each_col = [&](std::size_t i, std::vector<std::int32_t>& last,
+                          auto&& fn)
+  {
+    const std::int32_t r = rows[i];
+    for (std::int64_t k = row_offsets[r]; k < row_offsets[r + 1]; ++k)
+    {
+      for_each_dof(1, row_elements[k],
+                   [&](std::int32_t col)
+                   {
+                     if (last[col] != r)
+                     {
+                       last[col] = r;
+                       fn(col);
+                     }
+                   });
+    }
+  };
+
+  // Count the columns of each row
+  std::vector<std::int64_t> offsets(rows.size() + 1, 0);
+  common::parallel_for(rows.size(), num_threads,
+                       [&](std::size_t i0, std::size_t i1)
+                       {
+                         std::vector<std::int32_t> last(num_cols, -1);
+                         for (std::size_t i = i0; i < i1; ++i)
+                         {
+                           for_each_col(i, last,
+                                        [&](auto) { ++offsets[i + 1]; });
+                         }
+                       });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // Fill and sort the columns of each row
+  std::vector<std::int32_t> cols(offsets.back());
+  common::parallel_for(
+      rows.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        std::vector<std::int32_t> last(num_cols, -1);
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          auto it = std::next(cols.begin(), offsets[i]);
+          for_each_col(i, last, [&it](auto col) { *it++ = col; });
+          std::sort(std::next(cols.begin(), offsets[i]), it);
+        }
+      });
+
+  std::vector<std::int64_t>().swap(row_offsets);
+  std::vector<std::int32_t>().swap(row_elements);
+  pattern.insert_rows(std::move(rows), std::move(cols), std::move(offsets));
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 void sparsitybuild::cells(
     la::SparsityPattern& pattern,
     std::array<std::span<const std::int32_t>, 2> cells,
-    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps)
+    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps,
+    int num_threads)
 {
-  assert(cells[0].size() == cells[1].size());
-  const DofMap& map0 = dofmaps[0].get();
-  const DofMap& map1 = dofmaps[1].get();
-  for (std::size_t i = 0; i < cells[0].size(); ++i)
-    pattern.insert(map0.cell_dofs(cells[0][i]), map1.cell_dofs(cells[1][i]));
+  insert_elements(pattern, cells, dofmaps, 1, num_threads);
 }
 //-----------------------------------------------------------------------------
 void sparsitybuild::interior_facets(
     la::SparsityPattern& pattern,
     std::array<std::span<const std::int32_t>, 2> cells,
-    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps)
+    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps,
+    int num_threads)
 {
-  std::span<const std::int32_t> cells0 = cells[0];
-  std::span<const std::int32_t> cells1 = cells[1];
-  assert(cells0.size() == cells1.size());
-  const DofMap& dofmap0 = dofmaps[0];
-  const DofMap& dofmap1 = dofmaps[1];
-
-  // Iterate over facets
-  std::vector<std::int32_t> macro_dofs0, macro_dofs1;
-  for (std::size_t f = 0; f < cells[0].size(); f += 2)
-  {
-    // Test function dofs (sparsity pattern rows)
-    auto dofs00 = dofmap0.cell_dofs(cells0[f]);
-    auto dofs01 = dofmap0.cell_dofs(cells0[f + 1]);
-    macro_dofs0.resize(dofs00.size() + dofs01.size());
-    std::ranges::copy(dofs00, macro_dofs0.begin());
-    std::ranges::copy(dofs01, std::next(macro_dofs0.begin(), dofs00.size()));
-
-    // Trial function dofs (sparsity pattern columns)
-    auto dofs10 = dofmap1.cell_dofs(cells1[f]);
-    auto dofs11 = dofmap1.cell_dofs(cells1[f + 1]);
-    macro_dofs1.resize(dofs10.size() + dofs11.size());
-    std::ranges::copy(dofs10, macro_dofs1.begin());
-    std::ranges::copy(dofs11, std::next(macro_dofs1.begin(), dofs10.size()));
-
-    pattern.insert(macro_dofs0, macro_dofs1);
-  }
+  insert_elements(pattern, cells, dofmaps, 2, num_threads);
 }
 //-----------------------------------------------------------------------------
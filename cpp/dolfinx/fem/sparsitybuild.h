@@ -34,10 +34,17 @@ namespace sparsitybuild
 /// @param cells Lists of cells to iterate over. `cells[0]` and
 /// `cells[1]` must have the same size.
 /// @param dofmaps Dofmaps to used in building the sparsity pattern.
+/// @param num_threads Number of threads used to build the rows of the
+/// pattern.
+/// @note The rows are built in compressed form (counting the entries
+/// of each row before filling them) and inserted with
+/// la::SparsityPattern::insert_rows, which needs much less memory than
+/// inserting the dense block of each cell.
 /// @note The sparsity pattern is not finalised.
 void cells(la::SparsityPattern& pattern,
            std::array<std::span<const std::int32_t>, 2> cells,
-           std::array<std::reference_wrapper<const DofMap>, 2> dofmaps);
+           std::array<std::reference_wrapper<const DofMap>, 2> dofmaps,
+           int num_threads = 1);
 
 /// @brief Iterate over interior facets and insert entries into sparsity
 /// pattern.
@@ -51,12 +58,15 @@ void cells(la::SparsityPattern& pattern,
 /// list of `(cell0, cell1)` pairs for each interior facet to index into
 /// `dofmap[i]`. `cells[0]` and `cells[1]` must have the same size.
 /// @param[in] dofmaps Dofmaps to use in building the sparsity pattern.
+/// @param[in] num_threads Number of threads used to build the rows of
+/// the pattern.
 ///
 /// @note The sparsity pattern is not finalised.
 void interior_facets(
     la::SparsityPattern& pattern,
     std::array<std::span<const std::int32_t>, 2> cells,
-    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps);
+    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps,
+    int num_threads = 1);
 
 } // namespace sparsitybuild
 } // namespace dolfinx::fem
@@ -17,6 +17,7 @@
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
@@ -32,7 +33,8 @@ fem::DofMap fem::create_dofmap(
     MPI_Comm comm, const ElementDofLayout& layout, mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn)
+        reorder_fn,
+    int num_threads)
 {
   // Create required mesh entities
   const int D = topology.dim();
@@ -43,7 +45,7 @@ fem::DofMap fem::create_dofmap(
   }
 
   auto [_index_map, bs, dofmaps]
-      = build_dofmap_data(comm, topology, {layout}, reorder_fn);
+      = build_dofmap_data(comm, topology, {layout}, reorder_fn, num_threads);
   auto index_map = std::make_shared<common::IndexMap>(std::move(_index_map));
 
   // If the element's DOF transformations are permutations, permute the
@@ -55,11 +57,17 @@ fem::DofMap fem::create_dofmap(
     const std::vector<std::uint32_t>& cell_info
         = topology.get_cell_permutation_info();
     int dim = layout.num_dofs();
-    for (std::int32_t cell = 0; cell < num_cells; ++cell)
-    {
-      std::span<std::int32_t> dofs(dofmaps.front().data() + cell * dim, dim);
-      permute_inv(dofs, cell_info[cell]);
-    }
+    common::parallel_for(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
+        {
+          for (std::size_t cell = c0; cell < c1; ++cell)
+          {
+            std::span<std::int32_t> dofs(dofmaps.front().data() + cell * dim,
+                                         dim);
+            permute_inv(dofs, cell_info[cell]);
+          }
+        });
   }
 
   return DofMap(layout, index_map, bs, std::move(dofmaps.front()), bs);
@@ -70,7 +78,8 @@ std::vector<fem::DofMap> fem::create_dofmaps(
     mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn)
+        reorder_fn,
+    int num_threads)
 {
   std::int32_t D = topology.dim();
   assert(layouts.size() == topology.entity_types(D).size());
@@ -83,7 +92,7 @@ std::vector<fem::DofMap> fem::create_dofmaps(
   }
 
   auto [_index_map, bs, dofmaps]
-      = build_dofmap_data(comm, topology, layouts, reorder_fn);
+      = build_dofmap_data(comm, topology, layouts, reorder_fn, num_threads);
   auto index_map = std::make_shared<common::IndexMap>(std::move(_index_map));
 
   // If the element's DOF transformations are permutations, permute the
@@ -100,11 +109,17 @@ std::vector<fem::DofMap> fem::create_dofmaps(
     const std::vector<std::uint32_t>& cell_info
         = topology.get_cell_permutation_info();
     std::int32_t dim = layouts.front().num_dofs();
-    for (std::int32_t cell = 0; cell < num_cells; ++cell)
-    {
-      std::span<std::int32_t> dofs(dofmaps.front().data() + cell * dim, dim);
-      permute_inv(dofs, cell_info[cell]);
-    }
+    common::parallel_for(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
+        {
+          for (std::size_t cell = c0; cell < c1; ++cell)
+          {
+            std::span<std::int32_t> dofs(dofmaps.front().data() + cell * dim,
+                                         dim);
+            permute_inv(dofs, cell_info[cell]);
+          }
+        });
   }
 
   std::vector<DofMap> dms;
@@ -134,7 +149,11 @@ fem::compute_integration_domains(fem::IntegralType integral_type,
                                  std::span<const std::int32_t> entities)
 {
   const int tdim = topology.dim();
-  const int dim = integral_type == IntegralType::cell ? tdim : tdim - 1;
+  int dim = tdim - 1;
+  if (integral_type == IntegralType::cell)
+    dim = tdim;
+  else if (integral_type == IntegralType::vertex)
+    dim = 0;
 
   {
     // Create span of the owned entities (leaves off any ghosts)
@@ -152,6 +171,36 @@ fem::compute_integration_domains(fem::IntegralType integral_type,
     entity_data.insert(entity_data.begin(), entities.begin(), entities.end());
     break;
   }
+  case IntegralType::vertex:
+  {
+    auto v_to_c = topology.connectivity(0, tdim);
+    if (!v_to_c)
+    {
+      throw std::runtime_error(
+          "Topology vertex-to-cell connectivity has not been computed.");
+    }
+
+    auto c_to_v = topology.connectivity(tdim, 0);
+    assert(c_to_v);
+    const std::int32_t num_cells = topology.index_map(tdim)->size_local();
+    for (auto v : entities)
+    {
+      // Get the vertex as a (cell, local vertex) pair, preferring an
+      // owned cell
+      auto cells = v_to_c->links(v);
+      assert(!cells.empty());
+      auto c_it = std::ranges::find_if(cells, [num_cells](auto c)
+                                       { return c < num_cells; });
+      std::int32_t c = c_it != cells.end() ? *c_it : cells.front();
+      auto vertices = c_to_v->links(c);
+      auto it = std::ranges::find(vertices, v);
+      assert(it != vertices.end());
+      entity_data.insert(
+          entity_data.end(),
+          {c, static_cast<std::int32_t>(std::distance(vertices.begin(), it))});
+    }
+    break;
+  }
   default:
   {
     auto f_to_c = topology.connectivity(tdim - 1, tdim);
@@ -173,7 +222,7 @@ fem::compute_integration_domains(fem::IntegralType integral_type,
     case IntegralType::exterior_facet:
     {
       // Create list of tagged boundary facets
-      const std::vector bfacets = mesh::exterior_facet_indices(topology);
+      std::span bfacets = topology.exterior_facets();
       std::vector<std::int32_t> facets;
       std::ranges::set_intersection(entities, bfacets,
                                     std::back_inserter(facets));
@@ -95,7 +95,9 @@ get_cell_facet_pairs(std::int32_t f, std::span<const std::int32_t> cells,
 /// cell indices. For exterior facet integrals, a list of `(cell_index,
 /// local_facet_index)` pairs is returned. For interior facet integrals,
 /// a list of `(cell_index0, local_facet_index0, cell_index1,
-/// local_facet_index1)` tuples is returned.
+/// local_facet_index1)` tuples is returned. For vertex integrals, a list
+/// of `(cell_index, local_vertex_index)` pairs is returned, with one
+/// (preferably owned) cell attached to each vertex.
 /// The data computed by this function is typically used as input to
 /// fem::create_form.
 ///
@@ -104,14 +106,16 @@ get_cell_facet_pairs(std::int32_t f, std::span<const std::int32_t> cells,
 ///
 /// @pre For facet integrals, the topology facet-to-cell and
 /// cell-to-facet connectivity must be computed before calling this
-/// function.
+/// function. For vertex integrals, the vertex-to-cell connectivity
+/// must be computed.
 ///
 /// @param[in] integral_type Integral type.
 /// @param[in] topology Mesh topology.
 /// @param[in] entities List of mesh entities. For
 /// `integral_type==IntegralType::cell`, `entities` should be cell
-/// indices. For other `IntegralType`, `entities` should be facet
-/// indices.
+/// indices. For `integral_type==IntegralType::vertex`, `entities`
+/// should be vertex indices. For other `IntegralType`, `entities`
+/// should be facet indices.
 /// @return List of integration entity data.
 std::vector<std::int32_t>
 compute_integration_domains(IntegralType integral_type,
@@ -150,9 +154,11 @@ extract_function_spaces(const std::vector<std::vector<const Form<T, U>*>>& a)
 /// @note The pattern is not finalised, i.e. the caller is responsible
 /// for calling SparsityPattern::assemble.
 /// @param[in] a A bilinear form
+/// @param[in] num_threads Number of threads used to build the pattern.
 /// @return The corresponding sparsity pattern
 template <dolfinx::scalar T, std::floating_point U>
-la::SparsityPattern create_sparsity_pattern(const Form<T, U>& a)
+la::SparsityPattern create_sparsity_pattern(const Form<T, U>& a,
+                                            int num_threads = 1)
 {
   std::shared_ptr mesh = a.mesh();
   assert(mesh);
@@ -170,7 +176,7 @@ la::SparsityPattern create_sparsity_pattern(const Form<T, U>& a)
       = {dofmaps[0].get().index_map_bs(), dofmaps[1].get().index_map_bs()};
 
   la::SparsityPattern pattern(mesh->comm(), index_maps, bs);
-  build_sparsity_pattern(pattern, a);
+  build_sparsity_pattern(pattern, a, num_threads);
   return pattern;
 }
 
@@ -179,8 +185,10 @@ la::SparsityPattern create_sparsity_pattern(const Form<T, U>& a)
 /// for calling SparsityPattern::assemble.
 /// @param[in] pattern The sparsity pattern to add to
 /// @param[in] a A bilinear form
+/// @param[in] num_threads Number of threads used to build the pattern.
 template <dolfinx::scalar T, std::floating_point U>
-void build_sparsity_pattern(la::SparsityPattern& pattern, const Form<T, U>& a)
+void build_sparsity_pattern(la::SparsityPattern& pattern, const Form<T, U>& a,
+                            int num_threads = 1)
 {
   if (a.rank() != 2)
   {
@@ -236,7 +244,7 @@ void build_sparsity_pattern(la::SparsityPattern& pattern, const Form<T, U>& a)
           sparsitybuild::cells(pattern,
                                {a.domain_arg(type, 0, id, cell_type_idx),
                                 a.domain_arg(type, 1, id, cell_type_idx)},
-                               {{dofmaps[0], dofmaps[1]}});
+                               {{dofmaps[0], dofmaps[1]}}, num_threads);
         }
         break;
       case IntegralType::interior_facet:
@@ -246,7 +254,7 @@ void build_sparsity_pattern(la::SparsityPattern& pattern, const Form<T, U>& a)
               pattern,
               {extract_cells(a.domain_arg(type, 0, id, 0)),
                extract_cells(a.domain_arg(type, 1, id, 0))},
-              {{dofmaps[0], dofmaps[1]}});
+              {{dofmaps[0], dofmaps[1]}}, num_threads);
         }
         break;
       case IntegralType::exterior_facet:
@@ -255,7 +263,7 @@ void build_sparsity_pattern(la::SparsityPattern& pattern, const Form<T, U>& a)
           sparsitybuild::cells(pattern,
                                {extract_cells(a.domain_arg(type, 0, id, 0)),
                                 extract_cells(a.domain_arg(type, 1, id, 0))},
-                               {{dofmaps[0], dofmaps[1]}});
+                               {{dofmaps[0], dofmaps[1]}}, num_threads);
         }
         break;
       default:
@@ -308,13 +316,22 @@ ElementDofLayout create_element_dof_layout(const fem::FiniteElement<T>& element,
 /// @param[in] topology Mesh topology
 /// @param[in] permute_inv Function to un-permute dofs. `nullptr`
 /// when transformation is not required.
-/// @param[in] reorder_fn Graph reordering function called on the dofmap
+/// @param[in] reorder_fn Graph reordering function called on the
+/// graph of the owned dofs (nodes), e.g. graph::reorder_gps or
+/// graph::reorder_rcm. Entry `i` of the returned list is the new index
+/// of node `i`. The components of a blocked (vector) dof are numbered
+/// contiguously, so the ordering applies to blocks. If `nullptr`, the
+/// owned dofs are numbered in the order they are first visited when
+/// iterating over the cells, i.e. they follow the cell ordering (e.g.
+/// a space-filling curve ordering, see mesh::create_mesh).
+/// @param[in] num_threads Number of threads used to build the dofmap.
 /// @return A new dof map
 DofMap create_dofmap(
     MPI_Comm comm, const ElementDofLayout& layout, mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn);
+        reorder_fn,
+    int num_threads = 1);
 
 /// @brief Create a set of dofmaps on a given topology
 /// @param[in] comm MPI communicator
@@ -322,7 +339,9 @@ DofMap create_dofmap(
 /// @param[in] topology Mesh topology
 /// @param[in] permute_inv Function to un-permute dofs. `nullptr`
 /// when transformation is not required.
-/// @param[in] reorder_fn Graph reordering function called on the dofmaps
+/// @param[in] reorder_fn Graph reordering function called on the
+/// graph of the owned dofs (nodes). See create_dofmap.
+/// @param[in] num_threads Number of threads used to build the dofmaps.
 /// @return The list of new dof maps
 /// @note The number of layouts must match the number of cell types in the
 /// topology
@@ -331,7 +350,8 @@ std::vector<DofMap> create_dofmaps(
     mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn);
+        reorder_fn,
+    int num_threads = 1);
 
 /// Get the name of each coefficient in a UFC form
 /// @param[in] ufcx_form The UFC form
@@ -626,7 +646,7 @@ Form<T, U> create_form_factory(
         assert(k);
 
         // Build list of entities to assembler over
-        const std::vector bfacets = mesh::exterior_facet_indices(*topology);
+        std::span bfacets = topology->exterior_facets();
         auto f_to_c = topology->connectivity(tdim - 1, tdim);
         assert(f_to_c);
         auto c_to_f = topology->connectivity(tdim, tdim - 1);
@@ -885,13 +905,20 @@ Form<T, U> create_form(
 }
 
 /// @brief NEW Create a function space from a fem::FiniteElement.
+/// @param[in] mesh Mesh that the space is defined on.
+/// @param[in] e Finite element.
+/// @param[in] reorder_fn Graph reordering function for the dofs. See
+/// create_dofmap.
+/// @param[in] num_threads Number of threads used to build the dofmap.
+/// @return A function space.
 template <std::floating_point T>
 FunctionSpace<T> create_functionspace(
     std::shared_ptr<mesh::Mesh<T>> mesh,
     std::shared_ptr<const fem::FiniteElement<T>> e,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
         reorder_fn
-    = nullptr)
+    = nullptr,
+    int num_threads = 1)
 {
   // TODO: check cell type of e (need to add method to fem::FiniteElement)
   assert(e);
@@ -907,8 +934,9 @@ FunctionSpace<T> create_functionspace(
   std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv
       = e->needs_dof_permutations() ? e->dof_permutation_fn(true, true)
                                     : nullptr;
-  auto dofmap = std::make_shared<const DofMap>(create_dofmap(
-      mesh->comm(), layout, *mesh->topology(), permute_inv, reorder_fn));
+  auto dofmap = std::make_shared<const DofMap>(
+      create_dofmap(mesh->comm(), layout, *mesh->topology(), permute_inv,
+                    reorder_fn, num_threads));
 
   return FunctionSpace(mesh, e, dofmap);
 }
@@ -0,0 +1,256 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/math.h>
+#include <dolfinx/common/threads.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::geometry
+{
+/// @brief Precomputed affine maps of the cells of a mesh of affine
+/// simplices, for fast point-in-cell tests.
+///
+/// For each cell the first vertex `x0`, the Jacobian `J` and its
+/// (pseudo-)inverse `K` are stored, with the Jacobian of shape `(3,
+/// tdim)` so that points off the plane of a cell have a well-defined
+/// distance. The test of a point computes its barycentric coordinates
+/// and, from the heights of the cell, a lower bound of its distance to
+/// the cell. This decides collisions exactly, except for points that
+/// are outside the cell but closer than the tolerance to it, for which
+/// the test is inconclusive and GJK (geometry::compute_distance_gjk)
+/// should be used.
+///
+/// @tparam T Mesh geometry floating type.
+template <std::floating_point T>
+class AffineSimplexCache
+{
+public:
+  /// @brief Create the cache for all cells (including ghosts) of a
+  /// mesh.
+  /// @param[in] mesh The mesh. Its coordinate element must be affine and
+  /// its cells simplices, see supported().
+  /// @param[in] num_threads Number of threads.
+  explicit AffineSimplexCache(const mesh::Mesh<T>& mesh, int num_threads = 1)
+      : _tdim(mesh.topology()->dim())
+  {
+    if (!supported(mesh))
+    {
+      throw std::runtime_error(
+          "AffineSimplexCache requires a mesh of affine simplices.");
+    }
+
+    compute(mesh, mesh.geometry().dofmap().extent(0),
+            [](std::size_t c) { return c; }, num_threads);
+  }
+
+  /// @brief Create the cache for a subset of the cells of a mesh, e.g.
+  /// the candidate cells of a collision search.
+  ///
+  /// The cache then stores only the data of these cells, and
+  /// collides() looks up the position of a cell by a binary search.
+  ///
+  /// @param[in] mesh The mesh. Its coordinate element must be affine and
+  /// its cells simplices, see supported().
+  /// @param[in] cells Local indices of the cells (may contain
+  /// duplicates).
+  /// @param[in] num_threads Number of threads.
+  AffineSimplexCache(const mesh::Mesh<T>& mesh,
+                     std::span<const std::int32_t> cells, int num_threads = 1)
+      : _tdim(mesh.topology()->dim()), _cells(cells.begin(), cells.end()),
+        _subset(true)
+  {
+    if (!supported(mesh))
+    {
+      throw std::runtime_error(
+          "AffineSimplexCache requires a mesh of affine simplices.");
+    }
+
+    std::ranges::sort(_cells);
+    auto [unique_end, range_end] = std::ranges::unique(_cells);
+    _cells.erase(unique_end, range_end);
+    compute(mesh, _cells.size(), [this](std::size_t i)
+            { return static_cast<std::size_t>(_cells[i]); }, num_threads);
+  }
+
+  /// @brief Check if a mesh is supported, i.e. if its cells are affine
+  /// simplices.
+  /// @param[in] mesh The mesh.
+  /// @return True if an AffineSimplexCache can be created for `mesh`.
+  static bool supported(const mesh::Mesh<T>& mesh)
+  {
+    return mesh.geometry().cmap().is_affine()
+           and mesh::is_simplex(mesh.topology()->cell_type());
+  }
+
+  /// @brief Test if a point collides with a cell.
+  ///
+  /// @param[in] cell Local cell index. If the cache was created for a
+  /// subset of the cells, the cell must be in the subset.
+  /// @param[in] p The point.
+  /// @param[in] tol Tolerance for accepting a collision, in the squared
+  /// distance between the point and the cell.
+  /// @return 1 if the point collides with the cell, 0 if it does not,
+  /// and -1 if the test is inconclusive, i.e. the point is outside the
+  /// cell but a lower bound of its squared distance to the cell is
+  /// smaller than `tol`.
+  int collides(std::int32_t cell, std::span<const T, 3> p, T tol) const
+  {
+    const std::size_t tdim = _tdim;
+    std::size_t pos = cell;
+    if (_subset)
+    {
+      auto it = std::ranges::lower_bound(_cells, cell);
+      assert(it != _cells.end() and *it == cell);
+      pos = std::distance(_cells.begin(), it);
+    }
+    const T* data = _data.data() + pos * stride();
+    const T* J = data + 3;
+    const T* K = data + 3 + 3 * tdim;
+    const T* h = data + 3 + 6 * tdim;
+
+    // Reference coordinates X = K (p - x0)
+    const std::array<T, 3> dx = {p[0] - data[0], p[1] - data[1],
+                                 p[2] - data[2]};
+    std::array<T, 3> X = {0, 0, 0};
+    for (std::size_t j = 0; j < tdim; ++j)
+      for (std::size_t i = 0; i < 3; ++i)
+        X[j] += K[3 * j + i] * dx[i];
+
+    // Signed distance outside the half-spaces bounded by the facets,
+    // from the barycentric coordinates
+    T s = -(1 - X[0] - X[1] - X[2]) * h[0];
+    for (std::size_t j = 0; j < tdim; ++j)
+      s = std::max(s, -X[j] * h[j + 1]);
+
+    // Squared distance to the plane (line) of the cell
+    T r2 = 0;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      T r = dx[i];
+      for (std::size_t j = 0; j < tdim; ++j)
+        r -= J[tdim * i + j] * X[j];
+      r2 += r * r;
+    }
+
+    if (s <= 0)
+      return r2 < tol ? 1 : 0;
+    else if (s * s + r2 >= tol)
+      return 0;
+    else
+      return -1;
+  }
+
+  /// Topological dimension of the cells
+  int tdim() const { return _tdim; }
+
+private:
+  // Number of values stored per cell: x0, J, K and the heights
+  std::size_t stride() const { return 3 + 6 * _tdim + _tdim + 1; }
+
+  // Compute the data of the cells cell(0), ..., cell(num_cells - 1)
+  template <typename F>
+  void compute(const mesh::Mesh<T>& mesh, std::size_t num_cells, F cell,
+               int num_threads)
+  {
+    const std::size_t tdim = _tdim;
+    auto x_dofmap = mesh.geometry().dofmap();
+    std::span<const T> x = mesh.geometry().x();
+    const std::size_t stride = this->stride();
+    _data.resize(num_cells * stride);
+    common::parallel_for(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
+        {
+          // The Jacobians and their inverses are computed for batches
+          // of W cells, in structure-of-arrays layout
+          constexpr std::size_t W = 8;
+          std::array<T, 9 * W> J_b, K_b;
+          md::mdspan<T, md::dextents<std::size_t, 3>> J(J_b.data(), 3, tdim,
+                                                        W);
+          md::mdspan<T, md::dextents<std::size_t, 3>> K(K_b.data(), tdim, 3,
+                                                        W);
+          for (std::size_t cb = c0; cb < c1; cb += W)
+          {
+            // Unused lanes of the last batch repeat its first cell
+            const std::size_t num_lanes = std::min(W, c1 - cb);
+            for (std::size_t w = 0; w < W; ++w)
+            {
+              // The first tdim + 1 nodes of an affine simplex are its
+              // vertices
+              const std::size_t c = cell(cb + (w < num_lanes ? w : 0));
+              const std::int32_t v0 = x_dofmap(c, 0);
+              for (std::size_t j = 0; j < tdim; ++j)
+              {
+                const std::int32_t v = x_dofmap(c, j + 1);
+                for (std::size_t i = 0; i < 3; ++i)
+                  J(i, j, w) = x[3 * v + i] - x[3 * v0 + i];
+              }
+            }
+            if (tdim == 3)
+              math::inv_batch(J, K);
+            else
+              math::pinv_batch(J, K);
+
+            for (std::size_t w = 0; w < num_lanes; ++w)
+            {
+              std::span<T> data(_data.data() + (cb + w) * stride, stride);
+              const std::int32_t v0 = x_dofmap(cell(cb + w), 0);
+              std::copy_n(std::next(x.begin(), 3 * v0), 3, data.begin());
+              for (std::size_t i = 0; i < 3; ++i)
+              {
+                for (std::size_t j = 0; j < tdim; ++j)
+                {
+                  data[3 + i * tdim + j] = J(i, j, w);
+                  data[3 + 3 * tdim + j * 3 + i] = K(j, i, w);
+                }
+              }
+
+              // Height of the cell over each facet, i.e. the inverse of
+              // the norm of the gradient of the barycentric coordinate
+              // of the opposite vertex. The gradient of coordinate j + 1
+              // is row j of K.
+              std::array<T, 3> g0 = {0, 0, 0};
+              for (std::size_t j = 0; j < tdim; ++j)
+              {
+                T g2 = 0;
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                  g0[i] -= K(j, i, w);
+                  g2 += K(j, i, w) * K(j, i, w);
+                }
+                data[3 + 6 * tdim + j + 1] = 1 / std::sqrt(g2);
+              }
+              data[3 + 6 * tdim] = 1
+                                   / std::sqrt(g0[0] * g0[0] + g0[1] * g0[1]
+                                               + g0[2] * g0[2]);
+            }
+          }
+        });
+  }
+
+  // Topological dimension of the cells
+  int _tdim;
+
+  // Cells of the cache, if created for a subset of the cells (sorted)
+  std::vector<std::int32_t> _cells;
+  bool _subset = false;
+
+  // Cell data (shape=(num_cells, stride))
+  std::vector<T> _data;
+};
+} // namespace dolfinx::geometry
@@ -11,7 +11,9 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/mesh/utils.h>
+#include <limits>
 #include <mpi.h>
 #include <optional>
 #include <span>
@@ -23,40 +25,94 @@ namespace dolfinx::geometry
 namespace impl_bb
 {
 //-----------------------------------------------------------------------------
-// Compute bounding box of mesh entity. The bounding box is defined by (lower
-// left corner, top right corner). Storage flattened row-major
+// Compute the bounding box of the Bernstein control points of a cell,
+// from its node indices `v` and the matrix `M` from the nodes to the
+// control points (see fem::CoordinateElement::bernstein_matrix)
 template <std::floating_point T>
-std::array<T, 6> compute_bbox_of_entity(const mesh::Mesh<T>& mesh, int dim,
-                                        std::int32_t index)
+std::array<T, 6> compute_bernstein_bbox(std::span<const T> xg,
+                                        std::span<const std::int32_t> v,
+                                        std::span<const T> M)
 {
-  // Get the geometrical indices for the mesh entity
-  std::span<const T> xg = mesh.geometry().x();
-
-  // FIXME: return of small dynamic array is expensive
-  std::span<const std::int32_t> entity(&index, 1);
-  const std::vector<std::int32_t> vertex_indices
-      = mesh::entities_to_geometry(mesh, dim, entity, false).first;
-
+  const std::size_t n = v.size();
   std::array<T, 6> b;
-  std::span<T, 3> b0(b.data(), 3);
-  std::span<T, 3> b1(b.data() + 3, 3);
-
-  std::copy_n(std::next(xg.begin(), 3 * vertex_indices.front()), 3, b0.begin());
-  std::copy_n(std::next(xg.begin(), 3 * vertex_indices.front()), 3, b1.begin());
-
-  // Compute min and max over vertices
-  for (std::int32_t local_vertex : vertex_indices)
+  std::fill_n(b.begin(), 3, std::numeric_limits<T>::max());
+  std::fill_n(std::next(b.begin(), 3), 3, std::numeric_limits<T>::lowest());
+  for (std::size_t i = 0; i < n; ++i)
   {
+    std::array<T, 3> c = {0, 0, 0};
+    for (std::size_t k = 0; k < n; ++k)
+      for (std::size_t j = 0; j < 3; ++j)
+        c[j] += M[i * n + k] * xg[3 * v[k] + j];
     for (std::size_t j = 0; j < 3; ++j)
     {
-      b0[j] = std::min(b0[j], xg[3 * local_vertex + j]);
-      b1[j] = std::max(b1[j], xg[3 * local_vertex + j]);
+      b[j] = std::min(b[j], c[j]);
+      b[j + 3] = std::max(b[j + 3], c[j]);
     }
   }
 
   return b;
 }
 //-----------------------------------------------------------------------------
+// Compute the bounding boxes of mesh entities, each padded by `padding`,
+// paired with the entity index. The boxes of curved cells are computed
+// from their Bernstein control points, and enclose the cells.
+template <std::floating_point T>
+std::vector<std::pair<std::array<T, 6>, std::int32_t>>
+compute_leaf_bboxes(const mesh::Mesh<T>& mesh, int dim,
+                    std::span<const std::int32_t> entities, double padding,
+                    int num_threads)
+{
+  std::span<const T> xg = mesh.geometry().x();
+  std::vector<T> M;
+  if (dim == mesh.topology()->dim() and mesh.geometry().cmaps().size() == 1
+      and mesh.geometry().cmap().degree() > 1)
+  {
+    M = mesh.geometry().cmap().bernstein_matrix();
+  }
+
+  std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes(
+      entities.size());
+  common::parallel_for(
+      entities.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        auto [vertex_indices, shape] = mesh::entities_to_geometry(
+            mesh, dim, entities.subspan(i0, i1 - i0), false);
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          std::span<const std::int32_t> v(
+              vertex_indices.data() + (i - i0) * shape[1], shape[1]);
+          std::array<T, 6> b;
+          if (!M.empty())
+            b = compute_bernstein_bbox<T>(xg, v, M);
+          else
+          {
+            std::copy_n(std::next(xg.begin(), 3 * v.front()), 3, b.begin());
+            std::copy_n(std::next(xg.begin(), 3 * v.front()), 3,
+                        std::next(b.begin(), 3));
+            for (std::int32_t local_vertex : v)
+            {
+              for (std::size_t j = 0; j < 3; ++j)
+              {
+                b[j] = std::min(b[j], xg[3 * local_vertex + j]);
+                b[j + 3] = std::max(b[j + 3], xg[3 * local_vertex + j]);
+              }
+            }
+          }
+
+          for (std::size_t j = 0; j < 3; ++j)
+          {
+            b[j] = b[j] - padding;
+            b[j + 3] = b[j + 3] + padding;
+          }
+
+          leaf_bboxes[i] = {b, entities[i]};
+        }
+      });
+
+  return leaf_bboxes;
+}
+//-----------------------------------------------------------------------------
 // Compute bounding box of bounding boxes. Each bounding box is defined as a
 // tuple (corners, entity_index). The corners of the bounding box is flattened
 // row-major as (lower left corner, top right corner).
@@ -78,6 +134,36 @@ std::array<T, 6> compute_bbox_of_bboxes(
   return b;
 }
 //------------------------------------------------------------------------------
+// Partition leaf bounding boxes at the median of their midpoints along
+// the longest axis of their common bounding box. Returns the common
+// bounding box and the size of the first part.
+template <std::floating_point T>
+std::pair<std::array<T, 6>, std::size_t> split_leaf_bboxes(
+    std::span<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes)
+{
+  // Compute bounding box of all bounding boxes
+  std::array b = compute_bbox_of_bboxes<T>(leaf_bboxes);
+
+  // Sort bounding boxes along longest axis
+  std::array<T, 3> b_diff;
+  std::transform(std::next(b.cbegin(), 3), b.cend(), b.cbegin(),
+                 b_diff.begin(), std::minus<T>());
+  const std::size_t axis = std::distance(
+      b_diff.begin(), std::max_element(b_diff.begin(), b_diff.end()));
+
+  auto middle = std::next(leaf_bboxes.begin(), leaf_bboxes.size() / 2);
+  std::nth_element(leaf_bboxes.begin(), middle, leaf_bboxes.end(),
+                   [axis](auto& p0, auto& p1) -> bool
+                   {
+                     auto x0 = p0.first[axis] + p0.first[3 + axis];
+                     auto x1 = p1.first[axis] + p1.first[3 + axis];
+                     return x0 < x1;
+                   });
+
+  assert(!leaf_bboxes.empty());
+  return {b, leaf_bboxes.size() / 2};
+}
+//-----------------------------------------------------------------------------
 template <std::floating_point T>
 std::int32_t _build_from_leaf(
     std::span<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes,
@@ -98,28 +184,8 @@ std::int32_t _build_from_leaf(
   }
   else
   {
-    // Compute bounding box of all bounding boxes
-    std::array b = compute_bbox_of_bboxes<T>(leaf_bboxes);
-
-    // Sort bounding boxes along longest axis
-    std::array<T, 3> b_diff;
-    std::transform(std::next(b.cbegin(), 3), b.cend(), b.cbegin(),
-                   b_diff.begin(), std::minus<T>());
-    const std::size_t axis = std::distance(
-        b_diff.begin(), std::max_element(b_diff.begin(), b_diff.end()));
-
-    auto middle = std::next(leaf_bboxes.begin(), leaf_bboxes.size() / 2);
-    std::nth_element(leaf_bboxes.begin(), middle, leaf_bboxes.end(),
-                     [axis](auto& p0, auto& p1) -> bool
-                     {
-                       auto x0 = p0.first[axis] + p0.first[3 + axis];
-                       auto x1 = p1.first[axis] + p1.first[3 + axis];
-                       return x0 < x1;
-                     });
-
     // Split bounding boxes into two groups and call recursively
-    assert(!leaf_bboxes.empty());
-    std::size_t part = leaf_bboxes.size() / 2;
+    auto [b, part] = split_leaf_bboxes(leaf_bboxes);
     std::int32_t bbox0
         = _build_from_leaf(leaf_bboxes.first(part), bboxes, bbox_coordinates);
     std::int32_t bbox1 = _build_from_leaf(
@@ -133,13 +199,102 @@ std::int32_t _build_from_leaf(
   }
 }
 //-----------------------------------------------------------------------------
+// Build a tree from leaf bounding boxes. With more than one thread, the
+// top levels of the tree are split serially and the subtrees below
+// are built concurrently. The nodes are then merged in the order of
+// the serial build, so the tree does not depend on the number of
+// threads.
 template <std::floating_point T>
 std::pair<std::vector<std::int32_t>, std::vector<T>> build_from_leaf(
-    std::vector<std::pair<std::array<T, 6>, std::int32_t>>& leaf_bboxes)
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>>& leaf_bboxes,
+    int num_threads = 1)
 {
   std::vector<std::int32_t> bboxes;
   std::vector<T> bbox_coordinates;
-  impl_bb::_build_from_leaf<T>(leaf_bboxes, bboxes, bbox_coordinates);
+  if (num_threads <= 1)
+  {
+    impl_bb::_build_from_leaf<T>(leaf_bboxes, bboxes, bbox_coordinates);
+    return {std::move(bboxes), std::move(bbox_coordinates)};
+  }
+
+  // Split the top levels, recording the nodes in post-order: a
+  // non-negative value is a subtree and a negative value -(i + 1) is
+  // the node with bounding box split_bboxes[i]
+  int depth = 0;
+  while ((1 << depth) < num_threads)
+    ++depth;
+  std::vector<std::span<std::pair<std::array<T, 6>, std::int32_t>>> subtrees;
+  std::vector<std::array<T, 6>> split_bboxes;
+  std::vector<std::int32_t> nodes;
+  auto split = [&](auto&& split, auto leaves, int d) -> void
+  {
+    if (d == 0 or leaves.size() == 1)
+    {
+      nodes.push_back(subtrees.size());
+      subtrees.push_back(leaves);
+    }
+    else
+    {
+      auto [b, part] = split_leaf_bboxes(leaves);
+      split(split, leaves.first(part), d - 1);
+      split(split, leaves.last(leaves.size() - part), d - 1);
+      nodes.push_back(-(split_bboxes.size() + 1));
+      split_bboxes.push_back(b);
+    }
+  };
+  split(split, std::span(leaf_bboxes), depth);
+
+  // Build subtrees
+  const int num_subtrees = subtrees.size();
+  std::vector<std::vector<std::int32_t>> sub_bboxes(num_subtrees);
+  std::vector<std::vector<T>> sub_coordinates(num_subtrees);
+  const int nt = std::min(num_threads, num_subtrees);
+  common::run_threads(
+      nt,
+      [&](int t)
+      {
+        auto [i0, i1] = common::thread_range(t, num_subtrees, nt);
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          impl_bb::_build_from_leaf<T>(subtrees[i], sub_bboxes[i],
+                                       sub_coordinates[i]);
+        }
+      });
+
+  // Merge, offsetting the child nodes of the subtrees
+  std::vector<std::int32_t> roots;
+  for (std::int32_t node : nodes)
+  {
+    if (node >= 0)
+    {
+      const std::int32_t offset = bboxes.size() / 2;
+      const std::vector<std::int32_t>& sub = sub_bboxes[node];
+      for (std::size_t i = 0; i < sub.size(); i += 2)
+      {
+        // Leaf nodes hold entity indices
+        const std::int32_t shift = sub[i] == sub[i + 1] ? 0 : offset;
+        bboxes.push_back(sub[i] + shift);
+        bboxes.push_back(sub[i + 1] + shift);
+      }
+      bbox_coordinates.insert(bbox_coordinates.end(),
+                              sub_coordinates[node].begin(),
+                              sub_coordinates[node].end());
+    }
+    else
+    {
+      std::int32_t bbox1 = roots.back();
+      roots.pop_back();
+      std::int32_t bbox0 = roots.back();
+      roots.pop_back();
+      bboxes.push_back(bbox0);
+      bboxes.push_back(bbox1);
+      const std::array<T, 6>& b = split_bboxes[-node - 1];
+      bbox_coordinates.insert(bbox_coordinates.end(), b.begin(), b.end());
+    }
+
+    roots.push_back(bboxes.size() / 2 - 1);
+  }
+
   return {std::move(bboxes), std::move(bbox_coordinates)};
 }
 //-----------------------------------------------------------------------------
@@ -231,10 +386,17 @@ public:
   /// computed for all local entities (including ghosts) of the given `tdim`.
   /// @param[in] padding Value to pad (extend) the the bounding box of
   /// each entity by.
+  /// @param[in] num_threads Number of threads to build the tree with.
+  /// The tree does not depend on the number of threads.
+  ///
+  /// @note For cells of meshes with a higher-order coordinate element,
+  /// the boxes are computed from the Bernstein control points of the
+  /// cells (see fem::CoordinateElement::bernstein_matrix), which
+  /// enclose the curved cells.
   BoundingBoxTree(const mesh::Mesh<T>& mesh, int tdim,
                   std::optional<std::span<const std::int32_t>> entities
                   = std::nullopt,
-                  double padding = 0)
+                  double padding = 0, int num_threads = 1)
       : _tdim(tdim)
   {
     // Initialize entities of given dimension if they don't exist
@@ -263,22 +425,14 @@ public:
     mesh.topology_mutable()->create_connectivity(tdim, mesh.topology()->dim());
 
     // Create bounding boxes for all mesh entities (leaves)
-    std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes;
-    leaf_bboxes.reserve(entities_span.size());
-    for (std::int32_t e : entities_span)
-    {
-      std::array<T, 6> b = impl_bb::compute_bbox_of_entity(mesh, tdim, e);
-      std::transform(b.cbegin(), std::next(b.cbegin(), 3), b.begin(),
-                     [padding](auto x) { return x - padding; });
-      std::transform(std::next(b.begin(), 3), b.end(), std::next(b.begin(), 3),
-                     [padding](auto x) { return x + padding; });
-      leaf_bboxes.emplace_back(b, e);
-    }
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes
+        = impl_bb::compute_leaf_bboxes(mesh, tdim, entities_span, padding,
+                                       num_threads);
 
     // Recursively build the bounding box tree from the leaves
     if (!leaf_bboxes.empty())
       std::tie(_bboxes, _bbox_coordinates)
-          = impl_bb::build_from_leaf(leaf_bboxes);
+          = impl_bb::build_from_leaf(leaf_bboxes, num_threads);
 
     spdlog::info("Computed bounding box tree with {} nodes for {} entities",
                  num_bboxes(), entities_span.size());
@@ -327,6 +481,63 @@ public:
     return x;
   }
 
+  /// @brief Update the bounding boxes after the mesh geometry has
+  /// changed, without changing the tree structure.
+  ///
+  /// The leaves are recomputed for the entities that they bound, and
+  /// the boxes of the other nodes from their children. This is much
+  /// cheaper than building a new tree. The tree remains valid for any
+  /// motion of the mesh, but queries become less efficient if entities
+  /// move far relative to each other, in which case the tree should be
+  /// rebuilt.
+  ///
+  /// @pre The tree was created for entities of dimension tdim() of a
+  /// mesh with the same topology as `mesh`.
+  ///
+  /// @param[in] mesh Mesh with the updated geometry.
+  /// @param[in] padding Value to pad (extend) the bounding box of each
+  /// entity by.
+  /// @param[in] num_threads Number of threads.
+  void refit(const mesh::Mesh<T>& mesh, double padding = 0,
+             int num_threads = 1)
+  {
+    // Leaf nodes and their entities
+    std::vector<std::int32_t> leaves, entities;
+    for (std::int32_t i = 0; i < num_bboxes(); ++i)
+    {
+      if (_bboxes[2 * i] == _bboxes[2 * i + 1])
+      {
+        leaves.push_back(i);
+        entities.push_back(_bboxes[2 * i]);
+      }
+    }
+
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes
+        = impl_bb::compute_leaf_bboxes(mesh, _tdim, std::span(entities),
+                                       padding, num_threads);
+    for (std::size_t i = 0; i < leaves.size(); ++i)
+    {
+      std::ranges::copy(leaf_bboxes[i].first,
+                        std::next(_bbox_coordinates.begin(), 6 * leaves[i]));
+    }
+
+    // Child nodes precede their parents
+    for (std::int32_t i = 0; i < num_bboxes(); ++i)
+    {
+      if (std::array c = bbox(i); c[0] != c[1])
+      {
+        T* b = _bbox_coordinates.data() + 6 * i;
+        const T* b0 = _bbox_coordinates.data() + 6 * c[0];
+        const T* b1 = _bbox_coordinates.data() + 6 * c[1];
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+          b[j] = std::min(b0[j], b1[j]);
+          b[j + 3] = std::max(b0[j + 3], b1[j + 3]);
+        }
+      }
+    }
+  }
+
   /// Compute a global bounding tree (collective on comm)
   /// This can be used to find which process a point might have a
   /// collision with.
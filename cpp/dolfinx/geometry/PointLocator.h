@@ -0,0 +1,228 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <limits>
+#include <memory>
+#include <mpi.h>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dolfinx::geometry
+{
+/// @brief Repeated determination of the ownership of points that move
+/// between calls, e.g. particles.
+///
+/// A PointLocator computes the same data as determine_point_ownership,
+/// but uses the result of the previous call as a hint. A point that was
+/// owned by the calling process, in cell `c`, is first searched for in
+/// `c` and in the owned cells that share a vertex with `c`. Only the
+/// points that are not found this way are located with
+/// determine_point_ownership, which is skipped (apart from a single
+/// reduction) if no process has such points.
+///
+/// @note A point that lies in cells on more than one process keeps its
+/// previous owner, whereas determine_point_ownership picks the first
+/// colliding process. Ownership is otherwise the same.
+///
+/// @tparam T Mesh geometry floating type.
+template <std::floating_point T>
+class PointLocator
+{
+public:
+  /// @brief Create a point locator.
+  /// @param[in] mesh The mesh.
+  /// @param[in] padding Padding of the bounding boxes of the cells, see
+  /// determine_point_ownership.
+  PointLocator(std::shared_ptr<const mesh::Mesh<T>> mesh, T padding = 0)
+      : _mesh(mesh), _padding(padding)
+  {
+    // Owned cells that share a vertex with each owned cell
+    const int tdim = mesh->topology()->dim();
+    mesh->topology_mutable()->create_connectivity(0, tdim);
+    auto c_to_v = mesh->topology()->connectivity(tdim, 0);
+    auto v_to_c = mesh->topology()->connectivity(0, tdim);
+    assert(c_to_v);
+    assert(v_to_c);
+    const std::int32_t num_cells
+        = mesh->topology()->index_map(tdim)->size_local();
+    std::vector<std::int32_t> data, offsets(1, 0);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      for (std::int32_t v : c_to_v->links(c))
+      {
+        for (std::int32_t c1 : v_to_c->links(v))
+        {
+          if (c1 != c and c1 < num_cells)
+            data.push_back(c1);
+        }
+      }
+
+      auto it = std::next(data.begin(), offsets.back());
+      std::ranges::sort(it, data.end());
+      auto [unique_end, range_end] = std::ranges::unique(it, data.end());
+      data.erase(unique_end, range_end);
+      offsets.push_back(data.size());
+    }
+
+    _neighbours = graph::AdjacencyList(std::move(data), std::move(offsets));
+    if (AffineSimplexCache<T>::supported(*mesh))
+      _cache.emplace(*mesh);
+  }
+
+  /// @brief Determine the ownership of points.
+  ///
+  /// Points are located using the result of the previous call as a
+  /// hint if the number of points on the calling process is unchanged,
+  /// i.e. the `i`-th point is assumed to be the `i`-th point of the
+  /// previous call moved.
+  ///
+  /// @note Collective.
+  ///
+  /// @param[in] points Points to locate (`shape=(num_points, 3)`).
+  /// Storage is row-major.
+  /// @return Ownership data, see determine_point_ownership.
+  PointOwnershipData<T> locate(std::span<const T> points)
+  {
+    MPI_Comm comm = _mesh->comm();
+    const int rank = dolfinx::MPI::rank(comm);
+    const std::size_t num_points = points.size() / 3;
+    if (_cells.size() != num_points)
+      _cells.assign(num_points, -1);
+
+    // Search for points in the neighbourhood of their previous cell
+    std::vector<int> src_owner(num_points, -1);
+    std::vector<std::int32_t> cells(num_points, -1);
+    std::vector<std::int32_t> remaining;
+    std::vector<std::int32_t> candidates;
+    for (std::size_t i = 0; i < num_points; ++i)
+    {
+      if (std::int32_t c = _cells[i]; c >= 0)
+      {
+        candidates.assign(1, c);
+        auto nbrs = _neighbours.links(c);
+        candidates.insert(candidates.end(), nbrs.begin(), nbrs.end());
+        std::array<T, 3> p;
+        std::copy_n(std::next(points.begin(), 3 * i), 3, p.begin());
+        constexpr T tol = 10 * std::numeric_limits<T>::epsilon();
+        cells[i] = _cache ? compute_first_colliding_cell(
+                                *_mesh, *_cache,
+                                std::span<const std::int32_t>(candidates), p,
+                                tol)
+                          : compute_first_colliding_cell(
+                                *_mesh,
+                                std::span<const std::int32_t>(candidates), p,
+                                tol);
+      }
+
+      if (cells[i] >= 0)
+        src_owner[i] = rank;
+      else
+        remaining.push_back(i);
+    }
+
+    // Locate the remaining points globally, if there are any
+    std::int64_t num_remaining = remaining.size();
+    MPI_Allreduce(MPI_IN_PLACE, &num_remaining, 1, MPI_INT64_T, MPI_SUM,
+                  comm);
+    PointOwnershipData<T> data;
+    if (num_remaining > 0)
+    {
+      std::vector<T> x(3 * remaining.size());
+      for (std::size_t i = 0; i < remaining.size(); ++i)
+      {
+        std::copy_n(std::next(points.begin(), 3 * remaining[i]), 3,
+                    std::next(x.begin(), 3 * i));
+      }
+      data = determine_point_ownership(*_mesh, std::span<const T>(x),
+                                       _padding, 1, 1,
+                                       _cache ? &*_cache : nullptr);
+      for (std::size_t i = 0; i < remaining.size(); ++i)
+        src_owner[remaining[i]] = data.src_owner[i];
+    }
+
+    // Points received from this process, which are in the order of the
+    // (remaining) points
+    auto [r0, r1] = std::ranges::equal_range(data.dest_owners, rank);
+    const std::size_t d0 = std::distance(data.dest_owners.begin(), r0);
+    const std::size_t d1 = std::distance(data.dest_owners.begin(), r1);
+    std::size_t d = d0;
+    for (std::size_t i = 0; i < remaining.size(); ++i)
+    {
+      if (src_owner[remaining[i]] == rank)
+        cells[remaining[i]] = data.dest_cells[d++];
+    }
+    assert(d == d1);
+
+    // Insert the (all) points owned by this process, in order, into the
+    // points received from other processes
+    std::vector<int> dest_owners(data.dest_owners.begin(), r0);
+    std::vector<T> dest_points(data.dest_points.begin(),
+                               std::next(data.dest_points.begin(), 3 * d0));
+    std::vector<std::int32_t> dest_cells(
+        data.dest_cells.begin(), std::next(data.dest_cells.begin(), d0));
+    for (std::size_t i = 0; i < num_points; ++i)
+    {
+      if (src_owner[i] == rank)
+      {
+        dest_owners.push_back(rank);
+        dest_points.insert(dest_points.end(),
+                           std::next(points.begin(), 3 * i),
+                           std::next(points.begin(), 3 * (i + 1)));
+        dest_cells.push_back(cells[i]);
+      }
+    }
+    dest_owners.insert(dest_owners.end(), r1, data.dest_owners.end());
+    dest_points.insert(dest_points.end(),
+                       std::next(data.dest_points.begin(), 3 * d1),
+                       data.dest_points.end());
+    dest_cells.insert(dest_cells.end(), std::next(data.dest_cells.begin(), d1),
+                      data.dest_cells.end());
+
+    // Store hints for the next call
+    for (std::size_t i = 0; i < num_points; ++i)
+      _cells[i] = src_owner[i] == rank ? cells[i] : -1;
+
+    return PointOwnershipData<T>{.src_owner = std::move(src_owner),
+                                 .dest_owners = std::move(dest_owners),
+                                 .dest_points = std::move(dest_points),
+                                 .dest_cells = std::move(dest_cells)};
+  }
+
+  /// @brief Discard the hints from the previous call to locate(), e.g.
+  /// if the points have been renumbered.
+  ///
+  /// Hints are always verified, hence stale hints only cost time.
+  void reset() { _cells.clear(); }
+
+private:
+  // The mesh
+  std::shared_ptr<const mesh::Mesh<T>> _mesh;
+
+  // Padding of cell bounding boxes
+  T _padding;
+
+  // Owned cells that share a vertex with each owned cell
+  graph::AdjacencyList<std::int32_t> _neighbours{0};
+
+  // Affine maps of the cells, for meshes of affine simplices
+  std::optional<AffineSimplexCache<T>> _cache;
+
+  // Cell (local to this process) of each point at the previous call,
+  // or -1 if the point was not owned by this process
+  std::vector<std::int32_t> _cells;
+};
+} // namespace dolfinx::geometry
@@ -0,0 +1,182 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "BoundingBoxTree.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dolfinx::geometry
+{
+/// @brief Axis-aligned bounding box tree with `N` children per node (a
+/// wide bounding volume hierarchy).
+///
+/// The tree is built by collapsing a binary BoundingBoxTree: each node
+/// of the wide tree holds up to `N` nodes of the binary tree, obtained
+/// by repeatedly replacing the largest internal node by its two
+/// children. The boxes of the children of a node are stored together in
+/// a structure-of-arrays layout, so that a point can be tested against
+/// all children of a node with one vectorisable loop. The children of a
+/// node are ordered as they are visited by a depth-first traversal of
+/// the binary tree, hence queries return the same entities in the same
+/// order as for the binary tree.
+///
+/// @tparam T Floating point type of the box coordinates.
+/// @tparam N Number of children per node.
+template <std::floating_point T, int N = 4>
+class WideBoundingBoxTree
+{
+  static_assert(N >= 2);
+
+public:
+  /// Child index of an unused child slot
+  static constexpr std::int32_t empty
+      = std::numeric_limits<std::int32_t>::min();
+
+  /// @brief Create a tree for mesh entities.
+  ///
+  /// The arguments are as for the BoundingBoxTree constructor.
+  ///
+  /// @param[in] mesh Mesh for building the bounding box tree.
+  /// @param[in] tdim Topological dimension of the mesh entities.
+  /// @param[in] entities Entity indices (local to process). If
+  /// `std::nullopt`, the tree is built for all local entities
+  /// (including ghosts) of dimension `tdim`.
+  /// @param[in] padding Value to pad (extend) the bounding box of each
+  /// entity by.
+  WideBoundingBoxTree(const mesh::Mesh<T>& mesh, int tdim,
+                      std::optional<std::span<const std::int32_t>> entities
+                      = std::nullopt,
+                      double padding = 0)
+      : WideBoundingBoxTree(BoundingBoxTree<T>(mesh, tdim, entities, padding))
+  {
+  }
+
+  /// @brief Create a wide tree from a binary tree.
+  /// @param[in] tree Binary bounding box tree.
+  explicit WideBoundingBoxTree(const BoundingBoxTree<T>& tree)
+      : _tdim(tree.tdim())
+  {
+    if (tree.num_bboxes() > 0)
+      build(tree, tree.num_bboxes() - 1);
+  }
+
+  /// Move constructor
+  WideBoundingBoxTree(WideBoundingBoxTree&& tree) = default;
+
+  /// Copy constructor
+  WideBoundingBoxTree(const WideBoundingBoxTree& tree) = delete;
+
+  /// Move assignment
+  WideBoundingBoxTree& operator=(WideBoundingBoxTree&& other) = default;
+
+  /// Destructor
+  ~WideBoundingBoxTree() = default;
+
+  /// @brief Number of nodes. The root node is node 0.
+  std::int32_t num_nodes() const { return _children.size() / N; }
+
+  /// @brief Bounds of the boxes of the children of each node.
+  ///
+  /// The shape is `(num_nodes, 2, 3, N)` (row-major), i.e. the lower
+  /// bounds in each direction for the `N` children followed by the
+  /// upper bounds. The bounds include the relative tolerance of the
+  /// point-in-box test used by the binary tree. Unused child slots
+  /// have empty boxes.
+  std::span<const T> bbox_coordinates() const { return _bbox_coordinates; }
+
+  /// @brief Children of each node (`shape=(num_nodes, N)`).
+  ///
+  /// A non-negative value is the index of a node. A leaf that bounds
+  /// entity `e` is stored as `-(e + 1)`, and unused slots are
+  /// #empty.
+  std::span<const std::int32_t> children() const { return _children; }
+
+  /// Topological dimension of leaf entities
+  int tdim() const { return _tdim; }
+
+private:
+  // Append the node that collapses the binary subtree with root `node`,
+  // and return its index
+  std::int32_t build(const BoundingBoxTree<T>& tree, std::int32_t node)
+  {
+    // Collapse the subtree into at most N binary nodes, ordered as in a
+    // depth-first traversal
+    std::vector<std::int32_t> nodes = {node};
+    while (nodes.size() < static_cast<std::size_t>(N))
+    {
+      // Find the internal node with the largest box
+      int split = -1;
+      T size = -1;
+      for (std::size_t i = 0; i < nodes.size(); ++i)
+      {
+        if (std::array c = tree.bbox(nodes[i]); c[0] != c[1])
+        {
+          std::array<T, 6> b = tree.get_bbox(nodes[i]);
+          if (T s = (b[3] - b[0]) + (b[4] - b[1]) + (b[5] - b[2]); s > size)
+          {
+            split = i;
+            size = s;
+          }
+        }
+      }
+
+      if (split < 0)
+        break;
+      std::array c = tree.bbox(nodes[split]);
+      nodes[split] = c[1];
+      nodes.insert(std::next(nodes.begin(), split), c[0]);
+    }
+
+    // Unused child slots have empty boxes
+    const std::int32_t w = num_nodes();
+    _children.resize(_children.size() + N, empty);
+    _bbox_coordinates.resize(_bbox_coordinates.size() + 6 * N);
+    auto b_w = std::next(_bbox_coordinates.begin(), 6 * N * w);
+    std::fill_n(b_w, 3 * N, std::numeric_limits<T>::max());
+    std::fill_n(std::next(b_w, 3 * N), 3 * N, std::numeric_limits<T>::lowest());
+
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+      // Store bounds, padded as in impl::point_in_bbox
+      constexpr T rtol = 1e-14;
+      std::array<T, 6> b = tree.get_bbox(nodes[i]);
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        T eps = rtol * (b[j + 3] - b[j]);
+        _bbox_coordinates[6 * N * w + j * N + i] = b[j] - eps;
+        _bbox_coordinates[6 * N * w + (j + 3) * N + i] = b[j + 3] + eps;
+      }
+
+      std::int32_t child;
+      if (std::array c = tree.bbox(nodes[i]); c[0] == c[1])
+        child = -(c[1] + 1);
+      else
+        child = build(tree, nodes[i]);
+      _children[N * w + i] = child;
+    }
+
+    return w;
+  }
+
+  // Topological dimension of leaf entities
+  int _tdim;
+
+  // Child node (or leaf) indices
+  std::vector<std::int32_t> _children;
+
+  // Bounds of child boxes
+  std::vector<T> _bbox_coordinates;
+};
+} // namespace dolfinx::geometry
@@ -10,4 +10,5 @@ namespace dolfinx::geometry
 // DOLFINx geometry interface
 
 #include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/WideBoundingBoxTree.h>
 #include <dolfinx/geometry/gjk.h>
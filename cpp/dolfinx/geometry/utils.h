@@ -6,18 +6,28 @@
 
 #pragma once
 
+#include "AffineSimplexCache.h"
 #include "BoundingBoxTree.h"
+#include "WideBoundingBoxTree.h"
 #include "gjk.h"
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <concepts>
 #include <cstdint>
 #include <deque>
+#include <dolfinx/common/Workspace.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <map>
 #include <numeric>
+#include <optional>
 #include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::geometry
@@ -359,6 +369,159 @@ void _compute_collisions_point(const geometry::BoundingBoxTree<T>& tree,
   }
 }
 
+/// @brief Compute collisions with a packet of points.
+///
+/// The points of a packet traverse the tree together. For each visited
+/// node the child boxes are tested against all points of the packet
+/// at once (in a structure-of-arrays layout that the compiler can
+/// vectorise), and the points that collide with a child are tracked
+/// by a bit mask. The colliding entities of each point are the same,
+/// and in the same order, as for _compute_collisions_point.
+///
+/// @tparam W Packet size, `W <= 32`.
+/// @param[in] tree Bounding box tree.
+/// @param[in] points The points of the packet (`shape=(n, 3)`), with
+/// `0 < n <= W`.
+/// @param[in, out] entities List of colliding entities (local to
+/// process) for each point of the packet.
+template <int W, std::floating_point T>
+void _compute_collisions_packet(
+    const geometry::BoundingBoxTree<T>& tree, std::span<const T> points,
+    std::array<std::vector<std::int32_t>, W>& entities)
+{
+  static_assert(W > 0 and W <= 32);
+  using mask_t = std::uint32_t;
+
+  // Pack points (structure-of-arrays), with unused lanes holding
+  // copies of the last point
+  const std::size_t n = points.size() / 3;
+  assert(n > 0 and n <= W);
+  std::array<T, 3 * W> x;
+  for (std::size_t l = 0; l < W; ++l)
+    for (std::size_t j = 0; j < 3; ++j)
+      x[j * W + l] = points[3 * std::min(l, n - 1) + j];
+  const mask_t active = n == 32 ? ~mask_t(0) : (mask_t(1) << n) - 1;
+
+  // Lanes with a point in the box of a node (see point_in_bbox)
+  std::span<const T> coords = tree.bbox_coordinates();
+  auto collide = [&coords, &x](std::int32_t node) -> mask_t
+  {
+    constexpr T rtol = 1e-14;
+    const T* b = coords.data() + 6 * node;
+    std::array<bool, W> in;
+    in.fill(true);
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      const T eps = rtol * (b[i + 3] - b[i]);
+      const T x0 = b[i] - eps;
+      const T x1 = b[i + 3] + eps;
+      for (std::size_t l = 0; l < W; ++l)
+        in[l] &= (x[i * W + l] >= x0) & (x[i * W + l] <= x1);
+    }
+
+    mask_t m = 0;
+    for (std::size_t l = 0; l < W; ++l)
+      m |= mask_t(in[l]) << l;
+    return m;
+  };
+
+  std::vector<std::pair<std::int32_t, mask_t>> stack;
+  std::int32_t next = tree.num_bboxes() - 1;
+  mask_t mask = collide(next) & active;
+  while (mask != 0)
+  {
+    if (std::array bbox = tree.bbox(next); is_leaf(bbox))
+    {
+      // Add leaf to the colliding entities of each point in the mask
+      for (std::size_t l = 0; l < W; ++l)
+      {
+        if ((mask >> l) & 1)
+          entities[l].push_back(bbox[1]);
+      }
+      mask = 0;
+    }
+    else
+    {
+      // Points in the mask that collide with the child nodes. Continue
+      // with the left node, and defer the right node if both collide.
+      const mask_t left = collide(bbox[0]) & mask;
+      const mask_t right = collide(bbox[1]) & mask;
+      if (left != 0 and right != 0)
+      {
+        stack.emplace_back(bbox[1], right);
+        next = bbox[0];
+        mask = left;
+      }
+      else if (left != 0)
+      {
+        next = bbox[0];
+        mask = left;
+      }
+      else if (right != 0)
+      {
+        next = bbox[1];
+        mask = right;
+      }
+      else
+        mask = 0;
+    }
+
+    // Continue with a deferred subtree at a dead end
+    if (mask == 0 and !stack.empty())
+    {
+      std::tie(next, mask) = stack.back();
+      stack.pop_back();
+    }
+  }
+}
+
+/// @brief Compute collisions of a point with a wide bounding box tree.
+/// @param[in] tree Wide bounding box tree.
+/// @param[in] p The point.
+/// @param[in, out] entities List of colliding entities (local to
+/// process).
+/// @param[in, out] stack Work array for the traversal. It is empty on
+/// return.
+template <std::floating_point T, int N>
+void _compute_collisions_point(const geometry::WideBoundingBoxTree<T, N>& tree,
+                               std::span<const T, 3> p,
+                               std::vector<std::int32_t>& entities,
+                               std::vector<std::int32_t>& stack)
+{
+  std::span<const T> coords = tree.bbox_coordinates();
+  std::span<const std::int32_t> children = tree.children();
+  stack.push_back(0);
+  while (!stack.empty())
+  {
+    std::int32_t next = stack.back();
+    stack.pop_back();
+    if (next < 0)
+    {
+      // Leaf
+      entities.push_back(-(next + 1));
+      continue;
+    }
+
+    // Test the point against the boxes of all children
+    const T* b = coords.data() + 6 * N * next;
+    std::array<bool, N> in;
+    for (int i = 0; i < N; ++i)
+    {
+      in[i] = (p[0] >= b[i]) & (p[0] <= b[3 * N + i]) & (p[1] >= b[N + i])
+              & (p[1] <= b[4 * N + i]) & (p[2] >= b[2 * N + i])
+              & (p[2] <= b[5 * N + i]);
+    }
+
+    // Push colliding children in reverse order, so that they are
+    // visited in order
+    for (int i = N - 1; i >= 0; --i)
+    {
+      if (in[i])
+        stack.push_back(children[N * next + i]);
+    }
+  }
+}
+
 // Compute collisions with tree (recursive)
 template <std::floating_point T>
 void _compute_collisions_tree(const geometry::BoundingBoxTree<T>& A,
@@ -470,34 +633,143 @@ std::vector<std::int32_t> compute_collisions(const BoundingBoxTree<T>& tree0,
 /// Bounding boxes can overlap, therefore points can collide with more
 /// than one box.
 ///
+/// Points can be processed in packets that traverse the tree together
+/// (see impl::_compute_collisions_packet). This is efficient when the
+/// points of a packet are close, e.g. when the points are ordered
+/// spatially, as the packet then shares most node visits.
+///
 /// @param[in] tree The bounding box tree
 /// @param[in] points The points (`shape=(num_points, 3)`). Storage is
 /// row-major.
+/// @param[in] packet_size Number of consecutive points that traverse
+/// the tree together. Supported values are 1 (points traverse the tree
+/// one at a time), 4, 8 and 16.
+/// @param[in] num_threads Number of threads to process the points
+/// with.
 /// @return For each point, the bounding box leaves that collide with
 /// the point.
 template <std::floating_point T>
 graph::AdjacencyList<std::int32_t>
-compute_collisions(const BoundingBoxTree<T>& tree, std::span<const T> points)
+compute_collisions(const BoundingBoxTree<T>& tree, std::span<const T> points,
+                   int packet_size = 1, int num_threads = 1)
 {
-  if (tree.num_bboxes() > 0)
+  const std::size_t num_points = points.size() / 3;
+  if (tree.num_bboxes() == 0)
+  {
+    return graph::AdjacencyList(std::vector<std::int32_t>(),
+                                std::vector<std::int32_t>(num_points + 1, 0));
+  }
+
+  if (packet_size != 1 and packet_size != 4 and packet_size != 8
+      and packet_size != 16)
+  {
+    throw std::runtime_error("Unsupported packet size.");
+  }
+
+  // Compute the colliding entities of the points [p0, p1), and the
+  // number of colliding entities of each point
+  std::vector<std::int32_t> offsets(num_points + 1, 0);
+  auto collisions = [&tree, &points, &offsets, packet_size](
+                        std::size_t p0, std::size_t p1,
+                        std::vector<std::int32_t>& entities)
+  {
+    entities.reserve(p1 - p0);
+    auto packets = [&]<int W>(std::integral_constant<int, W>)
+    {
+      std::array<std::vector<std::int32_t>, W> packet_entities;
+      for (std::size_t p = p0; p < p1; p += W)
+      {
+        const std::size_t n = std::min<std::size_t>(W, p1 - p);
+        impl::_compute_collisions_packet<W, T>(
+            tree, points.subspan(3 * p, 3 * n), packet_entities);
+        for (std::size_t l = 0; l < n; ++l)
+        {
+          entities.insert(entities.end(), packet_entities[l].begin(),
+                          packet_entities[l].end());
+          offsets[p + l + 1] = packet_entities[l].size();
+          packet_entities[l].clear();
+        }
+      }
+    };
+
+    switch (packet_size)
+    {
+    case 4:
+      packets(std::integral_constant<int, 4>{});
+      break;
+    case 8:
+      packets(std::integral_constant<int, 8>{});
+      break;
+    case 16:
+      packets(std::integral_constant<int, 16>{});
+      break;
+    default:
+      for (std::size_t p = p0; p < p1; ++p)
+      {
+        std::size_t n = entities.size();
+        impl::_compute_collisions_point(
+            tree, std::span<const T, 3>(points.data() + 3 * p, 3), entities);
+        offsets[p + 1] = entities.size() - n;
+      }
+    }
+  };
+
+  // Divide whole packets between threads
+  const std::size_t num_packets
+      = (num_points + packet_size - 1) / packet_size;
+  const int nt = std::clamp<std::size_t>(num_threads, 1,
+                                         std::max<std::size_t>(num_packets, 1));
+  std::vector<std::vector<std::int32_t>> entities(nt);
+  common::run_threads(
+      nt,
+      [&](int t)
+      {
+        auto [q0, q1] = common::thread_range(t, num_packets, nt);
+        collisions(std::min(q0 * packet_size, num_points),
+                   std::min(q1 * packet_size, num_points), entities[t]);
+      });
+
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  for (std::size_t t = 1; t < entities.size(); ++t)
+  {
+    entities[0].insert(entities[0].end(), entities[t].begin(),
+                       entities[t].end());
+  }
+
+  return graph::AdjacencyList(std::move(entities[0]), std::move(offsets));
+}
+
+/// @brief Compute collisions between points and the leaf bounding
+/// boxes of a wide bounding box tree.
+///
+/// The result is the same as for compute_collisions with the binary
+/// tree that the wide tree was created from.
+///
+/// @param[in] tree The wide bounding box tree
+/// @param[in] points The points (`shape=(num_points, 3)`). Storage is
+/// row-major.
+/// @return For each point, the bounding box leaves that collide with
+/// the point.
+template <std::floating_point T, int N>
+graph::AdjacencyList<std::int32_t>
+compute_collisions(const WideBoundingBoxTree<T, N>& tree,
+                   std::span<const T> points)
+{
+  std::vector<std::int32_t> entities, offsets(points.size() / 3 + 1, 0);
+  if (tree.num_nodes() > 0)
   {
-    std::vector<std::int32_t> entities, offsets(points.size() / 3 + 1, 0);
     entities.reserve(points.size() / 3);
+    std::vector<std::int32_t> stack;
     for (std::size_t p = 0; p < points.size() / 3; ++p)
     {
       impl::_compute_collisions_point(
-          tree, std::span<const T, 3>(points.data() + 3 * p, 3), entities);
+          tree, std::span<const T, 3>(points.data() + 3 * p, 3), entities,
+          stack);
       offsets[p + 1] = entities.size();
     }
-
-    return graph::AdjacencyList(std::move(entities), std::move(offsets));
-  }
-  else
-  {
-    return graph::AdjacencyList(
-        std::vector<std::int32_t>(),
-        std::vector<std::int32_t>(points.size() / 3 + 1, 0));
   }
+
+  return graph::AdjacencyList(std::move(entities), std::move(offsets));
 }
 
 /// @brief Given a set of cells, find the first one that collides with a
@@ -552,6 +824,42 @@ std::int32_t compute_first_colliding_cell(const mesh::Mesh<T>& mesh,
   }
 }
 
+/// @brief Compute the first collision between a point and the cells
+/// of a mesh of affine simplices.
+///
+/// The result is as for the overload without `cache`, but collisions
+/// are decided by the barycentric test of AffineSimplexCache::collides.
+/// GJK is used only for the cells for which this test is inconclusive.
+///
+/// @param[in] mesh The mesh.
+/// @param[in] cache Affine maps of the cells of `mesh`.
+/// @param[in] cells Candidate cells.
+/// @param[in] point The point (`shape=(3,)`).
+/// @param[in] tol Tolerance for accepting a collision (in the squared
+/// distance).
+/// @return Local cell index, -1 if not found.
+template <std::floating_point T>
+std::int32_t compute_first_colliding_cell(const mesh::Mesh<T>& mesh,
+                                          const AffineSimplexCache<T>& cache,
+                                          std::span<const std::int32_t> cells,
+                                          std::array<T, 3> point, T tol)
+{
+  for (std::int32_t cell : cells)
+  {
+    if (int c = cache.collides(cell, point, tol); c == 1)
+      return cell;
+    else if (c == -1
+             and compute_first_colliding_cell(
+                     mesh, std::span<const std::int32_t>(&cell, 1), point, tol)
+                     >= 0)
+    {
+      return cell;
+    }
+  }
+
+  return -1;
+}
+
 /// @brief Compute closest mesh entity to a point.
 ///
 /// @note Returns a vector filled with index -1 if the bounding box tree
@@ -636,10 +944,12 @@ graph::AdjacencyList<std::int32_t> compute_colliding_cells(
   std::vector<std::int32_t> colliding_cells;
   constexpr T eps2 = 1e-12;
   const int tdim = mesh.topology()->dim();
+  common::Workspace& ws = common::Workspace::local();
   for (std::int32_t i = 0; i < candidate_cells.num_nodes(); i++)
   {
     auto cells = candidate_cells.links(i);
-    std::vector<T> _point(3 * cells.size());
+    common::Workspace::Scope scope(ws);
+    std::span<T> _point = ws.allocate<T>(3 * cells.size());
     for (std::size_t j = 0; j < cells.size(); ++j)
       for (std::size_t k = 0; k < 3; ++k)
         _point[3 * j + k] = points[3 * i + k];
@@ -655,6 +965,58 @@ graph::AdjacencyList<std::int32_t> compute_colliding_cells(
   return graph::AdjacencyList(std::move(colliding_cells), std::move(offsets));
 }
 
+/// @brief Compute which cells of a mesh of affine simplices collide
+/// with a point.
+///
+/// The result is as for the overload without `cache`, but collisions
+/// are decided by the barycentric test of AffineSimplexCache::collides.
+/// GJK is used only for the cells for which this test is inconclusive.
+///
+/// @param[in] mesh The mesh
+/// @param[in] cache Affine maps of the cells of `mesh`.
+/// @param[in] candidate_cells List of candidate colliding cells for the
+/// ith point in `points`
+/// @param[in] points Points to check for collision (`shape=(num_points,
+/// 3)`). Storage is row-major.
+/// @return For each point, the cells that collide with the point.
+template <std::floating_point T>
+graph::AdjacencyList<std::int32_t> compute_colliding_cells(
+    const mesh::Mesh<T>& mesh, const AffineSimplexCache<T>& cache,
+    const graph::AdjacencyList<std::int32_t>& candidate_cells,
+    std::span<const T> points)
+{
+  std::vector<std::int32_t> offsets = {0};
+  offsets.reserve(candidate_cells.num_nodes() + 1);
+  std::vector<std::int32_t> colliding_cells;
+  constexpr T eps2 = 1e-12;
+  std::vector<int> collides;
+  for (std::int32_t i = 0; i < candidate_cells.num_nodes(); i++)
+  {
+    // Test all candidates, then resolve inconclusive tests with GJK
+    auto cells = candidate_cells.links(i);
+    std::span<const T, 3> p(points.data() + 3 * i, 3);
+    collides.resize(cells.size());
+    std::ranges::transform(cells, collides.begin(), [&](auto c)
+                           { return cache.collides(c, p, eps2); });
+    for (std::size_t j = 0; j < cells.size(); j++)
+    {
+      if (collides[j] == -1)
+      {
+        std::vector d2 = squared_distance<T>(
+            mesh, cache.tdim(), std::span(cells.data() + j, 1), p);
+        collides[j] = d2.front() < eps2;
+      }
+
+      if (collides[j] == 1)
+        colliding_cells.push_back(cells[j]);
+    }
+
+    offsets.push_back(colliding_cells.size());
+  }
+
+  return graph::AdjacencyList(std::move(colliding_cells), std::move(offsets));
+}
+
 /// @brief Given a set of points, determine which process is colliding,
 /// using the GJK algorithm on cells to determine collisions.
 ///
@@ -667,6 +1029,14 @@ graph::AdjacencyList<std::int32_t> compute_colliding_cells(
 /// Each bounding box of the mesh is padded with this amount, to increase
 /// the number of candidates, avoiding rounding errors in determining the owner
 /// of a point if the point is on the surface of a cell in the mesh.
+/// @param[in] packet_size Number of consecutive points that traverse
+/// the bounding box trees together (see compute_collisions).
+/// @param[in] num_threads Number of threads for the process-local
+/// collision computations.
+/// @param[in] cache Affine maps of the cells, e.g. held by a caller
+/// that locates points repeatedly. If `nullptr` and the cells are
+/// affine simplices, the affine maps of the candidate cells of the
+/// received points are computed.
 /// @return Tuple `(src_owner, dest_owner, dest_points, dest_cells)`,
 /// where src_owner is a list of ranks corresponding to the input
 /// points. dest_owner is a list of ranks corresponding to dest_points,
@@ -683,9 +1053,10 @@ graph::AdjacencyList<std::int32_t> compute_colliding_cells(
 /// one has to determine the closest cell among all processes with an
 /// intersecting bounding box, which is an expensive operation to perform.
 template <std::floating_point T>
-PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
-                                                std::span<const T> points,
-                                                T padding)
+PointOwnershipData<T>
+determine_point_ownership(const mesh::Mesh<T>& mesh, std::span<const T> points,
+                          T padding, int packet_size = 1, int num_threads = 1,
+                          const AffineSimplexCache<T>* cache = nullptr)
 {
   MPI_Comm comm = mesh.comm();
 
@@ -702,7 +1073,8 @@ PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
 
   // Compute collisions:
   // For each point in `points` get the processes it should be sent to
-  graph::AdjacencyList collisions = compute_collisions(global_bbtree, points);
+  graph::AdjacencyList collisions
+      = compute_collisions(global_bbtree, points, packet_size, num_threads);
 
   // Get unique list of outgoing ranks
   std::vector<std::int32_t> out_ranks = collisions.array();
@@ -781,28 +1153,48 @@ PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
 
   // Compute candidate cells for collisions (and extrapolation)
   const graph::AdjacencyList<std::int32_t> candidate_collisions
-      = compute_collisions(bb, std::span<const T>(received_points.data(),
-                                                  received_points.size()));
-
-  // Each process checks which points collide with a cell on the process
+      = compute_collisions(bb, std::span<const T>(received_points), packet_size,
+                           num_threads);
+
+  // Each process checks which points collide with a cell on the
+  // process. Meshes of affine simplices use barycentric tests, with
+  // the affine maps of the candidate cells only if no cache is given.
+  std::optional<AffineSimplexCache<T>> candidate_cache;
+  if (!cache and AffineSimplexCache<T>::supported(mesh))
+  {
+    candidate_cache.emplace(mesh, candidate_collisions.array(), num_threads);
+    cache = &*candidate_cache;
+  }
   const int rank = dolfinx::MPI::rank(comm);
   std::vector<std::int32_t> cell_indicator(received_points.size() / 3);
   std::vector<std::int32_t> closest_cells(received_points.size() / 3);
-  for (std::size_t p = 0; p < received_points.size(); p += 3)
-  {
-    std::array<T, 3> point;
-    std::copy_n(std::next(received_points.begin(), p), 3, point.begin());
-    // Find first colliding cell among the cells with colliding bounding boxes
-    const int colliding_cell = geometry::compute_first_colliding_cell(
-        mesh, candidate_collisions.links(p / 3), point,
-        10 * std::numeric_limits<T>::epsilon());
-    // If a collding cell is found, store the rank of the current process
-    // which will be sent back to the owner of the point
-    cell_indicator[p / 3] = (colliding_cell >= 0) ? rank : -1;
-    // Store the cell index for lookup once the owning processes has determined
-    // the ownership of the point
-    closest_cells[p / 3] = colliding_cell;
-  }
+  common::parallel_for(
+      received_points.size() / 3, num_threads,
+      [&](std::size_t p0, std::size_t p1)
+      {
+        for (std::size_t p = 3 * p0; p < 3 * p1; p += 3)
+        {
+          std::array<T, 3> point;
+          std::copy_n(std::next(received_points.begin(), p), 3,
+                      point.begin());
+          // Find first colliding cell among the cells with colliding
+          // bounding boxes
+          constexpr T tol = 10 * std::numeric_limits<T>::epsilon();
+          const int colliding_cell
+              = cache ? geometry::compute_first_colliding_cell(
+                            mesh, *cache, candidate_collisions.links(p / 3),
+                            point, tol)
+                      : geometry::compute_first_colliding_cell(
+                            mesh, candidate_collisions.links(p / 3), point,
+                            tol);
+          // If a collding cell is found, store the rank of the current
+          // process which will be sent back to the owner of the point
+          cell_indicator[p / 3] = (colliding_cell >= 0) ? rank : -1;
+          // Store the cell index for lookup once the owning processes
+          // has determined the ownership of the point
+          closest_cells[p / 3] = colliding_cell;
+        }
+      });
 
   // Create neighborhood communicator in the reverse direction: send
   // back col to requesting processes
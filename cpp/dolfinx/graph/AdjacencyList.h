@@ -8,10 +8,13 @@
 
 #include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <numeric>
 #include <span>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -136,6 +139,13 @@ public:
   /// Offset for each node in array()
   std::vector<std::int32_t>& offsets() { return _offsets; }
 
+  /// @brief Memory used by the adjacency list.
+  /// @return Number of bytes of the links and offsets arrays.
+  std::size_t memory_usage() const noexcept
+  {
+    return sizeof(T) * _array.size() + sizeof(std::int32_t) * _offsets.size();
+  }
+
   /// Informal string representation (pretty-print)
   /// @return String representation of the adjacency list
   std::string str() const
@@ -201,4 +211,135 @@ regular_adjacency_list(U&& data, int degree)
       std::forward<U>(data), std::move(offsets));
 }
 
+/// @brief Adjacency list with the same number of links (degree) for
+/// every node.
+///
+/// No offsets array is stored, and the links of a node are returned as
+/// a span with extent `N`, such that loops over the links can be
+/// unrolled by the compiler when the degree is known at compile time.
+///
+/// @tparam T Link type
+/// @tparam N Degree of the nodes. If `std::dynamic_extent`, the degree
+/// is set at run time.
+/// @tparam Container Storage type of the links, e.g. `std::vector<T>`
+/// to own the data or `std::span<T>` for a view of the data of another
+/// adjacency list (see regular_view).
+template <typename T, std::size_t N = std::dynamic_extent,
+          typename Container = std::vector<T>>
+class RegularAdjacencyList
+{
+  static_assert(std::is_same_v<typename Container::value_type,
+                               std::remove_cv_t<T>>);
+  static_assert(N > 0);
+
+public:
+  /// Link type
+  using value_type = T;
+
+  /// @brief Create an adjacency list with a degree that is known at
+  /// compile time.
+  /// @param[in] data Links of all nodes (row-major)
+  explicit RegularAdjacencyList(Container data)
+    requires(N != std::dynamic_extent)
+      : _array(std::move(data))
+  {
+    if (_array.size() % N != 0)
+      throw std::runtime_error("Incompatible data size and degree.");
+  }
+
+  /// @brief Create an adjacency list with a degree that is set at run
+  /// time.
+  /// @param[in] data Links of all nodes (row-major)
+  /// @param[in] degree Number of links of each node
+  RegularAdjacencyList(Container data, int degree)
+      : _array(std::move(data))
+  {
+    if constexpr (N == std::dynamic_extent)
+      _degree = degree;
+    if (N != std::dynamic_extent and (std::size_t)degree != N)
+      throw std::runtime_error("Degree does not match the static degree.");
+    if (degree == 0 and !_array.empty())
+      throw std::runtime_error("Degree is zero but data is not empty.");
+    if (degree > 0 and _array.size() % degree != 0)
+      throw std::runtime_error("Incompatible data size and degree.");
+  }
+
+  /// Number of links of every node
+  constexpr int degree() const
+  {
+    if constexpr (N == std::dynamic_extent)
+      return _degree;
+    else
+      return N;
+  }
+
+  /// Get the number of nodes
+  /// @return The number of nodes in the adjacency list
+  std::int32_t num_nodes() const
+  {
+    return degree() == 0 ? 0 : _array.size() / degree();
+  }
+
+  /// Number of connections for given node
+  /// @return The number of outgoing links (edges) from the node
+  constexpr int num_links(std::size_t /*node*/) const { return degree(); }
+
+  /// Get the links (edges) for given node
+  /// @param [in] node Node index
+  /// @return Array of outgoing links for the node
+  std::span<T, N> links(std::size_t node)
+  {
+    return std::span<T, N>(_array.data() + node * degree(), degree());
+  }
+
+  /// Get the links (edges) for given node (const version)
+  /// @param [in] node Node index
+  /// @return Array of outgoing links for the node
+  std::span<const T, N> links(std::size_t node) const
+  {
+    return std::span<const T, N>(_array.data() + node * degree(),
+                                 degree());
+  }
+
+  /// Return contiguous array of links for all nodes
+  const Container& array() const { return _array; }
+
+private:
+  // Connections for all nodes stored as a contiguous array
+  Container _array;
+
+  // Degree, if not known at compile time
+  [[no_unique_address]] std::conditional_t<N == std::dynamic_extent, int,
+                                           std::integral_constant<int, 0>>
+      _degree{};
+};
+
+/// @brief Create a view of an adjacency list with the same number of
+/// links for every node.
+///
+/// The view does not store the offsets of the nodes. It is valid for
+/// the lifetime of `list`.
+///
+/// @tparam N Degree of the nodes, or `std::dynamic_extent` to use the
+/// degree of the first node.
+/// @param[in] list Adjacency list. Every node must have the same
+/// number of links.
+/// @return View of `list`.
+template <std::size_t N = std::dynamic_extent, typename T>
+RegularAdjacencyList<const T, N, std::span<const T>>
+regular_view(const AdjacencyList<T>& list)
+{
+  const std::vector<std::int32_t>& offsets = list.offsets();
+  const int degree = offsets.size() > 1 ? offsets[1] - offsets[0] : 0;
+  for (std::size_t i = 1; i < offsets.size(); ++i)
+  {
+    if (offsets[i] - offsets[i - 1] != degree)
+      throw std::runtime_error("AdjacencyList does not have constant degree.");
+  }
+
+  return RegularAdjacencyList<const T, N, std::span<const T>>(
+      std::span<const T>(list.array()),
+      (N == std::dynamic_extent or offsets.size() > 1) ? degree : N);
+}
+
 } // namespace dolfinx::graph
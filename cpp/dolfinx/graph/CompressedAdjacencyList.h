@@ -0,0 +1,355 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "AdjacencyList.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace dolfinx::graph
+{
+/// @brief Read-only adjacency list with compressed storage.
+///
+/// The number of links of each node and its links are stored as a
+/// stream of unsigned 32-bit integers that are encoded using the
+/// StreamVByte layout, i.e. 2-bit length codes (one to four bytes) for
+/// groups of four integers are stored in a control array that is
+/// separate from the little-endian data bytes. The first link of a node
+/// is stored as the difference to the first link of the previous node,
+/// and the following links as the difference to the previous link of
+/// the node. The differences are zig-zag encoded, such that links that
+/// are sorted, or close to the links of the previous node, are stored
+/// with one or two bytes.
+///
+/// The nodes are grouped into blocks of CompressedAdjacencyList::block
+/// nodes, with the position of the first node of each block in the
+/// stream stored, such that the links of a node can be decoded after
+/// at most `block - 1` nodes have been skipped. Iteration over all
+/// nodes (in order) decodes each value only once.
+///
+/// @tparam T Link type. It must be an integral type of at most 32
+/// bits.
+template <typename T>
+class CompressedAdjacencyList
+{
+  static_assert(std::is_integral_v<T> and sizeof(T) <= 4);
+
+  // Position in the stream of encoded values
+  struct position_t
+  {
+    // Index of the value
+    std::size_t value;
+
+    // Position of the first byte of the value in the data array
+    std::size_t byte;
+  };
+
+public:
+  /// Number of nodes in a block
+  static constexpr std::int32_t block = 64;
+
+  /// @brief Compress an adjacency list.
+  /// @param[in] list Adjacency list to compress, e.g. a connectivity
+  /// returned by mesh::Topology::connectivity.
+  explicit CompressedAdjacencyList(const AdjacencyList<T>& list)
+      : _num_nodes(list.num_nodes()), _num_links(list.array().size())
+  {
+    const std::int32_t num_blocks = (_num_nodes + block - 1) / block;
+    _blocks.reserve(num_blocks + 1);
+    std::size_t num_values = 0;
+    std::uint32_t first = 0;
+    for (std::int32_t n = 0; n < _num_nodes; ++n)
+    {
+      if (n % block == 0)
+      {
+        _blocks.push_back({num_values, _data.size()});
+        first = 0;
+      }
+
+      std::span<const T> links = list.links(n);
+      push_back(num_values, links.size());
+      if (!links.empty())
+      {
+        push_back(num_values, zigzag(std::uint32_t(links[0]) - first));
+        first = std::uint32_t(links[0]);
+      }
+      for (std::size_t i = 1; i < links.size(); ++i)
+      {
+        std::uint32_t d
+            = std::uint32_t(links[i]) - std::uint32_t(links[i - 1]);
+        push_back(num_values, zigzag(d));
+      }
+    }
+    _blocks.push_back({num_values, _data.size()});
+
+    _control.shrink_to_fit();
+    _data.shrink_to_fit();
+  }
+
+  /// Copy constructor
+  CompressedAdjacencyList(const CompressedAdjacencyList& list) = default;
+
+  /// Move constructor
+  CompressedAdjacencyList(CompressedAdjacencyList&& list) = default;
+
+  /// Destructor
+  ~CompressedAdjacencyList() = default;
+
+  /// Assignment operator
+  CompressedAdjacencyList& operator=(const CompressedAdjacencyList& list)
+      = default;
+
+  /// Move assignment operator
+  CompressedAdjacencyList& operator=(CompressedAdjacencyList&& list)
+      = default;
+
+  /// @brief Input iterator over the nodes of the adjacency list. It
+  /// dereferences to the links of the current node.
+  class iterator
+  {
+  public:
+    /// @private
+    using iterator_category = std::input_iterator_tag;
+    /// @private
+    using value_type = std::span<const T>;
+    /// @private
+    using difference_type = std::ptrdiff_t;
+
+    /// @private
+    iterator() = default;
+
+    /// @private
+    iterator(const CompressedAdjacencyList* list, std::int32_t node)
+        : _list(list), _node(node)
+    {
+      if (_node < _list->_num_nodes)
+      {
+        _pos = _list->_blocks[_node / block];
+        decode();
+      }
+    }
+
+    /// Links of the current node
+    value_type operator*() const { return _links; }
+
+    /// Advance to the next node
+    iterator& operator++()
+    {
+      ++_node;
+      if (_node < _list->_num_nodes)
+        decode();
+      return *this;
+    }
+
+    /// Advance to the next node
+    void operator++(int) { ++*this; }
+
+    /// Index of the current node
+    std::int32_t node() const { return _node; }
+
+    /// Equality operator
+    bool operator==(const iterator& other) const
+    {
+      return _node == other._node;
+    }
+
+  private:
+    // Decode the links of the current node
+    void decode()
+    {
+      if (_node % block == 0)
+        _first = 0;
+      _first = _list->decode_node(_pos, _first, _links);
+    }
+
+    const CompressedAdjacencyList* _list = nullptr;
+    std::int32_t _node = 0;
+    position_t _pos = {0, 0};
+    std::uint32_t _first = 0;
+    std::vector<T> _links;
+  };
+
+  /// Iterator to the first node
+  iterator begin() const { return iterator(this, 0); }
+
+  /// Iterator to one past the last node
+  iterator end() const { return iterator(this, _num_nodes); }
+
+  /// Get the number of nodes
+  /// @return The number of nodes in the adjacency list
+  std::int32_t num_nodes() const { return _num_nodes; }
+
+  /// Number of connections for given node
+  /// @param [in] node Node index
+  /// @return The number of outgoing links (edges) from the node
+  int num_links(std::size_t node) const
+  {
+    assert(node < (std::size_t)_num_nodes);
+    position_t pos = skip_to(node, nullptr);
+    return value(pos);
+  }
+
+  /// @brief Get the links (edges) for given node.
+  /// @param [in] node Node index
+  /// @param [out] buffer Buffer that the links are decoded into. It is
+  /// resized to the number of links of the node.
+  /// @return Links of the node (a view into `buffer`).
+  std::span<const T> links(std::size_t node, std::vector<T>& buffer) const
+  {
+    assert(node < (std::size_t)_num_nodes);
+    std::uint32_t first = 0;
+    position_t pos = skip_to(node, &first);
+    decode_node(pos, first, buffer);
+    return buffer;
+  }
+
+  /// @brief Decompress the adjacency list.
+  /// @return The adjacency list with uncompressed storage.
+  AdjacencyList<T> decompress() const
+  {
+    std::vector<T> array;
+    array.reserve(_num_links);
+    std::vector<std::int32_t> offsets(1, 0);
+    offsets.reserve(_num_nodes + 1);
+    for (std::span<const T> links : *this)
+    {
+      array.insert(array.end(), links.begin(), links.end());
+      offsets.push_back(array.size());
+    }
+    return AdjacencyList<T>(std::move(array), std::move(offsets));
+  }
+
+  /// @brief Size of the compressed storage.
+  /// @return Number of bytes used to store the adjacency list.
+  std::size_t memory() const
+  {
+    return _control.size() + _data.size()
+           + _blocks.size() * sizeof(position_t);
+  }
+
+private:
+  // Zig-zag encoding of a difference of two values (modulo 2^32)
+  static std::uint32_t zigzag(std::uint32_t d)
+  {
+    return (d << 1) ^ (0u - (d >> 31));
+  }
+
+  // Inverse of zigzag
+  static std::uint32_t unzigzag(std::uint32_t z)
+  {
+    return (z >> 1) ^ (0u - (z & 1));
+  }
+
+  // Append a value to the stream
+  void push_back(std::size_t& num_values, std::uint32_t v)
+  {
+    const int len = v < (1u << 8)    ? 1
+                    : v < (1u << 16) ? 2
+                    : v < (1u << 24) ? 3
+                                     : 4;
+    if (num_values % 4 == 0)
+      _control.push_back(0);
+    _control.back() |= std::uint8_t(len - 1) << (2 * (num_values % 4));
+    for (int b = 0; b < len; ++b)
+      _data.push_back(std::uint8_t(v >> (8 * b)));
+    ++num_values;
+  }
+
+  // Number of bytes of the value at the given position
+  int length(const position_t& pos) const
+  {
+    return ((_control[pos.value / 4] >> (2 * (pos.value % 4))) & 3) + 1;
+  }
+
+  // Decode the value at the given position
+  std::uint32_t value(const position_t& pos) const
+  {
+    const int len = length(pos);
+    std::uint32_t v = 0;
+    for (int b = 0; b < len; ++b)
+      v |= std::uint32_t(_data[pos.byte + b]) << (8 * b);
+    return v;
+  }
+
+  // Decode the value at the given position and advance the position
+  std::uint32_t next(position_t& pos) const
+  {
+    const int len = length(pos);
+    std::uint32_t v = value(pos);
+    pos.byte += len;
+    ++pos.value;
+    return v;
+  }
+
+  // Position of a node in the stream. If `first` is not null, it is
+  // set to the first link of the previous node in the block (or zero).
+  position_t skip_to(std::size_t node, std::uint32_t* first) const
+  {
+    position_t pos = _blocks[node / block];
+    std::uint32_t f = 0;
+    for (std::size_t n = node - node % block; n < node; ++n)
+    {
+      std::uint32_t num_links = next(pos);
+      if (num_links > 0)
+      {
+        f += unzigzag(next(pos));
+        for (std::uint32_t i = 1; i < num_links; ++i)
+        {
+          pos.byte += length(pos);
+          ++pos.value;
+        }
+      }
+    }
+
+    if (first)
+      *first = f;
+    return pos;
+  }
+
+  // Decode the links of a node and advance the position to the next
+  // node. Returns the first link of the node, or `first` if the node
+  // has no links.
+  std::uint32_t decode_node(position_t& pos, std::uint32_t first,
+                            std::vector<T>& links) const
+  {
+    links.resize(next(pos));
+    if (links.empty())
+      return first;
+
+    std::uint32_t v = first + unzigzag(next(pos));
+    links[0] = T(v);
+    first = v;
+    for (std::size_t i = 1; i < links.size(); ++i)
+    {
+      v += unzigzag(next(pos));
+      links[i] = T(v);
+    }
+
+    return first;
+  }
+
+  // Number of nodes and total number of links
+  std::int32_t _num_nodes;
+  std::size_t _num_links;
+
+  // Position in the stream of the first node of each block, and the
+  // end of the stream
+  std::vector<position_t> _blocks;
+
+  // Length codes (2 bits per value)
+  std::vector<std::uint8_t> _control;
+
+  // Encoded values
+  std::vector<std::uint8_t> _data;
+};
+
+} // namespace dolfinx::graph
@@ -0,0 +1,78 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "colouring.h"
+#include <algorithm>
+#include <cassert>
+#include <dolfinx/common/Timer.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t>
+graph::compute_colouring(const AdjacencyList<std::int32_t>& graph)
+{
+  common::Timer timer("Graph colouring");
+
+  const std::vector<std::int32_t>& links = graph.array();
+  const std::int32_t num_nodes = graph.num_nodes();
+  const std::int32_t num_resources
+      = links.empty() ? 0 : *std::ranges::max_element(links) + 1;
+
+  // Build map from resource to nodes that touch the resource
+  std::vector<std::int32_t> r_offsets(num_resources + 1, 0);
+  for (std::int32_t r : links)
+  {
+    assert(r >= 0);
+    ++r_offsets[r + 1];
+  }
+  std::partial_sum(r_offsets.begin(), r_offsets.end(), r_offsets.begin());
+  std::vector<std::int32_t> r_nodes(r_offsets.back());
+  {
+    std::vector<std::int32_t> pos(r_offsets.begin(), std::prev(r_offsets.end()));
+    for (std::int32_t i = 0; i < num_nodes; ++i)
+      for (std::int32_t r : graph.links(i))
+        r_nodes[pos[r]++] = i;
+  }
+
+  // Colour nodes. For the current node i, forbidden[c] == i if colour c
+  // is used by a conflicting node.
+  std::vector<std::int32_t> colours(num_nodes, -1);
+  std::vector<std::int32_t> forbidden;
+  for (std::int32_t i = 0; i < num_nodes; ++i)
+  {
+    for (std::int32_t r : graph.links(i))
+    {
+      for (std::int32_t k = r_offsets[r]; k < r_offsets[r + 1]; ++k)
+      {
+        if (std::int32_t c = colours[r_nodes[k]]; c >= 0)
+          forbidden[c] = i;
+      }
+    }
+
+    auto it = std::ranges::find_if(forbidden, [i](auto f) { return f != i; });
+    colours[i] = std::distance(forbidden.begin(), it);
+    if (it == forbidden.end())
+      forbidden.push_back(-1);
+  }
+
+  // Build colour-to-node list
+  std::vector<std::int32_t> offsets(forbidden.size() + 1, 0);
+  for (std::int32_t c : colours)
+    ++offsets[c + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::int32_t> nodes(num_nodes);
+  {
+    std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+    for (std::int32_t i = 0; i < num_nodes; ++i)
+      nodes[pos[colours[i]]++] = i;
+  }
+
+  return AdjacencyList<std::int32_t>(std::move(nodes), std::move(offsets));
+}
+//-----------------------------------------------------------------------------
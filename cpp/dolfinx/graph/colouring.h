@@ -0,0 +1,34 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "AdjacencyList.h"
+#include <cstdint>
+
+namespace dolfinx::graph
+{
+/// @brief Compute a greedy colouring of nodes such that no two nodes
+/// with the same colour share a link.
+///
+/// The input is interpreted as a map from each node to the 'resources'
+/// that the node touches, e.g. from a cell to the degrees-of-freedom
+/// that it writes to. Nodes `i` and `j` conflict if `links(i)` and
+/// `links(j)` have at least one common entry. Nodes with the same
+/// colour can be processed concurrently without write conflicts.
+///
+/// Nodes are coloured in order, with each node given the lowest colour
+/// that is not used by a conflicting node that has already been
+/// coloured.
+///
+/// @param[in] graph Adjacency list where `graph.links(i)` are the
+/// (non-negative) resource indices touched by node `i`.
+/// @return Adjacency list where `links(c)` are the nodes with colour
+/// `c`. The nodes for each colour are sorted.
+AdjacencyList<std::int32_t>
+compute_colouring(const AdjacencyList<std::int32_t>& graph);
+
+} // namespace dolfinx::graph
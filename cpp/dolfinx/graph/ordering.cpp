@@ -7,11 +7,20 @@
 #include "ordering.h"
 #include "AdjacencyList.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <cassert>
+#include <cmath>
 #include <cstdint>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/sort.h>
+#include <dolfinx/common/threads.h>
 #include <limits>
+#include <numeric>
 #include <span>
+#include <utility>
 
 using namespace dolfinx;
 
@@ -353,6 +362,290 @@ gps_reorder_unlabelled(const graph::AdjacencyList<std::int32_t>& graph,
   return rv;
 }
 
+//-----------------------------------------------------------------------------
+// Order the points (rows of x) along a space-filling curve, with the
+// curve keys computed on the bounding box of the points
+std::vector<std::int32_t> reorder_sfc(std::span<const double> x,
+                                      int num_threads, bool hilbert)
+{
+  assert(x.size() % 3 == 0);
+  const std::size_t num_points = x.size() / 3;
+
+  // Compute bounding box of the points
+  constexpr double max = std::numeric_limits<double>::max();
+  constexpr double min = std::numeric_limits<double>::lowest();
+  std::vector<std::array<double, 6>> bbox(std::max(num_threads, 1),
+                                          {max, max, max, min, min, min});
+  common::run_threads(
+      num_threads,
+      [&](int thread)
+      {
+        auto [p0, p1] = common::thread_range(thread, num_points, num_threads);
+        std::array<double, 6>& b = bbox[thread];
+        for (std::size_t p = p0; p < p1; ++p)
+        {
+          for (std::size_t j = 0; j < 3; ++j)
+          {
+            b[j] = std::min(b[j], x[3 * p + j]);
+            b[3 + j] = std::max(b[3 + j], x[3 * p + j]);
+          }
+        }
+      });
+  for (std::size_t t = 1; t < bbox.size(); ++t)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      bbox[0][j] = std::min(bbox[0][j], bbox[t][j]);
+      bbox[0][3 + j] = std::max(bbox[0][3 + j], bbox[t][3 + j]);
+    }
+  }
+
+  std::vector<std::uint64_t> keys = graph::sfc_keys(
+      x,
+      {{{bbox[0][0], bbox[0][1], bbox[0][2]},
+        {bbox[0][3], bbox[0][4], bbox[0][5]}}},
+      hilbert, num_threads);
+
+  // Sort points by key and invert the permutation
+  std::vector<std::int32_t> perm(num_points);
+  std::iota(perm.begin(), perm.end(), 0);
+  dolfinx::parallel_radix_sort(perm, num_threads,
+                               [&keys](auto p) { return keys[p]; });
+  std::vector<std::int32_t> map(num_points);
+  for (std::size_t i = 0; i < num_points; ++i)
+    map[perm[i]] = i;
+
+  return map;
+}
+//-----------------------------------------------------------------------------
+// Minimum number of nodes in a connected component for a level search
+// or Cuthill-McKee numbering to be executed on more than one thread
+constexpr std::int32_t rcm_min_nodes_threaded = 1 << 16;
+
+// Atomically set x = min(x, v)
+void atomic_min(std::int32_t& x, std::int32_t v)
+{
+  std::atomic_ref<std::int32_t> a(x);
+  std::int32_t current = a.load(std::memory_order_relaxed);
+  while (v < current
+         and !a.compare_exchange_weak(current, v, std::memory_order_relaxed))
+  {
+  }
+}
+
+// Breadth-first search of the connected component of s. Nodes that are
+// reached are marked with `tag` in `mark`, which must not hold `tag`
+// for any node on entry. Returns the number of levels and a node of
+// minimum degree (smallest index for ties) in the last level. If
+// `max_nodes` nodes are reached the search is stopped and the number of
+// levels is -1.
+std::array<std::int32_t, 2>
+rcm_level_search(const graph::AdjacencyList<std::int32_t>& graph,
+                 std::int32_t s, std::span<std::int32_t> mark, std::int32_t tag,
+                 std::int32_t max_nodes, int num_threads)
+{
+  auto cmp = [&graph](auto a, auto b)
+  {
+    return std::pair(graph.num_links(a), a)
+           < std::pair(graph.num_links(b), b);
+  };
+
+  mark[s] = tag;
+  std::int32_t depth = 0;
+  if (num_threads == 1)
+  {
+    // Level of the search is nodes[l0:l1]
+    std::vector<std::int32_t> nodes = {s};
+    std::size_t l0 = 0;
+    while (l0 < nodes.size())
+    {
+      std::size_t l1 = nodes.size();
+      for (std::size_t i = l0; i < l1; ++i)
+      {
+        for (std::int32_t v : graph.links(nodes[i]))
+        {
+          if (mark[v] != tag)
+          {
+            mark[v] = tag;
+            nodes.push_back(v);
+          }
+        }
+      }
+      ++depth;
+      if (nodes.size() == l1)
+      {
+        return {depth, *std::min_element(std::next(nodes.begin(), l0),
+                                         nodes.end(), cmp)};
+      }
+      else if (static_cast<std::int32_t>(nodes.size()) >= max_nodes)
+        return {-1, s};
+      l0 = l1;
+    }
+  }
+
+  std::vector<std::int32_t> front = {s}, next;
+  std::vector<std::vector<std::int32_t>> reached(num_threads);
+  std::int32_t num_nodes = 1;
+  std::int32_t u = s;
+  std::barrier sync(num_threads);
+  common::run_threads(
+      num_threads,
+      [&](int t)
+      {
+        while (!front.empty())
+        {
+          std::vector<std::int32_t>& r = reached[t];
+          r.clear();
+          auto [i0, i1] = common::thread_range(t, front.size(), num_threads);
+          for (std::size_t i = i0; i < i1; ++i)
+          {
+            for (std::int32_t v : graph.links(front[i]))
+            {
+              std::atomic_ref<std::int32_t> m(mark[v]);
+              std::int32_t m0 = m.load(std::memory_order_relaxed);
+              if (m0 != tag
+                  and m.compare_exchange_strong(m0, tag,
+                                                std::memory_order_relaxed))
+              {
+                r.push_back(v);
+              }
+            }
+          }
+          sync.arrive_and_wait();
+
+          if (t == 0)
+          {
+            ++depth;
+            next.clear();
+            for (const std::vector<std::int32_t>& r : reached)
+              next.insert(next.end(), r.begin(), r.end());
+            num_nodes += next.size();
+            if (next.empty())
+            {
+              u = *std::ranges::min_element(front, cmp);
+            }
+            else if (num_nodes >= max_nodes)
+            {
+              depth = -1;
+              next.clear();
+            }
+            std::swap(front, next);
+          }
+          sync.arrive_and_wait();
+        }
+      });
+
+  return {depth, u};
+}
+
+// Cuthill-McKee numbering of the connected component of s. The nodes
+// are appended to `order`, and the position in `order` of each node is
+// set in `pos`. Nodes that are not yet numbered must have `pos = -1`
+// and `parent = max`. The numbering is computed one level at a time.
+// The children of a node are the unnumbered neighbours for which it is
+// the earliest numbered neighbour, and they are numbered in order of
+// their parents, by increasing degree, which is the same numbering as
+// the sequential Cuthill-McKee algorithm.
+void cuthill_mckee(const graph::AdjacencyList<std::int32_t>& graph,
+                   std::int32_t s, std::vector<std::int32_t>& order,
+                   std::span<std::int32_t> pos, std::span<std::int32_t> parent,
+                   int num_threads)
+{
+  auto degree = [&graph](auto i) { return graph.num_links(i); };
+
+  // Current level is order[l0:l1]
+  std::size_t l0 = order.size();
+  order.push_back(s);
+  pos[s] = l0;
+  std::size_t l1 = order.size();
+
+  if (num_threads == 1)
+  {
+    for (std::size_t p = l0; p < order.size(); ++p)
+    {
+      std::size_t c0 = order.size();
+      for (std::int32_t v : graph.links(order[p]))
+      {
+        if (pos[v] < 0)
+        {
+          pos[v] = order.size();
+          order.push_back(v);
+        }
+      }
+      std::stable_sort(std::next(order.begin(), c0), order.end(),
+                       [&degree](auto a, auto b)
+                       { return degree(a) < degree(b); });
+      for (std::size_t q = c0; q < order.size(); ++q)
+        pos[order[q]] = q;
+    }
+    return;
+  }
+
+  std::vector<std::int32_t> offsets;
+  std::barrier sync(num_threads);
+  common::run_threads(
+      num_threads,
+      [&](int t)
+      {
+        while (l1 > l0)
+        {
+          // Find the earliest numbered parent of the nodes of the next
+          // level
+          auto [p0, p1] = common::thread_range(t, l1 - l0, num_threads);
+          for (std::size_t p = l0 + p0; p < l0 + p1; ++p)
+          {
+            for (std::int32_t v : graph.links(order[p]))
+              if (pos[v] < 0)
+                atomic_min(parent[v], p);
+          }
+          if (t == 0)
+            offsets.assign(l1 - l0 + 1, 0);
+          sync.arrive_and_wait();
+
+          // Count the children of each node of the current level
+          for (std::size_t p = l0 + p0; p < l0 + p1; ++p)
+          {
+            for (std::int32_t v : graph.links(order[p]))
+              if (pos[v] < 0 and parent[v] == static_cast<std::int32_t>(p))
+                ++offsets[p - l0 + 1];
+          }
+          sync.arrive_and_wait();
+          if (t == 0)
+          {
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            order.resize(l1 + offsets.back());
+          }
+          sync.arrive_and_wait();
+
+          // Number the children of each node by increasing degree
+          for (std::size_t p = l0 + p0; p < l0 + p1; ++p)
+          {
+            auto c0 = std::next(order.begin(), l1 + offsets[p - l0]);
+            auto c = c0;
+            for (std::int32_t v : graph.links(order[p]))
+              if (pos[v] < 0 and parent[v] == static_cast<std::int32_t>(p))
+                *c++ = v;
+            std::stable_sort(c0, c, [&degree](auto a, auto b)
+                             { return degree(a) < degree(b); });
+          }
+          sync.arrive_and_wait();
+
+          auto [q0, q1]
+              = common::thread_range(t, order.size() - l1, num_threads);
+          for (std::size_t q = l1 + q0; q < l1 + q1; ++q)
+            pos[order[q]] = q;
+          sync.arrive_and_wait();
+          if (t == 0)
+          {
+            l0 = l1;
+            l1 = order.size();
+          }
+          sync.arrive_and_wait();
+        }
+      });
+}
+//-----------------------------------------------------------------------------
+
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -380,3 +673,177 @@ graph::reorder_gps(const graph::AdjacencyList<std::int32_t>& graph)
   return r;
 }
 //-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+graph::reorder_rcm(const graph::AdjacencyList<std::int32_t>& graph,
+                   int num_threads, bool approximate)
+{
+  common::Timer timer("Reverse Cuthill-McKee ordering");
+
+  const std::int32_t n = graph.num_nodes();
+  num_threads = std::max(num_threads, 1);
+
+  // Nodes sorted by degree (counting sort), for choosing the start node
+  // of each connected component
+  std::vector<std::int32_t> nodes(n);
+  {
+    std::int32_t max_degree = 0;
+    for (std::int32_t i = 0; i < n; ++i)
+      max_degree = std::max(max_degree, graph.num_links(i));
+    std::vector<std::int32_t> offsets(max_degree + 2, 0);
+    for (std::int32_t i = 0; i < n; ++i)
+      ++offsets[graph.num_links(i) + 1];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for (std::int32_t i = 0; i < n; ++i)
+      nodes[offsets[graph.num_links(i)]++] = i;
+  }
+
+  std::vector<std::int32_t> pos(n, -1);
+  std::vector<std::int32_t> parent(n, std::numeric_limits<std::int32_t>::max());
+  std::vector<std::int32_t> mark(n, -1);
+  std::int32_t tag = 0;
+  std::vector<std::int32_t> order;
+  order.reserve(n);
+  for (std::int32_t s : nodes)
+  {
+    if (pos[s] >= 0)
+      continue;
+
+    // Search serially first, and use threads only for large components
+    int nt = 1;
+    std::array ls = rcm_level_search(graph, s, mark, tag++,
+                                     rcm_min_nodes_threaded, 1);
+    if (ls[0] < 0)
+    {
+      nt = num_threads;
+      ls = rcm_level_search(graph, s, mark, tag++, n + 1, nt);
+    }
+    auto [depth, u] = ls;
+
+    // Find a pseudo-peripheral node of the connected component of s,
+    // i.e. a node with a level structure of (locally) maximal depth. In
+    // approximate mode the start node is taken from the last level of
+    // the first level structure.
+    if (approximate)
+      s = u;
+    else
+    {
+      while (true)
+      {
+        auto [depth_u, v] = rcm_level_search(graph, u, mark, tag++, n + 1, nt);
+        if (depth_u <= depth)
+          break;
+        s = u;
+        u = v;
+        depth = depth_u;
+      }
+    }
+
+    // Cuthill-McKee ordering of the component
+    cuthill_mckee(graph, s, order, pos, parent, nt);
+  }
+
+  // Reverse the ordering
+  std::vector<std::int32_t> r(n);
+  for (std::int32_t i = 0; i < n; ++i)
+    r[order[i]] = n - 1 - i;
+  return r;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::uint64_t>
+graph::sfc_keys(std::span<const double> x,
+                std::array<std::array<double, 3>, 2> bbox, bool hilbert,
+                int num_threads)
+{
+  assert(x.size() % 3 == 0);
+  const std::size_t num_points = x.size() / 3;
+
+  // Coordinates with non-zero extent
+  std::vector<int> axes;
+  for (int j = 0; j < 3; ++j)
+  {
+    if (bbox[1][j] > bbox[0][j])
+      axes.push_back(j);
+  }
+
+  const int d = axes.size();
+  const int bits = d > 0 ? std::min(63 / d, 32) : 0;
+  const double qmax = std::ldexp(1.0, bits) - 1;
+  std::vector<std::uint64_t> keys(num_points, 0);
+  common::parallel_for(
+      num_points, num_threads,
+      [&](std::size_t p0, std::size_t p1)
+      {
+        for (std::size_t p = p0; p < p1; ++p)
+        {
+          // Quantise coordinates
+          std::array<std::uint32_t, 3> q = {0, 0, 0};
+          for (int i = 0; i < d; ++i)
+          {
+            const int j = axes[i];
+            double s = (x[3 * p + j] - bbox[0][j])
+                       / (bbox[1][j] - bbox[0][j]);
+            s = std::clamp(s, 0.0, 1.0);
+            q[i] = static_cast<std::uint32_t>(s * qmax);
+          }
+
+          if (hilbert and d > 1)
+          {
+            // Transform coordinates to the 'transposed' Hilbert index
+            // (Skilling's AxestoTranspose algorithm)
+            for (std::uint32_t Q = 1u << (bits - 1); Q > 1; Q >>= 1)
+            {
+              const std::uint32_t P = Q - 1;
+              for (int i = 0; i < d; ++i)
+              {
+                if (q[i] & Q)
+                  q[0] ^= P;
+                else
+                {
+                  std::uint32_t t = (q[0] ^ q[i]) & P;
+                  q[0] ^= t;
+                  q[i] ^= t;
+                }
+              }
+            }
+
+            // Gray encode
+            for (int i = 1; i < d; ++i)
+              q[i] ^= q[i - 1];
+            std::uint32_t t = 0;
+            for (std::uint32_t Q = 1u << (bits - 1); Q > 1; Q >>= 1)
+            {
+              if (q[d - 1] & Q)
+                t ^= Q - 1;
+            }
+            for (int i = 0; i < d; ++i)
+              q[i] ^= t;
+          }
+
+          // Interleave bits, most significant first
+          std::uint64_t key = 0;
+          for (int b = bits - 1; b >= 0; --b)
+          {
+            for (int i = 0; i < d; ++i)
+              key = (key << 1) | ((q[i] >> b) & 1);
+          }
+          keys[p] = key;
+        }
+      });
+
+  return keys;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> graph::reorder_morton(std::span<const double> x,
+                                                int num_threads)
+{
+  common::Timer timer("Morton reordering");
+  return reorder_sfc(x, num_threads, false);
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> graph::reorder_hilbert(std::span<const double> x,
+                                                 int num_threads)
+{
+  common::Timer timer("Hilbert reordering");
+  return reorder_sfc(x, num_threads, true);
+}
+//-----------------------------------------------------------------------------
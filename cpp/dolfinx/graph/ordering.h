@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace dolfinx::graph
@@ -26,4 +28,89 @@ class AdjacencyList;
 std::vector<std::int32_t>
 reorder_gps(const graph::AdjacencyList<std::int32_t>& graph);
 
+/// @brief Re-order a graph using the reverse Cuthill-McKee algorithm.
+///
+/// The nodes of each connected component are numbered in
+/// breadth-first order from a pseudo-peripheral node, with the
+/// neighbours of a node visited by increasing degree, and the
+/// numbering is then reversed. See *Reducing the bandwidth of sparse
+/// symmetric matrices*, Proceedings of the 24th National Conference of
+/// the ACM: 157-172, 1969, https://doi.org/10.1145/800195.805928.
+///
+/// The level structures that are used to find the start nodes, and the
+/// Cuthill-McKee numbering, are computed one level at a time, with the
+/// nodes of a level processed concurrently. The numbering is the same
+/// for any number of threads. Threads are only used for connected
+/// components with many nodes. With `num_threads > 1` it is a faster
+/// alternative to reorder_gps for large graphs, e.g. for reordering the
+/// cells of a large mesh (see mesh::CellReorderFunction).
+///
+/// @param[in] graph The graph to compute a re-ordering for. It must be
+/// symmetric.
+/// @param[in] num_threads Number of threads to use.
+/// @param[in] approximate If true, the search for a pseudo-peripheral
+/// start node is stopped after the first level structure, i.e. the
+/// start node is a node of minimum degree in the last level of the
+/// level structure rooted at a node of minimum degree. This reduces the
+/// number of breadth-first searches of each connected component to
+/// two, at the cost of a possibly larger bandwidth.
+/// @return Reordering array `map`, where `map[i]` is the new index of
+/// node `i`
+std::vector<std::int32_t>
+reorder_rcm(const graph::AdjacencyList<std::int32_t>& graph,
+            int num_threads = 1, bool approximate = false);
+
+/// @brief Compute the keys of points along a space-filling curve.
+///
+/// The coordinates are scaled to a box and quantised, using `63 / d`
+/// bits (at most 32) for each of the `d` coordinates along which the
+/// box has non-zero extent. Points outside the box are moved to its
+/// boundary. Keys computed on different processes with the same box
+/// are consistent, and can be used to distribute points along the
+/// curve.
+///
+/// @param[in] x Coordinates of the points (row-major, with shape
+/// `(num_points, 3)`).
+/// @param[in] bbox Lower and upper corners of the box.
+/// @param[in] hilbert If true, compute the Hilbert index (see
+/// reorder_hilbert), otherwise the Morton index (see reorder_morton).
+/// @param[in] num_threads Number of threads to use.
+/// @return Key of each point.
+std::vector<std::uint64_t>
+sfc_keys(std::span<const double> x, std::array<std::array<double, 3>, 2> bbox,
+         bool hilbert, int num_threads = 1);
+
+/// @brief Re-order points along a Morton (Z-order) space-filling
+/// curve.
+///
+/// The coordinates are scaled to the bounding box of the points and
+/// quantised, and the points are sorted by the interleaved bits of the
+/// quantised coordinates. Coordinates with zero extent are ignored,
+/// e.g. the third coordinate of points in a plane.
+///
+/// @param[in] x Coordinates of the points (row-major, with shape
+/// `(num_points, 3)`).
+/// @param[in] num_threads Number of threads to use.
+/// @return Reordering array `map`, where `map[i]` is the new index of
+/// point `i`
+std::vector<std::int32_t> reorder_morton(std::span<const double> x,
+                                         int num_threads = 1);
+
+/// @brief Re-order points along a Hilbert space-filling curve.
+///
+/// The coordinates are scaled and quantised as in reorder_morton, and
+/// the Hilbert index is computed using the algorithm described in
+/// *Programming the Hilbert curve*, AIP Conference Proceedings 707:
+/// 381-387, 2004, https://doi.org/10.1063/1.1751381. Consecutive points
+/// along a Hilbert curve are always neighbours on the quantisation
+/// grid, which gives better locality than Morton ordering.
+///
+/// @param[in] x Coordinates of the points (row-major, with shape
+/// `(num_points, 3)`).
+/// @param[in] num_threads Number of threads to use.
+/// @return Reordering array `map`, where `map[i]` is the new index of
+/// point `i`
+std::vector<std::int32_t> reorder_hilbert(std::span<const double> x,
+                                          int num_threads = 1);
+
 } // namespace dolfinx::graph
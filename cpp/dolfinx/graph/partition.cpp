@@ -8,11 +8,17 @@
 #include "AdjacencyList.h"
 #include "partitioners.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/sort.h>
+#include <dolfinx/common/threads.h>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <stdexcept>
 
 using namespace dolfinx;
 
@@ -29,10 +35,155 @@ graph::partition_graph(MPI_Comm comm, int nparts,
 #elif HAS_KAHIP
   return graph::kahip::partitioner()(comm, nparts, local_graph, ghosting);
 #else
-// Should never reach this point
+  return graph::native::partitioner()(comm, nparts, local_graph, ghosting);
 #endif
 }
 //-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t>
+graph::extend_destinations(MPI_Comm comm,
+                           const AdjacencyList<std::int64_t>& local_graph,
+                           const AdjacencyList<std::int32_t>& destinations)
+{
+  common::Timer timer("Extend graph destination ranks by one layer");
+
+  const std::int32_t num_nodes = local_graph.num_nodes();
+  if (destinations.num_nodes() != num_nodes)
+  {
+    throw std::runtime_error(
+        "Number of destinations does not match the number of graph nodes.");
+  }
+
+  // Distribution of the graph nodes across ranks
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  std::vector<std::int64_t> node_disp(size + 1, 0);
+  {
+    const std::int64_t n = num_nodes;
+    MPI_Allgather(&n, 1, MPI_INT64_T, node_disp.data() + 1, 1, MPI_INT64_T,
+                  comm);
+    std::partial_sum(node_disp.begin(), node_disp.end(), node_disp.begin());
+  }
+  const std::int64_t range0 = node_disp[rank];
+  const std::int64_t range1 = node_disp[rank + 1];
+
+  // Wherever a node goes, so must the nodes connected to it. Build
+  // (owner of node1, node1, destination of node0) for each edge
+  // (node0, node1) and destination of node0. Edges to local nodes are
+  // handled without communication.
+  std::vector<std::array<std::int32_t, 2>> local_node_to_dest;
+  std::vector<std::array<std::int64_t, 3>> node_to_dest;
+  for (std::int32_t node0 = 0; node0 < num_nodes; ++node0)
+  {
+    auto dest0 = destinations.links(node0);
+    for (std::int64_t node1 : local_graph.links(node0))
+    {
+      if (node1 >= range0 and node1 < range1)
+      {
+        for (std::int32_t d : dest0)
+          local_node_to_dest.push_back({std::int32_t(node1 - range0), d});
+      }
+      else
+      {
+        auto it = std::ranges::upper_bound(node_disp, node1);
+        const int owner = std::distance(node_disp.begin(), it) - 1;
+        for (std::int32_t d : dest0)
+          node_to_dest.push_back({owner, node1, d});
+      }
+    }
+  }
+  std::ranges::sort(node_to_dest);
+  {
+    auto [unique_end, range_end] = std::ranges::unique(node_to_dest);
+    node_to_dest.erase(unique_end, range_end);
+  }
+
+  // Pack send data for each rank
+  std::vector<int> dest, send_sizes;
+  std::vector<std::int64_t> send_buffer;
+  for (auto it = node_to_dest.begin(); it != node_to_dest.end();)
+  {
+    dest.push_back((*it)[0]);
+    auto it1 = std::find_if(it, node_to_dest.end(), [r = dest.back()](auto& e)
+                            { return e[0] != r; });
+    send_sizes.push_back(2 * std::distance(it, it1));
+    for (; it != it1; ++it)
+    {
+      send_buffer.push_back((*it)[1]);
+      send_buffer.push_back((*it)[2]);
+    }
+  }
+  std::vector<int> send_disp(send_sizes.size() + 1, 0);
+  std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                   std::next(send_disp.begin()));
+
+  // Send (node, destination) pairs to the owners of the nodes
+  const std::vector<int> src
+      = dolfinx::MPI::compute_graph_edges_nbx(comm, dest);
+  MPI_Comm neigh_comm;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 dest.size(), dest.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm);
+  std::vector<int> recv_sizes(src.size());
+  send_sizes.reserve(1);
+  recv_sizes.reserve(1);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                        MPI_INT, neigh_comm);
+  std::vector<int> recv_disp(recv_sizes.size() + 1, 0);
+  std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                   std::next(recv_disp.begin()));
+  std::vector<std::int64_t> recv_buffer(recv_disp.back());
+  MPI_Neighbor_alltoallv(send_buffer.data(), send_sizes.data(),
+                         send_disp.data(), MPI_INT64_T, recv_buffer.data(),
+                         recv_sizes.data(), recv_disp.data(), MPI_INT64_T,
+                         neigh_comm);
+  MPI_Comm_free(&neigh_comm);
+
+  for (std::size_t i = 0; i < recv_buffer.size(); i += 2)
+  {
+    assert(recv_buffer[i] >= range0 and recv_buffer[i] < range1);
+    local_node_to_dest.push_back({std::int32_t(recv_buffer[i] - range0),
+                                  std::int32_t(recv_buffer[i + 1])});
+  }
+
+  // Add the existing destinations, with the owner marked by a
+  // negative key (-1 - rank) so that it sorts first for each node
+  for (std::int32_t node = 0; node < num_nodes; ++node)
+  {
+    auto d = destinations.links(node);
+    local_node_to_dest.push_back({node, -1 - d.front()});
+    for (std::int32_t r : d)
+      local_node_to_dest.push_back({node, r});
+  }
+  std::ranges::sort(local_node_to_dest);
+  {
+    auto [unique_end, range_end] = std::ranges::unique(local_node_to_dest);
+    local_node_to_dest.erase(unique_end, range_end);
+  }
+
+  // Build adjacency list, with the owner first and without repeating
+  // the owner
+  std::vector<std::int32_t> data, offsets(num_nodes + 1, 0);
+  data.reserve(local_node_to_dest.size() - num_nodes);
+  std::int32_t owner = -1;
+  for (auto [node, r] : local_node_to_dest)
+  {
+    if (r < 0)
+    {
+      owner = -1 - r;
+      data.push_back(owner);
+      ++offsets[node + 1];
+    }
+    else if (r != owner)
+    {
+      data.push_back(r);
+      ++offsets[node + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  return AdjacencyList<std::int32_t>(std::move(data), std::move(offsets));
+}
+//-----------------------------------------------------------------------------
 std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<int>,
            std::vector<std::int64_t>, std::vector<int>>
 graph::build::distribute(MPI_Comm comm,
@@ -229,14 +380,15 @@ std::tuple<std::vector<std::int64_t>, std::vector<int>,
            std::vector<std::int64_t>, std::vector<int>>
 graph::build::distribute(MPI_Comm comm, std::span<const std::int64_t> list,
                          std::array<std::size_t, 2> shape,
-                         const graph::AdjacencyList<std::int32_t>& destinations)
+                         const graph::AdjacencyList<std::int32_t>& destinations,
+                         std::size_t max_bytes)
 {
   common::Timer timer(
       "Distribute fixed-degree adjacency list to destination ranks");
 
   assert(list.size() == shape[0] * shape[1]);
   assert(destinations.num_nodes() == (std::int32_t)shape[0]);
-  int rank = dolfinx::MPI::rank(comm);
+  [[maybe_unused]] int rank = dolfinx::MPI::rank(comm);
   std::int64_t num_owned = destinations.num_nodes();
 
   // Get global offset for converting local index to global index for
@@ -293,88 +445,244 @@ graph::build::distribute(MPI_Comm comm, std::span<const std::int64_t> list,
                                  dest.size(), dest.data(), MPI_UNWEIGHTED,
                                  MPI_INFO_NULL, false, &neigh_comm);
 
-  // Send number of nodes to receivers
-  std::vector<int> num_items_recv(src.size());
-  num_items_per_dest.reserve(1);
-  num_items_recv.reserve(1);
-  MPI_Request request_size;
-  MPI_Ineighbor_alltoall(num_items_per_dest.data(), 1, MPI_INT,
-                         num_items_recv.data(), 1, MPI_INT, neigh_comm,
-                         &request_size);
+  // Received rows owned by this rank and ghost rows, in order of the
+  // source ranks
+  std::vector<std::int64_t> data, data1;
+  std::vector<int> ghost_index_owner;
+  std::vector<std::int64_t> global_indices, global_indices1;
+  std::vector<int> src_ranks, src_ranks1;
 
   // Compute send displacements
   std::vector<std::int32_t> send_disp(num_items_per_dest.size() + 1, 0);
   std::partial_sum(num_items_per_dest.begin(), num_items_per_dest.end(),
                    std::next(send_disp.begin()));
 
-  // Pack send buffer
-  std::vector<std::int64_t> send_buffer(buffer_shape1 * send_disp.back(), -1);
+  if (max_bytes == 0)
   {
-    assert(send_disp.back() == (std::int32_t)dest_to_index.size());
-    for (std::size_t i = 0; i < dest_to_index.size(); ++i)
+    // Send number of nodes to receivers
+    std::vector<int> num_items_recv(src.size());
+    num_items_per_dest.reserve(1);
+    num_items_recv.reserve(1);
+    MPI_Request request_size;
+    MPI_Ineighbor_alltoall(num_items_per_dest.data(), 1, MPI_INT,
+                           num_items_recv.data(), 1, MPI_INT, neigh_comm,
+                           &request_size);
+
+    // Pack send buffer
+    std::vector<std::int64_t> send_buffer(buffer_shape1 * send_disp.back(), -1);
     {
-      std::array<int, 3> dest_data = dest_to_index[i];
-      const std::size_t pos = dest_data[1];
+      assert(send_disp.back() == (std::int32_t)dest_to_index.size());
+      for (std::size_t i = 0; i < dest_to_index.size(); ++i)
+      {
+        std::array<int, 3> dest_data = dest_to_index[i];
+        const std::size_t pos = dest_data[1];
 
-      std::span b(send_buffer.data() + i * buffer_shape1, buffer_shape1);
-      std::span row(list.data() + pos * shape[1], shape[1]);
-      std::ranges::copy(row, b.begin());
+        std::span b(send_buffer.data() + i * buffer_shape1, buffer_shape1);
+        std::span row(list.data() + pos * shape[1], shape[1]);
+        std::ranges::copy(row, b.begin());
 
-      auto info = b.last(2);
-      info[0] = dest_data[2];        // Owning rank
-      info[1] = pos + offset_global; // Original global index
+        auto info = b.last(2);
+        info[0] = dest_data[2];        // Owning rank
+        info[1] = pos + offset_global; // Original global index
+      }
+    }
+
+    // Prepare receive displacement
+    MPI_Wait(&request_size, MPI_STATUS_IGNORE);
+    std::vector<std::int32_t> recv_disp(num_items_recv.size() + 1, 0);
+    std::partial_sum(num_items_recv.begin(), num_items_recv.end(),
+                     std::next(recv_disp.begin()));
+
+    // Send/receive data facet
+    MPI_Datatype compound_type;
+    MPI_Type_contiguous(buffer_shape1, MPI_INT64_T, &compound_type);
+    MPI_Type_commit(&compound_type);
+    std::vector<std::int64_t> recv_buffer(buffer_shape1 * recv_disp.back());
+    MPI_Neighbor_alltoallv(send_buffer.data(), num_items_per_dest.data(),
+                           send_disp.data(), compound_type, recv_buffer.data(),
+                           num_items_recv.data(), recv_disp.data(),
+                           compound_type, neigh_comm);
+    MPI_Type_free(&compound_type);
+    MPI_Comm_free(&neigh_comm);
+
+    SPDLOG_DEBUG("Received {} data on {} [{}]", recv_disp.back(), rank,
+                 shape[1]);
+
+    // Unpack receive buffer
+    for (std::size_t p = 0; p < recv_disp.size() - 1; ++p)
+    {
+      int src_rank = src[p];
+      for (std::int32_t q = recv_disp[p]; q < recv_disp[p + 1]; ++q)
+      {
+        std::span row(recv_buffer.data() + q * buffer_shape1, buffer_shape1);
+        auto info = row.last(2);
+        std::int64_t orig_global_index = info[1];
+        auto edges = row.first(shape[1]);
+        if (int owner = info[0]; owner == rank)
+        {
+          data.insert(data.end(), edges.begin(), edges.end());
+          global_indices.push_back(orig_global_index);
+          src_ranks.push_back(src_rank);
+        }
+        else
+        {
+          data1.insert(data1.end(), edges.begin(), edges.end());
+          global_indices1.push_back(orig_global_index);
+          ghost_index_owner.push_back(owner);
+          src_ranks1.push_back(src_rank);
+        }
+      }
     }
   }
+  else
+  {
+    // Send the rows in rounds of at most max_bytes per rank. The rows of
+    // round r + 1 are packed and sent while round r is unpacked.
+    const std::size_t chunk = std::max<std::size_t>(
+        1, max_bytes / (buffer_shape1 * sizeof(std::int64_t)));
+    std::int64_t num_rounds = 0;
+    {
+      const std::int64_t num_rounds_local
+          = (dest_to_index.size() + chunk - 1) / chunk;
+      MPI_Allreduce(&num_rounds_local, &num_rounds, 1, MPI_INT64_T, MPI_MAX,
+                    comm);
+    }
+    spdlog::info("Distribute fixed-degree adjacency list in {} rounds",
+                 num_rounds);
 
-  // Prepare receive displacement
-  MPI_Wait(&request_size, MPI_STATUS_IGNORE);
-  std::vector<std::int32_t> recv_disp(num_items_recv.size() + 1, 0);
-  std::partial_sum(num_items_recv.begin(), num_items_recv.end(),
-                   std::next(recv_disp.begin()));
+    MPI_Datatype compound_type;
+    MPI_Type_contiguous(buffer_shape1, MPI_INT64_T, &compound_type);
+    MPI_Type_commit(&compound_type);
 
-  // Send/receive data facet
-  MPI_Datatype compound_type;
-  MPI_Type_contiguous(buffer_shape1, MPI_INT64_T, &compound_type);
-  MPI_Type_commit(&compound_type);
-  std::vector<std::int64_t> recv_buffer(buffer_shape1 * recv_disp.back());
-  MPI_Neighbor_alltoallv(send_buffer.data(), num_items_per_dest.data(),
-                         send_disp.data(), compound_type, recv_buffer.data(),
-                         num_items_recv.data(), recv_disp.data(), compound_type,
-                         neigh_comm);
-  MPI_Type_free(&compound_type);
-  MPI_Comm_free(&neigh_comm);
+    // Buffers of a round
+    struct Round
+    {
+      std::vector<int> send_count, send_disp, recv_count, recv_disp;
+      std::vector<std::int64_t> send_buffer, recv_buffer;
+      MPI_Request request = MPI_REQUEST_NULL;
+    };
+
+    // Pack the rows dest_to_index[i0:i1] of round r and start sending
+    // them
+    auto start_round = [&](std::int64_t r, Round& b)
+    {
+      const std::size_t i0 = std::min(r * chunk, dest_to_index.size());
+      const std::size_t i1 = std::min(i0 + chunk, dest_to_index.size());
+      b.send_count.resize(dest.size());
+      for (std::size_t d = 0; d < dest.size(); ++d)
+      {
+        const std::size_t lo = std::max<std::size_t>(send_disp[d], i0);
+        const std::size_t hi = std::min<std::size_t>(send_disp[d + 1], i1);
+        b.send_count[d] = hi > lo ? hi - lo : 0;
+      }
+      b.send_disp.assign(dest.size() + 1, 0);
+      std::partial_sum(b.send_count.begin(), b.send_count.end(),
+                       std::next(b.send_disp.begin()));
 
-  spdlog::debug("Received {} data on {} [{}]", recv_disp.back(), rank,
-                shape[1]);
+      b.send_buffer.resize(buffer_shape1 * (i1 - i0));
+      for (std::size_t i = i0; i < i1; ++i)
+      {
+        const std::array<int, 3>& dest_data = dest_to_index[i];
+        const std::size_t pos = dest_data[1];
+        std::span buffer(b.send_buffer.data() + (i - i0) * buffer_shape1,
+                         buffer_shape1);
+        std::span row(list.data() + pos * shape[1], shape[1]);
+        std::ranges::copy(row, buffer.begin());
+        auto info = buffer.last(2);
+        info[0] = dest_data[2];        // Owning rank
+        info[1] = pos + offset_global; // Original global index
+      }
 
-  // Unpack receive buffer
-  std::vector<std::int64_t> data, data1;
-  std::vector<int> ghost_index_owner;
-  std::vector<std::int64_t> global_indices, global_indices1;
-  std::vector<int> src_ranks, src_ranks1;
-  for (std::size_t p = 0; p < recv_disp.size() - 1; ++p)
-  {
-    int src_rank = src[p];
-    for (std::int32_t q = recv_disp[p]; q < recv_disp[p + 1]; ++q)
+      b.recv_count.resize(src.size());
+      b.send_count.reserve(1);
+      b.recv_count.reserve(1);
+      MPI_Neighbor_alltoall(b.send_count.data(), 1, MPI_INT,
+                            b.recv_count.data(), 1, MPI_INT, neigh_comm);
+      b.recv_disp.assign(src.size() + 1, 0);
+      std::partial_sum(b.recv_count.begin(), b.recv_count.end(),
+                       std::next(b.recv_disp.begin()));
+      b.recv_buffer.resize(buffer_shape1 * b.recv_disp.back());
+      MPI_Ineighbor_alltoallv(
+          b.send_buffer.data(), b.send_count.data(), b.send_disp.data(),
+          compound_type, b.recv_buffer.data(), b.recv_count.data(),
+          b.recv_disp.data(), compound_type, neigh_comm, &b.request);
+    };
+
+    // Position in src of the source rank of each received owned and
+    // ghost row
+    std::vector<std::int32_t> src_pos, src_pos1;
+
+    std::array<Round, 2> rounds;
+    if (num_rounds > 0)
+      start_round(0, rounds[0]);
+    for (std::int64_t r = 0; r < num_rounds; ++r)
     {
-      std::span row(recv_buffer.data() + q * buffer_shape1, buffer_shape1);
-      auto info = row.last(2);
-      std::int64_t orig_global_index = info[1];
-      auto edges = row.first(shape[1]);
-      if (int owner = info[0]; owner == rank)
+      if (r + 1 < num_rounds)
+        start_round(r + 1, rounds[(r + 1) % 2]);
+
+      Round& b = rounds[r % 2];
+      MPI_Wait(&b.request, MPI_STATUS_IGNORE);
+      for (std::size_t p = 0; p < src.size(); ++p)
       {
-        data.insert(data.end(), edges.begin(), edges.end());
-        global_indices.push_back(orig_global_index);
-        src_ranks.push_back(src_rank);
+        for (std::int32_t q = b.recv_disp[p]; q < b.recv_disp[p + 1]; ++q)
+        {
+          std::span row(b.recv_buffer.data() + q * buffer_shape1,
+                        buffer_shape1);
+          auto info = row.last(2);
+          auto edges = row.first(shape[1]);
+          if (int owner = info[0]; owner == rank)
+          {
+            data.insert(data.end(), edges.begin(), edges.end());
+            global_indices.push_back(info[1]);
+            src_pos.push_back(p);
+          }
+          else
+          {
+            data1.insert(data1.end(), edges.begin(), edges.end());
+            global_indices1.push_back(info[1]);
+            ghost_index_owner.push_back(owner);
+            src_pos1.push_back(p);
+          }
+        }
       }
-      else
+    }
+    MPI_Type_free(&compound_type);
+    MPI_Comm_free(&neigh_comm);
+
+    // Order the rows by source rank, keeping the order of the rows from
+    // a source rank, so that the result is the same as when sending
+    // in one round
+    auto order = [&](std::span<const std::int32_t> pos,
+                     std::vector<std::int64_t>& rows,
+                     std::vector<std::int64_t>& indices,
+                     std::vector<int>* owners, std::vector<int>& ranks)
+    {
+      std::vector<std::int32_t> offsets(src.size() + 1, 0);
+      for (std::int32_t p : pos)
+        ++offsets[p + 1];
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+      std::vector<std::int64_t> rows_new(rows.size()),
+          indices_new(indices.size());
+      std::vector<int> owners_new(owners ? owners->size() : 0);
+      ranks.resize(pos.size());
+      for (std::size_t i = 0; i < pos.size(); ++i)
       {
-        data1.insert(data1.end(), edges.begin(), edges.end());
-        global_indices1.push_back(orig_global_index);
-        ghost_index_owner.push_back(owner);
-        src_ranks1.push_back(src_rank);
+        const std::int32_t j = offsets[pos[i]]++;
+        std::copy_n(std::next(rows.begin(), i * shape[1]), shape[1],
+                    std::next(rows_new.begin(), j * shape[1]));
+        indices_new[j] = indices[i];
+        if (owners)
+          owners_new[j] = (*owners)[i];
+        ranks[j] = src[pos[i]];
       }
-    }
+      rows = std::move(rows_new);
+      indices = std::move(indices_new);
+      if (owners)
+        *owners = std::move(owners_new);
+    };
+    order(src_pos, data, global_indices, nullptr, src_ranks);
+    order(src_pos1, data1, global_indices1, &ghost_index_owner, src_ranks1);
   }
 
   data.insert(data.end(), data1.begin(), data1.end());
@@ -532,7 +840,8 @@ graph::build::compute_ghost_indices(MPI_Comm comm,
 //-----------------------------------------------------------------------------
 std::vector<std::int64_t>
 graph::build::compute_local_to_global(std::span<const std::int64_t> global,
-                                      std::span<const std::int32_t> local)
+                                      std::span<const std::int32_t> local,
+                                      int num_threads)
 {
   common::Timer timer(
       "Compute-local-to-global links for global/local adjacency list");
@@ -542,43 +851,80 @@ graph::build::compute_local_to_global(std::span<const std::int64_t> global,
   if (global.size() != local.size())
     throw std::runtime_error("Data size mismatch.");
 
-  std::int32_t max_local_idx = *std::ranges::max_element(local);
-  std::vector<std::int64_t> local_to_global_list(max_local_idx + 1, -1);
-  for (std::size_t i = 0; i < local.size(); ++i)
+  if (num_threads <= 1)
   {
-    if (local_to_global_list[local[i]] == -1)
-      local_to_global_list[local[i]] = global[i];
+    std::int32_t max_local_idx = *std::ranges::max_element(local);
+    std::vector<std::int64_t> local_to_global_list(max_local_idx + 1, -1);
+    for (std::size_t i = 0; i < local.size(); ++i)
+    {
+      if (local_to_global_list[local[i]] == -1)
+        local_to_global_list[local[i]] = global[i];
+    }
+
+    return local_to_global_list;
   }
 
+  std::vector<std::int32_t> max_local(num_threads, 0);
+  const std::size_t n = local.size();
+  common::run_threads(num_threads,
+                      [&](int t)
+                      {
+                        auto [i0, i1] = common::thread_range(t, n, num_threads);
+                        auto l = local.subspan(i0, i1 - i0);
+                        if (!l.empty())
+                          max_local[t] = *std::ranges::max_element(l);
+                      });
+  const std::int32_t max_local_idx = *std::ranges::max_element(max_local);
+
+  // Each occurrence of a local index has the same global index, so the
+  // concurrent (atomic) stores of an entry write the same value
+  std::vector<std::int64_t> local_to_global_list(max_local_idx + 1, -1);
+  common::parallel_for(
+      local.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          std::atomic_ref<std::int64_t>(local_to_global_list[local[i]])
+              .store(global[i], std::memory_order_relaxed);
+        }
+      });
+
   return local_to_global_list;
 }
 //-----------------------------------------------------------------------------
 std::vector<std::int32_t> graph::build::compute_local_to_local(
     std::span<const std::int64_t> local0_to_global,
-    std::span<const std::int64_t> local1_to_global)
+    std::span<const std::int64_t> local1_to_global, int num_threads)
 {
   common::Timer timer("Compute local-to-local map");
   assert(local0_to_global.size() == local1_to_global.size());
 
-  // Compute inverse map for local1_to_global
-  std::vector<std::pair<std::int64_t, std::int32_t>> global_to_local1;
-  global_to_local1.reserve(local1_to_global.size());
-  for (auto idx_global : local1_to_global)
-    global_to_local1.push_back({idx_global, global_to_local1.size()});
-  std::ranges::sort(global_to_local1);
+  // Compute inverse map for local1_to_global, with the global indices
+  // sorted by a (threaded) radix sort
+  const std::vector<std::int32_t> perm
+      = dolfinx::sort_by_perm(local1_to_global, 1, num_threads);
+  std::vector<std::int64_t> sorted_global(perm.size());
+  common::parallel_for(perm.size(), num_threads,
+                       [&](std::size_t i0, std::size_t i1)
+                       {
+                         for (std::size_t i = i0; i < i1; ++i)
+                           sorted_global[i] = local1_to_global[perm[i]];
+                       });
 
   // Compute inverse map for local0_to_local1
-  std::vector<std::int32_t> local0_to_local1;
-  local0_to_local1.reserve(local0_to_global.size());
-  std::ranges::transform(
-      local0_to_global, std::back_inserter(local0_to_local1),
-      [&global_to_local1](auto l2g)
+  std::vector<std::int32_t> local0_to_local1(local0_to_global.size());
+  common::parallel_for(
+      local0_to_global.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
       {
-        auto it = std::ranges::lower_bound(global_to_local1, l2g,
-                                           std::ranges::less(),
-                                           [](auto e) { return e.first; });
-        assert(it != global_to_local1.end() and it->first == l2g);
-        return it->second;
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          auto it
+              = std::ranges::lower_bound(sorted_global, local0_to_global[i]);
+          assert(it != sorted_global.end() and *it == local0_to_global[i]);
+          local0_to_local1[i] = perm[std::distance(sorted_global.begin(), it)];
+        }
       });
 
   return local0_to_local1;
@@ -45,6 +45,31 @@ AdjacencyList<std::int32_t>
 partition_graph(MPI_Comm comm, int nparts,
                 const AdjacencyList<std::int64_t>& local_graph, bool ghosting);
 
+/// @brief Add a layer of ghosting to the destination ranks of the
+/// nodes of a distributed graph.
+///
+/// A node is sent to all destination ranks of the nodes that it is
+/// connected to by an edge, i.e. if the destinations describe `k`
+/// layers of ghost nodes around the nodes owned by each rank, the
+/// returned destinations describe `k + 1` layers.
+///
+/// The global index of each node is assumed to be the local index plus
+/// the offset for this rank.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator that the graph is distributed
+/// across.
+/// @param[in] local_graph Node connectivity graph.
+/// @param[in] destinations Destination ranks for each node of
+/// `local_graph`. The first rank is the 'owner' of the node.
+/// @return Extended destination ranks for each node. The first rank is
+/// the owner of the node, and is unchanged.
+AdjacencyList<std::int32_t>
+extend_destinations(MPI_Comm comm,
+                    const AdjacencyList<std::int64_t>& local_graph,
+                    const AdjacencyList<std::int32_t>& destinations);
+
 /// Tools for distributed graphs
 ///
 /// @todo Add a function that sends data to the 'owner'
@@ -80,6 +105,11 @@ distribute(MPI_Comm comm, const graph::AdjacencyList<std::int64_t>& list,
 /// @param[in] shape Shape `(num_nodes, degree)` of `list`.
 /// @param[in] destinations Destination ranks for the ith node (row) of
 /// `list`. The first rank is the 'owner' of the node.
+/// @param[in] max_bytes If non-zero, the nodes are sent in rounds of at
+/// most `max_bytes` bytes from each rank, which bounds the size of the
+/// send buffers. A round is packed and sent while the previous round is
+/// unpacked. If zero, all nodes are sent at once. Must be the same on
+/// all ranks. The result does not depend on `max_bytes`.
 /// @return
 /// 1. Received adjacency list on this process. The array shape is
 /// (num_nodes, degree). Storage is row-major.
@@ -90,7 +120,8 @@ std::tuple<std::vector<std::int64_t>, std::vector<int>,
            std::vector<std::int64_t>, std::vector<int>>
 distribute(MPI_Comm comm, std::span<const std::int64_t> list,
            std::array<std::size_t, 2> shape,
-           const graph::AdjacencyList<std::int32_t>& destinations);
+           const graph::AdjacencyList<std::int32_t>& destinations,
+           std::size_t max_bytes = 0);
 
 /// @brief Take a set of distributed input global indices, including
 /// ghosts, and determine the new global indices after remapping.
@@ -128,12 +159,14 @@ compute_ghost_indices(MPI_Comm comm,
 ///
 /// @param[in] global Adjacency list with global link indices.
 /// @param[in] local Adjacency list with local, contiguous link indices.
+/// @param[in] num_threads Number of threads.
 /// @return Map from local index to global index, which if applied to
 /// the local adjacency list indices would yield the global adjacency
 /// list.
 std::vector<std::int64_t>
 compute_local_to_global(std::span<const std::int64_t> global,
-                        std::span<const std::int32_t> local);
+                        std::span<const std::int32_t> local,
+                        int num_threads = 1);
 
 /// @brief Compute a local0-to-local1 map from two local-to-global maps
 /// with common global indices.
@@ -142,10 +175,12 @@ compute_local_to_global(std::span<const std::int64_t> global,
 /// indices
 /// @param[in] local1_to_global Map from local1 indices to global
 /// indices
+/// @param[in] num_threads Number of threads.
 /// @return Map from local0 indices to local1 indices
 std::vector<std::int32_t>
 compute_local_to_local(std::span<const std::int64_t> local0_to_global,
-                       std::span<const std::int64_t> local1_to_global);
+                       std::span<const std::int64_t> local1_to_global,
+                       int num_threads = 1);
 } // namespace build
 
 } // namespace dolfinx::graph
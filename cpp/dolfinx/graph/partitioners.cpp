@@ -6,8 +6,11 @@
 
 #include "partitioners.h"
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Scatterer.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <map>
@@ -663,3 +666,195 @@ graph::partition_fn graph::kahip::partitioner(int mode, int seed,
 }
 //----------------------------------------------------------------------------
 #endif
+//-----------------------------------------------------------------------------
+graph::partition_fn graph::native::partitioner(double imbalance,
+                                               int max_iterations)
+{
+  return [imbalance, max_iterations](
+             MPI_Comm comm, int nparts,
+             const graph::AdjacencyList<std::int64_t>& graph, bool ghosting)
+  {
+    spdlog::info("Compute graph partition using label propagation");
+    common::Timer timer("Compute graph partition (label propagation)");
+
+    const int rank = dolfinx::MPI::rank(comm);
+    const int size = dolfinx::MPI::size(comm);
+    const std::int64_t num_local_nodes = graph.num_nodes();
+    std::vector<std::int64_t> node_disp(size + 1, 0);
+    MPI_Allgather(&num_local_nodes, 1, MPI_INT64_T, node_disp.data() + 1, 1,
+                  MPI_INT64_T, comm);
+    std::partial_sum(node_disp.begin(), node_disp.end(), node_disp.begin());
+    const std::int64_t offset = node_disp[rank];
+    const std::int64_t num_nodes = node_disp.back();
+
+    // Nodes that are connected to an owned node and are owned by
+    // another rank
+    std::vector<std::int64_t> ghosts;
+    for (std::int64_t node : graph.array())
+    {
+      if (node < offset or node >= offset + num_local_nodes)
+        ghosts.push_back(node);
+    }
+    std::ranges::sort(ghosts);
+    auto [unique_end, range_end] = std::ranges::unique(ghosts);
+    ghosts.erase(unique_end, range_end);
+
+    std::vector<int> owners;
+    owners.reserve(ghosts.size());
+    for (std::int64_t node : ghosts)
+    {
+      auto it = std::ranges::upper_bound(node_disp, node);
+      owners.push_back(std::distance(node_disp.begin(), it) - 1);
+    }
+
+    // Scatterer for sending the part of owned nodes to ranks that ghost
+    // them
+    common::IndexMap map(comm, num_local_nodes, ghosts, owners);
+    common::Scatterer<> scatterer(map, 1);
+
+    // Graph edges using local indices, with ghost nodes numbered after
+    // the owned nodes
+    std::vector<std::int32_t> edges;
+    edges.reserve(graph.array().size());
+    for (std::int64_t node : graph.array())
+    {
+      if (node >= offset and node < offset + num_local_nodes)
+        edges.push_back(node - offset);
+      else
+      {
+        auto it = std::ranges::lower_bound(ghosts, node);
+        edges.push_back(num_local_nodes + std::distance(ghosts.begin(), it));
+      }
+    }
+
+    // Initial partition into blocks of the global node numbering
+    std::vector<std::int32_t> part(num_local_nodes + ghosts.size());
+    for (std::int64_t i = 0; i < num_local_nodes; ++i)
+      part[i] = ((offset + i) * nparts) / num_nodes;
+
+    const std::int64_t max_part_size
+        = std::ceil(imbalance * num_nodes / nparts);
+    std::vector<std::int64_t> part_size(nparts);
+    std::vector<std::int64_t> capacity(nparts);
+    std::vector<std::int32_t> labels;
+    std::int64_t num_moved_prev = -1;
+    for (int iter = 0; num_nodes > 0 and iter < max_iterations; ++iter)
+    {
+      // Update part of ghost nodes
+      scatterer.scatter_fwd<std::int32_t>(
+          std::span(part.data(), num_local_nodes),
+          std::span(part.data() + num_local_nodes, ghosts.size()));
+
+      // Compute global part sizes
+      std::ranges::fill(part_size, 0);
+      for (std::int64_t i = 0; i < num_local_nodes; ++i)
+        ++part_size[part[i]];
+      MPI_Allreduce(MPI_IN_PLACE, part_size.data(), nparts, MPI_INT64_T,
+                    MPI_SUM, comm);
+
+      // Number of nodes that this rank can move into each part. The
+      // free capacity of each part is divided between ranks in
+      // proportion to their number of nodes.
+      for (int p = 0; p < nparts; ++p)
+      {
+        capacity[p] = std::max<std::int64_t>(
+            0, double(max_part_size - part_size[p]) * num_local_nodes
+                   / num_nodes);
+      }
+
+      std::int64_t num_moved = 0;
+      for (std::int64_t i = 0; i < num_local_nodes; ++i)
+      {
+        if ((offset + i) % 2 != iter % 2)
+          continue;
+
+        // Count parts of the neighbours
+        labels.clear();
+        for (std::int32_t j = graph.offsets()[i]; j < graph.offsets()[i + 1];
+             ++j)
+        {
+          labels.push_back(part[edges[j]]);
+        }
+        std::ranges::sort(labels);
+
+        // Find the part with the most neighbours that has capacity,
+        // keeping the current part if it has as many neighbours
+        const std::int32_t p0 = part[i];
+        auto [it0, it1] = std::ranges::equal_range(labels, p0);
+        std::int32_t best = p0;
+        std::ptrdiff_t best_count = std::distance(it0, it1);
+        for (auto it = labels.begin(); it != labels.end();)
+        {
+          auto it_next = std::ranges::upper_bound(it, labels.end(), *it);
+          if (std::distance(it, it_next) > best_count and capacity[*it] > 0)
+          {
+            best = *it;
+            best_count = std::distance(it, it_next);
+          }
+          it = it_next;
+        }
+
+        if (best != p0)
+        {
+          part[i] = best;
+          --capacity[best];
+          ++num_moved;
+        }
+      }
+
+      MPI_Allreduce(MPI_IN_PLACE, &num_moved, 1, MPI_INT64_T, MPI_SUM, comm);
+      SPDLOG_DEBUG("Label propagation iteration {}: {} nodes moved", iter,
+                   num_moved);
+      if (num_moved == 0 and num_moved_prev == 0)
+        break;
+      num_moved_prev = num_moved;
+    }
+
+    part.resize(num_local_nodes);
+    if (ghosting)
+    {
+      return compute_destination_ranks(
+          comm, graph, node_disp,
+          std::vector<std::int64_t>(part.begin(), part.end()));
+    }
+    else
+      return regular_adjacency_list(std::vector<int>(part.begin(), part.end()),
+                                    1);
+  };
+}
+//-----------------------------------------------------------------------------
+graph::partition_fn graph::fixed::partitioner(std::vector<std::int32_t> part)
+{
+  return [part = std::move(part)](
+             MPI_Comm comm, int nparts,
+             const graph::AdjacencyList<std::int64_t>& graph, bool ghosting)
+  {
+    if (static_cast<std::int32_t>(part.size()) != graph.num_nodes())
+    {
+      throw std::runtime_error(
+          "Size of partition does not match the number of graph nodes.");
+    }
+    if (std::ranges::any_of(part, [nparts](auto p)
+                            { return p < 0 or p >= nparts; }))
+    {
+      throw std::runtime_error("Invalid destination rank in partition.");
+    }
+
+    if (ghosting)
+    {
+      const int size = dolfinx::MPI::size(comm);
+      const std::int64_t num_local_nodes = graph.num_nodes();
+      std::vector<std::int64_t> node_disp(size + 1, 0);
+      MPI_Allgather(&num_local_nodes, 1, MPI_INT64_T, node_disp.data() + 1, 1,
+                    MPI_INT64_T, comm);
+      std::partial_sum(node_disp.begin(), node_disp.end(), node_disp.begin());
+      return compute_destination_ranks(
+          comm, graph, node_disp,
+          std::vector<std::int64_t>(part.begin(), part.end()));
+    }
+    else
+      return regular_adjacency_list(std::vector<int>(part.begin(), part.end()),
+                                    1);
+  };
+}
+//-----------------------------------------------------------------------------
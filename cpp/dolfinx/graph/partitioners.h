@@ -8,6 +8,8 @@
 
 #include "partition.h"
 #include <array>
+#include <cstdint>
+#include <vector>
 
 namespace dolfinx::graph
 {
@@ -80,4 +82,49 @@ graph::partition_fn partitioner(int mode = 1, int seed = 1,
 #endif
 } // namespace kahip
 
+/// Native (dependency-free) parallel partitioner
+namespace native
+{
+/// @brief Create a graph partitioning function that uses parallel
+/// label propagation.
+///
+/// The nodes are initially partitioned into contiguous blocks of the
+/// global node numbering. The partition is then improved by
+/// iteratively moving nodes to the part that most of their neighbours
+/// belong to, subject to a bound on the size of each part. Nodes with
+/// even and odd global index are moved in alternating iterations to
+/// avoid oscillation. Each iteration requires an exchange of the part
+/// of ghost nodes with neighbouring ranks and a reduction of the part
+/// sizes.
+///
+/// The partitioner does not require an external library, but the
+/// partition quality is lower than for ParMETIS, KaHIP or PT-SCOTCH.
+/// It is used by the default partitioner if none of these libraries is
+/// available.
+///
+/// @param[in] imbalance Maximum ratio of the size of a part to the
+/// average part size
+/// @param[in] max_iterations Maximum number of label propagation
+/// iterations
+/// @return A label propagation graph partitioning function.
+graph::partition_fn partitioner(double imbalance = 1.05,
+                                int max_iterations = 20);
+} // namespace native
+
+namespace fixed
+{
+/// @brief Create a graph partitioning function that returns a given
+/// partition.
+///
+/// This re-creates a distribution that was computed before, e.g. when
+/// a mesh is restored from a checkpoint on the same number of
+/// processes, without partitioning the graph again. If ghosting is
+/// requested, the ghosts of the nodes are computed from the graph.
+///
+/// @param[in] part Destination rank of each node of the local graph
+/// on the calling process.
+/// @return A graph partitioning function.
+graph::partition_fn partitioner(std::vector<std::int32_t> part);
+} // namespace fixed
+
 } // namespace dolfinx::graph
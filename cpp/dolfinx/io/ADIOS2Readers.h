@@ -0,0 +1,408 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#ifdef HAS_ADIOS2
+
+#include "ADIOS2Writers.h"
+#include <adios2.h>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/// @file ADIOS2Readers.h
+/// @brief ADIOS2-based input readers
+
+namespace dolfinx::io
+{
+namespace adios2_reader
+{
+/// @privatesection
+template <std::floating_point T>
+using U = std::vector<
+    std::variant<std::shared_ptr<fem::Function<float, T>>,
+                 std::shared_ptr<fem::Function<double, T>>,
+                 std::shared_ptr<fem::Function<std::complex<float>, T>>,
+                 std::shared_ptr<fem::Function<std::complex<double>, T>>>>;
+} // namespace adios2_reader
+
+/// @privatesection
+namespace impl_vtx
+{
+/// @brief Read the coefficients of a Function, written by
+/// vtx_write_data, from the current step of an ADIOS2 engine.
+/// @param[in] io ADIOS2 io object.
+/// @param[in] engine ADIOS2 engine object.
+/// @param[in,out] u Function to read into.
+/// @param[in] block Block of the variables to read, i.e. the rank of
+/// the writing process.
+/// @param[in] step Step to read for random access, or no value to read
+/// from the current step.
+template <typename T, std::floating_point X>
+void vtx_read_data(adios2::IO& io, adios2::Engine& engine,
+                   fem::Function<T, X>& u, std::size_t block,
+                   std::optional<std::size_t> step = std::nullopt)
+{
+  assert(u.x());
+  auto [V, map] = output_space(u.function_space());
+  std::span<T> u_vector = u.x()->mutable_array();
+
+  // Number of components of the (padded) values, see vtx_write_data
+  std::span<const std::size_t> value_shape = V->element()->value_shape();
+  std::size_t rank = value_shape.size();
+  std::size_t num_comp = std::reduce(value_shape.begin(), value_shape.end(), 1,
+                                     std::multiplies{});
+  if (num_comp < std::pow(3, rank))
+    num_comp = std::pow(3, rank);
+
+  std::shared_ptr<const fem::DofMap> dofmap = V->dofmap();
+  assert(dofmap);
+  std::shared_ptr<const common::IndexMap> index_map = dofmap->index_map;
+  assert(index_map);
+  int index_map_bs = dofmap->index_map_bs();
+  int dofmap_bs = dofmap->bs();
+  std::size_t num_dofs = index_map_bs
+                         * (index_map->size_local() + index_map->num_ghosts())
+                         / dofmap_bs;
+
+  // Values may have been written in single precision, see
+  // VTXFieldOptions
+  using S = scalar_value_t<T>;
+  auto get = [&](const std::string& name)
+  {
+    std::vector<S> data;
+    if (adios2::Variable<S> var = io.InquireVariable<S>(name); var)
+    {
+      var.SetBlockSelection(block);
+      if (step)
+        var.SetStepSelection({*step, 1});
+      engine.Get(var, data, adios2::Mode::Sync);
+    }
+    else if (adios2::Variable<float> var_float
+             = io.InquireVariable<float>(name);
+             var_float)
+    {
+      var_float.SetBlockSelection(block);
+      if (step)
+        var_float.SetStepSelection({*step, 1});
+      std::vector<float> data_float;
+      engine.Get(var_float, data_float, adios2::Mode::Sync);
+      data.assign(data_float.begin(), data_float.end());
+    }
+    else
+    {
+      throw std::runtime_error("Variable \"" + name
+                               + "\" not found in ADIOS2 step.");
+    }
+
+    if (data.size() != num_dofs * num_comp)
+    {
+      throw std::runtime_error("Size of variable \"" + name
+                               + "\" does not match the Function.");
+    }
+    return data;
+  };
+
+  auto set = [u_vector, map = map](std::size_t i, T value)
+  { u_vector[map.empty() ? i : map[i]] = value; };
+  if constexpr (std::is_scalar_v<T>)
+  {
+    std::vector<T> data = get(u.name);
+    for (std::size_t i = 0; i < num_dofs; ++i)
+      for (int j = 0; j < index_map_bs; ++j)
+        set(i * index_map_bs + j, data[i * num_comp + j]);
+  }
+  else
+  {
+    std::vector<S> re = get(u.name + impl_adios2::field_ext[0]);
+    std::vector<S> im = get(u.name + impl_adios2::field_ext[1]);
+    for (std::size_t i = 0; i < num_dofs; ++i)
+    {
+      for (int j = 0; j < index_map_bs; ++j)
+      {
+        std::size_t k = i * num_comp + j;
+        set(i * index_map_bs + j, T(re[k], im[k]));
+      }
+    }
+  }
+}
+
+/// @brief Check that the data of a Function was written on the same
+/// partition.
+///
+/// The global indices of the nodes that were written by VTXWriter with
+/// the Function are compared with those of the space of the Function
+/// on the calling process.
+///
+/// @param[in] io ADIOS2 io object.
+/// @param[in] engine ADIOS2 engine object.
+/// @param[in] u Function to read into.
+/// @param[in] block Block of the variables to read.
+/// @param[in] step Step to read for random access, or no value to read
+/// from the current step.
+/// @return `true` if the indices are the same on all processes.
+template <typename T, std::floating_point X>
+bool vtx_check_partition(adios2::IO& io, adios2::Engine& engine,
+                         const fem::Function<T, X>& u, std::size_t block,
+                         std::optional<std::size_t> step)
+{
+  // Nodes are the geometry nodes for piecewise constant Functions,
+  // otherwise the degrees-of-freedom (see VTXWriter::write)
+  auto V = output_space(u.function_space()).first;
+  std::shared_ptr<const fem::FiniteElement<X>> element = V->element();
+  std::vector<std::int64_t> x_id;
+  if (element->space_dimension() / element->block_size() == 1)
+  {
+    std::span ids = V->mesh()->geometry().input_global_indices();
+    x_id.assign(ids.begin(), ids.end());
+  }
+  else
+    x_id = V->dofmap()->index_map->global_indices();
+
+  std::vector<std::int64_t> x_id_file;
+  adios2::Variable<std::int64_t> var
+      = io.InquireVariable<std::int64_t>("vtkOriginalPointIds");
+  if (var)
+  {
+    var.SetBlockSelection(block);
+    if (step)
+      var.SetStepSelection({*step, 1});
+    engine.Get(var, x_id_file, adios2::Mode::Sync);
+  }
+
+  int same = x_id_file == x_id;
+  MPI_Allreduce(MPI_IN_PLACE, &same, 1, MPI_INT, MPI_MIN,
+                V->mesh()->comm());
+  return same;
+}
+} // namespace impl_vtx
+
+/// @brief Reader for the fem::Function data written by VTXWriter.
+///
+/// Steps are read one at a time from a file or from an ADIOS2 streaming
+/// engine, e.g. `SST`. With a streaming engine, the Functions of a
+/// running simulation can be used for in-transit analysis or
+/// visualisation, or for coupling, without writing them to the file
+/// system.
+///
+/// Files can also be opened for random access, e.g. to reload the
+/// Functions of a chosen step for a restart or postprocessing (see
+/// read_step).
+///
+/// Each process reads the data that was written by the process with
+/// the same rank, using an ADIOS2 block selection, directly into the
+/// vectors of the Functions. The reader must therefore run on the same
+/// number of processes as the writer, and the Functions must be on the
+/// same distributed mesh and in the same spaces as the written
+/// Functions, e.g. created in the same way. This is checked with the
+/// global node indices of the first read step.
+template <std::floating_point T>
+class VTXReader
+{
+public:
+  /// @brief Create a reader for a list of fem::Functions.
+  /// @param[in] comm MPI communicator to open the file or stream on.
+  /// @param[in] filename Name of the file or stream.
+  /// @param[in] u Functions to read into. The Functions are read from
+  /// the variables with their names.
+  /// @param[in] engine ADIOS2 engine type, e.g. `BPFile` or `SST`.
+  /// @param[in] params ADIOS2 engine parameters, e.g. `OpenTimeoutSecs`
+  /// for the time that `SST` waits for a writer.
+  /// @param[in] random_access Open a file for random access to its
+  /// steps with read_step(), instead of reading the steps in order with
+  /// read(). Not supported by streaming engines.
+  VTXReader(MPI_Comm comm, const std::filesystem::path& filename,
+            const adios2_reader::U<T>& u, std::string engine = "BPFile",
+            const adios2::Params& params = {}, bool random_access = false)
+      : _adios(std::make_unique<adios2::ADIOS>(comm)),
+        _io(std::make_unique<adios2::IO>(
+            _adios->DeclareIO("VTX function reader"))),
+        _u(u), _rank(dolfinx::MPI::rank(comm)), _random_access(random_access)
+  {
+    _io->SetEngine(engine);
+    _io->SetParameters(params);
+#if ADIOS2_VERSION_MAJOR > 2                                                   \
+    or (ADIOS2_VERSION_MAJOR == 2 and ADIOS2_VERSION_MINOR >= 9)
+    adios2::Mode mode
+        = random_access ? adios2::Mode::ReadRandomAccess : adios2::Mode::Read;
+#else
+    adios2::Mode mode = adios2::Mode::Read;
+#endif
+    _engine = std::make_unique<adios2::Engine>(_io->Open(filename, mode));
+  }
+
+  // Copy constructor
+  VTXReader(const VTXReader&) = delete;
+
+  /// @brief Move constructor
+  VTXReader(VTXReader&& reader) = default;
+
+  /// @brief Destructor
+  ~VTXReader() { close(); }
+
+  /// @brief Move assignment
+  VTXReader& operator=(VTXReader&&) = default;
+
+  // Copy assignment
+  VTXReader& operator=(const VTXReader&) = delete;
+
+  /// @brief Close the file or stream.
+  void close()
+  {
+    // ADIOS2 uses `operator bool()` to test if the engine is open
+    if (_engine and *_engine)
+      _engine->Close();
+  }
+
+  /// @brief Read the next step into the Functions.
+  ///
+  /// @note The ghost values are read as well and need not be updated.
+  ///
+  /// @param[in] timeout Time in seconds to wait for the next step. If
+  /// negative, wait until a step is available or the writer has closed
+  /// the stream.
+  /// @return Time stamp of the step, or no value if the stream has
+  /// ended or no step became available within `timeout`.
+  std::optional<double> read(float timeout = -1)
+  {
+    assert(_engine);
+    if (_random_access)
+      throw std::runtime_error("Use read_step() for random access.");
+    adios2::StepStatus status
+        = _engine->BeginStep(adios2::StepMode::Read, timeout);
+    if (status == adios2::StepStatus::EndOfStream
+        or status == adios2::StepStatus::NotReady)
+    {
+      return std::nullopt;
+    }
+    else if (status != adios2::StepStatus::OK)
+      throw std::runtime_error("Failed to begin ADIOS2 step.");
+
+    adios2::Variable var_step = _io->InquireVariable<double>("step");
+    if (!var_step)
+      throw std::runtime_error("Time stamp not found in ADIOS2 step.");
+    double t = 0;
+    _engine->Get(var_step, t, adios2::Mode::Sync);
+    read_data(std::nullopt);
+    _engine->EndStep();
+
+    return t;
+  }
+
+  /// @brief Number of steps in a file opened for random access.
+  std::size_t num_steps() const
+  {
+    assert(_engine);
+    if (!_random_access)
+      throw std::runtime_error("Reader is not opened for random access.");
+    return _engine->Steps();
+  }
+
+  /// @brief Time stamps of the steps in a file opened for random
+  /// access.
+  std::vector<double> times()
+  {
+    assert(_engine);
+    const std::size_t num = num_steps();
+    adios2::Variable var_step = _io->InquireVariable<double>("step");
+    if (!var_step)
+      throw std::runtime_error("Time stamps not found in ADIOS2 file.");
+    var_step.SetStepSelection({0, num});
+    std::vector<double> t;
+    _engine->Get(var_step, t, adios2::Mode::Sync);
+    return t;
+  }
+
+  /// @brief Read a step of a file opened for random access into the
+  /// Functions.
+  ///
+  /// @note The ghost values are read as well and need not be updated.
+  ///
+  /// @param[in] step Index of the step, `0 <= step < num_steps()`.
+  /// @return Time stamp of the step.
+  double read_step(std::size_t step)
+  {
+    assert(_engine);
+    if (step >= num_steps())
+      throw std::runtime_error("ADIOS2 step index out of range.");
+    adios2::Variable var_step = _io->InquireVariable<double>("step");
+    if (!var_step)
+      throw std::runtime_error("Time stamp not found in ADIOS2 file.");
+    var_step.SetStepSelection({step, 1});
+    std::vector<double> t;
+    _engine->Get(var_step, t, adios2::Mode::Sync);
+    read_data(step);
+    return t.front();
+  }
+
+private:
+  // Read the Functions from the current step, or from a step for random
+  // access. The partition is checked with the first read.
+  void read_data(std::optional<std::size_t> step)
+  {
+    if (!_checked and !_u.empty())
+    {
+      bool same = std::visit(
+          [&](auto& u)
+          {
+            return impl_vtx::vtx_check_partition(*_io, *_engine, *u, _rank,
+                                                 step);
+          },
+          _u.front());
+      if (!same)
+      {
+        throw std::runtime_error("VTX data was written on a different mesh "
+                                 "partition or function space.");
+      }
+      _checked = true;
+    }
+
+    for (auto& v : _u)
+    {
+      std::visit(
+          [&](auto& u)
+          { impl_vtx::vtx_read_data(*_io, *_engine, *u, _rank, step); }, v);
+    }
+  }
+
+  std::unique_ptr<adios2::ADIOS> _adios;
+  std::unique_ptr<adios2::IO> _io;
+  std::unique_ptr<adios2::Engine> _engine;
+  adios2_reader::U<T> _u;
+
+  // Rank of this process, which is the block that it reads
+  int _rank;
+
+  // True if the file is opened for random access
+  bool _random_access;
+
+  // True if the partition of the data has been checked
+  bool _checked = false;
+};
+
+} // namespace dolfinx::io
+
+#endif
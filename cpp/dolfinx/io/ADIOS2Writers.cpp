@@ -17,11 +17,13 @@ using namespace dolfinx::io;
 
 //-----------------------------------------------------------------------------
 ADIOS2Writer::ADIOS2Writer(MPI_Comm comm, const std::filesystem::path& filename,
-                           std::string tag, std::string engine)
+                           std::string tag, std::string engine,
+                           const adios2::Params& params)
     : _adios(std::make_unique<adios2::ADIOS>(comm)),
       _io(std::make_unique<adios2::IO>(_adios->DeclareIO(tag)))
 {
   _io->SetEngine(engine);
+  _io->SetParameters(params);
   _engine = std::make_unique<adios2::Engine>(
       _io->Open(filename, adios2::Mode::Write));
 }
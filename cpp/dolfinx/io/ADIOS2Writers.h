@@ -15,17 +15,26 @@
 #include <cassert>
 #include <complex>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <mpi.h>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -51,6 +60,49 @@ using U = std::vector<std::variant<
     std::shared_ptr<const fem::Function<std::complex<double>, T>>>>;
 } // namespace adios2_writer
 
+/// @brief Precision and compression of the values of a fem::Function
+/// that is written by VTXWriter.
+///
+/// Reduced precision and lossy compression can reduce the size of
+/// visualisation output by an order of magnitude, with errors that are
+/// not visible in a plot.
+struct VTXFieldOptions
+{
+  /// Write double precision values in single precision.
+  bool single_precision = false;
+
+  /// Type of the ADIOS2 operator that compresses the values, e.g.
+  /// `zfp`, `sz` or `mgard` (error bounded, lossy) or `blosc`
+  /// (lossless). The values are not compressed if empty. The operator
+  /// must be available in the ADIOS2 installation.
+  std::string operator_type;
+
+  /// Parameters of the operator, e.g. `{{"accuracy", "1e-4"}}` for the
+  /// absolute error bound of `zfp`. See
+  /// https://adios2.readthedocs.io/en/latest/components/components.html#operator.
+  adios2::Params operator_params;
+};
+
+/// @brief Topology of a VTX mesh, which is constant between write
+/// steps.
+struct VTXTopology
+{
+  /// Cells as `[N0, v0_0,...., v0_N0, N1, v1_0,...., v1_N1, ....]`,
+  /// where `N` is the number of cell nodes and `v0`, etc, is the
+  /// (local) node index.
+  std::vector<std::int64_t> cells;
+
+  /// Shape `(num_cells, num_nodes_per_cell + 1)` of `cells`.
+  std::array<std::size_t, 2> shape;
+
+  /// Global index of each node. A node that is on more than one process
+  /// has the same index on all of them.
+  std::vector<std::int64_t> x_id;
+
+  /// Ghost marker of each node (1 for a ghost, otherwise 0).
+  std::vector<std::uint8_t> x_ghost;
+};
+
 /// Base class for ADIOS2-based writers
 class ADIOS2Writer
 {
@@ -61,8 +113,11 @@ protected:
   /// @param[in] tag The ADIOS2 object name
   /// @param[in] engine ADIOS2 engine type. See
   /// https://adios2.readthedocs.io/en/latest/engines/engines.html.
+  /// @param[in] params ADIOS2 engine parameters, set before the file is
+  /// opened.
   ADIOS2Writer(MPI_Comm comm, const std::filesystem::path& filename,
-               std::string tag, std::string engine);
+               std::string tag, std::string engine,
+               const adios2::Params& params = {});
 
   /// @brief Move constructor
   ADIOS2Writer(ADIOS2Writer&& writer) = default;
@@ -80,7 +135,8 @@ protected:
   ADIOS2Writer& operator=(const ADIOS2Writer&) = delete;
 
 public:
-  /// @brief  Close the file
+  /// @brief Close the file.
+  /// @note Waits for asynchronous writes of steps to complete.
   void close();
 
 protected:
@@ -193,96 +249,380 @@ extract_function_names(const typename adios2_writer::U<T>& u)
   return names;
 }
 
+/// @brief Get the space whose dof layout is used to write a Function
+/// on a space.
+///
+/// The layout of a sub-Function is that of the (cached) collapsed
+/// subspace. The values of a sub-Function are not copied, but read
+/// from the parent vector through the map from the collapsed dofs.
+///
+/// @param[in] V Function space.
+/// @return The output space and the map from its dofs to the dofs of
+/// `V`. The map is empty if `V` is not a subspace.
+template <std::floating_point T>
+std::pair<std::shared_ptr<const fem::FunctionSpace<T>>,
+          std::span<const std::int32_t>>
+output_space(std::shared_ptr<const fem::FunctionSpace<T>> V)
+{
+  assert(V);
+  if (V->component().empty())
+    return {V, {}};
+  else
+    return V->collapsed();
+}
+
+/// @brief Put the values of a variable, with the precision and
+/// compression of a field.
+/// @param[in] io ADIOS2 io object.
+/// @param[in] engine ADIOS2 engine object.
+/// @param[in] name Name of the variable.
+/// @param[in] data Values to write.
+/// @param[in] count Local shape of the values.
+/// @param[in] options Precision and compression of the values.
+template <std::floating_point T>
+void vtx_put_values(adios2::IO& io, adios2::Engine& engine,
+                    const std::string& name, std::span<const T> data,
+                    const adios2::Dims& count, const VTXFieldOptions& options)
+{
+  auto put = [&]<typename V>(std::span<const V> values)
+  {
+    adios2::Variable var
+        = impl_adios2::define_variable<V>(io, name, {}, {}, count);
+    if (!options.operator_type.empty() and var.Operations().empty())
+      var.AddOperation(options.operator_type, options.operator_params);
+    engine.Put(var, values.data(), adios2::Mode::Sync);
+  };
+
+  if constexpr (!std::is_same_v<T, float>)
+  {
+    if (options.single_precision)
+    {
+      std::vector<float> values(data.begin(), data.end());
+      put(std::span<const float>(values));
+      return;
+    }
+  }
+
+  put(data);
+}
+
+/// @brief Copy padded values to a staging buffer, in the precision of
+/// a field, and put them.
+/// @param[in] io ADIOS2 io object.
+/// @param[in] engine ADIOS2 engine object.
+/// @param[in] name Name of the variable.
+/// @param[in] num_dofs Number of (blocked) degrees-of-freedom.
+/// @param[in] num_comp Number of (padded) components of each value.
+/// @param[in] bs Number of components of each value that are set.
+/// @param[in] value Function that returns component `j` of value `i`
+/// for the argument `i * bs + j`.
+/// @param[in] options Precision and compression of the values.
+/// @param[in,out] buffer Staging buffer. It is resized if it is too
+/// small, and can be re-used for subsequent writes.
+template <std::floating_point T, typename F, class Allocator>
+void vtx_put_padded_values(adios2::IO& io, adios2::Engine& engine,
+                           const std::string& name, std::uint32_t num_dofs,
+                           std::size_t num_comp, int bs, F value,
+                           const VTXFieldOptions& options,
+                           std::vector<std::byte, Allocator>& buffer)
+{
+  auto put = [&]<typename V>(V)
+  {
+    const std::size_t size = num_dofs * num_comp;
+    if (buffer.size() < size * sizeof(V))
+      buffer.resize(size * sizeof(V));
+    assert(reinterpret_cast<std::uintptr_t>(buffer.data()) % alignof(V) == 0);
+    std::span data(reinterpret_cast<V*>(buffer.data()), size);
+    std::ranges::fill(data, 0);
+    for (std::size_t i = 0; i < num_dofs; ++i)
+      for (int j = 0; j < bs; ++j)
+        data[i * num_comp + j] = value(i * bs + j);
+    vtx_put_values<V>(io, engine, name, data, {num_dofs, num_comp}, options);
+  };
+
+  if (options.single_precision)
+    put(float());
+  else
+    put(T());
+}
+
 /// Given a Function, write the coefficient to file using ADIOS2.
 /// @note Only supports (discontinuous) Lagrange functions.
 /// @note For a complex function, the coefficient is split into a real
 /// and imaginary function.
 /// @note Data is padded to be three dimensional if vector and 9
 /// dimensional if tensor.
+/// @note A sub-Function is written in the dof layout of its collapsed
+/// space (see output_space), with values read from the parent vector.
 /// @param[in] io ADIOS2 io object.
 /// @param[in] engine ADIOS2 engine object.
 /// @param[in] u Function to write.
-template <typename T, std::floating_point X>
+/// @param[in] options Precision and compression of the values.
+/// @param[in,out] buffer Staging buffer for the values, which is
+/// re-used by subsequent writes.
+/// @param[in] rows (Blocked) degrees-of-freedom to write, e.g. for
+/// the output of a subset of cells (see vtx_restrict). All
+/// degrees-of-freedom are written if empty.
+template <typename T, std::floating_point X, class Allocator>
 void vtx_write_data(adios2::IO& io, adios2::Engine& engine,
-                    const fem::Function<T, X>& u)
+                    const fem::Function<T, X>& u,
+                    const VTXFieldOptions& options,
+                    std::vector<std::byte, Allocator>& buffer,
+                    std::span<const std::int32_t> rows = {})
 {
   // Get function data array and information about layout
   assert(u.x());
+  auto [V, map] = output_space(u.function_space());
   std::span<const T> u_vector = u.x()->array();
+  auto u_value = [u_vector, map = map](std::size_t i)
+  { return map.empty() ? u_vector[i] : u_vector[map[i]]; };
 
   // Pad to 3D if vector/tensor is product of dimensions is smaller than
   // 3**rank to ensure that we can visualize them correctly in Paraview
-  std::span<const std::size_t> value_shape
-      = u.function_space()->element()->value_shape();
+  std::span<const std::size_t> value_shape = V->element()->value_shape();
   std::size_t rank = value_shape.size();
   std::size_t num_comp = std::reduce(value_shape.begin(), value_shape.end(), 1,
                                      std::multiplies{});
   if (num_comp < std::pow(3, rank))
     num_comp = std::pow(3, rank);
 
-  std::shared_ptr<const fem::DofMap> dofmap = u.function_space()->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap = V->dofmap();
   assert(dofmap);
   std::shared_ptr<const common::IndexMap> index_map = dofmap->index_map;
   assert(index_map);
   int index_map_bs = dofmap->index_map_bs();
   int dofmap_bs = dofmap->bs();
-  std::uint32_t num_dofs = index_map_bs
+  std::uint32_t num_dofs
+      = rows.empty() ? index_map_bs
                            * (index_map->size_local() + index_map->num_ghosts())
-                           / dofmap_bs;
+                           / dofmap_bs
+                     : rows.size();
+  auto value = [&u_value, rows, index_map_bs](std::size_t i)
+  {
+    return rows.empty() ? u_value(i)
+                        : u_value(rows[i / index_map_bs] * index_map_bs
+                                  + i % index_map_bs);
+  };
+
   if constexpr (std::is_scalar_v<T>)
   {
     // ---- Real
-    std::vector<T> data(num_dofs * num_comp, 0);
-    for (std::size_t i = 0; i < num_dofs; ++i)
-      for (int j = 0; j < index_map_bs; ++j)
-        data[i * num_comp + j] = u_vector[i * index_map_bs + j];
-
-    adios2::Variable output = impl_adios2::define_variable<T>(
-        io, u.name, {}, {}, {num_dofs, num_comp});
-    engine.Put(output, data.data(), adios2::Mode::Sync);
+    vtx_put_padded_values<T>(io, engine, u.name, num_dofs, num_comp,
+                             index_map_bs, value, options, buffer);
   }
   else
   {
     // ---- Complex
     using U = typename T::value_type;
+    vtx_put_padded_values<U>(
+        io, engine, u.name + impl_adios2::field_ext[0], num_dofs, num_comp,
+        index_map_bs, [&value](auto i) { return std::real(value(i)); },
+        options, buffer);
+    vtx_put_padded_values<U>(
+        io, engine, u.name + impl_adios2::field_ext[1], num_dofs, num_comp,
+        index_map_bs, [&value](auto i) { return std::imag(value(i)); },
+        options, buffer);
+  }
+}
 
-    std::vector<U> data(num_dofs * num_comp, 0);
-    for (std::size_t i = 0; i < num_dofs; ++i)
-      for (int j = 0; j < index_map_bs; ++j)
-        data[i * num_comp + j] = std::real(u_vector[i * index_map_bs + j]);
+/// @brief Pack cells for VTX output.
+/// @param[in] vtk Cell nodes in VTK ordering, shape `(num_cells,
+/// num_nodes)`.
+/// @param[in] shape Shape of `vtk`.
+/// @return Cells as `[N0, v0_0,...., v0_N0, N1, v1_0,...., v1_N1,
+/// ....]`, where `N` is the number of cell nodes and `v0`, etc, is the
+/// node index.
+inline std::vector<std::int64_t>
+vtx_pack_cells(std::span<const std::int64_t> vtk,
+               std::array<std::size_t, 2> shape)
+{
+  std::vector<std::int64_t> cells(shape[0] * (shape[1] + 1), shape[1]);
+  for (std::size_t c = 0; c < shape[0]; ++c)
+  {
+    std::span vtkcell(vtk.data() + c * shape[1], shape[1]);
+    std::span cell(cells.data() + c * (shape[1] + 1), shape[1] + 1);
+    std::ranges::copy(vtkcell, std::next(cell.begin()));
+  }
+  return cells;
+}
 
-    adios2::Variable output_real = impl_adios2::define_variable<U>(
-        io, u.name + impl_adios2::field_ext[0], {}, {}, {num_dofs, num_comp});
-    engine.Put(output_real, data.data(), adios2::Mode::Sync);
+/// @brief Compute the VTX topology of a mesh, with a point at each
+/// geometry node.
+/// @param[in] mesh The mesh.
+/// @return The topology.
+template <std::floating_point T>
+VTXTopology vtx_topology(const mesh::Mesh<T>& mesh)
+{
+  const mesh::Geometry<T>& geometry = mesh.geometry();
+  auto topology = mesh.topology();
+  assert(topology);
+  auto [vtkcells, shape]
+      = io::extract_vtk_connectivity(geometry.dofmap(), topology->cell_type());
 
-    std::ranges::fill(data, 0);
-    for (std::size_t i = 0; i < num_dofs; ++i)
-      for (int j = 0; j < index_map_bs; ++j)
-        data[i * num_comp + j] = std::imag(u_vector[i * index_map_bs + j]);
-    adios2::Variable output_imag = impl_adios2::define_variable<U>(
-        io, u.name + impl_adios2::field_ext[1], {}, {}, {num_dofs, num_comp});
-    engine.Put(output_imag, data.data(), adios2::Mode::Sync);
+  std::shared_ptr<const common::IndexMap> x_map = geometry.index_map();
+  const std::size_t num_nodes = x_map->size_local() + x_map->num_ghosts();
+  std::vector<std::uint8_t> x_ghost(num_nodes, 0);
+  std::fill(std::next(x_ghost.begin(), x_map->size_local()), x_ghost.end(), 1);
+  std::span x_id = geometry.input_global_indices();
+  return {vtx_pack_cells(vtkcells, shape),
+          {shape[0], shape[1] + 1},
+          std::vector<std::int64_t>(x_id.begin(), x_id.end()),
+          std::move(x_ghost)};
+}
+
+/// @brief Compute the VTX topology of the VTK mesh of a function space,
+/// with a point at each (scalar) degree-of-freedom.
+/// @note Only supports (discontinuous) Lagrange functions.
+/// @param[in] V The function space.
+/// @return The topology.
+template <std::floating_point T>
+VTXTopology vtx_topology(const fem::FunctionSpace<T>& V)
+{
+  auto mesh = V.mesh();
+  assert(mesh);
+  auto topology = mesh->topology();
+  assert(topology);
+  assert(V.element());
+  if (V.element()->is_mixed())
+    throw std::runtime_error("Can't create VTK mesh from a mixed element");
+
+  // Cell nodes in VTK ordering
+  auto dofmap = V.dofmap();
+  assert(dofmap);
+  auto map = topology->index_map(topology->dim());
+  const std::size_t num_cells = map->size_local() + map->num_ghosts();
+  const std::uint32_t num_nodes
+      = V.element()->space_dimension() / V.element()->block_size();
+  const std::vector<std::uint16_t> vtkmap = io::cells::transpose(
+      io::cells::perm_vtk(topology->cell_type(), num_nodes));
+  std::vector<std::int64_t> vtk(num_cells * num_nodes);
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    auto dofs = dofmap->cell_dofs(c);
+    for (std::size_t i = 0; i < dofs.size(); ++i)
+      vtk[c * num_nodes + i] = dofs[vtkmap[i]];
   }
+
+  // Global index and ghost marker of each node
+  std::shared_ptr<const common::IndexMap> map_dofs = dofmap->index_map;
+  const std::int32_t size_local = map_dofs->size_local();
+  const std::size_t num_points = size_local + map_dofs->num_ghosts();
+  std::vector<std::int64_t> x_id(num_points);
+  std::iota(x_id.begin(), std::next(x_id.begin(), size_local),
+            map_dofs->local_range()[0]);
+  std::ranges::copy(map_dofs->ghosts(), std::next(x_id.begin(), size_local));
+  std::vector<std::uint8_t> x_ghost(num_points, 0);
+  std::fill(std::next(x_ghost.begin(), size_local), x_ghost.end(), 1);
+
+  return {vtx_pack_cells(vtk, {num_cells, num_nodes}),
+          {num_cells, num_nodes + 1},
+          std::move(x_id),
+          std::move(x_ghost)};
+}
+
+/// @brief Restrict a VTX topology to a subset of its cells.
+/// @param[in] topology The topology.
+/// @param[in] cells Indices of the cells of the subset.
+/// @return The nodes of the subset, i.e. the (sorted) indices in
+/// `topology` of the nodes of the cells, and the topology of the
+/// subset, with the cells numbered by their position in `cells` and the
+/// nodes by their position in the list of nodes.
+inline std::pair<std::vector<std::int32_t>, VTXTopology>
+vtx_restrict(const VTXTopology& topology, std::span<const std::int32_t> cells)
+{
+  const std::size_t row_size = topology.shape[1];
+  std::vector<std::int32_t> nodes;
+  nodes.reserve(cells.size() * (row_size - 1));
+  for (std::int32_t c : cells)
+  {
+    auto cell = std::span(topology.cells).subspan(c * row_size, row_size);
+    nodes.insert(nodes.end(), std::next(cell.begin()), cell.end());
+  }
+  std::ranges::sort(nodes);
+  auto [unique_end, range_end] = std::ranges::unique(nodes);
+  nodes.erase(unique_end, range_end);
+
+  VTXTopology sub;
+  sub.shape = {cells.size(), row_size};
+  sub.cells.reserve(cells.size() * row_size);
+  for (std::int32_t c : cells)
+  {
+    auto cell = std::span(topology.cells).subspan(c * row_size, row_size);
+    sub.cells.push_back(cell.front());
+    for (std::int64_t n : cell.subspan(1))
+    {
+      auto it = std::ranges::lower_bound(nodes, n);
+      sub.cells.push_back(std::distance(nodes.begin(), it));
+    }
+  }
+
+  sub.x_id.reserve(nodes.size());
+  sub.x_ghost.reserve(nodes.size());
+  for (std::int32_t n : nodes)
+  {
+    sub.x_id.push_back(topology.x_id[n]);
+    sub.x_ghost.push_back(topology.x_ghost[n]);
+  }
+
+  return {std::move(nodes), std::move(sub)};
+}
+
+/// @brief Copy the rows of the nodes of a subset from a row-major array
+/// of node coordinates with 3 components.
+/// @param[in] x Coordinates of all nodes.
+/// @param[in] nodes Nodes of the subset. All nodes are used if empty.
+/// @param[in,out] buffer Buffer for the coordinates of a subset.
+/// @return Coordinates of the nodes.
+template <typename T>
+std::span<const T> vtx_extract_nodes(std::span<const T> x,
+                                     std::span<const std::int32_t> nodes,
+                                     std::vector<T>& buffer)
+{
+  if (nodes.empty())
+    return x;
+  buffer.resize(3 * nodes.size());
+  for (std::size_t i = 0; i < nodes.size(); ++i)
+    for (std::size_t j = 0; j < 3; ++j)
+      buffer[3 * i + j] = x[3 * nodes[i] + j];
+  return buffer;
+}
+
+/// @brief Put the node global ids and ghost markers of a VTX topology.
+/// @param[in] io The ADIOS2 io object
+/// @param[in] engine The ADIOS2 engine object
+/// @param[in] topology The topology
+inline void vtx_put_node_ids(adios2::IO& io, adios2::Engine& engine,
+                             const VTXTopology& topology)
+{
+  adios2::Variable orig_id = impl_adios2::define_variable<std::int64_t>(
+      io, "vtkOriginalPointIds", {}, {}, {topology.x_id.size()});
+  engine.Put(orig_id, topology.x_id.data());
+  adios2::Variable ghost = impl_adios2::define_variable<std::uint8_t>(
+      io, "vtkGhostType", {}, {}, {topology.x_ghost.size()});
+  engine.Put(ghost, topology.x_ghost.data());
 }
 
 /// Write mesh to file using VTX format
 /// @param[in] io The ADIOS2 io object
 /// @param[in] engine The ADIOS2 engine object
 /// @param[in] mesh The mesh
+/// @param[in] topology VTX topology of the mesh (see vtx_topology).
+/// @param[in] nodes Geometry nodes of `topology`, if it is the topology
+/// of a subset of the cells (see vtx_restrict). All nodes if empty.
 template <std::floating_point T>
 void vtx_write_mesh(adios2::IO& io, adios2::Engine& engine,
-                    const mesh::Mesh<T>& mesh)
+                    const mesh::Mesh<T>& mesh, const VTXTopology& topology,
+                    std::span<const std::int32_t> nodes = {})
 {
   const mesh::Geometry<T>& geometry = mesh.geometry();
-  auto topology = mesh.topology();
-  assert(topology);
 
   // "Put" geometry
-  std::shared_ptr<const common::IndexMap> x_map = geometry.index_map();
-  std::uint32_t num_vertices = x_map->size_local() + x_map->num_ghosts();
+  std::uint32_t num_vertices = topology.x_id.size();
   adios2::Variable local_geometry = impl_adios2::define_variable<T>(
       io, "geometry", {}, {}, {num_vertices, 3});
-  engine.Put(local_geometry, geometry.x().data());
+  std::vector<T> x_nodes;
+  engine.Put(local_geometry,
+             vtx_extract_nodes(geometry.x(), nodes, x_nodes).data());
 
   // Put number of nodes. The mesh data is written with local indices,
   // therefore we need the ghost vertices.
@@ -290,92 +630,66 @@ void vtx_write_mesh(adios2::IO& io, adios2::Engine& engine,
       io, "NumberOfNodes", {adios2::LocalValueDim});
   engine.Put<std::uint32_t>(vertices, num_vertices);
 
-  auto [vtkcells, shape]
-      = io::extract_vtk_connectivity(geometry.dofmap(), topology->cell_type());
-
   // Add cell metadata
-  int tdim = topology->dim();
+  auto mesh_topology = mesh.topology();
+  assert(mesh_topology);
+  int tdim = mesh_topology->dim();
   adios2::Variable cell_var = impl_adios2::define_variable<std::uint32_t>(
       io, "NumberOfCells", {adios2::LocalValueDim});
-  engine.Put<std::uint32_t>(cell_var, shape[0]);
+  engine.Put<std::uint32_t>(cell_var, topology.shape[0]);
   adios2::Variable celltype_var
       = impl_adios2::define_variable<std::uint32_t>(io, "types");
   engine.Put<std::uint32_t>(
-      celltype_var, cells::get_vtk_cell_type(topology->cell_type(), tdim));
-
-  // Pack mesh 'nodes'. Output is written as [N0, v0_0,...., v0_N0, N1,
-  // v1_0,...., v1_N1,....], where N is the number of cell nodes and v0,
-  // etc, is the node index
-  std::vector<std::int64_t> cells(shape[0] * (shape[1] + 1), shape[1]);
-  for (std::size_t c = 0; c < shape[0]; ++c)
-  {
-    std::span vtkcell(vtkcells.data() + c * shape[1], shape[1]);
-    std::span cell(cells.data() + c * (shape[1] + 1), shape[1] + 1);
-    std::ranges::copy(vtkcell, std::next(cell.begin()));
-  }
+      celltype_var,
+      cells::get_vtk_cell_type(mesh_topology->cell_type(), tdim));
 
   // Put topology (nodes)
   adios2::Variable local_topology = impl_adios2::define_variable<std::int64_t>(
-      io, "connectivity", {}, {}, {shape[0], shape[1] + 1});
-  engine.Put(local_topology, cells.data());
+      io, "connectivity", {}, {}, {topology.shape[0], topology.shape[1]});
+  engine.Put(local_topology, topology.cells.data());
 
   // Vertex global ids and ghost markers
-  adios2::Variable orig_id = impl_adios2::define_variable<std::int64_t>(
-      io, "vtkOriginalPointIds", {}, {}, {num_vertices});
-  engine.Put(orig_id, geometry.input_global_indices().data());
-
-  std::vector<std::uint8_t> x_ghost(num_vertices, 0);
-  std::fill(std::next(x_ghost.begin(), x_map->size_local()), x_ghost.end(), 1);
-  adios2::Variable ghost = impl_adios2::define_variable<std::uint8_t>(
-      io, "vtkGhostType", {}, {}, {x_ghost.size()});
-  engine.Put(ghost, x_ghost.data());
+  vtx_put_node_ids(io, engine, topology);
   engine.PerformPuts();
 }
 
-/// @brief Given a FunctionSpace, create a topology and geometry based
-/// on the function space dof coordinates. Writes the topology and
-/// geometry using ADIOS2 in VTX format.
+/// @brief Given a FunctionSpace, create a geometry based on the
+/// function space dof coordinates. Writes the topology and geometry
+/// using ADIOS2 in VTX format.
 /// @note Only supports (discontinuous) Lagrange functions.
 /// @param[in] io The ADIOS2 io object
 /// @param[in] engine The ADIOS2 engine object
 /// @param[in] V The function space
+/// @param[in] topology VTX topology of `V` (see vtx_topology).
+/// @param[in] nodes Degrees-of-freedom of `topology`, if it is the
+/// topology of a subset of the cells (see vtx_restrict). All
+/// degrees-of-freedom if empty.
 template <std::floating_point T>
-std::pair<std::vector<std::int64_t>, std::vector<std::uint8_t>>
-vtx_write_mesh_from_space(adios2::IO& io, adios2::Engine& engine,
-                          const fem::FunctionSpace<T>& V)
+void vtx_write_mesh_from_space(adios2::IO& io, adios2::Engine& engine,
+                               const fem::FunctionSpace<T>& V,
+                               const VTXTopology& topology,
+                               std::span<const std::int32_t> nodes = {})
 {
   auto mesh = V.mesh();
   assert(mesh);
-  auto topology = mesh->topology();
-  assert(topology);
-  int tdim = topology->dim();
-
-  // Get a VTK mesh with points at the 'nodes'
-  auto [x, xshape, x_id, x_ghost, vtk, vtkshape] = io::vtk_mesh_from_space(V);
-
-  std::uint32_t num_dofs = xshape[0];
-
-  // -- Pack mesh 'nodes'. Output is written as [N0, v0_0,...., v0_N0, N1,
-  // v1_0,...., v1_N1,....], where N is the number of cell nodes and v0,
-  // etc, is the node index.
-
-  // Create vector, setting all entries to nodes per cell (vtk.shape(1))
-  std::vector<std::int64_t> cells(vtkshape[0] * (vtkshape[1] + 1), vtkshape[1]);
-
-  // Set the [v0_0,...., v0_N0, v1_0,...., v1_N1,....] data
-  for (std::size_t c = 0; c < vtkshape[0]; ++c)
-  {
-    std::span vtkcell(vtk.data() + c * vtkshape[1], vtkshape[1]);
-    std::span cell(cells.data() + c * (vtkshape[1] + 1), vtkshape[1] + 1);
-    std::ranges::copy(vtkcell, std::next(cell.begin()));
-  }
+  auto mesh_topology = mesh->topology();
+  assert(mesh_topology);
+  int tdim = mesh_topology->dim();
+
+  // Coordinates of the 'nodes'
+  auto [x, xshape, x_id, x_ghost]
+      = io::impl::tabulate_lagrange_dof_coordinates(V);
+  std::vector<T> x_nodes;
+  std::span<const T> x_out
+      = vtx_extract_nodes(std::span<const T>(x), nodes, x_nodes);
+  std::uint32_t num_dofs = topology.x_id.size();
 
   // Define ADIOS2 variables for geometry, topology, celltypes and
   // corresponding VTK data
   adios2::Variable local_geometry
       = impl_adios2::define_variable<T>(io, "geometry", {}, {}, {num_dofs, 3});
   adios2::Variable local_topology = impl_adios2::define_variable<std::int64_t>(
-      io, "connectivity", {}, {}, {vtkshape[0], vtkshape[1] + 1});
+      io, "connectivity", {}, {}, {topology.shape[0], topology.shape[1]});
   adios2::Variable cell_type
       = impl_adios2::define_variable<std::uint32_t>(io, "types");
   adios2::Variable vertices = impl_adios2::define_variable<std::uint32_t>(
@@ -385,23 +699,29 @@ vtx_write_mesh_from_space(adios2::IO& io, adios2::Engine& engine,
 
   // Write mesh information to file
   engine.Put<std::uint32_t>(vertices, num_dofs);
-  engine.Put<std::uint32_t>(elements, vtkshape[0]);
+  engine.Put<std::uint32_t>(elements, topology.shape[0]);
   engine.Put<std::uint32_t>(
-      cell_type, cells::get_vtk_cell_type(topology->cell_type(), tdim));
-  engine.Put(local_geometry, x.data());
-  engine.Put(local_topology, cells.data());
+      cell_type, cells::get_vtk_cell_type(mesh_topology->cell_type(), tdim));
+  engine.Put(local_geometry, x_out.data());
+  engine.Put(local_topology, topology.cells.data());
 
   // Node global ids
-  adios2::Variable orig_id = impl_adios2::define_variable<std::int64_t>(
-      io, "vtkOriginalPointIds", {}, {}, {x_id.size()});
-  engine.Put(orig_id, x_id.data());
-  adios2::Variable ghost = impl_adios2::define_variable<std::uint8_t>(
-      io, "vtkGhostType", {}, {}, {x_ghost.size()});
-  engine.Put(ghost, x_ghost.data());
-
+  vtx_put_node_ids(io, engine, topology);
   engine.PerformPuts();
-  return {std::move(x_id), std::move(x_ghost)};
 }
+/// @brief ADIOS2 engine parameters for VTX output.
+/// @param[in] async_write Write steps to disk in a background thread
+/// (BP5 engine).
+/// @param[in] params Other engine parameters.
+/// @return Engine parameters.
+inline adios2::Params engine_params(bool async_write,
+                                    adios2::Params params = {})
+{
+  if (async_write)
+    params.insert_or_assign("AsyncWrite", "true");
+  return params;
+}
+
 } // namespace impl_vtx
 
 /// Mesh reuse policy
@@ -412,12 +732,80 @@ enum class VTXMeshPolicy
           ///< written to file
 };
 
+/// @brief Cache of the VTX topologies of meshes and function spaces.
+///
+/// The topology of the VTK mesh of a function space, with a point at
+/// each (scalar) degree-of-freedom, is computed when it is first
+/// written and re-used by later steps, for which only the point
+/// coordinates are computed. A cache can be shared by several
+/// VTXWriter objects, e.g. writers for different groups of output
+/// fields on the same spaces (see VTXWriter::set_mesh_cache).
+///
+/// @note The mesh topology and the dofmaps must not change while the
+/// cache is in use.
+template <std::floating_point T>
+class VTXMeshCache
+{
+public:
+  /// @brief VTX topology of a mesh, with a point at each geometry node.
+  /// @param[in] mesh The mesh.
+  /// @return The topology.
+  const VTXTopology& topology(std::shared_ptr<const mesh::Mesh<T>> mesh)
+  {
+    assert(mesh);
+    auto it = _topologies.find(mesh.get());
+    if (it == _topologies.end())
+    {
+      it = _topologies
+               .emplace(mesh.get(),
+                        std::pair(mesh, impl_vtx::vtx_topology(*mesh)))
+               .first;
+    }
+    return it->second.second;
+  }
+
+  /// @brief VTX topology of the VTK mesh of a function space, with a
+  /// point at each (scalar) degree-of-freedom.
+  /// @param[in] V The function space.
+  /// @return The topology.
+  const VTXTopology& topology(const fem::FunctionSpace<T>& V)
+  {
+    std::shared_ptr<const fem::DofMap> dofmap = V.dofmap();
+    assert(dofmap);
+    auto it = _topologies.find(dofmap.get());
+    if (it == _topologies.end())
+    {
+      it = _topologies
+               .emplace(dofmap.get(),
+                        std::pair(dofmap, impl_vtx::vtx_topology(V)))
+               .first;
+    }
+    return it->second.second;
+  }
+
+private:
+  // Topologies by the address of the mesh or the dofmap. The pointer
+  // keeps the object alive, so that the address is not re-used.
+  std::map<const void*, std::pair<std::shared_ptr<const void>, VTXTopology>>
+      _topologies;
+};
+
 /// @brief Writer for meshes and functions using the ADIOS2 VTX format,
 /// see
 /// https://adios2.readthedocs.io/en/latest/ecosystem/visualization.html#using-vtk-and-paraview.
 ///
 /// The output files can be visualized using ParaView.
-template <std::floating_point T>
+///
+/// The values of the Functions are copied to a staging buffer before
+/// they are passed to ADIOS2. The buffer is allocated with `Allocator`
+/// and is re-used by all writes, e.g. page-locked memory (see
+/// common::PinnedAllocator) for transfers to RDMA-capable staging
+/// engines. The allocator must return memory that is aligned for
+/// `double`.
+///
+/// @tparam T Geometry type.
+/// @tparam Allocator Allocator for the staging buffer.
+template <std::floating_point T, class Allocator = std::allocator<std::byte>>
 class VTXWriter : public ADIOS2Writer
 {
 public:
@@ -429,14 +817,17 @@ public:
   /// @param[in] filename Name of output file.
   /// @param[in] mesh Mesh to write.
   /// @param[in] engine ADIOS2 engine type.
+  /// @param[in] params ADIOS2 engine parameters, see the constructor
+  /// for fem::Functions.
   /// @note This format supports arbitrary degree meshes.
   /// @note The mesh geometry can be updated between write steps but the
   /// topology should not be changed between write steps.
   VTXWriter(MPI_Comm comm, const std::filesystem::path& filename,
             std::shared_ptr<const mesh::Mesh<T>> mesh,
-            std::string engine = "BPFile")
-      : ADIOS2Writer(comm, filename, "VTX mesh writer", engine), _mesh(mesh),
-        _mesh_reuse_policy(VTXMeshPolicy::update), _is_piecewise_constant(false)
+            std::string engine = "BPFile", const adios2::Params& params = {})
+      : ADIOS2Writer(comm, filename, "VTX mesh writer", engine, params),
+        _mesh(mesh), _mesh_reuse_policy(VTXMeshPolicy::update),
+        _is_piecewise_constant(false)
   {
     // Define VTK scheme attribute for mesh
     std::string vtk_scheme = impl_vtx::create_vtk_schema({}, {}).str();
@@ -457,20 +848,44 @@ public:
   /// @param[in] mesh_policy Controls if the mesh is written to file at
   /// the first time step only or is re-written (updated) at each time
   /// step.
+  /// @param[in] async_write If `true`, write() returns once the data of
+  /// a step has been copied into the ADIOS2 buffers, and the step is
+  /// written to disk by a background thread while the next step is
+  /// computed. At most one step is in flight; the next step and close()
+  /// wait for it to complete. Requires the BP5 engine (the default
+  /// `BPFile` engine for ADIOS2 >= 2.9), and is ignored by other
+  /// engines.
+  /// @param[in] params ADIOS2 engine parameters. For the streaming
+  /// engines, e.g. `SST`, these control the coupling with the readers
+  /// of the stream, e.g. `RendezvousReaderCount` (number of readers
+  /// that must connect before the first step is written),
+  /// `QueueLimit` (number of steps that are kept until they have been
+  /// read) and `QueueFullPolicy` (`Block` to wait for the readers when
+  /// the queue is full, or `Discard` to drop steps). See
+  /// https://adios2.readthedocs.io/en/latest/engines/engines.html.
   /// @note This format supports arbitrary degree meshes.
+  /// @note With streaming engines and VTXMeshPolicy::reuse, the mesh is
+  /// sent with the first step only. Readers that need the mesh must
+  /// then be connected before the first step.
   VTXWriter(MPI_Comm comm, const std::filesystem::path& filename,
             const typename adios2_writer::U<T>& u, std::string engine,
-            VTXMeshPolicy mesh_policy = VTXMeshPolicy::update)
-      : ADIOS2Writer(comm, filename, "VTX function writer", engine),
+            VTXMeshPolicy mesh_policy = VTXMeshPolicy::update,
+            bool async_write = false, const adios2::Params& params = {})
+      : ADIOS2Writer(comm, filename, "VTX function writer", engine,
+                     impl_vtx::engine_params(async_write, params)),
         _mesh(impl_adios2::extract_common_mesh<T>(u)), _u(u),
         _mesh_reuse_policy(mesh_policy), _is_piecewise_constant(false)
   {
     if (u.empty())
       throw std::runtime_error("VTXWriter fem::Function list is empty.");
 
-    // Extract space from first function
-    auto V0 = std::visit([](auto& u) { return u->function_space().get(); },
-                         u.front());
+    // Extract space from first function. The dofmap of a sub-Function
+    // is that of the collapsed subspace.
+    auto V0 = std::visit(
+                  [](auto& u)
+                  { return impl_vtx::output_space(u->function_space()); },
+                  u.front())
+                  .first;
     assert(V0);
     auto element0 = V0->element().get();
     assert(element0);
@@ -511,7 +926,9 @@ public:
             }
 #ifndef NDEBUG
             auto dmap0 = V0->dofmap()->map();
-            auto dmap = u->function_space()->dofmap()->map();
+            auto dmap = impl_vtx::output_space(u->function_space())
+                            .first->dofmap()
+                            ->map();
             if (dmap0.size() != dmap.size()
                 or !std::equal(dmap0.data_handle(),
                                dmap0.data_handle() + dmap0.size(),
@@ -549,11 +966,14 @@ public:
   /// @param[in] mesh_policy Controls if the mesh is written to file at
   /// the first time step only or is re-written (updated) at each time
   /// step.
+  /// @param[in] async_write Write steps to disk in the background, see
+  /// the constructor with an ADIOS2 engine.
   /// @note This format supports arbitrary degree meshes.
   VTXWriter(MPI_Comm comm, const std::filesystem::path& filename,
             const typename adios2_writer::U<T>& u,
-            VTXMeshPolicy mesh_policy = VTXMeshPolicy::update)
-      : VTXWriter(comm, filename, u, "BPFile", mesh_policy)
+            VTXMeshPolicy mesh_policy = VTXMeshPolicy::update,
+            bool async_write = false)
+      : VTXWriter(comm, filename, u, "BPFile", mesh_policy, async_write)
   {
   }
 
@@ -572,7 +992,85 @@ public:
   // Copy assignment
   VTXWriter& operator=(const VTXWriter&) = delete;
 
+  /// @brief Set the precision and compression of the values of a
+  /// fem::Function.
+  ///
+  /// Each Function can be written differently, e.g. an output field
+  /// for visualisation in single precision with error bounded
+  /// compression, and a field for restarts or post-processing with full
+  /// precision.
+  ///
+  /// @note Must be called before the first write.
+  /// @param[in] name Name of the Function.
+  /// @param[in] options Precision and compression of the values.
+  void set_field_options(const std::string& name,
+                         const VTXFieldOptions& options)
+  {
+    assert(_io);
+    if (_io->template InquireVariable<double>("step"))
+    {
+      throw std::runtime_error(
+          "Field options must be set before the first write.");
+    }
+    _field_options.insert_or_assign(name, options);
+  }
+
+  /// @brief Set the cache of the VTX mesh topologies.
+  ///
+  /// By default each writer has its own cache. Writers that share a
+  /// cache compute the topology of their mesh only once.
+  ///
+  /// @note Must be called before the first write.
+  /// @param[in] cache The cache.
+  void set_mesh_cache(std::shared_ptr<VTXMeshCache<T>> cache)
+  {
+    assert(_io);
+    if (_io->template InquireVariable<double>("step"))
+    {
+      throw std::runtime_error(
+          "Mesh cache must be set before the first write.");
+    }
+    if (!cache)
+      throw std::runtime_error("Mesh cache must not be null.");
+    _mesh_cache = cache;
+  }
+
+  /// @brief Restrict the output to a subset of the cells, e.g. a
+  /// region of interest that is written more often than the full
+  /// field.
+  ///
+  /// Only the nodes of the cells and the values at these nodes are
+  /// written. The restricted topology and the indices of the nodes are
+  /// computed with the first write and re-used by later writes. Writers
+  /// for the full field and for regions can share a mesh cache (see
+  /// set_mesh_cache).
+  ///
+  /// @note Must be called before the first write.
+  /// @param[in] cells Local indices of the cells to write, typically
+  /// owned cells. A cell that is in the subsets of several processes is
+  /// written more than once.
+  void set_cells(std::span<const std::int32_t> cells)
+  {
+    assert(_io);
+    if (_io->template InquireVariable<double>("step"))
+      throw std::runtime_error("Cells must be set before the first write.");
+    auto map = _mesh->topology()->index_map(_mesh->topology()->dim());
+    assert(map);
+    const std::int32_t num_cells = map->size_local() + map->num_ghosts();
+    if (std::ranges::any_of(cells, [num_cells](auto c)
+                            { return c < 0 or c >= num_cells; }))
+    {
+      throw std::runtime_error("Invalid cell index in VTXWriter subset.");
+    }
+    _cells.assign(cells.begin(), cells.end());
+  }
+
   /// @brief Write data with a given time stamp.
+  ///
+  /// The data is copied into the ADIOS2 buffers, so the Functions can
+  /// be modified when this function returns, also for asynchronous
+  /// writes.
+  ///
   /// @param[in] t Time stamp to associate with output.
   void write(double t)
   {
@@ -587,48 +1085,43 @@ public:
     // If we have no functions or DG functions write the mesh to file
     if (_is_piecewise_constant or _u.empty())
     {
-      impl_vtx::vtx_write_mesh(*_io, *_engine, *_mesh);
+      const VTXTopology& topology = restrict(_mesh_cache->topology(_mesh));
+      impl_vtx::vtx_write_mesh(*_io, *_engine, *_mesh, topology,
+                               _subset_nodes);
       if (_is_piecewise_constant)
       {
         for (auto& v : _u)
         {
-          std::visit([&](auto& u)
-                     { impl_vtx::vtx_write_data(*_io, *_engine, *u); }, v);
+          std::visit([&](auto& u) { write_data(*u); }, v);
         }
       }
     }
     else
     {
+      // Write a single mesh for functions as they share finite
+      // element. The topology is computed once and cached.
+      auto V = std::visit(
+                   [](auto& u)
+                   { return impl_vtx::output_space(u->function_space()); },
+                   _u[0])
+                   .first;
+      const VTXTopology& topology = restrict(_mesh_cache->topology(*V));
       if (_mesh_reuse_policy == VTXMeshPolicy::update
           or !(_io->template InquireVariable<std::int64_t>("connectivity")))
       {
-        // Write a single mesh for functions as they share finite
-        // element
-        std::tie(_x_id, _x_ghost) = std::visit(
-            [&](auto& u)
-            {
-              return impl_vtx::vtx_write_mesh_from_space(*_io, *_engine,
-                                                         *u->function_space());
-            },
-            _u[0]);
+        impl_vtx::vtx_write_mesh_from_space(*_io, *_engine, *V, topology,
+                                            _subset_nodes);
       }
       else
       {
-        // Node global ids
-        adios2::Variable orig_id = impl_adios2::define_variable<std::int64_t>(
-            *_io, "vtkOriginalPointIds", {}, {}, {_x_id.size()});
-        _engine->Put(orig_id, _x_id.data());
-        adios2::Variable ghost = impl_adios2::define_variable<std::uint8_t>(
-            *_io, "vtkGhostType", {}, {}, {_x_ghost.size()});
-        _engine->Put(ghost, _x_ghost.data());
+        impl_vtx::vtx_put_node_ids(*_io, *_engine, topology);
         _engine->PerformPuts();
       }
 
       // Write function data for each function to file
       for (auto& v : _u)
       {
-        std::visit([&](auto& u)
-                   { impl_vtx::vtx_write_data(*_io, *_engine, *u); }, v);
+        std::visit([&](auto& u) { write_data(*u); }, v);
       }
     }
 
@@ -636,17 +1129,74 @@ public:
   }
 
 private:
+  // Topology of the output: the full topology, or its restriction to
+  // the subset of cells, which is computed once
+  const VTXTopology& restrict(const VTXTopology& topology)
+  {
+    if (_cells.empty())
+      return topology;
+    if (!_subset)
+    {
+      auto [nodes, sub] = impl_vtx::vtx_restrict(topology, _cells);
+      _subset_nodes = std::move(nodes);
+      _subset = std::move(sub);
+    }
+    return *_subset;
+  }
+
+  // Write the values of a Function with its field options. For a
+  // subset, the values are those of the nodes of the subset, or of its
+  // cells for piecewise constant Functions.
+  template <typename S>
+  void write_data(const fem::Function<S, T>& u)
+  {
+    std::span<const std::int32_t> rows = _subset_nodes;
+    if (_is_piecewise_constant and !_cells.empty())
+    {
+      if (_cell_dofs.empty())
+      {
+        auto V = impl_vtx::output_space(u.function_space()).first;
+        std::shared_ptr<const fem::DofMap> dofmap = V->dofmap();
+        for (std::int32_t c : _cells)
+          _cell_dofs.push_back(dofmap->cell_dofs(c).front());
+      }
+      rows = _cell_dofs;
+    }
+
+    auto it = _field_options.find(u.name);
+    impl_vtx::vtx_write_data(*_io, *_engine, u,
+                             it == _field_options.end() ? VTXFieldOptions{}
+                                                        : it->second,
+                             _buffer, rows);
+  }
+
   std::shared_ptr<const mesh::Mesh<T>> _mesh;
   adios2_writer::U<T> _u;
 
+  // Precision and compression of the Functions, by name
+  std::map<std::string, VTXFieldOptions> _field_options;
+
   // Control whether the mesh is written to file once or at every time
   // step
   VTXMeshPolicy _mesh_reuse_policy;
-  std::vector<std::int64_t> _x_id;
-  std::vector<std::uint8_t> _x_ghost;
+
+  // Topologies of the VTK meshes, which may be shared with other
+  // writers
+  std::shared_ptr<VTXMeshCache<T>> _mesh_cache
+      = std::make_shared<VTXMeshCache<T>>();
 
   // Special handling of piecewise constant functions
   bool _is_piecewise_constant;
+
+  // Cells of the output subset (all cells if empty), and the topology,
+  // nodes and piecewise constant degrees-of-freedom of the subset
+  std::vector<std::int32_t> _cells;
+  std::optional<VTXTopology> _subset;
+  std::vector<std::int32_t> _subset_nodes;
+  std::vector<std::int32_t> _cell_dofs;
+
+  // Staging buffer for the values of the Functions
+  std::vector<std::byte, Allocator> _buffer;
 };
 
 /// Type deduction
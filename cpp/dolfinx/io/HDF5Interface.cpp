@@ -53,7 +53,19 @@ bool has_group(hid_t handle, const std::string& group_name)
 
 //-----------------------------------------------------------------------------
 hid_t io::hdf5::open_file(MPI_Comm comm, const std::filesystem::path& filename,
-                          const std::string& mode, bool use_mpi_io)
+                          const std::string& mode, bool use_mpi_io,
+                          int num_aggregators)
+{
+  // Collective buffering implies collective metadata writes
+  FileOptions options;
+  options.num_aggregators = num_aggregators;
+  options.collective_metadata_write = num_aggregators > 0;
+  return open_file(comm, filename, mode, use_mpi_io, options);
+}
+//-----------------------------------------------------------------------------
+hid_t io::hdf5::open_file(MPI_Comm comm, const std::filesystem::path& filename,
+                          const std::string& mode, bool use_mpi_io,
+                          const FileOptions& options)
 {
   // Set parallel access with communicator
   const hid_t plist_id = H5Pcreate(H5P_FILE_ACCESS);
@@ -62,9 +74,51 @@ hid_t io::hdf5::open_file(MPI_Comm comm, const std::filesystem::path& filename,
   {
     MPI_Info info;
     MPI_Info_create(&info);
+    if (options.num_aggregators > 0)
+    {
+      // Collective buffering hints, which are understood by ROMIO and
+      // OMPIO. Unknown hints are ignored by MPI.
+      const std::string cb_nodes = std::to_string(options.num_aggregators);
+      MPI_Info_set(info, "cb_nodes", cb_nodes.c_str());
+      MPI_Info_set(info, "romio_cb_write", "enable");
+      MPI_Info_set(info, "romio_cb_read", "enable");
+    }
+    for (auto& [key, value] : options.mpi_hints)
+      MPI_Info_set(info, key.c_str(), value.c_str());
     if (H5Pset_fapl_mpio(plist_id, comm, info) < 0)
       throw std::runtime_error("Call to H5Pset_fapl_mpio unsuccessful");
     MPI_Info_free(&info);
+
+    // Write and read metadata collectively, rather than independently
+    // from every process
+    if (options.collective_metadata_write
+        and H5Pset_coll_metadata_write(plist_id, true) < 0)
+    {
+      throw std::runtime_error("Call to H5Pset_coll_metadata_write failed");
+    }
+    if (options.collective_metadata_read
+        and H5Pset_all_coll_metadata_ops(plist_id, true) < 0)
+    {
+      throw std::runtime_error("Call to H5Pset_all_coll_metadata_ops failed");
+    }
+
+    if (options.alignment > 0
+        and H5Pset_alignment(plist_id, options.alignment_threshold,
+                             options.alignment)
+                < 0)
+    {
+      throw std::runtime_error("Call to H5Pset_alignment failed");
+    }
+    if (options.meta_block_size > 0
+        and H5Pset_meta_block_size(plist_id, options.meta_block_size) < 0)
+    {
+      throw std::runtime_error("Call to H5Pset_meta_block_size failed");
+    }
+    if (options.sieve_buffer_size > 0
+        and H5Pset_sieve_buf_size(plist_id, options.sieve_buffer_size) < 0)
+    {
+      throw std::runtime_error("Call to H5Pset_sieve_buf_size failed");
+    }
   }
 
   hid_t file_id = -1;
@@ -6,16 +6,21 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <dolfinx/common/log.h>
 #include <filesystem>
 #include <hdf5.h>
 #include <mpi.h>
 #include <numeric>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::io::hdf5
@@ -51,13 +56,76 @@ hid_t hdf5_type()
   }
 }
 
+/// @brief Access options of a HDF5 file opened with MPI-IO.
+///
+/// The options must be the same on all processes.
+struct FileOptions
+{
+  /// Number of processes that aggregate the data of collective reads
+  /// and writes (MPI-IO collective buffering), see open_file. If 0, the
+  /// MPI-IO default is used.
+  int num_aggregators = 0;
+
+  /// Write metadata collectively. Otherwise every process writes the
+  /// metadata in the file, which dominates the time to write small
+  /// datasets at large process counts.
+  bool collective_metadata_write = false;
+
+  /// Perform metadata reads (e.g. opening datasets and groups)
+  /// collectively, rather than independently on every process. All
+  /// processes must then open and inspect datasets, groups and
+  /// attributes together, or the program hangs.
+  bool collective_metadata_read = false;
+
+  /// Align file objects of at least @p alignment_threshold bytes to
+  /// multiples of @p alignment bytes, e.g. the stripe size of a
+  /// parallel file system. Not aligned if 0.
+  hsize_t alignment = 0;
+
+  /// Size in bytes above which file objects are aligned.
+  hsize_t alignment_threshold = 1;
+
+  /// Size in bytes of the block in which the metadata is aggregated
+  /// in the file. The HDF5 default is used if 0.
+  hsize_t meta_block_size = 0;
+
+  /// Size in bytes of the data sieve buffer for partial I/O of
+  /// contiguous datasets. The HDF5 default is used if 0.
+  std::size_t sieve_buffer_size = 0;
+
+  /// MPI-IO hints, e.g. `{"striping_factor", "16"}` and
+  /// `{"striping_unit", "4194304"}` for the striping of a new file on
+  /// Lustre. Unknown hints are ignored by MPI.
+  std::vector<std::pair<std::string, std::string>> mpi_hints = {};
+};
+
 /// Open HDF5 and return file descriptor
 /// @param[in] comm MPI communicator
 /// @param[in] filename Name of the HDF5 file to open
 /// @param[in] mode Mode in which to open the file (w, r, a)
 /// @param[in] use_mpi_io True if MPI-IO should be used
+/// @param[in] options Access options of the file with MPI-IO. Ignored
+/// if @p use_mpi_io is false.
 hid_t open_file(MPI_Comm comm, const std::filesystem::path& filename,
-                const std::string& mode, bool use_mpi_io);
+                const std::string& mode, bool use_mpi_io,
+                const FileOptions& options);
+
+/// Open HDF5 and return file descriptor
+/// @param[in] comm MPI communicator
+/// @param[in] filename Name of the HDF5 file to open
+/// @param[in] mode Mode in which to open the file (w, r, a)
+/// @param[in] use_mpi_io True if MPI-IO should be used
+/// @param[in] num_aggregators Number of processes that aggregate the
+/// data of collective reads and writes, and access the file in large
+/// contiguous blocks (MPI-IO collective buffering). This reduces lock
+/// contention on parallel file systems at large process counts, e.g.
+/// one or two aggregators per node or per storage target. If 0, the
+/// MPI-IO default is used. If positive, metadata is also written
+/// collectively (FileOptions::collective_metadata_write). Ignored if @p
+/// use_mpi_io is false.
+hid_t open_file(MPI_Comm comm, const std::filesystem::path& filename,
+                const std::string& mode, bool use_mpi_io,
+                int num_aggregators = 0);
 
 /// Close HDF5 file
 /// @param[in] handle HDF5 file handle
@@ -113,6 +181,48 @@ bool get_mpi_atomicity(hid_t handle);
 /// @param[in] dataset_path Data set path to add
 void add_group(hid_t handle, const std::string& dataset_path);
 
+/// @brief Storage options for datasets written by write_dataset.
+///
+/// Compressed datasets are stored in chunks. In parallel, filtered
+/// datasets are written collectively, which requires HDF5 >= 1.10.2.
+struct DatasetOptions
+{
+  /// Store the dataset in chunks. Chunking is always used if a filter
+  /// is set.
+  bool chunking = false;
+
+  /// Target size of a chunk in bytes. A chunk holds whole rows, and
+  /// not more rows than the largest local range.
+  std::size_t chunk_bytes = 1 << 20;
+
+  /// Shuffle the bytes of the values before compression. This
+  /// typically increases the compression of floating point data.
+  bool shuffle = false;
+
+  /// Deflate (gzip) compression level, 1-9. No deflate if 0.
+  int deflate = 0;
+
+  /// Identifier of a registered HDF5 filter plugin, e.g. 32013 (ZFP),
+  /// 32001 (Blosc) or 32004 (LZ4). No plugin if 0.
+  H5Z_filter_t filter = 0;
+
+  /// Parameters ('client data') of the filter plugin.
+  std::vector<unsigned int> filter_params;
+
+  /// Write the data of all processes collectively with MPI-IO, or
+  /// independently, which avoids the synchronisation of collective
+  /// writes when the processes write very different amounts of data.
+  /// Filtered (compressed) datasets are always written collectively.
+  bool collective = true;
+
+  /// Number of bits of floating point values in the file, 32 or 16.
+  /// Values with more bits are rounded by HDF5 when they are written,
+  /// which reduces the size of visualisation output by 2-4x. Values are
+  /// stored with their own precision if 0. Half precision requires
+  /// HDF5 >= 1.14.4.
+  int float_bits = 0;
+};
+
 /// Write data to existing HDF file as defined by range blocks on each
 /// process
 /// @param[in] file_handle HDF5 file handle
@@ -122,12 +232,13 @@ void add_group(hid_t handle, const std::string& dataset_path);
 /// @param[in] range The local range on this processor
 /// @param[in] global_size The global shape shape of the array
 /// @param[in] use_mpi_io True if MPI-IO should be used
-/// @param[in] use_chunking True if chunking should be used
+/// @param[in] options Chunking and compression of the dataset. Must be
+/// the same on all processes.
 template <typename T>
 void write_dataset(hid_t file_handle, const std::string& dataset_path,
                    const T* data, std::array<std::int64_t, 2> range,
                    const std::vector<int64_t>& global_size, bool use_mpi_io,
-                   bool use_chunking)
+                   const DatasetOptions& options = {})
 {
   // Data rank
   const int rank = global_size.size();
@@ -141,6 +252,33 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
   // Get HDF5 data type
   const hid_t h5type = hdf5::hdf5_type<T>();
 
+  // HDF5 data type in the file. HDF5 converts the values when they are
+  // written.
+  hid_t file_type = h5type;
+  if constexpr (std::is_floating_point_v<T>)
+  {
+    if (options.float_bits > 0 and options.float_bits < int(8 * sizeof(T)))
+    {
+      if (options.float_bits == 32)
+        file_type = H5T_IEEE_F32LE;
+      else if (options.float_bits == 16)
+      {
+#ifdef H5T_IEEE_F16LE
+        file_type = H5T_IEEE_F16LE;
+#else
+        throw std::runtime_error(
+            "Half precision datasets require HDF5 >= 1.14.4.");
+#endif
+      }
+      else
+      {
+        throw std::runtime_error("Unsupported number of bits of floating "
+                                 "point values: "
+                                 + std::to_string(options.float_bits));
+      }
+    }
+  }
+
   // Hyperslab selection parameters
   std::vector<hsize_t> count(global_size.begin(), global_size.end());
   count[0] = range[1] - range[0];
@@ -157,23 +295,67 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
   if (filespace0 == H5I_INVALID_HID)
     throw std::runtime_error("Failed to create HDF5 data space");
 
-  // Set chunking parameters
-  hid_t chunking_properties;
+  // Set chunking and filter parameters
+  const bool use_filters = options.shuffle or options.deflate > 0
+                           or options.filter != 0;
+  const bool use_chunking
+      = (options.chunking or use_filters) and dimsf[0] > 0;
+  hid_t chunking_properties = H5P_DEFAULT;
   if (use_chunking)
   {
-    // Set chunk size and limit to 1kB min/1MB max
-    hsize_t chunk_size = dimsf[0] / 2;
-    if (chunk_size > 1048576)
-      chunk_size = 1048576;
-    if (chunk_size < 1024)
-      chunk_size = 1024;
-
-    hsize_t chunk_dims[2] = {chunk_size, dimsf[1]};
+    // Chunks hold whole rows and are not longer than the largest local
+    // range, so that chunks are mostly written by one process
+    hsize_t max_rows = count[0];
+    if (use_mpi_io)
+    {
+      const hid_t fapl_id = H5Fget_access_plist(file_handle);
+      MPI_Comm comm;
+      MPI_Info info;
+      if (H5Pget_fapl_mpio(fapl_id, &comm, &info) < 0)
+        throw std::runtime_error("Failed to get HDF5 MPI-IO communicator.");
+      MPI_Allreduce(MPI_IN_PLACE, &max_rows, 1, MPI_UINT64_T, MPI_MAX, comm);
+      MPI_Comm_free(&comm);
+      if (info != MPI_INFO_NULL)
+        MPI_Info_free(&info);
+      H5Pclose(fapl_id);
+    }
+
+    const hsize_t row_bytes
+        = H5Tget_size(file_type) * (rank == 2 ? dimsf[1] : 1);
+    hsize_t chunk_rows = std::max<hsize_t>(options.chunk_bytes / row_bytes, 1);
+    chunk_rows = std::clamp<hsize_t>(std::min(chunk_rows, max_rows), 1,
+                                     dimsf[0]);
+
+    std::array<hsize_t, 2> chunk_dims = {chunk_rows, rank == 2 ? dimsf[1] : 0};
     chunking_properties = H5Pcreate(H5P_DATASET_CREATE);
-    H5Pset_chunk(chunking_properties, rank, chunk_dims);
+    if (H5Pset_chunk(chunking_properties, rank, chunk_dims.data()) < 0)
+      throw std::runtime_error("Failed to set HDF5 chunk size.");
+
+    // Filters are applied in the order that they are set
+    if (options.shuffle and H5Pset_shuffle(chunking_properties) < 0)
+      throw std::runtime_error("Failed to set HDF5 shuffle filter.");
+    if (options.deflate > 0
+        and H5Pset_deflate(chunking_properties, options.deflate) < 0)
+    {
+      throw std::runtime_error("Failed to set HDF5 deflate filter.");
+    }
+    if (options.filter != 0)
+    {
+      if (H5Zfilter_avail(options.filter) <= 0)
+      {
+        throw std::runtime_error("HDF5 filter "
+                                 + std::to_string(options.filter)
+                                 + " is not available.");
+      }
+      if (H5Pset_filter(chunking_properties, options.filter,
+                        H5Z_FLAG_MANDATORY, options.filter_params.size(),
+                        options.filter_params.data())
+          < 0)
+      {
+        throw std::runtime_error("Failed to set HDF5 filter.");
+      }
+    }
   }
-  else
-    chunking_properties = H5P_DEFAULT;
 
   // Check that group exists and recursively create if required
   const std::string group_name(dataset_path, 0, dataset_path.rfind('/'));
@@ -181,7 +363,7 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
 
   // Create global dataset (using dataset_path)
   const hid_t dset_id
-      = H5Dcreate2(file_handle, dataset_path.c_str(), h5type, filespace0,
+      = H5Dcreate2(file_handle, dataset_path.c_str(), file_type, filespace0,
                    H5P_DEFAULT, chunking_properties, H5P_DEFAULT);
   if (dset_id == H5I_INVALID_HID)
     throw std::runtime_error("Failed to create HDF5 global dataset.");
@@ -206,7 +388,11 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
   const hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
   if (use_mpi_io)
   {
-    if (herr_t status = H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+    const bool filtered = options.shuffle or options.deflate > 0
+                          or options.filter != 0;
+    if (herr_t status = H5Pset_dxpl_mpio(
+            plist_id, options.collective or filtered ? H5FD_MPIO_COLLECTIVE
+                                                     : H5FD_MPIO_INDEPENDENT);
         status < 0)
     {
       throw std::runtime_error(
@@ -245,6 +431,171 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
     throw std::runtime_error("Failed to release HDF5 file-access template.");
 }
 
+/// @brief Append a block of rows to a dataset, and create the dataset
+/// if it does not exist.
+///
+/// The dataset is chunked and can be extended along its first
+/// dimension. The rows of the block are distributed over the processes
+/// by range blocks, as in write_dataset.
+///
+/// @param[in] file_handle HDF5 file handle
+/// @param[in] dataset_path Path for the dataset in the HDF5 file
+/// @param[in] data Data to be written, flattened into 1D vector
+///   (row-major storage)
+/// @param[in] range The local range of rows within the block
+/// @param[in] global_size The global shape of the block. The shape of
+/// the rows must match the shape of the rows of an existing dataset.
+/// @param[in] use_mpi_io True if MPI-IO should be used
+/// @return Number of rows in the dataset before the block was appended
+template <typename T>
+std::int64_t append_dataset(hid_t file_handle, const std::string& dataset_path,
+                            const T* data, std::array<std::int64_t, 2> range,
+                            const std::vector<int64_t>& global_size,
+                            bool use_mpi_io)
+{
+  // Data rank
+  const int rank = global_size.size();
+  assert(rank != 0);
+  if (rank > 2)
+  {
+    throw std::runtime_error("Cannot append to HDF5 dataset. "
+                             "Only rank 1 and rank 2 dataset are supported");
+  }
+
+  // Get HDF5 data type
+  const hid_t h5type = hdf5::hdf5_type<T>();
+
+  // Check that group exists and recursively create if required
+  const std::string group_name(dataset_path, 0, dataset_path.rfind('/'));
+  add_group(file_handle, group_name);
+
+  std::vector<hsize_t> dims(global_size.begin(), global_size.end());
+  hsize_t offset0 = 0;
+  hid_t dset_id = H5I_INVALID_HID;
+  if (has_dataset(file_handle, dataset_path))
+  {
+    dset_id = open_dataset(file_handle, dataset_path);
+    if (dset_id == H5I_INVALID_HID)
+      throw std::runtime_error("Failed to open HDF5 dataset.");
+
+    // Check the shape of the rows of the dataset
+    const hid_t filespace0 = H5Dget_space(dset_id);
+    std::vector<hsize_t> dims0(rank);
+    if (H5Sget_simple_extent_ndims(filespace0) != rank
+        or H5Sget_simple_extent_dims(filespace0, dims0.data(), nullptr) < 0
+        or (rank == 2 and dims0[1] != dims[1]))
+    {
+      throw std::runtime_error("Cannot append to HDF5 dataset. "
+                               "Shape of the rows does not match.");
+    }
+    if (H5Sclose(filespace0) < 0)
+      throw std::runtime_error("Failed to close HDF5 data space.");
+
+    offset0 = dims0[0];
+    dims[0] += offset0;
+  }
+  else
+  {
+    // Create an empty dataset that can be extended along the first
+    // dimension
+    std::vector<hsize_t> dims0 = dims;
+    dims0[0] = 0;
+    std::vector<hsize_t> max_dims = dims;
+    max_dims[0] = H5S_UNLIMITED;
+    const hid_t filespace0
+        = H5Screate_simple(rank, dims0.data(), max_dims.data());
+    if (filespace0 == H5I_INVALID_HID)
+      throw std::runtime_error("Failed to create HDF5 data space");
+
+    // Extendable datasets must be chunked. Use chunks of about 1 MB,
+    // but not longer than the first block.
+    const hsize_t row_bytes = sizeof(T) * (rank == 2 ? dims[1] : 1);
+    std::array<hsize_t, 2> chunk_dims
+        = {std::clamp<hsize_t>((1 << 20) / row_bytes, 1,
+                               std::max<hsize_t>(dims[0], 1)),
+           rank == 2 ? dims[1] : 0};
+    const hid_t chunking_properties = H5Pcreate(H5P_DATASET_CREATE);
+    if (H5Pset_chunk(chunking_properties, rank, chunk_dims.data()) < 0)
+      throw std::runtime_error("Failed to set HDF5 chunk size.");
+
+    dset_id = H5Dcreate2(file_handle, dataset_path.c_str(), h5type,
+                         filespace0, H5P_DEFAULT, chunking_properties,
+                         H5P_DEFAULT);
+    if (dset_id == H5I_INVALID_HID)
+      throw std::runtime_error("Failed to create HDF5 global dataset.");
+
+    if (H5Pclose(chunking_properties) < 0)
+      throw std::runtime_error("Failed to close HDF5 chunking properties.");
+    if (H5Sclose(filespace0) < 0)
+      throw std::runtime_error("Failed to close HDF5 global data space.");
+  }
+
+  // Extend the dataset by the block
+  if (H5Dset_extent(dset_id, dims.data()) < 0)
+    throw std::runtime_error("Failed to extend HDF5 dataset.");
+
+  // Hyperslab selection parameters
+  std::vector<hsize_t> count(global_size.begin(), global_size.end());
+  count[0] = range[1] - range[0];
+  std::vector<hsize_t> offset(rank, 0);
+  offset[0] = offset0 + range[0];
+
+  // Create a local data space
+  const hid_t memspace = H5Screate_simple(rank, count.data(), nullptr);
+  if (memspace == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to create HDF5 local data space.");
+
+  // Create a file dataspace within the global space - a hyperslab
+  const hid_t filespace1 = H5Dget_space(dset_id);
+  if (H5Sselect_hyperslab(filespace1, H5S_SELECT_SET, offset.data(), nullptr,
+                          count.data(), nullptr)
+      < 0)
+  {
+    throw std::runtime_error("Failed to create HDF5 dataspace.");
+  }
+
+  // Set parallel access
+  const hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
+  if (use_mpi_io)
+  {
+    if (H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE) < 0)
+    {
+      throw std::runtime_error(
+          "Failed to set HDF5 data transfer property list.");
+    }
+  }
+
+  // Write local dataset into selected hyperslab
+  if (H5Dwrite(dset_id, h5type, memspace, filespace1, plist_id, data) < 0)
+  {
+    throw std::runtime_error(
+        "Failed to write HDF5 local dataset into hyperslab.");
+  }
+
+  // Close dataset collectively
+  if (H5Dclose(dset_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 dataset.");
+
+  // Close hyperslab
+  if (H5Sclose(filespace1) < 0)
+    throw std::runtime_error("Failed to close HDF5 hyperslab.");
+
+  // Close local dataset
+  if (H5Sclose(memspace) < 0)
+    throw std::runtime_error("Failed to close local HDF5 dataset.");
+
+  // Release file-access template
+  if (H5Pclose(plist_id) < 0)
+    throw std::runtime_error("Failed to release HDF5 file-access template.");
+
+  return offset0;
+}
+
+/// Default maximum size in bytes of the blocks of rows in which
+/// read_dataset reads a dataset. This keeps each MPI-IO request below
+/// the 2 GB limit of MPI counts.
+constexpr std::size_t max_read_block_bytes = std::size_t(1) << 30;
+
 /// Read data from a HDF5 dataset "dataset_path" as defined by range blocks on
 /// each process.
 ///
@@ -252,11 +603,14 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
 /// @param[in] dset_id HDF5 file handle.
 /// @param[in] range The local range on this processor.
 /// @param[in] allow_cast If true, allow casting from HDF5 type to type `T`.
+/// @param[in] max_block_bytes The rows are read in blocks of at most
+/// this number of bytes (and at least one row).
 /// @return Flattened 1D array of values. If range = {-1, -1}, then all data
 /// is read on this process.
 template <typename T>
 std::vector<T> read_dataset(hid_t dset_id, std::array<std::int64_t, 2> range,
-                            bool allow_cast)
+                            bool allow_cast,
+                            std::size_t max_block_bytes = max_read_block_bytes)
 {
   auto timer_start = std::chrono::system_clock::now();
 
@@ -310,42 +664,54 @@ std::vector<T> read_dataset(hid_t dset_id, std::array<std::int64_t, 2> range,
   else
     offset[0] = 0;
 
-  // Select a block in the dataset beginning at offset[], with
-  // size=count[]
-  if (herr_t status
-      = H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, offset.data(), nullptr,
-                            count.data(), nullptr);
-      status < 0)
+  // Create local data to read into
+  const hsize_t num_rows = count[0];
+  const hsize_t row_size = std::reduce(std::next(count.begin()), count.end(),
+                                       hsize_t(1), std::multiplies{});
+  std::vector<T> data(num_rows * row_size);
+
+  // Read data on each process, in blocks of rows of bounded size. The
+  // reads are independent (not collective), so a process with no rows
+  // has nothing to read and makes no HDF5 read call.
+  const hsize_t block_rows = std::max<hsize_t>(
+      1, max_block_bytes / std::max<hsize_t>(1, row_size * sizeof(T)));
+  hid_t h5type = hdf5::hdf5_type<T>();
+  const hsize_t offset0 = offset[0];
+  for (hsize_t r0 = 0; r0 < num_rows; r0 += block_rows)
   {
-    throw std::runtime_error("Failed to select HDF5 hyperslab.");
-  }
+    // Select a block in the dataset beginning at offset[], with
+    // size=count[]
+    offset[0] = offset0 + r0;
+    count[0] = std::min(block_rows, num_rows - r0);
+    if (herr_t status
+        = H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, offset.data(),
+                              nullptr, count.data(), nullptr);
+        status < 0)
+    {
+      throw std::runtime_error("Failed to select HDF5 hyperslab.");
+    }
 
-  // Create a memory dataspace
-  hid_t memspace = H5Screate_simple(rank, count.data(), nullptr);
-  if (memspace == H5I_INVALID_HID)
-    throw std::runtime_error("Failed to create HDF5 dataspace.");
+    // Create a memory dataspace
+    hid_t memspace = H5Screate_simple(rank, count.data(), nullptr);
+    if (memspace == H5I_INVALID_HID)
+      throw std::runtime_error("Failed to create HDF5 dataspace.");
 
-  // Create local data to read into
-  std::vector<T> data(
-      std::reduce(count.begin(), count.end(), 1, std::multiplies{}));
+    if (herr_t status = H5Dread(dset_id, h5type, memspace, dataspace,
+                                H5P_DEFAULT, data.data() + r0 * row_size);
+        status < 0)
+    {
+      throw std::runtime_error("Failed to read HDF5 data.");
+    }
 
-  // Read data on each process
-  hid_t h5type = hdf5::hdf5_type<T>();
-  if (herr_t status
-      = H5Dread(dset_id, h5type, memspace, dataspace, H5P_DEFAULT, data.data());
-      status < 0)
-  {
-    throw std::runtime_error("Failed to read HDF5 data.");
+    // Close memspace
+    if (herr_t status = H5Sclose(memspace); status < 0)
+      throw std::runtime_error("Failed to close HDF5 memory space.");
   }
 
   // Close dataspace
   if (herr_t status = H5Sclose(dataspace); status < 0)
     throw std::runtime_error("Failed to close HDF5 dataspace.");
 
-  // Close memspace
-  if (herr_t status = H5Sclose(memspace); status < 0)
-    throw std::runtime_error("Failed to close HDF5 memory space.");
-
   auto timer_end = std::chrono::system_clock::now();
   std::chrono::duration<double> dt = (timer_end - timer_start);
   double data_rate = data.size() * sizeof(T) / (1e6 * dt.count());
@@ -6,10 +6,15 @@
 
 #include "VTKFile.h"
 #include "cells.h"
+#include "utils.h"
 #include "vtk_utils.h"
 #include "xdmf_utils.h"
 #include <algorithm>
+#include <bit>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/fem/DofMap.h>
@@ -21,10 +26,13 @@
 #include <dolfinx/mesh/Topology.h>
 #include <filesystem>
 #include <iterator>
+#include <numeric>
 #include <pugixml.hpp>
 #include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 using namespace dolfinx;
 
@@ -57,18 +65,103 @@ std::string get_counter(const pugi::xml_node& node, const std::string& name)
 }
 //----------------------------------------------------------------------------
 
-/// Convert a container to a std::stringstream
+/// VTK name of the data type `T`
 template <typename T>
-std::stringstream container_to_string(const T& x, int precision)
+std::string vtk_type()
 {
-  std::stringstream s;
-  s.precision(precision);
-  std::ranges::for_each(x, [&s](auto e) { s << e << " "; });
+  if constexpr (std::is_floating_point_v<T>)
+    return "Float" + std::to_string(8 * sizeof(T));
+  else if constexpr (std::is_signed_v<T>)
+    return "Int" + std::to_string(8 * sizeof(T));
+  else
+    return "UInt" + std::to_string(8 * sizeof(T));
+}
+//-----------------------------------------------------------------------------
+
+/// Base64 encoding of a header followed by data
+std::string encode_base64(std::span<const std::byte> header,
+                          std::span<const std::byte> data)
+{
+  constexpr std::string_view chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                     "abcdefghijklmnopqrstuvwxyz0123456789+/";
+  auto byte = [&](std::size_t i) -> std::uint32_t
+  {
+    return std::to_integer<std::uint32_t>(
+        i < header.size() ? header[i] : data[i - header.size()]);
+  };
+
+  const std::size_t n = header.size() + data.size();
+  std::string s;
+  s.reserve(4 * ((n + 2) / 3));
+  for (std::size_t i = 0; i < n; i += 3)
+  {
+    std::uint32_t b = byte(i) << 16;
+    if (i + 1 < n)
+      b |= byte(i + 1) << 8;
+    if (i + 2 < n)
+      b |= byte(i + 2);
+    s.push_back(chars[(b >> 18) & 63]);
+    s.push_back(chars[(b >> 12) & 63]);
+    s.push_back(i + 1 < n ? chars[(b >> 6) & 63] : '=');
+    s.push_back(i + 2 < n ? chars[b & 63] : '=');
+  }
   return s;
 }
 //----------------------------------------------------------------------------
 
-void add_pvtu_mesh(pugi::xml_node& node)
+/// Set the format and the values of a pugixml DataArray node
+/// @param[in,out] node The DataArray node
+/// @param[in] values The values of the array
+/// @param[in] binary If true, write the raw bytes of `values` with a
+/// UInt64 header holding their size, base64 encoded. Otherwise, write
+/// the values as ASCII.
+template <typename T>
+void set_data(pugi::xml_node& node, std::span<const T> values, bool binary)
+{
+  if (binary)
+  {
+    node.append_attribute("format") = "binary";
+    const std::uint64_t num_bytes = values.size_bytes();
+    node.append_child(pugi::node_pcdata)
+        .set_value(encode_base64(std::as_bytes(std::span(&num_bytes, 1)),
+                                 std::as_bytes(values))
+                       .c_str());
+  }
+  else
+  {
+    node.append_attribute("format") = "ascii";
+    std::stringstream ss;
+    ss.precision(16);
+    std::ranges::for_each(values, [&ss](auto v) { ss << +v << " "; });
+    node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+  }
+}
+//-----------------------------------------------------------------------------
+
+/// Add the root node of a VTU file to an XML document
+/// @param[in,out] xml_vtu The XML document
+/// @param[in] binary True if the data arrays are binary
+/// @return The UnstructuredGrid node
+pugi::xml_node add_vtu_root(pugi::xml_document& xml_vtu, bool binary)
+{
+  pugi::xml_node vtk_node_vtu = xml_vtu.append_child("VTKFile");
+  vtk_node_vtu.append_attribute("type") = "UnstructuredGrid";
+  vtk_node_vtu.append_attribute("version") = "2.2";
+  if (binary)
+  {
+    vtk_node_vtu.append_attribute("byte_order")
+        = std::endian::native == std::endian::little ? "LittleEndian"
+                                                     : "BigEndian";
+    vtk_node_vtu.append_attribute("header_type") = "UInt64";
+  }
+  return vtk_node_vtu.append_child("UnstructuredGrid");
+}
+//-----------------------------------------------------------------------------
+
+/// Add the mesh arrays to a PUnstructuredGrid node
+/// @param[in,out] node The XML node to add data to
+/// @param[in] x_type VTK data type of the point coordinates
+void add_pvtu_mesh(pugi::xml_node& node, const std::string& x_type)
 {
   // -- Cell data (PCellData)
   pugi::xml_node cell_data_node = node.child("PCellData");
@@ -104,7 +197,7 @@ void add_pvtu_mesh(pugi::xml_node& node)
   if (x_data_node.empty())
     x_data_node = node.append_child("PPoints");
   pugi::xml_node data_node = x_data_node.append_child("PDataArray");
-  data_node.append_attribute("type") = "Float64";
+  data_node.append_attribute("type") = x_type.c_str();
   data_node.append_attribute("NumberOfComponents") = "3";
 }
 //----------------------------------------------------------------------------
@@ -114,25 +207,21 @@ void add_pvtu_mesh(pugi::xml_node& node)
 /// @param[in] num_components An array indicating the value shape of `values`
 /// @param[in] values The data array to add
 /// @param[in,out] data_node The XML node to add data to
+/// @param[in] binary If true, write binary data
 template <typename T>
 void add_data_float(const std::string& name,
                     std::span<const std::size_t> num_components,
-                    std::span<const T> values, pugi::xml_node& node)
+                    std::span<const T> values, pugi::xml_node& node,
+                    bool binary)
 {
   static_assert(std::is_floating_point_v<T>, "Scalar must be a float");
 
-  constexpr int size = 8 * sizeof(T);
-  std::string type = std::string("Float") + std::to_string(size);
-
   pugi::xml_node field_node = node.append_child("DataArray");
-  field_node.append_attribute("type") = type.c_str();
+  field_node.append_attribute("type") = vtk_type<T>().c_str();
   field_node.append_attribute("Name") = name.c_str();
-  field_node.append_attribute("format") = "ascii";
   if (!num_components.empty())
     field_node.append_attribute("NumberOfComponents") = num_components.front();
-
-  field_node.append_child(pugi::node_pcdata)
-      .set_value(container_to_string(values, 16).str().c_str());
+  set_data(field_node, values, binary);
 }
 //----------------------------------------------------------------------------
 
@@ -144,23 +233,24 @@ void add_data_float(const std::string& name,
 /// @param[in] num_components An array indicating the value shape of `values`
 /// @param[in] values The data array to add
 /// @param[in,out] data_node The XML node to add data to
+/// @param[in] binary If true, write binary data
 template <typename T>
 void add_data(const std::string& name,
               std::span<const std::size_t> num_components,
-              std::span<const T> values, pugi::xml_node& node)
+              std::span<const T> values, pugi::xml_node& node, bool binary)
 {
   if constexpr (std::is_scalar_v<T>)
-    add_data_float(name, num_components, values, node);
+    add_data_float(name, num_components, values, node, binary);
   else
   {
     using U = typename T::value_type;
     std::vector<U> v(values.size());
     std::ranges::transform(values, v.begin(), [](auto x) { return x.real(); });
     add_data_float(name + field_ext[0], num_components, std::span<const U>(v),
-                   node);
+                   node, binary);
     std::ranges::transform(values, v.begin(), [](auto x) { return x.imag(); });
     add_data_float(name + field_ext[1], num_components, std::span<const U>(v),
-                   node);
+                   node, binary);
   }
 }
 //----------------------------------------------------------------------------
@@ -177,6 +267,7 @@ void add_data(const std::string& name,
 /// @param[in] celltype The cell type
 /// @param[in] tdim Topological dimension of the cells
 /// @param[in,out] piece_node The XML node to add data to
+/// @param[in] binary If true, write binary data
 template <typename U>
 void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
               std::span<const std::int64_t> x_id,
@@ -184,54 +275,41 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
               std::span<const std::int64_t> cells,
               std::array<std::size_t, 2> cshape,
               const common::IndexMap& cellmap, mesh::CellType celltype,
-              int tdim, pugi::xml_node& piece_node)
+              int tdim, pugi::xml_node& piece_node, bool binary)
 {
   // -- Add geometry (points)
 
   pugi::xml_node points_node = piece_node.append_child("Points");
   pugi::xml_node x_node = points_node.append_child("DataArray");
-  x_node.append_attribute("type") = "Float64";
+  x_node.append_attribute("type") = vtk_type<U>().c_str();
   x_node.append_attribute("NumberOfComponents") = "3";
-  x_node.append_attribute("format") = "ascii";
-  x_node.append_child(pugi::node_pcdata)
-      .set_value(container_to_string(x, 16).str().c_str());
+  set_data(x_node, x, binary);
 
   // -- Add topology (cells)
 
   pugi::xml_node cells_node = piece_node.append_child("Cells");
   pugi::xml_node connectivity_node = cells_node.append_child("DataArray");
-  connectivity_node.append_attribute("type") = "Int32";
+  connectivity_node.append_attribute("type") = "Int64";
   connectivity_node.append_attribute("Name") = "connectivity";
-  connectivity_node.append_attribute("format") = "ascii";
-  {
-    std::stringstream ss;
-    std::ranges::for_each(cells, [&ss](auto& v) { ss << v << " "; });
-    connectivity_node.append_child(pugi::node_pcdata)
-        .set_value(ss.str().c_str());
-  }
+  set_data(connectivity_node, cells, binary);
 
   pugi::xml_node offsets_node = cells_node.append_child("DataArray");
-  offsets_node.append_attribute("type") = "Int32";
+  offsets_node.append_attribute("type") = "Int64";
   offsets_node.append_attribute("Name") = "offsets";
-  offsets_node.append_attribute("format") = "ascii";
   {
-    std::stringstream ss;
-    int num_nodes = cshape[1];
+    std::vector<std::int64_t> offsets(cshape[0]);
     for (std::size_t i = 0; i < cshape[0]; ++i)
-      ss << (i + 1) * num_nodes << " ";
-    offsets_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+      offsets[i] = (i + 1) * cshape[1];
+    set_data(offsets_node, std::span<const std::int64_t>(offsets), binary);
   }
 
   pugi::xml_node type_node = cells_node.append_child("DataArray");
   type_node.append_attribute("type") = "Int8";
   type_node.append_attribute("Name") = "types";
-  type_node.append_attribute("format") = "ascii";
-  int vtk_celltype = io::cells::get_vtk_cell_type(celltype, tdim);
   {
-    std::stringstream ss;
-    for (std::size_t c = 0; c < cshape[0]; ++c)
-      ss << vtk_celltype << " ";
-    type_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+    std::vector<std::int8_t> types(
+        cshape[0], io::cells::get_vtk_cell_type(celltype, tdim));
+    set_data(type_node, std::span<const std::int8_t>(types), binary);
   }
 
   // Ghost cell markers
@@ -240,16 +318,12 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   pugi::xml_node ghost_cell_node = cells_data_node.append_child("DataArray");
   ghost_cell_node.append_attribute("type") = "UInt8";
   ghost_cell_node.append_attribute("Name") = "vtkGhostType";
-  ghost_cell_node.append_attribute("format") = "ascii";
   ghost_cell_node.append_attribute("RangeMin") = "0";
   ghost_cell_node.append_attribute("RangeMax") = "1";
   {
-    std::stringstream ss;
-    for (std::int32_t c = 0; c < cellmap.size_local(); ++c)
-      ss << 0 << " ";
-    for (std::size_t c = cellmap.size_local(); c < cshape[0]; ++c)
-      ss << 1 << " ";
-    ghost_cell_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+    std::vector<std::uint8_t> ghosts(cshape[0], 1);
+    std::fill_n(ghosts.begin(), cellmap.size_local(), 0);
+    set_data(ghost_cell_node, std::span<const std::uint8_t>(ghosts), binary);
   }
 
   // Original cell IDs
@@ -257,15 +331,11 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   cell_id_node.append_attribute("type") = "Int64";
   cell_id_node.append_attribute("IdType") = "1";
   cell_id_node.append_attribute("Name") = "vtkOriginalCellIds";
-  cell_id_node.append_attribute("format") = "ascii";
   {
-    std::stringstream ss;
-    const std::int64_t cell_offset = cellmap.local_range()[0];
-    for (std::int32_t c = 0; c < cellmap.size_local(); ++c)
-      ss << cell_offset + c << " ";
-    std::ranges::for_each(cellmap.ghosts(),
-                          [&ss](auto& idx) { ss << idx << " "; });
-    cell_id_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+    std::vector<std::int64_t> ids(cellmap.size_local());
+    std::iota(ids.begin(), ids.end(), cellmap.local_range()[0]);
+    ids.insert(ids.end(), cellmap.ghosts().begin(), cellmap.ghosts().end());
+    set_data(cell_id_node, std::span<const std::int64_t>(ids), binary);
   }
 
   auto [min_idx, max_idx] = cellmap.local_range();
@@ -287,12 +357,7 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   point_id_node.append_attribute("type") = "Int64";
   point_id_node.append_attribute("IdType") = "1";
   point_id_node.append_attribute("Name") = "vtkOriginalPointIds";
-  point_id_node.append_attribute("format") = "ascii";
-  {
-    std::stringstream ss;
-    std::ranges::for_each(x_id, [&ss](auto idx) { ss << idx << " "; });
-    point_id_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
-  }
+  set_data(point_id_node, x_id, binary);
   if (!x_id.empty())
   {
     auto [min, max] = std::ranges::minmax_element(x_id);
@@ -304,13 +369,7 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   pugi::xml_node point_ghost_node = points_data_node.append_child("DataArray");
   point_ghost_node.append_attribute("type") = "UInt8";
   point_ghost_node.append_attribute("Name") = "vtkGhostType";
-  point_ghost_node.append_attribute("format") = "ascii";
-  {
-    std::stringstream ss;
-    std::ranges::for_each(x_ghost, [&ss](int ghost) { ss << ghost << " "; });
-    point_ghost_node.append_child(pugi::node_pcdata)
-        .set_value(ss.str().c_str());
-  }
+  set_data(point_ghost_node, x_ghost, binary);
   if (!x_ghost.empty())
   {
     auto [min, max] = std::ranges::minmax_element(x_ghost);
@@ -323,7 +382,8 @@ template <dolfinx::scalar T, std::floating_point U>
 void write_function(
     const std::vector<std::reference_wrapper<const fem::Function<T, U>>>& u,
     double time, pugi::xml_document* xml_doc,
-    const std::filesystem::path& filename)
+    const std::filesystem::path& filename, bool binary,
+    io::OutputMapCache& maps)
 {
   if (!xml_doc)
     throw std::runtime_error("VTKFile has been closed");
@@ -345,6 +405,11 @@ void write_function(
     }
   }
 
+  // The nodes of a sub-Function are those of the collapsed subspace.
+  // Values are read from the parent vector through the sub-dofmap.
+  if (!V0->component().empty())
+    V0 = V0->collapsed().first;
+
   // Check compatibility for all functions
   auto mesh0 = V0->mesh();
   assert(mesh0);
@@ -362,10 +427,6 @@ void write_function(
           "All Functions written to VTK file must share the same Mesh.");
     }
 
-    // Check that v isn't a sub-function
-    if (!V->component().empty())
-      throw std::runtime_error("Cannot write sub-Functions to VTK file.");
-
     auto e = V->element();
     assert(e);
 
@@ -397,10 +458,7 @@ void write_function(
 
   // Create a VTU XML object
   pugi::xml_document xml_vtu;
-  pugi::xml_node vtk_node_vtu = xml_vtu.append_child("VTKFile");
-  vtk_node_vtu.append_attribute("type") = "UnstructuredGrid";
-  vtk_node_vtu.append_attribute("version") = "2.2";
-  pugi::xml_node grid_node_vtu = vtk_node_vtu.append_child("UnstructuredGrid");
+  pugi::xml_node grid_node_vtu = add_vtu_root(xml_vtu, binary);
 
   auto topology0 = mesh0->topology();
   assert(topology0);
@@ -444,7 +502,7 @@ void write_function(
   int tdim = topology0->dim();
   add_mesh<U>(x, xshape, x_id, x_ghost, cells, cshape,
               *topology0->index_map(tdim), cell_type, topology0->dim(),
-              piece_node);
+              piece_node, binary);
 
   // FIXME: is this actually setting the first?
   // Set last scalar/vector/tensor Functions in u to be the 'active'
@@ -494,19 +552,29 @@ void write_function(
       pugi::xml_node data_node = piece_node.child("CellData");
       assert(!data_node.empty());
       auto dofmap = V->dofmap();
-      int bs = dofmap->bs();
+      std::span<const std::int32_t> map = maps(
+          dofmap, mesh0,
+          [&]()
+          {
+            // A sub-dofmap has one (unblocked) dof per component
+            const int bs = dofmap->bs();
+            const std::size_t m = bs * dofmap->map().extent(1);
+            std::vector<std::int32_t> map(cshape[0] * m);
+            for (std::size_t c = 0; c < cshape[0]; ++c)
+            {
+              auto dofs = dofmap->cell_dofs(c);
+              for (std::size_t i = 0; i < dofs.size(); ++i)
+                for (int k = 0; k < bs; ++k)
+                  map[m * c + bs * i + k] = bs * dofs[i] + k;
+            }
+            return map;
+          });
       std::vector<T> data(cshape[0] * num_components, 0);
-      auto u_vector = _u.get().x()->array();
-      for (std::size_t c = 0; c < cshape[0]; ++c)
-      {
-        auto dofs = dofmap->cell_dofs(c);
-        for (std::size_t i = 0; i < dofs.size(); ++i)
-          for (int k = 0; k < bs; ++k)
-            data[num_components * c + k] = u_vector[bs * dofs[i] + k];
-      }
+      io::gather_output<T>(_u.get().x()->array(), map, cshape[0],
+                           num_components, data);
 
       add_data(_u.get().name, std::span<const std::size_t>(component_vector),
-               std::span<const T>(data), data_node);
+               std::span<const T>(data), data_node, binary);
     }
     else
     {
@@ -540,14 +608,14 @@ void write_function(
         if (mesh0->geometry().dim() == 3)
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   _u.get().x()->array(), data_node);
+                   _u.get().x()->array(), data_node, binary);
         else
         {
           // Pad with zeros and then add
           auto data = pad_data(*V, _u.get().x()->array());
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   std::span<const T>(data), data_node);
+                   std::span<const T>(data), data_node, binary);
         }
       }
       else if (*e == *element0)
@@ -559,39 +627,41 @@ void write_function(
         assert(dofmap0);
         auto dofmap = V->dofmap();
         assert(dofmap);
-        int bs = dofmap->bs();
 
-        // Get data on each cell
-        auto u_vector = _u.get().x()->array();
-        std::vector<T> u(u_vector.size());
-        for (std::size_t c = 0; c < cshape[0]; ++c)
-        {
-          std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(c);
-          std::span<const std::int32_t> dofs = dofmap->cell_dofs(c);
-          for (std::size_t i = 0; i < dofs0.size(); ++i)
-          {
-            for (int k = 0; k < bs; ++k)
+        // Map from the nodes (dofs of V0) to the dofs of V. The dofs
+        // of a sub-dofmap are unblocked and refer to the parent vector.
+        const int e_bs = e->block_size();
+        std::span<const std::int32_t> map = maps(
+            dofmap, dofmap0,
+            [&]()
             {
-              assert(i < dofs0.size());
-              assert(bs * dofs0[i] + k < (int)u.size());
-              u[bs * dofs0[i] + k] = u_vector[bs * dofs[i] + k];
-            }
-          }
-        }
-
-        // Pack/add data
-        if (mesh0->geometry().dim() == 3)
-          add_data(_u.get().name,
-                   std::span<const std::size_t>(component_vector),
-                   std::span<const T>(u), data_node);
-        else
-        {
-          // Pad with zeros and then add
-          auto data = pad_data(*V, _u.get().x()->array());
-          add_data(_u.get().name,
-                   std::span<const std::size_t>(component_vector),
-                   std::span<const T>(data), data_node);
-        }
+              const int bs = dofmap->bs();
+              std::vector<std::int32_t> map(xshape[0] * e_bs, -1);
+              for (std::size_t c = 0; c < cshape[0]; ++c)
+              {
+                std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(c);
+                std::span<const std::int32_t> dofs = dofmap->cell_dofs(c);
+                for (std::size_t i = 0; i < dofs0.size(); ++i)
+                {
+                  for (int k = 0; k < e_bs; ++k)
+                  {
+                    std::div_t pos = std::div(int(i) * e_bs + k, bs);
+                    assert(e_bs * dofs0[i] + k < (int)map.size());
+                    map[e_bs * dofs0[i] + k]
+                        = bs * dofs[pos.quot] + pos.rem;
+                  }
+                }
+              }
+              return map;
+            });
+
+        // Gather data, padded with zeros
+        std::vector<T> data(xshape[0] * num_components, 0);
+        io::gather_output<T>(_u.get().x()->array(), map, xshape[0],
+                             num_components, data);
+
+        add_data(_u.get().name, std::span<const std::size_t>(component_vector),
+                 std::span<const T>(data), data_node, binary);
       }
       else
       {
@@ -646,7 +716,7 @@ void write_function(
     }
 
     // Add mesh metadata to PVTU object
-    add_pvtu_mesh(grid_node);
+    add_pvtu_mesh(grid_node, vtk_type<U>());
 
     const int mpi_size = dolfinx::MPI::size(mesh0->comm());
     for (auto _u : u)
@@ -715,8 +785,9 @@ void write_function(
 
 //----------------------------------------------------------------------------
 io::VTKFile::VTKFile(MPI_Comm comm, const std::filesystem::path& filename,
-                     const std::string&)
-    : _filename(filename), _comm(comm)
+                     const std::string&, Encoding encoding)
+    : _filename(filename), _encoding(encoding), _comm(comm),
+      _output_maps(std::make_unique<OutputMapCache>())
 {
   _pvd_xml = std::make_unique<pugi::xml_document>();
   assert(_pvd_xml);
@@ -794,10 +865,8 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
 
   // Create a VTU XML object
   pugi::xml_document xml_vtu;
-  pugi::xml_node vtk_node_vtu = xml_vtu.append_child("VTKFile");
-  vtk_node_vtu.append_attribute("type") = "UnstructuredGrid";
-  vtk_node_vtu.append_attribute("version") = "2.2";
-  pugi::xml_node grid_node_vtu = vtk_node_vtu.append_child("UnstructuredGrid");
+  pugi::xml_node grid_node_vtu
+      = add_vtu_root(xml_vtu, _encoding == Encoding::Binary);
 
   // Add "Piece" node and required metadata
   pugi::xml_node piece_node = grid_node_vtu.append_child("Piece");
@@ -814,7 +883,7 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
   std::fill(std::next(x_ghost.begin(), xmap->size_local()), x_ghost.end(), 1);
   add_mesh(geometry.x(), xshape, geometry.input_global_indices(), x_ghost,
            cells, cshape, *topology->index_map(tdim), cell_type,
-           topology->dim(), piece_node);
+           topology->dim(), piece_node, _encoding == Encoding::Binary);
 
   // Create filepath for a .vtu file
   auto create_vtu_path = [file_root = _filename.parent_path(),
@@ -847,7 +916,7 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
     grid_node.append_attribute("GhostLevel") = 1;
 
     // Add mesh metadata to PVTU object
-    add_pvtu_mesh(grid_node);
+    add_pvtu_mesh(grid_node, vtk_type<U>());
 
     // Add data for each process to the PVTU object
     const int mpi_size = dolfinx::MPI::size(_comm.comm());
@@ -876,7 +945,8 @@ void io::VTKFile::write(
     const std::vector<std::reference_wrapper<const fem::Function<T, U>>>& u,
     double time)
 {
-  write_function<T, U>(u, time, _pvd_xml.get(), _filename);
+  write_function<T, U>(u, time, _pvd_xml.get(), _filename,
+                       _encoding == Encoding::Binary, *_output_maps);
 }
 //-----------------------------------------------------------------------------
 // Instantiation for different types
@@ -33,6 +33,7 @@ class Mesh;
 
 namespace dolfinx::io
 {
+class OutputMapCache;
 
 /// @brief Output of meshes and functions in VTK/ParaView format.
 ///
@@ -46,9 +47,23 @@ namespace dolfinx::io
 class VTKFile
 {
 public:
-  /// Create VTK file
+  /// File encoding type
+  enum class Encoding
+  {
+    ASCII,
+    Binary
+  };
+
+  /// @brief Create VTK file.
+  /// @param[in] comm MPI communicator.
+  /// @param[in] filename Name of the PVD file.
+  /// @param[in] file_mode File mode (unused).
+  /// @param[in] encoding Encoding of the data arrays in the VTU files.
+  /// `Binary` writes the raw bytes of the arrays, base64 encoded,
+  /// which is faster to write and read than `ASCII` and gives smaller
+  /// files.
   VTKFile(MPI_Comm comm, const std::filesystem::path& filename,
-          const std::string& file_mode);
+          const std::string& file_mode, Encoding encoding = Encoding::ASCII);
 
   /// Destructor
   ~VTKFile();
@@ -69,8 +84,8 @@ public:
   /// @brief Write finite elements function with an associated time
   /// step.
   ///
-  /// @pre Functions in `u` cannot be sub-Functions. Extract
-  /// sub-Functions before output.
+  /// @note Sub-Functions (see fem::Function::sub) are written without
+  /// collapsing them. Their values are read from the parent vector.
   ///
   /// @pre All Functions in `u` with point-wise data must use the same
   /// element type (up to the block size) and the element must be
@@ -90,7 +105,14 @@ private:
 
   std::filesystem::path _filename;
 
+  // Encoding of the data arrays
+  Encoding _encoding;
+
   // MPI communicator
   dolfinx::MPI::Comm _comm;
+
+  // Maps from the dofs of written Functions to the output values, which
+  // are re-used by later writes of Functions on the same spaces
+  std::unique_ptr<OutputMapCache> _output_maps;
 };
 } // namespace dolfinx::io
@@ -6,13 +6,28 @@
 
 #include "HDF5Interface.h"
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <concepts>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
 #include <dolfinx/io/cells.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/utils.h>
+#include <functional>
 #include <map>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace dolfinx::io::VTKHDF
@@ -76,9 +91,9 @@ void write_mesh(std::string filename, const mesh::Mesh<U>& mesh)
   std::vector<std::int64_t> geom_global_shape = {size_global, 3};
   std::array<std::int64_t, 2> geom_irange = geom_imap->local_range();
   hdf5::write_dataset(h5file, "/VTKHDF/Points", mesh.geometry().x().data(),
-                      geom_irange, geom_global_shape, true, false);
+                      geom_irange, geom_global_shape, true);
   hdf5::write_dataset(h5file, "VTKHDF/NumberOfPoints", &size_global, {0, 1},
-                      {1}, true, false);
+                      {1}, true);
 
   // Note: VTKHDF stores the cells as an adjacency list, where cell
   // types might be jumbled up
@@ -145,7 +160,7 @@ void write_mesh(std::string filename, const mesh::Mesh<U>& mesh)
       = std::accumulate(num_cells_global.begin(), num_cells_global.end(), 0);
   hdf5::write_dataset(h5file, "/VTKHDF/Offsets", topology_offsets.data(),
                       {offset_start_position + 1, offset_stop_position + 1},
-                      {num_all_cells_global + 1}, true, false);
+                      {num_all_cells_global + 1}, true);
 
   // Store global mesh connectivity
   std::int64_t topology_size_global
@@ -155,16 +170,263 @@ void write_mesh(std::string filename, const mesh::Mesh<U>& mesh)
   std::int64_t topology_stop = topology_start + topology_flattened.size();
   hdf5::write_dataset(h5file, "/VTKHDF/Connectivity", topology_flattened.data(),
                       {topology_start, topology_stop}, {topology_size_global},
-                      true, false);
+                      true);
 
   // Store cell types
   hdf5::write_dataset(h5file, "/VTKHDF/Types", vtkcelltypes.data(),
                       {offset_start_position, offset_stop_position},
-                      {num_all_cells_global}, true, false);
+                      {num_all_cells_global}, true);
   hdf5::write_dataset(h5file, "/VTKHDF/NumberOfConnectivityIds",
-                      &topology_size_global, {0, 1}, {1}, true, false);
+                      &topology_size_global, {0, 1}, {1}, true);
   hdf5::write_dataset(h5file, "/VTKHDF/NumberOfCells", &num_all_cells_global,
-                      {0, 1}, {1}, true, false);
+                      {0, 1}, {1}, true);
+  hdf5::close_file(h5file);
+}
+
+namespace impl
+{
+/// @brief Pack the values of a Function at the points or at the cells
+/// of its mesh, in the order that write_mesh writes them.
+///
+/// @note A sub-Function is packed in the dof layout of its collapsed
+/// space, with values read from the parent vector.
+/// @param[in] u Function to pack. Must be a Lagrange function with the
+/// dof layout of the mesh geometry, or piecewise constant.
+/// @return Values at the owned points or cells, padded to 3 (vectors)
+/// or 9 (tensors) components, the number of components, and true if
+/// the values are cell data.
+template <dolfinx::scalar T, std::floating_point U>
+std::tuple<std::vector<T>, std::size_t, bool>
+pack_function(const fem::Function<T, U>& u)
+{
+  std::shared_ptr<const fem::FunctionSpace<U>> V = u.function_space();
+  assert(V);
+  std::span<const std::int32_t> map;
+  if (!V->component().empty())
+    std::tie(V, map) = V->collapsed();
+  std::span<const T> x = u.x()->array();
+  auto u_value = [x, map](std::int32_t i)
+  { return map.empty() ? x[i] : x[map[i]]; };
+
+  std::shared_ptr<const fem::FiniteElement<U>> element = V->element();
+  assert(element);
+  if (!element->interpolation_ident())
+  {
+    throw std::runtime_error("Only Lagrange functions are supported. "
+                             "Interpolate Functions before output.");
+  }
+
+  // Pad to 3D if vector/tensor is product of dimensions is smaller than
+  // 3**rank to ensure that we can visualize them correctly in Paraview
+  std::span<const std::size_t> value_shape = element->value_shape();
+  std::size_t num_comp = std::reduce(value_shape.begin(), value_shape.end(), 1,
+                                     std::multiplies{});
+  if (num_comp < std::pow(3, value_shape.size()))
+    num_comp = std::pow(3, value_shape.size());
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = V->mesh();
+  assert(mesh);
+  std::vector cell_imaps
+      = mesh->topology()->index_maps(mesh->topology()->dim());
+  const bool cell_data
+      = element->space_dimension() / element->block_size() == 1;
+  std::vector<T> data;
+  if (cell_data)
+  {
+    // Cells are ordered by cell type on each process
+    for (std::size_t i = 0; i < cell_imaps.size(); ++i)
+    {
+      std::shared_ptr<const fem::DofMap> dofmap = V->dofmaps(i);
+      const int bs = dofmap->bs();
+      const std::int32_t num_cells = cell_imaps[i]->size_local();
+      const std::size_t offset = data.size();
+      data.resize(offset + num_cells * num_comp, 0);
+      for (std::int32_t c = 0; c < num_cells; ++c)
+      {
+        std::int32_t dof = dofmap->cell_dofs(c).front();
+        for (int k = 0; k < bs; ++k)
+          data[offset + num_comp * c + k] = u_value(bs * dof + k);
+      }
+    }
+  }
+  else
+  {
+    const mesh::Geometry<U>& geometry = mesh->geometry();
+    const std::int32_t num_points = geometry.index_map()->size_local();
+    data.resize(num_points * num_comp, 0);
+    for (std::size_t i = 0; i < cell_imaps.size(); ++i)
+    {
+      std::shared_ptr<const fem::DofMap> dofmap = V->dofmaps(i);
+      const fem::CoordinateElement<U>& cmap = geometry.cmaps()[i];
+      if (dofmap->element_dof_layout() != cmap.create_dof_layout())
+      {
+        throw std::runtime_error(
+            "Function and Mesh dof layouts do not match. "
+            "Maybe the Function needs to be interpolated?");
+      }
+      if (cmap.degree() > 2
+          and element->basix_element().lagrange_variant() != cmap.variant())
+      {
+        throw std::runtime_error("Mismatch in Lagrange family. Maybe the "
+                                 "Function needs to be interpolated?");
+      }
+
+      // Owned points can be in ghost cells only
+      const int bs = dofmap->bs();
+      md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> x_dofmap
+          = geometry.dofmap(i);
+      const std::int32_t num_cells
+          = cell_imaps[i]->size_local() + cell_imaps[i]->num_ghosts();
+      for (std::int32_t c = 0; c < num_cells; ++c)
+      {
+        std::span<const std::int32_t> dofs = dofmap->cell_dofs(c);
+        for (std::size_t j = 0; j < dofs.size(); ++j)
+        {
+          if (std::int32_t p = x_dofmap(c, j); p < num_points)
+          {
+            for (int k = 0; k < bs; ++k)
+              data[num_comp * p + k] = u_value(bs * dofs[j] + k);
+          }
+        }
+      }
+    }
+  }
+
+  return {std::move(data), num_comp, cell_data};
+}
+} // namespace impl
+
+/// @brief Append a time step with the values of Functions to a VTKHDF
+/// file.
+///
+/// The file must hold the mesh of the Functions, written by
+/// write_mesh. Steps are stored in the transient layout of the VTKHDF
+/// format, where all steps share the mesh, and each call appends the
+/// values of the Functions at one step. Lagrange Functions with the dof
+/// layout of the mesh geometry are written as point data, and piecewise
+/// constant Functions as cell data. For complex Functions, the real and
+/// imaginary parts are written as separate fields.
+///
+/// @note The data of all processes is written collectively.
+/// @note Each step should write the same Functions.
+///
+/// @tparam T Scalar type of the Functions
+/// @tparam U Scalar type of the mesh
+/// @param filename Name of the file, written by write_mesh.
+/// @param u Functions to write. Must share the same mesh and have
+/// different names.
+/// @param t Time of the step.
+template <dolfinx::scalar T, std::floating_point U>
+void write_data(
+    std::string filename,
+    const std::vector<std::shared_ptr<const fem::Function<T, U>>>& u,
+    double t)
+{
+  if (u.empty())
+    throw std::runtime_error("No Functions to write.");
+  std::shared_ptr<const mesh::Mesh<U>> mesh
+      = u.front()->function_space()->mesh();
+  assert(mesh);
+  for (auto& v : u)
+  {
+    if (v->function_space()->mesh() != mesh)
+      throw std::runtime_error("Functions must share the same mesh.");
+  }
+
+  hid_t h5file = hdf5::open_file(mesh->comm(), filename, "a", true);
+
+  std::shared_ptr<const common::IndexMap> geom_imap
+      = mesh->geometry().index_map();
+  std::int64_t num_points_global = geom_imap->size_global();
+  if (!hdf5::has_dataset(h5file, "/VTKHDF/Points")
+      or hdf5::get_dataset_shape(h5file, "/VTKHDF/Points").front()
+             != num_points_global)
+  {
+    hdf5::close_file(h5file);
+    throw std::runtime_error("File does not hold the mesh of the Functions.");
+  }
+
+  // Owned range of the cells of all types, as in write_mesh
+  std::array<std::int64_t, 2> cell_range = {0, 0};
+  std::int64_t num_cells_global = 0;
+  for (auto& im : mesh->topology()->index_maps(mesh->topology()->dim()))
+  {
+    std::array<std::int64_t, 2> r = im->local_range();
+    cell_range[0] += r[0];
+    cell_range[1] += r[1];
+    num_cells_global += im->size_global();
+  }
+
+  // Append the step. Step sizes are written by rank 0, and all steps
+  // use the first (and only) part of the mesh.
+  const std::array<std::int64_t, 2> r0
+      = {0, dolfinx::MPI::rank(mesh->comm()) == 0 ? 1 : 0};
+  const std::int64_t zero = 0, one = 1;
+  const std::int32_t num_steps
+      = hdf5::append_dataset(h5file, "/VTKHDF/Steps/Values", &t, r0, {1},
+                             true)
+        + 1;
+  hdf5::append_dataset(h5file, "/VTKHDF/Steps/PartOffsets", &zero, r0, {1},
+                       true);
+  hdf5::append_dataset(h5file, "/VTKHDF/Steps/NumberOfParts", &one, r0, {1},
+                       true);
+  hdf5::append_dataset(h5file, "/VTKHDF/Steps/PointOffsets", &zero, r0, {1},
+                       true);
+  hdf5::append_dataset(h5file, "/VTKHDF/Steps/CellOffsets", &zero, r0,
+                       {1, 1}, true);
+  hdf5::append_dataset(h5file, "/VTKHDF/Steps/ConnectivityIdOffsets", &zero,
+                       r0, {1, 1}, true);
+
+  // Update "NSteps" attribute
+  hid_t steps_group = H5Gopen(h5file, "/VTKHDF/Steps", H5P_DEFAULT);
+  hid_t attr_id;
+  if (H5Aexists(steps_group, "NSteps") > 0)
+    attr_id = H5Aopen(steps_group, "NSteps", H5P_DEFAULT);
+  else
+  {
+    hid_t space_id = H5Screate(H5S_SCALAR);
+    attr_id = H5Acreate(steps_group, "NSteps", H5T_NATIVE_INT32, space_id,
+                        H5P_DEFAULT, H5P_DEFAULT);
+    H5Sclose(space_id);
+  }
+  H5Awrite(attr_id, H5T_NATIVE_INT32, &num_steps);
+  H5Aclose(attr_id);
+  H5Gclose(steps_group);
+
+  for (auto& v : u)
+  {
+    auto [data, num_comp, cell_data] = impl::pack_function(*v);
+
+    // Field values, and offset of the step in the field
+    const std::string type = cell_data ? "CellData" : "PointData";
+    std::vector<std::int64_t> shape
+        = {cell_data ? num_cells_global : num_points_global};
+    if (num_comp > 1)
+      shape.push_back(num_comp);
+    auto append = [&](const std::string& name, const auto& values)
+    {
+      std::int64_t offset = hdf5::append_dataset(
+          h5file, "/VTKHDF/" + type + "/" + name, values.data(),
+          cell_data ? cell_range : geom_imap->local_range(), shape, true);
+      hdf5::append_dataset(h5file,
+                           "/VTKHDF/Steps/" + type + "Offsets/" + name,
+                           &offset, r0, {1}, true);
+    };
+
+    if constexpr (std::is_floating_point_v<T>)
+      append(v->name, data);
+    else
+    {
+      std::vector<scalar_value_t<T>> part(data.size());
+      std::ranges::transform(data, part.begin(),
+                             [](auto x) { return x.real(); });
+      append("real_" + v->name, part);
+      std::ranges::transform(data, part.begin(),
+                             [](auto x) { return x.imag(); });
+      append("imag_" + v->name, part);
+    }
+  }
+
   hdf5::close_file(h5file);
 }
 
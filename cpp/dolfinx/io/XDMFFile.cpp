@@ -10,25 +10,288 @@
 #include "xdmf_mesh.h"
 #include "xdmf_utils.h"
 #include <boost/lexical_cast.hpp>
+#include <cstdint>
+#include <dolfinx/common/Trace.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/partition.h>
 #include <dolfinx/io/utils.h>
+#include <dolfinx/la/Vector.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/mesh/utils.h>
 #include <filesystem>
+#include <fstream>
+#include <limits>
 #include <pugixml.hpp>
+#include <string>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::io;
 
+namespace
+{
+/// @brief Save a XML document to file.
+///
+/// If `node` is the last element of the document (the last child of
+/// each of its ancestors), is not the first child of its parent, and
+/// the file holds the document without `node`, as written by the
+/// previous call, then only `node` and the closing tags of its
+/// ancestors are written. Time series then append to the file instead
+/// of re-writing it for each step.
+///
+/// @param[in] doc XML document.
+/// @param[in] node Node that has been appended to `doc` since the last
+/// call. If null, the document is written.
+/// @param[in] filename Name of the file.
+/// @param[in] size Size of the file after the last call, or -1.
+/// @return Size of the file.
+std::int64_t save_xml(const pugi::xml_document& doc, pugi::xml_node node,
+                      const std::filesystem::path& filename,
+                      std::int64_t size)
+{
+  constexpr const char* indent = "  ";
+
+  // Closing tags of the ancestors of the node, as written by pugixml
+  std::vector<pugi::xml_node> ancestors;
+  bool is_last = node and node.previous_sibling() and !node.next_sibling();
+  for (pugi::xml_node n = node.parent(); n.type() == pugi::node_element;
+       n = n.parent())
+  {
+    ancestors.push_back(n);
+    is_last = is_last and !n.next_sibling();
+  }
+  std::string tail;
+  for (std::size_t i = 0; i < ancestors.size(); ++i)
+  {
+    for (std::size_t d = i + 1; d < ancestors.size(); ++d)
+      tail += indent;
+    tail += "</" + std::string(ancestors[i].name()) + ">\n";
+  }
+
+  if (is_last and size >= std::int64_t(tail.size())
+      and std::filesystem::exists(filename)
+      and std::int64_t(std::filesystem::file_size(filename)) == size)
+  {
+    // Check that the file ends with the closing tags, i.e. that the
+    // parent of the node had children when the file was written
+    std::fstream file(filename,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    std::string end(tail.size(), ' ');
+    file.seekg(size - tail.size());
+    file.read(end.data(), end.size());
+    if (file and end == tail)
+    {
+      // Overwrite the closing tags with the node and closing tags
+      file.seekp(size - tail.size());
+      node.print(file, indent, pugi::format_default, pugi::encoding_auto,
+                 ancestors.size());
+      file << tail;
+      file.flush();
+      if (file)
+        return file.tellp();
+    }
+  }
+
+  if (!doc.save_file(filename.c_str(), indent))
+    throw std::runtime_error("Failed to save XML file.");
+  return std::filesystem::file_size(filename);
+}
+
+/// @brief Read mesh tags that are stored by the global index of a cell
+/// that contains the entity and the local index of the entity in the
+/// cell, as written by xdmf_mesh::add_meshtags.
+///
+/// The tags are read in chunks. The tags of a chunk are sent to a post
+/// office process for the cell, which forwards them to the process that
+/// owns the cell. The memory use therefore does not depend on the
+/// number of vertices of the entities and is bounded by the chunk size.
+/// Finally, the tags are copied to the other processes that have the
+/// entity.
+///
+/// @pre The mesh has been read from the file, so that the original cell
+/// indices of the topology are the cell indices in the file.
+///
+/// @param[in] topology Mesh topology.
+/// @param[in] dim Topological dimension of the tagged entities.
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] paths HDF5 paths of the cell indices, the local entity
+/// indices and the tag values.
+/// @param[in] chunk_size Maximum number of tags read by a process in one
+/// round.
+/// @return Sorted local indices of the tagged entities and their tags.
+std::pair<std::vector<std::int32_t>, std::vector<std::int32_t>>
+read_tags_by_cell(const mesh::Topology& topology, int dim, hid_t h5_id,
+                  const std::array<std::string, 3>& paths,
+                  std::int64_t chunk_size)
+{
+  MPI_Comm comm = topology.comm();
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const int tdim = topology.dim();
+  std::shared_ptr<const common::IndexMap> cell_map = topology.index_map(tdim);
+  std::shared_ptr<const common::IndexMap> entity_map = topology.index_map(dim);
+  assert(cell_map);
+  assert(entity_map);
+  auto c_to_e = topology.connectivity(tdim, dim);
+  assert(dim == tdim or c_to_e);
+
+  // Send (original cell index, rank, local cell index) of owned cells
+  // to the post office of the original cell index
+  const std::int64_t num_cells = cell_map->size_global();
+  std::span<const std::int64_t> original_cells
+      = topology.original_cell_index.front();
+  std::vector<std::int64_t> cell_data;
+  std::vector<std::int32_t> post_offices;
+  for (std::int32_t c = 0; c < cell_map->size_local(); ++c)
+  {
+    cell_data.insert(cell_data.end(), {original_cells[c], rank, c});
+    post_offices.push_back(
+        dolfinx::MPI::index_owner(size, original_cells[c], num_cells));
+  }
+  auto [cell_data_p, src0, idx0, ghost0] = graph::build::distribute(
+      comm, cell_data, {post_offices.size(), 3},
+      graph::regular_adjacency_list(std::move(post_offices), 1));
+
+  // Map from original cell index (minus offset) to (rank, local cell
+  // index) for the cells of this post office
+  const std::array<std::int64_t, 2> cell_range
+      = dolfinx::MPI::local_range(rank, num_cells, size);
+  std::vector<std::int64_t> cell_owners(
+      2 * (cell_range[1] - cell_range[0]), -1);
+  for (std::size_t i = 0; i < cell_data_p.size(); i += 3)
+  {
+    std::int64_t pos = cell_data_p[i] - cell_range[0];
+    cell_owners[2 * pos] = cell_data_p[i + 1];
+    cell_owners[2 * pos + 1] = cell_data_p[i + 2];
+  }
+
+  // Open datasets (collective)
+  std::array<hid_t, 3> dsets;
+  for (std::size_t i = 0; i < paths.size(); ++i)
+  {
+    dsets[i] = io::hdf5::open_dataset(h5_id, paths[i]);
+    if (dsets[i] == H5I_INVALID_HID)
+      throw std::runtime_error("Failed to open HDF5 global dataset.");
+  }
+
+  // Number of rounds
+  const std::int64_t num_tags
+      = io::hdf5::get_dataset_shape(h5_id, paths[2]).front();
+  const std::array<std::int64_t, 2> tag_range
+      = dolfinx::MPI::local_range(rank, num_tags, size);
+  std::int64_t num_rounds
+      = (tag_range[1] - tag_range[0] + chunk_size - 1) / chunk_size;
+  MPI_Allreduce(MPI_IN_PLACE, &num_rounds, 1, MPI_INT64_T, MPI_MAX, comm);
+
+  // Tag of each local entity, encoded as tag - min + 1, or 0 if the
+  // entity is not tagged
+  constexpr std::int64_t tag_min = std::numeric_limits<std::int32_t>::min();
+  la::Vector<std::int64_t> tags(entity_map, 1);
+  std::span<std::int64_t> _tags = tags.mutable_array();
+  std::ranges::fill(_tags, 0);
+  std::vector<std::int64_t> data;
+  std::vector<std::int32_t> dest;
+  for (std::int64_t k = 0; k < num_rounds; ++k)
+  {
+    std::array<std::int64_t, 2> range;
+    range[0] = std::min(tag_range[0] + k * chunk_size, tag_range[1]);
+    range[1] = std::min(range[0] + chunk_size, tag_range[1]);
+    const std::vector cells
+        = io::hdf5::read_dataset<std::int64_t>(dsets[0], range, true);
+    const std::vector local_entities
+        = io::hdf5::read_dataset<std::int64_t>(dsets[1], range, true);
+    const std::vector values
+        = io::hdf5::read_dataset<std::int64_t>(dsets[2], range, true);
+
+    // Send (original cell index, local entity index, value) to the
+    // post office of the cell
+    data.clear();
+    dest.clear();
+    for (std::size_t i = 0; i < cells.size(); ++i)
+    {
+      data.insert(data.end(), {cells[i], local_entities[i], values[i]});
+      dest.push_back(dolfinx::MPI::index_owner(size, cells[i], num_cells));
+    }
+    auto [data_p, src1, idx1, ghost1] = graph::build::distribute(
+        comm, data, {dest.size(), 3},
+        graph::regular_adjacency_list(std::move(dest), 1));
+
+    // Forward (local cell index, local entity index, value) to the
+    // process that owns the cell
+    data.clear();
+    dest.clear();
+    for (std::size_t i = 0; i < data_p.size(); i += 3)
+    {
+      std::int64_t pos = data_p[i] - cell_range[0];
+      if (cell_owners[2 * pos] < 0)
+        throw std::runtime_error("Tagged cell not found in mesh.");
+      data.insert(data.end(),
+                  {cell_owners[2 * pos + 1], data_p[i + 1], data_p[i + 2]});
+      dest.push_back(cell_owners[2 * pos]);
+    }
+    auto [data_c, src2, idx2, ghost2] = graph::build::distribute(
+        comm, data, {dest.size(), 3},
+        graph::regular_adjacency_list(std::move(dest), 1));
+
+    for (std::size_t i = 0; i < data_c.size(); i += 3)
+    {
+      std::int32_t c = data_c[i];
+      std::int32_t e = dim == tdim ? c : c_to_e->links(c)[data_c[i + 1]];
+      _tags[e] = data_c[i + 2] - tag_min + 1;
+    }
+    data = std::vector<std::int64_t>();
+    dest = std::vector<std::int32_t>();
+  }
+
+  for (hid_t dset : dsets)
+  {
+    if (herr_t err = H5Dclose(dset); err < 0)
+      throw std::runtime_error("Failed to close HDF5 global dataset.");
+  }
+
+  // Copy the tags to all processes that have the entity
+  tags.scatter_rev([](std::int64_t x, std::int64_t y)
+                   { return std::max(x, y); });
+  tags.scatter_fwd();
+
+  std::vector<std::int32_t> indices, tag_values;
+  for (std::size_t e = 0; e < _tags.size(); ++e)
+  {
+    if (_tags[e] > 0)
+    {
+      indices.push_back(e);
+      tag_values.push_back(_tags[e] + tag_min - 1);
+    }
+  }
+
+  return {std::move(indices), std::move(tag_values)};
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+XDMFFile::XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
+                   std::string file_mode, Encoding encoding,
+                   const hdf5::DatasetOptions& dataset_options,
+                   int num_aggregators)
+    : XDMFFile(comm, filename, file_mode, encoding, dataset_options,
+               hdf5::FileOptions{.num_aggregators = num_aggregators,
+                                 .collective_metadata_write
+                                 = num_aggregators > 0})
+{
+}
 //-----------------------------------------------------------------------------
 XDMFFile::XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
-                   std::string file_mode, Encoding encoding)
+                   std::string file_mode, Encoding encoding,
+                   const hdf5::DatasetOptions& dataset_options,
+                   const hdf5::FileOptions& file_options)
     : _comm(comm), _filename(filename), _file_mode(file_mode),
-      _xml_doc(new pugi::xml_document), _encoding(encoding)
+      _xml_doc(new pugi::xml_document), _encoding(encoding),
+      _dataset_options(dataset_options),
+      _output_maps(std::make_unique<OutputMapCache>())
 {
   // Handle HDF5 and XDMF files with the file mode. At the end of this
   // we will have _hdf5_file and _xml_doc both pointing to a valid and
@@ -43,8 +306,8 @@ XDMFFile::XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
     const std::filesystem::path hdf5_filename
         = xdmf_utils::get_hdf5_filename(_filename);
     const bool mpi_io = dolfinx::MPI::size(_comm.comm()) > 1 ? true : false;
-    _h5_id
-        = io::hdf5::open_file(_comm.comm(), hdf5_filename, file_mode, mpi_io);
+    _h5_id = io::hdf5::open_file(_comm.comm(), hdf5_filename, file_mode,
+                                 mpi_io, file_options);
     assert(_h5_id > 0);
     spdlog::info("Opened HDF5 file with id \"{}\"", _h5_id);
   }
@@ -142,16 +405,21 @@ void XDMFFile::close()
 template <std::floating_point U>
 void XDMFFile::write_mesh(const mesh::Mesh<U>& mesh, std::string xpath)
 {
+  static const std::uint32_t trace_region
+      = common::trace::region("XDMFFile::write_mesh");
+  common::TraceRegion trace(trace_region);
+
   pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
   if (!node)
     throw std::runtime_error("XML node '" + xpath + "' not found.");
 
   // Add the mesh Grid to the domain
-  xdmf_mesh::add_mesh(_comm.comm(), node, _h5_id, mesh, mesh.name);
+  xdmf_mesh::add_mesh(_comm.comm(), node, _h5_id, mesh, mesh.name,
+                      _dataset_options);
 
   // Save XML file (on process 0 only)
   if (MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+    _xml_size = save_xml(*_xml_doc, {}, _filename, _xml_size);
 }
 /// @cond
 template void XDMFFile::write_mesh(const mesh::Mesh<double>&, std::string);
@@ -173,11 +441,11 @@ void XDMFFile::write_geometry(const mesh::Geometry<double>& geometry,
 
   const std::string path_prefix = "/Geometry/" + name;
   xdmf_mesh::add_geometry_data(_comm.comm(), grid_node, _h5_id, path_prefix,
-                               geometry);
+                               geometry, _dataset_options);
 
   // Save XML file (on process 0 only)
   if (MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+    _xml_size = save_xml(*_xml_doc, {}, _filename, _xml_size);
 }
 //-----------------------------------------------------------------------------
 mesh::Mesh<double>
@@ -234,6 +502,10 @@ template <dolfinx::scalar T, std::floating_point U>
 void XDMFFile::write_function(const fem::Function<T, U>& u, double t,
                               std::string mesh_xpath)
 {
+  static const std::uint32_t trace_region
+      = common::trace::region("XDMFFile::write_function");
+  common::TraceRegion trace(trace_region);
+
   assert(_xml_doc);
 
   std::string timegrid_xpath
@@ -277,11 +549,12 @@ void XDMFFile::write_function(const fem::Function<T, U>& u, double t,
   assert(time_node);
 
   // Add the mesh Grid to the domain
-  xdmf_function::add_function(_comm.comm(), u, t, grid_node, _h5_id);
+  xdmf_function::add_function(_comm.comm(), u, t, grid_node, _h5_id,
+                              _dataset_options, _output_maps.get());
 
   // Save XML file (on process 0 only)
   if (dolfinx::MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+    _xml_size = save_xml(*_xml_doc, grid_node, _filename, _xml_size);
 }
 //-----------------------------------------------------------------------------
 // Instantiation for different types
@@ -317,11 +590,11 @@ void XDMFFile::write_meshtags(const mesh::MeshTags<std::int32_t>& meshtags,
   geo_ref_node.append_attribute("xpointer") = geo_ref_path.c_str();
   assert(geo_ref_node);
   xdmf_mesh::add_meshtags(_comm.comm(), meshtags, x, grid_node, _h5_id,
-                          meshtags.name);
+                          meshtags.name, _dataset_options);
 
   // Save XML file (on process 0 only)
   if (MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+    _xml_size = save_xml(*_xml_doc, {}, _filename, _xml_size);
 }
 //-----------------------------------------------------------------------------
 // Instantiation for different types
@@ -337,7 +610,7 @@ template void XDMFFile::write_meshtags(const mesh::MeshTags<std::int32_t>&,
 mesh::MeshTags<std::int32_t>
 XDMFFile::read_meshtags(const mesh::Mesh<double>& mesh, std::string name,
                         std::optional<std::string> attribute_name,
-                        std::string xpath)
+                        std::string xpath, std::int64_t chunk_size)
 {
   spdlog::info("XDMF read meshtags ({})", name);
   pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
@@ -348,8 +621,6 @@ XDMFFile::read_meshtags(const mesh::Mesh<double>& mesh, std::string name,
   if (!grid_node)
     throw std::runtime_error("<Grid> with name '" + name + "' not found.");
 
-  const auto [entities, eshape] = read_topology_data(name, xpath);
-
   pugi::xml_node values_data_node
       = grid_node.child("Attribute").child("DataItem");
   if (attribute_name)
@@ -366,19 +637,55 @@ XDMFFile::read_meshtags(const mesh::Mesh<double>& mesh, std::string name,
     else
       values_data_node = attribute_node.child("DataItem");
   }
-  const std::vector values = xdmf_utils::get_dataset<std::int32_t>(
-      _comm.comm(), values_data_node, _h5_id);
 
   const std::pair<std::string, int> cell_type_str
       = xdmf_utils::get_cell_type(grid_node.child("Topology"));
   mesh::CellType cell_type = mesh::to_type(cell_type_str.first);
+  const int dim = mesh::cell_dim(cell_type);
+
+  // Read tags stored by cell and local entity index if available, which
+  // avoids matching the entity vertices
+  auto find_attribute = [&grid_node](const std::string& attr_name)
+  {
+    return grid_node
+        .find_child([&attr_name](auto n)
+                    { return n.attribute("Name").value() == attr_name; })
+        .child("DataItem");
+  };
+  pugi::xml_node cells_data_node = find_attribute(name + "_cell");
+  pugi::xml_node local_entities_data_node
+      = find_attribute(name + "_local_entity");
+  std::shared_ptr<const mesh::Topology> topology = mesh.topology();
+  const int tdim = topology->dim();
+  auto is_hdf = [](pugi::xml_node n)
+  { return n and std::string(n.attribute("Format").value()) == "HDF"; };
+  if (is_hdf(cells_data_node) and is_hdf(local_entities_data_node)
+      and is_hdf(values_data_node) and topology->cell_types().size() == 1
+      and topology->index_map(dim)
+      and (dim == tdim or topology->connectivity(tdim, dim)))
+  {
+    std::array paths
+        = {xdmf_utils::get_hdf5_paths(cells_data_node)[1],
+           xdmf_utils::get_hdf5_paths(local_entities_data_node)[1],
+           xdmf_utils::get_hdf5_paths(values_data_node)[1]};
+    auto [indices, values]
+        = read_tags_by_cell(*topology, dim, _h5_id, paths, chunk_size);
+    mesh::MeshTags<std::int32_t> meshtags(topology, dim, std::move(indices),
+                                          std::move(values));
+    meshtags.name = name;
+    return meshtags;
+  }
+
+  auto [entities, eshape] = read_topology_data(name, xpath);
+  const std::vector values = xdmf_utils::get_dataset<std::int32_t>(
+      _comm.comm(), values_data_node, _h5_id);
 
   // Permute entities from VTK to DOLFINx ordering
-  std::vector<std::int64_t> entities1 = io::cells::apply_permutation(
+  io::cells::apply_permutation_inplace(
       entities, eshape, io::cells::perm_vtk(cell_type, eshape[1]));
 
   md::mdspan<const std::int64_t, md::dextents<std::size_t, 2>> entities_span(
-      entities1.data(), eshape);
+      entities.data(), eshape);
   std::pair<std::vector<std::int32_t>, std::vector<std::int32_t>>
       entities_values = io::distribute_entity_data<std::int32_t>(
           *mesh.topology(), mesh.geometry().input_global_indices(),
@@ -441,7 +748,7 @@ void XDMFFile::write_information(std::string name, std::string value,
 
   // Save XML file (on process 0 only)
   if (MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+    _xml_size = save_xml(*_xml_doc, {}, _filename, _xml_size);
 }
 //-----------------------------------------------------------------------------
 std::string XDMFFile::read_information(std::string name, std::string xpath)
@@ -462,3 +769,13 @@ std::string XDMFFile::read_information(std::string name, std::string xpath)
 //-----------------------------------------------------------------------------
 MPI_Comm XDMFFile::comm() const { return _comm.comm(); }
 //-----------------------------------------------------------------------------
+const hdf5::DatasetOptions& XDMFFile::dataset_options() const
+{
+  return _dataset_options;
+}
+//-----------------------------------------------------------------------------
+void XDMFFile::set_dataset_options(const hdf5::DatasetOptions& options)
+{
+  _dataset_options = options;
+}
+//-----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 
 #include "HDF5Interface.h"
 #include <concepts>
+#include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <filesystem>
@@ -44,6 +45,7 @@ class MeshTags;
 
 namespace dolfinx::io
 {
+class OutputMapCache;
 
 /// @brief Read and write mesh::Mesh, fem::Function and other objects in
 /// XDMF.
@@ -65,9 +67,37 @@ public:
     ASCII
   };
 
-  /// Constructor
+  /// @brief Constructor.
+  /// @param[in] comm MPI communicator.
+  /// @param[in] filename Name of the XDMF file.
+  /// @param[in] file_mode File mode (w, r, a).
+  /// @param[in] encoding Encoding of the data.
+  /// @param[in] dataset_options Chunking and compression of the HDF5
+  /// datasets that are written, e.g. deflate level 4 with shuffle for
+  /// smooth floating point data. Reading supports any filter that is
+  /// available to HDF5.
+  /// @param[in] num_aggregators Number of processes that access the
+  /// HDF5 file in collective reads and writes, see hdf5::open_file. If
+  /// 0, the MPI-IO default is used.
   XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
-           std::string file_mode, Encoding encoding = Encoding::HDF5);
+           std::string file_mode, Encoding encoding = Encoding::HDF5,
+           const hdf5::DatasetOptions& dataset_options = {},
+           int num_aggregators = 0);
+
+  /// @brief Constructor.
+  /// @param[in] comm MPI communicator.
+  /// @param[in] filename Name of the XDMF file.
+  /// @param[in] file_mode File mode (w, r, a).
+  /// @param[in] encoding Encoding of the data.
+  /// @param[in] dataset_options Chunking, compression and collective or
+  /// independent transfer of the HDF5 datasets that are written.
+  /// @param[in] file_options MPI-IO access options of the HDF5 file,
+  /// e.g. collective metadata operations and alignment to the stripes
+  /// of a parallel file system.
+  XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
+           std::string file_mode, Encoding encoding,
+           const hdf5::DatasetOptions& dataset_options,
+           const hdf5::FileOptions& file_options);
 
   /// Move constructor
   XDMFFile(XDMFFile&&) = default;
@@ -143,6 +173,11 @@ public:
   /// (io::VTXWriter) format is recommended over XDMF for discontinuous
   /// and/or high-order spaces.
   ///
+  /// @note The mesh topology and geometry are not written; the time
+  /// step references the mesh Grid at `mesh_xpath`. Only the function
+  /// values are written to HDF5, and steps after the first are appended
+  /// to the XML file rather than re-writing it.
+  ///
   /// @param[in] u Function to write to file.
   /// @param[in] t Time stamp to associate with `u`.
   /// @param[in] mesh_xpath XPath for a Grid under which `u` will be
@@ -163,17 +198,30 @@ public:
                       const mesh::Geometry<T>& x, std::string geometry_xpath,
                       std::string xpath = "/Xdmf/Domain");
 
-  /// Read MeshTags
+  /// @brief Read MeshTags.
+  ///
+  /// Tags written by write_meshtags store the global index of a cell
+  /// containing each entity and the local index of the entity in the
+  /// cell. If `mesh` has the cell-entity connectivity and the data is
+  /// stored in HDF5, the tags are then read in chunks and sent to the
+  /// processes that own the cells, which uses less memory than
+  /// matching the entity vertices. This requires that `mesh` has been
+  /// read from this file. Otherwise the entities are matched by their
+  /// vertices.
+  ///
   /// @param[in] mesh Mesh that the input data is defined on
   /// @param[in] name Name of the grid node in the xml-scheme of the
   /// XDMF-file. E.g. "Material" in Grid Name="Material"
   /// GridType="Uniform"
   /// @param[in] attribute_name Name of the attribute to read
   /// @param[in] xpath XPath where MeshTags Grid is stored in file
+  /// @param[in] chunk_size Maximum number of tags that a process reads
+  /// at once.
   mesh::MeshTags<std::int32_t>
   read_meshtags(const mesh::Mesh<double>& mesh, std::string name,
                 std::optional<std::string> attribute_name,
-                std::string xpath = "/Xdmf/Domain");
+                std::string xpath = "/Xdmf/Domain",
+                std::int64_t chunk_size = 1 << 20);
 
   /// Write Information
   /// @param[in] name
@@ -192,6 +240,19 @@ public:
   /// @return The MPI communicator for the file object
   MPI_Comm comm() const;
 
+  /// @brief Storage options of the HDF5 datasets that are written.
+  const hdf5::DatasetOptions& dataset_options() const;
+
+  /// @brief Set the storage options of the HDF5 datasets that are
+  /// written next.
+  ///
+  /// The options can be changed between writes to store each field
+  /// differently, e.g. a Function for visualisation with
+  /// hdf5::DatasetOptions::float_bits = 32 and the mesh geometry with
+  /// full precision.
+  /// @param[in] options Storage options.
+  void set_dataset_options(const hdf5::DatasetOptions& options);
+
 private:
   // MPI communicator
   dolfinx::MPI::Comm _comm;
@@ -210,6 +271,17 @@ private:
   std::unique_ptr<pugi::xml_document> _xml_doc;
 
   Encoding _encoding;
+
+  // Storage options of written HDF5 datasets
+  hdf5::DatasetOptions _dataset_options;
+
+  // Maps from the dofs of written Functions to the output values, which
+  // are re-used by later writes of Functions on the same spaces
+  std::unique_ptr<OutputMapCache> _output_maps;
+
+  // Size of the XML file after the last write (on process 0), or -1.
+  // Used to append steps of time series to the file.
+  std::int64_t _xml_size = -1;
 };
 
 } // namespace dolfinx::io
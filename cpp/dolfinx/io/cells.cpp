@@ -10,9 +10,13 @@
 #include <cstdint>
 #include <dolfinx/common/log.h>
 #include <dolfinx/mesh/cell_types.h>
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 using namespace dolfinx;
@@ -520,10 +524,8 @@ std::vector<std::uint16_t> gmsh_pyramid(int num_nodes)
     throw std::runtime_error("Higher order Gmsh pyramid not supported");
   }
 }
-} // namespace
 //-----------------------------------------------------------------------------
-std::vector<std::uint16_t> io::cells::perm_vtk(mesh::CellType type,
-                                               int num_nodes)
+std::vector<std::uint16_t> compute_perm_vtk(mesh::CellType type, int num_nodes)
 {
   std::vector<std::uint16_t> map;
   switch (type)
@@ -557,11 +559,10 @@ std::vector<std::uint16_t> io::cells::perm_vtk(mesh::CellType type,
     throw std::runtime_error("Unknown cell type.");
   }
 
-  return cells::transpose(map);
+  return io::cells::transpose(map);
 }
 //-----------------------------------------------------------------------------
-std::vector<std::uint16_t> io::cells::perm_gmsh(mesh::CellType type,
-                                                int num_nodes)
+std::vector<std::uint16_t> compute_perm_gmsh(mesh::CellType type, int num_nodes)
 {
   std::vector<std::uint16_t> map;
   switch (type)
@@ -595,7 +596,112 @@ std::vector<std::uint16_t> io::cells::perm_gmsh(mesh::CellType type,
     throw std::runtime_error("Unknown cell type.");
   }
 
-  return cells::transpose(map);
+  return io::cells::transpose(map);
+}
+//-----------------------------------------------------------------------------
+
+// Permutations by (cell type, number of nodes)
+using perm_cache_t
+    = std::map<std::pair<mesh::CellType, int>, std::vector<std::uint16_t>>;
+
+// Get a permutation from a cache, computing it if it is not cached
+std::vector<std::uint16_t>
+cached_perm(perm_cache_t& cache, std::mutex& mutex, mesh::CellType type,
+            int num_nodes,
+            std::vector<std::uint16_t> (*compute)(mesh::CellType, int))
+{
+  std::scoped_lock lock(mutex);
+  auto it = cache.find({type, num_nodes});
+  if (it == cache.end())
+  {
+    it = cache.emplace(std::pair(type, num_nodes), compute(type, num_nodes))
+             .first;
+  }
+  return it->second;
+}
+//-----------------------------------------------------------------------------
+
+// Call `f(std::integral_constant<std::size_t, N>())` with `N =
+// num_nodes` for the numbers of nodes of common cells, and with `N =
+// 0` otherwise, so that kernels can use compile-time sized loops
+template <typename F>
+void dispatch_num_nodes(std::size_t num_nodes, F&& f)
+{
+  switch (num_nodes)
+  {
+  case 2:
+    return f(std::integral_constant<std::size_t, 2>());
+  case 3:
+    return f(std::integral_constant<std::size_t, 3>());
+  case 4:
+    return f(std::integral_constant<std::size_t, 4>());
+  case 6:
+    return f(std::integral_constant<std::size_t, 6>());
+  case 8:
+    return f(std::integral_constant<std::size_t, 8>());
+  case 9:
+    return f(std::integral_constant<std::size_t, 9>());
+  case 10:
+    return f(std::integral_constant<std::size_t, 10>());
+  case 27:
+    return f(std::integral_constant<std::size_t, 27>());
+  default:
+    return f(std::integral_constant<std::size_t, 0>());
+  }
+}
+//-----------------------------------------------------------------------------
+
+// Permute the nodes of each cell, `out[c, i] = cells[c, p[i]]`. `out`
+// may be the same array as `cells`. If `N > 0`, the number of nodes
+// is `N`, otherwise it is `p.size()`.
+template <std::size_t N>
+void permute_cells(std::span<const std::int64_t> cells,
+                   std::span<const std::uint16_t> p,
+                   std::span<std::int64_t> out)
+{
+  if constexpr (N == 0)
+  {
+    const std::size_t n = p.size();
+    if (n == 0)
+      return;
+    std::vector<std::int64_t> cell(n);
+    for (std::size_t c = 0; c < cells.size() / n; ++c)
+    {
+      std::copy_n(std::next(cells.begin(), c * n), n, cell.begin());
+      for (std::size_t i = 0; i < n; ++i)
+        out[c * n + i] = cell[p[i]];
+    }
+  }
+  else
+  {
+    assert(p.size() == N);
+    std::array<std::uint16_t, N> perm;
+    std::ranges::copy(p, perm.begin());
+    std::array<std::int64_t, N> cell;
+    for (std::size_t c = 0; c < cells.size() / N; ++c)
+    {
+      std::copy_n(std::next(cells.begin(), c * N), N, cell.begin());
+      for (std::size_t i = 0; i < N; ++i)
+        out[c * N + i] = cell[perm[i]];
+    }
+  }
+}
+} // namespace
+//-----------------------------------------------------------------------------
+std::vector<std::uint16_t> io::cells::perm_vtk(mesh::CellType type,
+                                               int num_nodes)
+{
+  static perm_cache_t cache;
+  static std::mutex mutex;
+  return cached_perm(cache, mutex, type, num_nodes, compute_perm_vtk);
+}
+//-----------------------------------------------------------------------------
+std::vector<std::uint16_t> io::cells::perm_gmsh(mesh::CellType type,
+                                                int num_nodes)
+{
+  static perm_cache_t cache;
+  static std::mutex mutex;
+  return cached_perm(cache, mutex, type, num_nodes, compute_perm_gmsh);
 }
 //-----------------------------------------------------------------------------
 int io::cells::cell_degree(mesh::CellType type, int num_nodes)
@@ -694,16 +800,29 @@ io::cells::apply_permutation(std::span<const std::int64_t> cells,
 
   spdlog::info("IO permuting cells");
   std::vector<std::int64_t> cells_new(cells.size());
-  for (std::size_t c = 0; c < shape[0]; ++c)
-  {
-    auto cell = cells.subspan(c * shape[1], shape[1]);
-    std::span cell_new(cells_new.data() + c * shape[1], shape[1]);
-    for (std::size_t i = 0; i < shape[1]; ++i)
-      cell_new[i] = cell[p[i]];
-  }
+  dispatch_num_nodes(shape[1],
+                     [&]<std::size_t N>(std::integral_constant<std::size_t, N>)
+                     { permute_cells<N>(cells, p, cells_new); });
   return cells_new;
 }
 //-----------------------------------------------------------------------------
+void io::cells::apply_permutation_inplace(std::span<std::int64_t> cells,
+                                          std::array<std::size_t, 2> shape,
+                                          std::span<const std::uint16_t> p)
+{
+  assert(cells.size() == shape[0] * shape[1]);
+  assert(shape[1] == p.size());
+
+  spdlog::info("IO permuting cells in-place");
+  // Nothing to do for the identity permutation
+  if (std::ranges::is_sorted(p))
+    return;
+
+  dispatch_num_nodes(shape[1],
+                     [&]<std::size_t N>(std::integral_constant<std::size_t, N>)
+                     { permute_cells<N>(cells, p, cells); });
+}
+//-----------------------------------------------------------------------------
 std::int8_t io::cells::get_vtk_cell_type(mesh::CellType cell, int dim)
 {
   if (cell == mesh::CellType::prism and dim == 2)
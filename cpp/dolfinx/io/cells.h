@@ -135,6 +135,8 @@ int cell_degree(mesh::CellType type, int num_nodes);
 ///
 /// @details If `p = [0, 2, 1, 3]` and `a = [10, 3, 4, 7]`, then `a_p =
 /// [a[p[0]], a[p[1]], a[p[2]], a[p[3]]] = [10, 4, 3, 7]`.
+/// @note The permutation is computed once for each cell type and
+/// number of nodes, and is then returned from a cache.
 std::vector<std::uint16_t> perm_vtk(mesh::CellType type, int num_nodes);
 
 /// @brief Permutation array to map from Gmsh to DOLFINx node ordering.
@@ -146,6 +148,8 @@ std::vector<std::uint16_t> perm_vtk(mesh::CellType type, int num_nodes);
 ///
 /// @details If `p = [0, 2, 1, 3]` and `a = [10, 3, 4, 7]`, then `a_p
 /// =[a[p[0]], a[p[1]], a[p[2]], a[p[3]]] = [10, 4, 3, 7]`.
+/// @note The permutation is computed once for each cell type and
+/// number of nodes, and is then returned from a cache.
 std::vector<std::uint16_t> perm_gmsh(mesh::CellType type, int num_nodes);
 
 /// @brief Compute the transpose of a re-ordering map.
@@ -166,10 +170,26 @@ std::vector<std::uint16_t> transpose(std::span<const std::uint16_t> map);
 /// @return Permuted cell topology, where for a cell `v_new[i] =
 /// v_old[map[i]]`. The storage is row-major and the shape is the same
 /// as `cells`.
+/// @note The permutation loop is sized at compile time for the numbers
+/// of nodes of common cells.
 std::vector<std::int64_t> apply_permutation(std::span<const std::int64_t> cells,
                                             std::array<std::size_t, 2> shape,
                                             std::span<const std::uint16_t> p);
 
+/// @brief Permute cell topology in-place by applying a permutation
+/// array for each cell.
+///
+/// Same as ::apply_permutation, but without a copy of the topology.
+///
+/// @param[in,out] cells Array of cell topologies, with each row
+/// representing a cell (row-major storage).
+/// @param[in] shape Shape of the `cells` array.
+/// @param[in] p Permutation array that maps `a_p[i] = a[p[i]]`, where
+/// `a_p` is the permuted array.
+void apply_permutation_inplace(std::span<std::int64_t> cells,
+                               std::array<std::size_t, 2> shape,
+                               std::span<const std::uint16_t> p);
+
 /// @brief Get VTK cell identifier.
 ///
 /// @param[in] cell Cell type.
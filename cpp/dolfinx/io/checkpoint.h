@@ -0,0 +1,546 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "HDF5Interface.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/sort.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/graph/partitioners.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/utils.h>
+#include <filesystem>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief Checkpointing of meshes and Functions.
+///
+/// A checkpoint stores a mesh and Functions in a HDF5 file, in a layout
+/// that does not depend on the parallel distribution:
+///
+/// - `/Checkpoint/Mesh`: node coordinates (`x`), cell nodes (`cells`)
+///   and the owning rank of each cell (`owner`). Nodes and cells are
+///   ordered by their original (input) indices.
+/// - `/Checkpoint/Functions/<name>`: the raw values of the
+///   la::Vector (`values`, by global dof index), the global dofs of
+///   each cell (`cell_dofs`) and, for elements with DOF
+///   transformations, the cell permutation information (`cell_info`).
+///
+/// A checkpoint that is read on the number of processes that wrote it
+/// re-creates the partition of the mesh, without graph partitioning.
+/// On a different number of processes, the mesh is partitioned again.
+/// Functions are restored cell by cell, and the dof numbering of the
+/// restored space may differ from the numbering of the written space.
+namespace dolfinx::io::checkpoint
+{
+namespace impl
+{
+/// @brief Get the checkpoint indices of distributed rows.
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] indices Original index of each row on this process.
+/// @param[in] offset Global index of the first row on this process.
+/// @param[in] num_rows Global number of rows.
+/// @return The original indices, if they are a permutation of
+/// `[0, num_rows)`, otherwise the global indices of the rows.
+inline std::vector<std::int64_t>
+checkpoint_indices(MPI_Comm comm, std::span<const std::int64_t> indices,
+                   std::int64_t offset, std::int64_t num_rows)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Send the indices to their post office, which checks that each
+  // index in its range is received once
+  int valid = std::ranges::all_of(indices, [num_rows](auto i)
+                                  { return i >= 0 and i < num_rows; });
+  MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_LAND, comm);
+  if (valid)
+  {
+    std::vector<int> dest(indices.size());
+    std::ranges::transform(indices, dest.begin(), [size, num_rows](auto i)
+                           { return dolfinx::MPI::index_owner(size, i,
+                                                              num_rows); });
+    auto [src, data] = dolfinx::MPI::alltoallv_grid(
+        comm, dest, std::as_bytes(indices), sizeof(std::int64_t));
+
+    std::array<std::int64_t, 2> range
+        = dolfinx::MPI::local_range(rank, num_rows, size);
+    std::vector<std::int8_t> marker(range[1] - range[0], false);
+    valid = src.size() == marker.size();
+    for (std::size_t i = 0; i < src.size() and valid; ++i)
+    {
+      std::int64_t idx;
+      std::memcpy(&idx, data.data() + i * sizeof(std::int64_t),
+                  sizeof(std::int64_t));
+      valid = !marker[idx - range[0]];
+      marker[idx - range[0]] = true;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_LAND, comm);
+  }
+
+  if (valid)
+    return std::vector<std::int64_t>(indices.begin(), indices.end());
+  else
+  {
+    std::vector<std::int64_t> global(indices.size());
+    std::iota(global.begin(), global.end(), offset);
+    return global;
+  }
+}
+
+/// @brief Get the checkpoint indices of the owned cells of a mesh.
+///
+/// @param[in] mesh The mesh.
+/// @return Checkpoint index of each owned cell.
+template <std::floating_point U>
+std::vector<std::int64_t> cell_indices(const mesh::Mesh<U>& mesh)
+{
+  std::shared_ptr<const mesh::Topology> topology = mesh.topology();
+  if (topology->cell_types().size() != 1)
+  {
+    throw std::runtime_error("Checkpoints of meshes with more than one cell "
+                             "type are not supported.");
+  }
+
+  std::shared_ptr<const common::IndexMap> map
+      = topology->index_map(topology->dim());
+  std::span<const std::int64_t> original(
+      topology->original_cell_index.front().data(), map->size_local());
+  return checkpoint_indices(mesh.comm(), original, map->local_range()[0],
+                            map->size_global());
+}
+
+/// @brief Write rows to a dataset at their checkpoint indices.
+///
+/// Rows are sent to the process that writes the block of the dataset
+/// with their index, and each process then writes a contiguous block.
+///
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] path Path of the dataset.
+/// @param[in] comm MPI communicator.
+/// @param[in] indices Checkpoint index of each row.
+/// @param[in] data Rows (row-major).
+/// @param[in] shape1 Number of columns.
+/// @param[in] num_rows Global number of rows.
+template <typename T>
+void write_rows(hid_t h5_id, const std::string& path, MPI_Comm comm,
+                std::span<const std::int64_t> indices, std::span<const T> data,
+                std::size_t shape1, std::int64_t num_rows)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Pack each row with its index
+  const std::size_t row_size = sizeof(std::int64_t) + shape1 * sizeof(T);
+  std::vector<int> dest(indices.size());
+  std::vector<std::byte> rows(indices.size() * row_size);
+  for (std::size_t i = 0; i < indices.size(); ++i)
+  {
+    dest[i] = dolfinx::MPI::index_owner(size, indices[i], num_rows);
+    std::byte* row = rows.data() + i * row_size;
+    std::memcpy(row, &indices[i], sizeof(std::int64_t));
+    std::memcpy(row + sizeof(std::int64_t), data.data() + i * shape1,
+                shape1 * sizeof(T));
+  }
+  auto [src, recv_rows] = dolfinx::MPI::alltoallv_grid(comm, dest, rows,
+                                                       row_size);
+
+  // Place received rows in the block of this process
+  std::array<std::int64_t, 2> range
+      = dolfinx::MPI::local_range(rank, num_rows, size);
+  std::vector<T> block((range[1] - range[0]) * shape1);
+  for (std::size_t i = 0; i < src.size(); ++i)
+  {
+    const std::byte* row = recv_rows.data() + i * row_size;
+    std::int64_t idx;
+    std::memcpy(&idx, row, sizeof(std::int64_t));
+    std::memcpy(block.data() + (idx - range[0]) * shape1,
+                row + sizeof(std::int64_t), shape1 * sizeof(T));
+  }
+
+  hdf5::write_dataset(h5_id, path, block.data(), range,
+                      {num_rows, static_cast<std::int64_t>(shape1)}, true);
+}
+
+/// @brief Read the block of a dataset for this process.
+///
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] path Path of the dataset.
+/// @param[in] comm MPI communicator.
+/// @return The block of rows (row-major) and the shape of the dataset.
+template <typename T>
+std::pair<std::vector<T>, std::vector<std::int64_t>>
+read_block(hid_t h5_id, const std::string& path, MPI_Comm comm)
+{
+  if (!hdf5::has_dataset(h5_id, path))
+    throw std::runtime_error("Checkpoint has no dataset " + path + ".");
+  std::vector<std::int64_t> shape = hdf5::get_dataset_shape(h5_id, path);
+  std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(comm), shape[0], dolfinx::MPI::size(comm));
+  hid_t dset_id = hdf5::open_dataset(h5_id, path);
+  std::vector<T> data = hdf5::read_dataset<T>(dset_id, range, true);
+  if (H5Dclose(dset_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 dataset.");
+  return {std::move(data), std::move(shape)};
+}
+
+/// @brief Write an integer attribute.
+inline void write_attribute(hid_t h5_id, const std::string& group,
+                            const std::string& name, std::int32_t value)
+{
+  hid_t group_id = H5Gopen(h5_id, group.c_str(), H5P_DEFAULT);
+  hid_t space_id = H5Screate(H5S_SCALAR);
+  hid_t attr_id = H5Acreate(group_id, name.c_str(), H5T_NATIVE_INT32,
+                            space_id, H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(attr_id, H5T_NATIVE_INT32, &value);
+  H5Aclose(attr_id);
+  H5Sclose(space_id);
+  H5Gclose(group_id);
+}
+
+/// @brief Read an integer attribute.
+inline std::int32_t read_attribute(hid_t h5_id, const std::string& group,
+                                   const std::string& name)
+{
+  hid_t attr_id = H5Aopen_by_name(h5_id, group.c_str(), name.c_str(),
+                                  H5P_DEFAULT, H5P_DEFAULT);
+  if (attr_id < 0)
+    throw std::runtime_error("Checkpoint has no attribute " + name + ".");
+  std::int32_t value;
+  H5Aread(attr_id, H5T_NATIVE_INT32, &value);
+  H5Aclose(attr_id);
+  return value;
+}
+} // namespace impl
+
+/// @brief Write a mesh to a checkpoint file.
+///
+/// A new file is created. Functions on the mesh can then be added with
+/// write_function.
+///
+/// @note Collective.
+///
+/// @param[in] filename Name of the file.
+/// @param[in] mesh Mesh to write. Must have one cell type.
+template <std::floating_point U>
+void write_mesh(const std::filesystem::path& filename,
+                const mesh::Mesh<U>& mesh)
+{
+  MPI_Comm comm = mesh.comm();
+  std::shared_ptr<const mesh::Topology> topology = mesh.topology();
+  const mesh::Geometry<U>& geometry = mesh.geometry();
+  std::shared_ptr<const common::IndexMap> map_c
+      = topology->index_map(topology->dim());
+  std::shared_ptr<const common::IndexMap> map_x = geometry.index_map();
+  const std::int32_t num_cells = map_c->size_local();
+  const std::int32_t num_nodes = map_x->size_local();
+
+  // Checkpoint indices of the owned cells and nodes, and of the ghost
+  // nodes from their owners
+  std::vector<std::int64_t> cell_idx = impl::cell_indices(mesh);
+  std::vector<std::int64_t> node_idx = impl::checkpoint_indices(
+      comm,
+      std::span(geometry.input_global_indices()).first(num_nodes),
+      map_x->local_range()[0], map_x->size_global());
+  std::vector<std::int64_t> ghost_idx = dolfinx::MPI::distribute_data(
+      comm, map_x->ghosts(), comm, node_idx, 1);
+  std::vector<std::int64_t> local_idx = node_idx;
+  local_idx.insert(local_idx.end(), ghost_idx.begin(), ghost_idx.end());
+
+  // Cell nodes and owned node coordinates
+  md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> x_dofmap
+      = geometry.dofmap();
+  std::vector<std::int64_t> cells(num_cells * x_dofmap.extent(1));
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    for (std::size_t j = 0; j < x_dofmap.extent(1); ++j)
+      cells[c * x_dofmap.extent(1) + j] = local_idx[x_dofmap(c, j)];
+
+  const std::size_t gdim = geometry.dim();
+  std::span<const U> x = geometry.x();
+  std::vector<U> x_owned(num_nodes * gdim);
+  for (std::int32_t i = 0; i < num_nodes; ++i)
+    std::copy_n(x.data() + 3 * i, gdim, x_owned.data() + gdim * i);
+
+  const std::vector<std::int32_t> owner(num_cells,
+                                        dolfinx::MPI::rank(comm));
+
+  hid_t h5_id = hdf5::open_file(comm, filename, "w", true);
+  impl::write_rows<U>(h5_id, "/Checkpoint/Mesh/x", comm, node_idx, x_owned,
+                      gdim, map_x->size_global());
+  impl::write_rows<std::int64_t>(h5_id, "/Checkpoint/Mesh/cells", comm,
+                                 cell_idx, cells, x_dofmap.extent(1),
+                                 map_c->size_global());
+  impl::write_rows<std::int32_t>(h5_id, "/Checkpoint/Mesh/owner", comm,
+                                 cell_idx, owner, 1, map_c->size_global());
+
+  // Partition and coordinate element
+  int ghosted = map_c->num_ghosts() > 0;
+  MPI_Allreduce(MPI_IN_PLACE, &ghosted, 1, MPI_INT, MPI_LOR, comm);
+  const fem::CoordinateElement<U>& cmap = geometry.cmap();
+  const std::string group = "/Checkpoint/Mesh";
+  impl::write_attribute(h5_id, group, "NumProcesses",
+                        dolfinx::MPI::size(comm));
+  impl::write_attribute(h5_id, group, "Ghosted", ghosted);
+  impl::write_attribute(h5_id, group, "CellType",
+                        static_cast<std::int32_t>(cmap.cell_shape()));
+  impl::write_attribute(h5_id, group, "Degree", cmap.degree());
+  impl::write_attribute(h5_id, group, "LagrangeVariant",
+                        static_cast<std::int32_t>(cmap.variant()));
+  hdf5::close_file(h5_id);
+}
+
+/// @brief Read a mesh from a checkpoint file.
+///
+/// If the number of processes is the same as when the mesh was
+/// written, the cells are sent to the process that owned them, and
+/// ghosts are re-created if the written mesh had ghost cells. Otherwise
+/// the mesh is partitioned with the default graph partitioner.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator to create the mesh on.
+/// @param[in] filename Name of the file.
+/// @return The mesh. The original cell and node indices are the
+/// indices of the written mesh.
+template <std::floating_point U>
+mesh::Mesh<U> read_mesh(MPI_Comm comm, const std::filesystem::path& filename)
+{
+  hid_t h5_id = hdf5::open_file(comm, filename, "r", true);
+  auto [x, x_shape] = impl::read_block<U>(h5_id, "/Checkpoint/Mesh/x", comm);
+  auto [cells, cells_shape]
+      = impl::read_block<std::int64_t>(h5_id, "/Checkpoint/Mesh/cells", comm);
+  auto [owner, owner_shape]
+      = impl::read_block<std::int32_t>(h5_id, "/Checkpoint/Mesh/owner", comm);
+
+  const std::string group = "/Checkpoint/Mesh";
+  const int num_processes
+      = impl::read_attribute(h5_id, group, "NumProcesses");
+  const mesh::GhostMode ghost_mode
+      = impl::read_attribute(h5_id, group, "Ghosted")
+            ? mesh::GhostMode::shared_facet
+            : mesh::GhostMode::none;
+  fem::CoordinateElement<U> element(
+      static_cast<mesh::CellType>(
+          impl::read_attribute(h5_id, group, "CellType")),
+      impl::read_attribute(h5_id, group, "Degree"),
+      static_cast<basix::element::lagrange_variant>(
+          impl::read_attribute(h5_id, group, "LagrangeVariant")));
+  hdf5::close_file(h5_id);
+
+  mesh::CellPartitionFunction partitioner;
+  if (const int size = dolfinx::MPI::size(comm); size == num_processes)
+  {
+    if (size > 1)
+    {
+      partitioner = mesh::create_cell_partitioner(
+          ghost_mode, graph::fixed::partitioner(std::move(owner)));
+    }
+  }
+  else
+    partitioner = mesh::create_cell_partitioner(ghost_mode);
+
+  const std::size_t gdim = x_shape[1];
+  return mesh::create_mesh(comm, comm, cells, element, comm, x,
+                           {x.size() / gdim, gdim}, partitioner);
+}
+
+/// @brief Add a Function to a checkpoint file.
+///
+/// The file must hold the mesh of the Function, written by write_mesh.
+/// The Function is stored by its name.
+///
+/// @note Collective.
+///
+/// @param[in] filename Name of the file.
+/// @param[in] u Function to write. Must not be a sub-Function.
+template <dolfinx::scalar T, std::floating_point U>
+void write_function(const std::filesystem::path& filename,
+                    const fem::Function<T, U>& u)
+{
+  std::shared_ptr<const fem::FunctionSpace<U>> V = u.function_space();
+  assert(V);
+  if (!V->component().empty())
+  {
+    throw std::runtime_error("Cannot checkpoint a sub-Function. Collapse "
+                             "the Function first.");
+  }
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = V->mesh();
+  MPI_Comm comm = mesh->comm();
+  std::shared_ptr<const fem::DofMap> dofmap = V->dofmap();
+  std::shared_ptr<const common::IndexMap> map = dofmap->index_map;
+  const int bs = dofmap->index_map_bs();
+  std::shared_ptr<const common::IndexMap> map_c
+      = mesh->topology()->index_map(mesh->topology()->dim());
+  const std::int32_t num_cells = map_c->size_local();
+
+  // Global dofs of the owned cells
+  std::vector<std::int64_t> cell_idx = impl::cell_indices(*mesh);
+  md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> dofs
+      = dofmap->map();
+  std::vector<std::int64_t> cell_dofs(num_cells * dofs.extent(1));
+  map->local_to_global(
+      std::span(dofs.data_handle(), cell_dofs.size()), cell_dofs);
+
+  hid_t h5_id = hdf5::open_file(comm, filename, "a", true);
+  const std::string group = "/Checkpoint/Functions/" + u.name;
+  impl::write_rows<std::int64_t>(h5_id, group + "/cell_dofs", comm, cell_idx,
+                                 cell_dofs, dofs.extent(1),
+                                 map_c->size_global());
+
+  // Values of the owned dofs. Complex values are written as pairs of
+  // real values.
+  constexpr int vs = std::is_same_v<T, scalar_value_t<T>> ? 1 : 2;
+  hdf5::write_dataset(
+      h5_id, group + "/values",
+      reinterpret_cast<const scalar_value_t<T>*>(u.x()->array().data()),
+      map->local_range(), {map->size_global(), vs * bs}, true);
+
+  if (V->element()->needs_dof_transformations())
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+    std::span<const std::uint32_t> cell_info
+        = mesh->topology()->get_cell_permutation_info();
+    impl::write_rows<std::uint32_t>(h5_id, group + "/cell_info", comm,
+                                    cell_idx, cell_info.first(num_cells), 1,
+                                    map_c->size_global());
+  }
+
+  hdf5::close_file(h5_id);
+}
+
+/// @brief Read the values of a Function from a checkpoint file.
+///
+/// The mesh of the Function must have been read with read_mesh, from
+/// the same file, and the Function space must have the element of the
+/// written Function. The Function is found by its name.
+///
+/// @note Collective.
+///
+/// @param[in] filename Name of the file.
+/// @param[in,out] u Function to read the values into.
+template <dolfinx::scalar T, std::floating_point U>
+void read_function(const std::filesystem::path& filename,
+                   fem::Function<T, U>& u)
+{
+  std::shared_ptr<const fem::FunctionSpace<U>> V = u.function_space();
+  assert(V);
+  if (!V->component().empty())
+    throw std::runtime_error("Cannot read a sub-Function from a checkpoint.");
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = V->mesh();
+  MPI_Comm comm = mesh->comm();
+  std::shared_ptr<const fem::DofMap> dofmap = V->dofmap();
+  const int bs = dofmap->index_map_bs();
+  md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> dofs
+      = dofmap->map();
+  const std::size_t num_dofs = dofs.extent(1);
+  std::shared_ptr<const mesh::Topology> topology = mesh->topology();
+  const std::vector<std::int64_t>& cell_idx
+      = topology->original_cell_index.front();
+
+  // Dofs of the local cells, from the process that holds their row
+  hid_t h5_id = hdf5::open_file(comm, filename, "r", true);
+  const std::string group = "/Checkpoint/Functions/" + u.name;
+  auto [dofs_block, dofs_shape]
+      = impl::read_block<std::int64_t>(h5_id, group + "/cell_dofs", comm);
+  if (dofs_shape[1] != static_cast<std::int64_t>(num_dofs))
+  {
+    hdf5::close_file(h5_id);
+    throw std::runtime_error("Number of cell dofs in checkpoint does not "
+                             "match the Function space.");
+  }
+  std::vector<std::int64_t> cell_dofs = dolfinx::MPI::distribute_data(
+      comm, cell_idx, comm, dofs_block, num_dofs);
+
+  // Values of the dofs
+  constexpr int vs = std::is_same_v<T, scalar_value_t<T>> ? 1 : 2;
+  auto [values_block, values_shape] = impl::read_block<scalar_value_t<T>>(
+      h5_id, group + "/values", comm);
+  if (values_shape[1] != vs * bs
+      or values_shape[0] != dofmap->index_map->size_global())
+  {
+    hdf5::close_file(h5_id);
+    throw std::runtime_error(
+        "Size of Function in checkpoint does not match the Function space.");
+  }
+  std::vector<std::int64_t> required = cell_dofs;
+  dolfinx::radix_sort(required);
+  required.erase(std::unique(required.begin(), required.end()),
+                 required.end());
+  std::vector<scalar_value_t<T>> _values = dolfinx::MPI::distribute_data(
+      comm, required, comm, values_block, vs * bs);
+  std::span<const T> values(reinterpret_cast<const T*>(_values.data()),
+                            required.size() * bs);
+
+  // Cell permutations of the written and the restored mesh
+  const bool transform = V->element()->needs_dof_transformations();
+  std::vector<std::uint32_t> cell_info0;
+  std::span<const std::uint32_t> cell_info1;
+  if (transform)
+  {
+    auto [info_block, info_shape]
+        = impl::read_block<std::uint32_t>(h5_id, group + "/cell_info", comm);
+    cell_info0
+        = dolfinx::MPI::distribute_data(comm, cell_idx, comm, info_block, 1);
+    mesh->topology_mutable()->create_entity_permutations();
+    cell_info1 = topology->get_cell_permutation_info();
+  }
+  hdf5::close_file(h5_id);
+
+  // Map the values in the reference basis of each cell to the dofs of
+  // the cell. The local cells are the same cells that were written,
+  // with the same nodes.
+  auto T_fn = V->element()->template dof_transformation_fn<T>(
+      fem::doftransform::transpose);
+  auto Tt_inv_fn = V->element()->template dof_transformation_fn<T>(
+      fem::doftransform::inverse_transpose);
+  std::span<T> x = u.x()->mutable_array();
+  std::vector<T> cell_values(num_dofs * bs);
+  for (std::size_t c = 0; c < dofs.extent(0); ++c)
+  {
+    for (std::size_t i = 0; i < num_dofs; ++i)
+    {
+      auto it = std::ranges::lower_bound(required, cell_dofs[c * num_dofs + i]);
+      std::size_t pos = std::distance(required.begin(), it);
+      std::copy_n(values.data() + pos * bs, bs, cell_values.data() + i * bs);
+    }
+
+    if (transform)
+    {
+      T_fn(cell_values, cell_info0, c, 1);
+      Tt_inv_fn(cell_values, cell_info1, c, 1);
+    }
+
+    for (std::size_t i = 0; i < num_dofs; ++i)
+      std::copy_n(cell_values.data() + i * bs, bs, x.data() + dofs(c, i) * bs);
+  }
+}
+} // namespace dolfinx::io::checkpoint
@@ -9,6 +9,8 @@ namespace dolfinx::io
 
 // DOLFINx io interface
 
+#include <dolfinx/io/ADIOS2Readers.h>
 #include <dolfinx/io/ADIOS2Writers.h>
 #include <dolfinx/io/VTKFile.h>
 #include <dolfinx/io/VTKHDF.h>
+#include <dolfinx/io/checkpoint.h>
@@ -11,6 +11,10 @@
 #include <dolfinx/common/types.h>
 #include <dolfinx/fem/ElementDofLayout.h>
 #include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <functional>
+#include <map>
+#include <memory>
 #include <mpi.h>
 #include <span>
 #include <utility>
@@ -18,6 +22,10 @@
 
 namespace dolfinx
 {
+namespace fem
+{
+class DofMap;
+}
 
 namespace io
 {
@@ -479,5 +487,108 @@ std::pair<std::vector<std::int32_t>, std::vector<T>> distribute_entity_data(
 }
 //-----------------------------------------------------------------------------}
 
+/// @brief Cache of the maps from the output values of Functions to
+/// their degree-of-freedom values.
+///
+/// A map is computed the first time it is requested for a dofmap and
+/// an output layout, e.g. the mesh whose geometry nodes are the output
+/// points, and is then re-used by later writes, which are then a
+/// gather of the degree-of-freedom values (see io::gather_output).
+///
+/// @note The dofmap and the layout are assumed to not change. The
+/// entries of destroyed dofmaps and layouts are removed when the cache
+/// is accessed.
+/// @note This class is not thread-safe.
+class OutputMapCache
+{
+public:
+  /// @brief Get a map, computing it if it is not cached.
+  /// @param[in] dofmap Dofmap of the Function space.
+  /// @param[in] layout Object that defines the output layout.
+  /// @param[in] compute Function that computes the map. Entry `m * r +
+  /// k` of the map is the index in the Function vector of value `k` of
+  /// output `r`, where `m` is the number of values per output, or -1 if
+  /// the value is not set.
+  /// @return The map. The array is valid until the cache is cleared or
+  /// destroyed.
+  const std::vector<std::int32_t>&
+  operator()(std::shared_ptr<const fem::DofMap> dofmap,
+             std::shared_ptr<const void> layout,
+             const std::function<std::vector<std::int32_t>()>& compute)
+  {
+    assert(dofmap);
+    assert(layout);
+
+    // Drop the maps of destroyed dofmaps and layouts, so that the cache
+    // does not grow when the written spaces change
+    std::erase_if(_entries,
+                  [](const auto& e)
+                  {
+                    return e.second.dofmap.expired()
+                           or e.second.layout.expired();
+                  });
+
+    auto [it, inserted]
+        = _entries.try_emplace(std::pair(dofmap.get(), layout.get()));
+    Entry& e = it->second;
+    if (inserted or e.dofmap.lock() != dofmap or e.layout.lock() != layout)
+    {
+      e.dofmap = dofmap;
+      e.layout = layout;
+      e.map = compute();
+    }
+
+    return e.map;
+  }
+
+  /// @brief Remove all cached maps.
+  void clear() { _entries.clear(); }
+
+  /// @brief Number of cached maps.
+  std::size_t size() const { return _entries.size(); }
+
+private:
+  // Cached map, and the dofmap and layout that it was computed for
+  struct Entry
+  {
+    std::weak_ptr<const fem::DofMap> dofmap;
+    std::weak_ptr<const void> layout;
+    std::vector<std::int32_t> map;
+  };
+
+  // Map from (dofmap, layout) to cached map
+  std::map<std::pair<const fem::DofMap*, const void*>, Entry> _entries;
+};
+
+/// @brief Gather output values from degree-of-freedom values.
+///
+/// Sets `out[num_components * r + k] = x[map[m * r + k]]` for each
+/// output `r` and `k < m`, where `m = map.size() / num_outputs`. Values
+/// with a negative index in `map` are not changed.
+///
+/// @param[in] x Degree-of-freedom values.
+/// @param[in] map Map from output values to `x` (see OutputMapCache).
+/// @param[in] num_outputs Number of outputs.
+/// @param[in] num_components Number of (padded) values per output in
+/// `out`.
+/// @param[in,out] out Output values.
+template <typename T>
+void gather_output(std::span<const T> x, std::span<const std::int32_t> map,
+                   std::size_t num_outputs, int num_components,
+                   std::span<T> out)
+{
+  if (num_outputs == 0)
+    return;
+  const std::size_t m = map.size() / num_outputs;
+  for (std::size_t r = 0; r < num_outputs; ++r)
+  {
+    for (std::size_t k = 0; k < m; ++k)
+    {
+      if (std::int32_t i = map[m * r + k]; i >= 0)
+        out[num_components * r + k] = x[i];
+    }
+  }
+}
+
 } // namespace io
 } // namespace dolfinx
@@ -114,7 +114,7 @@ tabulate_lagrange_dof_coordinates(const fem::FunctionSpace<T>& V)
   std::vector<T> phi_b(
       std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
   cmdspan4_t phi_full(phi_b.data(), phi_shape);
-  cmap.tabulate(0, X, Xshape, phi_b);
+  cmap.tabulate_cached(0, X, Xshape, phi_b);
   auto phi = md::submdspan(phi_full, 0, md::full_extent, md::full_extent, 0);
 
   // Loop over cells and tabulate dofs
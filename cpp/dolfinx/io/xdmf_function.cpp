@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "xdmf_function.h"
+#include "utils.h"
 #include "xdmf_mesh.h"
 #include "xdmf_utils.h"
 #include <basix/mdspan.hpp>
@@ -16,7 +17,9 @@
 #include <dolfinx/fem/FunctionSpace.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
+#include <functional>
 #include <pugixml.hpp>
+#include <span>
 #include <string>
 
 using namespace dolfinx;
@@ -45,7 +48,9 @@ std::string shape_to_string(std::span<const std::size_t> shape)
 template <dolfinx::scalar T, std::floating_point U>
 void xdmf_function::add_function(MPI_Comm comm, const fem::Function<T, U>& u,
                                  double t, pugi::xml_node& xml_node,
-                                 hid_t h5_id)
+                                 hid_t h5_id,
+                                 const hdf5::DatasetOptions& options,
+                                 OutputMapCache* maps)
 {
   spdlog::info("Adding function to node \"{}\"", xml_node.path('/'));
 
@@ -89,21 +94,40 @@ void xdmf_function::add_function(MPI_Comm comm, const fem::Function<T, U>& u,
   std::vector<T> data_values;
   std::span<const T> x = u.x()->array();
 
+  // Compute the map from the output values to the dof values, or get
+  // it from the cache
+  std::vector<std::int32_t> map_b;
+  auto output_map
+      = [&](const std::function<std::vector<std::int32_t>()>& compute)
+      -> std::span<const std::int32_t>
+  {
+    if (maps)
+      return (*maps)(dofmap, mesh, compute);
+    map_b = compute();
+    return map_b;
+  };
+
   const bool cell_centred
       = element->space_dimension() / element->block_size() == 1;
+  std::int32_t num_outputs = 0;
+  std::span<const std::int32_t> map;
   if (cell_centred)
   {
-    // Get dof array and pack into array (padded where appropriate)
-    const std::int32_t num_local_cells = map_c->size_local();
-    data_values.resize(num_local_cells * num_components, 0);
-    for (std::int32_t c = 0; c < num_local_cells; ++c)
-    {
-      auto dofs = dofmap->cell_dofs(c);
-      assert(dofs.size() == 1);
-      for (std::size_t i = 0; i < dofs.size(); ++i)
-        for (int j = 0; j < bs; ++j)
-          data_values[num_components * c + j] = x[bs * dofs[i] + j];
-    }
+    // Map from cells to dofs
+    num_outputs = map_c->size_local();
+    map = output_map(
+        [&]()
+        {
+          std::vector<std::int32_t> out_map(num_outputs * bs);
+          for (std::int32_t c = 0; c < num_outputs; ++c)
+          {
+            auto dofs = dofmap->cell_dofs(c);
+            assert(dofs.size() == 1);
+            for (int j = 0; j < bs; ++j)
+              out_map[bs * c + j] = bs * dofs.front() + j;
+          }
+          return out_map;
+        });
   }
   else
   {
@@ -132,28 +156,36 @@ void xdmf_function::add_function(MPI_Comm comm, const fem::Function<T, U>& u,
                                "Function needs to be interpolated?");
     }
 
-    std::int32_t num_cells = map_c->size_local() + map_c->num_ghosts();
-    std::int32_t num_local_points = map_x->size_local();
-
-    // Get dof array and pack into array (padded where appropriate)
-    auto dofmap_x = geometry.dofmap();
-    data_values.resize(num_local_points * num_components, 0);
-    for (std::int32_t c = 0; c < num_cells; ++c)
-    {
-      auto dofs = dofmap->cell_dofs(c);
-      auto dofs_x = md::submdspan(dofmap_x, c, md::full_extent);
-      assert(dofs.size() == dofs_x.size());
-      for (std::size_t i = 0; i < dofs.size(); ++i)
-      {
-        if (dofs_x[i] < num_local_points)
+    // Map from the owned geometry nodes to dofs
+    num_outputs = map_x->size_local();
+    map = output_map(
+        [&]()
         {
-          for (int j = 0; j < bs; ++j)
-            data_values[num_components * dofs_x[i] + j] = x[bs * dofs[i] + j];
-        }
-      }
-    }
+          std::int32_t num_cells = map_c->size_local() + map_c->num_ghosts();
+          auto dofmap_x = geometry.dofmap();
+          std::vector<std::int32_t> out_map(num_outputs * bs, -1);
+          for (std::int32_t c = 0; c < num_cells; ++c)
+          {
+            auto dofs = dofmap->cell_dofs(c);
+            auto dofs_x = md::submdspan(dofmap_x, c, md::full_extent);
+            assert(dofs.size() == dofs_x.size());
+            for (std::size_t i = 0; i < dofs.size(); ++i)
+            {
+              if (dofs_x[i] < num_outputs)
+              {
+                for (int j = 0; j < bs; ++j)
+                  out_map[bs * dofs_x[i] + j] = bs * dofs[i] + j;
+              }
+            }
+          }
+          return out_map;
+        });
   }
 
+  // Pack dof values into array (padded where appropriate)
+  data_values.resize(num_outputs * num_components, 0);
+  io::gather_output<T>(x, map, num_outputs, num_components, data_values);
+
   // Global size
   const std::int64_t num_values
       = cell_centred ? map_c->size_global() : map_x->size_global();
@@ -206,7 +238,8 @@ void xdmf_function::add_function(MPI_Comm comm, const fem::Function<T, U>& u,
 
     // -- Real case, add data item
     xdmf_utils::add_data_item(attr_node, h5_id, dataset_name, u, offset,
-                              {num_values, num_components}, "", use_mpi_io);
+                              {num_values, num_components}, "", use_mpi_io,
+                              options);
   }
 }
 //-----------------------------------------------------------------------------
@@ -214,18 +247,22 @@ void xdmf_function::add_function(MPI_Comm comm, const fem::Function<T, U>& u,
 /// @cond
 template void xdmf_function::add_function(MPI_Comm,
                                           const fem::Function<float, float>&,
-                                          double, pugi::xml_node&, hid_t);
+                                          double, pugi::xml_node&, hid_t,
+                            const hdf5::DatasetOptions&, OutputMapCache*);
 template void xdmf_function::add_function(MPI_Comm,
                                           const fem::Function<double, double>&,
-                                          double, pugi::xml_node&, hid_t);
+                                          double, pugi::xml_node&, hid_t,
+                            const hdf5::DatasetOptions&, OutputMapCache*);
 template void
 xdmf_function::add_function(MPI_Comm,
                             const fem::Function<std::complex<float>, float>&,
-                            double, pugi::xml_node&, hid_t);
+                            double, pugi::xml_node&, hid_t,
+                            const hdf5::DatasetOptions&, OutputMapCache*);
 template void
 xdmf_function::add_function(MPI_Comm,
                             const fem::Function<std::complex<double>, double>&,
-                            double, pugi::xml_node&, hid_t);
+                            double, pugi::xml_node&, hid_t,
+                            const hdf5::DatasetOptions&, OutputMapCache*);
 
 /// @endcond
 //-----------------------------------------------------------------------------
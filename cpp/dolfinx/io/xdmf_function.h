@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "HDF5Interface.h"
 #include <complex>
 #include <concepts>
 #include <dolfinx/common/types.h>
@@ -25,13 +26,22 @@ template <dolfinx::scalar T, std::floating_point U>
 class Function;
 }
 
+namespace io
+{
+class OutputMapCache;
+}
+
 /// Low-level methods for reading/writing XDMF files
 namespace io::xdmf_function
 {
 
-/// Write a fem::Function to XDMF
+/// Write a fem::Function to XDMF. The HDF5 datasets are stored with
+/// `options`. If `maps` is not null, the map from the dofs of `u` to
+/// the output values is taken from, or stored in, `maps`.
 template <dolfinx::scalar T, std::floating_point U>
 void add_function(MPI_Comm comm, const fem::Function<T, U>& u, double t,
-                  pugi::xml_node& xml_node, const hid_t h5_id);
+                  pugi::xml_node& xml_node, const hid_t h5_id,
+                  const hdf5::DatasetOptions& options = {},
+                  OutputMapCache* maps = nullptr);
 } // namespace io::xdmf_function
 } // namespace dolfinx
@@ -24,7 +24,8 @@ void xdmf_mesh::add_topology_data(MPI_Comm comm, pugi::xml_node& xml_node,
                                   hid_t h5_id, std::string path_prefix,
                                   const mesh::Topology& topology,
                                   const mesh::Geometry<U>& geometry, int dim,
-                                  std::span<const std::int32_t> entities)
+                                  std::span<const std::int32_t> entities,
+                                  const hdf5::DatasetOptions& options)
 {
   spdlog::info("Adding topology data to node {}", xml_node.path('/'));
 
@@ -151,13 +152,14 @@ void xdmf_mesh::add_topology_data(MPI_Comm comm, pugi::xml_node& xml_node,
   const bool use_mpi_io = (dolfinx::MPI::size(comm) > 1);
   xdmf_utils::add_data_item(topology_node, h5_id, h5_path,
                             std::span<const std::int64_t>(topology_data),
-                            offset, shape, number_type, use_mpi_io);
+                            offset, shape, number_type, use_mpi_io, options);
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point U>
 void xdmf_mesh::add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node,
                                   hid_t h5_id, std::string path_prefix,
-                                  const mesh::Geometry<U>& geometry)
+                                  const mesh::Geometry<U>& geometry,
+                                  const hdf5::DatasetOptions& options)
 {
   spdlog::info("Adding geometry data to node \"{}\"", xml_node.path('/'));
   auto map = geometry.index_map();
@@ -205,12 +207,13 @@ void xdmf_mesh::add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node,
   const bool use_mpi_io = (dolfinx::MPI::size(comm) > 1);
   xdmf_utils::add_data_item(geometry_node, h5_id, h5_path,
                             std::span<const U>(x), offset, shape, "",
-                            use_mpi_io);
+                            use_mpi_io, options);
 }
 //----------------------------------------------------------------------------
 template <std::floating_point U>
 void xdmf_mesh::add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
-                         const mesh::Mesh<U>& mesh, const std::string& name)
+                         const mesh::Mesh<U>& mesh, const std::string& name,
+                         const hdf5::DatasetOptions& options)
 {
   spdlog::info("Adding mesh to node \"{}\"", xml_node.path('/'));
 
@@ -234,17 +237,19 @@ void xdmf_mesh::add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
 
   add_topology_data(comm, grid_node, h5_id, path_prefix, *mesh.topology(),
                     mesh.geometry(), tdim,
-                    std::span<std::int32_t>(cells.data(), num_cells));
+                    std::span<std::int32_t>(cells.data(), num_cells), options);
 
   // Add geometry node and attributes (including writing data)
-  add_geometry_data(comm, grid_node, h5_id, path_prefix, mesh.geometry());
+  add_geometry_data(comm, grid_node, h5_id, path_prefix, mesh.geometry(),
+                    options);
 }
 /// @cond
 template void xdmf_mesh::add_mesh(MPI_Comm, pugi::xml_node&, hid_t,
-                                  const mesh::Mesh<float>&, const std::string&);
+                                  const mesh::Mesh<float>&, const std::string&,
+                                  const hdf5::DatasetOptions&);
 template void xdmf_mesh::add_mesh(MPI_Comm, pugi::xml_node&, hid_t,
-                                  const mesh::Mesh<double>&,
-                                  const std::string&);
+                                  const mesh::Mesh<double>&, const std::string&,
+                                  const hdf5::DatasetOptions&);
 /// @endcond
 //----------------------------------------------------------------------------
 std::pair<std::variant<std::vector<float>, std::vector<double>>,
@@ -316,8 +321,8 @@ xdmf_mesh::read_topology_data(MPI_Comm comm, hid_t h5_id,
 
   //  Permute cells from VTK to DOLFINx ordering
   std::array<std::size_t, 2> shape = {num_local_cells, npoint_per_cell};
-  std::vector<std::int64_t> cells = io::cells::apply_permutation(
+  io::cells::apply_permutation_inplace(
       topology_data, shape, io::cells::perm_vtk(cell_type, shape[1]));
-  return {std::move(cells), shape};
+  return {std::move(topology_data), shape};
 }
 //----------------------------------------------------------------------------
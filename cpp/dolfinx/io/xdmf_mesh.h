@@ -7,10 +7,14 @@
 #pragma once
 
 #include "xdmf_utils.h"
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstdint>
+#include <dolfinx/common/IndexMap.h>
 #include <dolfinx/mesh/MeshTags.h>
 #include <hdf5.h>
+#include <memory>
 #include <mpi.h>
 #include <pugixml.hpp>
 #include <span>
@@ -43,10 +47,12 @@ namespace io::xdmf_mesh
 /// Add Mesh to xml node
 ///
 /// Creates new Grid with Topology and Geometry xml nodes for mesh. In
-/// HDF file data is stored under path prefix.
+/// HDF file data is stored under path prefix. The HDF5 datasets are
+/// stored with `options`.
 template <std::floating_point U>
 void add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
-              const mesh::Mesh<U>& mesh, const std::string& path_prefix);
+              const mesh::Mesh<U>& mesh, const std::string& path_prefix,
+              const hdf5::DatasetOptions& options = {});
 
 /// Add Topology xml node
 /// @param[in] comm
@@ -58,17 +64,20 @@ void add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
 /// @param[in] cell_dim Dimension of mesh entities to save
 /// @param[in] entities Local-to-process indices of mesh entities
 /// whose topology will be saved. This is used to save subsets of Mesh.
+/// @param[in] options Storage options for the HDF5 dataset.
 template <std::floating_point U>
 void add_topology_data(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
                        std::string path_prefix, const mesh::Topology& topology,
                        const mesh::Geometry<U>& geometry, int cell_dim,
-                       std::span<const std::int32_t> entities);
+                       std::span<const std::int32_t> entities,
+                       const hdf5::DatasetOptions& options = {});
 
 /// Add Geometry xml node
 template <std::floating_point U>
 void add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
                        std::string path_prefix,
-                       const mesh::Geometry<U>& geometry);
+                       const mesh::Geometry<U>& geometry,
+                       const hdf5::DatasetOptions& options = {});
 
 /// @brief Read geometry (coordinate) data.
 ///
@@ -93,7 +102,8 @@ read_topology_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node);
 template <typename T, std::floating_point U>
 void add_meshtags(MPI_Comm comm, const mesh::MeshTags<T>& meshtags,
                   const mesh::Geometry<U>& geometry, pugi::xml_node& xml_node,
-                  hid_t h5_id, const std::string& name)
+                  hid_t h5_id, const std::string& name,
+                  const hdf5::DatasetOptions& options = {})
 {
   spdlog::info("XDMF: add meshtags ({})", name.c_str());
   // Get mesh
@@ -115,7 +125,8 @@ void add_meshtags(MPI_Comm comm, const mesh::MeshTags<T>& meshtags,
   xdmf_mesh::add_topology_data(
       comm, xml_node, h5_id, path_prefix, *meshtags.topology(), geometry, dim,
       std::span<const std::int32_t>(meshtags.indices().data(),
-                                    num_active_entities));
+                                    num_active_entities),
+      options);
 
   // Add attribute node with values
   pugi::xml_node attribute_node = xml_node.append_child("Attribute");
@@ -135,7 +146,63 @@ void add_meshtags(MPI_Comm comm, const mesh::MeshTags<T>& meshtags,
   xdmf_utils::add_data_item(
       attribute_node, h5_id, path_prefix + std::string("/Values"),
       std::span<const T>(meshtags.values().data(), num_active_entities), offset,
-      {global_num_values, 1}, "", use_mpi_io);
+      {global_num_values, 1}, "", use_mpi_io, options);
+
+  // Add global index of a cell containing each entity and the local
+  // index of the entity in the cell. When the mesh is read from the
+  // same file, this allows the tags to be sent straight to the process
+  // that owns the cell.
+  const mesh::Topology& topology = *meshtags.topology();
+  const int tdim = topology.dim();
+  std::shared_ptr<const common::IndexMap> cell_map = topology.index_map(tdim);
+  assert(cell_map);
+  std::vector<std::int32_t> cells(num_active_entities);
+  std::vector<std::int32_t> local_entities(num_active_entities, 0);
+  if (dim == tdim)
+  {
+    std::copy_n(meshtags.indices().begin(), num_active_entities,
+                cells.begin());
+  }
+  else
+  {
+    auto e_to_c = topology.connectivity(dim, tdim);
+    if (!e_to_c)
+      throw std::runtime_error("Mesh is missing entity-cell connectivity.");
+    auto c_to_e = topology.connectivity(tdim, dim);
+    if (!c_to_e)
+      throw std::runtime_error("Mesh is missing cell-entity connectivity.");
+    for (int i = 0; i < num_active_entities; ++i)
+    {
+      std::int32_t e = meshtags.indices()[i];
+      cells[i] = e_to_c->links(e).front();
+      auto cell_entities = c_to_e->links(cells[i]);
+      auto it = std::ranges::find(cell_entities, e);
+      assert(it != cell_entities.end());
+      local_entities[i] = std::distance(cell_entities.begin(), it);
+    }
+  }
+  std::vector<std::int64_t> cells_global(cells.size());
+  cell_map->local_to_global(cells, cells_global);
+
+  pugi::xml_node cell_node = xml_node.append_child("Attribute");
+  assert(cell_node);
+  cell_node.append_attribute("Name") = (name + "_cell").c_str();
+  cell_node.append_attribute("AttributeType") = "Scalar";
+  cell_node.append_attribute("Center") = "Cell";
+  xdmf_utils::add_data_item(
+      cell_node, h5_id, path_prefix + std::string("/Cells"),
+      std::span<const std::int64_t>(cells_global), offset,
+      {global_num_values, 1}, "Int", use_mpi_io, options);
+
+  pugi::xml_node entity_node = xml_node.append_child("Attribute");
+  assert(entity_node);
+  entity_node.append_attribute("Name") = (name + "_local_entity").c_str();
+  entity_node.append_attribute("AttributeType") = "Scalar";
+  entity_node.append_attribute("Center") = "Cell";
+  xdmf_utils::add_data_item(
+      entity_node, h5_id, path_prefix + std::string("/LocalEntities"),
+      std::span<const std::int32_t>(local_entities), offset,
+      {global_num_values, 1}, "Int", use_mpi_io, options);
 }
 } // namespace io::xdmf_mesh
 } // namespace dolfinx
@@ -68,11 +68,13 @@ std::int64_t get_num_cells(const pugi::xml_node& topology_node);
 std::string vtk_cell_type_str(mesh::CellType cell_type, int num_nodes);
 
 /// TODO: Document
+/// @param[in] options Storage options for the HDF5 dataset.
 template <typename T>
 void add_data_item(pugi::xml_node& xml_node, hid_t h5_id,
                    const std::string& h5_path, std::span<const T> x,
                    std::int64_t offset, const std::vector<std::int64_t>& shape,
-                   const std::string& number_type, bool use_mpi_io)
+                   const std::string& number_type, bool use_mpi_io,
+                   const hdf5::DatasetOptions& options = {})
 {
   // Add DataItem node
   assert(xml_node);
@@ -127,7 +129,7 @@ void add_data_item(pugi::xml_node& xml_node, hid_t h5_id,
 
     const std::array local_range{offset, offset + local_shape0};
     io::hdf5::write_dataset(h5_id, h5_path, x.data(), local_range, shape,
-                            use_mpi_io, false);
+                            use_mpi_io, options);
 
     // Add partitioning attribute to dataset
     // std::vector<std::size_t> partitions;
@@ -0,0 +1,73 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "Agglomeration.h"
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using namespace dolfinx;
+using namespace dolfinx::la;
+
+//-----------------------------------------------------------------------------
+Agglomeration::Agglomeration(const common::IndexMap& map, int bs,
+                             int num_targets)
+    : _group_comm(MPI_COMM_NULL), _target_comm(MPI_COMM_NULL)
+{
+  MPI_Comm comm = map.comm();
+  const int size = dolfinx::MPI::size(comm);
+  const int rank = dolfinx::MPI::rank(comm);
+  if (num_targets < 1 or num_targets > size)
+  {
+    throw std::runtime_error("Number of agglomeration targets must be between "
+                             "one and the number of processes.");
+  }
+
+  // Split ranks into groups of consecutive ranks. Every group is
+  // non-empty since num_targets <= size.
+  const int group = (static_cast<std::int64_t>(rank) * num_targets) / size;
+  MPI_Comm c;
+  int err = MPI_Comm_split(comm, group, rank, &c);
+  dolfinx::MPI::check_error(comm, err);
+  _group_comm = dolfinx::MPI::Comm(c, false);
+
+  // The first rank of each group is the target
+  const int group_rank = dolfinx::MPI::rank(_group_comm.comm());
+  err = MPI_Comm_split(comm, group_rank == 0 ? 0 : MPI_UNDEFINED, rank, &c);
+  dolfinx::MPI::check_error(comm, err);
+  _target_comm = dolfinx::MPI::Comm(c, false);
+
+  // Gather number of entries of each rank of the group on the target
+  const std::int64_t num_entries = static_cast<std::int64_t>(bs)
+                                   * map.size_local();
+  if (num_entries > std::numeric_limits<int>::max())
+    throw std::runtime_error("Too many entries to agglomerate.");
+  const int count = num_entries;
+  if (group_rank == 0)
+    _counts.resize(dolfinx::MPI::size(_group_comm.comm()));
+  err = MPI_Gather(&count, 1, MPI_INT, _counts.data(), 1, MPI_INT, 0,
+                   _group_comm.comm());
+  dolfinx::MPI::check_error(_group_comm.comm(), err);
+
+  if (group_rank == 0)
+  {
+    _displs.resize(_counts.size());
+    std::exclusive_scan(_counts.begin(), _counts.end(), _displs.begin(),
+                        std::int64_t(0));
+    const std::int64_t total = std::reduce(
+        _counts.begin(), _counts.end(), std::int64_t(0));
+    if (total > std::numeric_limits<int>::max())
+      throw std::runtime_error("Too many entries to agglomerate.");
+
+    // Ownership ranges increase with rank, so the entries of the group
+    // start at the first entry of the target
+    _range[0] = bs * map.local_range()[0];
+    _range[1] = _range[0] + total;
+  }
+}
+//-----------------------------------------------------------------------------
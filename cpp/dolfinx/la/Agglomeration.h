@@ -0,0 +1,279 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Communication plan for gathering (agglomerating) the owned
+/// entries of distributed data onto a subset of ranks, and for
+/// scattering agglomerated data back to the owners.
+///
+/// The ranks of the communicator of an IndexMap are split into
+/// `num_targets` groups of consecutive ranks. The owned entries of all
+/// ranks of a group are gathered on the first rank of the group (the
+/// target rank). Since ownership ranges of an IndexMap increase with
+/// rank, each target holds a contiguous range of the global indices
+/// (see range()). The target ranks form a subcommunicator (see comm()),
+/// e.g. for a coarse-level solve in a multigrid hierarchy or for a
+/// sparse-direct solver.
+///
+/// The plan is computed once and can be re-used for any data with the
+/// same IndexMap and block size, e.g. the owned entries of all vectors
+/// of a function space.
+class Agglomeration
+{
+public:
+  /// @brief Create a plan for agglomerating data with a given IndexMap.
+  /// @note Collective over the communicator of `map`.
+  /// @param[in] map IndexMap of the data.
+  /// @param[in] bs Block size of the data.
+  /// @param[in] num_targets Number of ranks to agglomerate onto. Must
+  /// be between one and the size of the communicator of `map`.
+  Agglomeration(const common::IndexMap& map, int bs, int num_targets);
+
+  /// @brief Communicator of the target ranks.
+  /// @return Communicator of the target ranks on target ranks,
+  /// `MPI_COMM_NULL` on other ranks.
+  MPI_Comm comm() const { return _target_comm.comm(); }
+
+  /// @brief Communicator of the group of ranks whose data is gathered
+  /// on the same target rank. The target is rank 0.
+  MPI_Comm group_comm() const { return _group_comm.comm(); }
+
+  /// @brief Check if the calling rank is a target rank.
+  bool is_target() const { return _target_comm.comm() != MPI_COMM_NULL; }
+
+  /// @brief Range of (unblocked) global indices that are gathered on
+  /// the calling rank.
+  /// @return Range `[i0, i1)`. Empty on ranks that are not targets.
+  std::array<std::int64_t, 2> range() const { return _range; }
+
+  /// @brief Number of (unblocked) entries that are gathered on the
+  /// calling rank. Zero on ranks that are not targets.
+  std::int32_t size() const { return _range[1] - _range[0]; }
+
+  /// @brief Gather owned entries onto the target ranks.
+  /// @note Collective over the communicator of the IndexMap.
+  /// @param[in] x Owned entries on the calling rank, size
+  /// `bs * map.size_local()`.
+  /// @param[out] y Gathered entries, size size(), ordered by global
+  /// index.
+  template <typename T>
+  void gather(std::span<const T> x, std::span<T> y) const
+  {
+    int err = MPI_Gatherv(x.data(), x.size(), dolfinx::MPI::mpi_t<T>,
+                          y.data(), _counts.data(), _displs.data(),
+                          dolfinx::MPI::mpi_t<T>, 0, _group_comm.comm());
+    dolfinx::MPI::check_error(_group_comm.comm(), err);
+  }
+
+  /// @brief Scatter agglomerated entries from the target ranks back to
+  /// their owners.
+  /// @note Collective over the communicator of the IndexMap.
+  /// @param[in] y Agglomerated entries on the calling rank, size
+  /// size().
+  /// @param[out] x Owned entries on the calling rank, size
+  /// `bs * map.size_local()`.
+  template <typename T>
+  void scatter(std::span<const T> y, std::span<T> x) const
+  {
+    int err = MPI_Scatterv(y.data(), _counts.data(), _displs.data(),
+                           dolfinx::MPI::mpi_t<T>, x.data(), x.size(),
+                           dolfinx::MPI::mpi_t<T>, 0, _group_comm.comm());
+    dolfinx::MPI::check_error(_group_comm.comm(), err);
+  }
+
+private:
+  // Communicator of the ranks of this group, and of the target ranks
+  dolfinx::MPI::Comm _group_comm, _target_comm;
+
+  // Number of entries and displacements of each rank of the group
+  // (target rank only)
+  std::vector<int> _counts, _displs;
+
+  // Global range of the entries on this rank (target rank only)
+  std::array<std::int64_t, 2> _range = {0, 0};
+};
+
+/// @brief Agglomeration of the owned rows of a distributed matrix in
+/// compressed sparse row format onto a subset of ranks.
+///
+/// The rows are agglomerated onto target ranks as for an Agglomeration
+/// of the row IndexMap (see rows()). On a target rank, the
+/// agglomerated rows are stored in compressed sparse row format with
+/// global (unblocked) column indices that are sorted within each row,
+/// which is the input expected by most sparse direct solvers. Blocked
+/// matrices are expanded.
+///
+/// The sparsity structure is communicated once when the plan is
+/// created; gather() only communicates the matrix values. This makes
+/// re-agglomeration after re-assembly with the same sparsity pattern
+/// cheap.
+///
+/// @tparam Matrix Matrix type, e.g. la::MatrixCSR.
+template <class Matrix>
+class MatrixAgglomeration
+{
+public:
+  /// Scalar type
+  using value_type = typename Matrix::value_type;
+
+  /// @brief Create an agglomeration plan for a matrix, and gather its
+  /// values.
+  /// @note Collective over the communicator of the matrix.
+  /// @param[in] A Matrix. Ghost row contributions must already have
+  /// been accumulated on the owning ranks, e.g. with
+  /// MatrixCSR::scatter_rev().
+  /// @param[in] num_targets Number of ranks to agglomerate onto.
+  MatrixAgglomeration(const Matrix& A, int num_targets)
+      : _rows(*A.index_map(0), A.block_size()[0], num_targets)
+  {
+    const auto [bs0, bs1] = A.block_size();
+    const std::int32_t num_rows = A.num_owned_rows();
+    const auto& row_ptr = A.row_ptr();
+    const auto& cols = A.cols();
+
+    // Global column index of each block of the owned rows
+    std::vector<std::int32_t> lcols(cols.begin(),
+                                    std::next(cols.begin(), row_ptr[num_rows]));
+    std::vector<std::int64_t> gcols(lcols.size());
+    A.index_map(1)->local_to_global(lcols, gcols);
+
+    // Expand the blocks and sort the columns of each row. Record the
+    // position in the matrix data of each (expanded) entry.
+    std::vector<std::int32_t> row_sizes(num_rows * bs0);
+    std::vector<std::int64_t> local_cols;
+    local_cols.reserve(row_ptr[num_rows] * bs0 * bs1);
+    _perm.reserve(row_ptr[num_rows] * bs0 * bs1);
+    std::vector<std::int64_t> order;
+    for (std::int32_t r = 0; r < num_rows; ++r)
+    {
+      order.resize(row_ptr[r + 1] - row_ptr[r]);
+      std::iota(order.begin(), order.end(), row_ptr[r]);
+      std::ranges::sort(order, [&gcols](auto a, auto b)
+                        { return gcols[a] < gcols[b]; });
+      for (int i0 = 0; i0 < bs0; ++i0)
+      {
+        for (std::int64_t j : order)
+        {
+          for (int i1 = 0; i1 < bs1; ++i1)
+          {
+            local_cols.push_back(gcols[j] * bs1 + i1);
+            _perm.push_back((j * bs0 + i0) * bs1 + i1);
+          }
+        }
+        row_sizes[r * bs0 + i0] = order.size() * bs1;
+      }
+    }
+
+    // Gather row sizes and compute row pointers on the target
+    std::vector<std::int32_t> sizes(_rows.size());
+    _rows.gather(std::span<const std::int32_t>(row_sizes),
+                 std::span(sizes));
+    if (_rows.is_target())
+    {
+      _row_ptr.resize(sizes.size() + 1, 0);
+      std::partial_sum(sizes.begin(), sizes.end(), std::next(_row_ptr.begin()));
+    }
+
+    // Number of entries of each rank of the group
+    MPI_Comm comm = _rows.group_comm();
+    const int num_entries = local_cols.size();
+    if (_rows.is_target())
+      _counts.resize(dolfinx::MPI::size(comm));
+    int err = MPI_Gather(&num_entries, 1, MPI_INT, _counts.data(), 1, MPI_INT,
+                         0, comm);
+    dolfinx::MPI::check_error(comm, err);
+    if (_rows.is_target())
+    {
+      _displs.resize(_counts.size() + 1, 0);
+      std::partial_sum(_counts.begin(), _counts.end(),
+                       std::next(_displs.begin()));
+      if (_row_ptr.back() != _displs.back())
+        throw std::runtime_error("Inconsistent agglomerated matrix size.");
+    }
+
+    // Gather column indices
+    _cols.resize(_rows.is_target() ? _displs.back() : 0);
+    err = MPI_Gatherv(local_cols.data(), local_cols.size(), MPI_INT64_T,
+                      _cols.data(), _counts.data(), _displs.data(),
+                      MPI_INT64_T, 0, comm);
+    dolfinx::MPI::check_error(comm, err);
+
+    _values.resize(_cols.size());
+    gather(A);
+  }
+
+  /// @brief Gather the values of a matrix onto the target ranks.
+  ///
+  /// The matrix must have the same sparsity pattern as the matrix that
+  /// the plan was created with, e.g. the same matrix after
+  /// re-assembly.
+  /// @note Collective over the communicator of the matrix.
+  /// @param[in] A Matrix.
+  void gather(const Matrix& A)
+  {
+    const auto& data = A.values();
+    std::vector<value_type> buffer(_perm.size());
+    for (std::size_t i = 0; i < _perm.size(); ++i)
+      buffer[i] = data[_perm[i]];
+
+    MPI_Comm comm = _rows.group_comm();
+    int err = MPI_Gatherv(buffer.data(), buffer.size(),
+                          dolfinx::MPI::mpi_t<value_type>, _values.data(),
+                          _counts.data(), _displs.data(),
+                          dolfinx::MPI::mpi_t<value_type>, 0, comm);
+    dolfinx::MPI::check_error(comm, err);
+  }
+
+  /// @brief Agglomeration of the matrix rows.
+  ///
+  /// The agglomeration can be used to gather right-hand side vectors
+  /// onto, and to scatter solution vectors from, the target ranks.
+  const Agglomeration& rows() const { return _rows; }
+
+  /// @brief Row pointers of the agglomerated rows. Empty on ranks that
+  /// are not targets.
+  const std::vector<std::int64_t>& row_ptr() const { return _row_ptr; }
+
+  /// @brief Global column indices of the agglomerated rows. Empty on
+  /// ranks that are not targets.
+  const std::vector<std::int64_t>& cols() const { return _cols; }
+
+  /// @brief Values of the agglomerated rows. Empty on ranks that are
+  /// not targets.
+  const std::vector<value_type>& values() const { return _values; }
+
+private:
+  // Agglomeration of the rows
+  Agglomeration _rows;
+
+  // Position in the matrix data of each gathered entry of the calling
+  // rank
+  std::vector<std::int64_t> _perm;
+
+  // Number of entries and displacements of each rank of the group
+  // (target only)
+  std::vector<int> _counts, _displs;
+
+  // Agglomerated matrix (target only)
+  std::vector<std::int64_t> _row_ptr, _cols;
+  std::vector<value_type> _values;
+};
+
+} // namespace dolfinx::la
@@ -0,0 +1,281 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Vector.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/threads.h>
+#include <dolfinx/common/types.h>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Matrix with dense square blocks on the diagonal, e.g. one
+/// element matrix per cell.
+///
+/// Block `b` couples the degrees-of-freedom `dofs(b)`. The blocks are
+/// stored contiguously and row-major, so that the blocks can be
+/// factorised and applied in a single pass over the data. If no two
+/// blocks share a degree-of-freedom, as for discontinuous
+/// finite element spaces, the matrix is block-diagonal and solve()
+/// applies its inverse. Typical uses are the inversion of DG mass
+/// matrices and the elimination of cell-interior unknowns in static
+/// condensation.
+///
+/// Blocks are assembled with fem::assemble_block_diagonal().
+///
+/// @tparam T Scalar type of matrix entries.
+template <dolfinx::scalar T>
+class BlockDiagonalMatrix
+{
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// @brief Create a matrix with zero blocks.
+  /// @param[in] dofs Degree-of-freedom indices of the blocks, with the
+  /// (unrolled) indices of block `b` starting at `b * block_size`.
+  /// @param[in] block_size Number of rows in each block.
+  BlockDiagonalMatrix(std::vector<std::int32_t> dofs, int block_size)
+      : _dofs(std::move(dofs)), _block_size(block_size)
+  {
+    if (_block_size < 1 or _dofs.size() % _block_size != 0)
+      throw std::runtime_error("Invalid block size.");
+    _values.resize(_dofs.size() * _block_size, 0);
+  }
+
+  /// Number of blocks.
+  std::int32_t num_blocks() const { return _dofs.size() / _block_size; }
+
+  /// Number of rows (and columns) in each block.
+  int block_size() const { return _block_size; }
+
+  /// @brief Degree-of-freedom indices of a block.
+  /// @param[in] b Block index.
+  /// @return Indices of the rows (and columns) of block `b`.
+  std::span<const std::int32_t> dofs(std::int32_t b) const
+  {
+    return std::span(_dofs).subspan(b * _block_size, _block_size);
+  }
+
+  /// @brief Entries of a block, row-major.
+  ///
+  /// After factorize() the entries are the LU factors of the block.
+  /// @param[in] b Block index.
+  std::span<T> block(std::int32_t b)
+  {
+    const std::size_t n2 = _block_size * _block_size;
+    return std::span(_values).subspan(b * n2, n2);
+  }
+
+  /// @brief Entries of a block, row-major.
+  /// @param[in] b Block index.
+  std::span<const T> block(std::int32_t b) const
+  {
+    const std::size_t n2 = _block_size * _block_size;
+    return std::span(_values).subspan(b * n2, n2);
+  }
+
+  /// @brief Entries of all blocks.
+  std::span<T> values() { return _values; }
+
+  /// @brief Entries of all blocks.
+  std::span<const T> values() const { return _values; }
+
+  /// @brief Set all entries to a value.
+  ///
+  /// The factorisation, if computed, is discarded.
+  /// @param[in] x Value to set.
+  void set(T x)
+  {
+    std::ranges::fill(_values, x);
+    _pivots.clear();
+    _factorized = false;
+  }
+
+  /// @brief Whether the blocks have been factorised.
+  bool factorized() const { return _factorized; }
+
+  /// @brief Compute the matrix-vector product `y += Ax`.
+  ///
+  /// The entries of `x` and `y` are indexed by the block
+  /// degrees-of-freedom, including ghost entries. No communication is
+  /// performed.
+  ///
+  /// @pre The blocks have not been factorised.
+  ///
+  /// @param[in] x Vector to apply `A` to.
+  /// @param[in,out] y Vector to accumulate the result into.
+  /// @param[in] num_threads Number of threads to use. Blocks that share
+  /// a degree-of-freedom must not be applied concurrently, so threads
+  /// should only be used if no two blocks share a degree-of-freedom.
+  void mult(const Vector<T>& x, Vector<T>& y, int num_threads = 1) const
+  {
+    if (factorized())
+      throw std::runtime_error("Cannot apply a factorised matrix.");
+
+    std::span<const T> _x = x.array();
+    std::span<T> _y = y.mutable_array();
+    const std::size_t n = _block_size;
+    common::parallel_for(
+        num_blocks(), num_threads,
+        [&](std::size_t b0, std::size_t b1)
+        {
+          for (std::size_t b = b0; b < b1; ++b)
+          {
+            std::span<const std::int32_t> dofs = this->dofs(b);
+            std::span<const T> A = block(b);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+              T yi = 0;
+              for (std::size_t j = 0; j < n; ++j)
+                yi += A[i * n + j] * _x[dofs[j]];
+              _y[dofs[i]] += yi;
+            }
+          }
+        });
+  }
+
+  /// @brief Compute the LU factorisation, with partial pivoting, of
+  /// each block in-place.
+  ///
+  /// @param[in] num_threads Number of threads to use.
+  /// @throws std::runtime_error if a block is singular.
+  void factorize(int num_threads = 1)
+  {
+    if (factorized())
+      return;
+
+    const std::size_t n = _block_size;
+    std::vector<std::int32_t> pivots(_dofs.size());
+    common::parallel_for(
+        num_blocks(), num_threads,
+        [&](std::size_t b0, std::size_t b1)
+        {
+          for (std::size_t b = b0; b < b1; ++b)
+          {
+            std::span<T> A = block(b);
+            std::span<std::int32_t> p
+                = std::span(pivots).subspan(b * n, n);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+              // Row with the largest entry in column k
+              std::size_t r = k;
+              for (std::size_t i = k + 1; i < n; ++i)
+              {
+                if (std::abs(A[i * n + k]) > std::abs(A[r * n + k]))
+                  r = i;
+              }
+              if (A[r * n + k] == T(0))
+                throw std::runtime_error("Singular matrix block.");
+              p[k] = r;
+              if (r != k)
+              {
+                std::swap_ranges(A.begin() + k * n, A.begin() + (k + 1) * n,
+                                 A.begin() + r * n);
+              }
+
+              // Eliminate below the pivot
+              for (std::size_t i = k + 1; i < n; ++i)
+              {
+                const T l = A[i * n + k] / A[k * n + k];
+                A[i * n + k] = l;
+                for (std::size_t j = k + 1; j < n; ++j)
+                  A[i * n + j] -= l * A[k * n + j];
+              }
+            }
+          }
+        });
+
+    _pivots = std::move(pivots);
+    _factorized = true;
+  }
+
+  /// @brief Solve `A_b x_b = b_b` for each block `b`, where `x_b` and
+  /// `b_b` are the entries of `x` and `b` at the block
+  /// degrees-of-freedom.
+  ///
+  /// If no two blocks share a degree-of-freedom, `x` is set to
+  /// `A^{-1} b` for the block degrees-of-freedom. Other entries of `x`
+  /// are not changed and no communication is performed.
+  ///
+  /// @pre The blocks have been factorised (see factorize()).
+  ///
+  /// @param[in] b Right-hand side.
+  /// @param[in,out] x Solution. It may be the same vector as `b`.
+  /// @param[in] num_threads Number of threads to use.
+  void solve(const Vector<T>& b, Vector<T>& x, int num_threads = 1) const
+  {
+    if (!factorized())
+      throw std::runtime_error("Matrix blocks have not been factorised.");
+
+    std::span<const T> _b = b.array();
+    std::span<T> _x = x.mutable_array();
+    const std::size_t n = _block_size;
+    common::parallel_for(
+        num_blocks(), num_threads,
+        [&](std::size_t b0, std::size_t b1)
+        {
+          std::vector<T> w(n);
+          for (std::size_t k = b0; k < b1; ++k)
+          {
+            std::span<const std::int32_t> dofs = this->dofs(k);
+            std::span<const T> A = block(k);
+            std::span<const std::int32_t> p
+                = std::span(_pivots).subspan(k * n, n);
+
+            // Apply row permutation
+            for (std::size_t i = 0; i < n; ++i)
+              w[i] = _b[dofs[i]];
+            for (std::size_t i = 0; i < n; ++i)
+              std::swap(w[i], w[p[i]]);
+
+            // Forward substitution with L (unit diagonal)
+            for (std::size_t i = 1; i < n; ++i)
+            {
+              for (std::size_t j = 0; j < i; ++j)
+                w[i] -= A[i * n + j] * w[j];
+            }
+
+            // Backward substitution with U
+            for (std::size_t i = n; i-- > 0;)
+            {
+              for (std::size_t j = i + 1; j < n; ++j)
+                w[i] -= A[i * n + j] * w[j];
+              w[i] /= A[i * n + i];
+            }
+
+            for (std::size_t i = 0; i < n; ++i)
+              _x[dofs[i]] = w[i];
+          }
+        });
+  }
+
+private:
+  // Block degree-of-freedom indices
+  std::vector<std::int32_t> _dofs;
+
+  // Number of rows in a block
+  int _block_size;
+
+  // Block entries (row-major, contiguous)
+  std::vector<T> _values;
+
+  // Row pivots of the LU factorisations
+  std::vector<std::int32_t> _pivots;
+
+  // True if the blocks hold their LU factors
+  bool _factorized = false;
+};
+} // namespace dolfinx::la
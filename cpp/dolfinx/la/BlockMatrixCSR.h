@@ -0,0 +1,512 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "BlockVector.h"
+#include "MatrixCSR.h"
+#include "SparsityPattern.h"
+#include "matrix_csr_impl.h"
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Distributed sparse matrix made up of a rectangular grid of
+/// MatrixCSR blocks, e.g. for mixed problems.
+///
+/// Each block \f$A_{ij}\f$ is a MatrixCSR and is assembled into
+/// directly, e.g. using `block(i, j).mat_add_values()`. Blocks with no
+/// sparsity pattern are zero and are not stored. All blocks in block
+/// row \f$i\f$ should share the same row IndexMap, and all blocks in
+/// block column \f$j\f$ the same column IndexMap.
+///
+/// The ghost rows of all blocks are sent to the owning ranks with a
+/// single, fused neighbourhood communication (see scatter_rev), rather
+/// than one communication per block.
+///
+/// @tparam T Scalar type
+template <typename T>
+class BlockMatrixCSR
+{
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// Type of the matrix blocks
+  using matrix_type = MatrixCSR<T>;
+
+  /// @brief Create a distributed block matrix.
+  /// @param[in] patterns Rectangular array of finalized sparsity
+  /// patterns, one for each block. A `nullptr` entry is a zero block.
+  /// @param[in] mode Block mode of the MatrixCSR blocks.
+  explicit BlockMatrixCSR(
+      const std::vector<std::vector<const SparsityPattern*>>& patterns,
+      BlockMode mode = BlockMode::compact)
+      : _shape({patterns.size(), patterns.empty() ? 0 : patterns[0].size()})
+  {
+    for (auto& row : patterns)
+    {
+      if (row.size() != _shape[1])
+        throw std::runtime_error("Block sparsity patterns must be a "
+                                 "rectangular array.");
+      for (const SparsityPattern* p : row)
+      {
+        _blocks.push_back(p ? std::make_unique<matrix_type>(*p, mode)
+                            : nullptr);
+      }
+    }
+
+    auto it0 = std::ranges::find_if(_blocks,
+                                    [](auto& A) { return A != nullptr; });
+    if (it0 == _blocks.end())
+      throw std::runtime_error("Block matrix has no non-zero blocks.");
+    MPI_Comm comm = (*it0)->index_map(0)->comm();
+
+    // Union of the neighbourhoods of the row maps of all blocks. Ghost
+    // rows are sent to the src ranks (owners) of each row map.
+    std::vector<int> src, dest;
+    for (auto& A : _blocks)
+    {
+      if (A)
+      {
+        std::span s = A->index_map(0)->src();
+        std::span d = A->index_map(0)->dest();
+        src.insert(src.end(), s.begin(), s.end());
+        dest.insert(dest.end(), d.begin(), d.end());
+      }
+    }
+    std::ranges::sort(src);
+    src.erase(std::unique(src.begin(), src.end()), src.end());
+    std::ranges::sort(dest);
+    dest.erase(std::unique(dest.begin(), dest.end()), dest.end());
+
+    MPI_Comm ncomm;
+    MPI_Dist_graph_create_adjacent(comm, dest.size(), dest.data(),
+                                   MPI_UNWEIGHTED, src.size(), src.data(),
+                                   MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                                   &ncomm);
+    _comm = dolfinx::MPI::Comm(ncomm, false);
+
+    // Neighbourhood rank of the owner of each ghost row of each block,
+    // and the number of (non-zero, value) entries sent to each
+    // neighbour
+    _ghost_row_to_rank.resize(_blocks.size());
+    std::vector<std::int32_t> num_nz(src.size(), 0);
+    std::vector<int> num_vals(src.size(), 0);
+    for (std::size_t b = 0; b < _blocks.size(); ++b)
+    {
+      if (!_blocks[b])
+        continue;
+      const matrix_type& A = *_blocks[b];
+      const std::int32_t num_rows = A.index_map(0)->size_local();
+      const auto bs = A.block_size();
+      auto& row_ptr = A.row_ptr();
+      for (int r : A.index_map(0)->owners())
+      {
+        auto it = std::ranges::lower_bound(src, r);
+        assert(it != src.end() and *it == r);
+        _ghost_row_to_rank[b].push_back(std::distance(src.begin(), it));
+      }
+      for (std::size_t i = 0; i < _ghost_row_to_rank[b].size(); ++i)
+      {
+        const int rank = _ghost_row_to_rank[b][i];
+        const auto nnz = row_ptr[num_rows + i + 1] - row_ptr[num_rows + i];
+        num_nz[rank] += nnz;
+        num_vals[rank] += nnz * bs[0] * bs[1];
+      }
+    }
+
+    _send_disp.assign(src.size() + 1, 0);
+    std::partial_sum(num_vals.begin(), num_vals.end(),
+                     std::next(_send_disp.begin()));
+
+    // Pack (block, global row, global column) for each non-zero in the
+    // ghost rows, in the order that values are packed in scatter_rev
+    std::vector<int> idx_disp(src.size() + 1, 0);
+    std::partial_sum(num_nz.begin(), num_nz.end(),
+                     std::next(idx_disp.begin()));
+    std::vector<std::int64_t> idx_send(3 * idx_disp.back());
+    {
+      std::vector<int> insert_pos = idx_disp;
+      for (std::size_t b = 0; b < _blocks.size(); ++b)
+      {
+        if (!_blocks[b])
+          continue;
+        const matrix_type& A = *_blocks[b];
+        const std::int32_t num_rows = A.index_map(0)->size_local();
+        const std::int32_t num_cols = A.index_map(1)->size_local();
+        const std::int64_t col_offset = A.index_map(1)->local_range()[0];
+        std::span ghosts0 = A.index_map(0)->ghosts();
+        std::span ghosts1 = A.index_map(1)->ghosts();
+        auto& row_ptr = A.row_ptr();
+        auto& cols = A.cols();
+        for (std::size_t i = 0; i < ghosts0.size(); ++i)
+        {
+          const int rank = _ghost_row_to_rank[b][i];
+          for (auto k = row_ptr[num_rows + i]; k < row_ptr[num_rows + i + 1];
+               ++k)
+          {
+            const std::int32_t c = cols[k];
+            std::int64_t* data = idx_send.data() + 3 * insert_pos[rank]++;
+            data[0] = b;
+            data[1] = ghosts0[i];
+            data[2] = c < num_cols ? c + col_offset : ghosts1[c - num_cols];
+          }
+        }
+      }
+    }
+
+    // Send indices to the owners
+    std::vector<int> send_sizes(src.size()), recv_sizes(dest.size());
+    std::ranges::transform(num_nz, send_sizes.begin(),
+                           [](auto n) { return 3 * n; });
+    send_sizes.reserve(1);
+    recv_sizes.reserve(1);
+    MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                          MPI_INT, _comm.comm());
+    std::vector<int> send_disp(src.size() + 1, 0);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     std::next(send_disp.begin()));
+    std::vector<int> recv_disp(dest.size() + 1, 0);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_disp.begin()));
+    std::vector<std::int64_t> idx_recv(recv_disp.back());
+    MPI_Neighbor_alltoallv(idx_send.data(), send_sizes.data(),
+                           send_disp.data(), MPI_INT64_T, idx_recv.data(),
+                           recv_sizes.data(), recv_disp.data(), MPI_INT64_T,
+                           _comm.comm());
+
+    // Global-to-local map for the ghost columns of each block
+    std::vector<std::vector<std::pair<std::int64_t, std::int32_t>>>
+        global_to_local(_blocks.size());
+    for (std::size_t b = 0; b < _blocks.size(); ++b)
+    {
+      if (!_blocks[b])
+        continue;
+      auto map1 = _blocks[b]->index_map(1);
+      std::span ghosts1 = map1->ghosts();
+      for (std::size_t i = 0; i < ghosts1.size(); ++i)
+        global_to_local[b].emplace_back(ghosts1[i], map1->size_local() + i);
+      std::ranges::sort(global_to_local[b]);
+    }
+
+    // Compute the (block, entry) position to accumulate each received
+    // non-zero into, and the receive displacements of the values
+    _recv_disp.assign(dest.size() + 1, 0);
+    _unpack_pos.reserve(idx_recv.size() / 3);
+    for (std::size_t r = 0; r < dest.size(); ++r)
+    {
+      _recv_disp[r + 1] = _recv_disp[r];
+      for (int i = recv_disp[r]; i < recv_disp[r + 1]; i += 3)
+      {
+        const int b = idx_recv[i];
+        const matrix_type& A = *_blocks[b];
+        const auto bs = A.block_size();
+        _recv_disp[r + 1] += bs[0] * bs[1];
+
+        // Row must be owned by this process
+        const std::int32_t row
+            = idx_recv[i + 1] - A.index_map(0)->local_range()[0];
+        assert(row >= 0 and row < A.index_map(0)->size_local());
+
+        // Column may be owned or a ghost
+        std::int32_t col = idx_recv[i + 2] - A.index_map(1)->local_range()[0];
+        if (col < 0 or col >= A.index_map(1)->size_local())
+        {
+          auto it = std::ranges::lower_bound(
+              global_to_local[b], std::pair(idx_recv[i + 2], -1),
+              [](auto& a, auto& b) { return a.first < b.first; });
+          assert(it != global_to_local[b].end()
+                 and it->first == idx_recv[i + 2]);
+          col = it->second;
+        }
+
+        auto& cols = A.cols();
+        auto cit0 = std::next(cols.begin(), A.row_ptr()[row]);
+        auto cit1 = std::next(cols.begin(), A.row_ptr()[row + 1]);
+        auto cit = std::lower_bound(cit0, cit1, col);
+        assert(cit != cit1 and *cit == col);
+        _unpack_pos.emplace_back(b, std::distance(cols.begin(), cit));
+      }
+    }
+  }
+
+  /// Copy constructor (disabled)
+  BlockMatrixCSR(const BlockMatrixCSR& A) = delete;
+
+  /// Move constructor
+  BlockMatrixCSR(BlockMatrixCSR&& A) = default;
+
+  /// Assignment operator (disabled)
+  BlockMatrixCSR& operator=(const BlockMatrixCSR& A) = delete;
+
+  /// Move assignment operator
+  BlockMatrixCSR& operator=(BlockMatrixCSR&& A) = default;
+
+  /// @brief Number of block rows and block columns.
+  std::array<std::size_t, 2> shape() const { return _shape; }
+
+  /// @brief Check if a block is non-zero, i.e. stored.
+  /// @param[in] i Block row
+  /// @param[in] j Block column
+  bool has_block(std::size_t i, std::size_t j) const
+  {
+    return _blocks.at(i * _shape[1] + j) != nullptr;
+  }
+
+  /// @brief Get a block of the matrix.
+  /// @param[in] i Block row
+  /// @param[in] j Block column
+  /// @return The block. Throws if the block is zero.
+  matrix_type& block(std::size_t i, std::size_t j)
+  {
+    if (!has_block(i, j))
+      throw std::runtime_error("Block matrix has no block (i, j).");
+    return *_blocks[i * _shape[1] + j];
+  }
+
+  /// @brief Get a block of the matrix (const version).
+  /// @param[in] i Block row
+  /// @param[in] j Block column
+  /// @return The block. Throws if the block is zero.
+  const matrix_type& block(std::size_t i, std::size_t j) const
+  {
+    if (!has_block(i, j))
+      throw std::runtime_error("Block matrix has no block (i, j).");
+    return *_blocks[i * _shape[1] + j];
+  }
+
+  /// @brief Set all entries of all blocks (including ghost rows).
+  /// @param[in] x The value to set all entries to
+  void set(value_type x)
+  {
+    for (auto& A : _blocks)
+      if (A)
+        std::ranges::fill(A->values(), x);
+  }
+
+  /// @brief Transfer the ghost row data of all blocks to the owning
+  /// ranks, accumulating received values on the owned rows, and
+  /// zeroing the ghost rows.
+  ///
+  /// This is equivalent to calling MatrixCSR::scatter_rev on each
+  /// block, but uses a single communication.
+  ///
+  /// @note Collective MPI operation
+  void scatter_rev()
+  {
+    scatter_rev_begin();
+    scatter_rev_end();
+  }
+
+  /// @brief Begin transfer of the ghost row data of all blocks to the
+  /// owning ranks.
+  /// @note Must be followed by BlockMatrixCSR::scatter_rev_end().
+  /// Between the two calls values in ghost rows must not be changed.
+  void scatter_rev_begin()
+  {
+    _send.resize(_send_disp.back());
+    std::vector<int> insert_pos = _send_disp;
+    for (std::size_t b = 0; b < _blocks.size(); ++b)
+    {
+      if (!_blocks[b])
+        continue;
+      const matrix_type& A = *_blocks[b];
+      const std::int32_t num_rows = A.index_map(0)->size_local();
+      const auto bs = A.block_size();
+      const int bs2 = bs[0] * bs[1];
+      auto& row_ptr = A.row_ptr();
+      auto& values = A.values();
+      for (std::size_t i = 0; i < _ghost_row_to_rank[b].size(); ++i)
+      {
+        const int rank = _ghost_row_to_rank[b][i];
+        auto v0 = std::next(values.begin(), row_ptr[num_rows + i] * bs2);
+        auto v1 = std::next(values.begin(), row_ptr[num_rows + i + 1] * bs2);
+        std::copy(v0, v1, std::next(_send.begin(), insert_pos[rank]));
+        insert_pos[rank] += std::distance(v0, v1);
+      }
+    }
+
+    _recv.resize(_recv_disp.back());
+    std::vector<int> send_count(_send_disp.size() - 1);
+    std::adjacent_difference(std::next(_send_disp.begin()), _send_disp.end(),
+                             send_count.begin());
+    std::vector<int> recv_count(_recv_disp.size() - 1);
+    std::adjacent_difference(std::next(_recv_disp.begin()), _recv_disp.end(),
+                             recv_count.begin());
+    send_count.reserve(1);
+    recv_count.reserve(1);
+    int status = MPI_Ineighbor_alltoallv(
+        _send.data(), send_count.data(), _send_disp.data(),
+        dolfinx::MPI::mpi_t<value_type>, _recv.data(), recv_count.data(),
+        _recv_disp.data(), dolfinx::MPI::mpi_t<value_type>, _comm.comm(),
+        &_request);
+    dolfinx::MPI::check_error(_comm.comm(), status);
+  }
+
+  /// @brief End transfer of the ghost row data of all blocks to the
+  /// owning ranks.
+  /// @note Must be preceded by BlockMatrixCSR::scatter_rev_begin().
+  void scatter_rev_end()
+  {
+    int status = MPI_Wait(&_request, MPI_STATUS_IGNORE);
+    dolfinx::MPI::check_error(_comm.comm(), status);
+
+    // Add to owned rows
+    std::size_t offset = 0;
+    for (auto [b, pos] : _unpack_pos)
+    {
+      matrix_type& A = *_blocks[b];
+      const auto bs = A.block_size();
+      const int bs2 = bs[0] * bs[1];
+      auto& values = A.values();
+      for (int k = 0; k < bs2; ++k)
+        values[pos * bs2 + k] += _recv[offset + k];
+      offset += bs2;
+    }
+
+    // Set ghost row data to zero
+    for (auto& A : _blocks)
+    {
+      if (!A)
+        continue;
+      const std::int32_t num_rows = A->index_map(0)->size_local();
+      const auto bs = A->block_size();
+      std::fill(std::next(A->values().begin(),
+                          A->row_ptr()[num_rows] * bs[0] * bs[1]),
+                A->values().end(), 0);
+    }
+  }
+
+  /// @brief Compute the product `y += Ax`.
+  ///
+  /// The ghost entries of all blocks of `x` are updated with a single
+  /// fused scatter, which is overlapped with the product of the
+  /// diagonal (owned column) parts of the blocks. Block `j` of `x` must
+  /// have the parallel layout of the columns of block column `j`, and
+  /// block `i` of `y` the layout of the rows of block row `i`.
+  ///
+  /// @param[in] x Vector to apply `A` to.
+  /// @param[in,out] y Vector to accumulate the result into.
+  template <typename S = value_type>
+  void mult(BlockVector<S>& x, BlockVector<S>& y)
+  {
+    if (x.num_blocks() != _shape[1] or y.num_blocks() != _shape[0])
+      throw std::runtime_error("Block vector sizes do not match matrix.");
+
+    x.scatter_fwd_begin();
+
+    // Compute y_i += A_ij x_j with the columns for row r in
+    // [c0[r], c1[r])
+    auto spmv = [&](bool diagonal)
+    {
+      for (std::size_t i = 0; i < _shape[0]; ++i)
+      {
+        std::span<S> _y = y.block(i).mutable_array();
+        for (std::size_t j = 0; j < _shape[1]; ++j)
+        {
+          if (!has_block(i, j))
+            continue;
+          const matrix_type& A = *_blocks[i * _shape[1] + j];
+          const std::int32_t num_rows = A.num_owned_rows();
+          const auto bs = A.block_size();
+          std::span<const std::int64_t> row_ptr(A.row_ptr().data(),
+                                                num_rows + 1);
+          std::span<const std::int64_t> off_diag(A.off_diag_offset().data(),
+                                                 num_rows);
+          std::span<const std::int64_t> c0 = row_ptr.first(num_rows);
+          std::span<const std::int64_t> c1 = row_ptr.last(num_rows);
+          if (diagonal)
+            c1 = off_diag;
+          else
+            c0 = off_diag;
+
+          std::span<const std::int32_t> cols(A.cols());
+          std::span<const value_type> values(A.values());
+          std::span<const S> _x = x.block(j).array();
+          if (bs[1] == 1)
+            impl::spmv<value_type, 1>(values, c0, c1, cols, _x, _y, bs[0], 1);
+          else
+          {
+            impl::spmv<value_type, -1>(values, c0, c1, cols, _x, _y, bs[0],
+                                       bs[1]);
+          }
+        }
+      }
+    };
+
+    spmv(true);
+    x.scatter_fwd_end();
+    spmv(false);
+  }
+
+  /// @brief Compute the Frobenius norm squared of the matrix across all
+  /// processes.
+  /// @note Collective MPI operation
+  double squared_norm() const
+  {
+    double norm_sq_local = 0;
+    for (auto& A : _blocks)
+    {
+      if (!A)
+        continue;
+      const auto bs = A->block_size();
+      auto& values = A->values();
+      norm_sq_local = std::accumulate(
+          values.begin(),
+          std::next(values.begin(),
+                    A->row_ptr()[A->num_owned_rows()] * bs[0] * bs[1]),
+          norm_sq_local,
+          [](auto norm, value_type y) { return norm + std::norm(y); });
+    }
+
+    double norm_sq;
+    MPI_Allreduce(&norm_sq_local, &norm_sq, 1, MPI_DOUBLE, MPI_SUM,
+                  _comm.comm());
+    return norm_sq;
+  }
+
+private:
+  // Number of block rows and columns
+  std::array<std::size_t, 2> _shape;
+
+  // Blocks (row-major), nullptr for zero blocks
+  std::vector<std::unique_ptr<matrix_type>> _blocks;
+
+  // Neighbourhood communicator (ghost -> owner) for the rows of all
+  // blocks
+  dolfinx::MPI::Comm _comm{MPI_COMM_NULL};
+
+  // Neighbourhood rank of the owner of each ghost row of each block
+  std::vector<std::vector<int>> _ghost_row_to_rank;
+
+  // Displacements of the values sent to and received from each
+  // neighbour
+  std::vector<int> _send_disp, _recv_disp;
+
+  // (block, position in block values) to accumulate each received
+  // non-zero into
+  std::vector<std::pair<int, std::int64_t>> _unpack_pos;
+
+  // Buffers for non-blocking communication
+  std::vector<value_type> _send, _recv;
+
+  // Request in non-blocking communication
+  MPI_Request _request = MPI_REQUEST_NULL;
+};
+} // namespace dolfinx::la
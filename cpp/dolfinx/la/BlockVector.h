@@ -0,0 +1,250 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Vector.h"
+#include <algorithm>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Scatterer.h>
+#include <functional>
+#include <memory>
+#include <mpi.h>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Distributed vector made up of blocks, e.g. one block for each
+/// field of a mixed problem.
+///
+/// Each block is a la::Vector with its own IndexMap and block size. The
+/// ghost entries of all blocks are updated with a single, fused
+/// neighbourhood communication rather than one communication per
+/// block. The fused communication pattern is built from the IndexMaps
+/// stacked with common::stack_index_maps.
+///
+/// @tparam T Scalar type
+template <typename T>
+class BlockVector
+{
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// Type of the vector blocks
+  using vector_type = Vector<T>;
+
+  /// @brief Create a distributed block vector.
+  /// @param[in] maps The IndexMap and block size of each block. The
+  /// IndexMaps must share the same communicator.
+  explicit BlockVector(
+      const std::vector<
+          std::pair<std::shared_ptr<const common::IndexMap>, int>>& maps)
+  {
+    if (maps.empty())
+      throw std::runtime_error("BlockVector requires at least one block.");
+
+    std::vector<std::pair<std::reference_wrapper<const common::IndexMap>, int>>
+        _maps;
+    for (auto& [map, bs] : maps)
+    {
+      _blocks.emplace_back(map, bs);
+      _maps.emplace_back(*map, bs);
+    }
+
+    // Stack the (unrolled) maps into a single map with block size 1
+    // that describes the fused ghost update
+    auto [rank_offset, local_offset, ghosts, owners]
+        = common::stack_index_maps(_maps);
+    std::vector<std::int64_t> ghosts_stacked;
+    std::vector<int> owners_stacked;
+    for (std::size_t b = 0; b < maps.size(); ++b)
+    {
+      ghosts_stacked.insert(ghosts_stacked.end(), ghosts[b].begin(),
+                            ghosts[b].end());
+      owners_stacked.insert(owners_stacked.end(), owners[b].begin(),
+                            owners[b].end());
+    }
+
+    MPI_Comm comm = maps.front().first->comm();
+    _map = std::make_shared<common::IndexMap>(comm, local_offset.back(),
+                                              ghosts_stacked, owners_stacked);
+    _scatterer = std::make_shared<common::Scatterer<>>(*_map, 1);
+
+    // (block, index within block) of each entry in the owned and ghost
+    // part of the stacked map
+    std::span local_inds = _scatterer->local_indices();
+    _local.reserve(local_inds.size());
+    for (std::int32_t s : local_inds)
+    {
+      auto it = std::ranges::upper_bound(local_offset, s);
+      const int b = std::distance(local_offset.begin(), it) - 1;
+      _local.emplace_back(b, s - local_offset[b]);
+    }
+
+    std::vector<std::int32_t> ghost_offset = {0};
+    for (auto& g : ghosts)
+      ghost_offset.push_back(ghost_offset.back() + g.size());
+    std::span remote_inds = _scatterer->remote_indices();
+    _remote.reserve(remote_inds.size());
+    for (std::int32_t s : remote_inds)
+    {
+      auto it = std::ranges::upper_bound(ghost_offset, s);
+      const int b = std::distance(ghost_offset.begin(), it) - 1;
+      const std::int32_t num_owned
+          = maps[b].second * maps[b].first->size_local();
+      _remote.emplace_back(b, num_owned + s - ghost_offset[b]);
+    }
+
+    _buffer_local.resize(_scatterer->local_buffer_size());
+    _buffer_remote.resize(_scatterer->remote_buffer_size());
+  }
+
+  /// Copy constructor (disabled)
+  BlockVector(const BlockVector& x) = delete;
+
+  /// Move constructor
+  BlockVector(BlockVector&& x) = default;
+
+  /// Assignment operator (disabled)
+  BlockVector& operator=(const BlockVector& x) = delete;
+
+  /// Move assignment operator
+  BlockVector& operator=(BlockVector&& x) = default;
+
+  /// @brief Number of blocks.
+  std::size_t num_blocks() const { return _blocks.size(); }
+
+  /// @brief Get a block of the vector.
+  /// @param[in] i Block index
+  vector_type& block(std::size_t i) { return _blocks.at(i); }
+
+  /// @brief Get a block of the vector (const version).
+  /// @param[in] i Block index
+  const vector_type& block(std::size_t i) const { return _blocks.at(i); }
+
+  /// @brief IndexMap of the stacked blocks, with block size 1.
+  std::shared_ptr<const common::IndexMap> index_map() const { return _map; }
+
+  /// @brief Set all entries of all blocks (including ghosts).
+  /// @param[in] v The value to set all entries to (on calling rank)
+  void set(value_type v)
+  {
+    for (auto& b : _blocks)
+      b.set(v);
+  }
+
+  /// @brief Begin scatter of owned data of all blocks to ghosts on
+  /// other ranks.
+  /// @note Collective MPI operation
+  void scatter_fwd_begin()
+  {
+    for (std::size_t i = 0; i < _local.size(); ++i)
+    {
+      auto [b, idx] = _local[i];
+      _buffer_local[i] = _blocks[b].array()[idx];
+    }
+    _scatterer->scatter_fwd_begin(std::span<const value_type>(_buffer_local),
+                                  std::span<value_type>(_buffer_remote),
+                                  std::span<MPI_Request>(_request));
+  }
+
+  /// @brief End scatter of owned data of all blocks to ghosts on other
+  /// ranks.
+  /// @note Collective MPI operation
+  void scatter_fwd_end()
+  {
+    _scatterer->scatter_fwd_end(std::span<MPI_Request>(_request));
+    std::vector<std::span<value_type>> x = arrays();
+    for (std::size_t i = 0; i < _remote.size(); ++i)
+    {
+      auto [b, idx] = _remote[i];
+      x[b][idx] = _buffer_remote[i];
+    }
+  }
+
+  /// @brief Scatter owned data of all blocks to ghost positions on
+  /// other ranks.
+  /// @note Collective MPI operation
+  void scatter_fwd()
+  {
+    this->scatter_fwd_begin();
+    this->scatter_fwd_end();
+  }
+
+  /// @brief Begin scatter of ghost data of all blocks to the owners.
+  /// @note Collective MPI operation
+  void scatter_rev_begin()
+  {
+    for (std::size_t i = 0; i < _remote.size(); ++i)
+    {
+      auto [b, idx] = _remote[i];
+      _buffer_remote[i] = _blocks[b].array()[idx];
+    }
+    _scatterer->scatter_rev_begin(std::span<const value_type>(_buffer_remote),
+                                  std::span<value_type>(_buffer_local),
+                                  std::span<MPI_Request>(_request));
+  }
+
+  /// @brief End scatter of ghost data of all blocks to the owners.
+  /// @param op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev_end(BinaryOperation op)
+  {
+    _scatterer->scatter_rev_end(std::span<MPI_Request>(_request));
+    std::vector<std::span<value_type>> x = arrays();
+    for (std::size_t i = 0; i < _local.size(); ++i)
+    {
+      auto [b, idx] = _local[i];
+      x[b][idx] = op(x[b][idx], _buffer_local[i]);
+    }
+  }
+
+  /// @brief Scatter ghost data of all blocks to the owners.
+  /// @param op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev(BinaryOperation op)
+  {
+    this->scatter_rev_begin();
+    this->scatter_rev_end(op);
+  }
+
+private:
+  // Mutable arrays of the blocks
+  std::vector<std::span<value_type>> arrays()
+  {
+    std::vector<std::span<value_type>> x;
+    for (auto& b : _blocks)
+      x.push_back(b.mutable_array());
+    return x;
+  }
+
+  // Vector blocks
+  std::vector<vector_type> _blocks;
+
+  // Stacked map and the scatterer for the fused ghost update
+  std::shared_ptr<const common::IndexMap> _map;
+  std::shared_ptr<const common::Scatterer<>> _scatterer;
+
+  // (block, index in block) for each entry of the scatterer send
+  // (_local) and receive (_remote) buffers
+  std::vector<std::pair<int, std::int32_t>> _local, _remote;
+
+  // MPI request handle
+  std::vector<MPI_Request> _request = {MPI_REQUEST_NULL};
+
+  // Buffers for ghost scatters
+  std::vector<value_type> _buffer_local, _buffer_remote;
+};
+} // namespace dolfinx::la
@@ -0,0 +1,92 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "HugePageAllocator.h"
+#include <cstdint>
+#include <dolfinx/common/threads.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+using namespace dolfinx;
+
+namespace
+{
+#ifdef __linux__
+// Stride in bytes at which mapped memory is touched, which is no
+// larger than the smallest page size
+constexpr std::size_t touch_stride = 4096;
+
+// Map `bytes` (a multiple of the huge page size) bytes of memory
+// aligned to a huge page boundary
+void* map_huge_pages(std::size_t bytes)
+{
+  constexpr std::size_t align = la::impl::huge_page_size;
+
+  // Explicit huge pages, if the system has reserved pages
+  void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p != MAP_FAILED)
+    return p;
+
+  // Transparent huge pages. Map an extra huge page and trim the
+  // mapping to a huge page boundary.
+  p = mmap(nullptr, bytes + align, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+    throw std::bad_alloc();
+  auto p0 = reinterpret_cast<std::uintptr_t>(p);
+  std::uintptr_t p1 = (p0 + align - 1) / align * align;
+  if (p1 > p0)
+    munmap(p, p1 - p0);
+  if (std::size_t tail = align - (p1 - p0); tail > 0)
+    munmap(reinterpret_cast<void*>(p1 + bytes), tail);
+  p = reinterpret_cast<void*>(p1);
+#ifdef MADV_HUGEPAGE
+  madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+  return p;
+}
+#endif
+} // namespace
+
+//-----------------------------------------------------------------------------
+void* la::impl::huge_page_allocate(std::size_t bytes, int num_threads)
+{
+#ifdef __linux__
+  if (bytes >= huge_page_size)
+  {
+    const std::size_t size
+        = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+    auto p = static_cast<std::byte*>(map_huge_pages(size));
+
+    // First touch of the pages. Mapped memory is zero, so writing zero
+    // does not change the data.
+    common::parallel_for(bytes, num_threads,
+                         [p](std::size_t i0, std::size_t i1)
+                         {
+                           for (std::size_t i = i0; i < i1; i += touch_stride)
+                             p[i] = std::byte{0};
+                         });
+    return p;
+  }
+#endif
+  return ::operator new(bytes);
+}
+//-----------------------------------------------------------------------------
+void la::impl::huge_page_deallocate(void* p, std::size_t bytes) noexcept
+{
+#ifdef __linux__
+  if (bytes >= huge_page_size)
+  {
+    munmap(p, (bytes + huge_page_size - 1) / huge_page_size * huge_page_size);
+    return;
+  }
+#endif
+  ::operator delete(p);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,133 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/// @file HugePageAllocator.h
+/// @brief Allocator for large linear algebra arrays that uses huge
+/// pages.
+
+namespace dolfinx::la
+{
+namespace impl
+{
+/// Size in bytes of a huge page
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+/// @brief Allocate memory for a large array.
+///
+/// Allocations of at least huge_page_size bytes are mapped directly,
+/// rounded up to a multiple of the huge page size and aligned to a
+/// huge page boundary. Explicit (pre-reserved) huge pages are used if
+/// available, otherwise transparent huge pages are requested. Smaller
+/// allocations use `operator new`.
+///
+/// Directly mapped memory is touched (zeroed) by `num_threads`
+/// threads, with thread `i` touching the `i`th of `num_threads`
+/// contiguous blocks of the array (see common::thread_range). With a
+/// first-touch NUMA policy the memory of each block is therefore
+/// placed on the NUMA node of the thread that touched it.
+///
+/// @param[in] bytes Size in bytes.
+/// @param[in] num_threads Number of threads that touch the memory.
+/// @return Pointer to the memory.
+void* huge_page_allocate(std::size_t bytes, int num_threads);
+
+/// @brief Free memory allocated by huge_page_allocate().
+/// @param[in] p Pointer to the memory.
+/// @param[in] bytes Size in bytes that was passed to
+/// huge_page_allocate().
+void huge_page_deallocate(void* p, std::size_t bytes) noexcept;
+} // namespace impl
+
+/// @brief Allocator for large arrays that uses huge pages and
+/// NUMA-local first-touch placement of the memory.
+///
+/// Arrays of many megabytes, e.g. the values of a large matrix, are
+/// accessed with poor TLB locality when mapped with standard (4 KB)
+/// pages. This allocator maps such arrays using 2 MB huge pages, see
+/// impl::huge_page_allocate(). Containers that use the allocator can
+/// be used as the `Container` type of la::Vector and la::MatrixCSR,
+/// e.g.
+/// @code{.cpp}
+/// la::MatrixCSR<double, la::huge_page_vector<double>> A(sp);
+/// la::Vector<double, la::huge_page_vector<double>> x(map, 1);
+/// @endcode
+///
+/// @tparam T Value type.
+/// @tparam NumThreads Number of threads that touch newly allocated
+/// memory. It should be equal to the number of threads that operate
+/// on the data, e.g. the number of threads used for assembly or
+/// matrix-vector products with common::parallel_for. With one thread
+/// per MPI rank the default is appropriate.
+template <typename T, int NumThreads = 1>
+class HugePageAllocator
+{
+  static_assert(NumThreads > 0, "Number of threads must be positive.");
+
+public:
+  /// Value type
+  using value_type = T;
+
+  /// All allocators can free memory allocated by any other allocator
+  using is_always_equal = std::true_type;
+
+  /// Allocator for a different value type
+  template <typename U>
+  struct rebind
+  {
+    /// Allocator type
+    using other = HugePageAllocator<U, NumThreads>;
+  };
+
+  HugePageAllocator() = default;
+
+  /// Converting constructor
+  template <typename U>
+  constexpr HugePageAllocator(const HugePageAllocator<U, NumThreads>&) noexcept
+  {
+  }
+
+  /// @brief Allocate memory for `n` values.
+  /// @param[in] n Number of values.
+  /// @return Pointer to the memory.
+  T* allocate(std::size_t n)
+  {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "Over-aligned types are not supported.");
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+      throw std::bad_array_new_length();
+    return static_cast<T*>(impl::huge_page_allocate(n * sizeof(T), NumThreads));
+  }
+
+  /// @brief Free memory allocated by allocate().
+  /// @param[in] p Pointer to the memory.
+  /// @param[in] n Number of values that was passed to allocate().
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    impl::huge_page_deallocate(p, n * sizeof(T));
+  }
+};
+
+/// @brief Compare allocators.
+template <typename T, typename U, int NumThreads>
+constexpr bool operator==(const HugePageAllocator<T, NumThreads>&,
+                          const HugePageAllocator<U, NumThreads>&) noexcept
+{
+  return true;
+}
+
+/// Vector that is allocated with a HugePageAllocator
+template <typename T, int NumThreads = 1>
+using huge_page_vector = std::vector<T, HugePageAllocator<T, NumThreads>>;
+
+} // namespace dolfinx::la
@@ -6,15 +6,21 @@
 
 #pragma once
 
+#include "MultiVector.h"
 #include "SparsityPattern.h"
 #include "Vector.h"
 #include "matrix_csr_impl.h"
 #include <algorithm>
+#include <cstddef>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <limits>
+#include <memory>
 #include <mpi.h>
 #include <numeric>
+#include <type_traits>
 #include <span>
 #include <utility>
 #include <vector>
@@ -152,6 +158,43 @@ public:
     };
   }
 
+  /// @brief Insertion functor for adding values of a different scalar
+  /// type to a matrix.
+  ///
+  /// The function is the same as the function returned by
+  /// mat_add_values(), except that the values to add have type `S`
+  /// and are converted to the matrix scalar type before insertion.
+  /// This allows, for example, a form with scalar type `double` to be
+  /// assembled into a matrix that stores `float` values.
+  ///
+  /// @tparam S Scalar type of the values to add.
+  /// @tparam BS0 Row block size of data for insertion
+  /// @tparam BS1 Column block size of data for insertion
+  ///
+  /// @return Function for inserting values into `A`
+  template <typename S, int BS0 = 1, int BS1 = 1>
+  auto mat_add_values_cast()
+  {
+    if ((BS0 != _bs[0] and BS0 > 1 and _bs[0] > 1)
+        or (BS1 != _bs[1] and BS1 > 1 and _bs[1] > 1))
+    {
+      throw std::runtime_error(
+          "Cannot insert blocks of different size than matrix block size");
+    }
+
+    return [&, buffer = std::vector<value_type>()](
+               std::span<const std::int32_t> rows,
+               std::span<const std::int32_t> cols,
+               std::span<const S> data) mutable -> int
+    {
+      buffer.resize(data.size());
+      std::ranges::transform(data, buffer.begin(), [](auto x)
+                             { return static_cast<value_type>(x); });
+      this->add<BS0, BS1>(buffer, rows, cols);
+      return 0;
+    };
+  }
+
   /// @brief Create a distributed matrix.
   ///
   /// The structure of the matrix depends entirely on the input
@@ -167,6 +210,13 @@ public:
   /// @note The block size of the matrix is given by the block size of
   /// the input `SparsityPattern`.
   ///
+  /// @note If the lower triangle of `p` has been dropped (see
+  /// SparsityPattern::drop_lower_triangle), the matrix has symmetric
+  /// storage: only the entries on and above the diagonal of the owned
+  /// blocks are stored, entries below the diagonal are ignored when
+  /// values are added or set, and the products apply the matrix as
+  /// symmetric (see mult). The block mode must then be compact.
+  ///
   /// @param[in] p The sparsity pattern which describes the parallel
   /// distribution and the non-zero structure.
   /// @param[in] mode Block mode. When the block size is greater than
@@ -177,6 +227,32 @@ public:
   /// the matrix is set to (1, 1).
   MatrixCSR(const SparsityPattern& p, BlockMode mode = BlockMode::compact);
 
+  /// @brief Create a matrix with the same parallel distribution and
+  /// non-zero structure as another matrix, with zero entries.
+  ///
+  /// The column indices, row pointers, off-diagonal offsets and the
+  /// data (including the neighbourhood communicator) for transferring
+  /// ghost rows are immutable and shared with `A` rather than copied.
+  /// The new matrix holds only its values, which makes it much cheaper
+  /// in time and memory than creating another matrix from the sparsity
+  /// pattern, e.g. for the stage matrices of a time integrator or a
+  /// preconditioner with the structure of an operator.
+  ///
+  /// @note This function is not collective.
+  /// @note Matrices that share a structure share a communicator, so
+  /// their scatter_rev_begin() calls must be made in the same order on
+  /// all ranks.
+  ///
+  /// @param[in] A Matrix to share the structure of. Its scalar and
+  /// value container types can differ from the new matrix.
+  /// @return Matrix with zero entries.
+  template <class Scalar0, class Container0>
+  static MatrixCSR share_structure(
+      const MatrixCSR<Scalar0, Container0, ColContainer, RowPtrContainer>& A)
+  {
+    return MatrixCSR(A, nullptr);
+  }
+
   /// Move constructor
   /// @todo Check handling of MPI_Request
   MatrixCSR(MatrixCSR&& A) = default;
@@ -186,6 +262,23 @@ public:
   /// @param[in] x The value to set non-zero matrix entries to
   void set(value_type x) { std::ranges::fill(_data, x); }
 
+  /// @brief Set all non-zero entries of a set of rows to a value.
+  ///
+  /// Only the data of the given rows is touched, so that the entries
+  /// of a small part of a matrix can be reset before re-assembly.
+  /// @param[in] x The value to set the non-zero entries to.
+  /// @param[in] rows Local (block) row indices, which may include ghost
+  /// rows.
+  void set_rows(value_type x, std::span<const std::int32_t> rows)
+  {
+    const int bs2 = _bs[0] * _bs[1];
+    for (std::int32_t r : rows)
+    {
+      std::fill(std::next(_data.begin(), (*_row_ptr)[r] * bs2),
+                std::next(_data.begin(), (*_row_ptr)[r + 1] * bs2), x);
+    }
+  }
+
   /// @brief Set values in the matrix.
   ///
   /// @note Only entries included in the sparsity pattern used to
@@ -213,22 +306,23 @@ public:
     assert(x.size() == rows.size() * cols.size() * BS0 * BS1);
     if (_bs[0] == BS0 and _bs[1] == BS1)
     {
-      impl::insert_csr<BS0, BS1>(_data, _cols, _row_ptr, x, rows, cols, set_fn,
-                                 num_rows);
+      impl::insert_csr<BS0, BS1>(_data, *_cols, *_row_ptr, x, rows, cols,
+                                 set_fn, num_rows, _symmetric);
     }
     else if (_bs[0] == 1 and _bs[1] == 1)
     {
       // Set blocked data in a regular CSR matrix (_bs[0]=1, _bs[1]=1)
       // with correct sparsity
-      impl::insert_blocked_csr<BS0, BS1>(_data, _cols, _row_ptr, x, rows, cols,
-                                         set_fn, num_rows);
+      impl::insert_blocked_csr<BS0, BS1>(_data, *_cols, *_row_ptr, x, rows,
+                                         cols, set_fn, num_rows, _symmetric);
     }
     else
     {
       assert(BS0 == 1 and BS1 == 1);
       // Set non-blocked data in a blocked CSR matrix (BS0=1, BS1=1)
-      impl::insert_nonblocked_csr(_data, _cols, _row_ptr, x, rows, cols, set_fn,
-                                  num_rows, _bs[0], _bs[1]);
+      impl::insert_nonblocked_csr(_data, *_cols, *_row_ptr, x, rows, cols,
+                                  set_fn, num_rows, _bs[0], _bs[1],
+                                  _symmetric);
     }
   }
 
@@ -256,21 +350,74 @@ public:
     assert(x.size() == rows.size() * cols.size() * BS0 * BS1);
     if (_bs[0] == BS0 and _bs[1] == BS1)
     {
-      impl::insert_csr<BS0, BS1>(_data, _cols, _row_ptr, x, rows, cols, add_fn,
-                                 _row_ptr.size());
+      impl::insert_csr<BS0, BS1>(_data, *_cols, *_row_ptr, x, rows, cols,
+                                 add_fn, _row_ptr->size(), _symmetric);
     }
     else if (_bs[0] == 1 and _bs[1] == 1)
     {
       // Add blocked data to a regular CSR matrix (_bs[0]=1, _bs[1]=1)
-      impl::insert_blocked_csr<BS0, BS1>(_data, _cols, _row_ptr, x, rows, cols,
-                                         add_fn, _row_ptr.size());
+      impl::insert_blocked_csr<BS0, BS1>(_data, *_cols, *_row_ptr, x, rows,
+                                         cols, add_fn, _row_ptr->size(),
+                                         _symmetric);
     }
     else
     {
       assert(BS0 == 1 and BS1 == 1);
       // Add non-blocked data to a blocked CSR matrix (BS0=1, BS1=1)
-      impl::insert_nonblocked_csr(_data, _cols, _row_ptr, x, rows, cols, add_fn,
-                                  _row_ptr.size(), _bs[0], _bs[1]);
+      impl::insert_nonblocked_csr(_data, *_cols, *_row_ptr, x, rows, cols,
+                                  add_fn, _row_ptr->size(), _bs[0], _bs[1],
+                                  _symmetric);
+    }
+  }
+
+  /// @brief Compute the positions in the matrix data (see values()) of
+  /// the entries of a dense block of values.
+  ///
+  /// The positions depend only on the sparsity pattern and the block
+  /// indices, and can therefore be computed once and re-used to
+  /// accumulate values into the matrix without searching for the
+  /// columns, e.g. for repeated assembly of the same bilinear form.
+  ///
+  /// @note The matrix block size must be (BS0, BS1) or (1, 1), and the
+  /// matrix must not have symmetric storage.
+  ///
+  /// @tparam BS0 Row block size of data
+  /// @tparam BS1 Column block size of data
+  /// @param[out] offsets Position in the matrix data of each entry of
+  /// the `m` by `n` dense block of values (row-major) with row indices
+  /// `rows` and column indices `cols`.
+  /// @param[in] rows The row indices of the block
+  /// @param[in] cols The column indices of the block
+  template <int BS0 = 1, int BS1 = 1>
+  void data_offsets(std::span<std::int32_t> offsets,
+                    std::span<const std::int32_t> rows,
+                    std::span<const std::int32_t> cols) const
+  {
+    if (_data.size()
+        > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+    {
+      throw std::runtime_error(
+          "Matrix data size too large for 32-bit data offsets.");
+    }
+
+    if (_symmetric)
+    {
+      throw std::runtime_error(
+          "Data offsets are not supported for symmetric storage.");
+    }
+
+    if (_bs[0] == BS0 and _bs[1] == BS1)
+      impl::csr_offsets<BS0, BS1>(offsets, *_cols, *_row_ptr, rows, cols);
+    else if (_bs[0] == 1 and _bs[1] == 1)
+    {
+      impl::blocked_csr_offsets<BS0, BS1>(offsets, *_cols, *_row_ptr, rows,
+                                          cols);
+    }
+    else
+    {
+      throw std::runtime_error(
+          "Cannot compute offsets for blocks of different size than matrix "
+          "block size");
     }
   }
 
@@ -278,7 +425,7 @@ public:
   std::int32_t num_owned_rows() const { return _index_maps[0]->size_local(); }
 
   /// Number of local rows including ghost rows
-  std::int32_t num_all_rows() const { return _row_ptr.size() - 1; }
+  std::int32_t num_all_rows() const { return _row_ptr->size() - 1; }
 
   /// @brief Copy to a dense matrix.
   /// @note This function is typically used for debugging and not used
@@ -287,6 +434,8 @@ public:
   /// manually by using num_owned_rows() if required.
   /// @note If the block size is greater than 1, the entries are
   /// expanded.
+  /// @note For symmetric storage, the entries below the diagonal of the
+  /// owned block are also returned.
   /// @return Dense copy of the part of the matrix on the calling rank.
   /// Storage is row-major.
   std::vector<value_type> to_dense() const
@@ -296,13 +445,13 @@ public:
     std::vector<value_type> A(nrows * ncols * _bs[0] * _bs[1], 0.0);
     for (std::size_t r = 0; r < nrows; ++r)
     {
-      for (std::int32_t j = _row_ptr[r]; j < _row_ptr[r + 1]; ++j)
+      for (std::int32_t j = (*_row_ptr)[r]; j < (*_row_ptr)[r + 1]; ++j)
       {
         for (int i0 = 0; i0 < _bs[0]; ++i0)
         {
           for (int i1 = 0; i1 < _bs[1]; ++i1)
           {
-            std::array<std::int32_t, 1> local_col{_cols[j]};
+            std::array<std::int32_t, 1> local_col{(*_cols)[j]};
             std::array<std::int64_t, 1> global_col{0};
             _index_maps[1]->local_to_global(local_col, global_col);
             A[(r * _bs[1] + i0) * ncols * _bs[0] + global_col[0] * _bs[1] + i1]
@@ -312,6 +461,31 @@ public:
       }
     }
 
+    if (_symmetric)
+    {
+      // Entries below the diagonal of the owned block
+      const std::int32_t num_rows = num_owned_rows();
+      const std::int64_t offset = _index_maps[0]->local_range()[0];
+      const std::size_t bs = _bs[0];
+      for (std::int32_t r = 0; r < num_rows; ++r)
+      {
+        for (auto j = (*_row_ptr)[r]; j < (*_off_diagonal_offset)[r]; ++j)
+        {
+          const std::int32_t c = (*_cols)[j];
+          if (c == r)
+            continue;
+          for (std::size_t i0 = 0; i0 < bs; ++i0)
+          {
+            for (std::size_t i1 = 0; i1 < bs; ++i1)
+            {
+              A[(c * bs + i1) * ncols * bs + (offset + r) * bs + i0]
+                  = _data[(j * bs + i0) * bs + i1];
+            }
+          }
+        }
+      }
+    }
+
     return A;
   }
 
@@ -330,8 +504,10 @@ public:
   /// @brief Begin transfer of ghost row data to owning ranks, where it
   /// will be accumulated into existing owned rows.
   /// @note Calls to this function must be followed by
-  /// MatrixCSR::scatter_rev_end(). Between the two calls matrix values
-  /// must not be changed.
+  /// MatrixCSR::scatter_rev_end(). Between the two calls values in
+  /// ghost rows must not be changed. Values in owned rows may be
+  /// changed, e.g. by assembling contributions from cells that do not
+  /// contribute to ghost rows.
   /// @note This function does not change the matrix data. Data update
   /// only occurs with `scatter_rev_end()`.
   void scatter_rev_begin()
@@ -341,39 +517,42 @@ public:
     const int bs2 = _bs[0] * _bs[1];
 
     // For each ghost row, pack and send values to send to neighborhood
-    std::vector<int> insert_pos = _val_send_disp;
-    _ghost_value_data.resize(_val_send_disp.back());
+    const rowptr_container_type& row_ptr = *_row_ptr;
+    const std::vector<int>& val_send_disp = *_val_send_disp;
+    const std::vector<int>& val_recv_disp = *_val_recv_disp;
+    std::vector<int> insert_pos = val_send_disp;
+    _ghost_value_data.resize(val_send_disp.back());
     for (int i = 0; i < num_ghosts0; ++i)
     {
-      const int rank = _ghost_row_to_rank[i];
+      const int rank = (*_ghost_row_to_rank)[i];
 
       // Get position in send buffer to place data to send to this
       // neighbour
       const std::int32_t val_pos = insert_pos[rank];
-      std::copy(std::next(_data.data(), _row_ptr[local_size0 + i] * bs2),
-                std::next(_data.data(), _row_ptr[local_size0 + i + 1] * bs2),
+      std::copy(std::next(_data.data(), row_ptr[local_size0 + i] * bs2),
+                std::next(_data.data(), row_ptr[local_size0 + i + 1] * bs2),
                 std::next(_ghost_value_data.begin(), val_pos));
       insert_pos[rank]
-          += bs2 * (_row_ptr[local_size0 + i + 1] - _row_ptr[local_size0 + i]);
+          += bs2 * (row_ptr[local_size0 + i + 1] - row_ptr[local_size0 + i]);
     }
 
-    _ghost_value_data_in.resize(_val_recv_disp.back());
+    _ghost_value_data_in.resize(val_recv_disp.back());
 
     // Compute data sizes for send and receive from displacements
-    std::vector<int> val_send_count(_val_send_disp.size() - 1);
-    std::adjacent_difference(std::next(_val_send_disp.begin()),
-                             _val_send_disp.end(), val_send_count.begin());
+    std::vector<int> val_send_count(val_send_disp.size() - 1);
+    std::adjacent_difference(std::next(val_send_disp.begin()),
+                             val_send_disp.end(), val_send_count.begin());
 
-    std::vector<int> val_recv_count(_val_recv_disp.size() - 1);
-    std::adjacent_difference(std::next(_val_recv_disp.begin()),
-                             _val_recv_disp.end(), val_recv_count.begin());
+    std::vector<int> val_recv_count(val_recv_disp.size() - 1);
+    std::adjacent_difference(std::next(val_recv_disp.begin()),
+                             val_recv_disp.end(), val_recv_count.begin());
 
     int status = MPI_Ineighbor_alltoallv(
-        _ghost_value_data.data(), val_send_count.data(), _val_send_disp.data(),
+        _ghost_value_data.data(), val_send_count.data(), val_send_disp.data(),
         dolfinx::MPI::mpi_t<value_type>, _ghost_value_data_in.data(),
-        val_recv_count.data(), _val_recv_disp.data(),
-        dolfinx::MPI::mpi_t<value_type>, _comm.comm(), &_request);
-    dolfinx::MPI::check_error(_comm.comm(), status);
+        val_recv_count.data(), val_recv_disp.data(),
+        dolfinx::MPI::mpi_t<value_type>, _comm->comm(), &_request);
+    dolfinx::MPI::check_error(_comm->comm(), status);
   }
 
   /// @brief End transfer of ghost row data to owning ranks.
@@ -384,41 +563,62 @@ public:
   void scatter_rev_end()
   {
     int status = MPI_Wait(&_request, MPI_STATUS_IGNORE);
-    dolfinx::MPI::check_error(_comm.comm(), status);
+    dolfinx::MPI::check_error(_comm->comm(), status);
 
     _ghost_value_data.clear();
     _ghost_value_data.shrink_to_fit();
 
     // Add to local rows
     const int bs2 = _bs[0] * _bs[1];
-    assert(_ghost_value_data_in.size() == _unpack_pos.size() * bs2);
-    for (std::size_t i = 0; i < _unpack_pos.size(); ++i)
+    const std::vector<int>& unpack_pos = *_unpack_pos;
+    assert(_ghost_value_data_in.size() == unpack_pos.size() * bs2);
+    for (std::size_t i = 0; i < unpack_pos.size(); ++i)
       for (int j = 0; j < bs2; ++j)
-        _data[_unpack_pos[i] * bs2 + j] += _ghost_value_data_in[i * bs2 + j];
+        _data[unpack_pos[i] * bs2 + j] += _ghost_value_data_in[i * bs2 + j];
 
     _ghost_value_data_in.clear();
     _ghost_value_data_in.shrink_to_fit();
 
     // Set ghost row data to zero
     const std::int32_t local_size0 = _index_maps[0]->size_local();
-    std::fill(std::next(_data.begin(), _row_ptr[local_size0] * bs2),
+    std::fill(std::next(_data.begin(), (*_row_ptr)[local_size0] * bs2),
               _data.end(), 0);
   }
 
   /// @brief Compute the Frobenius norm squared across all processes.
+  /// @note For symmetric storage, the entries below the diagonal are
+  /// included.
   /// @note MPI Collective
   double squared_norm() const
   {
     const std::size_t num_owned_rows = _index_maps[0]->size_local();
     const int bs2 = _bs[0] * _bs[1];
-    assert(num_owned_rows < _row_ptr.size());
+    assert(num_owned_rows < _row_ptr->size());
     double norm_sq_local = std::accumulate(
         _data.cbegin(),
-        std::next(_data.cbegin(), _row_ptr[num_owned_rows] * bs2), double(0),
+        std::next(_data.cbegin(), (*_row_ptr)[num_owned_rows] * bs2),
+        double(0),
         [](auto norm, value_type y) { return norm + std::norm(y); });
+    if (_symmetric)
+    {
+      // Entries above the diagonal of the owned block represent two
+      // entries
+      for (std::size_t r = 0; r < num_owned_rows; ++r)
+      {
+        for (auto j = (*_row_ptr)[r]; j < (*_off_diagonal_offset)[r]; ++j)
+        {
+          if ((*_cols)[j] == static_cast<std::int32_t>(r))
+            continue;
+          norm_sq_local = std::accumulate(
+              std::next(_data.cbegin(), j * bs2),
+              std::next(_data.cbegin(), (j + 1) * bs2), norm_sq_local,
+              [](auto norm, value_type y) { return norm + std::norm(y); });
+        }
+      }
+    }
     double norm_sq;
     MPI_Allreduce(&norm_sq_local, &norm_sq, 1, MPI_DOUBLE, MPI_SUM,
-                  _comm.comm());
+                  _comm->comm());
     return norm_sq;
   }
 
@@ -427,9 +627,47 @@ public:
   /// The vectors `x` and `y` must have parallel layouts that are
   /// compatible with `A`.
   ///
+  /// If `num_threads` is greater than one, the owned rows are divided
+  /// into contiguous ranges with approximately equal numbers of
+  /// non-zeros, and the ranges are processed concurrently.
+  ///
+  /// The vector scalar type may differ from the matrix scalar type, in
+  /// which case the product is accumulated in the vector scalar type.
+  /// This allows the matrix values to be stored in lower precision,
+  /// e.g. `float` values with `double` vectors, which reduces the
+  /// memory traffic of the product.
+  ///
+  /// For symmetric storage, each stored entry above the diagonal of the
+  /// owned block is also applied as the entry below the diagonal, so
+  /// that the matrix data is read once. The entries with rows and
+  /// columns owned by different processes are stored by both
+  /// processes, and only the usual forward scatter of `x` is required.
+  /// The product is then computed by one thread.
+  ///
+  /// @tparam S Vector scalar type.
   /// @param[in] x Vector to be apply `A` to.
   /// @param[in,out] y Vector to accumulate the result into.
-  void mult(Vector<value_type>& x, Vector<value_type>& y);
+  /// @param[in] num_threads Number of threads to use.
+  template <typename S = value_type>
+  void mult(Vector<S>& x, Vector<S>& y, int num_threads = 1);
+
+  /// @brief Compute the product `y += Ax` for each vector of a
+  /// multi-vector.
+  ///
+  /// All vectors are processed in one pass over the matrix, which
+  /// reduces the memory traffic per vector compared to repeated calls
+  /// to the single vector product. The ghost entries of all vectors of
+  /// `x` are updated with a single scatter. The multi-vectors `x` and
+  /// `y` must have parallel layouts that are compatible with `A`, and
+  /// the same number of vectors. Threading, symmetric storage and the
+  /// vector scalar type are as for the single vector product.
+  ///
+  /// @tparam S Vector scalar type.
+  /// @param[in] x Multi-vector to be apply `A` to.
+  /// @param[in,out] y Multi-vector to accumulate the result into.
+  /// @param[in] num_threads Number of threads to use.
+  template <typename S = value_type>
+  void mult(MultiVector<S>& x, MultiVector<S>& y, int num_threads = 1);
 
   /// @brief Index maps for the row and column space.
   ///
@@ -453,11 +691,11 @@ public:
 
   /// Get local row pointers
   /// @note Includes pointers to ghost rows
-  const rowptr_container_type& row_ptr() const { return _row_ptr; }
+  const rowptr_container_type& row_ptr() const { return *_row_ptr; }
 
   /// Get local column indices
   /// @note Includes columns in ghost rows
-  const column_container_type& cols() const { return _cols; }
+  const column_container_type& cols() const { return *_cols; }
 
   /// Get the start of off-diagonal (unowned columns) on each row,
   /// allowing the matrix to be split (virtually) into two parts.
@@ -468,14 +706,56 @@ public:
   /// not required.
   const rowptr_container_type& off_diag_offset() const
   {
-    return _off_diagonal_offset;
+    return *_off_diagonal_offset;
   }
 
   /// Block size
   /// @return block sizes for rows and columns
   std::array<int, 2> block_size() const { return _bs; }
 
+  /// @brief Whether the matrix has symmetric storage, i.e. only the
+  /// entries on and above the diagonal of the owned blocks are stored
+  /// (see SparsityPattern::drop_lower_triangle).
+  bool symmetric() const { return _symmetric; }
+
+  /// @brief Memory used by the matrix.
+  /// @note The sparsity structure and the scatter data, which may be
+  /// shared by matrices with the same structure (see share_structure),
+  /// are included. The index maps are not included.
+  /// @return Number of bytes of the values, the sparsity structure and
+  /// the data for scatter_rev.
+  std::size_t memory_usage() const
+  {
+    auto bytes = [](auto& x)
+    {
+      using value_type = typename std::decay_t<decltype(x)>::value_type;
+      return sizeof(value_type) * x.size();
+    };
+    return bytes(_data) + bytes(*_cols) + bytes(*_row_ptr)
+           + bytes(*_off_diagonal_offset) + bytes(*_unpack_pos)
+           + bytes(*_val_send_disp) + bytes(*_val_recv_disp)
+           + bytes(*_ghost_row_to_rank) + bytes(_ghost_value_data)
+           + bytes(_ghost_value_data_in);
+  }
+
 private:
+  // Create a matrix that shares the structure of A (see
+  // share_structure)
+  template <class Scalar0, class Container0>
+  MatrixCSR(
+      const MatrixCSR<Scalar0, Container0, ColContainer, RowPtrContainer>& A,
+      std::nullptr_t)
+      : _index_maps(A._index_maps), _block_mode(A._block_mode), _bs(A._bs),
+        _symmetric(A._symmetric),
+        _data(A._row_ptr->back() * A._bs[0] * A._bs[1], 0),
+        _cols(A._cols), _row_ptr(A._row_ptr),
+        _off_diagonal_offset(A._off_diagonal_offset), _comm(A._comm),
+        _request(MPI_REQUEST_NULL), _unpack_pos(A._unpack_pos),
+        _val_send_disp(A._val_send_disp), _val_recv_disp(A._val_recv_disp),
+        _ghost_row_to_rank(A._ghost_row_to_rank)
+  {
+  }
+
   // Maps for the distribution of the ows and columns
   std::array<std::shared_ptr<const common::IndexMap>, 2> _index_maps;
 
@@ -485,32 +765,43 @@ private:
   // Block sizes
   std::array<int, 2> _bs;
 
+  // True if only the upper triangle of the owned block is stored
+  bool _symmetric;
+
+  // Matrices of other types share the structure of a matrix
+  template <class, class, class, class>
+  friend class MatrixCSR;
+
   // Matrix data
   container_type _data;
-  column_container_type _cols;
-  rowptr_container_type _row_ptr;
+
+  // Column indices and row pointers. They can be shared between
+  // matrices with the same structure.
+  std::shared_ptr<const column_container_type> _cols;
+  std::shared_ptr<const rowptr_container_type> _row_ptr;
 
   // Start of off-diagonal (unowned columns) on each row
-  rowptr_container_type _off_diagonal_offset;
+  std::shared_ptr<const rowptr_container_type> _off_diagonal_offset;
 
   // Neighborhood communicator (ghost->owner communicator for rows)
-  dolfinx::MPI::Comm _comm;
-
-  // -- Precomputed data for scatter_rev/update
+  std::shared_ptr<const dolfinx::MPI::Comm> _comm;
 
   // Request in non-blocking communication
   MPI_Request _request;
 
+  // -- Precomputed data for scatter_rev/update, which can also be
+  // shared between matrices with the same structure
+
   // Position in _data to add received data
-  std::vector<int> _unpack_pos;
+  std::shared_ptr<const std::vector<int>> _unpack_pos;
 
   // Displacements for alltoall for each neighbor when sending and
   // receiving
-  std::vector<int> _val_send_disp, _val_recv_disp;
+  std::shared_ptr<const std::vector<int>> _val_send_disp, _val_recv_disp;
 
   // Ownership of each row, by neighbor (for the neighbourhood defined
   // on _comm)
-  std::vector<int> _ghost_row_to_rank;
+  std::shared_ptr<const std::vector<int>> _ghost_row_to_rank;
 
   // Temporary stores for data during non-blocking communication
   container_type _ghost_value_data;
@@ -522,11 +813,18 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
     : _index_maps({p.index_map(0),
                    std::make_shared<common::IndexMap>(p.column_index_map())}),
       _block_mode(mode), _bs({p.block_size(0), p.block_size(1)}),
-      _data(p.num_nonzeros() * _bs[0] * _bs[1], 0),
-      _cols(p.graph().first.begin(), p.graph().first.end()),
-      _row_ptr(p.graph().second.begin(), p.graph().second.end()),
-      _comm(MPI_COMM_NULL)
+      _symmetric(p.symmetric()), _data(p.num_nonzeros() * _bs[0] * _bs[1], 0)
 {
+  if (_symmetric and _block_mode == BlockMode::expanded)
+  {
+    throw std::runtime_error(
+        "Symmetric storage requires the compact block mode.");
+  }
+
+  column_container_type cols(p.graph().first.begin(), p.graph().first.end());
+  rowptr_container_type row_ptr(p.graph().second.begin(),
+                                p.graph().second.end());
+  rowptr_container_type off_diagonal_offset;
   if (_block_mode == BlockMode::expanded)
   {
     // Rebuild IndexMaps
@@ -562,25 +860,25 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
     column_container_type new_cols;
     new_cols.reserve(_data.size());
     rowptr_container_type new_row_ptr = {0};
-    new_row_ptr.reserve(_row_ptr.size() * _bs[0]);
+    new_row_ptr.reserve(row_ptr.size() * _bs[0]);
     std::span<const std::int32_t> num_diag_nnz = p.off_diagonal_offsets();
-    for (std::size_t i = 0; i < _row_ptr.size() - 1; ++i)
+    for (std::size_t i = 0; i < row_ptr.size() - 1; ++i)
     {
       // Repeat row _bs[0] times
       for (int q0 = 0; q0 < _bs[0]; ++q0)
       {
-        _off_diagonal_offset.push_back(new_row_ptr.back()
+        off_diagonal_offset.push_back(new_row_ptr.back()
                                        + num_diag_nnz[i] * _bs[1]);
-        for (auto j = _row_ptr[i]; j < _row_ptr[i + 1]; ++j)
+        for (auto j = row_ptr[i]; j < row_ptr[i + 1]; ++j)
         {
           for (int q1 = 0; q1 < _bs[1]; ++q1)
-            new_cols.push_back(_cols[j] * _bs[1] + q1);
+            new_cols.push_back(cols[j] * _bs[1] + q1);
         }
         new_row_ptr.push_back(new_cols.size());
       }
     }
-    _cols = new_cols;
-    _row_ptr = new_row_ptr;
+    cols = std::move(new_cols);
+    row_ptr = std::move(new_row_ptr);
     _bs[0] = 1;
     _bs[1] = 1;
   }
@@ -588,9 +886,9 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
   {
     // Compute off-diagonal offset for each row (compact)
     std::span<const std::int32_t> num_diag_nnz = p.off_diagonal_offsets();
-    _off_diagonal_offset.reserve(num_diag_nnz.size());
-    std::ranges::transform(num_diag_nnz, _row_ptr,
-                           std::back_inserter(_off_diagonal_offset),
+    off_diagonal_offset.reserve(num_diag_nnz.size());
+    std::ranges::transform(num_diag_nnz, row_ptr,
+                           std::back_inserter(off_diagonal_offset),
                            std::plus{});
   }
 
@@ -611,49 +909,50 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
                                  dest_ranks.data(), MPI_UNWEIGHTED,
                                  src_ranks.size(), src_ranks.data(),
                                  MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
-  _comm = dolfinx::MPI::Comm(comm, false);
+  _comm = std::make_shared<const dolfinx::MPI::Comm>(comm, false);
 
   // Build map from ghost row index position to owning (neighborhood)
   // rank
-  _ghost_row_to_rank.reserve(_index_maps[0]->owners().size());
+  std::vector<int> ghost_row_to_rank;
+  ghost_row_to_rank.reserve(_index_maps[0]->owners().size());
   for (int r : _index_maps[0]->owners())
   {
     auto it = std::ranges::lower_bound(src_ranks, r);
     assert(it != src_ranks.end() and *it == r);
     std::size_t pos = std::distance(src_ranks.begin(), it);
-    _ghost_row_to_rank.push_back(pos);
+    ghost_row_to_rank.push_back(pos);
   }
 
   // Compute size of data to send to each neighbor
   std::vector<std::int32_t> data_per_proc(src_ranks.size(), 0);
-  for (std::size_t i = 0; i < _ghost_row_to_rank.size(); ++i)
+  for (std::size_t i = 0; i < ghost_row_to_rank.size(); ++i)
   {
-    assert(_ghost_row_to_rank[i] < (int)data_per_proc.size());
+    assert(ghost_row_to_rank[i] < (int)data_per_proc.size());
     std::size_t pos = local_size[0] + i;
-    data_per_proc[_ghost_row_to_rank[i]] += _row_ptr[pos + 1] - _row_ptr[pos];
+    data_per_proc[ghost_row_to_rank[i]] += row_ptr[pos + 1] - row_ptr[pos];
   }
 
   // Compute send displacements
-  _val_send_disp.resize(src_ranks.size() + 1, 0);
+  std::vector<int> val_send_disp(src_ranks.size() + 1, 0);
   std::partial_sum(data_per_proc.begin(), data_per_proc.end(),
-                   std::next(_val_send_disp.begin()));
+                   std::next(val_send_disp.begin()));
 
   // For each ghost row, pack and send indices to neighborhood
-  std::vector<std::int64_t> ghost_index_data(2 * _val_send_disp.back());
+  std::vector<std::int64_t> ghost_index_data(2 * val_send_disp.back());
   {
-    std::vector<int> insert_pos = _val_send_disp;
-    for (std::size_t i = 0; i < _ghost_row_to_rank.size(); ++i)
+    std::vector<int> insert_pos = val_send_disp;
+    for (std::size_t i = 0; i < ghost_row_to_rank.size(); ++i)
     {
-      const int rank = _ghost_row_to_rank[i];
+      const int rank = ghost_row_to_rank[i];
       std::int32_t row_id = local_size[0] + i;
-      for (int j = _row_ptr[row_id]; j < _row_ptr[row_id + 1]; ++j)
+      for (int j = row_ptr[row_id]; j < row_ptr[row_id + 1]; ++j)
       {
         // Get position in send buffer
         const std::int32_t idx_pos = 2 * insert_pos[rank];
 
         // Pack send data (row, col) as global indices
         ghost_index_data[idx_pos] = ghosts0[i];
-        if (std::int32_t col_local = _cols[j]; col_local < local_size[1])
+        if (std::int32_t col_local = cols[j]; col_local < local_size[1])
           ghost_index_data[idx_pos + 1] = col_local + local_range[1][0];
         else
           ghost_index_data[idx_pos + 1] = ghosts1[col_local - local_size[1]];
@@ -675,7 +974,7 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
     send_sizes.reserve(1);
     recv_sizes.reserve(1);
     MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
-                          MPI_INT, _comm.comm());
+                          MPI_INT, _comm->comm());
 
     // Build send/recv displacement
     std::vector<int> send_disp = {0};
@@ -689,16 +988,16 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
     MPI_Neighbor_alltoallv(ghost_index_data.data(), send_sizes.data(),
                            send_disp.data(), MPI_INT64_T,
                            ghost_index_array.data(), recv_sizes.data(),
-                           recv_disp.data(), MPI_INT64_T, _comm.comm());
+                           recv_disp.data(), MPI_INT64_T, _comm->comm());
   }
 
   // Store receive displacements for future use, when transferring
   // data values
-  _val_recv_disp.resize(recv_disp.size());
+  std::vector<int> val_recv_disp(recv_disp.size());
   const int bs2 = _bs[0] * _bs[1];
-  std::ranges::transform(recv_disp, _val_recv_disp.begin(),
+  std::ranges::transform(recv_disp, val_recv_disp.begin(),
                          [&bs2](auto d) { return bs2 * d / 2; });
-  std::ranges::transform(_val_send_disp, _val_send_disp.begin(),
+  std::ranges::transform(val_send_disp, val_send_disp.begin(),
                          [&bs2](auto d) { return d * bs2; });
 
   // Global-to-local map for ghost columns
@@ -710,6 +1009,8 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
 
   // Compute location in which data for each index should be stored
   // when received
+  std::vector<int> unpack_pos;
+  unpack_pos.reserve(ghost_index_array.size() / 2);
   for (std::size_t i = 0; i < ghost_index_array.size(); i += 2)
   {
     // Row must be on this process
@@ -727,16 +1028,28 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
              and it->first == ghost_index_array[i + 1]);
       local_col = it->second;
     }
-    auto cit0 = std::next(_cols.begin(), _row_ptr[local_row]);
-    auto cit1 = std::next(_cols.begin(), _row_ptr[local_row + 1]);
+    auto cit0 = std::next(cols.begin(), row_ptr[local_row]);
+    auto cit1 = std::next(cols.begin(), row_ptr[local_row + 1]);
 
     // Find position of column index and insert data
     auto cit = std::lower_bound(cit0, cit1, local_col);
     assert(cit != cit1);
     assert(*cit == local_col);
-    std::size_t d = std::distance(_cols.begin(), cit);
-    _unpack_pos.push_back(d);
+    std::size_t d = std::distance(cols.begin(), cit);
+    unpack_pos.push_back(d);
   }
+
+  _cols = std::make_shared<const column_container_type>(std::move(cols));
+  _row_ptr = std::make_shared<const rowptr_container_type>(std::move(row_ptr));
+  _off_diagonal_offset = std::make_shared<const rowptr_container_type>(
+      std::move(off_diagonal_offset));
+  _unpack_pos = std::make_shared<const std::vector<int>>(std::move(unpack_pos));
+  _val_send_disp
+      = std::make_shared<const std::vector<int>>(std::move(val_send_disp));
+  _val_recv_disp
+      = std::make_shared<const std::vector<int>>(std::move(val_recv_disp));
+  _ghost_row_to_rank
+      = std::make_shared<const std::vector<int>>(std::move(ghost_row_to_rank));
 }
 //-----------------------------------------------------------------------------
 
@@ -765,8 +1078,9 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
 /// Computes y += A*x for a parallel CSR matrix A and parallel dense vectors
 /// x,y
 template <typename Scalar, typename V, typename W, typename X>
-void MatrixCSR<Scalar, V, W, X>::mult(la::Vector<Scalar>& x,
-                                      la::Vector<Scalar>& y)
+template <typename S>
+void MatrixCSR<Scalar, V, W, X>::mult(la::Vector<S>& x, la::Vector<S>& y,
+                                      int num_threads)
 {
   // start communication (update ghosts)
   x.scatter_fwd_begin();
@@ -776,42 +1090,150 @@ void MatrixCSR<Scalar, V, W, X>::mult(la::Vector<Scalar>& x,
   std::span<const std::int32_t> Acols(cols().data(), Arow_ptr[nrowslocal]);
   std::span<const std::int64_t> Aoff_diag_offset(off_diag_offset().data(),
                                                  nrowslocal);
-  std::span<const Scalar> Avalues(values().data(), Arow_ptr[nrowslocal]);
+  std::span<const Scalar> Avalues(values().data(),
+                                  Arow_ptr[nrowslocal] * _bs[0] * _bs[1]);
 
-  std::span<const Scalar> _x = x.array();
-  std::span<Scalar> _y = y.mutable_array();
+  std::span<const S> _x = x.array();
+  std::span<S> _y = y.mutable_array();
 
   std::span<const std::int64_t> Arow_begin(Arow_ptr.data(), nrowslocal);
   std::span<const std::int64_t> Arow_end(Arow_ptr.data() + 1, nrowslocal);
 
-  // First stage:  spmv - diagonal
-  // yi[0] += Ai[0] * xi[0]
-  if (_bs[1] == 1)
+  if (_symmetric)
   {
-    impl::spmv<Scalar, 1>(Avalues, Arow_begin, Aoff_diag_offset, Acols, _x, _y,
-                          _bs[0], 1);
+    impl::spmm_symmetric<Scalar>(Avalues, Arow_begin, Aoff_diag_offset, Acols,
+                                 _x, _y, _bs[0], 1, true);
+    x.scatter_fwd_end();
+    impl::spmm_symmetric<Scalar>(Avalues, Aoff_diag_offset, Arow_end, Acols,
+                                 _x, _y, _bs[0], 1, false);
+    return;
   }
-  else
+
+  // Row ranges for each thread, balanced by number of non-zeros
+  const std::vector<std::int32_t> ranges
+      = impl::partition_rows(Arow_ptr, std::max(num_threads, 1));
+  const int num_parts = ranges.size() - 1;
+
+  // Compute y[r] += A[r, c] x[c] for the rows r of each thread, with
+  // the columns c for each row in [c0[r], c1[r])
+  auto spmv = [&](std::span<const std::int64_t> c0,
+                  std::span<const std::int64_t> c1)
   {
-    impl::spmv<Scalar, -1>(Avalues, Arow_begin, Aoff_diag_offset, Acols, _x, _y,
-                           _bs[0], _bs[1]);
-  }
+    common::run_threads(
+        num_parts,
+        [&](int i)
+        {
+          const std::int32_t r0 = ranges[i];
+          const std::int32_t n = ranges[i + 1] - r0;
+          auto block = [&]<int BS>(std::integral_constant<int, BS>)
+          {
+            impl::spmv_block<Scalar, BS>(Avalues, c0.subspan(r0, n),
+                                         c1.subspan(r0, n), Acols, _x,
+                                         _y.subspan(r0 * BS));
+          };
+          if (_bs[1] == 1)
+          {
+            impl::spmv<Scalar, 1>(Avalues, c0.subspan(r0, n),
+                                  c1.subspan(r0, n), Acols, _x,
+                                  _y.subspan(r0 * _bs[0]), _bs[0], 1);
+          }
+          else if (_bs[0] == _bs[1] and _bs[0] == 2)
+            block(std::integral_constant<int, 2>{});
+          else if (_bs[0] == _bs[1] and _bs[0] == 3)
+            block(std::integral_constant<int, 3>{});
+          else if (_bs[0] == _bs[1] and _bs[0] == 4)
+            block(std::integral_constant<int, 4>{});
+          else if (_bs[0] == _bs[1] and _bs[0] == 6)
+            block(std::integral_constant<int, 6>{});
+          else
+          {
+            impl::spmv<Scalar, -1>(Avalues, c0.subspan(r0, n),
+                                   c1.subspan(r0, n), Acols, _x,
+                                   _y.subspan(r0 * _bs[0]), _bs[0], _bs[1]);
+          }
+        });
+  };
+
+  // First stage:  spmv - diagonal
+  // yi[0] += Ai[0] * xi[0]
+  spmv(Arow_begin, Aoff_diag_offset);
 
   // finalize ghost update
   x.scatter_fwd_end();
 
   // Second stage:  spmv - off-diagonal
   // yi[0] += Ai[1] * xi[1]
-  if (_bs[1] == 1)
+  spmv(Aoff_diag_offset, Arow_end);
+}
+
+/// Computes y += A*x for a parallel CSR matrix A and parallel dense
+/// multi-vectors x, y
+template <typename Scalar, typename V, typename W, typename X>
+template <typename S>
+void MatrixCSR<Scalar, V, W, X>::mult(la::MultiVector<S>& x,
+                                      la::MultiVector<S>& y, int num_threads)
+{
+  const int num_vectors = x.num_vectors();
+  if (y.num_vectors() != num_vectors)
+    throw std::runtime_error("Incompatible number of vectors.");
+
+  // start communication (update ghosts)
+  x.scatter_fwd_begin();
+
+  const std::int32_t nrowslocal = num_owned_rows();
+  std::span<const std::int64_t> Arow_ptr(row_ptr().data(), nrowslocal + 1);
+  std::span<const std::int32_t> Acols(cols().data(), Arow_ptr[nrowslocal]);
+  std::span<const std::int64_t> Aoff_diag_offset(off_diag_offset().data(),
+                                                 nrowslocal);
+  std::span<const Scalar> Avalues(values().data(),
+                                  Arow_ptr[nrowslocal] * _bs[0] * _bs[1]);
+
+  std::span<const S> _x = x.array();
+  std::span<S> _y = y.mutable_array();
+
+  std::span<const std::int64_t> Arow_begin(Arow_ptr.data(), nrowslocal);
+  std::span<const std::int64_t> Arow_end(Arow_ptr.data() + 1, nrowslocal);
+
+  if (_symmetric)
   {
-    impl::spmv<Scalar, 1>(Avalues, Aoff_diag_offset, Arow_end, Acols, _x, _y,
-                          _bs[0], 1);
+    impl::spmm_symmetric<Scalar>(Avalues, Arow_begin, Aoff_diag_offset, Acols,
+                                 _x, _y, _bs[0], num_vectors, true);
+    x.scatter_fwd_end();
+    impl::spmm_symmetric<Scalar>(Avalues, Aoff_diag_offset, Arow_end, Acols,
+                                 _x, _y, _bs[0], num_vectors, false);
+    return;
   }
-  else
+
+  // Row ranges for each thread, balanced by number of non-zeros
+  const std::vector<std::int32_t> ranges
+      = impl::partition_rows(Arow_ptr, std::max(num_threads, 1));
+  const int num_parts = ranges.size() - 1;
+
+  // Compute y[r] += A[r, c] x[c] for the rows r of each thread, with
+  // the columns c for each row in [c0[r], c1[r])
+  auto spmm = [&](std::span<const std::int64_t> c0,
+                  std::span<const std::int64_t> c1)
   {
-    impl::spmv<Scalar, -1>(Avalues, Aoff_diag_offset, Arow_end, Acols, _x, _y,
-                           _bs[0], _bs[1]);
-  }
+    common::run_threads(
+        num_parts,
+        [&](int i)
+        {
+          const std::int32_t r0 = ranges[i];
+          const std::int32_t n = ranges[i + 1] - r0;
+          impl::spmm<Scalar>(Avalues, c0.subspan(r0, n), c1.subspan(r0, n),
+                             Acols, _x, _y.subspan(r0 * _bs[0] * num_vectors),
+                             _bs[0], _bs[1], num_vectors);
+        });
+  };
+
+  // First stage:  spmm - diagonal
+  spmm(Arow_begin, Aoff_diag_offset);
+
+  // finalize ghost update
+  x.scatter_fwd_end();
+
+  // Second stage:  spmm - off-diagonal
+  spmm(Aoff_diag_offset, Arow_end);
 }
 
 } // namespace dolfinx::la
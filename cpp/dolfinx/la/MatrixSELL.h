@@ -0,0 +1,251 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "MatrixCSR.h"
+#include "Vector.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/threads.h>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Distributed sparse matrix in sliced ELLPACK format with
+/// local row sorting (SELL-C-sigma).
+///
+/// The owned rows of the matrix are sorted by decreasing length within
+/// windows of `sigma` rows, and the sorted rows are grouped into slices
+/// of `C` rows. The entries of a slice are stored column-major, i.e.
+/// the `k`th entry of each of the `C` rows is stored contiguously, and
+/// rows shorter than the longest row in the slice are padded with
+/// zeros. This layout allows the matrix-vector product to be
+/// vectorised across the rows of a slice.
+///
+/// The matrix is created from a la::MatrixCSR and uses the same row
+/// and column index maps. Only the owned rows are stored, so the
+/// matrix supports operator application (mult()) but not assembly.
+/// Entries in the owned and ghost columns are stored separately so
+/// that the forward scatter of the input vector can be overlapped with
+/// computation.
+///
+/// @tparam Scalar Scalar type of matrix entries.
+/// @tparam C Slice height (number of rows in a slice).
+template <class Scalar, int C = 8>
+class MatrixSELL
+{
+  static_assert(C > 0);
+
+public:
+  /// Scalar type
+  using value_type = Scalar;
+
+  /// @brief Create a SELL-C-sigma matrix from a CSR matrix.
+  ///
+  /// @note Ghost rows of `A` are not copied. The reverse scatter
+  /// (MatrixCSR::scatter_rev) must be performed on `A` before
+  /// creating the matrix.
+  ///
+  /// @param[in] A Matrix to copy. The block size must be (1, 1).
+  /// @param[in] sigma Size of the windows within which rows are sorted
+  /// by length. It is rounded up to a multiple of `C`.
+  template <class V, class W, class X>
+  explicit MatrixSELL(const MatrixCSR<Scalar, V, W, X>& A, int sigma = 256)
+      : _index_maps({A.index_map(0), A.index_map(1)})
+  {
+    if (A.block_size() != std::array{1, 1})
+      throw std::runtime_error("MatrixSELL requires a block size of 1.");
+    if (sigma < 1)
+      throw std::runtime_error("Sorting window size must be positive.");
+    sigma = C * ((sigma + C - 1) / C);
+
+    const std::int32_t num_rows = A.num_owned_rows();
+    std::span row_ptr = A.row_ptr();
+    std::span off_diag = A.off_diag_offset();
+
+    // Sort rows by decreasing length within each window
+    _perm.resize(num_rows);
+    std::iota(_perm.begin(), _perm.end(), 0);
+    for (std::int32_t r0 = 0; r0 < num_rows; r0 += sigma)
+    {
+      auto it0 = std::next(_perm.begin(), r0);
+      auto it1 = std::next(_perm.begin(), std::min(r0 + sigma, num_rows));
+      std::stable_sort(it0, it1,
+                       [&](auto r, auto s)
+                       {
+                         return row_ptr[r + 1] - row_ptr[r]
+                                > row_ptr[s + 1] - row_ptr[s];
+                       });
+    }
+
+    std::span<const std::int64_t> row_begin(row_ptr.data(), num_rows);
+    std::span<const std::int64_t> row_end(row_ptr.data() + 1, num_rows);
+    std::span<const std::int64_t> row_off(off_diag.data(), num_rows);
+    _slices[0] = create_slices(row_begin, row_off, A.cols());
+    _slices[1] = create_slices(row_off, row_end, A.cols());
+    set_values(A);
+  }
+
+  /// @brief Copy the values of a CSR matrix into this matrix.
+  ///
+  /// This is used to update the matrix after re-assembly of `A`,
+  /// without re-computing the matrix layout.
+  ///
+  /// @param[in] A Matrix to copy values from. It must have the same
+  /// sparsity pattern as the matrix that this matrix was created from.
+  template <class V, class W, class X>
+  void set_values(const MatrixCSR<Scalar, V, W, X>& A)
+  {
+    std::span data = A.values();
+    for (auto& s : _slices)
+    {
+      for (std::size_t i = 0; i < s.pos.size(); ++i)
+        s.values[i] = s.pos[i] < 0 ? Scalar(0) : data[s.pos[i]];
+    }
+  }
+
+  /// @brief Compute the product `y += Ax`.
+  ///
+  /// The vectors `x` and `y` must have parallel layouts that are
+  /// compatible with `A`.
+  ///
+  /// @param[in] x Vector to be apply `A` to.
+  /// @param[in,out] y Vector to accumulate the result into.
+  /// @param[in] num_threads Number of threads to use.
+  void mult(Vector<value_type>& x, Vector<value_type>& y,
+            int num_threads = 1) const
+  {
+    x.scatter_fwd_begin();
+    spmv(_slices[0], x.array(), y.mutable_array(), num_threads);
+    x.scatter_fwd_end();
+    spmv(_slices[1], x.array(), y.mutable_array(), num_threads);
+  }
+
+  /// @brief Index maps for the row and column space.
+  /// @param[in] dim Row (0) or column (1) index map.
+  /// @return Row (0) or column (1) index maps.
+  std::shared_ptr<const common::IndexMap> index_map(int dim) const
+  {
+    return _index_maps.at(dim);
+  }
+
+  /// Number of local rows excluding ghost rows
+  std::int32_t num_owned_rows() const { return _perm.size(); }
+
+  /// @brief Original (CSR) row index of each sorted row.
+  std::span<const std::int32_t> row_permutation() const { return _perm; }
+
+private:
+  // Entries of a matrix part (owned or ghost columns) in SELL layout
+  struct slices_t
+  {
+    // Start of each slice in cols/values
+    std::vector<std::int64_t> slice_ptr;
+
+    // Column indices and values. Padding entries have value zero.
+    std::vector<std::int32_t> cols;
+    std::vector<Scalar> values;
+
+    // Position in the CSR data of each entry (-1 for padding)
+    std::vector<std::int64_t> pos;
+  };
+
+  // Create the SELL layout for the CSR entries [row_begin[r],
+  // row_end[r]) of each row r
+  slices_t create_slices(std::span<const std::int64_t> row_begin,
+                         std::span<const std::int64_t> row_end,
+                         std::span<const std::int32_t> csr_cols) const
+  {
+    const std::size_t num_rows = _perm.size();
+    const std::size_t num_slices = (num_rows + C - 1) / C;
+
+    slices_t s;
+    s.slice_ptr.resize(num_slices + 1, 0);
+    for (std::size_t i = 0; i < num_slices; ++i)
+    {
+      std::int64_t width = 0;
+      for (std::size_t j = i * C; j < std::min((i + 1) * C, num_rows); ++j)
+        width = std::max(width, row_end[_perm[j]] - row_begin[_perm[j]]);
+      s.slice_ptr[i + 1] = s.slice_ptr[i] + C * width;
+    }
+
+    s.cols.resize(s.slice_ptr.back(), 0);
+    s.values.resize(s.slice_ptr.back(), 0);
+    s.pos.resize(s.slice_ptr.back(), -1);
+    for (std::size_t i = 0; i < num_slices; ++i)
+    {
+      const std::int64_t width = (s.slice_ptr[i + 1] - s.slice_ptr[i]) / C;
+      for (std::size_t j = i * C; j < std::min((i + 1) * C, num_rows); ++j)
+      {
+        std::int32_t r = _perm[j];
+        const std::int64_t n = row_end[r] - row_begin[r];
+        for (std::int64_t k = 0; k < width; ++k)
+        {
+          // Padding entries use a column index of the row (or zero for
+          // an empty row) so that the access to x is valid
+          const std::int64_t p = s.slice_ptr[i] + k * C + (j - i * C);
+          if (k < n)
+          {
+            s.pos[p] = row_begin[r] + k;
+            s.cols[p] = csr_cols[row_begin[r] + k];
+          }
+          else if (n > 0)
+            s.cols[p] = csr_cols[row_begin[r] + n - 1];
+        }
+      }
+    }
+
+    return s;
+  }
+
+  // Compute y += A x for a matrix part
+  void spmv(const slices_t& s, std::span<const Scalar> x, std::span<Scalar> y,
+            int num_threads) const
+  {
+    const std::size_t num_rows = _perm.size();
+    const std::size_t num_slices = s.slice_ptr.size() - 1;
+    common::parallel_for(
+        num_slices, num_threads,
+        [&](std::size_t s0, std::size_t s1)
+        {
+          for (std::size_t i = s0; i < s1; ++i)
+          {
+            std::array<Scalar, C> yi{};
+            for (std::int64_t p = s.slice_ptr[i]; p < s.slice_ptr[i + 1];
+                 p += C)
+            {
+              for (int l = 0; l < C; ++l)
+                yi[l] += s.values[p + l] * x[s.cols[p + l]];
+            }
+
+            for (std::size_t j = i * C; j < std::min((i + 1) * C, num_rows);
+                 ++j)
+            {
+              y[_perm[j]] += yi[j - i * C];
+            }
+          }
+        });
+  }
+
+  // Maps for the distribution of the rows and columns
+  std::array<std::shared_ptr<const common::IndexMap>, 2> _index_maps;
+
+  // Original row index of each sorted row
+  std::vector<std::int32_t> _perm;
+
+  // Entries in the owned (0) and ghost (1) columns
+  std::array<slices_t, 2> _slices;
+};
+} // namespace dolfinx::la
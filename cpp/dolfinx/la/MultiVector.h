@@ -0,0 +1,228 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Scatterer.h>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Distributed set of vectors with the same parallel layout
+/// (multi-vector).
+///
+/// The vectors (columns) are stored interleaved, i.e. row-major, with
+/// entry `j` of each vector for local index `i` (the `bs * i + k`th
+/// entry for component `k` of block `i`) stored contiguously at
+/// `num_vectors * i + j`. The ghost entries of all vectors are
+/// communicated in a single scatter, and operations such as a
+/// matrix-multivector product process all vectors with one pass over
+/// the matrix.
+///
+/// @tparam T Scalar type
+/// @tparam Container data container type
+template <typename T, typename Container = std::vector<T>>
+class MultiVector
+{
+  static_assert(std::is_same_v<typename Container::value_type, T>);
+
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// Container type
+  using container_type = Container;
+
+  /// Scatterer type, with the indices stored using the allocator of
+  /// the container type
+  using scatterer_type = common::Scatterer<
+      typename std::allocator_traits<typename container_type::allocator_type>::
+          template rebind_alloc<std::int32_t>>;
+
+  /// @brief Create a distributed multi-vector.
+  /// @param map IndexMap for parallel distribution of the data
+  /// @param bs Block size
+  /// @param num_vectors Number of vectors (columns)
+  MultiVector(std::shared_ptr<const common::IndexMap> map, int bs,
+              int num_vectors)
+      : _map(map), _scatterer(std::make_shared<scatterer_type>(
+                       *_map, bs * num_vectors)),
+        _bs(bs), _num_vectors(num_vectors),
+        _buffer_local(_scatterer->local_buffer_size()),
+        _buffer_remote(_scatterer->remote_buffer_size()),
+        _x(bs * num_vectors * (map->size_local() + map->num_ghosts()))
+  {
+    if (num_vectors < 1)
+      throw std::runtime_error("Number of vectors must be positive.");
+  }
+
+  /// Copy constructor
+  MultiVector(const MultiVector& x)
+      : _map(x._map), _scatterer(x._scatterer), _bs(x._bs),
+        _num_vectors(x._num_vectors), _request(1, MPI_REQUEST_NULL),
+        _buffer_local(x._buffer_local), _buffer_remote(x._buffer_remote),
+        _x(x._x)
+  {
+  }
+
+  /// Move constructor
+  MultiVector(MultiVector&& x)
+      : _map(std::move(x._map)), _scatterer(std::move(x._scatterer)),
+        _bs(std::move(x._bs)), _num_vectors(std::move(x._num_vectors)),
+        _request(std::exchange(x._request, {MPI_REQUEST_NULL})),
+        _buffer_local(std::move(x._buffer_local)),
+        _buffer_remote(std::move(x._buffer_remote)), _x(std::move(x._x))
+  {
+  }
+
+  // Assignment operator (disabled)
+  MultiVector& operator=(const MultiVector& x) = delete;
+
+  /// Move Assignment operator
+  MultiVector& operator=(MultiVector&& x) = default;
+
+  /// Set all entries (including ghosts)
+  /// @param[in] v The value to set all entries to (on calling rank)
+  void set(value_type v) { std::ranges::fill(_x, v); }
+
+  /// Begin scatter of local data from owner to ghosts on other ranks
+  /// @note Collective MPI operation
+  void scatter_fwd_begin()
+  {
+    std::span<const value_type> x_local(_x.data(), local_size());
+    std::span<const std::int32_t> idx = _scatterer->local_indices();
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      _buffer_local[i] = x_local[idx[i]];
+
+    _scatterer->scatter_fwd_begin(std::span<const value_type>(_buffer_local),
+                                  std::span<value_type>(_buffer_remote),
+                                  std::span<MPI_Request>(_request));
+  }
+
+  /// End scatter of local data from owner to ghosts on other ranks
+  /// @note Collective MPI operation
+  void scatter_fwd_end()
+  {
+    std::span<value_type> x_remote(_x.data() + local_size(),
+                                   _x.size() - local_size());
+    _scatterer->scatter_fwd_end(std::span<MPI_Request>(_request));
+
+    std::span<const std::int32_t> idx = _scatterer->remote_indices();
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      x_remote[idx[i]] = _buffer_remote[i];
+  }
+
+  /// Scatter local data to ghost positions on other ranks
+  /// @note Collective MPI operation
+  void scatter_fwd()
+  {
+    this->scatter_fwd_begin();
+    this->scatter_fwd_end();
+  }
+
+  /// Start scatter of ghost data to owner
+  /// @note Collective MPI operation
+  void scatter_rev_begin()
+  {
+    std::span<const value_type> x_remote(_x.data() + local_size(),
+                                         _x.size() - local_size());
+    std::span<const std::int32_t> idx = _scatterer->remote_indices();
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      _buffer_remote[i] = x_remote[idx[i]];
+
+    _scatterer->scatter_rev_begin(std::span<const value_type>(_buffer_remote),
+                                  std::span<value_type>(_buffer_local),
+                                  _request);
+  }
+
+  /// End scatter of ghost data to owner. This process may receive data
+  /// from more than one process, and the received data can be summed or
+  /// inserted into the local portion of the multi-vector.
+  /// @param op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev_end(BinaryOperation op)
+  {
+    std::span<value_type> x_local(_x.data(), local_size());
+    _scatterer->scatter_rev_end(_request);
+
+    std::span<const std::int32_t> idx = _scatterer->local_indices();
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      x_local[idx[i]] = op(x_local[idx[i]], _buffer_local[i]);
+  }
+
+  /// Scatter ghost data to owner. This process may receive data from
+  /// more than one process, and the received data can be summed or
+  /// inserted into the local portion of the multi-vector.
+  /// @param op IndexMap operation (add or insert)
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev(BinaryOperation op)
+  {
+    this->scatter_rev_begin();
+    this->scatter_rev_end(op);
+  }
+
+  /// Get IndexMap
+  std::shared_ptr<const common::IndexMap> index_map() const { return _map; }
+
+  /// Get block size
+  constexpr int bs() const { return _bs; }
+
+  /// Get number of vectors (columns)
+  constexpr int num_vectors() const { return _num_vectors; }
+
+  /// @brief Get local part of the multi-vector (const version).
+  ///
+  /// Entry `j` of each vector for local index `i` is at
+  /// `num_vectors() * i + j`.
+  std::span<const value_type> array() const
+  {
+    return std::span<const value_type>(_x);
+  }
+
+  /// @brief Get local part of the multi-vector.
+  ///
+  /// Entry `j` of each vector for local index `i` is at
+  /// `num_vectors() * i + j`.
+  std::span<value_type> mutable_array() { return std::span(_x); }
+
+private:
+  // Number of owned entries (all vectors)
+  std::size_t local_size() const
+  {
+    return _bs * _num_vectors * _map->size_local();
+  }
+
+  // Map describing the data layout
+  std::shared_ptr<const common::IndexMap> _map;
+
+  // Scatter for managing MPI communication, with block size
+  // bs * num_vectors
+  std::shared_ptr<const scatterer_type> _scatterer;
+
+  // Block size and number of vectors
+  int _bs, _num_vectors;
+
+  // MPI request handle
+  std::vector<MPI_Request> _request = {MPI_REQUEST_NULL};
+
+  // Buffers for ghost scatters
+  container_type _buffer_local, _buffer_remote;
+
+  // Multi-vector data
+  container_type _x;
+};
+} // namespace dolfinx::la
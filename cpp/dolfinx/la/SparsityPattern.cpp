@@ -11,6 +11,8 @@
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <map>
+#include <numeric>
+#include <span>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
@@ -99,40 +101,43 @@ SparsityPattern::SparsityPattern(
       const int bs_dof0 = bs[0][row];
       const int bs_dof1 = bs[1][col];
 
-      // Iterate over owned rows cache
-      for (std::int32_t i = 0; i < num_rows_local; ++i)
+      // Insert entry (i, c_old) of the block, where i < num_rows_local
+      // are owned and other rows unowned
+      auto insert_entry = [&](std::int32_t i, std::int32_t c_old)
       {
-        for (std::int32_t c_old : p->_row_cache[i])
+        const std::int32_t r_new
+            = (i < num_rows_local)
+                  ? bs_dof0 * i + local_offset0[row]
+                  : num_rows_local_new + bs_dof0 * (i - num_rows_local)
+                        + ghost_offsets0[row];
+        const std::int32_t c_new = (c_old < num_cols_local)
+                                       ? bs_dof1 * c_old + local_offset1[col]
+                                       : bs_dof1 * (c_old - num_cols_local)
+                                             + local_offset1.back()
+                                             + ghost_offsets1[col];
+        for (int k0 = 0; k0 < bs_dof0; ++k0)
         {
-          const std::int32_t r_new = bs_dof0 * i + local_offset0[row];
-          const std::int32_t c_new = (c_old < num_cols_local)
-                                         ? bs_dof1 * c_old + local_offset1[col]
-                                         : bs_dof1 * (c_old - num_cols_local)
-                                               + local_offset1.back()
-                                               + ghost_offsets1[col];
-
-          for (int k0 = 0; k0 < bs_dof0; ++k0)
-          {
-            for (int k1 = 0; k1 < bs_dof1; ++k1)
-              _row_cache[r_new + k0].push_back(c_new + k1);
-          }
+          for (int k1 = 0; k1 < bs_dof1; ++k1)
+            _row_cache[r_new + k0].push_back(c_new + k1);
         }
+      };
+
+      // Iterate over owned and unowned rows cache
+      for (std::int32_t i = 0; i < num_rows_local + num_ghost_rows_local; ++i)
+      {
+        for (std::int32_t c_old : p->_row_cache[i])
+          insert_entry(i, c_old);
       }
-      // Iterate over unowned rows cache
-      for (std::int32_t i = 0; i < num_ghost_rows_local; ++i)
+
+      // Iterate over compressed rows
+      for (const RowBlock& block : p->_row_blocks)
       {
-        for (std::int32_t c_old : p->_row_cache[i + num_rows_local])
+        for (std::size_t j = 0; j < block.rows.size(); ++j)
         {
-          const std::int32_t r_new = bs_dof0 * i + ghost_offsets0[row];
-          const std::int32_t c_new = (c_old < num_cols_local)
-                                         ? bs_dof1 * c_old + local_offset1[col]
-                                         : bs_dof1 * (c_old - num_cols_local)
-                                               + local_offset1.back()
-                                               + ghost_offsets1[col];
-          for (int k0 = 0; k0 < bs_dof0; ++k0)
+          for (std::int64_t k = block.offsets[j]; k < block.offsets[j + 1];
+               ++k)
           {
-            for (int k1 = 0; k1 < bs_dof1; ++k1)
-              _row_cache[num_rows_local_new + r_new + k0].push_back(c_new + k1);
+            insert_entry(block.rows[j], block.cols[k]);
           }
         }
       }
@@ -185,6 +190,38 @@ void SparsityPattern::insert(std::span<const std::int32_t> rows,
   }
 }
 //-----------------------------------------------------------------------------
+void SparsityPattern::insert_rows(std::vector<std::int32_t> rows,
+                                  std::vector<std::int32_t> cols,
+                                  std::vector<std::int64_t> offsets)
+{
+  if (!_offsets.empty())
+  {
+    throw std::runtime_error(
+        "Cannot insert into sparsity pattern. It has already been finalized");
+  }
+
+  if (offsets.size() != rows.size() + 1
+      or offsets.back() != (std::int64_t)cols.size())
+  {
+    throw std::runtime_error("Row offsets do not match the rows and columns.");
+  }
+
+  if (rows.empty())
+    return;
+
+  assert(_index_maps[0]);
+  const std::int32_t max_row
+      = _index_maps[0]->size_local() + _index_maps[0]->num_ghosts() - 1;
+  assert(std::ranges::is_sorted(rows));
+  if (rows.back() > max_row or rows.front() < 0)
+  {
+    throw std::runtime_error(
+        "Cannot insert rows that do not exist in the IndexMap.");
+  }
+
+  _row_blocks.push_back({std::move(rows), std::move(cols), std::move(offsets)});
+}
+//-----------------------------------------------------------------------------
 void SparsityPattern::insert_diagonal(std::span<const std::int32_t> rows)
 {
   if (!_offsets.empty())
@@ -265,16 +302,41 @@ void SparsityPattern::finalize()
   _col_ghost_owners.assign(_index_maps[1]->owners().begin(),
                            _index_maps[1]->owners().end());
 
-  // Compute size of data to send to each process
-  std::vector<int> send_sizes(src0.size(), 0);
+  // Call fn(i, col) for the unassembled entries of ghost row i
+  auto for_each_ghost_entry = [&](auto&& fn)
+  {
+    for (std::size_t i = 0; i < owners0.size(); ++i)
+    {
+      for (std::int32_t col_local : _row_cache[i + local_size0])
+        fn(i, col_local);
+    }
+
+    for (const RowBlock& block : _row_blocks)
+    {
+      auto it = std::ranges::lower_bound(block.rows, local_size0);
+      for (std::size_t j = std::distance(block.rows.begin(), it);
+           j < block.rows.size(); ++j)
+      {
+        for (std::int64_t k = block.offsets[j]; k < block.offsets[j + 1]; ++k)
+          fn(block.rows[j] - local_size0, block.cols[k]);
+      }
+    }
+  };
+
+  // Neighbourhood rank of the owner of each ghost row
+  std::vector<int> ghost_neighbour(owners0.size());
   for (std::size_t i = 0; i < owners0.size(); ++i)
   {
     auto it = std::ranges::lower_bound(src0, owners0[i]);
     assert(it != src0.end() and *it == owners0[i]);
-    const int neighbour_rank = std::distance(src0.begin(), it);
-    send_sizes[neighbour_rank] += 3 * _row_cache[i + local_size0].size();
+    ghost_neighbour[i] = std::distance(src0.begin(), it);
   }
 
+  // Compute size of data to send to each process
+  std::vector<int> send_sizes(src0.size(), 0);
+  for_each_ghost_entry([&](std::size_t i, std::int32_t)
+                       { send_sizes[ghost_neighbour[i]] += 3; });
+
   // Compute send displacements
   std::vector<int> send_disp(send_sizes.size() + 1, 0);
   std::partial_sum(send_sizes.begin(), send_sizes.end(),
@@ -285,33 +347,28 @@ void SparsityPattern::finalize()
   std::vector<int> insert_pos(send_disp);
   std::vector<std::int64_t> ghost_data(send_disp.back());
   const int rank = dolfinx::MPI::rank(_comm.comm());
-  for (std::size_t i = 0; i < owners0.size(); ++i)
-  {
-    auto it = std::ranges::lower_bound(src0, owners0[i]);
-    assert(it != src0.end() and *it == owners0[i]);
-    const int neighbour_rank = std::distance(src0.begin(), it);
-
-    for (std::int32_t col_local : _row_cache[i + local_size0])
-    {
-      // Get index in send buffer
-      const std::int32_t pos = insert_pos[neighbour_rank];
-
-      // Pack send data
-      ghost_data[pos] = ghosts0[i];
-      if (col_local < local_size1)
+  for_each_ghost_entry(
+      [&](std::size_t i, std::int32_t col_local)
       {
-        ghost_data[pos + 1] = col_local + local_range1[0];
-        ghost_data[pos + 2] = rank;
-      }
-      else
-      {
-        ghost_data[pos + 1] = _col_ghosts[col_local - local_size1];
-        ghost_data[pos + 2] = _col_ghost_owners[col_local - local_size1];
-      }
+        // Get index in send buffer
+        const int neighbour_rank = ghost_neighbour[i];
+        const std::int32_t pos = insert_pos[neighbour_rank];
 
-      insert_pos[neighbour_rank] += 3;
-    }
-  }
+        // Pack send data
+        ghost_data[pos] = ghosts0[i];
+        if (col_local < local_size1)
+        {
+          ghost_data[pos + 1] = col_local + local_range1[0];
+          ghost_data[pos + 2] = rank;
+        }
+        else
+        {
+          ghost_data[pos + 1] = _col_ghosts[col_local - local_size1];
+          ghost_data[pos + 2] = _col_ghost_owners[col_local - local_size1];
+        }
+
+        insert_pos[neighbour_rank] += 3;
+      });
 
   // Exchange data between processes
   std::vector<std::int64_t> ghost_data_in;
@@ -375,36 +432,130 @@ void SparsityPattern::finalize()
     }
   }
 
-  // Sort and remove duplicate column indices in each row
-  std::vector<std::int32_t> adj_counts(local_size0 + owners0.size(), 0);
-  _off_diagonal_offsets.resize(local_size0 + owners0.size());
-  for (std::size_t i = 0; i < local_size0 + owners0.size(); ++i)
+  // Sort and remove duplicate column indices in each row. A row that
+  // is only in one compressed block is used as is, otherwise the
+  // columns of the row are merged. The number of entries of each row is
+  // computed first to allocate the adjacency data once.
+  const std::int32_t num_rows = local_size0 + owners0.size();
+  std::vector<std::size_t> block_pos(_row_blocks.size());
+  std::vector<std::int32_t> merged;
+  auto row_columns = [&](std::int32_t i) -> std::span<const std::int32_t>
   {
-    std::vector<std::int32_t>& row = _row_cache[i];
-    std::ranges::sort(row);
-    auto it_end = std::ranges::unique(row).begin();
+    merged = _row_cache[i];
+    std::span<const std::int32_t> cols;
+    int num_sources = merged.empty() ? 0 : 1;
+    for (std::size_t b = 0; b < _row_blocks.size(); ++b)
+    {
+      const RowBlock& block = _row_blocks[b];
+      std::size_t& j = block_pos[b];
+      if (j < block.rows.size() and block.rows[j] == i)
+      {
+        cols = std::span(block.cols.data() + block.offsets[j],
+                         block.offsets[j + 1] - block.offsets[j]);
+        merged.insert(merged.end(), cols.begin(), cols.end());
+        ++num_sources;
+        ++j;
+      }
+    }
+
+    if (num_sources == 1 and !cols.empty())
+      return cols;
+    std::ranges::sort(merged);
+    auto [unique_end, range_end] = std::ranges::unique(merged);
+    merged.erase(unique_end, range_end);
+    return merged;
+  };
+
+  _offsets.resize(num_rows + 1, 0);
+  for (std::int32_t i = 0; i < num_rows; ++i)
+    _offsets[i + 1] = _offsets[i] + row_columns(i).size();
+
+  std::ranges::fill(block_pos, 0);
+  _edges.resize(_offsets.back());
+  _off_diagonal_offsets.resize(num_rows);
+  for (std::int32_t i = 0; i < num_rows; ++i)
+  {
+    std::span<const std::int32_t> row = row_columns(i);
+    std::ranges::copy(row, std::next(_edges.begin(), _offsets[i]));
 
     // Find position of first "off-diagonal" column
     _off_diagonal_offsets[i] = std::distance(
-        row.begin(), std::lower_bound(row.begin(), it_end, local_size1));
-
-    _edges.insert(_edges.end(), row.begin(), it_end);
-    adj_counts[i] += std::distance(row.begin(), it_end);
+        row.begin(), std::ranges::lower_bound(row, local_size1));
   }
-  // Clear cache
-  std::vector<std::vector<std::int32_t>>().swap(_row_cache);
 
-  // Compute offsets for adjacency list
-  _offsets.resize(local_size0 + owners0.size() + 1, 0);
-  std::partial_sum(adj_counts.begin(), adj_counts.end(), _offsets.begin() + 1);
-
-  _edges.shrink_to_fit();
+  // Clear caches
+  std::vector<std::vector<std::int32_t>>().swap(_row_cache);
+  std::vector<RowBlock>().swap(_row_blocks);
 
   // Column count increased due to received rows from other processes
   spdlog::info("Column ghost size increased from {} to {}",
                _index_maps[1]->ghosts().size(), _col_ghosts.size());
 }
 //-----------------------------------------------------------------------------
+void SparsityPattern::drop_lower_triangle()
+{
+  if (_offsets.empty())
+    throw std::runtime_error("Sparsity pattern has not been finalised.");
+
+  const common::IndexMap& map0 = *_index_maps[0];
+  const common::IndexMap& map1 = *_index_maps[1];
+  if (_bs[0] != _bs[1] or map0.local_range() != map1.local_range()
+      or !std::ranges::equal(map0.ghosts(), map1.ghosts()))
+  {
+    throw std::runtime_error(
+        "Symmetric storage requires the same row and column index maps.");
+  }
+
+  const int rank = dolfinx::MPI::rank(_comm.comm());
+  const std::int32_t local_size = map0.size_local();
+  const std::int64_t offset = map0.local_range()[0];
+  std::span ghosts0 = map0.ghosts();
+  std::span owners0 = map0.owners();
+
+  // Owner and global index of a row (dim 0) or column (dim 1)
+  auto owner = [&](int dim, std::int32_t i)
+  {
+    if (i < local_size)
+      return rank;
+    return dim == 0 ? owners0[i - local_size]
+                    : _col_ghost_owners[i - local_size];
+  };
+  auto global = [&](int dim, std::int32_t i)
+  {
+    if (i < local_size)
+      return offset + i;
+    return dim == 0 ? ghosts0[i - local_size] : _col_ghosts[i - local_size];
+  };
+
+  // Remove the entries in place
+  const std::int32_t num_rows = _offsets.size() - 1;
+  std::int64_t pos = 0;
+  for (std::int32_t i = 0; i < num_rows; ++i)
+  {
+    const std::int64_t row_start = pos;
+    const int owner0 = owner(0, i);
+    const std::int64_t row = global(0, i);
+    for (std::int64_t k = _offsets[i]; k < _offsets[i + 1]; ++k)
+    {
+      const std::int32_t j = _edges[k];
+      if (owner(1, j) != owner0 or global(1, j) >= row)
+        _edges[pos++] = j;
+    }
+
+    _offsets[i] = row_start;
+    _off_diagonal_offsets[i] = std::distance(
+        std::next(_edges.begin(), row_start),
+        std::lower_bound(std::next(_edges.begin(), row_start),
+                         std::next(_edges.begin(), pos), local_size));
+  }
+  _offsets[num_rows] = pos;
+  _edges.resize(pos);
+  _edges.shrink_to_fit();
+  _symmetric = true;
+}
+//-----------------------------------------------------------------------------
+bool SparsityPattern::symmetric() const { return _symmetric; }
+//-----------------------------------------------------------------------------
 std::int64_t SparsityPattern::num_nonzeros() const
 {
   if (_offsets.empty())
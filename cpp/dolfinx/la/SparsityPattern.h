@@ -83,6 +83,25 @@ public:
   void insert(std::span<const std::int32_t> rows,
               std::span<const std::int32_t> cols);
 
+  /// @brief Insert rows of non-zero locations in compressed form,
+  /// using local (process-wise) indices.
+  ///
+  /// The columns of row `rows[i]` are `cols[offsets[i]], ...,
+  /// cols[offsets[i + 1] - 1]`. The arrays are stored (not copied into
+  /// per-row storage) until the pattern is finalised, so building the
+  /// pattern from compressed rows needs much less memory than
+  /// SparsityPattern::insert for the same entries.
+  ///
+  /// @param[in] rows Local row indices. The indices must be sorted and
+  /// unique.
+  /// @param[in] cols Local column indices of the rows. The columns of
+  /// each row must be sorted and unique.
+  /// @param[in] offsets Offsets into `cols` of each row, with size
+  /// `rows.size() + 1`.
+  void insert_rows(std::vector<std::int32_t> rows,
+                   std::vector<std::int32_t> cols,
+                   std::vector<std::int64_t> offsets);
+
   /// @brief Insert non-zero locations on the diagonal
   /// @param[in] rows Rows in local (process-wise) indices. The indices
   /// must exist in the row IndexMap.
@@ -92,6 +111,24 @@ public:
   /// entries
   void finalize();
 
+  /// @brief Remove the entries below the diagonal of the owned blocks,
+  /// for the symmetric storage of a symmetric matrix.
+  ///
+  /// An entry `(i, j)` is removed if the row and the column are owned
+  /// by the same process and the global block indices satisfy `j < i`.
+  /// Entries in the diagonal blocks, and entries with row and column
+  /// owned by different processes, are kept, so that a symmetric
+  /// matrix-vector product needs only the forward scatter of the
+  /// vector (see MatrixCSR::mult).
+  ///
+  /// @pre The pattern has been finalised and the row and column index
+  /// maps and block sizes are the same.
+  void drop_lower_triangle();
+
+  /// @brief Whether the entries below the diagonal have been removed
+  /// (see drop_lower_triangle()).
+  bool symmetric() const;
+
   /// @brief Index map for given dimension dimension. Returns the index
   /// map for rows and columns that will be set by the current MPI rank.
   /// @param[in] dim Requested map, row (0) or column (1).
@@ -167,6 +204,15 @@ private:
   // Cache for unassembled entries on owned and unowned (ghost) rows
   std::vector<std::vector<std::int32_t>> _row_cache;
 
+  // Unassembled rows in compressed form (see insert_rows)
+  struct RowBlock
+  {
+    std::vector<std::int32_t> rows;
+    std::vector<std::int32_t> cols;
+    std::vector<std::int64_t> offsets;
+  };
+  std::vector<RowBlock> _row_blocks;
+
   // Sparsity pattern adjacency data (computed once pattern is
   // finalised). _edges holds the edges (connected dofs). The edges for
   // node i are in the range [_offsets[i], _offsets[i + 1]).
@@ -175,5 +221,8 @@ private:
 
   // Start of off-diagonal (unowned columns) on each row (row-wise)
   std::vector<std::int32_t> _off_diagonal_offsets;
+
+  // True if only the upper triangle of the owned blocks is stored
+  bool _symmetric = false;
 };
 } // namespace dolfinx::la
@@ -6,17 +6,27 @@
 
 #pragma once
 
+#include "backend.h"
 #include "utils.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <complex>
+#include <concepts>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/Trace.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/common/types.h>
+#include <dolfinx/common/utils.h>
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <ranges>
 #include <span>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -25,9 +35,22 @@ namespace dolfinx::la
 
 /// Distributed vector
 ///
+/// Operations on the vector data, e.g. setting entries and packing and
+/// unpacking of ghost data, are performed through la::backend for the
+/// container type, which allows containers in device memory.
+///
+/// The send and receive buffers for ghost scatters are allocated when
+/// the vector is created and are re-used by all scatters. They are
+/// stored in containers of type `BufferContainer`, which can differ
+/// from the data container type, e.g. page-locked host memory (see
+/// common::PinnedAllocator) for staging device data that is
+/// communicated by an MPI implementation that is not device-aware.
+///
 /// @tparam T Scalar type
 /// @tparam Container data container type
-template <typename T, typename Container = std::vector<T>>
+/// @tparam BufferContainer scatter buffer container type
+template <typename T, typename Container = std::vector<T>,
+          typename BufferContainer = Container>
 class Vector
 {
   static_assert(std::is_same_v<typename Container::value_type, T>);
@@ -39,14 +62,29 @@ public:
   /// Container type
   using container_type = Container;
 
+  /// Scatter buffer container type
+  using buffer_container_type = BufferContainer;
+
+  /// Backend for operations on the data
+  using backend_type = backend<Container>;
+
+  /// Scatterer type, with the indices stored using the allocator of
+  /// the container type
+  using scatterer_type = common::Scatterer<
+      typename std::allocator_traits<typename container_type::allocator_type>::
+          template rebind_alloc<std::int32_t>>;
+
   static_assert(std::is_same_v<value_type, typename container_type::value_type>,
                 "Scalar type and container value type must be the same.");
+  static_assert(
+      std::is_same_v<value_type, typename buffer_container_type::value_type>,
+      "Scalar type and buffer container value type must be the same.");
 
   /// Create a distributed vector
   /// @param map IndexMap for parallel distribution of the data
   /// @param bs Block size
   Vector(std::shared_ptr<const common::IndexMap> map, int bs)
-      : _map(map), _scatterer(std::make_shared<common::Scatterer<>>(*_map, bs)),
+      : _map(map), _scatterer(std::make_shared<scatterer_type>(*_map, bs)),
         _bs(bs), _buffer_local(_scatterer->local_buffer_size()),
         _buffer_remote(_scatterer->remote_buffer_size()),
         _x(bs * (map->size_local() + map->num_ghosts()))
@@ -57,7 +95,8 @@ public:
   Vector(const Vector& x)
       : _map(x._map), _scatterer(x._scatterer), _bs(x._bs),
         _request(1, MPI_REQUEST_NULL), _buffer_local(x._buffer_local),
-        _buffer_remote(x._buffer_remote), _x(x._x)
+        _buffer_remote(x._buffer_remote), _x(x._x),
+        _state(common::next_state())
   {
   }
 
@@ -67,7 +106,8 @@ public:
         _bs(std::move(x._bs)),
         _request(std::exchange(x._request, {MPI_REQUEST_NULL})),
         _buffer_local(std::move(x._buffer_local)),
-        _buffer_remote(std::move(x._buffer_remote)), _x(std::move(x._x))
+        _buffer_remote(std::move(x._buffer_remote)), _x(std::move(x._x)),
+        _state(x._state)
   {
   }
 
@@ -79,21 +119,24 @@ public:
 
   /// Set all entries (including ghosts)
   /// @param[in] v The value to set all entries to (on calling rank)
-  void set(value_type v) { std::ranges::fill(_x, v); }
+  void set(value_type v)
+  {
+    backend_type::fill(std::span<value_type>(_x), v);
+    _state = common::next_state();
+  }
 
   /// Begin scatter of local data from owner to ghosts on other ranks
   /// @note Collective MPI operation
   void scatter_fwd_begin()
   {
+    static const std::uint32_t trace_region
+        = common::trace::region("Vector::scatter_fwd_begin");
+    common::TraceRegion trace(trace_region);
+
     const std::int32_t local_size = _bs * _map->size_local();
     std::span<const value_type> x_local(_x.data(), local_size);
-
-    auto pack = [](auto&& in, auto&& idx, auto&& out)
-    {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
-    };
-    pack(x_local, _scatterer->local_indices(), _buffer_local);
+    backend_type::pack(x_local, _scatterer->local_indices(),
+                       std::span<value_type>(_buffer_local));
 
     _scatterer->scatter_fwd_begin(std::span<const value_type>(_buffer_local),
                                   std::span<value_type>(_buffer_remote),
@@ -104,19 +147,18 @@ public:
   /// @note Collective MPI operation
   void scatter_fwd_end()
   {
+    static const std::uint32_t trace_region
+        = common::trace::region("Vector::scatter_fwd_end");
+    common::TraceRegion trace(trace_region);
+
     const std::int32_t local_size = _bs * _map->size_local();
     const std::int32_t num_ghosts = _bs * _map->num_ghosts();
     std::span<value_type> x_remote(_x.data() + local_size, num_ghosts);
     _scatterer->scatter_fwd_end(std::span<MPI_Request>(_request));
-
-    auto unpack = [](auto&& in, auto&& idx, auto&& out, auto op)
-    {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
-    };
-
-    unpack(_buffer_remote, _scatterer->remote_indices(), x_remote,
-           [](auto /*a*/, auto b) { return b; });
+    backend_type::unpack(std::span<const value_type>(_buffer_remote),
+                         _scatterer->remote_indices(), x_remote,
+                         [](auto /*a*/, auto b) { return b; });
+    _state = common::next_state();
   }
 
   /// Scatter local data to ghost positions on other ranks
@@ -131,16 +173,15 @@ public:
   /// @note Collective MPI operation
   void scatter_rev_begin()
   {
+    static const std::uint32_t trace_region
+        = common::trace::region("Vector::scatter_rev_begin");
+    common::TraceRegion trace(trace_region);
+
     const std::int32_t local_size = _bs * _map->size_local();
     const std::int32_t num_ghosts = _bs * _map->num_ghosts();
-    std::span<value_type> x_remote(_x.data() + local_size, num_ghosts);
-
-    auto pack = [](auto&& in, auto&& idx, auto&& out)
-    {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
-    };
-    pack(x_remote, _scatterer->remote_indices(), _buffer_remote);
+    std::span<const value_type> x_remote(_x.data() + local_size, num_ghosts);
+    backend_type::pack(x_remote, _scatterer->remote_indices(),
+                       std::span<value_type>(_buffer_remote));
 
     _scatterer->scatter_rev_begin(std::span<const value_type>(_buffer_remote),
                                   std::span<value_type>(_buffer_local),
@@ -156,16 +197,16 @@ public:
   template <class BinaryOperation>
   void scatter_rev_end(BinaryOperation op)
   {
+    static const std::uint32_t trace_region
+        = common::trace::region("Vector::scatter_rev_end");
+    common::TraceRegion trace(trace_region);
+
     const std::int32_t local_size = _bs * _map->size_local();
     std::span<value_type> x_local(_x.data(), local_size);
     _scatterer->scatter_rev_end(_request);
-
-    auto unpack = [](auto&& in, auto&& idx, auto&& out, auto op)
-    {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
-    };
-    unpack(_buffer_local, _scatterer->local_indices(), x_local, op);
+    backend_type::unpack(std::span<const value_type>(_buffer_local),
+                         _scatterer->local_indices(), x_local, op);
+    _state = common::next_state();
   }
 
   /// Scatter ghost data to owner. This process may receive data from
@@ -192,15 +233,49 @@ public:
     return std::span<const value_type>(_x);
   }
 
-  /// Get local part of the vector
-  std::span<value_type> mutable_array() { return std::span(_x); }
+  /// @brief Get local part of the vector.
+  ///
+  /// The state of the vector is changed, see state().
+  std::span<value_type> mutable_array()
+  {
+    _state = common::next_state();
+    return std::span(_x);
+  }
+
+  /// @brief State of the vector data.
+  ///
+  /// The state increases whenever the data may have been modified, i.e.
+  /// when mutable_array() is called or by operations that modify the
+  /// data, such as scatters. States are unique across all objects (see
+  /// common::next_state), so that an unchanged `(vector, state)` pair
+  /// identifies unchanged data, e.g. to skip repacking of coefficients.
+  ///
+  /// @note Data that is modified through a span returned by an earlier
+  /// call to mutable_array() is not detected. Call mutable_array()
+  /// again before modifying the data.
+  std::uint64_t state() const { return _state; }
+
+  /// @brief Memory used by the vector.
+  /// @note The scatterer, which may be shared by vectors with the same
+  /// layout, is included. The index map is not included.
+  /// @return Number of bytes of the data, the scatter buffers and the
+  /// scatterer.
+  std::size_t memory_usage() const
+  {
+    std::size_t bytes
+        = sizeof(value_type)
+          * (_x.size() + _buffer_local.size() + _buffer_remote.size());
+    if (_scatterer)
+      bytes += _scatterer->memory_usage();
+    return bytes;
+  }
 
 private:
   // Map describing the data layout
   std::shared_ptr<const common::IndexMap> _map;
 
   // Scatter for managing MPI communication
-  std::shared_ptr<const common::Scatterer<>> _scatterer;
+  std::shared_ptr<const scatterer_type> _scatterer;
 
   // Block size
   int _bs;
@@ -209,10 +284,13 @@ private:
   std::vector<MPI_Request> _request = {MPI_REQUEST_NULL};
 
   // Buffers for ghost scatters
-  container_type _buffer_local, _buffer_remote;
+  buffer_container_type _buffer_local, _buffer_remote;
 
   // Vector data
   container_type _x;
+
+  // State of the data, see state()
+  std::uint64_t _state = common::next_state();
 };
 
 /// Compute the inner product of two vectors. The two vectors must have
@@ -230,24 +308,305 @@ auto inner_product(const V& a, const V& b)
     throw std::runtime_error("Incompatible vector sizes");
   std::span<const T> x_a = a.array().subspan(0, local_size);
   std::span<const T> x_b = b.array().subspan(0, local_size);
+  const T local = V::backend_type::dot(x_a, x_b);
+
+  T result;
+  MPI_Allreduce(&local, &result, 1, dolfinx::MPI::mpi_t<T>, MPI_SUM,
+                a.index_map()->comm());
+  return result;
+}
 
-  const T local = std::transform_reduce(
-      x_a.begin(), x_a.end(), x_b.begin(), static_cast<T>(0), std::plus{},
-      [](T a, T b) -> T
+/// @brief Start the computation of the inner product of two vectors,
+/// with a non-blocking reduction.
+///
+/// The local inner product is computed and the sum over processes is
+/// started, so that the latency of the reduction can be overlapped
+/// with other work (see inner_product()).
+///
+/// @note Collective MPI operation
+/// @param a A vector
+/// @param b A vector
+/// @return Handle for the reduction, with value `a^{H} b` on
+/// completion.
+template <class V>
+MPI::Reduction<typename V::value_type> inner_product_begin(const V& a,
+                                                           const V& b)
+{
+  const std::int32_t local_size = a.bs() * a.index_map()->size_local();
+  if (local_size != b.bs() * b.index_map()->size_local())
+    throw std::runtime_error("Incompatible vector sizes");
+  return MPI::iallreduce(
+      V::backend_type::dot(a.array().subspan(0, local_size),
+                           b.array().subspan(0, local_size)),
+      MPI_SUM, a.index_map()->comm());
+}
+
+/// @brief Start the computation of the squared L2 norm of a vector,
+/// with a non-blocking reduction (see inner_product_begin()).
+///
+/// @note Collective MPI operation
+/// @param x A vector
+/// @return Handle for the reduction, with the squared norm of `x` on
+/// completion.
+template <class V>
+MPI::Reduction<dolfinx::scalar_value_t<typename V::value_type>>
+squared_norm_begin(const V& x)
+{
+  using U = typename dolfinx::scalar_value_t<typename V::value_type>;
+  const std::int32_t local_size = x.bs() * x.index_map()->size_local();
+  std::span data = x.array().subspan(0, local_size);
+  U local = std::accumulate(data.begin(), data.end(), U(0),
+                            [](U s, auto x) { return s + std::norm(x); });
+  return MPI::iallreduce(local, MPI_SUM, x.index_map()->comm());
+}
+
+/// @brief Compute `r_i = op(x_i, y_i, ...)` for each entry `i` of
+/// vectors with the same parallel layout.
+///
+/// This is a fused element-wise kernel: an expression in several
+/// vectors, e.g. a Runge-Kutta stage update `r = u + h (a k1 + b k2 + c
+/// k3)`, is evaluated with a single pass over the data rather than one
+/// pass per operation. The owned and ghost entries are computed, i.e.
+/// ghost values of `r` are up to date if the ghost values of the
+/// operands are.
+///
+/// @param[out] r Result. It can be the same vector as an operand.
+/// @param[in] op Element-wise operation, called with one entry of each
+/// operand and returning the entry of `r`.
+/// @param[in] x Operand vectors.
+template <class V, class Op, class... Vs>
+  requires(std::same_as<V, Vs> and ...)
+void transform(V& r, Op&& op, const Vs&... x)
+{
+  using T = typename V::value_type;
+  const std::size_t n = r.array().size();
+  if (((x.array().size() != n) or ...))
+    throw std::runtime_error("Incompatible vector sizes");
+
+  std::span<T> _r = r.mutable_array();
+  [&](const auto*... xp)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      _r[i] = op(xp[i]...);
+  }(x.array().data()...);
+}
+
+/// @brief Compute `r = alpha x + y` for vectors with the same parallel
+/// layout.
+///
+/// The owned and ghost entries are computed, i.e. ghost values of `r`
+/// are up to date if the ghost values of `x` and `y` are.
+///
+/// @param[out] r Result. It can be the same vector as `x` or `y`.
+/// @param[in] alpha Scalar.
+/// @param[in] x A vector.
+/// @param[in] y A vector.
+template <class V>
+void axpy(V& r, typename V::value_type alpha, const V& x, const V& y)
+{
+  if (x.array().size() != y.array().size()
+      or r.array().size() != x.array().size())
+  {
+    throw std::runtime_error("Incompatible vector sizes");
+  }
+  V::backend_type::axpy(r.mutable_array(), alpha, x.array(), y.array());
+}
+
+/// @brief Compute `r = alpha x + beta y` for vectors with the same
+/// parallel layout.
+///
+/// The owned and ghost entries are computed, as for axpy().
+///
+/// @param[out] r Result. It can be the same vector as `x` or `y`.
+/// @param[in] alpha Scalar.
+/// @param[in] x A vector.
+/// @param[in] beta Scalar.
+/// @param[in] y A vector.
+template <class V>
+void axpby(V& r, typename V::value_type alpha, const V& x,
+           typename V::value_type beta, const V& y)
+{
+  la::transform(
+      r, [alpha, beta](auto x, auto y) { return alpha * x + beta * y; }, x,
+      y);
+}
+
+/// @brief Compute `r = alpha x + y` and the L2 norm of `r` with a single
+/// pass over the data and one reduction.
+///
+/// The owned and ghost entries of `r` are computed, as for axpy(). The
+/// norm is computed from the owned entries.
+///
+/// @note Collective MPI operation
+/// @param[out] r Result. It can be the same vector as `x` or `y`.
+/// @param[in] alpha Scalar.
+/// @param[in] x A vector.
+/// @param[in] y A vector.
+/// @return L2 norm of `r`.
+template <class V>
+auto axpy_norm(V& r, typename V::value_type alpha, const V& x, const V& y)
+{
+  using T = typename V::value_type;
+  using U = typename dolfinx::scalar_value_t<T>;
+  if (x.array().size() != y.array().size()
+      or r.array().size() != x.array().size())
+  {
+    throw std::runtime_error("Incompatible vector sizes");
+  }
+
+  const std::size_t size_local = r.bs() * r.index_map()->size_local();
+  std::span<const T> _x = x.array(), _y = y.array();
+  std::span<T> _r = r.mutable_array();
+  U local = 0;
+  for (std::size_t i = 0; i < size_local; ++i)
+  {
+    _r[i] = alpha * _x[i] + _y[i];
+    local += std::norm(_r[i]);
+  }
+  for (std::size_t i = size_local; i < _r.size(); ++i)
+    _r[i] = alpha * _x[i] + _y[i];
+
+  U result;
+  MPI_Allreduce(&local, &result, 1, dolfinx::MPI::mpi_t<U>, MPI_SUM,
+                r.index_map()->comm());
+  return std::sqrt(result);
+}
+
+/// @brief Compute the linear combination `r = sum_i alpha_i x_i` of
+/// vectors with the same parallel layout in a single pass over the
+/// data.
+///
+/// The entries are processed in blocks, so that a block of `r` stays in
+/// cache while the terms are added. The owned and ghost entries are
+/// computed, as for axpy().
+///
+/// @param[out] r Result. It can be one of the vectors `x_i`.
+/// @param[in] alpha Coefficients `alpha_i`.
+/// @param[in] x Vectors `x_i`, with `x.size() == alpha.size()`.
+/// @param[in] num_threads Number of threads to use.
+template <std::ranges::random_access_range R, class V>
+  requires std::convertible_to<std::ranges::range_reference_t<R>, const V&>
+void linear_combination(V& r, std::span<const typename V::value_type> alpha,
+                        R&& x, int num_threads = 1)
+{
+  using T = typename V::value_type;
+  if (alpha.empty() or alpha.size() != std::ranges::size(x))
+    throw std::runtime_error("Incompatible number of terms");
+
+  std::vector<const T*> xp;
+  for (const V& xi : x)
+  {
+    if (xi.array().size() != r.array().size())
+      throw std::runtime_error("Incompatible vector sizes");
+    xp.push_back(xi.array().data());
+  }
+
+  std::span<T> _r = r.mutable_array();
+  constexpr std::size_t block_size = 512;
+  common::parallel_for(
+      _r.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        std::array<T, block_size> b;
+        for (std::size_t j0 = i0; j0 < i1; j0 += block_size)
+        {
+          const std::size_t n = std::min(block_size, i1 - j0);
+          for (std::size_t j = 0; j < n; ++j)
+            b[j] = alpha[0] * xp[0][j0 + j];
+          for (std::size_t k = 1; k < xp.size(); ++k)
+          {
+            const T a = alpha[k];
+            const T* xk = xp[k] + j0;
+            for (std::size_t j = 0; j < n; ++j)
+              b[j] += a * xk[j];
+          }
+          std::copy_n(b.begin(), n, std::next(_r.begin(), j0));
+        }
+      });
+}
+
+/// @brief Start the computation of the inner products of a set of
+/// vectors with a vector.
+///
+/// The local parts of the inner products `a_i^{H} b` are computed in a
+/// single pass over the vectors, and are summed across processes using
+/// one non-blocking reduction. The vectors must have the same parallel
+/// layout. The results are available in `result` after the returned
+/// request has been completed, e.g. using `MPI_Wait`. This allows the
+/// reduction to be overlapped with other work.
+///
+/// @note Collective MPI operation
+/// @param[in] a Vectors `a_i`.
+/// @param[in] b A vector.
+/// @param[out] result Inner products `a_i^{H} b`. It must not be
+/// accessed until the request has completed.
+/// @return MPI request handle for the reduction.
+template <std::ranges::random_access_range R, class V>
+  requires std::convertible_to<std::ranges::range_reference_t<R>, const V&>
+MPI_Request inner_products_begin(R&& a, const V& b,
+                                 std::span<typename V::value_type> result)
+{
+  using T = typename V::value_type;
+  if (result.size() != std::ranges::size(a))
+    throw std::runtime_error("Incompatible number of inner products");
+  const std::int32_t local_size = b.bs() * b.index_map()->size_local();
+  for (const V& ai : a)
+  {
+    if (local_size != ai.bs() * ai.index_map()->size_local())
+      throw std::runtime_error("Incompatible vector sizes");
+  }
+
+  // Loop over blocks of entries so that the block of b stays in cache
+  // while it is multiplied by all vectors a_i
+  constexpr std::int32_t block_size = 512;
+  std::ranges::fill(result, T(0));
+  std::span<const T> x_b = b.array();
+  for (std::int32_t i0 = 0; i0 < local_size; i0 += block_size)
+  {
+    const std::int32_t i1 = std::min(i0 + block_size, local_size);
+    for (std::size_t j = 0; j < result.size(); ++j)
+    {
+      const V& aj = std::ranges::begin(a)[j];
+      std::span<const T> x_a = aj.array();
+      T local = 0;
+      for (std::int32_t i = i0; i < i1; ++i)
       {
         if constexpr (std::is_same<T, std::complex<double>>::value
                       or std::is_same<T, std::complex<float>>::value)
         {
-          return std::conj(a) * b;
+          local += std::conj(x_a[i]) * x_b[i];
         }
         else
-          return a * b;
-      });
+          local += x_a[i] * x_b[i];
+      }
+      result[j] += local;
+    }
+  }
 
-  T result;
-  MPI_Allreduce(&local, &result, 1, dolfinx::MPI::mpi_t<T>, MPI_SUM,
-                a.index_map()->comm());
-  return result;
+  MPI_Request request;
+  MPI_Iallreduce(MPI_IN_PLACE, result.data(), result.size(),
+                 dolfinx::MPI::mpi_t<T>, MPI_SUM, b.index_map()->comm(),
+                 &request);
+  return request;
+}
+
+/// @brief Compute the inner products of a set of vectors with a
+/// vector.
+///
+/// The inner products are computed in a single pass over the vectors
+/// and with one reduction, see inner_products_begin().
+///
+/// @note Collective MPI operation
+/// @param[in] a Vectors `a_i`.
+/// @param[in] b A vector.
+/// @param[out] result Inner products `a_i^{H} b`.
+template <std::ranges::random_access_range R, class V>
+  requires std::convertible_to<std::ranges::range_reference_t<R>, const V&>
+void inner_products(R&& a, const V& b,
+                    std::span<typename V::value_type> result)
+{
+  MPI_Request request = inner_products_begin(std::forward<R>(a), b, result);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
 }
 
 /// Compute the squared L2 norm of vector
@@ -314,20 +673,29 @@ void orthonormalize(std::vector<std::reference_wrapper<V>> basis)
   using U = typename dolfinx::scalar_value_t<T>;
 
   // Loop over each vector in basis
+  std::vector<T> dots(basis.size());
   for (std::size_t i = 0; i < basis.size(); ++i)
   {
     // Orthogonalize vector i with respect to previously orthonormalized
-    // vectors
+    // vectors. Classical Gram-Schmidt is used, with the inner products
+    // computed in a single reduction, and is repeated once to recover
+    // the stability of modified Gram-Schmidt.
     V& bi = basis[i].get();
-    for (std::size_t j = 0; j < i; ++j)
+    std::span<T> dots_i(dots.data(), i);
+    auto basis_i = std::span(basis).first(i);
+    for (int pass = 0; pass < 2 and i > 0; ++pass)
     {
-      const V& bj = basis[j].get();
-
-      // basis_i <- basis_i - dot_ij  basis_j
-      auto dot_ij = inner_product(bi, bj);
-      std::ranges::transform(bj.array(), bi.array(), bi.mutable_array().begin(),
-                             [dot_ij](auto xj, auto xi)
-                             { return xi - dot_ij * xj; });
+      inner_products(basis_i, bi, dots_i);
+      for (std::size_t j = 0; j < i; ++j)
+      {
+        // basis_i <- basis_i - dot_ij  basis_j
+        const V& bj = basis[j].get();
+        auto dot_ij = dots_i[j];
+        std::ranges::transform(bj.array(), bi.array(),
+                               bi.mutable_array().begin(),
+                               [dot_ij](auto xj, auto xi)
+                               { return xi - dot_ij * xj; });
+      }
     }
 
     // Normalise basis function
@@ -0,0 +1,195 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Scatterer.h>
+#include <functional>
+#include <memory>
+#include <mpi.h>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Group of distributed vectors with the same IndexMap whose
+/// ghost entries are updated together.
+///
+/// The ghost data of all vectors in the group is packed into one
+/// message per neighbouring rank, so that the ghost update of `n`
+/// vectors costs one communication rather than `n`. The vectors may
+/// have different block sizes, e.g. a vector-valued velocity and
+/// scalar pressure and temperature on the same mesh.
+///
+/// The group holds references to the vectors, which must outlive the
+/// group.
+///
+/// @tparam V Vector type, e.g. la::Vector
+template <class V>
+class VectorGroup
+{
+public:
+  /// Scalar type
+  using value_type = typename V::value_type;
+
+  /// @brief Create a group of vectors.
+  /// @param[in] x Vectors in the group. All vectors must have the same
+  /// IndexMap.
+  explicit VectorGroup(std::vector<std::reference_wrapper<V>> x)
+      : _x(std::move(x))
+  {
+    if (_x.empty())
+      throw std::runtime_error("VectorGroup requires at least one vector.");
+
+    std::shared_ptr<const common::IndexMap> map = _x.front().get().index_map();
+    for (V& v : _x)
+    {
+      if (v.index_map() != map)
+        throw std::runtime_error("Vectors in a VectorGroup must share the "
+                                 "same IndexMap.");
+    }
+
+    // Ghost data for each index of the map is communicated as one
+    // block of size sum_k bs_k. Record the vector and offset within the
+    // vector block of each entry of the combined block.
+    for (std::size_t i = 0; i < _x.size(); ++i)
+      for (int k = 0; k < _x[i].get().bs(); ++k)
+        _component.emplace_back(i, k);
+
+    _bs = _component.size();
+    _scatterer = std::make_shared<typename V::scatterer_type>(*map, _bs);
+    _buffer_local.resize(_scatterer->local_buffer_size());
+    _buffer_remote.resize(_scatterer->remote_buffer_size());
+  }
+
+  /// @brief Number of vectors in the group.
+  std::size_t size() const { return _x.size(); }
+
+  /// @brief Begin scatter of local data of all vectors from owner to
+  /// ghosts on other ranks.
+  /// @note Collective MPI operation
+  void scatter_fwd_begin()
+  {
+    std::span<const std::int32_t> idx = _scatterer->local_indices();
+    pack(idx, _buffer_local, 0);
+    _scatterer->scatter_fwd_begin(std::span<const value_type>(_buffer_local),
+                                  std::span<value_type>(_buffer_remote),
+                                  std::span<MPI_Request>(_request));
+  }
+
+  /// @brief End scatter of local data of all vectors from owner to
+  /// ghosts on other ranks.
+  /// @note Collective MPI operation
+  void scatter_fwd_end()
+  {
+    _scatterer->scatter_fwd_end(std::span<MPI_Request>(_request));
+    const std::int32_t size_local
+        = _x.front().get().index_map()->size_local();
+    std::span<const std::int32_t> idx = _scatterer->remote_indices();
+    unpack(idx, _buffer_remote, size_local,
+           [](auto /*a*/, auto b) { return b; });
+  }
+
+  /// @brief Scatter local data of all vectors to ghost positions on
+  /// other ranks.
+  /// @note Collective MPI operation
+  void scatter_fwd()
+  {
+    this->scatter_fwd_begin();
+    this->scatter_fwd_end();
+  }
+
+  /// @brief Start scatter of ghost data of all vectors to the owner.
+  /// @note Collective MPI operation
+  void scatter_rev_begin()
+  {
+    const std::int32_t size_local
+        = _x.front().get().index_map()->size_local();
+    std::span<const std::int32_t> idx = _scatterer->remote_indices();
+    pack(idx, _buffer_remote, size_local);
+    _scatterer->scatter_rev_begin(std::span<const value_type>(_buffer_remote),
+                                  std::span<value_type>(_buffer_local),
+                                  std::span<MPI_Request>(_request));
+  }
+
+  /// @brief End scatter of ghost data of all vectors to the owner.
+  /// @param op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev_end(BinaryOperation op)
+  {
+    _scatterer->scatter_rev_end(std::span<MPI_Request>(_request));
+    std::span<const std::int32_t> idx = _scatterer->local_indices();
+    unpack(idx, _buffer_local, 0, op);
+  }
+
+  /// @brief Scatter ghost data of all vectors to the owner.
+  /// @param op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev(BinaryOperation op)
+  {
+    this->scatter_rev_begin();
+    this->scatter_rev_end(op);
+  }
+
+private:
+  // Pack the vector entries for the combined indices `idx` (relative
+  // to block `offset` of the map) into `buffer`
+  void pack(std::span<const std::int32_t> idx,
+            std::span<value_type> buffer, std::int32_t offset) const
+  {
+    for (std::size_t i = 0; i < idx.size(); ++i)
+    {
+      auto [v, k] = _component[idx[i] % _bs];
+      const V& x = _x[v].get();
+      buffer[i] = x.array()[(offset + idx[i] / _bs) * x.bs() + k];
+    }
+  }
+
+  // Unpack `buffer` into the vector entries for the combined indices
+  // `idx` (relative to block `offset` of the map)
+  template <class BinaryOperation>
+  void unpack(std::span<const std::int32_t> idx,
+              std::span<const value_type> buffer, std::int32_t offset,
+              BinaryOperation op)
+  {
+    std::vector<std::span<value_type>> x;
+    for (V& v : _x)
+      x.push_back(v.mutable_array());
+    for (std::size_t i = 0; i < idx.size(); ++i)
+    {
+      auto [v, k] = _component[idx[i] % _bs];
+      value_type& xi = x[v][(offset + idx[i] / _bs) * _x[v].get().bs() + k];
+      xi = op(xi, buffer[i]);
+    }
+  }
+
+  // Vectors in the group
+  std::vector<std::reference_wrapper<V>> _x;
+
+  // Size of the combined block, i.e. sum of the vector block sizes
+  int _bs;
+
+  // (vector, component) for each entry of the combined block
+  std::vector<std::pair<int, int>> _component;
+
+  // Scatterer for the combined block
+  std::shared_ptr<const typename V::scatterer_type> _scatterer;
+
+  // MPI request handle
+  std::vector<MPI_Request> _request = {MPI_REQUEST_NULL};
+
+  // Buffers for ghost scatters
+  typename V::buffer_container_type _buffer_local, _buffer_remote;
+};
+} // namespace dolfinx::la
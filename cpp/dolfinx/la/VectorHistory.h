@@ -0,0 +1,122 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Ring buffer of distributed vectors holding the past time
+/// levels of a field, e.g. for multistep (BDF, Adams) time
+/// integrators.
+///
+/// Vector `i` is the field at time level `n - i`, with `i = 0` the
+/// most recent level. Advancing to the next time level with rotate()
+/// re-labels the vectors in O(1), without copying data. The vectors are
+/// copies of one vector and therefore share its IndexMap and
+/// Scatterer.
+///
+/// Since rotate() re-labels the vectors, a fem::Function that wraps
+/// vector(i) refers to a different time level after each rotation.
+///
+/// @tparam V Vector type, e.g. la::Vector
+template <class V>
+class VectorHistory
+{
+public:
+  /// Scalar type
+  using value_type = typename V::value_type;
+
+  /// @brief Create a history of vectors.
+  /// @param[in] x Vector with the layout of the field. All time levels
+  /// are initialised to a copy of `x`.
+  /// @param[in] depth Number of time levels to store.
+  VectorHistory(const V& x, int depth)
+  {
+    if (depth < 1)
+      throw std::runtime_error("History depth must be positive.");
+    for (int i = 0; i < depth; ++i)
+      _x.push_back(std::make_shared<V>(x));
+  }
+
+  /// @brief Number of stored time levels.
+  int depth() const { return _x.size(); }
+
+  /// @brief Vector of a time level.
+  /// @param[in] i Level index, `0 <= i < depth()`. Level `i` is time
+  /// level `n - i`.
+  V& operator[](int i) { return *_x[slot(i)]; }
+
+  /// @brief Vector of a time level.
+  /// @param[in] i Level index, `0 <= i < depth()`.
+  const V& operator[](int i) const { return *_x[slot(i)]; }
+
+  /// @brief Pointer to the vector of a time level.
+  /// @param[in] i Level index, `0 <= i < depth()`.
+  std::shared_ptr<V> vector(int i) const { return _x[slot(i)]; }
+
+  /// @brief Advance the history to the next time level.
+  ///
+  /// The vector of level `i` becomes the vector of level `i + 1`, and
+  /// the vector of the oldest level is re-used for level 0. No data is
+  /// copied, so level 0 holds the data of the discarded oldest level
+  /// until it is overwritten with the new field.
+  ///
+  /// @return Vector of the new level 0.
+  V& rotate()
+  {
+    _head = (_head + _x.size() - 1) % _x.size();
+    return *_x[_head];
+  }
+
+  /// @brief Compute `y = sum_i alpha[i] x_i`, where `x_i` is the vector
+  /// of level `i`, in a single pass over the data.
+  ///
+  /// Owned and ghost entries are combined, so no communication is
+  /// required if the ghost entries of the levels are up to date.
+  ///
+  /// @param[in] alpha Coefficients of levels `0, ..., alpha.size() -
+  /// 1`, with `alpha.size() <= depth()`.
+  /// @param[out] y Result. It may be the vector of a level.
+  void linear_combination(std::span<const value_type> alpha, V& y) const
+  {
+    if (alpha.empty() or alpha.size() > _x.size())
+      throw std::runtime_error("Invalid number of history coefficients.");
+
+    std::vector<const value_type*> x;
+    for (std::size_t i = 0; i < alpha.size(); ++i)
+      x.push_back(_x[slot(i)]->array().data());
+
+    std::span<value_type> _y = y.mutable_array();
+    if (_y.size() != _x.front()->array().size())
+      throw std::runtime_error("Vector size mismatch.");
+
+    const std::size_t k = alpha.size();
+    for (std::size_t j = 0; j < _y.size(); ++j)
+    {
+      value_type s = alpha[0] * x[0][j];
+      for (std::size_t i = 1; i < k; ++i)
+        s += alpha[i] * x[i][j];
+      _y[j] = s;
+    }
+  }
+
+private:
+  // Position in _x of the vector of level i
+  std::size_t slot(int i) const { return (_head + i) % _x.size(); }
+
+  // Vectors, with level i stored at _x[(_head + i) % depth]
+  std::vector<std::shared_ptr<V>> _x;
+
+  // Position in _x of level 0
+  std::size_t _head = 0;
+};
+} // namespace dolfinx::la
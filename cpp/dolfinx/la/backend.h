@@ -0,0 +1,112 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <type_traits>
+
+namespace dolfinx::la
+{
+/// @brief Operations on the data of linear algebra objects that are
+/// stored in containers of type `Container`.
+///
+/// la::Vector performs all operations on its data through this class,
+/// i.e. it does not access its data or its scatter indices directly on
+/// the host. The default implementation is for containers in host
+/// memory, e.g. `std::vector`. Vectors with data in device memory are
+/// supported by specialising the class for the device container type,
+/// e.g. with CUDA, HIP, SYCL or Kokkos kernels.
+///
+/// The spans that are passed to the operations reference the data of
+/// the containers, i.e. for device containers they hold device
+/// pointers and must not be dereferenced on the host.
+///
+/// @tparam Container Container type of the data.
+template <typename Container>
+struct backend
+{
+  /// Scalar type
+  using value_type = typename Container::value_type;
+
+  /// @brief Set all entries of `x` to `v`.
+  static void fill(std::span<value_type> x, value_type v)
+  {
+    std::ranges::fill(x, v);
+  }
+
+  /// @brief Copy `x` to `y`.
+  static void copy(std::span<const value_type> x, std::span<value_type> y)
+  {
+    std::ranges::copy(x, y.begin());
+  }
+
+  /// @brief Pack entries of `in` into `out`, i.e. `out[i] =
+  /// in[idx[i]]`.
+  /// @param[in] in Data to pack.
+  /// @param[in] idx Indices of the data to pack.
+  /// @param[out] out Packed data.
+  static void pack(std::span<const value_type> in,
+                   std::span<const std::int32_t> idx,
+                   std::span<value_type> out)
+  {
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[i] = in[idx[i]];
+  }
+
+  /// @brief Unpack `in` into entries of `out`, i.e. `out[idx[i]] =
+  /// op(out[idx[i]], in[i])`.
+  /// @param[in] in Packed data.
+  /// @param[in] idx Indices of the entries to unpack to.
+  /// @param[in,out] out Data to unpack into.
+  /// @param[in] op Operation that combines the existing and the
+  /// unpacked values, e.g. to insert or to add.
+  template <class BinaryOperation>
+  static void unpack(std::span<const value_type> in,
+                     std::span<const std::int32_t> idx,
+                     std::span<value_type> out, BinaryOperation op)
+  {
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[idx[i]] = op(out[idx[i]], in[i]);
+  }
+
+  /// @brief Compute `r = alpha x + y`.
+  /// @note `r` can be the same as `x` or `y`.
+  static void axpy(std::span<value_type> r, value_type alpha,
+                   std::span<const value_type> x,
+                   std::span<const value_type> y)
+  {
+    std::transform(x.begin(), x.end(), y.begin(), r.begin(),
+                   [alpha](auto x, auto y) { return alpha * x + y; });
+  }
+
+  /// @brief Compute the local inner product `a^{H} b` (`a^{T} b` if
+  /// `a` and `b` are real).
+  static value_type dot(std::span<const value_type> a,
+                        std::span<const value_type> b)
+  {
+    return std::transform_reduce(
+        a.begin(), a.end(), b.begin(), static_cast<value_type>(0),
+        std::plus{},
+        [](value_type a, value_type b) -> value_type
+        {
+          if constexpr (std::is_same_v<value_type, std::complex<double>>
+                        or std::is_same_v<value_type, std::complex<float>>)
+          {
+            return std::conj(a) * b;
+          }
+          else
+            return a * b;
+        });
+  }
+};
+} // namespace dolfinx::la
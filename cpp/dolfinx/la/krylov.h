@@ -0,0 +1,452 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Vector.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/types.h>
+#include <functional>
+#include <mpi.h>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/// @file krylov.h
+/// @brief Krylov subspace solvers for la::Vector.
+///
+/// The solvers apply a linear operator `A` that is either an object
+/// with a member function `A.mult(x, y)` that computes `y += Ax` (e.g.
+/// la::MatrixCSR or la::MatrixSELL), or a callable `A(x, y)` that
+/// computes `y = Ax`. The operator needs to compute only the owned
+/// entries of `y`, and must update the ghost values of `x` if it
+/// requires them (la::MatrixCSR::mult does this).
+///
+/// The work vectors are allocated once per solve and the iterations do
+/// not allocate. Vector updates are fused with the local parts of the
+/// inner products that follow them, so that each iteration makes a
+/// small number of passes over the vectors and reductions.
+
+namespace dolfinx::la
+{
+namespace impl
+{
+/// @brief Complex conjugate that preserves the type of real values.
+template <typename T>
+T conj(T x)
+{
+  if constexpr (std::is_floating_point_v<T>)
+    return x;
+  else
+    return std::conj(x);
+}
+
+/// @brief Apply an operator, `y = Ax`.
+/// @param[in] A Operator with a member function `mult(x, y)` that
+/// computes `y += Ax`, or a callable that computes `y = Ax`.
+/// @param[in,out] x Vector to apply the operator to.
+/// @param[out] y Result vector.
+template <class Op, class V>
+void apply_operator(Op& A, V& x, V& y)
+{
+  if constexpr (requires { A.mult(x, y); })
+  {
+    y.set(0);
+    A.mult(x, y);
+  }
+  else
+    A(x, y);
+}
+
+/// @brief Sum the entries of `values` over all processes (in place).
+template <typename T>
+void allreduce_sum(std::span<T> values, MPI_Comm comm)
+{
+  MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(),
+                dolfinx::MPI::mpi_t<T>, MPI_SUM, comm);
+}
+
+/// @brief Local (process) part of the inner product `a^{H} b`.
+template <typename T>
+T local_inner_product(std::span<const T> a, std::span<const T> b)
+{
+  T result = 0;
+  for (std::size_t i = 0; i < a.size(); ++i)
+    result += conj(a[i]) * b[i];
+  return result;
+}
+
+/// @brief Number of owned entries of a vector.
+template <class V>
+std::size_t local_size(const V& x)
+{
+  return x.bs() * x.index_map()->size_local();
+}
+} // namespace impl
+
+/// @brief Solve `Ax = b` using the pipelined conjugate gradient method.
+///
+/// The inner products of an iteration are combined into a single
+/// non-blocking reduction (`MPI_Iallreduce`), which is overlapped with
+/// the application of the operator (Ghysels and Vanroose, Parallel
+/// Computing 40(7), 2014, https://doi.org/10.1016/j.parco.2013.06.001).
+///
+/// The operator must be self-adjoint and positive definite. The solver
+/// terminates when `||r|| <= rtol ||r_0||`, where `r` is the residual
+/// and `r_0` the initial residual, or after `kmax` iterations.
+///
+/// @note Collective MPI operation.
+///
+/// @param[in,out] x Initial guess on entry, and the solution on return.
+/// The ghost values are updated on return.
+/// @param[in] b Right-hand side vector.
+/// @param[in] A Linear operator.
+/// @param[in] kmax Maximum number of iterations.
+/// @param[in] rtol Relative tolerance.
+/// @return Number of iterations.
+template <class V, class Op>
+int cg(V& x, const V& b, Op&& A, int kmax,
+       dolfinx::scalar_value_t<typename V::value_type> rtol)
+{
+  using T = typename V::value_type;
+  using U = typename dolfinx::scalar_value_t<T>;
+  MPI_Comm comm = x.index_map()->comm();
+  const std::size_t n = impl::local_size(x);
+
+  // Work vectors
+  V r(b), w(b), m(b), p(b), s(b), z(b);
+  std::span _x = x.mutable_array().first(n);
+  std::span _r = r.mutable_array().first(n);
+  std::span _w = w.mutable_array().first(n);
+  std::span _m = m.mutable_array().first(n);
+  std::span _p = p.mutable_array().first(n);
+  std::span _s = s.mutable_array().first(n);
+  std::span _z = z.mutable_array().first(n);
+
+  // Initial residual r = b - Ax, w = A r and local inner products
+  // (r, r) and (w, r)
+  impl::apply_operator(A, x, w);
+  std::span<const T> _b = b.array().first(n);
+  for (std::size_t i = 0; i < n; ++i)
+    _r[i] = _b[i] - _w[i];
+  impl::apply_operator(A, r, w);
+  std::array<T, 2> dots = {impl::local_inner_product<T>(_r, _r),
+                           impl::local_inner_product<T>(_w, _r)};
+
+  std::ranges::fill(_p, T(0));
+  std::ranges::fill(_s, T(0));
+  std::ranges::fill(_z, T(0));
+
+  U gamma0 = 0;
+  T gamma_old = 1, alpha_old = 1;
+  int k = 0;
+  for (; k <= kmax; ++k)
+  {
+    // Start reduction, overlapped with m = A w
+    std::array<T, 2> local = dots;
+    MPI_Request request;
+    MPI_Iallreduce(local.data(), dots.data(), 2, dolfinx::MPI::mpi_t<T>,
+                   MPI_SUM, comm, &request);
+    impl::apply_operator(A, w, m);
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+    auto [gamma, delta] = dots;
+    if (k == 0)
+      gamma0 = std::real(gamma);
+    if (k == kmax or std::real(gamma) <= rtol * rtol * gamma0)
+      break;
+
+    T beta = k > 0 ? gamma / gamma_old : T(0);
+    T alpha = k > 0 ? gamma / (delta - beta * gamma / alpha_old)
+                    : gamma / delta;
+    gamma_old = gamma;
+    alpha_old = alpha;
+
+    // Update vectors and compute local (r, r) and (w, r)
+    dots = {0, 0};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      _z[i] = _m[i] + beta * _z[i];
+      _s[i] = _w[i] + beta * _s[i];
+      _p[i] = _r[i] + beta * _p[i];
+      _x[i] += alpha * _p[i];
+      _r[i] -= alpha * _s[i];
+      _w[i] -= alpha * _z[i];
+      dots[0] += impl::conj(_r[i]) * _r[i];
+      dots[1] += impl::conj(_w[i]) * _r[i];
+    }
+  }
+
+  x.scatter_fwd();
+  return k;
+}
+
+/// @brief Solve `Ax = b` using the restarted generalised minimal
+/// residual (GMRES) method.
+///
+/// The Krylov basis is orthogonalised using classical Gram-Schmidt with
+/// one re-orthogonalisation step, in which the inner products with all
+/// previous basis vectors are computed in a single pass and a single
+/// reduction. The solver terminates when `||r|| <= rtol ||r_0||`, where
+/// `r` is the residual and `r_0` the initial residual, or after `kmax`
+/// iterations.
+///
+/// @note Collective MPI operation.
+///
+/// @param[in,out] x Initial guess on entry, and the solution on return.
+/// The ghost values are updated on return.
+/// @param[in] b Right-hand side vector.
+/// @param[in] A Linear operator.
+/// @param[in] kmax Maximum number of iterations.
+/// @param[in] rtol Relative tolerance.
+/// @param[in] restart Number of iterations after which the method is
+/// restarted.
+/// @return Number of iterations.
+template <class V, class Op>
+int gmres(V& x, const V& b, Op&& A, int kmax,
+          dolfinx::scalar_value_t<typename V::value_type> rtol,
+          int restart = 30)
+{
+  using T = typename V::value_type;
+  using U = typename dolfinx::scalar_value_t<T>;
+  if (restart < 1)
+    throw std::runtime_error("GMRES restart must be positive.");
+
+  MPI_Comm comm = x.index_map()->comm();
+  const std::size_t n = impl::local_size(x);
+  const std::size_t mr = restart;
+
+  // Krylov basis, Hessenberg matrix (column-major), Givens rotations
+  // and least-squares right-hand side
+  std::vector<V> basis(mr + 1, b);
+  V w(b);
+  std::vector<T> H(mr * (mr + 1)), h(mr + 1), sn(mr), g(mr + 1);
+  std::vector<U> cs(mr);
+  std::span _x = x.mutable_array().first(n);
+  std::span _w = w.mutable_array().first(n);
+  std::span<const T> _b = b.array().first(n);
+
+  U rnorm0 = -1;
+  int k = 0;
+  while (k < kmax)
+  {
+    // Residual r = b - A x
+    V& v0 = basis[0];
+    std::span _v0 = v0.mutable_array().first(n);
+    impl::apply_operator(A, x, w);
+    T rr = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      _v0[i] = _b[i] - _w[i];
+      rr += impl::conj(_v0[i]) * _v0[i];
+    }
+    impl::allreduce_sum<T>({&rr, 1}, comm);
+    const U beta = std::sqrt(std::real(rr));
+    if (rnorm0 < 0)
+      rnorm0 = beta;
+    if (beta == 0 or beta <= rtol * rnorm0)
+      break;
+
+    std::ranges::transform(_v0, _v0.begin(),
+                           [beta](auto v) { return v / beta; });
+    std::ranges::fill(g, T(0));
+    g[0] = beta;
+
+    std::size_t j = 0;
+    bool converged = false;
+    while (j < mr and k < kmax)
+    {
+      // w = A v_j, orthogonalised against v_0, ..., v_j
+      impl::apply_operator(A, basis[j], w);
+      T* Hj = H.data() + j * (mr + 1);
+      std::fill_n(Hj, j + 2, T(0));
+      for (int pass = 0; pass < 2; ++pass)
+      {
+        la::inner_products(std::span(basis).first(j + 1), w,
+                           std::span(h.data(), j + 1));
+        for (std::size_t l = 0; l <= j; ++l)
+        {
+          std::span<const T> vl = basis[l].array().first(n);
+          for (std::size_t i = 0; i < n; ++i)
+            _w[i] -= h[l] * vl[i];
+          Hj[l] += h[l];
+        }
+      }
+
+      // Normalise to give v_{j+1}
+      T ww = impl::local_inner_product<T>(_w, _w);
+      impl::allreduce_sum<T>({&ww, 1}, comm);
+      const U wnorm = std::sqrt(std::real(ww));
+      Hj[j + 1] = wnorm;
+      if (wnorm > 0)
+      {
+        std::span v1 = basis[j + 1].mutable_array().first(n);
+        std::ranges::transform(_w, v1.begin(),
+                               [wnorm](auto v) { return v / wnorm; });
+      }
+
+      // Apply previous rotations to the new column of H, and compute
+      // the rotation that eliminates H(j + 1, j)
+      for (std::size_t l = 0; l < j; ++l)
+      {
+        T h0 = Hj[l], h1 = Hj[l + 1];
+        Hj[l] = cs[l] * h0 + sn[l] * h1;
+        Hj[l + 1] = -impl::conj(sn[l]) * h0 + cs[l] * h1;
+      }
+      const U a = std::abs(Hj[j]);
+      const U nrm = std::sqrt(a * a + wnorm * wnorm);
+      if (a == 0)
+      {
+        cs[j] = 0;
+        sn[j] = 1;
+      }
+      else
+      {
+        cs[j] = a / nrm;
+        sn[j] = (Hj[j] / a) * wnorm / nrm;
+      }
+      Hj[j] = cs[j] * Hj[j] + sn[j] * Hj[j + 1];
+      Hj[j + 1] = 0;
+      g[j + 1] = -impl::conj(sn[j]) * g[j];
+      g[j] = cs[j] * g[j];
+
+      ++j;
+      ++k;
+      if (std::abs(g[j]) <= rtol * rnorm0 or wnorm == 0)
+      {
+        converged = true;
+        break;
+      }
+    }
+
+    // Solve the upper-triangular system H y = g (in place in g) and
+    // update x += V y
+    for (std::size_t l = j; l-- > 0;)
+    {
+      for (std::size_t c = l + 1; c < j; ++c)
+        g[l] -= H[c * (mr + 1) + l] * g[c];
+      g[l] /= H[l * (mr + 1) + l];
+    }
+    for (std::size_t l = 0; l < j; ++l)
+    {
+      std::span<const T> vl = basis[l].array().first(n);
+      for (std::size_t i = 0; i < n; ++i)
+        _x[i] += g[l] * vl[i];
+    }
+
+    if (converged)
+      break;
+  }
+
+  x.scatter_fwd();
+  return k;
+}
+
+/// @brief Solve `Ax = b` using the stabilised bi-conjugate gradient
+/// (BiCGStab) method.
+///
+/// Inner products that are required at the same point of an iteration
+/// are combined into a single reduction, and the update of the solution
+/// and residual is fused with the inner products that start the next
+/// iteration. The solver terminates when `||r|| <= rtol ||r_0||`, where
+/// `r` is the residual and `r_0` the initial residual, or after `kmax`
+/// iterations.
+///
+/// @note Collective MPI operation.
+///
+/// @param[in,out] x Initial guess on entry, and the solution on return.
+/// The ghost values are updated on return.
+/// @param[in] b Right-hand side vector.
+/// @param[in] A Linear operator.
+/// @param[in] kmax Maximum number of iterations.
+/// @param[in] rtol Relative tolerance.
+/// @return Number of iterations.
+template <class V, class Op>
+int bicgstab(V& x, const V& b, Op&& A, int kmax,
+             dolfinx::scalar_value_t<typename V::value_type> rtol)
+{
+  using T = typename V::value_type;
+  using U = typename dolfinx::scalar_value_t<T>;
+  MPI_Comm comm = x.index_map()->comm();
+  const std::size_t n = impl::local_size(x);
+
+  // Work vectors
+  V r(b), r0(b), p(b), v(b), s(b), t(b);
+  std::span _x = x.mutable_array().first(n);
+  std::span _r = r.mutable_array().first(n);
+  std::span _r0 = r0.mutable_array().first(n);
+  std::span _p = p.mutable_array().first(n);
+  std::span _v = v.mutable_array().first(n);
+  std::span _s = s.mutable_array().first(n);
+  std::span _t = t.mutable_array().first(n);
+
+  // Initial residual r = b - Ax
+  impl::apply_operator(A, x, v);
+  std::span<const T> _b = b.array().first(n);
+  for (std::size_t i = 0; i < n; ++i)
+    _r[i] = _b[i] - _v[i];
+  std::ranges::copy(_r, _r0.begin());
+  std::ranges::fill(_p, T(0));
+  std::ranges::fill(_v, T(0));
+
+  // Global (r0, r) and (r, r)
+  std::array<T, 2> dots = {impl::local_inner_product<T>(_r0, _r),
+                           impl::local_inner_product<T>(_r, _r)};
+  impl::allreduce_sum<T>(dots, comm);
+  const U rnorm0 = std::sqrt(std::real(dots[1]));
+
+  T rho_old = 1, alpha = 1, omega = 1;
+  int k = 0;
+  for (; k < kmax; ++k)
+  {
+    if (std::sqrt(std::real(dots[1])) <= rtol * rnorm0)
+      break;
+
+    // p = r + beta (p - omega v), v = A p
+    const T rho = dots[0];
+    const T beta = (rho / rho_old) * (alpha / omega);
+    rho_old = rho;
+    for (std::size_t i = 0; i < n; ++i)
+      _p[i] = _r[i] + beta * (_p[i] - omega * _v[i]);
+    impl::apply_operator(A, p, v);
+
+    // s = r - alpha v, t = A s
+    T r0v = impl::local_inner_product<T>(_r0, _v);
+    impl::allreduce_sum<T>({&r0v, 1}, comm);
+    alpha = rho / r0v;
+    for (std::size_t i = 0; i < n; ++i)
+      _s[i] = _r[i] - alpha * _v[i];
+    impl::apply_operator(A, s, t);
+
+    // omega = (t, s) / (t, t)
+    std::array<T, 2> ts = {impl::local_inner_product<T>(_t, _s),
+                           impl::local_inner_product<T>(_t, _t)};
+    impl::allreduce_sum<T>(ts, comm);
+    omega = ts[0] / ts[1];
+
+    // Update x and r, and compute local (r0, r) and (r, r)
+    dots = {0, 0};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      _x[i] += alpha * _p[i] + omega * _s[i];
+      _r[i] = _s[i] - omega * _t[i];
+      dots[0] += impl::conj(_r0[i]) * _r[i];
+      dots[1] += impl::conj(_r[i]) * _r[i];
+    }
+    impl::allreduce_sum<T>(dots, comm);
+  }
+
+  x.scatter_fwd();
+  return k;
+}
+} // namespace dolfinx::la
@@ -6,6 +6,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
 #include <numeric>
 #include <span>
 #include <utility>
@@ -31,6 +36,9 @@ namespace impl
 /// @param[in] num_rows Maximum row index that can be set. Used when
 /// debugging to check that rows beyond a permitted range are not being
 /// set.
+/// @param[in] skip_missing If true, entries that are not in the
+/// sparsity pattern are ignored, e.g. the entries below the diagonal of
+/// a matrix with symmetric storage. Otherwise an exception is thrown.
 ///
 /// @note In the case of block data, where BS0 or BS1 are greater than
 /// one, the layout of the input data is still the same. For example,
@@ -48,7 +56,8 @@ template <int BS0, int BS1, typename OP, typename U, typename V, typename W,
           typename X, typename Y>
 void insert_csr(U&& data, const V& cols, const W& row_ptr, const X& x,
                 const Y& xrows, const Y& xcols, OP op,
-                [[maybe_unused]] typename Y::value_type num_rows)
+                [[maybe_unused]] typename Y::value_type num_rows,
+                bool skip_missing = false)
 {
   const std::size_t nc = xcols.size();
   assert(x.size() == xrows.size() * xcols.size() * BS0 * BS1);
@@ -71,7 +80,11 @@ void insert_csr(U&& data, const V& cols, const W& row_ptr, const X& x,
       // Find position of column index
       auto it = std::lower_bound(cit0, cit1, xcols[c]);
       if (it == cit1 or *it != xcols[c])
+      {
+        if (skip_missing)
+          continue;
         throw std::runtime_error("Entry not in sparsity");
+      }
 
       std::size_t d = std::distance(cols.begin(), it);
       std::size_t di = d * BS0 * BS1;
@@ -109,11 +122,15 @@ void insert_csr(U&& data, const V& cols, const W& row_ptr, const X& x,
 /// @param[in] num_rows Maximum row index that can be set. Used when
 /// debugging to check that rows beyond a permitted range are not being
 /// set.
+/// @param[in] skip_missing If true, entries that are not in the
+/// sparsity pattern are ignored, e.g. the entries below the diagonal of
+/// a matrix with symmetric storage. Otherwise an exception is thrown.
 template <int BS0, int BS1, typename OP, typename U, typename V, typename W,
           typename X, typename Y>
 void insert_blocked_csr(U&& data, const V& cols, const W& row_ptr, const X& x,
                         const Y& xrows, const Y& xcols, OP op,
-                        [[maybe_unused]] typename Y::value_type num_rows)
+                        [[maybe_unused]] typename Y::value_type num_rows,
+                        bool skip_missing = false)
 {
   const std::size_t nc = xcols.size();
   assert(x.size() == xrows.size() * xcols.size() * BS0 * BS1);
@@ -139,7 +156,11 @@ void insert_blocked_csr(U&& data, const V& cols, const W& row_ptr, const X& x,
         // Find position of column index
         auto it = std::lower_bound(cit0, cit1, xcols[c] * BS1);
         if (it == cit1 or *it != xcols[c] * BS1)
+        {
+          if (skip_missing)
+            continue;
           throw std::runtime_error("Entry not in sparsity");
+        }
 
         std::size_t d = std::distance(cols.begin(), it);
         assert(d < data.size());
@@ -170,12 +191,15 @@ void insert_blocked_csr(U&& data, const V& cols, const W& row_ptr, const X& x,
 /// set.
 /// @param[in] bs0 Row block size of matrix.
 /// @param[in] bs1 Column block size of matrix.
+/// @param[in] skip_missing If true, entries that are not in the
+/// sparsity pattern are ignored, e.g. the entries below the diagonal of
+/// a matrix with symmetric storage. Otherwise an exception is thrown.
 template <typename OP, typename U, typename V, typename W, typename X,
           typename Y>
 void insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
                            const X& x, const Y& xrows, const Y& xcols, OP op,
                            [[maybe_unused]] typename Y::value_type num_rows,
-                           int bs0, int bs1)
+                           int bs0, int bs1, bool skip_missing = false)
 {
   const std::size_t nc = xcols.size();
   const int nbs = bs0 * bs1;
@@ -201,7 +225,11 @@ void insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
       auto cdiv = std::div(xcols[c], bs1);
       auto it = std::lower_bound(cit0, cit1, cdiv.quot);
       if (it == cit1 or *it != cdiv.quot)
+      {
+        if (skip_missing)
+          continue;
         throw std::runtime_error("Entry not in sparsity");
+      }
 
       std::size_t d = std::distance(cols.begin(), it);
       std::size_t di = d * nbs + rdiv.rem * bs1 + cdiv.rem;
@@ -211,6 +239,122 @@ void insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
   }
 }
 
+/// @brief Compute the positions in the CSR matrix data of the entries
+/// of a dense block of values, for a matrix with the same block size as
+/// the data.
+///
+/// @note See ::insert_csr for data layout.
+///
+/// @tparam BS0 Row block size (of both matrix and data).
+/// @tparam BS1 Column block size (of both matrix and data).
+/// @param[out] offsets Position in the matrix data of each entry of the
+/// `m` by `n` dense block of values (row-major).
+/// @param[in] cols CSR column indices.
+/// @param[in] row_ptr Pointer to the ith row in the CSR data.
+/// @param[in] xrows Row indices of the block.
+/// @param[in] xcols Column indices of the block.
+template <int BS0, int BS1, typename U, typename V, typename W, typename Y>
+void csr_offsets(U&& offsets, const V& cols, const W& row_ptr,
+                 const Y& xrows, const Y& xcols)
+{
+  const std::size_t nc = xcols.size();
+  assert(offsets.size() == xrows.size() * xcols.size() * BS0 * BS1);
+  for (std::size_t r = 0; r < xrows.size(); ++r)
+  {
+    // Columns indices for row
+    auto row = xrows[r];
+    auto cit0 = std::next(cols.begin(), row_ptr[row]);
+    auto cit1 = std::next(cols.begin(), row_ptr[row + 1]);
+    for (std::size_t c = 0; c < nc; ++c)
+    {
+      // Find position of column index
+      auto it = std::lower_bound(cit0, cit1, xcols[c]);
+      if (it == cit1 or *it != xcols[c])
+        throw std::runtime_error("Entry not in sparsity");
+
+      std::size_t d = std::distance(cols.begin(), it);
+      for (int i = 0; i < BS0; ++i)
+      {
+        for (int j = 0; j < BS1; ++j)
+        {
+          offsets[((r * BS0 + i) * nc + c) * BS1 + j]
+              = (d * BS0 + i) * BS1 + j;
+        }
+      }
+    }
+  }
+}
+
+/// @brief Compute the positions in the CSR matrix data of the entries
+/// of a dense block of values with given block sizes, for a
+/// non-blocked matrix.
+///
+/// @note See ::insert_csr for data layout.
+///
+/// @tparam BS0 Row block size of data.
+/// @tparam BS1 Column block size of data.
+/// @param[out] offsets Position in the matrix data of each entry of the
+/// `m` by `n` dense block of values (row-major).
+/// @param[in] cols CSR column indices.
+/// @param[in] row_ptr Pointer to the ith row in the CSR data.
+/// @param[in] xrows Row indices of the block.
+/// @param[in] xcols Column indices of the block.
+template <int BS0, int BS1, typename U, typename V, typename W, typename Y>
+void blocked_csr_offsets(U&& offsets, const V& cols, const W& row_ptr,
+                         const Y& xrows, const Y& xcols)
+{
+  const std::size_t nc = xcols.size();
+  assert(offsets.size() == xrows.size() * xcols.size() * BS0 * BS1);
+  for (std::size_t r = 0; r < xrows.size(); ++r)
+  {
+    auto row = xrows[r] * BS0;
+    for (int i = 0; i < BS0; ++i)
+    {
+      // Columns indices for row
+      auto cit0 = std::next(cols.begin(), row_ptr[row + i]);
+      auto cit1 = std::next(cols.begin(), row_ptr[row + i + 1]);
+      for (std::size_t c = 0; c < nc; ++c)
+      {
+        // Find position of column index
+        auto it = std::lower_bound(cit0, cit1, xcols[c] * BS1);
+        if (it == cit1 or *it != xcols[c] * BS1)
+          throw std::runtime_error("Entry not in sparsity");
+
+        std::size_t d = std::distance(cols.begin(), it);
+        for (int j = 0; j < BS1; ++j)
+          offsets[((r * BS0 + i) * nc + c) * BS1 + j] = d + j;
+      }
+    }
+  }
+}
+
+/// @brief Partition the rows of a CSR matrix into contiguous ranges
+/// with approximately equal numbers of non-zeros.
+/// @param[in] row_ptr CSR row pointers, of size `num_rows + 1`.
+/// @param[in] num_parts Number of ranges.
+/// @return Boundaries of the ranges, of size `num_parts + 1`. Range `i`
+/// is rows `[r[i], r[i + 1])`.
+inline std::vector<std::int32_t>
+partition_rows(std::span<const std::int64_t> row_ptr, int num_parts)
+{
+  assert(!row_ptr.empty());
+  assert(num_parts > 0);
+  const std::int64_t nnz = row_ptr.back() - row_ptr.front();
+  std::vector<std::int32_t> ranges(num_parts + 1, 0);
+  for (int i = 1; i < num_parts; ++i)
+  {
+    // First row that starts at or after the target non-zero count
+    const std::int64_t target = row_ptr.front() + (nnz * i) / num_parts;
+    auto it = std::lower_bound(row_ptr.begin(), std::prev(row_ptr.end()),
+                               target);
+    ranges[i] = std::max<std::int32_t>(std::distance(row_ptr.begin(), it),
+                                       ranges[i - 1]);
+  }
+  ranges.back() = row_ptr.size() - 1;
+
+  return ranges;
+}
+
 /// @brief  Sparse matrix-vector product implementation.
 /// @tparam T
 /// @tparam BS1
@@ -222,25 +366,26 @@ void insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
 /// @param y
 /// @param bs0
 /// @param bs1
-template <typename T, int BS1>
+/// @tparam S Vector scalar type, in which the product is accumulated.
+template <typename T, int BS1, typename S = T>
 void spmv(std::span<const T> values, std::span<const std::int64_t> row_begin,
           std::span<const std::int64_t> row_end,
-          std::span<const std::int32_t> indices, std::span<const T> x,
-          std::span<T> y, int bs0, int bs1)
+          std::span<const std::int32_t> indices, std::span<const S> x,
+          std::span<S> y, int bs0, int bs1)
 {
   assert(row_begin.size() == row_end.size());
   for (int k0 = 0; k0 < bs0; ++k0)
   {
     for (std::size_t i = 0; i < row_begin.size(); i++)
     {
-      T vi{0};
+      S vi{0};
       for (std::int32_t j = row_begin[i]; j < row_end[i]; j++)
       {
         if constexpr (BS1 == -1)
         {
           for (int k1 = 0; k1 < bs1; ++k1)
           {
-            vi += values[j * bs1 * bs0 + k1 * bs0 + k0]
+            vi += static_cast<S>(values[j * bs1 * bs0 + k1 * bs0 + k0])
                   * x[indices[j] * bs1 + k1];
           }
         }
@@ -248,7 +393,7 @@ void spmv(std::span<const T> values, std::span<const std::int64_t> row_begin,
         {
           for (int k1 = 0; k1 < BS1; ++k1)
           {
-            vi += values[j * BS1 * bs0 + k1 * bs0 + k0]
+            vi += static_cast<S>(values[j * BS1 * bs0 + k1 * bs0 + k0])
                   * x[indices[j] * BS1 + k1];
           }
         }
@@ -259,5 +404,152 @@ void spmv(std::span<const T> values, std::span<const std::int64_t> row_begin,
   }
 }
 
+/// @brief Sparse matrix-vector product implementation for a matrix
+/// with square blocks of a compile-time size.
+///
+/// Computes the same product as spmv(). The entries of a block row of
+/// `y` are accumulated in registers (a fixed-size array) while the
+/// blocks of the row are applied, so that the matrix data is read once
+/// and the dense block products can be unrolled and vectorised by the
+/// compiler.
+///
+/// @tparam T Matrix scalar type.
+/// @tparam BS Row and column block size.
+/// @tparam S Vector scalar type, in which the product is accumulated.
+/// @param[in] values Matrix values.
+/// @param[in] row_begin Start of the entries of each row in `indices`.
+/// @param[in] row_end End of the entries of each row in `indices`.
+/// @param[in] indices Column (block) indices.
+/// @param[in] x Vector to apply the matrix to.
+/// @param[in,out] y Vector to accumulate the product into.
+template <typename T, int BS, typename S = T>
+void spmv_block(std::span<const T> values,
+                std::span<const std::int64_t> row_begin,
+                std::span<const std::int64_t> row_end,
+                std::span<const std::int32_t> indices, std::span<const S> x,
+                std::span<S> y)
+{
+  static_assert(BS > 0);
+  assert(row_begin.size() == row_end.size());
+  for (std::size_t i = 0; i < row_begin.size(); i++)
+  {
+    std::array<S, BS> vi{};
+    for (std::int32_t j = row_begin[i]; j < row_end[i]; j++)
+    {
+      const T* A = values.data() + j * BS * BS;
+      const S* xj = x.data() + indices[j] * BS;
+      for (int k1 = 0; k1 < BS; ++k1)
+      {
+        for (int k0 = 0; k0 < BS; ++k0)
+          vi[k0] += static_cast<S>(A[k1 * BS + k0]) * xj[k1];
+      }
+    }
+
+    for (int k0 = 0; k0 < BS; ++k0)
+      y[i * BS + k0] += vi[k0];
+  }
+}
+
+/// @brief Sparse matrix-multivector product implementation.
+///
+/// Computes `y += Ax` for each of the `num_vectors` interleaved
+/// vectors in `x` and `y` (see la::MultiVector), with one pass over the
+/// matrix entries.
+///
+/// @tparam T Matrix scalar type.
+/// @tparam S Vector scalar type, in which the product is accumulated.
+/// @param[in] values Matrix values.
+/// @param[in] row_begin Start of the entries of each row in `indices`.
+/// @param[in] row_end End of the entries of each row in `indices`.
+/// @param[in] indices Column (block) indices.
+/// @param[in] x Multi-vector to apply the matrix to.
+/// @param[in,out] y Multi-vector to accumulate the product into.
+/// @param[in] bs0 Row block size.
+/// @param[in] bs1 Column block size.
+/// @param[in] num_vectors Number of vectors in `x` and `y`.
+template <typename T, typename S = T>
+void spmm(std::span<const T> values, std::span<const std::int64_t> row_begin,
+          std::span<const std::int64_t> row_end,
+          std::span<const std::int32_t> indices, std::span<const S> x,
+          std::span<S> y, int bs0, int bs1, int num_vectors)
+{
+  assert(row_begin.size() == row_end.size());
+  for (std::size_t i = 0; i < row_begin.size(); i++)
+  {
+    for (int k0 = 0; k0 < bs0; ++k0)
+    {
+      S* yi = y.data() + (i * bs0 + k0) * num_vectors;
+      for (std::int32_t j = row_begin[i]; j < row_end[i]; j++)
+      {
+        for (int k1 = 0; k1 < bs1; ++k1)
+        {
+          const S a = static_cast<S>(values[j * bs1 * bs0 + k1 * bs0 + k0]);
+          const S* xj = x.data() + (indices[j] * bs1 + k1) * num_vectors;
+          for (int v = 0; v < num_vectors; ++v)
+            yi[v] += a * xj[v];
+        }
+      }
+    }
+  }
+}
+
+/// @brief Sparse matrix-multivector product implementation for a
+/// matrix with symmetric storage.
+///
+/// Computes `y += Ax` for each of the `num_vectors` interleaved vectors
+/// in `x` and `y` (see la::MultiVector), as spmm(), for the rows
+/// `0, ..., row_begin.size() - 1`. If `mirror` is true, each entry
+/// `A_ij` with `j != i` is also applied as the entry `A_ji = A_ij^T`,
+/// which is not stored (see SparsityPattern::drop_lower_triangle). The
+/// columns must then be owned, i.e. also be rows of `y`.
+///
+/// @tparam T Matrix scalar type.
+/// @tparam S Vector scalar type, in which the product is accumulated.
+/// @param[in] values Matrix values.
+/// @param[in] row_begin Start of the entries of each row in `indices`.
+/// @param[in] row_end End of the entries of each row in `indices`.
+/// @param[in] indices Column (block) indices.
+/// @param[in] x Multi-vector to apply the matrix to.
+/// @param[in,out] y Multi-vector to accumulate the product into.
+/// @param[in] bs Row and column block size.
+/// @param[in] num_vectors Number of vectors in `x` and `y`.
+/// @param[in] mirror Whether to apply the entries below the diagonal.
+template <typename T, typename S = T>
+void spmm_symmetric(std::span<const T> values,
+                    std::span<const std::int64_t> row_begin,
+                    std::span<const std::int64_t> row_end,
+                    std::span<const std::int32_t> indices,
+                    std::span<const S> x, std::span<S> y, int bs,
+                    int num_vectors, bool mirror)
+{
+  assert(row_begin.size() == row_end.size());
+  for (std::size_t i = 0; i < row_begin.size(); i++)
+  {
+    for (std::int32_t j = row_begin[i]; j < row_end[i]; j++)
+    {
+      const std::size_t c = indices[j];
+      const bool transpose = mirror and c != i;
+      for (int k0 = 0; k0 < bs; ++k0)
+      {
+        S* yi = y.data() + (i * bs + k0) * num_vectors;
+        const S* xi = x.data() + (i * bs + k0) * num_vectors;
+        for (int k1 = 0; k1 < bs; ++k1)
+        {
+          const S a = static_cast<S>(values[(j * bs + k1) * bs + k0]);
+          const S* xj = x.data() + (c * bs + k1) * num_vectors;
+          for (int v = 0; v < num_vectors; ++v)
+            yi[v] += a * xj[v];
+          if (transpose)
+          {
+            S* yj = y.data() + (c * bs + k1) * num_vectors;
+            for (int v = 0; v < num_vectors; ++v)
+              yj[v] += a * xi[v];
+          }
+        }
+      }
+    }
+  }
+}
+
 } // namespace impl
 } // namespace dolfinx::la
@@ -8,6 +8,7 @@
 #ifdef HAS_PETSC
 
 #include "petsc.h"
+#include "MatrixCSR.h"
 #include "SparsityPattern.h"
 #include "Vector.h"
 #include "utils.h"
@@ -17,7 +18,10 @@
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <iostream>
+#include <memory>
+#include <span>
 #include <sstream>
+#include <utility>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
@@ -30,6 +34,114 @@ using namespace dolfinx::la;
       petsc::error(ierr, __FILE__, NAME);                                      \
   } while (0)
 
+namespace
+{
+/// Name of the PetscContainer composed with a matrix created from a
+/// MatrixCSR
+constexpr const char* split_arrays_name = "dolfinx_split_arrays";
+
+/// Diagonal and off-diagonal CSR arrays of the owned rows of a
+/// MatrixCSR, which are the storage of a PETSc MPIAIJ matrix
+struct SplitArrays
+{
+  // Row pointers and column indices of the diagonal and off-diagonal
+  // blocks
+  std::vector<PetscInt> i, j, oi, oj;
+
+  // Entries of the diagonal and off-diagonal blocks
+  std::vector<PetscScalar> a, oa;
+
+  // Position in MatrixCSR::values of each entry of a and oa
+  std::vector<std::int64_t> pos, opos;
+};
+
+//-----------------------------------------------------------------------------
+#if PETSC_VERSION_LT(3, 23, 0)
+PetscErrorCode destroy_split_arrays(void* arrays)
+{
+  delete static_cast<SplitArrays*>(arrays);
+  return 0;
+}
+#else
+PetscErrorCode destroy_split_arrays(void** arrays)
+{
+  delete static_cast<SplitArrays*>(*arrays);
+  *arrays = nullptr;
+  return 0;
+}
+#endif
+//-----------------------------------------------------------------------------
+/// Copy (gather) the entries of a MatrixCSR into the split arrays
+void copy_split_values(SplitArrays& arrays,
+                       std::span<const PetscScalar> values)
+{
+  std::ranges::transform(arrays.pos, arrays.a.begin(),
+                         [values](auto p) { return values[p]; });
+  std::ranges::transform(arrays.opos, arrays.oa.begin(),
+                         [values](auto p) { return values[p]; });
+}
+//-----------------------------------------------------------------------------
+/// Name of the PetscContainer composed with a shell matrix, which owns
+/// the shell context
+constexpr const char* shell_context_name = "dolfinx_shell_context";
+
+/// Context of a shell matrix created by create_matrix_shell
+struct ShellContext
+{
+  std::function<void(std::span<const PetscScalar>, std::span<PetscScalar>)>
+      action;
+};
+
+//-----------------------------------------------------------------------------
+#if PETSC_VERSION_LT(3, 23, 0)
+PetscErrorCode destroy_shell_context(void* ctx)
+{
+  delete static_cast<ShellContext*>(ctx);
+  return 0;
+}
+#else
+PetscErrorCode destroy_shell_context(void** ctx)
+{
+  delete static_cast<ShellContext*>(*ctx);
+  *ctx = nullptr;
+  return 0;
+}
+#endif
+//-----------------------------------------------------------------------------
+/// MATOP_MULT of a shell matrix created by create_matrix_shell. The
+/// vector arrays are passed to the action in place.
+PetscErrorCode shell_mult(Mat A, Vec x, Vec y)
+{
+  void* ptr = nullptr;
+  PetscErrorCode ierr = MatShellGetContext(A, &ptr);
+  if (ierr != 0)
+    return ierr;
+  const ShellContext& ctx = *static_cast<ShellContext*>(ptr);
+
+  PetscInt nx = 0, ny = 0;
+  VecGetLocalSize(x, &nx);
+  VecGetLocalSize(y, &ny);
+  const PetscScalar* _x = nullptr;
+  PetscScalar* _y = nullptr;
+  ierr = VecGetArrayRead(x, &_x);
+  if (ierr != 0)
+    return ierr;
+  ierr = VecGetArray(y, &_y);
+  if (ierr != 0)
+  {
+    VecRestoreArrayRead(x, &_x);
+    return ierr;
+  }
+
+  ctx.action(std::span<const PetscScalar>(_x, nx),
+             std::span<PetscScalar>(_y, ny));
+
+  VecRestoreArray(y, &_y);
+  return VecRestoreArrayRead(x, &_x);
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 void la::petsc::error(int error_code, std::string filename,
                       std::string petsc_function)
@@ -357,6 +469,188 @@ Mat la::petsc::create_matrix(MPI_Comm comm, const SparsityPattern& sp,
   return A;
 }
 //-----------------------------------------------------------------------------
+Mat la::petsc::create_matrix(const MatrixCSR<PetscScalar>& A)
+{
+  common::Timer t("Create PETSc matrix from MatrixCSR");
+
+  auto map0 = A.index_map(0);
+  auto map1 = A.index_map(1);
+  const auto [bs0, bs1] = A.block_size();
+  const std::int32_t num_rows = map0->size_local();
+  const std::int32_t num_owned_cols = map1->size_local();
+  std::span<const std::int64_t> ghosts = map1->ghosts();
+  const auto& row_ptr = A.row_ptr();
+  const auto& cols = A.cols();
+  const auto& off_diag_offset = A.off_diag_offset();
+
+  // Split the (expanded) rows into the diagonal block, with local
+  // column indices, and the off-diagonal block, with global column
+  // indices. PETSc requires the columns of each row to be sorted.
+  auto arrays = std::make_unique<SplitArrays>();
+  arrays->i.reserve(num_rows * bs0 + 1);
+  arrays->oi.reserve(num_rows * bs0 + 1);
+  arrays->i.push_back(0);
+  arrays->oi.push_back(0);
+  std::vector<std::pair<PetscInt, std::int64_t>> row;
+  for (std::int32_t r = 0; r < num_rows; ++r)
+  {
+    for (int i0 = 0; i0 < bs0; ++i0)
+    {
+      row.clear();
+      for (std::int64_t k = row_ptr[r]; k < off_diag_offset[r]; ++k)
+      {
+        for (int i1 = 0; i1 < bs1; ++i1)
+          row.emplace_back(cols[k] * bs1 + i1, (k * bs0 + i0) * bs1 + i1);
+      }
+      std::ranges::sort(row);
+      for (auto [c, p] : row)
+      {
+        arrays->j.push_back(c);
+        arrays->pos.push_back(p);
+      }
+      arrays->i.push_back(arrays->j.size());
+
+      row.clear();
+      for (std::int64_t k = off_diag_offset[r]; k < row_ptr[r + 1]; ++k)
+      {
+        const std::int64_t c = ghosts[cols[k] - num_owned_cols];
+        for (int i1 = 0; i1 < bs1; ++i1)
+          row.emplace_back(c * bs1 + i1, (k * bs0 + i0) * bs1 + i1);
+      }
+      std::ranges::sort(row);
+      for (auto [c, p] : row)
+      {
+        arrays->oj.push_back(c);
+        arrays->opos.push_back(p);
+      }
+      arrays->oi.push_back(arrays->oj.size());
+    }
+  }
+
+  arrays->a.resize(arrays->j.size());
+  arrays->oa.resize(arrays->oj.size());
+  copy_split_values(*arrays, A.values());
+
+  Mat B;
+  PetscErrorCode ierr = MatCreateMPIAIJWithSplitArrays(
+      map0->comm(), bs0 * num_rows, bs1 * num_owned_cols,
+      bs0 * map0->size_global(), bs1 * map1->size_global(), arrays->i.data(),
+      arrays->j.data(), arrays->a.data(), arrays->oi.data(),
+      arrays->oj.data(), arrays->oa.data(), &B);
+  CHECK_ERROR("MatCreateMPIAIJWithSplitArrays");
+
+  // Attach the arrays to the matrix, which destroys them with the
+  // matrix
+  PetscContainer container;
+  ierr = PetscContainerCreate(PETSC_COMM_SELF, &container);
+  CHECK_ERROR("PetscContainerCreate");
+  PetscContainerSetPointer(container, arrays.release());
+#if PETSC_VERSION_LT(3, 23, 0)
+  PetscContainerSetUserDestroy(container, destroy_split_arrays);
+#else
+  PetscContainerSetCtxDestroy(container, destroy_split_arrays);
+#endif
+  ierr = PetscObjectCompose((PetscObject)B, split_arrays_name,
+                            (PetscObject)container);
+  CHECK_ERROR("PetscObjectCompose");
+  PetscContainerDestroy(&container);
+
+  return B;
+}
+//-----------------------------------------------------------------------------
+void la::petsc::update_matrix(Mat B, const MatrixCSR<PetscScalar>& A)
+{
+  PetscContainer container = nullptr;
+  PetscObjectQuery((PetscObject)B, split_arrays_name,
+                   (PetscObject*)&container);
+  if (!container)
+  {
+    throw std::runtime_error(
+        "PETSc matrix was not created from a MatrixCSR.");
+  }
+
+  void* ptr = nullptr;
+  PetscContainerGetPointer(container, &ptr);
+  SplitArrays& arrays = *static_cast<SplitArrays*>(ptr);
+  const auto [bs0, bs1] = A.block_size();
+  const std::int32_t num_rows = A.num_owned_rows();
+  if (arrays.pos.size() + arrays.opos.size()
+      != std::size_t(A.row_ptr()[num_rows] * bs0 * bs1))
+  {
+    throw std::runtime_error(
+        "MatrixCSR sparsity pattern does not match the PETSc matrix.");
+  }
+
+  // The PETSc matrix uses the split arrays as its storage, so the
+  // entries are updated in place. Assembly notifies PETSc that the
+  // entries have changed.
+  copy_split_values(arrays, A.values());
+  PetscErrorCode ierr = MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY);
+  CHECK_ERROR("MatAssemblyBegin");
+  ierr = MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY);
+  CHECK_ERROR("MatAssemblyEnd");
+}
+//-----------------------------------------------------------------------------
+Mat la::petsc::create_matrix_shell(
+    const common::IndexMap& map0, int bs0, const common::IndexMap& map1,
+    int bs1,
+    std::function<void(std::span<const PetscScalar>, std::span<PetscScalar>)>
+        action)
+{
+  auto ctx = std::make_unique<ShellContext>(std::move(action));
+  const PetscInt m = map0.size_local() * bs0;
+  const PetscInt n = map1.size_local() * bs1;
+  const PetscInt M = map0.size_global() * bs0;
+  const PetscInt N = map1.size_global() * bs1;
+
+  Mat A;
+  PetscErrorCode ierr = MatCreateShell(map0.comm(), m, n, M, N, ctx.get(), &A);
+  CHECK_ERROR("MatCreateShell");
+  ierr = MatShellSetOperation(A, MATOP_MULT, (void (*)(void))shell_mult);
+  CHECK_ERROR("MatShellSetOperation");
+
+  // Attach the context to the matrix, which destroys it with the
+  // matrix
+  PetscContainer container;
+  ierr = PetscContainerCreate(PETSC_COMM_SELF, &container);
+  CHECK_ERROR("PetscContainerCreate");
+  PetscContainerSetPointer(container, ctx.release());
+#if PETSC_VERSION_LT(3, 23, 0)
+  PetscContainerSetUserDestroy(container, destroy_shell_context);
+#else
+  PetscContainerSetCtxDestroy(container, destroy_shell_context);
+#endif
+  ierr = PetscObjectCompose((PetscObject)A, shell_context_name,
+                            (PetscObject)container);
+  CHECK_ERROR("PetscObjectCompose");
+  PetscContainerDestroy(&container);
+
+  return A;
+}
+//-----------------------------------------------------------------------------
+Mat la::petsc::create_matrix_shell(MatrixCSR<PetscScalar>& A,
+                                   int num_threads)
+{
+  const auto [bs0, bs1] = A.block_size();
+  std::shared_ptr<const common::IndexMap> map0 = A.index_map(0);
+  std::shared_ptr<const common::IndexMap> map1 = A.index_map(1);
+
+  // Work vectors with the ghost entries required by MatrixCSR::mult.
+  // The column index map includes all columns of the owned rows.
+  auto x = std::make_shared<la::Vector<PetscScalar>>(map1, bs1);
+  auto y = std::make_shared<la::Vector<PetscScalar>>(map0, bs0);
+  auto action = [&A, x, y, num_threads](std::span<const PetscScalar> _x,
+                                        std::span<PetscScalar> _y)
+  {
+    std::ranges::copy(_x, x->mutable_array().begin());
+    std::ranges::fill(y->mutable_array(), 0);
+    A.mult(*x, *y, num_threads);
+    std::copy_n(y->array().begin(), _y.size(), _y.begin());
+  };
+
+  return create_matrix_shell(*map0, bs0, *map1, bs1, action);
+}
+//-----------------------------------------------------------------------------
 MatNullSpace la::petsc::create_nullspace(MPI_Comm comm,
                                          std::span<const Vec> basis)
 {
@@ -572,6 +866,59 @@ petsc::Matrix::Matrix(Mat A, bool inc_ref_count) : Operator(A, inc_ref_count)
   // Reference count to A is incremented in base class
 }
 //-----------------------------------------------------------------------------
+petsc::MatrixCOO::MatrixCOO(Mat A, std::array<int, 2> bs)
+    : Operator(A, true), _bs(bs)
+{
+}
+//-----------------------------------------------------------------------------
+void petsc::MatrixCOO::finalize()
+{
+  if (_finalized)
+    throw std::runtime_error("COO pattern has already been finalized.");
+
+  // Map the recorded local indices to global indices
+  ISLocalToGlobalMapping rmap = nullptr, cmap = nullptr;
+  PetscErrorCode ierr = MatGetLocalToGlobalMapping(_matA, &rmap, &cmap);
+  CHECK_ERROR("MatGetLocalToGlobalMapping");
+  if (!rmap or !cmap)
+  {
+    throw std::runtime_error(
+        "PETSc matrix does not have a local-to-global map.");
+  }
+  ierr = ISLocalToGlobalMappingApply(rmap, _rows.size(), _rows.data(),
+                                     _rows.data());
+  CHECK_ERROR("ISLocalToGlobalMappingApply");
+  ierr = ISLocalToGlobalMappingApply(cmap, _cols.size(), _cols.data(),
+                                     _cols.data());
+  CHECK_ERROR("ISLocalToGlobalMappingApply");
+
+  ierr = MatSetPreallocationCOO(_matA, _rows.size(), _rows.data(),
+                                _cols.data());
+  CHECK_ERROR("MatSetPreallocationCOO");
+
+  _values.resize(_rows.size());
+  _rows = std::vector<PetscInt>();
+  _cols = std::vector<PetscInt>();
+  _offset = 0;
+  _finalized = true;
+}
+//-----------------------------------------------------------------------------
+void petsc::MatrixCOO::assemble(InsertMode mode)
+{
+  if (!_finalized)
+    throw std::runtime_error("COO pattern has not been finalized.");
+  if (_offset != _values.size())
+  {
+    throw std::runtime_error("Number of values (" + std::to_string(_offset)
+                             + ") does not match the COO pattern ("
+                             + std::to_string(_values.size()) + ").");
+  }
+
+  PetscErrorCode ierr = MatSetValuesCOO(_matA, _values.data(), mode);
+  CHECK_ERROR("MatSetValuesCOO");
+  _offset = 0;
+}
+//-----------------------------------------------------------------------------
 double petsc::Matrix::norm(Norm norm_type) const
 {
   assert(_matA);
@@ -9,8 +9,11 @@
 
 #ifdef HAS_PETSC
 
+#include "MatrixCSR.h"
 #include "Vector.h"
 #include "utils.h"
+#include <algorithm>
+#include <array>
 #include <boost/lexical_cast.hpp>
 #include <functional>
 #include <optional>
@@ -19,6 +22,7 @@
 #include <petscoptions.h>
 #include <petscvec.h>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -121,6 +125,89 @@ void scatter_local_vectors(
 Mat create_matrix(MPI_Comm comm, const SparsityPattern& sp,
                   std::optional<std::string> type = std::nullopt);
 
+/// @brief Create a PETSc `MPIAIJ` matrix with the entries of a
+/// la::MatrixCSR.
+///
+/// The owned rows of `A` are split into the diagonal (owned columns)
+/// and off-diagonal (ghost columns) blocks using
+/// MatrixCSR::off_diag_offset, and the PETSc matrix is created with
+/// `MatCreateMPIAIJWithSplitArrays`, which uses the split arrays as its
+/// storage. The arrays are owned by the returned matrix. Matrices are
+/// therefore assembled with the DOLFINx MatrixCSR insertion functions,
+/// which avoid the search and hashing of `MatSetValues`, and the
+/// entries are transferred to PETSc by update_matrix, which is a
+/// single pass over the matrix entries.
+///
+/// @note Collective.
+/// @note The PETSc matrix has block size 1. Compact blocked matrices are
+/// expanded.
+/// @note The ghost rows of `A` are ignored, i.e. MatrixCSR::scatter_rev
+/// should be called before this function if `A` has been assembled.
+/// @note Caller is responsible for destroying the returned object.
+///
+/// @param[in] A Matrix to create the PETSc matrix from.
+/// @return A PETSc matrix with the same sparsity and entries as `A`.
+Mat create_matrix(const MatrixCSR<PetscScalar>& A);
+
+/// @brief Copy the entries of a la::MatrixCSR into a PETSc matrix that
+/// was created from a matrix with the same sparsity pattern by
+/// create_matrix(const MatrixCSR<PetscScalar>&).
+///
+/// @note Collective.
+/// @note The ghost rows of `A` are ignored.
+///
+/// @param[in,out] B PETSc matrix to update.
+/// @param[in] A Matrix to copy the entries from.
+void update_matrix(Mat B, const MatrixCSR<PetscScalar>& A);
+
+/// @brief Create a PETSc `MATSHELL` matrix that applies a matrix-free
+/// action.
+///
+/// The action is called by `MatMult` with the owned entries of the
+/// input and output PETSc vectors, which are accessed in place with
+/// `VecGetArrayRead` and `VecGetArray`, i.e. without a copy. The
+/// output entries must be overwritten, not accumulated into. The
+/// returned matrix can be used as an operator for
+/// SLEPcEigenSolver, e.g. with a shell spectral transformation or a
+/// solver that only requires matrix-vector products.
+///
+/// @note Collective.
+/// @note Caller is responsible for destroying the returned object.
+///
+/// @param[in] map0 Index map for the rows (range) of the operator.
+/// @param[in] bs0 Block size of `map0`.
+/// @param[in] map1 Index map for the columns (domain) of the operator.
+/// @param[in] bs1 Block size of `map1`.
+/// @param[in] action Function that computes `y = Ax` given the owned
+/// entries of `x` (first argument) and `y` (second argument).
+/// @return A PETSc shell matrix.
+Mat create_matrix_shell(
+    const common::IndexMap& map0, int bs0, const common::IndexMap& map1,
+    int bs1,
+    std::function<void(std::span<const PetscScalar>, std::span<PetscScalar>)>
+        action);
+
+/// @brief Create a PETSc `MATSHELL` matrix whose product is the
+/// product of a la::MatrixCSR.
+///
+/// The product is computed by MatrixCSR::mult, so the matrix entries
+/// are not copied into a PETSc matrix and changes to the entries of
+/// `A`, e.g. when `A` is re-assembled in a parameter sweep, are seen by
+/// the shell matrix without an update. The owned entries of the PETSc
+/// vectors are copied into ghosted work vectors, since the product
+/// requires the ghost entries of the input vector.
+///
+/// @note Collective.
+/// @note `A` must outlive the returned matrix.
+/// @note Caller is responsible for destroying the returned object.
+///
+/// @param[in] A Matrix to apply. The ghost rows must have been
+/// scattered, i.e. MatrixCSR::scatter_rev should be called before
+/// applying the shell matrix if `A` has been assembled.
+/// @param[in] num_threads Number of threads used by MatrixCSR::mult.
+/// @return A PETSc shell matrix.
+Mat create_matrix_shell(MatrixCSR<PetscScalar>& A, int num_threads = 1);
+
 /// Create PETSc MatNullSpace. Caller is responsible for destruction
 /// returned object.
 /// @param [in] comm The MPI communicator
@@ -447,6 +534,136 @@ public:
   void set_from_options();
 };
 
+/// @brief Insertion of values into a PETSc matrix through the PETSc COO
+/// interface (`MatSetPreallocationCOO` and `MatSetValuesCOO`).
+///
+/// The positions of the matrix entries are recorded once, by an
+/// assembly with the insertion function returned by record_fn(), e.g.
+/// fem::assemble_matrix and fem::set_diagonal of the forms and boundary
+/// conditions of a problem. After finalize(), an assembly with the
+/// function returned by set_fn() copies the element values to a single
+/// contiguous array, without any index translation or search, and
+/// assemble() passes the array to PETSc. This also supports assembly
+/// into PETSc GPU matrix types.
+///
+/// @warning An assembly with set_fn() must make the same calls, i.e.
+/// with the same number of rows and columns in the same order, as the
+/// recording assembly, e.g. assemble the same forms over the same
+/// integration domains. The values of the boundary conditions, constants
+/// and coefficients may change. The insertion functions refer to this
+/// object, which must outlive them and not be moved while they are in
+/// use.
+///
+/// @note The class is not exposed to Python. The insertion functions
+/// are C++ callables that are inlined into the C++ assemblers, and an
+/// insertion function called from Python for each cell would be slower
+/// than the existing PETSc insertion.
+class MatrixCOO : public Operator
+{
+public:
+  /// @brief Create a COO insertion object for a matrix.
+  /// @param[in] A Matrix to insert into. It must have a local-to-global
+  /// map, e.g. a matrix created by create_matrix. Its sparsity is
+  /// replaced by the recorded COO pattern.
+  /// @param[in] bs Block sizes of the row and column indices that are
+  /// passed to the insertion functions (`{1, 1}` for unblocked indices).
+  MatrixCOO(Mat A, std::array<int, 2> bs = {1, 1});
+
+  // Copy constructor (deleted)
+  MatrixCOO(const MatrixCOO& A) = delete;
+
+  /// Move constructor
+  MatrixCOO(MatrixCOO&& A) = default;
+
+  /// Destructor
+  ~MatrixCOO() = default;
+
+  // Assignment operator (deleted)
+  MatrixCOO& operator=(const MatrixCOO& A) = delete;
+
+  /// Move assignment operator
+  MatrixCOO& operator=(MatrixCOO&& A) = default;
+
+  /// @brief Return a function that records the positions of the values
+  /// that it is called with. The values are ignored.
+  auto record_fn()
+  {
+    return [this](std::span<const std::int32_t> rows,
+                  std::span<const std::int32_t> cols,
+                  std::span<const PetscScalar>) -> int
+    {
+      if (_finalized)
+        throw std::runtime_error("COO pattern has already been finalized.");
+      for (auto r : rows)
+      {
+        for (int k0 = 0; k0 < _bs[0]; ++k0)
+        {
+          for (auto c : cols)
+          {
+            for (int k1 = 0; k1 < _bs[1]; ++k1)
+            {
+              _rows.push_back(r * _bs[0] + k0);
+              _cols.push_back(c * _bs[1] + k1);
+            }
+          }
+        }
+      }
+      return 0;
+    };
+  }
+
+  /// @brief Set the COO pattern of the matrix to the recorded
+  /// positions.
+  /// @note Collective.
+  void finalize();
+
+  /// @brief Return a function that copies the values that it is called
+  /// with to the COO values array. Only the number of indices is used.
+  auto set_fn()
+  {
+    return [this](std::span<const std::int32_t> rows,
+                  std::span<const std::int32_t> cols,
+                  std::span<const PetscScalar> vals) -> int
+    {
+      const std::size_t n = rows.size() * cols.size() * _bs[0] * _bs[1];
+      if (_offset + n > _values.size())
+        throw std::runtime_error("Too many values for the COO pattern.");
+      std::copy_n(vals.begin(), n, std::next(_values.begin(), _offset));
+      _offset += n;
+      return 0;
+    };
+  }
+
+  /// @brief Pass the values inserted by the function returned by
+  /// set_fn() to the PETSc matrix (calls `MatSetValuesCOO`), and reset
+  /// the values array for the next assembly.
+  /// @note Collective.
+  /// @param[in] mode `INSERT_VALUES` to overwrite the matrix entries or
+  /// `ADD_VALUES` to add to them. Values at repeated positions are
+  /// summed in either case.
+  void assemble(InsertMode mode = INSERT_VALUES);
+
+  /// @brief Number of recorded positions.
+  std::size_t size() const
+  {
+    return _finalized ? _values.size() : _rows.size();
+  }
+
+private:
+  // Block sizes of the row and column indices
+  std::array<int, 2> _bs;
+
+  // Recorded local row and column indices
+  std::vector<PetscInt> _rows, _cols;
+
+  // COO values, and number of values inserted since the last assembly
+  std::vector<PetscScalar> _values;
+  std::size_t _offset = 0;
+
+  // True if the COO pattern has been set
+  bool _finalized = false;
+};
+
 /// This class implements Krylov methods for linear systems of the form
 /// Ax = b. It is a wrapper for the Krylov solvers of PETSc.
 class KrylovSolver
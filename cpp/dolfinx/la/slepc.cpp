@@ -11,8 +11,10 @@
 #include "utils.h"
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <algorithm>
 #include <petscmat.h>
 #include <slepcversion.h>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
@@ -58,6 +60,46 @@ void SLEPcEigenSolver::set_operators(const Mat A, const Mat B)
   EPSSetOperators(_eps, A, B);
 }
 //-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_initial_space(std::span<const Vec> basis)
+{
+  assert(_eps);
+  std::vector<Vec> _basis(basis.begin(), basis.end());
+  PetscErrorCode ierr
+      = EPSSetInitialSpace(_eps, _basis.size(), _basis.data());
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "EPSSetInitialSpace");
+}
+//-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_initial_space_from_eigenvectors(std::int64_t n)
+{
+  assert(_eps);
+  PetscInt num_conv = 0;
+  EPSGetConverged(_eps, &num_conv);
+  const PetscInt num_vectors = std::min<PetscInt>(n, num_conv);
+  if (num_vectors <= 0)
+    return;
+
+  Mat A, B;
+  EPSGetOperators(_eps, &A, &B);
+  std::vector<Vec> basis(num_vectors, nullptr);
+  PetscErrorCode ierr = 0;
+  for (PetscInt i = 0; i < num_vectors; ++i)
+  {
+    ierr = MatCreateVecs(A, &basis[i], nullptr);
+    if (ierr != 0)
+      petsc::error(ierr, __FILE__, "MatCreateVecs");
+    ierr = EPSGetEigenvector(_eps, i, basis[i], nullptr);
+    if (ierr != 0)
+      petsc::error(ierr, __FILE__, "EPSGetEigenvector");
+  }
+
+  ierr = EPSSetInitialSpace(_eps, num_vectors, basis.data());
+  for (Vec& v : basis)
+    VecDestroy(&v);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "EPSSetInitialSpace");
+}
+//-----------------------------------------------------------------------------
 void SLEPcEigenSolver::solve()
 {
   // Get operators
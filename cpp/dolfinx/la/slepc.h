@@ -13,6 +13,7 @@
 #include <petscmat.h>
 #include <petscvec.h>
 #include <slepceps.h>
+#include <span>
 #include <string>
 
 namespace dolfinx::la
@@ -46,8 +47,34 @@ public:
 
   /// Set operators (B may be nullptr for regular eigenvalues
   /// problems)
+  ///
+  /// The operators may be PETSc shell matrices, e.g. created by
+  /// petsc::create_matrix_shell. In a parameter sweep the solver can be
+  /// reused by setting new operators of the same size before each
+  /// solve, which keeps the solver type, the options and the
+  /// allocated work space of the eigensolver.
   void set_operators(const Mat A, const Mat B);
 
+  /// @brief Set the initial space of the eigensolver.
+  ///
+  /// The vectors are used as the starting vectors of the next solve
+  /// only, and are referenced by the solver, i.e. they can be
+  /// destroyed by the caller after this call.
+  /// @param[in] basis Vectors that span the initial space.
+  void set_initial_space(std::span<const Vec> basis);
+
+  /// @brief Set the initial space of the eigensolver to the converged
+  /// eigenvectors of the previous solve.
+  ///
+  /// In a parameter sweep, the eigenvectors of nearby parameters are
+  /// good starting vectors, which reduces the number of iterations of
+  /// the next solve compared with a random starting vector. If `n` is
+  /// greater than the number of converged eigenpairs, all converged
+  /// eigenvectors are used. For complex eigenpairs of a real problem
+  /// only the real parts are used.
+  /// @param[in] n Maximum number of eigenvectors to use.
+  void set_initial_space_from_eigenvectors(std::int64_t n);
+
   /// Compute all eigenpairs of the matrix A (solve \f$A x = \lambda x\f$)
   void solve();
 
@@ -0,0 +1,288 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "krylov.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <limits>
+#include <mpi.h>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/// @file smoothers.h
+/// @brief Polynomial smoothers for la::Vector.
+///
+/// The smoothers use only the action of a linear operator and its
+/// diagonal, and are therefore suited to matrix-free multigrid, e.g.
+/// with fem::MatrixFreeOperator and fem::MatrixFreeOperator::diagonal.
+/// Operators are applied as for the Krylov solvers in krylov.h.
+
+namespace dolfinx::la
+{
+namespace impl
+{
+/// @brief Pseudo-random number in `[-1, 1)` computed from an integer.
+///
+/// The SplitMix64 hash of `i` is used, so that a vector filled from the
+/// global indices of its entries does not depend on the number of
+/// processes.
+template <std::floating_point U>
+U pseudo_random(std::uint64_t i)
+{
+  std::uint64_t z = i + 0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  z ^= z >> 31;
+  return U(2) * static_cast<U>(z >> 11) * U(0x1.0p-53) - U(1);
+}
+
+/// @brief Smallest and largest eigenvalues of a symmetric tridiagonal
+/// matrix.
+///
+/// The eigenvalues are computed by bisection with Sturm sequence
+/// counts, starting from the Gershgorin bounds.
+///
+/// @param[in] a Diagonal of the matrix.
+/// @param[in] b Sub-diagonal of the matrix (size `a.size() - 1`).
+/// @return Smallest and largest eigenvalue.
+template <std::floating_point U>
+std::array<U, 2> tridiagonal_eigenvalue_range(std::span<const U> a,
+                                              std::span<const U> b)
+{
+  const std::size_t n = a.size();
+  assert(b.size() + 1 == n);
+
+  // Gershgorin bounds
+  U lo = std::numeric_limits<U>::max();
+  U hi = std::numeric_limits<U>::lowest();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    U r = (i > 0 ? std::abs(b[i - 1]) : 0) + (i + 1 < n ? std::abs(b[i]) : 0);
+    lo = std::min(lo, a[i] - r);
+    hi = std::max(hi, a[i] + r);
+  }
+
+  // Number of eigenvalues smaller than x
+  auto count = [&](U x)
+  {
+    std::size_t c = 0;
+    U q = 1;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      q = a[i] - x - (i > 0 ? b[i - 1] * b[i - 1] / q : 0);
+      if (q == 0)
+        q = std::numeric_limits<U>::min();
+      if (q < 0)
+        ++c;
+    }
+    return c;
+  };
+
+  // Eigenvalue k (in increasing order)
+  auto bisect = [&](std::size_t k)
+  {
+    U l = lo, h = hi;
+    for (int it = 0; it < 200; ++it)
+    {
+      U m = (l + h) / 2;
+      if (m <= l or m >= h)
+        break;
+      if (count(m) > k)
+        h = m;
+      else
+        l = m;
+    }
+    return (l + h) / 2;
+  };
+
+  return {bisect(0), bisect(n - 1)};
+}
+} // namespace impl
+
+/// @brief Estimate the smallest and largest eigenvalues of `D^{-1}A`,
+/// where `D` is the diagonal of `A`.
+///
+/// A few steps of the Lanczos method are applied, in the form of
+/// conjugate gradient iterations preconditioned with `D` for a
+/// right-hand side with pseudo-random entries. The eigenvalues of the
+/// Lanczos tridiagonal matrix, which is computed from the conjugate
+/// gradient coefficients, lie within the spectrum and approach its
+/// ends quickly. The largest eigenvalue is typically accurate to a few
+/// percent after 10 steps.
+///
+/// The operator must be self-adjoint and positive definite.
+///
+/// @note Collective MPI operation.
+///
+/// @param[in] A Linear operator (see krylov.h).
+/// @param[in] diagonal Diagonal of `A`. All owned entries must be
+/// non-zero.
+/// @param[in] k Number of Lanczos steps.
+/// @return Estimates of the smallest and the largest eigenvalue.
+template <class V, class Op>
+std::array<dolfinx::scalar_value_t<typename V::value_type>, 2>
+estimate_eigenvalues(Op&& A, const V& diagonal, int k)
+{
+  using T = typename V::value_type;
+  using U = typename dolfinx::scalar_value_t<T>;
+  MPI_Comm comm = diagonal.index_map()->comm();
+  const std::size_t n = impl::local_size(diagonal);
+
+  // Work vectors
+  V r(diagonal), z(diagonal), p(diagonal), w(diagonal);
+  std::span _r = r.mutable_array().first(n);
+  std::span _z = z.mutable_array().first(n);
+  std::span _p = p.mutable_array().first(n);
+  std::span _w = w.mutable_array().first(n);
+  std::span<const T> _d = diagonal.array().first(n);
+
+  // Pseudo-random right-hand side, and z = D^{-1} r
+  const std::uint64_t offset
+      = diagonal.bs() * diagonal.index_map()->local_range()[0];
+  T rz = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    _r[i] = impl::pseudo_random<U>(offset + i);
+    _z[i] = _r[i] / _d[i];
+    _p[i] = _z[i];
+    rz += impl::conj(_r[i]) * _z[i];
+  }
+  impl::allreduce_sum<T>({&rz, 1}, comm);
+
+  // Conjugate gradient coefficients
+  std::vector<U> alpha, beta;
+  for (int j = 0; j < k and std::real(rz) > 0; ++j)
+  {
+    impl::apply_operator(A, p, w);
+    T pw = impl::local_inner_product<T>(_p, _w);
+    impl::allreduce_sum<T>({&pw, 1}, comm);
+    if (std::real(pw) <= 0)
+      break;
+
+    const T a = rz / pw;
+    T rz1 = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      _r[i] -= a * _w[i];
+      _z[i] = _r[i] / _d[i];
+      rz1 += impl::conj(_r[i]) * _z[i];
+    }
+    impl::allreduce_sum<T>({&rz1, 1}, comm);
+
+    const T b = rz1 / rz;
+    for (std::size_t i = 0; i < n; ++i)
+      _p[i] = _z[i] + b * _p[i];
+    alpha.push_back(std::real(a));
+    beta.push_back(std::real(b));
+    rz = rz1;
+  }
+
+  if (alpha.empty())
+    throw std::runtime_error("Eigenvalue estimation failed.");
+
+  // Lanczos tridiagonal matrix
+  const std::size_t m = alpha.size();
+  std::vector<U> td(m), ts(m - 1);
+  for (std::size_t j = 0; j < m; ++j)
+  {
+    td[j] = 1 / alpha[j] + (j > 0 ? beta[j - 1] / alpha[j - 1] : 0);
+    if (j + 1 < m)
+      ts[j] = std::sqrt(beta[j]) / alpha[j];
+  }
+
+  return impl::tridiagonal_eigenvalue_range<U>(td, ts);
+}
+
+/// @brief Apply a Chebyshev smoother to `Ax = b`.
+///
+/// Applies `degree` iterations of the Chebyshev method, preconditioned
+/// with the diagonal `D` of `A`, which damps the error components of
+/// `D^{-1}A` with eigenvalues in `interval`. As a multigrid smoother,
+/// the interval is typically chosen from an estimate `lmax` of the
+/// largest eigenvalue (see estimate_eigenvalues), e.g. `{0.1 lmax, 1.1
+/// lmax}`.
+///
+/// Each iteration applies the operator once and does not compute inner
+/// products, so the smoother requires no global reductions.
+///
+/// @note Collective MPI operation.
+///
+/// @param[in,out] x Initial guess on entry, and the smoothed solution
+/// on return. The ghost values are updated on return.
+/// @param[in] b Right-hand side vector.
+/// @param[in] A Linear operator (see krylov.h).
+/// @param[in] diagonal Diagonal of `A`. All owned entries must be
+/// non-zero.
+/// @param[in] interval Eigenvalue interval `{lmin, lmax}` of `D^{-1}A`
+/// to damp, with `0 < lmin < lmax`.
+/// @param[in] degree Number of iterations (polynomial degree).
+template <class V, class Op>
+void chebyshev(
+    V& x, const V& b, Op&& A, const V& diagonal,
+    std::array<dolfinx::scalar_value_t<typename V::value_type>, 2> interval,
+    int degree)
+{
+  using T = typename V::value_type;
+  using U = typename dolfinx::scalar_value_t<T>;
+  auto [lmin, lmax] = interval;
+  if (degree < 1)
+    throw std::runtime_error("Chebyshev degree must be positive.");
+  if (!(lmin > 0 and lmin < lmax))
+    throw std::runtime_error("Invalid Chebyshev eigenvalue interval.");
+
+  const std::size_t n = impl::local_size(x);
+  const U theta = (lmax + lmin) / 2;
+  const U delta = (lmax - lmin) / 2;
+  const U sigma = theta / delta;
+  U rho = 1 / sigma;
+
+  // Work vectors
+  V r(b), d(b), w(b);
+  std::span _x = x.mutable_array().first(n);
+  std::span _r = r.mutable_array().first(n);
+  std::span _d = d.mutable_array().first(n);
+  std::span _w = w.mutable_array().first(n);
+  std::span<const T> _b = b.array().first(n);
+  std::span<const T> _diag = diagonal.array().first(n);
+
+  // Residual r = b - Ax and first update d = D^{-1} r / theta
+  impl::apply_operator(A, x, w);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    _r[i] = _b[i] - _w[i];
+    _d[i] = _r[i] / (theta * _diag[i]);
+  }
+
+  for (int k = 1;; ++k)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      _x[i] += _d[i];
+    if (k == degree)
+      break;
+
+    // r -= A d and d = rho_1 rho d + (2 rho_1 / delta) D^{-1} r
+    impl::apply_operator(A, d, w);
+    const U rho1 = 1 / (2 * sigma - rho);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      _r[i] -= _w[i];
+      _d[i] = rho1 * rho * _d[i] + (2 * rho1 / delta) * _r[i] / _diag[i];
+    }
+    rho = rho1;
+  }
+
+  x.scatter_fwd();
+}
+} // namespace dolfinx::la
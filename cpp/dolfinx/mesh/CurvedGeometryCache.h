@@ -0,0 +1,245 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Geometry.h"
+#include "Mesh.h"
+#include "cell_types.h"
+#include <algorithm>
+#include <array>
+#include <basix/mdspan.hpp>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/threads.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+/// @brief Precomputed bounds and linearisations of the cells of a mesh
+/// with a non-affine (e.g. higher-order) coordinate element.
+///
+/// For each cell (including ghosts) the cache stores
+/// - the bounding box of the Bernstein control points of the cell
+///   (lower and upper corners), which encloses the curved cell, see
+///   fem::CoordinateElement::bernstein_matrix, and
+/// - the physical midpoint `x_m` of the cell and the inverse `K_m`
+///   (shape `(tdim, gdim)`) of the Jacobian at the reference midpoint
+///   `X_m`,
+///
+/// contiguously, in this order and row-major. The linearisation gives
+/// the initial guess `X_m + K_m (x - x_m)` of the Newton iterations of
+/// fem::CoordinateElement::pull_back_nonaffine. This guess is exact for
+/// affine cells and close to the solution for mildly curved cells, so
+/// few iterations are needed, e.g. in fem::Function::eval (see
+/// fem::EvalWorkspace::set_curved_geometry_cache).
+///
+/// The cache is computed by update(), which recomputes it only if the
+/// mesh coordinates may have changed since the last update (see
+/// Geometry::x_version).
+///
+/// @tparam T Mesh geometry floating type.
+template <std::floating_point T>
+class CurvedGeometryCache
+{
+public:
+  /// @brief Create an empty cache for a mesh.
+  ///
+  /// The cache is computed by the first call of update().
+  ///
+  /// @param[in] mesh The mesh. It must have a single coordinate element
+  /// and its cells must be intervals, triangles, tetrahedra,
+  /// quadrilaterals or hexahedra, see supported().
+  explicit CurvedGeometryCache(std::shared_ptr<const Mesh<T>> mesh)
+      : _mesh(mesh)
+  {
+    if (!supported(*_mesh))
+    {
+      throw std::runtime_error("CurvedGeometryCache requires a mesh with one "
+                               "coordinate element and no prisms or "
+                               "pyramids.");
+    }
+  }
+
+  /// @brief Check if a mesh is supported, i.e. if it has a single
+  /// coordinate element for which the Bernstein representation is
+  /// implemented.
+  /// @param[in] mesh The mesh.
+  /// @return True if a CurvedGeometryCache can be created for `mesh`.
+  static bool supported(const Mesh<T>& mesh)
+  {
+    const auto& cmaps = mesh.geometry().cmaps();
+    if (cmaps.size() != 1)
+      return false;
+    CellType cell = cmaps.front().cell_shape();
+    return cell != CellType::prism and cell != CellType::pyramid;
+  }
+
+  /// @brief The mesh.
+  std::shared_ptr<const Mesh<T>> mesh() const { return _mesh; }
+
+  /// @brief Check if the cache must be recomputed, i.e. if it has not
+  /// been computed or the mesh coordinates may have changed.
+  bool stale() const
+  {
+    return !_version or *_version != _mesh->geometry().x_version();
+  }
+
+  /// @brief Compute the cache if it is stale.
+  /// @param[in] num_threads Number of threads.
+  void update(int num_threads = 1)
+  {
+    if (!stale())
+      return;
+
+    const Geometry<T>& geometry = _mesh->geometry();
+    const fem::CoordinateElement<T>& cmap = geometry.cmap();
+    const std::size_t gdim = geometry.dim();
+    const std::size_t tdim = _mesh->topology()->dim();
+    const std::size_t stride = this->stride();
+    auto x_dofmap = geometry.dofmap();
+    std::span<const T> x = geometry.x();
+    const std::size_t num_cells = x_dofmap.extent(0);
+    const std::size_t num_dofs_g = x_dofmap.extent(1);
+
+    // Map from the nodes to the Bernstein control points
+    const std::vector<T> M = cmap.bernstein_matrix();
+    assert(M.size() == num_dofs_g * num_dofs_g);
+
+    // Geometry basis and its derivatives at the reference midpoint
+    const bool simplex = is_simplex(cmap.cell_shape());
+    _X_m.assign(tdim, simplex ? T(1) / (tdim + 1) : T(0.5));
+    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, 1);
+    std::vector<T> phi_b(phi_shape[0] * phi_shape[1] * phi_shape[2]
+                         * phi_shape[3]);
+    cmap.tabulate(1, _X_m, {1, tdim}, phi_b);
+    md::mdspan<const T, md::dextents<std::size_t, 4>> phi(phi_b.data(),
+                                                          phi_shape);
+    auto dphi = md::submdspan(phi, std::pair(1, tdim + 1), 0, md::full_extent,
+                              0);
+
+    _data.resize(num_cells * stride);
+    common::parallel_for(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
+        {
+          std::vector<T> cdofs_b(num_dofs_g * gdim);
+          std::vector<T> J_b(gdim * tdim);
+          md::mdspan<T, md::dextents<std::size_t, 2>> cdofs(
+              cdofs_b.data(), num_dofs_g, gdim);
+          md::mdspan<T, md::dextents<std::size_t, 2>> J(J_b.data(), gdim,
+                                                        tdim);
+          for (std::size_t c = c0; c < c1; ++c)
+          {
+            for (std::size_t i = 0; i < num_dofs_g; ++i)
+            {
+              std::copy_n(std::next(x.begin(), 3 * x_dofmap(c, i)), gdim,
+                          std::next(cdofs_b.begin(), i * gdim));
+            }
+
+            T* data = _data.data() + c * stride;
+            std::fill_n(data, stride, 0);
+
+            // Bounding box of the control points
+            std::fill_n(data, 3, std::numeric_limits<T>::max());
+            std::fill_n(data + 3, 3, std::numeric_limits<T>::lowest());
+            if (gdim < 3)
+            {
+              std::fill_n(data + gdim, 3 - gdim, 0);
+              std::fill_n(data + 3 + gdim, 3 - gdim, 0);
+            }
+            for (std::size_t i = 0; i < num_dofs_g; ++i)
+            {
+              for (std::size_t j = 0; j < gdim; ++j)
+              {
+                T cp = 0;
+                for (std::size_t k = 0; k < num_dofs_g; ++k)
+                  cp += M[i * num_dofs_g + k] * cdofs(k, j);
+                data[j] = std::min(data[j], cp);
+                data[3 + j] = std::max(data[3 + j], cp);
+              }
+            }
+
+            // Midpoint and inverse Jacobian at the midpoint
+            T* x_m = data + 6;
+            for (std::size_t i = 0; i < num_dofs_g; ++i)
+              for (std::size_t j = 0; j < gdim; ++j)
+                x_m[j] += phi(0, 0, i, 0) * cdofs(i, j);
+            md::mdspan<T, md::dextents<std::size_t, 2>> K(x_m + gdim, tdim,
+                                                          gdim);
+            std::ranges::fill(J_b, 0);
+            fem::CoordinateElement<T>::compute_jacobian(dphi, cdofs, J);
+            fem::CoordinateElement<T>::compute_jacobian_inverse(J, K);
+          }
+        });
+
+    _version = geometry.x_version();
+  }
+
+  /// @brief Number of values stored per cell (`6 + gdim + tdim gdim`).
+  std::size_t stride() const
+  {
+    const std::size_t gdim = _mesh->geometry().dim();
+    return 6 + gdim + _mesh->topology()->dim() * gdim;
+  }
+
+  /// @brief Cached data of all cells (see stride()).
+  /// @pre The cache is up to date (see update()).
+  std::span<const T> data() const { return _data; }
+
+  /// @brief Bounding box of a cell, which encloses the cell.
+  /// @param[in] cell Local cell index.
+  /// @return Lower and upper corner of the box.
+  std::span<const T, 6> bbox(std::int32_t cell) const
+  {
+    return std::span<const T, 6>(_data.data() + cell * stride(), 6);
+  }
+
+  /// @brief Compute the initial guess of the reference coordinates of a
+  /// point in a cell, from the linearisation of the cell at its
+  /// midpoint.
+  /// @param[in] cell Local cell index.
+  /// @param[in] x Physical coordinates of the point (`size=gdim`).
+  /// @param[out] X Initial guess of the reference coordinates
+  /// (`size=tdim`).
+  void initial_guess(std::int32_t cell, std::span<const T> x,
+                     std::span<T> X) const
+  {
+    const std::size_t gdim = _mesh->geometry().dim();
+    const T* x_m = _data.data() + cell * stride() + 6;
+    const T* K = x_m + gdim;
+    for (std::size_t i = 0; i < _X_m.size(); ++i)
+    {
+      X[i] = _X_m[i];
+      for (std::size_t j = 0; j < gdim; ++j)
+        X[i] += K[i * gdim + j] * (x[j] - x_m[j]);
+    }
+  }
+
+private:
+  // The mesh
+  std::shared_ptr<const Mesh<T>> _mesh;
+
+  // Bounding box, midpoint and inverse Jacobian of each cell
+  std::vector<T> _data;
+
+  // Reference midpoint
+  std::vector<T> _X_m;
+
+  // Coordinate version that the cache was computed for, unset if not
+  // computed
+  std::optional<std::uint64_t> _version;
+};
+} // namespace dolfinx::mesh
@@ -10,10 +10,12 @@
 #include <algorithm>
 #include <basix/mdspan.hpp>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/sort.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/ElementDofLayout.h>
 #include <dolfinx/fem/dofmapbuilder.h>
@@ -145,9 +147,24 @@ public:
   /// @brief Access geometry degrees-of-freedom data (non-const
   /// version).
   ///
+  /// Each call increments x_version(), since the coordinates may be
+  /// changed through the returned span.
+  ///
   /// @return The flattened row-major geometry data, where the shape is
   /// `(num_points, 3)`.
-  std::span<value_type> x() { return _x; }
+  std::span<value_type> x()
+  {
+    ++_x_version;
+    return _x;
+  }
+
+  /// @brief Version of the coordinates.
+  ///
+  /// The version is incremented by each non-const access to the
+  /// coordinates (see x()), so that data computed from the coordinates,
+  /// e.g. by mesh::GeometryCache, can be detected as stale.
+  /// @return Coordinate version.
+  std::uint64_t x_version() const { return _x_version; }
 
   /// @brief The elements that describes the geometry map.
   ///
@@ -176,6 +193,20 @@ public:
     return _input_global_indices;
   }
 
+  /// @brief Memory used by the geometry.
+  /// @return Number of bytes of the coordinates, dofmaps, input global
+  /// indices and index map.
+  std::size_t memory_usage() const
+  {
+    std::size_t bytes = sizeof(value_type) * _x.size()
+                        + sizeof(std::int64_t) * _input_global_indices.size();
+    for (auto& dofmap : _dofmaps)
+      bytes += sizeof(std::int32_t) * dofmap.size();
+    if (_index_map)
+      bytes += _index_map->memory_usage();
+    return bytes;
+  }
+
 private:
   // Geometric dimension
   int _dim;
@@ -195,6 +226,9 @@ private:
 
   // Global indices as provided on Geometry creation
   std::vector<std::int64_t> _input_global_indices;
+
+  // Number of non-const accesses to _x
+  std::uint64_t _x_version = 0;
 };
 
 /// @cond
@@ -229,6 +263,10 @@ Geometry(std::shared_ptr<const common::IndexMap>, U&&,
 /// @param[in] dim Geometric dimension (1, 2, or 3).
 /// @param[in] reorder_fn Function for re-ordering the degree-of-freedom
 /// map associated with the geometry data.
+/// @param[in] num_threads Number of threads used for the local passes
+/// over the dofmap and the nodes, i.e. the dofmap permutation, the
+/// local-to-global and local-to-local maps, and the copy of the node
+/// coordinates.
 /// @note Experimental new interface for multiple cmap/dofmap
 /// @return A mesh geometry.
 template <typename U>
@@ -241,7 +279,8 @@ create_geometry(
     const U& x, int dim,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
         reorder_fn
-    = nullptr)
+    = nullptr,
+    int num_threads = 1)
 {
   spdlog::info("Create Geometry (multiple)");
 
@@ -275,11 +314,16 @@ create_geometry(
     const std::vector<std::uint32_t>& cell_info
         = topology.get_cell_permutation_info();
     int d = elements.front().dim();
-    for (std::int32_t cell = 0; cell < num_cells; ++cell)
-    {
-      std::span dofs(dofmaps.front().data() + cell * d, d);
-      elements.front().permute_inv(dofs, cell_info[cell]);
-    }
+    common::parallel_for(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
+        {
+          for (std::size_t cell = c0; cell < c1; ++cell)
+          {
+            std::span dofs(dofmaps.front().data() + cell * d, d);
+            elements.front().permute_inv(dofs, cell_info[cell]);
+          }
+        });
   }
 
   spdlog::info("Calling compute_local_to_global");
@@ -302,23 +346,33 @@ create_geometry(
   spdlog::info("nodes.size = {}", nodes.size());
 
   const std::vector<std::int32_t> l2l = graph::build::compute_local_to_local(
-      graph::build::compute_local_to_global(xdofs, all_dofmaps), nodes);
+      graph::build::compute_local_to_global(xdofs, all_dofmaps, num_threads),
+      nodes, num_threads);
 
   // Allocate space for input global indices and copy data
   std::vector<std::int64_t> igi(nodes.size());
-  std::ranges::transform(l2l, igi.begin(),
-                         [&nodes](auto index) { return nodes[index]; });
+  common::parallel_for(igi.size(), num_threads,
+                       [&](std::size_t i0, std::size_t i1)
+                       {
+                         for (std::size_t i = i0; i < i1; ++i)
+                           igi[i] = nodes[l2l[i]];
+                       });
 
   // Build coordinate dof array, copying coordinates to correct position
   assert(x.size() % dim == 0);
   const std::size_t shape0 = x.size() / dim;
   const std::size_t shape1 = dim;
   std::vector<T> xg(3 * shape0, 0);
-  for (std::size_t i = 0; i < shape0; ++i)
-  {
-    std::copy_n(std::next(x.begin(), shape1 * l2l[i]), shape1,
-                std::next(xg.begin(), 3 * i));
-  }
+  common::parallel_for(
+      shape0, num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          std::copy_n(std::next(x.begin(), shape1 * l2l[i]), shape1,
+                      std::next(xg.begin(), 3 * i));
+        }
+      });
 
   spdlog::info("Creating geometry with {} dofmaps", dof_layouts.size());
 
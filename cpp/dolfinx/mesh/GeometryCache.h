@@ -0,0 +1,196 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Geometry.h"
+#include "Mesh.h"
+#include <algorithm>
+#include <array>
+#include <basix/mdspan.hpp>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/threads.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+/// @brief Precomputed Jacobians of the cells of a mesh with an affine
+/// coordinate element.
+///
+/// For each cell (including ghosts) the Jacobian `J` (shape `(gdim,
+/// tdim)`), its (pseudo-)inverse `K` (shape `(tdim, gdim)`) and the
+/// determinant `detJ` are stored contiguously, in this order and
+/// row-major. These quantities are constant on affine cells, and the
+/// cache avoids recomputing them for every evaluation, e.g. in
+/// fem::Function::eval (see fem::EvalWorkspace::set_geometry_cache).
+/// The data of cell `c` start at `c * stride()`, so that the array can
+/// also be passed to kernels that read cell geometry from custom data.
+///
+/// The cache is computed by update(), which recomputes it only if the
+/// mesh coordinates may have changed since the last update (see
+/// Geometry::x_version).
+///
+/// @tparam T Mesh geometry floating type.
+template <std::floating_point T>
+class GeometryCache
+{
+public:
+  /// @brief Create an empty cache for a mesh.
+  ///
+  /// The cache is computed by the first call of update().
+  ///
+  /// @param[in] mesh The mesh. It must have a single affine coordinate
+  /// element, see supported().
+  explicit GeometryCache(std::shared_ptr<const Mesh<T>> mesh) : _mesh(mesh)
+  {
+    if (!supported(*_mesh))
+    {
+      throw std::runtime_error(
+          "GeometryCache requires a mesh with one affine coordinate element.");
+    }
+  }
+
+  /// @brief Check if a mesh is supported, i.e. if it has a single
+  /// affine coordinate element.
+  /// @param[in] mesh The mesh.
+  /// @return True if a GeometryCache can be created for `mesh`.
+  static bool supported(const Mesh<T>& mesh)
+  {
+    const auto& cmaps = mesh.geometry().cmaps();
+    return cmaps.size() == 1 and cmaps.front().is_affine();
+  }
+
+  /// @brief The mesh.
+  std::shared_ptr<const Mesh<T>> mesh() const { return _mesh; }
+
+  /// @brief Check if the cache must be recomputed, i.e. if it has not
+  /// been computed or the mesh coordinates may have changed.
+  bool stale() const
+  {
+    return !_version or *_version != _mesh->geometry().x_version();
+  }
+
+  /// @brief Compute the cache if it is stale.
+  /// @param[in] num_threads Number of threads.
+  void update(int num_threads = 1)
+  {
+    if (!stale())
+      return;
+
+    const Geometry<T>& geometry = _mesh->geometry();
+    const fem::CoordinateElement<T>& cmap = geometry.cmap();
+    const std::size_t gdim = geometry.dim();
+    const std::size_t tdim = _mesh->topology()->dim();
+    const std::size_t stride = this->stride();
+    auto x_dofmap = geometry.dofmap();
+    std::span<const T> x = geometry.x();
+    const std::size_t num_cells = x_dofmap.extent(0);
+    const std::size_t num_dofs_g = x_dofmap.extent(1);
+
+    // Derivatives of the geometry basis, which are constant for an
+    // affine element
+    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, 1);
+    std::vector<T> phi_b(phi_shape[0] * phi_shape[1] * phi_shape[2]
+                         * phi_shape[3]);
+    const std::array<T, 3> X0 = {0, 0, 0};
+    cmap.tabulate(1, std::span(X0.data(), tdim), {1, tdim}, phi_b);
+    md::mdspan<const T, md::dextents<std::size_t, 4>> phi(phi_b.data(),
+                                                          phi_shape);
+    auto dphi = md::submdspan(phi, std::pair(1, tdim + 1), 0, md::full_extent,
+                              0);
+
+    _data.resize(num_cells * stride);
+    common::parallel_for(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
+        {
+          std::vector<T> cdofs_b(num_dofs_g * gdim);
+          std::vector<T> scratch(2 * gdim * tdim);
+          md::mdspan<T, md::dextents<std::size_t, 2>> cdofs(
+              cdofs_b.data(), num_dofs_g, gdim);
+          for (std::size_t c = c0; c < c1; ++c)
+          {
+            for (std::size_t i = 0; i < num_dofs_g; ++i)
+            {
+              std::copy_n(std::next(x.begin(), 3 * x_dofmap(c, i)), gdim,
+                          std::next(cdofs_b.begin(), i * gdim));
+            }
+
+            T* data = _data.data() + c * stride;
+            md::mdspan<T, md::dextents<std::size_t, 2>> J(data, gdim, tdim);
+            md::mdspan<T, md::dextents<std::size_t, 2>> K(
+                data + gdim * tdim, tdim, gdim);
+            std::fill_n(data, stride, 0);
+            fem::CoordinateElement<T>::compute_jacobian(dphi, cdofs, J);
+            fem::CoordinateElement<T>::compute_jacobian_inverse(J, K);
+            data[2 * gdim * tdim]
+                = fem::CoordinateElement<T>::compute_jacobian_determinant(
+                    J, std::span(scratch));
+          }
+        });
+
+    _version = geometry.x_version();
+  }
+
+  /// @brief Number of values stored per cell (`2 gdim tdim + 1`).
+  std::size_t stride() const
+  {
+    return 2 * _mesh->geometry().dim() * _mesh->topology()->dim() + 1;
+  }
+
+  /// @brief Cached data of all cells (see stride()).
+  /// @pre The cache is up to date (see update()).
+  std::span<const T> data() const { return _data; }
+
+  /// @brief Jacobian of a cell.
+  /// @param[in] cell Local cell index.
+  /// @return Jacobian, with shape `(gdim, tdim)`.
+  md::mdspan<const T, md::dextents<std::size_t, 2>> J(std::int32_t cell) const
+  {
+    return md::mdspan<const T, md::dextents<std::size_t, 2>>(
+        _data.data() + cell * stride(), _mesh->geometry().dim(),
+        _mesh->topology()->dim());
+  }
+
+  /// @brief Inverse of the Jacobian of a cell.
+  /// @param[in] cell Local cell index.
+  /// @return Inverse Jacobian, with shape `(tdim, gdim)`.
+  md::mdspan<const T, md::dextents<std::size_t, 2>> K(std::int32_t cell) const
+  {
+    const std::size_t gdim = _mesh->geometry().dim();
+    const std::size_t tdim = _mesh->topology()->dim();
+    return md::mdspan<const T, md::dextents<std::size_t, 2>>(
+        _data.data() + cell * stride() + gdim * tdim, tdim, gdim);
+  }
+
+  /// @brief Determinant of the Jacobian of a cell (the pseudo
+  /// determinant for manifolds).
+  /// @param[in] cell Local cell index.
+  T detJ(std::int32_t cell) const
+  {
+    return _data[(cell + 1) * stride() - 1];
+  }
+
+private:
+  // The mesh
+  std::shared_ptr<const Mesh<T>> _mesh;
+
+  // J, K and detJ of each cell
+  std::vector<T> _data;
+
+  // Coordinate version that the cache was computed for, unset if not
+  // computed
+  std::optional<std::uint64_t> _version;
+};
+} // namespace dolfinx::mesh
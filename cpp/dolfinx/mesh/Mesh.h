@@ -8,6 +8,7 @@
 
 #include "Geometry.h"
 #include <concepts>
+#include <cstddef>
 #include <dolfinx/common/MPI.h>
 #include <string>
 
@@ -83,6 +84,20 @@ public:
   /// @return The geometry object associated with the mesh.
   const Geometry<T>& geometry() const { return _geometry; }
 
+  /// @brief Memory used by the mesh topology and geometry.
+  ///
+  /// An index map that is shared by the topology and the geometry
+  /// (e.g. for affine meshes) is counted once.
+  /// @return Number of bytes.
+  std::size_t memory_usage() const
+  {
+    std::size_t bytes = _topology->memory_usage() + _geometry.memory_usage();
+    auto map = _geometry.index_map();
+    if (map and map == _topology->index_map(0))
+      bytes -= map->memory_usage();
+    return bytes;
+  }
+
   /// @brief Mesh MPI communicator.
   /// @return The communicator on which the mesh is distributed.
   MPI_Comm comm() const { return _comm.comm(); }
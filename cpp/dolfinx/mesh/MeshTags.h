@@ -14,6 +14,7 @@
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/io/cells.h>
 #include <memory>
+#include <numeric>
 #include <span>
 #include <utility>
 #include <vector>
@@ -63,6 +64,24 @@ public:
     if (std::adjacent_find(_indices.begin(), _indices.end()) != _indices.end())
       throw std::runtime_error("MeshTag data has duplicates");
 #endif
+
+    // Group the entity indices by tag value. The sort is stable, so the
+    // indices of each value remain sorted.
+    std::vector<std::int32_t> perm(_values.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::ranges::stable_sort(perm, [&v = _values](auto a, auto b)
+                             { return v[a] < v[b]; });
+    _value_indices.reserve(perm.size());
+    for (std::size_t i = 0; i < perm.size(); ++i)
+    {
+      if (i == 0 or _values[perm[i]] != _values[perm[i - 1]])
+      {
+        _unique_values.push_back(_values[perm[i]]);
+        _value_offsets.push_back(i);
+      }
+      _value_indices.push_back(_indices[perm[i]]);
+    }
+    _value_offsets.push_back(perm.size());
   }
 
   /// Copy constructor
@@ -81,21 +100,27 @@ public:
   MeshTags& operator=(MeshTags&& tags) = default;
 
   /// @brief Find all entities with a given tag value
+  ///
+  /// The entities are looked up in an index of the tag values that is
+  /// built when the MeshTags is created, so the cost is logarithmic in
+  /// the number of distinct values plus the size of the result.
+  ///
   /// @param[in] value The value
   /// @return Indices of tagged entities. The indices are sorted.
   std::vector<std::int32_t> find(const T value) const
   {
-    std::size_t n = std::count(_values.begin(), _values.end(), value);
-    std::vector<std::int32_t> indices;
-    indices.reserve(n);
-    for (std::size_t i = 0; i < _values.size(); ++i)
-    {
-      if (_values[i] == value)
-        indices.push_back(_indices[i]);
-    }
-    return indices;
+    auto it = std::ranges::lower_bound(_unique_values, value);
+    if (it == _unique_values.end() or *it != value)
+      return {};
+    std::size_t pos = std::distance(_unique_values.begin(), it);
+    return std::vector<std::int32_t>(
+        std::next(_value_indices.begin(), _value_offsets[pos]),
+        std::next(_value_indices.begin(), _value_offsets[pos + 1]));
   }
 
+  /// @brief Distinct tag values (sorted).
+  std::span<const T> unique_values() const { return _unique_values; }
+
   /// Indices of tagged topology entities (local-to-process). The
   /// indices are sorted.
   std::span<const std::int32_t> indices() const { return _indices; }
@@ -124,6 +149,13 @@ private:
 
   // Values attached to entities
   std::vector<T> _values;
+
+  // Distinct values (sorted), and the indices of the entities with
+  // value _unique_values[i] are _value_indices[_value_offsets[i]:
+  // _value_offsets[i + 1]]
+  std::vector<T> _unique_values;
+  std::vector<std::int32_t> _value_offsets;
+  std::vector<std::int32_t> _value_indices;
 };
 
 /// @brief Create MeshTags from arrays
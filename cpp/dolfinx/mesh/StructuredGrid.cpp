@@ -0,0 +1,167 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "StructuredGrid.h"
+#include <algorithm>
+#include <iterator>
+
+using namespace dolfinx;
+using namespace dolfinx::mesh;
+
+namespace
+{
+/// Lexicographic index (x fastest) of `idx` in the block `r`
+std::int64_t lex_index(const std::array<std::array<std::int64_t, 2>, 3>& r,
+                       const std::array<std::int64_t, 3>& idx)
+{
+  return ((idx[2] - r[2][0]) * (r[1][1] - r[1][0]) + (idx[1] - r[1][0]))
+             * (r[0][1] - r[0][0])
+         + (idx[0] - r[0][0]);
+}
+
+/// Index in the block `r` of the lexicographic index `i`
+std::array<std::int64_t, 3>
+block_index(const std::array<std::array<std::int64_t, 2>, 3>& r,
+            std::int64_t i)
+{
+  const std::int64_t n0 = r[0][1] - r[0][0];
+  const std::int64_t n1 = r[1][1] - r[1][0];
+  return {r[0][0] + i % n0, r[1][0] + (i / n0) % n1, r[2][0] + i / (n0 * n1)};
+}
+
+/// Check if `idx` is in the block `r`
+bool in_block(const std::array<std::array<std::int64_t, 2>, 3>& r,
+              const std::array<std::int64_t, 3>& idx)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    if (idx[i] < r[i][0] or idx[i] >= r[i][1])
+      return false;
+  }
+  return true;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+StructuredGrid::StructuredGrid(
+    CellType cell_type, std::array<std::array<std::int64_t, 2>, 3> cells_owned,
+    std::array<std::array<std::int64_t, 2>, 3> cells_local,
+    std::vector<std::int32_t> vertex_index)
+    : _cell_type(cell_type), _cells_owned(cells_owned),
+      _cells_local(cells_local), _vertex_index(std::move(vertex_index))
+{
+  switch (cell_type)
+  {
+  case CellType::triangle:
+    _sub_cells = {0, 1, 3, 0, 2, 3};
+    break;
+  case CellType::quadrilateral:
+    _sub_cells = {0, 1, 2, 3};
+    break;
+  case CellType::tetrahedron:
+    _sub_cells = {0, 1, 3, 7, 0, 1, 7, 5, 0, 5, 7, 4,
+                  0, 3, 2, 7, 0, 6, 4, 7, 0, 2, 6, 7};
+    break;
+  case CellType::prism:
+    _sub_cells = {0, 1, 2, 4, 5, 6, 1, 2, 3, 5, 6, 7};
+    break;
+  case CellType::hexahedron:
+    _sub_cells = {0, 1, 2, 3, 4, 5, 6, 7};
+    break;
+  default:
+    throw std::runtime_error("Unsupported cell type for a structured grid.");
+  }
+  _num_sub_cells = _sub_cells.size() / cell_num_entities(cell_type, 0);
+
+  const int tdim = cell_dim(cell_type);
+  _num_owned = 1;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (cells_owned[i][0] < cells_local[i][0]
+        or cells_owned[i][1] > cells_local[i][1])
+    {
+      throw std::runtime_error("Owned grid cells are not local.");
+    }
+    _num_owned *= cells_owned[i][1] - cells_owned[i][0];
+    _vertex_shape[i]
+        = cells_local[i][1] - cells_local[i][0] + (i < tdim ? 1 : 0);
+  }
+
+  if (_vertex_index.size() != static_cast<std::size_t>(
+          _vertex_shape[0] * _vertex_shape[1] * _vertex_shape[2]))
+  {
+    throw std::runtime_error("Wrong number of grid vertices.");
+  }
+
+  // Ghost grid cells, in lexicographic order
+  const std::int64_t num_local = (cells_local[0][1] - cells_local[0][0])
+                                 * (cells_local[1][1] - cells_local[1][0])
+                                 * (cells_local[2][1] - cells_local[2][0]);
+  for (std::int64_t i = 0; i < num_local; ++i)
+  {
+    if (!in_block(cells_owned, block_index(cells_local, i)))
+      _ghosts.push_back(i);
+  }
+}
+//-----------------------------------------------------------------------------
+std::array<std::int64_t, 3> StructuredGrid::grid_index(std::int32_t c) const
+{
+  const std::int32_t g = c / _num_sub_cells;
+  if (g < _num_owned)
+    return block_index(_cells_owned, g);
+  else
+    return block_index(_cells_local, _ghosts[g - _num_owned]);
+}
+//-----------------------------------------------------------------------------
+std::int32_t StructuredGrid::local_cell(std::array<std::int64_t, 3> idx) const
+{
+  if (!in_block(_cells_local, idx))
+    return -1;
+  else if (in_block(_cells_owned, idx))
+    return _num_sub_cells * lex_index(_cells_owned, idx);
+  else
+  {
+    auto it = std::ranges::lower_bound(_ghosts, lex_index(_cells_local, idx));
+    return _num_sub_cells
+           * (_num_owned + std::distance(_ghosts.begin(), it));
+  }
+}
+//-----------------------------------------------------------------------------
+std::array<std::int32_t, 8>
+StructuredGrid::corner_vertices(std::int32_t g) const
+{
+  const std::array<std::int64_t, 3> idx = grid_index(g * _num_sub_cells);
+  const std::array<std::int64_t, 3> v0
+      = {idx[0] - _cells_local[0][0], idx[1] - _cells_local[1][0],
+         idx[2] - _cells_local[2][0]};
+  const int num_corners = 1 << cell_dim(_cell_type);
+  std::array<std::int32_t, 8> corners;
+  for (int k = 0; k < num_corners; ++k)
+  {
+    std::int64_t v = ((v0[2] + (k >> 2)) * _vertex_shape[1]
+                      + (v0[1] + ((k >> 1) & 1)))
+                         * _vertex_shape[0]
+                     + (v0[0] + (k & 1));
+    corners[k] = _vertex_index[v];
+  }
+  return corners;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> StructuredGrid::cells() const
+{
+  const int num_cell_vertices = cell_num_entities(_cell_type, 0);
+  std::vector<std::int32_t> cells;
+  cells.reserve(num_cells() * num_cell_vertices);
+  const std::int32_t num_grid_cells = num_cells() / _num_sub_cells;
+  for (std::int32_t g = 0; g < num_grid_cells; ++g)
+  {
+    const std::array<std::int32_t, 8> corners = corner_vertices(g);
+    for (int v : _sub_cells)
+      cells.push_back(corners[v]);
+  }
+  return cells;
+}
+//-----------------------------------------------------------------------------
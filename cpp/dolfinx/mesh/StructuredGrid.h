@@ -0,0 +1,222 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "cell_types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+
+/// @brief Process-local block of a structured (Cartesian) grid.
+///
+/// The cells of a mesh on a structured grid are the grid cells, or a
+/// fixed subdivision of each grid cell (e.g. six tetrahedra per grid
+/// cell). A StructuredGrid describes the local grid cells of a process
+/// by index ranges, from which the cell-to-vertex connectivity and the
+/// cell neighbours across facets are computed arithmetically, i.e.
+/// without storing them. The connectivities are exposed through views
+/// with the `num_nodes()`/`num_links()`/`links()` interface of
+/// graph::AdjacencyList, so that code that is generic over the
+/// adjacency type can specialise on structured meshes.
+///
+/// The local cells are numbered with the cells of the owned grid cells
+/// first, in lexicographic order (x fastest) of the grid cells, followed
+/// by the cells of the ghost grid cells in lexicographic order. The
+/// sub-cells of a grid cell are numbered consecutively.
+class StructuredGrid
+{
+public:
+  /// @brief Create a structured grid block.
+  /// @param[in] cell_type Cell type of the mesh. For simplices and
+  /// prisms each grid cell is subdivided as in mesh::create_box and
+  /// mesh::create_rectangle (DiagonalType::right).
+  /// @param[in] cells_owned Range `[i0, i1)` of the owned grid cells in
+  /// each direction. For a 2D grid the range in direction 2 is `[0,
+  /// 1)`.
+  /// @param[in] cells_local Range of the local (owned and ghost) grid
+  /// cells in each direction. It must contain `cells_owned`.
+  /// @param[in] vertex_index Local index of each vertex of the local
+  /// grid cells, in lexicographic order of the grid vertices.
+  StructuredGrid(CellType cell_type,
+                 std::array<std::array<std::int64_t, 2>, 3> cells_owned,
+                 std::array<std::array<std::int64_t, 2>, 3> cells_local,
+                 std::vector<std::int32_t> vertex_index);
+
+  /// @brief View of the cell-to-vertex connectivity of a grid.
+  /// @tparam N Number of vertices per cell.
+  template <std::size_t N>
+  class CellVertices
+  {
+  public:
+    /// @brief Create a view.
+    /// @param[in] grid The grid. The view is valid for the lifetime of
+    /// the grid.
+    explicit CellVertices(const StructuredGrid& grid) : _grid(grid)
+    {
+      if (N != static_cast<std::size_t>(
+              cell_num_entities(grid.cell_type(), 0)))
+      {
+        throw std::runtime_error("Wrong number of cell vertices.");
+      }
+    }
+
+    /// Number of cells
+    std::int32_t num_nodes() const { return _grid.num_cells(); }
+
+    /// Number of vertices of a cell
+    constexpr int num_links(std::size_t /*node*/) const { return N; }
+
+    /// @brief Vertices of a cell.
+    /// @param[in] node Local cell index.
+    /// @return Local vertex indices, ordered as the cell's reference
+    /// vertices.
+    std::array<std::int32_t, N> links(std::int32_t node) const
+    {
+      const int m = _grid.num_sub_cells();
+      const std::array<std::int32_t, 8> corners
+          = _grid.corner_vertices(node / m);
+      const int* sub_cell = _grid.sub_cells().data() + (node % m) * N;
+      std::array<std::int32_t, N> v;
+      for (std::size_t i = 0; i < N; ++i)
+        v[i] = corners[sub_cell[i]];
+      return v;
+    }
+
+  private:
+    const StructuredGrid& _grid;
+  };
+
+  /// @brief View of the neighbours of each cell across its facets, for
+  /// grids of quadrilaterals or hexahedra.
+  ///
+  /// The neighbours of a cell are ordered `(-x, +x, -y, +y, -z, +z)`,
+  /// where the z-neighbours are only present for hexahedra. The index
+  /// is -1 if the neighbour is not a local cell, i.e. on the boundary of
+  /// the grid or of the local block.
+  /// @tparam N Number of facets per cell.
+  template <std::size_t N>
+  class CellNeighbours
+  {
+  public:
+    /// @brief Create a view.
+    /// @param[in] grid The grid. The view is valid for the lifetime of
+    /// the grid.
+    explicit CellNeighbours(const StructuredGrid& grid) : _grid(grid)
+    {
+      if (grid.num_sub_cells() != 1)
+        throw std::runtime_error("Cell neighbours require tensor cells.");
+      if (N != static_cast<std::size_t>(2 * cell_dim(grid.cell_type())))
+        throw std::runtime_error("Wrong number of cell facets.");
+    }
+
+    /// Number of cells
+    std::int32_t num_nodes() const { return _grid.num_cells(); }
+
+    /// Number of neighbours of a cell
+    constexpr int num_links(std::size_t /*node*/) const { return N; }
+
+    /// @brief Neighbours of a cell.
+    /// @param[in] node Local cell index.
+    /// @return Local indices of the neighbouring cells, or -1.
+    std::array<std::int32_t, N> links(std::int32_t node) const
+    {
+      std::array<std::int64_t, 3> idx = _grid.grid_index(node);
+      std::array<std::int32_t, N> nbrs;
+      for (std::size_t i = 0; i < N; ++i)
+      {
+        std::array<std::int64_t, 3> nidx = idx;
+        nidx[i / 2] += i % 2 == 0 ? -1 : 1;
+        nbrs[i] = _grid.local_cell(nidx);
+      }
+      return nbrs;
+    }
+
+  private:
+    const StructuredGrid& _grid;
+  };
+
+  /// Cell type
+  CellType cell_type() const { return _cell_type; }
+
+  /// Number of cells in each grid cell
+  int num_sub_cells() const { return _num_sub_cells; }
+
+  /// Number of local (owned and ghost) cells
+  std::int32_t num_cells() const
+  {
+    return _num_sub_cells * (_num_owned + _ghosts.size());
+  }
+
+  /// Number of owned cells
+  std::int32_t num_owned_cells() const { return _num_sub_cells * _num_owned; }
+
+  /// Range of the owned grid cells in each direction
+  const std::array<std::array<std::int64_t, 2>, 3>& cells_owned() const
+  {
+    return _cells_owned;
+  }
+
+  /// Range of the local grid cells in each direction
+  const std::array<std::array<std::int64_t, 2>, 3>& cells_local() const
+  {
+    return _cells_local;
+  }
+
+  /// @brief Vertices of the sub-cells of a grid cell, numbered by the
+  /// grid cell corners.
+  ///
+  /// Corner `k` of a grid cell is at the offset `(k & 1, (k >> 1) & 1,
+  /// k >> 2)` from the first vertex of the grid cell.
+  std::span<const int> sub_cells() const { return _sub_cells; }
+
+  /// @brief Grid index of a local cell.
+  /// @param[in] c Local cell index.
+  /// @return Index of the grid cell in each direction.
+  std::array<std::int64_t, 3> grid_index(std::int32_t c) const;
+
+  /// @brief Local index of the (first) cell of a grid cell.
+  /// @param[in] idx Grid cell index in each direction.
+  /// @return Local cell index, or -1 if the grid cell is not local.
+  std::int32_t local_cell(std::array<std::int64_t, 3> idx) const;
+
+  /// @brief Local indices of the corner vertices of a local grid cell.
+  /// @param[in] g Local grid cell index, i.e. the local cell index
+  /// divided by the number of sub-cells.
+  /// @return The vertices of the `2^tdim` corners, see sub_cells().
+  std::array<std::int32_t, 8> corner_vertices(std::int32_t g) const;
+
+  /// @brief Materialise the cell-to-vertex connectivity.
+  /// @return Local vertex indices of each cell (row-major).
+  std::vector<std::int32_t> cells() const;
+
+private:
+  // Cell type and subdivision of a grid cell
+  CellType _cell_type;
+  std::vector<int> _sub_cells;
+  int _num_sub_cells;
+
+  // Ranges of owned and local grid cells, and the shape of the local
+  // vertex block
+  std::array<std::array<std::int64_t, 2>, 3> _cells_owned, _cells_local;
+  std::array<std::int64_t, 3> _vertex_shape;
+
+  // Number of owned grid cells, and the lexicographic index in the
+  // local block of each ghost grid cell
+  std::int32_t _num_owned;
+  std::vector<std::int64_t> _ghosts;
+
+  // Local vertex index of each vertex of the local block
+  std::vector<std::int32_t> _vertex_index;
+};
+
+} // namespace dolfinx::mesh
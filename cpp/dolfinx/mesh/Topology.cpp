@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "Topology.h"
+#include "StructuredGrid.h"
 #include "cell_types.h"
 #include "permutationcomputation.h"
 #include "topologycomputation.h"
@@ -831,10 +832,66 @@ std::shared_ptr<const common::IndexMap> Topology::index_map(int dim) const
 std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
 Topology::connectivity(std::array<int, 2> d0, std::array<int, 2> d1) const
 {
-  if (auto it = _connectivity.find({d0, d1}); it == _connectivity.end())
-    return nullptr;
-  else
-    return it->second;
+  if (!_connectivity_lru)
+  {
+    auto it = _connectivity.find({d0, d1});
+    return it != _connectivity.end() ? it->second : nullptr;
+  }
+
+  {
+    std::shared_lock lock(_connectivity_mutex.map);
+    if (auto it = _connectivity.find({d0, d1}); it != _connectivity.end())
+    {
+      if (auto d = _derived_connectivity.find({d0, d1});
+          d != _derived_connectivity.end())
+      {
+        d->second.count.store(++_connectivity_access.count,
+                              std::memory_order_relaxed);
+      }
+      return it->second;
+    }
+    else if (!_evicted_connectivity.contains({d0, d1}))
+      return nullptr;
+  }
+
+  // Re-compute evicted connectivity. Another thread may have
+  // re-computed it while waiting for the lock, and the calls to
+  // connectivity() made by compute_connectivity on this thread return
+  // nullptr for the connectivity being computed.
+  std::scoped_lock compute_lock(_connectivity_mutex.compute);
+  {
+    std::shared_lock lock(_connectivity_mutex.map);
+    if (auto it = _connectivity.find({d0, d1}); it != _connectivity.end())
+      return it->second;
+    else if (!_evicted_connectivity.contains({d0, d1})
+             or _connectivity_computing.contains({d0, d1}))
+    {
+      return nullptr;
+    }
+  }
+
+  spdlog::info("Re-computing evicted connectivity ({}, {}) - ({}, {})",
+               d0[0], d0[1], d1[0], d1[1]);
+  _connectivity_computing.insert({d0, d1});
+  std::array<std::shared_ptr<graph::AdjacencyList<std::int32_t>>, 2> c;
+  try
+  {
+    c = compute_connectivity(*this, d0, d1);
+  }
+  catch (...)
+  {
+    _connectivity_computing.erase({d0, d1});
+    throw;
+  }
+  _connectivity_computing.erase({d0, d1});
+
+  auto [c_d0_d1, c_d1_d0] = c;
+  std::unique_lock lock(_connectivity_mutex.map);
+  if (c_d1_d0)
+    add_connectivity(d1, d0, c_d1_d0);
+  add_connectivity(d0, d1, c_d0_d1);
+  evict_connectivity(d0, d1);
+  return c_d0_d1;
 }
 //-----------------------------------------------------------------------------
 std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
@@ -890,7 +947,83 @@ const std::vector<std::int32_t>& Topology::interprocess_facets() const
   return this->interprocess_facets(0);
 }
 //-----------------------------------------------------------------------------
-bool Topology::create_entities(int dim)
+std::span<const std::int32_t> Topology::exterior_facets(int index) const
+{
+  {
+    std::shared_lock lock(_exterior_facets_mutex.map);
+    if (auto it = _exterior_facets.find(index); it != _exterior_facets.end())
+      return it->second;
+  }
+
+  const int tdim = this->dim();
+  auto f_to_c = this->connectivity(tdim - 1, tdim);
+  if (!f_to_c)
+  {
+    throw std::runtime_error(
+        "Facet to cell connectivity has not been computed.");
+  }
+
+  // Find all owned facets (not ghost) with only one attached cell
+  auto facet_map = this->index_maps(tdim - 1).at(index);
+  std::vector<std::int32_t> facets;
+  for (std::int32_t f = 0; f < facet_map->size_local(); ++f)
+  {
+    if (f_to_c->num_links(f) == 1)
+      facets.push_back(f);
+  }
+
+  // Remove facets on internal inter-process boundary
+  std::vector<std::int32_t> ext_facets;
+  std::ranges::set_difference(facets, this->interprocess_facets(index),
+                              std::back_inserter(ext_facets));
+
+  // Keep the facets of another thread that computed them first
+  std::unique_lock lock(_exterior_facets_mutex.map);
+  return _exterior_facets.try_emplace(index, std::move(ext_facets))
+      .first->second;
+}
+//-----------------------------------------------------------------------------
+std::span<const std::int32_t> Topology::exterior_facets() const
+{
+  if (this->entity_types(this->dim() - 1).size() > 1)
+  {
+    throw std::runtime_error(
+        "Multiple facet types in mesh. Specify facet type index.");
+  }
+
+  return this->exterior_facets(0);
+}
+//-----------------------------------------------------------------------------
+std::span<const std::int32_t> Topology::exterior_facet_vertices(int index) const
+{
+  {
+    std::shared_lock lock(_exterior_facets_mutex.map);
+    if (auto it = _exterior_facet_vertices.find(index);
+        it != _exterior_facet_vertices.end())
+    {
+      return it->second;
+    }
+  }
+
+  std::span<const std::int32_t> facets = exterior_facets(index);
+  auto f_to_v = connectivity({this->dim() - 1, index}, {0, 0});
+  assert(f_to_v);
+  std::vector<std::int32_t> vertices;
+  for (std::int32_t f : facets)
+  {
+    auto v = f_to_v->links(f);
+    vertices.insert(vertices.end(), v.begin(), v.end());
+  }
+  dolfinx::radix_sort(vertices);
+  auto [unique_end, range_end] = std::ranges::unique(vertices);
+  vertices.erase(unique_end, range_end);
+
+  std::unique_lock lock(_exterior_facets_mutex.map);
+  return _exterior_facet_vertices.try_emplace(index, std::move(vertices))
+      .first->second;
+}
+//-----------------------------------------------------------------------------
+bool Topology::create_entities(int dim, int num_threads)
 {
   // TODO: is this check sufficient/correct? Does not catch the
   // cell_entity entity case. Should there also be a check for
@@ -919,7 +1052,7 @@ bool Topology::create_entities(int dim)
 
     // Create local entities
     auto [cell_entity, entity_vertex, index_map, interprocess_entities]
-        = compute_entities(*this, dim, *entity);
+        = compute_entities(*this, dim, *entity, num_threads);
     for (std::size_t k = 0; k < cell_entity.size(); ++k)
     {
       if (cell_entity[k])
@@ -936,11 +1069,15 @@ bool Topology::create_entities(int dim)
 
     _index_maps.insert({{dim, int(index)}, index_map});
 
-    // Store interprocess facets
+    // Store interprocess facets, and clear exterior facets that depend
+    // on them
     if (dim == this->dim() - 1)
     {
       std::ranges::sort(interprocess_entities);
       _interprocess_facets.push_back(std::move(interprocess_entities));
+      std::unique_lock lock(_exterior_facets_mutex.map);
+      _exterior_facets.clear();
+      _exterior_facet_vertices.clear();
     }
   }
 
@@ -978,16 +1115,117 @@ void Topology::create_connectivity(int d0, int d1)
       // create_connectivity(std::vector<std::pair<int, int>>)?
 
       // Attach connectivities
+      if (c_d1_d0)
+        add_connectivity({d1, i1}, {d0, i0}, c_d1_d0);
+
       if (c_d0_d1)
-        _connectivity.insert({{{d0, i0}, {d1, i1}}, c_d0_d1});
+        add_connectivity({d0, i0}, {d1, i1}, c_d0_d1);
 
-      if (c_d1_d0)
-        _connectivity.insert({{{d1, i1}, {d0, i0}}, c_d1_d0});
+      evict_connectivity({d0, i0}, {d1, i1});
     }
   }
 }
 //-----------------------------------------------------------------------------
-void Topology::create_entity_permutations()
+void Topology::set_connectivity_memory_limit(std::size_t limit)
+{
+  _connectivity_memory_limit = limit;
+  _connectivity_lru = limit != std::numeric_limits<std::size_t>::max()
+                      or !_evicted_connectivity.empty();
+  if (!_derived_connectivity.empty())
+  {
+    // Keep the most recently used connectivity
+    auto it = std::ranges::max_element(_derived_connectivity, std::less{},
+                                       [](auto& c)
+                                       { return c.second.count.load(); });
+    evict_connectivity(it->first.first, it->first.second);
+  }
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::connectivity_memory() const
+{
+  std::size_t bytes = 0;
+  for (auto& [key, access] : _derived_connectivity)
+    bytes += _connectivity.at(key)->memory_usage();
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::memory_usage() const
+{
+  std::size_t bytes = 0;
+  std::set<const void*> counted;
+  for (auto& [key, c] : _connectivity)
+  {
+    if (c and counted.insert(c.get()).second)
+      bytes += c->memory_usage();
+  }
+  for (auto& [key, map] : _index_maps)
+  {
+    if (map and counted.insert(map.get()).second)
+      bytes += map->memory_usage();
+  }
+
+  bytes += sizeof(std::uint8_t) * _facet_permutations.size();
+  bytes += sizeof(std::uint32_t) * _cell_permutations.size();
+  for (auto& facets : _interprocess_facets)
+    bytes += sizeof(std::int32_t) * facets.size();
+  {
+    std::shared_lock lock(_exterior_facets_mutex.map);
+    for (auto& [index, facets] : _exterior_facets)
+      bytes += sizeof(std::int32_t) * facets.size();
+    for (auto& [index, vertices] : _exterior_facet_vertices)
+      bytes += sizeof(std::int32_t) * vertices.size();
+  }
+  for (auto& idx : original_cell_index)
+    bytes += sizeof(std::int64_t) * idx.size();
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+void Topology::add_connectivity(
+    std::array<int, 2> d0, std::array<int, 2> d1,
+    std::shared_ptr<graph::AdjacencyList<std::int32_t>> c) const
+{
+  if (_connectivity.insert({{d0, d1}, c}).second)
+  {
+    _derived_connectivity.insert({{d0, d1}, ++_connectivity_access.count});
+    _evicted_connectivity.erase({d0, d1});
+  }
+}
+//-----------------------------------------------------------------------------
+void Topology::evict_connectivity(std::array<int, 2> d0,
+                                  std::array<int, 2> d1) const
+{
+  std::size_t bytes = connectivity_memory();
+  while (bytes > _connectivity_memory_limit)
+  {
+    // Find least recently used connectivity (excluding (d0, d1))
+    auto it = _derived_connectivity.end();
+    for (auto c = _derived_connectivity.begin();
+         c != _derived_connectivity.end(); ++c)
+    {
+      if (c->first != std::pair{d0, d1}
+          and (it == _derived_connectivity.end()
+               or c->second.count.load() < it->second.count.load()))
+      {
+        it = c;
+      }
+    }
+
+    if (it == _derived_connectivity.end())
+      break;
+
+    spdlog::info("Evicting connectivity ({}, {}) - ({}, {})",
+                 it->first.first[0], it->first.first[1], it->first.second[0],
+                 it->first.second[1]);
+    auto c = _connectivity.find(it->first);
+    bytes -= sizeof(std::int32_t)
+             * (c->second->array().size() + c->second->offsets().size());
+    _connectivity.erase(c);
+    _evicted_connectivity.insert(it->first);
+    _derived_connectivity.erase(it);
+  }
+}
+//-----------------------------------------------------------------------------
+void Topology::create_entity_permutations(int num_threads)
 {
   if (!_cell_permutations.empty())
     return;
@@ -999,14 +1237,42 @@ void Topology::create_entity_permutations()
   // Create all mesh entities
   int tdim = this->dim();
   for (int d = 0; d < tdim; ++d)
-    create_entities(d);
+    create_entities(d, num_threads);
 
   auto [facet_permutations, cell_permutations]
-      = compute_entity_permutations(*this);
+      = compute_entity_permutations(*this, num_threads);
   _facet_permutations = std::move(facet_permutations);
   _cell_permutations = std::move(cell_permutations);
 }
 //-----------------------------------------------------------------------------
+std::shared_ptr<const StructuredGrid> Topology::structured_grid() const
+{
+  return _structured_grid;
+}
+//-----------------------------------------------------------------------------
+void Topology::set_structured_grid(std::shared_ptr<const StructuredGrid> grid)
+{
+  if (grid)
+  {
+    if (_entity_types.back().size() != 1
+        or grid->cell_type() != _entity_types.back().front())
+    {
+      throw std::runtime_error("Structured grid cell type does not match "
+                               "the topology.");
+    }
+
+    auto cell_map = this->index_map(this->dim());
+    if (grid->num_cells() != cell_map->size_local() + cell_map->num_ghosts()
+        or grid->num_owned_cells() != cell_map->size_local())
+    {
+      throw std::runtime_error("Structured grid number of cells does not "
+                               "match the topology.");
+    }
+  }
+
+  _structured_grid = grid;
+}
+//-----------------------------------------------------------------------------
 MPI_Comm Topology::comm() const
 {
   auto it = _index_maps.find({this->dim(), 0});
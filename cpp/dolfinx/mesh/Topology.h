@@ -7,11 +7,16 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
+#include <shared_mutex>
 #include <span>
 #include <tuple>
 #include <utility>
@@ -31,6 +36,7 @@ class AdjacencyList;
 namespace dolfinx::mesh
 {
 enum class CellType;
+class StructuredGrid;
 
 /// @brief Topology stores the topology of a mesh, consisting of mesh
 /// entities and connectivity (incidence relations for the mesh
@@ -130,6 +136,8 @@ public:
   /// incident "entity type" within topological dimension).
   /// @return AdjacencyList of connectivity from entity type in `d0` to
   /// entity types in `d1`, or `nullptr` if not yet computed.
+  /// @note A connectivity that was computed by create_connectivity and
+  /// then evicted (see set_connectivity_memory_limit) is re-computed.
   std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
   connectivity(std::array<int, 2> d0, std::array<int, 2> d1) const;
 
@@ -192,11 +200,50 @@ public:
   /// been computed.
   const std::vector<std::int32_t>& interprocess_facets() const;
 
+  /// @brief Owned exterior facets of a given type.
+  ///
+  /// An exterior facet (co-dimension 1) is one that is connected
+  /// globally to only one cell (co-dimension 0). The facets are
+  /// computed on first use and cached. The cache is cleared if the
+  /// facets are re-created.
+  ///
+  /// @note The function is thread-safe. Concurrent first calls may
+  /// each compute the facets, and one result is cached.
+  ///
+  /// @pre The facet-to-cell connectivity must have been computed.
+  ///
+  /// @param[in] index Index of facet type, following the order given
+  /// by ::entity_types.
+  /// @return Sorted indices of the owned exterior facets.
+  std::span<const std::int32_t> exterior_facets(int index) const;
+
+  /// @brief Owned exterior facets.
+  ///
+  /// @pre The topology has one facet type, and the facet-to-cell
+  /// connectivity has been computed.
+  ///
+  /// @return Sorted indices of the owned exterior facets, see
+  /// exterior_facets(int).
+  std::span<const std::int32_t> exterior_facets() const;
+
+  /// @brief Vertices of the owned exterior facets of a given type.
+  ///
+  /// The vertices are computed on first use and cached, as for
+  /// exterior_facets().
+  ///
+  /// @param[in] index Index of facet type, following the order given
+  /// by ::entity_types.
+  /// @return Sorted indices of the vertices of the facets returned by
+  /// exterior_facets(index).
+  std::span<const std::int32_t> exterior_facet_vertices(int index) const;
+
   /// @brief Create entities of given topological dimension.
   /// @param[in] dim Topological dimension of entities to compute.
+  /// @param[in] num_threads Number of threads used to compute the
+  /// process-local entities.
   /// @return True if entities are created, false if entities already
   /// existed.
-  bool create_entities(int dim);
+  bool create_entities(int dim, int num_threads = 1);
 
   /// @brief Create connectivity between given pair of dimensions, `d0
   /// -> d1`.
@@ -204,8 +251,58 @@ public:
   /// @param[in] d1 Topological dimension.
   void create_connectivity(int d0, int d1);
 
+  /// @brief Set the memory limit for connectivities computed by
+  /// create_connectivity.
+  ///
+  /// If the memory used by the connectivities computed by
+  /// create_connectivity exceeds the limit, the least recently used
+  /// connectivities are evicted. An evicted connectivity is
+  /// re-computed when it is next requested by connectivity(), and
+  /// adjacency lists that have been returned by connectivity() remain
+  /// valid after eviction. The connectivities that define the mesh
+  /// entities, i.e. entity-to-vertex and cell-to-entity
+  /// connectivities, are never evicted. The connectivity requested
+  /// most recently is kept, even if it exceeds the limit.
+  ///
+  /// @note Once a limit has been set, connectivity() updates the
+  /// access counts and re-computes evicted connectivities under a lock,
+  /// and can be called concurrently. Without a limit, connectivity()
+  /// does not modify the topology.
+  ///
+  /// @param[in] limit Memory limit in bytes.
+  void set_connectivity_memory_limit(std::size_t limit);
+
+  /// @brief Memory (in bytes) used by the connectivities computed by
+  /// create_connectivity that are currently stored.
+  std::size_t connectivity_memory() const;
+
+  /// @brief Memory used by the topology.
+  ///
+  /// Includes the connectivities, index maps, entity permutations,
+  /// inter-process and exterior facets and original cell indices.
+  /// Objects that are shared by more than one entry, e.g. an index map,
+  /// are counted once.
+  /// @return Number of bytes.
+  std::size_t memory_usage() const;
+
   /// @brief Compute entity permutations and reflections.
-  void create_entity_permutations();
+  /// @param[in] num_threads Number of threads used to create the
+  /// entities and to compute the permutations.
+  void create_entity_permutations(int num_threads = 1);
+
+  /// @brief Structured grid description of the cells, if the mesh is a
+  /// (subdivided) Cartesian grid.
+  ///
+  /// Code that can exploit the structure, e.g. by computing the
+  /// cell-to-vertex connectivity arithmetically, can specialise on
+  /// this.
+  /// @return The grid, or `nullptr` if the mesh is not structured.
+  std::shared_ptr<const StructuredGrid> structured_grid() const;
+
+  /// @brief Set the structured grid description of the cells.
+  /// @param[in] grid The grid. Its cells must be the cells of the
+  /// topology, in the same order and with the same vertices.
+  void set_structured_grid(std::shared_ptr<const StructuredGrid> grid);
 
   /// Original cell index for each cell type
   std::vector<std::vector<std::int64_t>> original_cell_index;
@@ -215,6 +312,30 @@ public:
   MPI_Comm comm() const;
 
 private:
+  // Access count of a connectivity, which can be updated concurrently
+  struct AccessCount
+  {
+    AccessCount(std::uint64_t c = 0) : count(c) {}
+    AccessCount(const AccessCount& c) : count(c.count.load()) {}
+    AccessCount& operator=(const AccessCount& c)
+    {
+      count.store(c.count.load());
+      return *this;
+    }
+    std::atomic<std::uint64_t> count;
+  };
+
+  // Mutexes for the connectivity cache. A copy of a topology has its
+  // own mutexes.
+  struct CacheMutex
+  {
+    CacheMutex() = default;
+    CacheMutex(const CacheMutex&) {}
+    CacheMutex& operator=(const CacheMutex&) { return *this; }
+    std::shared_mutex map;
+    std::recursive_mutex compute;
+  };
+
   // Cell types for entities in Topology, where _entity_types_new[d][i]
   // is the ith entity type of dimension d
   std::vector<std::vector<CellType>> _entity_types;
@@ -232,10 +353,53 @@ private:
   // (dim1, i1)] is the connection from (dim0, i0) -> (dim1, i1),
   // where dim0 and dim1 are topological dimensions and i0 and i1
   // are the indices of cell types (following the order in _entity_types).
-  std::map<std::pair<std::array<int, 2>, std::array<int, 2>>,
-           std::shared_ptr<graph::AdjacencyList<std::int32_t>>>
+  mutable std::map<std::pair<std::array<int, 2>, std::array<int, 2>>,
+                   std::shared_ptr<graph::AdjacencyList<std::int32_t>>>
       _connectivity;
 
+  // Memory limit (bytes) for the connectivities computed by
+  // create_connectivity
+  std::size_t _connectivity_memory_limit
+      = std::numeric_limits<std::size_t>::max();
+
+  // Connectivities computed by create_connectivity, with the access
+  // count at the last use of each. Only these connectivities can be
+  // evicted.
+  mutable std::map<std::pair<std::array<int, 2>, std::array<int, 2>>,
+                   AccessCount>
+      _derived_connectivity;
+  mutable AccessCount _connectivity_access;
+
+  // Connectivities that have been evicted, and are re-computed when
+  // requested
+  mutable std::set<std::pair<std::array<int, 2>, std::array<int, 2>>>
+      _evicted_connectivity;
+
+  // True if a memory limit has been set, in which case connectivity()
+  // updates the access counts and re-computes evicted connectivities
+  bool _connectivity_lru = false;
+
+  // Locks for the connectivity cache when _connectivity_lru is true.
+  // The shared mutex guards the maps and sets above, and the recursive
+  // mutex serialises re-computation of evicted connectivities
+  // (compute_connectivity calls connectivity() on the same thread).
+  mutable CacheMutex _connectivity_mutex;
+
+  // Evicted connectivities being re-computed (guarded by
+  // _connectivity_mutex.compute)
+  mutable std::set<std::pair<std::array<int, 2>, std::array<int, 2>>>
+      _connectivity_computing;
+
+  // Store a connectivity computed by create_connectivity
+  void add_connectivity(std::array<int, 2> d0, std::array<int, 2> d1,
+                        std::shared_ptr<graph::AdjacencyList<std::int32_t>> c)
+      const;
+
+  // Evict least recently used connectivities until the memory limit is
+  // met, keeping connectivity (d0, d1)
+  void evict_connectivity(std::array<int, 2> d0,
+                          std::array<int, 2> d1) const;
+
   // The facet permutations (local facet, cell))
   // [cell0_0, cell0_1, ,cell0_2, cell1_0, cell1_1, ,cell1_2, ...,
   // celln_0, celln_1, ,celln_2,]
@@ -249,6 +413,18 @@ private:
   // facet type. _interprocess_facets[i] is the inter-process facets of
   // facet type i.
   std::vector<std::vector<std::int32_t>> _interprocess_facets;
+
+  // Owned exterior facets, and their vertices, for each facet type
+  // (computed on demand)
+  mutable std::map<int, std::vector<std::int32_t>> _exterior_facets,
+      _exterior_facet_vertices;
+
+  // Lock for _exterior_facets and _exterior_facet_vertices (the shared
+  // mutex is used)
+  mutable CacheMutex _exterior_facets_mutex;
+
+  // Structured grid description of the cells
+  std::shared_ptr<const StructuredGrid> _structured_grid;
 };
 
 /// @brief Create a mesh topology.
@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include "Geometry.h"
 #include "Mesh.h"
+#include "StructuredGrid.h"
+#include "Topology.h"
 #include "cell_types.h"
 #include "utils.h"
 #include <algorithm>
@@ -15,10 +18,15 @@
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/ordering.h>
 #include <limits>
+#include <memory>
 #include <mpi.h>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -77,6 +85,11 @@ Mesh<T> build_prism(MPI_Comm comm, MPI_Comm subcomm,
                     std::array<std::int64_t, 3> n,
                     const CellPartitionFunction& partitioner,
                     const CellReorderFunction& reorder_fn);
+
+template <std::floating_point T>
+Mesh<T> build_blocked(MPI_Comm comm, std::array<std::array<T, 3>, 2> p,
+                      std::array<std::int64_t, 3> n, CellType celltype,
+                      GhostMode ghost_mode);
 } // namespace impl
 
 /// @brief Create a uniform mesh::Mesh over rectangular prism spanned by
@@ -228,6 +241,102 @@ Mesh<T> create_rectangle(MPI_Comm comm, std::array<std::array<T, 2>, 2> p,
   return create_rectangle<T>(comm, p, n, celltype, nullptr, diagonal);
 }
 
+/// @brief Create a uniform mesh::Mesh over the rectangular prism
+/// spanned by the two points `p`, with each process generating its own
+/// block of the mesh.
+///
+/// The processes are arranged in a Cartesian grid (see
+/// `MPI_Dims_create`) and each process creates the cells of a block of
+/// the structured grid, its ghost layer and the geometry directly in
+/// the local numbering. This avoids graph partitioning and the
+/// distribution of cells and geometry, and is suited to creating large
+/// meshes on many processes, e.g. for weak-scaling studies. The cells
+/// and vertices are the same as for ::create_box, and the 'original'
+/// input indices (Topology::original_cell_index and
+/// Geometry::input_global_indices) are the lexicographic cell and
+/// vertex indices of the structured grid. The topology of the mesh
+/// holds the StructuredGrid block of the process, see
+/// Topology::structured_grid.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator to create the mesh on.
+/// @param[in] p Corners of the box.
+/// @param[in] n Number of cells in each direction.
+/// @param[in] celltype Cell shape.
+/// @param[in] ghost_mode Ghost mode. For a mode other than
+/// GhostMode::none the ghost layer is one layer of grid cells, which
+/// contains all cells that share a vertex with an owned cell.
+/// @return Mesh
+/// @pre The number of cells in each direction is not less than the
+/// number of processes in that direction of the process grid.
+template <std::floating_point T = double>
+Mesh<T> create_box_blocked(MPI_Comm comm, std::array<std::array<T, 3>, 2> p,
+                           std::array<std::int64_t, 3> n, CellType celltype,
+                           GhostMode ghost_mode = GhostMode::none)
+{
+  if (std::ranges::any_of(n, [](auto e) { return e < 1; }))
+    throw std::runtime_error("At least one cell per dimension is required");
+
+  for (int32_t i = 0; i < 3; i++)
+  {
+    if (p[0][i] >= p[1][i])
+      throw std::runtime_error("It must hold p[0] < p[1].");
+  }
+
+  switch (celltype)
+  {
+  case CellType::tetrahedron:
+  case CellType::hexahedron:
+  case CellType::prism:
+    return impl::build_blocked<T>(comm, p, n, celltype, ghost_mode);
+  default:
+    throw std::runtime_error("Generate box mesh. Wrong cell type");
+  }
+}
+
+/// @brief Create a uniform mesh::Mesh over the rectangle spanned by the
+/// two points `p`, with each process generating its own block of the
+/// mesh.
+///
+/// See ::create_box_blocked. Triangles use DiagonalType::right.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator to create the mesh on.
+/// @param[in] p Bottom-left and top-right corners of the rectangle.
+/// @param[in] n Number of cells in each direction.
+/// @param[in] celltype Cell shape.
+/// @param[in] ghost_mode Ghost mode.
+/// @return Mesh
+template <std::floating_point T = double>
+Mesh<T> create_rectangle_blocked(MPI_Comm comm,
+                                 std::array<std::array<T, 2>, 2> p,
+                                 std::array<std::int64_t, 2> n,
+                                 CellType celltype,
+                                 GhostMode ghost_mode = GhostMode::none)
+{
+  if (std::ranges::any_of(n, [](auto e) { return e < 1; }))
+    throw std::runtime_error("At least one cell per dimension is required");
+
+  for (int32_t i = 0; i < 2; i++)
+  {
+    if (p[0][i] >= p[1][i])
+      throw std::runtime_error("It must hold p[0] < p[1].");
+  }
+
+  switch (celltype)
+  {
+  case CellType::triangle:
+  case CellType::quadrilateral:
+    return impl::build_blocked<T>(
+        comm, {{{p[0][0], p[0][1], 0}, {p[1][0], p[1][1], 0}}},
+        {n[0], n[1], 1}, celltype, ghost_mode);
+  default:
+    throw std::runtime_error("Generate rectangle mesh. Wrong cell type");
+  }
+}
+
 /// @brief Interval mesh of the 1D line `[a, b]`.
 ///
 /// Given `n` cells in the axial direction, the total number of
@@ -698,5 +807,278 @@ Mesh<T> build_quad(MPI_Comm comm, const std::array<std::array<T, 2>, 2> p,
                        std::vector<T>{}, {0, 2}, partitioner, reorder_fn);
   }
 }
+template <std::floating_point T>
+Mesh<T> build_blocked(MPI_Comm comm, std::array<std::array<T, 3>, 2> p,
+                      std::array<std::int64_t, 3> n, CellType celltype,
+                      GhostMode ghost_mode)
+{
+  common::Timer timer("Build blocked structured mesh");
+  const int tdim = cell_dim(celltype);
+  const int rank = dolfinx::MPI::rank(comm);
+  const int num_cell_vertices = cell_num_entities(celltype, 0);
+
+  // Number of grid cells and vertices in each direction. A 2D grid is
+  // one layer of grid cells with one layer of vertices.
+  std::array<std::int64_t, 3> nv;
+  for (int i = 0; i < 3; ++i)
+    nv[i] = i < tdim ? n[i] + 1 : 1;
+
+  // Process grid, with process (q0, q1, q2) being rank
+  // q0 + dims[0] * (q1 + dims[1] * q2)
+  std::array<int, 3> dims = {0, 0, tdim == 3 ? 0 : 1};
+  MPI_Dims_create(dolfinx::MPI::size(comm), tdim, dims.data());
+  for (int i = 0; i < tdim; ++i)
+  {
+    if (dims[i] > n[i])
+    {
+      throw std::runtime_error("Too few cells (" + std::to_string(n[i])
+                               + ") in direction " + std::to_string(i)
+                               + " for the process grid");
+    }
+  }
+  auto to_rank = [&dims](std::array<int, 3> q)
+  { return q[0] + dims[0] * (q[1] + dims[1] * q[2]); };
+  const std::array<int, 3> q = {rank % dims[0], (rank / dims[0]) % dims[1],
+                                rank / (dims[0] * dims[1])};
+
+  // Ranges of the owned grid cells and vertices of process block `a` in
+  // direction `i`. A vertex is owned by the block that owns the grid
+  // cell 'above' it, or the last block.
+  auto cells_owned = [&](int i, int a)
+  { return dolfinx::MPI::local_range(a, n[i], dims[i]); };
+  auto vertices_owned = [&](int i, int a) -> std::array<std::int64_t, 2>
+  {
+    auto [c0, c1] = cells_owned(i, a);
+    return {c0, c1 == n[i] ? nv[i] : c1};
+  };
+
+  // Range of the local (owned and ghost) grid cells and vertices
+  const bool ghosted = ghost_mode != GhostMode::none;
+  auto cells_local = [&](int i, int a) -> std::array<std::int64_t, 2>
+  {
+    auto [c0, c1] = cells_owned(i, a);
+    return ghosted ? std::array{std::max<std::int64_t>(c0 - 1, 0),
+                                std::min(c1 + 1, n[i])}
+                   : std::array{c0, c1};
+  };
+  auto vertices_local = [&](int i, int a) -> std::array<std::int64_t, 2>
+  {
+    auto [c0, c1] = cells_local(i, a);
+    return {c0, std::min(c1 + 1, nv[i])};
+  };
+
+  // Owner (process block) of grid index `idx`, and the global index of
+  // `idx` in the contiguous numbering of the owned entities, for
+  // grid cells (`vertex == false`) or vertices
+  auto owner = [&](const std::array<std::int64_t, 3>& idx, bool vertex)
+  {
+    std::array<int, 3> qo;
+    for (int i = 0; i < 3; ++i)
+    {
+      std::int64_t c = vertex ? std::min(idx[i], n[i] - 1) : idx[i];
+      qo[i] = dolfinx::MPI::index_owner(dims[i], c, n[i]);
+    }
+    return qo;
+  };
+  auto global_index
+      = [&](const std::array<std::int64_t, 3>& idx, bool vertex) -> std::int64_t
+  {
+    const std::array<int, 3> qo = owner(idx, vertex);
+    const std::array<std::int64_t, 3>& size = vertex ? nv : n;
+    std::array<std::int64_t, 3> r0, len;
+    for (int i = 0; i < 3; ++i)
+    {
+      auto r = vertex ? vertices_owned(i, qo[i]) : cells_owned(i, qo[i]);
+      r0[i] = r[0];
+      len[i] = r[1] - r[0];
+    }
+    std::int64_t offset = size[0] * size[1] * r0[2]
+                          + size[0] * r0[1] * len[2]
+                          + r0[0] * len[1] * len[2];
+    return offset + (idx[0] - r0[0])
+           + len[0] * ((idx[1] - r0[1]) + len[1] * (idx[2] - r0[2]));
+  };
+
+  // Neighbouring processes that own local entities of this process
+  // (src), and that have owned entities of this process as local
+  // entities (dest)
+  auto neighbours
+      = [&](auto owned, auto local) -> std::array<std::vector<int>, 2>
+  {
+    auto intersect = [](const std::array<int, 3>& q0,
+                        const std::array<int, 3>& q1, auto owned, auto local)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        auto [a0, a1] = owned(i, q0[i]);
+        auto [b0, b1] = local(i, q1[i]);
+        if (std::max(a0, b0) >= std::min(a1, b1))
+          return false;
+      }
+      return true;
+    };
+
+    std::array<std::vector<int>, 2> src_dest;
+    for (int k = -1; k <= 1; ++k)
+    {
+      for (int j = -1; j <= 1; ++j)
+      {
+        for (int i = -1; i <= 1; ++i)
+        {
+          std::array<int, 3> qn = {q[0] + i, q[1] + j, q[2] + k};
+          auto valid = [&](int d) { return qn[d] >= 0 and qn[d] < dims[d]; };
+          if (std::ranges::equal(qn, q)
+              or !(valid(0) and valid(1) and valid(2)))
+          {
+            continue;
+          }
+
+          if (intersect(qn, q, owned, local))
+            src_dest[0].push_back(to_rank(qn));
+          if (intersect(q, qn, owned, local))
+            src_dest[1].push_back(to_rank(qn));
+        }
+      }
+    }
+    std::ranges::sort(src_dest[0]);
+    std::ranges::sort(src_dest[1]);
+    return src_dest;
+  };
+
+  // Iterate over the grid indices in a range, lexicographically
+  auto for_each_index = [](const std::array<std::array<std::int64_t, 2>, 3>& r,
+                           auto&& f)
+  {
+    for (std::int64_t k = r[2][0]; k < r[2][1]; ++k)
+      for (std::int64_t j = r[1][0]; j < r[1][1]; ++j)
+        for (std::int64_t i = r[0][0]; i < r[0][1]; ++i)
+          f(std::array{i, j, k});
+  };
+  auto in_range = [](const std::array<std::array<std::int64_t, 2>, 3>& r,
+                     const std::array<std::int64_t, 3>& idx)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      if (idx[i] < r[i][0] or idx[i] >= r[i][1])
+        return false;
+    }
+    return true;
+  };
+
+  std::array<std::array<std::int64_t, 2>, 3> v_owned, v_local, c_owned,
+      c_local;
+  for (int i = 0; i < 3; ++i)
+  {
+    v_owned[i] = vertices_owned(i, q[i]);
+    v_local[i] = vertices_local(i, q[i]);
+    c_owned[i] = cells_owned(i, q[i]);
+    c_local[i] = cells_local(i, q[i]);
+  }
+
+  // Number the local vertices, owned vertices first, and compute the
+  // coordinates
+  std::array<std::int64_t, 3> v_shape;
+  for (int i = 0; i < 3; ++i)
+    v_shape[i] = v_local[i][1] - v_local[i][0];
+  std::int32_t num_owned_vertices = 1;
+  for (int i = 0; i < 3; ++i)
+    num_owned_vertices *= v_owned[i][1] - v_owned[i][0];
+
+  std::vector<std::int32_t> vertex_index(v_shape[0] * v_shape[1]
+                                         * v_shape[2]);
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> ghost_owners;
+  std::vector<T> x(3 * vertex_index.size(), 0);
+  std::vector<std::int64_t> input_global_indices(vertex_index.size());
+  const std::array<T, 3> h
+      = {(p[1][0] - p[0][0]) / static_cast<T>(n[0]),
+         (p[1][1] - p[0][1]) / static_cast<T>(n[1]),
+         (p[1][2] - p[0][2]) / static_cast<T>(n[2])};
+  {
+    std::int32_t vi = 0, num_ghosts = 0;
+    for_each_index(
+        v_local,
+        [&](const std::array<std::int64_t, 3>& idx)
+        {
+          std::int32_t v;
+          if (in_range(v_owned, idx))
+          {
+            v = (idx[0] - v_owned[0][0])
+                + (v_owned[0][1] - v_owned[0][0])
+                      * ((idx[1] - v_owned[1][0])
+                         + (v_owned[1][1] - v_owned[1][0])
+                               * (idx[2] - v_owned[2][0]));
+          }
+          else
+          {
+            v = num_owned_vertices + num_ghosts++;
+            ghosts.push_back(global_index(idx, true));
+            ghost_owners.push_back(to_rank(owner(idx, true)));
+          }
+          vertex_index[vi++] = v;
+
+          for (int i = 0; i < tdim; ++i)
+            x[3 * v + i] = p[0][i] + static_cast<T>(idx[i]) * h[i];
+          input_global_indices[v]
+              = (idx[2] * nv[1] + idx[1]) * nv[0] + idx[0];
+        });
+  }
+
+  // The cells of the owned grid cells, and then of the ghost grid
+  // cells, are computed from the grid
+  auto grid = std::make_shared<const StructuredGrid>(
+      celltype, c_owned, c_local, std::move(vertex_index));
+  const int num_sub_cells = grid->num_sub_cells();
+  std::vector<std::int32_t> cells = grid->cells();
+  const std::int32_t num_owned_cells = grid->num_owned_cells();
+  std::vector<std::int64_t> original_cell_index(grid->num_cells());
+  std::vector<std::int64_t> ghost_cells;
+  std::vector<int> ghost_cell_owners;
+  for (std::int32_t c = 0; c < grid->num_cells(); c += num_sub_cells)
+  {
+    const std::array<std::int64_t, 3> idx = grid->grid_index(c);
+    std::int64_t c0
+        = num_sub_cells * ((idx[2] * n[1] + idx[1]) * n[0] + idx[0]);
+    for (int i = 0; i < num_sub_cells; ++i)
+      original_cell_index[c + i] = c0 + i;
+
+    if (c >= num_owned_cells)
+    {
+      std::int64_t g0 = num_sub_cells * global_index(idx, false);
+      int r = to_rank(owner(idx, false));
+      for (int i = 0; i < num_sub_cells; ++i)
+      {
+        ghost_cells.push_back(g0 + i);
+        ghost_cell_owners.push_back(r);
+      }
+    }
+  }
+
+  // The processes that share vertices and cells are known from the
+  // process grid, which avoids the consensus algorithm when creating the
+  // index maps
+  auto vertex_map = std::make_shared<const common::IndexMap>(
+      comm, num_owned_vertices, neighbours(vertices_owned, vertices_local),
+      ghosts, ghost_owners);
+  auto cell_map = std::make_shared<const common::IndexMap>(
+      comm, num_owned_cells, neighbours(cells_owned, cells_local),
+      ghost_cells, ghost_cell_owners);
+
+  auto topology = std::make_shared<Topology>(
+      std::vector{celltype}, vertex_map, std::vector{cell_map},
+      std::vector{std::make_shared<graph::AdjacencyList<std::int32_t>>(
+          graph::regular_adjacency_list(cells, num_cell_vertices))},
+      std::vector<std::vector<std::int64_t>>{std::move(original_cell_index)});
+  topology->set_structured_grid(grid);
+
+  // For a degree 1 coordinate element the vertices are also the
+  // geometry nodes
+  Geometry<T> geometry(vertex_map,
+                       std::vector<std::vector<std::int32_t>>{std::move(cells)},
+                       {fem::CoordinateElement<T>(celltype, 1)}, std::move(x),
+                       tdim, std::move(input_global_indices));
+
+  return Mesh<T>(comm, topology, std::move(geometry));
+}
 } // namespace impl
 } // namespace dolfinx::mesh
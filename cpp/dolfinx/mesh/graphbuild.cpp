@@ -11,6 +11,7 @@
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/sort.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <span>
 #include <utility>
@@ -21,6 +22,61 @@ using namespace dolfinx;
 namespace
 {
 //-----------------------------------------------------------------------------
+/// @brief Add edges to off-process cells to the local part of a dual
+/// graph, and convert the graph to global cell indices.
+/// @param[in] local_graph The dual graph for cells on this MPI rank.
+/// @param[in] cell_offset Global index of the first cell on this rank.
+/// @param[in] cells Local cell index of each non-local edge.
+/// @param[in] partner Global index of the off-process cell of each
+/// edge. Entries with a negative value are ignored.
+/// @return The dual graph with global cell indices.
+graph::AdjacencyList<std::int64_t>
+merge_dual_graph(const graph::AdjacencyList<std::int32_t>& local_graph,
+                 std::int64_t cell_offset, std::span<const std::int32_t> cells,
+                 std::span<const std::int64_t> partner)
+{
+  assert(cells.size() == partner.size());
+
+  // Count number of adjacency list edges
+  std::vector<std::int32_t> num_edges(local_graph.num_nodes(), 0);
+  std::adjacent_difference(std::next(local_graph.offsets().begin()),
+                           local_graph.offsets().end(), num_edges.begin());
+  for (std::size_t i = 0; i < partner.size(); ++i)
+  {
+    if (partner[i] >= 0)
+      num_edges[cells[i]] += 1;
+  }
+
+  // Compute adjacency list offsets
+  std::vector<std::int32_t> offsets(local_graph.num_nodes() + 1, 0);
+  std::partial_sum(num_edges.cbegin(), num_edges.cend(),
+                   std::next(offsets.begin()));
+
+  // Compute adjacency list data (edges)
+  std::vector<std::int64_t> data(offsets.back());
+  {
+    std::vector<std::int32_t> disp = offsets;
+
+    // Copy local data and add cell offset
+    for (std::int32_t i = 0; i < local_graph.num_nodes(); ++i)
+    {
+      auto e = local_graph.links(i);
+      disp[i] += e.size();
+      std::ranges::transform(e, std::next(data.begin(), offsets[i]),
+                             [cell_offset](auto x) { return x + cell_offset; });
+    }
+
+    // Add non-local data
+    for (std::size_t i = 0; i < partner.size(); ++i)
+    {
+      if (partner[i] >= 0)
+        data[disp[cells[i]]++] = partner[i];
+    }
+  }
+
+  return graph::AdjacencyList(std::move(data), std::move(offsets));
+}
+//-----------------------------------------------------------------------------
 /// @brief Build nonlocal part of dual graph for mesh and return number
 /// of non-local edges.
 ///
@@ -107,7 +163,7 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
     fshape1 = recv_buffer_r[0];
     vrange = {-recv_buffer_r[1], recv_buffer_r[2] + 1};
 
-    spdlog::debug("Max. vertices per facet={}", fshape1);
+    SPDLOG_DEBUG("Max. vertices per facet={}", fshape1);
   }
   const std::int32_t buffer_shape1 = fshape1 + 1;
 
@@ -298,53 +354,301 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
   MPI_Comm_free(&neigh_comm1);
 
   // --- Build new graph
-
-  // Count number of adjacency list edges
-  std::vector<std::int32_t> num_edges(local_graph.num_nodes(), 0);
-  std::adjacent_difference(std::next(local_graph.offsets().begin()),
-                           local_graph.offsets().end(), num_edges.begin());
+  std::vector<std::int64_t> partner(shape0, -1);
   for (std::size_t i = 0; i < recv_buffer1.size(); ++i)
+    partner[send_indx_to_pos[i]] = recv_buffer1[i];
+  return merge_dual_graph(local_graph, cell_offset, cells, partner);
+}
+//-----------------------------------------------------------------------------
+/// @brief Compute a 64-bit hash of a facet key, i.e. of the sorted
+/// vertices of a facet up to the first padding value.
+/// @param[in] facet Row of the facet array.
+/// @param[in] seed Seed that selects the hash function.
+/// @return The hash.
+std::uint64_t facet_hash(std::span<const std::int64_t> facet,
+                         std::uint64_t seed)
+{
+  // splitmix64 finaliser
+  auto mix = [](std::uint64_t x)
+  {
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+  };
+
+  std::uint64_t h = mix(seed);
+  for (std::int64_t v : facet)
+  {
+    if (v < 0)
+      break;
+    h = mix(h ^ static_cast<std::uint64_t>(v));
+  }
+  return h;
+}
+//-----------------------------------------------------------------------------
+/// @brief Build nonlocal part of dual graph for mesh, matching facets
+/// across processes by hashes of their vertex keys.
+///
+/// Each facet is sent to its post office as a pair of independent
+/// 64-bit hashes of its key and the attached cell, i.e. three words
+/// rather than the full (padded) key. The first hash selects the post
+/// office and the communication round, so that matching facets meet in
+/// the same round and the buffers are bounded by the number of facets
+/// per round. A facet whose hashes match more than one other facet
+/// (a collision) is resolved by matching the full keys. A false match
+/// requires a collision of both hashes of two otherwise unmatched
+/// facets, which has probability of order `n^2 / 2^128` for `n`
+/// facets.
+///
+/// @param[in] comm MPI communicator
+/// @param[in] facets Facets on this rank that are shared by only on
+/// cell on this rank (see compute_nonlocal_dual_graph).
+/// @param[in] shape1 Number of columns for `facets`.
+/// @param[in] cells Attached cell (local index) for each facet.
+/// @param[in] local_graph The dual graph for cells on this MPI rank.
+/// @param[in] chunk_size Target maximum number of facets that a process
+/// sends in a communication round.
+/// @param[in] num_threads Number of threads for hashing the keys and
+/// sorting at the post offices.
+/// @return Extended dual graph to include ghost edges (edges to
+/// off-process cells).
+graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph_hashed(
+    const MPI_Comm comm, std::span<const std::int64_t> facets,
+    std::size_t shape1, std::span<const std::int32_t> cells,
+    const graph::AdjacencyList<std::int32_t>& local_graph,
+    std::size_t chunk_size, int num_threads)
+{
+  spdlog::info("Build nonlocal part of mesh dual graph (hashed)");
+  common::Timer timer("Compute non-local part of mesh dual graph (hashed)");
+
+  const std::size_t shape0 = cells.size();
+
+  // Return empty data if mesh is not distributed
+  const int num_ranks = dolfinx::MPI::size(comm);
+  if (num_ranks == 1)
+  {
+    // Convert graph to int64_t and return
+    return graph::AdjacencyList(
+        std::vector<std::int64_t>(local_graph.array().begin(),
+                                  local_graph.array().end()),
+        local_graph.offsets());
+  }
+
+  // Get cell offset for this process for converting local cell indices
+  // to global cell indices
+  std::int64_t cell_offset = 0;
+  MPI_Request request_cell_offset;
   {
-    if (recv_buffer1[i] >= 0)
+    const std::int64_t num_local = local_graph.num_nodes();
+    MPI_Iexscan(&num_local, &cell_offset, 1, MPI_INT64_T, MPI_SUM, comm,
+                &request_cell_offset);
+  }
+
+  // Number of communication rounds, from the largest number of facets
+  // on a process
+  std::int64_t num_rounds = 1;
+  {
+    std::int64_t num_facets = shape0;
+    MPI_Allreduce(MPI_IN_PLACE, &num_facets, 1, MPI_INT64_T, MPI_MAX, comm);
+    const std::int64_t c = std::max<std::size_t>(chunk_size, 1);
+    num_rounds = std::max<std::int64_t>((num_facets + c - 1) / c, 1);
+  }
+
+  // Hash the facet keys
+  std::vector<std::uint64_t> hashes(2 * shape0);
+  common::parallel_for(shape0, num_threads,
+                       [&](std::size_t i0, std::size_t i1)
+                       {
+                         for (std::size_t i = i0; i < i1; ++i)
+                         {
+                           auto f = facets.subspan(i * shape1, shape1);
+                           hashes[2 * i] = facet_hash(f, 0);
+                           hashes[2 * i + 1] = facet_hash(f, 1);
+                         }
+                       });
+
+  // Post office (global rank) and round of each facet
+  auto dest_rank = [&hashes, num_ranks](std::size_t i) -> int
+  { return hashes[2 * i] % num_ranks; };
+  auto round = [&hashes, num_ranks, num_rounds](std::size_t i) -> std::int64_t
+  { return (hashes[2 * i] / num_ranks) % num_rounds; };
+
+  // Destination ranks
+  std::vector<int> dest(shape0);
+  for (std::size_t i = 0; i < shape0; ++i)
+    dest[i] = dest_rank(i);
+  dolfinx::radix_sort(dest);
+  dest.erase(std::unique(dest.begin(), dest.end()), dest.end());
+  const std::int64_t num_dest = dest.size();
+
+  // Order the facets by (round, neighbourhood rank), and count the
+  // facets for each
+  std::vector<std::int32_t> order(shape0);
+  std::vector<std::int32_t> counts(num_rounds * num_dest, 0);
+  {
+    std::vector<std::int64_t> key(shape0);
+    for (std::size_t i = 0; i < shape0; ++i)
     {
-      std::size_t pos = send_indx_to_pos[i];
-      std::size_t cell = cells[pos];
-      num_edges[cell] += 1;
+      auto it = std::ranges::lower_bound(dest, dest_rank(i));
+      key[i] = round(i) * num_dest + std::distance(dest.begin(), it);
+      ++counts[key[i]];
     }
+    std::iota(order.begin(), order.end(), 0);
+    dolfinx::radix_sort(order, [&key](auto i) { return key[i]; });
   }
 
-  // Compute adjacency list offsets
-  std::vector<std::int32_t> offsets(local_graph.num_nodes() + 1, 0);
-  std::partial_sum(num_edges.cbegin(), num_edges.cend(),
-                   std::next(offsets.begin()));
+  // Determine source ranks and create neighbourhood communicators for
+  // sending data to and from the post offices
+  const std::vector<int> src
+      = dolfinx::MPI::compute_graph_edges_nbx(comm, dest);
+  MPI_Comm neigh_comm0, neigh_comm1;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 dest.size(), dest.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm0);
+  MPI_Dist_graph_create_adjacent(comm, dest.size(), dest.data(), MPI_UNWEIGHTED,
+                                 src.size(), src.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm1);
 
-  // Compute adjacency list data (edges)
-  std::vector<std::int64_t> data(offsets.back());
+  // Wait for the MPI_Iexscan to complete (before using cell_offset)
+  MPI_Wait(&request_cell_offset, MPI_STATUS_IGNORE);
+
+  // Facet message: (hash 0, hash 1, global cell index)
+  constexpr int msg_size = 3;
+  MPI_Datatype compound_type;
+  MPI_Type_contiguous(msg_size, MPI_INT64_T, &compound_type);
+  MPI_Type_commit(&compound_type);
+
+  std::vector<std::int64_t> partner(shape0, -1);
+  std::vector<std::int32_t> unresolved;
+  std::size_t round_offset = 0;
+  for (std::int64_t r = 0; r < num_rounds; ++r)
   {
-    std::vector<std::int32_t> disp = offsets;
+    // Number of facets sent to each post office in this round
+    std::span<std::int32_t> num_items_per_dest(counts.data() + r * num_dest,
+                                               num_dest);
+    std::vector<std::int32_t> send_disp(num_dest + 1, 0);
+    std::partial_sum(num_items_per_dest.begin(), num_items_per_dest.end(),
+                     std::next(send_disp.begin()));
+    std::span round_order(order.data() + round_offset, send_disp.back());
+    round_offset += send_disp.back();
+
+    // Pack send buffer. The facets are ordered by destination.
+    std::vector<std::int64_t> send_buffer(msg_size * round_order.size());
+    for (std::size_t p = 0; p < round_order.size(); ++p)
+    {
+      std::int32_t i = round_order[p];
+      send_buffer[msg_size * p] = hashes[2 * i];
+      send_buffer[msg_size * p + 1] = hashes[2 * i + 1];
+      send_buffer[msg_size * p + 2] = cells[i] + cell_offset;
+    }
 
-    // Copy local data and add cell offset
-    for (std::int32_t i = 0; i < local_graph.num_nodes(); ++i)
+    // Send number of send items to post offices
+    std::vector<int> num_items_recv(src.size());
+    num_items_recv.reserve(1);
+    std::vector<int> num_send(num_items_per_dest.begin(),
+                              num_items_per_dest.end());
+    num_send.reserve(1);
+    MPI_Neighbor_alltoall(num_send.data(), 1, MPI_INT, num_items_recv.data(),
+                          1, MPI_INT, neigh_comm0);
+    std::vector<std::int32_t> recv_disp(num_items_recv.size() + 1, 0);
+    std::partial_sum(num_items_recv.begin(), num_items_recv.end(),
+                     std::next(recv_disp.begin()));
+
+    // Send/receive facets
+    std::vector<std::int64_t> recv_buffer(msg_size * recv_disp.back());
+    MPI_Neighbor_alltoallv(send_buffer.data(), num_send.data(),
+                           send_disp.data(), compound_type, recv_buffer.data(),
+                           num_items_recv.data(), recv_disp.data(),
+                           compound_type, neigh_comm0);
+    send_buffer = std::vector<std::int64_t>();
+
+    // Match facets with the same hashes. Reply with the global index of
+    // the matched cell, -1 for an unmatched facet and -2 for a
+    // collision.
+    std::vector<std::int64_t> send_buffer1(recv_disp.back(), -1);
     {
-      auto e = local_graph.links(i);
-      disp[i] += e.size();
-      std::ranges::transform(e, std::next(data.begin(), offsets[i]),
-                             [cell_offset](auto x) { return x + cell_offset; });
+      const std::vector<std::int32_t> perm
+          = dolfinx::sort_by_perm<std::int64_t>(recv_buffer, msg_size,
+                                                num_threads);
+      auto same = [&recv_buffer](std::int32_t f0, std::int32_t f1)
+      {
+        return recv_buffer[msg_size * f0] == recv_buffer[msg_size * f1]
+               and recv_buffer[msg_size * f0 + 1]
+                       == recv_buffer[msg_size * f1 + 1];
+      };
+      auto it = perm.begin();
+      while (it != perm.end())
+      {
+        auto it1 = std::find_if_not(std::next(it), perm.end(),
+                                    [&](auto f) { return same(*it, f); });
+        if (std::size_t num_matches = std::distance(it, it1);
+            num_matches == 2)
+        {
+          send_buffer1[*it] = recv_buffer[msg_size * *(it + 1) + 2];
+          send_buffer1[*(it + 1)] = recv_buffer[msg_size * *it + 2];
+        }
+        else if (num_matches > 2)
+        {
+          for (auto e = it; e != it1; ++e)
+            send_buffer1[*e] = -2;
+        }
+        it = it1;
+      }
     }
 
-    // Add non-local data
-    for (std::size_t i = 0; i < recv_buffer1.size(); ++i)
+    // Send back data
+    std::vector<std::int64_t> recv_buffer1(send_disp.back());
+    MPI_Neighbor_alltoallv(send_buffer1.data(), num_items_recv.data(),
+                           recv_disp.data(), dolfinx::MPI::mpi_t<std::int64_t>,
+                           recv_buffer1.data(), num_send.data(),
+                           send_disp.data(), dolfinx::MPI::mpi_t<std::int64_t>,
+                           neigh_comm1);
+    for (std::size_t p = 0; p < round_order.size(); ++p)
+    {
+      if (recv_buffer1[p] == -2)
+        unresolved.push_back(round_order[p]);
+      else
+        partner[round_order[p]] = recv_buffer1[p];
+    }
+  }
+
+  MPI_Type_free(&compound_type);
+  MPI_Comm_free(&neigh_comm0);
+  MPI_Comm_free(&neigh_comm1);
+
+  // Resolve collisions by matching the full facet keys
+  std::vector<std::int32_t> edge_cells(cells.begin(), cells.end());
+  std::int64_t num_unresolved = unresolved.size();
+  MPI_Allreduce(MPI_IN_PLACE, &num_unresolved, 1, MPI_INT64_T, MPI_SUM, comm);
+  if (num_unresolved > 0)
+  {
+    spdlog::info("Resolve {} facets with colliding hashes", num_unresolved);
+    std::vector<std::int64_t> facets1;
+    std::vector<std::int32_t> cells1;
+    for (std::int32_t i : unresolved)
     {
-      if (recv_buffer1[i] >= 0)
+      auto f = facets.subspan(i * shape1, shape1);
+      facets1.insert(facets1.end(), f.begin(), f.end());
+      cells1.push_back(cells[i]);
+    }
+
+    graph::AdjacencyList<std::int32_t> empty_graph(
+        std::vector<std::int32_t>(),
+        std::vector<std::int32_t>(local_graph.num_nodes() + 1, 0));
+    graph::AdjacencyList<std::int64_t> graph1 = compute_nonlocal_dual_graph(
+        comm, facets1, shape1, cells1, empty_graph);
+    for (std::int32_t c = 0; c < graph1.num_nodes(); ++c)
+    {
+      for (std::int64_t e : graph1.links(c))
       {
-        std::size_t pos = send_indx_to_pos[i];
-        std::size_t cell = cells[pos];
-        data[disp[cell]++] = recv_buffer1[i];
+        edge_cells.push_back(c);
+        partner.push_back(e);
       }
     }
   }
 
-  return graph::AdjacencyList(std::move(data), std::move(offsets));
+  return merge_dual_graph(local_graph, cell_offset, edge_cells, partner);
 }
 //-----------------------------------------------------------------------------
 } // namespace
@@ -576,3 +880,26 @@ mesh::build_dual_graph(MPI_Comm comm, std::span<const CellType> celltypes,
   return graph;
 }
 //-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int64_t> mesh::build_dual_graph_hashed(
+    MPI_Comm comm, std::span<const CellType> celltypes,
+    const std::vector<std::span<const std::int64_t>>& cells,
+    std::size_t chunk_size, int num_threads)
+{
+  spdlog::info("Building mesh dual graph (hashed facet keys)");
+
+  // Compute local part of dual graph (cells are graph nodes, and edges
+  // are connections by facet)
+  auto [local_graph, facets, shape1, fcells]
+      = mesh::build_local_dual_graph(celltypes, cells);
+
+  // Extend with nonlocal edges and convert to global indices
+  graph::AdjacencyList graph = compute_nonlocal_dual_graph_hashed(
+      comm, facets, shape1, fcells, local_graph, chunk_size, num_threads);
+
+  spdlog::info("Graph edges (local: {}, non-local: {})",
+               local_graph.offsets().back(),
+               graph.offsets().back() - local_graph.offsets().back());
+
+  return graph;
+}
+//-----------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <mpi.h>
 #include <span>
@@ -75,4 +76,32 @@ graph::AdjacencyList<std::int64_t>
 build_dual_graph(MPI_Comm comm, std::span<const CellType> celltypes,
                  const std::vector<std::span<const std::int64_t>>& cells);
 
+/// @brief Build distributed mesh dual graph (cell-cell connections via
+/// facets), matching facets across processes by hashes of their vertex
+/// keys.
+///
+/// This computes the same graph as build_dual_graph with less memory.
+/// The facets on process boundaries are sent to the post offices as
+/// two 64-bit hashes of their keys and the attached cell, rather than
+/// by the vertices of their keys, and the facets are sent in rounds of
+/// bounded size. Hash collisions are resolved by matching the full
+/// keys of the colliding facets.
+///
+/// @note Collective function
+///
+/// @param[in] comm The MPI communicator
+/// @param[in] celltypes List of cell types
+/// @param[in] cells Collections of cells, defined by the cell vertices
+/// from which to build the dual graph, as flattened arrays for each
+/// cell type in `celltypes`.
+/// @param[in] chunk_size Target maximum number of facets that a
+/// process sends in a communication round.
+/// @param[in] num_threads Number of threads for hashing and sorting the
+/// facet keys.
+/// @return The dual graph
+graph::AdjacencyList<std::int64_t>
+build_dual_graph_hashed(MPI_Comm comm, std::span<const CellType> celltypes,
+                        const std::vector<std::span<const std::int64_t>>& cells,
+                        std::size_t chunk_size = 1 << 22, int num_threads = 1);
+
 } // namespace dolfinx::mesh
@@ -12,7 +12,10 @@
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <numeric>
+#include <span>
 
 namespace
 {
@@ -118,10 +121,22 @@ compute_quad_rot_reflect(const std::vector<std::int32_t>& e_vertices,
   return {(post > pre) == (g_post < g_pre), rots};
 }
 //-----------------------------------------------------------------------------
+// Global index of each (owned and ghost) vertex of a topology
+std::vector<std::int64_t> global_vertex_indices(const mesh::Topology& topology)
+{
+  auto im = topology.index_map(0);
+  assert(im);
+  std::vector<std::int32_t> vertices(im->size_local() + im->num_ghosts());
+  std::iota(vertices.begin(), vertices.end(), 0);
+  std::vector<std::int64_t> gvertices(vertices.size());
+  im->local_to_global(vertices, gvertices);
+  return gvertices;
+}
+//-----------------------------------------------------------------------------
 template <int BITSETSIZE>
-std::vector<std::bitset<BITSETSIZE>>
-compute_triangle_quad_face_permutations(const mesh::Topology& topology,
-                                        int cell_index)
+std::vector<std::bitset<BITSETSIZE>> compute_triangle_quad_face_permutations(
+    const mesh::Topology& topology, int cell_index,
+    std::span<const std::int64_t> gvertices, int num_threads)
 {
   std::vector<mesh::CellType> cell_types = topology.entity_types(3);
   mesh::CellType cell_type = cell_types.at(cell_index);
@@ -156,57 +171,59 @@ compute_triangle_quad_face_permutations(const mesh::Topology& topology,
 
   const std::int32_t num_cells = c_to_v->num_nodes();
   std::vector<std::bitset<BITSETSIZE>> face_perm(num_cells, 0);
-  std::vector<std::int64_t> cell_vertices, vertices;
-  std::vector<std::int32_t> e_vertices;
-  auto im = topology.index_map(0);
-
   for (std::size_t t = 0; t < face_type_indices.size(); ++t)
   {
     spdlog::info("Computing permutations for face type {}", t);
-    if (!face_type_indices[t].empty())
-    {
-      auto compute_refl_rots = (mesh_face_types[t] == mesh::CellType::triangle)
-                                   ? compute_triangle_rot_reflect
-                                   : compute_quad_rot_reflect;
-      for (int c = 0; c < num_cells; ++c)
-      {
-        cell_vertices.resize(c_to_v->links(c).size());
-        im->local_to_global(c_to_v->links(c), cell_vertices);
+    if (face_type_indices[t].empty())
+      continue;
+
+    auto compute_refl_rots = (mesh_face_types[t] == mesh::CellType::triangle)
+                                 ? compute_triangle_rot_reflect
+                                 : compute_quad_rot_reflect;
 
-        auto cell_faces = c_to_f[t]->links(c);
-        for (std::size_t i = 0; i < cell_faces.size(); ++i)
+    // Cells are independent, and are divided between threads
+    common::parallel_for(
+        num_cells, num_threads,
+        [&, t](std::size_t c0, std::size_t c1)
         {
-          // Get the face
-          const int face = cell_faces[i];
-          e_vertices.resize(f_to_v[t]->num_links(face));
-          vertices.resize(f_to_v[t]->num_links(face));
-          im->local_to_global(f_to_v[t]->links(face), vertices);
-
-          // Orient that triangle or quadrilateral so the lowest numbered
-          // vertex is the origin, and the next vertex anticlockwise from
-          // the lowest has a lower number than the next vertex clockwise.
-          // Find the index of the lowest numbered vertex.
-
-          // Find iterators pointing to cell vertex given a vertex on facet
-          for (std::size_t j = 0; j < vertices.size(); ++j)
+          std::vector<std::int64_t> vertices;
+          std::vector<std::int32_t> e_vertices;
+          for (std::size_t c = c0; c < c1; ++c)
           {
-            auto it = std::find(cell_vertices.begin(), cell_vertices.end(),
-                                vertices[j]);
-            // Get the actual local vertex indices
-            e_vertices[j] = std::distance(cell_vertices.begin(), it);
+            auto cell_vertices = c_to_v->links(c);
+            auto cell_faces = c_to_f[t]->links(c);
+            for (std::size_t i = 0; i < cell_faces.size(); ++i)
+            {
+              // Get the face
+              auto face_vertices = f_to_v[t]->links(cell_faces[i]);
+              e_vertices.resize(face_vertices.size());
+              vertices.resize(face_vertices.size());
+
+              // Orient that triangle or quadrilateral so the lowest
+              // numbered vertex is the origin, and the next vertex
+              // anticlockwise from the lowest has a lower number than
+              // the next vertex clockwise. Find the index of the lowest
+              // numbered vertex.
+
+              // Find the cell-local index of each vertex of the face
+              for (std::size_t j = 0; j < face_vertices.size(); ++j)
+              {
+                auto it = std::ranges::find(cell_vertices, face_vertices[j]);
+                e_vertices[j] = std::distance(cell_vertices.begin(), it);
+                vertices[j] = gvertices[face_vertices[j]];
+              }
+
+              // Compute reflections and rotations for this face type
+              auto [refl, rots] = compute_refl_rots(e_vertices, vertices);
+
+              // Store bits for this face
+              int fi = face_type_indices[t][i];
+              face_perm[c][3 * fi] = refl;
+              face_perm[c][3 * fi + 1] = rots % 2;
+              face_perm[c][3 * fi + 2] = rots / 2;
+            }
           }
-
-          // Compute reflections and rotations for this face type
-          auto [refl, rots] = compute_refl_rots(e_vertices, vertices);
-
-          // Store bits for this face
-          int fi = face_type_indices[t][i];
-          face_perm[c][3 * fi] = refl;
-          face_perm[c][3 * fi + 1] = rots % 2;
-          face_perm[c][3 * fi + 2] = rots / 2;
-        }
-      }
-    }
+        });
   }
 
   return face_perm;
@@ -214,14 +231,14 @@ compute_triangle_quad_face_permutations(const mesh::Topology& topology,
 //-----------------------------------------------------------------------------
 template <int BITSETSIZE>
 std::vector<std::bitset<BITSETSIZE>>
-compute_edge_reflections(const mesh::Topology& topology)
+compute_edge_reflections(const mesh::Topology& topology,
+                         std::span<const std::int64_t> gvertices,
+                         int num_threads)
 {
   mesh::CellType cell_type = topology.cell_type();
   const int tdim = topology.dim();
   const int edges_per_cell = cell_num_entities(cell_type, 1);
 
-  const std::int32_t num_cells = topology.connectivity(tdim, 0)->num_nodes();
-
   auto c_to_v = topology.connectivity(tdim, 0);
   assert(c_to_v);
   auto c_to_e = topology.connectivity(tdim, 1);
@@ -229,42 +246,46 @@ compute_edge_reflections(const mesh::Topology& topology)
   auto e_to_v = topology.connectivity(1, 0);
   assert(e_to_v);
 
-  auto im = topology.index_map(0);
-  assert(im);
-
+  const std::int32_t num_cells = c_to_v->num_nodes();
   std::vector<std::bitset<BITSETSIZE>> edge_perm(num_cells, 0);
-  std::vector<std::int64_t> cell_vertices, vertices;
-  for (int c = 0; c < c_to_v->num_nodes(); ++c)
-  {
-    cell_vertices.resize(c_to_v->num_links(c));
-    im->local_to_global(c_to_v->links(c), cell_vertices);
-    auto cell_edges = c_to_e->links(c);
-    for (int i = 0; i < edges_per_cell; ++i)
-    {
-      vertices.resize(e_to_v->links(cell_edges[i]).size());
-      im->local_to_global(e_to_v->links(cell_edges[i]), vertices);
-
-      // If the entity is an interval, it should be oriented pointing
-      // from the lowest numbered vertex to the highest numbered vertex.
-
-      // Find iterators pointing to cell vertex given a vertex on facet
-      auto it0
-          = std::find(cell_vertices.begin(), cell_vertices.end(), vertices[0]);
-      auto it1
-          = std::find(cell_vertices.begin(), cell_vertices.end(), vertices[1]);
-
-      // The number of reflections. Comparing iterators directly instead
-      // of values they point to is sufficient here.
-      edge_perm[c][i] = (it1 < it0) == (vertices[1] > vertices[0]);
-    }
-  }
+  common::parallel_for(
+      num_cells, num_threads,
+      [&](std::size_t c0, std::size_t c1)
+      {
+        for (std::size_t c = c0; c < c1; ++c)
+        {
+          auto cell_vertices = c_to_v->links(c);
+          auto cell_edges = c_to_e->links(c);
+          for (int i = 0; i < edges_per_cell; ++i)
+          {
+            auto vertices = e_to_v->links(cell_edges[i]);
+
+            // If the entity is an interval, it should be oriented
+            // pointing from the lowest numbered vertex to the highest
+            // numbered vertex.
+
+            // Find iterators pointing to cell vertex given a vertex on
+            // facet
+            auto it0 = std::ranges::find(cell_vertices, vertices[0]);
+            auto it1 = std::ranges::find(cell_vertices, vertices[1]);
+
+            // The number of reflections. Comparing iterators directly
+            // instead of values they point to is sufficient here.
+            edge_perm[c][i] = (it1 < it0)
+                              == (gvertices[vertices[1]]
+                                  > gvertices[vertices[0]]);
+          }
+        }
+      });
 
   return edge_perm;
 }
 //-----------------------------------------------------------------------------
 template <int BITSETSIZE>
 std::vector<std::bitset<BITSETSIZE>>
-compute_face_permutations(const mesh::Topology& topology)
+compute_face_permutations(const mesh::Topology& topology,
+                          std::span<const std::int64_t> gvertices,
+                          int num_threads)
 {
   if (topology.entity_types(3).size() > 1)
   {
@@ -278,14 +299,16 @@ compute_face_permutations(const mesh::Topology& topology)
     throw std::runtime_error("Faces have not been computed.");
 
   // Compute face permutations for first cell type in the topology
-  return compute_triangle_quad_face_permutations<BITSETSIZE>(topology, 0);
+  return compute_triangle_quad_face_permutations<BITSETSIZE>(
+      topology, 0, gvertices, num_threads);
 }
 //-----------------------------------------------------------------------------
 } // namespace
 
 //-----------------------------------------------------------------------------
 std::pair<std::vector<std::uint8_t>, std::vector<std::uint32_t>>
-mesh::compute_entity_permutations(const mesh::Topology& topology)
+mesh::compute_entity_permutations(const mesh::Topology& topology,
+                                  int num_threads)
 {
   common::Timer t_perm("Compute entity permutations");
   const int tdim = topology.dim();
@@ -293,14 +316,21 @@ mesh::compute_entity_permutations(const mesh::Topology& topology)
   const std::int32_t num_cells = topology.connectivity(tdim, 0)->num_nodes();
   const int facets_per_cell = cell_num_entities(cell_type, tdim - 1);
 
+  // Map vertices to global indices once, rather than for each
+  // cell-entity pair
+  const std::vector<std::int64_t> gvertices
+      = tdim > 1 ? global_vertex_indices(topology)
+                 : std::vector<std::int64_t>();
+
   std::vector<std::uint32_t> cell_permutation_info(num_cells, 0);
-  std::vector<std::uint8_t> facet_permutations(num_cells * facets_per_cell);
   std::int32_t used_bits = 0;
   if (tdim > 2)
   {
     spdlog::info("Compute face permutations");
     const int faces_per_cell = cell_num_entities(cell_type, 2);
-    const auto face_perm = compute_face_permutations<_BITSETSIZE>(topology);
+    const auto face_perm
+        = compute_face_permutations<_BITSETSIZE>(topology, gvertices,
+                                                 num_threads);
     for (int c = 0; c < num_cells; ++c)
       cell_permutation_info[c] = face_perm[c].to_ulong();
 
@@ -308,36 +338,41 @@ mesh::compute_entity_permutations(const mesh::Topology& topology)
     // 4 sides are implemented, this will need to be increased.
     used_bits += faces_per_cell * 3;
     assert(tdim == 3);
-    for (int c = 0; c < num_cells; ++c)
-    {
-      for (int i = 0; i < facets_per_cell; ++i)
-      {
-        facet_permutations[c * facets_per_cell + i]
-            = (cell_permutation_info[c] >> (3 * i)) & 7;
-      }
-    }
   }
 
   if (tdim > 1)
   {
     spdlog::info("Compute edge permutations");
     const int edges_per_cell = cell_num_entities(cell_type, 1);
-    const auto edge_perm = compute_edge_reflections<_BITSETSIZE>(topology);
+    const auto edge_perm
+        = compute_edge_reflections<_BITSETSIZE>(topology, gvertices,
+                                                num_threads);
     for (int c = 0; c < num_cells; ++c)
       cell_permutation_info[c] |= edge_perm[c].to_ulong() << used_bits;
 
     used_bits += edges_per_cell;
-    if (tdim == 2)
-    {
-      for (int c = 0; c < num_cells; ++c)
-      {
-        for (int i = 0; i < facets_per_cell; ++i)
-          facet_permutations[c * facets_per_cell + i] = edge_perm[c][i];
-      }
-    }
   }
   assert(used_bits < _BITSETSIZE);
 
+  // Unpack the facet permutations from the cell permutation info
+  std::vector<std::uint8_t> facet_permutations(num_cells * facets_per_cell, 0);
+  if (tdim > 1)
+  {
+    common::parallel_for(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
+        {
+          for (std::size_t c = c0; c < c1; ++c)
+          {
+            for (int i = 0; i < facets_per_cell; ++i)
+            {
+              facet_permutations[c * facets_per_cell + i]
+                  = facet_permutation(cell_permutation_info[c], i, tdim);
+            }
+          }
+        });
+  }
+
   return {std::move(facet_permutations), std::move(cell_permutation_info)};
 }
 //-----------------------------------------------------------------------------
@@ -66,8 +66,41 @@ class Topology;
 ///    This data is used to correct the direction of vector function
 ///    on permuted facets.
 ///
+/// The cell permutation data is the compact form of the facet
+/// permutation data: the permutation of a facet can be extracted from
+/// the cell permutation data with facet_permutation(). The facet data
+/// uses one byte per facet since it is passed by pointer to the
+/// kernels.
+///
+/// @param[in] topology Mesh topology. The entities of all dimensions
+/// must have been created.
+/// @param[in] num_threads Number of threads. The cells are divided
+/// between the threads.
 /// @return Facet permutation and cells permutations
 std::pair<std::vector<std::uint8_t>, std::vector<std::uint32_t>>
-compute_entity_permutations(const Topology& topology);
+compute_entity_permutations(const Topology& topology, int num_threads = 1);
+
+/// @brief Extract the permutation of a facet of a cell from cell
+/// permutation data.
+///
+/// @param[in] cell_info Cell permutation data of the cell, see
+/// compute_entity_permutations().
+/// @param[in] facet Cell-local index of the facet.
+/// @param[in] tdim Topological dimension of the cell.
+/// @return Facet permutation, encoded as for the facet permutation data
+/// returned by compute_entity_permutations().
+constexpr std::uint8_t facet_permutation(std::uint32_t cell_info, int facet,
+                                         int tdim)
+{
+  switch (tdim)
+  {
+  case 3:
+    return (cell_info >> (3 * facet)) & 7;
+  case 2:
+    return (cell_info >> facet) & 1;
+  default:
+    return 0;
+  }
+}
 
 } // namespace dolfinx::mesh
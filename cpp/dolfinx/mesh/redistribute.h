@@ -0,0 +1,192 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Mesh.h"
+#include "MeshTags.h"
+#include "Topology.h"
+#include "cell_types.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <basix/mdspan.hpp>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/partitioners.h>
+#include <dolfinx/io/utils.h>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+/// @brief Redistribute a mesh across processes, e.g. to restore the
+/// load balance after refinement.
+///
+/// The owned cells and geometry nodes of `mesh` are passed to
+/// create_mesh with the new partitioner, i.e. cells and geometry are
+/// migrated in memory. The 'original' input indices of the new mesh
+/// (Topology::original_cell_index and Geometry::input_global_indices)
+/// are the global indices of the cells and geometry nodes in `mesh`.
+///
+/// MeshTags can be transferred to the new mesh using
+/// redistribute_meshtags. Finite element functions can be transferred
+/// by interpolation between the (non-matching) meshes, see
+/// fem::create_interpolation_data, which is exact for functions in the
+/// same space since the meshes are geometrically identical.
+///
+/// @note Collective.
+///
+/// @param[in] mesh Mesh to redistribute.
+/// @param[in] partitioner Partitioner that computes the new owning rank
+/// of each cell, e.g. create_cell_partitioner.
+/// @return The redistributed mesh.
+template <std::floating_point T>
+Mesh<T> redistribute(const Mesh<T>& mesh,
+                     const CellPartitionFunction& partitioner)
+{
+  common::Timer timer("Redistribute mesh");
+  spdlog::info("Redistribute mesh across ranks");
+
+  auto topology = mesh.topology();
+  assert(topology);
+  if (topology->cell_types().size() > 1)
+  {
+    throw std::runtime_error(
+        "Redistribution of meshes with mixed cell types is not supported.");
+  }
+
+  // Owned cells, with nodes using the global geometry indices
+  const Geometry<T>& geometry = mesh.geometry();
+  const int tdim = topology->dim();
+  const std::int32_t num_cells = topology->index_map(tdim)->size_local();
+  auto xdofmap = geometry.dofmap();
+  std::span<const std::int32_t> cells_local(
+      xdofmap.data_handle(), num_cells * xdofmap.extent(1));
+  std::vector<std::int64_t> cells(cells_local.size());
+  geometry.index_map()->local_to_global(cells_local, cells);
+
+  // Coordinates of owned nodes
+  const std::size_t gdim = geometry.dim();
+  const std::int32_t num_nodes = geometry.index_map()->size_local();
+  std::span<const T> x_g = geometry.x();
+  std::vector<T> x(num_nodes * gdim);
+  for (std::int32_t i = 0; i < num_nodes; ++i)
+    std::copy_n(std::next(x_g.begin(), 3 * i), gdim,
+                std::next(x.begin(), gdim * i));
+
+  return create_mesh(mesh.comm(), mesh.comm(), cells, geometry.cmap(),
+                     mesh.comm(), x, {(std::size_t)num_nodes, gdim},
+                     partitioner);
+}
+
+/// @brief Create a mesh with the same cell ownership as `mesh` and
+/// the requested number of layers of ghost cells.
+///
+/// Each rank keeps its owned cells, so the mesh is not repartitioned
+/// and the owned cell and geometry data do not migrate. The ghost
+/// cells are computed from the dual graph of the mesh, see
+/// create_cell_partitioner. This is much cheaper than creating the
+/// mesh again from the input data, e.g. to obtain the two or more
+/// ghost layers required by patch-based methods. MeshTags are
+/// transferred by redistribute_meshtags.
+///
+/// @note Collective.
+///
+/// @param[in] mesh The mesh.
+/// @param[in] num_ghost_layers Number of layers of ghost cells.
+/// @return Mesh with the owned cells of `mesh` (possibly reordered on
+/// each rank) and `num_ghost_layers` layers of ghost cells.
+template <std::floating_point T>
+Mesh<T> extend_ghosting(const Mesh<T>& mesh, int num_ghost_layers)
+{
+  const int rank = dolfinx::MPI::rank(mesh.comm());
+  const std::int32_t num_cells
+      = mesh.topology()->index_map(mesh.topology()->dim())->size_local();
+  return redistribute(
+      mesh, create_cell_partitioner(
+                GhostMode::shared_facet,
+                graph::fixed::partitioner(
+                    std::vector<std::int32_t>(num_cells, rank)),
+                num_ghost_layers));
+}
+
+/// @brief Transfer MeshTags to a mesh that was created by
+/// redistribute or extend_ghosting.
+///
+/// @note Collective.
+///
+/// @param[in] tags Tags on `mesh0`.
+/// @param[in] mesh0 The mesh that `tags` are defined on.
+/// @param[in] mesh1 Mesh created by redistributing `mesh0`.
+/// @return Tags on `mesh1`. Only the tags of entities that are owned
+/// on `mesh0` are transferred, i.e. tags of ghost entities are assumed
+/// to be consistent with the owner.
+///
+/// @pre The connectivities `dim -> tdim` and `tdim -> dim` must have
+/// been computed for `mesh0`, and the entities of dimension `dim`
+/// (with the connectivity `dim -> 0`) must have been created for
+/// `mesh1`, where `dim` is the dimension of the tagged entities.
+template <typename U, std::floating_point T>
+MeshTags<U> redistribute_meshtags(const MeshTags<U>& tags,
+                                  const Mesh<T>& mesh0, const Mesh<T>& mesh1)
+{
+  const int dim = tags.dim();
+  auto topology1 = mesh1.topology();
+  assert(topology1);
+  if (!topology1->index_map(dim))
+  {
+    throw std::runtime_error("Mesh entities of dimension "
+                             + std::to_string(dim)
+                             + " have not been created.");
+  }
+
+  // Owned tagged entities, by the global geometry indices of their
+  // nodes on mesh0, which are the input global indices of mesh1
+  std::span<const std::int32_t> indices = tags.indices();
+  std::span<const U> values = tags.values();
+  auto it = std::ranges::lower_bound(
+      indices, mesh0.topology()->index_map(dim)->size_local());
+  std::size_t num_entities = std::distance(indices.begin(), it);
+  auto [nodes, eshape] = entities_to_geometry(
+      mesh0, dim, indices.first(num_entities), false);
+  std::vector<std::int64_t> nodes_g(nodes.size());
+  mesh0.geometry().index_map()->local_to_global(nodes, nodes_g);
+
+  // Set the number of nodes per entity, which is also needed when
+  // there are no owned tagged entities
+  const fem::ElementDofLayout layout
+      = mesh1.geometry().cmap().create_dof_layout();
+  eshape[1] = layout.entity_closure_dofs(dim, 0).size();
+
+  md::mdspan<const std::int64_t, md::dextents<std::size_t, 2>> entities(
+      nodes_g.data(), eshape);
+  auto [entities1, values1] = io::distribute_entity_data<U>(
+      *topology1, mesh1.geometry().input_global_indices(),
+      mesh1.geometry().index_map()->size_global(), layout,
+      mesh1.geometry().dofmap(), dim, entities,
+      values.first(num_entities));
+
+  std::size_t num_vertices_per_entity = cell_num_entities(
+      cell_entity_type(topology1->cell_type(), dim, 0), 0);
+  const graph::AdjacencyList<std::int32_t> entities_adj
+      = graph::regular_adjacency_list(std::move(entities1),
+                                      num_vertices_per_entity);
+  MeshTags<U> tags1 = create_meshtags(topology1, dim, entities_adj,
+                                      std::span<const U>(values1));
+  tags1.name = tags.name;
+  return tags1;
+}
+
+} // namespace dolfinx::mesh
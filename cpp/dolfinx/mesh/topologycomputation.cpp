@@ -15,6 +15,7 @@
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/sort.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <memory>
 #include <mpi.h>
@@ -447,6 +448,8 @@ get_local_indexing(MPI_Comm comm, const common::IndexMap& vertex_map,
 /// @param[in] shared_vertices TODO
 /// @param[in] cell_type Cell type
 /// @param[in] dim Topological dimension of the entities to be computed
+/// @param[in] num_threads Number of threads used for building and
+/// sorting the entity keys and numbering the entities
 /// @return Returns the (cell-entity connectivity, entity-vertex
 /// connectivity, index map for the entity distribution across
 /// processes, shared entities)
@@ -461,7 +464,7 @@ compute_entities_by_key_matching(
                    std::shared_ptr<const common::IndexMap>>>
         cell_lists,
     const common::IndexMap& vertex_index_map, mesh::CellType entity_type,
-    int dim)
+    int dim, int num_threads)
 {
   if (dim == 0)
   {
@@ -508,57 +511,73 @@ compute_entities_by_key_matching(
     // Create map from cell vertices to entity vertices
     auto e_vertices = get_entity_vertices(cell_type, dim);
 
+    // Cells of the same type have the same number of vertices
+    auto cell_vertices = graph::regular_view(*cells);
     const std::size_t num_cells = cells->num_nodes();
     int num_entities_per_cell = cell_type_entities[k].size();
-    for (std::size_t c = 0; c < num_cells; ++c)
-    {
-      // Get vertices from each cell
-      auto vertices = cells->links(c);
-
-      for (int i = 0; i < num_entities_per_cell; ++i)
-      {
-        const std::int32_t idx = c * num_entities_per_cell + i;
-        auto ev = e_vertices.links(cell_type_entities[k][i]);
-
-        // Get entity vertices. Padded with -1 if fewer than
-        // max_vertices_per_entity
-        // NOTE Entity orientation is determined by vertex ordering. The
-        // orientation of an entity with respect to the cell may differ from its
-        // global mesh orientation. Hence, we reorder the vertices so that
-        // each entity's orientation agrees with their global orientation.
-        // FIXME This might be better below when the entity to vertex
-        // connectivity is computed
-        std::vector<std::int32_t> entity_vertices(ev.size());
-        for (std::size_t j = 0; j < ev.size(); ++j)
-          entity_vertices[j] = vertices[ev[j]];
-
-        // Orient the entities. Simply sort according to global vertex index
-        // for simplices
-        std::vector<std::int64_t> global_vertices(entity_vertices.size());
-        vertex_index_map.local_to_global(entity_vertices, global_vertices);
-
-        std::vector<std::size_t> perm(global_vertices.size());
-        std::iota(perm.begin(), perm.end(), 0);
-        std::ranges::sort(
-            perm, [&global_vertices](std::size_t i0, std::size_t i1)
-            { return global_vertices[i0] < global_vertices[i1]; });
-        // For quadrilaterals, the vertex opposite the lowest vertex should
-        // be last
-        if (entity_type == mesh::CellType::quadrilateral)
+    common::parallel_for(
+        num_cells, num_threads,
+        [&, k](std::size_t c0, std::size_t c1)
         {
-          std::size_t min_vertex_idx = perm[0];
-          std::size_t opposite_vertex_index = 3 - min_vertex_idx;
-          auto it = std::find(perm.begin(), perm.end(), opposite_vertex_index);
-          assert(it != perm.end());
-          std::rotate(it, it + 1, perm.end());
-        }
-
-        for (std::size_t j = 0; j < ev.size(); ++j)
-          entity_list[(cell_type_offsets[k] + idx) * num_vertices_per_entity
-                      + j]
-              = entity_vertices[perm[j]];
-      }
-    }
+          std::vector<std::int32_t> entity_vertices;
+          std::vector<std::int64_t> global_vertices;
+          std::vector<std::size_t> perm;
+          for (std::size_t c = c0; c < c1; ++c)
+          {
+            // Get vertices from each cell
+            auto vertices = cell_vertices.links(c);
+
+            for (int i = 0; i < num_entities_per_cell; ++i)
+            {
+              const std::int32_t idx = c * num_entities_per_cell + i;
+              auto ev = e_vertices.links(cell_type_entities[k][i]);
+
+              // Get entity vertices. Padded with -1 if fewer than
+              // max_vertices_per_entity
+              // NOTE Entity orientation is determined by vertex
+              // ordering. The orientation of an entity with respect to
+              // the cell may differ from its global mesh orientation.
+              // Hence, we reorder the vertices so that each entity's
+              // orientation agrees with their global orientation.
+              // FIXME This might be better below when the entity to
+              // vertex connectivity is computed
+              entity_vertices.resize(ev.size());
+              for (std::size_t j = 0; j < ev.size(); ++j)
+                entity_vertices[j] = vertices[ev[j]];
+
+              // Orient the entities. Simply sort according to global
+              // vertex index for simplices
+              global_vertices.resize(entity_vertices.size());
+              vertex_index_map.local_to_global(entity_vertices,
+                                               global_vertices);
+
+              perm.resize(global_vertices.size());
+              std::iota(perm.begin(), perm.end(), 0);
+              std::ranges::sort(
+                  perm, [&global_vertices](std::size_t i0, std::size_t i1)
+                  { return global_vertices[i0] < global_vertices[i1]; });
+              // For quadrilaterals, the vertex opposite the lowest
+              // vertex should be last
+              if (entity_type == mesh::CellType::quadrilateral)
+              {
+                std::size_t min_vertex_idx = perm[0];
+                std::size_t opposite_vertex_index = 3 - min_vertex_idx;
+                auto it = std::find(perm.begin(), perm.end(),
+                                    opposite_vertex_index);
+                assert(it != perm.end());
+                std::rotate(it, it + 1, perm.end());
+              }
+
+              for (std::size_t j = 0; j < ev.size(); ++j)
+              {
+                entity_list[(cell_type_offsets[k] + idx)
+                                * num_vertices_per_entity
+                            + j]
+                    = entity_vertices[perm[j]];
+              }
+            }
+          }
+        });
   }
 
   // Start numbering entities
@@ -568,45 +587,66 @@ compute_entities_by_key_matching(
   {
     // Copy list and sort vertices of each entity into (reverse) order
     std::vector<std::int32_t> entity_list_sorted = entity_list;
-    for (std::size_t j = 0; j < entity_index.size(); ++j)
-    {
-      auto it
-          = std::next(entity_list_sorted.begin(), j * num_vertices_per_entity);
-      std::sort(it, std::next(it, num_vertices_per_entity), std::less<>());
-    }
+    common::parallel_for(
+        entity_index.size(), num_threads,
+        [&](std::size_t j0, std::size_t j1)
+        {
+          for (std::size_t j = j0; j < j1; ++j)
+          {
+            auto it = std::next(entity_list_sorted.begin(),
+                                j * num_vertices_per_entity);
+            std::sort(it, std::next(it, num_vertices_per_entity),
+                      std::less<>());
+          }
+        });
 
     // Sort the list and label uniquely
     const std::vector<std::int32_t> sort_order
-        = dolfinx::sort_by_perm<std::int32_t>(entity_list_sorted,
-                                              num_vertices_per_entity);
+        = dolfinx::sort_by_perm<std::int32_t>(
+            entity_list_sorted, num_vertices_per_entity, num_threads);
 
-    std::vector<std::int32_t> entity(num_vertices_per_entity),
-        entity0(num_vertices_per_entity);
-    auto it = sort_order.begin();
-    while (it != sort_order.end())
+    // An entity in the sorted list starts a new index range if it
+    // differs from the preceding entity
+    auto is_first = [&](std::size_t p) -> bool
     {
-      // First entity in new index range
-      std::size_t offset = (*it) * num_vertices_per_entity;
-      std::span e0(entity_list_sorted.data() + offset, num_vertices_per_entity);
-
-      // Find iterator to next entity
-      auto it1 = std::find_if_not(
-          it, sort_order.end(),
-          [e0, &entity_list_sorted, num_vertices_per_entity](auto idx) -> bool
-          {
-            std::size_t offset = idx * num_vertices_per_entity;
-            return std::equal(e0.begin(), e0.end(),
-                              std::next(entity_list_sorted.begin(), offset));
-          });
-
-      // Set entity unique index
-      std::for_each(it, it1, [&entity_index, entity_count](auto idx)
-                    { entity_index[idx] = entity_count; });
+      if (p == 0)
+        return true;
+      auto e0 = std::next(entity_list_sorted.begin(),
+                          sort_order[p - 1] * num_vertices_per_entity);
+      auto e1 = std::next(entity_list_sorted.begin(),
+                          sort_order[p] * num_vertices_per_entity);
+      return !std::equal(e0, std::next(e0, num_vertices_per_entity), e1);
+    };
 
-      // Advance iterator and increment entity
-      it = it1;
-      ++entity_count;
-    }
+    // Count the unique entities in the block of sorted entities of
+    // each thread, and then set the entity index
+    const std::size_t num_sorted = sort_order.size();
+    const int nt = std::clamp<std::size_t>(
+        num_threads, 1, std::max<std::size_t>(num_sorted, 1));
+    std::vector<std::int32_t> thread_offsets(nt + 1, 0);
+    common::run_threads(
+        nt,
+        [&](int t)
+        {
+          auto [p0, p1] = common::thread_range(t, num_sorted, nt);
+          for (std::size_t p = p0; p < p1; ++p)
+            thread_offsets[t + 1] += is_first(p);
+        });
+    std::partial_sum(thread_offsets.begin(), thread_offsets.end(),
+                     thread_offsets.begin());
+    common::run_threads(
+        nt,
+        [&](int t)
+        {
+          auto [p0, p1] = common::thread_range(t, num_sorted, nt);
+          std::int32_t e = thread_offsets[t] - 1;
+          for (std::size_t p = p0; p < p1; ++p)
+          {
+            e += is_first(p);
+            entity_index[sort_order[p]] = e;
+          }
+        });
+    entity_count = thread_offsets.back();
   }
 
   //---------
@@ -765,7 +805,8 @@ compute_from_map(const graph::AdjacencyList<std::int32_t>& c_d0_0,
 std::tuple<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
            std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
            std::shared_ptr<common::IndexMap>, std::vector<std::int32_t>>
-mesh::compute_entities(const Topology& topology, int dim, CellType entity_type)
+mesh::compute_entities(const Topology& topology, int dim, CellType entity_type,
+                       int num_threads)
 {
   spdlog::info("Computing mesh entities of dimension {}", dim);
 
@@ -813,7 +854,7 @@ mesh::compute_entities(const Topology& topology, int dim, CellType entity_type)
 
   // c->e, e->v
   auto [d0, d1, im, interprocess_entities] = compute_entities_by_key_matching(
-      topology.comm(), cell_lists, *vertex_map, entity_type, dim);
+      topology.comm(), cell_lists, *vertex_map, entity_type, dim, num_threads);
 
   return {d0,
           std::make_shared<graph::AdjacencyList<std::int32_t>>(std::move(d1)),
@@ -11,13 +11,20 @@
 #include "cell_types.h"
 #include "graphbuild.h"
 #include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/math.h>
+#include <dolfinx/common/sort.h>
 #include <dolfinx/fem/ElementDofLayout.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/ordering.h>
 #include <dolfinx/graph/partition.h>
+#include <limits>
+#include <numeric>
 #include <span>
 #include <stdexcept>
 #include <vector>
@@ -58,49 +65,25 @@ mesh::extract_topology(CellType cell_type, const fem::ElementDofLayout& layout,
 std::vector<std::int32_t> mesh::exterior_facet_indices(const Topology& topology,
                                                        int facet_type_idx)
 {
-  const int tdim = topology.dim();
-  auto f_to_c = topology.connectivity(tdim - 1, tdim);
-  if (!f_to_c)
-  {
-    throw std::runtime_error(
-        "Facet to cell connectivity has not been computed.");
-  }
-
-  // Find all owned facets (not ghost) with only one attached cell
-  auto facet_map = topology.index_maps(tdim - 1).at(facet_type_idx);
-
-  std::vector<std::int32_t> facets;
-  for (std::int32_t f = 0; f < facet_map->size_local(); ++f)
-  {
-    if (f_to_c->num_links(f) == 1)
-      facets.push_back(f);
-  }
-
-  // Remove facets on internal inter-process boundary
-  std::vector<std::int32_t> ext_facets;
-  std::ranges::set_difference(facets,
-                              topology.interprocess_facets(facet_type_idx),
-                              std::back_inserter(ext_facets));
-
-  return ext_facets;
+  std::span facets = topology.exterior_facets(facet_type_idx);
+  return std::vector(facets.begin(), facets.end());
 }
 //------------------------------------------------------------------------------
 std::vector<std::int32_t> mesh::exterior_facet_indices(const Topology& topology)
 {
-  if (topology.entity_types(topology.dim() - 1).size() > 1)
-  {
-    throw std::runtime_error("Multiple facet types in mesh. Call "
-                             "exterior_facet_indices with facet type index.");
-  }
-
-  return mesh::exterior_facet_indices(topology, 0);
+  std::span facets = topology.exterior_facets();
+  return std::vector(facets.begin(), facets.end());
 }
 //------------------------------------------------------------------------------
 mesh::CellPartitionFunction
 mesh::create_cell_partitioner(mesh::GhostMode ghost_mode,
-                              const graph::partition_fn& partfn)
+                              const graph::partition_fn& partfn,
+                              int num_ghost_layers)
 {
-  return [partfn, ghost_mode](
+  if (num_ghost_layers < 1)
+    throw std::runtime_error("Number of ghost layers must be at least one.");
+
+  return [partfn, ghost_mode, num_ghost_layers](
              MPI_Comm comm, int nparts, const std::vector<CellType>& cell_types,
              const std::vector<std::span<const std::int64_t>>& cells)
              -> graph::AdjacencyList<std::int32_t>
@@ -115,10 +98,164 @@ mesh::create_cell_partitioner(mesh::GhostMode ghost_mode,
     bool ghosting = (ghost_mode != GhostMode::none);
 
     // Compute partition
-    return partfn(comm, nparts, dual_graph, ghosting);
+    graph::AdjacencyList<std::int32_t> dest
+        = partfn(comm, nparts, dual_graph, ghosting);
+
+    // Add further ghost layers
+    if (ghosting)
+    {
+      for (int i = 1; i < num_ghost_layers; ++i)
+        dest = graph::extend_destinations(comm, dual_graph, dest);
+    }
+
+    return dest;
+  };
+}
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
+mesh::CellPartitionFunction
+mesh::create_geometric_cell_partitioner(std::span<const T> x,
+                                        std::size_t gdim, bool hilbert)
+{
+  return [x, gdim, hilbert](
+             MPI_Comm comm, int nparts, const std::vector<CellType>& cell_types,
+             const std::vector<std::span<const std::int64_t>>& cells)
+             -> graph::AdjacencyList<std::int32_t>
+  {
+    spdlog::info("Compute geometric partition of cells across ranks");
+    common::Timer timer("Compute geometric partition of cells");
+
+    // Fetch the coordinates of the cell vertices
+    std::vector<std::int64_t> vertices;
+    for (auto c : cells)
+      vertices.insert(vertices.end(), c.begin(), c.end());
+    dolfinx::sort_unique(vertices);
+    const std::vector<T> xv
+        = MPI::distribute_data(comm, vertices, comm, x, gdim);
+
+    // Compute cell midpoints and their bounding box. The bounding box
+    // stores the lower corner and the negated upper corner such that
+    // it can be reduced with a single MPI_MIN.
+    constexpr double max = std::numeric_limits<double>::max();
+    std::array<double, 6> bbox = {max, max, max, max, max, max};
+    std::vector<double> midpoints;
+    for (std::size_t i = 0; i < cell_types.size(); ++i)
+    {
+      const int num_vertices = num_cell_vertices(cell_types[i]);
+      const std::size_t num_cells = cells[i].size() / num_vertices;
+      for (std::size_t c = 0; c < num_cells; ++c)
+      {
+        std::array<double, 3> p = {0, 0, 0};
+        for (int v = 0; v < num_vertices; ++v)
+        {
+          auto it = std::ranges::lower_bound(vertices,
+                                             cells[i][c * num_vertices + v]);
+          std::size_t pos = std::distance(vertices.begin(), it);
+          for (std::size_t j = 0; j < gdim; ++j)
+            p[j] += xv[pos * gdim + j];
+        }
+
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+          p[j] /= num_vertices;
+          bbox[j] = std::min(bbox[j], p[j]);
+          bbox[3 + j] = std::min(bbox[3 + j], -p[j]);
+          midpoints.push_back(p[j]);
+        }
+      }
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, bbox.data(), bbox.size(), MPI_DOUBLE,
+                  MPI_MIN, comm);
+    const std::vector<std::uint64_t> keys = graph::sfc_keys(
+        midpoints,
+        {{{bbox[0], bbox[1], bbox[2]}, {-bbox[3], -bbox[4], -bbox[5]}}},
+        hilbert);
+
+    // Sample the sorted keys on this rank. Each sample is the smallest
+    // key of a range of sorted keys, and is weighted by the size of the
+    // range.
+    constexpr std::int64_t max_samples = 64;
+    std::vector<std::uint64_t> sorted_keys = keys;
+    dolfinx::radix_sort(sorted_keys);
+    const std::int64_t num_keys = sorted_keys.size();
+    const std::int64_t num_samples = std::min(max_samples, num_keys);
+    std::vector<std::uint64_t> samples(2 * num_samples);
+    for (std::int64_t k = 0; k < num_samples; ++k)
+    {
+      std::int64_t k0 = (k * num_keys) / num_samples;
+      std::int64_t k1 = ((k + 1) * num_keys) / num_samples;
+      samples[2 * k] = sorted_keys[k0];
+      samples[2 * k + 1] = k1 - k0;
+    }
+
+    // Gather samples on rank 0 and compute the splitters between the
+    // parts, i.e. the keys at which the cumulative weight of the
+    // sorted samples reaches each multiple of (number of cells) /
+    // nparts
+    const int rank = dolfinx::MPI::rank(comm);
+    const int size = dolfinx::MPI::size(comm);
+    int num_values = samples.size();
+    std::vector<int> recv_sizes(rank == 0 ? size : 0);
+    MPI_Gather(&num_values, 1, MPI_INT, recv_sizes.data(), 1, MPI_INT, 0,
+               comm);
+    std::vector<int> recv_disp(recv_sizes.size() + 1, 0);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_disp.begin()));
+    std::vector<std::uint64_t> recv_samples(recv_disp.back());
+    MPI_Gatherv(samples.data(), num_values, MPI_UINT64_T,
+                recv_samples.data(), recv_sizes.data(), recv_disp.data(),
+                MPI_UINT64_T, 0, comm);
+
+    std::vector<std::uint64_t> splitters(nparts - 1);
+    if (rank == 0)
+    {
+      std::vector<std::array<std::uint64_t, 2>> s(recv_samples.size() / 2);
+      for (std::size_t k = 0; k < s.size(); ++k)
+        s[k] = {recv_samples[2 * k], recv_samples[2 * k + 1]};
+      std::ranges::sort(s);
+
+      std::uint64_t total = 0;
+      for (auto& [key, weight] : s)
+        total += weight;
+
+      std::uint64_t w = 0;
+      auto it = s.begin();
+      for (int p = 1; p < nparts; ++p)
+      {
+        const double target = double(p) * double(total) / nparts;
+        while (it != s.end() and w < target)
+          w += (*it++)[1];
+        splitters[p - 1] = it == s.end()
+                               ? std::numeric_limits<std::uint64_t>::max()
+                               : (*it)[0];
+      }
+    }
+    MPI_Bcast(splitters.data(), splitters.size(), MPI_UINT64_T, 0, comm);
+
+    // Destination of each cell is the segment of the curve that contains
+    // its key
+    std::vector<std::int32_t> dest(keys.size());
+    std::ranges::transform(keys, dest.begin(),
+                           [&splitters](auto key)
+                           {
+                             auto it = std::ranges::upper_bound(splitters, key);
+                             return std::distance(splitters.begin(), it);
+                           });
+
+    return graph::regular_adjacency_list(std::move(dest), 1);
   };
 }
 //-----------------------------------------------------------------------------
+/// @cond
+template mesh::CellPartitionFunction
+mesh::create_geometric_cell_partitioner(std::span<const float>, std::size_t,
+                                        bool);
+template mesh::CellPartitionFunction
+mesh::create_geometric_cell_partitioner(std::span<const double>, std::size_t,
+                                        bool);
+/// @endcond
+//-----------------------------------------------------------------------------
 std::vector<std::int32_t>
 mesh::compute_incident_entities(const Topology& topology,
                                 std::span<const std::int32_t> entities, int d0,
@@ -159,3 +296,22 @@ mesh::compute_incident_entities(const Topology& topology,
   return entities1;
 }
 //-----------------------------------------------------------------------------
+std::vector<std::int32_t> mesh::compute_parent_to_sub_entity_map(
+    const Topology& topology, int dim,
+    std::span<const std::int32_t> sub_to_parent)
+{
+  auto map = topology.index_map(dim);
+  if (!map)
+  {
+    throw std::runtime_error("Mesh entities of dimension "
+                             + std::to_string(dim)
+                             + " have not been created.");
+  }
+
+  std::vector<std::int32_t> parent_to_sub(
+      map->size_local() + map->num_ghosts(), -1);
+  for (std::size_t i = 0; i < sub_to_parent.size(); ++i)
+    parent_to_sub[sub_to_parent[i]] = i;
+  return parent_to_sub;
+}
+//-----------------------------------------------------------------------------
@@ -12,6 +12,8 @@
 #include <algorithm>
 #include <basix/mdspan.hpp>
 #include <concepts>
+#include <dolfinx/common/math.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/ordering.h>
 #include <dolfinx/graph/partition.h>
@@ -73,6 +75,7 @@ void reorder_list(std::span<T> list, std::span<const std::int32_t> nodemap)
 /// @param[in] mesh Mesh to compute the vertex coordinates for.
 /// @param[in] dim Topological dimension of the entities.
 /// @param[in] facets List of facets (must be on the mesh boundary).
+/// @param[in] vertices Sorted list of the vertices of `facets`.
 /// @return (0) Entities attached to the boundary facets (sorted), (1)
 /// vertex coordinates (shape is `(3, num_vertices)`) and (2) map from
 /// vertex in the full mesh to the position in the vertex coordinates
@@ -81,7 +84,8 @@ void reorder_list(std::span<T> list, std::span<const std::int32_t> nodemap)
 template <std::floating_point T>
 std::tuple<std::vector<std::int32_t>, std::vector<T>, std::vector<std::int32_t>>
 compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
-                               std::span<const std::int32_t> facets)
+                               std::span<const std::int32_t> facets,
+                               std::span<const std::int32_t> vertices)
 {
   auto topology = mesh.topology();
   assert(topology);
@@ -92,35 +96,26 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
         "Cannot use mesh::locate_entities_boundary (boundary) for cells.");
   }
 
-  // Build set of vertices on boundary and set of boundary entities
-  mesh.topology_mutable()->create_connectivity(tdim - 1, 0);
-  mesh.topology_mutable()->create_connectivity(tdim - 1, dim);
-  std::vector<std::int32_t> vertices, entities;
+  // Build set of boundary entities
+  std::vector<std::int32_t> entities;
+  if (dim == 0)
+    entities.assign(vertices.begin(), vertices.end());
+  else if (dim == tdim - 1)
+    entities.assign(facets.begin(), facets.end());
+  else
   {
-    auto f_to_v = topology->connectivity(tdim - 1, 0);
-    assert(f_to_v);
+    mesh.topology_mutable()->create_connectivity(tdim - 1, dim);
     auto f_to_e = topology->connectivity(tdim - 1, dim);
     assert(f_to_e);
     for (auto f : facets)
     {
-      auto v = f_to_v->links(f);
-      vertices.insert(vertices.end(), v.begin(), v.end());
       auto e = f_to_e->links(f);
       entities.insert(entities.end(), e.begin(), e.end());
     }
 
-    // Build vector of boundary vertices
-    {
-      std::ranges::sort(vertices);
-      auto [unique_end, range_end] = std::ranges::unique(vertices);
-      vertices.erase(unique_end, range_end);
-    }
-
-    {
-      std::ranges::sort(entities);
-      auto [unique_end, range_end] = std::ranges::unique(entities);
-      entities.erase(unique_end, range_end);
-    }
+    std::ranges::sort(entities);
+    auto [unique_end, range_end] = std::ranges::unique(entities);
+    entities.erase(unique_end, range_end);
   }
 
   // Get geometry data
@@ -164,7 +159,8 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
 /// An exterior facet (co-dimension 1) is one that is connected globally
 /// to only one cell of co-dimension 0).
 ///
-/// @note Collective.
+/// @note The facets are computed once and cached on the topology,
+/// see Topology::exterior_facets().
 ///
 /// @param[in] topology Mesh topology.
 /// @param[in] facet_type_idx The index of the facet type in
@@ -180,7 +176,8 @@ std::vector<std::int32_t> exterior_facet_indices(const Topology& topology,
 /// An exterior facet (co-dimension 1) is one that is connected globally
 /// to only one cell of co-dimension 0).
 ///
-/// @note Collective.
+/// @note The facets are computed once and cached on the topology,
+/// see Topology::exterior_facets().
 ///
 /// @param[in] topology Mesh topology.
 /// @return Sorted list of owned facet indices that are exterior facets
@@ -215,6 +212,14 @@ using CellPartitionFunction = std::function<graph::AdjacencyList<std::int32_t>(
 using CellReorderFunction = std::function<std::vector<std::int32_t>(
     const graph::AdjacencyList<std::int32_t>&)>;
 
+/// @brief Function that reorders (locally) cells that are owned by this
+/// process using their coordinates, e.g. graph::reorder_hilbert. It
+/// takes the midpoints of the cells (row-major, with shape `(num_cells,
+/// 3)`) as an argument and returns a list whose `i`th entry is the new
+/// index of cell `i`.
+using CellCoordinateReorderFunction
+    = std::function<std::vector<std::int32_t>(std::span<const double>)>;
+
 /// @brief Creates the default boundary vertices routine for a given reorder
 /// function.
 /// @param[in] reorder_fn A cell reorder funciton which will be applied to
@@ -387,17 +392,82 @@ std::vector<std::int64_t> extract_topology(CellType cell_type,
                                            const fem::ElementDofLayout& layout,
                                            std::span<const std::int64_t> cells);
 
+namespace impl
+{
+/// Number of entities that are processed together (in
+/// structure-of-arrays layout) by the batched geometry computations.
+constexpr std::size_t geometry_batch_size = 8;
+
+/// @brief Execute a function over batches of entities, with the batches
+/// divided between threads.
+///
+/// For each batch, the coordinates of the first `num_vertices` geometry
+/// nodes of the entities are packed in an array `xb` with shape
+/// `(num_vertices, 3, W)`, i.e. with the entity (lane) index running
+/// fastest, so that loops over the lanes of a batch can be vectorised.
+/// If fewer than `W` entities remain, the unused lanes repeat the last
+/// entity.
+///
+/// @tparam W Batch size.
+/// @param[in] x Geometry coordinates, shape `(num_nodes, 3)`.
+/// @param[in] e_to_g Geometry nodes of each entity, shape
+/// `(num_entities, e_to_g.size() / num_entities)`.
+/// @param[in] num_entities Number of entities.
+/// @param[in] num_vertices Number of nodes of each entity to pack.
+/// @param[in] num_threads Number of threads.
+/// @param[in] fn Function with signature `void(std::span<const T> xb,
+/// std::size_t e0, std::size_t num_lanes)` that processes the entities
+/// `[e0, e0 + num_lanes)`.
+template <std::size_t W, std::floating_point T, typename F>
+void for_each_entity_batch(std::span<const T> x,
+                           std::span<const std::int32_t> e_to_g,
+                           std::size_t num_entities, std::size_t num_vertices,
+                           int num_threads, F&& fn)
+{
+  const std::size_t num_nodes = e_to_g.size() / num_entities;
+  assert(num_vertices <= num_nodes);
+  const std::size_t num_batches = (num_entities + W - 1) / W;
+  common::parallel_for(
+      num_batches, num_threads,
+      [&](std::size_t b0, std::size_t b1)
+      {
+        std::vector<T> xb(num_vertices * 3 * W);
+        for (std::size_t b = b0; b < b1; ++b)
+        {
+          const std::size_t e0 = b * W;
+          const std::size_t num_lanes = std::min(W, num_entities - e0);
+          for (std::size_t w = 0; w < W; ++w)
+          {
+            const std::size_t e = e0 + std::min(w, num_lanes - 1);
+            for (std::size_t v = 0; v < num_vertices; ++v)
+            {
+              const std::int32_t node = e_to_g[e * num_nodes + v];
+              for (std::size_t j = 0; j < 3; ++j)
+                xb[(v * 3 + j) * W + w] = x[3 * node + j];
+            }
+          }
+          fn(std::span<const T>(xb), e0, num_lanes);
+        }
+      });
+}
+} // namespace impl
+
 /// @brief Compute greatest distance between any two vertices of the
 /// mesh entities (`h`).
+///
+/// The entities are processed in batches, with the batches divided
+/// between threads.
+///
 /// @param[in] mesh Mesh that the entities belong to.
 /// @param[in] entities Indices (local to process) of entities to
 /// compute `h` for.
 /// @param[in] dim Topological dimension of the entities.
+/// @param[in] num_threads Number of threads.
 /// @returns Greatest distance between any two vertices, `h[i]`
 /// corresponds to the entity `entities[i]`.
 template <std::floating_point T>
 std::vector<T> h(const Mesh<T>& mesh, std::span<const std::int32_t> entities,
-                 int dim)
+                 int dim, int num_threads = 1)
 {
   if (entities.empty())
     return std::vector<T>();
@@ -411,45 +481,57 @@ std::vector<T> h(const Mesh<T>& mesh, std::span<const std::int32_t> entities,
   // Get the  geometry coordinate
   std::span<const T> x = mesh.geometry().x();
 
-  // Function to compute the length of (p0 - p1)
-  auto delta_norm = [](auto&& p0, auto&& p1)
-  {
-    T norm = 0;
-    for (std::size_t i = 0; i < 3; ++i)
-      norm += (p0[i] - p1[i]) * (p0[i] - p1[i]);
-    return std::sqrt(norm);
-  };
-
   // Compute greatest distance between any to vertices
   assert(dim > 0);
+  constexpr std::size_t W = impl::geometry_batch_size;
+  const std::size_t nv = xdof_shape[1];
   std::vector<T> h(entities.size(), 0);
-  for (std::size_t e = 0; e < entities.size(); ++e)
-  {
-    // Get geometry 'dof' for each vertex of entity e
-    std::span<const std::int32_t> e_vertices(
-        vertex_xdofs.data() + e * xdof_shape[1], xdof_shape[1]);
-
-    // Compute maximum distance between any two vertices
-    for (std::size_t i = 0; i < e_vertices.size(); ++i)
-    {
-      std::span<const T, 3> p0(x.data() + 3 * e_vertices[i], 3);
-      for (std::size_t j = i + 1; j < e_vertices.size(); ++j)
+  impl::for_each_entity_batch<W>(
+      x, std::span<const std::int32_t>(vertex_xdofs), entities.size(), nv,
+      num_threads,
+      [&](std::span<const T> xb, std::size_t e0, std::size_t num_lanes)
       {
-        std::span<const T, 3> p1(x.data() + 3 * e_vertices[j], 3);
-        h[e] = std::max(h[e], delta_norm(p0, p1));
-      }
-    }
-  }
+        // Compute maximum squared distance between any two vertices
+        std::array<T, W> h2{};
+        for (std::size_t i = 0; i < nv; ++i)
+        {
+          for (std::size_t j = i + 1; j < nv; ++j)
+          {
+            std::array<T, W> d2{};
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+              const T* p0 = xb.data() + (i * 3 + k) * W;
+              const T* p1 = xb.data() + (j * 3 + k) * W;
+              for (std::size_t w = 0; w < W; ++w)
+                d2[w] += (p0[w] - p1[w]) * (p0[w] - p1[w]);
+            }
+            for (std::size_t w = 0; w < W; ++w)
+              h2[w] = std::max(h2[w], d2[w]);
+          }
+        }
+
+        for (std::size_t w = 0; w < num_lanes; ++w)
+          h[e0 + w] = std::sqrt(h2[w]);
+      });
 
   return h;
 }
 
 /// @brief Compute normal to given cell (viewed as embedded in 3D).
+///
+/// The entities are processed in batches, with the batches divided
+/// between threads.
+///
+/// @param[in] mesh Mesh that the entities belong to.
+/// @param[in] dim Topological dimension of the entities.
+/// @param[in] entities Indices (local to process) of the entities.
+/// @param[in] num_threads Number of threads.
 /// @returns The entity normals. The shape is `(entities.size(), 3)` and
 /// the storage is row-major.
 template <std::floating_point T>
 std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
-                            std::span<const std::int32_t> entities)
+                            std::span<const std::int32_t> entities,
+                            int num_threads = 1)
 {
   if (entities.empty())
     return std::vector<T>();
@@ -470,6 +552,7 @@ std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
   const auto [geometry_entities, eshape]
       = entities_to_geometry(mesh, dim, entities, false);
 
+  constexpr std::size_t W = impl::geometry_batch_size;
   std::vector<T> n(entities.size() * 3);
   switch (type)
   {
@@ -477,82 +560,64 @@ std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
   {
     if (gdim > 2)
       throw std::invalid_argument("Interval cell normal undefined in 3D.");
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      // Get the two vertices as points
-      std::array vertices{geometry_entities[i * eshape[1]],
-                          geometry_entities[i * eshape[1] + 1]};
-      std::array p = {std::span<const T, 3>(x.data() + 3 * vertices[0], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[1], 3)};
-
-      // Define normal by rotating tangent counter-clockwise
-      std::array<T, 3> t;
-      std::ranges::transform(p[1], p[0], t.begin(),
-                             [](auto x, auto y) { return x - y; });
-
-      T norm = std::sqrt(t[0] * t[0] + t[1] * t[1]);
-      std::span<T, 3> ni(n.data() + 3 * i, 3);
-      ni[0] = -t[1] / norm;
-      ni[1] = t[0] / norm;
-      ni[2] = 0.0;
-    }
+    impl::for_each_entity_batch<W>(
+        x, std::span<const std::int32_t>(geometry_entities), entities.size(),
+        2, num_threads,
+        [&](std::span<const T> xb, std::size_t e0, std::size_t num_lanes)
+        {
+          // Define normal by rotating tangent counter-clockwise
+          std::array<T, 2 * W> ni;
+          for (std::size_t w = 0; w < W; ++w)
+          {
+            const T t0 = xb[3 * W + w] - xb[w];
+            const T t1 = xb[4 * W + w] - xb[W + w];
+            const T norm = std::sqrt(t0 * t0 + t1 * t1);
+            ni[w] = -t1 / norm;
+            ni[W + w] = t0 / norm;
+          }
+
+          for (std::size_t w = 0; w < num_lanes; ++w)
+          {
+            n[3 * (e0 + w) + 0] = ni[w];
+            n[3 * (e0 + w) + 1] = ni[W + w];
+            n[3 * (e0 + w) + 2] = 0.0;
+          }
+        });
     return n;
   }
   case CellType::triangle:
-  {
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      // Get the three vertices as points
-      std::array vertices = {geometry_entities[i * eshape[1] + 0],
-                             geometry_entities[i * eshape[1] + 1],
-                             geometry_entities[i * eshape[1] + 2]};
-      std::array p = {std::span<const T, 3>(x.data() + 3 * vertices[0], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[1], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[2], 3)};
-
-      // Compute (p1 - p0) and (p2 - p0)
-      std::array<T, 3> dp1, dp2;
-      std::ranges::transform(p[1], p[0], dp1.begin(),
-                             [](auto x, auto y) { return x - y; });
-      std::ranges::transform(p[2], p[0], dp2.begin(),
-                             [](auto x, auto y) { return x - y; });
-
-      // Define cell normal via cross product of first two edges
-      std::array<T, 3> ni = math::cross(dp1, dp2);
-      T norm = std::sqrt(ni[0] * ni[0] + ni[1] * ni[1] + ni[2] * ni[2]);
-      std::ranges::transform(ni, std::next(n.begin(), 3 * i),
-                             [norm](auto x) { return x / norm; });
-    }
-
-    return n;
-  }
   case CellType::quadrilateral:
   {
-    // TODO: check
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      // Get the three vertices as points
-      std::array vertices = {geometry_entities[i * eshape[1] + 0],
-                             geometry_entities[i * eshape[1] + 1],
-                             geometry_entities[i * eshape[1] + 2]};
-      std::array p = {std::span<const T, 3>(x.data() + 3 * vertices[0], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[1], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[2], 3)};
-
-      // Compute (p1 - p0) and (p2 - p0)
-      std::array<T, 3> dp1, dp2;
-      std::ranges::transform(p[1], p[0], dp1.begin(),
-                             [](auto x, auto y) { return x - y; });
-      std::ranges::transform(p[2], p[0], dp2.begin(),
-                             [](auto x, auto y) { return x - y; });
-
-      // Define cell normal via cross product of first two edges
-      std::array<T, 3> ni = math::cross(dp1, dp2);
-      T norm = std::sqrt(ni[0] * ni[0] + ni[1] * ni[1] + ni[2] * ni[2]);
-      std::ranges::transform(ni, std::next(n.begin(), 3 * i),
-                             [norm](auto x) { return x / norm; });
-    }
-
+    // Define cell normal via cross product of first two edges. For
+    // quadrilaterals, vertices 1 and 2 are both connected to vertex 0,
+    // so (p1 - p0) and (p2 - p0) are also edges. For a non-planar
+    // quadrilateral this is the normal at vertex 0.
+    impl::for_each_entity_batch<W>(
+        x, std::span<const std::int32_t>(geometry_entities), entities.size(),
+        3, num_threads,
+        [&](std::span<const T> xb, std::size_t e0, std::size_t num_lanes)
+        {
+          std::array<T, 3 * W> ni;
+          for (std::size_t w = 0; w < W; ++w)
+          {
+            // Compute (p1 - p0) and (p2 - p0)
+            std::array<T, 3> dp1, dp2;
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+              dp1[k] = xb[(3 + k) * W + w] - xb[k * W + w];
+              dp2[k] = xb[(6 + k) * W + w] - xb[k * W + w];
+            }
+
+            std::array<T, 3> c = math::cross(dp1, dp2);
+            const T norm = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+            for (std::size_t k = 0; k < 3; ++k)
+              ni[k * W + w] = c[k] / norm;
+          }
+
+          for (std::size_t w = 0; w < num_lanes; ++w)
+            for (std::size_t k = 0; k < 3; ++k)
+              n[3 * (e0 + w) + k] = ni[k * W + w];
+        });
     return n;
   }
   default:
@@ -562,11 +627,20 @@ std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
 }
 
 /// @brief Compute the midpoints for mesh entities of a given dimension.
+///
+/// The entities are processed in batches, with the batches divided
+/// between threads.
+///
+/// @param[in] mesh Mesh that the entities belong to.
+/// @param[in] dim Topological dimension of the entities.
+/// @param[in] entities Indices (local to process) of the entities.
+/// @param[in] num_threads Number of threads.
 /// @returns The entity midpoints. The shape is `(entities.size(), 3)`
 /// and the storage is row-major.
 template <std::floating_point T>
 std::vector<T> compute_midpoints(const Mesh<T>& mesh, int dim,
-                                 std::span<const std::int32_t> entities)
+                                 std::span<const std::int32_t> entities,
+                                 int num_threads = 1)
 {
   if (entities.empty())
     return std::vector<T>();
@@ -577,20 +651,26 @@ std::vector<T> compute_midpoints(const Mesh<T>& mesh, int dim,
   const auto [e_to_g, eshape]
       = entities_to_geometry(mesh, dim, entities, false);
 
+  constexpr std::size_t W = impl::geometry_batch_size;
+  const std::size_t nv = eshape[1];
   std::vector<T> x_mid(entities.size() * 3, 0);
-  for (std::size_t e = 0; e < entities.size(); ++e)
-  {
-    std::span<T, 3> p(x_mid.data() + 3 * e, 3);
-    std::span<const std::int32_t> rows(e_to_g.data() + e * eshape[1],
-                                       eshape[1]);
-    for (auto row : rows)
-    {
-      std::span<const T, 3> xg(x.data() + 3 * row, 3);
-      std::ranges::transform(p, xg, p.begin(),
-                             [size = rows.size()](auto x, auto y)
-                             { return x + y / size; });
-    }
-  }
+  impl::for_each_entity_batch<W>(
+      x, std::span<const std::int32_t>(e_to_g), entities.size(), nv,
+      num_threads,
+      [&](std::span<const T> xb, std::size_t e0, std::size_t num_lanes)
+      {
+        std::array<T, 3 * W> p{};
+        for (std::size_t v = 0; v < nv; ++v)
+        {
+          const T* xv = xb.data() + v * 3 * W;
+          for (std::size_t k = 0; k < 3 * W; ++k)
+            p[k] += xv[k] / nv;
+        }
+
+        for (std::size_t w = 0; w < num_lanes; ++w)
+          for (std::size_t k = 0; k < 3; ++k)
+            x_mid[3 * (e0 + w) + k] = p[k * W + w];
+      });
 
   return x_mid;
 }
@@ -645,6 +725,49 @@ compute_vertex_coords(const mesh::Mesh<T>& mesh)
   return {std::move(x_vertices), {3, vertex_to_node.size()}};
 }
 
+/// @brief Find the entities for which all vertices are marked.
+///
+/// The entities are divided between threads.
+///
+/// @param[in] e_to_v Entity-to-vertex connectivity.
+/// @param[in] num_entities Number of entities to check.
+/// @param[in] entity Function `std::int32_t(std::size_t i)` that returns
+/// the `i`-th entity to check.
+/// @param[in] marked Function `bool(std::int32_t v)` that returns true
+/// if vertex `v` is marked.
+/// @param[in] num_threads Number of threads.
+/// @return The entities with all vertices marked, in the order in which
+/// they are checked.
+template <typename E, typename M>
+std::vector<std::int32_t>
+marked_entities(const graph::AdjacencyList<std::int32_t>& e_to_v,
+                std::size_t num_entities, E entity, M marked, int num_threads)
+{
+  // Do not use more threads than entities
+  num_threads = std::max(num_threads, 1);
+  if (num_entities < static_cast<std::size_t>(num_threads))
+    num_threads = std::max<std::size_t>(num_entities, 1);
+
+  std::vector<std::vector<std::int32_t>> thread_entities(num_threads);
+  common::run_threads(
+      num_threads,
+      [&](int t)
+      {
+        auto [i0, i1] = common::thread_range(t, num_entities, num_threads);
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          const std::int32_t e = entity(i);
+          if (std::ranges::all_of(e_to_v.links(e), marked))
+            thread_entities[t].push_back(e);
+        }
+      });
+
+  std::vector<std::int32_t> entities;
+  for (auto& e : thread_entities)
+    entities.insert(entities.end(), e.begin(), e.end());
+  return entities;
+}
+
 } // namespace impl
 
 /// Requirements on function for geometry marking
@@ -667,11 +790,14 @@ concept MarkerFn = std::is_invocable_r<
 /// is 'marked', and `false` otherwise.
 /// @param[in] entity_type_idx The index of the entity type in
 /// Topology::entity_types(dim)
+/// @param[in] num_threads Number of threads used to check the entities.
+/// The marker function is called once, on the calling thread.
 /// @returns List of marked entity indices, including any ghost indices
 /// (indices local to the process).
 template <std::floating_point T, MarkerFn<T> U>
 std::vector<std::int32_t> locate_entities(const Mesh<T>& mesh, int dim,
-                                          U marker, int entity_type_idx)
+                                          U marker, int entity_type_idx,
+                                          int num_threads = 1)
 {
 
   using cmdspan3x_t
@@ -697,25 +823,9 @@ std::vector<std::int32_t> locate_entities(const Mesh<T>& mesh, int dim,
   // entities
   auto e_to_v = topology->connectivity({dim, entity_type_idx}, {0, 0});
   assert(e_to_v);
-  std::vector<std::int32_t> entities;
-  for (int e = 0; e < e_to_v->num_nodes(); ++e)
-  {
-    // Iterate over entity vertices
-    bool all_vertices_marked = true;
-    for (std::int32_t v : e_to_v->links(e))
-    {
-      if (!marked[v])
-      {
-        all_vertices_marked = false;
-        break;
-      }
-    }
-
-    if (all_vertices_marked)
-      entities.push_back(e);
-  }
-
-  return entities;
+  return impl::marked_entities(
+      *e_to_v, e_to_v->num_nodes(), [](std::size_t e) { return e; },
+      [&marked](std::int32_t v) { return marked[v]; }, num_threads);
 }
 
 /// @brief Compute indices of all mesh entities that evaluate to true
@@ -760,16 +870,23 @@ std::vector<std::int32_t> locate_entities(const Mesh<T>& mesh, int dim,
 /// returned by this function must typically perform some parallel
 /// communication.
 ///
+/// The exterior facets and their vertices are cached on the topology
+/// (see Topology::exterior_facets()), and the marker function is
+/// evaluated at the vertices of the exterior facets only.
+///
 /// @param[in] mesh Mesh to mark entities on.
 /// @param[in] dim Topological dimension of the entities to be
 /// considered. Must be less than the topological dimension of the mesh.
 /// @param[in] marker Marking function, returns `true` for a point that
 /// is 'marked', and `false` otherwise.
+/// @param[in] num_threads Number of threads used to check the entities.
+/// The marker function is called once, on the calling thread.
 /// @returns List of marked entity indices (indices local to the
 /// process).
 template <std::floating_point T, MarkerFn<T> U>
 std::vector<std::int32_t> locate_entities_boundary(const Mesh<T>& mesh, int dim,
-                                                   U marker)
+                                                   U marker,
+                                                   int num_threads = 1)
 {
   // TODO Rewrite this function, it should be possible to simplify considerably
   auto topology = mesh.topology();
@@ -781,17 +898,19 @@ std::vector<std::int32_t> locate_entities_boundary(const Mesh<T>& mesh, int dim,
         "Cannot use mesh::locate_entities_boundary (boundary) for cells.");
   }
 
-  // Compute list of boundary facets
+  // Get (cached) list of boundary facets and their vertices
   mesh.topology_mutable()->create_entities(tdim - 1);
   mesh.topology_mutable()->create_connectivity(tdim - 1, tdim);
-  std::vector<std::int32_t> boundary_facets = exterior_facet_indices(*topology);
+  std::span boundary_facets = topology->exterior_facets();
+  std::span boundary_vertices = topology->exterior_facet_vertices(0);
 
   using cmdspan3x_t
       = md::mdspan<const T, md::extents<std::size_t, 3, md::dynamic_extent>>;
 
   // Run marker function on the vertex coordinates
   auto [facet_entities, xdata, vertex_to_pos]
-      = impl::compute_vertex_coords_boundary(mesh, dim, boundary_facets);
+      = impl::compute_vertex_coords_boundary(mesh, dim, boundary_facets,
+                                             boundary_vertices);
   cmdspan3x_t x(xdata.data(), 3, xdata.size() / 3);
   std::vector<std::int8_t> marked = marker(x);
   if (marked.size() != x.extent(1))
@@ -801,27 +920,12 @@ std::vector<std::int32_t> locate_entities_boundary(const Mesh<T>& mesh, int dim,
   mesh.topology_mutable()->create_entities(dim);
   auto e_to_v = topology->connectivity(dim, 0);
   assert(e_to_v);
-  std::vector<std::int32_t> entities;
-  for (auto e : facet_entities)
-  {
-    // Iterate over entity vertices
-    bool all_vertices_marked = true;
-    for (auto v : e_to_v->links(e))
-    {
-      const std::int32_t pos = vertex_to_pos[v];
-      if (!marked[pos])
-      {
-        all_vertices_marked = false;
-        break;
-      }
-    }
-
-    // Mark facet with all vertices marked
-    if (all_vertices_marked)
-      entities.push_back(e);
-  }
-
-  return entities;
+  return impl::marked_entities(
+      *e_to_v, facet_entities.size(),
+      [&facet_entities](std::size_t i) { return facet_entities[i]; },
+      [&marked, &vertex_to_pos](std::int32_t v)
+      { return marked[vertex_to_pos[v]]; },
+      num_threads);
 }
 
 /// @brief Compute the geometry degrees of freedom associated with
@@ -945,11 +1049,47 @@ entities_to_geometry(const Mesh<T>& mesh, int dim,
 /// @brief Create a function that computes destination rank for mesh
 /// cells on this rank by applying the default graph partitioner to the
 /// dual graph of the mesh.
+/// @param[in] ghost_mode Type of cell ghosting.
+/// @param[in] partfn Graph partitioning function.
+/// @param[in] num_ghost_layers Number of layers of ghost cells when
+/// `ghost_mode` is not GhostMode::none. Each layer adds the cells that
+/// share a facet with a cell of the previous layer (see
+/// graph::extend_destinations).
 /// @return Function that computes the destination ranks for each cell.
 CellPartitionFunction create_cell_partitioner(mesh::GhostMode ghost_mode
                                               = mesh::GhostMode::none,
                                               const graph::partition_fn& partfn
-                                              = &graph::partition_graph);
+                                              = &graph::partition_graph,
+                                              int num_ghost_layers = 1);
+
+/// @brief Create a function that computes destination rank for mesh
+/// cells on this rank from the cell midpoints, without building the
+/// dual graph of the mesh.
+///
+/// The midpoints of the cells are ordered along a space-filling curve
+/// (see graph::sfc_keys) on the bounding box of the mesh, and the curve
+/// is split into `nparts` segments with approximately equal numbers of
+/// cells. The splitters are computed from a regular sample of the
+/// sorted curve keys on each rank. This is much cheaper than graph
+/// partitioning for large meshes, but the partition boundaries are in
+/// general longer.
+///
+/// @param[in] x Geometry coordinates (row-major, with shape
+/// `(num_nodes, gdim)`) that are passed to create_mesh. The
+/// coordinates must be distributed across the ranks of the
+/// communicator that the partitioner is called with (`commt` in
+/// create_mesh), and must be kept alive until the partitioner is no
+/// longer used.
+/// @param[in] gdim Geometric dimension.
+/// @param[in] hilbert If true, use the Hilbert curve, otherwise the
+/// Morton curve.
+/// @return Function that computes the destination ranks for each cell.
+/// @note The cells are not ghosted, since the ghost cells are
+/// determined from the dual graph.
+template <std::floating_point T>
+CellPartitionFunction create_geometric_cell_partitioner(std::span<const T> x,
+                                                        std::size_t gdim,
+                                                        bool hilbert = true);
 
 /// @brief Compute incident entities.
 /// @param[in] topology The topology.
@@ -963,6 +1103,25 @@ compute_incident_entities(const Topology& topology,
                           std::span<const std::int32_t> entities, int d0,
                           int d1);
 
+/// @brief Compute the inverse of a map from entities of a sub-mesh to
+/// entities of a parent mesh.
+///
+/// The inverse map is the entity map required when assembling forms
+/// over the parent mesh that involve functions on the sub-mesh, e.g.
+/// as returned by mesh::create_submesh. It is computed locally, without
+/// communication.
+///
+/// @param[in] topology Topology of the parent mesh.
+/// @param[in] dim Topological dimension of the parent mesh entities.
+/// @param[in] sub_to_parent Map from sub-mesh entities (cells) to
+/// local parent mesh entities of dimension `dim`.
+/// @return Map from local parent mesh entities (owned and ghost) of
+/// dimension `dim` to entities of the sub-mesh. Parent entities that
+/// are not in the sub-mesh are mapped to -1.
+std::vector<std::int32_t>
+compute_parent_to_sub_entity_map(const Topology& topology, int dim,
+                                 std::span<const std::int32_t> sub_to_parent);
+
 /// @brief Create a distributed mesh::Mesh from mesh data and using the
 /// provided graph partitioning function for determining the parallel
 /// distribution of the mesh.
@@ -1003,6 +1162,24 @@ compute_incident_entities(const Topology& topology,
 /// redistributed.
 /// @param[in] reorder_fn Function that reorders (locally) cells that
 /// are owned by this process.
+/// @param[in] coordinate_reorder_fn Function that reorders (locally)
+/// cells that are owned by this process using the cell midpoints. If
+/// callable, it is used instead of `reorder_fn`. Space-filling curve
+/// orderings (graph::reorder_hilbert and graph::reorder_morton) do not
+/// require the dual graph and are cheaper to compute than
+/// graph::reorder_gps for large meshes.
+/// @param[in] num_threads Number of threads used for the local passes
+/// of the geometry construction (see create_geometry).
+/// @param[in] max_distribute_bytes If non-zero, the cells are sent to
+/// their destination ranks in rounds of at most this number of bytes
+/// from each rank (see graph::build::distribute), which bounds the peak
+/// memory of the distribution. Must be the same on all ranks.
+/// @param[in] node_aware If `true`, the communication graph used to
+/// distribute the geometry is computed with the node-aware
+/// MPI::compute_graph_edges_node. This reduces the number of inter-node
+/// messages on many-node runs, but splits the communicator on each
+/// call and funnels the edges of a node through its leader. Must be
+/// the same on all ranks.
 /// @return A mesh distributed on the communicator `comm`.
 template <typename U>
 Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
@@ -1012,7 +1189,10 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
         typename std::remove_reference_t<typename U::value_type>>>& elements,
     MPI_Comm commg, const U& x, std::array<std::size_t, 2> xshape,
     const CellPartitionFunction& partitioner,
-    const CellReorderFunction& reorder_fn = graph::reorder_gps)
+    const CellReorderFunction& reorder_fn = graph::reorder_gps,
+    const CellCoordinateReorderFunction& coordinate_reorder_fn = nullptr,
+    int num_threads = 1, std::size_t max_distribute_bytes = 0,
+    bool node_aware = false)
 {
   assert(cells.size() == elements.size());
   std::vector<CellType> celltypes;
@@ -1078,7 +1258,8 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
       std::vector<int> src_ranks;
       std::tie(cells1[i], src_ranks, original_idx1[i], ghost_owners[i])
           = graph::build::distribute(comm, cells[i],
-                                     {num_cells, num_cell_nodes}, dest_i);
+                                     {num_cells, num_cell_nodes}, dest_i,
+                                     max_distribute_bytes);
       spdlog::debug("Got {} cells from distribution", cells1[i].size());
     }
   }
@@ -1116,7 +1297,73 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
                  cells1_v[i].size());
   }
 
-  auto boundary_v_fn = create_boundary_vertices_fn(reorder_fn);
+  // Build list of unique (global) node indices from cells1 and
+  // distribute coordinate data. Re-ordering the cells does not change
+  // the list of nodes.
+  std::vector<std::int64_t> nodes1;
+  for (std::vector<std::int64_t>& c : cells1)
+    nodes1.insert(nodes1.end(), c.begin(), c.end());
+
+  dolfinx::radix_sort(nodes1);
+  auto [unique_end, range_end] = std::ranges::unique(nodes1);
+  nodes1.erase(unique_end, range_end);
+
+  std::vector coords = dolfinx::MPI::distribute_data(comm, nodes1, commg, x,
+                                                     xshape[1], node_aware);
+
+  CellReorderFunction cell_reorder_fn = reorder_fn;
+  if (coordinate_reorder_fn)
+  {
+    spdlog::info("Re-order cells using cell midpoints.");
+    for (std::int32_t i = 0; i < num_cell_types; ++i)
+    {
+      // Compute midpoints of the owned cells
+      const std::size_t num_cell_nodes = doflayouts[i].num_dofs();
+      const std::size_t num_owned_cells
+          = cells1[i].size() / num_cell_nodes - ghost_owners[i].size();
+      std::vector<double> midpoints(3 * num_owned_cells, 0);
+      for (std::size_t c = 0; c < num_owned_cells; ++c)
+      {
+        for (std::size_t k = 0; k < num_cell_nodes; ++k)
+        {
+          auto it = std::ranges::lower_bound(
+              nodes1, cells1[i][c * num_cell_nodes + k]);
+          std::size_t pos = std::distance(nodes1.begin(), it);
+          for (std::size_t j = 0; j < xshape[1]; ++j)
+          {
+            midpoints[3 * c + j]
+                += double(coords[pos * xshape[1] + j]) / num_cell_nodes;
+          }
+        }
+      }
+
+      const std::vector<std::int32_t> remap = coordinate_reorder_fn(midpoints);
+
+      // Update 'original' indices (ghosts are not re-ordered)
+      std::vector<std::int64_t> orig_idx = original_idx1[i];
+      for (std::size_t j = 0; j < remap.size(); ++j)
+        original_idx1[i][remap[j]] = orig_idx[j];
+
+      // Reorder cells
+      impl::reorder_list(
+          std::span(cells1_v[i].data(),
+                    remap.size() * num_cell_vertices(celltypes[i])),
+          remap);
+      impl::reorder_list(
+          std::span(cells1[i].data(), remap.size() * num_cell_nodes), remap);
+    }
+
+    // Cells have been re-ordered, so use the identity in the dual graph
+    // based re-ordering
+    cell_reorder_fn = [](const graph::AdjacencyList<std::int32_t>& graph)
+    {
+      std::vector<std::int32_t> remap(graph.num_nodes());
+      std::iota(remap.begin(), remap.end(), 0);
+      return remap;
+    };
+  }
+
+  auto boundary_v_fn = create_boundary_vertices_fn(cell_reorder_fn);
   const std::vector<std::int64_t> boundary_v = boundary_v_fn(
       celltypes, doflayouts, ghost_owners, cells1, cells1_v, original_idx1);
 
@@ -1150,24 +1397,14 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
       topology.create_entity_permutations();
   }
 
-  // Build list of unique (global) node indices from cells1 and
-  // distribute coordinate data
-  std::vector<std::int64_t> nodes1, nodes2;
-  for (std::vector<std::int64_t>& c : cells1)
-    nodes1.insert(nodes1.end(), c.begin(), c.end());
+  // Build list of (global) node indices of the re-ordered cells
+  std::vector<std::int64_t> nodes2;
   for (std::vector<std::int64_t>& c : cells1)
     nodes2.insert(nodes2.end(), c.begin(), c.end());
 
-  dolfinx::radix_sort(nodes1);
-  auto [unique_end, range_end] = std::ranges::unique(nodes1);
-  nodes1.erase(unique_end, range_end);
-
-  std::vector coords
-      = dolfinx::MPI::distribute_data(comm, nodes1, commg, x, xshape[1]);
-
   // Create geometry object
-  Geometry geometry
-      = create_geometry(topology, elements, nodes1, nodes2, coords, xshape[1]);
+  Geometry geometry = create_geometry(topology, elements, nodes1, nodes2,
+                                      coords, xshape[1], nullptr, num_threads);
 
   return Mesh(comm, std::make_shared<Topology>(std::move(topology)),
               std::move(geometry));
@@ -1207,6 +1444,9 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
 /// rank for each cell. If not callable, cells are not redistributed.
 /// @param[in] reorder_fn Function that reorders (locally) cells that
 /// are owned by this process.
+/// @param[in] coordinate_reorder_fn Function that reorders (locally)
+/// cells that are owned by this process using the cell midpoints. If
+/// callable, it is used instead of `reorder_fn`.
 /// @return A mesh distributed on the communicator `comm`.
 template <typename U>
 Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
@@ -1215,10 +1455,12 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
         typename std::remove_reference_t<typename U::value_type>>& element,
     MPI_Comm commg, const U& x, std::array<std::size_t, 2> xshape,
     const CellPartitionFunction& partitioner,
-    const CellReorderFunction& reorder_fn = graph::reorder_gps)
+    const CellReorderFunction& reorder_fn = graph::reorder_gps,
+    const CellCoordinateReorderFunction& coordinate_reorder_fn = nullptr)
 {
   return create_mesh(comm, commt, std::vector{cells}, std::vector{element},
-                     commg, x, xshape, partitioner, reorder_fn);
+                     commg, x, xshape, partitioner, reorder_fn,
+                     coordinate_reorder_fn);
 }
 
 /// @brief Create a distributed mesh from mesh data using the default
@@ -1256,6 +1498,185 @@ create_mesh(MPI_Comm comm, std::span<const std::int64_t> cells,
   }
 }
 
+/// @brief Create a copy of a mesh on a group of ranks.
+///
+/// Every group of ranks of `comm`, e.g. created by MPI::split, receives
+/// a complete copy of `mesh`, which is distributed on the group by
+/// `partitioner`. The owned cells of rank `r` of `comm` are sent to
+/// rank `r % n` of each group, where `n` is the size of the group, and
+/// the owned nodes are sent in contiguous blocks of the input node
+/// indices. The input node indices (Geometry::input_global_indices)
+/// and the original cell indices (Topology::original_cell_index) of the
+/// group mesh are those of `mesh`, but the local and global cell
+/// numbering is in general different. Independent problems can then be
+/// solved concurrently on the groups.
+///
+/// @note Collective on `comm`.
+/// @note Only meshes with a single cell type are supported.
+///
+/// @param[in] comm Communicator that `mesh` is distributed on.
+/// @param[in] mesh Mesh to copy.
+/// @param[in] group_comm Communicator of the group of the caller. Each
+/// rank of `comm` must belong to exactly one group.
+/// @param[in] partitioner Graph partitioner that computes the owning
+/// rank in the group for each cell. If not callable, the cells are not
+/// redistributed after the transfer to the group.
+/// @return A copy of `mesh` distributed on `group_comm`.
+template <std::floating_point T>
+Mesh<T> create_group_mesh(MPI_Comm comm, const Mesh<T>& mesh,
+                          MPI_Comm group_comm,
+                          const CellPartitionFunction& partitioner)
+{
+  auto topology = mesh.topology();
+  assert(topology);
+  if (topology->cell_types().size() != 1)
+  {
+    throw std::runtime_error(
+        "Group meshes are only supported for a single cell type.");
+  }
+
+  const int size = dolfinx::MPI::size(comm);
+  const int rank = dolfinx::MPI::rank(comm);
+
+  // Rank on comm of each rank of each group, with the groups
+  // identified by the rank on comm of their first rank
+  std::vector<std::vector<int>> groups;
+  {
+    int root = rank;
+    MPI_Bcast(&root, 1, MPI_INT, 0, group_comm);
+    std::array<int, 2> id = {root, dolfinx::MPI::rank(group_comm)};
+    std::vector<int> ids(2 * size);
+    MPI_Allgather(id.data(), 2, MPI_INT, ids.data(), 2, MPI_INT, comm);
+    std::vector<int> roots;
+    for (int p = 0; p < size; ++p)
+      roots.push_back(ids[2 * p]);
+    std::ranges::sort(roots);
+    auto [unique_end, range_end] = std::ranges::unique(roots);
+    roots.erase(unique_end, range_end);
+    groups.resize(roots.size());
+    for (int p = 0; p < size; ++p)
+    {
+      auto it = std::ranges::lower_bound(roots, ids[2 * p]);
+      std::vector<int>& group = groups[std::distance(roots.begin(), it)];
+      if (int q = ids[2 * p + 1]; q >= (int)group.size())
+        group.resize(q + 1, -1);
+      group[ids[2 * p + 1]] = p;
+    }
+  }
+
+  const Geometry<T>& geometry = mesh.geometry();
+  const std::size_t gdim = geometry.dim();
+  std::span<const T> x = geometry.x();
+  std::span<const std::int64_t> input_indices
+      = geometry.input_global_indices();
+  auto dofmap = geometry.dofmap();
+  const std::int32_t num_cells
+      = topology->index_map(topology->dim())->size_local();
+  const std::int32_t num_nodes = geometry.index_map()->size_local();
+  std::span<const std::int64_t> cell_index
+      = topology->original_cell_index.front();
+  assert((std::int32_t)cell_index.size() >= num_cells);
+
+  std::int64_t num_nodes_global = 0;
+  {
+    std::int64_t max_index = -1;
+    for (std::int32_t i = 0; i < num_nodes; ++i)
+      max_index = std::max(max_index, input_indices[i]);
+    MPI_Allreduce(&max_index, &num_nodes_global, 1, MPI_INT64_T, MPI_MAX,
+                  comm);
+    num_nodes_global += 1;
+  }
+
+  // Pack the owned cells (input node indices and original cell index)
+  // and the owned nodes (input index and coordinates) for each
+  // destination rank
+  std::vector<std::vector<std::int64_t>> send_cells(size);
+  std::vector<std::vector<std::int64_t>> send_cell_indices(size);
+  std::vector<std::vector<std::int64_t>> send_node_indices(size);
+  std::vector<std::vector<T>> send_x(size);
+  for (const std::vector<int>& group : groups)
+  {
+    const int group_size = group.size();
+    const int dest = group[rank % group_size];
+    std::vector<std::int64_t>& cells = send_cells[dest];
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      for (std::size_t j = 0; j < dofmap.extent(1); ++j)
+        cells.push_back(input_indices[dofmap(c, j)]);
+    }
+    send_cell_indices[dest].insert(send_cell_indices[dest].end(),
+                                   cell_index.begin(),
+                                   std::next(cell_index.begin(), num_cells));
+
+    for (std::int32_t i = 0; i < num_nodes; ++i)
+    {
+      const int dest = group[dolfinx::MPI::index_owner(
+          group_size, input_indices[i], num_nodes_global)];
+      send_node_indices[dest].push_back(input_indices[i]);
+      send_x[dest].insert(send_x[dest].end(), std::next(x.begin(), 3 * i),
+                          std::next(x.begin(), 3 * i + gdim));
+    }
+  }
+
+  auto exchange = [comm, size]<typename V>(
+                      const std::vector<std::vector<V>>& data)
+  {
+    std::vector<int> send_sizes(size), send_disp(size + 1, 0);
+    for (int p = 0; p < size; ++p)
+    {
+      send_sizes[p] = data[p].size();
+      send_disp[p + 1] = send_disp[p] + send_sizes[p];
+    }
+    std::vector<V> send_buffer;
+    send_buffer.reserve(send_disp.back());
+    for (const std::vector<V>& d : data)
+      send_buffer.insert(send_buffer.end(), d.begin(), d.end());
+
+    std::vector<int> recv_sizes(size), recv_disp(size + 1, 0);
+    MPI_Alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                 MPI_INT, comm);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_disp.begin()));
+    std::vector<V> recv_buffer(recv_disp.back());
+    MPI_Alltoallv(send_buffer.data(), send_sizes.data(), send_disp.data(),
+                  dolfinx::MPI::mpi_t<V>, recv_buffer.data(),
+                  recv_sizes.data(), recv_disp.data(), dolfinx::MPI::mpi_t<V>,
+                  comm);
+    return recv_buffer;
+  };
+
+  std::vector<std::int64_t> cells = exchange(send_cells);
+  std::vector<std::int64_t> cell_indices = exchange(send_cell_indices);
+  std::vector<std::int64_t> node_indices = exchange(send_node_indices);
+  std::vector<T> recv_x = exchange(send_x);
+
+  // Place the received nodes in input index order
+  const std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(group_comm), num_nodes_global,
+      dolfinx::MPI::size(group_comm));
+  std::vector<T> group_x((range[1] - range[0]) * gdim, 0);
+  for (std::size_t i = 0; i < node_indices.size(); ++i)
+  {
+    const std::size_t pos = node_indices[i] - range[0];
+    std::copy_n(std::next(recv_x.begin(), i * gdim), gdim,
+                std::next(group_x.begin(), pos * gdim));
+  }
+
+  Mesh<T> group_mesh = create_mesh(group_comm, group_comm, std::span(cells),
+                                   geometry.cmap(), group_comm, group_x,
+                                   {group_x.size() / gdim, gdim}, partitioner);
+
+  // The original cell indices of the group mesh are the positions of
+  // the cells in the received cells on the group. Replace them by the
+  // original cell indices of `mesh`.
+  std::vector<std::int64_t>& group_cell_index
+      = group_mesh.topology()->original_cell_index.front();
+  group_cell_index = dolfinx::MPI::distribute_data(
+      group_comm, group_cell_index, group_comm, cell_indices, 1);
+
+  return group_mesh;
+}
+
 /// @brief Create a sub-geometry from a mesh and a subset of mesh entities to
 /// be included.
 ///
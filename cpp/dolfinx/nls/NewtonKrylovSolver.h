@@ -0,0 +1,308 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/la/krylov.h>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace dolfinx::nls
+{
+/// @brief Krylov method used by NewtonKrylovSolver to solve for the
+/// Newton increments.
+enum class KrylovMethod
+{
+  gmres,    ///< Restarted GMRES, see la::gmres
+  bicgstab, ///< BiCGStab, see la::bicgstab
+  cg        ///< Conjugate gradients (symmetric positive definite
+            ///< Jacobians only), see la::cg
+};
+
+/// @brief A line-search Newton-Krylov solver for nonlinear systems of
+/// equations of the form \f$F(x) = 0\f$, with \f$x\f$ a la::Vector.
+///
+/// The Newton increment is computed by solving
+/// \f[ \left. \frac{dF}{dx} \right|_{x} \Delta x = F(x) \f] with one of
+/// the native Krylov solvers in la/krylov.h, and the update is
+/// \f$x \leftarrow x - \lambda \Delta x\f$, where the step length
+/// \f$\lambda\f$ is found by a backtracking line search.
+///
+/// The Jacobian is never assembled. Its action is computed by a
+/// user-provided function, e.g. by assembling the directional
+/// derivative of the residual form in the direction of a coefficient,
+/// or, by default, by finite differencing of the residual (Jacobian-free
+/// Newton-Krylov). The solver does not depend on PETSc.
+///
+/// @tparam V Vector type, e.g. la::Vector.
+template <class V>
+class NewtonKrylovSolver
+{
+public:
+  /// Scalar type
+  using value_type = typename V::value_type;
+
+  /// Real type of norms and tolerances
+  using scalar_type = typename dolfinx::scalar_value_t<value_type>;
+
+  /// @brief Create a nonlinear solver.
+  /// @param[in] F Function that computes the residual. The first
+  /// argument is the solution vector `x`, with up-to-date ghost values,
+  /// and the second is the vector `b` to compute \f$F(x)\f$ into. Only
+  /// the owned entries of `b` need to be computed.
+  explicit NewtonKrylovSolver(std::function<void(V& x, V& b)> F)
+      : _fnF(std::move(F))
+  {
+  }
+
+  /// @brief Set the function that computes the action of the Jacobian.
+  ///
+  /// If not set, the action is approximated by the finite difference
+  /// \f$J(x) v \approx (F(x + h v) - F(x)) / h\f$, with \f$h = \epsilon
+  /// (1 + \|x\|) / \|v\|\f$ and \f$\epsilon\f$ =
+  /// NewtonKrylovSolver::fd_epsilon.
+  ///
+  /// @param[in] J Function that computes \f$y = J(x) v\f$. The arguments
+  /// are the solution vector `x`, the vector `v` and the vector `y` to
+  /// compute the action into. The ghost values of `x` and `v` are up to
+  /// date, and only the owned entries of `y` need to be computed.
+  void set_jacobian_action(std::function<void(V& x, V& v, V& y)> J)
+  {
+    _fnJ = std::move(J);
+  }
+
+  /// @brief Solve the nonlinear problem.
+  ///
+  /// @note Collective MPI operation.
+  ///
+  /// @param[in,out] x The solution vector. It should be set to the
+  /// initial solution guess. Its ghost values are updated on return.
+  /// @return (number of Newton iterations, whether iteration converged)
+  std::pair<int, bool> solve(V& x)
+  {
+    if (!_fnF)
+    {
+      throw std::runtime_error("Function for computing residual vector has "
+                               "not been provided to the NewtonKrylovSolver.");
+    }
+
+    _iteration = 0;
+    _krylov_iterations = 0;
+
+    // Residual, trial residual, Newton increment and trial solution
+    V b(x), bt(x), dx(x), xt(x);
+
+    // Work vectors for the finite difference Jacobian action
+    V xh(x), bh(x);
+
+    const std::size_t n = x.bs() * x.index_map()->size_local();
+    x.scatter_fwd();
+    _fnF(x, b);
+    _residual0 = la::norm(b);
+    _residual = _residual0;
+    bool converged = _residual <= atol;
+
+    // Action of the Jacobian at x in direction v, computed into y
+    auto action = [&](V& v, V& y)
+    {
+      v.scatter_fwd();
+      if (_fnJ)
+        _fnJ(x, v, y);
+      else
+      {
+        const scalar_type vnorm = la::norm(v);
+        if (vnorm == 0)
+        {
+          y.set(0);
+          return;
+        }
+
+        // Perturb x in direction v, including the ghost entries
+        const scalar_type h = fd_epsilon * (1 + la::norm(x)) / vnorm;
+        std::span _xh = xh.mutable_array();
+        std::span<const value_type> _x = x.array();
+        std::span<const value_type> _v = v.array();
+        for (std::size_t i = 0; i < _xh.size(); ++i)
+          _xh[i] = _x[i] + h * _v[i];
+
+        _fnF(xh, bh);
+        std::span _y = y.mutable_array();
+        std::span<const value_type> _b = b.array();
+        std::span<const value_type> _bh = bh.array();
+        for (std::size_t i = 0; i < n; ++i)
+          _y[i] = (_bh[i] - _b[i]) / h;
+      }
+    };
+
+    while (!converged and _iteration < max_it)
+    {
+      // Solve for the Newton increment
+      dx.set(0);
+      switch (krylov_method)
+      {
+      case KrylovMethod::gmres:
+        _krylov_iterations += la::gmres(dx, b, action, krylov_max_it,
+                                        krylov_rtol, gmres_restart);
+        break;
+      case KrylovMethod::bicgstab:
+        _krylov_iterations
+            += la::bicgstab(dx, b, action, krylov_max_it, krylov_rtol);
+        break;
+      case KrylovMethod::cg:
+        _krylov_iterations
+            += la::cg(dx, b, action, krylov_max_it, krylov_rtol);
+        break;
+      default:
+        throw std::runtime_error("Unknown Krylov method");
+      }
+
+      // Backtracking line search for a sufficient decrease of the
+      // residual norm
+      scalar_type lambda = 1;
+      scalar_type rt = 0;
+      std::span _xt = xt.mutable_array();
+      std::span<const value_type> _x = x.array();
+      std::span<const value_type> _dx = dx.array();
+      for (int k = 0;; ++k)
+      {
+        for (std::size_t i = 0; i < _xt.size(); ++i)
+          _xt[i] = _x[i] - lambda * _dx[i];
+        _fnF(xt, bt);
+        rt = la::norm(bt);
+        if (!line_search or k == line_search_max_it
+            or rt <= (1 - line_search_alpha * lambda) * _residual)
+        {
+          break;
+        }
+        lambda /= 2;
+      }
+
+      // Accept the step
+      std::ranges::copy(xt.array(), x.mutable_array().begin());
+      std::swap(b, bt);
+      _residual = rt;
+      ++_iteration;
+
+      if (report and dolfinx::MPI::rank(x.index_map()->comm()) == 0)
+      {
+        spdlog::info("Newton-Krylov iteration {}: r (abs) = {} (tol = {}), "
+                     "r (rel) = {} (tol = {}), step = {}",
+                     _iteration, _residual, atol, _residual / _residual0,
+                     rtol, lambda);
+      }
+
+      converged = _residual <= atol or _residual <= rtol * _residual0;
+    }
+
+    if (converged)
+    {
+      if (dolfinx::MPI::rank(x.index_map()->comm()) == 0)
+      {
+        spdlog::info("Newton-Krylov solver finished in {} iterations and {} "
+                     "linear solver iterations.",
+                     _iteration, _krylov_iterations);
+      }
+    }
+    else
+    {
+      if (error_on_nonconvergence)
+      {
+        if (_iteration == max_it)
+        {
+          throw std::runtime_error("Newton-Krylov solver did not converge "
+                                   "because maximum number of iterations "
+                                   "reached");
+        }
+        else
+          throw std::runtime_error("Newton-Krylov solver did not converge");
+      }
+      else
+        spdlog::warn("Newton-Krylov solver did not converge.");
+    }
+
+    return {_iteration, converged};
+  }
+
+  /// @brief Number of Newton iterations performed by the last solve.
+  int iteration() const { return _iteration; }
+
+  /// @brief Number of Krylov iterations of the last solve.
+  int krylov_iterations() const { return _krylov_iterations; }
+
+  /// @brief Norm of the current residual.
+  scalar_type residual() const { return _residual; }
+
+  /// @brief Norm of the initial residual.
+  scalar_type residual0() const { return _residual0; }
+
+  /// @brief Maximum number of iterations.
+  int max_it = 50;
+
+  /// @brief Relative convergence tolerance of the residual norm.
+  scalar_type rtol = 1e-9;
+
+  /// @brief Absolute convergence tolerance of the residual norm.
+  scalar_type atol = 1e-10;
+
+  /// @brief Krylov method for the Newton increments.
+  KrylovMethod krylov_method = KrylovMethod::gmres;
+
+  /// @brief Relative tolerance of the Krylov solver.
+  scalar_type krylov_rtol = 1e-4;
+
+  /// @brief Maximum number of iterations of the Krylov solver.
+  int krylov_max_it = 1000;
+
+  /// @brief Restart of the GMRES method.
+  int gmres_restart = 30;
+
+  /// @brief Use a backtracking line search. If false, the full Newton
+  /// step is taken.
+  bool line_search = true;
+
+  /// @brief Maximum number of step halvings of the line search.
+  int line_search_max_it = 10;
+
+  /// @brief Sufficient decrease parameter of the line search. A step
+  /// \f$\lambda\f$ is accepted if \f$\|F(x - \lambda \Delta x)\| \le (1
+  /// - \alpha \lambda) \|F(x)\|\f$.
+  scalar_type line_search_alpha = 1e-4;
+
+  /// @brief Relative size of the finite difference perturbation.
+  scalar_type fd_epsilon
+      = std::sqrt(std::numeric_limits<scalar_type>::epsilon());
+
+  /// @brief Monitor convergence.
+  bool report = true;
+
+  /// @brief Throw error if solver fails to converge.
+  bool error_on_nonconvergence = true;
+
+private:
+  // Function for computing the residual
+  std::function<void(V& x, V& b)> _fnF;
+
+  // Function for computing the Jacobian action
+  std::function<void(V& x, V& v, V& y)> _fnJ;
+
+  // Number of Newton and accumulated Krylov iterations of the last
+  // solve
+  int _iteration = 0, _krylov_iterations = 0;
+
+  // Most recent residual norm and initial residual norm
+  scalar_type _residual = 0, _residual0 = 0;
+};
+} // namespace dolfinx::nls
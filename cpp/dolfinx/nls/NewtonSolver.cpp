@@ -10,6 +10,10 @@
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/la/petsc.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <optional>
 #include <string>
 
 using namespace dolfinx;
@@ -18,17 +22,34 @@ namespace
 {
 //-----------------------------------------------------------------------------
 
-/// Convergence test
+/// Start the computation of the squared L2 norm of a vector, with a
+/// non-blocking reduction
+/// @param x The vector
+/// @param comm Communicator of the vector
+/// @return Handle for the reduction
+dolfinx::MPI::Reduction<PetscReal> squared_norm_begin(const Vec x,
+                                                      MPI_Comm comm)
+{
+  PetscInt n = 0;
+  VecGetLocalSize(x, &n);
+  const PetscScalar* array = nullptr;
+  VecGetArrayRead(x, &array);
+  PetscReal local = 0.0;
+  for (PetscInt i = 0; i < n; ++i)
+    local += std::norm(array[i]);
+  VecRestoreArrayRead(x, &array);
+  return dolfinx::MPI::iallreduce(local, MPI_SUM, comm);
+}
+//-----------------------------------------------------------------------------
+
+/// Convergence test for a computed residual norm
 /// @param solver The Newton solver
-/// @param r The residual vector
+/// @param residual The residual norm
 /// @return The pair `(residual norm, converged)`, where `converged` is
 /// and true` if convergence achieved
 std::pair<double, bool> converged(const nls::petsc::NewtonSolver& solver,
-                                  const Vec r)
+                                  double residual)
 {
-  PetscReal residual = 0.0;
-  VecNorm(r, NORM_2, &residual);
-
   // Relative residual
   const double relative_residual = residual / solver.residual0();
 
@@ -49,6 +70,20 @@ std::pair<double, bool> converged(const nls::petsc::NewtonSolver& solver,
 }
 //-----------------------------------------------------------------------------
 
+/// Convergence test
+/// @param solver The Newton solver
+/// @param r The residual vector
+/// @return The pair `(residual norm, converged)`, where `converged` is
+/// and true` if convergence achieved
+std::pair<double, bool> converged(const nls::petsc::NewtonSolver& solver,
+                                  const Vec r)
+{
+  PetscReal residual = 0.0;
+  VecNorm(r, NORM_2, &residual);
+  return converged(solver, residual);
+}
+//-----------------------------------------------------------------------------
+
 /// Update solution vector by computed Newton step. Default update is
 /// given by formula::
 ///
@@ -67,8 +102,11 @@ void update_solution(const nls::petsc::NewtonSolver& solver, const Vec dx,
 
 //-----------------------------------------------------------------------------
 nls::petsc::NewtonSolver::NewtonSolver(MPI_Comm comm)
-    : _converged(converged), _update_solution(update_solution),
-      _krylov_iterations(0), _iteration(0), _residual(0.0), _residual0(0.0),
+    : _converged([](const NewtonSolver& solver, const Vec r)
+                 { return converged(solver, r); }),
+      _update_solution(update_solution),
+      _krylov_iterations(0), _iteration(0), _jacobian_assemblies(0),
+      _preconditioner_builds(0), _residual(0.0), _residual0(0.0),
       _solver(comm), _dx(nullptr), _comm(comm)
 {
   // Create linear solver if not already created. Default to LU.
@@ -114,6 +152,12 @@ void nls::petsc::NewtonSolver::setP(std::function<void(const Vec, Mat)> P,
   PetscObjectReference((PetscObject)_matP);
 }
 //-----------------------------------------------------------------------------
+void nls::petsc::NewtonSolver::setFJ(
+    std::function<void(const Vec, Vec, Mat)> FJ)
+{
+  _fnFJ = FJ;
+}
+//-----------------------------------------------------------------------------
 const la::petsc::KrylovSolver&
 nls::petsc::NewtonSolver::get_krylov_solver() const
 {
@@ -134,6 +178,7 @@ void nls::petsc::NewtonSolver::set_convergence_check(
     std::function<std::pair<double, bool>(const NewtonSolver&, const Vec)> c)
 {
   _converged = c;
+  _default_convergence = false;
 }
 //-----------------------------------------------------------------------------
 void nls::petsc::NewtonSolver::set_update(
@@ -147,6 +192,8 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
   // Reset iteration counts
   _iteration = 0;
   _krylov_iterations = 0;
+  _jacobian_assemblies = 0;
+  _preconditioner_builds = 0;
   _residual = -1;
   _residual0 = 0.0;
 
@@ -162,15 +209,55 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
                              "been provided to the NewtonSolver.");
   }
 
-  if (_system)
-    _system(x);
-  assert(_b);
-  _fnF(x, _b);
+  // The residual and Jacobian are assembled together if the Jacobian
+  // is needed at every iteration, or the Jacobian is assembled while
+  // the residual norm is reduced
+  const bool fused = _fnFJ and jacobian_lag == 1;
+  const bool speculative = speculative_jacobian and !fused
+                           and jacobian_lag == 1 and _default_convergence
+                           and convergence_criterion == "residual";
+
+  // True if the Jacobian has been assembled at the current solution
+  bool jacobian_ready = false;
+
+  // Compute the residual, and the Jacobian if assembled with the
+  // residual
+  auto compute_residual = [&]()
+  {
+    if (_system)
+      _system(x);
+    assert(_b);
+    if (fused)
+    {
+      _fnFJ(x, _b, _matJ);
+      ++_jacobian_assemblies;
+      jacobian_ready = true;
+    }
+    else
+      _fnF(x, _b);
+  };
+
+  // Test for convergence of the residual
+  auto check_residual = [&]() -> std::pair<double, bool>
+  {
+    if (speculative)
+    {
+      auto norm_sq = squared_norm_begin(_b, _comm.comm());
+      _fnJ(x, _matJ);
+      ++_jacobian_assemblies;
+      jacobian_ready = true;
+      return converged(*this, std::sqrt(norm_sq.value()));
+    }
+    else
+      return this->_converged(*this, _b);
+  };
+
+  compute_residual();
 
   // Check convergence
   bool newton_converged = false;
   if (convergence_criterion == "residual")
-    std::tie(_residual, newton_converged) = this->_converged(*this, _b);
+    std::tie(_residual, newton_converged) = check_residual();
   else if (convergence_criterion == "incremental")
   {
     // We need to do at least one Newton step with the ||dx||-stopping
@@ -193,19 +280,95 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
   if (!_dx)
     MatCreateVecs(_matJ, &_dx, nullptr);
 
+  // Tolerances of the Krylov solver, restored after the iterations if
+  // modified by the Eisenstat-Walker method
+  PetscReal ksp_rtol, ksp_atol, ksp_dtol;
+  PetscInt ksp_max_it;
+  KSPGetTolerances(_solver.ksp(), &ksp_rtol, &ksp_atol, &ksp_dtol,
+                   &ksp_max_it);
+  PetscBool ksp_reuse_pc;
+  KSPGetReusePreconditioner(_solver.ksp(), &ksp_reuse_pc);
+
+  // Residual norms of the current and previous iterations, which are
+  // only computed for Jacobian lagging and Eisenstat-Walker
+  const bool compute_norm_F = jacobian_lag > 1 or eisenstat_walker;
+  PetscReal norm_F = 0.0, norm_F0 = 0.0;
+  if (compute_norm_F)
+    VecNorm(_b, NORM_2, &norm_F);
+
+  // Number of iterations since the Jacobian was assembled and number
+  // of Jacobian assemblies since the preconditioner was built
+  int jacobian_age = 0, preconditioner_age = 0;
+  bool assemble_jacobian = true;
+  double eta = eisenstat_walker_eta0;
+
   // Start iterations
   while (!newton_converged and _iteration < max_it)
   {
-    // Compute Jacobian
+    // Compute Jacobian, unless a lagged Jacobian is reused or the
+    // Jacobian has been assembled with the residual
     assert(_matJ);
-    _fnJ(x, _matJ);
+    if (jacobian_ready or assemble_jacobian or jacobian_age >= jacobian_lag)
+    {
+      if (!jacobian_ready)
+      {
+        _fnJ(x, _matJ);
+        ++_jacobian_assemblies;
+      }
+      jacobian_ready = false;
+      jacobian_age = 0;
+
+      // Build the preconditioner, unless a lagged preconditioner is
+      // reused with the new Jacobian
+      const bool build_preconditioner
+          = _preconditioner_builds == 0
+            or preconditioner_age >= preconditioner_lag;
+      if (build_preconditioner)
+      {
+        if (_fnP)
+          _fnP(x, _matP);
+        ++_preconditioner_builds;
+        preconditioner_age = 0;
+      }
+
+      if (preconditioner_lag > 1)
+      {
+        KSPSetReusePreconditioner(_solver.ksp(),
+                                  build_preconditioner ? PETSC_FALSE
+                                                       : PETSC_TRUE);
+      }
+
+      ++preconditioner_age;
+      assemble_jacobian = false;
+    }
+    ++jacobian_age;
+
+    // Set the relative tolerance of the linear solve
+    if (eisenstat_walker)
+    {
+      if (_iteration > 0 and norm_F0 > 0.0)
+      {
+        double eta_k = eisenstat_walker_gamma
+                       * std::pow(norm_F / norm_F0, eisenstat_walker_alpha);
+        const double eta_s
+            = eisenstat_walker_gamma * std::pow(eta, eisenstat_walker_alpha);
+        if (eta_s > 0.1)
+          eta_k = std::max(eta_k, eta_s);
+        eta = std::min(eta_k, eisenstat_walker_eta_max);
+      }
 
-    if (_fnP)
-      _fnP(x, _matP);
+      KSPSetTolerances(_solver.ksp(), eta, ksp_atol, ksp_dtol, ksp_max_it);
+    }
 
     // Perform linear solve and update total number of Krylov iterations
     _krylov_iterations += _solver.solve(_dx, _b);
 
+    // Start the reduction for the norm of the first update, which is
+    // overlapped with the solution update and the residual evaluation
+    std::optional<dolfinx::MPI::Reduction<PetscReal>> dx_norm_sq;
+    if (_iteration == 0)
+      dx_norm_sq = squared_norm_begin(_dx, _comm.comm());
+
     // Update solution
     this->_update_solution(*this, _dx, x);
 
@@ -213,20 +376,25 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
     ++_iteration;
 
     // Compute F
-    if (_system)
-      _system(x);
-    _fnF(x, _b);
-    // Initialize _residual0
-    if (_iteration == 1)
+    compute_residual();
+
+    // Reassemble a lagged Jacobian at the next iteration if the
+    // residual is not reduced fast enough
+    if (compute_norm_F)
     {
-      PetscReal _r = 0.0;
-      VecNorm(_dx, NORM_2, &_r);
-      _residual0 = _r;
+      norm_F0 = norm_F;
+      VecNorm(_b, NORM_2, &norm_F);
+      if (norm_F > jacobian_lag_rate * norm_F0)
+        assemble_jacobian = true;
     }
 
+    // Initialize _residual0
+    if (_iteration == 1)
+      _residual0 = std::sqrt(dx_norm_sq->value());
+
     // Test for convergence
     if (convergence_criterion == "residual")
-      std::tie(_residual, newton_converged) = this->_converged(*this, _b);
+      std::tie(_residual, newton_converged) = check_residual();
     else if (convergence_criterion == "incremental")
     {
       // Subtract 1 to make sure that the initial residual0 is properly
@@ -243,6 +411,15 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
       throw std::runtime_error("Unknown convergence criterion string.");
   }
 
+  // Restore the Krylov solver settings
+  if (eisenstat_walker)
+  {
+    KSPSetTolerances(_solver.ksp(), ksp_rtol, ksp_atol, ksp_dtol,
+                     ksp_max_it);
+  }
+  if (preconditioner_lag > 1)
+    KSPSetReusePreconditioner(_solver.ksp(), ksp_reuse_pc);
+
   if (newton_converged)
   {
     if (dolfinx::MPI::rank(_comm.comm()) == 0)
@@ -276,6 +453,16 @@ int nls::petsc::NewtonSolver::krylov_iterations() const
   return _krylov_iterations;
 }
 //-----------------------------------------------------------------------------
+int nls::petsc::NewtonSolver::jacobian_assemblies() const
+{
+  return _jacobian_assemblies;
+}
+//-----------------------------------------------------------------------------
+int nls::petsc::NewtonSolver::preconditioner_builds() const
+{
+  return _preconditioner_builds;
+}
+//-----------------------------------------------------------------------------
 int nls::petsc::NewtonSolver::iteration() const { return _iteration; }
 //-----------------------------------------------------------------------------
 double nls::petsc::NewtonSolver::residual() const { return _residual; }
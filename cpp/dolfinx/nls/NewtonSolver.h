@@ -82,6 +82,21 @@ public:
   /// @param[in] Pmat Matrix to assemble the preconditioner into.
   void setP(std::function<void(const Vec, Mat)> P, Mat Pmat);
 
+  /// @brief Set a function that computes the residual vector and the
+  /// Jacobian together, e.g. in a single pass over the cells with
+  /// fem::assemble_matrix_vector.
+  ///
+  /// If set and the Jacobian is reassembled at every iteration
+  /// (NewtonSolver::jacobian_lag is 1), the function is called instead
+  /// of the residual and Jacobian functions, which must still be set
+  /// (see setF and setJ). The Jacobian is then also assembled after the
+  /// final iteration, where it is not used.
+  ///
+  /// @param[in] FJ Function to compute the residual and the Jacobian.
+  /// The arguments are the solution vector `x`, the residual vector
+  /// and the Jacobian matrix to assemble into.
+  void setFJ(std::function<void(const Vec, Vec, Mat)> FJ);
+
   /// @brief Get the internal Krylov solver used to solve for the Newton
   /// updates (const version).
   ///
@@ -139,6 +154,14 @@ public:
   /// @return Number of Krylov iterations.
   int krylov_iterations() const;
 
+  /// @brief Number of Jacobian assemblies since solve started.
+  /// @return Number of Jacobian assemblies.
+  int jacobian_assemblies() const;
+
+  /// @brief Number of preconditioner builds since solve started.
+  /// @return Number of preconditioner builds.
+  int preconditioner_builds() const;
+
   /// @brief Get current residual.
   /// @return Current residual.
   double residual() const;
@@ -172,6 +195,64 @@ public:
   /// @brief Relaxation parameter.
   double relaxation_parameter = 1.0;
 
+  /// @brief Number of Newton iterations that an assembled Jacobian is
+  /// reused for. The default (1) reassembles the Jacobian at every
+  /// iteration.
+  ///
+  /// A lagged Jacobian is reassembled early if the convergence rate
+  /// degrades, see NewtonSolver::jacobian_lag_rate.
+  int jacobian_lag = 1;
+
+  /// @brief Largest ratio \f$\|F(x_{k})\| / \|F(x_{k-1})\|\f$ of
+  /// successive residual norms for which a lagged Jacobian is reused.
+  /// The Jacobian is reassembled at the next iteration if the ratio is
+  /// exceeded.
+  double jacobian_lag_rate = 0.5;
+
+  /// @brief Number of Jacobian assemblies that a preconditioner is
+  /// reused for. The default (1) rebuilds the preconditioner whenever
+  /// the Jacobian is reassembled.
+  ///
+  /// When the preconditioner is reused, the preconditioner matrix is
+  /// not reassembled and the Krylov solver solves with the updated
+  /// Jacobian and the old preconditioner.
+  int preconditioner_lag = 1;
+
+  /// @brief Assemble the Jacobian for the next iteration while the
+  /// residual norm is reduced over processes.
+  ///
+  /// The residual norm is computed with a non-blocking reduction (see
+  /// MPI::iallreduce), which is completed after the Jacobian has been
+  /// assembled, so that the latency of the reduction is hidden. The
+  /// Jacobian assembled after the final iteration is not used. Only
+  /// applies to the "residual" convergence criterion with the default
+  /// convergence check, and if NewtonSolver::jacobian_lag is 1.
+  bool speculative_jacobian = false;
+
+  /// @brief Adapt the relative tolerance of the Krylov solver with the
+  /// Eisenstat-Walker method (choice 2).
+  ///
+  /// The linear solve of iteration \f$k\f$ uses the relative tolerance
+  /// \f$\eta_{k} = \gamma (\|F(x_{k})\| / \|F(x_{k-1})\|)^{\alpha}\f$,
+  /// safeguarded by \f$\eta_{k} \ge \gamma \eta_{k-1}^{\alpha}\f$ when
+  /// \f$\gamma \eta_{k-1}^{\alpha} > 0.1\f$ and bounded by
+  /// NewtonSolver::eisenstat_walker_eta_max. The tolerance of the
+  /// Krylov solver is restored at the end of NewtonSolver::solve.
+  bool eisenstat_walker = false;
+
+  /// @brief Eisenstat-Walker relative tolerance of the first linear
+  /// solve, \f$\eta_{0}\f$.
+  double eisenstat_walker_eta0 = 0.3;
+
+  /// @brief Eisenstat-Walker upper bound of the relative tolerance.
+  double eisenstat_walker_eta_max = 0.9;
+
+  /// @brief Eisenstat-Walker parameter \f$\gamma\f$.
+  double eisenstat_walker_gamma = 0.9;
+
+  /// @brief Eisenstat-Walker parameter \f$\alpha\f$.
+  double eisenstat_walker_alpha = 1.61803398874989484820;
+
 private:
   // Function for computing the residual vector. The first argument is
   // the latest solution vector x and the second argument is the
@@ -183,6 +264,11 @@ private:
   // the matrix operator.
   std::function<void(const Vec x, Mat J)> _fnJ;
 
+  // Function for computing the residual vector and the Jacobian
+  // together. The arguments are the latest solution vector x, the
+  // residual vector and the matrix operator.
+  std::function<void(const Vec x, Vec b, Mat J)> _fnFJ;
+
   // Function for computing the preconditioner matrix operator. The
   // first argument is the latest solution vector x and the second
   // argument is the matrix operator.
@@ -203,6 +289,9 @@ private:
                                         const Vec r)>
       _converged;
 
+  // True if the default convergence check is used
+  bool _default_convergence = true;
+
   // Function to update the solution after inner solve for the Newton increment
   std::function<void(const NewtonSolver& solver, const Vec dx, Vec x)>
       _update_solution;
@@ -213,6 +302,10 @@ private:
   // Number of iterations
   int _iteration;
 
+  // Number of Jacobian assemblies and preconditioner builds since
+  // solve began
+  int _jacobian_assemblies, _preconditioner_builds;
+
   // Most recent residual and initial residual
   double _residual, _residual0;
 
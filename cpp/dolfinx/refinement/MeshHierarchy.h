@@ -0,0 +1,458 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "option.h"
+#include "refine.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace dolfinx::refinement
+{
+namespace impl
+{
+/// @brief Compute the non-zero entries of the prolongation operator
+/// from `V0` on a parent mesh to `V1` on a refined mesh.
+///
+/// Each interpolation point of `V1` on a refined cell is mapped to the
+/// reference cell of the parent cell, where the basis of `V0` is
+/// evaluated. The row of each owned degree-of-freedom of `V1` is
+/// computed once.
+///
+/// @param[in] V0 Space on the parent mesh.
+/// @param[in] V1 Space on the refined mesh.
+/// @param[in] parent_cell Parent cell of each cell of the refined mesh.
+/// @return (0) row (`V1`), (1) column (`V0`) local indices and (2)
+/// values of the non-zero entries. The entries of each row are
+/// contiguous.
+template <std::floating_point T>
+std::tuple<std::vector<std::int32_t>, std::vector<std::int32_t>,
+           std::vector<T>>
+prolongation_entries(const fem::FunctionSpace<T>& V0,
+                     const fem::FunctionSpace<T>& V1,
+                     std::span<const std::int32_t> parent_cell)
+{
+  auto mesh0 = V0.mesh();
+  assert(mesh0);
+  auto mesh1 = V1.mesh();
+  assert(mesh1);
+  auto e0 = V0.element();
+  assert(e0);
+  auto e1 = V1.element();
+  assert(e1);
+
+  for (auto e : {e0, e1})
+  {
+    if (e->map_type() != basix::maps::type::identity
+        or e->reference_value_size() != 1 or e->block_size() != 1
+        or e->needs_dof_transformations())
+    {
+      throw std::runtime_error("Transfer operators are only supported for "
+                               "scalar Lagrange-type spaces.");
+    }
+  }
+
+  const fem::CoordinateElement<T>& cmap0 = mesh0->geometry().cmap();
+  const fem::CoordinateElement<T>& cmap1 = mesh1->geometry().cmap();
+  if (!cmap0.is_affine() or !cmap1.is_affine())
+    throw std::runtime_error("Transfer operators require affine cells.");
+
+  const std::size_t tdim = mesh1->topology()->dim();
+  const std::size_t gdim = mesh1->geometry().dim();
+  const std::int32_t num_cells
+      = mesh1->topology()->index_map(tdim)->size_local();
+  if (parent_cell.size() < static_cast<std::size_t>(num_cells))
+    throw std::runtime_error("Missing parent cells of the refined mesh.");
+
+  // Interpolation points and operator of V1
+  const auto [X1b, X1shape] = e1->interpolation_points();
+  const auto [Pib, Pishape] = e1->interpolation_operator();
+  md::mdspan<const T, md::dextents<std::size_t, 2>> X1(X1b.data(), X1shape);
+  md::mdspan<const T, md::dextents<std::size_t, 2>> Pi(Pib.data(), Pishape);
+  const std::size_t num_points = X1.extent(0);
+  const int ndofs0 = e0->space_dimension();
+  const int ndofs1 = e1->space_dimension();
+
+  auto x_dofmap0 = mesh0->geometry().dofmap();
+  auto x_dofmap1 = mesh1->geometry().dofmap();
+  std::span<const T> x0 = mesh0->geometry().x();
+  std::span<const T> x1 = mesh1->geometry().x();
+  std::shared_ptr<const fem::DofMap> dofmap0 = V0.dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1 = V1.dofmap();
+  const std::int32_t num_owned1 = dofmap1->index_map->size_local();
+
+  // Drop entries that are zero up to rounding, e.g. the basis functions
+  // of parent vertices that are opposite to a new vertex
+  const T tol = 1000 * std::numeric_limits<T>::epsilon();
+
+  std::vector<std::int8_t> computed(num_owned1, false);
+  std::vector<std::int32_t> rows, cols;
+  std::vector<T> values;
+  std::vector<T> Jb(gdim * tdim), Kb(tdim * gdim);
+  md::mdspan<T, md::dextents<std::size_t, 2>> J(Jb.data(), gdim, tdim);
+  md::mdspan<T, md::dextents<std::size_t, 2>> K(Kb.data(), tdim, gdim);
+  std::vector<T> X0b(num_points * tdim);
+  md::mdspan<T, md::dextents<std::size_t, 2>> X0(X0b.data(), num_points,
+                                                  tdim);
+  std::vector<T> phi0b(num_points * ndofs0);
+  md::mdspan<const T, md::dextents<std::size_t, 2>> phi0(phi0b.data(),
+                                                         num_points, ndofs0);
+  std::vector<T> y(gdim);
+  for (std::int32_t c1 = 0; c1 < num_cells; ++c1)
+  {
+    std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(c1);
+    if (std::ranges::none_of(dofs1, [num_owned1, &computed](auto d)
+                             { return d < num_owned1 and !computed[d]; }))
+    {
+      continue;
+    }
+
+    // Jacobian inverse of the parent cell, where the first tdim + 1
+    // nodes of an affine cell are the vertices
+    const std::int32_t c0 = parent_cell[c1];
+    const T* q0 = x0.data() + 3 * x_dofmap0(c0, 0);
+    for (std::size_t k = 0; k < tdim; ++k)
+    {
+      const T* qk = x0.data() + 3 * x_dofmap0(c0, k + 1);
+      for (std::size_t i = 0; i < gdim; ++i)
+        J(i, k) = qk[i] - q0[i];
+    }
+    std::ranges::fill(Kb, 0);
+    fem::CoordinateElement<T>::compute_jacobian_inverse(J, K);
+
+    // Map the interpolation points of the refined cell to the reference
+    // cell of the parent cell
+    const T* p0 = x1.data() + 3 * x_dofmap1(c1, 0);
+    for (std::size_t p = 0; p < num_points; ++p)
+    {
+      for (std::size_t i = 0; i < gdim; ++i)
+        y[i] = p0[i] - q0[i];
+      for (std::size_t k = 0; k < tdim; ++k)
+      {
+        const T* pk = x1.data() + 3 * x_dofmap1(c1, k + 1);
+        for (std::size_t i = 0; i < gdim; ++i)
+          y[i] += X1(p, k) * (pk[i] - p0[i]);
+      }
+      for (std::size_t k = 0; k < tdim; ++k)
+      {
+        X0(p, k) = 0;
+        for (std::size_t i = 0; i < gdim; ++i)
+          X0(p, k) += K(k, i) * y[i];
+      }
+    }
+    e0->tabulate(phi0b, X0b, {num_points, tdim}, 0);
+
+    // Element prolongation matrix Pi * phi0, for the rows that have
+    // not been computed
+    std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(c0);
+    for (int i = 0; i < ndofs1; ++i)
+    {
+      const std::int32_t row = dofs1[i];
+      if (row >= num_owned1 or computed[row])
+        continue;
+      computed[row] = true;
+      for (int j = 0; j < ndofs0; ++j)
+      {
+        T a = 0;
+        for (std::size_t p = 0; p < num_points; ++p)
+          a += Pi(i, p) * phi0(p, j);
+        if (std::abs(a) > tol)
+        {
+          rows.push_back(row);
+          cols.push_back(dofs0[j]);
+          values.push_back(a);
+        }
+      }
+    }
+  }
+
+  return {std::move(rows), std::move(cols), std::move(values)};
+}
+} // namespace impl
+
+/// @brief Create the prolongation operator from a space on a mesh to
+/// the same type of space on a refinement of the mesh.
+///
+/// If `u0` is the degree-of-freedom vector of a function in `V0`, then
+/// `u1 = P u0` is the degree-of-freedom vector of the same function in
+/// `V1`, i.e. the operator is the interpolation between the nested
+/// spaces. The operator can be applied using la::MatrixCSR::mult. The
+/// cells of the refined mesh must be on the same process as the parent
+/// cells, as is the case without re-partitioning (see refine).
+///
+/// @param[in] V0 Space on the parent mesh.
+/// @param[in] V1 Space on the refined mesh.
+/// @param[in] parent_cell Parent cell of each cell of the refined mesh,
+/// in the cell order of the refined mesh (see
+/// MeshHierarchy::parent_cells). The parent cells computed by refine
+/// are in this order only if the parent mesh has no ghost cells.
+/// @return The prolongation matrix, with the rows distributed as the
+/// degrees-of-freedom of `V1`.
+/// @pre `V0` and `V1` are scalar Lagrange-type spaces on affine cells.
+template <dolfinx::scalar U, std::floating_point T>
+la::MatrixCSR<U> create_prolongation(const fem::FunctionSpace<T>& V0,
+                                     const fem::FunctionSpace<T>& V1,
+                                     std::span<const std::int32_t> parent_cell)
+{
+  common::Timer timer("Create prolongation operator");
+  auto [rows, cols, values]
+      = impl::prolongation_entries(V0, V1, parent_cell);
+
+  la::SparsityPattern sp(V1.mesh()->comm(),
+                         {V1.dofmap()->index_map, V0.dofmap()->index_map},
+                         {1, 1});
+  for (std::size_t i = 0; i < rows.size(); ++i)
+    sp.insert(rows[i], cols[i]);
+  sp.finalize();
+
+  // Set the entries row by row
+  la::MatrixCSR<U> P(sp);
+  const std::vector<U> values_u(values.begin(), values.end());
+  for (std::size_t i0 = 0; i0 < rows.size();)
+  {
+    std::size_t i1 = i0;
+    while (i1 < rows.size() and rows[i1] == rows[i0])
+      ++i1;
+    P.template set<1, 1>(std::span(values_u).subspan(i0, i1 - i0),
+                         std::span(rows).subspan(i0, 1),
+                         std::span(cols).subspan(i0, i1 - i0));
+    i0 = i1;
+  }
+
+  return P;
+}
+
+/// @brief Create the restriction operator from a space on a refined
+/// mesh to the same type of space on the parent mesh.
+///
+/// The restriction operator is the transpose of the prolongation
+/// operator (see create_prolongation), e.g. for the Galerkin coarse
+/// operator `A0 = R A1 P`.
+///
+/// @note The column IndexMap of the matrix (`R.index_map(1)`) may have
+/// more ghosts than the IndexMap of `V1`, so vectors that `R` is
+/// applied to must be created with the column IndexMap. To apply the
+/// restriction to vectors of `V1` use apply_restriction.
+///
+/// @param[in] V0 Space on the parent mesh.
+/// @param[in] V1 Space on the refined mesh.
+/// @param[in] parent_cell Parent cell of each cell of the refined mesh,
+/// in the cell order of the refined mesh (see
+/// MeshHierarchy::parent_cells). The parent cells computed by refine
+/// are in this order only if the parent mesh has no ghost cells.
+/// @return The restriction matrix, with the rows distributed as the
+/// degrees-of-freedom of `V0`.
+/// @pre `V0` and `V1` are scalar Lagrange-type spaces on affine cells.
+template <dolfinx::scalar U, std::floating_point T>
+la::MatrixCSR<U> create_restriction(const fem::FunctionSpace<T>& V0,
+                                    const fem::FunctionSpace<T>& V1,
+                                    std::span<const std::int32_t> parent_cell)
+{
+  common::Timer timer("Create restriction operator");
+  auto [rows, cols, values]
+      = impl::prolongation_entries(V0, V1, parent_cell);
+
+  // Rows are the degrees-of-freedom of V0, which may be ghosts
+  la::SparsityPattern sp(V0.mesh()->comm(),
+                         {V0.dofmap()->index_map, V1.dofmap()->index_map},
+                         {1, 1});
+  for (std::size_t i = 0; i < rows.size(); ++i)
+    sp.insert(cols[i], rows[i]);
+  sp.finalize();
+
+  la::MatrixCSR<U> R(sp);
+  for (std::size_t i = 0; i < rows.size(); ++i)
+  {
+    const U value = values[i];
+    R.template add<1, 1>(std::span(&value, 1), std::span(cols).subspan(i, 1),
+                         std::span(rows).subspan(i, 1));
+  }
+  R.scatter_rev();
+
+  return R;
+}
+
+/// @brief Apply the restriction operator without assembling it, i.e.
+/// compute `x0 = P^T x1` using the prolongation operator `P`.
+///
+/// @note Collective.
+///
+/// @param[in] P Prolongation operator, see create_prolongation.
+/// @param[in] x1 Vector on the refined level, with the row layout of
+/// `P`. The ghost entries are not used.
+/// @param[out] x0 Vector on the parent level, with the column layout of
+/// `P`. The owned and ghost entries are overwritten; the ghost entries
+/// are not updated.
+template <dolfinx::scalar U>
+void apply_restriction(const la::MatrixCSR<U>& P, const la::Vector<U>& x1,
+                       la::Vector<U>& x0)
+{
+  assert(P.block_size()[0] == 1 and P.block_size()[1] == 1);
+  assert(x0.index_map()->size_local() == P.index_map(1)->size_local());
+  assert(x0.index_map()->num_ghosts() == P.index_map(1)->num_ghosts());
+
+  // Accumulate the transpose product of the owned rows locally, and
+  // then add the ghost contributions to the owners
+  std::span<const U> _x1 = x1.array();
+  std::span<U> _x0 = x0.mutable_array();
+  std::ranges::fill(_x0, 0);
+  auto& row_ptr = P.row_ptr();
+  auto& cols = P.cols();
+  auto& values = P.values();
+  for (std::int32_t i = 0; i < P.num_owned_rows(); ++i)
+  {
+    for (auto k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+      _x0[cols[k]] += values[k] * _x1[i];
+  }
+  x0.scatter_rev(std::plus<U>());
+}
+
+/// @brief A sequence of meshes in which each mesh is a refinement of
+/// the previous mesh, with the parent-child cell maps between levels.
+///
+/// The refined meshes are not re-partitioned, i.e. the children of a
+/// cell are on the same process as the cell, so the transfer operators
+/// between the levels can be built without communication beyond the
+/// exchange of ghost entries. This is the structure required by
+/// geometric multigrid.
+///
+/// @tparam T Scalar type of the mesh geometry.
+template <std::floating_point T>
+class MeshHierarchy
+{
+public:
+  /// @brief Create a hierarchy with a single (coarsest) level.
+  /// @param[in] mesh The coarsest mesh.
+  explicit MeshHierarchy(std::shared_ptr<mesh::Mesh<T>> mesh)
+      : _meshes({mesh})
+  {
+    assert(mesh);
+  }
+
+  /// @brief Refine the finest mesh and add the refined mesh as a new
+  /// level.
+  /// @param[in] edges Indices of the edges of the finest mesh to split.
+  /// If not provided, uniform refinement is performed.
+  /// @param[in] num_threads Number of threads used in the refinement.
+  void refine(std::optional<std::span<const std::int32_t>> edges
+              = std::nullopt,
+              int num_threads = 1)
+  {
+    std::shared_ptr<mesh::Mesh<T>> mesh = _meshes.back();
+    mesh->topology_mutable()->create_entities(1);
+    auto [mesh1, parent_cell, parent_facet] = refinement::refine(
+        *mesh, edges, nullptr, Option::parent_cell, num_threads);
+    assert(parent_cell);
+
+    // The parent cells are in the order of the refinement data. If the
+    // parent mesh is ghosted, mesh::create_mesh re-orders the refined
+    // cells, so map the parent cells to the order of the refined cells
+    // using the original cell indices.
+    auto topology1 = mesh1.topology();
+    const int tdim = topology1->dim();
+    const std::vector<std::int64_t>& original_cell_index
+        = topology1->original_cell_index[0];
+    const std::int64_t offset = topology1->index_map(tdim)->local_range()[0];
+    std::vector<std::int32_t> parents(original_cell_index.size());
+    for (std::size_t c = 0; c < parents.size(); ++c)
+    {
+      assert(original_cell_index[c] >= offset);
+      assert(original_cell_index[c] - offset
+             < static_cast<std::int64_t>(parent_cell->size()));
+      parents[c] = (*parent_cell)[original_cell_index[c] - offset];
+    }
+
+    _meshes.push_back(std::make_shared<mesh::Mesh<T>>(std::move(mesh1)));
+    _parent_cells.push_back(std::move(parents));
+  }
+
+  /// @brief Number of levels, including the coarsest mesh.
+  int num_levels() const { return _meshes.size(); }
+
+  /// @brief Mesh on a level.
+  /// @param[in] level Level, where 0 is the coarsest mesh.
+  std::shared_ptr<mesh::Mesh<T>> mesh(int level) const
+  {
+    return _meshes.at(level);
+  }
+
+  /// @brief Parent cell (on `level - 1`) of each cell on a level.
+  ///
+  /// Unlike the parent cells returned by refinement::refine, which are
+  /// in the order of the refinement data, the parent cells are in the
+  /// cell order of the mesh on `level`.
+  /// @param[in] level Level, `0 < level < num_levels()`.
+  std::span<const std::int32_t> parent_cells(int level) const
+  {
+    return _parent_cells.at(level - 1);
+  }
+
+  /// @brief Create the prolongation operator from `V0` to `V1`, which
+  /// must be defined on consecutive levels (see create_prolongation).
+  template <dolfinx::scalar U = T>
+  la::MatrixCSR<U> create_prolongation(const fem::FunctionSpace<T>& V0,
+                                       const fem::FunctionSpace<T>& V1) const
+  {
+    return refinement::create_prolongation<U>(V0, V1,
+                                              parent_cells(level(V0, V1)));
+  }
+
+  /// @brief Create the restriction operator from `V1` to `V0`, which
+  /// must be defined on consecutive levels (see create_restriction).
+  template <dolfinx::scalar U = T>
+  la::MatrixCSR<U> create_restriction(const fem::FunctionSpace<T>& V0,
+                                      const fem::FunctionSpace<T>& V1) const
+  {
+    return refinement::create_restriction<U>(V0, V1,
+                                             parent_cells(level(V0, V1)));
+  }
+
+private:
+  // Level of the mesh of V1, checking that V0 is on the previous level
+  int level(const fem::FunctionSpace<T>& V0,
+            const fem::FunctionSpace<T>& V1) const
+  {
+    for (std::size_t l = 1; l < _meshes.size(); ++l)
+    {
+      if (V0.mesh() == _meshes[l - 1] and V1.mesh() == _meshes[l])
+        return l;
+    }
+
+    throw std::runtime_error(
+        "Function spaces are not on consecutive levels of the hierarchy.");
+  }
+
+  // Mesh on each level
+  std::vector<std::shared_ptr<mesh::Mesh<T>>> _meshes;
+
+  // Parent cell of each cell, for levels 1, 2, ...
+  std::vector<std::vector<std::int32_t>> _parent_cells;
+};
+} // namespace dolfinx::refinement
@@ -10,6 +10,8 @@ namespace dolfinx::refinement
 
 // DOLFINx refinement interface
 
+#include <dolfinx/refinement/MeshHierarchy.h>
 #include <dolfinx/refinement/interval.h>
+#include <dolfinx/refinement/marking.h>
 #include <dolfinx/refinement/refine.h>
 #include <dolfinx/refinement/uniform.h>
@@ -0,0 +1,224 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/utils.h>
+#include <limits>
+#include <memory>
+#include <mpi.h>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::refinement
+{
+/// @brief Strategies for marking cells from error indicators.
+enum class Marking : int
+{
+  /// Mark a minimal set of cells whose indicators sum to at least a
+  /// fraction `theta` of the sum of all indicators (Dörfler, or bulk,
+  /// marking).
+  dorfler = 0,
+  /// Mark the cells whose indicator is at least a fraction `theta` of
+  /// the largest indicator.
+  maximum = 1
+};
+
+/// @brief Compute the indicator threshold of a marking strategy.
+///
+/// Cells with an indicator `eta[i] >= threshold` are marked. For
+/// Dörfler marking, the threshold is the largest value for which the
+/// indicators of the marked cells sum to at least `theta` times the sum
+/// of all indicators. The threshold is found by a distributed
+/// histogram search. Each iteration bins the indicators in the current
+/// search interval, sums the bins over all ranks, and narrows the
+/// interval to the bin that holds the threshold. The indicators are
+/// neither gathered nor sorted, and the number of iterations depends
+/// only on the number of bins and the precision of `T`.
+///
+/// The indicators are assumed to be additive, e.g. the squares of
+/// local error estimates as assembled into a DG0 vector. Negative
+/// indicators are never marked.
+///
+/// @note Collective.
+///
+/// @param[in] comm Communicator that the indicators are distributed
+/// on.
+/// @param[in] eta Indicators of the cells owned by this rank.
+/// @param[in] theta Marking fraction in `[0, 1]`.
+/// @param[in] strategy Marking strategy.
+/// @param[in] num_bins Number of histogram bins per iteration of the
+/// Dörfler threshold search.
+/// @return The threshold. If no cell is to be marked, the threshold is
+/// infinity.
+template <std::floating_point T>
+T compute_marking_threshold(MPI_Comm comm, std::span<const T> eta, T theta,
+                            Marking strategy = Marking::dorfler,
+                            int num_bins = 128)
+{
+  common::Timer timer("Compute marking threshold");
+
+  if (theta < 0 or theta > 1)
+    throw std::runtime_error("Marking fraction must be in [0, 1].");
+  if (num_bins < 2)
+    throw std::runtime_error("At least two bins are required.");
+
+  // Largest indicator and sum of (non-negative) indicators
+  constexpr T inf = std::numeric_limits<T>::infinity();
+  T eta_max = 0;
+  {
+    T eta_max_local = 0;
+    for (T e : eta)
+      eta_max_local = std::max(eta_max_local, e);
+    MPI_Allreduce(&eta_max_local, &eta_max, 1, dolfinx::MPI::mpi_t<T>,
+                  MPI_MAX, comm);
+  }
+  if (eta_max <= 0 or theta == 0)
+    return inf;
+  if (strategy == Marking::maximum)
+    return theta * eta_max;
+  if (theta == 1)
+  {
+    // Mark all cells with a positive indicator. This avoids the search
+    // resolving rounding differences in the sum.
+    T eta_min_local = inf, eta_min = inf;
+    for (T e : eta)
+      eta_min_local = e > 0 ? std::min(eta_min_local, e) : eta_min_local;
+    MPI_Allreduce(&eta_min_local, &eta_min, 1, dolfinx::MPI::mpi_t<T>,
+                  MPI_MIN, comm);
+    return eta_min;
+  }
+
+  // Search for the threshold in [lo, hi]. Each pass computes the sum
+  // of the indicators above hi and the sums of the indicators in the
+  // bins of [lo, hi].
+  T lo = 0, hi = eta_max, threshold = 0;
+  T target = -1;
+  std::vector<T> sums_local(num_bins + 1), sums(num_bins + 1);
+  for (int it = 0; it < 4 * std::numeric_limits<T>::digits; ++it)
+  {
+    const T width = (hi - lo) / num_bins;
+    std::ranges::fill(sums_local, 0);
+    for (T e : eta)
+    {
+      if (e > hi)
+        sums_local.back() += e;
+      else if (e >= lo and width > 0)
+      {
+        int b = std::min<int>((e - lo) / width, num_bins - 1);
+        sums_local[b] += e;
+      }
+      else if (e >= lo)
+        sums_local.front() += e;
+    }
+    MPI_Allreduce(sums_local.data(), sums.data(), sums.size(),
+                  dolfinx::MPI::mpi_t<T>, MPI_SUM, comm);
+
+    // The first pass includes all indicators, which gives the target
+    const T above = sums.back();
+    T sum = above;
+    for (int b = 0; b < num_bins; ++b)
+      sum += sums[b];
+    if (target < 0)
+      target = theta * sum;
+
+    // Stop if rounding has moved indicators out of the interval. The
+    // threshold of the previous pass is then still valid.
+    if (sum < target)
+      break;
+
+    // All indicators >= lo sum to at least the target
+    threshold = lo;
+    if (width <= std::numeric_limits<T>::epsilon() * eta_max)
+      break;
+
+    // Find the bin that holds the threshold, i.e. the highest bin for
+    // which the indicators in it and above sum to at least the target
+    int b = num_bins - 1;
+    for (sum = above + sums[b]; sum < target and b > 0; sum += sums[b])
+      --b;
+    const T lo_b = lo + b * width;
+    if (b < num_bins - 1)
+      hi = lo + (b + 1) * width;
+    lo = lo_b;
+  }
+
+  return threshold;
+}
+
+/// @brief Mark cells for refinement from error indicators.
+///
+/// @note Collective.
+///
+/// @param[in] eta Cell indicators, e.g. a DG0 vector assembled from an
+/// error estimator. Only the owned entries are used.
+/// @param[in] theta Marking fraction in `[0, 1]`, see
+/// compute_marking_threshold.
+/// @param[in] strategy Marking strategy.
+/// @return Sorted indices of the marked cells (owned by this rank).
+template <std::floating_point T>
+std::vector<std::int32_t> mark_cells(const la::Vector<T>& eta, T theta,
+                                     Marking strategy = Marking::dorfler)
+{
+  if (eta.bs() != 1)
+    throw std::runtime_error("Indicators must have block size 1.");
+  std::shared_ptr<const common::IndexMap> map = eta.index_map();
+  assert(map);
+  std::span<const T> values = eta.array().first(map->size_local());
+  const T threshold
+      = compute_marking_threshold(map->comm(), values, theta, strategy);
+
+  std::vector<std::int32_t> cells;
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    if (values[i] >= threshold)
+      cells.push_back(i);
+  }
+
+  return cells;
+}
+
+/// @brief Mark edges for refinement from cell error indicators.
+///
+/// The edges of the marked cells (see mark_cells) are returned, and can
+/// be passed directly to refine or plaza::compute_refinement_data,
+/// which make the edge markers consistent across ranks.
+///
+/// @note Collective.
+///
+/// @param[in] topology Mesh topology.
+/// @param[in] eta Cell indicators. Only the owned entries are used.
+/// @param[in] theta Marking fraction in `[0, 1]`, see
+/// compute_marking_threshold.
+/// @param[in] strategy Marking strategy.
+/// @return Sorted indices of the edges of the marked cells.
+/// @pre The cell-to-edge connectivity must have been computed.
+template <std::floating_point T>
+std::vector<std::int32_t> mark_edges(const mesh::Topology& topology,
+                                     const la::Vector<T>& eta, T theta,
+                                     Marking strategy = Marking::dorfler)
+{
+  const int tdim = topology.dim();
+  if (!topology.connectivity(tdim, 1))
+  {
+    throw std::runtime_error(
+        "Cell-to-edge connectivity has not been computed.");
+  }
+  std::vector<std::int32_t> cells = mark_cells(eta, theta, strategy);
+  return mesh::compute_incident_entities(topology, cells, tdim, 1);
+}
+
+} // namespace dolfinx::refinement
@@ -8,12 +8,15 @@
 #include "utils.h"
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/utils.h>
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <numeric>
 #include <vector>
@@ -187,7 +190,8 @@ void plaza::impl::enforce_rules(MPI_Comm comm,
                                 const graph::AdjacencyList<int>& shared_edges,
                                 std::span<std::int8_t> marked_edges,
                                 const mesh::Topology& topology,
-                                std::span<const std::int32_t> long_edge)
+                                std::span<const std::int32_t> long_edge,
+                                int num_threads)
 {
   common::Timer t0("PLAZA: Enforce rules");
 
@@ -210,39 +214,66 @@ void plaza::impl::enforce_rules(MPI_Comm comm,
   const int num_neighbors = indegree;
   std::vector<std::vector<std::int32_t>> marked_for_update(num_neighbors);
 
+  // Edges that are marked by each thread in a sweep over the faces.
+  // Marking is a monotone operation, so threads may mark concurrently
+  // (atomically), and the first thread to mark an edge records it.
+  num_threads = std::max(
+      1, std::min<int>(num_threads, std::max<std::int32_t>(num_faces, 1)));
+  std::vector<std::vector<std::int32_t>> new_marked(num_threads);
+  std::vector<std::int32_t> thread_count(num_threads);
+
   std::int32_t update_count = 1;
   while (update_count > 0)
   {
-    update_count = 0;
     update_logical_edgefunction(comm, marked_for_update, marked_edges, *map_e);
     for (int i = 0; i < num_neighbors; ++i)
       marked_for_update[i].clear();
 
-    for (int f = 0; f < num_faces; ++f)
-    {
-      const std::int32_t long_e = long_edge[f];
-      if (marked_edges[long_e])
-        continue;
+    common::run_threads(
+        num_threads,
+        [&](int thread)
+        {
+          auto [f0, f1] = common::thread_range(thread, num_faces, num_threads);
+          std::vector<std::int32_t>& marked = new_marked[thread];
+          marked.clear();
+          std::int32_t count = 0;
+          for (std::size_t f = f0; f < f1; ++f)
+          {
+            const std::int32_t long_e = long_edge[f];
+            std::atomic_ref<std::int8_t> long_marked(marked_edges[long_e]);
+            if (long_marked.load(std::memory_order_relaxed))
+              continue;
 
-      bool any_marked = false;
-      for (auto edge : f_to_e->links(f))
-        any_marked = any_marked or marked_edges[edge];
+            bool any_marked = false;
+            for (auto edge : f_to_e->links(f))
+            {
+              any_marked = any_marked
+                           or std::atomic_ref<std::int8_t>(marked_edges[edge])
+                                  .load(std::memory_order_relaxed);
+            }
 
-      if (any_marked)
-      {
-        if (!marked_edges[long_e])
-        {
-          marked_edges[long_e] = true;
+            if (any_marked)
+            {
+              if (!long_marked.exchange(true, std::memory_order_relaxed))
+                marked.push_back(long_e);
+              ++count;
+            }
+          }
+          thread_count[thread] = count;
+        });
 
-          // Add sharing neighbors to update set
-          for (int rank : shared_edges.links(long_e))
-            marked_for_update[rank].push_back(long_e);
-        }
-        ++update_count;
+    // Add sharing neighbors to update set
+    for (const std::vector<std::int32_t>& marked : new_marked)
+    {
+      for (std::int32_t e : marked)
+      {
+        for (int rank : shared_edges.links(e))
+          marked_for_update[rank].push_back(e);
       }
     }
 
-    const std::int32_t update_count_old = update_count;
+    const std::int32_t update_count_old
+        = std::reduce(thread_count.begin(), thread_count.end());
     MPI_Allreduce(&update_count_old, &update_count, 1, MPI_INT32_T, MPI_SUM,
                   comm);
   }
@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include "dolfinx/common/threads.h"
 #include "dolfinx/graph/AdjacencyList.h"
 #include "dolfinx/mesh/Mesh.h"
 #include "dolfinx/mesh/Topology.h"
@@ -128,10 +129,15 @@ get_simplices(std::span<const std::int64_t> indices,
 
 /// Propagate edge markers according to rules (longest edge of each
 /// face must be marked, if any edge of face is marked)
+///
+/// The faces are visited concurrently by `num_threads` threads in each
+/// sweep. The markers are only set (never cleared), so the result is
+/// independent of the number of threads.
 void enforce_rules(MPI_Comm comm, const graph::AdjacencyList<int>& shared_edges,
                    std::span<std::int8_t> marked_edges,
                    const mesh::Topology& topology,
-                   std::span<const std::int32_t> long_edge);
+                   std::span<const std::int32_t> long_edge,
+                   int num_threads = 1);
 
 /// @brief Get the longest edge of each face (using local mesh index).
 ///
@@ -278,6 +284,7 @@ face_long_edge(const mesh::Mesh<T>& mesh)
 /// than sqrt(2)/2
 /// @param[in] option Option to compute additional information relating refined
 /// and original mesh entities
+/// @param[in] num_threads Number of threads used to subdivide the cells.
 /// @return (0) The new mesh topology, (1) the new flattened mesh geometry, (3)
 /// Shape of the new geometry_shape, (4) Map from new cells to parent cells
 /// and (5) map from refined facets to parent facets.
@@ -290,7 +297,8 @@ compute_refinement(MPI_Comm neighbor_comm,
                    const graph::AdjacencyList<int>& shared_edges,
                    const mesh::Mesh<T>& mesh,
                    std::span<const std::int32_t> long_edge,
-                   std::span<const std::int8_t> edge_ratio_ok, Option option)
+                   std::span<const std::int8_t> edge_ratio_ok, Option option,
+                   int num_threads = 1)
 {
   int tdim = mesh.topology()->dim();
   int num_cell_edges = tdim * 3 - 3;
@@ -311,9 +319,6 @@ compute_refinement(MPI_Comm neighbor_comm,
   if (compute_facets)
     parent_facet.emplace();
 
-  std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
-  std::vector<std::int32_t> simplex_set;
-
   auto map_c = mesh.topology()->index_map(tdim);
   assert(map_c);
   auto c_to_v = mesh.topology()->connectivity(tdim, 0);
@@ -330,107 +335,162 @@ compute_refinement(MPI_Comm neighbor_comm,
   std::vector<std::int64_t> global_indices
       = adjust_indices(*mesh.topology()->index_map(0), num_new_vertices_local);
 
+  // Global index of the new vertex on each edge (-1 if the edge is not
+  // refined), for lookup without a search when iterating over cells
+  std::vector<std::int64_t> edge_to_new_vertex(marked_edges.size(), -1);
+  for (auto [e, v] : new_vertex_map)
+    edge_to_new_vertex[e] = v;
+
   const std::int32_t num_cells = map_c->size_local();
 
-  // Iterate over all cells, and refine if cell has a marked edge
-  std::vector<std::int64_t> cell_topology;
-  for (int c = 0; c < num_cells; ++c)
+  // Refine the cells in contiguous blocks, one per thread, with the
+  // children of each block stored separately and then concatenated
+  // in block order
+  struct block_data_t
   {
-    // Create vector of indices in the order [vertices][edges], 3+3 in
-    // 2D, 4+6 in 3D
-
-    // Copy vertices
-    auto vertices = c_to_v->links(c);
-    for (std::size_t v = 0; v < vertices.size(); ++v)
-      indices[v] = global_indices[vertices[v]];
-
-    // Get cell-local indices of marked edges
-    auto edges = c_to_e->links(c);
-    bool no_edge_marked = true;
-    for (std::size_t ei = 0; ei < edges.size(); ++ei)
-    {
-      if (marked_edges[edges[ei]])
-      {
-        no_edge_marked = false;
-        auto it = new_vertex_map.find(edges[ei]);
-        assert(it != new_vertex_map.end());
-        indices[num_cell_vertices + ei] = it->second;
-      }
-      else
-        indices[num_cell_vertices + ei] = -1;
-    }
-
-    if (no_edge_marked)
-    {
-      // Copy over existing cell to new topology
-      for (auto v : vertices)
-        cell_topology.push_back(global_indices[v]);
-
-      if (compute_parent_cell)
-        parent_cell->push_back(c);
-
-      if (compute_facets)
-      {
-        if (tdim == 3)
-          parent_facet->insert(parent_facet->end(), {0, 1, 2, 3});
-        else
-          parent_facet->insert(parent_facet->end(), {0, 1, 2});
-      }
-    }
-    else
-    {
-      // Need longest edges of each face in cell local indexing. NB in
-      // 2D the face is the cell itself, and there is just one entry.
-      std::vector<std::int32_t> longest_edge;
-      for (auto f : c_to_f->links(c))
-        longest_edge.push_back(long_edge[f]);
-
-      // Convert to cell local index
-      for (std::int32_t& p : longest_edge)
+    std::vector<std::int64_t> cell_topology;
+    std::vector<std::int32_t> parent_cell;
+    std::vector<std::int8_t> parent_facet;
+  };
+  num_threads = std::max(
+      1, std::min<int>(num_threads, std::max<std::int32_t>(num_cells, 1)));
+  std::vector<block_data_t> block_data(num_threads);
+  common::run_threads(
+      num_threads,
+      [&](int thread)
       {
-        for (std::size_t ej = 0; ej < edges.size(); ++ej)
+        auto [c0, c1] = common::thread_range(thread, num_cells, num_threads);
+        auto& [cell_topology, parent_cell_b, parent_facet_b]
+            = block_data[thread];
+        std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
+        std::vector<std::int32_t> longest_edge;
+        for (std::int32_t c = c0; c < static_cast<std::int32_t>(c1); ++c)
         {
-          if (p == edges[ej])
+          // Create vector of indices in the order [vertices][edges],
+          // 3+3 in 2D, 4+6 in 3D
+
+          // Copy vertices
+          auto vertices = c_to_v->links(c);
+          for (std::size_t v = 0; v < vertices.size(); ++v)
+            indices[v] = global_indices[vertices[v]];
+
+          // Get cell-local indices of marked edges
+          auto edges = c_to_e->links(c);
+          bool no_edge_marked = true;
+          for (std::size_t ei = 0; ei < edges.size(); ++ei)
           {
-            p = ej;
-            break;
+            if (marked_edges[edges[ei]])
+            {
+              no_edge_marked = false;
+              assert(edge_to_new_vertex[edges[ei]] >= 0);
+              indices[num_cell_vertices + ei] = edge_to_new_vertex[edges[ei]];
+            }
+            else
+              indices[num_cell_vertices + ei] = -1;
           }
-        }
-      }
 
-      const bool uniform = (tdim == 2) ? edge_ratio_ok[c] : false;
-      const auto [simplex_set_b, simplex_set_size]
-          = get_simplices(indices, longest_edge, tdim, uniform);
-      std::span<const std::int32_t> simplex_set(simplex_set_b.data(),
-                                                simplex_set_size);
+          if (no_edge_marked)
+          {
+            // Copy over existing cell to new topology
+            for (auto v : vertices)
+              cell_topology.push_back(global_indices[v]);
+
+            if (compute_parent_cell)
+              parent_cell_b.push_back(c);
+
+            if (compute_facets)
+            {
+              if (tdim == 3)
+                parent_facet_b.insert(parent_facet_b.end(), {0, 1, 2, 3});
+              else
+                parent_facet_b.insert(parent_facet_b.end(), {0, 1, 2});
+            }
+          }
+          else
+          {
+            // Need longest edges of each face in cell local indexing.
+            // NB in 2D the face is the cell itself, and there is just
+            // one entry.
+            longest_edge.clear();
+            for (auto f : c_to_f->links(c))
+              longest_edge.push_back(long_edge[f]);
+
+            // Convert to cell local index
+            for (std::int32_t& p : longest_edge)
+            {
+              for (std::size_t ej = 0; ej < edges.size(); ++ej)
+              {
+                if (p == edges[ej])
+                {
+                  p = ej;
+                  break;
+                }
+              }
+            }
+
+            const bool uniform = (tdim == 2) ? edge_ratio_ok[c] : false;
+            const auto [simplex_set_b, simplex_set_size]
+                = get_simplices(indices, longest_edge, tdim, uniform);
+            std::span<const std::int32_t> simplex_set(simplex_set_b.data(),
+                                                      simplex_set_size);
+
+            // Save parent index
+            const std::int32_t ncells = simplex_set.size() / num_cell_vertices;
+            if (compute_parent_cell)
+              parent_cell_b.insert(parent_cell_b.end(), ncells, c);
+
+            if (compute_facets)
+            {
+              if (tdim == 3)
+              {
+                auto npf = compute_parent_facets<3>(simplex_set);
+                parent_facet_b.insert(
+                    parent_facet_b.end(), npf.begin(),
+                    std::next(npf.begin(), simplex_set.size()));
+              }
+              else
+              {
+                auto npf = compute_parent_facets<2>(simplex_set);
+                parent_facet_b.insert(
+                    parent_facet_b.end(), npf.begin(),
+                    std::next(npf.begin(), simplex_set.size()));
+              }
+            }
+
+            // Convert from cell local index to mesh index and add to
+            // cells
+            for (std::int32_t v : simplex_set)
+              cell_topology.push_back(indices[v]);
+          }
+        }
+      });
 
-      // Save parent index
-      const std::int32_t ncells = simplex_set.size() / num_cell_vertices;
+  // Concatenate the blocks
+  std::vector<std::int64_t> cell_topology;
+  if (num_threads == 1)
+  {
+    cell_topology = std::move(block_data.front().cell_topology);
+    if (compute_parent_cell)
+      parent_cell = std::move(block_data.front().parent_cell);
+    if (compute_facets)
+      parent_facet = std::move(block_data.front().parent_facet);
+  }
+  else
+  {
+    for (const block_data_t& b : block_data)
+    {
+      cell_topology.insert(cell_topology.end(), b.cell_topology.begin(),
+                           b.cell_topology.end());
       if (compute_parent_cell)
       {
-        for (std::int32_t i = 0; i < ncells; ++i)
-          parent_cell->push_back(c);
+        parent_cell->insert(parent_cell->end(), b.parent_cell.begin(),
+                            b.parent_cell.end());
       }
-
       if (compute_facets)
       {
-        if (tdim == 3)
-        {
-          auto npf = compute_parent_facets<3>(simplex_set);
-          parent_facet->insert(parent_facet->end(), npf.begin(),
-                               std::next(npf.begin(), simplex_set.size()));
-        }
-        else
-        {
-          auto npf = compute_parent_facets<2>(simplex_set);
-          parent_facet->insert(parent_facet->end(), npf.begin(),
-                               std::next(npf.begin(), simplex_set.size()));
-        }
+        parent_facet->insert(parent_facet->end(), b.parent_facet.begin(),
+                             b.parent_facet.end());
       }
-
-      // Convert from cell local index to mesh index and add to cells
-      for (std::int32_t v : simplex_set)
-        cell_topology.push_back(indices[v]);
     }
   }
 
@@ -453,6 +513,9 @@ compute_refinement(MPI_Comm neighbor_comm,
 /// refinement
 /// @param[in] option Control the computation of parent facets, parent
 /// cells. If an option is unselected, an empty list is returned.
+/// @param[in] num_threads Number of threads used for the local rule
+/// propagation and the subdivision of cells. The result does not depend
+/// on the number of threads.
 /// @return New mesh data: cell topology, vertex coordinates and parent
 /// cell index, and stored parent facet indices (if requested).
 template <std::floating_point T>
@@ -461,7 +524,7 @@ std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<T>,
            std::optional<std::vector<std::int8_t>>>
 compute_refinement_data(const mesh::Mesh<T>& mesh,
                         std::optional<std::span<const std::int32_t>> edges,
-                        Option option)
+                        Option option, int num_threads = 1)
 {
   common::Timer t0("PLAZA: refine");
   auto topology = mesh.topology();
@@ -527,11 +590,13 @@ compute_refinement_data(const mesh::Mesh<T>& mesh,
   // Enforce rules about refinement (i.e. if any edge is marked in a
   // triangle, then the longest edge must also be marked).
   const auto [long_edge, edge_ratio_ok] = impl::face_long_edge(mesh);
-  impl::enforce_rules(comm, edge_ranks, marked_edges, *topology, long_edge);
+  impl::enforce_rules(comm, edge_ranks, marked_edges, *topology, long_edge,
+                      num_threads);
 
   auto [cell_adj, new_vertex_coords, xshape, parent_cell, parent_facet]
       = impl::compute_refinement(comm, marked_edges, edge_ranks, mesh,
-                                 long_edge, edge_ratio_ok, option);
+                                 long_edge, edge_ratio_ok, option,
+                                 num_threads);
   MPI_Comm_free(&comm);
 
   return {std::move(cell_adj), std::move(new_vertex_coords), xshape,
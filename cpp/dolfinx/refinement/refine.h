@@ -15,12 +15,166 @@
 #include "plaza.h"
 #include <algorithm>
 #include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/sort.h>
+#include <memory>
+#include <numeric>
 #include <optional>
+#include <span>
 #include <spdlog/spdlog.h>
 #include <utility>
+#include <vector>
 
 namespace dolfinx::refinement
 {
+namespace impl
+{
+/// @brief Create the refined mesh without re-partitioning, with the
+/// children on the process that owns the parent cell.
+///
+/// The new vertex numbering of the refinement data is contiguous on
+/// each process, so the vertex and cell IndexMaps are built directly
+/// from the process offsets, and the dual graph construction, graph
+/// partitioning and cell reordering that mesh::create_mesh performs are
+/// skipped.
+///
+/// @param[in] mesh Parent mesh.
+/// @param[in] cells Refined cells, using the global vertex indices.
+/// @param[in] x Coordinates of the owned vertices of the refined mesh,
+/// `shape=(num_vertices, gdim)`.
+/// @param[in] xshape Shape of `x`.
+/// @return Refined mesh.
+/// @pre The parent mesh has no ghost cells and a degree 1 coordinate
+/// element.
+template <std::floating_point T>
+mesh::Mesh<T>
+create_refined_mesh(const mesh::Mesh<T>& mesh,
+                    const graph::AdjacencyList<std::int64_t>& cells,
+                    std::span<const T> x, std::array<std::size_t, 2> xshape)
+{
+  common::Timer timer("Refinement: create refined mesh (no repartition)");
+  MPI_Comm comm = mesh.comm();
+  auto topology = mesh.topology();
+  assert(topology);
+  const fem::CoordinateElement<T>& cmap = mesh.geometry().cmap();
+
+  // Owned vertex range on each process
+  const int size = dolfinx::MPI::size(comm);
+  const std::int64_t num_owned = xshape[0];
+  std::vector<std::int64_t> ranges(size + 1, 0);
+  MPI_Allgather(&num_owned, 1, MPI_INT64_T, ranges.data() + 1, 1, MPI_INT64_T,
+                comm);
+  std::partial_sum(ranges.begin(), ranges.end(), ranges.begin());
+  const int rank = dolfinx::MPI::rank(comm);
+  const std::int64_t v0 = ranges[rank];
+  const std::int64_t v1 = ranges[rank + 1];
+
+  // Ghost vertices are the cell vertices outside the owned range
+  std::span<const std::int64_t> cells_g = cells.array();
+  std::vector<std::int64_t> ghosts;
+  std::ranges::copy_if(cells_g, std::back_inserter(ghosts),
+                       [v0, v1](auto v) { return v < v0 or v >= v1; });
+  dolfinx::radix_sort(ghosts);
+  auto [unique_end, range_end] = std::ranges::unique(ghosts);
+  ghosts.erase(unique_end, range_end);
+  std::vector<int> owners;
+  owners.reserve(ghosts.size());
+  for (std::int64_t v : ghosts)
+  {
+    auto it = std::ranges::upper_bound(ranges, v);
+    owners.push_back(std::distance(ranges.begin(), it) - 1);
+  }
+
+  // Cells with the local vertex indices, using the numbering of the
+  // refinement data
+  std::vector<std::int32_t> cells_local(cells_g.size());
+  std::ranges::transform(
+      cells_g, cells_local.begin(),
+      [v0, v1, num_owned, &ghosts](auto v) -> std::int32_t
+      {
+        if (v >= v0 and v < v1)
+          return v - v0;
+        auto it = std::ranges::lower_bound(ghosts, v);
+        return num_owned + std::distance(ghosts.begin(), it);
+      });
+
+  // Number the owned vertices in the order they appear in the cells
+  // (as in mesh::create_mesh), which improves data locality since the
+  // new vertices would otherwise follow all of the parent vertices
+  std::vector<std::int32_t> perm(num_owned, -1);
+  std::int32_t count = 0;
+  for (std::int32_t v : cells_local)
+  {
+    if (v < num_owned and perm[v] < 0)
+      perm[v] = count++;
+  }
+  std::ranges::for_each(perm, [&count](auto& p) { p = p < 0 ? count++ : p; });
+
+  // Send the new global index of the owned vertices to the ghosts
+  std::vector<std::int64_t> global_indices(num_owned + ghosts.size());
+  {
+    common::IndexMap map(comm, num_owned, ghosts, owners);
+    std::ranges::transform(perm, global_indices.begin(),
+                           [v0](auto p) { return v0 + p; });
+    common::Scatterer<> scatterer(map, 1);
+    scatterer.scatter_fwd(
+        std::span<const std::int64_t>(global_indices.data(), num_owned),
+        std::span(global_indices).subspan(num_owned));
+  }
+
+  auto vertex_map = std::make_shared<const common::IndexMap>(
+      comm, num_owned, std::span(global_indices).subspan(num_owned), owners);
+  std::ranges::for_each(cells_local, [&perm, num_owned](auto& v)
+                        { v = v < num_owned ? perm[v] : v; });
+
+  // Cells remain on the process that owns the parent, and there are no
+  // ghost cells. For a degree 1 coordinate element the vertices are also
+  // the geometry nodes.
+  const std::int32_t num_cells = cells.num_nodes();
+  auto cell_map = std::make_shared<const common::IndexMap>(comm, num_cells);
+  std::vector<std::int64_t> original_cell_index(num_cells);
+  std::iota(original_cell_index.begin(), original_cell_index.end(),
+            cell_map->local_range()[0]);
+  const int num_cell_vertices
+      = mesh::cell_num_entities(topology->cell_type(), 0);
+  auto topology1 = std::make_shared<mesh::Topology>(
+      std::vector{topology->cell_type()}, vertex_map,
+      std::vector{cell_map},
+      std::vector{std::make_shared<graph::AdjacencyList<std::int32_t>>(
+          graph::regular_adjacency_list(cells_local, num_cell_vertices))},
+      std::vector<std::vector<std::int64_t>>{std::move(original_cell_index)});
+
+  // Coordinates (padded to 3D) of the owned and ghost vertices, and the
+  // vertex indices of the refinement data as the input global indices
+  const std::size_t gdim = xshape[1];
+  const std::int32_t num_vertices = num_owned + ghosts.size();
+  std::vector<T> x1(3 * num_vertices, 0);
+  std::vector<std::int64_t> input_global_indices(num_vertices);
+  for (std::int32_t i = 0; i < num_owned; ++i)
+  {
+    std::copy_n(std::next(x.begin(), gdim * i), gdim,
+                std::next(x1.begin(), 3 * perm[i]));
+    input_global_indices[perm[i]] = v0 + i;
+  }
+  common::Scatterer<> scatterer(*vertex_map, 3);
+  scatterer.scatter_fwd(std::span<const T>(x1.data(), 3 * num_owned),
+                        std::span<T>(x1).subspan(3 * num_owned));
+  std::ranges::copy(ghosts,
+                    std::next(input_global_indices.begin(), num_owned));
+
+  mesh::Geometry<T> geometry(
+      vertex_map,
+      std::vector<std::vector<std::int32_t>>{std::move(cells_local)}, {cmap},
+      std::move(x1), gdim, std::move(input_global_indices));
+
+  return mesh::Mesh<T>(comm, topology1, std::move(geometry));
+}
+} // namespace impl
+
 /// @brief Refine a mesh with markers.
 ///
 /// The refined mesh can be optionally re-partitioned across processes.
@@ -40,6 +194,12 @@ namespace dolfinx::refinement
 /// possibility to not re-partition the refined mesh and include ghost
 /// cells in the refined mesh will be added in a future release.
 ///
+/// @note Passing `nullptr` for `partitioner` and if the parent mesh has
+/// no ghost cells, the refined mesh is built directly from the parent
+/// distribution, i.e. without computing the dual graph, partitioning
+/// and reordering the cells. This is considerably cheaper than
+/// re-partitioning.
+///
 /// @param[in] mesh Input mesh to be refined.
 /// @param[in] edges Indices of the edges that should be split in the
 /// refinement. If not provided (`std::nullopt`), uniform refinement is
@@ -49,6 +209,8 @@ namespace dolfinx::refinement
 /// process as the parent cell.
 /// @param[in] option Control the computation of parent facets, parent
 /// cells. If an option is not selected, an empty list is returned.
+/// @param[in] num_threads Number of threads used to compute the
+/// refinement of triangle and tetrahedral meshes.
 /// @return New mesh, and optional parent cell indices and parent facet
 /// indices.
 template <std::floating_point T>
@@ -58,7 +220,7 @@ refine(const mesh::Mesh<T>& mesh,
        std::optional<std::span<const std::int32_t>> edges,
        const mesh::CellPartitionFunction& partitioner
        = mesh::create_cell_partitioner(mesh::GhostMode::none),
-       Option option = Option::none)
+       Option option = Option::none, int num_threads = 1)
 {
   auto topology = mesh.topology();
   assert(topology);
@@ -68,14 +230,27 @@ refine(const mesh::Mesh<T>& mesh,
   auto [cell_adj, new_vertex_coords, xshape, parent_cell, parent_facet]
       = (topology->cell_type() == mesh::CellType::interval)
             ? interval::compute_refinement_data(mesh, edges, option)
-            : plaza::compute_refinement_data(mesh, edges, option);
+            : plaza::compute_refinement_data(mesh, edges, option,
+                                             num_threads);
 
-  mesh::Mesh<T> mesh1 = mesh::create_mesh(
-      mesh.comm(), mesh.comm(), cell_adj.array(), mesh.geometry().cmap(),
-      mesh.comm(), new_vertex_coords, xshape, partitioner);
+  // Skip the re-partitioning if the children stay with the parents and
+  // the parent mesh is not ghosted
+  const int D = topology->dim();
+  int num_ghosts_local = topology->index_map(D)->num_ghosts();
+  int num_ghosts = 0;
+  MPI_Allreduce(&num_ghosts_local, &num_ghosts, 1, MPI_INT, MPI_MAX,
+                mesh.comm());
+  mesh::Mesh<T> mesh1
+      = (!partitioner and num_ghosts == 0
+         and mesh.geometry().cmap().degree() == 1)
+            ? impl::create_refined_mesh(mesh, cell_adj,
+                                        std::span<const T>(new_vertex_coords),
+                                        xshape)
+            : mesh::create_mesh(mesh.comm(), mesh.comm(), cell_adj.array(),
+                                mesh.geometry().cmap(), mesh.comm(),
+                                new_vertex_coords, xshape, partitioner);
 
   // Report the number of refined cells
-  const int D = topology->dim();
   const std::int64_t n0 = topology->index_map(D)->size_global();
   const std::int64_t n1 = mesh1.topology()->index_map(D)->size_global();
   spdlog::info(
@@ -1,9 +1,17 @@
 
+#include <algorithm>
+#include <array>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/utils.h>
 #include <iterator>
+#include <memory>
+#include <numeric>
+#include <span>
 #include <vector>
 
 #include "uniform.h"
@@ -15,11 +23,11 @@ mesh::Mesh<T>
 refinement::uniform_refine(const mesh::Mesh<T>& mesh,
                            const mesh::CellPartitionFunction& partitioner)
 {
+  common::Timer timer("Uniform refinement");
+
   // Requires edges (and facets for some 3D meshes) to be built already
   auto topology = mesh.topology();
   int tdim = topology->dim();
-  if (tdim < 2)
-    throw std::runtime_error("Uniform refinement only for 2D and 3D meshes");
 
   spdlog::info("Topology dim = {}", tdim);
 
@@ -39,10 +47,13 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
   std::vector<int> e_index = {0, 0};
 
   // Check for quadrilateral faces and get index, if any.
-  if (auto it = std::find(entity_types[2].begin(), entity_types[2].end(),
-                          mesh::CellType::quadrilateral);
-      it != entity_types[2].end())
-    e_index.push_back(std::distance(entity_types[2].begin(), it));
+  if (tdim > 1)
+  {
+    if (auto it = std::find(entity_types[2].begin(), entity_types[2].end(),
+                            mesh::CellType::quadrilateral);
+        it != entity_types[2].end())
+      e_index.push_back(std::distance(entity_types[2].begin(), it));
+  }
 
   if (tdim == 3)
   {
@@ -92,13 +103,25 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
     }
   }
 
-  // Compute offset for vertices related to each entity type
+  // Compute offset for vertices related to each entity type. The new
+  // vertices are numbered locally with the owned vertices of each
+  // entity type first, followed by the ghost vertices of each type.
   std::vector<std::int32_t> entity_offsets(index_maps.size() + 1, 0);
+  std::vector<std::int32_t> ghost_offsets(index_maps.size() + 1, nlocal);
   for (std::size_t i = 0; i < index_maps.size(); ++i)
+  {
     entity_offsets[i + 1] = entity_offsets[i] + index_maps[i]->size_local();
+    ghost_offsets[i + 1] = ghost_offsets[i] + index_maps[i]->num_ghosts();
+  }
+  auto local_index = [&](int j, std::int32_t w) -> std::int32_t
+  {
+    const std::int32_t size_local = index_maps[j]->size_local();
+    return w < size_local ? entity_offsets[j] + w
+                          : ghost_offsets[j] + w - size_local;
+  };
 
   // Copy existing vertices
-  std::vector<T> new_x(nlocal * 3);
+  std::vector<T> new_x(ghost_offsets.back() * 3);
   auto x_g = mesh.geometry().x();
   for (int i = 0; i < index_maps[0]->size_local(); ++i)
     for (int j = 0; j < 3; ++j)
@@ -135,9 +158,11 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
   std::array<std::int64_t, 2> local_range = {nscan - nlocal, nscan};
 
   // Compute indices for new vertices and share across processes
+  std::vector<std::int64_t> vertex_global(ghost_offsets.back());
   for (std::size_t j = 0; j < index_maps.size(); ++j)
   {
     std::int32_t num_entities = index_maps[j]->size_local();
+    std::int32_t num_ghosts = index_maps[j]->num_ghosts();
     assert(num_entities == entity_offsets[j + 1] - entity_offsets[j]);
     std::iota(new_v[j].begin(), std::next(new_v[j].begin(), num_entities),
               local_range[0] + entity_offsets[j]);
@@ -145,13 +170,23 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
     common::Scatterer sc(*index_maps[j], 1);
     sc.scatter_fwd(std::span<const std::int64_t>(new_v[j]),
                    std::span(std::next(new_v[j].begin(), num_entities),
-                             index_maps[j]->num_ghosts()));
+                             num_ghosts));
+    for (std::int32_t w = 0; w < num_entities + num_ghosts; ++w)
+      vertex_global[local_index(j, w)] = new_v[j][w];
+
+    // Without re-partitioning, the ghost vertices are also required.
+    // Their coordinates are received from the owner, so that they are
+    // bitwise identical across processes.
+    if (!partitioner)
+    {
+      common::Scatterer scx(*index_maps[j], 3);
+      scx.scatter_fwd(
+          std::span<const T>(new_x).subspan(3 * entity_offsets[j],
+                                            3 * num_entities),
+          std::span(new_x).subspan(3 * ghost_offsets[j], 3 * num_ghosts));
+    }
   }
 
-  // Create new topology
-  std::vector<std::vector<std::int64_t>> mixed_topology(
-      cell_entity_types.size());
-
   // Find index of tets in topology list, if any
   int ktet = -1;
   auto it = std::find(cell_entity_types.begin(), cell_entity_types.end(),
@@ -162,12 +197,22 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
   std::array<int, 16> pyr_to_tet_list
       = {5, 13, 7, 9, 6, 13, 11, 7, 10, 13, 12, 11, 8, 13, 9, 12};
 
+  // Create new topology, in the local vertex numbering, for the
+  // children of owned cells and, without re-partitioning, ghost cells.
+  // Tetrahedra from pyramid subdivision follow the tetrahedron children.
+  const int num_cell_types = cell_entity_types.size();
+  std::vector<std::vector<std::int32_t>> cells_owned(num_cell_types);
+  std::vector<std::vector<std::int32_t>> cells_ghost(num_cell_types);
+  std::array<std::vector<std::int32_t>, 2> pyr_tets;
+  std::vector<int> num_children(num_cell_types);
+  std::vector<int> num_cell_vertices(num_cell_types);
+
   std::vector<int> refined_cell_list;
-  for (int k = 0; k < static_cast<int>(cell_entity_types.size()); ++k)
+  for (int k = 0; k < num_cell_types; ++k)
   {
     // Reserve an estimate of space for the topology of each type
-    mixed_topology[k].reserve(mesh.topology()->index_maps(tdim)[k]->size_local()
-                              * 8 * 6);
+    cells_owned[k].reserve(mesh.topology()->index_maps(tdim)[k]->size_local()
+                           * 8 * 6);
 
     // Select correct subdivision for celltype
     // Hex -> 8 hex, Prism -> 8 prism, Tet -> 8 tet, Pyr -> 5 pyr + 4 tet
@@ -179,7 +224,7 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
     switch (cell_entity_types[k])
     {
     case mesh::CellType::hexahedron:
-      spdlog::debug("Hex subdivision [{}]", k);
+      SPDLOG_DEBUG("Hex subdivision [{}]", k);
       refined_cell_list
           = {0, 9,  8,  20, 10, 22, 21, 26, 1, 11, 8,  20, 12, 23, 21, 26,
              2, 13, 9,  20, 14, 24, 22, 26, 3, 13, 11, 20, 15, 24, 23, 26,
@@ -188,13 +233,13 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
       break;
 
     case mesh::CellType::tetrahedron:
-      spdlog::debug("Tet subdivision [{}]", k);
+      SPDLOG_DEBUG("Tet subdivision [{}]", k);
       refined_cell_list = {0, 7, 8, 9, 1, 5, 6, 9, 2, 4, 6, 8, 3, 4, 5, 7,
                            9, 4, 6, 8, 9, 4, 8, 7, 9, 4, 7, 5, 9, 4, 5, 6};
       break;
 
     case mesh::CellType::prism:
-      spdlog::debug("Prism subdivision [{}]", k);
+      SPDLOG_DEBUG("Prism subdivision [{}]", k);
       refined_cell_list
           = {0,  6,  7,  8,  15, 16, 6,  1,  9,  15, 10, 17, 7,  9,  2,  16,
              17, 11, 6,  9,  7,  15, 17, 16, 15, 17, 16, 12, 14, 13, 8,  15,
@@ -202,7 +247,7 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
       break;
 
     case mesh::CellType::pyramid:
-      spdlog::debug("Pyramid subdivision [{}]", k);
+      SPDLOG_DEBUG("Pyramid subdivision [{}]", k);
       refined_cell_list = {0,  5,  6, 13, 7,  1,  8,  5, 13, 9,  3,  10, 8,
                            13, 12, 2, 6,  10, 13, 11, 7, 9,  11, 12, 4};
       if (ktet == -1)
@@ -211,32 +256,48 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
       break;
 
     case mesh::CellType::triangle:
-      spdlog::debug("Triangle subdivision [{}]", k);
+      SPDLOG_DEBUG("Triangle subdivision [{}]", k);
       refined_cell_list = {0, 4, 5, 1, 5, 3, 2, 3, 4, 3, 4, 5};
       break;
 
     case mesh::CellType::quadrilateral:
-      spdlog::debug("Quad subdivision [{}]", k);
+      SPDLOG_DEBUG("Quad subdivision [{}]", k);
       refined_cell_list = {0, 4, 5, 8, 1, 6, 4, 8, 2, 7, 5, 8, 3, 7, 6, 8};
       break;
 
+    case mesh::CellType::interval:
+      SPDLOG_DEBUG("Interval subdivision [{}]", k);
+      refined_cell_list = {0, 2, 2, 1};
+      break;
+
     default:
       throw std::runtime_error("Unhandled cell type");
     }
 
+    num_cell_vertices[k] = mesh::cell_num_entities(cell_entity_types[k], 0);
+    num_children[k] = refined_cell_list.size() / num_cell_vertices[k];
+
     auto c_to_v = topology->connectivity({tdim, k}, {0, 0});
     auto c_to_e = topology->connectivity({tdim, k}, {1, 0});
 
-    for (int c = 0; c < topology->index_maps(tdim)[k]->size_local(); ++c)
+    const auto im = topology->index_maps(tdim)[k];
+    const std::int32_t num_cells
+        = im->size_local() + (partitioner ? 0 : im->num_ghosts());
+    for (std::int32_t c = 0; c < num_cells; ++c)
     {
-      // Cell topology defined through its globally numbered vertices
-      std::vector<std::int64_t> entities;
-      // Extract new global vertex number for existing vertices
+      // Cell topology defined through its locally numbered vertices
+      std::vector<std::int32_t> entities;
+      // Extract new vertex number for existing vertices
       for (std::int32_t i : c_to_v->links(c))
-        entities.push_back(new_v[0][i]);
+        entities.push_back(local_index(0, i));
       // Indices for vertices inserted on edges
-      for (std::int32_t i : c_to_e->links(c))
-        entities.push_back(new_v[1][i]);
+      if (tdim == 1)
+        entities.push_back(local_index(1, c));
+      else
+      {
+        for (std::int32_t i : c_to_e->links(c))
+          entities.push_back(local_index(1, i));
+      }
       if (e_index.size() > 2)
       {
         if (tdim == 3)
@@ -247,38 +308,191 @@ refinement::uniform_refine(const mesh::Mesh<T>& mesh,
           {
             for (std::int32_t i :
                  topology->connectivity({3, k}, {2, e_index[2]})->links(c))
-              entities.push_back(new_v[2][i]);
+              entities.push_back(local_index(2, i));
           }
         }
         // Add vertices for quadrilateral cells (2D mesh)
         else if (cell_entity_types[k] == mesh::CellType::quadrilateral)
-          entities.push_back(new_v[2][c]);
+          entities.push_back(local_index(2, c));
       }
 
       // Add vertices for hex cell centres
       if (e_index.size() > 3
           and cell_entity_types[k] == mesh::CellType::hexahedron)
-        entities.push_back(new_v[3][c]);
+        entities.push_back(local_index(3, c));
 
+      const bool owned = c < im->size_local();
+      std::vector<std::int32_t>& cells
+          = owned ? cells_owned[k] : cells_ghost[k];
       for (int i : refined_cell_list)
-        mixed_topology[k].push_back(entities[i]);
+        cells.push_back(entities[i]);
 
       if (cell_entity_types[k] == mesh::CellType::pyramid)
       {
         for (int i : pyr_to_tet_list)
-          mixed_topology[ktet].push_back(entities[i]);
+          pyr_tets[owned ? 0 : 1].push_back(entities[i]);
       }
     }
   }
 
-  spdlog::debug("Create new mesh");
-  std::vector<std::span<const std::int64_t>> topo_span(mixed_topology.begin(),
-                                                       mixed_topology.end());
-  mesh::Mesh new_mesh = mesh::create_mesh(
-      mesh.comm(), mesh.comm(), topo_span, mesh.geometry().cmaps(), mesh.comm(),
-      new_x, {new_x.size() / 3, 3}, partitioner);
+  // Number of owned tetrahedra that are children of tetrahedra
+  std::int32_t num_tet_children = 0;
+  if (ktet != -1)
+  {
+    num_tet_children = cells_owned[ktet].size() / 4;
+    cells_owned[ktet].insert(cells_owned[ktet].end(), pyr_tets[0].begin(),
+                             pyr_tets[0].end());
+    cells_ghost[ktet].insert(cells_ghost[ktet].end(), pyr_tets[1].begin(),
+                             pyr_tets[1].end());
+  }
+
+  if (partitioner)
+  {
+    SPDLOG_DEBUG("Create new mesh");
+    std::vector<std::vector<std::int64_t>> mixed_topology(num_cell_types);
+    for (int k = 0; k < num_cell_types; ++k)
+    {
+      mixed_topology[k].resize(cells_owned[k].size());
+      std::ranges::transform(cells_owned[k], mixed_topology[k].begin(),
+                             [&vertex_global](auto v)
+                             { return vertex_global[v]; });
+    }
+
+    std::vector<std::span<const std::int64_t>> topo_span(
+        mixed_topology.begin(), mixed_topology.end());
+    mesh::Mesh new_mesh = mesh::create_mesh(
+        mesh.comm(), mesh.comm(), topo_span, mesh.geometry().cmaps(),
+        mesh.comm(), std::span<const T>(new_x).first(3 * nlocal),
+        {static_cast<std::size_t>(nlocal), 3}, partitioner);
+
+    return new_mesh;
+  }
+
+  // Without re-partitioning, the children of a cell are on the process
+  // of the parent, with the same owner. The mesh is built directly, and
+  // since the neighbourhood of each process is unchanged the index maps
+  // are created without a consensus algorithm.
+  SPDLOG_DEBUG("Create new mesh (no re-partitioning)");
+  MPI_Comm comm = mesh.comm();
+  auto merge_ranks = [&index_maps](auto&& ranks)
+  {
+    std::vector<int> r;
+    for (auto& map : index_maps)
+      r.insert(r.end(), ranks(*map).begin(), ranks(*map).end());
+    std::ranges::sort(r);
+    auto [unique_end, range_end] = std::ranges::unique(r);
+    r.erase(unique_end, range_end);
+    return r;
+  };
+  std::vector<int> vertex_owners;
+  for (auto& map : index_maps)
+  {
+    vertex_owners.insert(vertex_owners.end(), map->owners().begin(),
+                         map->owners().end());
+  }
+  auto vertex_map = std::make_shared<const common::IndexMap>(
+      comm, nlocal,
+      std::array{merge_ranks([](auto& map) { return map.src(); }),
+                 merge_ranks([](auto& map) { return map.dest(); })},
+      std::span<const std::int64_t>(vertex_global).subspan(nlocal),
+      vertex_owners);
+
+  // Global index of the first child of each owned cell and, for
+  // pyramids, of the first tetrahedron child
+  std::vector<std::int64_t> num_owned(num_cell_types), offsets(num_cell_types);
+  for (int k = 0; k < num_cell_types; ++k)
+    num_owned[k] = cells_owned[k].size() / num_cell_vertices[k];
+  MPI_Scan(num_owned.data(), offsets.data(), num_cell_types, MPI_INT64_T,
+           MPI_SUM, comm);
+  for (int k = 0; k < num_cell_types; ++k)
+    offsets[k] -= num_owned[k];
+
+  std::vector<std::vector<std::int64_t>> ghost_cells(num_cell_types);
+  std::vector<std::vector<int>> ghost_owners(num_cell_types);
+  std::vector<std::int64_t> pyr_tet_ghosts;
+  std::vector<int> pyr_tet_owners;
+  for (int k = 0; k < num_cell_types; ++k)
+  {
+    const auto im = topology->index_maps(tdim)[k];
+    const std::int32_t num_cells = im->size_local();
+    const bool pyramid = cell_entity_types[k] == mesh::CellType::pyramid;
+    std::vector<std::int64_t> first_child(2 * (num_cells + im->num_ghosts()));
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      first_child[2 * c] = offsets[k] + c * num_children[k];
+      first_child[2 * c + 1]
+          = pyramid ? offsets[ktet] + num_tet_children + c * 4 : -1;
+    }
+
+    common::Scatterer sc(*im, 2);
+    sc.scatter_fwd(
+        std::span<const std::int64_t>(first_child).first(2 * num_cells),
+        std::span(first_child).subspan(2 * num_cells));
+
+    std::span owners = im->owners();
+    for (std::int32_t i = 0; i < im->num_ghosts(); ++i)
+    {
+      std::int64_t c0 = first_child[2 * (num_cells + i)];
+      for (int j = 0; j < num_children[k]; ++j)
+      {
+        ghost_cells[k].push_back(c0 + j);
+        ghost_owners[k].push_back(owners[i]);
+      }
+
+      if (pyramid)
+      {
+        std::int64_t t0 = first_child[2 * (num_cells + i) + 1];
+        for (int j = 0; j < 4; ++j)
+        {
+          pyr_tet_ghosts.push_back(t0 + j);
+          pyr_tet_owners.push_back(owners[i]);
+        }
+      }
+    }
+  }
+  if (ktet != -1)
+  {
+    ghost_cells[ktet].insert(ghost_cells[ktet].end(), pyr_tet_ghosts.begin(),
+                             pyr_tet_ghosts.end());
+    ghost_owners[ktet].insert(ghost_owners[ktet].end(),
+                              pyr_tet_owners.begin(), pyr_tet_owners.end());
+  }
+
+  std::vector<std::shared_ptr<const common::IndexMap>> cell_maps;
+  std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>> cells;
+  std::vector<std::vector<std::int32_t>> dofmaps;
+  std::vector<std::vector<std::int64_t>> original_cell_index;
+  for (int k = 0; k < num_cell_types; ++k)
+  {
+    const auto im = topology->index_maps(tdim)[k];
+    cell_maps.push_back(std::make_shared<const common::IndexMap>(
+        comm, num_owned[k],
+        std::array{std::vector(im->src().begin(), im->src().end()),
+                   std::vector(im->dest().begin(), im->dest().end())},
+        ghost_cells[k], ghost_owners[k]));
+
+    original_cell_index.emplace_back(num_owned[k]);
+    std::iota(original_cell_index[k].begin(), original_cell_index[k].end(),
+              offsets[k]);
+    original_cell_index[k].insert(original_cell_index[k].end(),
+                                  ghost_cells[k].begin(), ghost_cells[k].end());
+
+    // For a degree 1 coordinate element the vertices are also the
+    // geometry nodes
+    dofmaps.push_back(std::move(cells_owned[k]));
+    dofmaps[k].insert(dofmaps[k].end(), cells_ghost[k].begin(),
+                      cells_ghost[k].end());
+    cells.push_back(std::make_shared<graph::AdjacencyList<std::int32_t>>(
+        graph::regular_adjacency_list(dofmaps[k], num_cell_vertices[k])));
+  }
+
+  auto new_topology = std::make_shared<mesh::Topology>(
+      cell_entity_types, vertex_map, cell_maps, cells, original_cell_index);
+  mesh::Geometry<T> geometry(vertex_map, std::move(dofmaps),
+                             mesh.geometry().cmaps(), std::move(new_x),
+                             mesh.geometry().dim(), std::move(vertex_global));
 
-  return new_mesh;
+  return mesh::Mesh<T>(comm, new_topology, std::move(geometry));
 }
 
 /// @cond Explicit instatiation for float and double
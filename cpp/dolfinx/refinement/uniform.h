@@ -5,15 +5,29 @@
 namespace dolfinx::refinement
 {
 
-/// @brief Uniform refinement of a 2D or 3D mesh, containing any supported cell
+/// @brief Uniform refinement of a mesh, containing any supported cell
 /// types.
 /// Hexahedral, tetrahedral and prism cells are subdivided into 8, each being
 /// similar to the original cell. Pyramid cells are subdivided into 5 similar
 /// pyramids, plus 4 tetrahedra. Triangle and quadrilateral cells are subdivided
-/// into 4 similar subcells.
+/// into 4 similar subcells, and intervals into 2.
+///
+/// If `partitioner` is `nullptr`, the refined mesh is constructed
+/// directly in the local numbering, without re-partitioning: the
+/// children of a cell are on the same process as the parent and have
+/// the same owner, and the children of ghost cells are ghosts. Since the
+/// ghost layer is the refined ghost layer of `mesh`, it is one parent
+/// cell thick. This avoids the graph partitioning and data distribution
+/// of mesh::create_mesh, e.g. when generating large meshes by repeated
+/// refinement.
+///
+/// @pre The entities of dimension 1 (and, for meshes with
+/// quadrilateral facets, of dimension 2) have been created.
+/// @pre The coordinate elements have degree 1.
 /// @tparam T Scalar type of the mesh geometry
 /// @param mesh Input mesh
-/// @param partitioner Function to partition new mesh across processes.
+/// @param partitioner Function to partition new mesh across processes,
+/// or `nullptr` to keep the refined cells on the process of the parent.
 /// @returns Uniformly refined mesh
 template <typename T>
 mesh::Mesh<T>
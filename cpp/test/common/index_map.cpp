@@ -7,10 +7,12 @@
 #include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <cstring>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Scatterer.h>
 #include <numeric>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -60,6 +62,76 @@ void test_scatter_fwd(int n)
   CHECK(
       std::ranges::all_of(data_ghost, [=](auto i)
                           { return i == val * ((mpi_rank + 1) % mpi_size); }));
+
+  // Automatically selected pattern, which is the same on all ranks
+  std::vector<MPI_Request> arequests
+      = sct.create_request_vector(decltype(sct)::type::automatic);
+  std::ranges::fill(data_ghost, 0);
+  sct.scatter_fwd_begin<std::int64_t>(data_local, data_ghost, arequests,
+                                      decltype(sct)::type::automatic);
+  sct.scatter_fwd_end(arequests);
+  CHECK(
+      std::ranges::all_of(data_ghost, [=](auto i)
+                          { return i == val * ((mpi_rank + 1) % mpi_size); }));
+  const int tuned = static_cast<int>(sct.tune());
+  CHECK(tuned != static_cast<int>(decltype(sct)::type::automatic));
+  int tuned_max = 0;
+  MPI_Allreduce(&tuned, &tuned_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  CHECK(tuned == tuned_max);
+
+  // Tuning is collective when the choice is cached on some ranks only
+  if (mpi_rank == 0)
+  {
+    std::scoped_lock lock(common::impl::scatterer_type_cache_mutex());
+    common::impl::scatterer_type_cache().clear();
+  }
+  common::Scatterer sct1(idx_map, n);
+  const int tuned1 = static_cast<int>(sct1.tune());
+  int tuned1_max = 0;
+  MPI_Allreduce(&tuned1, &tuned1_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  CHECK(tuned1 == tuned1_max);
+
+  // Persistent requests, re-used for repeated scatters
+  std::vector<MPI_Request> prequests
+      = sct.create_request_vector(decltype(sct)::type::persistent);
+  std::vector<std::int64_t> send_buffer(sct.local_buffer_size());
+  sct.scatter_fwd_init<std::int64_t>(send_buffer, data_ghost, prequests);
+  for (std::int64_t k = 1; k < 3; ++k)
+  {
+    std::ranges::fill(send_buffer, k * val * mpi_rank);
+    std::ranges::fill(data_ghost, 0);
+    sct.scatter_fwd_begin<std::int64_t>(send_buffer, data_ghost, prequests,
+                                        decltype(sct)::type::persistent);
+    sct.scatter_fwd_end(prequests);
+    const std::int64_t owner_val = k * val * ((mpi_rank + 1) % mpi_size);
+    CHECK(std::ranges::all_of(data_ghost,
+                              [=](auto i) { return i == owner_val; }));
+  }
+
+  for (MPI_Request& r : prequests)
+  {
+    if (r != MPI_REQUEST_NULL)
+      MPI_Request_free(&r);
+  }
+
+  // Shared-memory window, with data on the same node read directly
+  auto window = sct.create_shared_window<std::int64_t>();
+  std::span<std::int64_t> wbuffer = window.send_buffer();
+  CHECK((int)wbuffer.size() == sct.local_buffer_size());
+  std::vector<std::int64_t> recv_buffer(sct.remote_buffer_size());
+  std::vector<MPI_Request> wrequests = sct.create_request_vector();
+  for (std::int64_t k = 1; k < 3; ++k)
+  {
+    std::span<const std::int32_t> idx = sct.local_indices();
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      wbuffer[i] = k * data_local[idx[i]];
+    std::ranges::fill(recv_buffer, 0);
+    sct.scatter_fwd_begin<std::int64_t>(window, recv_buffer, wrequests);
+    sct.scatter_fwd_end<std::int64_t>(window, recv_buffer, wrequests);
+    const std::int64_t owner_val = k * val * ((mpi_rank + 1) % mpi_size);
+    CHECK(std::ranges::all_of(recv_buffer,
+                              [=](auto i) { return i == owner_val; }));
+  }
 }
 
 void test_scatter_rev()
@@ -154,10 +226,170 @@ void test_consensus_exchange()
       = dolfinx::MPI::compute_graph_edges_nbx(MPI_COMM_WORLD, src_ranks);
   auto dest_ranks1
       = dolfinx::MPI::compute_graph_edges_pcx(MPI_COMM_WORLD, src_ranks);
+  auto dest_ranks2
+      = dolfinx::MPI::compute_graph_edges_node(MPI_COMM_WORLD, src_ranks);
   std::ranges::sort(dest_ranks0);
   std::ranges::sort(dest_ranks1);
+  std::ranges::sort(dest_ranks2);
 
   CHECK(dest_ranks0 == dest_ranks1);
+  CHECK(dest_ranks0 == dest_ranks2);
+
+  // Send the rank of the caller along each edge through a grid of ranks
+  std::vector<std::byte> data(sizeof(int) * src_ranks.size());
+  for (std::size_t i = 0; i < src_ranks.size(); ++i)
+    std::memcpy(data.data() + i * sizeof(int), &mpi_rank, sizeof(int));
+  auto [dest_ranks3, recv_data]
+      = dolfinx::MPI::alltoallv_grid(MPI_COMM_WORLD, src_ranks, data,
+                                     sizeof(int));
+  std::vector<int> recv_ranks(dest_ranks3.size());
+  std::memcpy(recv_ranks.data(), recv_data.data(), recv_data.size());
+  CHECK(recv_ranks == dest_ranks3);
+  std::ranges::sort(dest_ranks3);
+  CHECK(dest_ranks0 == dest_ranks3);
+}
+
+void test_distribute_data()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const std::int64_t size_local = 50 + mpi_rank;
+  const std::int64_t offset = mpi_rank * 50 + mpi_rank * (mpi_rank - 1) / 2;
+  const std::int64_t size_global
+      = mpi_size * 50 + mpi_size * (mpi_size - 1) / 2;
+
+  // Rows of two columns, with values computed from the global row index
+  std::vector<double> x(2 * size_local);
+  for (std::int64_t i = 0; i < size_local; ++i)
+  {
+    x[2 * i] = offset + i;
+    x[2 * i + 1] = -0.5 * (offset + i);
+  }
+
+  // Request rows from all ranks, in no particular order and with
+  // repeats
+  std::vector<std::int64_t> indices;
+  for (std::int64_t i = 0; i < 3 * size_global; i += 7)
+    indices.push_back((i * (mpi_rank + 3)) % size_global);
+
+  // Direct (neighbourhood) routing and routing through a grid of ranks
+  std::vector<double> x0 = dolfinx::MPI::distribute_data(
+      MPI_COMM_WORLD, indices, MPI_COMM_WORLD, x, 2, false, 0);
+  std::vector<double> x1 = dolfinx::MPI::distribute_data(
+      MPI_COMM_WORLD, indices, MPI_COMM_WORLD, x, 2, false, 1);
+  std::vector<double> x2 = dolfinx::MPI::distribute_data(
+      MPI_COMM_WORLD, indices, MPI_COMM_WORLD, x, 2, true, 1);
+  REQUIRE(x0.size() == 2 * indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+  {
+    CHECK(x0[2 * i] == indices[i]);
+    CHECK(x0[2 * i + 1] == -0.5 * indices[i]);
+  }
+  CHECK(x1 == x0);
+  CHECK(x2 == x0);
+}
+
+void test_local_global()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 100;
+
+  // Ghost every third index of the next process
+  std::vector<std::int64_t> ghosts;
+  if (mpi_size > 1)
+  {
+    const int next = (mpi_rank + 1) % mpi_size;
+    for (int i = 0; i < size_local; i += 3)
+      ghosts.push_back(next * size_local + i);
+  }
+  std::vector<int> owners(ghosts.size(), (mpi_rank + 1) % mpi_size);
+  const common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  const std::int32_t n = size_local + ghosts.size();
+  std::vector<std::int32_t> local(n);
+  std::iota(local.begin(), local.end(), 0);
+  for (int num_threads : {1, 3})
+  {
+    std::vector<std::int64_t> global(n);
+    map.local_to_global(local, global, num_threads);
+    CHECK(global == map.global_indices());
+
+    // Indices that are neither owned nor ghosts are not found
+    global.push_back(-1);
+    global.push_back(map.size_global());
+    std::vector<std::int32_t> local1(global.size());
+    map.global_to_local(global, local1, num_threads);
+    CHECK(std::equal(local.begin(), local.end(), local1.begin()));
+    CHECK(local1[n] == -1);
+    CHECK(local1[n + 1] == -1);
+  }
+}
+
+void test_global_to_local_ghosts()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const std::int64_t size_local = 4096;
+  const std::int64_t offset = mpi_rank * size_local;
+
+  // Ghost every 64th index and every other of the last indices of all
+  // other processes, in reverse order
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  for (int r = mpi_size - 1; r >= 0; --r)
+  {
+    if (r == mpi_rank)
+      continue;
+    for (std::int64_t k = 63; k >= 0; --k)
+    {
+      ghosts.push_back(r * size_local + 64 * k);
+      ghosts.push_back(r * size_local + size_local - 1 - 2 * k);
+      owners.insert(owners.end(), 2, r);
+    }
+  }
+  const common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts, owners);
+  const common::IndexMap map0(MPI_COMM_WORLD, size_local);
+  const common::IndexMap map1(MPI_COMM_WORLD, size_local, {}, {});
+
+  // Owned and ghost indices, followed by indices that are not on this
+  // process
+  std::vector<std::int64_t> global = {offset, offset + size_local - 1};
+  std::vector<std::int32_t> expected = {0, size_local - 1};
+  for (std::size_t i = 0; i < ghosts.size(); ++i)
+  {
+    global.push_back(ghosts[i]);
+    expected.push_back(size_local + i);
+  }
+  for (int r = 0; r < mpi_size; ++r)
+  {
+    if (r == mpi_rank)
+      continue;
+    for (std::int64_t k = 0; k < 64; ++k)
+      global.push_back(r * size_local + 64 * k + 2);
+  }
+  global.push_back(-1);
+  global.push_back(mpi_size * size_local);
+  expected.resize(global.size(), -1);
+
+  for (int num_threads : {1, 3})
+  {
+    std::vector<std::int32_t> local(global.size());
+    map.global_to_local(global, local, num_threads);
+    CHECK(local == expected);
+
+    // Maps without ghosts find the owned indices only
+    for (const common::IndexMap* m : {&map0, &map1})
+    {
+      CHECK(m->num_ghosts() == 0);
+      std::ranges::fill(local, -2);
+      m->global_to_local(global, local, num_threads);
+      CHECK(local[0] == 0);
+      CHECK(local[1] == size_local - 1);
+      CHECK(std::ranges::all_of(std::next(local.begin(), 2), local.end(),
+                                [](auto i) { return i == -1; }));
+    }
+  }
 }
 } // namespace
 
@@ -177,3 +409,19 @@ TEST_CASE("Communication graph edges via consensus exchange",
 {
   CHECK_NOTHROW(test_consensus_exchange());
 }
+
+TEST_CASE("Distribute data with direct and grid routing",
+          "[distribute_data]")
+{
+  CHECK_NOTHROW(test_distribute_data());
+}
+
+TEST_CASE("Local-to-global and global-to-local maps", "[index_map]")
+{
+  CHECK_NOTHROW(test_local_global());
+}
+
+TEST_CASE("Global-to-local map of ghosts", "[index_map]")
+{
+  CHECK_NOTHROW(test_global_to_local_ghosts());
+}
@@ -0,0 +1,45 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/log.h>
+#include <memory>
+#include <spdlog/async.h>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Parallel logging", "[log]")
+{
+  const spdlog::level::level_enum level0 = spdlog::get_level();
+  const int size = dolfinx::MPI::size(MPI_COMM_WORLD);
+
+  // No process logs, and changing the level does not enable logging
+  set_log_level(spdlog::level::info);
+  init_parallel_logging(MPI_COMM_WORLD, std::vector<int>{size});
+  CHECK(spdlog::get_level() == spdlog::level::off);
+  set_log_level(spdlog::level::debug);
+  CHECK(spdlog::get_level() == spdlog::level::off);
+  CHECK(!spdlog::default_logger()->should_log(spdlog::level::err));
+
+  // Logging again restores the requested level, and the thread pool
+  // of asynchronous logging is created once
+  init_parallel_logging(MPI_COMM_WORLD, {}, true, 16);
+  CHECK(spdlog::get_level() == spdlog::level::debug);
+  std::shared_ptr<spdlog::details::thread_pool> pool = spdlog::thread_pool();
+  REQUIRE(pool);
+  spdlog::debug("Asynchronous message");
+  init_parallel_logging(MPI_COMM_WORLD, {}, true, 32);
+  CHECK(spdlog::thread_pool() == pool);
+  set_log_level(spdlog::level::warn);
+  CHECK(spdlog::get_level() == spdlog::level::warn);
+  spdlog::default_logger()->flush();
+
+  init_parallel_logging(MPI_COMM_WORLD);
+  set_log_level(level0);
+}
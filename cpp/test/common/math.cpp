@@ -0,0 +1,73 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <array>
+#include <basix/mdspan.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <dolfinx/common/math.h>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+using mdspan2_t = md::mdspan<double, md::dextents<std::size_t, 2>>;
+using mdspan3_t = md::mdspan<double, md::dextents<std::size_t, 3>>;
+
+// Check the batched functions against the functions for a single
+// matrix, for a batch of num matrices of shape (m, n)
+void check_batch(std::size_t m, std::size_t n, std::size_t num)
+{
+  std::vector<double> A_b(m * n * num), B_b(m * n * num);
+  mdspan3_t A(A_b.data(), m, n, num);
+  mdspan3_t B(B_b.data(), n, m, num);
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      for (std::size_t w = 0; w < num; ++w)
+        A(i, j, w) = std::sin(1.0 + i + 3.0 * j + 0.7 * w * w) + (i == j);
+
+  std::vector<double> detA(num);
+  if (m == n)
+  {
+    math::det_batch(A, detA);
+    math::inv_batch(A, B);
+  }
+  else
+    math::pinv_batch(A, B);
+
+  std::array<double, 9> Aw_b, Bw_b;
+  for (std::size_t w = 0; w < num; ++w)
+  {
+    mdspan2_t Aw(Aw_b.data(), m, n), Bw(Bw_b.data(), n, m);
+    for (std::size_t i = 0; i < m; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+        Aw(i, j) = A(i, j, w);
+    if (m == n)
+    {
+      CHECK(detA[w] == Catch::Approx(math::det(Aw)));
+      math::inv(Aw, Bw);
+    }
+    else
+      math::pinv(Aw, Bw);
+
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = 0; j < m; ++j)
+        CHECK(B(i, j, w) == Catch::Approx(Bw(i, j)).margin(1e-12));
+  }
+}
+} // namespace
+
+TEST_CASE("Batched small matrix functions", "[math]")
+{
+  for (auto [m, n] : std::array<std::array<std::size_t, 2>, 6>{
+           {{1, 1}, {2, 2}, {3, 3}, {3, 2}, {3, 1}, {2, 1}}})
+  {
+    check_batch(m, n, 13);
+  }
+}
@@ -92,6 +92,38 @@ TEMPLATE_TEST_CASE("Test radix sort (projection)", "[radix]", std::int16_t,
   }
 }
 
+TEMPLATE_TEST_CASE("Test parallel radix sort", "[radix]", std::int16_t,
+                   std::int32_t, std::int64_t, std::uint32_t, std::uint64_t)
+{
+  auto vec_size = GENERATE(1000, 100000);
+  auto num_threads = GENERATE(1, 4);
+  std::vector<TestType> vec;
+  vec.reserve(vec_size);
+
+  std::uniform_int_distribution<TestType> distribution(
+      std::is_signed_v<TestType> ? -10000 : 0, 10000);
+  std::mt19937 engine;
+  auto generator = std::bind(distribution, engine);
+  std::generate_n(std::back_inserter(vec), vec_size, generator);
+
+  // Stable sort of indices by value
+  std::vector<std::int32_t> perm0(vec.size()), perm1(vec.size());
+  std::iota(perm0.begin(), perm0.end(), 0);
+  std::iota(perm1.begin(), perm1.end(), 0);
+  auto proj = [&vec](auto index) { return vec[index]; };
+  dolfinx::radix_sort(perm0, proj);
+  dolfinx::parallel_radix_sort(perm1, num_threads, proj);
+  CHECK(perm0 == perm1);
+
+  // Sort and remove duplicates
+  std::vector<TestType> unique0 = vec;
+  std::ranges::sort(unique0);
+  auto [unique_end, range_end] = std::ranges::unique(unique0);
+  unique0.erase(unique_end, range_end);
+  dolfinx::sort_unique(vec, num_threads);
+  CHECK(vec == unique0);
+}
+
 TEST_CASE("Test argsort bitset")
 {
   auto shape0 = GENERATE(100, 1000, 10000);
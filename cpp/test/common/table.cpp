@@ -0,0 +1,99 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Table.h>
+#include <limits>
+#include <string>
+#include <variant>
+
+using namespace dolfinx;
+
+TEST_CASE("Table JSON output", "[table]")
+{
+  CHECK(Table("Empty").json() == R"({"name": "Empty", "rows": {}})");
+
+  // Entries are sorted, independently of the order they are set in
+  Table t0("Timings \"x\"");
+  t0.set("b", "count", 2);
+  t0.set("b", "time", 0.25);
+  t0.set("a", "time", 1.0 / 3.0);
+  t0.set("a", "unit", std::string("s"));
+  t0.set("c", "time", std::numeric_limits<double>::infinity());
+
+  Table t1("Timings \"x\"");
+  t1.set("c", "time", std::numeric_limits<double>::infinity());
+  t1.set("a", "unit", std::string("s"));
+  t1.set("a", "time", 1.0 / 3.0);
+  t1.set("b", "time", 0.25);
+  t1.set("b", "count", 2);
+
+  const std::string json
+      = R"({"name": "Timings \"x\"", "rows": {)"
+        R"("a": {"time": 0.3333333333333333, "unit": "s"}, )"
+        R"("b": {"count": 2, "time": 0.25}, "c": {"time": null}}})";
+  CHECK(t0.json() == json);
+  CHECK(t1.json() == json);
+}
+
+TEST_CASE("Table statistics reduction", "[table]")
+{
+  const int size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Entries on all ranks, on the even ranks and on one rank only
+  Table t("T");
+  t.set("all", "time", double(rank + 1));
+  t.set("all", "reps", 3);
+  t.set("same", "time", 1.0);
+  if (rank % 2 == 0)
+    t.set("even", "time", 10.0 * rank);
+  t.set("rank " + std::to_string(rank), "time", double(rank));
+
+  Table s = t.reduce_statistics(MPI_COMM_WORLD);
+  CHECK(t.reduce(MPI_COMM_WORLD, Table::Reduction::statistics).json()
+        == s.json());
+  if (rank > 0)
+  {
+    CHECK(s.json() == R"({"name": "[MPI_STATS] T", "rows": {}})");
+    return;
+  }
+
+  // Nearest rank percentile of the values 1, ..., size
+  auto nearest
+      = [](double q, int n) { return std::max(std::ceil(q * n), 1.0); };
+  CHECK(std::get<double>(s.get("all", "time p50")) == nearest(0.5, size));
+  CHECK(std::get<double>(s.get("all", "time p95")) == nearest(0.95, size));
+  CHECK(std::get<double>(s.get("all", "time max")) == size);
+  CHECK(std::get<int>(s.get("all", "time max rank")) == size - 1);
+  CHECK(std::get<int>(s.get("all", "reps")) == 3);
+
+  // Ties give the lowest rank
+  CHECK(std::get<double>(s.get("same", "time max")) == 1.0);
+  CHECK(std::get<int>(s.get("same", "time max rank")) == 0);
+
+  // Ranks without the entry are not counted. The values are 20 * i for
+  // i = 0, ..., m - 1.
+  const int m = (size + 1) / 2;
+  CHECK(std::get<double>(s.get("even", "time p50"))
+        == 20 * (nearest(0.5, m) - 1));
+  CHECK(std::get<double>(s.get("even", "time p95"))
+        == 20 * (nearest(0.95, m) - 1));
+  CHECK(std::get<double>(s.get("even", "time max")) == 20 * (m - 1));
+  CHECK(std::get<int>(s.get("even", "time max rank")) == 2 * (m - 1));
+
+  for (int r = 0; r < size; ++r)
+  {
+    const std::string row = "rank " + std::to_string(r);
+    CHECK(std::get<double>(s.get(row, "time p50")) == r);
+    CHECK(std::get<double>(s.get(row, "time p95")) == r);
+    CHECK(std::get<double>(s.get(row, "time max")) == r);
+    CHECK(std::get<int>(s.get(row, "time max rank")) == r);
+  }
+}
@@ -0,0 +1,70 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/Trace.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Trace nested regions", "[trace]")
+{
+  const std::uint32_t outer = common::trace::region("outer");
+  const std::uint32_t inner = common::trace::region("inner");
+  CHECK(common::trace::region("outer") == outer);
+  CHECK(common::trace::region_name(inner) == "inner");
+
+  common::trace::start(4);
+  {
+    common::TraceRegion r0(outer);
+    for (int i = 0; i < 5; ++i)
+      common::TraceRegion r1(inner);
+    common::Timer timer("Traced timer");
+  }
+  std::thread([inner] { common::TraceRegion r(inner); }).join();
+  common::trace::stop();
+  {
+    // Not recorded
+    common::TraceRegion r(outer);
+  }
+
+  std::vector events = common::trace::events();
+  auto e0 = std::ranges::find_if(events, [](auto& e)
+                                 { return e.events.size() == 4; });
+  REQUIRE(e0 != events.end());
+  CHECK(e0->dropped == 3);
+  CHECK(e0->events[0].region == inner);
+  CHECK(e0->events[0].depth == 1);
+  CHECK(common::trace::region_name(e0->events[2].region) == "Traced timer");
+  CHECK(e0->events[3].region == outer);
+  CHECK(e0->events[3].depth == 0);
+  CHECK(e0->events[3].start <= e0->events[0].start);
+  CHECK(e0->events[3].end >= e0->events[2].end);
+  CHECK(std::ranges::count_if(events, [](auto& e)
+                              { return e.events.size() == 1; })
+        == 1);
+
+  std::filesystem::path filename
+      = std::filesystem::temp_directory_path() / "dolfinx_trace.json";
+  common::trace::write_chrome(MPI_COMM_WORLD, filename);
+  if (dolfinx::MPI::rank(MPI_COMM_WORLD) == 0)
+  {
+    std::ifstream file(filename);
+    std::string json(std::istreambuf_iterator<char>(file), {});
+    CHECK(json.starts_with("{\"displayTimeUnit\""));
+    CHECK(json.find("\"name\":\"outer\",\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"Traced timer\"") != std::string::npos);
+  }
+}
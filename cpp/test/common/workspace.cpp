@@ -0,0 +1,57 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/Workspace.h>
+#include <span>
+#include <thread>
+
+using namespace dolfinx;
+
+TEST_CASE("Workspace scopes", "[workspace]")
+{
+  common::Workspace ws;
+  double* p0 = nullptr;
+  {
+    common::Workspace::Scope s0(ws);
+    std::span<double> a = ws.allocate<double>(10);
+    p0 = a.data();
+    {
+      common::Workspace::Scope s1(ws);
+      std::span<std::int32_t> b = ws.allocate<std::int32_t>(3);
+      CHECK(reinterpret_cast<std::byte*>(b.data())
+            >= reinterpret_cast<std::byte*>(a.data() + a.size()));
+
+      // Larger than a block
+      std::span<double> c = ws.allocate<double>(1 << 20);
+      c.back() = 1.0;
+    }
+
+    // Released arrays are re-used
+    std::span<std::int32_t> d = ws.allocate<std::int32_t>(3);
+    CHECK(reinterpret_cast<std::byte*>(d.data())
+          >= reinterpret_cast<std::byte*>(a.data() + a.size()));
+  }
+
+  // All arrays released: blocks are merged, and not re-allocated
+  const std::size_t capacity = ws.capacity();
+  for (int i = 0; i < 3; ++i)
+  {
+    common::Workspace::Scope s(ws);
+    ws.allocate<double>(1 << 20);
+    ws.allocate<float>(100);
+  }
+  CHECK(ws.capacity() == capacity);
+  CHECK(p0 != nullptr);
+
+  // Each thread has its own workspace
+  common::Workspace* w0 = &common::Workspace::local();
+  common::Workspace* w1 = nullptr;
+  std::thread([&w1] { w1 = &common::Workspace::local(); }).join();
+  CHECK(w0 != w1);
+  CHECK(w0 == &common::Workspace::local());
+}
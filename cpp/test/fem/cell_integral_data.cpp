@@ -0,0 +1,108 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/CellIntegralData.h>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/DirichletBC.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Assembly from cell integral data", "[fem][cell_integral_data]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 5},
+      mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto f = std::make_shared<fem::Function<double>>(V);
+  std::span<double> fx = f->x()->mutable_array();
+  for (std::size_t i = 0; i < fx.size(); ++i)
+    fx[i] = std::sin(0.1 * i);
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto L = fem::create_form<double, double>(*form_poisson_L, {V}, {{"f", f}},
+                                            {}, {}, {});
+  auto a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+
+  SECTION("vector")
+  {
+    const int id = L.integral_ids(fem::IntegralType::cell).front();
+    auto coeffs = fem::allocate_coefficient_storage(L);
+    fem::pack_coefficients(L, coeffs);
+    auto& [c, cstride] = coeffs.at({fem::IntegralType::cell, id});
+    auto data = fem::create_cell_integral_data<double, double>(
+        L, id, 0, std::span<const double>(c), cstride);
+    CHECK(data.num_cells() == L.domain(fem::IntegralType::cell, id, 0).size());
+
+    std::vector<double> b0(fx.size(), 0), b1(fx.size(), 0), b2(fx.size(), 0);
+    fem::assemble_vector(std::span(b0), L);
+    auto kernel = L.kernel(fem::IntegralType::cell, id, 0);
+    fem::assemble_vector(std::span(b1), data, kernel, {});
+    fem::assemble_vector(std::span(b2), data, kernel, {}, 3);
+    for (std::size_t i = 0; i < b0.size(); ++i)
+    {
+      CHECK(std::abs(b1[i] - b0[i]) < 1e-12);
+      CHECK(std::abs(b2[i] - b0[i]) < 1e-12);
+    }
+  }
+
+  SECTION("matrix")
+  {
+    const int id = a.integral_ids(fem::IntegralType::cell).front();
+    const int tdim = mesh->topology()->dim();
+    std::vector facets = mesh::locate_entities_boundary(
+        *mesh, tdim - 1,
+        [](auto x)
+        {
+          std::vector<std::int8_t> marker(x.extent(1), false);
+          for (std::size_t p = 0; p < x.extent(1); ++p)
+            marker[p] = std::abs(x(0, p)) < 1e-8;
+          return marker;
+        });
+    std::vector bdofs = fem::locate_dofs_topological(
+        *mesh->topology_mutable(), *V->dofmap(), tdim - 1, facets);
+    fem::DirichletBC<double> bc(0.0, bdofs, V);
+    std::vector<std::int8_t> markers(fx.size(), false);
+    bc.mark_dofs(markers);
+
+    la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+    sp.finalize();
+    la::MatrixCSR<double> A0(sp), A1(sp);
+    fem::assemble_matrix(A0.mat_add_values(), a, {bc});
+
+    auto data
+        = fem::create_cell_integral_data<double, double>(a, id, 0, {}, 0);
+    fem::compute_csr_offsets(data, A1, markers, markers);
+    std::vector<double> constants = fem::pack_constants(a);
+    fem::assemble_matrix(std::span(A1.values()), data,
+                         a.kernel(fem::IntegralType::cell, id, 0),
+                         std::span<const double>(constants), 2);
+    for (std::size_t i = 0; i < A0.values().size(); ++i)
+      CHECK(std::abs(A1.values()[i] - A0.values()[i]) < 1e-12);
+  }
+}
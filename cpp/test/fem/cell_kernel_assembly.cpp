@@ -0,0 +1,174 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/pack.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/mesh/generation.h>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Create a Lagrange space on a tetrahedral mesh, with block size 3 if
+// `vector` is true
+std::shared_ptr<fem::FunctionSpace<double>>
+create_space(std::shared_ptr<mesh::Mesh<double>> mesh, int degree,
+             bool vector)
+{
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, degree,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  std::optional<std::vector<std::size_t>> shape;
+  if (vector)
+    shape = std::vector<std::size_t>{3};
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element, shape)));
+}
+
+// Assemble the cell integral of `a` with assemble_matrix_cells, with
+// one and several threads, and compare with assemble_matrix
+template <int BS>
+void check_matrix_cells(const fem::Form<double, double>& a)
+{
+  auto V = a.function_spaces().at(0);
+  REQUIRE(V->dofmap()->bs() == BS);
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp);
+  fem::assemble_matrix(A0.template mat_add_values<BS, BS>(), a, {});
+  A0.scatter_rev();
+
+  const int id = a.integral_ids(fem::IntegralType::cell).front();
+  std::span<const std::int32_t> cells
+      = a.domain(fem::IntegralType::cell, id, 0);
+  auto kernel = a.kernel(fem::IntegralType::cell, id, 0);
+  const std::vector<double> constants = fem::pack_constants(a);
+  for (int num_threads : {1, 3})
+  {
+    la::MatrixCSR<double> A1(sp);
+    fem::assemble_matrix_cells<double>(A1.template mat_add_values<BS, BS>(),
+                                       *V, *V, cells, kernel,
+                                       std::span(constants), {}, 0, {}, {},
+                                       num_threads);
+    A1.scatter_rev();
+    REQUIRE(A1.values().size() == A0.values().size());
+    for (std::size_t i = 0; i < A0.values().size(); ++i)
+      CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+  }
+}
+
+// Assemble `kernel` over `cells` with assemble_vector_cells, with one
+// and several threads, and compare with assemble_vector of L
+void check_vector_cells(const fem::Form<double, double>& L,
+                        std::span<const std::int32_t> cells,
+                        fem::FEkernel<double> auto kernel,
+                        std::span<const double> coeffs, int cstride)
+{
+  auto V = L.function_spaces().at(0);
+  const std::size_t size
+      = V->dofmap()->index_map->size_local()
+        + V->dofmap()->index_map->num_ghosts();
+  std::vector<double> b0(size * V->dofmap()->index_map_bs(), 0);
+  fem::assemble_vector(std::span(b0), L);
+  for (int num_threads : {1, 3})
+  {
+    std::vector<double> b1(b0.size(), 0);
+    fem::assemble_vector_cells<double>(std::span(b1), *V, cells, kernel, {},
+                                       coeffs, cstride, num_threads);
+    for (std::size_t i = 0; i < b0.size(); ++i)
+      CHECK(b1[i] == Catch::Approx(b0[i]).margin(1e-12));
+  }
+}
+} // namespace
+
+TEST_CASE("Assembly of cell kernels", "[fem][assembly]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 5},
+                       mesh::CellType::tetrahedron));
+
+  SECTION("vector")
+  {
+    // Form kernel with a coefficient
+    auto V = create_space(mesh, 2, false);
+    auto f = std::make_shared<fem::Function<double>>(V);
+    std::span<double> fx = f->x()->mutable_array();
+    for (std::size_t i = 0; i < fx.size(); ++i)
+      fx[i] = std::sin(0.1 * i);
+    auto L = fem::create_form<double, double>(*form_poisson_L, {V},
+                                              {{"f", f}}, {}, {}, {});
+    const int id = L.integral_ids(fem::IntegralType::cell).front();
+    auto coeffs = fem::allocate_coefficient_storage(L);
+    fem::pack_coefficients(L, coeffs);
+    auto& [c, cstride] = coeffs.at({fem::IntegralType::cell, id});
+    check_vector_cells(L, L.domain(fem::IntegralType::cell, id, 0),
+                       L.kernel(fem::IntegralType::cell, id, 0),
+                       std::span<const double>(c), cstride);
+
+    // Hand-written kernel on a space with block size 3, which
+    // integrates (1, 2, 3) against the linear basis functions
+    auto V3 = create_space(mesh, 1, true);
+    auto kernel = [](double* b, const double*, const double*, const double* x,
+                     const int*, const std::uint8_t*, void*)
+    {
+      double J[3][3];
+      for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+          J[i][j] = x[3 * (j + 1) + i] - x[i];
+      const double det
+          = J[0][0] * (J[1][1] * J[2][2] - J[1][2] * J[2][1])
+            - J[0][1] * (J[1][0] * J[2][2] - J[1][2] * J[2][0])
+            + J[0][2] * (J[1][0] * J[2][1] - J[1][1] * J[2][0]);
+      for (int i = 0; i < 4; ++i)
+        for (int k = 0; k < 3; ++k)
+          b[3 * i + k] += (k + 1) * std::abs(det) / 24.0;
+    };
+    std::vector<std::int32_t> cells(
+        mesh->topology()->index_map(3)->size_local());
+    std::iota(cells.begin(), cells.end(), 0);
+    std::map integrals{std::pair{
+        std::tuple{fem::IntegralType::cell, -1, 0},
+        fem::integral_data<double>(kernel, cells, std::vector<int>{})}};
+    fem::Form<double> L3({V3}, integrals, mesh, {}, {}, false, {});
+    check_vector_cells(L3, cells, kernel, {}, 0);
+  }
+
+  SECTION("matrix")
+  {
+    auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+    auto V = create_space(mesh, 2, false);
+    auto a = fem::create_form<double, double>(
+        *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+    check_matrix_cells<1>(a);
+
+    auto V3 = create_space(mesh, 1, true);
+    auto a3 = fem::create_form<double, double>(*form_poisson_a_vec, {V3, V3},
+                                               {}, {}, {}, {});
+    check_matrix_cells<3>(a3);
+  }
+}
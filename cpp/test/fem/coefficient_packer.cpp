@@ -0,0 +1,114 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/pack.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Coefficient packer", "[fem][pack]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 5},
+      mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto f = std::make_shared<fem::Function<double>>(V);
+  auto L = fem::create_form<double, double>(*form_poisson_L, {V}, {{"f", f}},
+                                            {}, {}, {});
+
+  auto set = [&f](double a)
+  {
+    std::span<double> x = f->x()->mutable_array();
+    for (std::size_t i = 0; i < x.size(); ++i)
+      x[i] = std::sin(a * i);
+  };
+  auto packed = [&L]()
+  {
+    auto coeffs = fem::allocate_coefficient_storage(L);
+    fem::pack_coefficients(L, coeffs);
+    return coeffs;
+  };
+
+  set(0.1);
+  fem::CoefficientPacker<double, double> packer(L, 3);
+  CHECK(packer.pack() == packed());
+
+  // Changes through mutable_array are detected
+  set(0.2);
+  CHECK(packer.pack() == packed());
+
+  // Repacking is skipped if the state of the vector is unchanged, so
+  // changes through an earlier span are not seen until a reset
+  auto coeffs0 = packer.pack();
+  const std::uint64_t state = f->x()->state();
+  std::span<double> x = f->x()->mutable_array();
+  CHECK(f->x()->state() != state);
+  packer.pack();
+  x[0] += 1;
+  CHECK(packer.pack() == coeffs0);
+  packer.reset();
+  CHECK(packer.pack() == packed());
+}
+
+TEST_CASE("Packed constants", "[fem][pack]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {2, 2, 2},
+      mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                            {{"kappa", kappa}}, {}, {});
+
+  std::span<const double> c = a.packed_constants();
+  CHECK(std::vector(c.begin(), c.end()) == fem::pack_constants(a));
+  const std::uint64_t state = a.packed_constants_state();
+
+  // Unchanged constants are not repacked
+  CHECK(a.packed_constants().data() == c.data());
+  CHECK(a.packed_constants_state() == state);
+
+  // Changed constants are updated in place
+  kappa->value[0] = 3.0;
+  CHECK(a.packed_constants().data() == c.data());
+  CHECK(c[0] == 3.0);
+  CHECK(a.packed_constants_state() != state);
+
+  // Mirrors are only updated when the constants change
+  std::vector<double> mirror;
+  std::uint64_t mirror_state = 0;
+  CHECK(fem::mirror_constants(a, mirror, mirror_state));
+  CHECK(mirror == std::vector<double>{3.0});
+  CHECK(!fem::mirror_constants(a, mirror, mirror_state));
+  kappa->value[0] = 4.0;
+  CHECK(fem::mirror_constants(a, mirror, mirror_state));
+  CHECK(mirror == std::vector<double>{4.0});
+}
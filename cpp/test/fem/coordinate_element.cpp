@@ -0,0 +1,98 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <array>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Pull back of points in curved cells", "[fem][coordinate_element]")
+{
+  using mdspan2_t = md::mdspan<double, md::dextents<std::size_t, 2>>;
+  using cmdspan2_t = md::mdspan<const double, md::dextents<std::size_t, 2>>;
+  using cmdspan3_t = md::mdspan<const double, md::dextents<std::size_t, 3>>;
+
+  fem::CoordinateElement<double> cmap(mesh::CellType::triangle, 2);
+  CHECK(!cmap.is_affine());
+  constexpr std::size_t num_nodes = 6;
+  constexpr std::size_t gdim = 2;
+
+  // Quadratic triangles with vertices (0, 0), (1, 0) and (0, 1), whose
+  // edge midpoints are moved by increasing amounts. The cell is
+  // straight-sided for amount 0, and the Newton iterations of the points
+  // take from 2 to 8 iterations, so points leave the active set of the
+  // lockstep iteration at different iterations.
+  const std::vector<double> amounts = {0.0, 0.03, 0.06, 0.1};
+  const std::vector<std::array<double, gdim>> X_ref
+      = {{0.1, 0.1}, {0.6, 0.2}, {0.2, 0.7}, {0.33, 0.33}, {0.0, 0.95}};
+  const std::size_t num_points = amounts.size() * X_ref.size();
+  std::vector<double> geometry, x, X_exact;
+  for (double a : amounts)
+  {
+    // Vertices, then the midpoints of the edges (1, 2), (0, 2) and
+    // (0, 1)
+    const std::vector<double> cell = {0.0,     0.0,     1.0, 0.0,     0.0, 1.0,
+                                      0.5 + a, 0.5 + a, -a,  0.5 - a, 0.5, -a};
+
+    // Push forward the reference points
+    std::vector<double> X;
+    for (const std::array<double, gdim>& p : X_ref)
+      X.insert(X.end(), p.begin(), p.end());
+    const std::array<std::size_t, 4> shape
+        = cmap.tabulate_shape(0, X_ref.size());
+    std::vector<double> phi(shape[0] * shape[1] * shape[2] * shape[3]);
+    cmap.tabulate(0, X, {X_ref.size(), gdim}, phi);
+    for (std::size_t p = 0; p < X_ref.size(); ++p)
+    {
+      std::array<double, gdim> xp = {0, 0};
+      for (std::size_t i = 0; i < num_nodes; ++i)
+        for (std::size_t j = 0; j < gdim; ++j)
+          xp[j] += phi[p * num_nodes + i] * cell[i * gdim + j];
+      x.insert(x.end(), xp.begin(), xp.end());
+      geometry.insert(geometry.end(), cell.begin(), cell.end());
+    }
+    X_exact.insert(X_exact.end(), X.begin(), X.end());
+  }
+
+  // Pull back all points together, and one point at a time
+  std::vector<double> X0(num_points * gdim), X1(num_points * gdim);
+  cmap.pull_back_nonaffine(mdspan2_t(X0.data(), num_points, gdim),
+                           cmdspan2_t(x.data(), num_points, gdim),
+                           cmdspan3_t(geometry.data(), num_points, num_nodes,
+                                      gdim),
+                           1e-12);
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    cmap.pull_back_nonaffine(
+        mdspan2_t(X1.data() + p * gdim, 1, gdim),
+        cmdspan2_t(x.data() + p * gdim, 1, gdim),
+        cmdspan2_t(geometry.data() + p * num_nodes * gdim, num_nodes, gdim),
+        1e-12);
+  }
+  for (std::size_t i = 0; i < X0.size(); ++i)
+  {
+    CHECK(X0[i] == Catch::Approx(X1[i]).margin(1e-12));
+    CHECK(X0[i] == Catch::Approx(X_exact[i]).margin(1e-10));
+  }
+
+  // Initial guesses close to the solution
+  std::vector<double> X2 = X_exact;
+  for (double& X : X2)
+    X += 0.01;
+  cmap.pull_back_nonaffine(mdspan2_t(X2.data(), num_points, gdim),
+                           cmdspan2_t(x.data(), num_points, gdim),
+                           cmdspan3_t(geometry.data(), num_points, num_nodes,
+                                      gdim),
+                           1e-12, 15, true);
+  for (std::size_t i = 0; i < X2.size(); ++i)
+    CHECK(X2[i] == Catch::Approx(X_exact[i]).margin(1e-10));
+}
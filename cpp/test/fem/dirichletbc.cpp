@@ -0,0 +1,185 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/DirichletBC.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Locate DOFs topologically", "[fem][dirichletbc]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {9, 7},
+                             mesh::CellType::triangle));
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::triangle, 2,
+          basix::element::lagrange_variant::unset,
+          basix::element::dpc_variant::unset, false),
+      std::vector<std::size_t>{2});
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(mesh, element));
+  fem::FunctionSpace<double> V1 = V->sub({1});
+  auto [V1c, map] = V1.collapse();
+
+  auto topology = mesh->topology_mutable();
+  topology->create_connectivity(1, 2);
+  topology->create_connectivity(2, 1);
+  std::vector facets = mesh::locate_entities_boundary(
+      *mesh, 1,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marker(x.extent(1), false);
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          marker[p] = std::abs(x(0, p)) < 1e-8 or std::abs(x(1, p)) < 1e-8;
+        return marker;
+      });
+
+  // DOFs of the facet closures, found cell by cell
+  std::vector<std::int32_t> dofs_ref;
+  {
+    const fem::DofMap& dofmap = *V->dofmap();
+    auto f_to_c = topology->connectivity(1, 2);
+    auto c_to_f = topology->connectivity(2, 1);
+    for (std::int32_t f : facets)
+    {
+      std::int32_t c = f_to_c->links(f).front();
+      auto cell_facets = c_to_f->links(c);
+      int i = std::distance(cell_facets.begin(),
+                            std::ranges::find(cell_facets, f));
+      for (int d : dofmap.element_dof_layout().entity_closure_dofs(1, i))
+        dofs_ref.push_back(dofmap.cell_dofs(c)[d]);
+    }
+    std::ranges::sort(dofs_ref);
+    auto [unique_end, range_end] = std::ranges::unique(dofs_ref);
+    dofs_ref.erase(unique_end, range_end);
+  }
+
+  for (bool remote : {false, true})
+  {
+    std::vector dofs = fem::locate_dofs_topological(*topology, *V->dofmap(),
+                                                    1, facets, remote);
+    if (!remote)
+      CHECK(dofs == dofs_ref);
+    else
+      CHECK(std::ranges::includes(dofs, dofs_ref));
+
+    std::array dofs1 = fem::locate_dofs_topological(
+        *topology, {*V1.dofmap(), *V1c.dofmap()}, 1, facets, remote);
+    CHECK(std::ranges::is_sorted(dofs1[0]));
+    for (int num_threads : {2, 3})
+    {
+      CHECK(fem::locate_dofs_topological(*topology, *V->dofmap(), 1, facets,
+                                         remote, num_threads)
+            == dofs);
+      CHECK(fem::locate_dofs_topological(
+                *topology, {*V1.dofmap(), *V1c.dofmap()}, 1, facets, remote,
+                num_threads)
+            == dofs1);
+    }
+  }
+
+  // Cached DOFs
+  std::vector<int> values(facets.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = i % 2;
+  auto tags = std::make_shared<mesh::MeshTags<int>>(topology, 1, facets,
+                                                    values);
+  fem::TopologicalDofLocator<int> locator(2);
+  for (int value : {0, 1})
+  {
+    const std::vector<std::int32_t>& dofs = locator(V->dofmap(), tags, value);
+    CHECK(dofs
+          == fem::locate_dofs_topological(*topology, *V->dofmap(), 1,
+                                          tags->find(value)));
+    CHECK(&locator(V->dofmap(), tags, value) == &dofs);
+  }
+  CHECK(locator.size() == 2);
+  locator.clear();
+  CHECK(locator.size() == 0);
+}
+
+TEST_CASE("Set DirichletBC values", "[fem][dirichletbc]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {6, 5},
+                             mesh::CellType::triangle));
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::triangle, 2,
+          basix::element::lagrange_variant::unset,
+          basix::element::dpc_variant::unset, false),
+      std::vector<std::size_t>{2});
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(mesh, element));
+
+  mesh->topology_mutable()->create_connectivity(1, 2);
+  std::vector facets = mesh::locate_entities_boundary(
+      *mesh, 1,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marker(x.extent(1), false);
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          marker[p] = x(0, p) < 0.6 and std::abs(x(1, p)) < 1e-8;
+        return marker;
+      });
+  std::vector dofs = fem::locate_dofs_topological(*mesh->topology(),
+                                                  *V->dofmap(), 1, facets);
+
+  auto g = std::make_shared<fem::Function<double>>(V);
+  std::span<double> gx = g->x()->mutable_array();
+  for (std::size_t i = 0; i < gx.size(); ++i)
+    gx[i] = i + 1;
+  std::vector<double> x0(gx.size());
+  for (std::size_t i = 0; i < x0.size(); ++i)
+    x0[i] = 0.5 * i;
+
+  fem::DirichletBC<double> bc_f(g, dofs);
+  fem::DirichletBC<double> bc_c(std::vector<double>{2.0, 3.0}, dofs, V);
+  std::span<const std::int32_t> bc_dofs = bc_f.dof_indices().first;
+  for (double alpha : {0.0, 1.0, -2.0})
+  {
+    for (bool use_x0 : {false, true})
+    {
+      // Set a truncated array to check that dofs outside of x are
+      // skipped
+      std::vector<double> x(gx.size() - 1, -1.0), y(x);
+      std::optional<std::span<const double>> _x0;
+      if (use_x0)
+        _x0 = x0;
+      bc_f.set(x, _x0, alpha);
+      bc_c.set(y, _x0, alpha);
+
+      std::vector<double> x_ref(x.size(), -1.0), y_ref(x_ref);
+      for (std::int32_t d : bc_dofs)
+      {
+        if (d < (std::int32_t)x.size())
+        {
+          double u0 = use_x0 ? x0[d] : 0.0;
+          x_ref[d] = alpha * (gx[d] - u0);
+          y_ref[d] = alpha * ((d % 2 == 0 ? 2.0 : 3.0) - u0);
+        }
+      }
+      CHECK(x == x_ref);
+      CHECK(y == y_ref);
+    }
+  }
+}
@@ -0,0 +1,116 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/DofTransformation.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Precomputed DOF transformations", "[fem][dof_transformation]")
+{
+  fem::FiniteElement<double> element(
+      basix::create_element<double>(
+          basix::element::family::N1E, basix::cell::type::tetrahedron, 3,
+          basix::element::lagrange_variant::legendre,
+          basix::element::dpc_variant::legendre, false));
+  REQUIRE(element.needs_dof_transformations());
+  const int dim = element.space_dimension();
+
+  // Random cell permutation information, with repeated values
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<std::uint32_t> info_dist(0, (1 << 18) - 1);
+  std::vector<std::uint32_t> cell_info(40);
+  std::ranges::generate(cell_info, [&]() { return info_dist(gen); });
+  std::copy_n(cell_info.begin(), 10, std::next(cell_info.begin(), 20));
+
+  std::uniform_real_distribution<double> dist(-1, 1);
+  for (fem::doftransform ttype :
+       {fem::doftransform::standard, fem::doftransform::transpose})
+  {
+    for (bool right : {false, true})
+    {
+      fem::DofTransformation<double> P(element, ttype, right, cell_info);
+      auto fn = right ? element.dof_transformation_right_fn<double>(ttype)
+                      : element.dof_transformation_fn<double>(ttype);
+      for (std::int32_t c = 0; c < (std::int32_t)cell_info.size(); ++c)
+      {
+        for (int n : {1, 3})
+        {
+          // Data for the left transformation can have more rows than
+          // DOFs
+          std::vector<double> u0(n * (right ? dim : dim + 2));
+          std::ranges::generate(u0, [&]() { return dist(gen); });
+          std::vector<double> u1 = u0;
+          fn(u0, cell_info, c, n);
+          P(u1, cell_info, c, n);
+          for (std::size_t i = 0; i < u0.size(); ++i)
+            CHECK(std::abs(u1[i] - u0[i]) < 1e-12);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Cached DOF transformations", "[fem][dof_transformation]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD,
+                               {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}},
+                               {2, 3, 2}, mesh::CellType::tetrahedron));
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::N1E, basix::cell::type::tetrahedron, 2,
+          basix::element::lagrange_variant::legendre,
+          basix::element::dpc_variant::legendre, false));
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(mesh, element));
+
+  // Later calls return the cached object
+  auto P = V->dof_transformation<double>(0, fem::doftransform::standard,
+                                         false);
+  CHECK(V->dof_transformation<double>(0, fem::doftransform::standard, false)
+        == P);
+  auto PT = V->dof_transformation<double>(0, fem::doftransform::transpose,
+                                          true);
+  CHECK(PT != P);
+
+  // The cached transformations match those computed from the cell
+  // permutation information of the mesh
+  std::span<const std::uint32_t> cell_info
+      = mesh->topology()->get_cell_permutation_info();
+  fem::DofTransformation<double> P0(*element, fem::doftransform::standard,
+                                    false, cell_info);
+  fem::DofTransformation<double> PT0(*element, fem::doftransform::transpose,
+                                     true, cell_info);
+  const int dim = element->space_dimension();
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  for (std::int32_t c = 0; c < (std::int32_t)cell_info.size(); ++c)
+  {
+    std::vector<double> u0(2 * dim);
+    std::ranges::generate(u0, [&]() { return dist(gen); });
+    std::vector<double> u1 = u0;
+    P0(u0, cell_info, c, 2);
+    (*P)(u1, cell_info, c, 2);
+    CHECK(u1 == u0);
+    PT0(u0, cell_info, c, 2);
+    (*PT)(u1, cell_info, c, 2);
+    CHECK(u1 == u0);
+  }
+}
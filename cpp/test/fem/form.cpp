@@ -8,12 +8,15 @@
 #include <basix/finite-element.h>
 #include <catch2/catch_test_macros.hpp>
 #include <dolfinx/fem/Expression.h>
+#include <dolfinx/fem/FormRegistry.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/fem/FunctionSpace.h>
 #include <dolfinx/fem/assembler.h>
 #include <dolfinx/fem/utils.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/generation.h>
+#include <string>
+#include <vector>
 
 using namespace dolfinx;
 
@@ -68,3 +71,20 @@ TEST_CASE("Create Expression/Form (mismatch of mesh geometry)",
   test_form_cmap_compat(V);
   test_expression_cmap_compat(V);
 }
+
+TEST_CASE("Form registry", "[form_registry]")
+{
+  fem::FormRegistry registry;
+  registry.insert("expr_L2", *form_expr_L2);
+  registry.insert("expr_L1", *form_expr_L1);
+  registry.insert("expr_L1", *form_expr_L1);
+  CHECK(registry.size() == 2);
+  CHECK(registry.names() == std::vector<std::string>{"expr_L1", "expr_L2"});
+
+  CHECK(registry.find("expr_L1") == form_expr_L1);
+  CHECK(&registry.at("expr_L2") == form_expr_L2);
+  CHECK(registry.find("expr_L3") == nullptr);
+  CHECK_THROWS(registry.at("expr_L3"));
+  CHECK_THROWS(registry.insert("expr_L1", *form_expr_L2));
+  CHECK(registry.find_signature(form_expr_L2->signature) == form_expr_L2);
+}
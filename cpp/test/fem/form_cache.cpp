@@ -0,0 +1,168 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+std::shared_ptr<mesh::Mesh<double>> create_mesh()
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  return std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 5},
+                       mesh::CellType::tetrahedron, part));
+}
+
+std::shared_ptr<fem::FunctionSpace<double>>
+create_dg_space(std::shared_ptr<mesh::Mesh<double>> mesh)
+{
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, true);
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+}
+} // namespace
+
+TEST_CASE("Interior facet data cache", "[fem][form]")
+{
+  auto V = create_dg_space(create_mesh());
+  auto g = std::make_shared<fem::Function<double>>(V);
+  std::span<double> gx = g->x()->mutable_array();
+  for (std::size_t i = 0; i < gx.size(); ++i)
+    gx[i] = std::sin(0.7 * i);
+
+  auto a = fem::create_form<double, double>(*form_poisson_a_dg, {V, V}, {},
+                                            {}, {}, {});
+  auto L = fem::create_form<double, double>(*form_poisson_L_dg, {V},
+                                            {{"g", g}}, {}, {}, {});
+
+  SECTION("matrix")
+  {
+    la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+    sp.finalize();
+    la::MatrixCSR<double> A0(sp);
+    fem::assemble_matrix(A0.mat_add_values(), a, {});
+
+    // Assemble twice with the cache, re-using the cached data the
+    // second time
+    a.cache_facet_pairs(true);
+    for (int i = 0; i < 2; ++i)
+    {
+      la::MatrixCSR<double> A1(sp);
+      fem::assemble_matrix(A1.mat_add_values(), a, {});
+      CHECK(A1.values() == A0.values());
+    }
+
+    a.cache_facet_pairs(false);
+    la::MatrixCSR<double> A2(sp);
+    fem::assemble_matrix(A2.mat_add_values(), a, {});
+    CHECK(A2.values() == A0.values());
+  }
+
+  SECTION("vector")
+  {
+    std::vector<double> b0(gx.size(), 0);
+    fem::assemble_vector(std::span(b0), L);
+
+    L.cache_facet_pairs(true);
+    const int id = L.integral_ids(fem::IntegralType::interior_facet).at(0);
+    if (!L.domain(fem::IntegralType::interior_facet, id, 0).empty())
+      CHECK(!L.facet_pairs(id).empty());
+    for (int i = 0; i < 2; ++i)
+    {
+      std::vector<double> b1(gx.size(), 0);
+      fem::assemble_vector(std::span(b1), L);
+      CHECK(b1 == b0);
+    }
+  }
+}
+
+TEST_CASE("Coordinate dofs cache", "[fem][form]")
+{
+  // The forms have cell, exterior facet and interior facet integrals
+  auto mesh = create_mesh();
+  auto V = create_dg_space(mesh);
+  auto g = std::make_shared<fem::Function<double>>(V);
+  std::span<double> gx = g->x()->mutable_array();
+  for (std::size_t i = 0; i < gx.size(); ++i)
+    gx[i] = std::cos(0.3 * i);
+
+  auto a = fem::create_form<double, double>(*form_poisson_a_dg, {V, V}, {},
+                                            {}, {}, {});
+  auto L = fem::create_form<double, double>(*form_poisson_L_dg, {V},
+                                            {{"g", g}}, {}, {}, {});
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+
+  auto assemble = [&]()
+  {
+    la::MatrixCSR<double> A(sp);
+    fem::assemble_matrix(A.mat_add_values(), a, {});
+    std::vector<double> b(gx.size(), 0);
+    fem::assemble_vector(std::span(b), L);
+    return std::pair(A.values(), b);
+  };
+
+  auto [A0, b0] = assemble();
+
+  // Cached coordinate dofs are the same values as gathered ones
+  a.cache_coordinate_dofs(true);
+  L.cache_coordinate_dofs(true);
+  for (int i = 0; i < 2; ++i)
+  {
+    auto [A1, b1] = assemble();
+    CHECK(A1 == A0);
+    CHECK(b1 == b0);
+  }
+
+  // Compact storage is accurate to single precision relative to the
+  // cell size
+  a.cache_coordinate_dofs(true, true);
+  L.cache_coordinate_dofs(true, true);
+  {
+    auto [A1, b1] = assemble();
+    REQUIRE(A1.size() == A0.size());
+    for (std::size_t i = 0; i < A0.size(); ++i)
+      CHECK(A1[i] == Catch::Approx(A0[i]).epsilon(1e-5).margin(1e-5));
+    REQUIRE(b1.size() == b0.size());
+    for (std::size_t i = 0; i < b0.size(); ++i)
+      CHECK(b1[i] == Catch::Approx(b0[i]).epsilon(1e-5).margin(1e-6));
+  }
+
+  // Moving the mesh requires the cache to be cleared
+  std::span<double> x = mesh->geometry().x();
+  std::ranges::transform(x, x.begin(), [](auto x) { return 2 * x; });
+  a.cache_coordinate_dofs(false);
+  L.cache_coordinate_dofs(false);
+  auto [A2, b2] = assemble();
+  a.cache_coordinate_dofs(true);
+  L.cache_coordinate_dofs(true);
+  a.clear_coordinate_dofs();
+  L.clear_coordinate_dofs();
+  auto [A3, b3] = assemble();
+  CHECK(A3 == A2);
+  CHECK(b3 == b2);
+}
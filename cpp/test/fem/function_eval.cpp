@@ -0,0 +1,214 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/CurvedGeometryCache.h>
+#include <dolfinx/mesh/GeometryCache.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Evaluate Function with workspace", "[fem][eval]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle(MPI_COMM_SELF, {{{0, 0}, {1, 1}}}, {6, 5},
+                             mesh::CellType::quadrilateral));
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::quadrilateral, 2,
+          basix::element::lagrange_variant::gll_warped,
+          basix::element::dpc_variant::unset, false));
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(mesh, element));
+  fem::Function<double> u(V);
+  std::span<double> coeffs = u.x()->mutable_array();
+  for (std::size_t i = 0; i < coeffs.size(); ++i)
+    coeffs[i] = std::sin(0.37 * i);
+
+  // Random points in random cells (several points per cell, and some
+  // ignored points), at the average of the cell nodes weighted by
+  // random weights
+  auto x_dofmap = mesh->geometry().dofmap();
+  std::span<const double> x_g = mesh->geometry().x();
+  const std::int32_t num_cells = x_dofmap.extent(0);
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<std::int32_t> cell_dist(-1, num_cells - 1);
+  std::uniform_real_distribution<double> weight_dist(0.1, 1);
+  const std::size_t num_points = 500;
+  std::vector<double> x(3 * num_points, 0);
+  std::vector<std::int32_t> cells(num_points);
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    cells[p] = cell_dist(gen);
+    const std::int32_t c = std::max(cells[p], 0);
+    std::vector<double> w(x_dofmap.extent(1));
+    std::ranges::generate(w, [&]() { return weight_dist(gen); });
+    const double w_sum = std::reduce(w.begin(), w.end());
+    for (std::size_t i = 0; i < w.size(); ++i)
+      for (int j = 0; j < 3; ++j)
+        x[3 * p + j] += w[i] / w_sum * x_g[3 * x_dofmap(c, i) + j];
+  }
+
+  // Evaluate point by point
+  std::vector<double> u0(num_points);
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    u.eval(std::span(x.data() + 3 * p, 3), {1, 3}, std::span(&cells[p], 1),
+           std::span(&u0[p], 1), {1, 1});
+  }
+
+  // Evaluate all points, reusing a workspace
+  fem::EvalWorkspace<double> workspace;
+  for (int num_threads : {1, 3, 1})
+  {
+    std::vector<double> u1(num_points, -1);
+    u.eval(x, {num_points, 3}, cells, u1, {num_points, 1}, workspace,
+           num_threads);
+    CHECK(u1 == u0);
+  }
+}
+
+TEST_CASE("Evaluate Function with geometry cache", "[fem][eval]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle(MPI_COMM_SELF, {{{0, 0}, {1, 1}}}, {6, 5},
+                             mesh::CellType::triangle));
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::triangle, 3,
+          basix::element::lagrange_variant::gll_warped,
+          basix::element::dpc_variant::unset, false));
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(mesh, element));
+  fem::Function<double> u(V);
+  std::span<double> coeffs = u.x()->mutable_array();
+  for (std::size_t i = 0; i < coeffs.size(); ++i)
+    coeffs[i] = std::sin(0.37 * i);
+
+  // Points at the midpoints of the cells
+  auto x_dofmap = mesh->geometry().dofmap();
+  auto cache = std::make_shared<mesh::GeometryCache<double>>(mesh);
+  CHECK(cache->stale());
+  cache->update(2);
+  CHECK(!cache->stale());
+  std::span<const double> x_g = std::as_const(*mesh).geometry().x();
+  const std::size_t num_cells = x_dofmap.extent(0);
+  std::vector<double> x(3 * num_cells, 0);
+  std::vector<std::int32_t> cells(num_cells);
+  std::iota(cells.begin(), cells.end(), 0);
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    for (std::size_t i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+        x[3 * c + j] += x_g[3 * x_dofmap(c, i) + j] / 3;
+
+    // Area of the cell
+    auto x0 = std::next(x_g.begin(), 3 * x_dofmap(c, 0));
+    auto x1 = std::next(x_g.begin(), 3 * x_dofmap(c, 1));
+    auto x2 = std::next(x_g.begin(), 3 * x_dofmap(c, 2));
+    double area = 0.5 * ((x1[0] - x0[0]) * (x2[1] - x0[1])
+                         - (x2[0] - x0[0]) * (x1[1] - x0[1]));
+    CHECK(std::abs(std::abs(cache->detJ(c)) - 2 * std::abs(area)) < 1e-12);
+  }
+
+  std::vector<double> u0(num_cells), u1(num_cells);
+  u.eval(x, {num_cells, 3}, cells, u0, {num_cells, 1});
+  fem::EvalWorkspace<double> workspace;
+  workspace.set_geometry_cache(cache);
+  u.eval(x, {num_cells, 3}, cells, u1, {num_cells, 1}, workspace);
+  CHECK(u1 == u0);
+
+  // Non-const access to the coordinates invalidates the cache
+  mesh->geometry().x();
+  CHECK(cache->stale());
+}
+
+TEST_CASE("Evaluate Function with curved geometry cache", "[fem][eval]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle(MPI_COMM_SELF, {{{0, 0}, {1, 1}}}, {6, 5},
+                             mesh::CellType::quadrilateral));
+
+  // Distort the (bilinear) cells
+  {
+    std::span<double> x_g = mesh->geometry().x();
+    for (std::size_t i = 0; i < x_g.size() / 3; ++i)
+    {
+      const double x = x_g[3 * i], y = x_g[3 * i + 1];
+      x_g[3 * i] += 0.05 * std::sin(3 * y);
+      x_g[3 * i + 1] += 0.05 * std::sin(4 * x);
+    }
+  }
+
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::quadrilateral, 2,
+          basix::element::lagrange_variant::gll_warped,
+          basix::element::dpc_variant::unset, false));
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(mesh, element));
+  fem::Function<double> u(V);
+  std::span<double> coeffs = u.x()->mutable_array();
+  for (std::size_t i = 0; i < coeffs.size(); ++i)
+    coeffs[i] = std::sin(0.37 * i);
+
+  auto cache = std::make_shared<mesh::CurvedGeometryCache<double>>(mesh);
+  CHECK(cache->stale());
+  cache->update(2);
+  CHECK(!cache->stale());
+
+  // Points at the average of the cell nodes weighted by random
+  // weights, which lie in the cell bounding boxes
+  auto x_dofmap = mesh->geometry().dofmap();
+  std::span<const double> x_g = std::as_const(*mesh).geometry().x();
+  const std::size_t num_cells = x_dofmap.extent(0);
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> weight_dist(0.1, 1);
+  std::vector<double> x(3 * num_cells, 0);
+  std::vector<std::int32_t> cells(num_cells);
+  std::iota(cells.begin(), cells.end(), 0);
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    std::vector<double> w(x_dofmap.extent(1));
+    std::ranges::generate(w, [&]() { return weight_dist(gen); });
+    const double w_sum = std::reduce(w.begin(), w.end());
+    for (std::size_t i = 0; i < w.size(); ++i)
+      for (int j = 0; j < 3; ++j)
+        x[3 * c + j] += w[i] / w_sum * x_g[3 * x_dofmap(c, i) + j];
+
+    std::span<const double, 6> b = cache->bbox(c);
+    for (int j = 0; j < 2; ++j)
+    {
+      CHECK(b[j] <= x[3 * c + j]);
+      CHECK(x[3 * c + j] <= b[3 + j]);
+    }
+  }
+
+  std::vector<double> u0(num_cells), u1(num_cells);
+  u.eval(x, {num_cells, 3}, cells, u0, {num_cells, 1});
+  fem::EvalWorkspace<double> workspace;
+  workspace.set_curved_geometry_cache(cache);
+  u.eval(x, {num_cells, 3}, cells, u1, {num_cells, 1}, workspace);
+  for (std::size_t c = 0; c < num_cells; ++c)
+    CHECK(std::abs(u1[c] - u0[c]) < 1e-5);
+
+  // Non-const access to the coordinates invalidates the cache
+  mesh->geometry().x();
+  CHECK(cache->stale());
+}
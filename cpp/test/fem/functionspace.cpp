@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 
 #include <basix/finite-element.h>
@@ -29,3 +30,62 @@ TEST_CASE("Create Function Space (mismatch of elements)", "[functionspace]")
   CHECK_THROWS(fem::create_functionspace<double>(
       mesh, std::make_shared<fem::FiniteElement<double>>(element)));
 }
+
+TEST_CASE("Collapse cached subspace", "[functionspace]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      dolfinx::mesh::create_rectangle<double>(MPI_COMM_WORLD,
+                                              {{{0, 0}, {1, 1}}}, {4, 3},
+                                              mesh::CellType::triangle));
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::triangle, 2,
+          basix::element::lagrange_variant::unset,
+          basix::element::dpc_variant::unset, false),
+      std::vector<std::size_t>{2});
+  auto V = fem::create_functionspace<double>(mesh, element);
+
+  // Subspaces for the same component share the sub-dofmap and the
+  // collapsed space
+  fem::FunctionSpace<double> V0 = V.sub({0});
+  fem::FunctionSpace<double> V1 = V.sub({1});
+  CHECK(V.sub({0}).dofmap() == V0.dofmap());
+  CHECK(V1.dofmap() != V0.dofmap());
+
+  auto [W0, map0] = V0.collapsed();
+  auto [W0b, map0b] = V.sub({0}).collapsed();
+  CHECK(W0 == W0b);
+  CHECK(map0.data() == map0b.data());
+  CHECK(W0 != V1.collapsed().first);
+
+  auto [W, map] = V0.collapse();
+  CHECK(W.dofmap() == W0->dofmap());
+  CHECK(std::ranges::equal(map, map0));
+}
+
+TEST_CASE("Dofmap with static number of dofs", "[functionspace]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      dolfinx::mesh::create_rectangle<double>(MPI_COMM_WORLD,
+                                              {{{0, 0}, {1, 1}}}, {4, 3},
+                                              mesh::CellType::triangle));
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::triangle, 2,
+          basix::element::lagrange_variant::unset,
+          basix::element::dpc_variant::unset, false));
+  auto V = fem::create_functionspace<double>(mesh, element);
+  const fem::DofMap& dofmap = *V.dofmap();
+
+  int num_dofs = 0;
+  fem::dispatch_num_dofs(dofmap.map().extent(1),
+                         [&]<int N>(std::integral_constant<int, N>)
+                         { num_dofs = N; });
+  CHECK(num_dofs == 6);
+
+  fem::dofmap_view_t<6> dofs = dofmap.map<6>();
+  CHECK(dofs.extent(0) == dofmap.map().extent(0));
+  CHECK(dofs.data_handle() == dofmap.map().data_handle());
+  CHECK(std::ranges::equal(dofmap.cell_dofs<6>(1), dofmap.cell_dofs(1)));
+  CHECK_THROWS(dofmap.map<3>());
+}
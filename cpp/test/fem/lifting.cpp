@@ -0,0 +1,262 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "poisson.h"
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/DirichletBC.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Assembly and lifting", "[fem][lifting]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 5},
+      mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto set = [](fem::Function<double>& u, double a)
+  {
+    std::span<double> x = u.x()->mutable_array();
+    for (std::size_t i = 0; i < x.size(); ++i)
+      x[i] = std::sin(a * i);
+  };
+  auto f = std::make_shared<fem::Function<double>>(V);
+  auto g = std::make_shared<fem::Function<double>>(V);
+  auto x0 = std::make_shared<fem::Function<double>>(V);
+  set(*f, 0.1);
+  set(*g, 0.2);
+  set(*x0, 0.3);
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto L = fem::create_form<double, double>(*form_poisson_L, {V}, {{"f", f}},
+                                            {}, {}, {});
+  auto a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+
+  // Boundary condition on the facets at x = 0
+  const int tdim = mesh->topology()->dim();
+  std::vector facets = mesh::locate_entities_boundary(
+      *mesh, tdim - 1,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marker(x.extent(1), false);
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          marker[p] = std::abs(x(0, p)) < 1e-8;
+        return marker;
+      });
+  std::vector bdofs = fem::locate_dofs_topological(
+      *mesh->topology_mutable(), *V->dofmap(), tdim - 1, facets);
+  auto bc = std::make_shared<const fem::DirichletBC<double>>(g, bdofs);
+
+  // Cells with a constrained dof
+  {
+    std::vector<std::int8_t> markers(f->x()->array().size(), false);
+    bc->mark_dofs(markers);
+    auto dofmap = V->dofmap()->map();
+    std::vector<std::int32_t> cells;
+    for (std::size_t c = 0; c < dofmap.extent(0); ++c)
+    {
+      auto dofs = md::submdspan(dofmap, c, md::full_extent);
+      for (std::size_t i = 0; i < dofs.size(); ++i)
+      {
+        if (markers[dofs[i]])
+        {
+          cells.push_back(c);
+          break;
+        }
+      }
+    }
+    CHECK(std::ranges::equal(bc->cells(), cells));
+  }
+
+  const std::size_t size = f->x()->array().size();
+  for (bool with_x0 : {false, true})
+  {
+    std::span<const double> _x0;
+    if (with_x0)
+      _x0 = x0->x()->array();
+
+    std::vector<double> b0(size, 1), b1(size, 1);
+    fem::assemble_vector(std::span(b0), L);
+    fem::apply_lifting<double, double>(b0, {a}, {{*bc}}, {_x0}, -0.5);
+    fem::assemble_vector_lifted<double, double>(b1, L, a, {*bc}, _x0, -0.5);
+    for (std::size_t i = 0; i < size; ++i)
+      CHECK(std::abs(b1[i] - b0[i]) < 1e-12);
+  }
+}
+
+TEST_CASE("Fused matrix and vector assembly", "[fem][lifting]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 5},
+      mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto f = std::make_shared<fem::Function<double>>(V);
+  std::span<double> _f = f->x()->mutable_array();
+  for (std::size_t i = 0; i < _f.size(); ++i)
+    _f[i] = std::sin(0.1 * i);
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto L = fem::create_form<double, double>(*form_poisson_L, {V}, {{"f", f}},
+                                            {}, {}, {});
+  auto a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+
+  const int tdim = mesh->topology()->dim();
+  std::vector facets = mesh::locate_entities_boundary(
+      *mesh, tdim - 1,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marker(x.extent(1), false);
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          marker[p] = std::abs(x(0, p)) < 1e-8;
+        return marker;
+      });
+  std::vector bdofs = fem::locate_dofs_topological(
+      *mesh->topology_mutable(), *V->dofmap(), tdim - 1, facets);
+  auto bc = std::make_shared<const fem::DirichletBC<double>>(f, bdofs);
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp), A1(sp);
+  const std::size_t size = _f.size();
+  std::vector<double> b0(size, 0), b1(size, 0);
+  fem::assemble_matrix(A0.mat_add_values(), a, {*bc});
+  fem::assemble_vector(std::span(b0), L);
+  fem::assemble_matrix_vector<double, double>(A1.mat_add_values(), b1, a, L,
+                                              {*bc});
+
+  for (std::size_t i = 0; i < size; ++i)
+    CHECK(std::abs(b1[i] - b0[i]) < 1e-12);
+  REQUIRE(A0.values().size() == A1.values().size());
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(std::abs(A1.values()[i] - A0.values()[i]) < 1e-12);
+}
+
+TEST_CASE("Fused residual and Jacobian assembly", "[fem][lifting]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {3, 4, 3},
+      mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  // F and J share the coefficient f, which is packed once
+  auto f = std::make_shared<fem::Function<double>>(V);
+  std::span<double> _f = f->x()->mutable_array();
+  for (std::size_t i = 0; i < _f.size(); ++i)
+    _f[i] = std::cos(0.3 * i);
+  auto F = fem::create_form<double, double>(*form_poisson_F, {V}, {{"f", f}},
+                                            {}, {}, {});
+  auto J = fem::create_form<double, double>(*form_poisson_J, {V, V},
+                                            {{"f", f}}, {}, {}, {});
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(J);
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp), A1(sp);
+  std::vector<double> b0(_f.size(), 0), b1(_f.size(), 0);
+  fem::assemble_matrix(A0.mat_add_values(), J, {});
+  fem::assemble_vector(std::span(b0), F);
+  fem::assemble_matrix_vector<double, double>(A1.mat_add_values(), b1, J, F,
+                                              {});
+
+  for (std::size_t i = 0; i < b0.size(); ++i)
+    CHECK(std::abs(b1[i] - b0[i]) < 1e-12);
+  REQUIRE(A0.values().size() == A1.values().size());
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(std::abs(A1.values()[i] - A0.values()[i]) < 1e-12);
+}
+
+TEST_CASE("Re-assembly on changed cells", "[fem][lifting]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 3},
+      mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto f = std::make_shared<fem::Function<double>>(V);
+  std::span<double> _f = f->x()->mutable_array();
+  for (std::size_t i = 0; i < _f.size(); ++i)
+    _f[i] = std::cos(0.3 * i);
+  f->x()->scatter_fwd();
+  auto J = fem::create_form<double, double>(*form_poisson_J, {V, V},
+                                            {{"f", f}}, {}, {}, {});
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(J);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp), B(sp);
+  fem::assemble_matrix(A.mat_add_values(), J, {});
+  A.scatter_rev();
+
+  // Change f at a few owned degrees-of-freedom, and find the cells
+  // that are affected by the change
+  std::vector<double> f0(_f.begin(), _f.end());
+  auto map = V->dofmap()->index_map;
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+  {
+    if ((map->local_range()[0] + i) % 11 == 0)
+      _f[i] += 1;
+  }
+  f->x()->scatter_fwd();
+  std::vector<std::int32_t> cells;
+  auto dofs = V->dofmap()->map();
+  for (std::size_t c = 0; c < dofs.extent(0); ++c)
+  {
+    for (std::size_t i = 0; i < dofs.extent(1); ++i)
+    {
+      if (_f[dofs(c, i)] != f0[dofs(c, i)])
+      {
+        cells.push_back(c);
+        break;
+      }
+    }
+  }
+
+  fem::reassemble_matrix<double, double>(A, J, cells, {});
+  fem::assemble_matrix(B.mat_add_values(), J, {});
+  B.scatter_rev();
+  for (std::size_t i = 0; i < A.values().size(); ++i)
+    CHECK(std::abs(A.values()[i] - B.values()[i]) < 1e-12);
+}
@@ -0,0 +1,169 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assemble_points.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Q1 basis functions on the reference quadrilateral
+double phi(int i, const double* X)
+{
+  const double x = (i % 2 == 0) ? 1 - X[0] : X[0];
+  const double y = (i < 2) ? 1 - X[1] : X[1];
+  return x * y;
+}
+
+// Mass kernels with quadrature rules from the custom data (for
+// parallelograms)
+double det_J(const double* cdofs)
+{
+  return std::abs((cdofs[3] - cdofs[0]) * (cdofs[7] - cdofs[1])
+                  - (cdofs[4] - cdofs[1]) * (cdofs[6] - cdofs[0]));
+}
+
+void vector_kernel(double* b, const double*, const double*,
+                   const double* cdofs, const int*, const std::uint8_t*,
+                   void* data)
+{
+  auto q = static_cast<const fem::quadrature_data<double>*>(data);
+  for (int p = 0; p < q->num_points; ++p)
+    for (int i = 0; i < 4; ++i)
+      b[i] += q->weights[p] * det_J(cdofs) * phi(i, q->points + 2 * p);
+}
+
+void matrix_kernel(double* A, const double*, const double*,
+                   const double* cdofs, const int*, const std::uint8_t*,
+                   void* data)
+{
+  auto q = static_cast<const fem::quadrature_data<double>*>(data);
+  for (int p = 0; p < q->num_points; ++p)
+  {
+    const double* X = q->points + 2 * p;
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+        A[i * 4 + j] += q->weights[p] * det_J(cdofs) * phi(i, X) * phi(j, X);
+  }
+}
+} // namespace
+
+TEST_CASE("Point and run-time quadrature assembly", "[fem][assembly]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle(MPI_COMM_SELF, {{{0, 0}, {2, 1}}}, {8, 5},
+                             mesh::CellType::quadrilateral));
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::quadrilateral, 1,
+          basix::element::lagrange_variant::gll_warped,
+          basix::element::dpc_variant::unset, false));
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(mesh, element));
+  const std::size_t num_dofs = V->dofmap()->index_map->size_local();
+  md::mdspan<const double, md::dextents<std::size_t, 2>> no_coeffs;
+
+  for (int num_threads : {1, 3})
+  {
+    // Unit point source at each vertex
+    auto topology = mesh->topology();
+    topology->create_connectivity(0, 2);
+    std::vector<std::int32_t> vertices(topology->index_map(0)->size_local());
+    std::iota(vertices.begin(), vertices.end(), 0);
+    std::vector<std::int32_t> entities = fem::compute_integration_domains(
+        fem::IntegralType::vertex, *topology, vertices);
+    REQUIRE(entities.size() == 2 * vertices.size());
+    std::vector<double> b(num_dofs, 0);
+    fem::assemble_vector_points<double, double>(
+        b,
+        [](double* be, const double*, const double*, const double*,
+           const int* v, const std::uint8_t*, void*) { be[*v] += 1; },
+        *V, fem::IntegralType::vertex, entities, {}, no_coeffs, std::nullopt,
+        num_threads);
+    CHECK(std::ranges::all_of(b, [](auto v) { return v == 1; }));
+
+    // Cells with a varying number of points: the mass vector and
+    // matrix sum to the area
+    const std::int32_t num_cells = topology->index_map(2)->size_local();
+    std::vector<std::int32_t> cells(num_cells);
+    std::iota(cells.begin(), cells.end(), 0);
+    std::vector<std::int32_t> offsets = {0};
+    std::vector<double> points, weights;
+    const double g = 0.5 / std::sqrt(3.0);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      // Two-point Gauss rule in each direction, or a one-point rule
+      // (exact for the mass vector only)
+      if (c % 2 == 0)
+      {
+        for (double y : {0.5 - g, 0.5 + g})
+          for (double x : {0.5 - g, 0.5 + g})
+            points.insert(points.end(), {x, y});
+        weights.insert(weights.end(), 4, 0.25);
+      }
+      else
+      {
+        points.insert(points.end(), {0.5, 0.5});
+        weights.push_back(1);
+      }
+      offsets.push_back(weights.size());
+    }
+    fem::RuntimeQuadrature<double> quadrature(2, offsets, points, weights);
+
+    std::ranges::fill(b, 0);
+    fem::assemble_vector_points<double, double>(
+        b, vector_kernel, *V, fem::IntegralType::cell, cells, {}, no_coeffs,
+        quadrature, num_threads);
+    CHECK(std::abs(std::reduce(b.begin(), b.end()) - 2) < 1e-12);
+
+    std::vector<double> row_sums(num_dofs, 0);
+    std::vector<std::int8_t> bc(num_dofs, 0);
+    bc[0] = 1;
+    fem::assemble_matrix_points<double, double>(
+        [&](std::span<const std::int32_t> rows, std::span<const std::int32_t>,
+            std::span<const double> Ae)
+        {
+          for (std::size_t i = 0; i < rows.size(); ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+              row_sums[rows[i]] += Ae[i * 4 + j];
+          return 0;
+        },
+        matrix_kernel, *V, *V, fem::IntegralType::cell, cells, {}, no_coeffs,
+        {}, {}, quadrature, num_threads);
+    const double sum = std::reduce(row_sums.begin(), row_sums.end());
+    CHECK(std::abs(sum - 2) < 1e-12);
+
+    // Boundary condition rows are zeroed
+    std::ranges::fill(row_sums, 0);
+    fem::assemble_matrix_points<double, double>(
+        [&](std::span<const std::int32_t> rows, std::span<const std::int32_t>,
+            std::span<const double> Ae)
+        {
+          for (std::size_t i = 0; i < rows.size(); ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+              row_sums[rows[i]] += Ae[i * 4 + j];
+          return 0;
+        },
+        matrix_kernel, *V, *V, fem::IntegralType::cell, cells, {}, no_coeffs,
+        bc, {}, quadrature, num_threads);
+    CHECK(row_sums[0] == 0);
+    CHECK(std::abs(std::reduce(row_sums.begin(), row_sums.end())
+                   - (sum - b[0]))
+          < 1e-12);
+  }
+}
@@ -0,0 +1,188 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "poisson.h"
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Reproducible assembly", "[fem][reproducible]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {6, 5, 4},
+      mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto f = std::make_shared<fem::Function<double>>(V);
+  std::span<double> fx = f->x()->mutable_array();
+  for (std::size_t i = 0; i < fx.size(); ++i)
+    fx[i] = std::sin(0.3 * i);
+  auto kappa = std::make_shared<fem::Constant<double>>(1.7);
+  auto L = fem::create_form<double, double>(*form_poisson_L, {V}, {{"f", f}},
+                                            {}, {}, {});
+  auto a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+  L.set_reproducible(true);
+  a.set_reproducible(true);
+
+  SECTION("vector")
+  {
+    std::vector<double> b0(fx.size(), 0);
+    fem::assemble_vector(std::span(b0), L);
+    for (int num_threads : {2, 3, 4})
+    {
+      std::vector<double> b1(fx.size(), 0);
+      fem::assemble_vector(std::span(b1), L, num_threads);
+      CHECK(b1 == b0);
+    }
+  }
+
+  SECTION("matrix")
+  {
+    la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+    sp.finalize();
+    la::MatrixCSR<double> A0(sp);
+    fem::assemble_matrix(A0.mat_add_values(), a, {});
+    for (int num_threads : {2, 4})
+    {
+      la::MatrixCSR<double> A1(sp);
+      fem::assemble_matrix(A1.mat_add_values(), a, {}, num_threads);
+      CHECK(A1.values() == A0.values());
+    }
+  }
+}
+
+TEST_CASE("Colouring of integration entities", "[fem][reproducible]")
+{
+  // Forms with cell, exterior facet and interior facet integrals
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 5},
+      mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, true);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto g = std::make_shared<fem::Function<double>>(V);
+  std::span<double> gx = g->x()->mutable_array();
+  for (std::size_t i = 0; i < gx.size(); ++i)
+    gx[i] = std::sin(0.7 * i);
+  auto a = fem::create_form<double, double>(*form_poisson_a_dg, {V, V}, {},
+                                            {}, {}, {});
+  auto L = fem::create_form<double, double>(*form_poisson_L_dg, {V},
+                                            {{"g", g}}, {}, {}, {});
+
+  SECTION("colouring")
+  {
+    // Entities of a colour do not share a test dof, and each entity
+    // has one colour
+    std::shared_ptr<const fem::DofMap> dofmap = V->dofmap();
+    for (auto [type, stride] :
+         {std::pair(fem::IntegralType::cell, 1),
+          std::pair(fem::IntegralType::exterior_facet, 2),
+          std::pair(fem::IntegralType::interior_facet, 4)})
+    {
+      for (int id : a.integral_ids(type))
+      {
+        std::span entities = a.domain_arg(type, 0, id, 0);
+        const graph::AdjacencyList<std::int32_t>& colouring
+            = a.colouring(type, id, 0);
+        std::vector<int> num_colours(entities.size() / stride, 0);
+        for (int c = 0; c < colouring.num_nodes(); ++c)
+        {
+          std::vector<std::int8_t> marked(gx.size(), 0);
+          for (std::int32_t pos : colouring.links(c))
+          {
+            ++num_colours[pos];
+            for (int k = 0; k < stride; k += 2)
+            {
+              for (std::int32_t dof :
+                   dofmap->cell_dofs(entities[pos * stride + k]))
+              {
+                CHECK(!marked[dof]);
+                marked[dof] = 1;
+              }
+            }
+          }
+        }
+        CHECK(std::ranges::all_of(num_colours, [](int n) { return n == 1; }));
+
+        // The colouring is cached until it is cleared
+        CHECK(&a.colouring(type, id, 0) == &colouring);
+        a.clear_colourings();
+        CHECK(a.colouring(type, id, 0).array() == colouring.array());
+      }
+    }
+  }
+
+  SECTION("vector")
+  {
+    std::vector<double> b0(gx.size(), 0);
+    fem::assemble_vector(std::span(b0), L);
+    for (int num_threads : {2, 3})
+    {
+      std::vector<double> b1(gx.size(), 0);
+      fem::assemble_vector(std::span(b1), L, num_threads);
+      for (std::size_t i = 0; i < b0.size(); ++i)
+        CHECK(b1[i] == Catch::Approx(b0[i]).margin(1e-12));
+    }
+
+    L.set_reproducible(true);
+    std::vector<double> b2(gx.size(), 0);
+    fem::assemble_vector(std::span(b2), L);
+    std::vector<double> b3(gx.size(), 0);
+    fem::assemble_vector(std::span(b3), L, 4);
+    CHECK(b3 == b2);
+  }
+
+  SECTION("matrix")
+  {
+    la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+    sp.finalize();
+    la::MatrixCSR<double> A0(sp);
+    fem::assemble_matrix(A0.mat_add_values(), a, {});
+    for (int num_threads : {2, 3})
+    {
+      la::MatrixCSR<double> A1(sp);
+      fem::assemble_matrix(A1.mat_add_values(), a, {}, num_threads);
+      for (std::size_t i = 0; i < A0.values().size(); ++i)
+        CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+    }
+
+    a.set_reproducible(true);
+    la::MatrixCSR<double> A2(sp), A3(sp);
+    fem::assemble_matrix(A2.mat_add_values(), a, {});
+    fem::assemble_matrix(A3.mat_add_values(), a, {}, 4);
+    CHECK(A3.values() == A2.values());
+  }
+}
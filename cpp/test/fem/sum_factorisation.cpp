@@ -0,0 +1,78 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/SumFactorisedOperator.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Sum factorised operator", "[fem][sum_factorisation]")
+{
+  // Box [0, 1] x [0, 2] x [0, 3], with volume 6 and, for u = x, the
+  // integral of |grad u|^2 equal to 6
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 2, 3}}}, {3, 2, 4},
+                       mesh::CellType::hexahedron));
+  for (int degree : {1, 3})
+  {
+    auto element = std::make_shared<fem::FiniteElement<double>>(
+        basix::create_element<double>(
+            basix::element::family::P, basix::cell::type::hexahedron, degree,
+            basix::element::lagrange_variant::gll_warped,
+            basix::element::dpc_variant::unset, false));
+    auto V = std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace<double>(mesh, element));
+    auto map = V->dofmap()->index_map;
+
+    la::Vector<double> x(map, 1), y(map, 1);
+    auto inner = [&map](const la::Vector<double>& a,
+                        const la::Vector<double>& b)
+    {
+      double local = 0;
+      for (std::int32_t i = 0; i < map->size_local(); ++i)
+        local += a.array()[i] * b.array()[i];
+      double global = 0;
+      MPI_Allreduce(&local, &global, 1, MPI_DOUBLE, MPI_SUM, map->comm());
+      return global;
+    };
+
+    // Mass: 1^T M 1 is the volume
+    std::ranges::fill(x.mutable_array(), 1);
+    fem::SumFactorisedOperator<double> M(V, 1, 0);
+    M.apply(x, y);
+    CHECK(std::abs(inner(x, y) - 6) < 1e-10);
+
+    // Stiffness: constants are in the kernel, and u^T K u = 6 for u = x
+    fem::SumFactorisedOperator<double> K(V, 0, 1);
+    K.apply(x, y);
+    CHECK(std::sqrt(inner(y, y)) < 1e-10);
+
+    fem::Function<double> u(V);
+    u.interpolate(
+        [](auto xp) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+        {
+          std::vector<double> f(xp.extent(1));
+          for (std::size_t p = 0; p < xp.extent(1); ++p)
+            f[p] = xp(0, p);
+          return {f, {f.size()}};
+        });
+    std::ranges::copy(u.x()->array(), x.mutable_array().begin());
+    K.apply(x, y);
+    CHECK(std::abs(inner(x, y) - 6) < 1e-10);
+  }
+}
@@ -0,0 +1,96 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/fem/TabulationCache.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Tabulation cache", "[fem][tabulation]")
+{
+  fem::TabulationCache<double> cache(24);
+  int num_calls = 0;
+  auto tabulate = [&](auto X, int nd)
+  {
+    std::vector<double> values(2 * X.size());
+    cache.tabulate(nd, std::span<const double>(X), {X.size() / 2, 2}, values,
+                   [&](std::span<double> v)
+                   {
+                     ++num_calls;
+                     for (std::size_t i = 0; i < v.size(); ++i)
+                       v[i] = (nd + 1) * X[i % X.size()];
+                   });
+    return values;
+  };
+
+  std::vector<double> X0 = {0.1, 0.2, 0.3, 0.4};
+  std::vector<double> X1 = {0.1, 0.2, 0.3, 0.5};
+
+  std::vector<double> v0 = tabulate(X0, 0);
+  CHECK(num_calls == 1);
+  CHECK(cache.size() == 8);
+
+  // Cached
+  CHECK(tabulate(X0, 0) == v0);
+  CHECK(num_calls == 1);
+
+  // Different derivative order or points
+  tabulate(X0, 1);
+  CHECK(num_calls == 2);
+  tabulate(X1, 0);
+  CHECK(num_calls == 3);
+  CHECK(cache.size() == 24);
+
+  // Inserting evicts the least recently used tabulation, (X0, 1)
+  CHECK(tabulate(X0, 0) == v0);
+  CHECK(num_calls == 3);
+  tabulate(std::vector<double>{0, 0, 0, 0}, 0);
+  CHECK(num_calls == 4);
+  CHECK(cache.size() == 24);
+  CHECK(tabulate(X0, 0) == v0);
+  CHECK(num_calls == 4);
+  tabulate(X0, 1);
+  CHECK(num_calls == 5);
+
+  // Disable
+  cache.set_max_size(0);
+  CHECK(cache.size() == 0);
+  CHECK(tabulate(X0, 0) == v0);
+  CHECK(num_calls == 6);
+  CHECK(cache.size() == 0);
+}
+
+TEST_CASE("Coordinate element tabulation cache", "[fem][tabulation]")
+{
+  fem::CoordinateElement<double> cmap(mesh::CellType::triangle, 2);
+  std::vector<double> X = {0.1, 0.2, 0.3, 0.4, 0.25, 0.25};
+  std::array<std::size_t, 2> Xshape = {3, 2};
+  std::array<std::size_t, 4> shape = cmap.tabulate_shape(1, Xshape[0]);
+  const std::size_t size
+      = std::reduce(shape.begin(), shape.end(), 1, std::multiplies{});
+
+  // Tabulation at arbitrary points bypasses the cache
+  std::vector<double> phi0(size), phi1(size);
+  cmap.tabulate(1, X, Xshape, phi0);
+  CHECK(cmap.tabulation_cache().size() == 0);
+
+  // Tabulation at fixed points is cached on request
+  cmap.tabulate_cached(1, X, Xshape, phi1);
+  CHECK(cmap.tabulation_cache().size() == size);
+  CHECK(phi1 == phi0);
+  std::ranges::fill(phi1, 0);
+  cmap.tabulate_cached(1, X, Xshape, phi1);
+  CHECK(phi1 == phi0);
+  CHECK(cmap.tabulation_cache().size() == size);
+}
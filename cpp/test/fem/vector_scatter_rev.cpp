@@ -0,0 +1,118 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <basix/mdspan.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/colouring.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/generation.h>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Assemble L into a vector with and without overlapping the reverse
+// scatter, and compare the owned entries
+void check_scatter_rev(const fem::Form<double, double>& L)
+{
+  auto V = L.function_spaces().at(0);
+  la::Vector<double> b0(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+  fem::assemble_vector(b0.mutable_array(), L);
+  b0.scatter_rev(std::plus<double>());
+
+  la::Vector<double> b1(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+  fem::assemble_vector_scatter_rev(b1, L);
+
+  const std::size_t num_owned
+      = V->dofmap()->index_map->size_local() * V->dofmap()->index_map_bs();
+  std::span<const double> x0 = b0.array(), x1 = b1.array();
+  for (std::size_t i = 0; i < num_owned; ++i)
+    CHECK(x1[i] == Catch::Approx(x0[i]).margin(1e-12));
+}
+
+// Create a finite element space on a tetrahedral mesh
+std::shared_ptr<fem::FunctionSpace<double>>
+create_space(std::shared_ptr<mesh::Mesh<double>> mesh, int degree,
+             bool discontinuous)
+{
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, degree,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, discontinuous);
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+}
+} // namespace
+
+TEST_CASE("Partition entities by ghost dofs", "[fem][scatter_rev]")
+{
+  // Three cells with two dofs each, of which dofs 4 and 5 are ghosts
+  std::vector<std::int32_t> dofs = {0, 1, 2, 5, 3, 4};
+  md::mdspan<const std::int32_t, md::dextents<std::size_t, 2>> dofmap(
+      dofs.data(), 3, 2);
+
+  std::vector<std::int32_t> cells = {2, 0, 1};
+  auto [p0, p1]
+      = fem::partition_by_ghosts(fem::IntegralType::cell, dofmap, 4, cells);
+  CHECK(p0 == std::vector<std::int32_t>{0, 2});
+  CHECK(p1 == std::vector<std::int32_t>{1});
+
+  // Interior facets have ghost dofs if either cell has
+  std::vector<std::int32_t> facets = {0, 1, 1, 2, 0, 3, 0, 0, 2, 1, 2, 0};
+  auto [q0, q1] = fem::partition_by_ghosts(fem::IntegralType::interior_facet,
+                                           dofmap, 4, facets);
+  CHECK(q0 == std::vector<std::int32_t>{0, 2});
+  CHECK(q1 == std::vector<std::int32_t>{1});
+}
+
+TEST_CASE("Vector assembly with overlapped reverse scatter",
+          "[fem][scatter_rev]")
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {5, 4, 3},
+                       mesh::CellType::tetrahedron, part));
+
+  SECTION("cell integrals")
+  {
+    auto V = create_space(mesh, 2, false);
+    auto f = std::make_shared<fem::Function<double>>(V);
+    std::span<double> fx = f->x()->mutable_array();
+    for (std::size_t i = 0; i < fx.size(); ++i)
+      fx[i] = std::sin(0.3 * i);
+    auto L = fem::create_form<double, double>(*form_poisson_L, {V},
+                                              {{"f", f}}, {}, {}, {});
+    check_scatter_rev(L);
+  }
+
+  SECTION("cell and interior facet integrals")
+  {
+    auto V = create_space(mesh, 1, true);
+    auto g = std::make_shared<fem::Function<double>>(V);
+    std::span<double> gx = g->x()->mutable_array();
+    for (std::size_t i = 0; i < gx.size(); ++i)
+      gx[i] = std::cos(0.7 * i);
+    auto L = fem::create_form<double, double>(*form_poisson_L_dg, {V},
+                                              {{"g", g}}, {}, {}, {});
+    check_scatter_rev(L);
+  }
+}
@@ -0,0 +1,90 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/geometry/AffineSimplexCache.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/generation.h>
+#include <mpi.h>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Affine simplex collisions", "[geometry][collisions]")
+{
+  auto mesh = mesh::create_box(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {5, 4, 3}, mesh::CellType::tetrahedron);
+
+  // Random points in and around the domain, and the mesh nodes, which
+  // are on cell boundaries
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(-0.1, 1.1);
+  std::vector<double> x(3000);
+  std::ranges::generate(x, [&]() { return dist(gen); });
+  std::span<const double> x_g = mesh.geometry().x();
+  x.insert(x.end(), x_g.begin(), x_g.end());
+
+  geometry::BoundingBoxTree<double> tree(mesh, 3, std::nullopt, 1e-3);
+  graph::AdjacencyList<std::int32_t> candidates
+      = geometry::compute_collisions(tree, std::span<const double>(x));
+
+  REQUIRE(geometry::AffineSimplexCache<double>::supported(mesh));
+  geometry::AffineSimplexCache<double> cache(mesh, 2);
+  graph::AdjacencyList<std::int32_t> cells0
+      = geometry::compute_colliding_cells(mesh, candidates,
+                                          std::span<const double>(x));
+  graph::AdjacencyList<std::int32_t> cells1
+      = geometry::compute_colliding_cells(mesh, cache, candidates,
+                                          std::span<const double>(x));
+  CHECK(cells1.offsets() == cells0.offsets());
+  CHECK(cells1.array() == cells0.array());
+}
+
+TEST_CASE("Affine simplex collisions (candidate cells)",
+          "[geometry][collisions]")
+{
+  auto mesh = mesh::create_box(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {5, 4, 3}, mesh::CellType::tetrahedron);
+
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(0.2, 0.8);
+  std::vector<double> x(300);
+  std::ranges::generate(x, [&]() { return dist(gen); });
+
+  geometry::BoundingBoxTree<double> tree(mesh, 3, std::nullopt, 1e-3);
+  graph::AdjacencyList<std::int32_t> candidates
+      = geometry::compute_collisions(tree, std::span<const double>(x));
+
+  // A cache of the candidate cells only gives the same collisions as a
+  // cache of all cells
+  geometry::AffineSimplexCache<double> cache0(mesh);
+  geometry::AffineSimplexCache<double> cache1(mesh, candidates.array());
+  graph::AdjacencyList<std::int32_t> cells0
+      = geometry::compute_colliding_cells(mesh, cache0, candidates,
+                                          std::span<const double>(x));
+  graph::AdjacencyList<std::int32_t> cells1
+      = geometry::compute_colliding_cells(mesh, cache1, candidates,
+                                          std::span<const double>(x));
+  CHECK(cells1.offsets() == cells0.offsets());
+  CHECK(cells1.array() == cells0.array());
+
+  // Point ownership with a cache owned by the caller, and with the
+  // cache of the candidate cells built internally
+  geometry::PointOwnershipData<double> data0
+      = geometry::determine_point_ownership(mesh, std::span<const double>(x),
+                                            0.0, 1, 1, &cache0);
+  geometry::PointOwnershipData<double> data1
+      = geometry::determine_point_ownership(mesh, std::span<const double>(x),
+                                            0.0);
+  CHECK(data0.src_owner == data1.src_owner);
+  CHECK(data0.dest_owners == data1.dest_owners);
+  CHECK(data0.dest_cells == data1.dest_cells);
+}
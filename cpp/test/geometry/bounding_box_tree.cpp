@@ -0,0 +1,63 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/WideBoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/generation.h>
+#include <mpi.h>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+template <int N>
+void test_wide_tree(const geometry::BoundingBoxTree<double>& tree,
+                    std::span<const double> points)
+{
+  geometry::WideBoundingBoxTree<double, N> wide(tree);
+  graph::AdjacencyList<std::int32_t> ref
+      = geometry::compute_collisions(tree, points);
+  graph::AdjacencyList<std::int32_t> col
+      = geometry::compute_collisions(wide, points);
+  CHECK(col.offsets() == ref.offsets());
+  CHECK(col.array() == ref.array());
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Wide bounding box tree", "[geometry][bounding_box_tree]",
+                   std::integral_constant<int, 4>,
+                   std::integral_constant<int, 8>)
+{
+  constexpr int N = TestType::value;
+  mesh::Mesh<double> mesh = mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {13, 11},
+      mesh::CellType::triangle);
+
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> dist(-0.1, 1.1);
+  std::vector<double> points;
+  for (int i = 0; i < 500; ++i)
+    points.insert(points.end(), {dist(gen), dist(gen), 0.0});
+
+  // Cell and facet trees, the global tree and a tree with a single leaf
+  geometry::BoundingBoxTree<double> cells(mesh, 2);
+  test_wide_tree<N>(cells, points);
+  test_wide_tree<N>(geometry::BoundingBoxTree<double>(mesh, 1), points);
+  test_wide_tree<N>(cells.create_global_tree(mesh.comm()), points);
+  std::vector<std::int32_t> cell0 = {0};
+  test_wide_tree<N>(geometry::BoundingBoxTree<double>(mesh, 2, cell0),
+                    points);
+
+  // The wide tree has fewer nodes than the binary tree
+  geometry::WideBoundingBoxTree<double, N> wide(mesh, 2);
+  CHECK(wide.num_nodes() < cells.num_bboxes() / 2);
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/geometry/PointLocator.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Point locator", "[geometry][point_locator]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {12, 9},
+      mesh::CellType::triangle));
+
+  // Points at the midpoints of the owned cells, plus a point outside
+  // the domain
+  const int tdim = mesh->topology()->dim();
+  const std::int32_t num_cells
+      = mesh->topology()->index_map(tdim)->size_local();
+  std::vector<std::int32_t> cells(num_cells);
+  std::iota(cells.begin(), cells.end(), 0);
+  std::vector<double> x = mesh::compute_midpoints(*mesh, tdim, cells);
+  x.insert(x.end(), {2.0, 0.5, 0.0});
+
+  geometry::PointLocator<double> locator(mesh);
+  for (int step = 0; step < 4; ++step)
+  {
+    geometry::PointOwnershipData<double> ref
+        = geometry::determine_point_ownership(*mesh, std::span<const double>(x),
+                                              0.0);
+    geometry::PointOwnershipData<double> data
+        = locator.locate(std::span<const double>(x));
+    CHECK(data.src_owner == ref.src_owner);
+    CHECK(data.dest_owners == ref.dest_owners);
+    CHECK(data.dest_points == ref.dest_points);
+    CHECK(data.dest_cells == ref.dest_cells);
+
+    // Move the points, by less than a cell size
+    for (std::size_t i = 0; i < x.size(); i += 3)
+    {
+      x[i] += 0.021;
+      x[i + 1] -= 0.013;
+    }
+  }
+}
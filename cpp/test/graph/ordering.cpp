@@ -0,0 +1,90 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/ordering.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Graph of the vertices of an n x n x n grid, with the nodes randomly
+/// numbered, and a second (small) connected component of m nodes in a
+/// chain
+graph::AdjacencyList<std::int32_t> create_graph(std::int32_t n,
+                                                std::int32_t m)
+{
+  const std::int32_t num_grid = n * n * n;
+  std::vector<std::int32_t> label(num_grid + m);
+  std::iota(label.begin(), label.end(), 0);
+  std::mt19937 gen(0);
+  std::ranges::shuffle(label, gen);
+
+  std::vector<std::vector<std::int32_t>> edges(num_grid + m);
+  auto add = [&](std::int32_t a, std::int32_t b)
+  {
+    edges[label[a]].push_back(label[b]);
+    edges[label[b]].push_back(label[a]);
+  };
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    for (std::int32_t j = 0; j < n; ++j)
+    {
+      for (std::int32_t k = 0; k < n; ++k)
+      {
+        std::int32_t v = (i * n + j) * n + k;
+        if (i + 1 < n)
+          add(v, v + n * n);
+        if (j + 1 < n)
+          add(v, v + n);
+        if (k + 1 < n)
+          add(v, v + 1);
+      }
+    }
+  }
+  for (std::int32_t v = num_grid; v + 1 < num_grid + m; ++v)
+    add(v, v + 1);
+
+  return graph::AdjacencyList<std::int32_t>(edges);
+}
+
+bool is_permutation(std::vector<std::int32_t> map)
+{
+  std::ranges::sort(map);
+  for (std::size_t i = 0; i < map.size(); ++i)
+  {
+    if (map[i] != static_cast<std::int32_t>(i))
+      return false;
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("Threaded RCM ordering", "[graph][ordering]")
+{
+  // The grid component has more nodes than the threshold for the
+  // threaded searches (65536), and the chain fewer
+  const graph::AdjacencyList<std::int32_t> graph = create_graph(42, 100);
+  REQUIRE(graph.num_nodes() > (1 << 16));
+
+  for (bool approximate : {false, true})
+  {
+    std::vector<std::int32_t> map0
+        = graph::reorder_rcm(graph, 1, approximate);
+    CHECK(map0.size() == static_cast<std::size_t>(graph.num_nodes()));
+    CHECK(is_permutation(map0));
+
+    std::vector<std::int32_t> map1
+        = graph::reorder_rcm(graph, 4, approximate);
+    CHECK(map1 == map0);
+  }
+}
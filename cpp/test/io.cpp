@@ -13,6 +13,7 @@
 #include <dolfinx/fem/FunctionSpace.h>
 #include <dolfinx/fem/utils.h>
 #include <dolfinx/io/ADIOS2Writers.h>
+#include <dolfinx/io/vtk_utils.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/generation.h>
 #include <mpi.h>
@@ -53,6 +54,109 @@ void test_vtx_reuse_mesh()
 
   writer.write(1);
 }
+
+template <std::floating_point T>
+void test_vtx_mesh_cache()
+{
+  auto mesh = std::make_shared<mesh::Mesh<T>>(
+      mesh::create_rectangle<T>(MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}},
+                                {8, 5}, mesh::CellType::quadrilateral));
+  basix::FiniteElement e = basix::create_element<T>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh::CellType::quadrilateral), 2,
+      basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<T>>(fem::create_functionspace<T>(
+      mesh, std::make_shared<fem::FiniteElement<T>>(e)));
+  auto u = std::make_shared<fem::Function<T>>(V);
+  auto w = std::make_shared<fem::Function<T>>(V);
+  u->name = "u";
+  w->name = "w";
+
+  // Writers for different fields that share the topology
+  auto cache = std::make_shared<io::VTXMeshCache<T>>();
+  std::string suffix = std::to_string(sizeof(T)) + ".bp";
+  io::VTXWriter<T> writer0(mesh->comm(), "test_vtx_cache_u" + suffix, {u},
+                           "BPFile", io::VTXMeshPolicy::update);
+  io::VTXWriter<T> writer1(mesh->comm(), "test_vtx_cache_w" + suffix, {w},
+                           "BPFile", io::VTXMeshPolicy::update);
+  writer0.set_mesh_cache(cache);
+  writer1.set_mesh_cache(cache);
+  for (double t : {0.0, 1.0})
+  {
+    writer0.write(t);
+    writer1.write(t);
+  }
+
+  // The cached topology is that of the VTK mesh of the space
+  const io::VTXTopology& topology = cache->topology(*V);
+  auto [x, xshape, x_id, x_ghost, vtk, vtkshape] = io::vtk_mesh_from_space(*V);
+  REQUIRE(topology.shape[0] == vtkshape[0]);
+  REQUIRE(topology.shape[1] == vtkshape[1] + 1);
+  REQUIRE(topology.x_id == x_id);
+  REQUIRE(topology.x_ghost == x_ghost);
+  for (std::size_t c = 0; c < vtkshape[0]; ++c)
+  {
+    CHECK(topology.cells[c * topology.shape[1]]
+          == std::int64_t(vtkshape[1]));
+    for (std::size_t i = 0; i < vtkshape[1]; ++i)
+    {
+      CHECK(topology.cells[c * topology.shape[1] + i + 1]
+            == vtk[c * vtkshape[1] + i]);
+    }
+  }
+  CHECK(&cache->topology(*V) == &topology);
+}
+
+template <std::floating_point T>
+void test_vtx_cell_subset()
+{
+  auto mesh = std::make_shared<mesh::Mesh<T>>(
+      mesh::create_rectangle<T>(MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}},
+                                {12, 9}, mesh::CellType::triangle));
+  basix::FiniteElement e = basix::create_element<T>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh::CellType::triangle), 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<T>>(fem::create_functionspace<T>(
+      mesh, std::make_shared<fem::FiniteElement<T>>(e)));
+  auto u = std::make_shared<fem::Function<T>>(V);
+
+  // Every other owned cell
+  std::vector<std::int32_t> cells;
+  const std::int32_t num_cells
+      = mesh->topology()->index_map(mesh->topology()->dim())->size_local();
+  for (std::int32_t c = 0; c < num_cells; c += 2)
+    cells.push_back(c);
+
+  std::string suffix = std::to_string(sizeof(T)) + ".bp";
+  io::VTXWriter<T> writer(mesh->comm(), "test_vtx_subset" + suffix, {u},
+                          "BPFile", io::VTXMeshPolicy::reuse);
+  writer.set_cells(cells);
+  writer.write(0);
+  writer.write(1);
+  CHECK_THROWS(writer.set_cells(cells));
+
+  // The restricted cells have the nodes of the full cells
+  io::VTXTopology topology = io::impl_vtx::vtx_topology(*V);
+  auto [nodes, sub] = io::impl_vtx::vtx_restrict(topology, cells);
+  REQUIRE(sub.shape[0] == cells.size());
+  REQUIRE(sub.shape[1] == topology.shape[1]);
+  REQUIRE(std::ranges::is_sorted(nodes));
+  REQUIRE(sub.x_id.size() == nodes.size());
+  const std::size_t row = topology.shape[1];
+  for (std::size_t c = 0; c < cells.size(); ++c)
+  {
+    CHECK(sub.cells[c * row] == topology.cells[cells[c] * row]);
+    for (std::size_t i = 1; i < row; ++i)
+    {
+      std::int64_t n = topology.cells[cells[c] * row + i];
+      CHECK(nodes[sub.cells[c * row + i]] == n);
+      CHECK(sub.x_id[sub.cells[c * row + i]] == topology.x_id[n]);
+    }
+  }
+}
 } // namespace
 
 TEST_CASE("VTX reuse mesh")
@@ -61,4 +165,16 @@ TEST_CASE("VTX reuse mesh")
   CHECK_NOTHROW(test_vtx_reuse_mesh<double>());
 }
 
+TEST_CASE("VTX cell subset")
+{
+  CHECK_NOTHROW(test_vtx_cell_subset<float>());
+  CHECK_NOTHROW(test_vtx_cell_subset<double>());
+}
+
+TEST_CASE("VTX mesh cache")
+{
+  test_vtx_mesh_cache<float>();
+  test_vtx_mesh_cache<double>();
+}
+
 #endif
@@ -0,0 +1,86 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/io/cells.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Cell permutation kernels", "[io][cells]")
+{
+  std::mt19937 rng(12);
+
+  // Numbers of nodes with a fixed-size kernel, and sizes (5, 7) that
+  // use the runtime-sized kernel
+  for (std::size_t n : {2, 3, 4, 5, 6, 7, 8, 9, 10, 27})
+  {
+    const std::size_t num_cells = 11;
+    std::vector<std::int64_t> cells(num_cells * n);
+    std::iota(cells.begin(), cells.end(), 100);
+    std::ranges::shuffle(cells, rng);
+    std::vector<std::uint16_t> p(n);
+    std::iota(p.begin(), p.end(), 0);
+    std::ranges::shuffle(p, rng);
+
+    // Reference permutation
+    std::vector<std::int64_t> cells_p(cells.size());
+    for (std::size_t c = 0; c < num_cells; ++c)
+      for (std::size_t i = 0; i < n; ++i)
+        cells_p[c * n + i] = cells[c * n + p[i]];
+
+    const std::array<std::size_t, 2> shape = {num_cells, n};
+    CHECK(io::cells::apply_permutation(cells, shape, p) == cells_p);
+    std::vector<std::int64_t> cells1 = cells;
+    io::cells::apply_permutation_inplace(cells1, shape, p);
+    CHECK(cells1 == cells_p);
+
+    // The transpose undoes the permutation
+    io::cells::apply_permutation_inplace(cells1, shape,
+                                         io::cells::transpose(p));
+    CHECK(cells1 == cells);
+
+    // Identity
+    std::vector<std::uint16_t> identity(n);
+    std::iota(identity.begin(), identity.end(), 0);
+    CHECK(io::cells::apply_permutation(cells, shape, identity) == cells);
+    io::cells::apply_permutation_inplace(cells1, shape, identity);
+    CHECK(cells1 == cells);
+  }
+
+  // Runtime-sized loop for no cells
+  std::vector<std::int64_t> empty;
+  std::vector<std::uint16_t> p = {1, 0, 2, 4, 3};
+  CHECK(io::cells::apply_permutation(empty, {0, 5}, p).empty());
+  io::cells::apply_permutation_inplace(empty, {0, 5}, p);
+  CHECK(empty.empty());
+}
+
+TEST_CASE("Cached VTK permutations", "[io][cells]")
+{
+  // Cached permutations are the same on later calls, and are
+  // permutations
+  for (auto [type, n] : std::vector<std::pair<mesh::CellType, int>>{
+           {mesh::CellType::triangle, 6},
+           {mesh::CellType::tetrahedron, 10},
+           {mesh::CellType::hexahedron, 27}})
+  {
+    std::vector<std::uint16_t> p = io::cells::perm_vtk(type, n);
+    CHECK(io::cells::perm_vtk(type, n) == p);
+    std::vector<std::uint16_t> q = p;
+    std::ranges::sort(q);
+    std::vector<std::uint16_t> identity(n);
+    std::iota(identity.begin(), identity.end(), 0);
+    CHECK(q == identity);
+  }
+}
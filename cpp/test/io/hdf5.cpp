@@ -0,0 +1,76 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/io/HDF5Interface.h>
+#include <dolfinx/io/XDMFFile.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <hdf5.h>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Read the local rows of a dataset with the default block size and
+// with blocks of at most max_block_bytes, and compare
+template <typename T>
+void check_read_blocks(hid_t h5_id, const std::string& path,
+                       std::size_t max_block_bytes)
+{
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  std::vector<std::int64_t> shape = io::hdf5::get_dataset_shape(h5_id, path);
+  REQUIRE(shape.size() == 2);
+  std::array<std::int64_t, 2> range
+      = dolfinx::MPI::local_range(rank, shape[0], size);
+
+  hid_t dset_id = io::hdf5::open_dataset(h5_id, path);
+  std::vector<T> data0 = io::hdf5::read_dataset<T>(dset_id, range, true);
+  CHECK((std::int64_t)data0.size() == (range[1] - range[0]) * shape[1]);
+  CHECK(io::hdf5::read_dataset<T>(dset_id, range, true, max_block_bytes)
+        == data0);
+
+  // All rows, and no rows
+  std::vector<T> data1 = io::hdf5::read_dataset<T>(dset_id, {-1, -1}, true);
+  CHECK((std::int64_t)data1.size() == shape[0] * shape[1]);
+  CHECK(io::hdf5::read_dataset<T>(dset_id, {-1, -1}, true, max_block_bytes)
+        == data1);
+  CHECK(io::hdf5::read_dataset<T>(dset_id, {range[0], range[0]}, true,
+                                  max_block_bytes)
+            .empty());
+  H5Dclose(dset_id);
+}
+} // namespace
+
+TEST_CASE("Read HDF5 datasets in blocks", "[io][hdf5]")
+{
+  mesh::Mesh<double> mesh = mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {5, 4, 3},
+      mesh::CellType::tetrahedron);
+  {
+    io::XDMFFile file(MPI_COMM_WORLD, "hdf5_read_blocks.xdmf", "w");
+    file.write_mesh(mesh);
+  }
+
+  // Blocks of one row, and of a few rows
+  const bool use_mpi_io = dolfinx::MPI::size(MPI_COMM_WORLD) > 1;
+  hid_t h5_id = io::hdf5::open_file(MPI_COMM_WORLD, "hdf5_read_blocks.h5",
+                                    "r", use_mpi_io);
+  for (std::size_t max_block_bytes : {1, 100})
+  {
+    check_read_blocks<std::int64_t>(h5_id, "/Mesh/mesh/topology",
+                                    max_block_bytes);
+    check_read_blocks<double>(h5_id, "/Mesh/mesh/geometry", max_block_bytes);
+  }
+  io::hdf5::close_file(h5_id);
+}
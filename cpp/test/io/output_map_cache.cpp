@@ -0,0 +1,133 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/io/VTKFile.h>
+#include <dolfinx/io/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Create a Lagrange space of degree k with block size bs
+std::shared_ptr<fem::FunctionSpace<double>>
+create_space(std::shared_ptr<mesh::Mesh<double>> mesh, int k, int bs)
+{
+  basix::FiniteElement e = basix::create_element<double>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh::CellType::triangle), k,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  std::optional<std::vector<std::size_t>> shape;
+  if (bs > 1)
+    shape = std::vector<std::size_t>{std::size_t(bs)};
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(e, shape)));
+}
+
+// Set u to a function of its dof index and t
+void set_values(fem::Function<double>& u, double t)
+{
+  std::span<double> x = u.x()->mutable_array();
+  for (std::size_t i = 0; i < x.size(); ++i)
+    x[i] = t + 0.5 * i;
+}
+
+// Contents of the VTU file of the calling rank for a step
+std::string read_vtu(const std::string& stem, int step)
+{
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  std::string counter = std::to_string(step);
+  counter.insert(0, 6 - counter.size(), '0');
+  std::ifstream f(stem + "_p" + std::to_string(rank) + "_" + counter
+                  + ".vtu");
+  std::stringstream s;
+  s << f.rdbuf();
+  return s.str();
+}
+
+// Write u at time t with a new VTKFile, and return the VTU contents
+std::string write_uncached(const std::string& stem,
+                           const fem::Function<double>& u, double t)
+{
+  io::VTKFile file(MPI_COMM_WORLD, stem + ".pvd", "w");
+  file.write<double>({u}, t);
+  file.close();
+  return read_vtu(stem, 0);
+}
+} // namespace
+
+TEST_CASE("Output map cache", "[io]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD,
+                                     {{{0.0, 0.0}, {1.0, 1.0}}}, {6, 4},
+                                     mesh::CellType::triangle));
+  auto V = create_space(mesh, 1, 1);
+  auto W = create_space(mesh, 1, 2);
+  fem::Function<double> u(V);
+  fem::Function<double> w(W);
+  u.name = "u";
+  w.name = "w";
+
+  // Write twice with the cached maps, and after the written space
+  // changes, and compare with writes without cached maps
+  io::VTKFile file(MPI_COMM_WORLD, "output_map_cache.pvd", "w");
+  std::vector<std::string> expected;
+  set_values(u, 0);
+  file.write<double>({u}, 0.0);
+  expected.push_back(write_uncached("output_map_cache_ref", u, 0.0));
+  set_values(u, 1);
+  file.write<double>({u}, 1.0);
+  expected.push_back(write_uncached("output_map_cache_ref", u, 1.0));
+  set_values(w, 2);
+  file.write<double>({w}, 2.0);
+  expected.push_back(write_uncached("output_map_cache_ref", w, 2.0));
+  file.close();
+  for (int step = 0; step < 3; ++step)
+  {
+    CHECK(!expected[step].empty());
+    CHECK(read_vtu("output_map_cache", step) == expected[step]);
+  }
+
+  // Maps of destroyed dofmaps are dropped on the next access
+  io::OutputMapCache cache;
+  int num_computed = 0;
+  auto compute = [&num_computed]()
+  {
+    ++num_computed;
+    return std::vector<std::int32_t>{0, 1};
+  };
+  {
+    auto V1 = create_space(mesh, 2, 1);
+    cache(V1->dofmap(), mesh, compute);
+    cache(V1->dofmap(), mesh, compute);
+    CHECK(num_computed == 1);
+    CHECK(cache.size() == 1);
+  }
+  cache(V->dofmap(), mesh, compute);
+  CHECK(num_computed == 2);
+  CHECK(cache.size() == 1);
+}
@@ -0,0 +1,102 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#ifdef HAS_PETSC
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/petsc.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/petsc.h>
+#include <dolfinx/mesh/generation.h>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <optional>
+#include <petscmat.h>
+#include <string>
+#include <vector>
+
+using namespace dolfinx;
+
+#if !defined(PETSC_USE_COMPLEX) and defined(PETSC_USE_REAL_DOUBLE)
+namespace
+{
+/// Assemble a bilinear form with MatSetValuesLocal and with the COO
+/// interface, and check that the matrices are equal
+void test_matrix_coo(const ufcx_form& ufcx_a,
+                     std::optional<std::vector<std::size_t>> shape, int degree)
+{
+  PetscBool initialized;
+  PetscInitialized(&initialized);
+  if (!initialized)
+    PetscInitializeNoArguments();
+
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 3},
+                       mesh::CellType::tetrahedron));
+  auto element = std::make_shared<const fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::tetrahedron, degree,
+          basix::element::lagrange_variant::unset,
+          basix::element::dpc_variant::unset, false),
+      shape);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(mesh, element));
+  std::map<std::string, std::shared_ptr<const fem::Constant<double>>>
+      constants;
+  if (!shape)
+    constants["kappa"] = std::make_shared<fem::Constant<double>>(1.5);
+  auto a = fem::create_form<double, double>(ufcx_a, {V, V}, {}, constants,
+                                            {}, {});
+  const int bs = V->dofmap()->index_map_bs();
+
+  Mat A0 = fem::petsc::create_matrix(a);
+  MatZeroEntries(A0);
+  fem::assemble_matrix(
+      la::petsc::Matrix::set_block_expand_fn(A0, bs, bs, ADD_VALUES), a, {});
+  MatAssemblyBegin(A0, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(A0, MAT_FINAL_ASSEMBLY);
+
+  // Assemble twice through the COO interface, checking that the values
+  // are overwritten
+  Mat A1 = fem::petsc::create_matrix(a);
+  {
+    la::petsc::MatrixCOO coo(A1, {bs, bs});
+    fem::assemble_matrix(coo.record_fn(), a, {});
+    coo.finalize();
+    for (int i = 0; i < 2; ++i)
+    {
+      fem::assemble_matrix(coo.set_fn(), a, {});
+      coo.assemble();
+    }
+  }
+
+  PetscReal norm0 = 0, norm1 = 0;
+  MatNorm(A0, NORM_FROBENIUS, &norm0);
+  MatAXPY(A1, -1, A0, DIFFERENT_NONZERO_PATTERN);
+  MatNorm(A1, NORM_FROBENIUS, &norm1);
+  CHECK(norm0 > 0);
+  CHECK(norm1 < 1e-12 * norm0);
+
+  MatDestroy(&A0);
+  MatDestroy(&A1);
+}
+} // namespace
+
+TEST_CASE("PETSc COO matrix assembly", "[petsc][la_matrix]")
+{
+  CHECK_NOTHROW(test_matrix_coo(*form_poisson_a, std::nullopt, 2));
+  CHECK_NOTHROW(
+      test_matrix_coo(*form_poisson_a_vec, std::vector<std::size_t>{3}, 1));
+}
+#endif
+#endif
@@ -8,16 +8,34 @@
 
 #include "poisson.h"
 #include <algorithm>
+#include <array>
 #include <basix/mdspan.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
 #include <dolfinx.h>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/Agglomeration.h>
+#include <dolfinx/la/BlockDiagonalMatrix.h>
+#include <dolfinx/la/BlockMatrixCSR.h>
+#include <dolfinx/la/BlockVector.h>
 #include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/MatrixSELL.h>
+#include <dolfinx/la/MultiVector.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/la/Vector.h>
+#include <dolfinx/la/krylov.h>
+#include <dolfinx/la/smoothers.h>
+#include <dolfinx/nls/NewtonKrylovSolver.h>
+#include <functional>
+#include <map>
 #include <mpi.h>
+#include <numeric>
+#include <optional>
 #include <span>
+#include <tuple>
+#include <vector>
 
 using namespace dolfinx;
 
@@ -25,8 +43,9 @@ namespace
 {
 /// @brief Create a matrix operator
 /// @param comm The communicator to builf the matrix on
+/// @param num_threads Number of threads to use in assembly
 /// @return The assembled matrix
-la::MatrixCSR<double> create_operator(MPI_Comm comm)
+la::MatrixCSR<double> create_operator(MPI_Comm comm, int num_threads = 1)
 {
   auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
   auto mesh = std::make_shared<mesh::Mesh<double>>(
@@ -50,7 +69,7 @@ la::MatrixCSR<double> create_operator(MPI_Comm comm)
   la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
   sp.finalize();
   la::MatrixCSR<double> A(sp);
-  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  fem::assemble_matrix(A.mat_add_values(), *a, {}, num_threads);
   A.scatter_rev();
 
   return A;
@@ -63,6 +82,510 @@ la::MatrixCSR<double> create_operator(MPI_Comm comm)
   CHECK(A1.squared_norm() == Catch::Approx(A0.squared_norm()).epsilon(1e-8));
 }
 
+[[maybe_unused]] void test_matrix_threaded()
+{
+  la::MatrixCSR A0 = create_operator(MPI_COMM_WORLD, 1);
+  la::MatrixCSR A1 = create_operator(MPI_COMM_WORLD, 4);
+  auto& a0 = A0.values();
+  auto& a1 = A1.values();
+  REQUIRE(a0.size() == a1.size());
+  for (std::size_t i = 0; i < a0.size(); ++i)
+    CHECK(a1[i] == Catch::Approx(a0[i]).margin(1e-12));
+}
+
+/// @brief Create a batched kernel of width W that executes a
+/// (non-batched) kernel for each lane.
+template <int W>
+auto create_batched_kernel(
+    std::function<void(double*, const double*, const double*, const double*,
+                       const int*, const std::uint8_t*, void*)>
+        kernel,
+    std::size_t num_A, std::size_t num_w, std::size_t num_x)
+{
+  return [=](double* A, const double* w, const double* c, const double* x,
+             const int* e, const std::uint8_t* p, void* data)
+  {
+    std::vector<double> Ae(num_A), we(num_w), xe(num_x);
+    for (int lane = 0; lane < W; ++lane)
+    {
+      for (std::size_t i = 0; i < num_w; ++i)
+        we[i] = w[i * W + lane];
+      for (std::size_t i = 0; i < num_x; ++i)
+        xe[i] = x[i * W + lane];
+      std::ranges::fill(Ae, 0);
+      kernel(Ae.data(), we.data(), c, xe.data(), e ? e + lane : nullptr,
+             p ? p + lane : nullptr, data);
+      for (std::size_t i = 0; i < num_A; ++i)
+        A[i * W + lane] += Ae[i];
+    }
+  };
+}
+
+[[maybe_unused]] void test_matrix_batched()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {7, 6, 5},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  // Create a form with the same cell integral, executed using a batched
+  // kernel
+  std::map<std::tuple<fem::IntegralType, int, int>,
+           fem::integral_data<double>>
+      integrals;
+  const std::size_t num_dofs = V->dofmap()->map().extent(1);
+  const std::size_t num_x_dofs = mesh->geometry().dofmap().extent(1);
+  for (int id : a->integral_ids(fem::IntegralType::cell))
+  {
+    auto kernel = a->kernel(fem::IntegralType::cell, id, 0);
+    std::span cells = a->domain(fem::IntegralType::cell, id, 0);
+    fem::integral_data<double> integral(
+        kernel, std::vector<std::int32_t>(cells.begin(), cells.end()),
+        std::vector<int>{});
+    integral.kernel_batch = create_batched_kernel<8>(
+        kernel, num_dofs * num_dofs, 0, 3 * num_x_dofs);
+    integral.batch_size = 8;
+    integrals.insert({{fem::IntegralType::cell, id, 0}, std::move(integral)});
+  }
+  fem::Form<double, double> a_b({V, V}, std::move(integrals), mesh, {},
+                                a->constants(), false, {});
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp), A1(sp);
+  fem::assemble_matrix(A0.mat_add_values(), *a, {});
+  fem::assemble_matrix(A1.mat_add_values(), a_b, {});
+
+  auto& a0 = A0.values();
+  auto& a1 = A1.values();
+  REQUIRE(a0.size() == a1.size());
+  for (std::size_t i = 0; i < a0.size(); ++i)
+    CHECK(a1[i] == Catch::Approx(a0[i]).margin(1e-12));
+}
+
+[[maybe_unused]] void test_matrix_scatter_rev()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {7, 6, 5},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp), A1(sp);
+  fem::assemble_matrix(A0.mat_add_values(), *a, {});
+  A0.scatter_rev();
+  fem::assemble_matrix_scatter_rev(A1, *a, {});
+
+  auto& a0 = A0.values();
+  auto& a1 = A1.values();
+  REQUIRE(a0.size() == a1.size());
+  for (std::size_t i = 0; i < a0.size(); ++i)
+    CHECK(a1[i] == Catch::Approx(a0[i]).margin(1e-12));
+}
+
+[[maybe_unused]] void test_matrix_streamed()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {7, 6, 5},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  A.scatter_rev();
+
+  // Compare each streamed block with the owned rows of A
+  auto map0 = A.index_map(0);
+  auto map1 = A.index_map(1);
+  const std::int64_t row_offset = map0->local_range()[0];
+  std::int64_t next_row = row_offset;
+  auto check_block = [&](std::int64_t row0, std::span<const std::int64_t> ptr,
+                         std::span<const std::int64_t> cols,
+                         std::span<const double> values)
+  {
+    CHECK(row0 == next_row);
+    CHECK(ptr.size() <= 101);
+    next_row += ptr.size() - 1;
+    for (std::size_t i = 0; i + 1 < ptr.size(); ++i)
+    {
+      std::int32_t row = row0 - row_offset + i;
+      auto c = std::span(A.cols()).subspan(
+          A.row_ptr()[row], A.row_ptr()[row + 1] - A.row_ptr()[row]);
+      REQUIRE(ptr[i + 1] - ptr[i] == (std::int64_t)c.size());
+      std::vector<std::int64_t> gcols(c.size());
+      map1->local_to_global(c, gcols);
+      auto block_cols = cols.subspan(ptr[i], c.size());
+      CHECK(std::ranges::is_sorted(block_cols));
+      for (std::size_t j = 0; j < c.size(); ++j)
+      {
+        auto it = std::ranges::lower_bound(block_cols, gcols[j]);
+        REQUIRE(it != block_cols.end());
+        CHECK(*it == gcols[j]);
+        CHECK(values[ptr[i] + std::distance(block_cols.begin(), it)]
+              == Catch::Approx(A.values()[A.row_ptr()[row] + j])
+                     .margin(1e-12));
+      }
+    }
+  };
+  fem::assemble_matrix_streamed<double, double>(check_block, *a, {}, 100);
+  CHECK(next_row == row_offset + map0->size_local());
+}
+
+[[maybe_unused]] void test_matrix_offsets()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {7, 6, 5},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp), A1(sp);
+  fem::assemble_matrix(A0.mat_add_values(), *a, {});
+
+  // Assemble twice using precomputed offsets
+  auto offsets = fem::create_csr_offsets(*a, A1);
+  fem::assemble_matrix(A1, *a, {}, 1, std::cref(offsets));
+  fem::assemble_matrix(A1, *a, {}, 1, std::cref(offsets));
+
+  auto& a0 = A0.values();
+  auto& a1 = A1.values();
+  REQUIRE(a0.size() == a1.size());
+  for (std::size_t i = 0; i < a0.size(); ++i)
+    CHECK(a1[i] == Catch::Approx(2 * a0[i]).margin(1e-12));
+}
+
+[[maybe_unused]] void test_matrix_symmetric()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {5, 4, 6},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  la::SparsityPattern sp0 = fem::create_sparsity_pattern(*a);
+  sp0.finalize();
+  la::SparsityPattern sp1 = fem::create_sparsity_pattern(*a);
+  sp1.finalize();
+  sp1.drop_lower_triangle();
+  CHECK(sp1.symmetric());
+  CHECK(sp1.num_nonzeros() < sp0.num_nonzeros());
+
+  la::MatrixCSR<double> A0(sp0), A1(sp1);
+  CHECK(A1.symmetric());
+  fem::assemble_matrix(A0.mat_add_values(), *a, {});
+  fem::assemble_matrix(A1.mat_add_values(), *a, {});
+  A0.scatter_rev();
+  A1.scatter_rev();
+  CHECK(A1.squared_norm() == Catch::Approx(A0.squared_norm()));
+
+  la::Vector<double> x(A0.index_map(1), 1), y0(A0.index_map(0), 1),
+      y1(A1.index_map(0), 1);
+  la::Vector<double> x1(A1.index_map(1), 1);
+  const std::int64_t offset = A0.index_map(1)->local_range()[0];
+  for (std::int32_t i = 0; i < A0.index_map(1)->size_local(); ++i)
+  {
+    x.mutable_array()[i] = std::sin(0.1 * (offset + i));
+    x1.mutable_array()[i] = x.array()[i];
+  }
+  A0.mult(x, y0);
+  A1.mult(x1, y1);
+  for (std::int32_t i = 0; i < A0.num_owned_rows(); ++i)
+    CHECK(y1.array()[i] == Catch::Approx(y0.array()[i]).margin(1e-12));
+}
+
+[[maybe_unused]] void test_matrix_block_size()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}},
+                       {4, 3, 3}, mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  std::shared_ptr<const fem::DofMap> dofmap = V->dofmap();
+  auto map = dofmap->index_map;
+
+  // Products with the fixed block size kernels (bs = 2, 3, 4, 6) and
+  // the generic kernel (bs = 5) must match the generic kernel
+  for (int bs : {2, 3, 4, 5, 6})
+  {
+    la::SparsityPattern sp(MPI_COMM_WORLD, {map, map}, {bs, bs});
+    for (std::int32_t c = 0; c < mesh->topology()->index_map(3)->size_local();
+         ++c)
+    {
+      sp.insert(dofmap->cell_dofs(c), dofmap->cell_dofs(c));
+    }
+    sp.finalize();
+
+    la::MatrixCSR<double> A(sp);
+    for (std::size_t i = 0; i < A.values().size(); ++i)
+      A.values()[i] = std::cos(0.37 * i);
+
+    la::Vector<double> x(map, bs), y(map, bs), y0(map, bs);
+    for (std::int32_t i = 0; i < map->size_local() * bs; ++i)
+      x.mutable_array()[i] = std::sin(0.1 * (map->local_range()[0] * bs + i));
+    A.mult(x, y);
+
+    const std::int32_t n = A.num_owned_rows();
+    std::span<const std::int64_t> row_ptr(A.row_ptr());
+    la::impl::spmv<double, -1>(std::span<const double>(A.values()),
+                               row_ptr.first(n), row_ptr.subspan(1, n),
+                               std::span<const std::int32_t>(A.cols()),
+                               x.array(), y0.mutable_array(), bs, bs);
+    for (std::int32_t i = 0; i < n * bs; ++i)
+      CHECK(y.array()[i] == Catch::Approx(y0.array()[i]).margin(1e-12));
+  }
+}
+
+[[maybe_unused]] void test_matrix_assembly_block_size()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}},
+                       {4, 3, 3}, mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(
+                    element, std::vector<std::size_t>{3})));
+  auto a = fem::create_form<double, double>(*form_poisson_a_vec, {V, V}, {},
+                                            {}, {}, {});
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+
+  // Assembly with the MatrixCSR overload, with insertion and kernels
+  // with compile-time block sizes, and through an insertion function
+  la::MatrixCSR<double> A0(sp), A1(sp), A2(sp);
+  fem::assemble_matrix(A0, a, {});
+  A0.scatter_rev();
+  auto mat_add = A1.mat_add_values<3, 3>();
+  fem::assemble_matrix(
+      [&mat_add](std::span<const std::int32_t> rows,
+                 std::span<const std::int32_t> cols,
+                 std::span<const double> vals)
+      { return mat_add(rows, cols, vals); }, a, {});
+  A1.scatter_rev();
+  fem::assemble_matrix_scatter_rev(A2, a, {});
+  REQUIRE(A1.values().size() == A0.values().size());
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+  {
+    CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+    CHECK(A2.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+  }
+
+  // The vector Laplacian couples equal components only, with the same
+  // values for each component, and has zero row sums
+  std::vector<double> A = A0.to_dense();
+  const std::size_t num_rows = A0.num_owned_rows();
+  const std::size_t ncols = 3 * V->dofmap()->index_map->size_global();
+  for (std::size_t r = 0; r < num_rows; ++r)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      std::span<const double> row(A.data() + (3 * r + k) * ncols, ncols);
+      double sum = 0;
+      for (std::size_t c = 0; c < ncols; ++c)
+      {
+        sum += row[c];
+        const int l = c % 3;
+        const double a00 = A[3 * r * ncols + c - l];
+        if (l != k)
+          CHECK(row[c] == 0.0);
+        else
+          CHECK(row[c] == Catch::Approx(a00).margin(1e-12));
+      }
+      CHECK(sum == Catch::Approx(0.0).margin(1e-10));
+    }
+  }
+}
+
+[[maybe_unused]] void test_sparsity_compressed()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}},
+                       {5, 4, 3}, mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  // Pattern with the dense block of each cell inserted
+  std::shared_ptr<const fem::DofMap> dofmap = V->dofmap();
+  la::SparsityPattern sp0(MPI_COMM_WORLD,
+                          {dofmap->index_map, dofmap->index_map}, {1, 1});
+  const std::int32_t num_cells
+      = mesh->topology()->index_map(3)->size_local()
+        + mesh->topology()->index_map(3)->num_ghosts();
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    sp0.insert(dofmap->cell_dofs(c), dofmap->cell_dofs(c));
+  sp0.finalize();
+
+  // Columns (global indices) of each row
+  auto rows = [](const la::SparsityPattern& sp)
+  {
+    auto [edges, offsets] = sp.graph();
+    std::vector<std::int64_t> cols = sp.column_indices();
+    std::vector<std::vector<std::int64_t>> rows(offsets.size() - 1);
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+      for (std::int64_t k = offsets[i]; k < offsets[i + 1]; ++k)
+        rows[i].push_back(cols[edges[k]]);
+      std::ranges::sort(rows[i]);
+    }
+    return rows;
+  };
+
+  for (int num_threads : {1, 3})
+  {
+    la::SparsityPattern sp1 = fem::create_sparsity_pattern(*a, num_threads);
+    sp1.finalize();
+    CHECK(sp1.num_nonzeros() == sp0.num_nonzeros());
+    CHECK(std::ranges::equal(sp1.off_diagonal_offsets(),
+                             sp0.off_diagonal_offsets()));
+    CHECK(rows(sp1) == rows(sp0));
+  }
+}
+
+[[maybe_unused]] void test_sparsity_cache()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}},
+                       {5, 4, 3}, mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto kappa0 = std::make_shared<fem::Constant<double>>(2.0);
+  auto kappa1 = std::make_shared<fem::Constant<double>>(3.0);
+  fem::Form<double> a0 = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa0}}, {}, {});
+  fem::Form<double> a1 = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa1}}, {}, {});
+
+  // Forms with the same spaces and domains share a pattern
+  fem::SparsityPatternCache cache;
+  std::shared_ptr p0 = cache.pattern(a0);
+  CHECK(cache.pattern(a1) == p0);
+  CHECK(cache.size() == 1);
+
+  la::MatrixCSR<double> A0 = cache.create_matrix(a0);
+  la::MatrixCSR<double> A1 = cache.create_matrix(a1);
+  CHECK(A0.cols().data() == A1.cols().data());
+  CHECK(A0.row_ptr().data() == A1.row_ptr().data());
+  CHECK(A0.values().size() == std::size_t(p0->num_nonzeros()));
+  fem::assemble_matrix(A0.mat_add_values(), a0, {});
+  fem::assemble_matrix(A1.mat_add_values(), a1, {});
+  A0.scatter_rev();
+  A1.scatter_rev();
+
+  // Compare with a matrix that does not share its structure
+  la::MatrixCSR<double> A2(*p0);
+  fem::assemble_matrix(A2.mat_add_values(), a1, {});
+  A2.scatter_rev();
+  CHECK(A2.cols().data() != A1.cols().data());
+  for (std::size_t i = 0; i < A1.values().size(); ++i)
+  {
+    CHECK(A1.values()[i] == Catch::Approx(A2.values()[i]).margin(1e-12));
+    CHECK(A1.values()[i] == Catch::Approx(1.5 * A0.values()[i]).margin(1e-12));
+  }
+
+  // Matrices that share a structure outlive the matrix they share it
+  // with
+  std::optional<la::MatrixCSR<double>> A3(std::in_place, *p0);
+  la::MatrixCSR<double> A4 = la::MatrixCSR<double>::share_structure(*A3);
+  A3.reset();
+  fem::assemble_matrix(A4.mat_add_values(), a1, {});
+  A4.scatter_rev();
+  CHECK(A4.squared_norm() == Catch::Approx(A2.squared_norm()));
+
+  cache.clear();
+  CHECK(cache.size() == 0);
+}
+
 [[maybe_unused]] void test_matrix_apply()
 {
   MPI_Comm comm = MPI_COMM_WORLD;
@@ -119,6 +642,510 @@ la::MatrixCSR<double> create_operator(MPI_Comm comm)
                         [](auto a) { REQUIRE(std::abs(a) < 1e-13); });
 }
 
+[[maybe_unused]] void test_matrix_free()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {8, 8, 8},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  // Assembled operator
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  A.scatter_rev();
+
+  // Compute y0 = A x and y1 = A x using assembled and matrix-free
+  // operators
+  auto map = V->dofmap()->index_map;
+  la::Vector<double> x(map, 1), y0(map, 1), y1(map, 1);
+  std::span<double> _x = x.mutable_array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    _x[i] = std::sin(static_cast<double>(map->local_range()[0] + i));
+  x.scatter_fwd();
+  y0.set(0);
+  A.mult(x, y0);
+
+  fem::MatrixFreeOperator<double> op(a);
+  op.apply(x, y1);
+
+  std::span<const double> _y0 = y0.array();
+  std::span<const double> _y1 = y1.array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    CHECK(_y1[i] == Catch::Approx(_y0[i]).margin(1e-10));
+
+  // Diagonal without assembly
+  la::Vector<double> d(map, 1), d1(map, 1);
+  op.diagonal(d);
+  fem::assemble_diagonal(d1, *a, {});
+  std::span<const double> _d = d.array();
+  std::span<const double> _d1 = d1.array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+  {
+    for (auto j = A.row_ptr()[i]; j < A.row_ptr()[i + 1]; ++j)
+    {
+      if (A.cols()[j] == i)
+      {
+        CHECK(_d[i] == Catch::Approx(A.values()[j]).margin(1e-10));
+        CHECK(_d1[i] == Catch::Approx(A.values()[j]).margin(1e-10));
+      }
+    }
+  }
+
+  // Threaded matrix-vector product
+  la::Vector<double> y2(map, 1);
+  y2.set(0);
+  A.mult(x, y2, 3);
+  std::span<const double> _y2 = y2.array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    CHECK(_y2[i] == Catch::Approx(_y0[i]).margin(1e-12));
+
+  // Matrix-vector product with SELL-C-sigma storage
+  la::MatrixSELL<double, 4> S(A, 32);
+  la::Vector<double> y3(map, 1);
+  y3.set(0);
+  S.mult(x, y3);
+  std::span<const double> _y3 = y3.array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    CHECK(_y3[i] == Catch::Approx(_y0[i]).margin(1e-12));
+
+  // Matrix with float values applied to double vectors
+  la::MatrixCSR<float> Af(sp);
+  fem::assemble_matrix(Af.mat_add_values_cast<double>(), *a, {});
+  Af.scatter_rev();
+  la::Vector<double> y4(map, 1);
+  y4.set(0);
+  Af.mult(x, y4);
+  std::span<const double> _y4 = y4.array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    CHECK(_y4[i] == Catch::Approx(_y0[i]).epsilon(1e-5).margin(1e-5));
+
+  // Matrix-multivector product, with vector j equal to (j + 1) x
+  const int num_vectors = 3;
+  la::MultiVector<double> X(map, 1, num_vectors), Y(map, 1, num_vectors);
+  std::span<double> _X = X.mutable_array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    for (int j = 0; j < num_vectors; ++j)
+      _X[i * num_vectors + j] = (j + 1) * _x[i];
+  Y.set(0);
+  A.mult(X, Y, 2);
+  std::span<const double> _Y = Y.array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+  {
+    for (int j = 0; j < num_vectors; ++j)
+    {
+      CHECK(_Y[i * num_vectors + j]
+            == Catch::Approx((j + 1) * _y0[i]).margin(1e-10));
+    }
+  }
+}
+
+[[maybe_unused]] void test_matrix_free_facets()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 4, 3},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, true);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a_dg, {V, V}, {}, {}, {},
+                                       {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  A.scatter_rev();
+
+  // Matrix-free action and diagonal of the cell and facet integrals
+  auto map = V->dofmap()->index_map;
+  la::Vector<double> x(map, 1), y0(map, 1), y1(map, 1), d(map, 1);
+  std::span<double> _x = x.mutable_array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    _x[i] = std::sin(static_cast<double>(map->local_range()[0] + i));
+  x.scatter_fwd();
+  A.mult(x, y0);
+
+  fem::MatrixFreeOperator<double> op(a);
+  op.apply(x, y1);
+  op.diagonal(d);
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+  {
+    CHECK(y1.array()[i] == Catch::Approx(y0.array()[i]).margin(1e-10));
+    for (auto j = A.row_ptr()[i]; j < A.row_ptr()[i + 1]; ++j)
+    {
+      if (A.cols()[j] == i)
+        CHECK(d.array()[i] == Catch::Approx(A.values()[j]).margin(1e-10));
+    }
+  }
+}
+
+[[maybe_unused]] void test_block_diagonal()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}},
+                       {4, 4, 4}, mesh::CellType::tetrahedron));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  A.scatter_rev();
+
+  // The sum of the element matrices is the assembled matrix
+  la::BlockDiagonalMatrix<double> B = fem::create_block_diagonal_matrix(*a);
+  CHECK(B.num_blocks() == mesh->topology()->index_map(3)->size_local());
+  CHECK(B.block_size() == 10);
+  fem::assemble_block_diagonal(B, *a);
+
+  auto map = V->dofmap()->index_map;
+  la::Vector<double> x(map, 1), y0(map, 1), y1(map, 1);
+  std::span<double> _x = x.mutable_array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    _x[i] = std::sin(static_cast<double>(map->local_range()[0] + i));
+  x.scatter_fwd();
+  y0.set(0);
+  A.mult(x, y0);
+  y1.set(0);
+  B.mult(x, y1);
+  y1.scatter_rev(std::plus<double>());
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    CHECK(y1.array()[i] == Catch::Approx(y0.array()[i]).margin(1e-10));
+
+  // Blocks with disjoint dofs, some of which need row pivoting, are
+  // inverted by solve()
+  const int n = 3;
+  const std::int32_t num_blocks = map->size_local() / n;
+  std::vector<std::int32_t> dofs(num_blocks * n);
+  std::iota(dofs.begin(), dofs.end(), 0);
+  la::BlockDiagonalMatrix<double> C(dofs, n);
+  constexpr std::array<double, 9> C0 = {4, 1, 0, 1, 3, 1, 0, 1, 2};
+  constexpr std::array<double, 9> C1 = {0, 1, 0, 1, 0, 1, 2, 1, 3};
+  for (std::int32_t b = 0; b < num_blocks; ++b)
+    std::ranges::copy(b % 2 == 0 ? C0 : C1, C.block(b).begin());
+  y0.set(0);
+  C.mult(x, y0);
+  C.factorize(2);
+  CHECK(C.factorized());
+  la::Vector<double> z(map, 1);
+  C.solve(y0, z, 2);
+  for (std::int32_t i = 0; i < num_blocks * n; ++i)
+    CHECK(z.array()[i] == Catch::Approx(x.array()[i]).margin(1e-12));
+}
+
+[[maybe_unused]] void test_krylov()
+{
+  la::MatrixCSR<double> A = create_operator(MPI_COMM_WORLD);
+  auto map = A.index_map(0);
+
+  // Shifted operator A + I, applied as y += (A + I) x
+  struct
+  {
+    la::MatrixCSR<double>& A;
+    void mult(la::Vector<double>& x, la::Vector<double>& y)
+    {
+      A.mult(x, y);
+      std::span<double> _y = y.mutable_array();
+      std::span<const double> _x = x.array();
+      for (std::size_t i = 0; i < _y.size(); ++i)
+        _y[i] += _x[i];
+    }
+  } op{A};
+
+  // Same operator as a callable, y = (A + I) x
+  auto action = [&op](la::Vector<double>& x, la::Vector<double>& y)
+  {
+    y.set(0);
+    op.mult(x, y);
+  };
+
+  la::Vector<double> x0(map, 1), b(map, 1), x(map, 1);
+  std::span<double> _x0 = x0.mutable_array();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+    _x0[i] = std::sin(static_cast<double>(map->local_range()[0] + i));
+  action(x0, b);
+
+  auto check = [&](int num_it)
+  {
+    CHECK(num_it > 0);
+    std::span<const double> _x = x.array();
+    for (std::int32_t i = 0; i < map->size_local(); ++i)
+      CHECK(_x[i] == Catch::Approx(_x0[i]).margin(1e-6));
+    x.set(0);
+  };
+
+  check(la::cg(x, b, action, 500, 1e-10));
+  check(la::gmres(x, b, op, 1000, 1e-10, 20));
+  check(la::bicgstab(x, b, op, 500, 1e-10));
+}
+
+[[maybe_unused]] void test_chebyshev()
+{
+  la::MatrixCSR<double> A = create_operator(MPI_COMM_WORLD);
+  auto map = A.index_map(0);
+  const std::int32_t n = map->size_local();
+
+  // Shifted operator y = (A + I) x and its diagonal
+  auto op = [&A](la::Vector<double>& x, la::Vector<double>& y)
+  {
+    y.set(0);
+    A.mult(x, y);
+    std::span<double> _y = y.mutable_array();
+    std::span<const double> _x = x.array();
+    for (std::size_t i = 0; i < _y.size(); ++i)
+      _y[i] += _x[i];
+  };
+  la::Vector<double> d(map, 1);
+  std::span<double> _d = d.mutable_array();
+  double gershgorin = 0;
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    double row_sum = 1;
+    for (auto j = A.row_ptr()[i]; j < A.row_ptr()[i + 1]; ++j)
+    {
+      row_sum += std::abs(A.values()[j]);
+      if (A.cols()[j] == i)
+        _d[i] = A.values()[j] + 1;
+    }
+    gershgorin = std::max(gershgorin, row_sum / _d[i]);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &gershgorin, 1, MPI_DOUBLE, MPI_MAX,
+                MPI_COMM_WORLD);
+
+  // The estimates lie inside the Gershgorin bound of D^{-1}(A + I)
+  auto [lmin, lmax] = la::estimate_eigenvalues(op, d, 20);
+  CHECK(lmin > 0);
+  CHECK(lmin < lmax);
+  CHECK(lmax <= gershgorin);
+
+  // Chebyshev iterations reduce the error in the D-norm
+  la::Vector<double> x0(map, 1), b(map, 1), x(map, 1);
+  std::span<double> _x0 = x0.mutable_array();
+  for (std::int32_t i = 0; i < n; ++i)
+    _x0[i] = std::sin(static_cast<double>(map->local_range()[0] + i));
+  op(x0, b);
+  auto error = [&]()
+  {
+    std::span<const double> _x = x.array();
+    double e = 0;
+    for (std::int32_t i = 0; i < n; ++i)
+      e += _d[i] * (_x[i] - _x0[i]) * (_x[i] - _x0[i]);
+    MPI_Allreduce(MPI_IN_PLACE, &e, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return std::sqrt(e);
+  };
+  x.set(0);
+  double e0 = error();
+  la::chebyshev(x, b, op, d, {lmin, 1.1 * lmax}, 20);
+  double e1 = error();
+  CHECK(e1 < 0.5 * e0);
+  la::chebyshev(x, b, op, d, {0.1 * lmax, 1.1 * lmax}, 4);
+  CHECK(error() <= e1);
+}
+
+[[maybe_unused]] void test_newton_krylov()
+{
+  la::MatrixCSR<double> A = create_operator(MPI_COMM_WORLD);
+  auto map = A.index_map(0);
+  const std::size_t n = map->size_local();
+
+  // y = (A + I) x
+  auto apply = [&A, n](la::Vector<double>& x, la::Vector<double>& y)
+  {
+    y.set(0);
+    A.mult(x, y);
+    for (std::size_t i = 0; i < n; ++i)
+      y.mutable_array()[i] += x.array()[i];
+  };
+
+  // F(x) = (A + I) x + x^3 - c, with c chosen such that x0 is the
+  // solution
+  la::Vector<double> x0(map, 1), c(map, 1), x(map, 1);
+  std::span<double> _x0 = x0.mutable_array();
+  for (std::size_t i = 0; i < n; ++i)
+    _x0[i] = std::sin(static_cast<double>(map->local_range()[0] + i));
+  x0.scatter_fwd();
+  apply(x0, c);
+  for (std::size_t i = 0; i < n; ++i)
+    c.mutable_array()[i] += std::pow(_x0[i], 3);
+
+  auto F = [&](la::Vector<double>& x, la::Vector<double>& b)
+  {
+    apply(x, b);
+    for (std::size_t i = 0; i < n; ++i)
+      b.mutable_array()[i] += std::pow(x.array()[i], 3) - c.array()[i];
+  };
+
+  auto check = [&](std::pair<int, bool> result)
+  {
+    CHECK(result.second);
+    CHECK(result.first > 0);
+    std::span<const double> _x = x.array();
+    for (std::size_t i = 0; i < n; ++i)
+      CHECK(_x[i] == Catch::Approx(_x0[i]).margin(1e-6));
+    x.set(0);
+  };
+
+  // Finite difference Jacobian action
+  nls::NewtonKrylovSolver<la::Vector<double>> solver(F);
+  solver.report = false;
+  solver.krylov_rtol = 1e-8;
+  check(solver.solve(x));
+
+  // Exact Jacobian action, J(x) v = (A + I) v + 3 x^2 v
+  solver.set_jacobian_action(
+      [&](la::Vector<double>& x, la::Vector<double>& v, la::Vector<double>& y)
+      {
+        apply(v, y);
+        for (std::size_t i = 0; i < n; ++i)
+          y.mutable_array()[i] += 3 * std::pow(x.array()[i], 2) * v.array()[i];
+      });
+  solver.krylov_method = nls::KrylovMethod::bicgstab;
+  check(solver.solve(x));
+}
+
+[[maybe_unused]] void test_block_matrix()
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}},
+                       {8, 8, 8}, mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+
+  // Block matrix [[A, A], [0, A]], with the ghost rows of all blocks
+  // accumulated in one communication
+  la::BlockMatrixCSR<double> Ab({{&sp, &sp}, {nullptr, &sp}});
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 2; ++j)
+      if (Ab.has_block(i, j))
+        fem::assemble_matrix(Ab.block(i, j).mat_add_values(), *a, {});
+  Ab.scatter_rev();
+
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  A.scatter_rev();
+  CHECK(Ab.squared_norm() == Catch::Approx(3 * A.squared_norm()));
+
+  auto map0 = A.index_map(0);
+  auto map1 = A.index_map(1);
+  la::BlockVector<double> x({{map1, 1}, {map1, 1}});
+  la::BlockVector<double> y({{map0, 1}, {map0, 1}});
+  for (int k = 0; k < 2; ++k)
+  {
+    std::span<double> _x = x.block(k).mutable_array();
+    for (std::int32_t i = 0; i < map1->size_local(); ++i)
+      _x[i] = std::sin(static_cast<double>(map1->local_range()[0] + i + k));
+  }
+  y.set(0);
+  Ab.mult(x, y);
+
+  // Reference y0 = A (x0 + x1) and y1 = A x1
+  la::Vector<double> x1(x.block(1)), x01(x.block(0)), y0(map0, 1),
+      y1(map0, 1);
+  std::ranges::transform(x01.array(), x1.array(),
+                         x01.mutable_array().begin(), std::plus{});
+  y0.set(0);
+  y1.set(0);
+  A.mult(x01, y0);
+  A.mult(x1, y1);
+  for (std::int32_t i = 0; i < map0->size_local(); ++i)
+  {
+    CHECK(y.block(0).array()[i]
+          == Catch::Approx(y0.array()[i]).margin(1e-10));
+    CHECK(y.block(1).array()[i]
+          == Catch::Approx(y1.array()[i]).margin(1e-10));
+  }
+}
+
+[[maybe_unused]] void test_matrix_agglomeration()
+{
+  la::MatrixCSR A = create_operator(MPI_COMM_WORLD);
+  auto map0 = A.index_map(0);
+  auto map1 = A.index_map(1);
+
+  la::Vector<double> x(map1, 1), y(map0, 1);
+  std::span<double> _x = x.mutable_array();
+  for (std::int32_t i = 0; i < map1->size_local(); ++i)
+    _x[i] = std::sin(static_cast<double>(map1->local_range()[0] + i));
+  y.set(0);
+  A.mult(x, y);
+
+  // Agglomerate onto one rank, and compute y = A x on the agglomerated
+  // matrix
+  la::MatrixAgglomeration<la::MatrixCSR<double>> Ag(A, 1);
+  const la::Agglomeration& rows = Ag.rows();
+  std::vector<double> yg(rows.size(), 0);
+  if (rows.is_target())
+  {
+    CHECK(rows.size() == map0->size_global());
+    const std::vector<std::int64_t>& row_ptr = Ag.row_ptr();
+    for (std::int32_t i = 0; i < rows.size(); ++i)
+    {
+      for (std::int64_t j = row_ptr[i]; j < row_ptr[i + 1]; ++j)
+        yg[i] += Ag.values()[j] * std::sin(static_cast<double>(Ag.cols()[j]));
+    }
+  }
+
+  // Scatter the agglomerated product to the owners and compare
+  la::Vector<double> y1(map0, 1);
+  rows.scatter(std::span<const double>(yg),
+               y1.mutable_array().first(map0->size_local()));
+  for (std::int32_t i = 0; i < map0->size_local(); ++i)
+    CHECK(y1.array()[i] == Catch::Approx(y.array()[i]).margin(1e-10));
+
+  // Re-gather values after scaling the matrix
+  std::ranges::transform(A.values(), A.values().begin(),
+                         [](auto a) { return 2 * a; });
+  std::vector<double> v0 = Ag.values();
+  Ag.gather(A);
+  for (std::size_t i = 0; i < v0.size(); ++i)
+    CHECK(Ag.values()[i] == 2 * v0[i]);
+}
+
 void test_matrix()
 {
   auto map0 = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, 8);
@@ -171,4 +1198,22 @@ TEST_CASE("Linear Algebra CSR Matrix", "[la_matrix]")
   CHECK_NOTHROW(test_matrix());
   CHECK_NOTHROW(test_matrix_apply());
   CHECK_NOTHROW(test_matrix_norm());
+  CHECK_NOTHROW(test_matrix_threaded());
+  CHECK_NOTHROW(test_matrix_batched());
+  CHECK_NOTHROW(test_matrix_free());
+  CHECK_NOTHROW(test_matrix_free_facets());
+  CHECK_NOTHROW(test_block_diagonal());
+  CHECK_NOTHROW(test_matrix_scatter_rev());
+  CHECK_NOTHROW(test_matrix_streamed());
+  CHECK_NOTHROW(test_matrix_offsets());
+  CHECK_NOTHROW(test_matrix_symmetric());
+  CHECK_NOTHROW(test_matrix_block_size());
+  CHECK_NOTHROW(test_matrix_assembly_block_size());
+  CHECK_NOTHROW(test_sparsity_compressed());
+  CHECK_NOTHROW(test_sparsity_cache());
+  CHECK_NOTHROW(test_krylov());
+  CHECK_NOTHROW(test_chebyshev());
+  CHECK_NOTHROW(test_newton_krylov());
+  CHECK_NOTHROW(test_block_matrix());
+  CHECK_NOTHROW(test_matrix_agglomeration());
 }
@@ -11,11 +11,13 @@
 #include <catch2/catch_test_macros.hpp>
 #include <dolfinx.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/partition.h>
 #include <dolfinx/graph/partitioners.h>
 #include <dolfinx/io/XDMFFile.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/graphbuild.h>
 #include <memory>
+#include <numeric>
 
 using namespace dolfinx;
 
@@ -154,11 +156,184 @@ void test_distributed_mesh(mesh::CellPartitionFunction partitioner)
   if (subset_comm != MPI_COMM_NULL)
     MPI_Comm_free(&subset_comm);
 }
+
+void test_geometric_partitioner()
+{
+  using T = double;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int mpi_rank = dolfinx::MPI::rank(comm);
+  const int mpi_size = dolfinx::MPI::size(comm);
+
+  // Create the vertices and triangles of a rectangle mesh, distributed
+  // by index across the ranks
+  const std::int64_t num_vertices = (N + 1) * (N + 1);
+  const std::int64_t num_cells = 2 * N * N;
+  std::vector<T> x;
+  for (std::int64_t v = num_vertices * mpi_rank / mpi_size;
+       v < num_vertices * (mpi_rank + 1) / mpi_size; ++v)
+  {
+    x.push_back(T(v % (N + 1)) / N);
+    x.push_back(T(v / (N + 1)) / N);
+  }
+
+  std::vector<std::int64_t> cells;
+  for (std::int64_t c = num_cells * mpi_rank / mpi_size;
+       c < num_cells * (mpi_rank + 1) / mpi_size; ++c)
+  {
+    std::int64_t v0 = (c / 2) / N * (N + 1) + (c / 2) % N;
+    std::int64_t v1 = c % 2 == 0 ? v0 + 1 : v0 + N + 1;
+    cells.insert(cells.end(), {v0, v1, v0 + N + 2});
+  }
+
+  auto e = std::make_shared<basix::FiniteElement<T>>(basix::create_element<T>(
+      basix::element::family::P, basix::cell::type::triangle, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false));
+  fem::CoordinateElement<T> cmap(e);
+
+  mesh::CellPartitionFunction partitioner
+      = mesh::create_geometric_cell_partitioner<T>(x, 2);
+  std::array<std::size_t, 2> xshape = {x.size() / 2, 2};
+  mesh::Mesh mesh = mesh::create_mesh(comm, comm, cells, cmap, comm, x,
+                                      xshape, partitioner);
+
+  // Check that the cells are balanced across the ranks
+  auto t = mesh.topology();
+  int tdim = t->dim();
+  std::int32_t num_cells_local = t->index_map(tdim)->size_local();
+  std::int32_t min_cells, max_cells;
+  MPI_Allreduce(&num_cells_local, &min_cells, 1, MPI_INT32_T, MPI_MIN, comm);
+  MPI_Allreduce(&num_cells_local, &max_cells, 1, MPI_INT32_T, MPI_MAX, comm);
+  CHECK(t->index_map(tdim)->size_global() == num_cells);
+  CHECK(t->index_map(0)->size_global() == num_vertices);
+  CHECK(max_cells - min_cells <= mpi_size);
+  CHECK(t->index_map(tdim)->num_ghosts() == 0);
+}
+
+void test_create_mesh_threads()
+{
+  using T = double;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int mpi_rank = dolfinx::MPI::rank(comm);
+  const int mpi_size = dolfinx::MPI::size(comm);
+
+  // Create the vertices and triangles of a rectangle mesh, distributed
+  // by index across the ranks
+  const std::int64_t num_vertices = (N + 1) * (N + 1);
+  const std::int64_t num_cells = 2 * N * N;
+  std::vector<T> x;
+  for (std::int64_t v = num_vertices * mpi_rank / mpi_size;
+       v < num_vertices * (mpi_rank + 1) / mpi_size; ++v)
+  {
+    x.push_back(T(v % (N + 1)) / N);
+    x.push_back(T(v / (N + 1)) / N);
+  }
+
+  std::vector<std::int64_t> cells;
+  for (std::int64_t c = num_cells * mpi_rank / mpi_size;
+       c < num_cells * (mpi_rank + 1) / mpi_size; ++c)
+  {
+    std::int64_t v0 = (c / 2) / N * (N + 1) + (c / 2) % N;
+    std::int64_t v1 = c % 2 == 0 ? v0 + 1 : v0 + N + 1;
+    cells.insert(cells.end(), {v0, v1, v0 + N + 2});
+  }
+
+  auto e = std::make_shared<basix::FiniteElement<T>>(basix::create_element<T>(
+      basix::element::family::P, basix::cell::type::triangle, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false));
+  fem::CoordinateElement<T> cmap(e);
+
+  // Create the mesh with one and with several threads for the local
+  // geometry passes
+  std::array<std::size_t, 2> xshape = {x.size() / 2, 2};
+  auto create = [&](int num_threads)
+  {
+    return mesh::create_mesh(
+        comm, comm, {cells}, {cmap}, comm, x, xshape,
+        mesh::create_geometric_cell_partitioner<T>(x, 2),
+        graph::reorder_gps, nullptr, num_threads);
+  };
+  mesh::Mesh<T> mesh0 = create(1);
+  for (int num_threads : {2, 3, 4})
+  {
+    mesh::Mesh<T> mesh1 = create(num_threads);
+    const mesh::Geometry<T>& g0 = mesh0.geometry();
+    const mesh::Geometry<T>& g1 = mesh1.geometry();
+    auto dofmap0 = g0.dofmap();
+    auto dofmap1 = g1.dofmap();
+    CHECK(std::ranges::equal(
+        std::span(dofmap0.data_handle(), dofmap0.size()),
+        std::span(dofmap1.data_handle(), dofmap1.size())));
+    CHECK(std::ranges::equal(g0.x(), g1.x()));
+    CHECK(std::ranges::equal(g0.input_global_indices(),
+                             g1.input_global_indices()));
+    CHECK(g0.index_map()->size_local() == g1.index_map()->size_local());
+    CHECK(std::ranges::equal(g0.index_map()->ghosts(),
+                             g1.index_map()->ghosts()));
+  }
+}
+
+void test_redistribute()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+
+  // Create a mesh with all cells on rank 0
+  auto part0 = [](MPI_Comm, int, const std::vector<mesh::CellType>&,
+                  const std::vector<std::span<const std::int64_t>>& cells)
+  {
+    return graph::regular_adjacency_list(
+        std::vector<std::int32_t>(cells.front().size() / 3, 0), 1);
+  };
+  mesh::Mesh<double> mesh0 = mesh::create_rectangle(
+      comm, {{{0.0, 0.0}, {1.0, 1.0}}}, {N, N}, mesh::CellType::triangle,
+      part0);
+
+  // Tag facets by their midpoints
+  auto topology0 = mesh0.topology();
+  topology0->create_entities(1);
+  topology0->create_connectivity(1, 2);
+  topology0->create_connectivity(2, 1);
+  std::vector<std::int32_t> facets(topology0->index_map(1)->size_local());
+  std::iota(facets.begin(), facets.end(), 0);
+  auto tag = [](auto x) -> std::int32_t
+  { return 1000 * std::round(N * x[0]) + std::round(N * x[1]); };
+  std::vector<double> x0 = mesh::compute_midpoints(mesh0, 1, facets);
+  std::vector<std::int32_t> values0;
+  for (std::size_t i = 0; i < facets.size(); ++i)
+    values0.push_back(tag(std::span(x0.data() + 3 * i, 3)));
+  mesh::MeshTags<std::int32_t> tags0(topology0, 1, facets, values0);
+
+  mesh::Mesh<double> mesh1
+      = mesh::redistribute(mesh0, mesh::create_cell_partitioner());
+  auto topology1 = mesh1.topology();
+  CHECK(topology1->index_map(2)->size_global() == 2 * N * N);
+  CHECK(topology1->index_map(2)->size_local() > 0);
+  CHECK(mesh1.geometry().index_map()->size_global() == (N + 1) * (N + 1));
+
+  // Check that all facets on the redistributed mesh get the right tag
+  topology1->create_entities(1);
+  mesh::MeshTags<std::int32_t> tags1
+      = mesh::redistribute_meshtags(tags0, mesh0, mesh1);
+  topology1->create_connectivity(1, 2);
+  topology1->create_connectivity(2, 1);
+  std::vector<double> x1
+      = mesh::compute_midpoints(mesh1, 1, tags1.indices());
+  CHECK((int)tags1.indices().size()
+        == topology1->index_map(1)->size_local()
+               + topology1->index_map(1)->num_ghosts());
+  for (std::size_t i = 0; i < tags1.indices().size(); ++i)
+    CHECK(tags1.values()[i] == tag(std::span(x1.data() + 3 * i, 3)));
+}
 } // namespace
 
 /// Create a mesh on even ranks and distribute to all ranks in mpi_comm
 TEST_CASE("Create box", "[create_box]")
 {
+  CHECK_NOTHROW(test_create_box(mesh::create_cell_partitioner(
+      mesh::GhostMode::none, graph::native::partitioner())));
 #ifdef HAS_PTSCOTCH
   CHECK_NOTHROW(test_create_box(mesh::create_cell_partitioner(
       mesh::GhostMode::none, graph::scotch::partitioner())));
@@ -181,6 +356,9 @@ TEST_CASE("Distributed Mesh", "[distributed_mesh]")
     create_mesh_file(MPI_COMM_SELF);
   MPI_Barrier(MPI_COMM_WORLD);
 
+  CHECK_NOTHROW(test_distributed_mesh(mesh::create_cell_partitioner(
+      mesh::GhostMode::none, graph::native::partitioner())));
+
 #ifdef HAS_PTSCOTCH
   CHECK_NOTHROW(test_distributed_mesh(mesh::create_cell_partitioner(
       mesh::GhostMode::none, graph::scotch::partitioner())));
@@ -194,3 +372,53 @@ TEST_CASE("Distributed Mesh", "[distributed_mesh]")
       mesh::GhostMode::none, graph::kahip::partitioner(1, 1, 0.03, false))));
 #endif
 }
+
+TEST_CASE("Geometric cell partitioner", "[geometric_partitioner]")
+{
+  CHECK_NOTHROW(test_geometric_partitioner());
+}
+
+TEST_CASE("Create mesh with threads", "[create_mesh_threads]")
+{
+  CHECK_NOTHROW(test_create_mesh_threads());
+}
+
+TEST_CASE("Redistribute mesh", "[redistribute_mesh]")
+{
+  CHECK_NOTHROW(test_redistribute());
+}
+
+TEST_CASE("Distribute in rounds", "[distribute_rounds]")
+{
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size = dolfinx::MPI::size(MPI_COMM_WORLD);
+
+  // Nodes of degree 4 with one to three destination ranks
+  const std::size_t num_nodes = 50 + 13 * rank;
+  const std::size_t degree = 4;
+  std::vector<std::int64_t> list(num_nodes * degree);
+  std::iota(list.begin(), list.end(), 1000 * rank);
+  std::vector<std::int32_t> dest_data, dest_offsets = {0};
+  for (std::size_t i = 0; i < num_nodes; ++i)
+  {
+    const int r0 = (rank + i) % size;
+    dest_data.push_back(r0);
+    for (int j = 1; j < std::min<int>(1 + i % 3, size); ++j)
+      dest_data.push_back((r0 + j) % size);
+    dest_offsets.push_back(dest_data.size());
+  }
+  graph::AdjacencyList<std::int32_t> dest(dest_data, dest_offsets);
+
+  // The result must not depend on the number of rounds
+  auto ref = graph::build::distribute(MPI_COMM_WORLD, list,
+                                      {num_nodes, degree}, dest);
+  for (std::size_t max_bytes : {1, 100, 1000, 1000000})
+  {
+    auto result = graph::build::distribute(
+        MPI_COMM_WORLD, list, {num_nodes, degree}, dest, max_bytes);
+    CHECK(std::get<0>(result) == std::get<0>(ref));
+    CHECK(std::get<1>(result) == std::get<1>(ref));
+    CHECK(std::get<2>(result) == std::get<2>(ref));
+    CHECK(std::get<3>(result) == std::get<3>(ref));
+  }
+}
@@ -6,16 +6,27 @@
 
 #include "dolfinx/mesh/generation.h"
 #include <algorithm>
+#include <array>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
+#include <cmath>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/threads.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/CompressedAdjacencyList.h>
+#include <dolfinx/graph/ordering.h>
 #include <dolfinx/graph/partitioners.h>
+#include <dolfinx/mesh/StructuredGrid.h>
 #include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/permutationcomputation.h>
 #include <dolfinx/mesh/utils.h>
 #include <iterator>
 #include <mpi.h>
+#include <numeric>
+#include <span>
+#include <utility>
 #include <vector>
 
 using namespace dolfinx;
@@ -598,3 +609,435 @@ TEMPLATE_TEST_CASE("Box tetrahedron mesh", "[mesh][box][tetrahedron]", float,
                                        /* c_4 */ {0, 5, 7, 3},
                                        /* c_5 */ {0, 7, 6, 3}});
 }
+
+TEMPLATE_TEST_CASE("Box mesh (blocked)", "[mesh][box][blocked]", float,
+                   double)
+{
+  using T = TestType;
+
+  for (auto ghost_mode : {mesh::GhostMode::none, mesh::GhostMode::shared_facet})
+  {
+    for (auto [celltype, num_sub_cells] :
+         {std::pair{mesh::CellType::hexahedron, 1},
+          std::pair{mesh::CellType::tetrahedron, 6}})
+    {
+      mesh::Mesh<T> mesh = mesh::create_box_blocked<T>(
+          MPI_COMM_WORLD, {{{0, 0, 0}, {4, 3, 5}}}, {4, 3, 5}, celltype,
+          ghost_mode);
+      auto topology = mesh.topology();
+      CHECK(topology->index_map(3)->size_global() == 60 * num_sub_cells);
+      CHECK(topology->index_map(0)->size_global() == 5 * 4 * 6);
+      if (ghost_mode == mesh::GhostMode::none)
+        CHECK(topology->index_map(3)->num_ghosts() == 0);
+
+      // The structured grid reproduces the cell-to-vertex connectivity
+      auto grid = topology->structured_grid();
+      REQUIRE(grid);
+      auto c_to_v = topology->connectivity(3, 0);
+      auto check_cells = [&c_to_v](auto cell_vertices)
+      {
+        REQUIRE(cell_vertices.num_nodes() == c_to_v->num_nodes());
+        for (std::int32_t c = 0; c < c_to_v->num_nodes(); ++c)
+          CHECK_THAT(cell_vertices.links(c), RangeEquals(c_to_v->links(c)));
+      };
+      if (celltype == mesh::CellType::hexahedron)
+      {
+        check_cells(mesh::StructuredGrid::CellVertices<8>(*grid));
+
+        // Neighbours across facets are symmetric
+        mesh::StructuredGrid::CellNeighbours<6> neighbours(*grid);
+        for (std::int32_t c = 0; c < neighbours.num_nodes(); ++c)
+        {
+          std::array<std::int32_t, 6> nbrs = neighbours.links(c);
+          for (std::size_t i = 0; i < nbrs.size(); ++i)
+          {
+            if (nbrs[i] >= 0)
+              CHECK(neighbours.links(nbrs[i])[i ^ 1] == c);
+          }
+        }
+      }
+      else
+        check_cells(mesh::StructuredGrid::CellVertices<4>(*grid));
+
+      // Vertices are at the grid points of their lexicographic input
+      // index
+      std::span<const T> x = mesh.geometry().x();
+      std::span<const std::int64_t> input_index
+          = mesh.geometry().input_global_indices();
+      for (std::size_t i = 0; i < input_index.size(); ++i)
+      {
+        std::int64_t v = input_index[i];
+        CHECK(std::abs(x[3 * i] - v % 5) <= EPS<T>);
+        CHECK(std::abs(x[3 * i + 1] - (v / 5) % 4) <= EPS<T>);
+        CHECK(std::abs(x[3 * i + 2] - v / 20) <= 4 * EPS<T>);
+      }
+
+      // Facets on the boundary of the box are the only owned facets
+      // with one cell when the mesh is ghosted
+      topology->create_entities(2);
+      CHECK(topology->index_map(2)->size_global()
+            == (celltype == mesh::CellType::hexahedron ? 3 * 60 + 47
+                                                       : 12 * 60 + 2 * 47));
+      if (ghost_mode != mesh::GhostMode::none)
+      {
+        topology->create_connectivity(2, 3);
+        auto f_to_c = topology->connectivity(2, 3);
+        int num_exterior = 0;
+        for (std::int32_t f = 0; f < topology->index_map(2)->size_local(); ++f)
+          num_exterior += f_to_c->num_links(f) == 1;
+        MPI_Allreduce(MPI_IN_PLACE, &num_exterior, 1, MPI_INT, MPI_SUM,
+                      MPI_COMM_WORLD);
+        CHECK(num_exterior
+              == (celltype == mesh::CellType::hexahedron ? 94 : 2 * 94));
+      }
+    }
+  }
+}
+
+TEST_CASE("Threaded entity computation", "[mesh][entities]")
+{
+  mesh::Mesh<double> mesh = dolfinx::mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {6, 5, 4},
+      mesh::CellType::tetrahedron);
+
+  // Compute edges and facets on copies of the topology, with and
+  // without threads
+  mesh::Topology topology0 = *mesh.topology();
+  mesh::Topology topology1 = *mesh.topology();
+  for (int dim : {1, 2})
+  {
+    topology0.create_entities(dim);
+    topology1.create_entities(dim, 4);
+    CHECK(topology0.index_map(dim)->size_global()
+          == topology1.index_map(dim)->size_global());
+    CHECK_THAT(topology0.connectivity(dim, 0)->array(),
+               RangeEquals(topology1.connectivity(dim, 0)->array()));
+    CHECK_THAT(topology0.connectivity(3, dim)->array(),
+               RangeEquals(topology1.connectivity(3, dim)->array()));
+  }
+}
+
+TEST_CASE("Threaded entity permutations", "[mesh][entities]")
+{
+  for (mesh::CellType cell_type :
+       {mesh::CellType::tetrahedron, mesh::CellType::hexahedron})
+  {
+    mesh::Mesh<double> mesh = dolfinx::mesh::create_box<double>(
+        MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {5, 4, 3}, cell_type);
+    auto topology = mesh.topology_mutable();
+    for (int d = 1; d < 3; ++d)
+      topology->create_entities(d);
+
+    auto [facet_perms0, cell_info0]
+        = mesh::compute_entity_permutations(*topology);
+    for (int num_threads : {2, 3, 4})
+    {
+      auto [facet_perms1, cell_info1]
+          = mesh::compute_entity_permutations(*topology, num_threads);
+      CHECK(facet_perms1 == facet_perms0);
+      CHECK(cell_info1 == cell_info0);
+    }
+  }
+}
+
+TEST_CASE("Threaded geometry queries", "[mesh][geometry]")
+{
+  for (mesh::CellType cell_type :
+       {mesh::CellType::tetrahedron, mesh::CellType::hexahedron})
+  {
+    mesh::Mesh<double> mesh = dolfinx::mesh::create_box<double>(
+        MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {5, 4, 3}, cell_type);
+    auto topology = mesh.topology_mutable();
+    topology->create_entities(2);
+    for (int dim : {2, 3})
+    {
+      auto map = topology->index_map(dim);
+      std::vector<std::int32_t> entities(map->size_local()
+                                         + map->num_ghosts());
+      std::iota(entities.begin(), entities.end(), 0);
+
+      // Fewer entities than the batch size and threads
+      std::span<const std::int32_t> few(entities.data(), 5);
+      for (std::span<const std::int32_t> e :
+           {std::span<const std::int32_t>(entities), few})
+      {
+        std::vector<double> h0 = mesh::h(mesh, e, dim);
+        std::vector<double> x0 = mesh::compute_midpoints(mesh, dim, e);
+        for (int num_threads : {2, 3, 4})
+        {
+          CHECK(mesh::h(mesh, e, dim, num_threads) == h0);
+          CHECK(mesh::compute_midpoints(mesh, dim, e, num_threads) == x0);
+        }
+      }
+    }
+
+    // The facets are axis-aligned, so the normal of each quadrilateral
+    // or triangle facet is a coordinate direction
+    auto map = topology->index_map(2);
+    std::vector<std::int32_t> facets(map->size_local() + map->num_ghosts());
+    std::iota(facets.begin(), facets.end(), 0);
+    std::vector<double> n0 = mesh::cell_normals(mesh, 2, facets);
+    for (int num_threads : {2, 3, 4})
+      CHECK(mesh::cell_normals(mesh, 2, facets, num_threads) == n0);
+    if (cell_type == mesh::CellType::hexahedron)
+    {
+      for (std::size_t f = 0; f < facets.size(); ++f)
+      {
+        double max = 0, sum = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+          max = std::max(max, std::abs(n0[3 * f + k]));
+          sum += std::abs(n0[3 * f + k]);
+        }
+        CHECK(std::abs(max - 1) < 1e-12);
+        CHECK(std::abs(sum - 1) < 1e-12);
+      }
+    }
+  }
+}
+
+TEST_CASE("Connectivity memory limit", "[mesh][connectivity]")
+{
+  mesh::Mesh<double> mesh = dolfinx::mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 4, 4},
+      mesh::CellType::tetrahedron);
+
+  // Compute connectivities with and without a memory limit and check
+  // that connectivities evicted from the limited topology are
+  // re-computed on access
+  mesh::Topology topology0 = *mesh.topology();
+  mesh::Topology topology1 = *mesh.topology();
+  topology1.set_connectivity_memory_limit(0);
+  std::vector<std::array<int, 2>> pairs = {{2, 3}, {0, 3}, {1, 3}, {0, 2}};
+  for (auto [d0, d1] : pairs)
+  {
+    topology0.create_connectivity(d0, d1);
+    topology1.create_connectivity(d0, d1);
+  }
+
+  CHECK(topology1.connectivity_memory() < topology0.connectivity_memory());
+  for (auto [d0, d1] : pairs)
+  {
+    auto c0 = topology0.connectivity(d0, d1);
+    auto c1 = topology1.connectivity(d0, d1);
+    REQUIRE(c1);
+    CHECK_THAT(c0->array(), RangeEquals(c1->array()));
+    CHECK_THAT(c0->offsets(), RangeEquals(c1->offsets()));
+  }
+}
+
+TEST_CASE("Connectivity memory limit threaded", "[mesh][connectivity]")
+{
+  mesh::Mesh<double> mesh = dolfinx::mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 4, 4},
+      mesh::CellType::tetrahedron);
+
+  // Request connectivities from several threads on a topology that
+  // evicts all but the most recently used connectivity, so that the
+  // threads concurrently update the access counts and re-compute
+  // evicted connectivities
+  mesh::Topology topology0 = *mesh.topology();
+  mesh::Topology topology1 = *mesh.topology();
+  topology1.set_connectivity_memory_limit(0);
+  std::vector<std::array<int, 2>> pairs = {{2, 3}, {0, 3}, {1, 3}, {0, 2}};
+  for (auto [d0, d1] : pairs)
+  {
+    topology0.create_connectivity(d0, d1);
+    topology1.create_connectivity(d0, d1);
+  }
+
+  constexpr int num_threads = 4;
+  std::vector<int> mismatch(num_threads, 0);
+  common::run_threads(
+      num_threads,
+      [&](int t)
+      {
+        for (int i = 0; i < 20; ++i)
+        {
+          auto [d0, d1] = pairs[(i + t) % pairs.size()];
+          auto c0 = topology0.connectivity(d0, d1);
+          auto c1 = topology1.connectivity(d0, d1);
+          if (!c1 or !std::ranges::equal(c0->array(), c1->array())
+              or !std::ranges::equal(c0->offsets(), c1->offsets()))
+          {
+            ++mismatch[t];
+          }
+        }
+      });
+
+  for (int m : mismatch)
+    CHECK(m == 0);
+}
+
+TEST_CASE("Exterior facets cache threaded", "[mesh][connectivity]")
+{
+  mesh::Mesh<double> mesh = dolfinx::mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 4, 4},
+      mesh::CellType::tetrahedron);
+  mesh::Topology topology = *mesh.topology();
+  const int tdim = topology.dim();
+
+  // The facets must be created before the exterior facets are computed
+  if (!topology.connectivity(tdim - 1, 0))
+    CHECK_THROWS(topology.exterior_facets());
+  topology.create_entities(tdim - 1);
+  topology.create_connectivity(tdim - 1, tdim);
+  topology.create_connectivity(tdim - 1, 0);
+
+  // Owned facets connected to one cell and not on the inter-process
+  // boundary
+  auto f_to_c = topology.connectivity(tdim - 1, tdim);
+  auto f_to_v = topology.connectivity(tdim - 1, 0);
+  const std::vector<std::int32_t>& ip_facets = topology.interprocess_facets();
+  std::vector<std::int32_t> facets, vertices;
+  for (std::int32_t f = 0; f < topology.index_map(tdim - 1)->size_local(); ++f)
+  {
+    if (f_to_c->num_links(f) == 1
+        and !std::ranges::binary_search(ip_facets, f))
+    {
+      facets.push_back(f);
+      auto v = f_to_v->links(f);
+      vertices.insert(vertices.end(), v.begin(), v.end());
+    }
+  }
+  std::ranges::sort(vertices);
+  vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                 vertices.end());
+
+  // Make the first calls concurrently
+  constexpr int num_threads = 4;
+  std::vector<int> mismatch(num_threads, 0);
+  common::run_threads(num_threads,
+                      [&](int t)
+                      {
+                        if (t % 2 == 0
+                            and !std::ranges::equal(
+                                topology.exterior_facet_vertices(0), vertices))
+                        {
+                          ++mismatch[t];
+                        }
+                        if (!std::ranges::equal(topology.exterior_facets(),
+                                                facets))
+                        {
+                          ++mismatch[t];
+                        }
+                      });
+  for (int m : mismatch)
+    CHECK(m == 0);
+
+  // Creating the existing facets again keeps the cache
+  std::span<const std::int32_t> cached = topology.exterior_facets();
+  CHECK(!topology.create_entities(tdim - 1));
+  CHECK(topology.exterior_facets().data() == cached.data());
+  CHECK(std::ranges::equal(topology.exterior_facets(), facets));
+
+  // A copy holds its own cache
+  mesh::Topology topology1 = topology;
+  CHECK(topology1.exterior_facets().data() != cached.data());
+  CHECK(std::ranges::equal(topology1.exterior_facets(), facets));
+}
+
+TEST_CASE("Compressed connectivity", "[mesh][connectivity]")
+{
+  mesh::Mesh<double> mesh = dolfinx::mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 4, 4},
+      mesh::CellType::tetrahedron);
+  auto topology = mesh.topology();
+  topology->create_connectivity(2, 3);
+  for (auto [d0, d1] : std::vector<std::array<int, 2>>{{3, 0}, {2, 3}})
+  {
+    auto c = topology->connectivity(d0, d1);
+    graph::CompressedAdjacencyList<std::int32_t> cc(*c);
+    CHECK(cc.num_nodes() == c->num_nodes());
+    CHECK(cc.decompress() == *c);
+
+    std::vector<std::int32_t> buffer;
+    std::int32_t n = cc.num_nodes() / 2;
+    CHECK(cc.num_links(n) == c->num_links(n));
+    CHECK_THAT(cc.links(n, buffer), RangeEquals(c->links(n)));
+  }
+}
+
+TEST_CASE("Regular connectivity view", "[mesh][connectivity]")
+{
+  mesh::Mesh<double> mesh = dolfinx::mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {3, 3, 3},
+      mesh::CellType::hexahedron);
+  auto c = mesh.topology()->connectivity(3, 0);
+  auto cells = graph::regular_view<8>(*c);
+  REQUIRE(cells.num_nodes() == c->num_nodes());
+  for (std::int32_t i = 0; i < cells.num_nodes(); ++i)
+    CHECK_THAT(cells.links(i), RangeEquals(c->links(i)));
+  CHECK_THROWS(graph::regular_view<4>(*c));
+}
+
+TEST_CASE("Create mesh with space-filling curve cell ordering",
+          "[mesh][reorder]")
+{
+  // Unit square mesh with n x n squares split into triangles, with the
+  // data on rank 0
+  constexpr std::int64_t n = 8;
+  std::vector<double> x;
+  std::vector<std::int64_t> cells;
+  if (dolfinx::MPI::rank(MPI_COMM_WORLD) == 0)
+  {
+    for (std::int64_t j = 0; j <= n; ++j)
+      for (std::int64_t i = 0; i <= n; ++i)
+        x.insert(x.end(), {double(i) / n, double(j) / n});
+    for (std::int64_t j = 0; j < n; ++j)
+    {
+      for (std::int64_t i = 0; i < n; ++i)
+      {
+        std::int64_t v0 = j * (n + 1) + i;
+        std::int64_t v1 = v0 + 1, v2 = v0 + n + 1, v3 = v0 + n + 2;
+        cells.insert(cells.end(), {v0, v1, v3, v0, v2, v3});
+      }
+    }
+  }
+
+  fem::CoordinateElement<double> cmap(mesh::CellType::triangle, 1);
+  for (auto reorder_fn : {graph::reorder_hilbert, graph::reorder_morton})
+  {
+    mesh::Mesh<double> mesh = mesh::create_mesh(
+        MPI_COMM_WORLD, MPI_COMM_WORLD, cells, cmap, MPI_COMM_WORLD, x,
+        {x.size() / 2, 2},
+        mesh::create_cell_partitioner(mesh::GhostMode::none),
+        graph::reorder_gps,
+        [reorder_fn](std::span<const double> midpoints)
+        { return reorder_fn(midpoints, 1); });
+    auto topology = mesh.topology();
+    CHECK(topology->index_map(2)->size_global() == 2 * n * n);
+    CHECK(topology->index_map(0)->size_global() == (n + 1) * (n + 1));
+    CHECK(mesh.geometry().index_map()->size_global() == (n + 1) * (n + 1));
+
+    // The owned cells are in curve order: re-ordering their midpoints
+    // gives the identity
+    const std::int32_t num_cells = topology->index_map(2)->size_local();
+    auto dofmap = mesh.geometry().dofmap();
+    std::span<const double> xg = mesh.geometry().x();
+    std::vector<double> midpoints(3 * num_cells, 0);
+    double area = 0;
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      std::array<const double*, 3> p;
+      for (std::size_t k = 0; k < 3; ++k)
+      {
+        p[k] = xg.data() + 3 * dofmap(c, k);
+        for (std::size_t j = 0; j < 2; ++j)
+          midpoints[3 * c + j] += p[k][j] / 3;
+      }
+      area += 0.5
+              * std::abs((p[1][0] - p[0][0]) * (p[2][1] - p[0][1])
+                         - (p[2][0] - p[0][0]) * (p[1][1] - p[0][1]));
+    }
+    std::vector<std::int32_t> identity(num_cells);
+    std::iota(identity.begin(), identity.end(), 0);
+    CHECK(reorder_fn(midpoints, 1) == identity);
+
+    // The cells cover the square once
+    double area_global = 0;
+    MPI_Allreduce(&area, &area_global, 1, MPI_DOUBLE, MPI_SUM,
+                  MPI_COMM_WORLD);
+    CHECK(std::abs(area_global - 1) < 1e-12);
+  }
+}
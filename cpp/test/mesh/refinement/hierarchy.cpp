@@ -0,0 +1,117 @@
+// Copyright (C) 2026 The DOLFINx developers
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/refinement/MeshHierarchy.h>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Set the degrees-of-freedom of a vector in V to the values of a
+/// function at the degree-of-freedom coordinates
+void interpolate(const fem::FunctionSpace<double>& V, la::Vector<double>& u,
+                 auto&& f)
+{
+  std::vector<double> x = V.tabulate_dof_coordinates(false);
+  std::span<double> _u = u.mutable_array();
+  for (std::size_t i = 0; i < _u.size(); ++i)
+    _u[i] = f(x[3 * i], x[3 * i + 1]);
+}
+
+void test_transfer(int degree, mesh::GhostMode ghost_mode)
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {5, 4},
+      mesh::CellType::triangle, mesh::create_cell_partitioner(ghost_mode)));
+
+  // Uniform and then adaptive refinement
+  refinement::MeshHierarchy<double> hierarchy(mesh);
+  hierarchy.refine();
+  auto mesh1 = hierarchy.mesh(1);
+  mesh1->topology()->create_entities(1);
+  std::vector<std::int32_t> edges(mesh1->topology()->index_map(1)->size_local()
+                                  / 4);
+  std::iota(edges.begin(), edges.end(), 0);
+  hierarchy.refine(edges);
+  CHECK(hierarchy.num_levels() == 3);
+
+  auto element = std::make_shared<const fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::triangle, degree,
+          basix::element::lagrange_variant::gll_warped,
+          basix::element::dpc_variant::unset, false));
+  auto f = [degree](double x, double y)
+  { return degree == 1 ? 1 + 2 * x - y : x * x - 3 * x * y + y; };
+
+  for (int l = 1; l < hierarchy.num_levels(); ++l)
+  {
+    auto V0 = fem::create_functionspace<double>(hierarchy.mesh(l - 1),
+                                                element);
+    auto V1 = fem::create_functionspace<double>(hierarchy.mesh(l), element);
+    la::MatrixCSR<double> P = hierarchy.create_prolongation(V0, V1);
+
+    // Prolongation is exact for functions in V0
+    la::Vector<double> u0(V0.dofmap()->index_map, 1);
+    la::Vector<double> u1(V1.dofmap()->index_map, 1);
+    la::Vector<double> u1_ex(V1.dofmap()->index_map, 1);
+    interpolate(V0, u0, f);
+    interpolate(V1, u1_ex, f);
+    P.mult(u0, u1);
+    const std::int32_t n1 = V1.dofmap()->index_map->size_local();
+    for (std::int32_t i = 0; i < n1; ++i)
+      CHECK(u1.array()[i] == Catch::Approx(u1_ex.array()[i]).margin(1e-12));
+
+    // Restriction is the transpose of the prolongation, i.e.
+    // (P u0, v1) = (u0, R v1)
+    la::Vector<double> v1(V1.dofmap()->index_map, 1);
+    la::Vector<double> w0(V0.dofmap()->index_map, 1);
+    interpolate(V1, v1, [](double x, double y) { return std::sin(5 * x + y); });
+    refinement::apply_restriction(P, v1, w0);
+
+    la::MatrixCSR<double> R = hierarchy.create_restriction(V0, V1);
+    la::Vector<double> v1r(R.index_map(1), 1);
+    la::Vector<double> w0r(V0.dofmap()->index_map, 1);
+    std::copy_n(v1.array().begin(), n1, v1r.mutable_array().begin());
+    R.mult(v1r, w0r);
+
+    const std::int32_t n0 = V0.dofmap()->index_map->size_local();
+    for (std::int32_t i = 0; i < n0; ++i)
+      CHECK(w0r.array()[i] == Catch::Approx(w0.array()[i]).margin(1e-12));
+
+    double a = la::inner_product(u1, v1);
+    double b = la::inner_product(u0, w0);
+    CHECK(a == Catch::Approx(b));
+  }
+}
+} // namespace
+
+TEST_CASE("Mesh hierarchy transfer operators", "[refinement][hierarchy]")
+{
+  CHECK_NOTHROW(test_transfer(1, mesh::GhostMode::none));
+  CHECK_NOTHROW(test_transfer(2, mesh::GhostMode::none));
+}
+
+TEST_CASE("Mesh hierarchy transfer operators (ghosted)",
+          "[refinement][hierarchy]")
+{
+  // The refinement of a ghosted mesh re-orders the refined cells
+  CHECK_NOTHROW(test_transfer(1, mesh::GhostMode::shared_facet));
+  CHECK_NOTHROW(test_transfer(2, mesh::GhostMode::shared_facet));
+}
@@ -4,9 +4,12 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <limits>
 #include <optional>
+#include <span>
 
 #include <mpi.h>
 
@@ -159,3 +162,84 @@ plotter.show()
   //                                      /* e_14 */ {6, 8},
   //                                      /* e_15 */ {7, 8}});
 }
+
+TEMPLATE_TEST_CASE("Rectangle uniform refinement (no re-partitioning)",
+                   "refinement,rectangle,uniform", double)
+{
+  using T = TestType;
+
+  mesh::Mesh<T> mesh = dolfinx::mesh::create_rectangle<T>(
+      MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {4, 3}, mesh::CellType::triangle);
+  mesh.topology()->create_entities(1);
+
+  // Children stay on the process of the parent cell
+  auto [mesh0, parent_cell, parent_facet] = refinement::refine(
+      mesh, std::nullopt, nullptr, refinement::Option::parent_cell);
+  auto [mesh1, parent_cell1, parent_facet1] = refinement::refine(
+      mesh, std::nullopt, mesh::create_cell_partitioner(mesh::GhostMode::none),
+      refinement::Option::none);
+
+  auto t = mesh.topology();
+  auto t0 = mesh0.topology();
+  auto t1 = mesh1.topology();
+  CHECK(t0->index_map(2)->size_local() == 4 * t->index_map(2)->size_local());
+  CHECK(t0->index_map(2)->num_ghosts() == 0);
+  CHECK(t0->index_map(2)->size_global() == t1->index_map(2)->size_global());
+  CHECK(t0->index_map(0)->size_global() == t1->index_map(0)->size_global());
+  REQUIRE(parent_cell);
+  CHECK(std::ranges::all_of(*parent_cell, [&t](auto c)
+                            { return c < t->index_map(2)->size_local(); }));
+
+  // Check that the geometry covers the domain
+  const mesh::Geometry<T>& geometry = mesh0.geometry();
+  std::span<const T> x = geometry.x();
+  auto dofmap = geometry.dofmap();
+  T area = 0;
+  for (std::size_t c = 0; c < dofmap.extent(0); ++c)
+  {
+    const T* x0 = x.data() + 3 * dofmap(c, 0);
+    const T* x1 = x.data() + 3 * dofmap(c, 1);
+    const T* x2 = x.data() + 3 * dofmap(c, 2);
+    area += std::abs((x1[0] - x0[0]) * (x2[1] - x0[1])
+                     - (x2[0] - x0[0]) * (x1[1] - x0[1]))
+            / 2;
+  }
+  T area_global = 0;
+  MPI_Allreduce(&area, &area_global, 1, dolfinx::MPI::mpi_t<T>, MPI_SUM,
+                MPI_COMM_WORLD);
+  CHECK_THAT(area_global, WithinAbs(1.0, 1.0e-10));
+}
+
+TEMPLATE_TEST_CASE("Rectangle adaptive refinement (threaded)",
+                   "refinement,rectangle,threads", double)
+{
+  using T = TestType;
+
+  mesh::Mesh<T> mesh = dolfinx::mesh::create_rectangle<T>(
+      MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {12, 9}, mesh::CellType::triangle);
+  mesh.topology()->create_entities(1);
+
+  std::vector<std::int32_t> edges;
+  for (std::int32_t e = 0; e < mesh.topology()->index_map(1)->size_local();
+       e += 5)
+  {
+    edges.push_back(e);
+  }
+
+  // The refinement must not depend on the number of threads
+  auto [cells0, x0, xshape0, parent_cell0, parent_facet0]
+      = refinement::plaza::compute_refinement_data(
+          mesh, std::span<const std::int32_t>(edges),
+          refinement::Option::parent_cell_and_facet, 1);
+  for (int num_threads : {2, 3})
+  {
+    auto [cells1, x1, xshape1, parent_cell1, parent_facet1]
+        = refinement::plaza::compute_refinement_data(
+            mesh, std::span<const std::int32_t>(edges),
+            refinement::Option::parent_cell_and_facet, num_threads);
+    CHECK_THAT(cells1.array(), RangeEquals(cells0.array()));
+    CHECK_THAT(x1, RangeEquals(x0));
+    CHECK_THAT(parent_cell1.value(), RangeEquals(parent_cell0.value()));
+    CHECK_THAT(parent_facet1.value(), RangeEquals(parent_facet0.value()));
+  }
+}
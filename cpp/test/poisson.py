@@ -3,12 +3,18 @@ from ufl import (
     Coefficient,
     Constant,
     FunctionSpace,
+    FacetNormal,
     Mesh,
     TestFunction,
     TrialFunction,
+    avg,
+    dS,
+    derivative,
+    ds,
     dx,
     grad,
     inner,
+    jump,
 )
 
 e = element("Lagrange", "tetrahedron", 2)
@@ -23,3 +29,32 @@ f = Coefficient(V)
 kappa = Constant(mesh)
 
 a = kappa * inner(grad(u), grad(v)) * dx
+L = f * v * dx
+
+# Nonlinear residual and its Jacobian, which share the coefficient f
+F = (1 + f**2) * inner(grad(f), grad(v)) * dx
+J = derivative(F, f, u)
+
+# Interior penalty operator on a discontinuous space, with cell,
+# exterior facet and interior facet integrals
+e_dg = element("DG", "tetrahedron", 1)
+W = FunctionSpace(mesh, e_dg)
+w = TrialFunction(W)
+q = TestFunction(W)
+n = FacetNormal(mesh)
+a_dg = (
+    inner(grad(w), grad(q)) * dx
+    - inner(avg(grad(w)), jump(q, n)) * dS
+    + 10 * inner(jump(w), jump(q)) * dS
+    + w * q * ds
+)
+
+# Linear form with cell and interior facet integrals on the
+# discontinuous space
+g = Coefficient(W)
+L_dg = inner(avg(grad(g)), jump(q, n)) * dS + g * q * dx
+
+# Vector-valued operator on a blocked space
+e_vec = element("Lagrange", "tetrahedron", 1, shape=(3,))
+U = FunctionSpace(mesh, e_vec)
+a_vec = inner(grad(TrialFunction(U)), grad(TestFunction(U))) * dx
@@ -9,10 +9,21 @@
 #include <algorithm>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <complex>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/PinnedAllocator.h>
+#include <dolfinx/la/HugePageAllocator.h>
 #include <dolfinx/la/Vector.h>
+#include <dolfinx/la/VectorGroup.h>
+#include <dolfinx/la/VectorHistory.h>
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 using namespace dolfinx;
 
@@ -53,6 +64,340 @@ void test_vector()
   CHECK(la::norm(v, la::Norm::l2) == std::sqrt(sumn2));
   CHECK(la::inner_product(v, v) == sumn2);
   CHECK(la::norm(v, la::Norm::linf) == static_cast<T>(mpi_size - 1));
+
+  // Fused inner products
+  la::Vector<T> w(index_map, 1);
+  std::ranges::fill(w.mutable_array(), 2.0);
+  std::vector<std::reference_wrapper<const la::Vector<T>>> vw = {v, w};
+  std::vector<T> dots(2);
+  la::inner_products(vw, w, std::span(dots));
+  CHECK(dots[0] == la::inner_product(v, w));
+  CHECK(dots[1] == la::inner_product(w, w));
+
+  // r = 2 v + w
+  la::Vector<T> r(index_map, 1);
+  la::axpy(r, T(2), v, w);
+  std::span<const T> _r = r.array();
+  CHECK(std::all_of(_r.begin(), _r.begin() + size_local,
+                    [mpi_rank](auto x) { return x == T(2 * mpi_rank + 2); }));
+}
+
+/// Allocator that is distinct from (but behaves like) std::allocator,
+/// to test la::Vector with a non-default allocator
+template <typename T>
+struct test_allocator : std::allocator<T>
+{
+  using value_type = T;
+  test_allocator() = default;
+  template <typename U>
+  test_allocator(const test_allocator<U>&)
+  {
+  }
+};
+
+} // namespace
+
+/// Backend for the test container that records the number of pack and
+/// unpack operations, as a backend for a device container would launch
+/// kernels for them
+template <typename T>
+struct dolfinx::la::backend<std::vector<T, test_allocator<T>>>
+    : dolfinx::la::backend<std::vector<T>>
+{
+  using base = dolfinx::la::backend<std::vector<T>>;
+  inline static int num_calls = 0;
+
+  static void pack(std::span<const T> in, std::span<const std::int32_t> idx,
+                   std::span<T> out)
+  {
+    ++num_calls;
+    base::pack(in, idx, out);
+  }
+
+  template <class BinaryOperation>
+  static void unpack(std::span<const T> in, std::span<const std::int32_t> idx,
+                     std::span<T> out, BinaryOperation op)
+  {
+    ++num_calls;
+    base::unpack(in, idx, out, op);
+  }
+};
+
+namespace
+{
+template <typename T>
+void test_vector_allocator()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 100;
+
+  // Create some ghost entries on next process
+  const int owner = (mpi_rank + 1) % mpi_size;
+  std::vector<std::int64_t> ghosts((mpi_size - 1) * 3);
+  for (std::size_t i = 0; i < ghosts.size(); ++i)
+    ghosts[i] = owner * size_local + i;
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts,
+      std::vector<int>(ghosts.size(), owner));
+
+  using V = la::Vector<T, std::vector<T, test_allocator<T>>>;
+  using S = common::Scatterer<test_allocator<std::int32_t>>;
+  static_assert(std::is_same_v<typename V::scatterer_type, S>);
+  V v(index_map, 1);
+  v.set(mpi_rank);
+  v.scatter_fwd();
+  std::span<const T> x = v.array();
+  CHECK(std::all_of(x.begin() + size_local, x.end(),
+                    [owner](auto x) { return x == T(owner); }));
+
+  // Ghost data was packed and unpacked through the container backend
+  CHECK(la::backend<typename V::container_type>::num_calls == 2);
+}
+
+template <typename T>
+void test_vector_pinned_buffers()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 100;
+
+  // Create some ghost entries on next process
+  const int owner = (mpi_rank + 1) % mpi_size;
+  std::vector<std::int64_t> ghosts((mpi_size - 1) * 3);
+  for (std::size_t i = 0; i < ghosts.size(); ++i)
+    ghosts[i] = owner * size_local + i;
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts,
+      std::vector<int>(ghosts.size(), owner));
+
+  // Scatter buffers in page-locked memory
+  using V = la::Vector<T, std::vector<T>,
+                       std::vector<T, common::PinnedAllocator<T>>>;
+  V v(index_map, 1);
+  v.set(mpi_rank);
+  v.scatter_fwd();
+  std::span<const T> x = v.array();
+  CHECK(std::all_of(x.begin() + size_local, x.end(),
+                    [owner](auto x) { return x == T(owner); }));
+}
+
+template <typename T>
+void test_vector_huge_pages()
+{
+  // Large enough for the data to be mapped with huge pages
+  constexpr int size_local = la::impl::huge_page_size / sizeof(T) + 100;
+  auto index_map
+      = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local);
+
+  using V = la::Vector<T, la::huge_page_vector<T, 2>>;
+  V v(index_map, 1);
+  std::span<const T> x = v.array();
+  CHECK(std::ranges::all_of(x, [](auto x) { return x == T(0); }));
+  v.set(T(2));
+  CHECK(std::ranges::all_of(x, [](auto x) { return x == T(2); }));
+
+  // Small containers, e.g. the scatter indices, use operator new
+  la::huge_page_vector<T> y(10, T(3));
+  CHECK(std::ranges::all_of(y, [](auto y) { return y == T(3); }));
+}
+
+template <typename T>
+void test_orthonormalize()
+{
+  auto index_map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, 50);
+  const std::int64_t offset = index_map->local_range()[0];
+  std::vector<la::Vector<T>> basis(4, la::Vector<T>(index_map, 1));
+  for (std::size_t j = 0; j < basis.size(); ++j)
+  {
+    std::span<T> x = basis[j].mutable_array();
+    for (std::size_t i = 0; i < x.size(); ++i)
+      x[i] = std::pow(static_cast<double>(offset + i) / 50, j) + 0.1 * j;
+  }
+
+  std::vector<std::reference_wrapper<la::Vector<T>>> _basis(basis.begin(),
+                                                            basis.end());
+  la::orthonormalize(_basis);
+  std::vector<std::reference_wrapper<const la::Vector<T>>> _cbasis(
+      basis.begin(), basis.end());
+  CHECK(la::is_orthonormal(_cbasis, 1e-10));
+}
+
+template <typename T>
+void test_vector_state()
+{
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, 10);
+  la::Vector<T> v0(map, 1), v1(map, 1);
+  CHECK(v0.state() != v1.state());
+
+  // Mutable access changes the state, read access does not
+  const std::uint64_t state = v0.state();
+  std::ranges::fill(v0.mutable_array(), T(1));
+  CHECK(v0.state() > state);
+  const std::uint64_t state1 = v0.state();
+  CHECK(v0.array()[0] == T(1));
+  CHECK(v0.state() == state1);
+
+  v0.scatter_fwd();
+  CHECK(v0.state() > state1);
+  la::Vector<T> v2(v0);
+  CHECK(v2.state() != v0.state());
+}
+
+template <typename T>
+void test_vector_group()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 20;
+
+  // Ghost the first entries of the next process
+  const int dest = (mpi_rank + 1) % mpi_size;
+  const int num_ghosts = mpi_size > 1 ? 3 : 0;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = dest * size_local + i;
+  const std::vector<int> owners(num_ghosts, dest);
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local,
+                                                ghosts, owners);
+
+  // Vectors with different block sizes, and a copy of each that is
+  // updated separately
+  la::Vector<T> u(map, 3), p(map, 1);
+  std::vector<la::Vector<T>*> x = {&u, &p};
+  for (la::Vector<T>* v : x)
+  {
+    std::span<T> _v = v->mutable_array();
+    for (int i = 0; i < size_local * v->bs(); ++i)
+      _v[i] = mpi_rank * 1000 + v->bs() * 100 + i;
+  }
+  la::Vector<T> u0(u), p0(p);
+  u0.scatter_fwd();
+  p0.scatter_fwd();
+
+  la::VectorGroup<la::Vector<T>> group({u, p});
+  CHECK(group.size() == 2);
+  group.scatter_fwd();
+  CHECK(std::ranges::equal(u.array(), u0.array()));
+  CHECK(std::ranges::equal(p.array(), p0.array()));
+
+  u0.scatter_rev(std::plus<T>());
+  p0.scatter_rev(std::plus<T>());
+  group.scatter_rev(std::plus<T>());
+  CHECK(std::ranges::equal(u.array(), u0.array()));
+  CHECK(std::ranges::equal(p.array(), p0.array()));
+}
+
+template <typename T>
+void test_vector_history()
+{
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, 10);
+  la::Vector<T> u(map, 2);
+  la::VectorHistory<la::Vector<T>> history(u, 3);
+  CHECK(history.depth() == 3);
+
+  // Store levels u^n = n + j
+  std::span<T> _u = u.mutable_array();
+  for (int n = 0; n < 5; ++n)
+  {
+    la::Vector<T>& un = history.rotate();
+    std::span<T> x = un.mutable_array();
+    for (std::size_t j = 0; j < x.size(); ++j)
+      x[j] = n + static_cast<double>(j);
+  }
+  CHECK(history.vector(0).get() == &history[0]);
+  CHECK(history[2].index_map() == map);
+  for (int i = 0; i < 3; ++i)
+    CHECK(history[i].array()[1] == T(5 - i));
+
+  // u = 3 u^4 - 2 u^3 + u^2
+  std::vector<T> alpha = {3, -2, 1};
+  history.linear_combination(alpha, u);
+  for (std::size_t j = 0; j < _u.size(); ++j)
+    CHECK(_u[j] == T(2 * static_cast<double>(j) + 8));
+
+  // In-place combination with fewer levels
+  history.linear_combination(std::span(alpha).first(2), history[0]);
+  CHECK(history[0].array()[0] == T(6));
+}
+
+template <typename T>
+void test_vector_fused()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 1000;
+  const int dest = (mpi_rank + 1) % mpi_size;
+  const int num_ghosts = mpi_size > 1 ? 5 : 0;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = dest * size_local + i;
+  const std::vector<int> owners(num_ghosts, dest);
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local,
+                                                ghosts, owners);
+
+  la::Vector<T> x(map, 1), y(map, 1), z(map, 1), r(map, 1);
+  std::span<T> _x = x.mutable_array(), _y = y.mutable_array(),
+               _z = z.mutable_array();
+  for (std::size_t i = 0; i < _x.size(); ++i)
+  {
+    _x[i] = std::sin(static_cast<double>(i));
+    _y[i] = std::cos(static_cast<double>(i));
+    _z[i] = 1.0 / (1 + i);
+  }
+
+  auto check = [&](auto f)
+  {
+    std::span<const T> _r = r.array();
+    for (std::size_t i = 0; i < _r.size(); ++i)
+      CHECK(std::abs(_r[i] - f(_x[i], _y[i], _z[i])) < 1e-12);
+  };
+
+  la::axpby(r, T(2), x, T(-3), y);
+  check([](auto x, auto y, auto) { return T(2) * x - T(3) * y; });
+
+  la::transform(r, [](auto x, auto y, auto z) { return x * y + z; }, x, y,
+                z);
+  check([](auto x, auto y, auto z) { return x * y + z; });
+
+  std::vector<T> alpha = {1, 0.5, -2};
+  la::linear_combination(r, std::span<const T>(alpha),
+                         std::array{std::cref(x), std::cref(y), std::cref(z)},
+                         2);
+  check([](auto x, auto y, auto z) { return x + T(0.5) * y - T(2) * z; });
+
+  auto nrm = la::axpy_norm(r, T(4), x, z);
+  check([](auto x, auto, auto z) { return T(4) * x + z; });
+  CHECK(std::abs(nrm - la::norm(r)) < 1e-10);
+}
+
+template <typename T>
+void test_vector_reductions()
+{
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, 50);
+  la::Vector<T> x(map, 2), y(map, 2);
+  std::span<T> _x = x.mutable_array(), _y = y.mutable_array();
+  for (std::size_t i = 0; i < _x.size(); ++i)
+  {
+    _x[i] = std::sin(static_cast<double>(i + mpi_rank));
+    _y[i] = std::cos(static_cast<double>(i));
+  }
+
+  // Start both reductions before completing either
+  auto r0 = la::inner_product_begin(x, y);
+  auto r1 = la::squared_norm_begin(x);
+  CHECK(std::abs(r0.value() - la::inner_product(x, y)) < 1e-12);
+  CHECK(std::abs(r1.value() - la::squared_norm(x)) < 1e-12);
+  CHECK(r0.test());
+
+  std::vector<std::int32_t> v = {mpi_rank, -mpi_rank};
+  auto r2 = dolfinx::MPI::iallreduce(std::span<const std::int32_t>(v),
+                                     MPI_MAX, MPI_COMM_WORLD);
+  std::span<const std::int32_t> max = r2.get();
+  CHECK(max[0] == mpi_size - 1);
+  CHECK(max[1] == 0);
 }
 
 } // namespace
@@ -61,4 +406,13 @@ TEMPLATE_TEST_CASE("Linear Algebra Vector", "[la_vector]", double,
                    std::complex<double>)
 {
   CHECK_NOTHROW(test_vector<TestType>());
+  CHECK_NOTHROW(test_orthonormalize<TestType>());
+  CHECK_NOTHROW(test_vector_allocator<TestType>());
+  CHECK_NOTHROW(test_vector_pinned_buffers<TestType>());
+  CHECK_NOTHROW(test_vector_huge_pages<TestType>());
+  CHECK_NOTHROW(test_vector_state<TestType>());
+  CHECK_NOTHROW(test_vector_group<TestType>());
+  CHECK_NOTHROW(test_vector_history<TestType>());
+  CHECK_NOTHROW(test_vector_fused<TestType>());
+  CHECK_NOTHROW(test_vector_reductions<TestType>());
 }
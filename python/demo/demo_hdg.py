@@ -135,8 +135,7 @@ dx_f = ufl.Measure("dx", domain=facet_mesh)
 # We write the mixed domain forms as integrals over msh. Hence, we must
 # provide a map from facets in msh to cells in facet_mesh. This is the
 # 'inverse' of facet_mesh_to_mesh, which we compute as follows:
-mesh_to_facet_mesh = np.full(num_facets, -1)
-mesh_to_facet_mesh[facet_mesh_to_mesh] = np.arange(len(facet_mesh_to_mesh))
+mesh_to_facet_mesh = mesh.compute_parent_to_sub_entity_map(msh.topology, fdim, facet_mesh_to_mesh)
 entity_maps = {facet_mesh: mesh_to_facet_mesh}
 
 # Define forms
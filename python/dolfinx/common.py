@@ -8,6 +8,7 @@
 import datetime
 import functools
 import typing
+from pathlib import Path
 
 from dolfinx import cpp as _cpp
 from dolfinx.cpp.common import (
@@ -63,11 +64,202 @@ def list_timings(comm, reduction=Reduction.max):
     """Print out a summary of all Timer measurements.
 
     When used in parallel, a reduction is applied across all processes.
-    By default, the maximum time is shown.
+    By default, the maximum time is shown. With ``Reduction.statistics``
+    the median, 95th percentile and maximum over the processes, and the
+    rank with the maximum, are shown.
     """
     _cpp.common.list_timings(comm, reduction)
 
 
+def perf_counters_start() -> bool:
+    """Enable the hardware counters of the calling thread.
+
+    Named ``Timer`` objects then also record the cycles, instructions
+    and last level cache misses of the periods that they run, see
+    ``list_counters``. The counters use the Linux ``perf_event``
+    interface.
+
+    Returns:
+        ``True`` if the counters are available.
+    """
+    return _cpp.common.perf_counters_start()
+
+
+def perf_counters_stop() -> None:
+    """Disable the hardware counters."""
+    _cpp.common.perf_counters_stop()
+
+
+def list_counters(comm, reduction=Reduction.max):
+    """Print out a summary of the hardware counts of all Timer tasks.
+
+    The summary includes the instructions per cycle and the memory
+    bandwidth estimated from the last level cache misses. When used in
+    parallel, a reduction is applied across all processes.
+    """
+    _cpp.common.list_counters(comm, reduction)
+
+
+def comm_stats_start() -> None:
+    """Enable recording of MPI communication statistics.
+
+    Halo exchanges (scatters) and the parallel data distribution
+    functions of the C++ library then record the number of messages
+    and bytes that they send and receive, the number of neighbour
+    processes and the time spent waiting for communication to
+    complete, see ``list_comm_stats``.
+    """
+    _cpp.common.comm_stats_start()
+
+
+def comm_stats_stop() -> None:
+    """Disable recording of MPI communication statistics. The recorded
+    statistics are kept."""
+    _cpp.common.comm_stats_stop()
+
+
+def comm_stats_clear() -> None:
+    """Discard the recorded MPI communication statistics."""
+    _cpp.common.comm_stats_clear()
+
+
+def list_comm_stats(comm, reduction=Reduction.max):
+    """Print out a summary of the recorded MPI communication statistics.
+
+    When used in parallel, a reduction is applied across all processes,
+    e.g. the minimum and maximum show imbalanced halo exchanges. By
+    default, the maximum is shown.
+    """
+    _cpp.common.list_comm_stats(comm, reduction)
+
+
+def memory_usage_record(name: str, nbytes: int) -> None:
+    """Record the memory used by a named object, e.g. the value of
+    ``Mesh.memory_usage()``. A previously recorded size of the same name
+    is replaced.
+
+    Args:
+        name: Name of the object.
+        nbytes: Memory in bytes.
+    """
+    _cpp.common.memory_usage_record(name, nbytes)
+
+
+def memory_usage_clear() -> None:
+    """Discard the recorded memory usage."""
+    _cpp.common.memory_usage_clear()
+
+
+def memory_usage_recorded() -> dict[str, int]:
+    """Recorded memory (bytes) of each named object."""
+    return _cpp.common.memory_usage_recorded()
+
+
+def peak_resident_memory() -> int:
+    """Peak resident memory (bytes) of the calling process, or zero if
+    not available."""
+    return _cpp.common.peak_resident_memory()
+
+
+def list_memory_usage(comm, reduction=Reduction.max):
+    """Print out a summary (in MB) of the recorded memory usage.
+
+    The summary includes the total of the recorded sizes and the peak
+    resident memory of the process. When used in parallel, a reduction
+    is applied across all processes. By default, the maximum is shown.
+    """
+    _cpp.common.list_memory_usage(comm, reduction)
+
+
+def trace_start(capacity: int = 1 << 16) -> None:
+    """Enable tracing of the regions of code that are timed by named
+    ``Timer`` objects and by the C++ library.
+
+    Previously recorded regions are discarded.
+
+    Args:
+        capacity: Number of regions that are kept for each thread.
+            Older regions are overwritten.
+    """
+    _cpp.common.trace_start(capacity)
+
+
+def trace_stop() -> None:
+    """Disable tracing. The recorded regions are kept."""
+    _cpp.common.trace_stop()
+
+
+def trace_write_chrome(comm, filename: typing.Union[str, Path]) -> None:
+    """Write the traced regions of all processes to a Chrome trace file.
+
+    The file can be viewed in https://ui.perfetto.dev, which shows the
+    nested regions of each thread of each process on a timeline.
+
+    Note:
+        This function is collective.
+
+    Args:
+        comm: MPI communicator.
+        filename: Name of the file.
+    """
+    _cpp.common.trace_write_chrome(comm, filename)
+
+
+def split_comm(comm, num_groups: int) -> tuple[typing.Any, int]:
+    """Split a communicator into groups of contiguous ranks.
+
+    The ranks are divided into ``num_groups`` groups of almost equal
+    size, as by the C++ function ``dolfinx::MPI::split``. Each group can
+    then work on an independent problem, e.g. a load case of a parameter
+    study, with less communication than on ``comm``. A mesh can be
+    copied to the groups with :func:`dolfinx.mesh.create_group_mesh`.
+
+    Note:
+        This function is collective.
+
+    Args:
+        comm: MPI communicator to split.
+        num_groups: Number of groups, between one and the size of
+            ``comm``.
+
+    Returns:
+        Communicator of the group of the caller and the index of the
+        group.
+    """
+    size, rank = comm.size, comm.rank
+    if num_groups < 1 or num_groups > size:
+        raise ValueError(f"Number of groups ({num_groups}) must be between 1 and {size}.")
+    n, r = divmod(size, num_groups)
+    group = rank // (n + 1) if rank < r * (n + 1) else r + (rank - r * (n + 1)) // n
+    return comm.Split(group, rank), group
+
+
+def gather_group_results(comm, group_comm, value: typing.Any) -> list[typing.Any]:
+    """Gather a result of each group of ranks on all ranks.
+
+    The value on the first rank of each group is gathered, and the
+    values on the other ranks are ignored. This is the counterpart of
+    :func:`split_comm` for collecting the results of the independent
+    problems solved by the groups.
+
+    Note:
+        This function is collective on ``comm``.
+
+    Args:
+        comm: MPI communicator that was split into groups.
+        group_comm: Communicator of the group of the caller.
+        value: Result of the group of the caller. Must be picklable.
+
+    Returns:
+        Results of the groups, ordered by the rank on ``comm`` of the
+        first rank of each group, which is the group index for groups
+        created by :func:`split_comm`.
+    """
+    root = group_comm.rank == 0
+    values = comm.allgather((True, value) if root else (False, None))
+    return [v for is_root, v in values if is_root]
+
+
 class Timer:
     """A timer for timing section of code.
 
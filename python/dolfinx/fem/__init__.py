@@ -5,9 +5,12 @@
 # SPDX-License-Identifier:    LGPL-3.0-or-later
 """Tools for assembling and manipulating finite element forms."""
 
+import typing
+
 import numpy as np
 import numpy.typing as npt
 
+from dolfinx import cpp as _cpp
 from dolfinx.cpp.fem import _IntegralType as IntegralType
 from dolfinx.cpp.fem import build_sparsity_pattern as _build_sparsity_pattern
 from dolfinx.cpp.fem import compute_integration_domains as _compute_integration_domains
@@ -20,6 +23,7 @@ from dolfinx.cpp.fem import transpose_dofmap
 from dolfinx.cpp.la import SparsityPattern
 from dolfinx.cpp.mesh import Topology
 from dolfinx.fem.assemble import (
+    Assembler,
     apply_lifting,
     assemble_matrix,
     assemble_scalar,
@@ -60,11 +64,12 @@ from dolfinx.geometry import PointOwnershipData as _PointOwnershipData
 from dolfinx.la import MatrixCSR as _MatrixCSR
 
 
-def create_sparsity_pattern(a: Form):
+def create_sparsity_pattern(a: Form, num_threads: int = 1):
     """Create a sparsity pattern from a bilinear form.
 
     Args:
         a: Bilinear form to build a sparsity pattern for.
+        num_threads: Number of threads used to build the pattern.
 
     Returns:
         Sparsity pattern for the form ``a``.
@@ -73,15 +78,16 @@ def create_sparsity_pattern(a: Form):
         The pattern is not finalised, i.e. the caller is responsible for
         calling ``assemble`` on the sparsity pattern.
     """
-    return _create_sparsity_pattern(a._cpp_object)
+    return _create_sparsity_pattern(a._cpp_object, num_threads)
 
 
-def build_sparsity_pattern(pattern: SparsityPattern, a: Form):
+def build_sparsity_pattern(pattern: SparsityPattern, a: Form, num_threads: int = 1):
     """Build a sparsity pattern from a bilinear form.
 
     Args:
         pattern: The sparsity pattern to add to
         a: Bilinear form to build a sparsity pattern for.
+        num_threads: Number of threads used to build the pattern.
 
     Returns:
         Sparsity pattern for the form ``a``.
@@ -90,7 +96,7 @@ def build_sparsity_pattern(pattern: SparsityPattern, a: Form):
         The pattern is not finalised, i.e. the caller is responsible for
         calling ``assemble`` on the sparsity pattern.
     """
-    return _build_sparsity_pattern(pattern, a._cpp_object)
+    return _build_sparsity_pattern(pattern, a._cpp_object, num_threads)
 
 
 def create_interpolation_data(
@@ -125,7 +131,95 @@ def create_interpolation_data(
     )
 
 
-def discrete_curl(V0: FunctionSpace, V1: FunctionSpace) -> _MatrixCSR:
+def create_interpolation_plan(
+    V_from: FunctionSpace,
+    cells: npt.NDArray[np.int32],
+    interpolation_data: _PointOwnershipData,
+):
+    """Create precomputed data for repeated interpolation of functions
+    across different meshes.
+
+    Args:
+        V_from: Function space to interpolate from
+        cells: Indices of the cells associated with the space to
+            interpolate into on which to interpolate.
+        interpolation_data: Data created by
+            :func:`dolfinx.fem.create_interpolation_data`.
+
+    Returns:
+        Interpolation plan, to be used with
+        :meth:`dolfinx.fem.Function.interpolate_nonmatching_plan`.
+    """
+    if np.issubdtype(V_from.mesh.geometry.x.dtype, np.float32):
+        plan_type = _cpp.fem.InterpolationPlan_float32
+    else:
+        plan_type = _cpp.fem.InterpolationPlan_float64
+    return plan_type(V_from._cpp_object, cells, interpolation_data._cpp_object)
+
+
+def create_interpolation_coords(
+    V: FunctionSpace,
+    cells: typing.Optional[npt.NDArray[np.int32]] = None,
+    chunk_size: int = 4096,
+    cache: bool = True,
+):
+    """Create interpolation coordinates of cells, computed in chunks.
+
+    Interpolation of a callable with
+    :meth:`dolfinx.fem.Function.interpolate_chunked` evaluates the
+    callable one chunk of cells at a time, which bounds the memory used
+    for the coordinates and the values. If ``cache`` is true, the
+    coordinates are computed once and re-used by later interpolations,
+    e.g. of time-dependent boundary data on a fixed mesh.
+
+    Args:
+        V: Function space to interpolate into.
+        cells: Cells to interpolate on. If ``None``, all cells
+            (including ghosts) are used.
+        chunk_size: Number of cells in each chunk.
+        cache: Store the coordinates of all chunks for re-use.
+
+    Returns:
+        Interpolation coordinates.
+    """
+    msh = V.mesh
+    if cells is None:
+        cmap = msh.topology.index_map(msh.topology.dim)
+        cells = np.arange(cmap.size_local + cmap.num_ghosts, dtype=np.int32)
+    if np.issubdtype(msh.geometry.x.dtype, np.float32):
+        coords_type = _cpp.fem.InterpolationCoords_float32
+    else:
+        coords_type = _cpp.fem.InterpolationCoords_float64
+    return coords_type(V.element._cpp_object, msh._cpp_object, cells, chunk_size, cache)
+
+
+def create_dof_coordinates(V: FunctionSpace, dofs: npt.NDArray[np.int32]):
+    """Create the coordinates of a subset of degrees-of-freedom.
+
+    Interpolation of a callable with
+    :meth:`dolfinx.fem.Function.interpolate_dofs` evaluates the callable
+    at these degrees-of-freedom only. This is typically used to update
+    time-dependent Dirichlet boundary data at the degrees-of-freedom
+    returned by :func:`dolfinx.fem.locate_dofs_topological`, at a cost
+    proportional to the size of the boundary. The coordinates are
+    computed once and recomputed only if the mesh geometry changes.
+
+    Args:
+        V: Point-evaluation function space, which must not be a
+            subspace.
+        dofs: Degree-of-freedom block indices (local to the process).
+
+    Returns:
+        Degree-of-freedom coordinates.
+    """
+    if np.issubdtype(V.mesh.geometry.x.dtype, np.float32):
+        coords_type = _cpp.fem.DofCoordinates_float32
+    else:
+        coords_type = _cpp.fem.DofCoordinates_float64
+    return coords_type(V._cpp_object, np.asarray(dofs, dtype=np.int32))
+
+
+def discrete_curl(V0: FunctionSpace, V1: FunctionSpace, num_threads: int = 1) -> _MatrixCSR:
     """Assemble a discrete curl operator.
 
     The discrete curl operator interpolates the curl of H(curl) finite
@@ -134,14 +228,18 @@ def discrete_curl(V0: FunctionSpace, V1: FunctionSpace) -> _MatrixCSR:
     Args:
         V0: H1(curl) space to interpolate the curl from.
         V1: H(div) space to interpolate into.
+        num_threads: Number of threads used to compute the cell
+            matrices.
 
     Returns:
         Discrete curl operator.
     """
-    return _MatrixCSR(_discrete_curl(V0._cpp_object, V1._cpp_object))
+    return _MatrixCSR(_discrete_curl(V0._cpp_object, V1._cpp_object, num_threads))
 
 
-def discrete_gradient(space0: FunctionSpace, space1: FunctionSpace) -> _MatrixCSR:
+def discrete_gradient(
+    space0: FunctionSpace, space1: FunctionSpace, num_threads: int = 1
+) -> _MatrixCSR:
     """Assemble a discrete gradient operator.
 
     The discrete gradient operator interpolates the gradient of a H1
@@ -152,25 +250,31 @@ def discrete_gradient(space0: FunctionSpace, space1: FunctionSpace) -> _MatrixCS
     Args:
         space0: H1 space to interpolate the gradient from.
         space1: H(curl) space to interpolate into.
+        num_threads: Number of threads used to compute the cell
+            matrices.
 
     Returns:
         Discrete gradient operator.
     """
-    return _MatrixCSR(_discrete_gradient(space0._cpp_object, space1._cpp_object))
+    return _MatrixCSR(_discrete_gradient(space0._cpp_object, space1._cpp_object, num_threads))
 
 
-def interpolation_matrix(space0: FunctionSpace, space1: FunctionSpace) -> _MatrixCSR:
+def interpolation_matrix(
+    space0: FunctionSpace, space1: FunctionSpace, num_threads: int = 1
+) -> _MatrixCSR:
     """Assemble an interpolation matrix for two function spaces on the same
     mesh.
 
     Args:
         space0: space to interpolate from
         space1: space to interpolate into
+        num_threads: Number of threads used to compute the cell
+            matrices.
 
     Returns:
         Interpolation matrix
     """
-    return _MatrixCSR(_interpolation_matrix(space0._cpp_object, space1._cpp_object))
+    return _MatrixCSR(_interpolation_matrix(space0._cpp_object, space1._cpp_object, num_threads))
 
 
 def compute_integration_domains(
@@ -212,6 +316,7 @@ def compute_integration_domains(
 
 
 __all__ = [
+    "Assembler",
     "Constant",
     "CoordinateElement",
     "DirichletBC",
@@ -231,8 +336,11 @@ __all__ = [
     "compile_form",
     "compute_integration_domains",
     "coordinate_element",
+    "create_dof_coordinates",
     "create_form",
+    "create_interpolation_coords",
     "create_interpolation_data",
+    "create_interpolation_plan",
     "create_matrix",
     "create_sparsity_pattern",
     "create_vector",
@@ -133,7 +133,9 @@ def create_matrix(a: Form, block_mode: typing.Optional[la.BlockMode] = None) ->
 # -- Scalar assembly ------------------------------------------------------
 
 
-def assemble_scalar(M: Form, constants: typing.Optional[np.ndarray] = None, coeffs=None):
+def assemble_scalar(
+    M: Form, constants: typing.Optional[np.ndarray] = None, coeffs=None, num_threads: int = 1
+):
     """Assemble functional. The returned value is local and not
     accumulated across processes.
 
@@ -143,6 +145,8 @@ def assemble_scalar(M: Form, constants: typing.Optional[np.ndarray] = None, coef
             required constants will be computed.
         coeffs: Coefficients that appear in the form. If not provided,
             any required coefficients will be computed.
+        num_threads: Number of threads to use. The computed value does
+            not depend on the number of threads.
 
     Returns:
         The computed scalar on the calling rank.
@@ -155,9 +159,9 @@ def assemble_scalar(M: Form, constants: typing.Optional[np.ndarray] = None, coef
         To compute the functional value on the whole domain, the output
         of this function is typically summed across all MPI ranks.
     """
-    constants = pack_constants(M) if constants is None else constants  # type: ignore
+    constants = M._cpp_object.packed_constants() if constants is None else constants
     coeffs = coeffs or pack_coefficients(M)
-    return _cpp.fem.assemble_scalar(M._cpp_object, constants, coeffs)
+    return _cpp.fem.assemble_scalar(M._cpp_object, constants, coeffs, num_threads)
 
 
 # -- Vector assembly ------------------------------------------------------
@@ -197,7 +201,7 @@ def _assemble_vector_form(
     """
     b = create_vector(L)
     b.array[:] = 0
-    constants = constants or pack_constants(L)  # type: ignore
+    constants = L._cpp_object.packed_constants() if constants is None else constants
     coeffs = coeffs or pack_coefficients(L)
     _assemble_vector_array(b.array, L, constants, coeffs)
     return b
@@ -229,7 +233,7 @@ def _assemble_vector_array(
         :func:`dolfinx.la.Vector.scatter_reverse` on the return vector
         can accumulate ghost contributions.
     """
-    constants = pack_constants(L) if constants is None else constants  # type: ignore
+    constants = L._cpp_object.packed_constants() if constants is None else constants
     coeffs = pack_coefficients(L) if coeffs is None else coeffs
     _cpp.fem.assemble_vector(b, L._cpp_object, constants, coeffs)
     return b
@@ -311,7 +315,7 @@ def _assemble_matrix_csr(
         accumulated.
     """
     bcs = [] if bcs is None else [bc._cpp_object for bc in bcs]
-    constants = pack_constants(a) if constants is None else constants  # type: ignore
+    constants = a._cpp_object.packed_constants() if constants is None else constants
     coeffs = pack_coefficients(a) if coeffs is None else coeffs
     _cpp.fem.assemble_matrix(A._cpp_object, a._cpp_object, constants, coeffs, bcs)
 
@@ -322,6 +326,99 @@ def _assemble_matrix_csr(
     return A
 
 
+# -- Repeated assembly ----------------------------------------------------
+
+
+class Assembler:
+    """Assembler for a form that is assembled repeatedly, e.g. in a
+    time loop.
+
+    Packed coefficient data is stored between assemblies, and a
+    coefficient is repacked only if the data of its vector has changed
+    since the last assembly. Constants are packed in place into a
+    buffer of the form, and only the constants whose value has changed
+    are copied. The Python global interpreter lock is
+    released while coefficients are packed and the form is assembled,
+    so that assembly can overlap with Python work in other threads.
+
+    Note:
+        Changes to a coefficient through a NumPy array that was
+        obtained from ``Function.x.array`` before the previous assembly
+        are not detected. Call :meth:`reset` to repack all coefficients
+        in this case.
+    """
+
+    def __init__(self, form: Form, num_threads: int = 1):
+        """Create an assembler for a form.
+
+        Args:
+            form: The form to assemble.
+            num_threads: Number of threads used to pack coefficients.
+        """
+        self._form = form
+        packer = getattr(_cpp.fem, f"CoefficientPacker_{form.dtype.name}")
+        self._packer = packer(form._cpp_object, num_threads)
+
+    @property
+    def form(self) -> Form:
+        """The form that is assembled."""
+        return self._form
+
+    def reset(self):
+        """Repack all coefficients in the next assembly."""
+        self._packer.reset()
+
+    def assemble_scalar(self):
+        """Assemble the functional on the calling rank.
+
+        Returns:
+            The computed scalar on the calling rank.
+        """
+        constants = self._form._cpp_object.packed_constants()
+        return _cpp.fem.assemble_scalar(self._form._cpp_object, constants, self._packer)
+
+    def assemble_vector(self, b: np.ndarray) -> np.ndarray:
+        """Assemble the linear form into an existing array.
+
+        Args:
+            b: The array to add the contribution from the calling MPI
+                rank to. It must have the required size.
+
+        Returns:
+            The array ``b``.
+        """
+        constants = self._form._cpp_object.packed_constants()
+        _cpp.fem.assemble_vector(b, self._form._cpp_object, constants, self._packer)
+        return b
+
+    def assemble_matrix(
+        self,
+        A: la.MatrixCSR,
+        bcs: typing.Optional[list[DirichletBC]] = None,
+        diagonal: float = 1.0,
+    ) -> la.MatrixCSR:
+        """Assemble the bilinear form into an existing matrix.
+
+        Args:
+            A: The matrix to add to. It must have been initialized with
+                the sparsity pattern of the form.
+            bcs: Boundary conditions that affect the assembled matrix,
+                see :func:`assemble_matrix`.
+            diagonal: Value to set on the diagonal of the rows and
+                columns constrained by ``bcs``.
+
+        Returns:
+            The matrix ``A``.
+        """
+        a = self._form
+        bcs = [] if bcs is None else [bc._cpp_object for bc in bcs]
+        constants = a._cpp_object.packed_constants()
+        _cpp.fem.assemble_matrix(A._cpp_object, a._cpp_object, constants, self._packer, bcs)
+        if a.function_spaces[0] is a.function_spaces[1]:
+            _cpp.fem.insert_diagonal(A._cpp_object, a.function_spaces[0], bcs, diagonal)
+        return A
+
+
 # -- Modifiers for Dirichlet conditions -----------------------------------
 
 
@@ -60,6 +60,7 @@ def locate_dofs_topological(
     entity_dim: int,
     entities: npt.NDArray[np.int32],
     remote: bool = True,
+    num_threads: int = 1,
 ) -> np.ndarray:
     """Locate degrees-of-freedom belonging to mesh entities topologically.
 
@@ -72,6 +73,8 @@ def locate_dofs_topological(
             where degrees-of-freedom are located.
         remote: True to return also "remotely located" degree-of-freedom
             indices.
+        num_threads: Number of threads used to find the
+            degrees-of-freedom of the entities.
 
     Returns:
         An array of degree-of-freedom indices (local to the process) for
@@ -85,10 +88,16 @@ def locate_dofs_topological(
     """
     _entities = np.asarray(entities, dtype=np.int32)
     try:
-        return _cpp.fem.locate_dofs_topological(V._cpp_object, entity_dim, _entities, remote)  # type: ignore
+        return _cpp.fem.locate_dofs_topological(
+            V._cpp_object,  # type: ignore
+            entity_dim,
+            _entities,
+            remote,
+            num_threads,
+        )
     except AttributeError:
         _V = [space._cpp_object for space in V]  # type: ignore
-        return _cpp.fem.locate_dofs_topological(_V, entity_dim, _entities, remote)
+        return _cpp.fem.locate_dofs_topological(_V, entity_dim, _entities, remote, num_threads)
 
 
 class DirichletBC:
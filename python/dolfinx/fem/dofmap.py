@@ -52,6 +52,10 @@ class DofMap:
         """Block size of the index map."""
         return self._cpp_object.index_map_bs
 
+    def memory_usage(self) -> int:
+        """Memory (bytes) used by the dofmap, including its index map."""
+        return self._cpp_object.memory_usage()
+
     @property
     def list(self):
         """Adjacency list with dof indices for each cell."""
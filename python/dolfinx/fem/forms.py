@@ -109,6 +109,19 @@ class Form:
         """Integral types in the form."""
         return self._cpp_object.integral_types
 
+    def cache_facet_pairs(self, cache: bool):
+        """Enable or disable caching of precomputed interior facet data.
+
+        With the cache enabled, the merged degree-of-freedom lists and
+        the facet permutations of the two cells of each interior facet
+        are computed once and re-used by subsequent assemblies.
+
+        Args:
+            cache: ``True`` to cache interior facet data, ``False`` to
+                disable the cache and release cached data.
+        """
+        self._cpp_object.cache_facet_pairs(cache)
+
 
 def get_integration_domains(
     integral_type: IntegralType,
@@ -332,9 +345,12 @@ def form(
         msh = domain.ufl_cargo()
         if msh is None:
             raise RuntimeError("Expecting to find a Mesh in the form.")
-        ufcx_form, module, code = jit.ffcx_jit(
-            msh.comm, form, form_compiler_options=form_compiler_options, jit_options=jit_options
-        )
+        try:
+            ufcx_form, module, code = compiled[id(form)]
+        except KeyError:
+            ufcx_form, module, code = jit.ffcx_jit(
+                msh.comm, form, form_compiler_options=form_compiler_options, jit_options=jit_options
+            )
 
         # For each argument in form extract its function space
         V = [arg.ufl_function_space()._cpp_object for arg in form.arguments()]
@@ -435,6 +451,35 @@ def form(
         else:
             return form
 
+    def _ufl_forms(form) -> list[ufl.Form]:
+        """Collect the UFL forms of a nested list of forms."""
+        if isinstance(form, ufl.Form):
+            return [form]
+        elif isinstance(form, ufl.ZeroBaseForm):
+            return []
+        elif isinstance(form, collections.abc.Iterable):
+            return [f for sub_form in form for f in _ufl_forms(sub_form)]
+        else:
+            return []
+
+    # Compile the forms of a list into one module, so that FFCx and the
+    # C compiler are invoked once and one shared library is loaded
+    compiled: dict[int, tuple] = {}
+    ufl_forms = list({id(f): f for f in _ufl_forms(form)}.values())
+    if len(ufl_forms) > 1:
+        domains = [list(f.subdomain_data().keys()) for f in ufl_forms]
+        meshes = [d[0].ufl_cargo() if len(d) == 1 else None for d in domains]
+        if all(msh is not None for msh in meshes) and all(
+            msh.comm == meshes[0].comm for msh in meshes
+        ):
+            ufcx_forms, module, code = jit.ffcx_jit(
+                meshes[0].comm,
+                ufl_forms,
+                form_compiler_options=form_compiler_options,
+                jit_options=jit_options,
+            )
+            compiled = {id(f): (u, module, code) for f, u in zip(ufl_forms, ufcx_forms)}
+
     return _create_form(form)
 
 
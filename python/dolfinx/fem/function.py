@@ -199,6 +199,7 @@ class Expression:
         mesh: Mesh,
         entities: np.ndarray,
         values: typing.Optional[np.ndarray] = None,
+        num_threads: int = 1,
     ) -> np.ndarray:
         """Evaluate Expression on entities.
 
@@ -214,6 +215,9 @@ class Expression:
                 ``(entities.shape[0], num_points, *value_shape,
                 argument_space_dim)`` if the Expression does have an
                 argument function.
+            num_threads: Number of threads to evaluate the Expression
+                with. The entities are divided into contiguous ranges,
+                one per thread.
 
         Returns:
             Expression evaluated at points for ``entities``. Shape is
@@ -251,7 +255,7 @@ class Expression:
         constants = _cpp.fem.pack_constants(self._cpp_object)
         coeffs = _cpp.fem.pack_coefficients(self._cpp_object, _entities)
         _cpp.fem.tabulate_expression(
-            values, self._cpp_object, constants, coeffs, mesh._cpp_object, _entities
+            values, self._cpp_object, constants, coeffs, mesh._cpp_object, _entities, num_threads
         )
         return values
 
@@ -426,6 +430,51 @@ class Function(ufl.Coefficient):
         """
         self._cpp_object.interpolate(u0._cpp_object, cells, interpolation_data._cpp_object)  # type: ignore
 
+    def interpolate_nonmatching_plan(self, u0: Function, plan) -> None:
+        """Interpolate a Function defined on one mesh to a function
+        defined on a different mesh, using precomputed data.
+
+        Args:
+            u0: The Function to interpolate.
+            plan: Interpolation plan. Created by
+                :func:`dolfinx.fem.create_interpolation_plan`.
+        """
+        self._cpp_object.interpolate(u0._cpp_object, plan)  # type: ignore
+
+    def interpolate_chunked(self, u0: typing.Callable, coords) -> None:
+        """Interpolate a callable one chunk of cells at a time.
+
+        Args:
+            u0: Callable function to interpolate. It is called with the
+                interpolation coordinates of each chunk of cells.
+            coords: Interpolation coordinates created by
+                :func:`dolfinx.fem.create_interpolation_coords` for the
+                function space of this function.
+        """
+        for i in range(coords.num_chunks):
+            values = np.asarray(u0(coords.x(i)), dtype=self.dtype)
+            self._cpp_object.interpolate(values, coords.cells(i))  # type: ignore
+
+    def interpolate_dofs(self, u0: typing.Callable, coords) -> None:
+        """Interpolate a callable at a subset of the degrees-of-freedom.
+
+        Only the degrees-of-freedom (including ghosts) of ``coords`` are
+        set; all other entries are left unchanged.
+
+        Args:
+            u0: Callable function to interpolate. It is called with the
+                coordinates of the degrees-of-freedom, with shape
+                ``(3, num_dofs)``.
+            coords: Degree-of-freedom coordinates created by
+                :func:`dolfinx.fem.create_dof_coordinates` for the
+                function space of this function.
+        """
+        bs = self.function_space.dofmap.bs
+        values = np.asarray(u0(coords.x()), dtype=self.dtype).reshape(bs, -1)
+        dofs = coords.dofs
+        for k in range(bs):
+            self.x.array[bs * dofs + k] = values[k]
+
     def interpolate(
         self,
         u0: typing.Union[typing.Callable, Expression, Function],
@@ -587,12 +636,20 @@ def functionspace(
         tuple[str, int, tuple],
         tuple[str, int, tuple, bool],
     ],
+    reorder_fn: typing.Optional[typing.Callable] = None,
+    num_threads: int = 1,
 ) -> FunctionSpace:
     """Create a finite element function space.
 
     Args:
         mesh: Mesh that space is defined on.
         element: Finite element description.
+        reorder_fn: Function that computes a re-ordering of the owned
+            degrees-of-freedom (blocks) from their graph, e.g.
+            ``dolfinx.cpp.graph.reorder_rcm``. It returns an array whose
+            ``i``th entry is the new index of node ``i``. If ``None``, the
+            degrees-of-freedom are numbered in cell order.
+        num_threads: Number of threads used to build the dofmap.
 
     Returns:
         A function space.
@@ -618,7 +675,13 @@ def functionspace(
 
     # Create DOLFINx objects
     element = finiteelement(mesh.topology.cell_type, ufl_e, dtype)  # type: ignore
-    cpp_dofmap = _cpp.fem.create_dofmap(mesh.comm, mesh.topology._cpp_object, element._cpp_object)  # type: ignore
+    cpp_dofmap = _cpp.fem.create_dofmap(
+        mesh.comm,
+        mesh.topology._cpp_object,
+        element._cpp_object,  # type: ignore
+        reorder_fn,
+        num_threads,
+    )
 
     assert np.issubdtype(mesh.geometry.x.dtype, element.dtype), (  # type: ignore
         "Mesh and element dtype are not compatible."
@@ -753,6 +816,11 @@ class FunctionSpace(ufl.FunctionSpace):
         """Degree-of-freedom map associated with the function space."""
         return dofmap.DofMap(self._cpp_object.dofmap)  # type: ignore
 
+    def memory_usage(self) -> int:
+        """Memory (bytes) used by the dofmaps of the function space. The
+        mesh is not included."""
+        return self._cpp_object.memory_usage()
+
     @property
     def mesh(self) -> Mesh:
         """Mesh on which the function space is defined."""
@@ -96,6 +96,20 @@ class BoundingBoxTree:
         """
         return self._cpp_object.bbox_coordinates
 
+    def refit(self, mesh: Mesh, padding: float = 0.0, num_threads: int = 1):
+        """Update the bounding boxes after the mesh geometry has changed.
+
+        The tree structure is kept and only the boxes are recomputed,
+        which is much cheaper than building a new tree.
+
+        Args:
+            mesh: The mesh that the tree was created for, with updated
+                geometry.
+            padding: Padding for each bounding box.
+            num_threads: Number of threads.
+        """
+        self._cpp_object.refit(mesh._cpp_object, padding, num_threads)
+
     def get_bbox(self, i) -> npt.NDArray[np.floating]:
         """Get lower and upper corners of the ith bounding box.
 
@@ -118,6 +132,7 @@ def bb_tree(
     dim: int,
     entities: typing.Optional[npt.NDArray[np.int32]] = None,
     padding: float = 0.0,
+    num_threads: int = 1,
 ) -> BoundingBoxTree:
     """Create a bounding box tree for use in collision detection.
 
@@ -127,6 +142,7 @@ def bb_tree(
         entities: List of entity indices (local to process). If not
             supplied, all owned and ghosted entities are used.
         padding: Padding for each bounding box.
+        num_threads: Number of threads to build the tree with.
 
     Returns:
         Bounding box tree.
@@ -139,11 +155,15 @@ def bb_tree(
     dtype = mesh.geometry.x.dtype
     if np.issubdtype(dtype, np.float32):
         return BoundingBoxTree(
-            _cpp.geometry.BoundingBoxTree_float32(mesh._cpp_object, dim, entities, padding)
+            _cpp.geometry.BoundingBoxTree_float32(
+                mesh._cpp_object, dim, entities, padding, num_threads
+            )
         )
     elif np.issubdtype(dtype, np.float64):
         return BoundingBoxTree(
-            _cpp.geometry.BoundingBoxTree_float64(mesh._cpp_object, dim, entities, padding)
+            _cpp.geometry.BoundingBoxTree_float64(
+                mesh._cpp_object, dim, entities, padding, num_threads
+            )
         )
     else:
         raise NotImplementedError(f"Type {dtype} not supported.")
@@ -166,7 +186,12 @@ def compute_collisions_trees(
     return _cpp.geometry.compute_collisions_trees(tree0._cpp_object, tree1._cpp_object)
 
 
-def compute_collisions_points(tree: BoundingBoxTree, x: npt.NDArray[np.floating]) -> AdjacencyList:
+def compute_collisions_points(
+    tree: BoundingBoxTree,
+    x: npt.NDArray[np.floating],
+    packet_size: int = 1,
+    num_threads: int = 1,
+) -> AdjacencyList:
     """Compute collisions between points and leaf bounding boxes.
 
     Bounding boxes can overlap, therefore points can collide with more
@@ -175,13 +200,19 @@ def compute_collisions_points(tree: BoundingBoxTree, x: npt.NDArray[np.floating]
     Args:
         tree: Bounding box tree.
         x: Points (``shape=(num_points, 3)``).
+        packet_size: Number of consecutive points that traverse the
+            tree together (1, 4, 8 or 16). Packets are efficient for
+            spatially ordered points.
+        num_threads: Number of threads.
 
     Returns:
        For each point, the bounding box leaves that collide with the
        point.
 
     """
-    return AdjacencyList(_cpp.geometry.compute_collisions_points(tree._cpp_object, x))
+    return AdjacencyList(
+        _cpp.geometry.compute_collisions_points(tree._cpp_object, x, packet_size, num_threads)
+    )
 
 
 def compute_closest_entity(
@@ -6,13 +6,28 @@
 """Tools for file input/output (IO)."""
 
 from dolfinx import cpp as _cpp
-from dolfinx.io import gmshio, vtkhdf
-from dolfinx.io.utils import VTKFile, XDMFFile, distribute_entity_data
+from dolfinx.io import checkpoint, gmshio, vtkhdf
+from dolfinx.io.utils import (
+    DatasetOptions,
+    FileOptions,
+    VTKFile,
+    XDMFFile,
+    distribute_entity_data,
+)
 
-__all__ = ["VTKFile", "XDMFFile", "distribute_entity_data", "gmshio", "vtkhdf"]
+__all__ = [
+    "DatasetOptions",
+    "FileOptions",
+    "VTKFile",
+    "XDMFFile",
+    "checkpoint",
+    "distribute_entity_data",
+    "gmshio",
+    "vtkhdf",
+]
 
 if _cpp.common.has_adios2:
     # VTXWriter requires ADIOS2
-    from dolfinx.io.utils import VTXMeshPolicy, VTXWriter
+    from dolfinx.io.utils import VTXFieldOptions, VTXMeshPolicy, VTXReader, VTXWriter
 
-    __all__ = [*__all__, "VTXWriter", "VTXMeshPolicy"]
+    __all__ = [*__all__, "VTXFieldOptions", "VTXReader", "VTXWriter", "VTXMeshPolicy"]
@@ -0,0 +1,107 @@
+# Copyright (C) 2026 The DOLFINx developers
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+"""Checkpointing of meshes and Functions.
+
+A checkpoint file holds a mesh and the values of Functions on it,
+ordered by the input node and cell indices, and the distribution of
+the mesh cells. A checkpoint that is read on the same number of
+processes re-creates the distribution of the mesh without graph
+partitioning. On a different number of processes the mesh is
+partitioned again.
+"""
+
+import typing
+from pathlib import Path
+
+from mpi4py import MPI as _MPI
+
+import numpy as np
+import numpy.typing as npt
+
+import basix
+import ufl
+from dolfinx.cpp.io import (
+    read_checkpoint_function,
+    read_checkpoint_mesh_float32,
+    read_checkpoint_mesh_float64,
+    write_checkpoint_function,
+    write_checkpoint_mesh,
+)
+from dolfinx.fem import Function
+from dolfinx.mesh import Mesh
+
+__all__ = ["read_function", "read_mesh", "write_function", "write_mesh"]
+
+
+def write_mesh(filename: typing.Union[str, Path], mesh: Mesh):
+    """Create a checkpoint file with a mesh.
+
+    Args:
+        filename: File to write to. An existing file is overwritten.
+        mesh: Mesh.
+    """
+    write_checkpoint_mesh(filename, mesh._cpp_object)
+
+
+def read_mesh(
+    comm: _MPI.Comm, filename: typing.Union[str, Path], dtype: npt.DTypeLike = np.float64
+) -> Mesh:
+    """Read a mesh from a checkpoint file.
+
+    Args:
+        comm: MPI communicator to create the mesh on.
+        filename: File to read from.
+        dtype: Scalar type of the mesh geometry.
+
+    Returns:
+        The mesh.
+    """
+    if np.dtype(dtype) == np.float64:
+        mesh_cpp = read_checkpoint_mesh_float64(comm, filename)
+    elif np.dtype(dtype) == np.float32:
+        mesh_cpp = read_checkpoint_mesh_float32(comm, filename)
+    else:
+        raise RuntimeError(f"Unsupported mesh geometry type: {dtype}")
+
+    cell_type = mesh_cpp.topology.cell_type
+    domain = ufl.Mesh(
+        basix.ufl.element(
+            "Lagrange",
+            cell_type.name,
+            mesh_cpp.geometry.cmap.degree,
+            mesh_cpp.geometry.cmap.variant,
+            shape=(mesh_cpp.geometry.dim,),
+            dtype=dtype,
+        )
+    )
+    return Mesh(mesh_cpp, domain)
+
+
+def write_function(filename: typing.Union[str, Path], u: Function):
+    """Add a Function to a checkpoint file.
+
+    The file must hold the mesh of the Function, written by
+    :func:`write_mesh`. The Function is stored under its name.
+
+    Args:
+        filename: Checkpoint file.
+        u: Function to write.
+    """
+    write_checkpoint_function(filename, u._cpp_object)
+
+
+def read_function(filename: typing.Union[str, Path], u: Function):
+    """Read the values of a Function from a checkpoint file.
+
+    The Function must be on the mesh read by :func:`read_mesh` from the
+    file and in the same space as the written Function. The values are
+    read from the Function in the file with the name of ``u``.
+
+    Args:
+        filename: Checkpoint file.
+        u: Function to read the values into.
+    """
+    read_checkpoint_function(filename, u._cpp_object)
@@ -6,6 +6,8 @@
 # SPDX-License-Identifier:    LGPL-3.0-or-later
 """Tools to extract data from Gmsh models."""
 
+import mmap
+import struct
 import typing
 from pathlib import Path
 
@@ -30,6 +32,7 @@ __all__ = [
     "extract_topology_and_markers",
     "model_to_mesh",
     "read_from_msh",
+    "read_from_msh_distributed",
     "ufl_mesh",
 ]
 
@@ -261,6 +264,58 @@ def extract_geometry(model, name: typing.Optional[str] = None) -> npt.NDArray[np
     return points[perm_sort]
 
 
+def _distribute_meshtags(
+    mesh: Mesh, meshtags: dict[int, tuple[npt.NDArray[np.int64], npt.NDArray[np.int32]]]
+) -> dict[str, typing.Optional[MeshTags]]:
+    """Create MeshTags from marked entities given on any process.
+
+    Args:
+        mesh: Mesh the entities belong to.
+        meshtags: Map from codimension to the marked entities, described
+            by their nodes in the original input ordering, and the
+            markers.
+
+    Returns:
+        Map from ``"cell_tags"``, ``"facet_tags"``, ``"ridge_tags"`` and
+        ``"peak_tags"`` to the MeshTags, or ``None`` if no entities of
+        the codimension are marked.
+    """
+    # Create MeshTags for all sub entities
+    topology = mesh.topology
+    tdim = topology.dim
+    codim_to_name = {0: "cell", 1: "facet", 2: "ridge", 3: "peak"}
+    dolfinx_meshtags: dict[str, typing.Optional[MeshTags]] = {}
+    for codim in [0, 1, 2, 3]:
+        key = f"{codim_to_name[codim]}_tags"
+        if (
+            codim == 1 and topology.cell_type == CellType.prism
+        ) or topology.cell_type == CellType.pyramid:
+            raise RuntimeError(f"Unsupported facet tag for type {topology.cell_type}")
+
+        meshtag_data = meshtags.get(codim, None)
+        if meshtag_data is None:
+            dolfinx_meshtags[key] = None
+            continue
+
+        # Distribute entity data [[e0_v0, e0_v1, ...], [e1_v0, e1_v1, ...],
+        # ...] which is made in global input indices to local indices on
+        # the owning process
+        (marked_entities, entity_values) = meshtag_data
+        local_entities, local_values = distribute_entity_data(
+            mesh, tdim - codim, marked_entities, entity_values
+        )
+        # Create MeshTags object from the local entities
+        mesh.topology.create_connectivity(tdim - codim, tdim)
+        adj = adjacencylist(local_entities)
+        et = meshtags_from_entities(
+            mesh, tdim - codim, adj, local_values.astype(np.int32, copy=False)
+        )
+        et.name = key
+        dolfinx_meshtags[key] = et
+
+    return dolfinx_meshtags
+
+
 def model_to_mesh(
     model,
     comm: _MPI.Comm,
@@ -371,37 +426,7 @@ def model_to_mesh(
         f"{mesh.topology.dim=} does not match Gmsh model dimension {tdim}"
     )
 
-    # Create MeshTags for all sub entities
-    topology = mesh.topology
-    codim_to_name = {0: "cell", 1: "facet", 2: "ridge", 3: "peak"}
-    dolfinx_meshtags: dict[str, typing.Optional[MeshTags]] = {}
-    for codim in [0, 1, 2, 3]:
-        key = f"{codim_to_name[codim]}_tags"
-        if (
-            codim == 1 and topology.cell_type == CellType.prism
-        ) or topology.cell_type == CellType.pyramid:
-            raise RuntimeError(f"Unsupported facet tag for type {topology.cell_type}")
-
-        meshtag_data = meshtags.get(codim, None)
-        if meshtag_data is None:
-            dolfinx_meshtags[key] = None
-            continue
-
-        # Distribute entity data [[e0_v0, e0_v1, ...], [e1_v0, e1_v1, ...],
-        # ...] which is made in global input indices to local indices on
-        # the owning process
-        (marked_entities, entity_values) = meshtag_data
-        local_entities, local_values = distribute_entity_data(
-            mesh, tdim - codim, marked_entities, entity_values
-        )
-        # Create MeshTags object from the local entities
-        mesh.topology.create_connectivity(tdim - codim, tdim)
-        adj = adjacencylist(local_entities)
-        et = meshtags_from_entities(
-            mesh, tdim - codim, adj, local_values.astype(np.int32, copy=False)
-        )
-        et.name = key
-        dolfinx_meshtags[key] = et
+    dolfinx_meshtags = _distribute_meshtags(mesh, meshtags)
 
     # Broadcast physical groups (string to integer mapping) to all ranks
     if comm.rank == rank:
@@ -457,3 +482,352 @@ def read_from_msh(
         return msh
     else:
         return model_to_mesh(gmsh.model, comm, rank, gdim=gdim, partitioner=partitioner)
+
+
+# Number of nodes of the Gmsh element types, used to step over element
+# blocks in binary MSH files
+_gmsh_num_nodes = {
+    1: 2,
+    2: 3,
+    3: 4,
+    4: 4,
+    5: 8,
+    6: 6,
+    7: 5,
+    8: 3,
+    9: 6,
+    10: 9,
+    11: 10,
+    12: 27,
+    13: 18,
+    14: 14,
+    15: 1,
+    16: 8,
+    17: 20,
+    18: 15,
+    19: 13,
+    20: 9,
+    21: 10,
+    22: 12,
+    23: 15,
+    24: 15,
+    25: 21,
+    26: 4,
+    27: 5,
+    28: 6,
+    29: 20,
+    30: 35,
+    31: 56,
+    36: 16,
+    37: 25,
+    92: 64,
+    93: 125,
+}
+
+
+class _MshBlock(typing.NamedTuple):
+    """Entity block of the ``$Nodes`` or ``$Elements`` section of a
+    binary MSH file.
+
+    Args:
+        dim: Dimension of the Gmsh entity.
+        tag: Tag of the Gmsh entity.
+        element_type: Gmsh element type (``$Elements`` blocks only).
+        size: Number of nodes or elements in the block.
+        offset: Byte offset of the block data.
+        parametric: Number of parametric coordinates per node
+            (``$Nodes`` blocks only).
+    """
+
+    dim: int
+    tag: int
+    element_type: int
+    size: int
+    offset: int
+    parametric: int
+
+
+class _MshHeader(typing.NamedTuple):
+    """Metadata of a binary MSH file.
+
+    Args:
+        physical_names: Map from physical group ``(dim, tag)`` to name.
+        entity_physicals: Map from Gmsh entity ``(dim, tag)`` to the tags
+            of the physical groups it belongs to.
+        node_blocks: Blocks of the ``$Nodes`` section.
+        min_node_tag: Smallest node tag.
+        max_node_tag: Largest node tag.
+        element_blocks: Blocks of the ``$Elements`` section.
+    """
+
+    physical_names: dict[tuple[int, int], str]
+    entity_physicals: dict[tuple[int, int], list[int]]
+    node_blocks: list[_MshBlock]
+    min_node_tag: int
+    max_node_tag: int
+    element_blocks: list[_MshBlock]
+
+
+def _read_msh_header(buffer) -> _MshHeader:
+    """Read the metadata of a binary MSH 4.1 file.
+
+    Only the entity and block headers are read. The node and element
+    data are stepped over, which touches a small part of a large file.
+
+    Args:
+        buffer: Memory-mapped file.
+
+    Returns:
+        Metadata of the file.
+    """
+    def readline(pos: int) -> tuple[str, int]:
+        end = buffer.find(b"\n", pos)
+        if end < 0:
+            raise RuntimeError("Unexpected end of MSH file.")
+        return buffer[pos:end].decode().strip(), end + 1
+
+    def unpack(fmt: str, pos: int) -> tuple[tuple, int]:
+        return struct.unpack_from(f"<{fmt}", buffer, pos), pos + struct.calcsize(f"<{fmt}")
+
+    physical_names: dict[tuple[int, int], str] = {}
+    entity_physicals: dict[tuple[int, int], list[int]] = {}
+    node_blocks: list[_MshBlock] = []
+    element_blocks: list[_MshBlock] = []
+    node_tag_range = (0, -1)
+    has_format, has_nodes, has_elements = False, False, False
+    pos = 0
+    while pos < len(buffer) and not (has_nodes and has_elements):
+        section, pos = readline(pos)
+        if section == "":
+            continue
+        elif not section.startswith("$"):
+            raise RuntimeError(f"Unexpected line '{section}' in MSH file.")
+        elif section == "$MeshFormat":
+            fmt, pos = readline(pos)
+            version, file_type, data_size = fmt.split()
+            if version != "4.1" or file_type != "1" or data_size != "8":
+                raise RuntimeError(
+                    f"Unsupported MSH format '{fmt}'. A binary MSH 4.1 file is required."
+                )
+            (one,), pos = unpack("i", pos)
+            if one != 1:
+                raise RuntimeError("Unsupported byte order of MSH file.")
+            has_format = True
+        elif not has_format:
+            raise RuntimeError("MSH file does not start with $MeshFormat.")
+        elif section == "$PhysicalNames":
+            line, pos = readline(pos)
+            for _ in range(int(line)):
+                line, pos = readline(pos)
+                dim, tag, name = line.split(maxsplit=2)
+                physical_names[(int(dim), int(tag))] = name.strip('"')
+        elif section == "$Entities":
+            num_entities, pos = unpack("4Q", pos)
+            for dim, num in enumerate(num_entities):
+                for _ in range(num):
+                    (tag,), pos = unpack("i", pos)
+                    pos += 8 * (3 if dim == 0 else 6)
+                    (num_physicals,), pos = unpack("Q", pos)
+                    physicals, pos = unpack(f"{num_physicals}i", pos)
+                    entity_physicals[(dim, tag)] = list(physicals)
+                    if dim > 0:
+                        (num_bounding,), pos = unpack("Q", pos)
+                        pos += 4 * num_bounding
+        elif section == "$PartitionedEntities":
+            raise RuntimeError("Partitioned MSH files are not supported.")
+        elif section == "$Nodes":
+            (num_blocks, _, min_tag, max_tag), pos = unpack("4Q", pos)
+            node_tag_range = (min_tag, max_tag)
+            for _ in range(num_blocks):
+                (dim, tag, parametric, size), pos = unpack("3iQ", pos)
+                parametric = dim if parametric else 0
+                node_blocks.append(_MshBlock(dim, tag, -1, size, pos, parametric))
+                pos += 8 * size * (4 + parametric)
+            has_nodes = True
+        elif section == "$Elements":
+            (num_blocks, _, _, _), pos = unpack("4Q", pos)
+            for _ in range(num_blocks):
+                (dim, tag, element_type, size), pos = unpack("3iQ", pos)
+                try:
+                    num_nodes = _gmsh_num_nodes[element_type]
+                except KeyError:
+                    raise RuntimeError(f"Unknown cell type {element_type}.")
+                element_blocks.append(_MshBlock(dim, tag, element_type, size, pos, 0))
+                pos += 8 * size * (1 + num_nodes)
+            has_elements = True
+
+        # Step to the end of the section. Sections that are not used are
+        # skipped.
+        end = buffer.find(f"$End{section[1:]}".encode(), pos)
+        if end < 0:
+            raise RuntimeError(f"Unterminated section {section} in MSH file.")
+        _, pos = readline(end)
+
+    if not (has_nodes and has_elements):
+        raise RuntimeError("MSH file has no $Nodes or $Elements section.")
+
+    return _MshHeader(
+        physical_names, entity_physicals, node_blocks, *node_tag_range, element_blocks
+    )
+
+
+def _block_slices(
+    sizes: typing.Sequence[int], start: int, stop: int
+) -> typing.Iterator[tuple[int, int, int]]:
+    """Split a range of rows of a sequence of blocks into per-block
+    ranges.
+
+    Args:
+        sizes: Number of rows in each block.
+        start: First row of the range.
+        stop: End of the range (exclusive).
+
+    Returns:
+        Iterator over ``(block, first row, end row)``, where the rows are
+        counted from the start of the block.
+    """
+    offset = 0
+    for i, size in enumerate(sizes):
+        b0, b1 = max(start - offset, 0), min(stop - offset, size)
+        if b0 < b1:
+            yield i, b0, b1
+        offset += size
+
+
+def _local_range(comm: _MPI.Comm, n: int) -> tuple[int, int]:
+    """Contiguous range of ``n`` rows owned by this rank."""
+    return n * comm.rank // comm.size, n * (comm.rank + 1) // comm.size
+
+
+def read_from_msh_distributed(
+    filename: typing.Union[str, Path],
+    comm: _MPI.Comm,
+    gdim: int = 3,
+    partitioner: typing.Optional[
+        typing.Callable[[_MPI.Comm, int, int, AdjacencyList], AdjacencyList_int32]
+    ] = None,
+    dtype=default_real_type,
+) -> MeshData:
+    """Read a binary Gmsh MSH 4.1 file in parallel.
+
+    Unlike :func:`read_from_msh`, the file is not processed on one rank
+    and scattered. Each rank memory-maps the file, reads the entity and
+    block headers, and then reads a contiguous slice of the nodes, of
+    the cells and of the marked lower-dimensional entities. The slices
+    are passed to :func:`dolfinx.mesh.create_mesh` and
+    :func:`dolfinx.io.distribute_entity_data`, which accept distributed
+    input, so no rank holds more than its share of the mesh.
+
+    The mesh is created from the elements of the highest topological
+    dimension that belong to a physical group, as for
+    :func:`model_to_mesh`.
+
+    Note:
+        This function does not require the Gmsh Python module. The
+        node tags in the file must be contiguous, which is the case for
+        files written by Gmsh unless nodes have been removed, and the
+        file must not be partitioned. A file can be converted to the
+        required format with
+        ``gmsh -save -format msh4 -bin -o out.msh in.msh``.
+
+    Args:
+        filename: Name of ``.msh`` file.
+        comm: MPI communicator to create the mesh on.
+        gdim: Geometric dimension of the mesh.
+        partitioner: Function that computes the parallel
+            distribution of cells across MPI ranks.
+        dtype: Scalar type of the mesh geometry.
+
+    Returns:
+        Meshdata with mesh, cell tags, facet tags, edge tags,
+        vertex tags and physical groups.
+    """
+    with open(filename, "rb") as f, mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as buffer:
+        header = _read_msh_header(buffer)
+        num_nodes_global = sum(block.size for block in header.node_blocks)
+        if header.max_node_tag - header.min_node_tag + 1 != num_nodes_global:
+            raise RuntimeError(
+                "Node tags of the MSH file are not contiguous. "
+                "Renumber the nodes with gmsh.model.mesh.renumberNodes()."
+            )
+
+        # Read a slice of the nodes in file order
+        n0, n1 = _local_range(comm, num_nodes_global)
+        node_tags, node_coords = [], []
+        sizes = [block.size for block in header.node_blocks]
+        for i, b0, b1 in _block_slices(sizes, n0, n1):
+            block = header.node_blocks[i]
+            node_tags.append(
+                np.frombuffer(buffer, np.int64, b1 - b0, block.offset + 8 * b0).copy()
+            )
+            offset = block.offset + 8 * block.size + 8 * b0 * (3 + block.parametric)
+            coords = np.frombuffer(buffer, np.float64, (b1 - b0) * (3 + block.parametric), offset)
+            node_coords.append(coords.reshape(-1, 3 + block.parametric)[:, :3].copy())
+            del coords
+
+        # Marked element blocks by dimension, with one block entry per
+        # physical group that the Gmsh entity belongs to
+        marked_blocks: dict[int, list[tuple[_MshBlock, int]]] = {}
+        for block in header.element_blocks:
+            for physical in header.entity_physicals.get((block.dim, block.tag), []):
+                marked_blocks.setdefault(block.dim, []).append((block, physical))
+        if len(marked_blocks) == 0:
+            raise RuntimeError("MSH file has no elements in physical groups.")
+        tdim = max(marked_blocks.keys())
+
+        # Read a slice of the marked entities of each dimension
+        meshtags: dict[int, tuple[npt.NDArray[np.int64], npt.NDArray[np.int32]]] = {}
+        element_types: dict[int, int] = {}
+        for dim, blocks in marked_blocks.items():
+            types = {block.element_type for block, _ in blocks}
+            if len(types) > 1:
+                raise RuntimeError(f"Unsupported mesh with multiple cell types {types}.")
+            element_type = types.pop()
+            num_nodes = _gmsh_num_nodes[element_type]
+            e0, e1 = _local_range(comm, sum(block.size for block, _ in blocks))
+            topologies, markers = [np.empty((0, num_nodes), dtype=np.int64)], []
+            for i, b0, b1 in _block_slices([block.size for block, _ in blocks], e0, e1):
+                block, physical = blocks[i]
+                offset = block.offset + 8 * b0 * (1 + num_nodes)
+                data = np.frombuffer(buffer, np.int64, (b1 - b0) * (1 + num_nodes), offset)
+                topologies.append(data.reshape(-1, 1 + num_nodes)[:, 1:] - header.min_node_tag)
+                markers.append(np.full(b1 - b0, physical, dtype=np.int32))
+                del data
+            markers.append(np.empty(0, dtype=np.int32))
+            meshtags[tdim - dim] = (np.vstack(topologies), np.hstack(markers))
+            element_types[dim] = element_type
+
+        physicals = {(dim, p) for dim, blocks in marked_blocks.items() for _, p in blocks}
+        physical_groups = {
+            header.physical_names.get((dim, tag), ""): (dim, tag) for dim, tag in sorted(physicals)
+        }
+
+    # Send the nodes to the rank that owns their input index, so that
+    # the rows of the geometry are in input order across ranks
+    node_index = np.hstack(node_tags + [np.empty(0, np.int64)]) - header.min_node_tag
+    node_x = np.vstack(node_coords + [np.empty((0, 3))])
+    offsets = np.array([num_nodes_global * r // comm.size for r in range(comm.size + 1)])
+    dest = np.searchsorted(offsets, node_index, side="right") - 1
+    perm = np.argsort(dest, kind="stable")
+    send_sizes = np.bincount(dest, minlength=comm.size).astype(np.int64)
+    recv_sizes = np.array(comm.alltoall(send_sizes.tolist()), dtype=np.int64)
+    recv_index = np.empty(recv_sizes.sum(), dtype=np.int64)
+    recv_x = np.empty((recv_sizes.sum(), 3), dtype=np.float64)
+    comm.Alltoallv((node_index[perm], send_sizes), (recv_index, recv_sizes))
+    comm.Alltoallv(
+        (np.ascontiguousarray(node_x[perm]), 3 * send_sizes), (recv_x, 3 * recv_sizes)
+    )
+    x = np.empty((offsets[comm.rank + 1] - offsets[comm.rank], 3), dtype=np.float64)
+    x[recv_index - offsets[comm.rank]] = recv_x
+
+    # Create the mesh from the local slices of the nodes and cells
+    ufl_domain = ufl_mesh(element_types[tdim], gdim, dtype=dtype)
+    num_nodes = _gmsh_num_nodes[element_types[tdim]]
+    gmsh_cell_perm = cell_perm_array(_cpp.mesh.to_type(str(ufl_domain.ufl_cell())), num_nodes)
+    cell_connectivity = meshtags[0][0][:, gmsh_cell_perm].copy()
+    mesh = create_mesh(
+        comm, cell_connectivity, x[:, :gdim].astype(dtype, copy=False), ufl_domain, partitioner
+    )
+
+    dolfinx_meshtags = _distribute_meshtags(mesh, meshtags)
+    return MeshData(mesh, physical_groups=physical_groups, **dolfinx_meshtags)
@@ -18,12 +18,21 @@ import basix
 import basix.ufl
 import ufl
 from dolfinx import cpp as _cpp
+from dolfinx.cpp.io import DatasetOptions, FileOptions
 from dolfinx.cpp.io import perm_gmsh as cell_perm_gmsh
 from dolfinx.cpp.io import perm_vtk as cell_perm_vtk
 from dolfinx.fem import Function
 from dolfinx.mesh import CellType, Geometry, GhostMode, Mesh, MeshTags
 
-__all__ = ["VTKFile", "XDMFFile", "cell_perm_gmsh", "cell_perm_vtk", "distribute_entity_data"]
+__all__ = [
+    "DatasetOptions",
+    "FileOptions",
+    "VTKFile",
+    "XDMFFile",
+    "cell_perm_gmsh",
+    "cell_perm_vtk",
+    "distribute_entity_data",
+]
 
 
 def _extract_cpp_objects(functions: typing.Union[Mesh, Function, tuple[Function], list[Function]]):
@@ -36,9 +45,9 @@ def _extract_cpp_objects(functions: typing.Union[Mesh, Function, tuple[Function]
 
 # VTXWriter requires ADIOS2
 if _cpp.common.has_adios2:
-    from dolfinx.cpp.io import VTXMeshPolicy  # F401
+    from dolfinx.cpp.io import VTXFieldOptions, VTXMeshPolicy  # F401
 
-    __all__ = [*__all__, "VTXWriter", "VTXMeshPolicy"]
+    __all__ = [*__all__, "VTXFieldOptions", "VTXReader", "VTXWriter", "VTXMeshPolicy"]
 
     class VTXWriter:
         """Writer for VTX files, using ADIOS2 to create the files.
@@ -59,6 +68,8 @@ if _cpp.common.has_adios2:
             output: typing.Union[Mesh, Function, list[Function], tuple[Function]],
             engine: str = "BPFile",
             mesh_policy: VTXMeshPolicy = VTXMeshPolicy.update,
+            async_write: bool = False,
+            params: typing.Optional[dict[str, str]] = None,
         ):
             """Initialize a writer for outputting data in the VTX format.
 
@@ -75,11 +86,21 @@ if _cpp.common.has_adios2:
                     written to file, or is re-written (updated) at each
                     time step. Has an effect only for ``Function``
                     output.
+                async_write: If ``True``, ``write`` returns once the
+                    data has been copied, and the step is written to
+                    disk in the background (BP5 engine). ``close``
+                    waits for the write to complete. Has an effect only
+                    for ``Function`` output.
+                params: ADIOS2 engine parameters. For streaming engines,
+                    e.g. ``"SST"``, these control the coupling with the
+                    readers, e.g. ``{"RendezvousReaderCount": "1",
+                    "QueueLimit": "2", "QueueFullPolicy": "Block"}``.
 
             Note:
                 All Functions for output must share the same mesh and
                 have the same element type.
             """
+            params = {} if params is None else params
             # Get geometry type
             try:
                 dtype = output.geometry.x.dtype  # type: ignore
@@ -96,11 +117,23 @@ if _cpp.common.has_adios2:
 
             try:
                 # Input is a mesh
-                self._cpp_object = _vtxwriter(comm, filename, output._cpp_object, engine)  # type: ignore[union-attr]
+                self._cpp_object = _vtxwriter(
+                    comm,
+                    filename,
+                    output._cpp_object,  # type: ignore[union-attr]
+                    engine,
+                    params,
+                )
             except (NotImplementedError, TypeError, AttributeError):
                 # Input is a single function or a list of functions
                 self._cpp_object = _vtxwriter(
-                    comm, filename, _extract_cpp_objects(output), engine, mesh_policy
+                    comm,
+                    filename,
+                    _extract_cpp_objects(output),
+                    engine,
+                    mesh_policy,
+                    async_write,
+                    params,
                 )  # type: ignore[arg-type]
 
         def __enter__(self):
@@ -109,12 +142,134 @@ if _cpp.common.has_adios2:
         def __exit__(self, exception_type, exception_value, traceback):
             self.close()
 
+        def set_field_options(self, name: str, options: VTXFieldOptions):
+            """Set the precision and compression of a Function.
+
+            Must be called before the first write.
+
+            Args:
+                name: Name of the Function.
+                options: Precision and compression of the values, e.g.
+                    ``single_precision=True`` or an error bounded lossy
+                    compressor with ``operator_type="zfp"`` and
+                    ``operator_params={"accuracy": "1e-4"}``.
+            """
+            self._cpp_object.set_field_options(name, options)
+
+        def set_cells(self, cells: npt.NDArray[np.int32]):
+            """Restrict the output to a subset of the cells.
+
+            Only the nodes of the cells and the values at these nodes
+            are written, e.g. for a region of interest that is written
+            more often than the full field. The restricted topology is
+            computed once and re-used by all writes.
+
+            Must be called before the first write.
+
+            Args:
+                cells: Local indices of the cells to write, typically
+                    owned cells.
+            """
+            self._cpp_object.set_cells(np.asarray(cells, dtype=np.int32))
+
         def write(self, t: float):
             self._cpp_object.write(t)
 
         def close(self):
             self._cpp_object.close()
 
+    class VTXReader:
+        """Reader for the Functions written by a :class:`VTXWriter`.
+
+        Steps are read one at a time from a file or from an ADIOS2
+        stream, e.g. with the ``"SST"`` engine for in-transit analysis
+        of a running simulation. A file can also be opened for random
+        access to its steps, e.g. to restart a simulation from a chosen
+        step.
+
+        Each process reads the data written by the process with the
+        same rank. The Functions must be on the same distributed mesh
+        and in the same spaces as the written Functions, which is
+        checked when the first step is read.
+        """
+
+        _cpp_object: typing.Union[_cpp.io.VTXReader_float32, _cpp.io.VTXReader_float64]
+
+        def __init__(
+            self,
+            comm: _MPI.Comm,
+            filename: typing.Union[str, Path],
+            u: typing.Union[Function, list[Function], tuple[Function]],
+            engine: str = "BPFile",
+            params: typing.Optional[dict[str, str]] = None,
+            random_access: bool = False,
+        ):
+            """Initialize a reader for Functions in the VTX format.
+
+            Args:
+                comm: The MPI communicator.
+                filename: The file or stream name.
+                u: Function(s) to read into. The Functions are read
+                    from the data with their names.
+                engine: ADIOS2 engine to use for input.
+                params: ADIOS2 engine parameters.
+                random_access: Open a file for random access to its
+                    steps with :func:`read_step`, instead of reading
+                    the steps in order with :func:`read`.
+            """
+            u = [u] if isinstance(u, Function) else u
+            dtype = u[0].function_space.mesh.geometry.x.dtype
+            if np.issubdtype(dtype, np.float32):
+                _vtxreader = _cpp.io.VTXReader_float32
+            elif np.issubdtype(dtype, np.float64):
+                _vtxreader = _cpp.io.VTXReader_float64
+            params = {} if params is None else params
+            self._cpp_object = _vtxreader(
+                comm, filename, _extract_cpp_objects(u), engine, params, random_access
+            )
+
+        def __enter__(self):
+            return self
+
+        def __exit__(self, exception_type, exception_value, traceback):
+            self.close()
+
+        def read(self, timeout: float = -1.0) -> typing.Optional[float]:
+            """Read the next step into the Functions.
+
+            Args:
+                timeout: Time in seconds to wait for the step. If
+                    negative, wait until a step is available or the
+                    stream has ended.
+
+            Returns:
+                The time stamp of the step, or ``None`` if the stream
+                has ended or no step became available in time.
+            """
+            return self._cpp_object.read(timeout)
+
+        def num_steps(self) -> int:
+            """Number of steps in a file opened for random access."""
+            return self._cpp_object.num_steps()
+
+        def times(self) -> list[float]:
+            """Time stamps of the steps in a file opened for random access."""
+            return self._cpp_object.times()
+
+        def read_step(self, step: int) -> float:
+            """Read a step of a file opened for random access into the Functions.
+
+            Args:
+                step: Index of the step.
+
+            Returns:
+                The time stamp of the step.
+            """
+            return self._cpp_object.read_step(step)
+
+        def close(self):
+            self._cpp_object.close()
+
 
 class VTKFile(_cpp.io.VTKFile):
     """Interface to VTK files.
@@ -122,6 +277,10 @@ class VTKFile(_cpp.io.VTKFile):
     VTK supports arbitrary order Lagrange finite elements for the
     geometry description. XDMF is the preferred format for geometry
     order <= 2.
+
+    The data arrays are written as ASCII by default. Pass
+    ``encoding=VTKFile.Encoding.Binary`` to write binary (base64)
+    arrays, which is faster and gives smaller files.
     """
 
     def __enter__(self):
@@ -14,7 +14,13 @@ import numpy.typing as npt
 
 import basix
 import ufl
-from dolfinx.cpp.io import read_vtkhdf_mesh_float32, read_vtkhdf_mesh_float64, write_vtkhdf_mesh
+from dolfinx.cpp.io import (
+    read_vtkhdf_mesh_float32,
+    read_vtkhdf_mesh_float64,
+    write_vtkhdf_data,
+    write_vtkhdf_mesh,
+)
+from dolfinx.fem import Function
 from dolfinx.mesh import Mesh
 
 
@@ -62,3 +68,24 @@ def write_mesh(filename: typing.Union[str, Path], mesh: Mesh):
         mesh: Mesh.
     """
     write_vtkhdf_mesh(filename, mesh._cpp_object)
+
+
+def write_data(
+    filename: typing.Union[str, Path],
+    u: typing.Union[Function, list[Function]],
+    t: float,
+):
+    """Append a time step with the values of Functions to a VTKHDF file
+
+    The file must hold the mesh of the Functions, written by
+    :func:`write_mesh`. All steps share the mesh. Lagrange Functions
+    with the dof layout of the mesh geometry are written as point data,
+    and piecewise constant Functions as cell data.
+
+    Args:
+        filename: File to write to.
+        u: Function(s) to write at the step.
+        t: Time of the step.
+    """
+    u = [u] if isinstance(u, Function) else u
+    write_vtkhdf_data(filename, [v._cpp_object for v in u], t)
@@ -6,8 +6,10 @@
 """Just-in-time (JIT) compilation using FFCx"""
 
 import functools
+import inspect
 import json
 import os
+import shutil
 import sys
 from pathlib import Path
 from typing import Optional
@@ -30,6 +32,11 @@ DOLFINX_DEFAULT_JIT_OPTIONS = {
     "cffi_verbose": (False, "CFFI verbose mode"),
     "cffi_libraries": (None, "Extra libraries to link"),
     "timeout": (10, "Timeout for JIT compilation"),
+    "node_cache_dir": (
+        None,
+        "Node-local directory (e.g. on /tmp) that compiled modules are copied to from cache_dir. "
+        "In parallel, processes load the copy instead of cache_dir.",
+    ),
 }
 
 if sys.platform.startswith("win32"):
@@ -53,7 +60,15 @@ def mpi_jit_decorator(local_jit, *args, **kwargs):
     in the cache, it will call the jit compiler on the remaining
     processes, which will then use the cached module.
 
+    If the JIT option ``node_cache_dir`` is set, one process on each
+    shared-memory node copies the compiled module from ``cache_dir`` to
+    ``node_cache_dir``, and the remaining processes load the copy. This
+    avoids all processes loading the module from the same, typically
+    shared, file system. The shared ``cache_dir`` is used if the copy
+    fails.
+
     """
+    signature = inspect.signature(local_jit)
 
     @functools.wraps(local_jit)
     def mpi_jit(comm, *args, **kwargs):
@@ -87,6 +102,18 @@ def mpi_jit_decorator(local_jit, *args, **kwargs):
         if global_status == 0:
             # Success, call jit on all other processes (this should just
             # read the cache)
+            if "jit_options" in signature.parameters:
+                bound = signature.bind(*args, **kwargs)
+                jit_options = bound.arguments.get("jit_options")
+                node_cache_dir = get_options(jit_options)["node_cache_dir"]
+                if node_cache_dir is not None:
+                    files = comm.bcast(_module_files(output[1]) if root else None, root=0)
+                    if _replicate_module(comm, files, Path(node_cache_dir)):
+                        bound.arguments["jit_options"] = {
+                            **(jit_options or {}),
+                            "cache_dir": node_cache_dir,
+                        }
+                        args, kwargs = bound.args, bound.kwargs
             if not root:
                 output = local_jit(*args, **kwargs)
         else:
@@ -102,6 +129,54 @@ def mpi_jit_decorator(local_jit, *args, **kwargs):
     return mpi_jit
 
 
+def _module_files(module) -> list[Path]:
+    """Files of a compiled module in the JIT cache.
+
+    Args:
+        module: Compiled CFFI module.
+
+    Returns:
+        Paths of the shared library and of the files that FFCx uses to
+        detect a cached module, with the file that marks the module as
+        ready last.
+    """
+    path = Path(module.__file__)
+    files = sorted(path.parent.glob(f"{module.__name__}.*"))
+    return sorted(files, key=lambda f: f.suffix == ".cached")
+
+
+def _replicate_module(comm: MPI.Comm, files: list[Path], node_cache_dir: Path) -> bool:
+    """Copy a compiled module to a node-local cache directory.
+
+    The files are copied by one process on each shared-memory node.
+    Each file is written to a temporary file and renamed, so that
+    processes of other jobs on the same node never see a partial copy.
+
+    Args:
+        comm: MPI communicator.
+        files: Files of the module (see :func:`_module_files`).
+        node_cache_dir: Node-local cache directory.
+
+    Returns:
+        ``True`` if the module was copied on all nodes.
+    """
+    node_comm = comm.Split_type(MPI.COMM_TYPE_SHARED)
+    status = 0
+    if node_comm.rank == 0:
+        try:
+            node_cache_dir.mkdir(exist_ok=True, parents=True)
+            for file in files:
+                target = node_cache_dir / file.name
+                if not target.exists():
+                    tmp = target.with_name(f"{target.name}.{os.getpid()}.tmp")
+                    shutil.copy2(file, tmp)
+                    os.replace(tmp, target)
+        except OSError:
+            status = 1
+    node_comm.Free()
+    return comm.allreduce(status, op=MPI.MAX) == 0
+
+
 @functools.cache
 def _load_options():
     """Loads options from JSON files."""
@@ -175,6 +250,10 @@ def ffcx_jit(
     Returns:
         (compiled object, module, (header code, implementation code))
 
+        If ``ufl_object`` is a list of forms, the forms are compiled
+        into one module and the compiled object is a list with the
+        compiled forms.
+
     Note:
         Priority ordering of options controlling DOLFINx JIT
         compilation from highest to lowest is:
@@ -208,10 +287,18 @@ def ffcx_jit(
     """
     p_ffcx = ffcx.get_options(form_compiler_options)
     p_jit = get_options(jit_options)
+    p_jit.pop("node_cache_dir")
 
     # Switch on type and compile, returning cffi object
     if isinstance(ufl_object, ufl.Form):
         r = ffcx.codegeneration.jit.compile_forms([ufl_object], options=p_ffcx, **p_jit)
+    elif (
+        isinstance(ufl_object, list)
+        and len(ufl_object) > 0
+        and all(isinstance(form, ufl.Form) for form in ufl_object)
+    ):
+        r = ffcx.codegeneration.jit.compile_forms(ufl_object, options=p_ffcx, **p_jit)
+        return (r[0], r[1], r[2])
     elif isinstance(ufl_object, tuple) and isinstance(ufl_object[0], ufl.core.expr.Expr):
         r = ffcx.codegeneration.jit.compile_expressions([ufl_object], options=p_ffcx, **p_jit)
     else:
@@ -72,6 +72,11 @@ class Vector:
         """Index map that describes size and parallel distribution."""
         return self._cpp_object.index_map
 
+    def memory_usage(self) -> int:
+        """Memory (bytes) used by the vector data, scatter buffers and
+        scatterer."""
+        return self._cpp_object.memory_usage()
+
     @property
     def block_size(self) -> int:
         """Block size for the vector."""
@@ -102,6 +107,29 @@ class Vector:
             self._petsc_x = create_vector_wrap(self)
         return self._petsc_x
 
+    def __dlpack__(self, *, stream=None, **kwargs):
+        """Export the local entries (owned and ghost) through DLPack.
+
+        The data is shared, so that frameworks that support DLPack,
+        e.g. CuPy, PyTorch and JAX, can use the vector entries without
+        a copy, e.g. ``torch.from_dlpack(u.x)``.
+
+        Args:
+            stream: Stream for device synchronisation, see the DLPack
+                Python specification.
+            kwargs: Further arguments of the DLPack Python
+                specification, passed on to the exporter.
+
+        Returns:
+            DLPack capsule.
+        """
+        return self.array.__dlpack__(stream=stream, **kwargs)
+
+    def __dlpack_device__(self) -> tuple[int, int]:
+        """Device type and device id of the vector data, see the DLPack
+        Python specification."""
+        return self.array.__dlpack_device__()
+
     def scatter_forward(self) -> None:
         """Update ghost entries."""
         self._cpp_object.scatter_forward()
@@ -153,6 +181,11 @@ class MatrixCSR:
         """
         return self._cpp_object.index_map(i)
 
+    def memory_usage(self) -> int:
+        """Memory (bytes) used by the values, sparsity structure and
+        scatter data of the matrix."""
+        return self._cpp_object.memory_usage()
+
     def mult(self, x: Vector, y: Vector) -> None:
         """Compute ``y += Ax``.
 
@@ -209,7 +242,13 @@ class MatrixCSR:
 
     @property
     def data(self) -> npt.NDArray[np.floating]:
-        """Underlying matrix entry data."""
+        """Underlying matrix entry data.
+
+        Note:
+            The entry data and the sparsity arrays :attr:`indices` and
+            :attr:`indptr` are shared, and support DLPack, e.g.
+            ``torch.from_dlpack(A.data)``.
+        """
         return self._cpp_object.data
 
     @property
@@ -22,11 +22,19 @@ import numpy as np
 import numpy.typing as npt
 
 import dolfinx
-from dolfinx.la import IndexMap, Vector
+from dolfinx import cpp as _cpp
+from dolfinx.la import IndexMap, MatrixCSR, Vector
 
 assert dolfinx.has_petsc4py
 
-__all__ = ["assign", "create_vector", "create_vector_wrap"]
+__all__ = [
+    "assign",
+    "create_matrix",
+    "create_matrix_shell",
+    "create_vector",
+    "create_vector_wrap",
+    "update_matrix",
+]
 
 
 def _ghost_update(x: PETSc.Vec, insert_mode: PETSc.InsertMode, scatter_mode: PETSc.ScatterMode):  # type: ignore
@@ -72,6 +80,68 @@ def create_vector_wrap(x: Vector) -> PETSc.Vec:  # type: ignore[name-defined]
     )
 
 
+def create_matrix(A: MatrixCSR) -> PETSc.Mat:  # type: ignore[name-defined]
+    """Create a PETSc matrix with the entries of a DOLFINx CSR matrix.
+
+    The PETSc ``MPIAIJ`` matrix stores its diagonal and off-diagonal
+    blocks in arrays split from ``A``. Assembly into ``A`` avoids the
+    overhead of ``MatSetValues``, and :func:`update_matrix` copies the
+    entries of ``A`` into the PETSc matrix in a single pass.
+
+    Note:
+        Contributions to ghost rows of ``A`` are ignored, so
+        ``A.scatter_reverse()`` should be called before this function.
+
+    Args:
+        A: Matrix to create the PETSc matrix from. Its scalar type must
+            be the PETSc scalar type.
+
+    Returns:
+        PETSc matrix with the sparsity and entries of ``A``.
+    """
+    return _cpp.la.petsc.create_matrix(A._cpp_object)
+
+
+def update_matrix(B: PETSc.Mat, A: MatrixCSR) -> None:  # type: ignore[name-defined]
+    """Copy the entries of a DOLFINx CSR matrix into a PETSc matrix.
+
+    Args:
+        B: PETSc matrix created by :func:`create_matrix` from a matrix
+            with the same sparsity pattern as ``A``.
+        A: Matrix to copy the entries from.
+    """
+    _cpp.la.petsc.update_matrix(B, A._cpp_object)
+
+
+def create_matrix_shell(
+    A: MatrixCSR, num_threads: int = 1
+) -> PETSc.Mat:  # type: ignore[name-defined]
+    """Create a PETSc shell matrix that applies a DOLFINx CSR matrix.
+
+    The product of the shell matrix is computed by the DOLFINx CSR
+    matrix-vector product, so the entries of ``A`` are not copied and
+    changes to ``A`` are seen by the shell matrix without an update.
+    The shell matrix can be used as an operator of a SLEPc eigenvalue
+    solver that only requires matrix-vector products.
+
+    Note:
+        Contributions to ghost rows of ``A`` are ignored, so
+        ``A.scatter_reverse()`` should be called before the shell matrix
+        is applied.
+
+    Args:
+        A: Matrix to apply. Its scalar type must be the PETSc scalar
+            type.
+        num_threads: Number of threads used for the product.
+
+    Returns:
+        PETSc shell matrix. It holds a reference to ``A``.
+    """
+    B = _cpp.la.petsc.create_matrix_shell(A._cpp_object, num_threads)
+    B.setAttr("_dolfinx_matrix_csr", A)
+    return B
+
+
 @functools.singledispatch
 def assign(x0: typing.Union[npt.NDArray[np.inexact], list[npt.NDArray[np.inexact]]], x1: PETSc.Vec):  # type: ignore
     """Assign ``x0`` values to a PETSc vector ``x1``.
@@ -26,30 +26,38 @@ from dolfinx.cpp.mesh import (
     DiagonalType,
     GhostMode,
     build_dual_graph,
+    build_dual_graph_hashed,
     cell_dim,
     create_cell_partitioner,
     to_string,
     to_type,
 )
-from dolfinx.cpp.refinement import RefinementOption
+from dolfinx.cpp.refinement import Marking, RefinementOption
 from dolfinx.fem import CoordinateElement as _CoordinateElement
 from dolfinx.fem import coordinate_element as _coordinate_element
 from dolfinx.graph import AdjacencyList
 
+if typing.TYPE_CHECKING:
+    from dolfinx.la import Vector
+
 __all__ = [
     "CellType",
     "Geometry",
     "GhostMode",
+    "Marking",
     "Mesh",
     "MeshTags",
     "Topology",
     "build_dual_graph",
+    "build_dual_graph_hashed",
     "cell_dim",
     "compute_incident_entities",
     "compute_midpoints",
+    "compute_parent_to_sub_entity_map",
     "create_box",
     "create_cell_partitioner",
     "create_geometry",
+    "create_group_mesh",
     "create_interval",
     "create_mesh",
     "create_rectangle",
@@ -59,10 +67,14 @@ __all__ = [
     "create_unit_square",
     "entities_to_geometry",
     "exterior_facet_indices",
+    "extend_ghosting",
     "locate_entities",
     "locate_entities_boundary",
+    "mark_edges",
     "meshtags",
     "meshtags_from_entities",
+    "redistribute",
+    "redistribute_meshtag",
     "refine",
     "to_string",
     "to_type",
@@ -132,9 +144,14 @@ class Topology:
         """
         return self._cpp_object.create_entities(dim)
 
-    def create_entity_permutations(self):
-        """Compute entity permutations and reflections."""
-        self._cpp_object.create_entity_permutations()
+    def create_entity_permutations(self, num_threads: int = 1):
+        """Compute entity permutations and reflections.
+
+        Args:
+            num_threads: Number of threads used to create the entities and
+                to compute the permutations.
+        """
+        self._cpp_object.create_entity_permutations(num_threads)
 
     @property
     def dim(self) -> int:
@@ -212,6 +229,11 @@ class Topology:
         computed."""
         return self._cpp_object.interprocess_facets()
 
+    def memory_usage(self) -> int:
+        """Memory (bytes) used by the connectivities, index maps and
+        permutation data of the topology."""
+        return self._cpp_object.memory_usage()
+
     @property
     def original_cell_index(self) -> npt.NDArray[np.int64]:
         """Get the original cell index"""
@@ -265,6 +287,11 @@ class Geometry:
         (nodes)."""
         return self._cpp_object.index_map()
 
+    def memory_usage(self) -> int:
+        """Memory (bytes) used by the coordinates, dofmaps and index map
+        of the geometry."""
+        return self._cpp_object.memory_usage()
+
     @property
     def input_global_indices(self) -> npt.NDArray[np.int64]:
         """Global input indices of the geometry nodes."""
@@ -343,7 +370,9 @@ class Mesh:
         """Return the Basix cell type."""
         return getattr(basix.CellType, self.topology.cell_name())
 
-    def h(self, dim: int, entities: npt.NDArray[np.int32]) -> npt.NDArray[np.float64]:
+    def h(
+        self, dim: int, entities: npt.NDArray[np.int32], num_threads: int = 1
+    ) -> npt.NDArray[np.float64]:
         """Geometric size measure of cell entities.
 
         Args:
@@ -351,11 +380,16 @@ class Mesh:
                 size measure of.
             entities: Indices of entities of dimension ``dim`` to
                 compute size measure of.
+            num_threads: Number of threads.
 
         Returns:
             Size measure for each requested entity.
         """
-        return _cpp.mesh.h(self._cpp_object, dim, entities)
+        return _cpp.mesh.h(self._cpp_object, dim, entities, num_threads)
+
+    def memory_usage(self) -> int:
+        """Memory (bytes) used by the topology and geometry of the mesh."""
+        return self._cpp_object.memory_usage()
 
     @property
     def topology(self) -> Topology:
@@ -453,18 +487,46 @@ def compute_incident_entities(
     return _cpp.mesh.compute_incident_entities(topology._cpp_object, entities, d0, d1)
 
 
-def compute_midpoints(msh: Mesh, dim: int, entities: npt.NDArray[np.int32]):
+def compute_parent_to_sub_entity_map(
+    topology: Topology, dim: int, sub_to_parent: npt.NDArray[np.int32]
+) -> npt.NDArray[np.int32]:
+    """Compute the inverse of a map from sub-mesh entities to parent mesh
+    entities.
+
+    The inverse map is the entity map required to assemble forms over
+    the parent mesh that involve functions on a sub-mesh created with
+    :func:`create_submesh`.
+
+    Args:
+        topology: Topology of the parent mesh.
+        dim: Topological dimension of the parent mesh entities.
+        sub_to_parent: Map from sub-mesh cells to parent mesh entities
+            of dimension ``dim``, e.g. the entity map returned by
+            :func:`create_submesh`.
+
+    Returns:
+        Map from (owned and ghost) parent mesh entities of dimension
+        ``dim`` to sub-mesh cells. Entities that are not in the sub-mesh
+        are mapped to -1.
+    """
+    return _cpp.mesh.compute_parent_to_sub_entity_map(topology._cpp_object, dim, sub_to_parent)
+
+
+def compute_midpoints(
+    msh: Mesh, dim: int, entities: npt.NDArray[np.int32], num_threads: int = 1
+):
     """Compute the midpoints of a set of mesh entities.
 
     Args:
         msh: The mesh.
         dim: Topological dimension of the mesh entities to consider.
         entities: Indices of entities in ``mesh`` to consider.
+        num_threads: Number of threads.
 
     Returns:
         Midpoints of the entities, shape ``(num_entities, 3)``.
     """
-    return _cpp.mesh.compute_midpoints(msh._cpp_object, dim, entities)
+    return _cpp.mesh.compute_midpoints(msh._cpp_object, dim, entities, num_threads)
 
 
 def locate_entities(msh: Mesh, dim: int, marker: typing.Callable) -> np.ndarray:
@@ -547,6 +609,39 @@ def transfer_meshtag(
         raise RuntimeError("MeshTag transfer is supported on on cells or facets.")
 
 
+def mark_edges(
+    msh: Mesh, eta: Vector, theta: float, strategy: Marking = Marking.dorfler
+) -> npt.NDArray[np.int32]:
+    """Mark edges for refinement from cell error indicators.
+
+    Cells are marked with a distributed threshold search on the
+    indicators, without gathering them on a single process. For
+    :attr:`Marking.dorfler`, a minimal set of cells whose indicators
+    sum to at least ``theta`` times the sum of all indicators is
+    marked. For :attr:`Marking.maximum`, cells with an indicator of at
+    least ``theta`` times the largest indicator are marked.
+
+    Note:
+        The cell-to-edge connectivity must have been computed, e.g. by
+        ``msh.topology.create_connectivity(tdim, 1)``.
+
+    Args:
+        msh: Mesh with the cells that ``eta`` is defined on.
+        eta: Cell indicators, e.g. the (real) vector of a DG0 function.
+            The indicators are assumed to be additive, e.g. squared
+            local error estimates.
+        theta: Marking fraction in ``[0, 1]``.
+        strategy: Marking strategy.
+
+    Returns:
+        Sorted indices of the edges of the marked cells, which can be
+        passed to :func:`refine`.
+    """
+    return _cpp.refinement.mark_edges(
+        msh.topology._cpp_object, eta._cpp_object, theta, strategy
+    )
+
+
 def refine(
     msh: Mesh,
     edges: typing.Optional[np.ndarray] = None,
@@ -592,6 +687,106 @@ def refine(
     return Mesh(mesh1, ufl_domain), parent_cell, parent_facet
 
 
+def redistribute(
+    msh: Mesh,
+    partitioner: typing.Callable = create_cell_partitioner(GhostMode.none),
+) -> Mesh:
+    """Redistribute a mesh across processes.
+
+    The cells and geometry of the mesh are migrated to the ranks that
+    are computed by the partitioner, e.g. to restore the load balance
+    after refinement. Meshtags can be transferred to the new mesh using
+    :func:`redistribute_meshtag`.
+
+    Args:
+        msh: Mesh to redistribute.
+        partitioner: Partitioner that computes the new owning rank of
+            each cell.
+
+    Returns:
+        Redistributed mesh.
+    """
+    mesh1 = _cpp.mesh.redistribute(msh._cpp_object, partitioner)
+    ufl_domain = ufl.Mesh(msh._ufl_domain.ufl_coordinate_element())  # type: ignore
+    return Mesh(mesh1, ufl_domain)
+
+
+def create_group_mesh(
+    msh: Mesh,
+    group_comm: _MPI.Comm,
+    partitioner: typing.Callable = create_cell_partitioner(GhostMode.none),
+) -> Mesh:
+    """Create a copy of a mesh on a group of ranks.
+
+    Every group of ranks, e.g. created by
+    :func:`dolfinx.common.split_comm`, receives a complete copy of
+    ``msh``. The input node indices and original cell indices of the
+    copy are those of ``msh``, but the cells are numbered differently.
+    Function spaces on the copy are created with the element of the
+    space on ``msh``, e.g. ``functionspace(group_mesh, V.ufl_element())``.
+
+    Note:
+        This function is collective on the communicator of ``msh``.
+
+    Args:
+        msh: Mesh to copy. Only meshes with a single cell type are
+            supported.
+        group_comm: Communicator of the group of the caller. Each rank
+            of the communicator of ``msh`` must belong to one group.
+        partitioner: Partitioner that computes the owning rank in the
+            group of each cell.
+
+    Returns:
+        Copy of the mesh distributed on ``group_comm``.
+    """
+    mesh1 = _cpp.mesh.create_group_mesh(msh.comm, msh._cpp_object, group_comm, partitioner)
+    ufl_domain = ufl.Mesh(msh._ufl_domain.ufl_coordinate_element())  # type: ignore
+    return Mesh(mesh1, ufl_domain)
+
+
+def extend_ghosting(msh: Mesh, num_ghost_layers: int) -> Mesh:
+    """Create a mesh with the same cell ownership as ``msh`` and more
+    layers of ghost cells.
+
+    The mesh is not repartitioned and owned cells do not migrate, which
+    is much cheaper than creating the mesh again. Meshtags can be
+    transferred to the new mesh using :func:`redistribute_meshtag`.
+
+    Args:
+        msh: Mesh to extend the ghosting of.
+        num_ghost_layers: Number of layers of ghost cells. Each layer
+            adds the cells that share a facet with the previous layer.
+
+    Returns:
+        Mesh with ``num_ghost_layers`` layers of ghost cells.
+    """
+    mesh1 = _cpp.mesh.extend_ghosting(msh._cpp_object, num_ghost_layers)
+    ufl_domain = ufl.Mesh(msh._ufl_domain.ufl_coordinate_element())  # type: ignore
+    return Mesh(mesh1, ufl_domain)
+
+
+def redistribute_meshtag(meshtag: MeshTags, msh0: Mesh, msh1: Mesh) -> MeshTags:
+    """Transfer a meshtag to a mesh that was created by :func:`redistribute`
+    or :func:`extend_ghosting`.
+
+    Args:
+        meshtag: Meshtag (with ``int32`` values) on ``msh0``.
+        msh0: Mesh that ``meshtag`` is defined on.
+        msh1: Mesh created by redistributing ``msh0``.
+
+    Returns:
+        Meshtag on ``msh1``.
+    """
+    dim = meshtag.dim
+    msh0.topology.create_connectivity(dim, msh0.topology.dim)
+    msh0.topology.create_connectivity(msh0.topology.dim, dim)
+    msh1.topology.create_entities(dim)
+    mt = _cpp.mesh.redistribute_meshtags(
+        meshtag._cpp_object, msh0._cpp_object, msh1._cpp_object
+    )
+    return MeshTags(mt)
+
+
 def create_mesh(
     comm: _MPI.Comm,
     cells: npt.NDArray[np.int64],
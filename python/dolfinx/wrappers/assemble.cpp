@@ -18,6 +18,7 @@
 #include <dolfinx/fem/FunctionSpace.h>
 #include <dolfinx/fem/assembler.h>
 #include <dolfinx/fem/discreteoperators.h>
+#include <dolfinx/fem/pack.h>
 #include <dolfinx/fem/sparsitybuild.h>
 #include <dolfinx/fem/utils.h>
 #include <dolfinx/la/MatrixCSR.h>
@@ -47,134 +48,105 @@ namespace md = MDSPAN_IMPL_STANDARD_NAMESPACE;
 namespace
 {
 
-template <typename U>
-dolfinx::la::SparsityPattern
-create_sparsity(const dolfinx::fem::FunctionSpace<U>& V0,
-                const dolfinx::fem::FunctionSpace<U>& V1)
-{
-  assert(V0.mesh());
-  auto mesh = V0.mesh();
-  assert(V1.mesh());
-  assert(mesh == V1.mesh());
-  MPI_Comm comm = mesh->comm();
-
-  auto dofmap0 = V0.dofmap();
-  assert(dofmap0);
-  auto dofmap1 = V1.dofmap();
-  assert(dofmap1);
-
-  // Create and build  sparsity pattern
-  assert(dofmap0->index_map);
-  assert(dofmap1->index_map);
-  dolfinx::la::SparsityPattern sp(
-      comm, {dofmap1->index_map, dofmap0->index_map},
-      {dofmap1->index_map_bs(), dofmap0->index_map_bs()});
-
-  int tdim = mesh->topology()->dim();
-  auto map = mesh->topology()->index_map(tdim);
-  assert(map);
-  std::vector<std::int32_t> c(map->size_local(), 0);
-  std::iota(c.begin(), c.end(), 0);
-  dolfinx::fem::sparsitybuild::cells(sp, {c, c}, {*dofmap1, *dofmap0});
-  sp.finalize();
-
-  return sp;
-}
-
 // Declare assembler function that have multiple scalar types
 template <typename T, typename U>
 void declare_discrete_operators(nb::module_& m)
 {
-  m.def("interpolation_matrix",
-        [](const dolfinx::fem::FunctionSpace<U>& V0,
-           const dolfinx::fem::FunctionSpace<U>& V1)
-        {
-          // Create sparsity
-          dolfinx::la::SparsityPattern sp = create_sparsity(V0, V1);
-
-          // Build operator
-          dolfinx::la::MatrixCSR<T> A(sp);
-
-          auto [bs0, bs1] = A.block_size();
-          if (bs0 == 1 and bs1 == 1)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<1, 1>());
-          }
-          else if (bs0 == 2 and bs1 == 1)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<2, 1>());
-          }
-          else if (bs0 == 1 and bs1 == 2)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<1, 2>());
-          }
-          else if (bs0 == 2 and bs1 == 2)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<2, 2>());
-          }
-          else if (bs0 == 3 and bs1 == 1)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<3, 1>());
-          }
-          else if (bs0 == 1 and bs1 == 3)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<1, 3>());
-          }
-          else if (bs0 == 3 and bs1 == 3)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<3, 3>());
-          }
-          else
-          {
-            throw std::runtime_error(
-                "Interpolation matrix not supported between block sizes "
-                + std::to_string(bs0) + " and " + std::to_string(bs1));
-          }
-
-          return A;
-        });
-
   m.def(
-      "discrete_curl",
+      "interpolation_matrix",
       [](const dolfinx::fem::FunctionSpace<U>& V0,
-         const dolfinx::fem::FunctionSpace<U>& V1)
+         const dolfinx::fem::FunctionSpace<U>& V1, int num_threads)
       {
-        dolfinx::la::SparsityPattern sp = create_sparsity(V0, V1);
-
-        // Build operator
-        dolfinx::la::MatrixCSR<T> A(sp);
-        dolfinx::fem::discrete_curl<U, T>(V0, V1, A.mat_set_values());
-        return A;
+        return dolfinx::fem::interpolation_matrix<T, U>(V0, V1,
+                                                        num_threads);
       },
-      nb::arg("V0"), nb::arg("V1"));
+      nb::arg("V0"), nb::arg("V1"), nb::arg("num_threads") = 1);
 
   m.def(
-      "discrete_gradient",
+      "discrete_curl",
       [](const dolfinx::fem::FunctionSpace<U>& V0,
-         const dolfinx::fem::FunctionSpace<U>& V1)
-      {
-        dolfinx::la::SparsityPattern sp = create_sparsity(V0, V1);
+         const dolfinx::fem::FunctionSpace<U>& V1, int num_threads)
+      { return dolfinx::fem::discrete_curl<U, T>(V0, V1, num_threads); },
+      nb::arg("V0"), nb::arg("V1"), nb::arg("num_threads") = 1);
 
-        // Build operator
-        dolfinx::la::MatrixCSR<T> A(sp);
-        dolfinx::fem::discrete_gradient<T, U>(
-            *V0.mesh()->topology_mutable(), {*V0.element(), *V0.dofmap()},
-            {*V1.element(), *V1.dofmap()}, A.mat_set_values());
-        return A;
-      },
-      nb::arg("V0"), nb::arg("V1"));
+  m.def(
+      "discrete_gradient",
+      [](const dolfinx::fem::FunctionSpace<U>& V0,
+         const dolfinx::fem::FunctionSpace<U>& V1, int num_threads)
+      { return dolfinx::fem::discrete_gradient<T, U>(V0, V1, num_threads); },
+      nb::arg("V0"), nb::arg("V1"), nb::arg("num_threads") = 1);
 }
 
 // Declare assembler function that have multiple scalar types
+// Assemble a bilinear form into a MatrixCSR, dispatching on the block
+// size of the matrix
+template <typename T, typename U>
+void assemble_csr_matrix(
+    dolfinx::la::MatrixCSR<T>& A, const dolfinx::fem::Form<T, U>& a,
+    std::span<const T> constants,
+    const std::map<std::pair<dolfinx::fem::IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::vector<
+        std::reference_wrapper<const dolfinx::fem::DirichletBC<T, U>>>& bcs)
+{
+  // Get index map block size. Note that mixed-topology meshes will have
+  // multiple DOF maps, but the block sizes are the same.
+  const std::array<int, 2> data_bs
+      = {a.function_spaces().at(0)->dofmaps(0)->index_map_bs(),
+         a.function_spaces().at(1)->dofmaps(0)->index_map_bs()};
+  if (data_bs[0] != data_bs[1])
+    throw std::runtime_error("Non-square blocksize unsupported in Python");
+
+  auto assemble = [&]<int BS>()
+  {
+    if constexpr (BS == 1)
+    {
+      dolfinx::fem::assemble_matrix(A.mat_add_values(), a, constants,
+                                    coefficients, bcs);
+    }
+    else
+    {
+      auto mat_add = A.template mat_add_values<BS, BS>();
+      dolfinx::fem::assemble_matrix(mat_add, a, constants, coefficients, bcs);
+    }
+  };
+
+  switch (data_bs[0])
+  {
+  case 1:
+    assemble.template operator()<1>();
+    break;
+  case 2:
+    assemble.template operator()<2>();
+    break;
+  case 3:
+    assemble.template operator()<3>();
+    break;
+  case 4:
+    assemble.template operator()<4>();
+    break;
+  case 5:
+    assemble.template operator()<5>();
+    break;
+  case 6:
+    assemble.template operator()<6>();
+    break;
+  case 7:
+    assemble.template operator()<7>();
+    break;
+  case 8:
+    assemble.template operator()<8>();
+    break;
+  case 9:
+    assemble.template operator()<9>();
+    break;
+  default:
+    throw std::runtime_error("Block size not supported in Python");
+  }
+}
+
 template <typename T, typename U>
-void declare_assembly_functions(nb::module_& m)
+void declare_assembly_functions(nb::module_& m, const std::string& type)
 {
   // Coefficient/constant packing
   m.def(
@@ -266,20 +238,13 @@ void declare_assembly_functions(nb::module_& m)
          nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants,
          nb::ndarray<const T, nb::ndim<2>, nb::c_contig> coeffs,
          const dolfinx::mesh::Mesh<U>& mesh,
-         nb::ndarray<const std::int32_t, nb::c_contig> entities)
+         nb::ndarray<const std::int32_t, nb::c_contig> entities,
+         int num_threads)
       {
         std::optional<std::pair<
             std::reference_wrapper<const dolfinx::fem::FiniteElement<U>>,
             std::size_t>>
-            element = std::nullopt;
-        if (auto V = e.argument_space(); V)
-        {
-          std::size_t num_argument_dofs
-              = V->dofmap()->element_dof_layout().num_dofs()
-                * V->dofmap()->bs();
-          assert(V->element());
-          element = {std::cref(*V->element()), num_argument_dofs};
-        }
+            element = dolfinx::fem::impl::expression_argument_element(e);
 
         if (entities.ndim() == 1)
         {
@@ -287,7 +252,8 @@ void declare_assembly_functions(nb::module_& m)
               std::span<T>(values.data(), values.size()), e,
               md::mdspan(coeffs.data(), coeffs.shape(0), coeffs.shape(1)),
               std::span(constants.data(), constants.size()), mesh,
-              md::mdspan(entities.data(), entities.size()), element);
+              md::mdspan(entities.data(), entities.size()), element,
+              num_threads);
         }
         else if (entities.ndim() == 2)
         {
@@ -299,7 +265,7 @@ void declare_assembly_functions(nb::module_& m)
               md::mdspan<const std::int32_t,
                          md::extents<std::size_t, md::dynamic_extent, 2>>(
                   entities.data(), entities.shape(0), entities.shape(1)),
-              element);
+              element, num_threads);
         }
         else
         {
@@ -309,20 +275,24 @@ void declare_assembly_functions(nb::module_& m)
       },
       nb::arg("values"), nb::arg("expression"), nb::arg("constants"),
       nb::arg("coefficients"), nb::arg("mesh"), nb::arg("entities"),
-      "Evaluate an Expression on mesh entities.");
+      nb::arg("num_threads") = 1, "Evaluate an Expression on mesh entities.");
   m.def(
       "assemble_scalar",
       [](const dolfinx::fem::Form<T, U>& M,
          nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants,
          const std::map<std::pair<dolfinx::fem::IntegralType, int>,
                         nb::ndarray<const T, nb::ndim<2>, nb::c_contig>>&
-             coefficients)
+             coefficients,
+         int num_threads)
       {
+        auto _coefficients = dolfinx_wrappers::py_to_cpp_coeffs(coefficients);
+        nb::gil_scoped_release release;
         return dolfinx::fem::assemble_scalar<T>(
-            M, std::span(constants.data(), constants.size()),
-            dolfinx_wrappers::py_to_cpp_coeffs(coefficients));
+            M, std::span(constants.data(), constants.size()), _coefficients,
+            num_threads);
       },
       nb::arg("M"), nb::arg("constants"), nb::arg("coefficients"),
+      nb::arg("num_threads") = 1,
       "Assemble functional over mesh with provided constants and "
       "coefficients");
   // Vector
@@ -335,10 +305,11 @@ void declare_assembly_functions(nb::module_& m)
                         nb::ndarray<const T, nb::ndim<2>, nb::c_contig>>&
              coefficients)
       {
+        auto _coefficients = dolfinx_wrappers::py_to_cpp_coeffs(coefficients);
+        nb::gil_scoped_release release;
         dolfinx::fem::assemble_vector<T>(
             std::span(b.data(), b.size()), L,
-            std::span(constants.data(), constants.size()),
-            dolfinx_wrappers::py_to_cpp_coeffs(coefficients));
+            std::span(constants.data(), constants.size()), _coefficients);
       },
       nb::arg("b"), nb::arg("L"), nb::arg("constants"), nb::arg("coeffs"),
       "Assemble linear form into an existing vector with pre-packed constants "
@@ -362,86 +333,79 @@ void declare_assembly_functions(nb::module_& m)
           _bcs.push_back(*bc);
         }
 
-        // Get index map block size. Note that mixed-topology meshes
-        // will have multiple DOF maps, but the block sizes are the same.
-        const std::array<int, 2> data_bs
-            = {a.function_spaces().at(0)->dofmaps(0)->index_map_bs(),
-               a.function_spaces().at(1)->dofmaps(0)->index_map_bs()};
+        auto _coefficients = dolfinx_wrappers::py_to_cpp_coeffs(coefficients);
+        nb::gil_scoped_release release;
+        assemble_csr_matrix(
+            A, a, std::span<const T>(constants.data(), constants.size()),
+            _coefficients, _bcs);
+      },
+      nb::arg("A"), nb::arg("a"), nb::arg("constants"), nb::arg("coeffs"),
+      nb::arg("bcs"), "Experimental.");
 
-        if (data_bs[0] != data_bs[1])
+  // Assembly with coefficients packed by a CoefficientPacker. The GIL
+  // is released during packing and assembly.
+  using packer_t = dolfinx::fem::CoefficientPacker<T, U>;
+  std::string pyclass_name = std::string("CoefficientPacker_") + type;
+  nb::class_<packer_t>(m, pyclass_name.c_str(),
+                       "Packed form coefficients that are reused between "
+                       "assemblies")
+      .def(nb::init<const dolfinx::fem::Form<T, U>&, int>(), nb::arg("form"),
+           nb::arg("num_threads") = 1, nb::keep_alive<1, 2>())
+      .def("reset", &packer_t::reset,
+           "Repack all coefficients in the next assembly");
+  m.def(
+      "assemble_scalar",
+      [](const dolfinx::fem::Form<T, U>& M,
+         nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants,
+         packer_t& packer)
+      {
+        nb::gil_scoped_release release;
+        return dolfinx::fem::assemble_scalar<T>(
+            M, std::span(constants.data(), constants.size()),
+            dolfinx::fem::make_coefficients_span(packer.pack()));
+      },
+      nb::arg("M"), nb::arg("constants"), nb::arg("packer"),
+      "Assemble functional with coefficients from a packer");
+  m.def(
+      "assemble_vector",
+      [](nb::ndarray<T, nb::ndim<1>, nb::c_contig> b,
+         const dolfinx::fem::Form<T, U>& L,
+         nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants,
+         packer_t& packer)
+      {
+        nb::gil_scoped_release release;
+        dolfinx::fem::assemble_vector<T>(
+            std::span(b.data(), b.size()), L,
+            std::span(constants.data(), constants.size()),
+            dolfinx::fem::make_coefficients_span(packer.pack()));
+      },
+      nb::arg("b"), nb::arg("L"), nb::arg("constants"), nb::arg("packer"),
+      "Assemble linear form into an existing vector with coefficients from "
+      "a packer");
+  m.def(
+      "assemble_matrix",
+      [](dolfinx::la::MatrixCSR<T>& A, const dolfinx::fem::Form<T, U>& a,
+         nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants,
+         packer_t& packer,
+         std::vector<const dolfinx::fem::DirichletBC<T, U>*> bcs)
+      {
+        std::vector<
+            std::reference_wrapper<const dolfinx::fem::DirichletBC<T, U>>>
+            _bcs;
+        for (auto bc : bcs)
         {
-          throw std::runtime_error(
-              "Non-square blocksize unsupported in Python");
+          assert(bc);
+          _bcs.push_back(*bc);
         }
 
-        if (data_bs[0] == 1)
-        {
-          dolfinx::fem::assemble_matrix(
-              A.mat_add_values(), a,
-              std::span<const T>(constants.data(), constants.size()),
-              dolfinx_wrappers::py_to_cpp_coeffs(coefficients), _bcs);
-        }
-        else if (data_bs[0] == 2)
-        {
-          auto mat_add = A.template mat_add_values<2, 2>();
-          dolfinx::fem::assemble_matrix(
-              mat_add, a, std::span(constants.data(), constants.size()),
-              dolfinx_wrappers::py_to_cpp_coeffs(coefficients), _bcs);
-        }
-        else if (data_bs[0] == 3)
-        {
-          auto mat_add = A.template mat_add_values<3, 3>();
-          dolfinx::fem::assemble_matrix(
-              mat_add, a, std::span(constants.data(), constants.size()),
-              dolfinx_wrappers::py_to_cpp_coeffs(coefficients), _bcs);
-        }
-        else if (data_bs[0] == 4)
-        {
-          auto mat_add = A.template mat_add_values<4, 4>();
-          dolfinx::fem::assemble_matrix(
-              mat_add, a, std::span(constants.data(), constants.size()),
-              dolfinx_wrappers::py_to_cpp_coeffs(coefficients), _bcs);
-        }
-        else if (data_bs[0] == 5)
-        {
-          auto mat_add = A.template mat_add_values<5, 5>();
-          dolfinx::fem::assemble_matrix(
-              mat_add, a, std::span(constants.data(), constants.size()),
-              dolfinx_wrappers::py_to_cpp_coeffs(coefficients), _bcs);
-        }
-        else if (data_bs[0] == 6)
-        {
-          auto mat_add = A.template mat_add_values<6, 6>();
-          dolfinx::fem::assemble_matrix(
-              mat_add, a, std::span(constants.data(), constants.size()),
-              dolfinx_wrappers::py_to_cpp_coeffs(coefficients), _bcs);
-        }
-        else if (data_bs[0] == 7)
-        {
-          auto mat_add = A.template mat_add_values<7, 7>();
-          dolfinx::fem::assemble_matrix(
-              mat_add, a, std::span(constants.data(), constants.size()),
-              dolfinx_wrappers::py_to_cpp_coeffs(coefficients), _bcs);
-        }
-        else if (data_bs[0] == 8)
-        {
-          auto mat_add = A.template mat_add_values<8, 8>();
-          dolfinx::fem::assemble_matrix(
-              mat_add, a, std::span(constants.data(), constants.size()),
-              dolfinx_wrappers::py_to_cpp_coeffs(coefficients), _bcs);
-        }
-        else if (data_bs[0] == 9)
-        {
-          auto mat_add = A.template mat_add_values<9, 9>();
-          dolfinx::fem::assemble_matrix(
-              mat_add, a, std::span(constants.data(), constants.size()),
-              dolfinx_wrappers::py_to_cpp_coeffs(coefficients), _bcs);
-        }
-        else
-          throw std::runtime_error("Block size not supported in Python");
+        nb::gil_scoped_release release;
+        assemble_csr_matrix(
+            A, a, std::span<const T>(constants.data(), constants.size()),
+            dolfinx::fem::make_coefficients_span(packer.pack()), _bcs);
       },
-      nb::arg("A"), nb::arg("a"), nb::arg("constants"), nb::arg("coeffs"),
-      nb::arg("bcs"), "Experimental.");
+      nb::arg("A"), nb::arg("a"), nb::arg("constants"), nb::arg("packer"),
+      nb::arg("bcs"),
+      "Assemble bilinear form into a matrix with coefficients from a packer");
   m.def(
       "insert_diagonal",
       [](dolfinx::la::MatrixCSR<T>& A, const dolfinx::fem::FunctionSpace<U>& V,
@@ -579,10 +543,10 @@ namespace dolfinx_wrappers
 void assemble(nb::module_& m)
 {
   // dolfinx::fem::assemble
-  declare_assembly_functions<float, float>(m);
-  declare_assembly_functions<double, double>(m);
-  declare_assembly_functions<std::complex<float>, float>(m);
-  declare_assembly_functions<std::complex<double>, double>(m);
+  declare_assembly_functions<float, float>(m, "float32");
+  declare_assembly_functions<double, double>(m, "float64");
+  declare_assembly_functions<std::complex<float>, float>(m, "complex64");
+  declare_assembly_functions<std::complex<double>, double>(m, "complex128");
 
   declare_discrete_operators<float, float>(m);
   declare_discrete_operators<double, double>(m);
@@ -8,10 +8,15 @@
 #include "dolfinx_wrappers/array.h"
 #include "dolfinx_wrappers/caster_mpi.h"
 #include <complex>
+#include <filesystem>
+#include <dolfinx/common/CommStats.h>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MemoryUsage.h>
+#include <dolfinx/common/PerfCounters.h>
 #include <dolfinx/common/Scatterer.h>
 #include <dolfinx/common/Table.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/Trace.h>
 #include <dolfinx/common/defines.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/timing.h>
@@ -21,6 +26,7 @@
 #include <nanobind/ndarray.h>
 #include <nanobind/stl/array.h>
 #include <nanobind/stl/chrono.h>
+#include <nanobind/stl/filesystem.h>
 #include <nanobind/stl/map.h>
 #include <nanobind/stl/optional.h>
 #include <nanobind/stl/pair.h>
@@ -94,7 +100,8 @@ void common(nb::module_& m)
   nb::enum_<dolfinx::Table::Reduction>(m, "Reduction")
       .value("max", dolfinx::Table::Reduction::max)
       .value("min", dolfinx::Table::Reduction::min)
-      .value("average", dolfinx::Table::Reduction::average);
+      .value("average", dolfinx::Table::Reduction::average)
+      .value("statistics", dolfinx::Table::Reduction::statistics);
 
   auto sc = nb::class_<dolfinx::common::Scatterer<>>(m, "Scatterer")
                 .def(nb::init<dolfinx::common::IndexMap&, int>(),
@@ -158,6 +165,8 @@ void common(nb::module_& m)
            &dolfinx::common::IndexMap::index_to_dest_ranks)
       .def("imbalance", &dolfinx::common::IndexMap::imbalance,
            "Imbalance of the current IndexMap.")
+      .def("memory_usage", &dolfinx::common::IndexMap::memory_usage,
+           "Memory (bytes) used by the index map")
       .def_prop_ro(
           "ghosts",
           [](const dolfinx::common::IndexMap& self)
@@ -219,6 +228,16 @@ void common(nb::module_& m)
            &dolfinx::common::Timer<std::chrono::high_resolution_clock>::flush,
            "Flush timer");
 
+  m.def("trace_start", &dolfinx::common::trace::start,
+        nb::arg("capacity") = 1 << 16, "Enable tracing");
+  m.def("trace_stop", &dolfinx::common::trace::stop, "Disable tracing");
+  m.def(
+      "trace_write_chrome",
+      [](MPICommWrapper comm, std::filesystem::path filename)
+      { dolfinx::common::trace::write_chrome(comm.get(), filename); },
+      nb::arg("comm"), nb::arg("filename"),
+      "Write the traced regions to a Chrome trace file");
+
   m.def("timing", &dolfinx::timing);
   m.def("timings", &dolfinx::timings);
 
@@ -228,6 +247,43 @@ void common(nb::module_& m)
       { dolfinx::list_timings(comm.get(), reduction); }, nb::arg("comm"),
       nb::arg("reduction"));
 
+  m.def("perf_counters_start", &dolfinx::common::perf::start,
+        "Enable the hardware counters of the calling thread");
+  m.def("perf_counters_stop", &dolfinx::common::perf::stop,
+        "Disable the hardware counters");
+  m.def(
+      "list_counters",
+      [](MPICommWrapper comm, dolfinx::Table::Reduction reduction)
+      { dolfinx::list_counters(comm.get(), reduction); }, nb::arg("comm"),
+      nb::arg("reduction"));
+
+  m.def("comm_stats_start", &dolfinx::common::comm_stats::start,
+        "Enable recording of MPI communication statistics");
+  m.def("comm_stats_stop", &dolfinx::common::comm_stats::stop,
+        "Disable recording of MPI communication statistics");
+  m.def("comm_stats_clear", &dolfinx::common::comm_stats::clear,
+        "Discard the recorded MPI communication statistics");
+  m.def(
+      "list_comm_stats",
+      [](MPICommWrapper comm, dolfinx::Table::Reduction reduction)
+      { dolfinx::common::comm_stats::list(comm.get(), reduction); },
+      nb::arg("comm"), nb::arg("reduction"));
+
+  m.def("memory_usage_record", &dolfinx::common::memory_usage::record,
+        nb::arg("name"), nb::arg("bytes"),
+        "Record the memory (bytes) used by a named object");
+  m.def("memory_usage_clear", &dolfinx::common::memory_usage::clear,
+        "Discard the recorded memory usage");
+  m.def("memory_usage_recorded", &dolfinx::common::memory_usage::recorded,
+        "Recorded memory (bytes) of each named object");
+  m.def("peak_resident_memory", &dolfinx::common::memory_usage::peak_resident,
+        "Peak resident memory (bytes) of the process");
+  m.def(
+      "list_memory_usage",
+      [](MPICommWrapper comm, dolfinx::Table::Reduction reduction)
+      { dolfinx::common::memory_usage::list(comm.get(), reduction); },
+      nb::arg("comm"), nb::arg("reduction"));
+
   m.def(
       "init_logging",
       [](std::vector<std::string> args)
@@ -85,6 +85,8 @@ void declare_function_space(nb::module_& m, std::string type)
              nb::arg("mesh"), nb::arg("elements"), nb::arg("dofmaps"))
         .def("collapse", &dolfinx::fem::FunctionSpace<T>::collapse)
         .def("component", &dolfinx::fem::FunctionSpace<T>::component)
+        .def("memory_usage", &dolfinx::fem::FunctionSpace<T>::memory_usage,
+             "Memory (bytes) used by the dofmaps")
         .def("contains", &dolfinx::fem::FunctionSpace<T>::contains,
              nb::arg("V"))
         .def_prop_ro("element", &dolfinx::fem::FunctionSpace<T>::element)
@@ -297,6 +299,105 @@ void declare_function_space(nb::module_& m, std::string type)
                      &dolfinx::fem::FiniteElement<T>::needs_dof_transformations)
         .def_prop_ro("signature", &dolfinx::fem::FiniteElement<T>::signature);
   }
+
+  {
+    std::string pyclass_name = "InterpolationPlan_" + type;
+    nb::class_<dolfinx::fem::InterpolationPlan<T>>(
+        m, pyclass_name.c_str(),
+        "Precomputed data for interpolation on non-matching meshes")
+        .def(
+            "__init__",
+            [](dolfinx::fem::InterpolationPlan<T>* self,
+               std::shared_ptr<const dolfinx::fem::FunctionSpace<T>> V,
+               nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
+               const dolfinx::geometry::PointOwnershipData<T>&
+                   interpolation_data)
+            {
+              new (self) dolfinx::fem::InterpolationPlan<T>(
+                  V, std::span(cells.data(), cells.size()),
+                  interpolation_data);
+            },
+            nb::arg("V"), nb::arg("cells"), nb::arg("interpolation_data"))
+        .def_prop_ro("function_space",
+                     &dolfinx::fem::InterpolationPlan<T>::function_space);
+  }
+
+  {
+    std::string pyclass_name = "InterpolationCoords_" + type;
+    nb::class_<dolfinx::fem::InterpolationCoords<T>>(
+        m, pyclass_name.c_str(),
+        "Interpolation coordinates of cells, computed in chunks")
+        .def(
+            "__init__",
+            [](dolfinx::fem::InterpolationCoords<T>* self,
+               std::shared_ptr<const dolfinx::fem::FiniteElement<T>> element,
+               std::shared_ptr<const dolfinx::mesh::Mesh<T>> mesh,
+               nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
+               std::size_t chunk_size, bool cache)
+            {
+              new (self) dolfinx::fem::InterpolationCoords<T>(
+                  element, mesh, std::span(cells.data(), cells.size()),
+                  chunk_size, cache);
+            },
+            nb::arg("element"), nb::arg("mesh"), nb::arg("cells"),
+            nb::arg("chunk_size"), nb::arg("cache"))
+        .def_prop_ro("num_chunks",
+                     &dolfinx::fem::InterpolationCoords<T>::num_chunks)
+        .def(
+            "cells",
+            [](const dolfinx::fem::InterpolationCoords<T>& self,
+               std::size_t i)
+            {
+              std::span<const std::int32_t> c = self.cells(i);
+              return nb::ndarray<const std::int32_t, nb::numpy>(c.data(),
+                                                                {c.size()});
+            },
+            nb::rv_policy::reference_internal, nb::arg("i"))
+        .def(
+            "x",
+            [](dolfinx::fem::InterpolationCoords<T>& self, std::size_t i)
+            {
+              std::span<const T> x = self.x(i);
+              return dolfinx_wrappers::as_nbarray(
+                  std::vector<T>(x.begin(), x.end()), {3, x.size() / 3});
+            },
+            nb::arg("i"), "Interpolation coordinates of chunk i (copy).");
+  }
+
+  {
+    std::string pyclass_name = "DofCoordinates_" + type;
+    nb::class_<dolfinx::fem::DofCoordinates<T>>(
+        m, pyclass_name.c_str(),
+        "Coordinates of a subset of degrees-of-freedom")
+        .def(
+            "__init__",
+            [](dolfinx::fem::DofCoordinates<T>* self,
+               std::shared_ptr<const dolfinx::fem::FunctionSpace<T>> V,
+               nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> dofs)
+            {
+              new (self) dolfinx::fem::DofCoordinates<T>(
+                  V, std::span(dofs.data(), dofs.size()));
+            },
+            nb::arg("V"), nb::arg("dofs"))
+        .def_prop_ro(
+            "dofs",
+            [](const dolfinx::fem::DofCoordinates<T>& self)
+            {
+              std::span<const std::int32_t> d = self.dofs();
+              return nb::ndarray<const std::int32_t, nb::numpy>(d.data(),
+                                                                {d.size()});
+            },
+            nb::rv_policy::reference_internal)
+        .def(
+            "x",
+            [](dolfinx::fem::DofCoordinates<T>& self)
+            {
+              std::span<const T> x = self.x();
+              return dolfinx_wrappers::as_nbarray(
+                  std::vector<T>(x.begin(), x.end()), {3, x.size() / 3});
+            },
+            "Coordinates of the degrees-of-freedom (copy).");
+  }
 }
 
 // Declare DirichletBC objects for type T
@@ -460,6 +561,15 @@ void declare_objects(nb::module_& m, const std::string& type)
           },
           nb::arg("u"), nb::arg("cells"), nb::arg("interpolation_data"),
           "Interpolate a finite element function on non-matching meshes")
+      .def(
+          "interpolate",
+          [](dolfinx::fem::Function<T, U>& self,
+             const dolfinx::fem::Function<T, U>& u,
+             const dolfinx::fem::InterpolationPlan<U>& plan)
+          { dolfinx::fem::interpolate(self, u, plan); },
+          nb::arg("u"), nb::arg("plan"),
+          "Interpolate a finite element function on non-matching meshes "
+          "using an interpolation plan")
       .def(
           "interpolate_ptr",
           [](dolfinx::fem::Function<T, U>& self, std::uintptr_t addr,
@@ -548,7 +658,8 @@ void declare_objects(nb::module_& m, const std::string& type)
             return nb::ndarray<T, nb::numpy>(
                 self.value.data(), self.shape.size(), self.shape.data());
           },
-          nb::rv_policy::reference_internal);
+          nb::rv_policy::reference_internal)
+      .def_prop_ro("state", &dolfinx::fem::Constant<T>::state);
 
   // dolfinx::fem::Expression
   std::string pyclass_name_expr = std::string("Expression_") + type;
@@ -735,6 +846,16 @@ void declare_form(nb::module_& m, std::string type)
                    { return dolfinx_wrappers::numpy_dtype<T>(); })
       .def_prop_ro("coefficients", &dolfinx::fem::Form<T, U>::coefficients)
       .def_prop_ro("constants", &dolfinx::fem::Form<T, U>::constants)
+      .def(
+          "packed_constants",
+          [](const dolfinx::fem::Form<T, U>& self)
+          {
+            std::span<const T> c = self.packed_constants();
+            return nb::ndarray<const T, nb::numpy>(c.data(), {c.size()});
+          },
+          nb::rv_policy::reference_internal)
+      .def_prop_ro("packed_constants_state",
+                   &dolfinx::fem::Form<T, U>::packed_constants_state)
       .def_prop_ro("rank", &dolfinx::fem::Form<T, U>::rank)
       .def_prop_ro("mesh", &dolfinx::fem::Form<T, U>::mesh)
       .def_prop_ro("function_spaces",
@@ -748,6 +869,8 @@ void declare_form(nb::module_& m, std::string type)
       .def_prop_ro("integral_types", &dolfinx::fem::Form<T, U>::integral_types)
       .def_prop_ro("needs_facet_permutations",
                    &dolfinx::fem::Form<T, U>::needs_facet_permutations)
+      .def("cache_facet_pairs", &dolfinx::fem::Form<T, U>::cache_facet_pairs,
+           nb::arg("cache"))
       .def(
           "domains",
           [](const dolfinx::fem::Form<T, U>& self,
@@ -858,10 +981,12 @@ void declare_form(nb::module_& m, std::string type)
       nb::arg("mesh"), "Create Form from a pointer to ufcx_form.");
 
   m.def("create_sparsity_pattern", &dolfinx::fem::create_sparsity_pattern<T, U>,
-        nb::arg("a"), "Create a sparsity pattern.");
+        nb::arg("a"), nb::arg("num_threads") = 1,
+        "Create a sparsity pattern.");
 
   m.def("build_sparsity_pattern", &dolfinx::fem::build_sparsity_pattern<T, U>,
-        nb::arg("pattern"), nb::arg("a"), "Build a sparsity pattern.");
+        nb::arg("pattern"), nb::arg("a"), nb::arg("num_threads") = 1,
+        "Build a sparsity pattern.");
 }
 
 template <typename T>
@@ -992,7 +1117,11 @@ void declare_real_functions(nb::module_& m)
       "create_dofmap",
       [](const dolfinx_wrappers::MPICommWrapper comm,
          dolfinx::mesh::Topology& topology,
-         const dolfinx::fem::FiniteElement<T>& element)
+         const dolfinx::fem::FiniteElement<T>& element,
+         std::function<std::vector<int>(
+             const dolfinx::graph::AdjacencyList<std::int32_t>&)>
+             reorder_fn,
+         int num_threads)
       {
         dolfinx::fem::ElementDofLayout layout
             = dolfinx::fem::create_element_dof_layout(element);
@@ -1002,16 +1131,19 @@ void declare_real_functions(nb::module_& m)
         if (element.needs_dof_permutations())
           permute_inv = element.dof_permutation_fn(true, true);
         return dolfinx::fem::create_dofmap(comm.get(), layout, topology,
-                                           permute_inv, nullptr);
+                                           permute_inv, reorder_fn,
+                                           num_threads);
       },
       nb::arg("comm"), nb::arg("topology"), nb::arg("element"),
+      nb::arg("reorder_fn").none() = nb::none(), nb::arg("num_threads") = 1,
       "Create DofMap object from an element.");
   m.def(
       "create_dofmaps",
       [](const dolfinx_wrappers::MPICommWrapper comm,
          dolfinx::mesh::Topology& topology,
          std::vector<std::shared_ptr<const dolfinx::fem::FiniteElement<T>>>
-             elements)
+             elements,
+         int num_threads)
       {
         std::vector<dolfinx::fem::ElementDofLayout> layouts;
         assert(elements.size() == topology.entity_types(topology.dim()).size());
@@ -1022,9 +1154,10 @@ void declare_real_functions(nb::module_& m)
         }
 
         return dolfinx::fem::create_dofmaps(comm.get(), layouts, topology,
-                                            nullptr, nullptr);
+                                            nullptr, nullptr, num_threads);
       },
       nb::arg("comm"), nb::arg("topology"), nb::arg("elements"),
+      nb::arg("num_threads") = 1,
       "Create DofMap objects on a mixed topology mesh from pointers to "
       "FiniteElements.");
 
@@ -1034,7 +1167,7 @@ void declare_real_functions(nb::module_& m)
              std::shared_ptr<const dolfinx::fem::FunctionSpace<T>>>& V,
          int dim,
          nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
-         bool remote)
+         bool remote, int num_threads)
       {
         if (V.size() != 2)
           throw std::runtime_error("Expected two function spaces.");
@@ -1042,26 +1175,28 @@ void declare_real_functions(nb::module_& m)
             = dolfinx::fem::locate_dofs_topological(
                 *V[0].get()->mesh()->topology_mutable(),
                 {*V[0].get()->dofmap(), *V[1].get()->dofmap()}, dim,
-                std::span(entities.data(), entities.size()), remote);
+                std::span(entities.data(), entities.size()), remote,
+                num_threads);
         return std::array<nb::ndarray<std::int32_t, nb::numpy>, 2>(
             {dolfinx_wrappers::as_nbarray(std::move(dofs[0])),
              dolfinx_wrappers::as_nbarray(std::move(dofs[1]))});
       },
       nb::arg("V"), nb::arg("dim"), nb::arg("entities"),
-      nb::arg("remote") = true);
+      nb::arg("remote") = true, nb::arg("num_threads") = 1);
   m.def(
       "locate_dofs_topological",
       [](const dolfinx::fem::FunctionSpace<T>& V, int dim,
          nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
-         bool remote)
+         bool remote, int num_threads)
       {
         return dolfinx_wrappers::as_nbarray(
             dolfinx::fem::locate_dofs_topological(
                 *V.mesh()->topology_mutable(), *V.dofmap(), dim,
-                std::span(entities.data(), entities.size()), remote));
+                std::span(entities.data(), entities.size()), remote,
+                num_threads));
       },
       nb::arg("V"), nb::arg("dim"), nb::arg("entities"),
-      nb::arg("remote") = true);
+      nb::arg("remote") = true, nb::arg("num_threads") = 1);
   m.def(
       "locate_dofs_geometrical",
       [](const std::vector<
@@ -1162,16 +1297,18 @@ void fem(nb::module_& m)
   m.def(
       "build_dofmap",
       [](MPICommWrapper comm, const dolfinx::mesh::Topology& topology,
-         const dolfinx::fem::ElementDofLayout& layout)
+         const dolfinx::fem::ElementDofLayout& layout, int num_threads)
       {
         assert(topology.entity_types(topology.dim()).size() == 1);
         auto [map, bs, dofmap] = dolfinx::fem::build_dofmap_data(
             comm.get(), topology, {layout},
             [](const dolfinx::graph::AdjacencyList<std::int32_t>& g)
-            { return dolfinx::graph::reorder_gps(g); });
+            { return dolfinx::graph::reorder_gps(g); },
+            num_threads);
         return std::tuple(std::move(map), bs, std::move(dofmap));
       },
       nb::arg("comm"), nb::arg("topology"), nb::arg("layout"),
+      nb::arg("num_threads") = 1,
       "Build a dofmap on a mesh.");
   m.def(
       "transpose_dofmap",
@@ -1247,6 +1384,8 @@ void fem(nb::module_& m)
           },
           nb::rv_policy::reference_internal, nb::arg("cell"))
       .def_prop_ro("bs", &dolfinx::fem::DofMap::bs)
+      .def("memory_usage", &dolfinx::fem::DofMap::memory_usage,
+           "Memory (bytes) used by the dofmap")
       .def(
           "map",
           [](const dolfinx::fem::DofMap& self)
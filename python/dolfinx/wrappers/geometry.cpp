@@ -39,7 +39,7 @@ void declare_bbtree(nb::module_& m, std::string type)
              std::optional<
                  nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig>>
                  entities,
-             double padding)
+             double padding, int num_threads)
           {
             std::optional<std::span<const std::int32_t>> ents
                 = entities ? std::span<const std::int32_t>(
@@ -48,11 +48,11 @@ void declare_bbtree(nb::module_& m, std::string type)
                            : std::optional<std::span<const std::int32_t>>(
                                  std::nullopt);
 
-            new (bbt)
-                dolfinx::geometry::BoundingBoxTree<T>(mesh, dim, ents, padding);
+            new (bbt) dolfinx::geometry::BoundingBoxTree<T>(
+                mesh, dim, ents, padding, num_threads);
           },
           nb::arg("mesh"), nb::arg("dim"), nb::arg("entities").none(),
-          nb::arg("padding") = 0.0)
+          nb::arg("padding") = 0.0, nb::arg("num_threads") = 1)
       .def_prop_ro("num_bboxes",
                    &dolfinx::geometry::BoundingBoxTree<T>::num_bboxes)
       .def_prop_ro(
@@ -77,6 +77,9 @@ void declare_bbtree(nb::module_& m, std::string type)
                 .cast();
           },
           nb::arg("i"))
+      .def("refit", &dolfinx::geometry::BoundingBoxTree<T>::refit,
+           nb::arg("mesh"), nb::arg("padding") = 0.0,
+           nb::arg("num_threads") = 1)
       .def("__repr__", &dolfinx::geometry::BoundingBoxTree<T>::str)
       .def(
           "create_global_tree",
@@ -88,21 +91,26 @@ void declare_bbtree(nb::module_& m, std::string type)
   m.def(
       "compute_collisions_points",
       [](const dolfinx::geometry::BoundingBoxTree<T>& tree,
-         nb::ndarray<const T, nb::shape<3>, nb::c_contig> points)
+         nb::ndarray<const T, nb::shape<3>, nb::c_contig> points,
+         int packet_size, int num_threads)
       {
         return dolfinx::geometry::compute_collisions<T>(
-            tree, std::span(points.data(), 3));
+            tree, std::span(points.data(), 3), packet_size, num_threads);
       },
-      nb::arg("tree"), nb::arg("points"));
+      nb::arg("tree"), nb::arg("points"), nb::arg("packet_size") = 1,
+      nb::arg("num_threads") = 1);
   m.def(
       "compute_collisions_points",
       [](const dolfinx::geometry::BoundingBoxTree<T>& tree,
-         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points)
+         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points,
+         int packet_size, int num_threads)
       {
         return dolfinx::geometry::compute_collisions<T>(
-            tree, std::span(points.data(), points.size()));
+            tree, std::span(points.data(), points.size()), packet_size,
+            num_threads);
       },
-      nb::arg("tree"), nb::arg("points"));
+      nb::arg("tree"), nb::arg("points"), nb::arg("packet_size") = 1,
+      nb::arg("num_threads") = 1);
   m.def(
       "compute_collisions_trees",
       [](const dolfinx::geometry::BoundingBoxTree<T>& treeA,
@@ -208,13 +216,16 @@ void declare_bbtree(nb::module_& m, std::string type)
       nb::arg("mesh"), nb::arg("dim"), nb::arg("indices"), nb::arg("points"));
   m.def("determine_point_ownership",
         [](const dolfinx::mesh::Mesh<T>& mesh,
-           nb::ndarray<const T, nb::c_contig> points, const T padding)
+           nb::ndarray<const T, nb::c_contig> points, const T padding,
+           int packet_size, int num_threads)
         {
           std::size_t p_s0 = points.ndim() == 1 ? 1 : points.shape(0);
           std::span<const T> _p(points.data(), 3 * p_s0);
-          return dolfinx::geometry::determine_point_ownership<T>(mesh, _p,
-                                                                 padding);
-        });
+          return dolfinx::geometry::determine_point_ownership<T>(
+              mesh, _p, padding, packet_size, num_threads);
+        },
+        nb::arg("mesh"), nb::arg("points"), nb::arg("padding"),
+        nb::arg("packet_size") = 1, nb::arg("num_threads") = 1);
 
   std::string pod_pyclass_name = "PointOwnershipData_" + type;
   nb::class_<dolfinx::geometry::PointOwnershipData<T>>(m,
@@ -160,6 +160,18 @@ void graph(nb::module_& m)
       nb::arg("suppress_output") = true, "KaHIP graph partitioner");
 #endif
 
+  m.def(
+      "partitioner_native",
+      [](double imbalance, int max_iterations) -> partition_fn
+      {
+        return create_partitioner_py(
+            dolfinx::graph::native::partitioner(imbalance, max_iterations));
+      },
+      nb::arg("imbalance") = 1.05, nb::arg("max_iterations") = 20,
+      "Native (label propagation) graph partitioner");
+
   m.def("reorder_gps", &dolfinx::graph::reorder_gps, nb::arg("graph"));
+  m.def("reorder_rcm", &dolfinx::graph::reorder_rcm, nb::arg("graph"),
+        nb::arg("num_threads") = 1, nb::arg("approximate") = false);
 }
 } // namespace dolfinx_wrappers
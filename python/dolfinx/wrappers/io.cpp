@@ -10,11 +10,13 @@
 #include <dolfinx/common/defines.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/io/ADIOS2Readers.h>
 #include <dolfinx/io/ADIOS2Writers.h>
 #include <dolfinx/io/VTKFile.h>
 #include <dolfinx/io/VTKHDF.h>
 #include <dolfinx/io/XDMFFile.h>
 #include <dolfinx/io/cells.h>
+#include <dolfinx/io/checkpoint.h>
 #include <dolfinx/io/utils.h>
 #include <dolfinx/io/vtk_utils.h>
 #include <dolfinx/io/xdmf_utils.h>
@@ -26,6 +28,7 @@
 #include <nanobind/ndarray.h>
 #include <nanobind/stl/complex.h>
 #include <nanobind/stl/filesystem.h>
+#include <nanobind/stl/map.h>
 #include <nanobind/stl/optional.h>
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/shared_ptr.h>
@@ -106,6 +109,25 @@ void vtk_scalar_fn(auto&& m)
       nb::arg("u"), nb::arg("t") = 0.0);
 }
 
+template <typename T, typename U>
+void vtkhdf_scalar_fn(nb::module_& m)
+{
+  m.def("write_vtkhdf_data", &dolfinx::io::VTKHDF::write_data<T, U>,
+        nb::arg("filename"), nb::arg("u"), nb::arg("t"),
+        "Append a time step with the values of Functions to a VTKHDF file");
+}
+
+template <typename T, typename U>
+void checkpoint_scalar_fn(nb::module_& m)
+{
+  m.def("write_checkpoint_function",
+        &dolfinx::io::checkpoint::write_function<T, U>, nb::arg("filename"),
+        nb::arg("u"), "Add a Function to a checkpoint file");
+  m.def("read_checkpoint_function",
+        &dolfinx::io::checkpoint::read_function<T, U>, nb::arg("filename"),
+        nb::arg("u"), "Read the values of a Function from a checkpoint file");
+}
+
 #ifdef HAS_ADIOS2
 template <typename T>
 void declare_vtx_writer(nb::module_& m, std::string type)
@@ -118,13 +140,13 @@ void declare_vtx_writer(nb::module_& m, std::string type)
             [](dolfinx::io::VTXWriter<T>* self, MPICommWrapper comm,
                std::filesystem::path filename,
                std::shared_ptr<const dolfinx::mesh::Mesh<T>> mesh,
-               std::string engine)
+               std::string engine, const adios2::Params& params)
             {
-              new (self)
-                  dolfinx::io::VTXWriter<T>(comm.get(), filename, mesh, engine);
+              new (self) dolfinx::io::VTXWriter<T>(comm.get(), filename, mesh,
+                                                   engine, params);
             },
             nb::arg("comm"), nb::arg("filename"), nb::arg("mesh"),
-            nb::arg("engine"))
+            nb::arg("engine"), nb::arg("params") = adios2::Params())
         .def(
             "__init__",
             [](dolfinx::io::VTXWriter<T>* self, MPICommWrapper comm,
@@ -136,19 +158,64 @@ void declare_vtx_writer(nb::module_& m, std::string type)
                        const dolfinx::fem::Function<std::complex<float>, T>>,
                    std::shared_ptr<const dolfinx::fem::Function<
                        std::complex<double>, T>>>>& u,
-               std::string engine, dolfinx::io::VTXMeshPolicy policy)
+               std::string engine, dolfinx::io::VTXMeshPolicy policy,
+               bool async_write, const adios2::Params& params)
             {
-              new (self) dolfinx::io::VTXWriter<T>(comm.get(), filename, u,
-                                                   engine, policy);
+              new (self) dolfinx::io::VTXWriter<T>(
+                  comm.get(), filename, u, engine, policy, async_write, params);
             },
             nb::arg("comm"), nb::arg("filename"), nb::arg("u"),
             nb::arg("engine") = "BPFile",
-            nb::arg("policy") = dolfinx::io::VTXMeshPolicy::update)
+            nb::arg("policy") = dolfinx::io::VTXMeshPolicy::update,
+            nb::arg("async_write") = false,
+            nb::arg("params") = adios2::Params())
         .def("close", [](dolfinx::io::VTXWriter<T>& self) { self.close(); })
+        .def("set_field_options", &dolfinx::io::VTXWriter<T>::set_field_options,
+             nb::arg("name"), nb::arg("options"))
+        .def(
+            "set_cells",
+            [](dolfinx::io::VTXWriter<T>& self,
+               nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig>
+                   cells)
+            { self.set_cells(std::span(cells.data(), cells.size())); },
+            nb::arg("cells"))
         .def(
             "write", [](dolfinx::io::VTXWriter<T>& self, double t)
             { self.write(t); }, nb::arg("t"));
   }
+
+  {
+    std::string pyclass_name = "VTXReader_" + type;
+    nb::class_<dolfinx::io::VTXReader<T>>(m, pyclass_name.c_str())
+        .def(
+            "__init__",
+            [](dolfinx::io::VTXReader<T>* self, MPICommWrapper comm,
+               std::filesystem::path filename,
+               const std::vector<std::variant<
+                   std::shared_ptr<dolfinx::fem::Function<float, T>>,
+                   std::shared_ptr<dolfinx::fem::Function<double, T>>,
+                   std::shared_ptr<
+                       dolfinx::fem::Function<std::complex<float>, T>>,
+                   std::shared_ptr<
+                       dolfinx::fem::Function<std::complex<double>, T>>>>& u,
+               std::string engine, const adios2::Params& params,
+               bool random_access)
+            {
+              new (self) dolfinx::io::VTXReader<T>(
+                  comm.get(), filename, u, engine, params, random_access);
+            },
+            nb::arg("comm"), nb::arg("filename"), nb::arg("u"),
+            nb::arg("engine") = "BPFile", nb::arg("params") = adios2::Params(),
+            nb::arg("random_access") = false)
+        .def("close", [](dolfinx::io::VTXReader<T>& self) { self.close(); })
+        .def(
+            "read", [](dolfinx::io::VTXReader<T>& self, float timeout)
+            { return self.read(timeout); }, nb::arg("timeout") = -1.0f)
+        .def("num_steps", &dolfinx::io::VTXReader<T>::num_steps)
+        .def("times", &dolfinx::io::VTXReader<T>::times)
+        .def("read_step", &dolfinx::io::VTXReader<T>::read_step,
+             nb::arg("step"));
+  }
 }
 #endif
 
@@ -234,6 +301,33 @@ void io(nb::module_& m)
           return dolfinx::io::VTKHDF::read_mesh<float>(comm.get(), filename,
                                                        gdim);
         });
+  vtkhdf_scalar_fn<float, float>(m);
+  vtkhdf_scalar_fn<double, double>(m);
+  vtkhdf_scalar_fn<std::complex<float>, float>(m);
+  vtkhdf_scalar_fn<std::complex<double>, double>(m);
+
+  m.def("write_checkpoint_mesh", &dolfinx::io::checkpoint::write_mesh<double>,
+        nb::arg("filename"), nb::arg("mesh"))
+      .def("write_checkpoint_mesh", &dolfinx::io::checkpoint::write_mesh<float>,
+           nb::arg("filename"), nb::arg("mesh"));
+  m.def(
+      "read_checkpoint_mesh_float64",
+      [](MPICommWrapper comm, std::filesystem::path filename)
+      {
+        return dolfinx::io::checkpoint::read_mesh<double>(comm.get(), filename);
+      },
+      nb::arg("comm"), nb::arg("filename"));
+  m.def(
+      "read_checkpoint_mesh_float32",
+      [](MPICommWrapper comm, std::filesystem::path filename)
+      {
+        return dolfinx::io::checkpoint::read_mesh<float>(comm.get(), filename);
+      },
+      nb::arg("comm"), nb::arg("filename"));
+  checkpoint_scalar_fn<float, float>(m);
+  checkpoint_scalar_fn<double, double>(m);
+  checkpoint_scalar_fn<std::complex<float>, float>(m);
+  checkpoint_scalar_fn<std::complex<double>, double>(m);
 
   // dolfinx::io::cell permutation functions
   m.def("perm_vtk", &dolfinx::io::cells::perm_vtk, nb::arg("type"),
@@ -243,6 +337,39 @@ void io(nb::module_& m)
         nb::arg("num_nodes"),
         "Permutation array to map from Gmsh to DOLFINx node ordering");
 
+  // dolfinx::io::hdf5::DatasetOptions
+  nb::class_<dolfinx::io::hdf5::DatasetOptions>(
+      m, "DatasetOptions", "Chunking and compression of HDF5 datasets")
+      .def(nb::init<>())
+      .def_rw("chunking", &dolfinx::io::hdf5::DatasetOptions::chunking)
+      .def_rw("chunk_bytes", &dolfinx::io::hdf5::DatasetOptions::chunk_bytes)
+      .def_rw("shuffle", &dolfinx::io::hdf5::DatasetOptions::shuffle)
+      .def_rw("deflate", &dolfinx::io::hdf5::DatasetOptions::deflate)
+      .def_rw("filter", &dolfinx::io::hdf5::DatasetOptions::filter)
+      .def_rw("filter_params",
+              &dolfinx::io::hdf5::DatasetOptions::filter_params)
+      .def_rw("collective", &dolfinx::io::hdf5::DatasetOptions::collective)
+      .def_rw("float_bits", &dolfinx::io::hdf5::DatasetOptions::float_bits);
+
+  // dolfinx::io::hdf5::FileOptions
+  nb::class_<dolfinx::io::hdf5::FileOptions>(
+      m, "FileOptions", "MPI-IO access options of HDF5 files")
+      .def(nb::init<>())
+      .def_rw("num_aggregators",
+              &dolfinx::io::hdf5::FileOptions::num_aggregators)
+      .def_rw("collective_metadata_write",
+              &dolfinx::io::hdf5::FileOptions::collective_metadata_write)
+      .def_rw("collective_metadata_read",
+              &dolfinx::io::hdf5::FileOptions::collective_metadata_read)
+      .def_rw("alignment", &dolfinx::io::hdf5::FileOptions::alignment)
+      .def_rw("alignment_threshold",
+              &dolfinx::io::hdf5::FileOptions::alignment_threshold)
+      .def_rw("meta_block_size",
+              &dolfinx::io::hdf5::FileOptions::meta_block_size)
+      .def_rw("sieve_buffer_size",
+              &dolfinx::io::hdf5::FileOptions::sieve_buffer_size)
+      .def_rw("mpi_hints", &dolfinx::io::hdf5::FileOptions::mpi_hints);
+
   // dolfinx::io::XDMFFile
   nb::class_<dolfinx::io::XDMFFile> xdmf_file(m, "XDMFFile");
 
@@ -257,13 +384,29 @@ void io(nb::module_& m)
           "__init__",
           [](dolfinx::io::XDMFFile* x, MPICommWrapper comm,
              std::filesystem::path filename, std::string file_mode,
-             dolfinx::io::XDMFFile::Encoding encoding)
+             dolfinx::io::XDMFFile::Encoding encoding,
+             const dolfinx::io::hdf5::DatasetOptions& dataset_options,
+             int num_aggregators,
+             std::optional<dolfinx::io::hdf5::FileOptions> file_options)
           {
-            new (x) dolfinx::io::XDMFFile(comm.get(), filename, file_mode,
-                                          encoding);
+            if (file_options)
+            {
+              new (x) dolfinx::io::XDMFFile(comm.get(), filename, file_mode,
+                                            encoding, dataset_options,
+                                            *file_options);
+            }
+            else
+            {
+              new (x) dolfinx::io::XDMFFile(comm.get(), filename, file_mode,
+                                            encoding, dataset_options,
+                                            num_aggregators);
+            }
           },
           nb::arg("comm"), nb::arg("filename"), nb::arg("file_mode"),
-          nb::arg("encoding") = dolfinx::io::XDMFFile::Encoding::HDF5)
+          nb::arg("encoding") = dolfinx::io::XDMFFile::Encoding::HDF5,
+          nb::arg("dataset_options") = dolfinx::io::hdf5::DatasetOptions(),
+          nb::arg("num_aggregators") = 0,
+          nb::arg("file_options").none() = nb::none())
       .def("close", &dolfinx::io::XDMFFile::close)
       .def("write_geometry", &dolfinx::io::XDMFFile::write_geometry,
            nb::arg("geometry"), nb::arg("name") = "geometry",
@@ -291,14 +434,17 @@ void io(nb::module_& m)
            nb::arg("name") = "mesh", nb::arg("xpath") = "/Xdmf/Domain")
       .def("read_meshtags", &dolfinx::io::XDMFFile::read_meshtags,
            nb::arg("mesh"), nb::arg("name"), nb::arg("attribute_name").none(),
-           nb::arg("xpath"))
+           nb::arg("xpath"), nb::arg("chunk_size") = 1 << 20)
       .def("write_information", &dolfinx::io::XDMFFile::write_information,
            nb::arg("name"), nb::arg("value"), nb::arg("xpath") = "/Xdmf/Domain")
       .def("read_information", &dolfinx::io::XDMFFile::read_information,
            nb::arg("name"), nb::arg("xpath") = "/Xdmf/Domain")
       .def_prop_ro(
           "comm", [](dolfinx::io::XDMFFile& self)
-          { return MPICommWrapper(self.comm()); }, nb::keep_alive<0, 1>());
+          { return MPICommWrapper(self.comm()); }, nb::keep_alive<0, 1>())
+      .def_prop_rw("dataset_options",
+                   &dolfinx::io::XDMFFile::dataset_options,
+                   &dolfinx::io::XDMFFile::set_dataset_options);
 
   xdmf_real_fn<float>(xdmf_file);
   xdmf_real_fn<double>(xdmf_file);
@@ -309,13 +455,24 @@ void io(nb::module_& m)
 
   // dolfinx::io::VTKFile
   nb::class_<dolfinx::io::VTKFile> vtk_file(m, "VTKFile");
+
+  // dolfinx::io::VTKFile::Encoding enums
+  nb::enum_<dolfinx::io::VTKFile::Encoding>(vtk_file, "Encoding")
+      .value("ASCII", dolfinx::io::VTKFile::Encoding::ASCII, "ASCII encoding")
+      .value("Binary", dolfinx::io::VTKFile::Encoding::Binary,
+             "Binary (base64) encoding");
+
   vtk_file
       .def(
           "__init__",
           [](dolfinx::io::VTKFile* v, MPICommWrapper comm,
-             std::filesystem::path filename, std::string mode)
-          { new (v) dolfinx::io::VTKFile(comm.get(), filename, mode); },
-          nb::arg("comm"), nb::arg("filename"), nb::arg("mode"))
+             std::filesystem::path filename, std::string mode,
+             dolfinx::io::VTKFile::Encoding encoding) {
+            new (v)
+                dolfinx::io::VTKFile(comm.get(), filename, mode, encoding);
+          },
+          nb::arg("comm"), nb::arg("filename"), nb::arg("mode"),
+          nb::arg("encoding") = dolfinx::io::VTKFile::Encoding::ASCII)
       .def("close", &dolfinx::io::VTKFile::close);
 
   vtk_real_fn<float>(vtk_file);
@@ -330,6 +487,15 @@ void io(nb::module_& m)
       .value("update", dolfinx::io::VTXMeshPolicy::update)
       .value("reuse", dolfinx::io::VTXMeshPolicy::reuse);
 
+  nb::class_<dolfinx::io::VTXFieldOptions>(
+      m, "VTXFieldOptions", "Precision and compression of VTX output fields")
+      .def(nb::init<>())
+      .def_rw("single_precision",
+              &dolfinx::io::VTXFieldOptions::single_precision)
+      .def_rw("operator_type", &dolfinx::io::VTXFieldOptions::operator_type)
+      .def_rw("operator_params",
+              &dolfinx::io::VTXFieldOptions::operator_params);
+
   declare_vtx_writer<float>(m, "float32");
   declare_vtx_writer<double>(m, "float64");
 #endif
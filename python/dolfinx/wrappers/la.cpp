@@ -51,6 +51,8 @@ void declare_objects(nb::module_& m, const std::string& type)
                    { return dolfinx_wrappers::numpy_dtype<T>(); })
       .def_prop_ro("index_map", &dolfinx::la::Vector<T>::index_map)
       .def_prop_ro("bs", &dolfinx::la::Vector<T>::bs)
+      .def("memory_usage", &dolfinx::la::Vector<T>::memory_usage,
+           "Memory (bytes) used by the vector")
       .def_prop_ro(
           "array",
           [](dolfinx::la::Vector<T>& self)
@@ -59,6 +61,7 @@ void declare_objects(nb::module_& m, const std::string& type)
             return nb::ndarray<T, nb::numpy>(x.data(), {x.size()});
           },
           nb::rv_policy::reference_internal)
+      .def_prop_ro("state", &dolfinx::la::Vector<T>::state)
       .def("scatter_forward", &dolfinx::la::Vector<T>::scatter_fwd)
       .def(
           "scatter_reverse",
@@ -91,6 +94,9 @@ void declare_objects(nb::module_& m, const std::string& type)
       .def_prop_ro("dtype", [](const dolfinx::la::MatrixCSR<T>&)
                    { return dolfinx_wrappers::numpy_dtype<T>(); })
       .def_prop_ro("bs", &dolfinx::la::MatrixCSR<T>::block_size)
+      .def_prop_ro("symmetric", &dolfinx::la::MatrixCSR<T>::symmetric)
+      .def("memory_usage", &dolfinx::la::MatrixCSR<T>::memory_usage,
+           "Memory (bytes) used by the matrix")
       .def("squared_norm", &dolfinx::la::MatrixCSR<T>::squared_norm)
       .def("index_map", &dolfinx::la::MatrixCSR<T>::index_map)
       .def("add",
@@ -132,7 +138,11 @@ void declare_objects(nb::module_& m, const std::string& type)
                &dolfinx::la::MatrixCSR<T>::set),
            nb::arg("x"))
       .def("scatter_reverse", &dolfinx::la::MatrixCSR<T>::scatter_rev)
-      .def("mult", &dolfinx::la::MatrixCSR<T>::mult)
+      .def("mult",
+           static_cast<void (dolfinx::la::MatrixCSR<T>::*)(
+               dolfinx::la::Vector<T>&, dolfinx::la::Vector<T>&, int)>(
+               &dolfinx::la::MatrixCSR<T>::template mult<T>),
+           nb::arg("x"), nb::arg("y"), nb::arg("num_threads") = 1)
       .def("to_dense",
            [](const dolfinx::la::MatrixCSR<T>& self)
            {
@@ -257,6 +267,9 @@ void la(nb::module_& m)
            nb::arg("dim"))
       .def("column_index_map", &dolfinx::la::SparsityPattern::column_index_map)
       .def("finalize", &dolfinx::la::SparsityPattern::finalize)
+      .def("drop_lower_triangle",
+           &dolfinx::la::SparsityPattern::drop_lower_triangle)
+      .def_prop_ro("symmetric", &dolfinx::la::SparsityPattern::symmetric)
       .def_prop_ro("num_nonzeros", &dolfinx::la::SparsityPattern::num_nonzeros)
       .def(
           "insert",
@@ -4,11 +4,15 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include "dolfinx_wrappers/MPICommWrapper.h"
+#include "dolfinx_wrappers/caster_mpi.h"
+#include <chrono>
 #include <dolfinx/common/log.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <memory>
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
 #include <string>
@@ -43,6 +47,19 @@ void log(nb::module_& m)
       },
       nb::arg("filename"));
 
+  m.def(
+      "init_parallel_logging",
+      [](MPICommWrapper comm, std::vector<int> ranks, bool asynchronous,
+         std::size_t queue_size, int flush_interval)
+      {
+        dolfinx::init_parallel_logging(comm.get(), ranks, asynchronous,
+                                       queue_size,
+                                       std::chrono::seconds(flush_interval));
+      },
+      nb::arg("comm"), nb::arg("ranks") = std::vector<int>(),
+      nb::arg("asynchronous") = false, nb::arg("queue_size") = 8192,
+      nb::arg("flush_interval") = 1);
+
   m.def(
       "set_thread_name",
       [](std::string thread_name)
@@ -55,7 +72,7 @@ void log(nb::module_& m)
 
   m.def(
       "set_log_level", [](spdlog::level::level_enum level)
-      { spdlog::set_level(level); }, nb::arg("level"));
+      { dolfinx::set_log_level(level); }, nb::arg("level"));
   m.def("get_log_level", []() { return spdlog::get_level(); });
   m.def(
       "log",
@@ -19,6 +19,7 @@
 #include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/generation.h>
 #include <dolfinx/mesh/graphbuild.h>
+#include <dolfinx/mesh/redistribute.h>
 #include <dolfinx/mesh/topologycomputation.h>
 #include <dolfinx/mesh/utils.h>
 #include <memory>
@@ -211,7 +212,9 @@ void declare_mesh(nb::module_& m, std::string type)
             return nb::ndarray<const std::int64_t, nb::numpy>(
                 id_to_global.data(), {id_to_global.size()});
           },
-          nb::rv_policy::reference_internal);
+          nb::rv_policy::reference_internal)
+      .def("memory_usage", &dolfinx::mesh::Geometry<T>::memory_usage,
+           "Memory (bytes) used by the geometry");
 
   std::string pyclass_mesh_name = std::string("Mesh_") + type;
   nb::class_<dolfinx::mesh::Mesh<T>>(m, pyclass_mesh_name.c_str(),
@@ -234,6 +237,8 @@ void declare_mesh(nb::module_& m, std::string type)
       .def_prop_ro(
           "comm", [](dolfinx::mesh::Mesh<T>& self)
           { return MPICommWrapper(self.comm()); }, nb::keep_alive<0, 1>())
+      .def("memory_usage", &dolfinx::mesh::Mesh<T>::memory_usage,
+           "Memory (bytes) used by the topology and geometry")
       .def_rw("name", &dolfinx::mesh::Mesh<T>::name);
 
   std::string create_interval("create_interval_" + type);
@@ -280,6 +285,32 @@ void declare_mesh(nb::module_& m, std::string type)
       nb::arg("comm"), nb::arg("p"), nb::arg("n"), nb::arg("celltype"),
       nb::arg("partitioner").none());
 
+  std::string create_rectangle_blocked("create_rectangle_blocked_" + type);
+  m.def(
+      create_rectangle_blocked.c_str(),
+      [](MPICommWrapper comm, std::array<std::array<T, 2>, 2> p,
+         std::array<std::int64_t, 2> n, dolfinx::mesh::CellType celltype,
+         dolfinx::mesh::GhostMode ghost_mode)
+      {
+        return dolfinx::mesh::create_rectangle_blocked<T>(comm.get(), p, n,
+                                                          celltype, ghost_mode);
+      },
+      nb::arg("comm"), nb::arg("p"), nb::arg("n"), nb::arg("celltype"),
+      nb::arg("ghost_mode"));
+
+  std::string create_box_blocked("create_box_blocked_" + type);
+  m.def(
+      create_box_blocked.c_str(),
+      [](MPICommWrapper comm, std::array<std::array<T, 3>, 2> p,
+         std::array<std::int64_t, 3> n, dolfinx::mesh::CellType celltype,
+         dolfinx::mesh::GhostMode ghost_mode)
+      {
+        return dolfinx::mesh::create_box_blocked<T>(comm.get(), p, n, celltype,
+                                                    ghost_mode);
+      },
+      nb::arg("comm"), nb::arg("p"), nb::arg("n"), nb::arg("celltype"),
+      nb::arg("ghost_mode"));
+
   m.def("create_mesh",
         [](MPICommWrapper comm,
            const std::vector<nb::ndarray<const std::int64_t, nb::ndim<1>,
@@ -384,33 +415,42 @@ void declare_mesh(nb::module_& m, std::string type)
   m.def(
       "cell_normals",
       [](const dolfinx::mesh::Mesh<T>& mesh, int dim,
-         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities)
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
+         int num_threads)
       {
         std::vector<T> n = dolfinx::mesh::cell_normals(
-            mesh, dim, std::span(entities.data(), entities.size()));
+            mesh, dim, std::span(entities.data(), entities.size()),
+            num_threads);
         return as_nbarray(std::move(n), {n.size() / 3, 3});
       },
-      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"));
+      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"),
+      nb::arg("num_threads") = 1);
   m.def(
       "h",
       [](const dolfinx::mesh::Mesh<T>& mesh, int dim,
-         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities)
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
+         int num_threads)
       {
         return as_nbarray(dolfinx::mesh::h(
-            mesh, std::span(entities.data(), entities.size()), dim));
+            mesh, std::span(entities.data(), entities.size()), dim,
+            num_threads));
       },
       nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"),
+      nb::arg("num_threads") = 1,
       "Compute maximum distsance between any two vertices.");
   m.def(
       "compute_midpoints",
       [](const dolfinx::mesh::Mesh<T>& mesh, int dim,
-         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities)
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
+         int num_threads)
       {
         std::vector<T> x = dolfinx::mesh::compute_midpoints(
-            mesh, dim, std::span(entities.data(), entities.size()));
+            mesh, dim, std::span(entities.data(), entities.size()),
+            num_threads);
         return as_nbarray(std::move(x), {entities.size(), 3});
       },
-      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"));
+      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"),
+      nb::arg("num_threads") = 1);
 
   m.def(
       "locate_entities",
@@ -488,19 +528,58 @@ void declare_mesh(nb::module_& m, std::string type)
       },
       nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"), nb::arg("permute"));
 
+  m.def(
+      "redistribute",
+      [](const dolfinx::mesh::Mesh<T>& mesh,
+         const part::impl::PythonCellPartitionFunction& partitioner)
+      {
+        return dolfinx::mesh::redistribute(
+            mesh, part::impl::create_cell_partitioner_cpp(partitioner));
+      },
+      nb::arg("mesh"), nb::arg("partitioner"));
+  m.def(
+      "create_group_mesh",
+      [](MPICommWrapper comm, const dolfinx::mesh::Mesh<T>& mesh,
+         MPICommWrapper group_comm,
+         const part::impl::PythonCellPartitionFunction& partitioner)
+      {
+        return dolfinx::mesh::create_group_mesh(
+            comm.get(), mesh, group_comm.get(),
+            part::impl::create_cell_partitioner_cpp(partitioner));
+      },
+      nb::arg("comm"), nb::arg("mesh"), nb::arg("group_comm"),
+      nb::arg("partitioner"));
+  m.def(
+      "extend_ghosting",
+      [](const dolfinx::mesh::Mesh<T>& mesh, int num_ghost_layers)
+      { return dolfinx::mesh::extend_ghosting(mesh, num_ghost_layers); },
+      nb::arg("mesh"), nb::arg("num_ghost_layers"));
+  m.def(
+      "redistribute_meshtags",
+      [](const dolfinx::mesh::MeshTags<std::int32_t>& tags,
+         const dolfinx::mesh::Mesh<T>& mesh0,
+         const dolfinx::mesh::Mesh<T>& mesh1)
+      { return dolfinx::mesh::redistribute_meshtags(tags, mesh0, mesh1); },
+      nb::arg("tags"), nb::arg("mesh0"), nb::arg("mesh1"));
+
   m.def("create_geometry",
         [](const dolfinx::mesh::Topology& topology,
            const std::vector<dolfinx::fem::CoordinateElement<T>>& elements,
            nb::ndarray<const std::int64_t, nb::ndim<1>, nb::c_contig> nodes,
            nb::ndarray<const std::int64_t, nb::ndim<1>, nb::c_contig> xdofs,
-           nb::ndarray<const T, nb::ndim<1>, nb::c_contig> x, int dim)
+           nb::ndarray<const T, nb::ndim<1>, nb::c_contig> x, int dim,
+           int num_threads)
         {
           return dolfinx::mesh::create_geometry(
               topology, elements,
               std::span<const std::int64_t>(nodes.data(), nodes.size()),
               std::span<const std::int64_t>(xdofs.data(), xdofs.size()),
-              std::span<const T>(x.data(), x.size()), dim);
-        });
+              std::span<const T>(x.data(), x.size()), dim, nullptr,
+              num_threads);
+        },
+        nb::arg("topology"), nb::arg("elements"), nb::arg("nodes"),
+        nb::arg("xdofs"), nb::arg("x"), nb::arg("dim"),
+        nb::arg("num_threads") = 1);
 }
 
 void mesh(nb::module_& m)
@@ -572,6 +651,22 @@ void mesh(nb::module_& m)
       nb::arg("comm"), nb::arg("cell_types"), nb::arg("cells"),
       "Build dual graph for cells");
 
+  m.def(
+      "build_dual_graph_hashed",
+      [](const MPICommWrapper comm, dolfinx::mesh::CellType cell_type,
+         const dolfinx::graph::AdjacencyList<std::int64_t>& cells,
+         std::size_t chunk_size, int num_threads)
+      {
+        std::vector<dolfinx::mesh::CellType> c = {cell_type};
+        return dolfinx::mesh::build_dual_graph_hashed(
+            comm.get(), std::span{c}, {cells.array()}, chunk_size,
+            num_threads);
+      },
+      nb::arg("comm"), nb::arg("cell_type"), nb::arg("cells"),
+      nb::arg("chunk_size") = 1 << 22, nb::arg("num_threads") = 1,
+      "Build dual graph for cells, matching facets across processes by "
+      "hashes of their keys");
+
   // dolfinx::mesh::GhostMode enums
   nb::enum_<dolfinx::mesh::GhostMode>(m, "GhostMode")
       .value("none", dolfinx::mesh::GhostMode::none)
@@ -614,11 +709,19 @@ void mesh(nb::module_& m)
           nb::arg("cell_type"), nb::arg("vertex_map"), nb::arg("cell_map"),
           nb::arg("cells"), nb::arg("original_index").none())
       .def("create_entities", &dolfinx::mesh::Topology::create_entities,
-           nb::arg("dim"))
+           nb::arg("dim"), nb::arg("num_threads") = 1)
       .def("create_entity_permutations",
-           &dolfinx::mesh::Topology::create_entity_permutations)
+           &dolfinx::mesh::Topology::create_entity_permutations,
+           nb::arg("num_threads") = 1)
       .def("create_connectivity", &dolfinx::mesh::Topology::create_connectivity,
            nb::arg("d0"), nb::arg("d1"))
+      .def("set_connectivity_memory_limit",
+           &dolfinx::mesh::Topology::set_connectivity_memory_limit,
+           nb::arg("limit"))
+      .def_prop_ro("connectivity_memory",
+                   &dolfinx::mesh::Topology::connectivity_memory)
+      .def("memory_usage", &dolfinx::mesh::Topology::memory_usage,
+           "Memory (bytes) used by the topology")
       .def(
           "get_facet_permutations",
           [](const dolfinx::mesh::Topology& self)
@@ -730,12 +833,14 @@ void mesh(nb::module_& m)
 
   m.def(
       "create_cell_partitioner",
-      [](dolfinx::mesh::GhostMode mode)
+      [](dolfinx::mesh::GhostMode mode, int num_ghost_layers)
           -> part::impl::PythonCellPartitionFunction
       {
         return part::impl::create_cell_partitioner_py(
-            dolfinx::mesh::create_cell_partitioner(mode));
+            dolfinx::mesh::create_cell_partitioner(
+                mode, &dolfinx::graph::partition_graph, num_ghost_layers));
       },
+      nb::arg("ghost_mode"), nb::arg("num_ghost_layers") = 1,
       "Create default cell partitioner.");
   m.def(
       "create_cell_partitioner",
@@ -744,14 +849,16 @@ void mesh(nb::module_& m)
              const dolfinx::graph::AdjacencyList<std::int64_t>& local_graph,
              bool ghosting)>
              part,
-         dolfinx::mesh::GhostMode mode)
+         dolfinx::mesh::GhostMode mode, int num_ghost_layers)
           -> part::impl::PythonCellPartitionFunction
       {
         return part::impl::create_cell_partitioner_py(
             dolfinx::mesh::create_cell_partitioner(
-                mode, part::impl::create_partitioner_cpp(part)));
+                mode, part::impl::create_partitioner_cpp(part),
+                num_ghost_layers));
       },
       nb::arg("part"), nb::arg("ghost_mode") = dolfinx::mesh::GhostMode::none,
+      nb::arg("num_ghost_layers") = 1,
       "Create a cell partitioner from a graph partitioning function.");
 
   m.def(
@@ -773,6 +880,18 @@ void mesh(nb::module_& m)
                 topology, std::span(entities.data(), entities.size()), d0, d1));
       },
       nb::arg("mesh"), nb::arg("entities"), nb::arg("d0"), nb::arg("d1"));
+  m.def(
+      "compute_parent_to_sub_entity_map",
+      [](const dolfinx::mesh::Topology& topology, int dim,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig>
+             sub_to_parent)
+      {
+        return dolfinx_wrappers::as_nbarray(
+            dolfinx::mesh::compute_parent_to_sub_entity_map(
+                topology, dim,
+                std::span(sub_to_parent.data(), sub_to_parent.size())));
+      },
+      nb::arg("topology"), nb::arg("dim"), nb::arg("sub_to_parent"));
 
   // Mesh generation
   nb::enum_<dolfinx::mesh::DiagonalType>(m, "DiagonalType")
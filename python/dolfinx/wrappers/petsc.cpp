@@ -22,6 +22,7 @@
 #include <dolfinx/fem/petsc.h>
 #include <dolfinx/fem/sparsitybuild.h>
 #include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/la/petsc.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -185,6 +186,34 @@ void petsc_la_module(nb::module_& m)
       nb::arg("comm"), nb::arg("p"), nb::arg("type") = nb::none(),
       "Create a PETSc Mat from sparsity pattern.");
 
+  m.def(
+      "create_matrix",
+      [](const dolfinx::la::MatrixCSR<PetscScalar>& A)
+      {
+        Mat B = dolfinx::la::petsc::create_matrix(A);
+        PyObject* obj = PyPetscMat_New(B);
+        PetscObjectDereference((PetscObject)B);
+        return nb::borrow(obj);
+      },
+      nb::arg("A"), "Create a PETSc Mat from a MatrixCSR.");
+  m.def(
+      "update_matrix",
+      [](Mat B, const dolfinx::la::MatrixCSR<PetscScalar>& A)
+      { dolfinx::la::petsc::update_matrix(B, A); }, nb::arg("B"),
+      nb::arg("A"),
+      "Copy the entries of a MatrixCSR into a PETSc Mat created from it.");
+  m.def(
+      "create_matrix_shell",
+      [](dolfinx::la::MatrixCSR<PetscScalar>& A, int num_threads)
+      {
+        Mat B = dolfinx::la::petsc::create_matrix_shell(A, num_threads);
+        PyObject* obj = PyPetscMat_New(B);
+        PetscObjectDereference((PetscObject)B);
+        return nb::borrow(obj);
+      },
+      nb::arg("A"), nb::arg("num_threads") = 1,
+      "Create a PETSc shell Mat that applies a MatrixCSR.");
+
   m.def(
       "create_index_sets",
       [](const std::vector<std::pair<const dolfinx::common::IndexMap*, int>>&
@@ -425,6 +454,8 @@ void petsc_nls_module(nb::module_& m)
            nb::arg("Jmat"))
       .def("setP", &dolfinx::nls::petsc::NewtonSolver::setP, nb::arg("P"),
            nb::arg("Pmat"))
+      .def("setFJ", &dolfinx::nls::petsc::NewtonSolver::setFJ,
+           nb::arg("FJ"))
       .def(
           "set_update",
           [](dolfinx::nls::petsc::NewtonSolver& self,
@@ -474,7 +505,36 @@ void petsc_nls_module(nb::module_& m)
       .def_rw("convergence_criterion",
               &dolfinx::nls::petsc::NewtonSolver::convergence_criterion,
               "Convergence criterion, either 'residual' (default) or "
-              "'incremental'");
+              "'incremental'")
+      .def_rw("jacobian_lag", &dolfinx::nls::petsc::NewtonSolver::jacobian_lag,
+              "Number of iterations that a Jacobian is reused for")
+      .def_rw("jacobian_lag_rate",
+              &dolfinx::nls::petsc::NewtonSolver::jacobian_lag_rate,
+              "Largest residual reduction ratio for which a lagged "
+              "Jacobian is reused")
+      .def_rw("preconditioner_lag",
+              &dolfinx::nls::petsc::NewtonSolver::preconditioner_lag,
+              "Number of Jacobian assemblies that a preconditioner is "
+              "reused for")
+      .def_rw("speculative_jacobian",
+              &dolfinx::nls::petsc::NewtonSolver::speculative_jacobian,
+              "Assemble the Jacobian while the residual norm is reduced")
+      .def_rw("eisenstat_walker",
+              &dolfinx::nls::petsc::NewtonSolver::eisenstat_walker,
+              "Adapt the linear solver tolerance with the Eisenstat-Walker "
+              "method")
+      .def_rw("eisenstat_walker_eta0",
+              &dolfinx::nls::petsc::NewtonSolver::eisenstat_walker_eta0)
+      .def_rw("eisenstat_walker_eta_max",
+              &dolfinx::nls::petsc::NewtonSolver::eisenstat_walker_eta_max)
+      .def_rw("eisenstat_walker_gamma",
+              &dolfinx::nls::petsc::NewtonSolver::eisenstat_walker_gamma)
+      .def_rw("eisenstat_walker_alpha",
+              &dolfinx::nls::petsc::NewtonSolver::eisenstat_walker_alpha)
+      .def_prop_ro("jacobian_assemblies",
+                   &dolfinx::nls::petsc::NewtonSolver::jacobian_assemblies)
+      .def_prop_ro("preconditioner_builds",
+                   &dolfinx::nls::petsc::NewtonSolver::preconditioner_builds);
 }
 
 } // namespace
@@ -9,9 +9,11 @@
 #include "dolfinx_wrappers/mesh.h"
 #include <concepts>
 #include <cstdint>
+#include <dolfinx/la/Vector.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/refinement/interval.h>
+#include <dolfinx/refinement/marking.h>
 #include <dolfinx/refinement/option.h>
 #include <dolfinx/refinement/refine.h>
 #include <dolfinx/refinement/uniform.h>
@@ -35,9 +37,15 @@ template <std::floating_point T>
 void export_refinement(nb::module_& m)
 {
   m.def(
-      "uniform_refine", [](const dolfinx::mesh::Mesh<T>& mesh)
-      { return dolfinx::refinement::uniform_refine<T>(mesh); },
-      nb::arg("mesh"));
+      "uniform_refine",
+      [](const dolfinx::mesh::Mesh<T>& mesh, bool redistribute)
+      {
+        if (redistribute)
+          return dolfinx::refinement::uniform_refine<T>(mesh);
+        else
+          return dolfinx::refinement::uniform_refine<T>(mesh, nullptr);
+      },
+      nb::arg("mesh"), nb::arg("redistribute") = true);
 
   m.def(
       "refine",
@@ -48,7 +56,7 @@ void export_refinement(nb::module_& m)
          std::optional<
              dolfinx_wrappers::part::impl::PythonCellPartitionFunction>
              partitioner,
-         dolfinx::refinement::Option option)
+         dolfinx::refinement::Option option, int num_threads)
       {
         std::optional<std::span<const std::int32_t>> cpp_edges(std::nullopt);
         if (edges.has_value())
@@ -63,7 +71,7 @@ void export_refinement(nb::module_& m)
                         partitioner.value())
                   : nullptr;
         auto [mesh1, cell, facet] = dolfinx::refinement::refine(
-            mesh, cpp_edges, cpp_partitioner, option);
+            mesh, cpp_edges, cpp_partitioner, option, num_threads);
 
         std::optional<nb::ndarray<std::int32_t, nb::numpy>> python_cell(
             std::nullopt);
@@ -85,7 +93,19 @@ void export_refinement(nb::module_& m)
                           std::move(python_facet)};
       },
       nb::arg("mesh"), nb::arg("edges").none(), nb::arg("partitioner").none(),
-      nb::arg("option"));
+      nb::arg("option"), nb::arg("num_threads") = 1);
+
+  m.def(
+      "mark_edges",
+      [](const dolfinx::mesh::Topology& topology,
+         const dolfinx::la::Vector<T>& eta, T theta,
+         dolfinx::refinement::Marking strategy)
+      {
+        return dolfinx_wrappers::as_nbarray(
+            dolfinx::refinement::mark_edges(topology, eta, theta, strategy));
+      },
+      nb::arg("topology"), nb::arg("eta"), nb::arg("theta"),
+      nb::arg("strategy"));
 }
 } // namespace
 
@@ -94,6 +114,10 @@ namespace dolfinx_wrappers
 
 void refinement(nb::module_& m)
 {
+  nb::enum_<dolfinx::refinement::Marking>(m, "Marking")
+      .value("dorfler", dolfinx::refinement::Marking::dorfler)
+      .value("maximum", dolfinx::refinement::Marking::maximum);
+
   export_refinement<float>(m);
   export_refinement<double>(m);
 
@@ -6,8 +6,13 @@
 #
 # SPDX-License-Identifier:    LGPL-3.0-or-later
 
+import json
+from pathlib import Path
 from time import sleep
 
+from mpi4py import MPI
+
+import numpy as np
 import pytest
 
 from dolfinx import common
@@ -65,5 +70,73 @@ def test_context_manager_anonymous():
     assert timer.elapsed().total_seconds() > 0.045
 
 
+
+def test_trace(tempdir):
+    """Test that named Timers are traced."""
+    common.trace_start()
+    with common.Timer("test_trace_outer"):
+        with common.Timer("test_trace_inner"):
+            sleep(0.01)
+    with common.Timer("test_trace_inner"):
+        pass
+    common.trace_stop()
+    with common.Timer("test_trace_outer"):
+        pass
+
+    filename = Path(tempdir, "trace.json")
+    common.trace_write_chrome(MPI.COMM_WORLD, filename)
+    if MPI.COMM_WORLD.rank == 0:
+        with open(filename) as f:
+            events = json.load(f)["traceEvents"]
+        regions = [e for e in events if e["ph"] == "X" and e["name"].startswith("test_trace")]
+        assert len(regions) == 3 * MPI.COMM_WORLD.size
+        outer = next(e for e in regions if e["name"] == "test_trace_outer" and e["pid"] == 0)
+        inner = next(e for e in regions if e["name"] == "test_trace_inner" and e["pid"] == 0)
+        assert outer["ts"] <= inner["ts"]
+        assert inner["ts"] + inner["dur"] <= outer["ts"] + outer["dur"]
+        assert inner["dur"] >= 0.9e4
+
+
+def test_perf_counters(capfd):
+    """Test that named Timers record hardware counters."""
+    if not common.perf_counters_start():
+        pytest.skip("Hardware counters are not available")
+    with common.Timer("test_perf_counters"):
+        sum(range(100000))
+    common.perf_counters_stop()
+    common.list_counters(MPI.COMM_WORLD)
+    if MPI.COMM_WORLD.rank == 0:
+        out = capfd.readouterr().out
+        assert "test_perf_counters" in out
+        assert "IPC" in out
+
+
+def test_comm_stats(capfd):
+    """Test recording of the communication statistics of a scatter."""
+    from dolfinx import la
+
+    comm = MPI.COMM_WORLD
+    n = 10
+    nbr = (comm.rank + 1) % comm.size
+    ghosts = np.array([nbr * n] if comm.size > 1 else [], dtype=np.int64)
+    owners = np.full_like(ghosts, nbr, dtype=np.int32)
+    index_map = common.IndexMap(comm, n, ghosts, owners, 0)
+    x = la.vector(index_map)
+
+    common.comm_stats_clear()
+    common.comm_stats_start()
+    x.scatter_forward()
+    x.scatter_forward()
+    common.comm_stats_stop()
+    x.scatter_forward()
+
+    common.list_comm_stats(comm, common.Reduction.max)
+    if comm.rank == 0:
+        out = capfd.readouterr().out
+        assert "Scatterer::scatter_fwd" in out
+        assert "bytes sent" in out
+    common.comm_stats_clear()
+
+
 if __name__ == "__main__":
     pytest.main([__file__])
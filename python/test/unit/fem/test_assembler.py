@@ -19,6 +19,7 @@ from basix.ufl import element, mixed_element
 from dolfinx import cpp as _cpp
 from dolfinx import default_real_type, default_scalar_type, fem, graph, la
 from dolfinx.fem import (
+    Assembler,
     Constant,
     Function,
     assemble_matrix,
@@ -159,6 +160,77 @@ def test_basic_assembly(mode, dtype):
     assert 4 * normA == pytest.approx(A.squared_norm())
 
 
+@dtype_parametrize
+def test_reusable_assembler(dtype):
+    mesh = create_unit_square(MPI.COMM_WORLD, 12, 12, dtype=dtype(0).real.dtype)
+    V = functionspace(mesh, ("Lagrange", 1))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    f = Function(V, dtype=dtype)
+    f.x.array[:] = 2.0
+    c = Constant(mesh, dtype(3.0))
+    a = form(inner(f * u, v) * dx, dtype=dtype)
+    L = form(inner(c * f, v) * dx + inner(f, v) * ds, dtype=dtype)
+    M = form(c * f * dx, dtype=dtype)
+
+    assembler_a, assembler_L = Assembler(a), Assembler(L)
+    assembler_M = Assembler(M, num_threads=2)
+    for value in [2.0, 5.0]:
+        f.x.array[:] = value
+        c.value = 1.5 * value
+
+        b = assemble_vector(L)
+        b1 = np.zeros_like(b.array)
+        assembler_L.assemble_vector(b1)
+        np.testing.assert_allclose(b1, b.array, rtol=1e-5)
+
+        A = assemble_matrix(a)
+        A1 = fem.create_matrix(a)
+        assembler_a.assemble_matrix(A1)
+        np.testing.assert_allclose(A1.data, A.data, rtol=1e-5)
+
+        m = assembler_M.assemble_scalar()
+        assert m == pytest.approx(assemble_scalar(M), rel=1e-5)
+
+
+@dtype_parametrize
+def test_assemble_scalar_threads(dtype):
+    mesh = create_unit_square(MPI.COMM_WORLD, 48, 48, dtype=dtype(0).real.dtype)
+    V = functionspace(mesh, ("Lagrange", 2))
+    f = Function(V, dtype=dtype)
+    f.interpolate(lambda x: np.sin(4 * x[0]) * np.cos(3 * x[1]))
+    M = form(f * f * dx + f * ds + ufl.avg(f) * dS, dtype=dtype)
+    m = assemble_scalar(M)
+    for num_threads in [2, 3, 8]:
+        assert assemble_scalar(M, num_threads=num_threads) == m
+
+
+@dtype_parametrize
+def test_assemble_interior_facets_cached(dtype):
+    mesh = create_unit_square(
+        MPI.COMM_WORLD, 12, 10, ghost_mode=GhostMode.shared_facet, dtype=dtype(0).real.dtype
+    )
+    V = functionspace(mesh, ("DG", 1))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    f = Function(V, dtype=dtype)
+    f.interpolate(lambda x: np.sin(4 * x[0]) * np.cos(3 * x[1]))
+    n = ufl.FacetNormal(mesh)
+    a = form(
+        inner(ufl.jump(u), ufl.jump(v)) * dS + inner(ufl.avg(ufl.grad(u)), ufl.jump(v, n)) * dS,
+        dtype=dtype,
+    )
+    L = form(inner(ufl.avg(f), ufl.avg(v)) * dS, dtype=dtype)
+
+    A0 = assemble_matrix(a)
+    b0 = assemble_vector(L)
+    a.cache_facet_pairs(True)
+    L.cache_facet_pairs(True)
+    for _ in range(2):
+        A1 = assemble_matrix(a)
+        b1 = assemble_vector(L)
+        assert np.array_equal(A1.data, A0.data)
+        assert np.array_equal(b1.array, b0.array)
+
+
 def nest_matrix_norm(A):
     """Return norm of a MatNest matrix"""
     assert A.getType() == "nest"
@@ -73,3 +73,17 @@ def test_complex_method():
     a = 1.0 + 1.0j
     c0 = Constant(mesh, a)
     assert a == complex(c0)
+
+
+def test_state():
+    mesh = create_unit_cube(MPI.COMM_WORLD, 2, 2, 2)
+    c0 = Constant(mesh, [1.0, 2.0])
+    c1 = Constant(mesh, 1.0)
+    s0, s1 = c0._cpp_object.state, c1._cpp_object.state
+    assert s0 != s1
+    assert c0._cpp_object.state == s0
+    c0.value = [1.0, 2.0]
+    assert c0._cpp_object.state == s0
+    c0.value += 1.0
+    assert c0._cpp_object.state > s0
+    assert c1._cpp_object.state == s1
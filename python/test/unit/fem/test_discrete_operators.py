@@ -46,6 +46,28 @@ def test_gradient(mesh):
     assert np.isclose(G.squared_norm(), 2.0 * num_edges)
 
 
+@pytest.mark.parametrize("num_threads", [2, 3])
+def test_discrete_operators_threaded(num_threads):
+    """Test that operators computed with threads match the serial operators."""
+    from dolfinx.fem import interpolation_matrix
+
+    mesh = create_unit_cube(MPI.COMM_WORLD, 5, 4, 3)
+    V = functionspace(mesh, ("Lagrange", 2))
+    W = functionspace(mesh, ("Nedelec 1st kind H(curl)", 2))
+    R = functionspace(mesh, ("Raviart-Thomas", 1))
+    Q = functionspace(mesh, ("Lagrange", 1, (3,)))
+    for op, V0, V1 in [
+        (discrete_gradient, V, W),
+        (discrete_curl, W, R),
+        (interpolation_matrix, Q, W),
+    ]:
+        A0 = op(V0, V1)
+        A1 = op(V0, V1, num_threads=num_threads)
+        assert np.array_equal(A0.indptr, A1.indptr)
+        assert np.array_equal(A0.indices, A1.indices)
+        assert np.allclose(A0.data, A1.data)
+
+
 @pytest.mark.parametrize("cell", [CellType.triangle, CellType.quadrilateral])
 def test_discrete_curl_gdim_raises(cell):
     """Test that discrete curl function raises for gdim != 3."""
@@ -445,3 +445,31 @@ def test_empty_rank_collapse():
     V = functionspace(mesh, el)
     V_0, _ = V.sub(0).collapse()
     assert V.dofmap.index_map.size_local == V_0.dofmap.index_map.size_local
+
+
+@pytest.mark.parametrize(
+    "reorder_fn", [dolfinx.cpp.graph.reorder_gps, dolfinx.cpp.graph.reorder_rcm]
+)
+def test_dof_reordering(reorder_fn):
+    """Test that dof re-ordering changes only the numbering of the dofs"""
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 5)
+    V0 = functionspace(mesh, ("Lagrange", 2, (2,)))
+    V1 = functionspace(mesh, ("Lagrange", 2, (2,)), reorder_fn=reorder_fn)
+    assert V0.dofmap.index_map.size_local == V1.dofmap.index_map.size_local
+    assert V0.dofmap.index_map_bs == V1.dofmap.index_map_bs == 2
+
+    # Each dof of V1 is at the same point as the corresponding dof of V0
+    x0, x1 = V0.tabulate_dof_coordinates(), V1.tabulate_dof_coordinates()
+    dofs0, dofs1 = V0.dofmap.list, V1.dofmap.list
+    assert np.allclose(x0[dofs0], x1[dofs1])
+
+
+@pytest.mark.parametrize("reorder_fn", [None, dolfinx.cpp.graph.reorder_gps])
+def test_dofmap_threaded(reorder_fn):
+    """Test that a dofmap built with threads is the same as a serial one"""
+    mesh = create_unit_cube(MPI.COMM_WORLD, 4, 3, 3)
+    V0 = functionspace(mesh, ("Lagrange", 3), reorder_fn=reorder_fn)
+    V1 = functionspace(mesh, ("Lagrange", 3), reorder_fn=reorder_fn, num_threads=3)
+    assert np.array_equal(V0.dofmap.list, V1.dofmap.list)
+    assert np.array_equal(V0.dofmap.index_map.ghosts, V1.dofmap.index_map.ghosts)
+    assert np.array_equal(V0.dofmap.index_map.owners, V1.dofmap.index_map.owners)
@@ -332,6 +332,11 @@ def test_assembly_into_quadrature_function(dtype):
         e_exact_eval[Q_dofs_unrolled[cell]] = e_exact(x.T).T.flatten()
     assert np.allclose(local, e_exact_eval)
 
+    # Interpolate directly into the Quadrature function
+    e_Q1 = Function(Q, dtype=dtype)
+    e_Q1.interpolate(e_expr, cells)
+    assert np.allclose(e_Q1.x.array, e_exact_eval)
+
 
 @pytest.mark.parametrize(
     "dtype",
@@ -372,6 +377,12 @@ def test_expression_eval_cells_subset(dtype):
     u_ = e.eval(mesh, cells)
     assert np.allclose(u_.ravel(), cells)
 
+    # Test threaded eval
+    cells = np.arange(cells_imap.size_local - 1, -1, -1, dtype=np.int32)
+    for num_threads in [2, 3, cells.size + 1]:
+        u_ = e.eval(mesh, cells, num_threads=num_threads)
+        assert np.allclose(u_.ravel(), cells)
+
 
 @pytest.mark.parametrize(
     "dtype",
@@ -55,6 +55,27 @@ def test_extract_forms():
         extract_function_spaces(a, 1)
 
 
+def test_form_list_one_module(tmp_path):
+    """Test that the forms of a list are compiled into one module, and
+    that processes load it from a node-local copy of the cache."""
+    mesh = create_unit_square(MPI.COMM_WORLD, 8, 7)
+    V = functionspace(mesh, ("Lagrange", 1))
+    u, v = TrialFunction(V), TestFunction(V)
+    x = SpatialCoordinate(mesh)
+
+    node_cache_dir = MPI.COMM_WORLD.bcast(tmp_path, root=0) / "node_cache"
+    jit_options = {"node_cache_dir": node_cache_dir}
+    a, L = form([inner(u, v) * dx, inner(x[0], v) * dx], jit_options=jit_options)
+    assert a.module is L.module
+    assert a.rank == 2 and L.rank == 1
+    b = dolfinx.fem.assemble_vector(L)
+    b.scatter_reverse(dolfinx.la.InsertMode.add)
+    num_owned = V.dofmap.index_map.size_local
+    assert np.isclose(mesh.comm.allreduce(b.array[:num_owned].sum()), 0.5)
+    if mesh.comm.size > 1:
+        assert any(node_cache_dir.glob(f"{a.module.__name__}.*.cached"))
+
+
 def test_incorrect_element():
     """Test that an error is raised if an incorrect element is used."""
     mesh = create_unit_square(MPI.COMM_WORLD, 32, 31)
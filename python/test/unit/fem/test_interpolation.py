@@ -20,9 +20,13 @@ from dolfinx.fem import (
     Expression,
     Function,
     assemble_scalar,
+    create_dof_coordinates,
+    create_interpolation_coords,
     create_interpolation_data,
+    create_interpolation_plan,
     form,
     functionspace,
+    locate_dofs_topological,
 )
 from dolfinx.geometry import bb_tree, compute_collisions_points
 from dolfinx.mesh import (
@@ -266,6 +270,41 @@ def run_vector_test(V, poly_order):
         assert np.allclose(val, f(p), atol=1.0e-5)
 
 
+@pytest.mark.parametrize("cell_type", [CellType.triangle, CellType.quadrilateral])
+@pytest.mark.parametrize("shape", [(), (2,)])
+def test_interpolation_dofs(cell_type, shape):
+    """Test that interpolation at boundary dofs matches interpolation on all
+    cells at those dofs, and leaves the other dofs unchanged."""
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 5, cell_type=cell_type, dtype=default_real_type)
+    V = functionspace(mesh, ("Lagrange", 3, shape))
+    bs = V.dofmap.bs
+
+    def f(x):
+        return np.vstack([x[0] ** 3 + (k + 1) * x[1] for k in range(bs)])
+
+    tdim = mesh.topology.dim
+    facets = locate_entities_boundary(mesh, tdim - 1, lambda x: np.isclose(x[0], 0.0))
+    mesh.topology.create_connectivity(tdim - 1, tdim)
+    dofs = locate_dofs_topological(V, tdim - 1, facets)
+    coords = create_dof_coordinates(V, dofs)
+
+    u0, u1 = Function(V), Function(V)
+    u0.interpolate(f)
+    u1.x.array[:] = -1.0
+    u1.interpolate_dofs(f, coords)
+    marked = np.zeros(len(u1.x.array), dtype=bool)
+    for k in range(bs):
+        marked[bs * dofs + k] = True
+    assert np.allclose(u1.x.array[marked], u0.x.array[marked])
+    assert np.all(u1.x.array[~marked] == -1.0)
+
+    # Move the mesh, which invalidates the coordinates
+    mesh.geometry.x[:, 1] += 1
+    u0.interpolate(f)
+    u1.interpolate_dofs(f, coords)
+    assert np.allclose(u1.x.array[marked], u0.x.array[marked])
+
+
 @pytest.mark.skip_in_parallel
 @parametrize_cell_types
 @pytest.mark.parametrize("order", range(1, 5))
@@ -288,6 +327,32 @@ def test_serendipity_interpolation(cell_type, order):
     run_scalar_test(V, order)
 
 
+@pytest.mark.parametrize("cache", [True, False])
+def test_interpolation_chunked(cache):
+    """Test that chunked interpolation of a callable matches interpolation
+    in one pass, and that cached coordinates follow the geometry."""
+    mesh = create_unit_square(MPI.COMM_WORLD, 7, 5, dtype=default_real_type)
+    V = functionspace(mesh, ("Lagrange", 2, (2,)))
+
+    def f(x):
+        return np.vstack((x[0] ** 2, x[0] * x[1]))
+
+    u0, u1 = Function(V), Function(V)
+    u0.interpolate(f)
+    coords = create_interpolation_coords(V, chunk_size=7, cache=cache)
+    assert coords.num_chunks > 1
+    for _ in range(2):
+        u1.x.array[:] = 0
+        u1.interpolate_chunked(f, coords)
+        assert np.allclose(u1.x.array, u0.x.array)
+
+    # Move the mesh, which invalidates cached coordinates
+    mesh.geometry.x[:, 0] += 1
+    u0.interpolate(f)
+    u1.interpolate_chunked(f, coords)
+    assert np.allclose(u1.x.array, u0.x.array)
+
+
 @pytest.mark.skip_in_parallel
 @parametrize_cell_types
 @pytest.mark.parametrize("order", range(1, 5))
@@ -460,6 +525,32 @@ def test_interpolation_n1curl_to_dg(tdim, order):
     assert assemble_scalar(form(ufl.inner(u - v, u - v) * ufl.dx)) == pytest.approx(0.0, abs=1e-10)
 
 
+@pytest.mark.parametrize("order", [1, 2])
+def test_interpolation_nonmatching_maps_repeated(order):
+    """Repeated interpolation between spaces with different maps reuses the cell operators."""
+    mesh = create_unit_cube(MPI.COMM_WORLD, 2, 2, 2)
+    V = functionspace(mesh, ("Lagrange", order, (3,)))
+    V1 = functionspace(mesh, ("N1curl", order + 1))
+    u, v = Function(V), Function(V1)
+    for k in range(3):
+        u.interpolate(lambda x: (k + 1) * x**order)
+        v.interpolate(u)
+        w = Function(V1)
+        w.interpolate(u)
+        assert np.allclose(v.x.array, w.x.array)
+        e = assemble_scalar(form(ufl.inner(u - v, u - v) * ufl.dx))
+        assert e == pytest.approx(0.0, abs=1.0e-10)
+
+    # Interpolate on a subset of cells
+    cells = np.arange(mesh.topology.index_map(3).size_local // 2, dtype=np.int32)
+    for _ in range(2):
+        v.x.array[:] = 0
+        v.interpolate(u, cells0=cells)
+    w = Function(V1)
+    w.interpolate(u, cells0=cells)
+    assert np.allclose(v.x.array, w.x.array)
+
+
 @pytest.mark.parametrize("tdim", [2, 3])
 @pytest.mark.parametrize("order", [1, 2, 3])
 def test_interpolation_n2curl_to_bdm(tdim, order):
@@ -948,6 +1039,31 @@ def test_nonmatching_mesh_interpolation(xtype, cell_type0, cell_type1):
     assert np.isclose(assemble_scalar(form(residual, dtype=xtype)), 0)
 
 
+@pytest.mark.parametrize("xtype", [np.float32, np.float64])
+def test_nonmatching_mesh_interpolation_plan(xtype):
+    mesh0 = create_unit_cube(MPI.COMM_WORLD, 4, 5, 3, dtype=xtype)
+    mesh1 = create_unit_cube(MPI.COMM_WORLD, 3, 2, 6, cell_type=CellType.hexahedron, dtype=xtype)
+    V0 = functionspace(mesh0, ("Lagrange", 2, (3,)))
+    V1 = functionspace(mesh1, ("Lagrange", 1, (3,)))
+
+    cell_map = mesh1.topology.index_map(mesh1.topology.dim)
+    cells = np.arange(cell_map.size_local + cell_map.num_ghosts, dtype=np.int32)
+    interpolation_data = create_interpolation_data(V1, V0, cells, padding=1e-6)
+    plan = create_interpolation_plan(V0, cells, interpolation_data)
+
+    # Repeated interpolation with the plan gives the same result as
+    # interpolation with the data it was created from
+    u0 = Function(V0, dtype=xtype)
+    u1, u1_plan = Function(V1, dtype=xtype), Function(V1, dtype=xtype)
+    for k in range(3):
+        u0.interpolate(lambda x: (x[0] ** 2 + k, x[1] * x[2], np.sin(x[0] + k)))
+        u0.x.scatter_forward()
+        u1.interpolate_nonmatching(u0, cells, interpolation_data)
+        u1_plan.interpolate_nonmatching_plan(u0, plan)
+        eps = np.finfo(xtype).eps
+        assert np.allclose(u1_plan.x.array, u1.x.array, rtol=100 * eps, atol=100 * eps)
+
+
 @pytest.mark.parametrize("xtype", [np.float64])
 def test_nonmatching_mesh_single_cell_overlap_interpolation(xtype):
     # mesh2 is contained by a single cell of mesh1. Here we test
@@ -450,6 +450,42 @@ def test_serial_global_bb_tree(dtype, comm):
         assert len(tree_col.links(1)) > 0
 
 
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+def test_threaded_build_and_refit(dtype):
+    """Test that threaded builds match the serial build, and that a
+    refitted tree matches a rebuilt tree"""
+    mesh = create_unit_cube(MPI.COMM_WORLD, 5, 4, 3, dtype=dtype)
+    tdim = mesh.topology.dim
+    tree = bb_tree(mesh, tdim, padding=0.01)
+    for num_threads in [2, 3, 8]:
+        tree_t = bb_tree(mesh, tdim, padding=0.01, num_threads=num_threads)
+        assert np.array_equal(tree_t.bbox_coordinates, tree.bbox_coordinates)
+
+    # Scaling the geometry by 2 (exact in floating point) does not
+    # change the tree structure
+    tree = bb_tree(mesh, tdim)
+    mesh.geometry.x[:] *= 2
+    tree.refit(mesh, num_threads=2)
+    tree_new = bb_tree(mesh, tdim)
+    assert np.array_equal(tree.bbox_coordinates, tree_new.bbox_coordinates)
+
+
+@pytest.mark.parametrize("packet_size", [4, 8, 16])
+@pytest.mark.parametrize("num_threads", [1, 3])
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+def test_compute_collisions_points_packets(packet_size, num_threads, dtype):
+    """Test that packet traversal gives the same collisions as traversal by single points"""
+    mesh = create_unit_cube(MPI.COMM_WORLD, 5, 4, 3, dtype=dtype)
+    tree = bb_tree(mesh, mesh.topology.dim)
+    rng = np.random.default_rng(12)
+    x = rng.uniform(-0.1, 1.1, size=(101, 3)).astype(dtype)
+    x = x[np.lexsort(x.T)]
+    ref = compute_collisions_points(tree, x)
+    col = compute_collisions_points(tree, x, packet_size=packet_size, num_threads=num_threads)
+    assert np.array_equal(col.offsets, ref.offsets)
+    assert np.array_equal(col.array, ref.array)
+
+
 @pytest.mark.parametrize("ct", [CellType.hexahedron, CellType.tetrahedron])
 @pytest.mark.parametrize("N", [7, 13])
 @pytest.mark.parametrize("dtype", [np.float32, np.float64])
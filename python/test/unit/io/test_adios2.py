@@ -154,6 +154,26 @@ class TestVTX:
 
         f.close()
 
+    def test_vtx_sub_functions(self, tempdir):
+        """Test saving sub-Functions without collapsing them."""
+        from basix.ufl import mixed_element
+        from dolfinx.io import VTXWriter
+
+        mesh = generate_mesh(2, True)
+        Pv = element("Lagrange", mesh.basix_cell(), 2, shape=(2,), dtype=default_real_type)
+        Ps = element("Lagrange", mesh.basix_cell(), 2, dtype=default_real_type)
+        U = Function(functionspace(mesh, mixed_element([Pv, Ps])))
+        U.sub(0).interpolate(lambda x: np.vstack((x[0], x[1])))
+        U.sub(1).interpolate(lambda x: x[0] + x[1])
+
+        for i in range(2):
+            u = U.sub(i)
+            filename = Path(tempdir, f"u_sub{i}.bp")
+            with VTXWriter(mesh.comm, filename, u) as f:
+                f.write(0.0)
+                U.x.array[:] += 1
+                f.write(1.0)
+
     def test_save_vtkx_cell_point(self, tempdir):
         """Test writing point-wise data."""
         from dolfinx.io import VTXWriter
@@ -243,3 +263,135 @@ class TestVTX:
             else:
                 assert int(var["AvailableStepsCount"]) == target_all
         adios_file.close()
+
+    def test_vtx_async_write(self, tempdir):
+        """Test that asynchronous writes snapshot the Function data."""
+        from dolfinx.io import VTXWriter
+
+        adios2 = pytest.importorskip("adios2", minversion="2.10.0")
+        if not adios2.is_built_with_mpi:
+            pytest.skip("Require adios2 built with MPI support")
+
+        mesh = generate_mesh(2, True)
+        v = Function(functionspace(mesh, ("Lagrange", 1)))
+        v.name = "v"
+        filename = Path(tempdir, "v_async.bp")
+        with VTXWriter(mesh.comm, filename, v, "BP5", async_write=True) as writer:
+            for t in range(3):
+                v.x.array[:] = t
+                writer.write(t)
+                v.x.array[:] = -1
+
+        adios = adios2.Adios(comm=mesh.comm)
+        io = adios.declare_io("TestData")
+        io.set_engine("BP5")
+        adios_file = adios2.Stream(io, str(filename), "r", mesh.comm)
+        for t, _ in enumerate(adios_file.steps()):
+            assert np.allclose(adios_file.read("v", block_id=mesh.comm.rank), t)
+        adios_file.close()
+
+    @pytest.mark.parametrize("dtype", [np.float64, np.complex128])
+    def test_vtx_reader(self, tempdir, dtype):
+        """Test reading the steps written by a VTXWriter into Functions."""
+        from dolfinx.io import VTXReader, VTXWriter
+
+        mesh = generate_mesh(2, True)
+        V = functionspace(mesh, ("Lagrange", 2, (2,)))
+        W = functionspace(mesh, ("Lagrange", 2))
+        u, w = Function(V, name="u", dtype=dtype), Function(W, name="w", dtype=dtype)
+        filename = Path(tempdir, "v_read.bp")
+        with VTXWriter(mesh.comm, filename, [u, w], "BP4") as writer:
+            for t in range(3):
+                u.x.array[:] = np.arange(u.x.array.size) + t
+                w.x.array[:] = np.arange(w.x.array.size) - t
+                writer.write(0.5 * t)
+
+        u1, w1 = Function(V, name="u", dtype=dtype), Function(W, name="w", dtype=dtype)
+        with VTXReader(mesh.comm, filename, [u1, w1], "BP4") as reader:
+            for t in range(3):
+                assert reader.read() == 0.5 * t
+                assert np.allclose(u1.x.array, np.arange(u.x.array.size) + t)
+                assert np.allclose(w1.x.array, np.arange(w.x.array.size) - t)
+            assert reader.read() is None
+
+    @pytest.mark.parametrize("dtype", [np.float64, np.complex128])
+    @pytest.mark.parametrize("degree", [0, 2])
+    def test_vtx_cell_subset(self, tempdir, dtype, degree):
+        """Test writing a Function on a subset of the cells."""
+        from dolfinx.io import VTXWriter
+
+        mesh = generate_mesh(2, True)
+        family = "DG" if degree == 0 else "Lagrange"
+        V = functionspace(mesh, (family, degree))
+        u = Function(V, dtype=dtype)
+        u.interpolate(lambda x: x[0] + 2 * x[1])
+        tdim = mesh.topology.dim
+        cells = np.arange(0, mesh.topology.index_map(tdim).size_local, 3, dtype=np.int32)
+        filename = Path(tempdir, f"v_subset_{degree}.bp")
+        with VTXWriter(mesh.comm, filename, u, "BP4") as writer:
+            writer.set_cells(cells)
+            for t in range(2):
+                writer.write(t)
+            with pytest.raises(RuntimeError):
+                writer.set_cells(cells)
+
+        with pytest.raises(RuntimeError):
+            with VTXWriter(mesh.comm, Path(tempdir, "v_bad.bp"), u, "BP4") as writer:
+                writer.set_cells(np.array([-1], dtype=np.int32))
+
+    @pytest.mark.parametrize("dtype", [np.float64, np.complex128])
+    def test_vtx_reader_random_access(self, tempdir, dtype):
+        """Test reading chosen steps written by a VTXWriter for a restart."""
+        from dolfinx.io import VTXReader, VTXWriter
+
+        mesh = generate_mesh(2, True)
+        V = functionspace(mesh, ("Lagrange", 2))
+        Q = functionspace(mesh, ("DG", 0))
+        u = Function(V, name="u", dtype=dtype)
+        filename = Path(tempdir, "v_restart.bp")
+        with VTXWriter(mesh.comm, filename, [u], "BP4") as writer:
+            for t in range(3):
+                u.x.array[:] = np.arange(u.x.array.size) + t
+                writer.write(0.5 * t)
+
+        u1 = Function(V, name="u", dtype=dtype)
+        with VTXReader(mesh.comm, filename, [u1], "BP4", random_access=True) as reader:
+            assert reader.num_steps() == 3
+            assert np.allclose(reader.times(), [0.0, 0.5, 1.0])
+            for t in [2, 0, 1]:
+                assert reader.read_step(t) == 0.5 * t
+                assert np.allclose(u1.x.array, np.arange(u.x.array.size) + t)
+            with pytest.raises(RuntimeError):
+                reader.read()
+
+        # Data written for a different space is rejected
+        q1 = Function(Q, name="u", dtype=dtype)
+        with VTXReader(mesh.comm, filename, [q1], "BP4", random_access=True) as reader:
+            with pytest.raises(RuntimeError):
+                reader.read_step(0)
+
+    @pytest.mark.parametrize("dtype", [np.float64, np.complex128])
+    def test_vtx_single_precision(self, tempdir, dtype):
+        """Test writing a Function in single precision."""
+        from dolfinx.io import VTXFieldOptions, VTXReader, VTXWriter
+
+        mesh = generate_mesh(2, True)
+        V = functionspace(mesh, ("Lagrange", 1))
+        u, w = Function(V, name="u", dtype=dtype), Function(V, name="w", dtype=dtype)
+        u.x.array[:] = np.sqrt(np.arange(u.x.array.size) + 1)
+        w.x.array[:] = u.x.array
+        filename = Path(tempdir, "v_single.bp")
+        with VTXWriter(mesh.comm, filename, [u, w], "BP4") as writer:
+            options = VTXFieldOptions()
+            options.single_precision = True
+            writer.set_field_options("u", options)
+            writer.write(0.0)
+            with pytest.raises(RuntimeError):
+                writer.set_field_options("w", options)
+
+        u1, w1 = Function(V, name="u", dtype=dtype), Function(V, name="w", dtype=dtype)
+        with VTXReader(mesh.comm, filename, [u1, w1], "BP4") as reader:
+            assert reader.read() == 0.0
+        single = np.complex64 if np.issubdtype(dtype, np.complexfloating) else np.float32
+        assert np.array_equal(u1.x.array, u.x.array.astype(single).astype(dtype))
+        assert np.array_equal(w1.x.array, w.x.array)
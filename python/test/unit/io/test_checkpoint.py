@@ -0,0 +1,47 @@
+# Copyright (C) 2026 The DOLFINx developers
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+
+from mpi4py import MPI
+
+import numpy as np
+import pytest
+
+import dolfinx
+from dolfinx.fem import Function, functionspace
+from dolfinx.io import checkpoint
+from dolfinx.mesh import CellType, GhostMode, create_unit_cube
+
+
+def f(x):
+    return np.vstack((x[0] + 2 * x[1] * x[2], x[1] - x[0] ** 2, 3 * x[2] + x[0]))
+
+
+@pytest.mark.parametrize("ghost_mode", [GhostMode.none, GhostMode.shared_facet])
+@pytest.mark.parametrize("element", [("Lagrange", 2, (3,)), ("N1curl", 1, None)])
+def test_checkpoint(tmp_path, ghost_mode, element):
+    comm = MPI.COMM_WORLD
+    filename = comm.bcast(tmp_path, root=0) / "checkpoint.h5"
+    dtype = dolfinx.default_real_type
+    mesh = create_unit_cube(comm, 3, 2, 4, CellType.tetrahedron, ghost_mode=ghost_mode, dtype=dtype)
+    family, degree, shape = element
+    V = functionspace(mesh, (family, degree, shape))
+    u = Function(V, name="u", dtype=dolfinx.default_scalar_type)
+    u.interpolate(f)
+    checkpoint.write_mesh(filename, mesh)
+    checkpoint.write_function(filename, u)
+
+    mesh1 = checkpoint.read_mesh(comm, filename, dtype)
+    assert mesh1.topology.index_map(3).size_global == mesh.topology.index_map(3).size_global
+    if comm.size > 1:
+        # The distribution of the cells is restored
+        assert mesh1.topology.index_map(3).size_local == mesh.topology.index_map(3).size_local
+    V1 = functionspace(mesh1, (family, degree, shape))
+    u1 = Function(V1, name="u", dtype=dolfinx.default_scalar_type)
+    checkpoint.read_function(filename, u1)
+    u_ref = Function(V1, dtype=dolfinx.default_scalar_type)
+    u_ref.interpolate(f)
+    tol = 100 * np.finfo(dtype).eps
+    np.testing.assert_allclose(u1.x.array, u_ref.x.array, rtol=tol, atol=tol)
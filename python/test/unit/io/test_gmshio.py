@@ -0,0 +1,61 @@
+# Copyright (C) 2026 The DOLFINx developers
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+
+from mpi4py import MPI
+
+import numpy as np
+import pytest
+
+from dolfinx.io.gmshio import read_from_msh, read_from_msh_distributed
+
+
+@pytest.mark.parametrize("order", [1, 2])
+def test_read_from_msh_distributed(tmp_path, order):
+    gmsh = pytest.importorskip("gmsh")
+    comm = MPI.COMM_WORLD
+    filename = comm.bcast(tmp_path, root=0) / f"box_{order}.msh"
+    if comm.rank == 0:
+        gmsh.initialize()
+        gmsh.option.setNumber("General.Terminal", 0)
+        gmsh.model.add("box")
+        gmsh.model.occ.addBox(0, 0, 0, 1, 1, 1)
+        gmsh.model.occ.synchronize()
+        gmsh.model.addPhysicalGroup(3, [1], tag=3, name="volume")
+        gmsh.model.addPhysicalGroup(2, [1, 2], tag=5, name="walls")
+        gmsh.option.setNumber("Mesh.CharacteristicLengthMax", 0.3)
+        gmsh.model.mesh.generate(3)
+        gmsh.model.mesh.setOrder(order)
+        gmsh.option.setNumber("Mesh.Binary", 1)
+        gmsh.option.setNumber("Mesh.MshFileVersion", 4.1)
+        gmsh.write(str(filename))
+        gmsh.finalize()
+    comm.barrier()
+
+    ref = read_from_msh(filename, comm, rank=0)
+    data = read_from_msh_distributed(filename, comm)
+    assert data.physical_groups == ref.physical_groups
+
+    mesh, mesh_ref = data.mesh, ref.mesh
+    for d in (0, 3):
+        assert (
+            mesh.topology.index_map(d).size_global == mesh_ref.topology.index_map(d).size_global
+        )
+    assert mesh.geometry.index_map().size_global == mesh_ref.geometry.index_map().size_global
+    x = mesh.geometry.x[: mesh.geometry.index_map().size_local]
+    x_ref = mesh_ref.geometry.x[: mesh_ref.geometry.index_map().size_local]
+    x_sum = comm.allreduce(x[:, 0].sum(), op=MPI.SUM)
+    x_sum_ref = comm.allreduce(x_ref[:, 0].sum(), op=MPI.SUM)
+    assert np.isclose(x_sum, x_sum_ref)
+
+    for tags, tags_ref in ((data.cell_tags, ref.cell_tags), (data.facet_tags, ref.facet_tags)):
+        num_owned = tags.topology.index_map(tags.dim).size_local
+        num_owned_ref = tags_ref.topology.index_map(tags_ref.dim).size_local
+        values = tags.values[tags.indices < num_owned]
+        values_ref = tags_ref.values[tags_ref.indices < num_owned_ref]
+        for value in (3, 5):
+            assert comm.allreduce(np.count_nonzero(values == value), op=MPI.SUM) == comm.allreduce(
+                np.count_nonzero(values_ref == value), op=MPI.SUM
+            )
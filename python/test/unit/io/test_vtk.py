@@ -4,7 +4,9 @@
 #
 # SPDX-License-Identifier:    LGPL-3.0-or-later
 
+import base64
 from pathlib import Path
+from xml.etree import ElementTree
 
 from mpi4py import MPI
 
@@ -173,14 +175,13 @@ def test_save_vtk_mixed(tempdir):
     with VTKFile(mesh.comm, filename, "w") as vtk:
         vtk.write_function([U1, U2], 0.0)
 
+    # Sub-Functions are written without collapsing them
     Up = U.sub(1)
     Up.name = "psub"
-    with pytest.raises(RuntimeError):
-        with VTKFile(mesh.comm, filename, "w") as vtk:
-            vtk.write_function([U2, Up, U1], 0)
-    with pytest.raises(RuntimeError):
-        with VTKFile(mesh.comm, filename, "w") as vtk:
-            vtk.write_function([U.sub(i) for i in range(W.num_sub_spaces)], 0)
+    with VTKFile(mesh.comm, filename, "w") as vtk:
+        vtk.write_function([U2, Up, U1], 0)
+    with VTKFile(mesh.comm, filename, "w") as vtk:
+        vtk.write_function([U.sub(i) for i in range(W.num_sub_spaces)], 0)
 
 
 @pytest.mark.parametrize("cell_type", cell_types_2D)
@@ -222,6 +223,41 @@ def test_save_vtk_cell_point(tempdir):
         vtk.write_function((U1, U2), 0.0)
 
 
+def test_save_vtk_binary(tempdir):
+    """Test that binary data arrays hold the same values as ASCII arrays"""
+    mesh = create_unit_square(MPI.COMM_WORLD, 4, 3)
+    V = functionspace(mesh, ("Lagrange", 1, (2,)))
+    u = Function(V)
+    u.interpolate(lambda x: np.vstack((x[0], 0.2 * x[1])))
+    u.name = "u"
+
+    def data_arrays(filename):
+        tree = ElementTree.parse(filename)
+        return tree.getroot().iter("DataArray")
+
+    files = {}
+    for encoding in (VTKFile.Encoding.ASCII, VTKFile.Encoding.Binary):
+        filename = Path(tempdir, f"{encoding.name}.pvd")
+        with VTKFile(mesh.comm, filename, "w", encoding) as vtk:
+            vtk.write_mesh(mesh)
+            vtk.write_function(u, 1.0)
+        mesh.comm.barrier()
+        files[encoding] = [
+            Path(tempdir, f"{encoding.name}_p{mesh.comm.rank}_00000{i}.vtu") for i in range(2)
+        ]
+
+    dtypes = {"Float64": "<f8", "Float32": "<f4", "Int64": "<i8", "Int8": "i1", "UInt8": "u1"}
+    f_ascii, f_binary = files[VTKFile.Encoding.ASCII], files[VTKFile.Encoding.Binary]
+    for file_ascii, file_binary in zip(f_ascii, f_binary):
+        for a, b in zip(data_arrays(file_ascii), data_arrays(file_binary), strict=True):
+            assert a.get("format") == "ascii"
+            assert b.get("format") == "binary"
+            data = base64.b64decode(b.text.strip())
+            assert np.frombuffer(data[:8], dtype="<u8")[0] == len(data) - 8
+            values = np.frombuffer(data[8:], dtype=dtypes[b.get("type")])
+            assert np.allclose(values, np.array((a.text or "").split(), dtype=np.float64))
+
+
 def test_save_1d_tensor(tempdir):
     mesh = create_unit_interval(MPI.COMM_WORLD, 32)
     e = element("Lagrange", mesh.basix_cell(), 2, shape=(2, 2), dtype=default_real_type)
@@ -11,7 +11,7 @@ import pytest
 
 import dolfinx
 import ufl
-from dolfinx.io.vtkhdf import read_mesh, write_mesh
+from dolfinx.io.vtkhdf import read_mesh, write_data, write_mesh
 from dolfinx.mesh import CellType, Mesh, create_unit_cube, create_unit_square
 
 
@@ -33,6 +33,41 @@ def test_read_write_vtkhdf_mesh3d():
     assert mesh.topology.index_map(3).size_global == mesh2.topology.index_map(3).size_global
 
 
+def test_write_vtkhdf_data(tmp_path):
+    comm = MPI.COMM_WORLD
+    filename = comm.bcast(tmp_path, root=0) / "data.vtkhdf"
+    dtype = dolfinx.default_real_type
+    mesh = create_unit_square(comm, 5, 4, dtype=dtype)
+    V = dolfinx.fem.functionspace(mesh, ("Lagrange", 1, (2,)))
+    u = dolfinx.fem.Function(V, name="u", dtype=dtype)
+    q = dolfinx.fem.Function(dolfinx.fem.functionspace(mesh, ("DG", 0)), name="q", dtype=dtype)
+    write_mesh(filename, mesh)
+    for t in [0.0, 0.5, 1.0]:
+        u.interpolate(lambda x: (t * x[0], x[1]))
+        q.x.array[:] = t
+        write_data(filename, [u, q], t)
+
+    # Time series shares the mesh, with one block of data per step
+    h5py = pytest.importorskip("h5py")
+    comm.Barrier()
+    if comm.rank == 0:
+        with h5py.File(filename, "r") as f:
+            steps = f["VTKHDF/Steps"]
+            assert steps.attrs["NSteps"] == 3
+            assert np.allclose(steps["Values"][:], [0.0, 0.5, 1.0])
+            num_points = mesh.geometry.index_map().size_global
+            num_cells = mesh.topology.index_map(2).size_global
+            assert f["VTKHDF/PointData/u"].shape == (3 * num_points, 3)
+            assert f["VTKHDF/CellData/q"].shape == (3 * num_cells,)
+            assert np.all(steps["PointDataOffsets/u"][:] == np.arange(3) * num_points)
+            assert np.all(steps["CellDataOffsets/q"][:] == np.arange(3) * num_cells)
+            assert np.allclose(f["VTKHDF/CellData/q"][-num_cells:], 1.0)
+            x = f["VTKHDF/Points"][:]
+            u_file = f["VTKHDF/PointData/u"][num_points : 2 * num_points]
+            assert np.allclose(u_file[:, 0], 0.5 * x[:, 0])
+            assert np.allclose(u_file[:, 1], x[:, 1])
+
+
 def test_read_write_mixed_topology(mixed_topology_mesh):
     mesh = Mesh(mixed_topology_mesh, None)
     write_mesh("mixed_mesh.vtkhdf", mesh)
@@ -222,6 +222,33 @@ def test_save_3d_vector_series(tempdir, encoding, dtype, cell_type):
         file.write_function(u, 0.3)
 
 
+@pytest.mark.parametrize("encoding", encodings)
+def test_save_series_appended(tempdir, encoding):
+    """Test that time steps appended to the XML file form a valid file."""
+    import xml.etree.ElementTree as ET
+
+    filename = Path(tempdir, "u_series.xdmf")
+    mesh = create_unit_square(MPI.COMM_WORLD, 4, 4)
+    u = Function(functionspace(mesh, ("Lagrange", 1)))
+    v = Function(functionspace(mesh, ("Lagrange", 1)))
+    u.name, v.name = "u", "v"
+    with XDMFFile(mesh.comm, filename, "w", encoding=encoding) as file:
+        file.write_mesh(mesh)
+        for t in range(4):
+            file.write_function(u, t)
+        for t in range(3):
+            file.write_function(v, t)
+            file.write_function(u, 4 + t)
+
+    if mesh.comm.rank == 0:
+        domain = ET.parse(filename).getroot().find("Domain")
+        series = {g.get("Name"): g for g in domain.findall("Grid[@GridType='Collection']")}
+        assert len(series["u"].findall("Grid")) == 7
+        assert len(series["v"].findall("Grid")) == 3
+        times = [g.find("Time").get("Value") for g in series["u"].findall("Grid")]
+        assert times == [str(t) for t in range(7)]
+
+
 def test_higher_order_function(tempdir):
     """Test Function output for higher-order meshes."""
     gmsh = pytest.importorskip("gmsh")
@@ -13,7 +13,7 @@ import pytest
 
 from dolfinx import cpp as _cpp
 from dolfinx import default_real_type
-from dolfinx.io import XDMFFile
+from dolfinx.io import DatasetOptions, FileOptions, XDMFFile
 from dolfinx.io.gmshio import cell_perm_array, ufl_mesh
 from dolfinx.mesh import (
     CellType,
@@ -61,6 +61,86 @@ def test_save_and_load_1d_mesh(tempdir, encoding):
     )
 
 
+@pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
+def test_save_and_load_compressed_mesh(tempdir):
+    filename = Path(tempdir, "mesh_compressed.xdmf")
+    mesh = create_unit_square(MPI.COMM_WORLD, 12, 12)
+    options = DatasetOptions()
+    options.shuffle = True
+    options.deflate = 4
+    with XDMFFile(mesh.comm, filename, "w", dataset_options=options) as file:
+        file.write_mesh(mesh)
+    with XDMFFile(MPI.COMM_WORLD, filename, "r") as file:
+        mesh2 = file.read_mesh()
+    assert mesh.topology.index_map(0).size_global == mesh2.topology.index_map(0).size_global
+    tdim = mesh.topology.dim
+    assert (
+        mesh.topology.index_map(tdim).size_global == mesh2.topology.index_map(tdim).size_global
+    )
+    assert mesh.comm.allreduce(np.sum(mesh.geometry.x), op=MPI.SUM) == pytest.approx(
+        mesh2.comm.allreduce(np.sum(mesh2.geometry.x), op=MPI.SUM)
+    )
+
+
+@pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
+def test_save_and_load_single_precision_mesh(tempdir):
+    mesh = create_unit_square(MPI.COMM_WORLD, 12, 12)
+    options = DatasetOptions()
+    options.float_bits = 32
+    sizes = []
+    for name, opts in [("mesh_double", DatasetOptions()), ("mesh_single", options)]:
+        with XDMFFile(mesh.comm, Path(tempdir, f"{name}.xdmf"), "w", dataset_options=opts) as file:
+            assert file.dataset_options.float_bits == opts.float_bits
+            file.write_mesh(mesh)
+        sizes.append(Path(tempdir, f"{name}.h5").stat().st_size)
+    assert sizes[1] < sizes[0]
+
+    with XDMFFile(MPI.COMM_WORLD, Path(tempdir, "mesh_single.xdmf"), "r") as file:
+        mesh2 = file.read_mesh()
+    assert mesh.comm.allreduce(np.sum(mesh.geometry.x), op=MPI.SUM) == pytest.approx(
+        mesh2.comm.allreduce(np.sum(mesh2.geometry.x), op=MPI.SUM), rel=1e-6
+    )
+
+
+def test_save_and_load_mesh_aggregators(tempdir):
+    filename = Path(tempdir, "mesh_aggregators.xdmf")
+    mesh = create_unit_square(MPI.COMM_WORLD, 12, 12)
+    with XDMFFile(mesh.comm, filename, "w", num_aggregators=1) as file:
+        file.write_mesh(mesh)
+    with XDMFFile(MPI.COMM_WORLD, filename, "r", num_aggregators=1) as file:
+        mesh2 = file.read_mesh()
+    tdim = mesh.topology.dim
+    assert (
+        mesh.topology.index_map(tdim).size_global == mesh2.topology.index_map(tdim).size_global
+    )
+    assert mesh.comm.allreduce(np.sum(mesh.geometry.x), op=MPI.SUM) == pytest.approx(
+        mesh2.comm.allreduce(np.sum(mesh2.geometry.x), op=MPI.SUM)
+    )
+
+
+def test_save_and_load_mesh_file_options(tempdir):
+    filename = Path(tempdir, "mesh_file_options.xdmf")
+    mesh = create_unit_square(MPI.COMM_WORLD, 12, 12)
+    file_options = FileOptions()
+    file_options.collective_metadata_write = True
+    file_options.collective_metadata_read = True
+    file_options.alignment = 4096
+    file_options.alignment_threshold = 1024
+    file_options.sieve_buffer_size = 1 << 16
+    file_options.mpi_hints = [("romio_ds_write", "disable")]
+    dataset_options = DatasetOptions()
+    dataset_options.collective = False
+    with XDMFFile(
+        mesh.comm, filename, "w", dataset_options=dataset_options, file_options=file_options
+    ) as file:
+        file.write_mesh(mesh)
+    with XDMFFile(MPI.COMM_WORLD, filename, "r", file_options=file_options) as file:
+        mesh2 = file.read_mesh()
+    assert mesh.comm.allreduce(np.sum(mesh.geometry.x), op=MPI.SUM) == pytest.approx(
+        mesh2.comm.allreduce(np.sum(mesh2.geometry.x), op=MPI.SUM)
+    )
+
+
 @pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
 @pytest.mark.parametrize("cell_type", celltypes_2D)
 @pytest.mark.parametrize("encoding", encodings)
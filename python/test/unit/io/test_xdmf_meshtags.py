@@ -12,9 +12,16 @@ from mpi4py import MPI
 import numpy as np
 import pytest
 
+from dolfinx import cpp as _cpp
 from dolfinx import default_real_type
 from dolfinx.io import XDMFFile
-from dolfinx.mesh import CellType, create_unit_cube, locate_entities, meshtags
+from dolfinx.mesh import (
+    CellType,
+    compute_midpoints,
+    create_unit_cube,
+    locate_entities,
+    meshtags,
+)
 
 # Supported XDMF file encoding
 if MPI.COMM_WORLD.size > 1:
@@ -138,3 +145,50 @@ def test_read_named_meshtags(tempdir, cell_type, encoding):
 
         mt_materials_in = file.read_meshtags(mesh_in, "material")
         assert all(v == material_value for v in mt_materials_in.values)
+
+
+@pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
+@pytest.mark.parametrize("cell_type", celltypes_3D)
+@pytest.mark.parametrize("chunk_size", [7, 2**20])
+def test_read_meshtags_by_cell(tempdir, cell_type, chunk_size):
+    """Check that tags stored by cell and local entity index are read
+    onto the correct entities."""
+    filename = Path(tempdir, "meshtags_by_cell.xdmf")
+    comm = MPI.COMM_WORLD
+    mesh = create_unit_cube(comm, 4, 4, 4, cell_type)
+    tdim = mesh.topology.dim
+
+    def tag(mesh, dim, entities):
+        x = compute_midpoints(mesh, dim, entities)
+        return (np.rint(8 * x) @ np.array([1, 100, 10000])).astype(np.int32)
+
+    tags = []
+    for dim in (tdim - 1, tdim):
+        mesh.topology.create_entities(dim)
+        mesh.topology.create_connectivity(dim, tdim)
+        num_entities = mesh.topology.index_map(dim).size_local
+        entities = np.arange(num_entities, dtype=np.int32)[::3]
+        mt = meshtags(mesh, dim, entities, tag(mesh, dim, entities))
+        mt.name = f"tags{dim}"
+        tags.append(mt)
+
+    with XDMFFile(comm, filename, "w", encoding=XDMFFile.Encoding.HDF5) as file:
+        file.write_mesh(mesh)
+        for mt in tags:
+            file.write_meshtags(mt, mesh.geometry)
+
+    with XDMFFile(comm, filename, "r", encoding=XDMFFile.Encoding.HDF5) as file:
+        mesh_in = file.read_mesh()
+        mesh_in.topology.create_connectivity(tdim - 1, tdim)
+        for mt in tags:
+            mt_in = _cpp.io.XDMFFile.read_meshtags(
+                file, mesh_in._cpp_object, mt.name, None, "/Xdmf/Domain", chunk_size
+            )
+            assert mt_in.dim == mt.dim
+            assert np.all(np.diff(mt_in.indices) > 0)
+            assert np.array_equal(mt_in.values, tag(mesh_in, mt.dim, mt_in.indices))
+
+            num_owned = mesh_in.topology.index_map(mt.dim).size_local
+            num_tags = comm.allreduce((mt.indices < num_owned).sum())
+            num_tags_in = comm.allreduce((mt_in.indices < num_owned).sum())
+            assert num_tags_in == num_tags
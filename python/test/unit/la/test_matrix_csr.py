@@ -267,3 +267,77 @@ def test_bad_entry(dtype):
     # set unblocked in bs=2 matrix (tests insert_nonblocked_csr)
     with pytest.raises(RuntimeError):
         mat2.add([2.0, 3.0, 4.0, 5.0], [0, 1], [0, 1], 1)
+
+
+@pytest.mark.petsc4py
+@pytest.mark.parametrize("block_mode", [BlockMode.compact, BlockMode.expanded])
+def test_create_petsc_matrix(block_mode):
+    from petsc4py import PETSc
+
+    from dolfinx.fem.petsc import assemble_matrix as petsc_assemble_matrix
+    from dolfinx.la.petsc import create_matrix, update_matrix
+
+    dtype = PETSc.ScalarType
+    mesh = create_unit_square(
+        MPI.COMM_WORLD, 7, 5, ghost_mode=GhostMode.none, dtype=np.real(dtype(0)).dtype
+    )
+    V = fem.functionspace(mesh, ("Lagrange", 2, (2,)))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = fem.form(ufl.inner(ufl.grad(u), ufl.grad(v)) * ufl.dx + u[0] * v[1] * ufl.dx, dtype=dtype)
+
+    A = fem.assemble_matrix(a, block_mode=block_mode)
+    A.scatter_reverse()
+    B = create_matrix(A)
+    C = petsc_assemble_matrix(a)
+    C.assemble()
+
+    x, y = C.createVecRight(), C.createVecLeft()
+    x.setRandom()
+    z = y.duplicate()
+    B.mult(x, y)
+    C.mult(x, z)
+    assert np.isclose((y - z).norm(), 0.0, atol=1.0e-10 * z.norm())
+
+    # Scale the entries and update the PETSc matrix
+    A.data[:] *= 2
+    update_matrix(B, A)
+    B.mult(x, y)
+    assert np.isclose((y - 2 * z).norm(), 0.0, atol=1.0e-10 * z.norm())
+
+    for M in (B, C, x, y, z):
+        M.destroy()
+
+
+@pytest.mark.petsc4py
+def test_create_petsc_matrix_shell():
+    from petsc4py import PETSc
+
+    from dolfinx.la.petsc import create_matrix, create_matrix_shell
+
+    dtype = PETSc.ScalarType
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 7, dtype=np.real(dtype(0)).dtype)
+    V = fem.functionspace(mesh, ("Lagrange", 1, (2,)))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = fem.form(ufl.inner(ufl.grad(u), ufl.grad(v)) * ufl.dx, dtype=dtype)
+
+    A = fem.assemble_matrix(a)
+    A.scatter_reverse()
+    B = create_matrix(A)
+    S = create_matrix_shell(A, num_threads=2)
+    assert S.getType() == PETSc.Mat.Type.SHELL
+    assert S.getSizes() == B.getSizes()
+
+    x, y = B.createVecRight(), B.createVecLeft()
+    x.setRandom()
+    z = y.duplicate()
+    S.mult(x, y)
+    B.mult(x, z)
+    assert np.isclose((y - z).norm(), 0.0, atol=1.0e-10 * z.norm())
+
+    # The shell matrix applies the current entries of A
+    A.data[:] *= 3
+    S.mult(x, y)
+    assert np.isclose((y - 3 * z).norm(), 0.0, atol=1.0e-10 * z.norm())
+
+    for M in (B, S, x, y, z):
+        M.destroy()
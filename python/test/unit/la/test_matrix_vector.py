@@ -139,3 +139,17 @@ def test_vector_norm(dtype, norm_type):
     x.array[:] = 0.0
     normed_value = la.norm(x, norm_type)
     assert np.isclose(normed_value, 0.0)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.complex128])
+def test_vector_dlpack(dtype):
+    mesh = create_unit_square(MPI.COMM_WORLD, 5, 5)
+    V = functionspace(mesh, ("Lagrange", 1))
+    x = la.vector(V.dofmap.index_map, dtype=dtype)
+    assert x.__dlpack_device__() == (1, 0)  # kDLCPU
+
+    y = np.from_dlpack(x)
+    assert y.dtype == dtype
+    assert y.size == x.array.size
+    y[:] = 3
+    assert np.all(x.array == 3)
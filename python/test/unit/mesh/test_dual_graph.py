@@ -31,3 +31,26 @@ def test_dgrsph_1d():
     assert w.num_nodes == 3
     for i in range(w.num_nodes):
         assert len(w.links(i)) == 2
+
+
+def test_dgraph_hashed():
+    """Check that the graph with hashed facet keys is the same as the graph with full keys."""
+    rank = MPI.COMM_WORLD.Get_rank()
+    size = MPI.COMM_WORLD.Get_size()
+    nx, ny = 5, 3 * size
+
+    # Rows of quadrilateral cells, distributed cyclically
+    cells = []
+    for j in range(rank, ny, size):
+        for i in range(nx):
+            v0 = j * (nx + 1) + i
+            cells.append([v0, v0 + 1, v0 + nx + 1, v0 + nx + 2])
+    adj = to_adj(cells, np.int64)._cpp_object
+    w0 = mesh.build_dual_graph(MPI.COMM_WORLD, mesh.CellType.quadrilateral, adj)
+    for chunk_size in [1, 4, 1 << 22]:
+        w1 = mesh.build_dual_graph_hashed(
+            MPI.COMM_WORLD, mesh.CellType.quadrilateral, adj, chunk_size, num_threads=2
+        )
+        assert w1.num_nodes == w0.num_nodes
+        for i in range(w0.num_nodes):
+            assert sorted(w1.links(i)) == sorted(w0.links(i))
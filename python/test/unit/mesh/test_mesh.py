@@ -15,11 +15,11 @@ import pytest
 import basix
 import ufl
 from basix.ufl import element
+from dolfinx import common, graph
 from dolfinx import cpp as _cpp
-from dolfinx import graph
 from dolfinx import mesh as _mesh
 from dolfinx.cpp.mesh import create_cell_partitioner, is_simplex
-from dolfinx.fem import assemble_scalar, coordinate_element, form
+from dolfinx.fem import assemble_scalar, coordinate_element, form, functionspace
 from dolfinx.mesh import (
     CellType,
     DiagonalType,
@@ -558,6 +558,28 @@ def test_submesh_boundary(d, n, boundary, ghost_mode):
     submesh_geometry_test(mesh, submesh, entity_map, geom_map, edim)
 
 
+@pytest.mark.parametrize("ghost_mode", [GhostMode.none, GhostMode.shared_facet])
+def test_submesh_parent_to_sub_entity_map(ghost_mode):
+    mesh = create_unit_square(MPI.COMM_WORLD, 8, 8, ghost_mode=ghost_mode)
+    tdim = mesh.topology.dim
+    cells = locate_entities(mesh, tdim, lambda x: x[0] <= 0.5)
+    submesh, entity_map = create_submesh(mesh, tdim, cells)[:2]
+
+    # Without ghost cells, each process includes only owned cells and
+    # the sub-mesh cells have no ghosts
+    if ghost_mode == GhostMode.none:
+        cell_imap = submesh.topology.index_map(tdim)
+        assert cell_imap.num_ghosts == 0
+        assert cell_imap.size_local == len(cells)
+        assert cell_imap.size_global == mesh.comm.allreduce(len(cells))
+
+    parent_to_sub = _mesh.compute_parent_to_sub_entity_map(mesh.topology, tdim, entity_map)
+    cell_imap = mesh.topology.index_map(tdim)
+    assert len(parent_to_sub) == cell_imap.size_local + cell_imap.num_ghosts
+    assert np.all(parent_to_sub[entity_map] == np.arange(len(entity_map)))
+    assert np.count_nonzero(parent_to_sub >= 0) == len(entity_map)
+
+
 @pytest.mark.parametrize("dtype", [np.float32, np.float64])
 def test_empty_rank_mesh(dtype):
     """Construction of mesh where some ranks are empty"""
@@ -732,3 +754,33 @@ def test_mesh_create_cmap(dtype):
     msh = _mesh.create_mesh(MPI.COMM_WORLD, cells, x, domain)
     assert msh.geometry.cmap.dim == 3
     assert msh.ufl_domain() is None
+
+
+def test_memory_usage(capfd):
+    msh = create_unit_square(MPI.COMM_WORLD, 8, 8)
+    topology, geometry = msh.topology, msh.geometry
+    assert geometry.memory_usage() >= geometry.x.nbytes
+    assert 0 < msh.memory_usage() <= topology.memory_usage() + geometry.memory_usage()
+
+    nbytes = topology.memory_usage()
+    msh.topology.create_connectivity(1, 2)
+    assert topology.memory_usage() > nbytes
+
+    V = functionspace(msh, ("Lagrange", 1))
+    assert V.memory_usage() == V.dofmap.memory_usage()
+    assert V.dofmap.memory_usage() >= V.dofmap.list.nbytes
+
+    common.memory_usage_clear()
+    common.memory_usage_record("mesh", msh.memory_usage())
+    common.memory_usage_record("V", V.memory_usage())
+    common.memory_usage_record("V", V.memory_usage())
+    assert common.memory_usage_recorded() == {
+        "mesh": msh.memory_usage(),
+        "V": V.memory_usage(),
+    }
+    common.list_memory_usage(msh.comm)
+    if msh.comm.rank == 0:
+        out = capfd.readouterr().out
+        assert "mesh" in out
+        assert "Peak resident memory" in out
+    common.memory_usage_clear()
@@ -24,10 +24,17 @@ from dolfinx.mesh import (
     compute_midpoints,
     create_box,
     create_cell_partitioner,
+    create_group_mesh,
     create_mesh,
+    create_unit_square,
+    extend_ghosting,
+    locate_entities,
+    meshtags,
+    redistribute,
+    redistribute_meshtag,
 )
 
-partitioners = [dolfinx.graph.partitioner()]
+partitioners = [dolfinx.graph.partitioner(), dolfinx.graph.partitioner_native()]
 try:
     from dolfinx.graph import partitioner_scotch
 
@@ -173,6 +180,114 @@ def test_asymmetric_partitioner():
         assert new_mesh.topology.index_map(2).num_ghosts == 0
 
 
+def test_redistribute():
+    comm = MPI.COMM_WORLD
+
+    # Create a mesh with all cells on rank 0
+    def partitioner(comm, n, cell_types, topo):
+        num_cells = len(topo[0]) // cell_num_vertices(cell_types[0])
+        dests = np.zeros(num_cells, dtype=np.int32)
+        offsets = np.arange(num_cells + 1, dtype=np.int32)
+        return dolfinx.cpp.graph.AdjacencyList_int32(dests, offsets)
+
+    msh0 = create_unit_square(comm, 8, 8, partitioner=partitioner)
+    tdim = msh0.topology.dim
+    if comm.rank > 0:
+        assert msh0.topology.index_map(tdim).size_local == 0
+
+    def marker(x):
+        return x[0] < 0.5
+
+    cells = locate_entities(msh0, tdim, marker)
+    values = np.full(len(cells), 3, dtype=np.int32)
+    mt0 = meshtags(msh0, tdim, cells, values)
+
+    msh1 = redistribute(msh0)
+    cmap = msh1.topology.index_map(tdim)
+    assert cmap.size_global == msh0.topology.index_map(tdim).size_global
+    assert cmap.size_local > 0
+
+    mt1 = redistribute_meshtag(mt0, msh0, msh1)
+    owned = mt1.indices[mt1.indices < cmap.size_local]
+    assert comm.allreduce(len(owned)) == comm.allreduce(len(cells))
+    assert np.all(marker(compute_midpoints(msh1, tdim, mt1.indices).T))
+
+
+def test_create_group_mesh():
+    from dolfinx.common import gather_group_results, split_comm
+
+    comm = MPI.COMM_WORLD
+    num_groups = min(2, comm.size)
+    group_comm, group = split_comm(comm, num_groups)
+    assert group_comm.size in (comm.size // num_groups, comm.size // num_groups + 1)
+
+    msh0 = create_unit_square(comm, 9, 7, ghost_mode=GhostMode.none)
+    msh1 = create_group_mesh(msh0, group_comm)
+    assert msh1.comm.size == group_comm.size
+    tdim = msh0.topology.dim
+    num_cells = msh0.topology.index_map(tdim).size_global
+    assert msh1.topology.index_map(tdim).size_global == num_cells
+    assert msh1.geometry.index_map().size_global == msh0.geometry.index_map().size_global
+
+    # The original cell indices of the copy are those of msh0, and
+    # identify the same cells
+    def owned_cells(msh, comm):
+        n = msh.topology.index_map(tdim).size_local
+        idx = np.concatenate(comm.allgather(msh.topology.original_cell_index[:n]))
+        x = compute_midpoints(msh, tdim, np.arange(n, dtype=np.int32))
+        x = np.concatenate(comm.allgather(x))
+        order = np.argsort(idx)
+        return idx[order], x[order]
+
+    idx0, x0 = owned_cells(msh0, comm)
+    idx1, x1 = owned_cells(msh1, group_comm)
+    assert np.array_equal(idx0, idx1)
+    assert np.allclose(x0, x1)
+
+    # Each group solves a 'case' that depends on the group index
+    x = ufl.SpatialCoordinate(msh1)
+    form = dolfinx.fem.form((group + 1) * x[0] * ufl.dx(domain=msh1), dtype=default_real_type)
+    value = group_comm.allreduce(dolfinx.fem.assemble_scalar(form))
+    results = gather_group_results(comm, group_comm, value)
+    assert len(results) == num_groups
+    for g, r in enumerate(results):
+        assert np.isclose(r, 0.5 * (g + 1))
+    group_comm.Free()
+
+
+@pytest.mark.parametrize("num_ghost_layers", [2, 3])
+def test_extend_ghosting(num_ghost_layers):
+    comm = MPI.COMM_WORLD
+    msh0 = create_unit_square(comm, 12, 12, ghost_mode=GhostMode.shared_facet)
+    tdim = msh0.topology.dim
+    msh1 = extend_ghosting(msh0, num_ghost_layers)
+    cmap0, cmap1 = msh0.topology.index_map(tdim), msh1.topology.index_map(tdim)
+    assert cmap1.size_local == cmap0.size_local
+    assert cmap1.size_global == cmap0.size_global
+    assert cmap1.num_ghosts >= cmap0.num_ghosts
+    if comm.size > 1:
+        assert comm.allreduce(cmap1.num_ghosts) > comm.allreduce(cmap0.num_ghosts)
+
+    # Every ghost cell is within num_ghost_layers facet-neighbours of
+    # an owned cell
+    msh1.topology.create_connectivity(tdim, tdim - 1)
+    msh1.topology.create_connectivity(tdim - 1, tdim)
+    cells = np.arange(cmap1.size_local, dtype=np.int32)
+    reached = cells
+    for _ in range(num_ghost_layers):
+        facets = dolfinx.mesh.compute_incident_entities(msh1.topology, reached, tdim, tdim - 1)
+        reached = dolfinx.mesh.compute_incident_entities(msh1.topology, facets, tdim - 1, tdim)
+    assert len(reached) == cmap1.size_local + cmap1.num_ghosts
+
+    # Partitioner with multiple ghost layers
+    part = create_cell_partitioner(GhostMode.shared_facet, num_ghost_layers=num_ghost_layers)
+    msh2 = create_unit_square(comm, 12, 12, partitioner=part)
+    cmap2 = msh2.topology.index_map(tdim)
+    assert cmap2.size_global == cmap0.size_global
+    if comm.size > 1:
+        assert comm.allreduce(cmap2.num_ghosts) > comm.allreduce(cmap0.num_ghosts)
+
+
 def test_mixed_topology_partitioning():
     nx = 16
     ny = 16
@@ -17,6 +17,7 @@ from dolfinx.mesh import (
     create_unit_cube,
     entities_to_geometry,
     locate_entities,
+    meshtags,
     meshtags_from_entities,
 )
 from ufl import Measure
@@ -42,6 +43,18 @@ def test_create(cell_type):
     assert mt.values.shape[0] == entities.num_nodes
 
 
+def test_find():
+    """Test lookup of tagged entities by value"""
+    msh = create_unit_cube(MPI.COMM_WORLD, 4, 4, 4)
+    tdim = msh.topology.dim
+    num_cells = msh.topology.index_map(tdim).size_local
+    cells = np.arange(0, num_cells, 2, dtype=np.int32)
+    values = (cells % 7 - 3).astype(np.int32)
+    mt = meshtags(msh, tdim, cells, values)
+    for value in range(-5, 6):
+        assert np.array_equal(mt.find(value), cells[values == value])
+
+
 def test_ufl_id():
     """Test that UFL can process MeshTags (tests ufl_id attribute)"""
     comm = MPI.COMM_WORLD
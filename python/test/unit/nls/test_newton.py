@@ -196,6 +196,69 @@ class TestNLS:
         assert converged
         assert n > 0 and n < 6
 
+    def test_nonlinear_pde_lagging(self):
+        """Test Newton solver with Jacobian and preconditioner lagging and
+        Eisenstat-Walker tolerances"""
+        from petsc4py import PETSc
+
+        from dolfinx.nls.petsc import NewtonSolver
+
+        mesh = create_unit_square(MPI.COMM_WORLD, 12, 5)
+        V = functionspace(mesh, ("Lagrange", 1))
+        u = Function(V)
+        v = TestFunction(V)
+        F = inner(5.0, v) * dx - ufl.sqrt(u * u) * inner(grad(u), grad(v)) * dx - inner(u, v) * dx
+
+        bc = dirichletbc(
+            PETSc.ScalarType(1.0),
+            locate_dofs_geometrical(V, lambda x: np.isclose(x[0], 0.0) | np.isclose(x[0], 1.0)),
+            V,
+        )
+
+        problem = NonlinearPDEProblem(F, u, bc)
+
+        u.x.array[:] = 0.9
+        solver = NewtonSolver(MPI.COMM_WORLD, problem)
+        solver.setF(problem.F, problem.vector())
+        solver.setJ(problem.J, problem.matrix())
+        solver.set_form(problem.form)
+        solver.atol = 1.0e-8
+        solver.rtol = 1.0e2 * np.finfo(default_real_type).eps
+        solver.jacobian_lag = 3
+        solver.jacobian_lag_rate = 0.9
+        solver.preconditioner_lag = 2
+        solver.eisenstat_walker = True
+        ksp = solver.krylov_solver
+        ksp.setType("gmres")
+        ksp.getPC().setType("jacobi")
+        ksp.setTolerances(rtol=1.0e-10)
+        n, converged = solver.solve(u)
+        assert converged
+        assert 0 < solver.jacobian_assemblies <= n
+        assert 0 < solver.preconditioner_builds <= solver.jacobian_assemblies
+        assert np.isclose(ksp.getTolerances()[0], 1.0e-10)
+
+        # Compare with the solution computed with full Newton
+        u0 = Function(V)
+        u0.x.array[:] = 0.9
+        problem0 = NonlinearPDEProblem(
+            inner(5.0, v) * dx
+            - ufl.sqrt(u0 * u0) * inner(grad(u0), grad(v)) * dx
+            - inner(u0, v) * dx,
+            u0,
+            bc,
+        )
+        solver0 = NewtonSolver(MPI.COMM_WORLD, problem0)
+        solver0.setF(problem0.F, problem0.vector())
+        solver0.setJ(problem0.J, problem0.matrix())
+        solver0.set_form(problem0.form)
+        solver0.atol = 1.0e-8
+        solver0.rtol = 1.0e2 * np.finfo(default_real_type).eps
+        n0, converged = solver0.solve(u0)
+        assert converged
+        assert solver0.jacobian_assemblies == n0
+        assert np.allclose(u.x.array, u0.x.array, atol=1.0e-5)
+
     def test_nonlinear_pde_snes(self):
         """Test Newton solver for a simple nonlinear PDE"""
         from petsc4py import PETSc
@@ -12,17 +12,19 @@ from numpy import isclose
 
 import ufl
 from dolfinx.cpp.mesh import create_cell_partitioner
-from dolfinx.fem import assemble_matrix, form, functionspace
+from dolfinx.fem import Function, assemble_matrix, form, functionspace
 from dolfinx.mesh import (
     CellType,
     DiagonalType,
     GhostMode,
+    Marking,
     RefinementOption,
     compute_incident_entities,
     create_unit_cube,
     create_unit_square,
     locate_entities,
     locate_entities_boundary,
+    mark_edges,
     meshtags,
     refine,
     transfer_meshtag,
@@ -212,3 +214,35 @@ def test_refine_ufl_cargo():
     msh.topology.create_entities(1)
     msh1, _, _ = refine(msh)
     assert msh1.ufl_domain().ufl_cargo() != msh.ufl_domain().ufl_cargo()
+
+
+@pytest.mark.parametrize("theta", [0.0, 0.3, 0.7, 1.0])
+@pytest.mark.parametrize("strategy", [Marking.dorfler, Marking.maximum])
+def test_mark_edges(theta, strategy):
+    msh = create_unit_square(MPI.COMM_WORLD, 12, 9)
+    tdim = msh.topology.dim
+    msh.topology.create_connectivity(tdim, 1)
+    eta = Function(functionspace(msh, ("DG", 0)))
+    eta.interpolate(lambda x: np.exp(-10 * ((x[0] - 0.3) ** 2 + (x[1] - 0.6) ** 2)))
+
+    # Reference threshold from all (gathered) indicators
+    num_owned = msh.topology.index_map(tdim).size_local
+    values = eta.x.array[:num_owned]
+    all_values = np.sort(np.concatenate(msh.comm.allgather(values)))[::-1]
+    if theta == 0.0:
+        threshold = np.inf
+    elif strategy == Marking.maximum:
+        threshold = theta * all_values[0]
+    else:
+        cumsum = np.cumsum(all_values)
+        threshold = all_values[np.searchsorted(cumsum, theta * cumsum[-1] * (1 - 1e-12))]
+
+    # Compare with the edges of the reference marked cells
+    edges = mark_edges(msh, eta.x, theta, strategy)
+    cells = np.flatnonzero(values >= threshold).astype(np.int32)
+    edges_ref = compute_incident_entities(msh.topology, cells, tdim, 1)
+    assert np.array_equal(edges, np.unique(edges_ref))
+
+    msh1, _, _ = refine(msh, edges)
+    num_cells = msh.topology.index_map(tdim).size_global
+    assert msh1.topology.index_map(tdim).size_global >= num_cells
@@ -3,7 +3,7 @@ from mpi4py import MPI
 import pytest
 
 import dolfinx
-from dolfinx.mesh import CellType, Mesh, create_unit_cube, create_unit_square
+from dolfinx.mesh import CellType, GhostMode, Mesh, create_unit_cube, create_unit_square
 
 
 @pytest.mark.parametrize("ctype", [CellType.hexahedron, CellType.tetrahedron, CellType.prism])
@@ -56,3 +56,18 @@ def test_uniform_refine_mixed_mesh(mixed_topology_mesh):
     assert comm.allreduce(ncells0[CellType.tetrahedron]) * 8 + comm.allreduce(
         ncells0[CellType.pyramid]
     ) * 4 == comm.allreduce(ncells1[CellType.tetrahedron])
+
+
+@pytest.mark.parametrize("ctype", [CellType.triangle, CellType.quadrilateral])
+def test_uniform_refinement_no_redistribute(ctype):
+    mesh = create_unit_square(
+        MPI.COMM_WORLD, 12, 11, cell_type=ctype, ghost_mode=GhostMode.shared_facet
+    )
+    mesh.topology.create_entities(1)
+    m2 = Mesh(dolfinx.cpp.refinement.uniform_refine(mesh._cpp_object, False), None)
+
+    # Children stay with the parent, and ghost cells have ghost children
+    cmap0, cmap1 = mesh.topology.index_map(2), m2.topology.index_map(2)
+    assert cmap1.size_local == 4 * cmap0.size_local
+    assert cmap1.num_ghosts == 4 * cmap0.num_ghosts
+    assert m2.topology.index_map(0).size_global == 25 * 23